@@ -25,6 +25,10 @@ do
         fi
         echo "Build with test project"
     ;;
+    bench)
+        CMAKE_EXTRA_OPTIONS+=" -DXENABLE_TESTS=ON -DXENABLE_BENCHMARKS=ON"
+        echo "Build with micro benchmarks"
+    ;;
     metrics)
         CMAKE_EXTRA_OPTIONS+=" -DBUILD_METRICS=ON"
         echo "BUILD METRICS mode"
@@ -7,6 +7,7 @@
 #include "xapplication/xerror/xerror.h"
 #include "xbasic/xmemory.hpp"
 #include "xbasic/xscope_executer.h"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xbasic/xtimer_driver.h"
 #include "xblockstore/xblockstore_face.h"
 #include "xcertauth/xcertauth_face.h"
@@ -41,6 +42,8 @@
 #include "xvnetwork/xvhost.h"
 #include "xvnode/xvnode_manager.h"
 
+#include <future>
+
 NS_BEG2(top, application)
 
 xtop_application::xtop_application(common::xnode_id_t const & node_id, xpublic_key_t const & public_key, std::string const & sign_key)
@@ -59,8 +62,9 @@ xtop_application::xtop_application(common::xnode_id_t const & node_id, xpublic_k
   , m_elect_client{top::make_unique<elect::xelect_client_imp>()} {
     int db_kind = top::db::xdb_kind_kvdb;
     std::vector<db::xdb_path_t> db_data_paths{};
-    base::xvchain_t::instance().get_db_config_custom(db_data_paths, db_kind);
-    std::shared_ptr<db::xdb_face_t> db = db::xdb_factory_t::create(db_kind, XGET_CONFIG(db_path), db_data_paths);
+    db::xdb_options_t db_options{};
+    base::xvchain_t::instance().get_db_config_custom(db_data_paths, db_kind, db_options);
+    std::shared_ptr<db::xdb_face_t> db = db::xdb_factory_t::create(db_kind, XGET_CONFIG(db_path), db_data_paths, db_options);
     m_store = store::xstore_factory::create_store_with_static_kvdb(db);
     base::xvchain_t::instance().set_xdbstore(m_store.get());
     base::xvchain_t::instance().set_xevmbus(m_bus.get());
@@ -81,6 +85,7 @@ xtop_application::xtop_application(common::xnode_id_t const & node_id, xpublic_k
         xwarn("xtop_application::start db open failed!");
         exit(0);
     }
+    m_startup_timeline.mark("db_open");
 
     // prepare system contract data only
     contract::xcontract_deploy_t::instance().deploy_sys_contracts();
@@ -91,6 +96,7 @@ xtop_application::xtop_application(common::xnode_id_t const & node_id, xpublic_k
     std::error_code ec;
     m_genesis_manager->init_genesis_block(ec);
     top::error::throw_error(ec);
+    m_startup_timeline.mark("genesis");
 }
 
 void xtop_application::start() {
@@ -101,8 +107,11 @@ void xtop_application::start() {
 
     chain_fork::xtop_chain_fork_config_center::init();
     base::xvblock_fork_t::instance().init(chain_fork::xtop_chain_fork_config_center::is_block_forked);
+    m_startup_timeline.mark("config_load");
 
     m_txpool = xtxpool_v2::xtxpool_instance::create_xtxpool_inst(make_observer(m_blockstore), make_observer(m_cert_ptr), make_observer(m_bus));
+    // pending txs are journaled next to the db and pushed again when their tables are subscribed after a restart
+    m_txpool->set_journal_dir(XGET_CONFIG(db_path) + "/txpool_journal");
 
     m_syncstore.attach(new store::xsyncvstore_t(*m_cert_ptr.get(), *m_blockstore.get()));
     contract::xcontract_manager_t::instance().init(m_syncstore);
@@ -115,10 +124,19 @@ void xtop_application::start() {
     statestore_thp.push_back(make_object_ptr<base::xiothread_t>());
     statestore_thp.push_back(make_object_ptr<base::xiothread_t>());
     m_thread_pools[xtop_thread_pool_type::statestore] = statestore_thp;
+    for (std::size_t i = 0; i < txpool_service_thp.size(); i++) {
+        threading::set_thread_name(txpool_service_thp[i].get(), "txpool_svc" + std::to_string(i));
+    }
+    for (std::size_t i = 0; i < statestore_thp.size(); i++) {
+        threading::set_thread_name(statestore_thp[i].get(), "statestore" + std::to_string(i));
+    }
+    threading::set_thread_name(m_sync_thread.get(), "sync");
+    threading::set_thread_name(m_grpc_thread.get(), "grpc");
 
     std::vector<observer_ptr<base::xiothread_t>> sync_account_thread_pool;
     for (uint32_t i = 0; i < 2; i++) {
         xobject_ptr_t<base::xiothread_t> thread = make_object_ptr<base::xiothread_t>();
+        threading::set_thread_name(thread.get(), "sync_account" + std::to_string(i));
         m_sync_account_thread_pool.push_back(thread);
         sync_account_thread_pool.push_back(make_observer(thread));
     }
@@ -126,6 +144,7 @@ void xtop_application::start() {
     std::vector<observer_ptr<base::xiothread_t>> sync_handler_thread_pool;
     for (uint32_t i = 0; i < 2; i++) {
         xobject_ptr_t<base::xiothread_t> thread = make_object_ptr<base::xiothread_t>();
+        threading::set_thread_name(thread.get(), "sync_handler" + std::to_string(i));
         m_sync_handler_thread_pool.push_back(thread);
         sync_handler_thread_pool.push_back(make_observer(thread));
     }
@@ -150,6 +169,8 @@ void xtop_application::start() {
             make_observer(m_blockstore), make_observer(m_txpool), m_thread_pools.at(xthread_pool_type_t::txpool_service), make_observer(m_bus), make_observer(m_logic_timer));
         xobject_ptr_t<base::xiothread_t> executor_thread = make_object_ptr<base::xiothread_t>();
         xobject_ptr_t<base::xiothread_t> syncer_thread = make_object_ptr<base::xiothread_t>();
+        threading::set_thread_name(executor_thread.get(), "state_executor");
+        threading::set_thread_name(syncer_thread.get(), "state_syncer");
         m_downloader = std::make_shared<state_sync::xstate_downloader_t>(
             base::xvchain_t::instance().get_xdbstore(), statestore::xstatestore_hub_t::instance(), make_observer(m_bus), executor_thread, syncer_thread);
         m_vnode_manager = std::make_shared<vnode::xvnode_manager_t>(make_observer(m_elect_main),
@@ -168,6 +189,7 @@ void xtop_application::start() {
                                                                     make_observer(m_nodesvr_ptr),
                                                                     make_observer(m_downloader.get()));
     }
+    m_startup_timeline.mark("construct");
 
     for (auto & io_context_pool_info : m_io_context_pools) {
         auto & io_context_pool = top::get<xio_context_pool_t>(io_context_pool_info);
@@ -207,7 +229,13 @@ void xtop_application::start() {
     // start
     {
         contract::xcontract_manager_t::instance().install_monitors(make_observer(m_bus), make_observer(m_message_callback_hub.get()), m_syncstore);
+
+        // tables catch up their execution while the election data is loaded and the services start
+        auto statestore_thp = m_thread_pools.at(xthread_pool_type_t::statestore);
+        statestore::xstatestore_hub_t::instance()->start(statestore_thp[0], statestore_thp[1]);
+
         load_last_election_data();
+        m_startup_timeline.mark("election_data_load");
 
         m_txpool_service_mgr->start();
         m_vhost->start();
@@ -219,9 +247,7 @@ void xtop_application::start() {
         m_sync_obj->start();
 
         top_console_init();
-
-        auto statestore_thp = m_thread_pools.at(xthread_pool_type_t::statestore);
-        statestore::xstatestore_hub_t::instance()->start(statestore_thp[0], statestore_thp[1]);
+        m_startup_timeline.mark("services_start");
 
         auto const & frozen_sharding_address = common::build_frozen_sharding_address(m_network_id);
         auto const zone_type = common::node_type_from(frozen_sharding_address.zone_id());
@@ -246,6 +272,7 @@ void xtop_application::start() {
         xinfo("disable_block_recycler ok.");
     else
         xerror("disable_block_recycler fail");
+    m_startup_timeline.mark("start");
 }
 
 void xtop_application::stop() {
@@ -319,52 +346,83 @@ void xtop_application::load_last_election_data() {
                                                                              {zec_elect_consensus_contract_address, common::xdefault_zone_id},
                                                                              {zec_elect_eth_contract_address, common::xevm_zone_id},
                                                                              {relay_make_block_contract_address, common::xrelay_zone_id}};
+
+    // the states are read and decoded in parallel, the election data is still applied in the original order
+    struct xelection_data_t {
+        common::xaccount_address_t addr;
+        std::string property;
+        bool loaded{false};
+        uint64_t block_height{0};
+        data::election::xelection_result_store_t result_store;
+        bool prev_loaded{false};
+        data::election::xelection_result_store_t prev_result_store;
+    };
+    std::vector<xelection_data_t> election_data;
     for (const auto & addr : sys_addr) {
         for (auto const & property : data::election::get_property_name_by_addr(addr)) {
-            common::xzone_id_t zone_id = addr_to_zone_id[addr];
-            using top::data::election::xelection_result_store_t;
-            std::error_code ec;
+            xelection_data_t item;
+            item.addr = addr;
+            item.property = property;
+            election_data.push_back(std::move(item));
+        }
+    }
 
+    std::vector<std::future<void>> loadings;
+    for (auto & item : election_data) {
+        loadings.push_back(std::async(std::launch::async, [&item] {
+            auto const & addr = item.addr;
+            auto const & property = item.property;
             xwarn("xbeacon_chain_application::load_last_election_data begin. contract %s; property %s", addr.c_str(), property.c_str());
             xscope_executer_t loading_result_logger{
-                [&ec, &addr, property] { xwarn("xbeacon_chain_application::load_last_election_data end. contract %s; property %s", addr.c_str(), property.c_str()); }};
+                [&addr, &property] { xwarn("xbeacon_chain_application::load_last_election_data end. contract %s; property %s", addr.c_str(), property.c_str()); }};
 
             data::xunitstate_ptr_t unitstate = statestore::xstatestore_hub_t::instance()->get_unit_latest_connectted_change_state(addr);
             if (unitstate == nullptr) {
                 xerror("xtop_application::load_last_election_data fail-get state.");
-                top::error::throw_error(ec);
-                continue;
+                return;
             }
             std::string result;
             if (xsuccess != unitstate->string_get(property, result)) {
                 xerror("xtop_application::load_last_election_data fail-get property.");
-                top::error::throw_error(ec);
-                continue;
+                return;
             }
 
-            uint64_t block_height = unitstate->height();
-            auto const & last_election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(result), std::end(result)});
-            xinfo("xbeacon_chain_application::load_last_election_data load block.addr=%s,height=%ld", addr.c_str(), block_height);
+            item.block_height = unitstate->height();
+            item.result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(result), std::end(result)});
+            xinfo("xbeacon_chain_application::load_last_election_data load block.addr=%s,height=%ld", addr.c_str(), item.block_height);
 
             if ((addr == rec_elect_rec_contract_address || addr == rec_elect_zec_contract_address || addr == zec_elect_consensus_contract_address ||
                  addr == zec_elect_eth_contract_address || addr == relay_make_block_contract_address) &&
-                block_height != 0) {
-                uint64_t prev_block_height = block_height - 1;
+                item.block_height != 0) {
+                uint64_t prev_block_height = item.block_height - 1;
                 data::xunitstate_ptr_t unitstate2 = statestore::xstatestore_hub_t::instance()->get_unit_committed_changed_state(addr, prev_block_height);
-                if (unitstate == nullptr) {
+                if (unitstate2 == nullptr) {
                     xwarn("xtop_application::load_last_election_data fail-get state.");
                 } else {
                     if (xsuccess != unitstate2->string_get(property, result)) {
                         xerror("xtop_application::load_last_election_data fail-get property.");
-                        top::error::throw_error(ec);
-                        continue;
+                        return;
                     }
-                    auto const & before_last_election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(result), std::end(result)});
-                    on_election_data_updated(before_last_election_result_store, zone_id, prev_block_height);  // TODO(jimmy) use state->get_block_height() ?
+                    item.prev_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(result), std::end(result)});
+                    item.prev_loaded = true;
                 }
             }
-            on_election_data_updated(last_election_result_store, zone_id, block_height);
+            item.loaded = true;
+        }));
+    }
+    for (auto & loading : loadings) {
+        loading.get();
+    }
+
+    for (auto const & item : election_data) {
+        if (!item.loaded) {
+            continue;
+        }
+        common::xzone_id_t zone_id = addr_to_zone_id[item.addr];
+        if (item.prev_loaded) {
+            on_election_data_updated(item.prev_result_store, zone_id, item.block_height - 1);  // TODO(jimmy) use state->get_block_height() ?
         }
+        on_election_data_updated(item.result_store, zone_id, item.block_height);
     }
 }
 
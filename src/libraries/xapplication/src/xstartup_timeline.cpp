@@ -0,0 +1,31 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xapplication/xstartup_timeline.h"
+
+#include "xbase/xlog.h"
+#include "xmetrics/xmetrics.h"
+
+NS_BEG2(top, application)
+
+xtop_startup_timeline::xtop_startup_timeline() : m_begin{std::chrono::steady_clock::now()}, m_phase_begin{m_begin} {
+}
+
+void xtop_startup_timeline::mark(std::string const & phase) {
+    auto const now = std::chrono::steady_clock::now();
+    auto const phase_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_phase_begin).count();
+    m_phase_begin = now;
+    auto const elapsed_ms = total_ms();
+    xkinfo("xstartup_timeline_t::mark phase:%s,phase_ms:%lld,total_ms:%lld", phase.c_str(), static_cast<long long>(phase_ms), static_cast<long long>(elapsed_ms));
+#ifdef ENABLE_METRICS
+    XMETRICS_COUNTER_SET("startup_" + phase + "_ms", static_cast<int64_t>(phase_ms));
+    XMETRICS_COUNTER_SET("startup_total_ms", static_cast<int64_t>(elapsed_ms));
+#endif
+}
+
+int64_t xtop_startup_timeline::total_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_begin).count();
+}
+
+NS_END2
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "xapplication/xstartup_timeline.h"
 #include "xbase/xns_macro.h"
 #include "xbasic/xasio_io_context_wrapper.h"
 #include "xbasic/xcrypto_key.h"
@@ -94,6 +95,7 @@ public:
     using xio_context_pool_t = std::vector<std::shared_ptr<xbase_io_context_wrapper_t>>;
 
 private:
+    xstartup_timeline_t m_startup_timeline{};
     common::xnode_id_t m_node_id;
     xpublic_key_t m_public_key;
     std::string m_sign_key;
@@ -0,0 +1,31 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <chrono>
+#include <string>
+
+NS_BEG2(top, application)
+
+/// @brief Records how long each startup phase takes, exported as the startup_<phase>_ms counters and logged.
+class xtop_startup_timeline {
+public:
+    xtop_startup_timeline();
+
+    /// @brief Ends the running phase with the given name and starts the next one.
+    void mark(std::string const & phase);
+
+    /// @brief Milliseconds since the timeline was created.
+    int64_t total_ms() const;
+
+private:
+    std::chrono::steady_clock::time_point m_begin;
+    std::chrono::steady_clock::time_point m_phase_begin;
+};
+using xstartup_timeline_t = xtop_startup_timeline;
+
+NS_END2
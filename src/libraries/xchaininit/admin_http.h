@@ -64,6 +64,23 @@ public:
 
     bool verify_token(ResponsePtr res, RequestPtr req);
     bool handle_command(ResponsePtr res, RequestPtr req);
+    // OpenMetrics pull endpoint for prometheus
+    bool metrics(ResponsePtr res, RequestPtr req);
+    // allocator statistics, and a heap profile written to the log directory
+    bool heap_stats(ResponsePtr res, RequestPtr req);
+    bool heap_dump(ResponsePtr res, RequestPtr req);
+    // cpu profile or sampled heap profile of the next ?seconds=N (default 30), returned as the profile file.
+    // the cpu profile takes ?threads=<name prefix> to keep only e.g. cons_worker, sync_ or rpc_ threads
+    bool cpu_profile(ResponsePtr res, RequestPtr req);
+    bool heap_profile(ResponsePtr res, RequestPtr req);
+    // "tid name" of all threads, to read the profiles per pool
+    bool threads(ResponsePtr res, RequestPtr req);
+    // memory of the caches and pools with their soft limits, json
+    bool memory(ResponsePtr res, RequestPtr req);
+    // heaviest accounts of each table by txs, execution time, state loads and state changes, json.
+    // takes ?top=N (default 10) and ?table=<address>; the POST resets them
+    bool hot_accounts(ResponsePtr res, RequestPtr req);
+    bool hot_accounts_reset(ResponsePtr res, RequestPtr req);
 
 private:
     std::string webroot_ {"./"};
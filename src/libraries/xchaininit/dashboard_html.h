@@ -179,6 +179,7 @@ COMMANDS:
     help                     Show a list of commands and options.
     topcl                    A command line interface to interact with the blockchain and manage accounts.
     xnode                    Xnode is the core service daemon that runs on every TOP Network node.
+    memory                   Show the memory of the caches and pools of topio and their soft limits.
 			</p>
                 </pre>
             </div>
@@ -247,6 +248,45 @@ COMMANDS:
                 });
             }
 
+            function append_result(cmdline, result) {
+                var cmd_line_div = document.createElement("div");
+                cmd_line_div.className = "line input";
+                cmd_line_div.innerHTML = String.format('<div class="nopad"><span class="prompt">&gt; </span><a href="#run">{0}</a></div>', cmdline);
+                var cmd_result_div = document.createElement("div");
+                cmd_result_div.className = "line response";
+                cmd_result_div.innerHTML = String.format('<div class="nopad"><span class="prompt"></span><pre><p>{0}</p></pre></div>', result);
+                var output_father = document.getElementById('log');
+                output_father.appendChild(cmd_line_div);
+                output_father.appendChild(cmd_result_div);
+                output_father.scrollTop = output_father.scrollHeight;
+            }
+
+            function mb(bytes) {
+                return (bytes / 1048576).toFixed(1) + ' MB';
+            }
+
+            function ajax_topio_memory(cmdline) {
+                $.ajax({
+                    cache: false,
+                    type: "GET",
+                    url: "/debug/memory",
+                    dataType: "json",
+                    error: function(request) {
+                        alert("send request failed, please make sure remote http-server is ok.");
+                    },
+                    success: function(response) {
+                        var result = String.format('{0}{1}{2}{3}{4}\n', 'subsystem'.padEnd(32), 'memory'.padStart(14), 'objects'.padStart(14), 'soft limit'.padStart(14), 'shrinks'.padStart(10));
+                        for (var index in response['subsystems']) {
+                            var usage = response['subsystems'][index];
+                            var limit = usage['soft_limit'] > 0 ? mb(usage['soft_limit']) : '-';
+                            result += String.format('{0}{1}{2}{3}{4}\n', usage['name'].padEnd(32), mb(usage['bytes']).padStart(14), String(usage['objects']).padStart(14), limit.padStart(14), String(usage['shrinks']).padStart(10));
+                        }
+                        result += String.format('{0}{1}\n', 'total'.padEnd(32), mb(response['total_bytes']).padStart(14));
+                        append_result(cmdline, result);
+                    }
+                });
+            }
+
             $(function() {
 
                 $('input').bind('keypress', function(event) {
@@ -257,6 +297,11 @@ COMMANDS:
                         if (cmdline == '') {
                             return;
                         }
+                        if (cmdline.trim() == 'memory') {
+                            ajax_topio_memory(cmdline);
+                            document.getElementById("input").value = '';
+                            return;
+                        }
                         var sp_command = cmdline.split(' ');
                         if (sp_command.length < 1) {
                             alert("wrong command, try input help");
@@ -1,5 +1,8 @@
 #include "xchaininit/admin_http.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -9,8 +12,15 @@
 #include "xpbase/base/top_utils.h"
 #include "xpbase/base/line_parser.h"
 #include <asio/error.hpp>
+#include "xchaininit/xallocator_profile.h"
+#include "xchaininit/xcpu_profile.h"
 #include "xchaininit/xchain_info_query.h"
+#include "xchaininit/xmemory_monitor.h"
 #include "xchaininit/dashboard_html.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
+#include "xmetrics/xhot_accounts.h"
+#include "xmetrics/xmetrics.h"
 
 namespace  top {
 
@@ -290,6 +300,188 @@ bool HttpHandler::verify_token(ResponsePtr res, RequestPtr req) {
     return true;
 }
 
+bool HttpHandler::metrics(ResponsePtr res, RequestPtr req) {
+#ifdef ENABLE_METRICS
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", top::metrics::xopenmetrics_writer_t::content_type});
+    res->write(top::metrics::e_metrics::get_instance().openmetrics_text(), res_headers);
+    return true;
+#else
+    return default_not_found(res, req);
+#endif
+}
+
+bool HttpHandler::heap_stats(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "text/plain; charset=utf-8"});
+    res->write("allocator: " + top::allocator_name() + "\n" + top::allocator_stats(), res_headers);
+    return true;
+}
+
+bool HttpHandler::heap_dump(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    std::string result;
+    json res_content;
+    if (top::dump_heap_profile(XGET_CONFIG(log_path) + "/heap", result)) {
+        res_content["path"] = result;
+    } else {
+        res_content["error"] = result;
+    }
+    TOP_INFO("heap_dump %s", result.c_str());
+
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "application/json"});
+    res->write(res_content.dump(4), res_headers);
+    return true;
+}
+
+namespace {
+
+uint32_t profile_seconds(RequestPtr req) {
+    uint32_t seconds = 30;
+    auto query_fields = req->parse_query_string();
+    auto it = query_fields.find("seconds");
+    if (it != query_fields.end()) {
+        seconds = static_cast<uint32_t>(std::strtoul(it->second.c_str(), nullptr, 10));
+    }
+    return std::min<uint32_t>(std::max<uint32_t>(seconds, 1), 600);
+}
+
+void write_profile(ResponsePtr res, bool ok, std::string const & result) {
+    std::ifstream profile(result, std::ios::in | std::ios::binary);
+    if (!ok || !profile) {
+        json res_content;
+        res_content["error"] = ok ? "cannot read " + result : result;
+        SimpleWeb::CaseInsensitiveMultimap res_headers;
+        res_headers.insert({"Content-Type", "application/json"});
+        res->write(res_content.dump(4), res_headers);
+        return;
+    }
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "application/octet-stream"});
+    res_headers.insert({"Content-Disposition", "attachment; filename=\"" + result.substr(result.find_last_of('/') + 1) + "\""});
+    res->write(profile, res_headers);
+}
+
+}  // namespace
+
+// the profiles take seconds, they run off the single admin thread and answer when done
+bool HttpHandler::cpu_profile(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    auto const seconds = profile_seconds(req);
+    auto query_fields = req->parse_query_string();
+    auto it = query_fields.find("threads");
+    std::string thread_prefix = it != query_fields.end() ? it->second : "";
+    std::thread([res, seconds, thread_prefix]() {
+        std::string result;
+        bool ok = top::cpu_profile(XGET_CONFIG(log_path) + "/cpu", seconds, thread_prefix, result);
+        TOP_INFO("cpu_profile %s", result.c_str());
+        write_profile(res, ok, result);
+    }).detach();
+    return true;
+}
+
+bool HttpHandler::heap_profile(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    auto const seconds = profile_seconds(req);
+    std::thread([res, seconds]() {
+        static std::atomic<bool> running{false};
+        std::string result;
+        bool ok = false;
+        if (running.exchange(true)) {
+            result = "another heap profile is running";
+        } else {
+            ok = top::sample_heap_profile(XGET_CONFIG(log_path) + "/heap", seconds, result);
+            running = false;
+        }
+        TOP_INFO("heap_profile %s", result.c_str());
+        write_profile(res, ok, result);
+    }).detach();
+    return true;
+}
+
+bool HttpHandler::threads(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "text/plain; charset=utf-8"});
+    res->write(top::thread_names(), res_headers);
+    return true;
+}
+
+bool HttpHandler::memory(ResponsePtr res, RequestPtr req) {
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "application/json"});
+    res->write(top::memory_usage_json(), res_headers);
+    return true;
+}
+
+bool HttpHandler::hot_accounts(ResponsePtr res, RequestPtr req) {
+#ifdef ENABLE_METRICS
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    auto query_fields = req->parse_query_string();
+    std::size_t top_k = 10;
+    auto it = query_fields.find("top");
+    if (it != query_fields.end()) {
+        top_k = std::min<std::size_t>(std::strtoul(it->second.c_str(), nullptr, 10), top::metrics::xhot_accounts_t::sketch_capacity);
+    }
+    it = query_fields.find("table");
+    std::string const table = it != query_fields.end() ? it->second : "";
+
+    auto const & hot = top::metrics::xhot_accounts_t::instance();
+    json res_content;
+    res_content["sample_rate"] = hot.sample_rate();
+    for (std::size_t i = 0; i < static_cast<std::size_t>(top::metrics::xhot_dimension_t::count); ++i) {
+        auto const dimension = static_cast<top::metrics::xhot_dimension_t>(i);
+        json tables = json::object();
+        for (auto const & pair : hot.top(dimension, top_k, table)) {
+            json accounts = json::array();
+            for (auto const & account : pair.second) {
+                accounts.push_back({{"account", account.account}, {"value", account.value}, {"error", account.error}});
+            }
+            tables[pair.first] = accounts;
+        }
+        res_content[top::metrics::hot_dimension_name(dimension)] = tables;
+    }
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "application/json"});
+    res->write(res_content.dump(), res_headers);
+    return true;
+#else
+    return default_not_found(res, req);
+#endif
+}
+
+bool HttpHandler::hot_accounts_reset(ResponsePtr res, RequestPtr req) {
+#ifdef ENABLE_METRICS
+    if (!verify_token(res, req)) {
+        return false;
+    }
+    top::metrics::xhot_accounts_t::instance().reset();
+    SimpleWeb::CaseInsensitiveMultimap res_headers;
+    res_headers.insert({"Content-Type", "text/plain; charset=utf-8"});
+    res->write("ok", res_headers);
+    return true;
+#else
+    return default_not_found(res, req);
+#endif
+}
+
 // post method; body contain cmd
 bool HttpHandler::handle_command(ResponsePtr res, RequestPtr req) {
     if (!verify_token(res, req)) {
@@ -595,6 +787,51 @@ void AdminHttpServer::bind_route_callback_for_command() {
         http_handler_->handle_command(res, req);
     };
     TOP_INFO("bind_route_callback route:/api/command POST");
+
+    svr_->resource["/metrics"]["GET"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->metrics(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/metrics GET");
+
+    svr_->resource["/debug/heap/stats"]["GET"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->heap_stats(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/heap/stats GET");
+
+    svr_->resource["/debug/heap/dump"]["POST"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->heap_dump(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/heap/dump POST");
+
+    svr_->resource["/debug/pprof/profile"]["POST"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->cpu_profile(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/pprof/profile POST");
+
+    svr_->resource["/debug/pprof/heap"]["POST"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->heap_profile(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/pprof/heap POST");
+
+    svr_->resource["/debug/threads"]["GET"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->threads(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/threads GET");
+
+    svr_->resource["/debug/memory"]["GET"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->memory(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/memory GET");
+
+    svr_->resource["/debug/hot_accounts"]["GET"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->hot_accounts(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/hot_accounts GET");
+
+    svr_->resource["/debug/hot_accounts/reset"]["POST"] = [&](ResponsePtr res, RequestPtr req) {
+        http_handler_->hot_accounts_reset(res, req);
+    };
+    TOP_INFO("bind_route_callback route:/debug/hot_accounts/reset POST");
 }
 
 } // namespace admin
@@ -0,0 +1,235 @@
+#include "xchaininit/xallocator_profile.h"
+
+#include "xbase/xlog.h"
+#include "xmetrics/xmetrics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+#if defined(ENABLE_JEMALLOC)
+// declared here instead of including jemalloc/jemalloc.h, the unprefixed symbols of the system jemalloc
+extern "C" {
+int mallctl(const char * name, void * oldp, size_t * oldlenp, void * newp, size_t newlen);
+void malloc_stats_print(void (*write_cb)(void *, const char *), void * cbopaque, const char * opts);
+
+// read by jemalloc at startup, MALLOC_CONF in the environment overrides it.
+// background threads purge dirty pages off the allocating threads, the decay keeps a burst of blocks for reuse
+// instead of returning them to the kernel at once
+const char * malloc_conf = "background_thread:true,dirty_decay_ms:5000,muzzy_decay_ms:5000";
+}
+#elif defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+#include "gperftools/malloc_extension.h"
+#if defined(ENABLE_GHPERF)
+#include "gperftools/heap-profiler.h"
+#endif
+#else
+#include <malloc.h>
+#endif
+
+namespace top {
+
+namespace {
+
+#if defined(ENABLE_JEMALLOC) || defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+std::string profile_path(std::string const & prefix, char const * suffix) {
+    return prefix + "." + std::to_string(::getpid()) + "." +
+           std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()) + suffix;
+}
+#endif
+
+#if defined(ENABLE_JEMALLOC)
+template <typename T>
+bool jemalloc_read(char const * name, T & value) {
+    size_t size = sizeof(value);
+    return ::mallctl(name, &value, &size, nullptr, 0) == 0;
+}
+
+void jemalloc_refresh_stats() {
+    // the stats are cached until the epoch is bumped
+    uint64_t epoch = 1;
+    size_t size = sizeof(epoch);
+    ::mallctl("epoch", &epoch, &size, &epoch, size);
+}
+#endif
+
+}  // namespace
+
+std::string allocator_name() {
+#if defined(ENABLE_JEMALLOC)
+    return "jemalloc";
+#elif defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+    return "tcmalloc";
+#else
+    return "glibc";
+#endif
+}
+
+std::string allocator_stats() {
+#if defined(ENABLE_JEMALLOC)
+    jemalloc_refresh_stats();
+    std::string stats;
+    ::malloc_stats_print([](void * opaque, const char * text) { static_cast<std::string *>(opaque)->append(text); }, &stats, nullptr);
+    return stats;
+#elif defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+    std::string stats(64 * 1024, '\0');
+    MallocExtension::instance()->GetStats(&stats[0], static_cast<int>(stats.size()));
+    stats.resize(std::strlen(stats.c_str()));
+    return stats;
+#else
+    char * buffer = nullptr;
+    size_t size = 0;
+    FILE * stream = ::open_memstream(&buffer, &size);
+    if (stream == nullptr) {
+        return std::string();
+    }
+    ::malloc_info(0, stream);
+    std::fclose(stream);
+    std::string stats(buffer, size);
+    std::free(buffer);
+    return stats;
+#endif
+}
+
+bool dump_heap_profile(std::string const & prefix, std::string & result) {
+#if defined(ENABLE_JEMALLOC)
+    bool active = false;
+    if (!jemalloc_read("opt.prof", active) || !active) {
+        result = "jemalloc profiling is off, run with MALLOC_CONF=prof:true,prof_active:true on a jemalloc built with --enable-prof";
+        return false;
+    }
+    std::string path = profile_path(prefix, ".heap");
+    char const * file = path.c_str();
+    if (::mallctl("prof.dump", nullptr, nullptr, &file, sizeof(file)) != 0) {
+        result = "jemalloc prof.dump failed";
+        return false;
+    }
+    result = path;
+    return true;
+#elif defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+    std::string profile;
+#if defined(ENABLE_GHPERF)
+    if (::IsHeapProfilerRunning()) {
+        char * text = ::GetHeapProfile();
+        if (text != nullptr) {
+            profile = text;
+            std::free(text);
+        }
+    }
+#endif
+    if (profile.empty()) {
+        MallocExtension::instance()->GetHeapSample(&profile);
+    }
+    if (profile.empty()) {
+        result = "tcmalloc has no heap sample, run with TCMALLOC_SAMPLE_PARAMETER=524288";
+        return false;
+    }
+    std::string path = profile_path(prefix, ".heap");
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    out << profile;
+    if (!out) {
+        result = "cannot write " + path;
+        return false;
+    }
+    result = path;
+    return true;
+#else
+    (void)prefix;
+    result = "heap profiles need a build with XUSE_JEMALLOC or TCMALLOC";
+    return false;
+#endif
+}
+
+bool sample_heap_profile(std::string const & prefix, uint32_t seconds, std::string & result) {
+#if defined(ENABLE_JEMALLOC)
+    bool enabled = false;
+    if (!jemalloc_read("opt.prof", enabled) || !enabled) {
+        return dump_heap_profile(prefix, result);
+    }
+    bool was_active = false;
+    jemalloc_read("prof.active", was_active);
+    bool active = true;
+    ::mallctl("prof.reset", nullptr, nullptr, nullptr, 0);
+    ::mallctl("prof.active", nullptr, nullptr, &active, sizeof(active));
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    bool const ok = dump_heap_profile(prefix, result);
+    ::mallctl("prof.active", nullptr, nullptr, &was_active, sizeof(was_active));
+    return ok;
+#elif defined(ENABLE_GHPERF)
+    if (::IsHeapProfilerRunning()) {
+        // started for the whole process by setup_ghperf, cannot be narrowed to the window
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        return dump_heap_profile(prefix, result);
+    }
+    ::HeapProfilerStart(prefix.c_str());
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    bool const ok = dump_heap_profile(prefix, result);
+    ::HeapProfilerStop();
+    return ok;
+#elif defined(ENABLE_TCMALLOC)
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    return dump_heap_profile(prefix, result);
+#else
+    (void)seconds;
+    return dump_heap_profile(prefix, result);
+#endif
+}
+
+void export_allocator_metrics() {
+#ifdef ENABLE_METRICS
+#if defined(ENABLE_JEMALLOC)
+    jemalloc_refresh_stats();
+    static char const * const stats[][2] = {
+        {"stats.allocated", "allocator_allocated_bytes"},
+        {"stats.active", "allocator_active_bytes"},
+        {"stats.metadata", "allocator_metadata_bytes"},
+        {"stats.resident", "allocator_resident_bytes"},
+        {"stats.mapped", "allocator_mapped_bytes"},
+        {"stats.retained", "allocator_retained_bytes"},
+    };
+    for (auto const & stat : stats) {
+        size_t value = 0;
+        if (jemalloc_read(stat[0], value)) {
+            XMETRICS_COUNTER_SET(stat[1], static_cast<int64_t>(value));
+        }
+    }
+#elif defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+    static char const * const properties[][2] = {
+        {"generic.current_allocated_bytes", "allocator_allocated_bytes"},
+        {"generic.heap_size", "allocator_mapped_bytes"},
+        {"tcmalloc.pageheap_free_bytes", "allocator_pageheap_free_bytes"},
+        {"tcmalloc.pageheap_unmapped_bytes", "allocator_retained_bytes"},
+        {"tcmalloc.current_total_thread_cache_bytes", "allocator_thread_cache_bytes"},
+    };
+    for (auto const & property : properties) {
+        size_t value = 0;
+        if (MallocExtension::instance()->GetNumericProperty(property[0], &value)) {
+            XMETRICS_COUNTER_SET(property[1], static_cast<int64_t>(value));
+        }
+    }
+#endif
+#endif
+}
+
+void setup_allocator() {
+#if defined(ENABLE_TCMALLOC) || defined(ENABLE_GHPERF)
+    // the default of 32MB is shared by hundreds of threads here, so busy threads keep going to the central lists
+    MallocExtension::instance()->SetNumericProperty("tcmalloc.max_total_thread_cache_bytes", 256u * 1024 * 1024);
+#endif
+    xkinfo("setup_allocator %s", allocator_name().c_str());
+
+#ifdef ENABLE_METRICS
+    std::thread([] {
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::seconds(10));
+            export_allocator_metrics();
+        }
+    }).detach();
+#endif
+}
+
+}  // namespace top
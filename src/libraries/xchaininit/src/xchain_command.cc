@@ -705,6 +705,26 @@ int parse_execute_command(const char * config_file_extra, int argc, char * argv[
     transfer->add_option("note", note, "The note for the transfer,characters of any type, not exceeding 128 in length.");
     transfer->add_option("-t,--tx_deposit", tx_deposit, "Transaction deposit,a minimum of 0.1 TOP.");
 
+    /*
+     * loadgen
+     */
+    std::string loadgen_keys_path;
+    uint32_t loadgen_tx_per_account{100};
+    uint32_t loadgen_tps{100};
+    uint32_t loadgen_connections{8};
+    auto loadgen = app.add_subcommand("loadgen", "Send signed transfers among accounts at a target rate and report confirm latency.")->group("");
+    loadgen->callback(std::bind(&ApiMethod::load_gen,
+                                &topcl.api,
+                                std::ref(loadgen_keys_path),
+                                std::ref(loadgen_tx_per_account),
+                                std::ref(loadgen_tps),
+                                std::ref(loadgen_connections),
+                                std::ref(out_str)));
+    loadgen->add_option("keys_file", loadgen_keys_path, "File of funded account private keys in hex, one per line.")->required();
+    loadgen->add_option("-n,--tx_per_account", loadgen_tx_per_account, "Transfers sent by each account, default 100.");
+    loadgen->add_option("-r,--tps", loadgen_tps, "Target transactions per second, default 100.");
+    loadgen->add_option("-c,--connections", loadgen_connections, "Keep-alive connections to the edge node, default 8.");
+
     /*
      * estimategas
      */
@@ -1007,6 +1027,18 @@ int parse_execute_command(const char * config_file_extra, int argc, char * argv[
         }
         db_prune::DbPrune::instance().compact_db(dbdir, out_str);
     });
+    auto cmd_db_cfmigrate = db->add_subcommand("cfmigrate", "migrate database to column families by key type.");
+    std::string cfmigrate_dir{};
+    cmd_db_cfmigrate->add_option("-d,--dir", cfmigrate_dir, "Database directory which to migrate.");
+    cmd_db_cfmigrate->callback([&]() {
+        std::string dbdir;
+        if (!cfmigrate_dir.empty()) {
+            dbdir = cfmigrate_dir;
+        } else {
+            dbdir = config_extra_json["datadir"].get<std::string>();
+        }
+        db_prune::DbPrune::instance().migrate_cf(dbdir, out_str);
+    });
     auto cmd_db_convert = db->add_subcommand("convert", "convert database.");
     std::string convert_dir;
     cmd_db_convert->add_option("-d,--dir", convert_dir, "Database directory which to convert.")->mandatory();
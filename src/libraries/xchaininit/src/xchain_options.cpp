@@ -1,4 +1,5 @@
 #include "xchaininit/xchain_options.h"
+#include "xchaininit/xallocator_profile.h"
 
 #if defined(ENABLE_TCMALLOC)
 #include <thread>
@@ -124,5 +125,7 @@ namespace top
 #ifdef ENABLE_TCMALLOC
         setup_tcmalloc();
 #endif
+
+        setup_allocator();
     }
 } // namespace top
\ No newline at end of file
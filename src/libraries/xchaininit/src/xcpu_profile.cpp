@@ -0,0 +1,97 @@
+#include "xchaininit/xcpu_profile.h"
+
+#include "xbase/xlog.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sys/prctl.h>
+#endif
+
+#if defined(ENABLE_GPERF) || defined(ENABLE_GHPERF)
+#include "gperftools/profiler.h"
+#endif
+
+namespace top {
+
+namespace {
+
+#if defined(ENABLE_GPERF) || defined(ENABLE_GHPERF)
+// called by the profiler from its SIGPROF handler, so only a syscall and no allocation
+int profile_thread_filter(void * arg) {
+    char name[16] = {0};
+    ::prctl(PR_GET_NAME, name, 0, 0, 0);
+    auto const * thread_prefix = static_cast<std::string const *>(arg);
+    return std::strncmp(name, thread_prefix->c_str(), thread_prefix->size()) == 0;
+}
+#endif
+
+}  // namespace
+
+bool cpu_profile(std::string const & prefix, uint32_t seconds, std::string const & thread_prefix, std::string & result) {
+#if defined(ENABLE_GPERF) || defined(ENABLE_GHPERF)
+    // the profiler is process wide, also switched by SIGUSR2 of setGperfStatus
+    static std::mutex profile_mutex;
+    std::unique_lock<std::mutex> lock(profile_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        result = "another cpu profile is running";
+        return false;
+    }
+
+    std::string path = prefix + "." + std::to_string(::getpid()) + "." +
+                       std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()) + ".prof";
+    ProfilerOptions options;
+    std::memset(&options, 0, sizeof(options));
+    if (!thread_prefix.empty()) {
+        options.filter_in_thread = profile_thread_filter;
+        options.filter_in_thread_arg = const_cast<std::string *>(&thread_prefix);
+    }
+    if (!::ProfilerStartWithOptions(path.c_str(), &options)) {
+        result = "cpu profiler is already on, started by SIGUSR2 or CPUPROFILE";
+        return false;
+    }
+    xkinfo("cpu_profile start %s seconds:%u threads:%s", path.c_str(), seconds, thread_prefix.c_str());
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    ::ProfilerStop();
+
+    std::ofstream threads(path + ".threads", std::ios::out | std::ios::trunc);
+    threads << thread_names();
+    result = path;
+    return true;
+#else
+    (void)prefix;
+    (void)seconds;
+    (void)thread_prefix;
+    result = "cpu profiles need a build with BUILD_GPERF or BUILD_GHPERF";
+    return false;
+#endif
+}
+
+std::string thread_names() {
+    std::string names;
+#if defined(__linux__)
+    DIR * dir = ::opendir("/proc/self/task");
+    if (dir == nullptr) {
+        return names;
+    }
+    while (struct dirent * entry = ::readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+        std::string name;
+        std::getline(comm, name);
+        names += std::string(entry->d_name) + " " + name + "\n";
+    }
+    ::closedir(dir);
+#endif
+    return names;
+}
+
+}  // namespace top
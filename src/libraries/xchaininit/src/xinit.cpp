@@ -13,6 +13,9 @@
 #include "xchaininit/xconfig.h"
 #include "xchaininit/xchain_options.h"
 #include "xchaininit/xchain_params.h"
+#include "xchaininit/xmemory_monitor.h"
+#include "xbasic/xasync_log.h"
+#include "xbasic/xthreading/xthread_affinity.h"
 #include "xbase/xutl.h"
 #include "xbase/xhash.h"
 #include "xpbase/base/top_utils.h"
@@ -22,6 +25,7 @@
 #include "xloader/xconfig_offchain_loader.h"
 #include "xloader/xconfig_genesis_loader.h"
 #include "xmetrics/xmetrics.h"
+#include "xmetrics/xhot_accounts.h"
 #include "xapplication/xapplication.h"
 #include "xchaininit/admin_http.h"
 #include "xtopcl/include/global_definition.h"
@@ -113,6 +117,7 @@ void on_sys_signal_callback(int signum, siginfo_t *info, void *ptr)
         {
             printf("on_sys_signal_callback:capture core_signal(%d)\n",signum);
             xwarn("on_sys_signal_callback:capture core_signal(%d)",signum);
+            top::basic::xasync_log_t::instance().flush();
             
             //trigger save data before coredump
             top::base::xvchain_t::instance().on_process_close();
@@ -130,6 +135,7 @@ void on_sys_signal_callback(int signum, siginfo_t *info, void *ptr)
         {
             printf("on_sys_signal_callback:capture terminate_signal(%d) \n",signum);
             xwarn("on_sys_signal_callback:capture terminate_signal(%d)",signum);
+            top::basic::xasync_log_t::instance().flush();
             
             //trigger save data before terminate
             top::base::xvchain_t::instance().on_process_close();
@@ -246,6 +252,10 @@ int topchain_start(const std::string& config_file) {
     std::cout << "account: " << global_node_id << std::endl;
     xinit_log(log_path.c_str(), true, true);
     xset_log_level((enum_xlog_level)log_level);
+    // before any pool starts, a pool thread is pinned when it is named
+    threading::xthread_affinity_t::instance().configure(XGET_CONFIG(thread_cpu_affinity));
+    basic::xasync_log_t::instance().set_level(log_level);
+    basic::xasync_log_t::instance().start();
     auto xbase_info = base::xcontext_t::get_xbase_info();
     xwarn("=== topio start here ===");
     xwarn("=== xbase info: %s ===", xbase_info.c_str());
@@ -255,9 +265,8 @@ int topchain_start(const std::string& config_file) {
 
     //wait log path created,and init metrics
     XMETRICS_INIT2(log_path);
-
-    // init checkpoint
-    data::xchain_checkpoint_t::load();
+    XMETRICS_HOT_ACCOUNTS_SAMPLE_RATE(XGET_CONFIG(hot_account_sample_rate));
+    setup_memory_monitor();
 
     //init data_path into xvchain instance
     //init auto_prune feature
@@ -308,6 +317,8 @@ int topchain_start(const std::string& config_file) {
     }
 
     xinfo("==== app start done ===");
+    // threads not named through xthread_name.h, e.g. rocksdb's background jobs
+    xkinfo("topchain_init pinned %zu threads by thread_cpu_affinity", threading::xthread_affinity_t::instance().apply_all_threads());
 
     std::cout << std::endl
         << "#####################################################################" << std::endl
@@ -0,0 +1,106 @@
+#include "xchaininit/xmemory_monitor.h"
+
+#include "xbase/xlog.h"
+#include "xbasic/xmemory_accounting.h"
+#include "xbasic/xthreading/xthread_name.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
+#include "xmetrics/xmetrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace top {
+
+std::map<std::string, uint64_t> parse_memory_soft_limits(std::string const & limits) {
+    std::map<std::string, uint64_t> result;
+    std::stringstream items(limits);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        item.erase(std::remove(item.begin(), item.end(), ' '), item.end());
+        auto const colon = item.find(':');
+        if (colon == std::string::npos || colon == 0) {
+            if (!item.empty()) {
+                xwarn("parse_memory_soft_limits ignore %s, expect name:MB", item.c_str());
+            }
+            continue;
+        }
+        result[item.substr(0, colon)] = std::strtoull(item.c_str() + colon + 1, nullptr, 10) * 1024 * 1024;
+    }
+    return result;
+}
+
+std::string memory_usage_json() {
+    nlohmann::json subsystems = nlohmann::json::array();
+    uint64_t total_bytes = 0;
+    for (auto const & usage : basic::xmemory_accounting_t::instance().usages()) {
+        nlohmann::json subsystem;
+        subsystem["name"] = usage.name;
+        subsystem["bytes"] = usage.bytes;
+        subsystem["objects"] = usage.objects;
+        subsystem["soft_limit"] = usage.soft_limit;
+        subsystem["shrinkable"] = usage.shrinkable;
+        subsystem["shrinks"] = usage.shrinks;
+        subsystems.push_back(subsystem);
+        total_bytes += usage.bytes;
+    }
+
+    nlohmann::json result;
+    result["subsystems"] = subsystems;
+    result["total_bytes"] = total_bytes;
+    return result.dump(4);
+}
+
+static void export_memory_metrics(std::vector<basic::xmemory_subsystem_usage_t> const & usages) {
+#ifdef ENABLE_METRICS
+    int64_t total_bytes = 0;
+    for (auto const & usage : usages) {
+        XMETRICS_COUNTER_SET("memory_" + usage.name + "_bytes", static_cast<int64_t>(usage.bytes));
+        XMETRICS_COUNTER_SET("memory_" + usage.name + "_objects", static_cast<int64_t>(usage.objects));
+        if (usage.soft_limit > 0) {
+            XMETRICS_COUNTER_SET("memory_" + usage.name + "_soft_limit", static_cast<int64_t>(usage.soft_limit));
+            XMETRICS_COUNTER_SET("memory_" + usage.name + "_shrinks", static_cast<int64_t>(usage.shrinks));
+        }
+        total_bytes += static_cast<int64_t>(usage.bytes);
+    }
+    XMETRICS_COUNTER_SET("memory_total_bytes", total_bytes);
+#else
+    (void)usages;
+#endif
+}
+
+void setup_memory_monitor() {
+    auto & accounting = basic::xmemory_accounting_t::instance();
+    for (auto const & limit : parse_memory_soft_limits(XGET_CONFIG(memory_soft_limits))) {
+        xkinfo("setup_memory_monitor soft limit of %s: %" PRIu64 " bytes", limit.first.c_str(), limit.second);
+        accounting.set_soft_limit(limit.first, limit.second);
+    }
+
+    auto const interval = std::chrono::seconds(std::max<uint32_t>(XGET_CONFIG(memory_check_interval_s), 1));
+    std::thread([interval] {
+        threading::set_current_thread_name("memory_monitor");
+        for (;;) {
+            std::this_thread::sleep_for(interval);
+            auto const usages = basic::xmemory_accounting_t::instance().enforce_soft_limits();
+            for (auto const & usage : usages) {
+                if (usage.soft_limit > 0 && usage.bytes > usage.soft_limit) {
+                    xkinfo("memory of %s %" PRIu64 " over soft limit %" PRIu64 "%s",
+                           usage.name.c_str(),
+                           usage.bytes,
+                           usage.soft_limit,
+                           usage.shrinkable ? ", shrinking" : ", cannot shrink");
+                }
+            }
+            export_memory_metrics(usages);
+        }
+    }).detach();
+}
+
+}  // namespace top
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace top {
+
+// the allocator linked in by the build: jemalloc (XUSE_JEMALLOC), tcmalloc (TCMALLOC, BUILD_GHPERF) or glibc
+std::string allocator_name();
+
+// human readable statistics of the allocator
+std::string allocator_stats();
+
+// writes a heap profile next to prefix and returns its path in result, or the reason it cannot in result.
+// jemalloc only profiles when the node runs with MALLOC_CONF=prof:true and a jemalloc built with --enable-prof,
+// tcmalloc only samples when TCMALLOC_SAMPLE_PARAMETER is set or the heap profiler of BUILD_GHPERF runs
+bool dump_heap_profile(std::string const & prefix, std::string & result);
+
+// like dump_heap_profile, but samples the allocations made during the next seconds only where the allocator can:
+// jemalloc resets and activates its profile for the window, the heap profiler of BUILD_GHPERF runs for the window,
+// tcmalloc dumps its live heap sample at the end of the window
+bool sample_heap_profile(std::string const & prefix, uint32_t seconds, std::string & result);
+
+// allocator gauges exported through xmetrics
+void export_allocator_metrics();
+
+// applies the tuned allocator settings and exports the gauges periodically
+void setup_allocator();
+
+}  // namespace top
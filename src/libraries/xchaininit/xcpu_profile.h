@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace top {
+
+// profiles cpu of the process for seconds and returns the profile path in result, or the reason it cannot in result.
+// needs a build with BUILD_GPERF or BUILD_GHPERF, which link the gperftools profiler.
+// a non-empty thread_prefix keeps only the samples of threads whose name starts with it, e.g. cons_worker or rpc_
+bool cpu_profile(std::string const & prefix, uint32_t seconds, std::string const & thread_prefix, std::string & result);
+
+// "tid name" of every thread of the process, one per line, names are set by threading::set_thread_name
+std::string thread_names();
+
+}  // namespace top
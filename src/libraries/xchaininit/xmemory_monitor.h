@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace top {
+
+// parses memory_soft_limits, "name:MB,name:MB", into bytes by subsystem name of basic::xmemory_accounting_t
+std::map<std::string, uint64_t> parse_memory_soft_limits(std::string const & limits);
+
+// memory of the caches and pools as json: every subsystem with its bytes, objects and soft limit, and the total
+std::string memory_usage_json();
+
+// applies the soft limits of memory_soft_limits, then every memory_check_interval_s shrinks the subsystems over
+// their limit and exports the memory of each subsystem through xmetrics
+void setup_memory_monitor();
+
+}  // namespace top
@@ -7,6 +7,7 @@
 #include "xgrpcservice/xgrpc_service.h"
 #include "xmbus/xevent_store.h"
 #include "xrpc/xrpc_query_manager.h"
+#include "xdata/xblock.h"
 #include "xdata/xblocktool.h"
 
 NS_BEG2(top, grpcmgr)
@@ -119,6 +120,28 @@ void xgrpc_mgr_t::process_event(const mbus::xevent_ptr_t & e) {
     xdbg("grpc stream xgetblock_handler tableblock_data after tableblock_cv.notify_one()");
 }
 
+xblock_stream_source_t::xblock_stream_source_t(base::xvblockstore_t * block_store) : m_block_store(block_store) {
+}
+
+uint64_t xblock_stream_source_t::get_latest_committed_height(std::string const & account) {
+    return m_block_store->get_latest_committed_block_height(base::xvaccount_t(account), metrics::blockstore_access_from_rpc_get_committed_block);
+}
+
+bool xblock_stream_source_t::load_committed_block(std::string const & account, uint64_t height, std::string & block_bin) {
+    auto vblock = m_block_store->load_block_object(base::xvaccount_t(account), height, base::enum_xvblock_flag_committed, true, metrics::blockstore_access_from_rpc_get_committed_block);
+    data::xblock_t * block = dynamic_cast<data::xblock_t *>(vblock.get());
+    if (block == nullptr) {
+        return false;
+    }
+    base::xstream_t stream(base::xcontext_t::instance());
+    if (block->full_block_serialize_to(stream) <= 0) {
+        xwarn("xblock_stream_source_t::load_committed_block fail-serialize.block=%s", block->dump().c_str());
+        return false;
+    }
+    block_bin.assign((const char *)stream.data(), stream.size());
+    return true;
+}
+
 handler_mgr::handler_mgr() {
 }
 
@@ -157,6 +180,7 @@ int grpc_init(base::xvblockstore_t * block_store, sync::xsync_face_t * sync, uin
     handle_mgr->add_handler(handle_store);
 
     grpc_srv->register_handle(handle_mgr);
+    grpc_srv->register_block_source(std::make_shared<xblock_stream_source_t>(block_store));
     grpc_srv->start();
 
     return 0;
@@ -45,6 +45,17 @@ private:
     std::atomic_uchar m_arc_count{0};
 };
 
+class xblock_stream_source_t : public top::rpc::xblock_stream_source_face_t {
+public:
+    explicit xblock_stream_source_t(base::xvblockstore_t * block_store);
+
+    uint64_t get_latest_committed_height(std::string const & account) override;
+    bool load_committed_block(std::string const & account, uint64_t height, std::string & block_bin) override;
+
+private:
+    base::xvblockstore_t * m_block_store;
+};
+
 class handler_mgr : public top::rpc::xrpc_handle_face_t {
 public:
     handler_mgr();
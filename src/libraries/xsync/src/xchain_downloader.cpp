@@ -10,6 +10,7 @@
 #include "xsync/xsync_util.h"
 #include "xdata/xnative_contract_address.h"
 #include "xdata/xgenesis_data.h"
+#include "xdata/xcheckpoint.h"
 #include "xpbase/base/top_utils.h"
 #include "xsync/xsync_message.h"
 #include "xdata/xfull_tableblock.h"
@@ -18,12 +19,19 @@
 #include "xsync/xsync_pusher.h"
 #include "xstatestore/xstatestore_face.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 NS_BEG2(top, sync)
 
 using namespace mbus;
 using namespace data;
 
 #define BATCH_SIZE 20
+#define PREFETCH_WINDOWS 3
+#define WINDOW_TIMEOUT_MS 10000
+#define VERIFY_WORKERS 4
 
 xchain_downloader_t::xchain_downloader_t(std::string vnode_id,
                                  xsync_store_face_t * sync_store,
@@ -141,6 +149,10 @@ bool xchain_downloader_t::on_timer(int64_t now) {
 }
 
 void xchain_downloader_t::on_response(std::vector<data::xblock_ptr_t> &blocks, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &from_addr) {
+    if (buffer_window(blocks, from_addr)) {
+        return;
+    }
+
     xsync_on_blocks_response_command_t command(blocks, self_addr, from_addr);
     xsync_info("chain_downloader on_response %s count(%u) %s, %d",
         m_address.c_str(), blocks.size(), from_addr.to_string().c_str(), m_task.finished());
@@ -304,14 +316,19 @@ void xchain_downloader_t::on_block_committed_event(uint64_t height) {
 enum_result_code xchain_downloader_t::pre_handle_block(
     std::vector<data::xblock_ptr_t> &blocks,
     uint64_t quota_height,
+    bool verify_each,
     std::vector<base::xvblock_t*> &processed_blocks) {
 
-    for (auto block : blocks){
-        if (m_is_elect_chain) {
-            if (!check_auth(m_certauth, block)) {
-                xsync_warn("chain_downloader check auth fail, block is: %s", block->dump().c_str());
-                return enum_result_code::auth_failed;
-            }
+    std::vector<bool> verified(blocks.size(), true);
+    if (verify_each) {
+        verify_blocks(blocks, verified);
+    }
+
+    for (uint32_t i = 0; i < blocks.size(); i++) {
+        xblock_ptr_t &block = blocks[i];
+        if (!verified[i]) {
+            xsync_warn("chain_downloader check auth fail, block is: %s", block->dump().c_str());
+            continue;
         }
 
         //temperary code
@@ -319,8 +336,8 @@ enum_result_code xchain_downloader_t::pre_handle_block(
         if (vbindex == nullptr) {
         //XTODO,need doublecheck whether allow set flag of authenticated without verify signature
             block->set_block_flag(enum_xvblock_flag_authenticated);
-            base::xvblock_t* vblock = dynamic_cast<base::xvblock_t*>(block.get());
             wait_committed_event_group(block->get_height(), quota_height);
+            processed_blocks.push_back(dynamic_cast<base::xvblock_t*>(block.get()));
         } else {
             if (vbindex->check_block_flag(enum_xvblock_flag_committed)) {
                 m_sync_store->get_shadow()->on_chain_event(block->get_block_owner(), block->get_height());
@@ -328,13 +345,79 @@ enum_result_code xchain_downloader_t::pre_handle_block(
                 wait_committed_event_group(block->get_height(), quota_height);
             }
         }
-
-        processed_blocks.push_back(dynamic_cast<base::xvblock_t*>(block.get()));
     }
 
     return enum_result_code::success;
 }
 
+void xchain_downloader_t::verify_blocks(std::vector<data::xblock_ptr_t> &blocks, std::vector<bool> &verified) {
+    if (blocks.empty()) {
+        return;
+    }
+
+    // blocks are independent of each other for multi-sign verification, split them to a few workers by stride
+    std::vector<char> results(blocks.size(), 0);
+    auto verify = [this, &blocks, &results](std::size_t worker, std::size_t workers) {
+        for (std::size_t i = worker; i < blocks.size(); i += workers) {
+            results[i] = check_auth(m_certauth, blocks[i]) ? 1 : 0;
+        }
+    };
+
+    std::size_t const hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const workers = std::min(std::min(blocks.size(), hardware_threads), (std::size_t)VERIFY_WORKERS);
+    std::vector<std::future<void>> futures;
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+        futures.push_back(std::async(std::launch::async, verify, worker, workers));
+    }
+    verify(0, workers);
+    for (auto & future : futures) {
+        future.get();
+    }
+
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+        verified[i] = results[i] != 0;
+    }
+}
+
+bool xchain_downloader_t::linked_below_checkpoint(std::vector<data::xblock_ptr_t> &blocks, bool &anchored) {
+    anchored = false;
+
+    std::error_code ec;
+    auto const checkpoint = data::xchain_checkpoint_t::get_latest_checkpoint(common::xaccount_address_t{m_address}, ec);
+    if (ec || checkpoint.height == 0 || blocks.back()->get_height() > checkpoint.height) {
+        return false;
+    }
+
+    // every block must match its own hash and be linked to the previous one
+    for (auto & block : blocks) {
+        if (!block->is_valid(true)) {
+            xsync_dbg("chain_downloader block invalid below checkpoint, block is: %s", block->dump().c_str());
+            return false;
+        }
+    }
+    if (!sync_blocks_continue_check(blocks, m_address, true)) {
+        return false;
+    }
+
+    // the range is trusted if it ends at the checkpoint block, or links up to a committed block below the checkpoint
+    xblock_ptr_t &last_block = blocks.back();
+    if (last_block->get_height() == checkpoint.height) {
+        anchored = (last_block->get_block_hash() == checkpoint.hash);
+    } else {
+        auto successor = m_sync_store->load_block_object(m_address, last_block->get_height() + 1, false);
+        anchored = (successor != nullptr && successor->check_block_flag(enum_xvblock_flag_committed) &&
+                    successor->get_last_block_hash() == last_block->get_block_hash());
+    }
+
+    if (anchored) {
+        for (auto & block : blocks) {
+            block->reset_block_flags();
+            block->set_block_flag(enum_xvblock_flag_authenticated);
+        }
+    }
+    return true;
+}
+
 enum_result_code xchain_downloader_t::handle_block(xblock_ptr_t &block, uint64_t quota_height) {
     if (m_is_elect_chain) {
         if (!check_auth(m_certauth, block)) {
@@ -407,7 +490,8 @@ bool xchain_downloader_t::send_request(int64_t now) {
         return m_sync_sender->send_get_blocks(m_request->owner, m_request->start_height, m_request->count, m_request->self_addr, m_request->target_addr);
     }
 
-    std::vector<vnetwork::xvnode_address_t> addresses = m_role_xips_mgr->get_rand_archives(1);
+    std::vector<vnetwork::xvnode_address_t> addresses = m_role_xips_mgr->get_rand_archives(PREFETCH_WINDOWS);
+    m_role_xips_mgr->peer_score().sort(addresses);
     if (addresses.empty()) {
         xsync_info("xchain_downloader_t::send_request, not find archive.");
         return false;
@@ -467,6 +551,25 @@ xsync_command_execute_result xchain_downloader_t::handle_next(uint64_t current_h
     if (count > 0) {
         int64_t now = get_time();
 
+        // the range may be requested already as a window ahead, take it instead of asking again
+        auto it = m_windows.find(start_height);
+        if (it != m_windows.end()) {
+            xchain_window_t window = it->second;
+            m_windows.erase(it);
+            if (!window.blocks.empty()) {
+                m_request = window.request;
+                m_request->send_time = now - window.cost;
+                xsync_info("chain_downloader take window %s,range[%lu,%lu] %s",
+                    m_address.c_str(), start_height, start_height + window.blocks.size() - 1, window.from_addr.to_string().c_str());
+                return execute_next_download(window.blocks, window.request->self_addr, window.from_addr);
+            }
+            if (window.request->count == count && now - window.request->send_time <= WINDOW_TIMEOUT_MS) {
+                m_request = window.request;
+                prefetch_windows(start_height + count, self_addr, target_addr, now);
+                return wait_response;
+            }
+        }
+
         xentire_block_request_ptr_t req = create_request(start_height, count);
         if (req != nullptr) {
             req->self_addr = self_addr;
@@ -476,6 +579,7 @@ xsync_command_execute_result xchain_downloader_t::handle_next(uint64_t current_h
             req->send_time = 0;
             m_request = req;
             if (send_request(now)){
+                prefetch_windows(start_height + count, self_addr, target_addr, now);
                 return wait_response;
             } else {
                 return abort_overflow;
@@ -507,6 +611,7 @@ bool xchain_downloader_t::handle_fulltable(uint64_t fulltable_height_of_tablecha
 
 void xchain_downloader_t::clear() {
     m_request = nullptr;
+    m_windows.clear();
     m_sync_range_mgr.clear_behind_info();
     init_committed_event_group();
 }
@@ -564,6 +669,104 @@ xentire_block_request_ptr_t xchain_downloader_t::create_request(uint64_t start_h
     return ptr;
 }
 
+bool xchain_downloader_t::buffer_window(std::vector<data::xblock_ptr_t> &blocks, const vnetwork::xvnode_address_t &from_addr) {
+    if (blocks.empty()) {
+        return false;
+    }
+
+    auto it = m_windows.find(blocks[0]->get_height());
+    if (it == m_windows.end() || !it->second.blocks.empty()) {
+        return false;
+    }
+
+    xchain_window_t &window = it->second;
+    window.blocks = blocks;
+    window.from_addr = from_addr;
+    window.cost = get_time() - window.request->send_time;
+    XMETRICS_COUNTER_INCREMENT("sync_downloader_prefetch_response", 1);
+    xsync_info("chain_downloader buffer window %s,range[%lu,%lu] cost(%ldms) %s",
+        m_address.c_str(), it->first, it->first + blocks.size() - 1, window.cost, from_addr.to_string().c_str());
+    return true;
+}
+
+void xchain_downloader_t::prefetch_windows(uint64_t start_height, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr, int64_t now) {
+    // drop windows already passed, and the timed-out ones so they are asked again from another peer
+    for (auto it = m_windows.begin(); it != m_windows.end();) {
+        xchain_window_t &window = it->second;
+        if (it->first < start_height) {
+            it = m_windows.erase(it);
+        } else if (window.blocks.empty() && now - window.request->send_time > WINDOW_TIMEOUT_MS) {
+            xsync_info("chain_downloader window timeout %s,range[%lu,%lu] %s",
+                m_address.c_str(), it->first, it->first + window.request->count - 1, window.request->target_addr.to_string().c_str());
+            m_role_xips_mgr->peer_score().on_failure(window.request->target_addr);
+            it = m_windows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    uint64_t behind_height = m_sync_range_mgr.get_behind_height();
+    if (start_height > behind_height) {
+        return;
+    }
+
+    std::vector<vnetwork::xvnode_address_t> peers = pick_peers(self_addr, target_addr);
+    if (peers.empty()) {
+        return;
+    }
+
+    uint32_t peer_index = 0;
+    for (uint32_t i = 0; i < PREFETCH_WINDOWS && start_height <= behind_height; i++, start_height += BATCH_SIZE) {
+        if (m_windows.find(start_height) != m_windows.end()) {
+            continue;
+        }
+
+        if (!m_ratelimit->get_token(now)) {
+            XMETRICS_COUNTER_INCREMENT("xsync_downloader_overflow", 1);
+            break;
+        }
+
+        uint32_t count = (behind_height - start_height + 1) > BATCH_SIZE ? BATCH_SIZE : (behind_height - start_height + 1);
+        xentire_block_request_ptr_t req = create_request(start_height, count);
+        req->self_addr = self_addr;
+        req->target_addr = peers[peer_index++ % peers.size()];
+        req->create_time = now;
+        req->try_time = 0;
+        req->send_time = now;
+        if (!m_sync_sender->send_get_blocks(req->owner, req->start_height, req->count, req->self_addr, req->target_addr)) {
+            continue;
+        }
+
+        XMETRICS_COUNTER_INCREMENT("sync_downloader_prefetch_request", 1);
+        xsync_info("chain_downloader send prefetch request(block). %s,range[%lu,%lu] %s",
+            m_address.c_str(), req->start_height, req->start_height + req->count - 1, req->target_addr.to_string().c_str());
+        m_windows[start_height].request = req;
+    }
+}
+
+std::vector<vnetwork::xvnode_address_t> xchain_downloader_t::pick_peers(const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr) {
+    std::vector<vnetwork::xvnode_address_t> candidates;
+    if (common::has<common::xnode_type_t::fullnode>(self_addr.type())) {
+        candidates = m_role_xips_mgr->get_rand_archives(PREFETCH_WINDOWS);
+    } else {
+        candidates = m_role_xips_mgr->get_rand_neighbors(self_addr, PREFETCH_WINDOWS);
+        if (std::find(candidates.begin(), candidates.end(), target_addr) == candidates.end()) {
+            candidates.push_back(target_addr);
+        }
+    }
+
+    xsync_peer_score_t &peer_score = m_role_xips_mgr->peer_score();
+    peer_score.sort(candidates);
+    while (!candidates.empty() && peer_score.score(candidates.back()) == xsync_peer_score_t::deceit_score) {
+        candidates.pop_back();
+    }
+
+    if (candidates.size() > PREFETCH_WINDOWS) {
+        candidates.resize(PREFETCH_WINDOWS);
+    }
+    return candidates;
+}
+
 xsync_command_execute_result xchain_downloader_t::execute_download(uint64_t start_height, uint64_t end_height, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr, const std::string &reason) {
     std::string account_prefix;
     uint32_t table_id = 0;
@@ -652,6 +855,7 @@ xsync_command_execute_result xchain_downloader_t::execute_next_download(std::vec
         m_address.c_str(), count, total_cost, from_addr.to_string().c_str());
 
     m_ratelimit->feedback(total_cost, now);
+    m_role_xips_mgr->peer_score().on_response(from_addr, total_cost, count);
     XMETRICS_COUNTER_INCREMENT("sync_downloader_response", 1);
     XMETRICS_COUNTER_INCREMENT("sync_cost_peer_response", total_cost);
 
@@ -665,11 +869,18 @@ xsync_command_execute_result xchain_downloader_t::execute_next_download(std::vec
         return ignore;
     }
 
-    // 1.verify shard-table block multi-sign
-    if (!m_is_elect_chain){
+    // 1.verify multi-sign, blocks hash-linked to a trusted checkpoint need none,
+    // other blocks below the checkpoint only need the last one of the range as shard-table blocks
+    bool anchored = false;
+    bool linked = linked_below_checkpoint(blocks, anchored);
+    bool verify_each = m_is_elect_chain && !linked;
+    if (anchored) {
+        XMETRICS_COUNTER_INCREMENT("sync_downloader_checkpoint_anchored", count);
+    } else if (!verify_each) {
         xblock_ptr_t &block = blocks[count-1];
         if (!check_auth(m_certauth, block)) {
             xsync_info("chain_downloader on_response(auth_failed) %s,height=%lu,", m_address.c_str(), block->get_height());
+            m_role_xips_mgr->peer_score().on_failure(from_addr);
             return ignore;
         }
     }
@@ -687,30 +898,14 @@ xsync_command_execute_result xchain_downloader_t::execute_next_download(std::vec
 
     auto next_block = blocks[blocks.size() - 1];
     init_committed_event_group();
-    #if 0
-    std::vector<top::base::xvblock_t *> processed_blocks;
-    enum_result_code ret = pre_handle_block(blocks, m_is_elect_chain, next_block->get_height(), processed_blocks);
-    if (ret != enum_result_code::success) {
-        init_committed_event_group();
-        return abort;
-    }
 
+    // 2.verify multi-sign of blocks in parallel, then store the new ones in height order by one batch
+    std::vector<top::base::xvblock_t *> processed_blocks;
+    pre_handle_block(blocks, next_block->get_height(), verify_each, processed_blocks);
     if (!m_sync_store->store_blocks(processed_blocks)) {
-        xsync_warn("chain_downloader on_response(failed) fail to store blocks");
-    }
-    #endif
-
-    // compare before and after
-    for (uint32_t i = 0; i < count; i++) {
-        xblock_ptr_t &block = blocks[i];
-        enum_result_code ret = handle_block(block, next_block->get_height());
-
-        if (ret == enum_result_code::success) {
-            xsync_dbg("chain_downloader on_response(succ) %s,height=%lu,viewid=%lu,prev_hash:%s,",
-                m_address.c_str(), block->get_height(), block->get_viewid(), to_hex_str(block->get_last_block_hash()).c_str());
-        } else if (ret == enum_result_code::failed) {
-            xsync_warn("chain_downloader on_response(failed) reason %d, block is: %s", ret, block->dump().c_str());
-        }
+        xsync_warn("chain_downloader on_response(failed) fail to store blocks %s, count %zu", m_address.c_str(), processed_blocks.size());
+    } else {
+        xsync_dbg("chain_downloader on_response(succ) %s, stored count %zu", m_address.c_str(), processed_blocks.size());
     }
 
     if (sync_policy == enum_chain_sync_policy_fast) {
@@ -1,5 +1,7 @@
 #include "xsync/xrole_chains.h"
 
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xdata/xnative_contract_address.h"
 #include "xsync/xsync_log.h"
 
@@ -58,6 +60,11 @@ void xrole_chains_t::init_chains() {
     add_tables(nt::fullnode, sys_contract_sharding_table_block_addr, enum_chain_sync_policy_checkpoint);
     add_chain(nt::fullnode, sys_contract_relay_table_block_addr, enum_chain_sync_policy_full);
     add_chain(nt::fullnode, sys_contract_eth_table_block_addr_with_suffix, enum_chain_sync_policy_full);
+
+    // edges answering the eth reads themselves follow the eth table
+    if (XGET_CONFIG(edge_local_query)) {
+        add_chain(nt::edge, sys_contract_eth_table_block_addr_with_suffix, enum_chain_sync_policy_fast);
+    }
 }
 
 void xrole_chains_t::add_chain(common::xnode_type_t allow_types,
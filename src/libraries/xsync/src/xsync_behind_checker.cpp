@@ -20,10 +20,18 @@ void xsync_behind_checker_t::on_timer() {
     }
     
     m_counter++;
-    if (m_counter %10 != 0)
+    if (m_counter - m_last_check_counter < m_check_interval)
         return;
+    m_last_check_counter = m_counter;
+
+    bool dump_metrics = false;
+    if (m_counter - m_last_dump_counter >= dump_metrics_interval) {
+        dump_metrics = true;
+        m_last_dump_counter = m_counter;
+    }
 
     std::string reason = "timer_check";
+    bool behind = false;
 
     xsync_roles_t roles = m_role_chains_mgr->get_roles();
     for (const auto &role_it: roles) {
@@ -36,9 +44,39 @@ void xsync_behind_checker_t::on_timer() {
             const std::string &address = it.first;
             enum_chain_sync_policy sync_policy = it.second.sync_policy;
 
-            check_one(address, sync_policy, self_addr, reason);
+            if (check_one(address, sync_policy, self_addr, reason, dump_metrics) > 0) {
+                behind = true;
+            }
         }
     }
+
+    if (behind) {
+        m_check_interval = min_check_interval;
+    } else {
+        m_check_interval *= 2;
+        if (m_check_interval > max_check_interval)
+            m_check_interval = max_check_interval;
+    }
+}
+
+void xsync_behind_checker_t::on_chain_state(const vnetwork::xvnode_address_t &self_addr, const std::vector<xchain_state_info_t> &info_list) {
+    std::shared_ptr<xrole_chains_t> role_chains = m_role_chains_mgr->get_role(self_addr);
+    if (role_chains == nullptr)
+        return;
+
+    std::string reason = "announce_check";
+    const map_chain_info_t &chains = role_chains->get_chains_wrapper().get_chains();
+    for (auto &info : info_list) {
+        auto it = chains.find(info.address);
+        if (it == chains.end())
+            continue;
+
+        enum_chain_sync_policy sync_policy = it->second.sync_policy;
+        if (info.end_height <= m_sync_store->get_latest_end_block_height(info.address, sync_policy))
+            continue;
+
+        check_one(info.address, sync_policy, self_addr, reason);
+    }
 }
 
 void xsync_behind_checker_t::on_behind_check_event(const mbus::xevent_ptr_t &e) {
@@ -75,7 +113,7 @@ void xsync_behind_checker_t::on_behind_check_event(const mbus::xevent_ptr_t &e)
     }
 }
 
-void xsync_behind_checker_t::check_one(const std::string &address, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const std::string &reason) {
+uint64_t xsync_behind_checker_t::check_one(const std::string &address, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const std::string &reason, bool dump_metrics) {
 
     uint64_t latest_start_block_height = m_sync_store->get_latest_start_block_height(address, sync_policy);
     uint64_t latest_end_block_height = m_sync_store->get_latest_end_block_height(address, sync_policy);
@@ -87,7 +125,7 @@ void xsync_behind_checker_t::check_one(const std::string &address, enum_chain_sy
 
     if (m_peerset->get_newest_peer(self_addr, address, peer_start_height, peer_end_height, peer_addr)) {
         xsync_dbg("xsync_behind_checker_t::check_one, %d, %s,%llu,%llu,%llu,%llu,%s", sync_policy, address.c_str(), latest_start_block_height, latest_end_block_height, peer_start_height, peer_end_height, peer_addr.to_string().c_str());
-        if ((m_counter % 120) == 0) {
+        if (dump_metrics) {
             std::string sync_mode;
             std::string gap_metric_tag_name;
             if (sync_policy == enum_chain_sync_policy_fast) {
@@ -126,17 +164,17 @@ void xsync_behind_checker_t::check_one(const std::string &address, enum_chain_sy
         }
 
         if (peer_end_height == 0)
-            return;
+            return 0;
 
         if (latest_end_block_height >= peer_end_height) {
             if (sync_policy == enum_chain_sync_policy_fast) {
                 auto latest_start_block = m_sync_store->get_latest_start_block(address, sync_policy);
                 data::xblock_ptr_t block = autoptr_to_blockptr(latest_start_block);
                 if (block->is_full_state_block()) {
-                    return;
+                    return 0;
                 }
             } else {
-                return;
+                return 0;
             }
         }
         
@@ -151,7 +189,10 @@ void xsync_behind_checker_t::check_one(const std::string &address, enum_chain_sy
 
         mbus::xevent_ptr_t ev = make_object_ptr<mbus::xevent_behind_download_t>(address, fix_start_block_height, fix_end_block_height, sync_policy, self_addr, peer_addr, reason);
         m_downloader->push_event(ev);
+        return (peer_end_height > latest_end_block_height) ? (peer_end_height - latest_end_block_height) : 1;
     }
+
+    return 0;
 }
 
 NS_END2
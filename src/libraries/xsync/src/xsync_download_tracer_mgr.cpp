@@ -19,6 +19,10 @@ void xsync_download_tracer::set_trace_height(const uint64_t trace_height) {
     m_trace_height = trace_height;
 }
 
+void xsync_download_tracer::set_height_interval(const std::pair<uint64_t, uint64_t> expect_height_interval) {
+    m_expect_height_interval = expect_height_interval;
+}
+
 const uint64_t xsync_download_tracer::trace_height() {
     return m_trace_height;
 }
@@ -110,6 +114,53 @@ bool xsync_download_tracer_mgr::get(const std::string account, xsync_download_tr
     return false;
 }
 
+bool xsync_download_tracer_mgr::merge(std::string account, std::pair<uint64_t, uint64_t> expect_height_interval) {
+    uint64_t now = xtime_utl::gmttime_ms();
+    std::lock_guard<std::mutex> lck(m_lock);
+    expire(now);
+    auto it = m_tracers.find(account);
+    if (it == m_tracers.end()) {
+        return false;
+    }
+
+    // the download only goes up from the start of the interval
+    std::pair<uint64_t, uint64_t> interval = it->second.height_interval();
+    if (expect_height_interval.first < interval.first || expect_height_interval.first > interval.second + 1) {
+        return false;
+    }
+
+    if (expect_height_interval.second > interval.second) {
+        interval.second = expect_height_interval.second;
+        it->second.set_height_interval(interval);
+    }
+    return true;
+}
+
+void xsync_download_tracer_mgr::set_missing(std::string account, uint64_t height) {
+    uint64_t now = xtime_utl::gmttime_ms();
+    std::lock_guard<std::mutex> lck(m_lock);
+    if (m_missing.size() >= m_max_missing_capacity && m_missing.find(account) == m_missing.end()) {
+        m_missing.clear();
+    }
+    m_missing[account] = std::make_pair(height, now);
+}
+
+bool xsync_download_tracer_mgr::is_missing(std::string account, uint64_t height) {
+    uint64_t now = xtime_utl::gmttime_ms();
+    std::lock_guard<std::mutex> lck(m_lock);
+    auto it = m_missing.find(account);
+    if (it == m_missing.end()) {
+        return false;
+    }
+
+    if (now - it->second.second >= m_missing_expire_time) {
+        m_missing.erase(it);
+        return false;
+    }
+
+    return height >= it->second.first;
+}
+
 void xsync_download_tracer_mgr::expire() {
     uint64_t now = xtime_utl::gmttime_ms();
     std::lock_guard<std::mutex> lck(m_lock);
@@ -612,6 +612,7 @@ void xsync_handler_t::broadcast_chain_state(uint32_t msg_size, const vnetwork::x
 
     // 1. update local peers
     m_peer_keeper->handle_message(network_self, from_address, info_list);
+    m_behind_checker->on_chain_state(network_self, info_list);
 
     std::shared_ptr<xrole_chains_t> role_chains = m_role_chains_mgr->get_role(network_self);
     if (role_chains == nullptr) {
@@ -682,6 +683,7 @@ void xsync_handler_t::response_chain_state(uint32_t msg_size, const vnetwork::xv
         msg_hash, get_time()-recv_time, (uint32_t)info_list.size(), from_address.to_string().c_str());
 
     m_peer_keeper->handle_message(network_self, from_address, info_list);
+    m_behind_checker->on_chain_state(network_self, info_list);
 }
 
 void xsync_handler_t::cross_cluster_chain_state(uint32_t msg_size, const vnetwork::xvnode_address_t &from_address,
@@ -1020,6 +1022,7 @@ void xsync_handler_t::handle_consensus_result(const mbus::xevent_ptr_t& e) {
     xsync_info("xsync_handler on_consensus_block %s", block->dump().c_str());
 
     m_sync_pusher->push_newblock_to_archive(block);
+    m_peer_keeper->announce_chain(address);
 }
 
 void xsync_handler_t::handle_chain_snapshot_request(
@@ -1371,6 +1374,7 @@ int64_t xsync_handler_t::get_time() {
 void xsync_handler_t::notify_deceit_node(const vnetwork::xvnode_address_t& address) {
     xsync_warn("xsync_handler deceit_node %s", address.to_string().c_str());
     m_blacklist->add_deceit_node(address);
+    m_role_xips_mgr->peer_score().on_deceit(address);
     m_role_xips_mgr->remove_xips_by_id(address.node_id());
 }
 
@@ -1458,7 +1462,11 @@ void xsync_handler_t::on_block_response_process(uint32_t msg_size,
         if (response_ptr->get_requeset_param_type() == enum_sync_block_by_hash) {
             m_sync_on_demand->handle_blocks_response_with_hash(reuqest_ptr, blocks_vec, from_address, network_self);
         } else if (response_ptr->get_requeset_param_type() == enum_sync_block_by_height) {
-            m_sync_on_demand->handle_blocks_response_with_params(blocks_vec, response_ptr->get_extend_data(), from_address, network_self);
+            if (blocks_vec.empty()) {
+                m_sync_on_demand->handle_empty_blocks_response(reuqest_ptr, from_address, network_self);
+            } else {
+                m_sync_on_demand->handle_blocks_response_with_params(blocks_vec, response_ptr->get_extend_data(), from_address, network_self);
+            }
         } else if (response_ptr->get_requeset_param_type() == enum_sync_block_by_txhash) {
             m_sync_on_demand->handle_blocks_by_hash_response(blocks_vec, from_address, network_self);
         }
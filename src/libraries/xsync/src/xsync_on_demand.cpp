@@ -18,6 +18,8 @@ NS_BEG2(top, sync)
 
 using namespace data;
 
+#define ON_DEMAND_CANDIDATES 3
+
 xsync_on_demand_t::xsync_on_demand_t(std::string vnode_id, const observer_ptr<mbus::xmessage_bus_face_t> &mbus, const observer_ptr<base::xvcertauth_t> &certauth,
         xsync_store_face_t *sync_store, xrole_chains_mgr_t *role_chains_mgr, xrole_xips_manager_t *role_xips_mgr, xsync_sender_t *sync_sender):
 m_vnode_id(vnode_id),
@@ -48,20 +50,35 @@ void xsync_on_demand_t::on_behind_event(const mbus::xevent_ptr_t &e) {
         return;
     }
 
+    if (m_download_tracer.is_missing(address, start_height)) {
+        xsync_info("xsync_on_demand_t::on_behind_event peers have no block recently %s,height=%lu", address.c_str(), start_height);
+        XMETRICS_COUNTER_INCREMENT("xsync_on_demand_download_missing", 1);
+        return;
+    }
+
+    // a download of the same account is in flight, let it go on to cover this request too
+    if (m_download_tracer.merge(address, std::make_pair(start_height, start_height + count - 1))) {
+        xsync_info("xsync_on_demand_t::on_behind_event merged into the download in flight %s,range(%lu,%lu)",
+            address.c_str(), start_height, start_height + count - 1);
+        XMETRICS_COUNTER_INCREMENT("xsync_on_demand_download_coalesced", 1);
+        return;
+    }
+
     vnetwork::xvnode_address_t self_addr;
     if (!m_role_xips_mgr->get_self_addr(self_addr)) {
         xsync_warn("xsync_on_demand_t::on_behind_event get self addr failed %s,reason:%s", address.c_str(), reason.c_str());
         return;
     }
 
-    // only one archive node
+    // only one archive node, the best scored of a few random ones
     std::vector<vnetwork::xvnode_address_t> archive_list;
     
     if (bme->is_consensus) {
-        archive_list = m_role_xips_mgr->get_rand_full_nodes(1);
+        archive_list = m_role_xips_mgr->get_rand_full_nodes(ON_DEMAND_CANDIDATES);
     } else {
-        archive_list = m_role_xips_mgr->get_rand_archives(1);
+        archive_list = m_role_xips_mgr->get_rand_archives(ON_DEMAND_CANDIDATES);
     }
+    m_role_xips_mgr->peer_score().sort(archive_list);
     
     if (archive_list.size() == 0) {
         xsync_warn("xsync_on_demand_t::on_behind_event no archive node %s,", address.c_str());
@@ -115,6 +132,7 @@ void xsync_on_demand_t::handle_blocks_response(const std::vector<data::xblock_pt
     if (!check_auth(m_certauth, last_block)) {
         xsync_error("xsync_on_demand_t::handle_blocks_response auth_failed %s,height=%lu,viewid=%lu,",
             account.c_str(), last_block->get_height(), last_block->get_viewid());
+        m_role_xips_mgr->peer_score().on_failure(to_address);
         return;
     }
 
@@ -178,6 +196,7 @@ void xsync_on_demand_t::handle_blocks_response_with_proof(const std::vector<data
     if (!check_auth(m_certauth, last_block)) {
         xsync_error("xsync_on_demand_t::handle_blocks_response_with_proof auth_failed %s,height=%lu,viewid=%lu,",
             account.c_str(), last_block->get_height(), last_block->get_viewid());
+        m_role_xips_mgr->peer_score().on_failure(to_address);
         return;
     }
 
@@ -581,8 +600,9 @@ void xsync_on_demand_t::on_behind_by_hash_event(const mbus::xevent_ptr_t &e) {
         return;
     }
 
-    // only one archive node
-    std::vector<vnetwork::xvnode_address_t> archive_list = m_role_xips_mgr->get_rand_archives(1);
+    // only one archive node, the best scored of a few random ones
+    std::vector<vnetwork::xvnode_address_t> archive_list = m_role_xips_mgr->get_rand_archives(ON_DEMAND_CANDIDATES);
+    m_role_xips_mgr->peer_score().sort(archive_list);
     if (archive_list.size() == 0) {
         xsync_warn("xsync_on_demand_t::on_behind_by_hash_event no archive node %s,", address.c_str());
         return;
@@ -812,6 +832,7 @@ void xsync_on_demand_t::handle_blocks_response_with_params(const std::vector<dat
     if (!check_auth(m_certauth, last_block)) {
         xsync_error("xsync_on_demand_t::handle_blocks_response_with_params auth_failed %s,height=%lu,viewid=%lu,",
             account.c_str(), last_block->get_height(), last_block->get_viewid());
+        m_role_xips_mgr->peer_score().on_failure(to_address);
         return;
     }
 
@@ -876,6 +897,17 @@ void xsync_on_demand_t::handle_blocks_response_with_params(const std::vector<dat
     }
 }
 
+void xsync_on_demand_t::handle_empty_blocks_response(const xsync_msg_block_request_ptr_t& request_ptr,
+    const vnetwork::xvnode_address_t &to_address, const vnetwork::xvnode_address_t &network_self) {
+
+    const std::string &account = request_ptr->get_address();
+    xsync_info("xsync_on_demand_t::handle_empty_blocks_response no blocks(on_demand) %s,height=%lu %s",
+        account.c_str(), request_ptr->get_request_start_height(), to_address.to_string().c_str());
+
+    m_download_tracer.set_missing(account, request_ptr->get_request_start_height());
+    m_download_tracer.expire(account);
+}
+
 void xsync_on_demand_t::handle_blocks_response_with_hash(const xsync_msg_block_request_ptr_t& request_ptr, const std::vector<data::xblock_ptr_t> &blocks, 
     const vnetwork::xvnode_address_t &to_address, const vnetwork::xvnode_address_t &network_self) {
 
@@ -12,6 +12,7 @@ NS_BEG2(top, sync)
 
 const uint32_t COMMON_TIME_INTERVAl = 180;
 const uint32_t frozen_broadcast_factor = 10;
+const int64_t min_announce_interval_ms = 1000;
 
 xsync_peer_keeper_t::xsync_peer_keeper_t(std::string vnode_id, xsync_store_face_t *sync_store, xrole_chains_mgr_t *role_chains_mgr,
     xrole_xips_manager_t *role_xips_mgr, xsync_sender_t *sync_sender, xsync_peerset_t *peerset):
@@ -152,22 +153,7 @@ void xsync_peer_keeper_t::walk_role(const vnetwork::xvnode_address_t &self_addr,
             }
         }
 
-        xchain_state_info_t info;
-        info.address = address;
-        if (chain_info.sync_policy == enum_chain_sync_policy_fast) {
-            base::xauto_ptr<base::xvblock_t> latest_start_block = m_sync_store->get_latest_start_block(address, chain_info.sync_policy);
-            if (latest_start_block == nullptr || !latest_start_block->is_full_state_block()) {
-                info.start_height = 0;
-                info.end_height = 0;
-            } else {
-                info.start_height = latest_start_block->get_height();
-                info.end_height = m_sync_store->get_latest_end_block_height(address, chain_info.sync_policy);
-            }
-        } else {
-            info.start_height = m_sync_store->get_latest_start_block_height(address, chain_info.sync_policy);
-            info.end_height = m_sync_store->get_latest_end_block_height(address, chain_info.sync_policy);
-        }
-        info_list.push_back(info);
+        info_list.push_back(get_chain_state(address, chain_info.sync_policy));
     }
 
     if (common::has<common::xnode_type_t::frozen>(self_addr.type())) {
@@ -176,6 +162,56 @@ void xsync_peer_keeper_t::walk_role(const vnetwork::xvnode_address_t &self_addr,
         send_chain_state(self_addr, target_list, info_list);
     }
 }
+xchain_state_info_t xsync_peer_keeper_t::get_chain_state(const std::string &address, enum_chain_sync_policy sync_policy) {
+    xchain_state_info_t info;
+    info.address = address;
+    if (sync_policy == enum_chain_sync_policy_fast) {
+        base::xauto_ptr<base::xvblock_t> latest_start_block = m_sync_store->get_latest_start_block(address, sync_policy);
+        if (latest_start_block == nullptr || !latest_start_block->is_full_state_block()) {
+            info.start_height = 0;
+            info.end_height = 0;
+        } else {
+            info.start_height = latest_start_block->get_height();
+            info.end_height = m_sync_store->get_latest_end_block_height(address, sync_policy);
+        }
+    } else {
+        info.start_height = m_sync_store->get_latest_start_block_height(address, sync_policy);
+        info.end_height = m_sync_store->get_latest_end_block_height(address, sync_policy);
+    }
+    return info;
+}
+
+void xsync_peer_keeper_t::announce_chain(const std::string &address) {
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    int64_t now = base::xtime_utl::gmttime_ms();
+    auto it_announce = m_last_announce_ms.find(address);
+    if (it_announce != m_last_announce_ms.end() && (now - it_announce->second) < min_announce_interval_ms)
+        return;
+    m_last_announce_ms[address] = now;
+
+    for (auto &it: m_maps) {
+        const vnetwork::xvnode_address_t &self_addr = it.first;
+        if (common::has<common::xnode_type_t::frozen>(self_addr.type()))
+            continue;
+
+        std::shared_ptr<xrole_chains_t> role_chains = m_role_chains_mgr->get_role(self_addr);
+        if (role_chains == nullptr)
+            continue;
+
+        const map_chain_info_t &chains = role_chains->get_chains_wrapper().get_chains();
+        auto it_chain = chains.find(address);
+        if (it_chain == chains.end())
+            continue;
+
+        std::vector<xchain_state_info_t> info_list{get_chain_state(address, it_chain->second.sync_policy)};
+        XMETRICS_COUNTER_INCREMENT("sync_announce_chain_state_send", 1);
+        for (const auto &peer : it.second) {
+            m_sync_sender->send_broadcast_chain_state(info_list, self_addr, peer);
+        }
+    }
+}
+
 void xsync_peer_keeper_t::prune_table(const vnetwork::xvnode_address_t &self_addr, const map_chain_info_t &chains) {
     common::xminer_type_t miner_type = m_role_xips_mgr->miner_type();
     xsync_info("xsync_peer_keeper walk_role, %s", to_string(miner_type).c_str());
@@ -11,7 +11,7 @@ xsync_ratelimit_t::xsync_ratelimit_t(observer_ptr<base::xiothread_t> const & iot
 m_iothread(iothread) {
 
     m_bucket_config_upper = max_allowed_parallels/sample_count;
-    m_bucket = min_val;
+    m_bucket = (int64_t)(min_val * 1000);
 
     xsync_ratelimit_ctx_t ctx;
     ctx.calc_bucket_size = min_val;
@@ -33,6 +33,11 @@ void xsync_ratelimit_t::stop() {
 }
 
 void xsync_ratelimit_t::resume() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    next_sample();
+}
+
+void xsync_ratelimit_t::next_sample() {
     xsync_ratelimit_ctx_t new_ctx;
 
     m_list_ctx.push_back(new_ctx);
@@ -51,57 +56,51 @@ void xsync_ratelimit_t::on_timer() {
         return;
     }
 
-    resume();
+    next_sample();
 }
 
-bool xsync_ratelimit_t::get_token(int64_t now) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (!m_time_rejecter.reject()){
-        resume();
-    }
-    
-    if (m_bucket >= 1.0) {
-        m_last_success_count++;
-        m_bucket--;
-        return true;
+void xsync_ratelimit_t::try_resume() {
+    // the thread getting the lock makes the decision, the others go on with the current bucket
+    std::unique_lock<std::mutex> lock(m_lock, std::try_to_lock);
+    if (!lock.owns_lock() || m_time_rejecter.reject()) {
+        return;
     }
 
-    m_last_fail_count++;
+    next_sample();
+}
 
-    return false;
+bool xsync_ratelimit_t::get_token(int64_t now) {
+    try_resume();
+
+    int64_t current = m_bucket.load(std::memory_order_relaxed);
+    do {
+        if (current < 1000) {
+            m_last_fail_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!m_bucket.compare_exchange_weak(current, current - 1000, std::memory_order_relaxed));
+
+    m_last_success_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
 }
 
 void xsync_ratelimit_t::feedback(uint32_t cost, int64_t now) {
-    std::unique_lock<std::mutex> lock(m_lock);
-
-    response_info info;
-    info.cost = cost;
-    info.time = now;
-    m_last_response_list.push_back(info);
+    m_last_response_count.fetch_add(1, std::memory_order_relaxed);
+    m_last_response_cost.fetch_add(cost, std::memory_order_relaxed);
 }
 
 void xsync_ratelimit_t::data_statistics() {
-    uint32_t last_response_cost = 0;
-    uint32_t last_response_count = 0;
+    uint32_t last_response_cost = m_last_response_cost.exchange(0, std::memory_order_relaxed);
+    uint32_t last_response_count = m_last_response_count.exchange(0, std::memory_order_relaxed);
 
-    for (auto &it: m_last_response_list) {
-        response_info &info = it;
-        last_response_count++;
-        last_response_cost += info.cost;
-    }
-
-    m_list_ctx.back().last_success_count = m_last_success_count;
-    m_list_ctx.back().last_fail_count = m_last_fail_count;
+    m_list_ctx.back().last_success_count = m_last_success_count.exchange(0, std::memory_order_relaxed);
+    m_list_ctx.back().last_fail_count = m_last_fail_count.exchange(0, std::memory_order_relaxed);
     m_list_ctx.back().last_response_count = last_response_count;
     m_list_ctx.back().last_response_cost = last_response_cost;
     if (last_response_count != 0) {
         m_list_ctx.back().last_response_average_cost = last_response_cost/last_response_count;
     }
 
-    m_last_success_count = 0;
-    m_last_fail_count = 0;
-    m_last_response_list.clear();
-
 
     uint32_t total_success_count = 0;
     uint32_t total_fail_count = 0;
@@ -171,7 +170,7 @@ void xsync_ratelimit_t::make_decision() {
     if (ctx.real_bucket_size < min_val)
        ctx.real_bucket_size = min_val; 
 
-    m_bucket = ctx.real_bucket_size;
+    m_bucket.store((int64_t)(ctx.real_bucket_size * 1000), std::memory_order_relaxed);
 }
 
 NS_END2
\ No newline at end of file
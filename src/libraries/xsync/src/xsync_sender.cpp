@@ -10,6 +10,7 @@
 #include "xdata/xdatautil.h"
 #include "xsyncbase/xmessage_ids.h"
 #include "xsync/xsync_util.h"
+#include "xconfig/xconfig_register.h"
 
 NS_BEG2(top, sync)
 
@@ -22,7 +23,8 @@ m_vhost(vhost),
 m_role_xips_mgr(role_xips_mgr),
 m_sync_store(sync_store),
 m_session_mgr(session_mgr),
-m_min_compress_threshold(min_compress_threshold) {
+m_min_compress_threshold(min_compress_threshold),
+m_serve_limiter(XGET_CONFIG(sync_serve_max_bytes_per_second)) {
 }
 
 void xsync_sender_t::send_gossip(const std::vector<xgossip_chain_info_ptr_t> &info_list, const xbyte_buffer_t &bloom_data, const vnetwork::xvnode_address_t& self_xip, uint32_t max_peers, enum_gossip_target_type target_type) {
@@ -250,7 +252,7 @@ void xsync_sender_t::push_newblock(const data::xblock_ptr_t &block, const vnetwo
     } else {
         std::vector<data::xblock_ptr_t> block_vec{block};
         uint32_t request_option = SYNC_MSG_OPTION_SET(enum_sync_block_request_push, 0, enum_sync_data_all, enum_sync_block_object_xvblock, 0);
-        auto block_str_vec = convert_blocks_to_stream(enum_sync_data_all, block_vec);
+        auto block_str_vec = serialize_blocks(enum_sync_data_all, block_vec);
         auto body = make_object_ptr<xsync_msg_block_push_t>(block->get_account(), request_option, block_str_vec);
         xsync_dbg("push_newblock sessionid(%lx) %s send to %s", body->get_sessionID(), self_addr.to_string().c_str(), target_addr.to_string().c_str());
         send_message(body, xmessage_id_sync_newblock_push, "newblock_push", self_addr, target_addr);
@@ -408,7 +410,7 @@ void xsync_sender_t::send_get_on_demand_blocks_with_params(const std::string &ad
 void xsync_sender_t::send_block_response(const xsync_msg_block_request_ptr_t& request_ptr, const std::vector<xblock_ptr_t> &vector_blocks, uint32_t response_extend_option, 
                             std::string extend_data, const vnetwork::xvnode_address_t& self_addr, const vnetwork::xvnode_address_t& target_addr) 
 {
-    auto block_str_vec = convert_blocks_to_stream(request_ptr->get_data_type(), vector_blocks); 
+    auto block_str_vec = serialize_blocks(request_ptr->get_data_type(), vector_blocks);
     auto body = make_object_ptr<xsync_msg_block_response_t>(request_ptr->get_sessionID(), request_ptr->get_address(), request_ptr->get_option(),
                  block_str_vec, response_extend_option, extend_data);
     send_message(body, xmessage_id_sync_block_response, "xmessage_id_sync_block_response", self_addr, target_addr);
@@ -416,6 +418,32 @@ void xsync_sender_t::send_block_response(const xsync_msg_block_request_ptr_t& re
             request_ptr->get_sessionID(), self_addr.to_string().c_str(), target_addr.to_string().c_str(), vector_blocks.size(), response_extend_option, extend_data.c_str());
 }
 
+std::vector<std::string> xsync_sender_t::serialize_blocks(uint32_t data_type, const std::vector<xblock_ptr_t> &blocks) {
+    std::vector<std::string> blocks_str_vec;
+    blocks_str_vec.reserve(blocks.size());
+
+    for (auto &block : blocks) {
+        // the hash tells forked blocks of the same height apart
+        std::string key = block->get_account() + ":" + std::to_string(block->get_height()) + ":" + block->get_block_hash() + ":" + std::to_string(data_type);
+        std::string block_str;
+        if (m_serialized_blocks.get(key, block_str)) {
+            XMETRICS_COUNTER_INCREMENT("sync_serialized_block_cache_hit", 1);
+            blocks_str_vec.push_back(std::move(block_str));
+            continue;
+        }
+
+        XMETRICS_COUNTER_INCREMENT("sync_serialized_block_cache_miss", 1);
+        std::vector<xblock_ptr_t> one_block{block};
+        block_str = std::move(convert_blocks_to_stream(data_type, one_block)[0]);
+        if (block_str.size() <= serialized_block_max_size) {
+            m_serialized_blocks.put(key, block_str);
+        }
+        blocks_str_vec.push_back(std::move(block_str));
+    }
+
+    return blocks_str_vec;
+}
+
 bool xsync_sender_t::send_message(
             const xobject_ptr_t<basic::xserialize_face_t> serializer,
             const common::xmessage_id_t msgid, 
@@ -434,12 +462,19 @@ bool xsync_sender_t::send_message(
     xmessage_t msg;
     xmessage_pack_t::pack_message(_msg, ((int) _msg.payload().size()) >= m_min_compress_threshold, msg);
 
+    if (!m_serve_limiter.allow(msgid, target_addr, msg.payload().size(), base::xtime_utl::gmttime_ms())) {
+        xsync_dbg("xsync_sender_t %s to %s throttled, size %zu", metric_key.c_str(), target_addr.to_string().c_str(), msg.payload().size());
+        return false;
+    }
+
     std::string pkg_metric_name = "sync_pkgs_" + metric_key + "_send";
-    std::string bytes_metric_name = "sync_pkgs_" + metric_key + "_send";
+    std::string bytes_metric_name = "sync_bytes_" + metric_key + "_send";
     XMETRICS_COUNTER_INCREMENT(pkg_metric_name, 1);
     XMETRICS_COUNTER_INCREMENT(bytes_metric_name, msg.payload().size());
     XMETRICS_COUNTER_INCREMENT("sync_pkgs_out", 1);
     XMETRICS_COUNTER_INCREMENT("sync_bytes_out", msg.payload().size());
+    // size before packing, to compare with sync_bytes_out for the compression gain
+    XMETRICS_COUNTER_INCREMENT("sync_bytes_out_raw", _msg.payload().size());
     
     std::error_code ec;
     if (self_addr.zone_id() == common::xfrozen_zone_id)
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xsync/xsync_serve_limiter.h"
+
+#include "xmetrics/xmetrics.h"
+#include "xsyncbase/xmessage_ids.h"
+
+#include <functional>
+#include <string>
+
+NS_BEG2(top, sync)
+
+constexpr uint32_t xsync_serve_limiter_t::peer_slot_count;
+
+xsync_serve_limiter_t::xsync_serve_limiter_t(uint64_t max_bytes_per_second) {
+    // burst of one second, a class may take half of the budget and a peer one eighth
+    m_global.reset(max_bytes_per_second, max_bytes_per_second);
+    for (auto & bucket : m_classes) {
+        bucket.reset(max_bytes_per_second / 2, max_bytes_per_second / 2);
+    }
+    for (auto & bucket : m_peers) {
+        bucket.reset(max_bytes_per_second / 8, max_bytes_per_second / 8);
+    }
+}
+
+bool xsync_serve_limiter_t::serve_class(common::xmessage_id_t msgid, enum_sync_serve_class & cls) {
+    if (msgid == xmessage_id_sync_blocks || msgid == xmessage_id_sync_blocks_by_hashes || msgid == xmessage_id_sync_block_response) {
+        cls = enum_sync_serve_class_blocks;
+    } else if (msgid == xmessage_id_sync_on_demand_blocks || msgid == xmessage_id_sync_on_demand_by_hash_blocks ||
+               msgid == xmessage_id_sync_on_demand_blocks_with_proof || msgid == xmessage_id_sync_on_demand_blocks_with_hash) {
+        cls = enum_sync_serve_class_on_demand;
+    } else if (msgid == xmessage_id_sync_archive_blocks) {
+        cls = enum_sync_serve_class_archive;
+    } else if (msgid == xmessage_id_sync_chain_snapshot_response || msgid == xmessage_id_sync_ondemand_chain_snapshot_response) {
+        cls = enum_sync_serve_class_state;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool xsync_serve_limiter_t::allow(common::xmessage_id_t msgid, const vnetwork::xvnode_address_t & peer, uint64_t bytes, int64_t now_ms) {
+    enum_sync_serve_class cls;
+    if (!serve_class(msgid, cls)) {
+        return true;
+    }
+
+    xsync_token_bucket_t & peer_bucket = m_peers[std::hash<std::string>{}(peer.account_address().to_string()) % peer_slot_count];
+    if (!peer_bucket.consume(bytes, now_ms)) {
+        XMETRICS_COUNTER_INCREMENT("sync_bytes_throttled_peer", bytes);
+        return false;
+    }
+
+    if (!m_classes[cls].consume(bytes, now_ms)) {
+        peer_bucket.refund(bytes);
+        XMETRICS_COUNTER_INCREMENT("sync_bytes_throttled_class", bytes);
+        return false;
+    }
+
+    if (!m_global.consume(bytes, now_ms)) {
+        m_classes[cls].refund(bytes);
+        peer_bucket.refund(bytes);
+        XMETRICS_COUNTER_INCREMENT("sync_bytes_throttled_global", bytes);
+        return false;
+    }
+
+    return true;
+}
+
+NS_END2
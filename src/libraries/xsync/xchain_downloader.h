@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include "xmbus/xevent_account.h"
 #include "xsync/xchain_info.h"
@@ -101,6 +102,15 @@ class xchain_object_t {
         vnetwork::xvnode_address_t m_target_addr;
 };
 
+// a block range requested ahead of the one being applied, kept until its turn comes.
+class xchain_window_t {
+public:
+    xentire_block_request_ptr_t request{nullptr};
+    std::vector<data::xblock_ptr_t> blocks;
+    vnetwork::xvnode_address_t from_addr;
+    int64_t cost{0};
+};
+
 class xchain_downloader_t : public xchain_downloader_face_t {
 public:
     xchain_downloader_t(std::string vnode_id,
@@ -129,7 +139,7 @@ public:
     xsync_command_execute_result execute_download(uint64_t start_height, uint64_t end_height, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr, const std::string &reason);
 protected:
     enum_result_code handle_block(data::xblock_ptr_t & block, uint64_t quota_height);
-    enum_result_code pre_handle_block(std::vector<data::xblock_ptr_t> &blocks, uint64_t quota_height, std::vector<base::xvblock_t*> &processed_blocks);
+    enum_result_code pre_handle_block(std::vector<data::xblock_ptr_t> &blocks, uint64_t quota_height, bool verify_each, std::vector<base::xvblock_t*> &processed_blocks);
 
     xsync_command_execute_result handle_next(uint64_t current_height);
     bool handle_fulltable(uint64_t fulltable_height_of_tablechain, const vnetwork::xvnode_address_t self_addr, const vnetwork::xvnode_address_t target_addr);
@@ -151,6 +161,11 @@ private:
     bool notified_committed_event_group();
     enum_result_code handle_archive_block(data::xblock_ptr_t & block, uint64_t quota_height);
     bool is_elect_chain();
+    void verify_blocks(std::vector<data::xblock_ptr_t> &blocks, std::vector<bool> &verified);
+    bool linked_below_checkpoint(std::vector<data::xblock_ptr_t> &blocks, bool &anchored);
+    bool buffer_window(std::vector<data::xblock_ptr_t> &blocks, const vnetwork::xvnode_address_t &from_addr);
+    void prefetch_windows(uint64_t start_height, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr, int64_t now);
+    std::vector<vnetwork::xvnode_address_t> pick_peers(const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr);
 
 protected:
     std::string m_vnode_id;
@@ -172,6 +187,7 @@ private:
     xrole_xips_manager_t *m_role_xips_mgr;
     xrole_chains_mgr_t *m_role_chains_mgr;
     bool m_is_elect_chain;
+    std::map<uint64_t, xchain_window_t> m_windows;
 };
 
 NS_END2
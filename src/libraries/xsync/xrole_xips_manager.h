@@ -14,6 +14,7 @@
 #include "xdata/xgenesis_data.h"
 #include "xrouter/xrouter.h"
 #include "xvnetwork/xvhost_face.h"
+#include "xsync/xsync_peer_score.h"
 
 NS_BEG2(top, sync)
 
@@ -131,6 +132,7 @@ public:
     void set_miner(common::xminer_type_t miner_type, bool genesis);
     bool genesis() {return m_genesis;}
     common::xminer_type_t miner_type() { return m_miner_type; }
+    xsync_peer_score_t & peer_score() { return m_peer_score; }
 protected:
 
     xip_vector_ptr create_xip_vector_ptr(const std::vector<common::xnode_address_t>& list, const common::xnode_address_t& self_xip);
@@ -146,6 +148,7 @@ protected:
     common::xnode_address_t m_self_xip;
     common::xminer_type_t m_miner_type;
     bool m_genesis{false};
+    xsync_peer_score_t m_peer_score;
 };
 
 NS_END2
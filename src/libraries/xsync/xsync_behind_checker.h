@@ -26,9 +26,12 @@ public:
     xsync_behind_checker_t(std::string vnode_id, xsync_store_face_t *sync_store, xrole_chains_mgr_t *role_chains_mgr, xsync_peerset_t *peerset, xdownloader_face_t *downloader);
     void on_timer();
     void on_behind_check_event(const mbus::xevent_ptr_t &e);
+    // heights announced by a peer, start catching up at once rather than at the next check
+    void on_chain_state(const vnetwork::xvnode_address_t &self_addr, const std::vector<xchain_state_info_t> &info_list);
 
 private:
-    void check_one(const std::string &address, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const std::string &reason);
+    // return how many blocks behind the newest peer
+    uint64_t check_one(const std::string &address, enum_chain_sync_policy sync_policy, const vnetwork::xvnode_address_t &self_addr, const std::string &reason, bool dump_metrics = false);
 
 private:
     std::string m_vnode_id;
@@ -39,6 +42,14 @@ private:
     xsync_time_rejecter_t m_time_rejecter{900};
 
     int m_counter{0};
+    // polling is only the fallback of the announcements: often while behind, rarely once caught up
+    int m_check_interval{min_check_interval};
+    int m_last_check_counter{0};
+    int m_last_dump_counter{0};
+
+    static constexpr int min_check_interval = 2;
+    static constexpr int max_check_interval = 30;
+    static constexpr int dump_metrics_interval = 120;
 };
 
 NS_END2
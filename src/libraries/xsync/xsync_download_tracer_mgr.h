@@ -19,6 +19,7 @@ class xsync_download_tracer {
             const vnetwork::xvnode_address_t& src,
             const vnetwork::xvnode_address_t& dst);
         void set_trace_height(const uint64_t trace_height);
+        void set_height_interval(const std::pair<uint64_t, uint64_t> expect_height_interval);
         const uint64_t trace_height();
         const std::pair<uint64_t, uint64_t> height_interval();
         const std::map<std::string, std::string> context();
@@ -44,6 +45,11 @@ class xsync_download_tracer_mgr {
         bool refresh(std::string account, uint64_t downloaded_height);
         bool refresh(std::string account);
         bool get(const std::string account, xsync_download_tracer &tracer);
+        // extend the in-flight download of account when the interval continues it, so one request serves both
+        bool merge(std::string account, std::pair<uint64_t, uint64_t> expect_height_interval);
+        // peers answered they have no block of account from height on, do not ask again for a while
+        void set_missing(std::string account, uint64_t height);
+        bool is_missing(std::string account, uint64_t height);
 
         void expire();
         void expire(std::string account);
@@ -60,9 +66,12 @@ class xsync_download_tracer_mgr {
         std::unordered_map<xchain_account_t, xsync_download_tracer> m_tracers;
         std::multimap<uint64_t, xchain_account_t> m_elapses;
         std::unordered_map<xchain_account_t, uint64_t> m_account_elapses;
+        std::unordered_map<xchain_account_t, std::pair<uint64_t, uint64_t>> m_missing; // height, time
         mutable std::mutex m_lock;
         const uint64_t m_tolerated_expire_time = 2000;// time unit is ms
         const uint32_t m_max_capacity = 100;
+        const uint64_t m_missing_expire_time = 3000;// time unit is ms
+        const uint32_t m_max_missing_capacity = 1000;
 };
 
 NS_END2
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "xbase/xlog.h"
+#include "xbasic/xasync_log.h"
 
 NS_BEG2(top, sync)
 
@@ -9,17 +10,17 @@ NS_BEG2(top, sync)
 
 
 #ifdef SYNC_TEST
-#define xsync_dbg(fmt, ...) xdbg("vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
-#define xsync_info(fmt, ...) xinfo("vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
-#define xsync_warn(fmt, ...) xwarn("vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
-#define xsync_kinfo(fmt, ...) xkinfo("vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
+#define xsync_dbg(fmt, ...) xasync_log(enum_xlog_level_debug, "vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
+#define xsync_info(fmt, ...) xasync_log(enum_xlog_level_info, "vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
+#define xsync_warn(fmt, ...) xasync_log(enum_xlog_level_warn, "vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
+#define xsync_kinfo(fmt, ...) xasync_log(enum_xlog_level_key_info, "vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
 #define xsync_error(fmt, ...) xerror("vnode_id(%s) " fmt, m_vnode_id.c_str(), ## __VA_ARGS__)
 
 #else
-#define xsync_dbg xdbg
-#define xsync_info xinfo
-#define xsync_warn xwarn
-#define xsync_kinfo xkinfo
+#define xsync_dbg(fmt, ...) xasync_log(enum_xlog_level_debug, fmt, ## __VA_ARGS__)
+#define xsync_info(fmt, ...) xasync_log(enum_xlog_level_info, fmt, ## __VA_ARGS__)
+#define xsync_warn(fmt, ...) xasync_log(enum_xlog_level_warn, fmt, ## __VA_ARGS__)
+#define xsync_kinfo(fmt, ...) xasync_log(enum_xlog_level_key_info, fmt, ## __VA_ARGS__)
 #define xsync_error xerror
 #endif
 
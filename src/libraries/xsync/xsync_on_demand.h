@@ -58,6 +58,8 @@ public:
     void handle_blocks_response_with_params(const std::vector<data::xblock_ptr_t>& blocks, 
             const std::string& unit_proof_str, const vnetwork::xvnode_address_t& to_address, 
             const vnetwork::xvnode_address_t& network_self);
+    void handle_empty_blocks_response(const xsync_msg_block_request_ptr_t& request_ptr,
+            const vnetwork::xvnode_address_t &to_address, const vnetwork::xvnode_address_t &network_self);
     void handle_blocks_response_with_hash(const xsync_msg_block_request_ptr_t& request_ptr, 
             const std::vector<data::xblock_ptr_t> &blocks,  const vnetwork::xvnode_address_t &to_address, 
             const vnetwork::xvnode_address_t &network_self);
@@ -32,6 +32,8 @@ public:
     void remove_role(const vnetwork::xvnode_address_t& addr);
     void handle_message(const vnetwork::xvnode_address_t &network_self, const vnetwork::xvnode_address_t &from_address, const std::vector<xchain_state_info_t> &info_list);
     uint32_t get_frozen_broadcast_factor();
+    // push the heights of one chain to the peers right after it commits, instead of waiting for the next walk
+    void announce_chain(const std::string &address);
 
 private:
     void walk_role(const vnetwork::xvnode_address_t &self_addr, const std::set<vnetwork::xvnode_address_t> &target_list, const std::shared_ptr<xrole_chains_t> &role_chains);
@@ -39,6 +41,7 @@ private:
     void send_chain_state(const vnetwork::xvnode_address_t &self_addr, const std::set<vnetwork::xvnode_address_t> &target_list, std::vector<xchain_state_info_t> &info_list);
     void send_frozen_chain_state(const vnetwork::xvnode_address_t &self_addr, std::vector<xchain_state_info_t> &info_list);
     void prune_table(const vnetwork::xvnode_address_t &self_addr, const map_chain_info_t &chains);
+    xchain_state_info_t get_chain_state(const std::string &address, enum_chain_sync_policy sync_policy);
 private:
     std::string m_vnode_id;
     xsync_store_face_t *m_sync_store;
@@ -51,6 +54,7 @@ private:
     std::mutex m_lock;
     std::map<vnetwork::xvnode_address_t, std::set<vnetwork::xvnode_address_t>> m_maps;
     xsync_time_rejecter_t m_time_rejecter{900};
+    std::map<std::string, int64_t> m_last_announce_ms;
 };
 
 NS_END2
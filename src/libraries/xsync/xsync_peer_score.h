@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "xvnetwork/xaddress.h"
+
+NS_BEG2(top, sync)
+
+// learned quality of the peers sync requests are sent to, lower score is better.
+// peers are keyed by account so the score survives epoch changes of their xip.
+class xsync_peer_score_t {
+public:
+    static constexpr int64_t failure_penalty_ms = 1000;
+    static constexpr int64_t deceit_score = INT64_MAX;
+    static constexpr size_t max_peers = 1024;
+
+    // a response of count blocks took cost ms since the request was sent
+    void on_response(const vnetwork::xvnode_address_t &peer, int64_t cost, uint32_t count) {
+        if (cost < 0) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        xpeer_stat_t &stat = get_stat(peer.account_address());
+        int64_t cost_per_block = cost / std::max(count, (uint32_t)1) + 1;
+        if (stat.cost_per_block == 0) {
+            stat.rtt = cost;
+            stat.cost_per_block = cost_per_block;
+        } else {
+            stat.rtt = (stat.rtt * 3 + cost) / 4;
+            stat.cost_per_block = (stat.cost_per_block * 3 + cost_per_block) / 4;
+        }
+        stat.failures /= 2;
+    }
+
+    // no response in time, or a response which can not be used
+    void on_failure(const vnetwork::xvnode_address_t &peer) {
+        std::unique_lock<std::mutex> lock(m_lock);
+        xpeer_stat_t &stat = get_stat(peer.account_address());
+        if (stat.failures < 16) {
+            stat.failures++;
+        }
+    }
+
+    void on_deceit(const vnetwork::xvnode_address_t &peer) {
+        std::unique_lock<std::mutex> lock(m_lock);
+        get_stat(peer.account_address()).deceit = true;
+    }
+
+    // peers never measured score 0, so every peer gets a chance before the fastest are preferred
+    int64_t score(const vnetwork::xvnode_address_t &peer) {
+        std::unique_lock<std::mutex> lock(m_lock);
+        return score(peer.account_address());
+    }
+
+    // best first, the order of peers with the same score is kept
+    void sort(std::vector<vnetwork::xvnode_address_t> &peers) {
+        std::unique_lock<std::mutex> lock(m_lock);
+        std::vector<std::pair<int64_t, vnetwork::xvnode_address_t>> scored;
+        for (auto &peer : peers) {
+            scored.push_back(std::make_pair(score(peer.account_address()), peer));
+        }
+        std::stable_sort(scored.begin(), scored.end(), [](const std::pair<int64_t, vnetwork::xvnode_address_t> &l, const std::pair<int64_t, vnetwork::xvnode_address_t> &r) {
+            return l.first < r.first;
+        });
+        for (size_t i = 0; i < scored.size(); i++) {
+            peers[i] = scored[i].second;
+        }
+    }
+
+private:
+    struct xpeer_stat_t {
+        int64_t rtt{0};            // smoothed response time(ms)
+        int64_t cost_per_block{0}; // smoothed response time per block(ms), the inverse of throughput
+        uint32_t failures{0};
+        bool deceit{false};
+    };
+
+    xpeer_stat_t & get_stat(const vnetwork::xaccount_address_t &account) {
+        if (m_stats.size() >= max_peers && m_stats.find(account) == m_stats.end()) {
+            m_stats.clear();
+        }
+        return m_stats[account];
+    }
+
+    int64_t score(const vnetwork::xaccount_address_t &account) const {
+        auto it = m_stats.find(account);
+        if (it == m_stats.end()) {
+            return 0;
+        }
+        const xpeer_stat_t &stat = it->second;
+        if (stat.deceit) {
+            return deceit_score;
+        }
+        return stat.cost_per_block + stat.rtt / 8 + stat.failures * failure_penalty_ms;
+    }
+
+    std::mutex m_lock;
+    std::map<vnetwork::xaccount_address_t, xpeer_stat_t> m_stats;
+};
+
+NS_END2
@@ -21,12 +21,6 @@ public:
     virtual void resume() = 0;
 };
 
-class response_info {
-public:
-    uint32_t cost;
-    int64_t time;
-};
-
 class xsync_ratelimit_ctx_t {
 public:
     // last sample
@@ -61,18 +55,21 @@ public:
 private:
     void data_statistics();
     void make_decision();
+    void try_resume();
+    void next_sample();
 
 private:
     observer_ptr<base::xiothread_t> m_iothread;
     xsync_ratelimit_timer_t *m_timer{nullptr};
     bool m_is_start{false};
-    std::mutex m_lock;
+    std::mutex m_lock;  // only guards the decision, get_token and feedback do not wait for it
     float m_bucket_config_upper;
-    float m_bucket;
+    std::atomic<int64_t> m_bucket{0};  // tokens in 1/1000
     // range info
-    uint32_t m_last_success_count{0};
-    uint32_t m_last_fail_count{0};
-    std::list<response_info> m_last_response_list;
+    std::atomic<uint32_t> m_last_success_count{0};
+    std::atomic<uint32_t> m_last_fail_count{0};
+    std::atomic<uint32_t> m_last_response_count{0};
+    std::atomic<uint32_t> m_last_response_cost{0};
     std::list<xsync_ratelimit_ctx_t> m_list_ctx;
     xsync_time_rejecter_t m_time_rejecter{100};// the callback thread of timer maybe blocked
 };
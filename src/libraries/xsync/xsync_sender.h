@@ -15,6 +15,8 @@
 #include "xsyncbase/xmessage_ids.h"
 #include "xsync/xsync_store.h"
 #include "xsync/xsync_session_manager.h"
+#include "xsync/xsync_serve_limiter.h"
+#include "xbasic/xlru_cache.h"
 
 NS_BEG2(top, sync)
 
@@ -85,12 +87,20 @@ public:
 
     bool send_message(xobject_ptr_t<basic::xserialize_face_t> serializer, const common::xmessage_id_t msgid, const std::string metric_key, const vnetwork::xvnode_address_t &self_addr, const vnetwork::xvnode_address_t &target_addr);
 protected:
+    // same as convert_blocks_to_stream, but recent blocks asked by many peers are serialized only once
+    std::vector<std::string> serialize_blocks(uint32_t data_type, const std::vector<data::xblock_ptr_t> &blocks);
+
+    static constexpr size_t serialized_block_cache_count = 512;
+    static constexpr size_t serialized_block_max_size = 1024 * 1024;
+
     std::string m_vnode_id;
     observer_ptr<vnetwork::xvhost_face_t> m_vhost{};
     xrole_xips_manager_t *m_role_xips_mgr{};
     xsync_store_face_t *m_sync_store;
     xsync_session_manager_t *m_session_mgr;
     int m_min_compress_threshold{};
+    xsync_serve_limiter_t m_serve_limiter;
+    basic::xlru_cache<std::string, std::string> m_serialized_blocks{serialized_block_cache_count};  // key: account:height:hash:data_type
 };
 
 NS_END2
@@ -0,0 +1,42 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xcommon/xmessage_id.h"
+#include "xvnetwork/xaddress.h"
+#include "xsync/xsync_token_bucket.h"
+
+NS_BEG2(top, sync)
+
+enum enum_sync_serve_class {
+    enum_sync_serve_class_blocks,
+    enum_sync_serve_class_on_demand,
+    enum_sync_serve_class_archive,
+    enum_sync_serve_class_state,
+    enum_sync_serve_class_max,
+};
+
+// byte budget of the responses served to other nodes: one global budget, a share of it for
+// each request class and a smaller one for each peer, so one class or one peer can not take all.
+// peers are hashed to a fixed set of slots so no lock or map is needed.
+class xsync_serve_limiter_t {
+public:
+    static constexpr uint32_t peer_slot_count = 256;
+
+    explicit xsync_serve_limiter_t(uint64_t max_bytes_per_second);
+
+    // return false if the response should not be sent now
+    bool allow(common::xmessage_id_t msgid, const vnetwork::xvnode_address_t &peer, uint64_t bytes, int64_t now_ms);
+
+    // whether msgid is a response, and the class it is served in
+    static bool serve_class(common::xmessage_id_t msgid, enum_sync_serve_class &cls);
+
+private:
+    xsync_token_bucket_t m_global;
+    xsync_token_bucket_t m_classes[enum_sync_serve_class_max];
+    xsync_token_bucket_t m_peers[peer_slot_count];
+};
+
+NS_END2
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <atomic>
+#include <cstdint>
+
+NS_BEG2(top, sync)
+
+// lock-free token bucket, refilled continuously with rate tokens per second up to burst tokens.
+// tokens are kept in 1/1000 so low rates are not lost to rounding on frequent refills.
+class xsync_token_bucket_t {
+public:
+    xsync_token_bucket_t() = default;
+    xsync_token_bucket_t(uint64_t rate, uint64_t burst) {
+        reset(rate, burst);
+    }
+
+    xsync_token_bucket_t(const xsync_token_bucket_t &) = delete;
+    xsync_token_bucket_t & operator=(const xsync_token_bucket_t &) = delete;
+
+    // rate 0 means unlimited
+    void reset(uint64_t rate, uint64_t burst) {
+        m_rate.store((int64_t)rate, std::memory_order_relaxed);
+        m_burst.store((int64_t)burst * 1000, std::memory_order_relaxed);
+        m_tokens.store((int64_t)burst * 1000, std::memory_order_relaxed);
+    }
+
+    bool consume(uint64_t tokens, int64_t now_ms) {
+        int64_t rate = m_rate.load(std::memory_order_relaxed);
+        if (rate == 0) {
+            return true;
+        }
+
+        refill(rate, now_ms);
+
+        // a request larger than the burst passes once the bucket is full, rather than never
+        int64_t burst = m_burst.load(std::memory_order_relaxed);
+        int64_t want = (int64_t)tokens * 1000 > burst ? burst : (int64_t)tokens * 1000;
+        int64_t current = m_tokens.load(std::memory_order_relaxed);
+        do {
+            if (current < want) {
+                return false;
+            }
+        } while (!m_tokens.compare_exchange_weak(current, current - want, std::memory_order_relaxed));
+        return true;
+    }
+
+    // give back tokens taken for a request which was not sent at last
+    void refund(uint64_t tokens) {
+        if (m_rate.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        add(m_burst.load(std::memory_order_relaxed), (int64_t)tokens * 1000);
+    }
+
+private:
+    void refill(int64_t rate, int64_t now_ms) {
+        int64_t last = m_last_ms.load(std::memory_order_relaxed);
+        if (now_ms <= last || !m_last_ms.compare_exchange_strong(last, now_ms, std::memory_order_relaxed)) {
+            return;
+        }
+
+        // only the thread moving the refill time adds the elapsed tokens
+        int64_t elapsed = now_ms - last;
+        if (last == 0 || elapsed > max_refill_ms) {
+            elapsed = max_refill_ms;
+        }
+        add(m_burst.load(std::memory_order_relaxed), elapsed * rate);
+    }
+
+    void add(int64_t burst, int64_t value) {
+        int64_t current = m_tokens.load(std::memory_order_relaxed);
+        int64_t next;
+        do {
+            next = current + value > burst ? burst : current + value;
+        } while (!m_tokens.compare_exchange_weak(current, next, std::memory_order_relaxed));
+    }
+
+    static constexpr int64_t max_refill_ms = 60000;
+
+    std::atomic<int64_t> m_rate{0};
+    std::atomic<int64_t> m_burst{0};
+    std::atomic<int64_t> m_tokens{0};
+    std::atomic<int64_t> m_last_ms{0};
+};
+
+NS_END2
@@ -7,7 +7,9 @@
 #include "xdata/xtransaction.h"
 #include <grpcpp/grpcpp.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cinttypes>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -19,6 +21,7 @@ using grpc::Server;
 using grpc::ServerAsyncResponseWriter;
 using grpc::ServerBuilder;
 using grpc::ServerCompletionQueue;
+using top::xblock_reply;
 using top::xrpc_reply;
 using top::xrpc_request;
 using top::xrpc_service;
@@ -103,6 +106,81 @@ Status xrpc_serviceimpl::table_stream(ServerContext * context, const xrpc_reques
     return Status(grpc::StatusCode::OK, "Stream finished successfully.");
 }
 
+xblock_stream_call_t::xblock_stream_call_t(xrpc_serviceimpl * service, ServerCompletionQueue * cq, std::shared_ptr<xblock_stream_source_face_t> const & source)
+  : m_service(service), m_cq(cq), m_source(source), m_writer(&m_ctx) {
+    m_service->Requestblock_stream(&m_ctx, &m_request, &m_writer, m_cq, m_cq, this);
+}
+
+void xblock_stream_call_t::proceed(bool ok) {
+    switch (m_state) {
+    case xstate_t::request:
+        if (!ok) {  // queue is shutting down
+            delete this;
+            return;
+        }
+        // keep one call waiting for the next client
+        new xblock_stream_call_t(m_service, m_cq, m_source);
+        start_stream();
+        break;
+    case xstate_t::write:
+        if (!ok) {  // client is gone, no finish needed
+            xinfo("grpc block stream: write fail, account %s, height %" PRIu64, m_account.c_str(), m_next_height - 1);
+            delete this;
+            return;
+        }
+        write_next();
+        break;
+    case xstate_t::finish:
+        delete this;
+        break;
+    }
+}
+
+void xblock_stream_call_t::start_stream() {
+    xJson::Reader reader;
+    xJson::Value js_req;
+    if (!reader.parse(m_request.body(), js_req) || !js_req["account"].isString()) {
+        xdbg("grpc block stream: %s json parse error", m_request.body().c_str());
+        m_state = xstate_t::finish;
+        m_writer.Finish(Status(grpc::StatusCode::INVALID_ARGUMENT, "Invalid request argument: account is required."), this);
+        return;
+    }
+    if (m_source == nullptr) {
+        m_state = xstate_t::finish;
+        m_writer.Finish(Status(grpc::StatusCode::UNAVAILABLE, "Block stream is not served by this node."), this);
+        return;
+    }
+    m_account = js_req["account"].asString();
+    m_next_height = static_cast<uint64_t>(js_req["start_height"].asUInt64());
+    // stream ends at the committed height seen at start, client continues from there by another call
+    m_end_height = m_source->get_latest_committed_height(m_account);
+    if (js_req.isMember("end_height")) {
+        m_end_height = std::min(m_end_height, static_cast<uint64_t>(js_req["end_height"].asUInt64()));
+    }
+    xinfo("grpc block stream: account %s, heights [%" PRIu64 ", %" PRIu64 "]", m_account.c_str(), m_next_height, m_end_height);
+    m_state = xstate_t::write;
+    write_next();
+}
+
+void xblock_stream_call_t::write_next() {
+    if (m_ctx.IsCancelled() || m_next_height > m_end_height) {
+        m_state = xstate_t::finish;
+        m_writer.Finish(Status::OK, this);
+        return;
+    }
+    xblock_reply reply;
+    if (!m_source->load_committed_block(m_account, m_next_height, *reply.mutable_block())) {
+        // pruned or not stored, stop at the gap so client never miss a block silently
+        m_state = xstate_t::finish;
+        m_writer.Finish(Status(grpc::StatusCode::NOT_FOUND, "Block not found at height " + std::to_string(m_next_height)), this);
+        return;
+    }
+    reply.set_account(m_account);
+    reply.set_height(m_next_height);
+    ++m_next_height;
+    m_writer.Write(reply, this);
+}
+
 // std::atomic<int> grpc_recv_num(0);
 // uint64_t grpc_last_timestamp;
 
@@ -283,6 +361,12 @@ uint32_t xgrpc_service::sync_run(const std::shared_ptr<xrpc_handle_face_t> & han
     // Register "service" as the instance through which we'll communicate with
     // clients. In this case it corresponds to an *synchronous* service.
     builder.RegisterService(&service);
+    // block_stream runs on one completion queue per core
+    std::vector<std::unique_ptr<ServerCompletionQueue>> cqs;
+    const uint32_t cq_count = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t i = 0; i < cq_count; ++i) {
+        cqs.push_back(builder.AddCompletionQueue());
+    }
     // Finally assemble the server.
     std::unique_ptr<Server> server(builder.BuildAndStart());
     if (server == nullptr) {
@@ -292,9 +376,28 @@ uint32_t xgrpc_service::sync_run(const std::shared_ptr<xrpc_handle_face_t> & han
     std::cout << "xrpc grpc server listening on " << m_address << std::endl;
     xdbg("xrpc grpc server listening on %s", m_address.c_str());
 
+    std::vector<std::thread> cq_threads;
+    for (auto & cq : cqs) {
+        auto cq_ptr = cq.get();
+        cq_threads.emplace_back([&service, cq_ptr, this] {
+            new xblock_stream_call_t(&service, cq_ptr, m_block_source);
+            void * tag{nullptr};
+            bool ok{false};
+            while (cq_ptr->Next(&tag, &ok)) {
+                static_cast<xblock_stream_call_t *>(tag)->proceed(ok);
+            }
+        });
+    }
+
     // Wait for the server to shutdown. Note that some other thread must be
     // responsible for shutting down the server for this call to ever return.
     server->Wait();
+    for (auto & cq : cqs) {
+        cq->Shutdown();
+    }
+    for (auto & th : cq_threads) {
+        th.join();
+    }
     return 0;
 }
 
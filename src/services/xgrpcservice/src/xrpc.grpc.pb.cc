@@ -18,6 +18,7 @@ namespace top {
 static const char* xrpc_service_method_names[] = {
   "/top.xrpc_service/call",
   "/top.xrpc_service/table_stream",
+  "/top.xrpc_service/block_stream",
 };
 
 std::unique_ptr< xrpc_service::Stub> xrpc_service::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -29,6 +30,7 @@ std::unique_ptr< xrpc_service::Stub> xrpc_service::NewStub(const std::shared_ptr
 xrpc_service::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel)
   : channel_(channel), rpcmethod_call_(xrpc_service_method_names[0], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_table_stream_(xrpc_service_method_names[1], ::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_block_stream_(xrpc_service_method_names[2], ::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
   {}
 
 ::grpc::Status xrpc_service::Stub::call(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::top::xrpc_reply* response) {
@@ -55,6 +57,18 @@ xrpc_service::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& chann
   return ::grpc::internal::ClientAsyncReaderFactory< ::top::xrpc_reply>::Create(channel_.get(), cq, rpcmethod_table_stream_, context, request, false, nullptr);
 }
 
+::grpc::ClientReader< ::top::xblock_reply>* xrpc_service::Stub::block_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request) {
+  return ::grpc::internal::ClientReaderFactory< ::top::xblock_reply>::Create(channel_.get(), rpcmethod_block_stream_, context, request);
+}
+
+::grpc::ClientAsyncReader< ::top::xblock_reply>* xrpc_service::Stub::Asyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::top::xblock_reply>::Create(channel_.get(), cq, rpcmethod_block_stream_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::top::xblock_reply>* xrpc_service::Stub::PrepareAsyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::top::xblock_reply>::Create(channel_.get(), cq, rpcmethod_block_stream_, context, request, false, nullptr);
+}
+
 xrpc_service::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       xrpc_service_method_names[0],
@@ -66,6 +80,11 @@ xrpc_service::Service::Service() {
       ::grpc::internal::RpcMethod::SERVER_STREAMING,
       new ::grpc::internal::ServerStreamingHandler< xrpc_service::Service, ::top::xrpc_request, ::top::xrpc_reply>(
           std::mem_fn(&xrpc_service::Service::table_stream), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      xrpc_service_method_names[2],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< xrpc_service::Service, ::top::xrpc_request, ::top::xblock_reply>(
+          std::mem_fn(&xrpc_service::Service::block_stream), this)));
 }
 
 xrpc_service::Service::~Service() {
@@ -85,6 +104,13 @@ xrpc_service::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status xrpc_service::Service::block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace top
 
@@ -50,12 +50,24 @@ class xrpc_service final {
     std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xrpc_reply>> PrepareAsynctable_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xrpc_reply>>(PrepareAsynctable_streamRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::top::xblock_reply>> block_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::top::xblock_reply>>(block_streamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>> Asyncblock_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>>(Asyncblock_streamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>> PrepareAsyncblock_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>>(PrepareAsyncblock_streamRaw(context, request, cq));
+    }
   private:
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::top::xrpc_reply>* AsynccallRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::top::xrpc_reply>* PrepareAsynccallRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientReaderInterface< ::top::xrpc_reply>* table_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request) = 0;
     virtual ::grpc::ClientAsyncReaderInterface< ::top::xrpc_reply>* Asynctable_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
     virtual ::grpc::ClientAsyncReaderInterface< ::top::xrpc_reply>* PrepareAsynctable_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::top::xblock_reply>* block_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>* Asyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::top::xblock_reply>* PrepareAsyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -76,6 +88,15 @@ class xrpc_service final {
     std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xrpc_reply>> PrepareAsynctable_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xrpc_reply>>(PrepareAsynctable_streamRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReader< ::top::xblock_reply>> block_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::top::xblock_reply>>(block_streamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xblock_reply>> Asyncblock_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xblock_reply>>(Asyncblock_streamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xblock_reply>> PrepareAsyncblock_stream(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::top::xblock_reply>>(PrepareAsyncblock_streamRaw(context, request, cq));
+    }
 
    private:
     std::shared_ptr< ::grpc::ChannelInterface> channel_;
@@ -84,8 +105,12 @@ class xrpc_service final {
     ::grpc::ClientReader< ::top::xrpc_reply>* table_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request) override;
     ::grpc::ClientAsyncReader< ::top::xrpc_reply>* Asynctable_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) override;
     ::grpc::ClientAsyncReader< ::top::xrpc_reply>* PrepareAsynctable_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::top::xblock_reply>* block_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request) override;
+    ::grpc::ClientAsyncReader< ::top::xblock_reply>* Asyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::top::xblock_reply>* PrepareAsyncblock_streamRaw(::grpc::ClientContext* context, const ::top::xrpc_request& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_call_;
     const ::grpc::internal::RpcMethod rpcmethod_table_stream_;
+    const ::grpc::internal::RpcMethod rpcmethod_block_stream_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -95,6 +120,7 @@ class xrpc_service final {
     virtual ~Service();
     virtual ::grpc::Status call(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::top::xrpc_reply* response);
     virtual ::grpc::Status table_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xrpc_reply>* writer);
+    virtual ::grpc::Status block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer);
   };
   template <class BaseClass>
   class WithAsyncMethod_call : public BaseClass {
@@ -136,7 +162,27 @@ class xrpc_service final {
       ::grpc::Service::RequestAsyncServerStreaming(1, context, request, writer, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_call<WithAsyncMethod_table_stream<Service > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_block_stream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service *service) {}
+   public:
+    WithAsyncMethod_block_stream() {
+      ::grpc::Service::MarkMethodAsync(2);
+    }
+    ~WithAsyncMethod_block_stream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void Requestblock_stream(::grpc::ServerContext* context, ::top::xrpc_request* request, ::grpc::ServerAsyncWriter< ::top::xblock_reply>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(2, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_call<WithAsyncMethod_table_stream<WithAsyncMethod_block_stream<Service > > > AsyncService;
   template <class BaseClass>
   class WithGenericMethod_call : public BaseClass {
    private:
@@ -172,6 +218,23 @@ class xrpc_service final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_block_stream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service *service) {}
+   public:
+    WithGenericMethod_block_stream() {
+      ::grpc::Service::MarkMethodGeneric(2);
+    }
+    ~WithGenericMethod_block_stream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_call : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service *service) {}
@@ -212,6 +275,26 @@ class xrpc_service final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_block_stream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service *service) {}
+   public:
+    WithRawMethod_block_stream() {
+      ::grpc::Service::MarkMethodRaw(2);
+    }
+    ~WithRawMethod_block_stream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void Requestblock_stream(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(2, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_call : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service *service) {}
@@ -252,8 +335,28 @@ class xrpc_service final {
     // replace default version of method with split streamed
     virtual ::grpc::Status Streamedtable_stream(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::top::xrpc_request,::top::xrpc_reply>* server_split_streamer) = 0;
   };
-  typedef WithSplitStreamingMethod_table_stream<Service > SplitStreamedService;
-  typedef WithStreamedUnaryMethod_call<WithSplitStreamingMethod_table_stream<Service > > StreamedService;
+  template <class BaseClass>
+  class WithSplitStreamingMethod_block_stream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service *service) {}
+   public:
+    WithSplitStreamingMethod_block_stream() {
+      ::grpc::Service::MarkMethodStreamed(2,
+        new ::grpc::internal::SplitServerStreamingHandler< ::top::xrpc_request, ::top::xblock_reply>(std::bind(&WithSplitStreamingMethod_block_stream<BaseClass>::Streamedblock_stream, this, std::placeholders::_1, std::placeholders::_2)));
+    }
+    ~WithSplitStreamingMethod_block_stream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status block_stream(::grpc::ServerContext* context, const ::top::xrpc_request* request, ::grpc::ServerWriter< ::top::xblock_reply>* writer) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status Streamedblock_stream(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::top::xrpc_request,::top::xblock_reply>* server_split_streamer) = 0;
+  };
+  typedef WithSplitStreamingMethod_table_stream<WithSplitStreamingMethod_block_stream<Service > > SplitStreamedService;
+  typedef WithStreamedUnaryMethod_call<WithSplitStreamingMethod_table_stream<WithSplitStreamingMethod_block_stream<Service > > > StreamedService;
 };
 
 }  // namespace top
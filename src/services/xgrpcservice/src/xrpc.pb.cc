@@ -30,6 +30,11 @@ class xrpc_replyDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<xrpc_reply>
       _instance;
 } _xrpc_reply_default_instance_;
+class xblock_replyDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<xblock_reply>
+      _instance;
+} _xblock_reply_default_instance_;
 }  // namespace top
 namespace protobuf_xrpc_2eproto {
 static void InitDefaultsxrpc_request() {
@@ -60,12 +65,27 @@ static void InitDefaultsxrpc_reply() {
 ::google::protobuf::internal::SCCInfo<0> scc_info_xrpc_reply =
     {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsxrpc_reply}, {}};
 
+static void InitDefaultsxblock_reply() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::top::_xblock_reply_default_instance_;
+    new (ptr) ::top::xblock_reply();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::top::xblock_reply::InitAsDefaultInstance();
+}
+
+::google::protobuf::internal::SCCInfo<0> scc_info_xblock_reply =
+    {{ATOMIC_VAR_INIT(::google::protobuf::internal::SCCInfoBase::kUninitialized), 0, InitDefaultsxblock_reply}, {}};
+
 void InitDefaults() {
   ::google::protobuf::internal::InitSCC(&scc_info_xrpc_request.base);
   ::google::protobuf::internal::InitSCC(&scc_info_xrpc_reply.base);
+  ::google::protobuf::internal::InitSCC(&scc_info_xblock_reply.base);
 }
 
-::google::protobuf::Metadata file_level_metadata[2];
+::google::protobuf::Metadata file_level_metadata[3];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   ~0u,  // no _has_bits_
@@ -82,15 +102,25 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xrpc_reply, result_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xrpc_reply, body_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xblock_reply, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xblock_reply, account_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xblock_reply, height_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::top::xblock_reply, block_),
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::top::xrpc_request)},
   { 7, -1, sizeof(::top::xrpc_reply)},
+  { 14, -1, sizeof(::top::xblock_reply)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::top::_xrpc_request_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::top::_xrpc_reply_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::top::_xblock_reply_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -108,7 +138,7 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 2);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 3);
 }
 
 void AddDescriptorsImpl() {
@@ -116,15 +146,18 @@ void AddDescriptorsImpl() {
   static const char descriptor[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
       "\n\nxrpc.proto\022\003top\",\n\014xrpc_request\022\016\n\006act"
       "ion\030\001 \001(\t\022\014\n\004body\030\002 \001(\t\"*\n\nxrpc_reply\022\016\n"
-      "\006result\030\001 \001(\t\022\014\n\004body\030\002 \001(\t2t\n\014xrpc_serv"
-      "ice\022,\n\004call\022\021.top.xrpc_request\032\017.top.xrp"
-      "c_reply\"\000\0226\n\014table_stream\022\021.top.xrpc_req"
-      "uest\032\017.top.xrpc_reply\"\0000\001B6\n\033io.grpc.exa"
-      "mples.helloworldB\017HelloWorldProtoP\001\242\002\003HL"
-      "Wb\006proto3"
+      "\006result\030\001 \001(\t\022\014\n\004body\030\002 \001(\t\">\n\014xblock_re"
+      "ply\022\017\n\007account\030\001 \001(\t\022\016\n\006height\030\002 \001(\004\022\r\n\005"
+      "block\030\003 \001(\0142\256\001\n\014xrpc_service\022,\n\004call\022\021.t"
+      "op.xrpc_request\032\017.top.xrpc_reply\"\000\0226\n\014ta"
+      "ble_stream\022\021.top.xrpc_request\032\017.top.xrpc"
+      "_reply\"\0000\001\0228\n\014block_stream\022\021.top.xrpc_re"
+      "quest\032\021.top.xblock_reply\"\0000\001B6\n\033io.grpc."
+      "examples.helloworldB\017HelloWorldProtoP\001\242\002"
+      "\003HLWb\006proto3"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 289);
+      descriptor, 412);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "xrpc.proto", &protobuf_RegisterTypes);
 }
@@ -742,6 +775,333 @@ void xrpc_reply::InternalSwap(xrpc_reply* other) {
 }
 
 
+// ===================================================================
+
+void xblock_reply::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int xblock_reply::kAccountFieldNumber;
+const int xblock_reply::kHeightFieldNumber;
+const int xblock_reply::kBlockFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+xblock_reply::xblock_reply()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  ::google::protobuf::internal::InitSCC(
+      &protobuf_xrpc_2eproto::scc_info_xblock_reply.base);
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:top.xblock_reply)
+}
+xblock_reply::xblock_reply(const xblock_reply& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  account_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.account().size() > 0) {
+    account_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.account_);
+  }
+  block_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.block().size() > 0) {
+    block_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.block_);
+  }
+  height_ = from.height_;
+  // @@protoc_insertion_point(copy_constructor:top.xblock_reply)
+}
+
+void xblock_reply::SharedCtor() {
+  account_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  block_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  height_ = GOOGLE_ULONGLONG(0);
+}
+
+xblock_reply::~xblock_reply() {
+  // @@protoc_insertion_point(destructor:top.xblock_reply)
+  SharedDtor();
+}
+
+void xblock_reply::SharedDtor() {
+  account_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  block_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+void xblock_reply::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const ::google::protobuf::Descriptor* xblock_reply::descriptor() {
+  ::protobuf_xrpc_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_xrpc_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const xblock_reply& xblock_reply::default_instance() {
+  ::google::protobuf::internal::InitSCC(&protobuf_xrpc_2eproto::scc_info_xblock_reply.base);
+  return *internal_default_instance();
+}
+
+
+void xblock_reply::Clear() {
+// @@protoc_insertion_point(message_clear_start:top.xblock_reply)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  account_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  block_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  height_ = GOOGLE_ULONGLONG(0);
+  _internal_metadata_.Clear();
+}
+
+bool xblock_reply::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:top.xblock_reply)
+  for (;;) {
+    ::std::pair<::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // string account = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(10u /* 10 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
+                input, this->mutable_account()));
+          DO_(::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+            this->account().data(), static_cast<int>(this->account().length()),
+            ::google::protobuf::internal::WireFormatLite::PARSE,
+            "top.xblock_reply.account"));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // uint64 height = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(16u /* 16 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
+                 input, &height_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes block = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(26u /* 26 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_block()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:top.xblock_reply)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:top.xblock_reply)
+  return false;
+#undef DO_
+}
+
+void xblock_reply::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:top.xblock_reply)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string account = 1;
+  if (this->account().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+      this->account().data(), static_cast<int>(this->account().length()),
+      ::google::protobuf::internal::WireFormatLite::SERIALIZE,
+      "top.xblock_reply.account");
+    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
+      1, this->account(), output);
+  }
+
+  // uint64 height = 2;
+  if (this->height() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt64(2, this->height(), output);
+  }
+
+  // bytes block = 3;
+  if (this->block().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      3, this->block(), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:top.xblock_reply)
+}
+
+::google::protobuf::uint8* xblock_reply::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:top.xblock_reply)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string account = 1;
+  if (this->account().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+      this->account().data(), static_cast<int>(this->account().length()),
+      ::google::protobuf::internal::WireFormatLite::SERIALIZE,
+      "top.xblock_reply.account");
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
+        1, this->account(), target);
+  }
+
+  // uint64 height = 2;
+  if (this->height() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(2, this->height(), target);
+  }
+
+  // bytes block = 3;
+  if (this->block().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        3, this->block(), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:top.xblock_reply)
+  return target;
+}
+
+size_t xblock_reply::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:top.xblock_reply)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // string account = 1;
+  if (this->account().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::StringSize(
+        this->account());
+  }
+
+  // bytes block = 3;
+  if (this->block().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->block());
+  }
+
+  // uint64 height = 2;
+  if (this->height() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt64Size(
+        this->height());
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void xblock_reply::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:top.xblock_reply)
+  GOOGLE_DCHECK_NE(&from, this);
+  const xblock_reply* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const xblock_reply>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:top.xblock_reply)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:top.xblock_reply)
+    MergeFrom(*source);
+  }
+}
+
+void xblock_reply::MergeFrom(const xblock_reply& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:top.xblock_reply)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.account().size() > 0) {
+
+    account_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.account_);
+  }
+  if (from.block().size() > 0) {
+
+    block_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.block_);
+  }
+  if (from.height() != 0) {
+    set_height(from.height());
+  }
+}
+
+void xblock_reply::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:top.xblock_reply)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void xblock_reply::CopyFrom(const xblock_reply& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:top.xblock_reply)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool xblock_reply::IsInitialized() const {
+  return true;
+}
+
+void xblock_reply::Swap(xblock_reply* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void xblock_reply::InternalSwap(xblock_reply* other) {
+  using std::swap;
+  account_.Swap(&other->account_, &::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
+  block_.Swap(&other->block_, &::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
+  swap(height_, other->height_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+}
+
+::google::protobuf::Metadata xblock_reply::GetMetadata() const {
+  protobuf_xrpc_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_xrpc_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace top
 namespace google {
@@ -752,6 +1112,9 @@ template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::top::xrpc_request* Arena::Create
 template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::top::xrpc_reply* Arena::CreateMaybeMessage< ::top::xrpc_reply >(Arena* arena) {
   return Arena::CreateInternal< ::top::xrpc_reply >(arena);
 }
+template<> GOOGLE_PROTOBUF_ATTRIBUTE_NOINLINE ::top::xblock_reply* Arena::CreateMaybeMessage< ::top::xblock_reply >(Arena* arena) {
+  return Arena::CreateInternal< ::top::xblock_reply >(arena);
+}
 }  // namespace protobuf
 }  // namespace google
 
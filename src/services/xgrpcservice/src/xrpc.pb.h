@@ -38,7 +38,7 @@ namespace protobuf_xrpc_2eproto {
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[2];
+  static const ::google::protobuf::internal::ParseTable schema[3];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -46,6 +46,9 @@ struct TableStruct {
 void AddDescriptors();
 }  // namespace protobuf_xrpc_2eproto
 namespace top {
+class xblock_reply;
+class xblock_replyDefaultTypeInternal;
+extern xblock_replyDefaultTypeInternal _xblock_reply_default_instance_;
 class xrpc_reply;
 class xrpc_replyDefaultTypeInternal;
 extern xrpc_replyDefaultTypeInternal _xrpc_reply_default_instance_;
@@ -55,6 +58,7 @@ extern xrpc_requestDefaultTypeInternal _xrpc_request_default_instance_;
 }  // namespace top
 namespace google {
 namespace protobuf {
+template<> ::top::xblock_reply* Arena::CreateMaybeMessage<::top::xblock_reply>(Arena*);
 template<> ::top::xrpc_reply* Arena::CreateMaybeMessage<::top::xrpc_reply>(Arena*);
 template<> ::top::xrpc_request* Arena::CreateMaybeMessage<::top::xrpc_request>(Arena*);
 }  // namespace protobuf
@@ -313,6 +317,139 @@ class xrpc_reply : public ::google::protobuf::Message /* @@protoc_insertion_poin
   mutable ::google::protobuf::internal::CachedSize _cached_size_;
   friend struct ::protobuf_xrpc_2eproto::TableStruct;
 };
+// -------------------------------------------------------------------
+
+class xblock_reply : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:top.xblock_reply) */ {
+ public:
+  xblock_reply();
+  virtual ~xblock_reply();
+
+  xblock_reply(const xblock_reply& from);
+
+  inline xblock_reply& operator=(const xblock_reply& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  xblock_reply(xblock_reply&& from) noexcept
+    : xblock_reply() {
+    *this = ::std::move(from);
+  }
+
+  inline xblock_reply& operator=(xblock_reply&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const xblock_reply& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const xblock_reply* internal_default_instance() {
+    return reinterpret_cast<const xblock_reply*>(
+               &_xblock_reply_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  void Swap(xblock_reply* other);
+  friend void swap(xblock_reply& a, xblock_reply& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline xblock_reply* New() const final {
+    return CreateMaybeMessage<xblock_reply>(NULL);
+  }
+
+  xblock_reply* New(::google::protobuf::Arena* arena) const final {
+    return CreateMaybeMessage<xblock_reply>(arena);
+  }
+  void CopyFrom(const ::google::protobuf::Message& from) final;
+  void MergeFrom(const ::google::protobuf::Message& from) final;
+  void CopyFrom(const xblock_reply& from);
+  void MergeFrom(const xblock_reply& from);
+  void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) final;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const final;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(xblock_reply* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // string account = 1;
+  void clear_account();
+  static const int kAccountFieldNumber = 1;
+  const ::std::string& account() const;
+  void set_account(const ::std::string& value);
+  #if LANG_CXX11
+  void set_account(::std::string&& value);
+  #endif
+  void set_account(const char* value);
+  void set_account(const char* value, size_t size);
+  ::std::string* mutable_account();
+  ::std::string* release_account();
+  void set_allocated_account(::std::string* account);
+
+  // bytes block = 3;
+  void clear_block();
+  static const int kBlockFieldNumber = 3;
+  const ::std::string& block() const;
+  void set_block(const ::std::string& value);
+  #if LANG_CXX11
+  void set_block(::std::string&& value);
+  #endif
+  void set_block(const char* value);
+  void set_block(const void* value, size_t size);
+  ::std::string* mutable_block();
+  ::std::string* release_block();
+  void set_allocated_block(::std::string* block);
+
+  // uint64 height = 2;
+  void clear_height();
+  static const int kHeightFieldNumber = 2;
+  ::google::protobuf::uint64 height() const;
+  void set_height(::google::protobuf::uint64 value);
+
+  // @@protoc_insertion_point(class_scope:top.xblock_reply)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::internal::ArenaStringPtr account_;
+  ::google::protobuf::internal::ArenaStringPtr block_;
+  ::google::protobuf::uint64 height_;
+  mutable ::google::protobuf::internal::CachedSize _cached_size_;
+  friend struct ::protobuf_xrpc_2eproto::TableStruct;
+};
 // ===================================================================
 
 
@@ -540,11 +677,137 @@ inline void xrpc_reply::set_allocated_body(::std::string* body) {
   // @@protoc_insertion_point(field_set_allocated:top.xrpc_reply.body)
 }
 
+// -------------------------------------------------------------------
+
+// xblock_reply
+
+// string account = 1;
+inline void xblock_reply::clear_account() {
+  account_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& xblock_reply::account() const {
+  // @@protoc_insertion_point(field_get:top.xblock_reply.account)
+  return account_.GetNoArena();
+}
+inline void xblock_reply::set_account(const ::std::string& value) {
+  
+  account_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:top.xblock_reply.account)
+}
+#if LANG_CXX11
+inline void xblock_reply::set_account(::std::string&& value) {
+  
+  account_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:top.xblock_reply.account)
+}
+#endif
+inline void xblock_reply::set_account(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  account_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:top.xblock_reply.account)
+}
+inline void xblock_reply::set_account(const char* value, size_t size) {
+  
+  account_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:top.xblock_reply.account)
+}
+inline ::std::string* xblock_reply::mutable_account() {
+  
+  // @@protoc_insertion_point(field_mutable:top.xblock_reply.account)
+  return account_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* xblock_reply::release_account() {
+  // @@protoc_insertion_point(field_release:top.xblock_reply.account)
+  
+  return account_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void xblock_reply::set_allocated_account(::std::string* account) {
+  if (account != NULL) {
+    
+  } else {
+    
+  }
+  account_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), account);
+  // @@protoc_insertion_point(field_set_allocated:top.xblock_reply.account)
+}
+
+// uint64 height = 2;
+inline void xblock_reply::clear_height() {
+  height_ = GOOGLE_ULONGLONG(0);
+}
+inline ::google::protobuf::uint64 xblock_reply::height() const {
+  // @@protoc_insertion_point(field_get:top.xblock_reply.height)
+  return height_;
+}
+inline void xblock_reply::set_height(::google::protobuf::uint64 value) {
+  
+  height_ = value;
+  // @@protoc_insertion_point(field_set:top.xblock_reply.height)
+}
+
+// bytes block = 3;
+inline void xblock_reply::clear_block() {
+  block_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& xblock_reply::block() const {
+  // @@protoc_insertion_point(field_get:top.xblock_reply.block)
+  return block_.GetNoArena();
+}
+inline void xblock_reply::set_block(const ::std::string& value) {
+  
+  block_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:top.xblock_reply.block)
+}
+#if LANG_CXX11
+inline void xblock_reply::set_block(::std::string&& value) {
+  
+  block_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:top.xblock_reply.block)
+}
+#endif
+inline void xblock_reply::set_block(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  block_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:top.xblock_reply.block)
+}
+inline void xblock_reply::set_block(const void* value, size_t size) {
+  
+  block_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:top.xblock_reply.block)
+}
+inline ::std::string* xblock_reply::mutable_block() {
+  
+  // @@protoc_insertion_point(field_mutable:top.xblock_reply.block)
+  return block_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* xblock_reply::release_block() {
+  // @@protoc_insertion_point(field_release:top.xblock_reply.block)
+  
+  return block_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void xblock_reply::set_allocated_block(::std::string* block) {
+  if (block != NULL) {
+    
+  } else {
+    
+  }
+  block_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), block);
+  // @@protoc_insertion_point(field_set_allocated:top.xblock_reply.block)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -3,6 +3,8 @@
 #include <string>
 #include <thread>
 #include <deque>
+#include <memory>
+#include <vector>
 #include <condition_variable>
 #include "json/json.h"
 #include "src/xrpc.grpc.pb.h"
@@ -11,6 +13,8 @@
 using grpc::Status;
 using grpc::ServerContext;
 using grpc::ServerWriter;
+using grpc::ServerAsyncWriter;
+using grpc::ServerCompletionQueue;
 
 namespace top { namespace rpc {
 
@@ -31,6 +35,16 @@ public:
     virtual bool handle(std::string & request, xJson::Value& js_req, xJson::Value& js_rsp, std::string & strResult, uint32_t & nErrorCode) = 0;
 };
 
+// committed blocks served by block_stream
+class xblock_stream_source_face_t
+{
+public:
+    virtual ~xblock_stream_source_face_t() = default;
+    virtual uint64_t get_latest_committed_height(std::string const & account) = 0;
+    // full block serialized by xblock_t::full_block_serialize_to, false if not found
+    virtual bool load_committed_block(std::string const & account, uint64_t height, std::string & block_bin) = 0;
+};
+
 class xgrpc_service
 {
 public:
@@ -43,6 +57,9 @@ public:
     void register_handle(const std::shared_ptr<xrpc_handle_face_t>& handle){
         m_handle = handle;
     }
+    void register_block_source(const std::shared_ptr<xblock_stream_source_face_t>& source){
+        m_block_source = source;
+    }
     int32_t start();
 private:
     int32_t run();
@@ -52,9 +69,11 @@ private:
     std::thread m_sync_thread;
     std::string m_address;
     std::shared_ptr<xrpc_handle_face_t> m_handle;
+    std::shared_ptr<xblock_stream_source_face_t> m_block_source;
 };
 
-class xrpc_serviceimpl final : public top::xrpc_service::Service {
+// call and table_stream are served by sync threads, block_stream by completion queue threads
+class xrpc_serviceimpl final : public top::xrpc_service::WithAsyncMethod_block_stream<top::xrpc_service::Service> {
 
 public:
     void register_handle(const std::shared_ptr<xrpc_handle_face_t>& handle);
@@ -70,6 +89,32 @@ private:
     mutable std::mutex m_call_mtx;
 };
 
+// one block_stream call, driven by the events of its completion queue.
+// only one write is in flight, so a slow reader holds back loading of the next block.
+class xblock_stream_call_t
+{
+public:
+    xblock_stream_call_t(xrpc_serviceimpl * service, ServerCompletionQueue * cq, std::shared_ptr<xblock_stream_source_face_t> const & source);
+    void proceed(bool ok);
+
+private:
+    enum class xstate_t { request, write, finish };
+
+    void start_stream();
+    void write_next();
+
+    xrpc_serviceimpl * m_service;
+    ServerCompletionQueue * m_cq;
+    std::shared_ptr<xblock_stream_source_face_t> m_source;
+    ServerContext m_ctx;
+    xrpc_request m_request;
+    ServerAsyncWriter<xblock_reply> m_writer;
+    xstate_t m_state{xstate_t::request};
+    std::string m_account;
+    uint64_t m_next_height{0};
+    uint64_t m_end_height{0};
+};
+
 }}
 
 
@@ -40,17 +40,17 @@ void usage() {
     std::cout << "        - db_migrate_v2_to_v3 new_path" << std::endl;
     std::cout << "        - check_fast_sync <account>" << std::endl;
     std::cout << "        - check_state_data <account>" << std::endl;
-    std::cout << "        - check_off_data" << std::endl;
-    std::cout << "        - check_mpt" << std::endl;
+    std::cout << "        - check_off_data [threads]" << std::endl;
+    std::cout << "        - check_mpt [threads]" << std::endl;
     std::cout << "        - check_block_exist <account> <height>" << std::endl;
     std::cout << "        - check_block_info <account> <height|last|all>" << std::endl;
     std::cout << "        - check_tx_info [starttime] [endtime] [threads]" << std::endl;
     std::cout << "        - check_tx_file [tx_file] [threads]" << std::endl;
-    std::cout << "        - check_latest_fullblock" << std::endl;
+    std::cout << "        - check_latest_fullblock [threads]" << std::endl;
     std::cout << "        - check_contract_property <account> <property> <height|last|all>" << std::endl;
     std::cout << "        - check_balance" << std::endl;
     std::cout << "        - check_archive_db [redundancy]" << std::endl;
-    std::cout << "        - check_performance" << std::endl;
+    std::cout << "        - check_performance [threads]" << std::endl;
     std::cout << "        - parse_checkpoint <height>" << std::endl;
     std::cout << "        - parse_db" << std::endl;
     std::cout << "        - db_read_meta  [db_path] <account>" << std::endl;
@@ -59,6 +59,9 @@ void usage() {
     std::cout << "        - db_parse_type_size [db_path] " << std::endl;
     std::cout << "        - db_read_block [db_path] <account> <height> " << std::endl;
     std::cout << "        - db_prune [db_path] " << std::endl;
+    std::cout << "        - export_block_archive <archive_file> [account]" << std::endl;
+    std::cout << "        - import_block_archive <archive_file>" << std::endl;
+    std::cout << "        - replay_table <table> <start_height> <end_height>" << std::endl;
     std::cout << "-------  end  -------" << std::endl;
 }
 
@@ -241,12 +244,21 @@ int main(int argc, char ** argv) {
             }
         }
     } else if (function_name == "check_off_data") {
+        if (argc == 4) {
+            tools.set_thread_num(std::stoi(argv[3]));
+        }
         auto const table_account_vec = xdb_export_tools_t::get_table_accounts();
         tools.query_all_account_data(table_account_vec, true, xdb_check_data_func_off_data_t());
     } else if (function_name == "check_mpt") {
+        if (argc == 4) {
+            tools.set_thread_num(std::stoi(argv[3]));
+        }
         auto const table_account_vec = xdb_export_tools_t::get_table_accounts();
         tools.query_all_table_mpt(table_account_vec);
     } else if (function_name == "check_performance") {
+        if (argc == 4) {
+            tools.set_thread_num(std::stoi(argv[3]));
+        }
         tools.set_outfile_folder("performance_result/");
         auto const table_account_vec = tools.get_table_accounts();
         tools.query_all_table_performance(table_account_vec);
@@ -347,7 +359,32 @@ int main(int argc, char ** argv) {
         } else if (argc == 4) {
             tools.query_meta(argv[3]);
         }
+    } else if (function_name == "export_block_archive") {
+        if (argc < 4 || argc > 5) {
+            usage();
+            return -1;
+        }
+        if (argc == 4) {
+            tools.export_block_archive(xdb_export_tools_t::get_table_accounts(), argv[3]);
+        } else {
+            tools.export_block_archive({argv[4]}, argv[3]);
+        }
+    } else if (function_name == "import_block_archive") {
+        if (argc != 4) {
+            usage();
+            return -1;
+        }
+        tools.import_block_archive(argv[3]);
+    } else if (function_name == "replay_table") {
+        if (argc != 6) {
+            usage();
+            return -1;
+        }
+        tools.replay_table(argv[3], std::stoull(argv[4]), std::stoull(argv[5]));
     } else if (function_name == "check_latest_fullblock") {
+        if (argc == 4) {
+            tools.set_thread_num(std::stoi(argv[3]));
+        }
         tools.query_table_latest_fullblock();
     } else if (function_name == "check_contract_property") {
         if (argc < 6) {
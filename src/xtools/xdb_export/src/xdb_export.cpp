@@ -1,5 +1,7 @@
 #include "dirent.h"
 #include <stdio.h>
+#include <chrono>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -7,7 +9,10 @@
 #include "xdbstore/xstore.h"
 #include "xdbstore/xstore_face.h"
 #include "xbasic/xasio_io_context_wrapper.h"
+#include "xblockstore/xblockarchive.h"
 #include "xblockstore/xblockstore_face.h"
+#include "xblockmaker/xblock_maker_para.h"
+#include "xblockmaker/xblockmaker_error.h"
 #include "xchain_upgrade/xchain_data_processor.h"
 #include "xconfig/xconfig_register.h"
 #include "xconfig/xpredefined_configurations.h"
@@ -17,14 +22,18 @@
 #include "xdata/xsystem_contract/xdata_structures.h"
 #include "xdata/xtable_bstate.h"
 #include "xdata/xblocktool.h"
+#include "xdata/xblockbuild.h"
 #include "xdepends/include/asio/post.hpp"
 #include "xdepends/include/asio/thread_pool.hpp"
 #include "xelection/xvnode_house.h"
+#include "xgasfee/xgas_estimate.h"
 #include "xevm_common/trie/xtrie.h"
 #include "xevm_common/trie/xtrie_iterator.h"
 #include "xevm_common/trie/xtrie_kv_db.h"
 #include "xevm_common/trie/xsecure_trie.h"
 #include "xstate_mpt/xstate_mpt.h"
+#include "xstatestore/xstatestore_face.h"
+#include "xstore/xtgas_singleton.h"
 #include "xloader/src/xgenesis_info.h"
 #include "xloader/xconfig_genesis_loader.h"
 #include "xvledger/xvdbkey.h"
@@ -52,9 +61,10 @@ xdb_export_tools_t::xdb_export_tools_t(std::string const & db_path) {
 
     int dst_db_kind = top::db::xdb_kind_kvdb;
     std::vector<db::xdb_path_t> db_data_paths {};
-    base::xvchain_t::instance().get_db_config_custom(db_data_paths, dst_db_kind);
+    db::xdb_options_t db_options {};
+    base::xvchain_t::instance().get_db_config_custom(db_data_paths, dst_db_kind, db_options);
     std::cout << "--------db_path:" << db_path << std::endl;
-    std::shared_ptr<db::xdb_face_t> db = top::db::xdb_factory_t::create(dst_db_kind, db_path, db_data_paths);
+    std::shared_ptr<db::xdb_face_t> db = top::db::xdb_factory_t::create(dst_db_kind, db_path, db_data_paths, db_options);
 
     m_store = top::store::xstore_factory::create_store_with_static_kvdb(db);
    // m_store = top::store::xstore_factory::create_store_with_kvdb(db_path);
@@ -154,50 +164,6 @@ std::vector<std::string> xdb_export_tools_t::get_db_unit_accounts() {
 }
 
 void xdb_export_tools_t::query_all_account_data(std::vector<std::string> const & accounts_vec, bool is_table, const xdb_check_data_func_face_t & func) {
-    json result_json;
-    uint32_t thread_num = 8;
-    if (accounts_vec.size() < thread_num) {
-        for (auto const & account : accounts_vec) {
-            json j;
-            query_account_data(account, j, func);
-            result_json[account] = j;
-        }
-    } else {
-        uint32_t address_per_thread = accounts_vec.size() / thread_num;
-        std::vector<std::vector<std::string>> accounts_vec_split;
-        std::vector<json> j_vec(thread_num);
-        for (size_t i = 0; i < thread_num; i++) {
-            uint32_t start_index = i * address_per_thread;
-            uint32_t end_index = (i == (thread_num - 1)) ? accounts_vec.size() : ((i + 1) * address_per_thread);
-            std::vector<std::string> thread_address;
-            for (auto j = start_index; j < end_index; j++) {
-                thread_address.emplace_back(accounts_vec[j]);
-            }
-            accounts_vec_split.emplace_back(thread_address);
-        }
-        auto thread_helper = [&accounts_vec_split, &j_vec, &func](xdb_export_tools_t * arg, int index) {
-            for (auto const & account : accounts_vec_split[index]) {
-                json j;
-                arg->query_account_data(account, j, func);
-                j_vec[index][account] = j;
-                std::cout << account << " " << func.data_type() << " query finish: " << j.get<std::string>() << std::endl;
-            }
-        };
-        std::vector<std::thread> all_thread;
-        for (auto i = 0U; i < thread_num; i++) {
-            std::thread th(thread_helper, this, i);
-            all_thread.emplace_back(std::move(th));
-        }
-        for (auto i = 0U; i < thread_num; i++) {
-            all_thread[i].join();
-        }
-        for (auto const & j : j_vec) {            
-            for (auto acc = j.begin(); acc != j.end(); acc++) {
-                result_json[acc.key()] = acc.value();
-            }
-        }
-    }
-
     std::string filename;
     if (accounts_vec.size() == 1) {
         filename = accounts_vec[0] + "_" + func.data_type() + ".json";
@@ -208,35 +174,44 @@ void xdb_export_tools_t::query_all_account_data(std::vector<std::string> const &
             filename = "all_unit_" + func.data_type() + ".json";
         }
     }
-    std::ofstream out_json(filename);
-    out_json << std::setw(4) << result_json;
+
+    {
+        xjson_object_writer_t writer{filename};
+        parallel_for_each_account(accounts_vec, m_thread_num, [this, &writer, &func](std::string const & account) {
+            json j;
+            query_account_data(account, j, func);
+            writer.write(account, j);
+            std::cout << account << " " << func.data_type() << " query finish: " << j.get<std::string>() << std::endl;
+        });
+    }
     std::cout << "===> " << filename << " generated success!" << std::endl;
 }
 
 void xdb_export_tools_t::query_all_table_mpt(std::vector<std::string> const & accounts_vec) {
-    json result_json;
-    for (auto const & account : accounts_vec) {
-        json j;
-        query_table_mpt(account, j);
-        result_json[account] = j;
-        std::cout << account << " mpt query finish: " << j.get<std::string>() << std::endl;
-    }
-
     std::string filename = "all_table_mpt.json";
-    std::ofstream out_json(filename);
-    out_json << std::setw(4) << result_json;
+    {
+        xjson_object_writer_t writer{filename};
+        parallel_for_each_account(accounts_vec, m_thread_num, [this, &writer](std::string const & account) {
+            json j;
+            query_table_mpt(account, j);
+            writer.write(account, j);
+            std::cout << account << " mpt query finish: " << j.get<std::string>() << std::endl;
+        });
+    }
     std::cout << "===> " << filename << " generated success!" << std::endl;
 }
 
 void xdb_export_tools_t::query_table_latest_fullblock() {
-    json result_json;
     auto const account_vec = xdb_export_tools_t::get_table_accounts();
-    for (auto const & _p : account_vec) {
-        query_table_latest_fullblock(_p, result_json[_p]);
-    }
     std::string filename = "all_latest_fullblock_info.json";
-    std::ofstream out_json(filename);
-    out_json << std::setw(4) << result_json;
+    {
+        xjson_object_writer_t writer{filename};
+        parallel_for_each_account(account_vec, m_thread_num, [this, &writer](std::string const & account) {
+            json j;
+            query_table_latest_fullblock(account, j);
+            writer.write(account, j);
+        });
+    }
     std::cout << "===> " << filename << " generated success!" << std::endl;
 }
 
@@ -313,10 +288,10 @@ void xdb_export_tools_t::query_table_performance(std::string const & account) {
 }
 
 void xdb_export_tools_t::query_all_table_performance(std::vector<std::string> const & accounts_vec) {
-    for (auto const & account : accounts_vec) {
+    parallel_for_each_account(accounts_vec, m_thread_num, [this](std::string const & account) {
         query_table_performance(account);
         std::cout << account << " table performance query finish" << std::endl;
-    }
+    });
 }
 
 void GetFiles(const std::string& img_dir_path,std::vector<std::string> &img_file_paths)
@@ -1662,6 +1637,13 @@ void xdb_export_tools_t::set_outfile_folder(std::string const & folder) {
     m_outfile_folder = folder;
 }
 
+void xdb_export_tools_t::set_thread_num(uint32_t const thread_num) {
+    if (thread_num != 0) {
+        m_thread_num = thread_num;
+    }
+    std::cout << "use thread num: " << m_thread_num << std::endl;
+}
+
 
 
 void xdb_export_tools_t::parse_info_set(xdbtool_parse_info_t &info, int db_key_type, uint64_t value_size)
@@ -2079,6 +2061,17 @@ std::string xdb_check_data_func_block_t::data_type() const {
     return "sync_result";
 }
 
+// the new and the old key are read at one point, a value moved from one to the other in between is still found
+static bool exist_in_snapshot(std::vector<std::string> const & keys) {
+    auto const values = base::xvchain_t::instance().get_xdbstore()->create_snapshot()->get_values(keys);
+    for (auto const & value : values) {
+        if (!value.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool xdb_check_data_func_table_state_t::is_data_exist(base::xvblockstore_t * blockstore, std::string const & account, uint64_t height) const {
     auto vblock = blockstore->load_block_object(account, height, base::enum_xvblock_flag_committed, false);
     data::xblock_t * block = dynamic_cast<data::xblock_t *>(vblock.get());
@@ -2087,8 +2080,8 @@ bool xdb_check_data_func_table_state_t::is_data_exist(base::xvblockstore_t * blo
     }
 
     auto state_db_key = base::xvdbkey_t::create_prunable_state_key(account, height, block->get_block_hash());
-    const std::string state_db_bin = base::xvchain_t::instance().get_xdbstore()->get_value(state_db_key);
-    return !state_db_bin.empty();
+    auto state_db_key_old = base::xvdbkey_t::create_prunable_state_key_old(account, height, block->get_block_hash());
+    return exist_in_snapshot({state_db_key, state_db_key_old});
 }
 std::string xdb_check_data_func_table_state_t::data_type() const {
     return "state_data";
@@ -2116,11 +2109,264 @@ bool xdb_check_data_func_off_data_t::is_data_exist(base::xvblockstore_t * blocks
         return false;
     }
     const std::string key = base::xvdbkey_t::create_prunable_block_output_offdata_key(vblock->get_account(), height, vblock->get_viewid());
-    const std::string state_db_bin = base::xvchain_t::instance().get_xdbstore()->get_value(key);
-    return !state_db_bin.empty();
+    const std::string key_old = base::xvdbkey_t::create_prunable_block_output_offdata_key_old(vblock->get_account(), height, vblock->get_viewid());
+    return exist_in_snapshot({key, key_old});
 }
 std::string xdb_check_data_func_off_data_t::data_type() const {
     return "off_data";
 }
 
+void xdb_export_tools_t::export_block_archive(std::vector<std::string> const & accounts_vec, std::string const & archive_file) {
+    store::xblock_archive_writer_t writer;
+    if (!writer.open(archive_file)) {
+        std::cerr << "open archive file " << archive_file << " failed!" << std::endl;
+        return;
+    }
+    for (auto const & account : accounts_vec) {
+        base::xvaccount_t const _vaccount(account);
+        auto const committed_height = m_blockstore->get_latest_committed_block_height(_vaccount);
+        uint64_t count = 0;
+        for (uint64_t h = 0; h <= committed_height; h++) {
+            auto const block = m_blockstore->load_block_object(_vaccount, h, base::enum_xvblock_flag_committed, true);
+            if (block == nullptr) {  // pruned or not synced yet
+                continue;
+            }
+            if (!writer.append(block.get())) {
+                std::cerr << "account: " << account << " , height: " << h << " append archive failed!" << std::endl;
+                continue;
+            }
+            count++;
+        }
+        std::cout << "account: " << account << " , committed height: " << committed_height << " , archived blocks: " << count << std::endl;
+    }
+    if (!writer.close()) {
+        std::cerr << "close archive file " << archive_file << " failed!" << std::endl;
+        return;
+    }
+    std::cout << "===> " << archive_file << " generated success! blocks: " << writer.get_blocks_count() << std::endl;
+}
+
+data::xtransaction_ptr_t xdb_export_tools_t::load_send_raw_tx(std::string const & tx_hash) {
+    base::xauto_ptr<base::xvtxindex_t> txindex = m_txstore->load_tx_idx(tx_hash, base::enum_transaction_subtype_send);
+    if (txindex == nullptr) {
+        return nullptr;
+    }
+    base::xvaccount_t const _vaccount(txindex->get_block_addr());
+    auto const vblock = m_blockstore->load_block_object(_vaccount, txindex->get_block_height(), txindex->get_block_hash(), false);
+    if (vblock == nullptr || !m_blockstore->load_block_input(_vaccount, vblock.get())) {
+        return nullptr;
+    }
+    auto const * block = dynamic_cast<data::xblock_t *>(vblock.get());
+    return block != nullptr ? block->query_raw_transaction(tx_hash) : nullptr;
+}
+
+bool xdb_export_tools_t::replay_table_block(blockmaker::xtable_maker_t & table_maker, base::xvblock_t * block, xreplay_stat_t & stat, std::string & error) {
+    using steady_clock = std::chrono::steady_clock;
+    auto const elapsed_us = [](steady_clock::time_point const & begin) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - begin).count();
+    };
+    base::xvaccount_t const _vaccount(block->get_account());
+
+    // #1 load prev cert/lock/commit blocks, inputs and raw txs the leader packed
+    auto begin = steady_clock::now();
+    std::vector<data::xblock_ptr_t> prev_blocks;
+    for (uint64_t i = 1; i <= 3 && i <= block->get_height(); i++) {
+        base::xvblock_t * next = prev_blocks.empty() ? block : prev_blocks.back().get();
+        auto const vblock = m_blockstore->load_block_object(_vaccount, next->get_height() - 1, next->get_last_block_hash(), true);
+        if (vblock == nullptr) {
+            error = "load prev block fail, height " + std::to_string(next->get_height() - 1);
+            return false;
+        }
+        prev_blocks.push_back(data::xblock_t::raw_vblock_to_object_ptr(vblock.get()));
+    }
+    while (prev_blocks.size() < 3) {  // genesis is cert, lock and commit block of first blocks
+        prev_blocks.push_back(prev_blocks.back());
+    }
+    if (!m_blockstore->load_block_input(_vaccount, block) || !m_blockstore->load_block_output(_vaccount, block)) {
+        error = "load block input output fail";
+        return false;
+    }
+
+    uint64_t tgas_height = 0;
+    std::string random_seed;
+    std::vector<data::xcons_transaction_ptr_t> input_txs;
+    std::map<base::xtable_shortid_t, xtxpool_v2::xreceiptid_state_and_prove> receiptid_info_map;
+    if (block->get_block_class() == base::enum_xvblock_class_light) {
+        blockmaker::xtable_proposal_input_ptr_t proposal_input = make_object_ptr<blockmaker::xtable_proposal_input_t>();
+        if (proposal_input->serialize_from_string(block->get_input()->get_proposal()) <= 0) {
+            error = "no proposal input";
+            return false;
+        }
+        input_txs = proposal_input->get_input_txs();
+        for (auto & tx : input_txs) {
+            if (tx->get_transaction() == nullptr && tx->is_confirm_tx()) {  // confirm tx is packed without raw tx
+                auto const raw_tx = load_send_raw_tx(tx->get_tx_hash());
+                if (raw_tx == nullptr || !tx->set_raw_tx(raw_tx.get())) {
+                    error = "load raw tx fail, tx " + base::xstring_utl::to_hex(tx->get_tx_hash());
+                    return false;
+                }
+            }
+        }
+        for (auto & prove : proposal_input->get_receiptid_state_proves()) {
+            auto peer_receiptid_state = data::xblocktool_t::get_receiptid_from_property_prove(prove);
+            receiptid_info_map[peer_receiptid_state->get_self_tableid()] = xtxpool_v2::xreceiptid_state_and_prove(prove, peer_receiptid_state);
+        }
+
+        data::xtableheader_extra_t header_extra;
+        if (header_extra.deserialize_from_string(block->get_header()->get_extra_data()) <= 0) {
+            error = "invalid header extra data";
+            return false;
+        }
+        tgas_height = header_extra.get_tgas_total_lock_amount_property_height();
+
+        auto const drand_block = m_blockstore->load_block_object(base::xvaccount_t(sys_drand_addr), block->get_cert()->get_drand_height(), 0, true);
+        if (drand_block == nullptr) {
+            error = "load drand block fail, height " + std::to_string(block->get_cert()->get_drand_height());
+            return false;
+        }
+        // same as proposal maker
+        std::string random_str = base::xstring_utl::tostring(prev_blocks[0]->get_cert()->get_nonce());
+        random_str += base::xstring_utl::tostring(block->get_cert()->get_viewtoken());
+        random_str += drand_block->get_cert()->get_verify_signature();
+        random_seed = base::xstring_utl::tostring(base::xhash64_t::digest(random_str));
+    }
+    stat.load_us += elapsed_us(begin);
+
+    // #2 table states which the block is executed on
+    begin = steady_clock::now();
+    auto const cert_tablestate = statestore::xstatestore_hub_t::instance()->get_table_state_by_block(prev_blocks[0].get());
+    auto const commit_tablestate = statestore::xstatestore_hub_t::instance()->get_table_state_by_block(prev_blocks[2].get());
+    if (cert_tablestate == nullptr || commit_tablestate == nullptr) {
+        error = "load table state fail";
+        return false;
+    }
+    uint64_t total_lock_tgas_token = 0;
+    if (block->get_block_class() == base::enum_xvblock_class_light &&
+        !store::xtgas_singleton::get_instance().backup_get_total_lock_tgas_token(block->get_clock(), tgas_height, total_lock_tgas_token)) {
+        error = "load total lock tgas fail, property height " + std::to_string(tgas_height);
+        return false;
+    }
+    stat.state_us += elapsed_us(begin);
+
+    data::xblock_consensus_para_t cs_para(block->get_account(), block->get_clock(), block->get_viewid(), block->get_viewtoken(), block->get_height(), block->get_second_level_gmtime());
+    cs_para.set_latest_blocks(prev_blocks[0], prev_blocks[1], prev_blocks[2]);
+    cs_para.set_table_state(cert_tablestate, commit_tablestate);
+    cs_para.set_timeofday_s(block->get_second_level_gmtime());
+    cs_para.set_parent_height(prev_blocks[0]->get_height() + 1);
+    cs_para.set_common_consensus_para(block->get_clock(), block->get_cert()->get_validator(), block->get_cert()->get_auditor(),
+                                      block->get_viewid(), block->get_viewtoken(), block->get_cert()->get_drand_height());
+    if (block->get_block_class() == base::enum_xvblock_class_light) {
+        cs_para.set_tableblock_consensus_para(block->get_cert()->get_drand_height(), random_seed, total_lock_tgas_token, tgas_height);
+    }
+    // only eth user leader is paid as coinbase, same as proposal maker
+    common::xaccount_address_t coinbase = eth_zero_address;
+    base::xauto_ptr<base::xvnode_t> leader = m_nodesvr_ptr->get_node(cs_para.get_leader_xip());
+    if (leader != nullptr) {
+        auto const addr_type = base::xvaccount_t::get_addrtype_from_account(leader->get_account());
+        if (addr_type == base::enum_vaccount_addr_type_secp256k1_eth_user_account || addr_type == base::enum_vaccount_addr_type_secp256k1_evm_user_account) {
+            coinbase = common::xaccount_address_t(leader->get_account());
+        }
+    }
+    cs_para.set_coinbase(coinbase);
+    cs_para.set_block_gaslimit(XGET_ONCHAIN_GOVERNANCE_PARAMETER(block_gas_limit));
+    cs_para.set_block_base_price(gasfee::xgas_estimate::base_price());
+
+    blockmaker::xtablemaker_para_t table_para(cert_tablestate, commit_tablestate);
+    table_para.set_pack_resource(xtxpool_v2::xpack_resource(input_txs, receiptid_info_map));
+
+    // #3 execute txs, make units and table and compare with the stored block
+    begin = steady_clock::now();
+    int32_t ret = table_maker.verify_proposal(block, table_para, cs_para);
+    stat.execute_us += elapsed_us(begin);
+    stat.txs += input_txs.size();
+    if (ret != xsuccess) {
+        error = "replay not match, error " + chainbase::xmodule_error_to_str(ret);
+        return false;
+    }
+    return true;
+}
+
+void xdb_export_tools_t::replay_table(std::string const & account, const uint64_t start_height, const uint64_t end_height) {
+    base::xvaccount_t const _vaccount(account);
+    if (_vaccount.get_addr_type() != base::enum_vaccount_addr_type_block_contract) {
+        std::cerr << "account: " << account << " is not a table" << std::endl;
+        return;
+    }
+    uint64_t const committed_height = m_blockstore->get_latest_committed_block_height(_vaccount);
+    uint64_t const last_height = std::min(end_height, committed_height);
+    if (start_height == 0 || start_height > last_height) {
+        std::cerr << "account: " << account << " , committed height: " << committed_height << " , invalid range " << start_height << "-" << end_height << std::endl;
+        return;
+    }
+
+    // the maker only reads the given states and blocks, txpool is not used by backup
+    blockmaker::xblockmaker_resources_ptr_t resources = std::make_shared<blockmaker::xblockmaker_resources_impl_t>(
+        make_observer(m_blockstore.get()), observer_ptr<xtxpool_v2::xtxpool_face_t>{nullptr}, make_observer(m_bus.get()));
+    blockmaker::xtable_maker_ptr_t table_maker = make_object_ptr<blockmaker::xtable_maker_t>(account, resources);
+
+    json root;
+    xreplay_stat_t stat;
+    auto const begin = std::chrono::steady_clock::now();
+    for (uint64_t h = start_height; h <= last_height; h++) {
+        auto const vblock = m_blockstore->load_block_object(_vaccount, h, base::enum_xvblock_flag_committed, true);
+        if (vblock == nullptr) {
+            std::cerr << "account: " << account << " , height: " << h << " block null" << std::endl;
+            continue;
+        }
+        std::string error;
+        stat.blocks++;
+        if (!replay_table_block(*table_maker, vblock.get(), stat, error)) {
+            stat.failed_blocks++;
+            root["failed"]["h" + std::to_string(h)] = error;
+            std::cerr << "account: " << account << " , height: " << h << " replay failed: " << error << std::endl;
+        }
+    }
+    auto const total_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    root["account"] = account;
+    root["range"] = std::to_string(start_height) + "-" + std::to_string(last_height);
+    root["blocks"] = stat.blocks;
+    root["failed_blocks"] = stat.failed_blocks;
+    root["txs"] = stat.txs;
+    root["total_ms"] = total_us / 1000;
+    root["load_ms"] = stat.load_us / 1000;
+    root["state_ms"] = stat.state_us / 1000;
+    root["execute_ms"] = stat.execute_us / 1000;
+    root["tps"] = stat.execute_us == 0 ? 0 : stat.txs * 1000000 / stat.execute_us;
+    root["max_rss_kb"] = (int64_t)usage.ru_maxrss;
+    std::cout << root.dump(4) << std::endl;
+    generate_json_file(std::string(account + "_replay.json"), root);
+}
+
+void xdb_export_tools_t::import_block_archive(std::string const & archive_file) {
+    store::xblock_archive_reader_t reader;
+    if (!reader.open(archive_file)) {
+        std::cerr << "open archive file " << archive_file << " failed!" << std::endl;
+        return;
+    }
+    for (auto const & _p : reader.get_index()) {
+        base::xvaccount_t const _vaccount(_p.first);
+        uint64_t count = 0;
+        for (auto const & entry : _p.second) {
+            base::xauto_ptr<base::xvblock_t> block(reader.load_block(_p.first, entry.height));
+            if (block == nullptr) {
+                std::cerr << "account: " << _p.first << " , height: " << entry.height << " load from archive failed!" << std::endl;
+                break;
+            }
+            // archive only holds blocks committed at local node
+            block->set_block_flag(base::enum_xvblock_flag_authenticated);
+            block->set_block_flag(base::enum_xvblock_flag_locked);
+            block->set_block_flag(base::enum_xvblock_flag_committed);
+            if (!m_blockstore->store_block(_vaccount, block.get())) {
+                std::cerr << "account: " << _p.first << " , height: " << entry.height << " store failed!" << std::endl;
+                break;
+            }
+            count++;
+        }
+        std::cout << "account: " << _p.first << " , imported blocks: " << count << "/" << _p.second.size() << std::endl;
+    }
+}
+
 NS_END2
@@ -8,9 +8,10 @@ NS_BEG2(top, db_export)
 xdb_read_tools_t::xdb_read_tools_t(std::string const & db_path) {
     int dst_db_kind = 0;
     std::vector<db::xdb_path_t> db_data_paths {};
-    base::xvchain_t::instance().get_db_config_custom(db_data_paths, dst_db_kind);
+    db::xdb_options_t db_options {};
+    base::xvchain_t::instance().get_db_config_custom(db_data_paths, dst_db_kind, db_options);
     dst_db_kind |= top::db::xdb_kind_readonly;
-    std::shared_ptr<db::xdb_face_t> db = top::db::xdb_factory_t::create(dst_db_kind, db_path, db_data_paths);
+    std::shared_ptr<db::xdb_face_t> db = top::db::xdb_factory_t::create(dst_db_kind, db_path, db_data_paths, db_options);
     m_store = store::xstore_factory::create_store_with_static_kvdb(db);
     m_xvdb_ptr = m_store.get();
     m_xvblockdb_ptr = new store::xvblockdb_t(m_xvdb_ptr);
@@ -27,6 +27,8 @@
 #include "xdata/xproposal_data.h"
 #include "xdata/xsystem_contract/xdata_structures.h"
 #include "xdata/xtable_bstate.h"
+#include "xdepends/include/asio/post.hpp"
+#include "xdepends/include/asio/thread_pool.hpp"
 
 #define XPROPERTY_CONTRACT_ELECTION_RESULT_0_KEY  "@42_0"
 #define XPROPERTY_CONTRACT_ELECTION_RESULT_1_KEY  "@42_1"
@@ -890,4 +892,39 @@ static void parse_election_result_string(std::string const & str, json & j) {
     }
 }
 
+xjson_object_writer_t::xjson_object_writer_t(std::string const & filename) : m_out{filename} {
+    m_out << "{";
+}
+
+xjson_object_writer_t::~xjson_object_writer_t() {
+    m_out << (m_empty ? "}" : "\n}") << std::endl;
+}
+
+void xjson_object_writer_t::write(std::string const & key, json const & value) {
+    // same layout as std::setw(4) on the whole object
+    std::string member = value.dump(4);
+    for (auto pos = member.find('\n'); pos != std::string::npos; pos = member.find('\n', pos + 5)) {
+        member.replace(pos, 1, "\n    ");
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_out << (m_empty ? "\n    " : ",\n    ") << json(key).dump() << ": " << member;
+    m_empty = false;
+}
+
+void parallel_for_each_account(std::vector<std::string> const & accounts, uint32_t thread_num, std::function<void(std::string const &)> const & func) {
+    if (thread_num <= 1 || accounts.size() <= 1) {
+        for (auto const & account : accounts) {
+            func(account);
+        }
+        return;
+    }
+
+    asio::thread_pool pool(std::min<std::size_t>(thread_num, accounts.size()));
+    for (auto const & account : accounts) {
+        asio::post(pool, [&func, &account] { func(account); });
+    }
+    pool.join();
+}
+
 NS_END2
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "xbasic/xtimer_driver.h"
+#include "xblockmaker/xtable_maker.h"
 #include "xdb_util.h"
 #include "xgrpcservice/xgrpc_service.h"
 #include "xmbus/xmessage_bus.h"
@@ -79,6 +80,8 @@ public:
     void query_checkpoint(const uint64_t clock);
     // set folder
     void set_outfile_folder(std::string const & folder);
+    // set the threads of the scans over all accounts
+    void set_thread_num(uint32_t const thread_num);
     void compact_db();
     static bool  db_scan_key_callback(const std::string& key, const std::string& value,void*cookie);
     bool   db_scan_key_callback(const std::string& key, const std::string& value);
@@ -86,6 +89,12 @@ public:
     std::string get_account_key_string(const std::string & key);
     void   prune_db();
     void   query_all_table_performance(std::vector<std::string> const & accounts_vec);
+    // write committed blocks of accounts into read-only archive segment
+    void   export_block_archive(std::vector<std::string> const & accounts_vec, std::string const & archive_file);
+    // rebuild db from blocks of archive segment
+    void   import_block_archive(std::string const & archive_file);
+    // re-execute committed table blocks of [start_height, end_height] by table maker and check them with the stored ones
+    void   replay_table(std::string const & account, const uint64_t start_height, const uint64_t end_height);
 private:
     struct tx_ext_t {
         base::xtable_shortid_t  sendtableid;
@@ -364,6 +373,17 @@ private:
                                  std::map<std::string, tx_check_result_info_t> & tx_result_list);
     void query_table_performance(std::string const & account);
 
+    struct xreplay_stat_t {
+        uint64_t blocks{0};
+        uint64_t failed_blocks{0};
+        uint64_t txs{0};
+        uint64_t load_us{0};     // blocks, proposal input and raw txs
+        uint64_t state_us{0};    // table states of cert and commit blocks
+        uint64_t execute_us{0};  // execute txs, make units, mpt root and compare with stored block
+    };
+    bool replay_table_block(blockmaker::xtable_maker_t & table_maker, base::xvblock_t * block, xreplay_stat_t & stat, std::string & error);
+    data::xtransaction_ptr_t load_send_raw_tx(std::string const & tx_hash);
+
     std::unique_ptr<xbase_timer_driver_t> m_timer_driver;
     xobject_ptr_t<mbus::xmessage_bus_face_t> m_bus;
     xobject_ptr_t<store::xstore_face_t> m_store;
@@ -374,6 +394,7 @@ private:
 
     std::map<std::string, std::map<std::string, base::xaccount_index_t>> m_db_units_info;
     std::string m_outfile_folder;
+    uint32_t m_thread_num{8};
     std::mutex m_write_lock;
     
     struct xdbtool_parse_info_t {
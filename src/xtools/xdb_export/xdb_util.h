@@ -8,10 +8,14 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 NS_BEG2(top, db_export)
 
@@ -23,4 +27,24 @@ using json = unordered_json;
 
 void property_json(xobject_ptr_t<base::xvbstate_t> const & state, json & j);
 
+// writes the members of one json object to a file as they are ready, so a scan keeps only the member being written in memory
+class xjson_object_writer_t {
+public:
+    explicit xjson_object_writer_t(std::string const & filename);
+    ~xjson_object_writer_t();
+    xjson_object_writer_t(xjson_object_writer_t const &) = delete;
+    xjson_object_writer_t & operator=(xjson_object_writer_t const &) = delete;
+
+    // thread safe, the members are written in the order of the calls
+    void write(std::string const & key, json const & value);
+
+private:
+    std::mutex m_mutex;
+    std::ofstream m_out;
+    bool m_empty{true};
+};
+
+// calls func for each account on thread_num threads, a thread takes the next account when it is free
+void parallel_for_each_account(std::vector<std::string> const & accounts, uint32_t thread_num, std::function<void(std::string const &)> const & func);
+
 NS_END2
\ No newline at end of file
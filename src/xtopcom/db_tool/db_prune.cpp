@@ -34,7 +34,7 @@ DbPrune & DbPrune::instance() {
     static DbPrune prune;
     return prune;
 }
-int DbPrune::db_init(const std::string datadir) {
+int DbPrune::db_init(const std::string datadir, const db::xdb_options_t * db_options) {
     auto hash_plugin = new xtop_hash_t();
     data::xrootblock_para_t para;
     data::xrootblock_t::init(para);
@@ -72,14 +72,15 @@ int DbPrune::db_init(const std::string datadir) {
         }
     }
     
-    std::shared_ptr<db::xdb_face_t> db;
     std::string db_path = datadir + DB_PATH;
-    if (db_path_num > 1)    {
-        db = db::xdb_factory_t::instance(db_path, db_data_paths);
+    if (db_options != nullptr) {
+        m_db = db::xdb_factory_t::create(db::xdb_kind_kvdb, db_path, db_data_paths, *db_options);
+    } else if (db_path_num > 1)    {
+        m_db = db::xdb_factory_t::instance(db_path, db_data_paths);
     } else {
-        db = db::xdb_factory_t::instance(db_path);
+        m_db = db::xdb_factory_t::instance(db_path);
     }
-    m_store = top::store::xstore_factory::create_store_with_static_kvdb(db);
+    m_store = top::store::xstore_factory::create_store_with_static_kvdb(m_db);
     base::xvchain_t::instance().set_xdbstore(m_store.get());
     auto _static_blockstore = store::create_vblockstore(m_store.get());
 
@@ -285,4 +286,40 @@ void DbPrune::compact_db(const std::string datadir, std::ostringstream& out_str)
     out_str << "compact database ok." << std::endl;
     db_close();
 }
+int DbPrune::migrate_cf(const std::string datadir, std::ostringstream& out_str) {
+    std::cout << "migrate column families of db: " << datadir << std::endl;
+    db_init(datadir);
+
+    int ret = 0;
+    if (m_db->migrate_cf_layout()) {
+        out_str << "migrate column families ok." << std::endl;
+    } else {
+        out_str << "migrate column families failed, run it again to resume." << std::endl;
+        ret = 1;
+    }
+    db_close();
+    return ret;
+}
+int DbPrune::recompress_db(const std::string datadir, const uint32_t dict_bytes, std::ostringstream& out_str) {
+    std::cout << "recompress db: " << datadir << " with dictionary bytes " << dict_bytes << std::endl;
+    std::vector<db::xdb_path_t> db_data_paths;
+    int db_kind = db::xdb_kind_kvdb;
+    db::xdb_options_t db_options;
+    base::xvchain_t::instance().get_db_config_custom(db_data_paths, db_kind, db_options);
+    db_options.zstd_dict_bytes = dict_bytes;
+    db_init(datadir, &db_options);
+
+    // force compaction of bottom level, each new SST is compressed by dictionary trained from its own samples
+    std::string begin_key;
+    std::string end_key;
+    int ret = 0;
+    if (m_store->compact_range(begin_key, end_key)) {
+        out_str << "recompress database ok." << std::endl;
+    } else {
+        out_str << "recompress database failed." << std::endl;
+        ret = 1;
+    }
+    db_close();
+    return ret;
+}
 NS_END2
\ No newline at end of file
@@ -19,9 +19,10 @@ class DbPrune {
 private:
     xobject_ptr_t<store::xstore_face_t> m_store;
     xobject_ptr_t<base::xvblockstore_t> m_blockstore;
+    std::shared_ptr<db::xdb_face_t> m_db;
     int update_meta(base::xvaccount_t& _vaddr, const uint64_t& height);
 
-    int db_init(const std::string datadir);
+    int db_init(const std::string datadir, const db::xdb_options_t * db_options = nullptr);
     int db_close();
     std::vector<std::string> get_db_unit_accounts();
     std::vector<std::string> get_table_accounts();
@@ -32,6 +33,9 @@ public:
     int db_prune(const std::string& node_addr, const std::string& datadir, std::ostringstream & out_str);
     int db_convert(const std::string& miner_type, const std::string& datadir, std::ostringstream & out_str);
     void compact_db(const std::string datadir, std::ostringstream& out_str);
+    int migrate_cf(const std::string datadir, std::ostringstream& out_str);
+    // rewrite bottom level of block CFs, which trains new ZSTD dictionaries(refer xdb_options_t::zstd_dict_bytes)
+    int recompress_db(const std::string datadir, const uint32_t dict_bytes, std::ostringstream& out_str);
 };
 
 class xtop_hash_t : public top::base::xhashplugin_t {
@@ -526,6 +526,8 @@ namespace top
                         if (!_proposal->get_block()->get_vote_extend_data().empty()) {
                             xdbg("nathan test vote msg inner proposal:%s,vote data size:%d,:%s", _proposal->dump().c_str(), _proposal->get_block()->get_vote_extend_data().size(), _proposal->get_block()->get_vote_extend_data().c_str());
                         }
+                        //vote goes to leader directly: schnorr sign of each replica uses its own nonce point,and vote carry per-replica extend data,
+                        //so intermediate replicas could not fold votes into one partial signature;leader verify them in one batch instead(see verify_pending_votes)
                         xvote_msg_t _vote_msg(*_proposal->get_proposal_cert(), _proposal->get_block()->get_vote_extend_data());
                         _vote_msg.serialize_to_string(msg_stream);
                         fire_pdu_event_up(xvote_msg_t::get_msg_type(),msg_stream,_proposal->get_proposal_msg_nonce() + 1,get_xip2_addr(),peer_addr,_proposal->get_block());
@@ -1258,78 +1260,16 @@ namespace top
             if( (NULL == replica_cert) || (NULL == local_proposal) )
                 return false;
 
-            replica_cert->add_ref();
-            auto _verify_function = [this,replica_xip,replica_cert, vote_extend_data](base::xcall_t & call, const int32_t cur_thread_id,const uint64_t timenow_ms)->bool{
-                base::xauto_ptr<base::xvqcert_t> _dummy_release(replica_cert);//auto release the added addtional once quit
-                if(is_close() == false)//running at a specific worker thread of pool
-                {
-                    xproposal_t * _proposal = (xproposal_t *)call.get_param1().get_object();
-                    if(_proposal->is_vote_disable()) //quick path to exit while proposal has been disabled
-                    {
-                        xwarn("xBFTdriver_t::fire_verify_vote_job,had disabled proposal=%s,at node=0x%llx",_proposal->dump().c_str(),replica_xip.low_addr);
-                        return true;
-                    }
+            //queue vote first,then job take all queued votes to verify as one batch,so votes arrived while verifying are verified together
+            local_proposal->push_pending_vote(replica_xip,replica_cert,vote_extend_data);
+            auto _verify_function = [this](base::xcall_t & call, const int32_t cur_thread_id,const uint64_t timenow_ms)->bool{
+                xproposal_t * _proposal = (xproposal_t *)call.get_param1().get_object();
+                std::vector<xproposal_t::xpending_vote_t> _votes = _proposal->pop_pending_votes();
+                if( (is_close() == false) && (false == _votes.empty()) )//running at a specific worker thread of pool
+                    verify_pending_votes(_proposal,_votes,(base::xfunction_t *)call.get_param2().get_function());
 
-                    if(false == _proposal->is_vote_finish()) //check first as async case,it might be finished already
-                    {
-                        XMETRICS_GAUGE(metrics::cpu_ca_verify_sign_xbft, 1);
-                        if(get_vcertauth()->verify_sign(replica_xip, replica_cert,_proposal->get_account()) == base::enum_vcert_auth_result::enum_successful) //verify partial-certication of msg
-                        {
-                            std::string extend_data_result;
-                            if (!verify_vote_extend_data(_proposal->get_block(), replica_xip, vote_extend_data, extend_data_result)) {
-                                    xerror("xBFTdriver_t::fire_verify_vote_job,fail-verify vote extend data _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
-                                    return true;
-                            }
-                            if(_proposal->add_voted_cert(replica_xip,replica_cert,get_vcertauth())) //add to local list
-                            {
-                                add_vote_extend_data(_proposal->get_block(), replica_xip, vote_extend_data, extend_data_result);
-                                if(_proposal->is_vote_finish()) //check again
-                                {
-                                    if(false == _proposal->get_voted_validators().empty())
-                                    {
-                                        XMETRICS_GAUGE(metrics::cpu_ca_merge_sign_xbft, 1);
-                                        const std::string merged_sign_for_validators = get_vcertauth()->merge_muti_sign(_proposal->get_voted_validators(), _proposal->get_block());
-                                        _proposal->get_block()->set_verify_signature(merged_sign_for_validators);
-                                    }
-                                    if(false == _proposal->get_voted_auditors().empty())
-                                    {
-                                        XMETRICS_GAUGE(metrics::cpu_ca_merge_sign_xbft, 1);
-                                        const std::string merged_sign_for_auditors = get_vcertauth()->merge_muti_sign(_proposal->get_voted_auditors(), _proposal->get_block());
-                                        _proposal->get_block()->set_audit_signature(merged_sign_for_auditors);
-                                    }
-                                    if (!proc_vote_complate(_proposal->get_block())) {
-                                        xwarn("xBFTdriver_t::fire_verify_vote_job,fail-proc vote complate _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
-                                        return true;
-                                    }
-                                    
-                                    XMETRICS_GAUGE(metrics::cpu_ca_verify_multi_sign_xbft, 1);
-                                    if(get_vcertauth()->verify_muti_sign(_proposal->get_block()) == base::enum_vcert_auth_result::enum_successful) //quorum certification and  check if majority voted
-                                    {
-                                        _proposal->get_cert()->set_unit_flag(base::enum_xvblock_flag_authenticated);
-                                        _proposal->get_block()->set_block_flag(base::enum_xvblock_flag_authenticated);
-                                        //--------------after below line, block not allow do any change  anymore------------
-                                        xinfo("xBFTdriver_t::fire_verify_vote_job,successful collect enough vote and verified for _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
-
-                                        base::xfunction_t* _callback_ = (base::xfunction_t *)call.get_param2().get_function();
-                                        if(_callback_ != NULL)
-                                        {
-                                            _proposal->add_ref(); //hold for async call
-                                            dispatch_call(*_callback_,(void*)_proposal);//send callback to engine'own thread
-                                        }
-                                    }
-                                    else
-                                        xerror("xBFTdriver_t::fire_verify_vote_job,fail-verify_muti_sign for _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
-                                }
-                            }
-                            else
-                            {
-                                XMETRICS_GAUGE(metrics::bft_verify_vote_msg_fail, 1);
-                            }
-                        }
-                        else
-                            xerror("xBFTdriver_t::fire_verify_vote_job,fail-verify_sign for replica_cert=%s,at node=0x%llx",replica_cert->dump().c_str(),get_xip2_low_addr());
-                    }
-                }
+                for(auto & vote : _votes)
+                    vote.voted_cert->release_ref();//release the reference added by push_pending_vote
                 return true;
             };
 
@@ -1342,6 +1282,89 @@ namespace top
                 return (dispatch_call(asyn_verify_call) == enum_xcode_successful);
         }
 
+        void xBFTdriver_t::verify_pending_votes(xproposal_t * _proposal,const std::vector<xproposal_t::xpending_vote_t> & votes,base::xfunction_t * callback)
+        {
+            if(_proposal->is_vote_disable()) //quick path to exit while proposal has been disabled
+            {
+                xwarn("xBFTdriver_t::verify_pending_votes,had disabled proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
+                return;
+            }
+            if(_proposal->is_vote_finish()) //check first as async case,it might be finished already
+                return;
+
+            std::vector<xvip2_t>                 signers;
+            std::vector<const base::xvqcert_t*>  voted_certs;
+            signers.reserve(votes.size());
+            voted_certs.reserve(votes.size());
+            for(auto & vote : votes)
+            {
+                signers.push_back(vote.voter_xip);
+                voted_certs.push_back(vote.voted_cert);
+            }
+            XMETRICS_GAUGE(metrics::cpu_ca_verify_sign_xbft, (int64_t)votes.size());
+            std::vector<base::enum_vcert_auth_result> verify_results;
+            get_vcertauth()->verify_signs(signers,voted_certs,_proposal->get_account(),verify_results); //verify partial-certication of msgs
+
+            for(size_t i = 0; i < votes.size(); ++i)
+            {
+                const xproposal_t::xpending_vote_t & vote = votes[i];
+                if(verify_results[i] != base::enum_vcert_auth_result::enum_successful)
+                {
+                    xerror("xBFTdriver_t::verify_pending_votes,fail-verify_sign for replica_cert=%s,at node=0x%llx",vote.voted_cert->dump().c_str(),get_xip2_low_addr());
+                    continue;
+                }
+
+                std::string extend_data_result;
+                if (!verify_vote_extend_data(_proposal->get_block(), vote.voter_xip, vote.vote_extend_data, extend_data_result)) {
+                    xerror("xBFTdriver_t::verify_pending_votes,fail-verify vote extend data _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
+                    continue;
+                }
+                if(false == _proposal->add_voted_cert(vote.voter_xip,vote.voted_cert,get_vcertauth())) //add to local list
+                {
+                    XMETRICS_GAUGE(metrics::bft_verify_vote_msg_fail, 1);
+                    continue;
+                }
+                add_vote_extend_data(_proposal->get_block(), vote.voter_xip, vote.vote_extend_data, extend_data_result);
+                if(false == _proposal->is_vote_finish()) //check again
+                    continue;
+
+                if(false == _proposal->get_voted_validators().empty())
+                {
+                    XMETRICS_GAUGE(metrics::cpu_ca_merge_sign_xbft, 1);
+                    const std::string merged_sign_for_validators = get_vcertauth()->merge_muti_sign(_proposal->get_voted_validators().voters(), _proposal->get_voted_validators().signatures(), _proposal->get_block());
+                    _proposal->get_block()->set_verify_signature(merged_sign_for_validators);
+                }
+                if(false == _proposal->get_voted_auditors().empty())
+                {
+                    XMETRICS_GAUGE(metrics::cpu_ca_merge_sign_xbft, 1);
+                    const std::string merged_sign_for_auditors = get_vcertauth()->merge_muti_sign(_proposal->get_voted_auditors().voters(), _proposal->get_voted_auditors().signatures(), _proposal->get_block());
+                    _proposal->get_block()->set_audit_signature(merged_sign_for_auditors);
+                }
+                if (!proc_vote_complate(_proposal->get_block())) {
+                    xwarn("xBFTdriver_t::verify_pending_votes,fail-proc vote complate _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
+                    return;
+                }
+
+                XMETRICS_GAUGE(metrics::cpu_ca_verify_multi_sign_xbft, 1);
+                if(get_vcertauth()->verify_muti_sign(_proposal->get_block()) == base::enum_vcert_auth_result::enum_successful) //quorum certification and  check if majority voted
+                {
+                    _proposal->get_cert()->set_unit_flag(base::enum_xvblock_flag_authenticated);
+                    _proposal->get_block()->set_block_flag(base::enum_xvblock_flag_authenticated);
+                    //--------------after below line, block not allow do any change  anymore------------
+                    xinfo("xBFTdriver_t::verify_pending_votes,successful collect enough vote and verified for _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
+
+                    if(callback != NULL)
+                    {
+                        _proposal->add_ref(); //hold for async call
+                        dispatch_call(*callback,(void*)_proposal);//send callback to engine'own thread
+                    }
+                }
+                else
+                    xerror("xBFTdriver_t::verify_pending_votes,fail-verify_muti_sign for _proposal=%s,at node=0x%llx",_proposal->dump().c_str(),get_xip2_low_addr());
+                return; //rest votes are not needed anymore
+            }
+        }
+
         bool xBFTdriver_t::fire_verify_proposal_job(const xvip2_t leader_xip,const xvip2_t replica_xip,xproposal_t * target_proposal,base::xfunction_t &callback)
         {
             if(NULL == target_proposal)
@@ -193,6 +193,10 @@ namespace top
         //sync function under xBFTRules
         class xBFTSyncdrv : public xBFTRules
         {
+            enum
+            {
+                enum_max_sync_request_peers = 3, //a sync request is sent to the peer and up to 2 more members of its group
+            };
         public:
             xBFTSyncdrv(xcscoreobj_t & parent_object);
         protected:
@@ -222,6 +226,7 @@ namespace top
             bool  resync_local_and_peer(base::xvblock_t* peer_block,const xvip2_t & peer_addr,const xvip2_t & my_addr,const uint64_t cur_clock);
         private:
             bool                fire_verify_syncblock_job(base::xvblock_t * target_block,base::xvqcert_t * paired_cert);
+            void                send_sync_request_msg(const xvip2_t & from_addr,const xvip2_t & to_addr,const std::string & msg_stream,const uint64_t proof_block_viewid,const uint32_t proof_block_viewtoken,const uint64_t proof_block_height,const uint64_t chainid);
             
             class xsyn_request
             {
@@ -232,12 +237,15 @@ namespace top
                     expired_viewid  = 0;
                     expired_clock   = 0;
                     sync_trycount   = 0;
+                    sync_delivered  = false;
                 }
                 xsyn_request(const uint64_t _targetheight,const uint64_t _expired_clock,const uint8_t _trycount)
                 {
                     target_height   = _targetheight;
+                    expired_viewid  = 0;
                     expired_clock   = _expired_clock;
                     sync_trycount   = _trycount;
+                    sync_delivered  = false;
                 }
                 xsyn_request(const xsyn_request & obj)
                 {
@@ -249,6 +257,7 @@ namespace top
                     expired_viewid   = obj.expired_viewid;
                     expired_clock    = obj.expired_clock;
                     sync_trycount    = obj.sync_trycount;
+                    sync_delivered   = obj.sync_delivered;
                     return *this;
                 }
             public:
@@ -256,6 +265,7 @@ namespace top
                 uint64_t  expired_clock; //clock height
                 uint64_t  expired_viewid;
                 uint8_t   sync_trycount;
+                bool      sync_delivered; //first valid respond has been taken,the ones from other peers are dropped
             };
         private:
             std::map<std::string,xsyn_request>  m_syncing_requests; //hash -->height
@@ -301,6 +311,7 @@ namespace top
             bool                fire_verify_cert_job(base::xvqcert_t * target_cert);
             bool                fire_verify_commit_job(base::xvblock_t * target_block,base::xvqcert_t * paired_cert);
             bool                fire_verify_vote_job(const xvip2_t replica_xip,base::xvqcert_t*replica_cert,xproposal_t * local_proposal,base::xfunction_t &callback, const std::string & vote_extend_data);
+            void                verify_pending_votes(xproposal_t * local_proposal,const std::vector<xproposal_t::xpending_vote_t> & votes,base::xfunction_t * callback);
             bool                fire_verify_proposal_job(const xvip2_t leader_xip,const xvip2_t replica_xip,xproposal_t * target_proposal,base::xfunction_t &callback);
             
             bool                notify_proposal_fail(std::vector<xproposal_t*> & timeout_list,std::vector<xproposal_t*> &outofdate_list);
@@ -218,9 +218,30 @@ namespace top
             
             if(m_proposal_cert != NULL)
                 m_proposal_cert->release_ref();
+
+            for(auto & vote : m_pending_votes)
+                vote.voted_cert->release_ref();
             
             //xdbg("xproposal_t::destroy,dump=%s",dump().c_str());
         }
+
+        void  xproposal_t::push_pending_vote(const xvip2_t & voter_xip,base::xvqcert_t * voted_cert,const std::string & vote_extend_data)
+        {
+            if(NULL == voted_cert)
+                return;
+
+            voted_cert->add_ref();
+            std::lock_guard<std::mutex> _lock(m_pending_votes_lock);
+            m_pending_votes.push_back(xpending_vote_t{voter_xip,voted_cert,vote_extend_data});
+        }
+
+        std::vector<xproposal_t::xpending_vote_t>  xproposal_t::pop_pending_votes()
+        {
+            std::vector<xpending_vote_t> votes;
+            std::lock_guard<std::mutex> _lock(m_pending_votes_lock);
+            votes.swap(m_pending_votes);
+            return votes;
+        }
     
         bool  xproposal_t::set_highest_QC_viewid(const uint64_t new_viewid)
         {
@@ -336,8 +357,7 @@ namespace top
                         auto set_res = m_all_voted_cert.emplace(signature);//emplace do test whether item already in set
                         if(set_res.second)//return true when it is a new element
                         {
-                            auto map_res = m_voted_validators.emplace(voter_xip,signature);
-                            if(map_res.second)
+                            if(m_voted_validators.insert(voter_xip,signature))
                             {
                                 m_all_votors.emplace(account_addr_of_node);//record account to avoid duplicated nodes of same account
                                 ++m_voted_validators_count;
@@ -365,8 +385,7 @@ namespace top
                         auto set_res = m_all_voted_cert.emplace(signature);//emplace do test whether item already in set
                         if(set_res.second)//return true when it is a new element
                         {
-                            auto map_res = m_voted_auditors.emplace(voter_xip,signature);
-                            if(map_res.second)
+                            if(m_voted_auditors.insert(voter_xip,signature))
                             {
                                 m_all_votors.emplace(account_addr_of_node);//record account to avoid duplicated nodes of same account
                                 ++m_voted_auditors_count;
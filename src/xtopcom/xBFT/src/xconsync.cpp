@@ -102,11 +102,18 @@ namespace top
                 auto insert_result = m_syncing_requests.emplace(sync_key,xsyn_request(target_block_height,expired_at_clock,1));
                 if(false == insert_result.second)//duplicated sync request
                 {
-                    insert_result.first->second.sync_trycount += 1;
-                    if(insert_result.first->second.sync_trycount > 1) //allow retry 1 times
+                    if(insert_result.first->second.sync_delivered) //the delivered block did not make it,so request again
                     {
-                        xdbg("xBFTSyncdrv::send_sync_request,duplicated request for block={height=%llu with proof of viewid=%llu,viewtoken=%u to node=0x%llx,at node=0x%llx",target_block_height,proof_block_viewid,proof_block_viewtoken,to_addr.low_addr,from_addr.low_addr);
-                        return true;
+                        insert_result.first->second = xsyn_request(target_block_height,expired_at_clock,1);
+                    }
+                    else
+                    {
+                        insert_result.first->second.sync_trycount += 1;
+                        if(insert_result.first->second.sync_trycount > 1) //allow retry 1 times
+                        {
+                            xdbg("xBFTSyncdrv::send_sync_request,duplicated request for block={height=%llu with proof of viewid=%llu,viewtoken=%u to node=0x%llx,at node=0x%llx",target_block_height,proof_block_viewid,proof_block_viewtoken,to_addr.low_addr,from_addr.low_addr);
+                            return true;
+                        }
                     }
                 }
 
@@ -114,26 +121,51 @@ namespace top
                 xsync_request_t _sync_request(enum_xsync_target_block_object | enum_xsync_target_block_input | enum_xsync_target_block_output | enum_xsync_target_block_output_offdata, sync_cookie,target_block_height,target_block_hash);
                 _sync_request.serialize_to_string(msg_stream);
 
-                //construct request msg here
-                base::xauto_ptr<xcspdu_fire>_event_obj(new xcspdu_fire(get_target_pdu_class()));
-                _event_obj->set_from_xip(from_addr);
-                _event_obj->set_to_xip(to_addr);
-                _event_obj->_packet.set_block_chainid((uint32_t)chainid);
-                _event_obj->_packet.set_block_account(get_account());
-                _event_obj->_packet.set_block_height(proof_block_height);
-                _event_obj->_packet.set_block_viewid(proof_block_viewid);
-                _event_obj->_packet.set_block_viewtoken(proof_block_viewtoken);
-                _event_obj->_packet.set_block_clock(0);
-
-                _event_obj->_packet.reset_message(xsync_request_t::get_msg_type(), get_default_msg_ttl(),msg_stream,0,from_addr.low_addr,to_addr.low_addr);
-
                 xinfo("xBFTSyncdrv::send_sync_request,send request for target block={height=%llu} with proof of height=%llu,viewid=%llu,viewtoken=%u to node=0x%llx,at node=0x%llx",target_block_height,proof_block_height,proof_block_viewid,proof_block_viewtoken,to_addr.low_addr,from_addr.low_addr);
-                get_parent_node()->push_event_up(*_event_obj, this, get_thread_id(), get_time_now());
+                send_sync_request_msg(from_addr,to_addr,msg_stream,proof_block_viewid,proof_block_viewtoken,proof_block_height,chainid);
 
+                //hedge the request to the next members of the peer'group,the first valid respond is taken and the others are dropped
+                const uint32_t to_node_id    = (uint32_t)get_node_id_from_xip2(to_addr);
+                const uint32_t group_nodes   = (uint32_t)get_group_nodes_count_from_xip2(to_addr);
+                if( (to_node_id != 0x3FF) && (to_node_id < group_nodes) )//valid node id instead of broadcast address
+                {
+                    const bool same_group = is_xip2_group_equal(to_addr,from_addr);
+                    uint32_t hedged_count = 0;
+                    for(uint32_t i = 1; (i < group_nodes) && (hedged_count + 1 < enum_max_sync_request_peers); ++i)
+                    {
+                        const uint32_t node_id = (to_node_id + i) % group_nodes;
+                        if(same_group && (node_id == (uint32_t)get_node_id_from_xip2(from_addr)))
+                            continue; //skip myself
+
+                        xvip2_t hedge_addr = to_addr;
+                        reset_node_id_to_xip2(hedge_addr);
+                        set_node_id_to_xip2(hedge_addr,node_id);
+                        xdbg("xBFTSyncdrv::send_sync_request,hedge request for target block={height=%llu} to node=0x%llx,at node=0x%llx",target_block_height,hedge_addr.low_addr,from_addr.low_addr);
+                        send_sync_request_msg(from_addr,hedge_addr,msg_stream,proof_block_viewid,proof_block_viewtoken,proof_block_height,chainid);
+                        ++hedged_count;
+                    }
+                }
                 return true;
             }
             return  false;
         }
+
+        void xBFTSyncdrv::send_sync_request_msg(const xvip2_t & from_addr,const xvip2_t & to_addr,const std::string & msg_stream,const uint64_t proof_block_viewid,const uint32_t proof_block_viewtoken,const uint64_t proof_block_height,const uint64_t chainid)
+        {
+            //construct request msg here
+            base::xauto_ptr<xcspdu_fire>_event_obj(new xcspdu_fire(get_target_pdu_class()));
+            _event_obj->set_from_xip(from_addr);
+            _event_obj->set_to_xip(to_addr);
+            _event_obj->_packet.set_block_chainid((uint32_t)chainid);
+            _event_obj->_packet.set_block_account(get_account());
+            _event_obj->_packet.set_block_height(proof_block_height);
+            _event_obj->_packet.set_block_viewid(proof_block_viewid);
+            _event_obj->_packet.set_block_viewtoken(proof_block_viewtoken);
+            _event_obj->_packet.set_block_clock(0);
+
+            _event_obj->_packet.reset_message(xsync_request_t::get_msg_type(), get_default_msg_ttl(),msg_stream,0,from_addr.low_addr,to_addr.low_addr);
+            get_parent_node()->push_event_up(*_event_obj, this, get_thread_id(), get_time_now());
+        }
     
         //return true if fired sync request
         bool  xBFTSyncdrv::resync_local_and_peer(base::xvblock_t* peer_block,const xvip2_t & peer_addr,const xvip2_t & my_addr,const uint64_t cur_clock)
@@ -429,6 +461,11 @@ namespace top
             //step#3: verify request etc to protect from DDOS attack
             const std::string sync_key  = _sync_block->get_block_hash() + base::xstring_utl::tostring(_sync_block->get_height());
             auto sync_request_it = m_syncing_requests.find(sync_key);
+            if( (sync_request_it != m_syncing_requests.end()) && sync_request_it->second.sync_delivered )
+            {
+                xdbg("xBFTSyncdrv::handle_sync_respond_msg,drop duplicated respond for packet=%s,at node=0x%llx from peer:0x%llx",packet.dump().c_str(),get_xip2_low_addr(),from_addr.low_addr);
+                return enum_xconsensus_code_successful; //the first valid respond of hedged request is being verified
+            }
             if(sync_request_it == m_syncing_requests.end())
             {
                 xinfo("xBFTSyncdrv::handle_sync_respond_msg,warn-NOT find request for packet=%s,at node=0x%llx",packet.dump().c_str(),get_xip2_low_addr());
@@ -443,7 +480,7 @@ namespace top
                 //note:#1 safe rule, always cleans up flags carried by peer
                 _sync_block->reset_block_flags();  //now force to clean all flags for both block and cert
                 if(sync_request_it != m_syncing_requests.end())
-                    m_syncing_requests.erase(sync_request_it); //safe to remove local request now
+                    sync_request_it->second.sync_delivered = true; //keep it until expired,so responds from the hedged peers are dropped
                 //fire asyn job to verify signature & cert then
                 {
                     xinfo("xBFTSyncdrv::handle_sync_respond_msg,pulled un-verified commit-block:%s at node=0x%llx from peer:0x%llx,local(%s)",_sync_block->dump().c_str(),get_xip2_addr().low_addr,from_addr.low_addr,dump().c_str());
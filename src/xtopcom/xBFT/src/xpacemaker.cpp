@@ -277,6 +277,8 @@ namespace top
                        clock_height_from_latest_commit);
                 base::xatomic_t::xexchange(m_latest_view_id, new_view_id);
                 //fire view chagne event
+                //note:view moves on as soon as a new block is certified(not until it is locked or committed),and proposal of new view is built on this cert and carries it as justify,
+                //so lock of cert-1 and commit of cert-2 go along with consensus of new proposal,which is chained pipeline already
 
                 //send_call may automatically hold this reference whiling executing,so here is safe to using "this"
                 std::function<void(void*)> _aysn_update_view = [this,new_view_id,clock_height_from_latest_clock](void*)->void{
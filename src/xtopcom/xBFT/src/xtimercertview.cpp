@@ -50,7 +50,17 @@ bool xvote_cache_t::add_qcert(const xvip2_t &replica_xip, uint64_t clock, const
     if (!check(replica_xip, clock))
         return false;
 
-    // 1. add <xip,clock> to m_clocks
+    // 1. add <xip,cert_str> to m_clock_votes, a replica out of the group of the clock's votes or voted already is refused
+    auto it = m_clock_votes.find(clock);
+    if (it == m_clock_votes.end()) {
+        it = m_clock_votes.emplace(clock, xvip_votes_t{}).first;
+        it->second.create_tm = base::xtime_utl::gmttime_ms();
+    }
+    if (!it->second.validators.insert(replica_xip, qcert_bin)) {
+        return false;
+    }
+
+    // 2. add <xip,clock> to m_clocks
     {
         auto it = m_clocks.find(replica_xip);
         if (it == m_clocks.end()) {
@@ -64,22 +74,10 @@ bool xvote_cache_t::add_qcert(const xvip2_t &replica_xip, uint64_t clock, const
         }
     }
 
-    // 2. add <xip,cert_str> to m_clock_votes
-    auto it = m_clock_votes.find(clock);
-    if (it == m_clock_votes.end()) {
-        xvip_votes_t votes;
-        votes.create_tm = base::xtime_utl::gmttime_ms();
-        votes.validators[replica_xip] = qcert_bin;
-        m_clock_votes[clock] = votes;
-    } else {
-        std::map<xvip2_t,std::string,xvip2_compare> &validators = it->second.validators;
-        validators[replica_xip] = qcert_bin;
-    }
-
     return true;
 }
 
-const std::map<xvip2_t,std::string,xvip2_compare>& xvote_cache_t::get_clock_votes(uint64_t clock) {
+const xvote_set_t& xvote_cache_t::get_clock_votes(uint64_t clock) {
     auto it = m_clock_votes.find(clock);
     xassert(it != m_clock_votes.end());
     return it->second.validators;
@@ -98,10 +96,7 @@ void xvote_cache_t::clear_timeout_clock() {
             continue;
         }
 
-        std::map<xvip2_t,std::string,xvip2_compare> &validators = votes.validators;
-
-        for (auto &it2: validators) {
-            const xvip2_t &xip = it2.first;
+        votes.validators.for_each([&](const xvip2_t &xip, const std::string &) {
             auto it3 = m_clocks.find(xip);
             assert(it3!=m_clocks.end());
             assert(!it3->second.empty());
@@ -114,7 +109,7 @@ void xvote_cache_t::clear_timeout_clock() {
             if (it3->second.empty()) {
                 m_clocks.erase(xip);
             }
-        }
+        });
 
         m_clock_votes.erase(it++);
     }
@@ -302,12 +297,12 @@ void xconspacemaker_t::add_vote(const xvip2_t & xip_addr, base::xvblock_t *model
         return;
     }
 
-    const std::map<xvip2_t,std::string,xvip2_compare> &validators = m_vote_cache.get_clock_votes(clock);
+    const xvote_set_t &validators = m_vote_cache.get_clock_votes(clock);
 
     xinfo("[xconspacemaker_t::add_vote] xip {%" PRIx64 ", %" PRIx64 "}, clock %" PRIu64", version=0x%x,validators %d, threshold %d",
             xip_addr.high_addr, xip_addr.low_addr, clock, model_block->get_block_version(), validators.size(), model_block->get_cert()->get_validator_threshold());
 
-    if (validators.size() < model_block->get_cert()->get_validator_threshold())
+    if (!validators.reached(model_block->get_cert()->get_validator_threshold()))
         return;
 
     if (!merge_multi_sign(xip_addr, model_block, validators)) {
@@ -325,10 +320,10 @@ void xconspacemaker_t::add_vote(const xvip2_t & xip_addr, base::xvblock_t *model
     xcspacemaker_t::send_call(_aysn_update_view,(void*)NULL);
 }
 
-bool xconspacemaker_t::merge_multi_sign(const xvip2_t &xip_addr, base::xvblock_t *block, const std::map<xvip2_t,std::string,xvip2_compare> &validators) {
+bool xconspacemaker_t::merge_multi_sign(const xvip2_t &xip_addr, base::xvblock_t *block, const xvote_set_t &validators) {
     XMETRICS_GAUGE(metrics::cpu_ca_merge_sign_tc, 1);
     // cert, is the target of the sign function, also is the target of the multi sign function.
-    std::string sign = get_vcertauth()->merge_muti_sign(validators, block->get_cert());
+    std::string sign = get_vcertauth()->merge_muti_sign(validators.voters(), validators.signatures(), block->get_cert());
     block->set_verify_signature(sign);
     block->reset_block_flags();
     block->set_block_flag(base::enum_xvblock_flag_authenticated);
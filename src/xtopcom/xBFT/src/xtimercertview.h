@@ -6,13 +6,14 @@
 
 #include "xbasic/xversion.h"
 #include "xBFT/xconsengine.h"
+#include "xBFT/xvoteset.h"
 
 NS_BEG2(top, xconsensus)
 
 class xvip_votes_t {
 public:
     int64_t create_tm;
-    std::map<xvip2_t,std::string,xvip2_compare> validators;
+    xvote_set_t validators;
 };
 
 class xvote_cache_t {
@@ -20,7 +21,7 @@ public:
     xvote_cache_t() = default;
     ~xvote_cache_t() = default;
     bool add_qcert(const xvip2_t &replica_xip, uint64_t clock, const std::string &qcert_bin);
-    const std::map<xvip2_t,std::string,xvip2_compare>& get_clock_votes(uint64_t clock);
+    const xvote_set_t& get_clock_votes(uint64_t clock);
     void clear_timeout_clock();
     void clear();
 
@@ -94,7 +95,7 @@ protected:
     void on_timeout(time_t cur_time);
     void on_timeout_stage2(base::xvblock_t *vote);
 
-    bool merge_multi_sign(const xvip2_t & xip_addr, base::xvblock_t *block, const std::map<xvip2_t,std::string,xvip2_compare> &validators);
+    bool merge_multi_sign(const xvip2_t & xip_addr, base::xvblock_t *block, const xvote_set_t &validators);
 
     void add_vote(const xvip2_t & xip_addr, base::xvblock_t *model_block, base::xvblock_t *vote);
     bool filter_consensus_event(base::xvevent_t const & event);
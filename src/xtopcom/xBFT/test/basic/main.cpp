@@ -244,10 +244,11 @@ int main(int argc, const char * argv[])
     #endif
    
 #else
-    nodes_list.insert(std::multimap<uint32_t,std::string>::value_type(enum_xtestnode_role_honest,std::string()));
-    nodes_list.insert(std::multimap<uint32_t,std::string>::value_type(enum_xtestnode_role_honest,std::string()));
-    nodes_list.insert(std::multimap<uint32_t,std::string>::value_type(enum_xtestnode_role_honest,std::string()));
-    nodes_list.insert(std::multimap<uint32_t,std::string>::value_type(enum_xtestnode_role_honest,std::string()));
+    //usage: xBFT_basic_test [nodes count,4 as default] [network profile of every node,e.g. 0x2330 for small rtt/lossrate/outoforder]
+    const int nodes_count = (argc > 1) ? atoi(argv[1]) : 4;
+    const uint32_t net_profile = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+    for(int i = 0; i < nodes_count; ++i)
+        nodes_list.insert(std::multimap<uint32_t,std::string>::value_type(enum_xtestnode_role_honest | net_profile,std::string()));
 #endif
     
     //global shared runtime
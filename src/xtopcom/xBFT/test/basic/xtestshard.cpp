@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "xtestshard.hpp"
+#include "xteststats.hpp"
 #include "xcertauth/xcertauth_face.h"
 #include "xbase/xutl.h"
 #include "xcrypto/xckey.h"
@@ -121,7 +122,10 @@ namespace top
                     {
                         xvip2_t this_address = _node->get_xip2_addr();
                         if( (this_address.low_addr != from_addr.low_addr) ||  (this_address.high_addr != from_addr.high_addr) )
+                        {
+                            xteststats_t::instance().on_packet_deliver(packet.get_msg_type(),packet.get_msg_body().size());
                             _node->recv_in(from_addr, this_address, packet, cur_thread_id, timenow_ms);
+                        }
                     }
                 }
             }
@@ -135,6 +139,7 @@ namespace top
                         xvip2_t this_address = _node->get_xip2_addr();
                         if( (this_address.low_addr == to_addr.low_addr) && (this_address.high_addr == to_addr.high_addr) )
                         {
+                            xteststats_t::instance().on_packet_deliver(packet.get_msg_type(),packet.get_msg_body().size());
                             _node->recv_in(from_addr, this_address, packet, cur_thread_id, timenow_ms);
                             break;
                         }
@@ -219,6 +224,12 @@ namespace top
                     _node->fire_clock(*new_clock_block, 0, 0);
                 }
             }
+            if( (new_clock_block->get_clock() % 10 == 0) ) //report consensus stats every 10 clocks
+            {
+                const std::string stats = xteststats_t::instance().dump();
+                printf("xtestshard stats at clock=%llu:%s\n",(unsigned long long)new_clock_block->get_clock(),stats.c_str());
+                xkinfo("xtestshard::on_timer_fire,stats at clock=%llu:%s",(unsigned long long)new_clock_block->get_clock(),stats.c_str());
+            }
             if( (new_clock_block->get_clock() % 6 == 0) ) //every 60 seconds do one election round
             {
                 //m_shard_base_addr = m_shard_base_addr + 1;
@@ -8,6 +8,7 @@
 #include "xtestnode.hpp"
 #include "xtestnet.hpp"
 #include "xtestclock.hpp"
+#include "xteststats.hpp"
 #include "xcertauth/xcertauth_face.h"
 #include "xvledger/xvledger.h"
 
@@ -229,6 +230,7 @@ namespace top
             {
                 xdbg("xtestnode_t::on_view_fire,elect to leader by viewid=%lld and total nodes=%d at node=%llx",m_latest_viewid,m_total_nodes,get_xip2_low_addr() & 0x3FF);
                 
+                xteststats_t::instance().on_view_start(m_latest_viewid,timenow_ms);
                 fire_proposal();
             }
             return true;
@@ -243,6 +245,9 @@ namespace top
                     xconsensus::xproposal_finish * _evt_obj = (xconsensus::xproposal_finish*)&event;
                     if(_evt_obj->get_error_code() == xconsensus::enum_xconsensus_code_successful)
                     {
+                        if(is_xip2_equal(_evt_obj->get_target_proposal()->get_cert()->get_validator(), get_xip2_addr())) //count once at leader
+                            xteststats_t::instance().on_view_certified(_evt_obj->get_target_proposal()->get_viewid(),timenow_ms);
+                        
                         base::xvnodesrv_t * nodesvr = (base::xvnodesrv_t *)query_plugin(std::string("*/") + base::xvnodesrv_t::name());
                         if(nodesvr != NULL)
                         {
@@ -271,6 +276,13 @@ namespace top
                     }
                     break;
                 }
+                case xconsensus::enum_xcsevent_type_on_consensus_commit:
+                {
+                    xconsensus::xconsensus_commit * _evt_obj = (xconsensus::xconsensus_commit*)&event;
+                    if(is_xip2_equal(_evt_obj->get_target_commit()->get_cert()->get_validator(), get_xip2_addr())) //count once at leader
+                        xteststats_t::instance().on_block_commit();
+                    break;
+                }
             }
             return xconsensus::xcsobject_t::on_event_up(event,from_child,cur_thread_id,timenow_ms);
         }
@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2020 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <time.h>
+#include <algorithm>
+#include <sstream>
+#include "xteststats.hpp"
+
+namespace top
+{
+    namespace test
+    {
+        xteststats_t & xteststats_t::instance()
+        {
+            static xteststats_t _static_stats;
+            return _static_stats;
+        }
+
+        xteststats_t::xteststats_t()
+        {
+            for(int i = 0; i < enum_max_msg_types; ++i)
+                m_msg_count[i] = 0;
+            m_msg_bytes = 0;
+            m_committed_blocks = 0;
+            m_timeout_views = 0;
+            m_start_cpu_us = get_cpu_time_us();
+        }
+
+        uint64_t xteststats_t::get_cpu_time_us()
+        {
+            struct timespec _ts;
+            clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &_ts);
+            return (uint64_t)_ts.tv_sec * 1000000 + (uint64_t)_ts.tv_nsec / 1000;
+        }
+
+        void xteststats_t::on_packet_deliver(const int msg_type,const size_t packet_size)
+        {
+            if( (msg_type >= 0) && (msg_type < enum_max_msg_types) )
+                ++m_msg_count[msg_type];
+            m_msg_bytes += packet_size;
+        }
+
+        void xteststats_t::on_view_start(const uint64_t viewid,const uint64_t timenow_ms)
+        {
+            std::lock_guard<std::mutex> _lock(m_lock);
+            m_view_start_ms[viewid] = timenow_ms;
+
+            //a view still not certified after 64 views is counted as timeout
+            while( (m_view_start_ms.empty() == false) && (m_view_start_ms.begin()->first + 64 < viewid) )
+            {
+                m_view_start_ms.erase(m_view_start_ms.begin());
+                ++m_timeout_views;
+            }
+        }
+
+        void xteststats_t::on_view_certified(const uint64_t viewid,const uint64_t timenow_ms)
+        {
+            std::lock_guard<std::mutex> _lock(m_lock);
+            auto it = m_view_start_ms.find(viewid);
+            if(it == m_view_start_ms.end())
+                return;
+
+            m_view_latency_ms.push_back(timenow_ms >= it->second ? timenow_ms - it->second : 0);
+            m_view_start_ms.erase(it);
+        }
+
+        void xteststats_t::on_block_commit()
+        {
+            ++m_committed_blocks;
+        }
+
+        std::string xteststats_t::dump()
+        {
+            std::vector<uint64_t> latency;
+            uint64_t timeout_views = 0;
+            {
+                std::lock_guard<std::mutex> _lock(m_lock);
+                latency = m_view_latency_ms;
+                timeout_views = m_timeout_views;
+            }
+            std::sort(latency.begin(),latency.end());
+            auto percentile = [&latency](const uint32_t percent) -> uint64_t {
+                if(latency.empty())
+                    return 0;
+                return latency[(latency.size() - 1) * percent / 100];
+            };
+
+            const uint64_t committed_blocks = m_committed_blocks;
+            const uint64_t cpu_us = get_cpu_time_us() - m_start_cpu_us;
+            uint64_t total_msgs = 0;
+            std::stringstream _ss;
+            _ss << "views{certified:" << latency.size() << ",timeout:" << timeout_views;
+            _ss << ",latency_ms p50:" << percentile(50) << " p90:" << percentile(90) << " p99:" << percentile(99) << " max:" << percentile(100) << "}";
+            _ss << " msgs{";
+            for(int i = 0; i < enum_max_msg_types; ++i)
+            {
+                const uint64_t count = m_msg_count[i];
+                if(count > 0)
+                    _ss << "type" << i << ":" << count << ",";
+                total_msgs += count;
+            }
+            _ss << "bytes:" << m_msg_bytes << "}";
+            _ss << " committed_blocks:" << committed_blocks;
+            if(committed_blocks > 0)
+                _ss << " per_block{msgs:" << total_msgs / committed_blocks << ",cpu_us:" << cpu_us / committed_blocks << "}";
+            return _ss.str();
+        }
+    };
+};
@@ -0,0 +1,50 @@
+// Copyright (c) 2017-2020 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace top
+{
+    namespace test
+    {
+        //collect consensus metrics of all simulated nodes,so consensus changes may be measured before deployment
+        //view latency: from view fired at leader to the proposal certified
+        //messages: every packet delivered to a node is counted,a broadcast to n nodes is n messages
+        //cpu: cpu time of whole process divided by committed blocks
+        class xteststats_t
+        {
+            enum {enum_max_msg_types = 16};
+        public:
+            static xteststats_t & instance();
+        private:
+            xteststats_t();
+            xteststats_t(const xteststats_t &);
+            xteststats_t & operator = (const xteststats_t &);
+        public:
+            void        on_packet_deliver(const int msg_type,const size_t packet_size);
+            void        on_view_start(const uint64_t viewid,const uint64_t timenow_ms);
+            void        on_view_certified(const uint64_t viewid,const uint64_t timenow_ms);
+            void        on_block_commit();
+
+            std::string dump();//summary of stats since process start
+        private:
+            static uint64_t     get_cpu_time_us();
+        private:
+            std::atomic<uint64_t>           m_msg_count[enum_max_msg_types];
+            std::atomic<uint64_t>           m_msg_bytes;
+            std::atomic<uint64_t>           m_committed_blocks;
+            std::mutex                      m_lock;
+            std::map<uint64_t,uint64_t>     m_view_start_ms;//viewid -> time of view fired at leader
+            std::vector<uint64_t>           m_view_latency_ms;
+            uint64_t                        m_timeout_views;
+            uint64_t                        m_start_cpu_us;
+        };
+    };
+};
@@ -4,7 +4,10 @@
 
 #pragma once
 #include <map>
+#include <mutex>
+#include <vector>
 #include "xconsobj.h"
+#include "xvoteset.h"
 
 namespace top
 {
@@ -134,11 +137,20 @@ namespace top
             const xvip2_t &      get_proposal_source_addr() const {return m_proposal_from_addr;}
             const uint32_t       get_proposal_msg_nonce() const {return m_proposal_msg_nonce;}
             
-            const std::map<xvip2_t,std::string,xvip2_compare> &  get_voted_validators()   const {return m_voted_validators;}
-            const std::map<xvip2_t,std::string,xvip2_compare> &  get_voted_auditors()     const {return m_voted_auditors;}
+            const xvote_set_t &  get_voted_validators()   const {return m_voted_validators;}
+            const xvote_set_t &  get_voted_auditors()     const {return m_voted_auditors;}
             
             void                  set_proposal_cert(base::xvqcert_t* new_proposal_cert);
             void                  set_bind_clock_cert(base::xvqcert_t* clock_cert);
+        public: //votes are pushed at engine'own thread,then taken all at once by woker'thread to verify as batch
+            struct xpending_vote_t
+            {
+                xvip2_t             voter_xip;
+                base::xvqcert_t*    voted_cert;    //hold one reference
+                std::string         vote_extend_data;
+            };
+            void                          push_pending_vote(const xvip2_t & voter_xip,base::xvqcert_t * voted_cert,const std::string & vote_extend_data);
+            std::vector<xpending_vote_t>  pop_pending_votes(); //caller take over reference of voted_cert
         public: //below apis are called from engine'own thread
             bool                 is_leader() const {return m_is_leader;}
             bool                 is_voted()  const {return m_is_voted;}
@@ -171,8 +183,10 @@ namespace top
             
             std::set<std::string>          m_all_votors;    //to filter duplicated account of node
             std::set<std::string>          m_all_voted_cert;//to remove duplicated certificates,possible attack or duplicated
-            std::map<xvip2_t,std::string,xvip2_compare> m_voted_validators;          //include leader as well
-            std::map<xvip2_t,std::string,xvip2_compare> m_voted_auditors;            //include leader as well if need
+            xvote_set_t                    m_voted_validators;          //include leader as well
+            xvote_set_t                    m_voted_auditors;            //include leader as well if need
+            std::mutex                     m_pending_votes_lock;
+            std::vector<xpending_vote_t>   m_pending_votes;             //received votes that not verified yet
         private:
             base::xvqcert_t *              m_proposal_cert;             //dedicated cert to store signature of leader
             base::xvqcert_t *              m_bind_clock_cert;           //each proposal ask carry the related clock cert
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2020 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xobject.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xconsensus)
+
+// votes of one group indexed by the node id of the voter. whether a node voted is a bit, the signatures sit in
+// one vector by node id, so duplicate checks, quorum checks and collecting the signatures for merge_muti_sign
+// neither compare nor allocate per vote like a map keyed by xvip2_t does.
+class xvote_set_t {
+public:
+    // the first vote fixes the group, votes of other groups or node ids beyond the group size are refused
+    // like merge_muti_sign would refuse them. returns false if refused or the node voted already
+    bool insert(const xvip2_t & voter, const std::string & signature) {
+        const int32_t slot = slot_of(voter);
+        if (slot < 0 || is_voted(slot)) {
+            return false;
+        }
+        m_voted[slot / 64] |= (uint64_t{1} << (slot % 64));
+        m_voters[slot] = voter;
+        m_signatures[slot] = signature;
+        ++m_count;
+        return true;
+    }
+
+    bool contains(const xvip2_t & voter) const {
+        if (m_count == 0 || !is_xip2_group_equal(m_group, voter)) {
+            return false;
+        }
+        const int32_t node_id = get_node_id_from_xip2(voter);
+        return node_id < (int32_t)m_voters.size() && is_voted(node_id);
+    }
+
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    bool reached(const uint32_t threshold) const { return m_count >= threshold; }
+
+    // voters and signatures in node id order, paired by index as merge_muti_sign takes them
+    std::vector<xvip2_t> voters() const {
+        std::vector<xvip2_t> result;
+        result.reserve(m_count);
+        for_each([&result](const xvip2_t & voter, const std::string &) { result.push_back(voter); });
+        return result;
+    }
+
+    std::vector<std::string> signatures() const {
+        std::vector<std::string> result;
+        result.reserve(m_count);
+        for_each([&result](const xvip2_t &, const std::string & signature) { result.push_back(signature); });
+        return result;
+    }
+
+    template <typename F>
+    void for_each(F && f) const {
+        for (size_t word = 0; word < m_voted.size(); ++word) {
+            for (uint64_t bits = m_voted[word]; bits != 0; bits &= bits - 1) {
+                const size_t slot = word * 64 + (size_t)__builtin_ctzll(bits);
+                f(m_voters[slot], m_signatures[slot]);
+            }
+        }
+    }
+
+    void clear() {
+        m_voted.clear();
+        m_voters.clear();
+        m_signatures.clear();
+        m_count = 0;
+    }
+
+private:
+    bool is_voted(const int32_t slot) const {
+        return (m_voted[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    // slot of the voter, -1 if it is not a node of the group
+    int32_t slot_of(const xvip2_t & voter) {
+        if (m_count == 0) {
+            const int32_t nodes_count = get_group_nodes_count_from_xip2(voter);
+            if (nodes_count <= 0) {
+                return -1;
+            }
+            m_group = voter;
+            reset_node_id_to_xip2(m_group);
+            m_voted.assign((nodes_count + 63) / 64, 0);
+            m_voters.assign(nodes_count, xvip2_t{});
+            m_signatures.assign(nodes_count, std::string());
+        } else if (!is_xip2_group_equal(m_group, voter)) {
+            return -1;
+        }
+        const int32_t node_id = get_node_id_from_xip2(voter);
+        if (node_id < 0 || node_id >= (int32_t)m_voters.size()) {
+            return -1;
+        }
+        return node_id;
+    }
+
+    xvip2_t m_group{};
+    std::vector<uint64_t> m_voted;  // bit per node id
+    std::vector<xvip2_t> m_voters;
+    std::vector<std::string> m_signatures;
+    size_t m_count{0};
+};
+
+NS_END2
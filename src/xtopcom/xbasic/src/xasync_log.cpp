@@ -0,0 +1,202 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xasync_log.h"
+
+#include "xbasic/xthreading/xthread_name.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+NS_BEG2(top, basic)
+
+namespace {
+
+/// @brief Lock-free ring of the records logged by one thread. The thread is the only producer, the writer the only
+///        consumer; each side only stores its own index.
+class xlog_ring_t {
+public:
+    enum : std::size_t { capacity = 256 };
+
+    details::xlog_record_t * reserve() noexcept {
+        auto const head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == capacity) {
+            return nullptr;
+        }
+        return &m_records[head % capacity];
+    }
+
+    void commit() noexcept {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    details::xlog_record_t const * front() noexcept {
+        auto const tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_records[tail % capacity];
+    }
+
+    void pop() noexcept {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // set when the thread exits, the writer frees the ring once it is drained
+    std::atomic<bool> closed{false};
+
+private:
+    std::atomic<std::size_t> m_head{0};
+    std::atomic<std::size_t> m_tail{0};
+    details::xlog_record_t m_records[capacity];
+};
+
+struct xlog_rings_t {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<xlog_ring_t>> rings;
+};
+
+// never destroyed, like xasync_log_t
+xlog_rings_t & all_rings() {
+    static auto * rings = new xlog_rings_t;
+    return *rings;
+}
+
+struct xthread_ring_t {
+    std::shared_ptr<xlog_ring_t> ring;
+
+    ~xthread_ring_t() {
+        if (ring != nullptr) {
+            ring->closed.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local xthread_ring_t thread_ring;
+
+}  // namespace
+
+xasync_log_t & xasync_log_t::instance() {
+    static auto * log = new xasync_log_t;
+    return *log;
+}
+
+void xasync_log_t::start() {
+    std::lock_guard<std::mutex> lock{m_start_mutex};
+    if (m_started.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::thread([this] {
+        threading::set_current_thread_name("xasync_log");
+        run();
+    }).detach();
+    m_started.store(true, std::memory_order_release);
+}
+
+void xasync_log_t::flush() {
+    // bounded wait, flush may be called from a signal raised on the writer thread while it drains
+    for (int i = 0; i < 100; ++i) {
+        std::unique_lock<std::mutex> lock{m_drain_mutex, std::try_to_lock};
+        if (lock.owns_lock()) {
+            drain_rings();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+details::xlog_record_t * xasync_log_t::reserve() {
+    if (!m_started.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    auto & ring = thread_ring.ring;
+    if (ring == nullptr) {
+        ring = std::make_shared<xlog_ring_t>();
+        auto & rings = all_rings();
+        std::lock_guard<std::mutex> lock{rings.mutex};
+        rings.rings.push_back(ring);
+    }
+    auto record = ring->reserve();
+    while (record == nullptr) {
+        std::this_thread::yield();
+        record = ring->reserve();
+    }
+    return record;
+}
+
+void xasync_log_t::commit() noexcept {
+    thread_ring.ring->commit();
+}
+
+void xasync_log_t::run() {
+    for (;;) {
+        if (!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+bool xasync_log_t::drain() {
+    std::lock_guard<std::mutex> lock{m_drain_mutex};
+    return drain_rings();
+}
+
+bool xasync_log_t::drain_rings() {
+    std::vector<std::shared_ptr<xlog_ring_t>> rings;
+    {
+        auto & all = all_rings();
+        std::lock_guard<std::mutex> lock{all.mutex};
+        rings = all.rings;
+    }
+
+    bool written = false;
+    std::vector<std::shared_ptr<xlog_ring_t>> drained_closed;
+    char text[enum_text_capacity];
+    for (auto const & ring : rings) {
+        // read before draining, nothing is committed to a closed ring afterwards
+        bool const closed = ring->closed.load(std::memory_order_acquire);
+        for (auto record = ring->front(); record != nullptr; record = ring->front()) {
+            details::xlog_format(*record, text, sizeof(text));
+            write(record->level, record->module, text);
+            ring->pop();
+            written = true;
+        }
+        if (closed) {
+            drained_closed.push_back(ring);
+        }
+    }
+
+    if (!drained_closed.empty()) {
+        auto & all = all_rings();
+        std::lock_guard<std::mutex> lock{all.mutex};
+        for (auto const & ring : drained_closed) {
+            all.rings.erase(std::remove(all.rings.begin(), all.rings.end(), ring), all.rings.end());
+        }
+    }
+    return written;
+}
+
+void xasync_log_t::write(int const level, char const * module, char const * text) {
+    switch (level) {
+    case enum_xlog_level_debug:
+        xdbg("[%s] %s", module, text);
+        break;
+    case enum_xlog_level_info:
+        xinfo("[%s] %s", module, text);
+        break;
+    case enum_xlog_level_key_info:
+        xkinfo("[%s] %s", module, text);
+        break;
+    case enum_xlog_level_warn:
+        xwarn("[%s] %s", module, text);
+        break;
+    default:
+        xerror("[%s] %s", module, text);
+        break;
+    }
+}
+
+NS_END2
@@ -0,0 +1,90 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xmemory_accounting.h"
+
+#include <utility>
+
+NS_BEG2(top, basic)
+
+xmemory_accounting_t & xmemory_accounting_t::instance() {
+    static xmemory_accounting_t accounting;
+    return accounting;
+}
+
+uint64_t xmemory_accounting_t::add_reporter(std::string const & subsystem, xusage_callback_t usage, xshrink_callback_t shrink) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto const id = m_next_id++;
+    m_reporters[id] = xreporter_t{subsystem, std::move(usage), std::move(shrink)};
+    m_subsystems[subsystem];
+    return id;
+}
+
+void xmemory_accounting_t::remove_reporter(uint64_t const id) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_reporters.erase(id);
+}
+
+void xmemory_accounting_t::set_soft_limit(std::string const & subsystem, uint64_t const bytes) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_subsystems[subsystem].soft_limit = bytes;
+}
+
+std::vector<xmemory_subsystem_usage_t> xmemory_accounting_t::usages() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    std::map<uint64_t, xmemory_usage_t> reporter_usages;
+    return usages(reporter_usages);
+}
+
+std::vector<xmemory_subsystem_usage_t> xmemory_accounting_t::usages(std::map<uint64_t, xmemory_usage_t> & reporter_usages) const {
+    std::map<std::string, xmemory_subsystem_usage_t> by_name;
+    for (auto const & subsystem : m_subsystems) {
+        auto & usage = by_name[subsystem.first];
+        usage.name = subsystem.first;
+        usage.soft_limit = subsystem.second.soft_limit;
+        usage.shrinks = subsystem.second.shrinks;
+    }
+    for (auto const & reporter : m_reporters) {
+        auto const reported = reporter.second.usage ? reporter.second.usage() : xmemory_usage_t{};
+        reporter_usages[reporter.first] = reported;
+        auto & usage = by_name[reporter.second.subsystem];
+        usage.bytes += reported.bytes;
+        usage.objects += reported.objects;
+        usage.shrinkable = usage.shrinkable || reporter.second.shrink != nullptr;
+    }
+
+    std::vector<xmemory_subsystem_usage_t> result;
+    result.reserve(by_name.size());
+    for (auto & usage : by_name) {
+        result.push_back(std::move(usage.second));
+    }
+    return result;
+}
+
+std::vector<xmemory_subsystem_usage_t> xmemory_accounting_t::enforce_soft_limits() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    std::map<uint64_t, xmemory_usage_t> reporter_usages;
+    auto result = usages(reporter_usages);
+    for (auto const & usage : result) {
+        if (usage.soft_limit == 0 || usage.bytes <= usage.soft_limit || !usage.shrinkable) {
+            continue;
+        }
+        // every reporter keeps the share of the limit it has of the usage
+        for (auto const & reporter : m_reporters) {
+            if (reporter.second.subsystem != usage.name || reporter.second.shrink == nullptr) {
+                continue;
+            }
+            auto const bytes = reporter_usages[reporter.first].bytes;
+            if (bytes == 0) {
+                continue;
+            }
+            auto const target = static_cast<uint64_t>(static_cast<double>(usage.soft_limit) * bytes / usage.bytes);
+            reporter.second.shrink(target);
+        }
+        ++m_subsystems[usage.name].shrinks;
+    }
+    return result;
+}
+
+NS_END2
@@ -0,0 +1,128 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xparallel_pool.h"
+
+#include "xbasic/xthreading/xthread_name.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+NS_BEG2(top, threading)
+
+namespace {
+
+struct xparallel_job_t {
+    std::function<void(std::size_t)> const * task{nullptr};
+    std::size_t part_count{0};
+    std::atomic<std::size_t> next_part{0};
+    std::size_t done_count{0};
+    std::mutex lock;
+    std::condition_variable done_cond;
+
+    // task is only touched for a part taken before every part is done, so it is alive while caller waits
+    void take_parts() {
+        std::size_t done = 0;
+        for (std::size_t part = next_part.fetch_add(1); part < part_count; part = next_part.fetch_add(1)) {
+            (*task)(part);
+            ++done;
+        }
+        if (done == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        done_count += done;
+        if (done_count == part_count) {
+            done_cond.notify_all();
+        }
+    }
+};
+
+}  // namespace
+
+xtop_parallel_pool::xtop_parallel_pool() {
+    m_thread_count = std::max(1u, std::thread::hardware_concurrency()) - 1;  // calling thread takes parts too
+}
+
+xtop_parallel_pool::~xtop_parallel_pool() {
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_cond.notify_all();
+    for (auto & t : m_threads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+xtop_parallel_pool & xtop_parallel_pool::instance() {
+    static xtop_parallel_pool pool;
+    return pool;
+}
+
+std::size_t xtop_parallel_pool::thread_count() const noexcept {
+    return m_thread_count + 1;
+}
+
+void xtop_parallel_pool::start() {
+    m_threads.reserve(m_thread_count);
+    for (std::size_t i = 0; i < m_thread_count; ++i) {
+        m_threads.emplace_back(&xtop_parallel_pool::worker_loop, this);
+    }
+}
+
+void xtop_parallel_pool::worker_loop() {
+    set_current_thread_name("xparallel_pool");
+    for (;;) {
+        std::function<void()> helper;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_cond.wait(lock, [this] { return m_stop || !m_helpers.empty(); });
+            if (m_helpers.empty()) {
+                return;
+            }
+            helper = std::move(m_helpers.front());
+            m_helpers.pop_front();
+        }
+        helper();
+    }
+}
+
+void xtop_parallel_pool::run(std::size_t part_count, std::size_t max_threads, std::function<void(std::size_t)> const & task) {
+    if (part_count == 0) {
+        return;
+    }
+    std::size_t const helper_count = std::min({part_count, std::max<std::size_t>(max_threads, 1), thread_count()}) - 1;
+    if (helper_count == 0) {
+        for (std::size_t part = 0; part < part_count; ++part) {
+            task(part);
+        }
+        return;
+    }
+
+    std::call_once(m_start_flag, [this] { start(); });
+    auto job = std::make_shared<xparallel_job_t>();
+    job->task = &task;
+    job->part_count = part_count;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        for (std::size_t i = 0; i < helper_count; ++i) {
+            m_helpers.emplace_back([job] { job->take_parts(); });
+        }
+    }
+    if (helper_count == 1) {
+        m_cond.notify_one();
+    } else {
+        m_cond.notify_all();
+    }
+
+    job->take_parts();
+    std::unique_lock<std::mutex> lock(job->lock);
+    job->done_cond.wait(lock, [&job] { return job->done_count == job->part_count; });
+}
+
+NS_END2
@@ -0,0 +1,199 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xthread_affinity.h"
+
+#include "xbase/xlog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+NS_BEG2(top, threading)
+
+// CPU_SETSIZE of glibc
+static long const max_cpus = 1024;
+
+std::vector<int> parse_cpu_list(std::string const & cpu_list) {
+    std::vector<int> cpus;
+    std::stringstream ranges(cpu_list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), [](char const c) { return c == ' ' || c == '\n'; }), range.end());
+        if (range.empty()) {
+            continue;
+        }
+        char * end = nullptr;
+        long const first = std::strtol(range.c_str(), &end, 10);
+        long last = first;
+        if (end == range.c_str()) {
+            return {};
+        }
+        if (*end == '-') {
+            char const * last_begin = end + 1;
+            last = std::strtol(last_begin, &end, 10);
+            if (end == last_begin) {
+                return {};
+            }
+        }
+        if (*end != '\0' || first < 0 || last < first || last >= max_cpus) {
+            return {};
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+#if defined(__linux__)
+// the numa node holding all of cpus, -1 if they span nodes or the machine has no numa information
+static int numa_node_of(std::vector<int> const & cpus) {
+    for (int node = 0; node < static_cast<int>(sizeof(unsigned long) * 8); ++node) {
+        std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!cpulist) {
+            continue;
+        }
+        std::string line;
+        std::getline(cpulist, line);
+        auto const node_cpus = parse_cpu_list(line);
+        if (std::includes(node_cpus.begin(), node_cpus.end(), cpus.begin(), cpus.end())) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+static bool set_affinity(pid_t const tid, std::vector<int> const & cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto const cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return ::sched_setaffinity(tid, sizeof(set), &set) == 0;
+}
+
+// MPOL_PREFERRED of linux/mempolicy.h, set_mempolicy is called directly to not depend on libnuma
+static bool prefer_numa_node(int const node) {
+    int const mpol_preferred = 1;
+    unsigned long nodemask = 1UL << node;
+    return ::syscall(SYS_set_mempolicy, mpol_preferred, &nodemask, sizeof(nodemask) * 8) == 0;
+}
+#endif
+
+xthread_affinity_t & xthread_affinity_t::instance() {
+    static xthread_affinity_t affinity;
+    return affinity;
+}
+
+bool xthread_affinity_t::configure(std::string const & rules) {
+    std::vector<xrule_t> parsed;
+    std::stringstream items(rules);
+    std::string item;
+    while (std::getline(items, item, ';')) {
+        item.erase(std::remove(item.begin(), item.end(), ' '), item.end());
+        if (item.empty()) {
+            continue;
+        }
+        auto const colon = item.find(':');
+        xrule_t rule;
+        if (colon != std::string::npos && colon != 0) {
+            rule.prefix = item.substr(0, colon);
+            rule.cpus = parse_cpu_list(item.substr(colon + 1));
+        }
+        if (rule.cpus.empty()) {
+            xwarn("xthread_affinity_t::configure invalid rule %s, expect prefix:cpus", item.c_str());
+            return false;
+        }
+#if defined(__linux__)
+        rule.numa_node = numa_node_of(rule.cpus);
+#endif
+        xkinfo("xthread_affinity_t::configure threads %s* on cpus %s numa node %d", rule.prefix.c_str(), item.substr(colon + 1).c_str(), rule.numa_node);
+        parsed.push_back(std::move(rule));
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_rules = std::move(parsed);
+    return true;
+}
+
+bool xthread_affinity_t::match(std::string const & name, xrule_t & rule) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    xrule_t const * best = nullptr;
+    for (auto const & r : m_rules) {
+        if (name.compare(0, r.prefix.size(), r.prefix) == 0 && (best == nullptr || r.prefix.size() > best->prefix.size())) {
+            best = &r;
+        }
+    }
+    if (best == nullptr) {
+        return false;
+    }
+    rule = *best;
+    return true;
+}
+
+void xthread_affinity_t::apply_current_thread(std::string const & name) {
+#if defined(__linux__)
+    xrule_t rule;
+    if (!match(name, rule)) {
+        return;
+    }
+    if (!set_affinity(0, rule.cpus)) {
+        xwarn("xthread_affinity_t::apply_current_thread pin %s failed, errno %d", name.c_str(), errno);
+        return;
+    }
+    if (rule.numa_node >= 0 && !prefer_numa_node(rule.numa_node)) {
+        xwarn("xthread_affinity_t::apply_current_thread prefer numa node %d for %s failed, errno %d", rule.numa_node, name.c_str(), errno);
+    }
+#else
+    (void)name;
+#endif
+}
+
+std::size_t xthread_affinity_t::apply_all_threads() {
+    std::size_t pinned = 0;
+#if defined(__linux__)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_rules.empty()) {
+            return 0;
+        }
+    }
+    DIR * tasks = ::opendir("/proc/self/task");
+    if (tasks == nullptr) {
+        return 0;
+    }
+    for (auto entry = ::readdir(tasks); entry != nullptr; entry = ::readdir(tasks)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        std::ifstream comm(std::string{"/proc/self/task/"} + entry->d_name + "/comm");
+        std::string name;
+        std::getline(comm, name);
+        xrule_t rule;
+        if (name.empty() || !match(name, rule)) {
+            continue;
+        }
+        // the memory policy of another thread cannot be set, only threads pinning themselves prefer their node
+        if (set_affinity(static_cast<pid_t>(std::atoi(entry->d_name)), rule.cpus)) {
+            ++pinned;
+        }
+    }
+    ::closedir(tasks);
+#endif
+    return pinned;
+}
+
+NS_END2
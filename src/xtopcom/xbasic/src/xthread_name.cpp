@@ -0,0 +1,38 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xthread_name.h"
+
+#include "xbasic/xthreading/xthread_affinity.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+NS_BEG2(top, threading)
+
+void set_current_thread_name(std::string const & name) {
+#if defined(__linux__)
+    ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+    ::pthread_setname_np(name.c_str());
+#else
+    (void)name;
+#endif
+    xthread_affinity_t::instance().apply_current_thread(name);
+}
+
+void set_thread_name(base::xworker_t * worker, std::string const & name) {
+    if (worker == nullptr) {
+        return;
+    }
+    auto _call = [name](base::xcall_t & call, const int32_t cur_thread_id, const uint64_t timenow_ms) -> bool {
+        set_current_thread_name(name);
+        return true;
+    };
+    base::xcall_t asyn_call((base::xcallback_t)_call);
+    worker->send_call(asyn_call);
+}
+
+NS_END2
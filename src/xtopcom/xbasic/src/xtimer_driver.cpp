@@ -7,20 +7,43 @@
 #include "xbase/xlog.h"
 
 #include <cassert>
+#include <cstdint>
+#include <exception>
+#include <vector>
 
 NS_BEG1(top)
 
-xtop_timer_driver::xtop_timer_driver(std::shared_ptr<xasio_io_context_wrapper_t> io_object, std::chrono::milliseconds reap_interval_ms)
-  : m_reap_interval{std::move(reap_interval_ms)}, m_io_object{io_object} {
+// tick of the wheel a time point falls in, or the first tick not before it when rounding up
+static std::uint64_t tick_of(std::chrono::steady_clock::time_point const & epoch,
+                             std::chrono::steady_clock::time_point const & time_point,
+                             std::chrono::milliseconds const & tick,
+                             bool const round_up) {
+    auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(time_point - epoch).count();
+    if (elapsed <= 0) {
+        return 0;
+    }
+    auto const ticks = static_cast<std::uint64_t>(elapsed) / static_cast<std::uint64_t>(tick.count());
+    auto const rest = static_cast<std::uint64_t>(elapsed) % static_cast<std::uint64_t>(tick.count());
+    return round_up && rest != 0 ? ticks + 1 : ticks;
+}
+
+xtop_timer_driver::xtop_timer_driver(std::shared_ptr<xasio_io_context_wrapper_t> io_object, std::chrono::milliseconds tick_ms)
+  : m_tick{tick_ms.count() > 0 ? tick_ms : std::chrono::milliseconds{1}}, m_io_object{io_object} {
     assert(io_object);
 }
 
 void xtop_timer_driver::start() {
     assert(!running());
 
+    auto io_object = m_io_object.lock();
+    if (io_object == nullptr) {
+        return;
+    }
+    m_tick_timer = top::make_unique<asio::steady_timer>(io_object->create_timer<asio::steady_timer>());
+
     running(true);
 
-    do_reap();
+    do_tick();
 }
 
 void xtop_timer_driver::stop() {
@@ -28,36 +51,42 @@ void xtop_timer_driver::stop() {
     running(false);
 }
 
-void xtop_timer_driver::schedule(std::chrono::milliseconds const & ms_in_future, top::xtimer_t::timeout_callback_t callback) {
+basic::xtimer_handle_t xtop_timer_driver::schedule(std::chrono::milliseconds const & ms_in_future, top::xtimer_t::timeout_callback_t callback) {
     if (!running()) {
         xwarn("[timer driver] timer driver not run");
-        return;
+        return 0;
     }
 
+    auto const expire_tick = tick_of(m_epoch, std::chrono::steady_clock::now() + ms_in_future, m_tick, true);
     std::lock_guard<std::mutex> lock{m_timers_mutex};
-    auto io_object = m_io_object.lock();
-    if (io_object) {
-        m_timers.push_back(std::make_shared<top::xtimer_t>(io_object, ms_in_future, std::move(callback)));
-    }
+    return m_wheel.add(expire_tick, std::move(callback));
+}
+
+bool xtop_timer_driver::cancel(basic::xtimer_handle_t const handle) {
+    std::lock_guard<std::mutex> lock{m_timers_mutex};
+    return m_wheel.cancel(handle);
 }
 
-void xtop_timer_driver::do_reap() {
+void xtop_timer_driver::do_tick() {
     if (!running()) {
         xwarn("[timer driver] timer driver not run");
         return;
     }
 
+    std::vector<top::xtimer_t::timeout_callback_t> expired;
     {
         std::lock_guard<std::mutex> lock{m_timers_mutex};
+        m_wheel.advance(tick_of(m_epoch, std::chrono::steady_clock::now(), m_tick, false), expired);
+    }
 
-        auto it = std::begin(m_timers);
-        while (it != std::end(m_timers)) {
-            if ((*it)->expired()) {
-                (*it)->wait();
-                it = m_timers.erase(it);
-            } else {
-                ++it;
-            }
+    // run outside the lock, a callback usually schedules its next round
+    for (auto & callback : expired) {
+        try {
+            callback(std::error_code{});
+        } catch (std::exception const & eh) {
+            xwarn("[timer driver] timer callback throws exception %s", eh.what());
+        } catch (...) {
+            xerror("[timer driver] timer callback throws unknown exception");
         }
     }
 
@@ -66,13 +95,9 @@ void xtop_timer_driver::do_reap() {
         return;
     }
 
-    auto io_object = m_io_object.lock();
-    if (io_object == nullptr) {
-        return;
-    }
-
     auto self = shared_from_this();
-    m_timers.push_back(std::make_shared<top::xtimer_t>(io_object, m_reap_interval, [this, self](asio::error_code const & ec) {
+    m_tick_timer->expires_after(m_tick);
+    m_tick_timer->async_wait([this, self](asio::error_code const & ec) {
         if (ec && ec == asio::error::operation_aborted) {
             xwarn("[timer driver] timer driver cancelled");
             return;
@@ -83,17 +108,18 @@ void xtop_timer_driver::do_reap() {
             return;
         }
 
-        do_reap();
-    }));
+        do_tick();
+    });
 }
 
-xtop_base_timer_driver::xtop_base_timer_driver(std::shared_ptr<xbase_io_context_wrapper_t> const & io_object, std::chrono::milliseconds reap_interval_ms) : m_reap_interval {reap_interval_ms}, m_io_object {make_observer(io_object.get())} {
+xtop_base_timer_driver::xtop_base_timer_driver(std::shared_ptr<xbase_io_context_wrapper_t> const & io_object, std::chrono::milliseconds tick_ms)
+  : m_tick{tick_ms.count() > 0 ? tick_ms : std::chrono::milliseconds{1}}, m_io_object{make_observer(io_object.get())} {
 }
 
 void xtop_base_timer_driver::start() {
     assert(!running());
     running(true);
-    do_reap();
+    do_tick(std::chrono::milliseconds{0});
 }
 
 void xtop_base_timer_driver::stop() {
@@ -101,52 +127,70 @@ void xtop_base_timer_driver::stop() {
     running(false);
 }
 
-void xtop_base_timer_driver::schedule(std::chrono::milliseconds const & ms_in_future, top::xbase_timer_t::timeout_callback_t callback) {
+basic::xtimer_handle_t xtop_base_timer_driver::schedule(std::chrono::milliseconds const & ms_in_future, top::xbase_timer_t::timeout_callback_t callback) {
     if (!running()) {
         xwarn("[xbase timer driver] timer driver not run");
-        return;
+        return 0;
     }
 
     assert(m_io_object != nullptr);
+    auto const expire_tick = tick_of(m_epoch, std::chrono::steady_clock::now() + ms_in_future, m_tick, true);
     std::lock_guard<std::mutex> lock{m_timers_mutex};
-    m_timers.push_back(top::make_unique<top::xbase_timer_t>(m_io_object, ms_in_future, std::move(callback)));
+    return m_wheel.add(expire_tick, std::move(callback));
 }
 
-void xtop_base_timer_driver::do_reap() {
+bool xtop_base_timer_driver::cancel(basic::xtimer_handle_t const handle) {
+    std::lock_guard<std::mutex> lock{m_timers_mutex};
+    return m_wheel.cancel(handle);
+}
+
+void xtop_base_timer_driver::do_tick(std::chrono::milliseconds const current_time) {
     if (!running()) {
         xwarn("[xbase timer driver] timer driver not run");
         return;
     }
 
+    std::vector<top::xbase_timer_t::timeout_callback_t> expired;
     {
         std::lock_guard<std::mutex> lock{m_timers_mutex};
+        m_wheel.advance(tick_of(m_epoch, std::chrono::steady_clock::now(), m_tick, false), expired);
 
-        auto it = std::begin(m_timers);
-        while (it != std::end(m_timers)) {
+        auto it = std::begin(m_tick_timers);
+        while (it != std::end(m_tick_timers)) {
             if ((*it)->expired()) {
-                it = m_timers.erase(it);
+                it = m_tick_timers.erase(it);
             } else {
                 ++it;
             }
         }
     }
 
+    // run outside the lock, a callback usually schedules its next round
+    for (auto & callback : expired) {
+        try {
+            callback(current_time);
+        } catch (std::exception const & eh) {
+            xwarn("[xbase timer driver] timer callback throws exception %s", eh.what());
+        } catch (...) {
+            xerror("[xbase timer driver] timer callback throws unknown exception");
+        }
+    }
+
     if (!running()) {
         xwarn("[xbase timer driver] timer driver not run");
         return;
     }
 
     auto self = shared_from_this();
-    m_timers.push_back(top::make_unique<top::xbase_timer_t>(m_io_object, m_reap_interval, [this, self](std::chrono::milliseconds) -> bool {
+    std::lock_guard<std::mutex> lock{m_timers_mutex};
+    m_tick_timers.push_back(top::make_unique<top::xbase_timer_t>(m_io_object, m_tick, [this, self](std::chrono::milliseconds const now) {
         if (!running()) {
             xwarn("[xbase timer driver] timer driver not run");
-            return false;
+            return;
         }
 
-        do_reap();
-        return true;
+        do_tick(now);
     }));
 }
 
-
 NS_END1
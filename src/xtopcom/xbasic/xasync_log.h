@@ -0,0 +1,260 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xlog.h"
+#include "xbase/xns_macro.h"
+#include "xbasic/xutility.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+// logs below this level are removed at compile time, arguments included. release builds drop debug logs.
+#if !defined(XASYNC_LOG_MIN_LEVEL)
+#    if defined(NDEBUG) && !defined(RELEASEDEBINFO)
+#        define XASYNC_LOG_MIN_LEVEL enum_xlog_level_info
+#    else
+#        define XASYNC_LOG_MIN_LEVEL enum_xlog_level_debug
+#    endif
+#endif
+
+NS_BEG2(top, basic)
+
+namespace details {
+
+/// @brief One log call captured in binary: the format and module literals by pointer, the arguments by value and
+///        strings by copy. decode formats it later on the writer thread.
+struct xlog_record_t {
+    using decode_t = int (*)(char const * fmt, uint8_t const * payload, char * out, std::size_t size);
+
+    enum : std::size_t { payload_capacity = 192 };
+
+    int level{0};
+    char const * module{nullptr};
+    char const * fmt{nullptr};
+    decode_t decode{nullptr};
+    uint8_t payload[payload_capacity];
+};
+
+template <typename T>
+struct xlog_arg_codec {
+    static_assert(std::is_scalar<T>::value, "only printf arguments can be logged");
+    using decoded_type = T;
+
+    static std::size_t size(T) noexcept {
+        return sizeof(T);
+    }
+    static void encode(uint8_t *& p, T const v) noexcept {
+        std::memcpy(p, &v, sizeof(T));
+        p += sizeof(T);
+    }
+    static T decode(uint8_t const *& p) noexcept {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+};
+
+// %s arguments are copied, the caller's buffer, e.g. a temporary std::string, is gone when the writer formats
+template <>
+struct xlog_arg_codec<char const *> {
+    using decoded_type = char const *;
+
+    static char const * text(char const * v) noexcept {
+        return v == nullptr ? "(null)" : v;
+    }
+    static std::size_t size(char const * v) noexcept {
+        return std::strlen(text(v)) + 1;
+    }
+    static void encode(uint8_t *& p, char const * v) noexcept {
+        auto const n = size(v);
+        std::memcpy(p, text(v), n);
+        p += n;
+    }
+    static char const * decode(uint8_t const *& p) noexcept {
+        auto const v = reinterpret_cast<char const *>(p);
+        p += std::strlen(v) + 1;
+        return v;
+    }
+};
+
+template <>
+struct xlog_arg_codec<char *> : xlog_arg_codec<char const *> {};
+
+inline std::size_t xlog_payload_size() noexcept {
+    return 0;
+}
+
+template <typename T, typename... Args>
+std::size_t xlog_payload_size(T const & v, Args const &... args) noexcept {
+    return xlog_arg_codec<T>::size(v) + xlog_payload_size(args...);
+}
+
+inline void xlog_encode(uint8_t *&) noexcept {
+}
+
+template <typename T, typename... Args>
+void xlog_encode(uint8_t *& p, T const & v, Args const &... args) noexcept {
+    xlog_arg_codec<T>::encode(p, v);
+    xlog_encode(p, args...);
+}
+
+#if defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#    pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+
+template <typename Tuple, std::size_t... Idx>
+int xlog_snprintf(char * out, std::size_t size, char const * fmt, Tuple const & values, top::index_sequence<Idx...>) {
+    return std::snprintf(out, size, fmt, std::get<Idx>(values)...);
+}
+
+#if defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#endif
+
+template <typename... Args>
+int xlog_decode(char const * fmt, uint8_t const * payload, char * out, std::size_t size) {
+    // elements of a braced initializer are evaluated in order, so the arguments are read as they were written
+    std::tuple<typename xlog_arg_codec<Args>::decoded_type...> values{xlog_arg_codec<Args>::decode(payload)...};
+    (void)payload;
+    return xlog_snprintf(out, size, fmt, values, top::index_sequence_for<Args...>{});
+}
+
+/// @brief Captures a log call into record without formatting it.
+/// @return false if the arguments do not fit, the caller formats in place then.
+template <typename... Args>
+bool xlog_capture(xlog_record_t & record, int level, char const * module, char const * fmt, Args const &... args) noexcept {
+    if (xlog_payload_size(args...) > xlog_record_t::payload_capacity) {
+        return false;
+    }
+    uint8_t * p = record.payload;
+    xlog_encode(p, args...);
+    record.level = level;
+    record.module = module;
+    record.fmt = fmt;
+    record.decode = &xlog_decode<Args...>;
+    return true;
+}
+
+inline int xlog_format(xlog_record_t const & record, char * out, std::size_t size) {
+    return record.decode(record.fmt, record.payload, out, size);
+}
+
+// never called, lets the compiler check the format against the arguments as it does for xinfo
+#if defined(__GNUC__)
+__attribute__((format(printf, 1, 2)))
+#endif
+inline void xlog_check_format(char const *, ...) noexcept {
+}
+
+}  // namespace details
+
+/// @brief Asynchronous backend of the module log macros (xtxpool_dbg, xunit_info, xsync_kinfo, ...).
+///        The level is checked before anything is done, a call under it costs one relaxed load.
+///        A call over it captures its arguments in binary into a lock-free ring of the calling thread;
+///        one writer thread formats the records and hands them to xbase's log.
+///        Until start(), and for arguments over the capacity of a record, logs are formatted and written on the calling
+///        thread. A thread whose ring is full waits for the writer, logs are never dropped.
+///        Lines of different threads may interleave in a different order than they were logged, and the time of a line
+///        is the time it was written.
+class xasync_log_t {
+public:
+    xasync_log_t(xasync_log_t const &) = delete;
+    xasync_log_t & operator=(xasync_log_t const &) = delete;
+    xasync_log_t(xasync_log_t &&) = delete;
+    xasync_log_t & operator=(xasync_log_t &&) = delete;
+
+    // never destroyed, threads may log during exit
+    static xasync_log_t & instance();
+
+    // starts the writer thread, idempotent
+    void start();
+
+    // writes everything logged so far, e.g. before the process aborts. gives up after 100ms if the writer is stuck.
+    void flush();
+
+    // logs under level are dropped before their arguments are formatted; pass the level given to xset_log_level
+    void set_level(int const level) noexcept {
+        m_level.store(level, std::memory_order_relaxed);
+    }
+
+    bool enabled(int const level) const noexcept {
+        return level >= m_level.load(std::memory_order_relaxed);
+    }
+
+    // arguments are taken by value so that char arrays decay to the strings they hold
+    template <typename... Args>
+    void log(int const level, char const * module, char const * fmt, Args... args) {
+        auto record = reserve();
+        if (record != nullptr) {
+            if (details::xlog_capture(*record, level, module, fmt, args...)) {
+                commit();
+                return;
+            }
+        }
+        write_now(level, module, fmt, args...);
+    }
+
+    // logs that were written on the calling thread since the writer started, their arguments did not fit a record
+    uint64_t sync_writes() const noexcept {
+        return m_sync_writes.load(std::memory_order_relaxed);
+    }
+
+private:
+    xasync_log_t() = default;
+    ~xasync_log_t() = default;
+
+    template <typename... Args>
+    void write_now(int const level, char const * module, char const * fmt, Args const &... args) {
+        if (m_started.load(std::memory_order_relaxed)) {
+            m_sync_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+        char text[enum_text_capacity];
+        details::xlog_snprintf(text, sizeof(text), fmt, std::make_tuple(args...), top::index_sequence_for<Args...>{});
+        write(level, module, text);
+    }
+
+    // free slot in the ring of the calling thread, waits while the ring is full; nullptr before start().
+    // the slot is only handed to the writer by commit().
+    details::xlog_record_t * reserve();
+    void commit() noexcept;
+
+    void run();
+    bool drain();
+    bool drain_rings();  // m_drain_mutex held
+    static void write(int level, char const * module, char const * text);
+
+    enum : std::size_t { enum_text_capacity = 2048 };
+
+    std::atomic<int> m_level{enum_xlog_level_debug};
+    std::atomic<bool> m_started{false};
+    std::atomic<uint64_t> m_sync_writes{0};
+    std::mutex m_start_mutex;
+    std::mutex m_drain_mutex;
+};
+
+NS_END2
+
+/// logs fmt at level through xasync_log_t. fmt must be a string literal.
+/// arguments are not evaluated when level is under XASYNC_LOG_MIN_LEVEL or the runtime level.
+#define xasync_log(level, fmt, ...)                                                                    \
+    do {                                                                                                \
+        if (false) {                                                                                    \
+            top::basic::details::xlog_check_format("" fmt, ##__VA_ARGS__);                              \
+        }                                                                                               \
+        if ((level) >= XASYNC_LOG_MIN_LEVEL && top::basic::xasync_log_t::instance().enabled(level)) {   \
+            top::basic::xasync_log_t::instance().log((level), __MODULE__, "" fmt, ##__VA_ARGS__);       \
+        }                                                                                               \
+    } while (0)
@@ -0,0 +1,79 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, basic)
+
+struct xmemory_usage_t {
+    uint64_t bytes{0};
+    uint64_t objects{0};
+};
+
+struct xmemory_subsystem_usage_t {
+    std::string name;
+    uint64_t bytes{0};
+    uint64_t objects{0};
+    uint64_t soft_limit{0};  // 0 when not limited
+    uint64_t shrinks{0};     // times the subsystem was asked to shrink
+    bool shrinkable{false};
+};
+
+/* node-wide registry of the memory held by the caches and pools (blockstore, txpool, statestore, trie dirties,
+ * rocksdb, metrics), read by the metrics and the admin http server.
+ * a subsystem registers reporters that give their bytes and objects when asked, so the hot paths only keep the
+ * counters they already have; several reporters of one subsystem (e.g. the column families of two dbs) add up.
+ * a reporter may also take a shrink callback: while the subsystem is over its soft limit, enforce_soft_limits()
+ * asks every shrinkable reporter to drop to its share of the limit, long before the os runs out of memory.
+ * callbacks run under the lock of the registry: they must not register or remove reporters themselves.
+ */
+class xmemory_accounting_t {
+public:
+    using xusage_callback_t = std::function<xmemory_usage_t()>;
+    using xshrink_callback_t = std::function<void(uint64_t target_bytes)>;
+
+    static xmemory_accounting_t & instance();
+
+    /// @brief Returns the id to remove the reporter with, the reporter is called until then.
+    uint64_t add_reporter(std::string const & subsystem, xusage_callback_t usage, xshrink_callback_t shrink = nullptr);
+    void remove_reporter(uint64_t id);
+
+    /// @brief Soft limit of the subsystem in bytes, 0 removes the limit.
+    void set_soft_limit(std::string const & subsystem, uint64_t bytes);
+
+    std::vector<xmemory_subsystem_usage_t> usages() const;
+
+    /// @brief Shrinks the subsystems over their soft limit and returns the usages read before.
+    std::vector<xmemory_subsystem_usage_t> enforce_soft_limits();
+
+private:
+    struct xreporter_t {
+        std::string subsystem;
+        xusage_callback_t usage;
+        xshrink_callback_t shrink;
+    };
+
+    struct xsubsystem_t {
+        uint64_t soft_limit{0};
+        uint64_t shrinks{0};
+    };
+
+    std::vector<xmemory_subsystem_usage_t> usages(std::map<uint64_t, xmemory_usage_t> & reporter_usages) const;
+
+    mutable std::mutex m_mutex;
+    uint64_t m_next_id{1};
+    std::map<uint64_t, xreporter_t> m_reporters;
+    std::map<std::string, xsubsystem_t> m_subsystems;
+};
+
+NS_END2
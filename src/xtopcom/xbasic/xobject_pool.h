@@ -0,0 +1,206 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+NS_BEG2(top, basic)
+
+/* slab pool for the small objects created and released at high rates (blocks, cons transactions, txpool entries).
+ * sizes are rounded up to size classes of 16 bytes. every thread keeps a free list per class and only takes the
+ * lock of the class to move a batch of blocks from or to the shared list, and to carve a new slab. blocks freed by
+ * another thread than the allocating one simply join that thread's list.
+ * slabs are kept for the life of the process: the pool trades the memory of the peak for no fragmentation.
+ */
+class xobject_pool_t {
+public:
+    static constexpr std::size_t class_granularity{16};
+    static constexpr std::size_t max_pooled_size{1024};
+    static constexpr std::size_t class_count{max_pooled_size / class_granularity};
+    static constexpr std::size_t batch_size{32};           // blocks moved between a thread and the shared list
+    static constexpr std::size_t thread_cache_limit{2 * batch_size};
+    static constexpr std::size_t slab_bytes{64 * 1024};
+
+    static void * allocate(std::size_t const size) {
+        if (size == 0 || size > max_pooled_size) {
+            return ::operator new(size);
+        }
+        auto & list = thread_cache().lists[class_of(size)];
+        if (list.head == nullptr) {
+            shared_class(class_of(size)).refill(list, (class_of(size) + 1) * class_granularity);
+        }
+        auto block = list.head;
+        list.head = block->next;
+        --list.count;
+        return block;
+    }
+
+    static void deallocate(void * p, std::size_t const size) noexcept {
+        if (p == nullptr) {
+            return;
+        }
+        if (size == 0 || size > max_pooled_size) {
+            ::operator delete(p);
+            return;
+        }
+        auto & list = thread_cache().lists[class_of(size)];
+        auto block = static_cast<xfree_block_t *>(p);
+        block->next = list.head;
+        list.head = block;
+        if (++list.count > thread_cache_limit) {
+            shared_class(class_of(size)).give_back(list);
+        }
+    }
+
+private:
+    struct xfree_block_t {
+        xfree_block_t * next;
+    };
+
+    struct xfree_list_t {
+        xfree_block_t * head{nullptr};
+        std::size_t count{0};
+    };
+
+    class xshared_class_t {
+    public:
+        void refill(xfree_list_t & list, std::size_t const block_size) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_free.head == nullptr) {
+                carve(block_size);
+            }
+            for (std::size_t i = 0; i < batch_size && m_free.head != nullptr; ++i) {
+                auto block = m_free.head;
+                m_free.head = block->next;
+                --m_free.count;
+                block->next = list.head;
+                list.head = block;
+                ++list.count;
+            }
+        }
+
+        // moves all but one batch of the thread's blocks to the shared list
+        void give_back(xfree_list_t & list) noexcept {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (list.count > batch_size) {
+                auto block = list.head;
+                list.head = block->next;
+                --list.count;
+                block->next = m_free.head;
+                m_free.head = block;
+                ++m_free.count;
+            }
+        }
+
+        void give_back_all(xfree_list_t & list) noexcept {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (list.head != nullptr) {
+                auto block = list.head;
+                list.head = block->next;
+                block->next = m_free.head;
+                m_free.head = block;
+                ++m_free.count;
+            }
+            list.count = 0;
+        }
+
+    private:
+        void carve(std::size_t const block_size) {
+            auto slab = static_cast<char *>(::operator new(slab_bytes));
+            m_slabs.push_back(slab);
+            for (std::size_t offset = 0; offset + block_size <= slab_bytes; offset += block_size) {
+                auto block = reinterpret_cast<xfree_block_t *>(slab + offset);
+                block->next = m_free.head;
+                m_free.head = block;
+                ++m_free.count;
+            }
+        }
+
+        std::mutex m_mutex;
+        xfree_list_t m_free;
+        std::vector<char *> m_slabs;
+    };
+
+    struct xthread_cache_t {
+        std::array<xfree_list_t, class_count> lists{};
+
+        ~xthread_cache_t() {
+            for (std::size_t i = 0; i < class_count; ++i) {
+                if (lists[i].head != nullptr) {
+                    shared_class(i).give_back_all(lists[i]);
+                }
+            }
+        }
+    };
+
+    static std::size_t class_of(std::size_t const size) noexcept {
+        return (size - 1) / class_granularity;
+    }
+
+    static xshared_class_t & shared_class(std::size_t const index) {
+        // never destroyed: threads may still release blocks while static objects are torn down
+        static auto classes = new std::array<xshared_class_t, class_count>();
+        return (*classes)[index];
+    }
+
+    static xthread_cache_t & thread_cache() {
+        thread_local xthread_cache_t cache;
+        return cache;
+    }
+};
+
+/// @brief Allocator drawing single objects from xobject_pool_t, for std::allocate_shared and containers of nodes.
+template <typename T>
+struct xpool_allocator_t {
+    using value_type = T;
+
+    xpool_allocator_t() noexcept = default;
+    template <typename U>
+    xpool_allocator_t(xpool_allocator_t<U> const &) noexcept {
+    }
+
+    T * allocate(std::size_t const n) {
+        return static_cast<T *>(xobject_pool_t::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, std::size_t const n) noexcept {
+        xobject_pool_t::deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(xpool_allocator_t<U> const &) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(xpool_allocator_t<U> const &) const noexcept {
+        return false;
+    }
+};
+
+/// @brief make_shared drawing the object and its control block as one block from the pool.
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled_shared(Args &&... args) {
+    return std::allocate_shared<T>(xpool_allocator_t<T>{}, std::forward<Args>(args)...);
+}
+
+NS_END2
+
+// class-specific new and delete drawing the objects of a class hierarchy from xobject_pool_t. the hierarchy must have
+// a virtual destructor, so the sized delete gets the size of the most derived class.
+#define XDECLARE_POOLED_NEW_DELETE                                     \
+    static void * operator new(std::size_t size) {                     \
+        return top::basic::xobject_pool_t::allocate(size);             \
+    }                                                                  \
+    static void operator delete(void * p, std::size_t size) noexcept { \
+        top::basic::xobject_pool_t::deallocate(p, size);               \
+    }
@@ -0,0 +1,268 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xlock.h"
+#include "xbasic/xlru_cache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG2(top, basic)
+
+// every entry weighs one, the capacity is an entry count
+template <typename key, typename value>
+struct xunit_weigher_t {
+    size_t operator()(const key &, const value &) const {
+        return 1;
+    }
+};
+
+struct xcache_stats_t {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t evictions{0};
+    size_t size{0};
+    size_t weight{0};
+};
+
+/* concurrent cache for hot lookup paths, a drop-in for xlru_cache.
+ * keys are spread over shards by hash, each shard has its own read-write lock and evicts by CLOCK:
+ * a hit only sets the referenced flag of the entry under the read lock, and the clock hand spares referenced
+ * entries once while it looks for a victim. eviction is thus approximately LRU but gets never write.
+ * the capacity is split evenly over the shards and is measured by weigher, so it may be a byte budget.
+ * values are released by deletor when they are replaced, evicted, erased or cleared, as in xlru_cache.
+ */
+template <typename key,
+          typename value,
+          typename deletor = xvoid_deletor_t<value>,
+          typename weigher = xunit_weigher_t<key, value>,
+          typename hasher = std::hash<key>>
+class xsharded_lru_cache {
+public:
+    static constexpr size_t default_shard_count{16};
+
+    explicit xsharded_lru_cache(size_t max_weight, size_t shard_count = default_shard_count) {
+        // every shard holds at least one entry of unit weight
+        size_t count = 1;
+        while (count < shard_count && count * 2 <= max_weight) {
+            count *= 2;
+        }
+        m_shards.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            m_shards.emplace_back(new xshard_t);
+        }
+        set_max_size(max_weight);
+    }
+
+    xsharded_lru_cache(const xsharded_lru_cache &) = delete;
+    xsharded_lru_cache & operator=(const xsharded_lru_cache &) = delete;
+
+    virtual ~xsharded_lru_cache() {
+        clear();
+    }
+
+    void put(const key & k, const value & v) {
+        auto & shard = shard_of(k);
+        size_t const weight = weigher{}(k, v);
+        shard.lock.lock_write();
+        auto it = shard.index.find(k);
+        if (it != shard.index.end()) {
+            auto & slot = *shard.slots[it->second];
+            delete_value(slot.v);
+            shard.weight -= slot.weight;
+            slot.v = v;
+            slot.weight = weight;
+            slot.referenced.store(true, std::memory_order_relaxed);
+        } else {
+            size_t index;
+            if (shard.free_slots.empty()) {
+                index = shard.slots.size();
+                shard.slots.emplace_back(new xslot_t);
+            } else {
+                index = shard.free_slots.back();
+                shard.free_slots.pop_back();
+            }
+            auto & slot = *shard.slots[index];
+            slot.k = k;
+            slot.v = v;
+            slot.weight = weight;
+            slot.used = true;
+            slot.referenced.store(true, std::memory_order_relaxed);
+            shard.index.emplace(k, index);
+        }
+        shard.weight += weight;
+        evict(shard);
+        shard.lock.release_write();
+    }
+
+    bool get(const key & k, value & v) {
+        auto & shard = shard_of(k);
+        shard.lock.lock_read();
+        auto it = shard.index.find(k);
+        if (it == shard.index.end()) {
+            shard.lock.release_read();
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto & slot = *shard.slots[it->second];
+        // test first, so hits on a hot entry do not keep writing its cache line
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(true, std::memory_order_relaxed);
+        }
+        v = slot.v;
+        shard.lock.release_read();
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool exist(const key & k) {
+        auto & shard = shard_of(k);
+        shard.lock.lock_read();
+        bool const found = shard.index.count(k) > 0;
+        shard.lock.release_read();
+        return found;
+    }
+
+    bool erase(const key & k) {
+        auto & shard = shard_of(k);
+        shard.lock.lock_write();
+        auto it = shard.index.find(k);
+        bool const found = it != shard.index.end();
+        if (found) {
+            auto const index = it->second;
+            shard.index.erase(it);
+            release_slot(shard, index);
+        }
+        shard.lock.release_write();
+        return found;
+    }
+
+    void set_max_size(size_t max_weight) {
+        size_t const per_shard = (max_weight + m_shards.size() - 1) / m_shards.size();
+        for (auto & shard : m_shards) {
+            shard->lock.lock_write();
+            shard->max_weight = per_shard;
+            evict(*shard);
+            shard->lock.release_write();
+        }
+    }
+
+    void clear() {
+        for (auto & shard : m_shards) {
+            shard->lock.lock_write();
+            for (auto & pair : shard->index) {
+                delete_value(shard->slots[pair.second]->v);
+            }
+            shard->index.clear();
+            shard->slots.clear();
+            shard->free_slots.clear();
+            shard->weight = 0;
+            shard->hand = 0;
+            shard->lock.release_write();
+        }
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (auto & shard : m_shards) {
+            shard->lock.lock_read();
+            total += shard->index.size();
+            shard->lock.release_read();
+        }
+        return total;
+    }
+
+    xcache_stats_t stats() {
+        xcache_stats_t result;
+        for (auto & shard : m_shards) {
+            result.hits += shard->hits.load(std::memory_order_relaxed);
+            result.misses += shard->misses.load(std::memory_order_relaxed);
+            shard->lock.lock_read();
+            result.evictions += shard->evictions;
+            result.size += shard->index.size();
+            result.weight += shard->weight;
+            shard->lock.release_read();
+        }
+        return result;
+    }
+
+    size_t shard_count() const {
+        return m_shards.size();
+    }
+
+private:
+    struct xslot_t {
+        key k{};
+        value v{};
+        size_t weight{0};
+        bool used{false};
+        std::atomic<bool> referenced{false};
+    };
+
+    struct xshard_t {
+        base::xrwlock_t lock;
+        std::unordered_map<key, size_t, hasher> index;  // key -> slot
+        std::vector<std::unique_ptr<xslot_t>> slots;     // clock ring, stable addresses
+        std::vector<size_t> free_slots;
+        size_t hand{0};
+        size_t weight{0};
+        size_t max_weight{0};
+        uint64_t evictions{0};
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+
+    xshard_t & shard_of(const key & k) {
+        // the shard takes the high bits, unordered_map buckets take the low ones
+        uint64_t const h = static_cast<uint64_t>(hasher{}(k)) * 0x9E3779B97F4A7C15ull;
+        return *m_shards[static_cast<size_t>(h >> 32) & (m_shards.size() - 1)];
+    }
+
+    inline void delete_value(value & v) {
+        deletor del;
+        del(v);
+    }
+
+    void release_slot(xshard_t & shard, size_t const index) {
+        auto & slot = *shard.slots[index];
+        delete_value(slot.v);
+        shard.weight -= slot.weight;
+        slot.k = key{};
+        slot.v = value{};
+        slot.weight = 0;
+        slot.used = false;
+        shard.free_slots.push_back(index);
+    }
+
+    // called with the write lock held. every step clears a flag or evicts, so two turns of the hand suffice
+    void evict(xshard_t & shard) {
+        while (shard.weight > shard.max_weight && !shard.index.empty()) {
+            if (shard.hand >= shard.slots.size()) {
+                shard.hand = 0;
+            }
+            auto const index = shard.hand++;
+            auto & slot = *shard.slots[index];
+            if (!slot.used) {
+                continue;
+            }
+            if (slot.referenced.load(std::memory_order_relaxed)) {
+                slot.referenced.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            shard.index.erase(slot.k);
+            release_slot(shard, index);
+            ++shard.evictions;
+        }
+    }
+
+    std::vector<std::unique_ptr<xshard_t>> m_shards;
+};
+
+NS_END2
@@ -0,0 +1,270 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xthreading/xutility.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+NS_BEG2(top, threading)
+
+/// @brief Bounded lock-free multiple-producer multiple-consumer ring queue.
+///        Every cell carries a sequence number telling whose turn it is, so producers and consumers only
+///        contend on one CAS of their own cache-line padded position and a push never allocates.
+///        A full queue drops the pushed item and counts it. Consumers waiting for items spin a while and then
+///        park on a condition variable, which producers only touch when someone is parked.
+///        Same interface as xthreadsafe_queue, so clients switch by type.
+template <typename T>
+class xbounded_queue final {
+    struct xcell_t {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T * value() noexcept {
+            return reinterpret_cast<T *>(&storage);
+        }
+    };
+
+    static constexpr std::size_t cache_line_size{64};
+    static constexpr int spin_count{256};
+    static constexpr int yield_count{16};
+
+public:
+    xbounded_queue(xbounded_queue const &) = delete;
+    xbounded_queue & operator=(xbounded_queue const &) = delete;
+    xbounded_queue(xbounded_queue &&) = delete;
+    xbounded_queue & operator=(xbounded_queue &&) = delete;
+
+    /// @brief capacity is rounded up to a power of two.
+    explicit xbounded_queue(std::size_t const capacity) : m_mask{round_up_to_power_of_two(capacity) - 1}, m_cells{new xcell_t[m_mask + 1]} {
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~xbounded_queue() {
+        T value;
+        while (try_pop(value)) {
+        }
+    }
+
+    /// @brief false if the queue was full and o is dropped.
+    bool push(T && o) {
+        if (!emplace(std::move(o))) {
+            return false;
+        }
+        notify_parked();
+        return true;
+    }
+
+    bool push(T const & o) {
+        if (!emplace(o)) {
+            return false;
+        }
+        notify_parked();
+        return true;
+    }
+
+    /// @brief Pushes the items in order until the queue is full, by one claim of the positions.
+    ///        Returns how many were pushed, the rest are dropped.
+    template <typename InputIt>
+    std::size_t push_batch(InputIt first, InputIt last) {
+        auto const count = static_cast<std::size_t>(std::distance(first, last));
+        std::size_t begin{0};
+        std::size_t const claimed = claim(m_enqueue_position.value, 0, count, begin);
+        for (std::size_t i = 0; i < claimed; ++i, ++first) {
+            auto & cell = m_cells[(begin + i) & m_mask];
+            ::new (cell.value()) T(std::move(*first));
+            cell.sequence.store(begin + i + 1, std::memory_order_release);
+        }
+        if (claimed < count) {
+            m_dropped.fetch_add(count - claimed, std::memory_order_relaxed);
+        }
+        if (claimed > 0) {
+            notify_parked();
+        }
+        return claimed;
+    }
+
+    bool try_pop(T & value) {
+        std::size_t position = m_dequeue_position.value.load(std::memory_order_relaxed);
+        for (;;) {
+            auto & cell = m_cells[position & m_mask];
+            std::size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (diff == 0) {
+                if (m_dequeue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(*cell.value());
+                    cell.value()->~T();
+                    cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = m_dequeue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Appends up to max items in push order to values, by one claim of the positions.
+    std::size_t try_pop_batch(std::vector<T> & values, std::size_t const max) {
+        std::size_t begin{0};
+        std::size_t const claimed = claim(m_dequeue_position.value, 1, max, begin);
+        values.reserve(values.size() + claimed);
+        for (std::size_t i = 0; i < claimed; ++i) {
+            auto & cell = m_cells[(begin + i) & m_mask];
+            values.push_back(std::move(*cell.value()));
+            cell.value()->~T();
+            cell.sequence.store(begin + i + m_mask + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    T wait_and_pop() {
+        T value;
+        wait([this, &value] { return try_pop(value); });
+        return value;
+    }
+
+    std::vector<T> wait_and_pop_all() {
+        std::vector<T> values;
+        wait([this, &values] { return try_pop_batch(values, m_mask + 1) > 0; });
+        return values;
+    }
+
+    /// @brief Approximate size, only for metrics and limits.
+    std::size_t unsafe_size() const noexcept {
+        auto const enqueued = m_enqueue_position.value.load(std::memory_order_relaxed);
+        auto const dequeued = m_dequeue_position.value.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    std::size_t capacity() const noexcept {
+        return m_mask + 1;
+    }
+
+    /// @brief Items dropped because the queue was full.
+    uint64_t dropped() const noexcept {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::size_t round_up_to_power_of_two(std::size_t const n) {
+        std::size_t result{2};
+        while (result < n) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    template <typename U>
+    bool emplace(U && o) {
+        std::size_t position = m_enqueue_position.value.load(std::memory_order_relaxed);
+        for (;;) {
+            auto & cell = m_cells[position & m_mask];
+            std::size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (diff == 0) {
+                if (m_enqueue_position.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    ::new (cell.value()) T(std::forward<U>(o));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = m_enqueue_position.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Claims up to max consecutive cells from position whose sequence is their position plus turn:
+    ///        turn 0 finds free cells for producers, turn 1 filled cells for consumers.
+    ///        A cell past the position is only taken by claiming the position first, so the cells checked keep
+    ///        their turn until the CAS.
+    std::size_t claim(std::atomic<std::size_t> & position, std::size_t const turn, std::size_t const max, std::size_t & begin) {
+        if (max == 0) {
+            return 0;
+        }
+        std::size_t current = position.load(std::memory_order_relaxed);
+        for (;;) {
+            std::size_t ready{0};
+            while (ready < max && m_cells[(current + ready) & m_mask].sequence.load(std::memory_order_acquire) == current + ready + turn) {
+                ++ready;
+            }
+            if (ready == 0) {
+                auto const sequence = m_cells[current & m_mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(current + turn) < 0) {
+                    return 0;
+                }
+                // another thread took the position
+                current = position.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (position.compare_exchange_weak(current, current + ready, std::memory_order_relaxed)) {
+                begin = current;
+                return ready;
+            }
+        }
+    }
+
+    template <typename Pop>
+    void wait(Pop const & pop) {
+        for (int i = 0; i < spin_count; ++i) {
+            if (pop()) {
+                return;
+            }
+        }
+        for (int i = 0; i < yield_count; ++i) {
+            if (pop()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock{m_park_mutex};
+        m_parked.fetch_add(1, std::memory_order_seq_cst);
+        // the producer pushes and then reads m_parked, the consumer counts itself in and then pops: one of both
+        // sees the other, so no wake up is lost
+        while (!pop()) {
+            m_park_cv.wait(lock);
+        }
+        m_parked.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_parked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_parked.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock{m_park_mutex};
+            m_park_cv.notify_all();
+        }
+    }
+
+    struct alignas(cache_line_size) xpadded_position_t {
+        std::atomic<std::size_t> value{0};
+    };
+
+    std::size_t const m_mask;
+    std::unique_ptr<xcell_t[]> m_cells;
+    xpadded_position_t m_enqueue_position;
+    xpadded_position_t m_dequeue_position;
+    alignas(cache_line_size) std::atomic<uint64_t> m_dropped{0};
+    std::atomic<int> m_parked{0};
+    std::mutex m_park_mutex;
+    std::condition_variable m_park_cv;
+};
+
+NS_END2
@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xthreading/xutility.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+NS_BEG2(top, threading)
+
+/// @brief Lock-free multiple-producer single-consumer queue.
+///        Producers push by one CAS on the head, never blocked by each other or by the consumer.
+///        The consumer takes all items at once by one exchange, so there is no ABA problem.
+///        Only one thread may call pop_all at the same time, e.g. the one holding the lock of the data fed by this queue.
+template <typename T>
+class xmpsc_queue final {
+    struct xnode_t {
+        T value;
+        xnode_t * next{nullptr};
+
+        explicit xnode_t(T const & v) : value{v} {
+        }
+        explicit xnode_t(T && v) : value{std::move(v)} {
+        }
+    };
+
+public:
+    xmpsc_queue(xmpsc_queue const &) = delete;
+    xmpsc_queue & operator=(xmpsc_queue const &) = delete;
+    xmpsc_queue(xmpsc_queue &&) = delete;
+    xmpsc_queue & operator=(xmpsc_queue &&) = delete;
+
+    xmpsc_queue() = default;
+
+    ~xmpsc_queue() {
+        xnode_t * node = m_head.exchange(nullptr, std::memory_order_acquire);
+        while (node != nullptr) {
+            xnode_t * next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void push(T const & o) {
+        push_node(new xnode_t(o));
+    }
+
+    void push(T && o) {
+        push_node(new xnode_t(std::move(o)));
+    }
+
+    /// @brief Take all pushed items in push order.
+    std::vector<T> pop_all() {
+        std::vector<T> values;
+        xnode_t * node = m_head.exchange(nullptr, std::memory_order_acquire);
+        if (node == nullptr) {
+            return values;
+        }
+        m_size.fetch_sub(reverse_and_count(node), std::memory_order_relaxed);
+        while (node != nullptr) {
+            xnode_t * next = node->next;
+            values.push_back(std::move(node->value));
+            delete node;
+            node = next;
+        }
+        return values;
+    }
+
+    bool empty() const noexcept {
+        return m_head.load(std::memory_order_relaxed) == nullptr;
+    }
+
+    /// @brief Approximate size, only for metrics and limits.
+    std::size_t size() const noexcept {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+private:
+    void push_node(xnode_t * node) {
+        m_size.fetch_add(1, std::memory_order_relaxed);
+        node->next = m_head.load(std::memory_order_relaxed);
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Reverse the LIFO list to push order, return node count.
+    static std::size_t reverse_and_count(xnode_t *& node) {
+        std::size_t count{0};
+        xnode_t * prev = nullptr;
+        while (node != nullptr) {
+            xnode_t * next = node->next;
+            node->next = prev;
+            prev = node;
+            node = next;
+            ++count;
+        }
+        node = prev;
+        return count;
+    }
+
+    std::atomic<xnode_t *> m_head{nullptr};
+    std::atomic<std::size_t> m_size{0};
+};
+
+NS_END2
@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NS_BEG2(top, threading)
+
+// long-lived threads shared by cpu bound batches(e.g. signature verification) that split one call into parts,
+// so a call never pays for creating and joining threads. threads start at first use.
+class xtop_parallel_pool {
+public:
+    xtop_parallel_pool(xtop_parallel_pool const &) = delete;
+    xtop_parallel_pool & operator=(xtop_parallel_pool const &) = delete;
+    ~xtop_parallel_pool();
+
+    static xtop_parallel_pool & instance();
+
+    // runs task(0) .. task(part_count - 1) on at most max_threads threads including the calling one,
+    // and returns once every part is done. the calling thread takes parts too, so a task may call run again.
+    void run(std::size_t part_count, std::size_t max_threads, std::function<void(std::size_t)> const & task);
+    std::size_t thread_count() const noexcept;
+
+private:
+    xtop_parallel_pool();
+    void start();
+    void worker_loop();
+
+    std::size_t                       m_thread_count{0};
+    std::once_flag                    m_start_flag;
+    std::mutex                        m_lock;
+    std::condition_variable           m_cond;
+    std::deque<std::function<void()>> m_helpers;
+    std::vector<std::thread>          m_threads;
+    bool                              m_stop{false};
+};
+using xparallel_pool_t = xtop_parallel_pool;
+
+NS_END2
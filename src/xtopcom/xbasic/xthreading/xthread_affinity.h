@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, threading)
+
+// parses a linux cpu list, "0-7,16-23", into its cpus in ascending order. empty for a malformed list.
+std::vector<int> parse_cpu_list(std::string const & cpu_list);
+
+/// @brief Pins threads to cpu sets by their name, e.g. consensus workers to one socket and rpc and rocksdb compaction
+///        to another. Rules are "prefix:cpus;prefix:cpus", the longest prefix matching a thread name wins:
+///        "cons_worker:0-7;xbft_worker:0-7;rpc:8-11;rocksdb:12-15".
+///        A thread named by set_current_thread_name or set_thread_name is pinned right away. When all cpus of its rule
+///        are on one numa node, its allocations prefer that node, so the caches filled by a pool stay local to it.
+///        Threads named elsewhere, e.g. rocksdb's background jobs, are pinned by apply_all_threads.
+class xthread_affinity_t {
+public:
+    xthread_affinity_t(xthread_affinity_t const &) = delete;
+    xthread_affinity_t & operator=(xthread_affinity_t const &) = delete;
+    xthread_affinity_t(xthread_affinity_t &&) = delete;
+    xthread_affinity_t & operator=(xthread_affinity_t &&) = delete;
+
+    static xthread_affinity_t & instance();
+
+    // replaces the rules; false and the rules are kept if rules is malformed. set before the pools start.
+    bool configure(std::string const & rules);
+
+    // pins the calling thread if a rule matches name
+    void apply_current_thread(std::string const & name);
+
+    // pins every thread of the process whose name matches a rule, returns the number of threads pinned
+    std::size_t apply_all_threads();
+
+private:
+    struct xrule_t {
+        std::string prefix;
+        std::vector<int> cpus;
+        int numa_node{-1};
+    };
+
+    xthread_affinity_t() = default;
+    ~xthread_affinity_t() = default;
+
+    // longest prefix rule of name, false if none
+    bool match(std::string const & name, xrule_t & rule) const;
+
+    mutable std::mutex m_mutex;
+    std::vector<xrule_t> m_rules;
+};
+
+NS_END2
@@ -0,0 +1,22 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xbase/xthread.h"
+
+#include <string>
+
+NS_BEG2(top, threading)
+
+// names the calling os thread, shown by top -H, gdb, perf and the thread list of the admin http profiles.
+// linux keeps the first 15 characters; threads created afterwards by this thread inherit the name.
+// the thread is pinned to the cpus xthread_affinity_t configures for the name.
+void set_current_thread_name(std::string const & name);
+
+// names the os thread of worker from inside it, the call is queued behind work already posted to worker
+void set_thread_name(base::xworker_t * worker, std::string const & name);
+
+NS_END2
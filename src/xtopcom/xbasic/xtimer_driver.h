@@ -10,13 +10,18 @@
 #include "xbasic/xrunnable.h"
 #include "xbasic/xtimer.h"
 #include "xbasic/xtimer_driver_fwd.h"
+#include "xbasic/xtimer_wheel.h"
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 
 NS_BEG1(top)
 
+/// @brief Runs the scheduled callbacks on the io context. the callbacks are kept in a timing wheel advanced by one
+///        timer ticking every tick_ms, so scheduling and cancelling are O(1) whatever the number of pending timers,
+///        and the callbacks are fired late by up to one tick.
 class xtop_timer_driver final
   : public std::enable_shared_from_this<xtop_timer_driver>
   , public xbasic_runnable_t<xtop_timer_driver> {
@@ -24,9 +29,11 @@ private:
     using runnable_base_type = xbasic_runnable_t<xtop_timer_driver>;
 
     std::mutex m_timers_mutex{};
-    std::vector<std::shared_ptr<top::xtimer_t>> m_timers{};
+    basic::xtimer_wheel_t<top::xtimer_t::timeout_callback_t> m_wheel{};
+    std::unique_ptr<asio::steady_timer> m_tick_timer{};
 
-    std::chrono::milliseconds m_reap_interval;
+    std::chrono::milliseconds m_tick;
+    std::chrono::steady_clock::time_point m_epoch{std::chrono::steady_clock::now()};
     std::weak_ptr<xasio_io_context_wrapper_t> m_io_object;
 
 public:
@@ -36,18 +43,23 @@ public:
     xtop_timer_driver & operator=(xtop_timer_driver &&) = default;
     ~xtop_timer_driver() = default;
 
-    explicit xtop_timer_driver(std::shared_ptr<xasio_io_context_wrapper_t> io_object, std::chrono::milliseconds reap_interval_ms = std::chrono::milliseconds{100});
+    explicit xtop_timer_driver(std::shared_ptr<xasio_io_context_wrapper_t> io_object, std::chrono::milliseconds tick_ms = std::chrono::milliseconds{10});
 
     void start() override;
 
     void stop() override;
 
-    void schedule(std::chrono::milliseconds const & ms_in_future, top::xtimer_t::timeout_callback_t callback);
+    /// @brief Runs callback once after ms_in_future. returns 0 when the driver is not running.
+    basic::xtimer_handle_t schedule(std::chrono::milliseconds const & ms_in_future, top::xtimer_t::timeout_callback_t callback);
+
+    /// @brief Drops a callback not run yet, false when it already ran or was cancelled.
+    bool cancel(basic::xtimer_handle_t handle);
 
 private:
-    void do_reap();
+    void do_tick();
 };
 
+/// @brief xtop_timer_driver on the thread of an xbase io context.
 class xtop_base_timer_driver final
   : public std::enable_shared_from_this<xtop_base_timer_driver>
   , public xbasic_runnable_t<xtop_base_timer_driver> {
@@ -55,9 +67,12 @@ private:
     using runnable_base_type = xbasic_runnable_t<xtop_base_timer_driver>;
 
     std::mutex m_timers_mutex{};
-    std::vector<std::unique_ptr<top::xbase_timer_t>> m_timers{};
+    basic::xtimer_wheel_t<top::xbase_timer_t::timeout_callback_t> m_wheel{};
+    // the timer of the coming tick and the ones fired already, released at the next tick
+    std::vector<std::unique_ptr<top::xbase_timer_t>> m_tick_timers{};
 
-    std::chrono::milliseconds m_reap_interval;
+    std::chrono::milliseconds m_tick;
+    std::chrono::steady_clock::time_point m_epoch{std::chrono::steady_clock::now()};
     observer_ptr<xbase_io_context_wrapper_t> m_io_object;
 
 public:
@@ -67,16 +82,20 @@ public:
     xtop_base_timer_driver & operator=(xtop_base_timer_driver &&) = default;
     ~xtop_base_timer_driver() = default;
 
-    explicit xtop_base_timer_driver(std::shared_ptr<xbase_io_context_wrapper_t> const & io_object, std::chrono::milliseconds reap_interval_ms = std::chrono::minutes{2});
+    explicit xtop_base_timer_driver(std::shared_ptr<xbase_io_context_wrapper_t> const & io_object, std::chrono::milliseconds tick_ms = std::chrono::milliseconds{10});
 
     void start() override;
 
     void stop() override;
 
-    void schedule(std::chrono::milliseconds const & ms_in_future, top::xbase_timer_t::timeout_callback_t callback);
+    /// @brief Runs callback once after ms_in_future. returns 0 when the driver is not running.
+    basic::xtimer_handle_t schedule(std::chrono::milliseconds const & ms_in_future, top::xbase_timer_t::timeout_callback_t callback);
+
+    /// @brief Drops a callback not run yet, false when it already ran or was cancelled.
+    bool cancel(basic::xtimer_handle_t handle);
 
 private:
-    void do_reap();
+    void do_tick(std::chrono::milliseconds current_time);
 };
 using xbase_timer_driver_t = xtop_base_timer_driver;
 
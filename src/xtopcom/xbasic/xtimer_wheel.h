@@ -0,0 +1,245 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+NS_BEG2(top, basic)
+
+/// @brief Identifies a timer added to a wheel, 0 is never a valid handle.
+using xtimer_handle_t = std::uint64_t;
+
+/* hierarchical timing wheel: four levels of 256, 64, 64 and 64 slots. the first level has one slot per tick,
+ * every slot of a higher level spans the whole level below. add and cancel are O(1), a tick expires its slot of
+ * the first level as a batch and, once per round of a level, moves the next slot of the level above down.
+ * timers are kept in a slab of nodes linked by index, so adding a timer does not allocate once the slab has grown.
+ * deadlines more than 2^26 ticks ahead are parked in the last level and put back each time they come round.
+ * the wheel is not thread safe, its owner serializes access.
+ */
+template <typename CallbackT>
+class xtimer_wheel {
+public:
+    static constexpr std::size_t level0_bits{8};
+    static constexpr std::size_t level_bits{6};
+    static constexpr std::size_t level_count{4};
+    static constexpr std::uint64_t max_span{std::uint64_t{1} << (level0_bits + (level_count - 1) * level_bits)};
+
+    xtimer_wheel() {
+        m_heads.fill(npos);
+    }
+
+    /// @brief Adds a timer expiring at absolute tick expire_tick, or at the next tick if that has passed.
+    xtimer_handle_t add(std::uint64_t const expire_tick, CallbackT callback) {
+        std::uint32_t index;
+        if (m_free != npos) {
+            index = m_free;
+            m_free = m_nodes[index].next;
+        } else {
+            assert(m_nodes.size() < npos);
+            index = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        auto & node = m_nodes[index];
+        node.expire_tick = expire_tick > m_now ? expire_tick : m_now + 1;
+        node.callback = std::move(callback);
+        node.active = true;
+        link(index);
+        ++m_size;
+        return handle_of(index);
+    }
+
+    /// @brief Removes a pending timer, false when it already expired or was cancelled.
+    bool cancel(xtimer_handle_t const handle) {
+        auto const index = static_cast<std::uint32_t>(handle & 0xFFFFFFFF);
+        if (handle == 0 || index >= m_nodes.size()) {
+            return false;
+        }
+        auto & node = m_nodes[index];
+        if (!node.active || node.generation != static_cast<std::uint32_t>(handle >> 32)) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    /// @brief Runs the ticks up to tick and appends the callbacks of the expired timers to expired, in order of
+    ///        expiry. the owner calls them after leaving its lock, so they may add timers again.
+    std::size_t advance(std::uint64_t const tick, std::vector<CallbackT> & expired) {
+        auto const before = expired.size();
+        while (m_now < tick) {
+            if (m_size == 0) {
+                // no timer to cascade or expire, the empty slots are skipped at once
+                m_now = tick;
+                break;
+            }
+            auto const next = m_now + 1;
+            // the base of the placement is the tick being processed, so a cascaded timer lands in the first level
+            m_now = next;
+            cascade(next);
+            expire(next, expired);
+        }
+        return expired.size() - before;
+    }
+
+    /// @brief The last tick processed.
+    std::uint64_t now() const noexcept {
+        return m_now;
+    }
+
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+private:
+    static constexpr std::uint32_t npos{std::numeric_limits<std::uint32_t>::max()};
+    static constexpr std::size_t level0_slots{std::size_t{1} << level0_bits};
+    static constexpr std::size_t level_slots{std::size_t{1} << level_bits};
+    static constexpr std::size_t slot_count{level0_slots + (level_count - 1) * level_slots};
+
+    struct xnode_t {
+        std::uint64_t expire_tick{0};
+        CallbackT callback{};
+        std::uint32_t prev{npos};
+        std::uint32_t next{npos};
+        std::uint32_t slot{0};
+        std::uint32_t generation{1};
+        bool active{false};
+    };
+
+    std::vector<xnode_t> m_nodes;
+    std::array<std::uint32_t, slot_count> m_heads;
+    std::vector<std::uint32_t> m_due;
+    std::uint32_t m_free{npos};
+    std::size_t m_size{0};
+    std::uint64_t m_now{0};
+
+    xtimer_handle_t handle_of(std::uint32_t const index) const noexcept {
+        return (static_cast<xtimer_handle_t>(m_nodes[index].generation) << 32) | index;
+    }
+
+    // slot of a deadline, placed relative to the tick being processed (m_now during a tick, else the next one)
+    std::size_t slot_of(std::uint64_t const expire_tick, std::uint64_t const base) const noexcept {
+        auto delta = expire_tick > base ? expire_tick - base : 0;
+        auto tick = base + delta;
+        if (delta < level0_slots) {
+            return tick & (level0_slots - 1);
+        }
+        if (delta >= max_span) {
+            tick = base + max_span - 1;
+        }
+        std::size_t level = 1;
+        while (level < level_count - 1 && delta >= (std::uint64_t{1} << (level0_bits + level * level_bits))) {
+            ++level;
+        }
+        auto const shift = level0_bits + (level - 1) * level_bits;
+        return level0_slots + (level - 1) * level_slots + ((tick >> shift) & (level_slots - 1));
+    }
+
+    void link(std::uint32_t const index) {
+        // between the ticks the next one to run is m_now + 1
+        relink(index, m_now + 1);
+    }
+
+    void unlink(std::uint32_t const index) {
+        auto & node = m_nodes[index];
+        if (node.prev != npos) {
+            m_nodes[node.prev].next = node.next;
+        } else {
+            m_heads[node.slot] = node.next;
+        }
+        if (node.next != npos) {
+            m_nodes[node.next].prev = node.prev;
+        }
+    }
+
+    void release(std::uint32_t const index) {
+        auto & node = m_nodes[index];
+        node.callback = CallbackT{};
+        node.active = false;
+        ++node.generation;
+        if (node.generation == 0) {
+            node.generation = 1;
+        }
+        node.next = m_free;
+        m_free = index;
+        --m_size;
+    }
+
+    // at the start of every round of a level, brings down the slot of the level above covering that round
+    void cascade(std::uint64_t const tick) {
+        for (std::size_t level = 1; level < level_count; ++level) {
+            auto const shift = level0_bits + (level - 1) * level_bits;
+            if ((tick & ((std::uint64_t{1} << shift) - 1)) != 0) {
+                break;
+            }
+            auto const slot = level0_slots + (level - 1) * level_slots + ((tick >> shift) & (level_slots - 1));
+            auto index = m_heads[slot];
+            m_heads[slot] = npos;
+            while (index != npos) {
+                auto const next = m_nodes[index].next;
+                relink(index, tick);
+                index = next;
+            }
+        }
+    }
+
+    void relink(std::uint32_t const index, std::uint64_t const base) {
+        auto & node = m_nodes[index];
+        node.slot = static_cast<std::uint32_t>(slot_of(node.expire_tick, base));
+        node.prev = npos;
+        node.next = m_heads[node.slot];
+        if (node.next != npos) {
+            m_nodes[node.next].prev = index;
+        }
+        m_heads[node.slot] = index;
+    }
+
+    void expire(std::uint64_t const tick, std::vector<CallbackT> & expired) {
+        auto const slot = tick & (level0_slots - 1);
+        auto index = m_heads[slot];
+        m_heads[slot] = npos;
+        // the slot is a stack, collected first so the batch runs in the order the timers were linked
+        auto & due = m_due;
+        due.clear();
+        while (index != npos) {
+            auto const next = m_nodes[index].next;
+            if (m_nodes[index].expire_tick > tick) {
+                // a parked far deadline, not due in this round yet
+                relink(index, tick + 1);
+            } else {
+                due.push_back(index);
+            }
+            index = next;
+        }
+        for (auto it = due.rbegin(); it != due.rend(); ++it) {
+            expired.push_back(std::move(m_nodes[*it].callback));
+            release(*it);
+        }
+    }
+};
+
+template <typename CallbackT>
+constexpr std::uint64_t xtimer_wheel<CallbackT>::max_span;
+
+template <typename CallbackT>
+constexpr std::uint32_t xtimer_wheel<CallbackT>::npos;
+
+template <typename CallbackT>
+using xtimer_wheel_t = xtimer_wheel<CallbackT>;
+
+NS_END2
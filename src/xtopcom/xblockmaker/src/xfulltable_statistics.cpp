@@ -8,6 +8,11 @@
 #include "xbase/xobject_ptr.h"
 #include "xdata/xblocktool.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
 namespace top {
 namespace blockmaker {
 
@@ -43,10 +48,40 @@ static void calc_workload_data(const xvip2_t leader_xip, const uint32_t txs_coun
     it_group->second.account_statistics_data[slot_idx].block_data.transaction_count += txs_count;
 }
 
-static void calc_consensus_vote_data(xvip2_t const & vote_xip,
-                                     xobject_ptr_t<data::xblock_t> const & block,
-                                     std::string const & aggregated_signatures_bin,
-                                     data::xstatistics_data_t & data) {
+// votes of one consensus group on a block, decoded from its aggregated signature
+struct xconsensus_vote_info_t {
+    xvip2_t vote_xip;
+    std::vector<bool> voted;  // one per slot of the group
+};
+
+// what a block contributes to the statistics. extracting it decodes the txactions and the signatures,
+// which is the expensive part, so it is done for the blocks in parallel and merged in block order after.
+struct xblock_statistics_info_t {
+    bool valid{false};
+    xvip2_t leader_xip;
+    uint32_t txs_count{0};
+    std::vector<xconsensus_vote_info_t> votes;
+};
+
+static xconsensus_vote_info_t extract_consensus_vote_data(xvip2_t const & vote_xip, std::string const & aggregated_signatures_bin) {
+    xconsensus_vote_info_t info;
+    info.vote_xip = vote_xip;
+
+    xassert(!aggregated_signatures_bin.empty());
+
+    xmutisigdata_t aggregated_sig_obj;
+    xassert(aggregated_sig_obj.serialize_from_string(aggregated_signatures_bin) > 0);
+
+    xnodebitset & nodebits = aggregated_sig_obj.get_nodebitset();
+    info.voted.resize(std::max(0, static_cast<int>(nodebits.get_alloc_bits())));
+    for (int i = 0; i < nodebits.get_alloc_bits(); ++i) {
+        info.voted[i] = nodebits.is_set(i);
+    }
+    return info;
+}
+
+static void calc_consensus_vote_data(xconsensus_vote_info_t const & info, data::xstatistics_data_t & data) {
+    auto const & vote_xip = info.vote_xip;
     // height
     uint64_t block_height = get_network_height_from_xip2(vote_xip);
     auto it_height = data.detail.find(block_height);
@@ -66,55 +101,77 @@ static void calc_consensus_vote_data(xvip2_t const & vote_xip,
         it_group = ret.first;
     }
 
-    xassert(!aggregated_signatures_bin.empty());
-
-    xmutisigdata_t aggregated_sig_obj;
-    xassert(aggregated_sig_obj.serialize_from_string(aggregated_signatures_bin) > 0);
-
-    xnodebitset & nodebits = aggregated_sig_obj.get_nodebitset();
-    if(it_group->second.account_statistics_data.size() < (uint32_t)nodebits.get_alloc_bits()){
-        it_group->second.account_statistics_data.resize(nodebits.get_alloc_bits());
+    if(it_group->second.account_statistics_data.size() < info.voted.size()){
+        it_group->second.account_statistics_data.resize(info.voted.size());
     }
-    for (int i = 0; i < nodebits.get_alloc_bits(); ++i) {
+    for (size_t i = 0; i < info.voted.size(); ++i) {
         it_group->second.account_statistics_data[i].vote_data.block_count++;
-        if (nodebits.is_set(i)) {
+        if (info.voted[i]) {
             it_group->second.account_statistics_data[i].vote_data.vote_count++;
         }
     }
 }
 
-static void process_vote_info(xobject_ptr_t<data::xblock_t> const & block, data::xstatistics_data_t & data) {
+static xblock_statistics_info_t extract_block_statistics(xobject_ptr_t<data::xblock_t> const & block) {
+    xblock_statistics_info_t info;
+    info.valid = true;
+    info.txs_count = data::xblockextract_t::get_txactions_count(block.get());
+
+    info.leader_xip = block->get_cert()->get_validator();
+    if (get_node_id_from_xip2(info.leader_xip) == 0x3FF) {
+        info.leader_xip = block->get_cert()->get_auditor();
+        xassert(!block->get_cert()->get_audit_signature().empty());
+    }
+
     auto auditor_xip = block->get_cert()->get_auditor();
     auto validator_xip = block->get_cert()->get_validator();
 
     if (!is_xip2_empty(auditor_xip)) {//block has auditor info
-        calc_consensus_vote_data(auditor_xip, block, block->get_cert()->get_audit_signature(), data);
+        info.votes.push_back(extract_consensus_vote_data(auditor_xip, block->get_cert()->get_audit_signature()));
     }
 
     if (!is_xip2_empty(validator_xip)) {
-        calc_consensus_vote_data(validator_xip, block, block->get_cert()->get_verify_signature(), data);
+        info.votes.push_back(extract_consensus_vote_data(validator_xip, block->get_cert()->get_verify_signature()));
     }
+    return info;
 }
 
 data::xstatistics_data_t tableblock_statistics(std::vector<xobject_ptr_t<data::xblock_t>> const & blks) {
+    constexpr size_t min_blocks_per_worker{16};
+
     data::xstatistics_data_t data;
     xdbg("[tableblock_statistics] blks size: %u", blks.size());
-    for (size_t i = 0; i < blks.size(); i++) {
-        if (nullptr == blks[i]) {
+
+    std::vector<xblock_statistics_info_t> infos(blks.size());
+    auto extract = [&blks, &infos](size_t const worker, size_t const workers) {
+        for (size_t i = worker; i < blks.size(); i += workers) {
+            if (nullptr != blks[i]) {
+                infos[i] = extract_block_statistics(blks[i]);
+            }
+        }
+    };
+    size_t const workers = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), blks.size() / min_blocks_per_worker));
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers - 1);
+    for (size_t worker = 1; worker < workers; ++worker) {
+        futures.push_back(std::async(std::launch::async, extract, worker, workers));
+    }
+    extract(0, workers);
+    for (auto & future : futures) {
+        future.get();
+    }
+
+    // merged in block order, the result doesn't depend on how the blocks were spread over the workers
+    for (size_t i = 0; i < infos.size(); i++) {
+        if (!infos[i].valid) {
             xerror("[tableblock_statistics] blks[%u] null", i);
             continue;
         }
 
-        uint32_t txs_count = data::xblockextract_t::get_txactions_count(blks[i].get());
-
-        auto leader_xip = blks[i]->get_cert()->get_validator();
-        if (get_node_id_from_xip2(leader_xip) == 0x3FF) {
-            leader_xip = blks[i]->get_cert()->get_auditor();
-            xassert(!blks[i]->get_cert()->get_audit_signature().empty());
+        calc_workload_data(infos[i].leader_xip, infos[i].txs_count, data);
+        for (auto const & vote_info : infos[i].votes) {
+            calc_consensus_vote_data(vote_info, data);
         }
-
-        calc_workload_data(leader_xip, txs_count, data);
-        process_vote_info(blks[i], data);
     }
 
     return data;
@@ -304,6 +304,8 @@ xblock_ptr_t xtable_maker_t::make_light_table_v2(bool is_leader, const xtablemak
             is_leader, cs_para.dump().c_str());        
         return nullptr;
     }
+    // load unit states at background while preparing txs, executor will wait for it
+    statectx_ptr->async_prefetch_unit_states(txexecutor::xbatchtx_executor_t::get_batch_accounts(input_txs));
 
     resource_plugin_make_txs(is_leader, statectx_ptr, cs_para, input_txs, ec);
     if (ec) {
@@ -0,0 +1,299 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include "xdata/xblock.h"
+#include "../xblockarchive.h"
+
+namespace top
+{
+    namespace store
+    {
+        //integers are kept as little endian
+        static void put_uint(std::string & out,const uint64_t value,const size_t bytes)
+        {
+            for(size_t i = 0; i < bytes; ++i)
+                out.push_back((char)((value >> (8 * i)) & 0xFF));
+        }
+
+        static bool get_uint(const char * data,const size_t size,size_t & pos,const size_t bytes,uint64_t & value)
+        {
+            if(pos + bytes > size)
+                return false;
+            value = 0;
+            for(size_t i = 0; i < bytes; ++i)
+                value |= ((uint64_t)(uint8_t)data[pos + i]) << (8 * i);
+            pos += bytes;
+            return true;
+        }
+
+        xblock_archive_writer_t::~xblock_archive_writer_t()
+        {
+            if(m_file != nullptr) //not closed normally,segment is left without index
+            {
+                fclose(m_file);
+                m_file = nullptr;
+            }
+        }
+
+        bool  xblock_archive_writer_t::open(const std::string & file_path)
+        {
+            if(m_file != nullptr)
+                return false;
+
+            m_file = fopen(file_path.c_str(),"wb");
+            if(nullptr == m_file)
+            {
+                xerror("xblock_archive_writer_t::open,fail to create file(%s)",file_path.c_str());
+                return false;
+            }
+            m_write_offset = 0;
+            m_blocks_count = 0;
+            m_index.clear();
+            m_accounts.clear();
+
+            std::string head;
+            put_uint(head,enum_archive_magic,4);
+            put_uint(head,enum_archive_version,4);
+            return write_raw(head.data(),head.size());
+        }
+
+        bool  xblock_archive_writer_t::write_raw(const void * data,const size_t size)
+        {
+            if(fwrite(data,1,size,m_file) != size)
+            {
+                xerror("xblock_archive_writer_t::write_raw,fail to write %zu bytes at offset(%llu)",size,m_write_offset);
+                return false;
+            }
+            m_write_offset += size;
+            return true;
+        }
+
+        bool  xblock_archive_writer_t::append(base::xvblock_t * block)
+        {
+            if( (nullptr == m_file) || (nullptr == block) )
+                return false;
+
+            data::xblock_t * full_block = dynamic_cast<data::xblock_t*>(block);
+            if(nullptr == full_block)
+                return false;
+
+            std::vector<xarchive_entry_t> & entries = m_index[block->get_account()];
+            if( (false == entries.empty()) && (entries.back().height >= block->get_height()) )
+            {
+                xwarn("xblock_archive_writer_t::append,height must be ascending,last(%llu) block=%s",entries.back().height,block->dump().c_str());
+                return false;
+            }
+
+            base::xstream_t stream(base::xcontext_t::instance());
+            if(full_block->full_block_serialize_to(stream) <= 0)
+            {
+                xerror("xblock_archive_writer_t::append,block is not full loaded.block=%s",block->dump().c_str());
+                return false;
+            }
+
+            xarchive_entry_t entry;
+            entry.height = block->get_height();
+            entry.offset = m_write_offset;
+            entry.size   = (uint32_t)stream.size();
+            if(false == write_raw(stream.data(),(size_t)stream.size()))
+                return false;
+
+            if(entries.empty())
+                m_accounts.push_back(block->get_account());
+            entries.push_back(entry);
+            m_blocks_count++;
+            return true;
+        }
+
+        bool  xblock_archive_writer_t::close()
+        {
+            if(nullptr == m_file)
+                return false;
+
+            const uint64_t index_offset = m_write_offset;
+            std::string index_bin;
+            put_uint(index_bin,m_accounts.size(),4);
+            for(auto & address : m_accounts)
+            {
+                const std::vector<xarchive_entry_t> & entries = m_index[address];
+                put_uint(index_bin,address.size(),2);
+                index_bin.append(address);
+                put_uint(index_bin,entries.size(),4);
+                for(auto & entry : entries)
+                {
+                    put_uint(index_bin,entry.height,8);
+                    put_uint(index_bin,entry.offset,8);
+                    put_uint(index_bin,entry.size,4);
+                }
+            }
+            put_uint(index_bin,index_offset,8);
+            put_uint(index_bin,enum_archive_magic,4);
+
+            bool result = write_raw(index_bin.data(),index_bin.size());
+            if(fflush(m_file) != 0)
+                result = false;
+            fclose(m_file);
+            m_file = nullptr;
+            xinfo("xblock_archive_writer_t::close,accounts(%zu),blocks(%zu),size(%llu),result(%d)",m_accounts.size(),m_blocks_count,m_write_offset,result);
+            return result;
+        }
+
+        xblock_archive_reader_t::~xblock_archive_reader_t()
+        {
+            close();
+        }
+
+        bool  xblock_archive_reader_t::open(const std::string & file_path)
+        {
+            if(m_data != nullptr)
+                return false;
+
+            m_fd = ::open(file_path.c_str(),O_RDONLY);
+            if(m_fd < 0)
+            {
+                xwarn("xblock_archive_reader_t::open,fail to open file(%s)",file_path.c_str());
+                return false;
+            }
+            struct stat file_stat;
+            if( (fstat(m_fd,&file_stat) != 0) || (file_stat.st_size < (enum_archive_head_size + enum_archive_foot_size)) )
+            {
+                xwarn("xblock_archive_reader_t::open,invalid file(%s)",file_path.c_str());
+                close();
+                return false;
+            }
+
+            void * mapped = mmap(nullptr,(size_t)file_stat.st_size,PROT_READ,MAP_SHARED,m_fd,0);
+            if(MAP_FAILED == mapped)
+            {
+                xwarn("xblock_archive_reader_t::open,fail to map file(%s)",file_path.c_str());
+                close();
+                return false;
+            }
+            m_data = (const char*)mapped;
+            m_size = (size_t)file_stat.st_size;
+            madvise(mapped,m_size,MADV_RANDOM); //lookup by height,let page cache keep what is read
+
+            if(false == parse_index())
+            {
+                xerror("xblock_archive_reader_t::open,bad segment(%s)",file_path.c_str());
+                close();
+                return false;
+            }
+            xinfo("xblock_archive_reader_t::open,file(%s),accounts(%zu),size(%zu)",file_path.c_str(),m_index.size(),m_size);
+            return true;
+        }
+
+        void  xblock_archive_reader_t::close()
+        {
+            if(m_data != nullptr)
+            {
+                munmap((void*)m_data,m_size);
+                m_data = nullptr;
+                m_size = 0;
+            }
+            if(m_fd >= 0)
+            {
+                ::close(m_fd);
+                m_fd = -1;
+            }
+            m_index.clear();
+        }
+
+        bool  xblock_archive_reader_t::parse_index()
+        {
+            uint64_t value = 0;
+            size_t pos = 0;
+            if( (false == get_uint(m_data,m_size,pos,4,value)) || (value != enum_archive_magic) )
+                return false;
+            if( (false == get_uint(m_data,m_size,pos,4,value)) || (value != enum_archive_version) )
+                return false;
+
+            uint64_t index_offset = 0;
+            pos = m_size - enum_archive_foot_size;
+            if( (false == get_uint(m_data,m_size,pos,8,index_offset)) || (false == get_uint(m_data,m_size,pos,4,value)) || (value != enum_archive_magic) )
+                return false;
+            if( (index_offset < enum_archive_head_size) || (index_offset > m_size - enum_archive_foot_size) )
+                return false;
+
+            const size_t index_end = m_size - enum_archive_foot_size;
+            pos = (size_t)index_offset;
+            uint64_t accounts_count = 0;
+            if(false == get_uint(m_data,index_end,pos,4,accounts_count))
+                return false;
+            for(uint64_t i = 0; i < accounts_count; ++i)
+            {
+                uint64_t address_size = 0;
+                if( (false == get_uint(m_data,index_end,pos,2,address_size)) || (pos + address_size > index_end) )
+                    return false;
+                std::vector<xarchive_entry_t> & entries = m_index[std::string(m_data + pos,(size_t)address_size)];
+                pos += (size_t)address_size;
+
+                uint64_t entries_count = 0;
+                if(false == get_uint(m_data,index_end,pos,4,entries_count))
+                    return false;
+                if(pos + entries_count * 20 > index_end)
+                    return false;
+                entries.resize((size_t)entries_count);
+                for(auto & entry : entries)
+                {
+                    uint64_t size = 0;
+                    get_uint(m_data,index_end,pos,8,entry.height);
+                    get_uint(m_data,index_end,pos,8,entry.offset);
+                    get_uint(m_data,index_end,pos,4,size);
+                    entry.size = (uint32_t)size;
+                    if( (entry.offset < enum_archive_head_size) || (entry.offset + entry.size > index_offset) )
+                        return false;
+                }
+            }
+            return (pos == index_end);
+        }
+
+        const xblock_archive_t::xarchive_entry_t *  xblock_archive_reader_t::find_entry(const std::string & address,const uint64_t height) const
+        {
+            auto it = m_index.find(address);
+            if(it == m_index.end())
+                return nullptr;
+
+            //entries are ascending by height
+            auto entry = std::lower_bound(it->second.begin(),it->second.end(),height,[](const xarchive_entry_t & item,const uint64_t target) {
+                return item.height < target;
+            });
+            if( (entry == it->second.end()) || (entry->height != height) )
+                return nullptr;
+            return &(*entry);
+        }
+
+        bool  xblock_archive_reader_t::read_block_data(const std::string & address,const uint64_t height,const char* & data,size_t & size) const
+        {
+            const xarchive_entry_t * entry = find_entry(address,height);
+            if(nullptr == entry)
+                return false;
+            data = m_data + entry->offset;
+            size = entry->size;
+            return true;
+        }
+
+        base::xvblock_t*  xblock_archive_reader_t::load_block(const std::string & address,const uint64_t height) const
+        {
+            const char * data = nullptr;
+            size_t size = 0;
+            if(false == read_block_data(address,height,data,size))
+                return nullptr;
+
+            base::xstream_t stream(base::xcontext_t::instance(),(uint8_t*)data,(uint32_t)size);
+            base::xvblock_t * block = data::xblock_t::full_block_read_from(stream);
+            if(nullptr == block)
+            {
+                xerror("xblock_archive_reader_t::load_block,bad block of account(%s) at height(%llu)",address.c_str(),height);
+                return nullptr;
+            }
+            return block;
+        }
+    };//end of namespace of store
+};//end of namespace of top
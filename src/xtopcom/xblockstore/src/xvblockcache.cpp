@@ -0,0 +1,78 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvblockcache.h"
+#include "xbasic/xmemory_accounting.h"
+#include "xmetrics/xmetrics.h"
+
+#include <algorithm>
+
+namespace top
+{
+    namespace store
+    {
+        xblockcache_budget_t &  xblockcache_budget_t::instance()
+        {
+            static xblockcache_budget_t _static_budget;
+            //the budget counts blocks, memory is estimated from them. a soft limit lowers the budget, accounts then
+            //shrink their caches on their next access
+            static const uint64_t _reporter = add_memory_reporter(_static_budget);
+            (void)_reporter;
+            return _static_budget;
+        }
+
+        uint64_t  xblockcache_budget_t::add_memory_reporter(xblockcache_budget_t & budget)
+        {
+            return basic::xmemory_accounting_t::instance().add_reporter(
+                "blockstore_cache",
+                [&budget]() {
+                    const uint64_t cached = (uint64_t)std::max<int64_t>(budget.get_cached_blocks(), 0);
+                    return basic::xmemory_usage_t{cached * enum_estimated_block_bytes, cached};
+                },
+                [&budget](const uint64_t target_bytes) {
+                    const int64_t target_blocks = std::max<int64_t>((int64_t)(target_bytes / enum_estimated_block_bytes), enum_min_max_cached_blocks);
+                    if(target_blocks < budget.get_max_cached_blocks())
+                        budget.set_max_cached_blocks(target_blocks);
+                });
+        }
+
+        void  xblockcache_budget_t::set_max_cached_blocks(const int64_t max_cached_blocks)
+        {
+            m_max_cached_blocks = max_cached_blocks;
+        }
+
+        void  xblockcache_budget_t::update_cached_blocks(const int64_t delta)
+        {
+            if(0 == delta)
+                return;
+
+            const int64_t cached = (m_cached_blocks += delta);
+            XMETRICS_GAUGE_SET_VALUE(metrics::blockstore_cache_budget_used, cached);
+        }
+
+        uint32_t  xblockcache_budget_t::touch(uint32_t & frequency,uint32_t & epoch)
+        {
+            const uint32_t current_epoch = (uint32_t)(++m_accesses / enum_access_aging_window);
+            frequency = get_frequency(frequency,epoch);
+            epoch     = current_epoch;
+            if(frequency < UINT32_MAX)
+                ++frequency;
+            return frequency;
+        }
+
+        uint32_t  xblockcache_budget_t::get_frequency(const uint32_t frequency,const uint32_t epoch) const
+        {
+            const uint32_t current_epoch = (uint32_t)(m_accesses / enum_access_aging_window);
+            const uint32_t passed_epochs = current_epoch - epoch;
+            if(passed_epochs >= 32)
+                return 0;
+            return (frequency >> passed_epochs);
+        }
+
+        bool  xblockcache_budget_t::is_hot(const uint32_t frequency,const uint32_t epoch) const
+        {
+            return get_frequency(frequency,epoch) >= enum_hot_access_frequency;
+        }
+    };//end of namespace of store
+};//end of namespace of top
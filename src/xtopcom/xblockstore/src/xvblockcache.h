@@ -0,0 +1,57 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace top
+{
+    namespace store
+    {
+        //node-wide budget for block indexes cached by all accounts at xblockacct_t.
+        //each account still owns its cache, the budget decides how much of it may stay: while all caches together
+        //exceed the budget, accounts accessed rarely shrink to a small cache, so hot tables keep their full cache
+        //instead of sharing the same quota with tens of thousands of idle units.
+        class xblockcache_budget_t
+        {
+        public:
+            enum
+            {
+                enum_default_max_cached_blocks  = 64 * 1024, //cached heights of all accounts
+                enum_hot_access_frequency       = 16,        //decayed access count from which account is hot
+                enum_access_aging_window        = 64 * 1024, //accesses per aging epoch, frequency halves each epoch
+                enum_estimated_block_bytes      = 4 * 1024,  //average memory of a cached index with its block, for memory accounting
+                enum_min_max_cached_blocks      = 4 * 1024,  //soft memory limit never shrinks the budget below it
+            };
+        public:
+            static xblockcache_budget_t &  instance();
+        public:
+            void        set_max_cached_blocks(const int64_t max_cached_blocks);
+            int64_t     get_max_cached_blocks() const {return m_max_cached_blocks;}
+            int64_t     get_cached_blocks() const {return m_cached_blocks;}
+            bool        is_over_budget() const {return m_cached_blocks > m_max_cached_blocks;}
+
+            //account reports change of its cached heights
+            void        update_cached_blocks(const int64_t delta);
+
+            //record one access of account, frequency and epoch are owned by account and guarded by its lock
+            //return decayed frequency after this access
+            uint32_t    touch(uint32_t & frequency,uint32_t & epoch);
+            //decayed frequency of account without recording access
+            uint32_t    get_frequency(const uint32_t frequency,const uint32_t epoch) const;
+            bool        is_hot(const uint32_t frequency,const uint32_t epoch) const;
+        private:
+            static uint64_t add_memory_reporter(xblockcache_budget_t & budget);
+            xblockcache_budget_t() = default;
+            xblockcache_budget_t(const xblockcache_budget_t &) = delete;
+            xblockcache_budget_t & operator = (const xblockcache_budget_t &) = delete;
+        private:
+            std::atomic<int64_t>    m_max_cached_blocks{enum_default_max_cached_blocks};
+            std::atomic<int64_t>    m_cached_blocks{0};
+            std::atomic<uint64_t>   m_accesses{0};
+        };
+    };//end of namespace of store
+};//end of namespace of top
@@ -4,6 +4,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <cinttypes>
+#include <map>
 #include "xvblockdb.h"
 #include "xvledger/xvdbkey.h"
 #include "xblockstore/xblockstore_face.h"
@@ -106,6 +107,36 @@ namespace top
         #endif
         }
     
+        //pending writes of one batch,owned by the thread that opened it
+        struct xvblockdb_pending_batch_t
+        {
+            xvblockdb_t*                        owner;
+            std::map<std::string,std::string>   values;
+            std::vector<base::xvbindex_t*>      indexes; //indexes written into values,hold reference
+        };
+        static thread_local xvblockdb_pending_batch_t * t_pending_batch = nullptr;
+
+        xvblockdb_batch_t::xvblockdb_batch_t(xvblockdb_t * blockdb_ptr)
+        {
+            m_blockdb_ptr = nullptr;
+            if( (blockdb_ptr != nullptr) && blockdb_ptr->begin_write_batch() )
+                m_blockdb_ptr = blockdb_ptr;
+        }
+
+        xvblockdb_batch_t::~xvblockdb_batch_t()
+        {
+            commit();
+        }
+
+        bool    xvblockdb_batch_t::commit()
+        {
+            if(nullptr == m_blockdb_ptr) //nested batch or already committed
+                return true;
+            xvblockdb_t * blockdb_ptr = m_blockdb_ptr;
+            m_blockdb_ptr = nullptr;
+            return blockdb_ptr->commit_write_batch();
+        }
+
         xvblockdb_t::xvblockdb_t(base::xvdbstore_t* xvdb_ptr)
         {
             m_blockstore_version = enum_xblockstore_version_0; //default version
@@ -216,6 +247,26 @@ namespace top
             return  read_block_output_from_db(target_index,target_block,get_xdbstore());
         }
 
+        bool    xvblockdb_t::load_block_input_output(base::xvbindex_t* target_index)
+        {
+            if(NULL == target_index)
+                return false;
+            
+            if(target_index->get_block_class() == base::enum_xvblock_class_nil)
+                return true;
+            
+            if(target_index->get_this_block() == NULL)
+                read_block_object_from_db(target_index);
+            
+            if(target_index->get_this_block() == NULL) //check again
+            {
+                xerror("xvblockdb_t::load_block_input_output,fail to load associatd raw block(%s)",target_index->dump().c_str());
+                return false;
+            }
+            xdbg("xvblockdb_t::load_block_input_output,target index(%s)",target_index->dump().c_str());
+            return  read_block_input_output_from_db(target_index,target_index->get_this_block(),get_xdbstore());
+        }
+
         bool  xvblockdb_t::load_block_output_offdata(base::xvbindex_t* target_index,base::xvblock_t * target_block)
         {
             if( (NULL == target_index) || (NULL == target_block))
@@ -295,6 +346,7 @@ namespace top
                 xerror("xvblockdb_t::save_block,fail for write_block_object_to_db,index(%s) and  block(%s)",index_ptr->dump().c_str(),block_ptr->dump().c_str());
                 return object_stored_flag;
             }
+            move_cold_blocks(index_ptr);
             
             //new version(>=1) of block may serialize seperately
             if(block_ptr->get_block_class() == base::enum_xvblock_class_nil)
@@ -313,6 +365,27 @@ namespace top
             
             return combined_stored_flags;//return flags to caller who need set xvbindex_t
         }
+    
+        void    xvblockdb_t::move_cold_blocks(base::xvbindex_t* index_ptr)
+        {
+            const uint64_t cold_height_gap = get_xdbstore()->get_cold_height_gap();
+            if(0 == cold_height_gap) //not tiered
+                return;
+            
+            //stateless trigger:each time height reach boundary of batch,move the batch that fall behind by gap
+            const uint64_t new_height = index_ptr->get_height();
+            if( (new_height % enum_cold_move_batch_heights) != 0 || (new_height < cold_height_gap + enum_cold_move_batch_heights) )
+                return;
+            
+            //[lower_bound_height,upper_bound_height)
+            const uint64_t upper_bound_height = new_height - cold_height_gap;
+            const uint64_t lower_bound_height = upper_bound_height - enum_cold_move_batch_heights;
+            const std::string begin_key = base::xvdbkey_t::create_prunable_block_height_key(*index_ptr,lower_bound_height);
+            const std::string end_key   = base::xvdbkey_t::create_prunable_block_height_key(*index_ptr,upper_bound_height);
+            flush_write_batch(); //range may cover blocks of pending batch
+            if(get_xdbstore()->move_range_to_cold(begin_key,end_key))
+                xinfo("xvblockdb_t::move_cold_blocks,queued account %s from %" PRIu64 " to %" PRIu64,index_ptr->get_address().c_str(),lower_bound_height,upper_bound_height);
+        }
 
         bool    xvblockdb_t::delete_block(base::xvbindex_t* index_ptr)
         {
@@ -355,7 +428,7 @@ namespace top
                 deleted_key_list.push_back(output_resource_key);
             }
             
-            return get_xdbstore()->delete_values(deleted_key_list);
+            return delete_values(deleted_key_list);
         }
 
         //return bool indicated whether has anything writed into db
@@ -380,21 +453,27 @@ namespace top
                 return false;
             }
                        
+            const size_t index_bin_size = index_bin.size();
             bool is_stored_db_successful = false;
             if(index_obj->check_store_flag(base::enum_index_store_flag_main_entry)) //main index for this height
             {
                 const std::string key_path = create_block_index_key(*index_obj,index_obj->get_height());
-                is_stored_db_successful = get_xdbstore()->set_value(key_path,index_bin);
+                is_stored_db_successful = write_value(key_path,std::move(index_bin));
                 xdbg("xvblockdb_t::write_index_to_db for main entry.index=%s",index_obj->dump().c_str());
             }
             else
             {
                 const std::string key_path = create_block_index_key(*index_obj,index_obj->get_height(),index_obj->get_viewid());
-                is_stored_db_successful = get_xdbstore()->set_value(key_path,index_bin);
+                is_stored_db_successful = write_value(key_path,std::move(index_bin));
                 xdbg("xvblockdb_t::write_index_to_db for other entry.index=%s",index_obj->dump().c_str());
             }
             
-            update_block_write_metrics(index_obj->get_block_level(), index_obj->get_block_class(), enum_blockstore_metrics_type_block_index, index_bin.size());
+            update_block_write_metrics(index_obj->get_block_level(), index_obj->get_block_class(), enum_blockstore_metrics_type_block_index, index_bin_size);
+            if(is_stored_db_successful && (t_pending_batch != nullptr) && (t_pending_batch->owner == this))
+            {
+                index_obj->add_ref(); //restore modified flag if batch fail to commit later
+                t_pending_batch->indexes.push_back(index_obj);
+            }
             
             if(false == is_stored_db_successful)
             {
@@ -452,17 +531,22 @@ namespace top
             #if defined(ENABLE_METRICS)
             XMETRICS_GAUGE(metrics::store_block_index_read, 1);
             #endif
-            const std::string index_bin = get_xdbstore()->get_value(index_db_key_path);
-            if(index_bin.empty())
-            {
-                xdbg("xvblockdb_t::read_index_from_db,fail to read from db for path(%s)",index_db_key_path.c_str());
-                return NULL;
-            }
-            
+            //decode straight from value pinned at DB
             base::xvbindex_t * new_index_obj = new base::xvbindex_t();
-            if(new_index_obj->serialize_from(index_bin) <= 0)
+            bool found_at_db = false;
+            auto const decoder = [new_index_obj, &found_at_db](const char* data, const size_t size) {
+                found_at_db = true;
+                base::xstream_t _stream(base::xcontext_t::instance(), (uint8_t*)data, (uint32_t)size);
+                return (new_index_obj->serialize_from(_stream) > 0);
+            };
+            std::string pending_bin;
+            const bool decoded = find_pending_value(get_xdbstore(),index_db_key_path,pending_bin) ? decoder(pending_bin.data(),pending_bin.size()) : get_xdbstore()->decode_value(index_db_key_path, decoder);
+            if(false == decoded)
             {
-                xerror("xvblockdb_t::read_index_from_db,fail to serialize from db for path(%s)",index_db_key_path.c_str());
+                if(found_at_db)
+                    xerror("xvblockdb_t::read_index_from_db,fail to serialize from db for path(%s)",index_db_key_path.c_str());
+                else
+                    xdbg("xvblockdb_t::read_index_from_db,fail to read from db for path(%s)",index_db_key_path.c_str());
                 new_index_obj->release_ref();
                 return NULL;
             }
@@ -488,9 +572,10 @@ namespace top
                 std::string blockobj_bin;
                 block_ptr->serialize_to_string(blockobj_bin);
                 const std::string blockobj_key = create_block_object_key(index_ptr);
-                if(get_xdbstore()->set_value(blockobj_key, blockobj_bin))
+                const size_t blockobj_bin_size = blockobj_bin.size();
+                if(write_value(blockobj_key, std::move(blockobj_bin)))
                 {
-                    update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_object, blockobj_bin.size());
+                    update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_object, blockobj_bin_size);
                     
                     xinfo("xvblockdb_t::write_block_object_to_db,stored DB at key(%s) for block(%s) and index_ptr(%s)",blockobj_key.c_str(),block_ptr->dump().c_str(), index_ptr->dump().c_str());
                     
@@ -527,8 +612,16 @@ namespace top
                 #endif
                 
                 const std::string blockobj_key = create_block_object_key(index_ptr);
-                const std::string blockobj_bin = from_db->get_value(blockobj_key);
-                if(blockobj_bin.empty())
+                //decode straight from value pinned at DB,avoid copying the whole block body
+                base::xvblock_t* decoded_block = NULL;
+                //header-only callers never touch input/output,so leave them as bytes until first access
+                auto const decoder = [&decoded_block](const char* data, const size_t size) {
+                    decoded_block = base::xvblock_t::create_block_object(data, size, true);
+                    return true;
+                };
+                std::string pending_bin;
+                const bool found_at_db = find_pending_value(from_db,blockobj_key,pending_bin) ? decoder(pending_bin.data(),pending_bin.size()) : from_db->decode_value(blockobj_key, decoder);
+                if(false == found_at_db)
                 {
                     if(index_ptr->check_store_flag(base::enum_index_store_flag_mini_block)) //has stored header and cert
                         xerror("xvblockdb_t::read_block_object_from_db,fail to find item at DB for key(%s)",blockobj_key.c_str());
@@ -538,7 +631,7 @@ namespace top
                     return false;
                 }
                 
-                base::xauto_ptr<base::xvblock_t> new_block_ptr(base::xvblock_t::create_block_object(blockobj_bin));
+                base::xauto_ptr<base::xvblock_t> new_block_ptr(decoded_block);
                 if(!new_block_ptr)
                 {
                     xerror("xvblockdb_t::read_block_object_from_db,bad data at DB for key(%s)",blockobj_key.c_str());
@@ -590,15 +683,16 @@ namespace top
             {
                 if(block_ptr->get_input()->get_resources_hash().empty() == false)
                 {
-                    const std::string input_res_bin = block_ptr->get_input()->get_resources_data();
+                    std::string input_res_bin = block_ptr->get_input()->get_resources_data();
                     if(input_res_bin.empty() == false)
                     {
                         update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_input_res, input_res_bin.size());
                         
                         const std::string input_res_key = create_block_input_resource_key(index_ptr);
-                        if(get_xdbstore()->set_value(input_res_key, input_res_bin))
+                        const size_t input_res_bin_size = input_res_bin.size();
+                        if(write_value(input_res_key, std::move(input_res_bin)))
                         {
-                            xdbg("xvblockdb_t::write_block_input_to_db,store input resource to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), input_res_bin.size());
+                            xdbg("xvblockdb_t::write_block_input_to_db,store input resource to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), input_res_bin_size);
                             return base::enum_index_store_flag_input_resource;
                         }
                         else
@@ -633,7 +727,7 @@ namespace top
                     //which means resource are stored at seperatedly
                     const std::string input_resource_key = create_block_input_resource_key(index_ptr);
                     
-                    const std::string input_resource_bin = from_db->get_value(input_resource_key);
+                    const std::string input_resource_bin = read_value(from_db,input_resource_key);
                     if(input_resource_bin.empty()) //that possible happen actually
                     {
                         xwarn_err("xvblockdb_t::read_block_input_from_db,fail to read resource from db for path(%s)",input_resource_key.c_str());
@@ -673,16 +767,17 @@ namespace top
                     // XTODO write output offdata with output resource
                     if (block_ptr->get_output_offdata_hash().empty() == false)
                     {
-                        const std::string output_offdata_bin = block_ptr->get_output_offdata();
+                        std::string output_offdata_bin = block_ptr->get_output_offdata();
                         if (output_offdata_bin.empty()) {
                             xerror("xvblockdb_t::write_block_output_to_db,fail output offdata empty for block(%s)",index_ptr->dump().c_str());
                             return -1; //invalid params                 
                         }
                         const std::string output_offdata_key = create_block_output_offdata_key(index_ptr);
-                        if(get_xdbstore()->set_value(output_offdata_key, output_offdata_bin))
+                        const size_t output_offdata_bin_size = output_offdata_bin.size();
+                        if(write_value(output_offdata_key, std::move(output_offdata_bin)))
                         {
-                            xdbg("xvblockdb_t::write_block_output_to_db,store output offdata to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), output_offdata_bin.size());
-                            update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_output_offdata, output_offdata_bin.size());
+                            xdbg("xvblockdb_t::write_block_output_to_db,store output offdata to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), output_offdata_bin_size);
+                            update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_output_offdata, output_offdata_bin_size);
                         }
                         else
                         {
@@ -692,15 +787,16 @@ namespace top
                     }
 
 
-                    const std::string output_res_bin = block_ptr->get_output()->get_resources_data();
+                    std::string output_res_bin = block_ptr->get_output()->get_resources_data();
                     if(output_res_bin.empty() == false)
                     {
                         const std::string output_res_key = create_block_output_resource_key(index_ptr);
-                        if(get_xdbstore()->set_value(output_res_key, output_res_bin))
+                        const size_t output_res_bin_size = output_res_bin.size();
+                        if(write_value(output_res_key, std::move(output_res_bin)))
                         {
-                            update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_output_res, output_res_bin.size());
+                            update_block_write_metrics(block_ptr->get_block_level(), block_ptr->get_block_class(), enum_blockstore_metrics_type_block_output_res, output_res_bin_size);
 
-                            xdbg("xvblockdb_t::write_block_output_to_db,store output resource to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), output_res_bin.size());
+                            xdbg("xvblockdb_t::write_block_output_to_db,store output resource to DB for block(%s),bin_size=%zu",index_ptr->dump().c_str(), output_res_bin_size);
                             return base::enum_index_store_flag_output_resource;
                         }
                         else
@@ -735,7 +831,7 @@ namespace top
                     //which means resource are stored at seperatedly
                     const std::string output_resource_key = create_block_output_resource_key(index_ptr);
                     
-                    const std::string output_resource_bin = from_db->get_value(output_resource_key);
+                    const std::string output_resource_bin = read_value(from_db,output_resource_key);
                     if(output_resource_bin.empty()) //that possible happen actually
                     {
                         xwarn_err("xvblockdb_t::read_block_output_from_db,fail to read resource from db for path(%s)",output_resource_key.c_str());
@@ -756,6 +852,72 @@ namespace top
             }
             return (block_ptr->get_output() != NULL);
         }
+        bool    xvblockdb_t::read_block_input_output_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db)
+        {
+            if(block_ptr == NULL)
+                return false;
+            
+            const bool need_input_resource  = (block_ptr->get_input() != NULL)
+                                            && (block_ptr->get_input()->get_resources_hash().empty() == false)
+                                            && (block_ptr->get_input()->has_resource_data() == false);
+            const bool need_output_resource = (block_ptr->get_output() != NULL)
+                                            && (block_ptr->get_output()->get_resources_hash().empty() == false)
+                                            && (block_ptr->get_output()->has_resource_data() == false);
+            if( (need_input_resource == false) || (need_output_resource == false) ) //nothing to batch
+            {
+                if(read_block_input_from_db(index_ptr,block_ptr,from_db) == false)
+                    return false;
+                return read_block_output_from_db(index_ptr,block_ptr,from_db);
+            }
+            
+            #if defined(ENABLE_METRICS)
+            XMETRICS_GAUGE(metrics::store_block_input_read, 1);
+            XMETRICS_GAUGE(metrics::store_block_output_read, 1);
+            #endif
+            //both resources are stored at seperatedly,fetch them by one round of DB
+            std::vector<std::string> resource_keys;
+            resource_keys.push_back(create_block_input_resource_key(index_ptr));
+            resource_keys.push_back(create_block_output_resource_key(index_ptr));
+            const std::vector<std::string> resource_bins = read_values(from_db,resource_keys);
+            if(resource_bins.size() != resource_keys.size())
+            {
+                xerror("xvblockdb_t::read_block_input_output_from_db,fail to batch read resources for block(%s)",block_ptr->dump().c_str());
+                return false;
+            }
+            
+            const std::string & input_resource_bin = resource_bins[0];
+            if(input_resource_bin.empty()) //that possible happen actually
+            {
+                xwarn_err("xvblockdb_t::read_block_input_output_from_db,fail to read resource from db for path(%s)",resource_keys[0].c_str());
+                return false;
+            }
+            if(block_ptr->get_input()->has_resource_data() == false) //double check again
+            {
+                if(block_ptr->set_input_resources(input_resource_bin) == false)
+                {
+                    xerror("xvblockdb_t::read_block_input_output_from_db,load bad input-resource for key(%s)",resource_keys[0].c_str());
+                    return false;
+                }
+            }
+            
+            const std::string & output_resource_bin = resource_bins[1];
+            if(output_resource_bin.empty()) //that possible happen actually
+            {
+                xwarn_err("xvblockdb_t::read_block_input_output_from_db,fail to read resource from db for path(%s)",resource_keys[1].c_str());
+                return false;
+            }
+            if(block_ptr->get_output()->has_resource_data() == false) //double check again
+            {
+                if(block_ptr->set_output_resources(output_resource_bin) == false)
+                {
+                    xerror("xvblockdb_t::read_block_input_output_from_db,read bad output-resource for key(%s)",resource_keys[1].c_str());
+                    return false;
+                }
+            }
+            xdbg("xvblockdb_t::read_block_input_output_from_db,read input and output resource,block(%s) ",block_ptr->dump().c_str());
+            return true;
+        }
+        
         bool    xvblockdb_t::read_block_output_offdata_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db)
         {
             if(NULL == block_ptr)
@@ -770,9 +932,14 @@ namespace top
                     XMETRICS_GAUGE(metrics::store_block_output_read, 1);
                     #endif
                     //which means resource are stored at seperatedly
-                    const std::string output_resource_key = create_block_output_offdata_key(index_ptr);
+                    std::string output_resource_key = create_block_output_offdata_key(index_ptr);
                     
-                    const std::string output_resource_bin = from_db->get_value(output_resource_key);
+                    std::string output_resource_bin = read_value(from_db,output_resource_key);
+                    if(output_resource_bin.empty()) //written before offdata moved to the state height key
+                    {
+                        output_resource_key = base::xvdbkey_t::create_prunable_block_output_offdata_key_old(*index_ptr,index_ptr->get_height(), index_ptr->get_viewid());
+                        output_resource_bin = read_value(from_db,output_resource_key);
+                    }
                     if(output_resource_bin.empty()) //that possible happen actually
                     {
                         xwarn("xvblockdb_t::read_block_output_offdata_from_db,fail to read resource from db for path(%s)",output_resource_key.c_str());
@@ -802,7 +969,7 @@ namespace top
             base::xvblock_t* main_entry_block_ptr = NULL;
             //step#1: try load committed block directly (hit most case)
             const std::string target_block_key = base::xvdbkey_t::create_prunable_block_object_key(account,target_height);
-            const std::string target_block_bin = get_xdbstore()->get_value(target_block_key);
+            const std::string target_block_bin = read_value(get_xdbstore(),target_block_key);
             if(target_block_bin.empty() == false)
             {
                 main_entry_block_ptr = base::xvblock_t::create_block_object(target_block_bin);
@@ -860,20 +1027,127 @@ namespace top
         //compatible for old version,e.g read meta and other stuff
         const std::string   xvblockdb_t::load_value_by_path(const std::string & full_path_as_key)
         {
-            return get_xdbstore()->get_value(full_path_as_key);
+            return read_value(get_xdbstore(),full_path_as_key);
         }
         bool                xvblockdb_t::delete_value_by_path(const std::string & full_path_as_key)
         {
-            return get_xdbstore()->delete_value(full_path_as_key);
+            return delete_values(std::vector<std::string>{full_path_as_key});
         }
         bool                xvblockdb_t::store_value_by_path(const std::string & full_path_as_key,const std::string & value)
         {
             if(value.empty())
                 return true;
             
-            return get_xdbstore()->set_value(full_path_as_key,value);
+            return write_value(full_path_as_key,std::string(value));
         }
     
+        bool    xvblockdb_t::begin_write_batch()
+        {
+            if(t_pending_batch != nullptr) //not support nested batch,writes go to the outer one
+                return false;
+            t_pending_batch = new xvblockdb_pending_batch_t();
+            t_pending_batch->owner = this;
+            return true;
+        }
+
+        bool    xvblockdb_t::commit_write_batch()
+        {
+            if( (nullptr == t_pending_batch) || (t_pending_batch->owner != this) )
+            {
+                xassert(false);
+                return false;
+            }
+            const bool result = flush_write_batch();
+            delete t_pending_batch;
+            t_pending_batch = nullptr;
+            return result;
+        }
+
+        bool    xvblockdb_t::flush_write_batch()
+        {
+            if( (nullptr == t_pending_batch) || (t_pending_batch->owner != this) )
+                return true;
+
+            xvblockdb_pending_batch_t & batch = *t_pending_batch;
+            bool result = true;
+            if(batch.values.empty() == false)
+            {
+                #if defined(ENABLE_METRICS)
+                XMETRICS_GAUGE(metrics::store_block_batch_write, (int64_t)batch.values.size());
+                #endif
+                result = get_xdbstore()->set_values(batch.values);
+                if(false == result)
+                {
+                    xerror("xvblockdb_t::flush_write_batch,fail to write %zu values by one batch",batch.values.size());
+                    for(auto & index_obj : batch.indexes)
+                        index_obj->set_modified_flag(); //write index again at next save
+                }
+                else
+                {
+                    xdbg("xvblockdb_t::flush_write_batch,wrote %zu values of %zu indexes",batch.values.size(),batch.indexes.size());
+                }
+                batch.values.clear();
+            }
+            for(auto & index_obj : batch.indexes)
+                index_obj->release_ref();
+            batch.indexes.clear();
+            return result;
+        }
+
+        bool    xvblockdb_t::write_value(const std::string & key,std::string && value)
+        {
+            if( (t_pending_batch != nullptr) && (t_pending_batch->owner == this) )
+            {
+                //take over serialized bytes instead of copying them again,later write of same key replace the older,e.g. index updated by commit
+                t_pending_batch->values[key] = std::move(value);
+                return true;
+            }
+            return get_xdbstore()->set_value(key,value);
+        }
+
+        bool    xvblockdb_t::delete_values(const std::vector<std::string> & keys)
+        {
+            if( (t_pending_batch != nullptr) && (t_pending_batch->owner == this) )
+            {
+                for(auto & key : keys)
+                    t_pending_batch->values.erase(key);
+            }
+            if(keys.size() == 1)
+                return get_xdbstore()->delete_value(keys[0]);
+            return get_xdbstore()->delete_values(keys);
+        }
+
+        bool    xvblockdb_t::find_pending_value(base::xvdbstore_t* from_db,const std::string & key,std::string & value) const
+        {
+            if( (nullptr == t_pending_batch) || (t_pending_batch->owner != this) || (from_db != get_xdbstore()) )
+                return false;
+            auto it = t_pending_batch->values.find(key);
+            if(it == t_pending_batch->values.end())
+                return false;
+            value = it->second;
+            return true;
+        }
+
+        const std::string   xvblockdb_t::read_value(base::xvdbstore_t* from_db,const std::string & key) const
+        {
+            std::string value;
+            if(find_pending_value(from_db,key,value))
+                return value;
+            return from_db->get_value(key);
+        }
+
+        std::vector<std::string>  xvblockdb_t::read_values(base::xvdbstore_t* from_db,const std::vector<std::string> & keys) const
+        {
+            if( (nullptr == t_pending_batch) || (t_pending_batch->owner != this) || (from_db != get_xdbstore()) )
+                return from_db->get_values(keys);
+
+            std::vector<std::string> values;
+            values.reserve(keys.size());
+            for(auto & key : keys)
+                values.push_back(read_value(from_db,key));
+            return values;
+        }
+
         const std::string  xvblockdb_t::create_block_index_key(const base::xvaccount_t & account,const uint64_t target_height)
         {
             return base::xvdbkey_t::create_prunable_block_index_key(account,target_height);
@@ -22,9 +22,14 @@ namespace top
     
         class xvblockdb_t : public base::xobject_t
         {
+            enum
+            {
+                enum_cold_move_batch_heights = 64, //move blocks to cold DB every 64 heights as batch
+            };
             friend class xunitbkplugin;
             friend class xtablebkplugin;
             friend class xrelay_plugin;
+            friend class xvblockdb_batch_t;
         public:
             xvblockdb_t(base::xvdbstore_t* xvdb_ptr);
         public:
@@ -45,6 +50,8 @@ namespace top
             
             bool                load_block_output(base::xvbindex_t* target_index);
             bool                load_block_output(base::xvbindex_t* target_index,base::xvblock_t * target_block);
+            //load input and output together,resources of both are fetched from DB by one batch read
+            bool                load_block_input_output(base::xvbindex_t* target_index);
             bool                load_block_output_offdata(base::xvbindex_t* target_index,base::xvblock_t * target_block);
             
             bool                load_block_object(base::xvbindex_t* index_ptr, const int atag = 0);
@@ -73,11 +80,14 @@ namespace top
             int                 write_block_object_to_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr);
             int                 write_block_input_to_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr);
             int                 write_block_output_to_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr);
+            //tiered storage:move blocks that fall behind new block by cold height gap to cold DB
+            void                move_cold_blocks(base::xvbindex_t* index_ptr);
         protected:
             bool                read_block_object_from_db(base::xvbindex_t* index_ptr);
             bool                read_block_object_from_db(base::xvbindex_t* index_ptr,base::xvdbstore_t* from_db);
             bool                read_block_input_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db);
             bool                read_block_output_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db);
+            bool                read_block_input_output_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db);
             bool                read_block_output_offdata_from_db(base::xvbindex_t* index_ptr,base::xvblock_t * block_ptr,base::xvdbstore_t* from_db);
 
             std::vector<base::xvblock_t*>  read_prunable_block_object_from_db(base::xvaccount_t & account,const uint64_t target_height);
@@ -95,10 +105,36 @@ namespace top
             const std::string   create_block_output_resource_key(base::xvbindex_t * index_ptr);
             const std::string   create_block_output_offdata_key(base::xvbindex_t * index_ptr);
             
+        private://writes of batch are pending at current thread until commit,reads of same thread see them first
+            bool                begin_write_batch();
+            bool                commit_write_batch();
+            bool                flush_write_batch();
+            bool                write_value(const std::string & key,std::string && value); //value is moved away
+            bool                delete_values(const std::vector<std::string> & keys);
+            bool                find_pending_value(base::xvdbstore_t* from_db,const std::string & key,std::string & value) const;
+            const std::string   read_value(base::xvdbstore_t* from_db,const std::string & key) const;
+            std::vector<std::string> read_values(base::xvdbstore_t* from_db,const std::vector<std::string> & keys) const;
         private:
              base::xvdbstore_t*  m_xvdb_ptr;
              int                 m_blockstore_version;
         };
+
+        //write all keys of blocks stored at current thread by one DB batch,e.g. blocks of one sync response
+        //the batch is committed by commit() or at destruction,a nested batch just joins the outer one
+        class xvblockdb_batch_t
+        {
+        public:
+            xvblockdb_batch_t(xvblockdb_t * blockdb_ptr);
+            ~xvblockdb_batch_t();
+        private:
+            xvblockdb_batch_t();
+            xvblockdb_batch_t(const xvblockdb_batch_t &);
+            xvblockdb_batch_t & operator = (const xvblockdb_batch_t &);
+        public:
+            bool                commit();
+        private:
+            xvblockdb_t*        m_blockdb_ptr; //null when not own the batch
+        };
  
     };//end of namespace of vstore
 };//end of namespace of top
@@ -3,6 +3,7 @@
 // Licensed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <cinttypes>
 #include "xbase/xutl.h"
 #include "xbase/xcontext.h"
@@ -233,6 +234,7 @@ namespace top
 
                 //then clean all blocks at memory
                 close_blocks();
+                report_cached_size();
 
                 //TODO, retore following assert check after full_block enable
                 xassert(m_meta->_highest_connect_block_height <= m_meta->_highest_commit_block_height);
@@ -249,14 +251,19 @@ namespace top
 
         const int  xblockacct_t::get_max_cache_size() const
         {
+            int max_cache_size = enum_max_cached_blocks;
             //note: place code first but  please enable it later
             if(base::enum_xvblock_level_table == m_meta->_block_level)
-                return (enum_max_cached_blocks << 1);//cache to max 128 block
+                max_cache_size = (enum_max_cached_blocks << 1);//cache to max 64 block
+            else if(base::enum_xvblock_level_unit == m_meta->_block_level)
+                max_cache_size = (enum_max_cached_blocks >> 2);//cache to max 8 block for unit
 
-            if(base::enum_xvblock_level_unit == m_meta->_block_level)
-                return (enum_max_cached_blocks >> 2);//cache to max 8 block for unit
+            //cold account gives up most of its cache once all accounts together are over budget
+            const xblockcache_budget_t & budget = xblockcache_budget_t::instance();
+            if(budget.is_over_budget() && !budget.is_hot(m_access_frequency,m_access_epoch))
+                return std::max(1,max_cache_size >> 2);
 
-            return enum_max_cached_blocks;
+            return max_cache_size;
         }
     
         const int  xblockacct_t::get_cached_size() const
@@ -267,7 +274,21 @@ namespace top
         //clean unsed caches of account to recall memory
         bool xblockacct_t::clean_caches(bool clean_all,bool force_release_unused_block)
         {
-            return clean_blocks(clean_all ? 0 : get_max_cache_size(),force_release_unused_block);//try all possible clean_caches
+            const bool result = clean_blocks(clean_all ? 0 : get_max_cache_size(),force_release_unused_block);//try all possible clean_caches
+            report_cached_size();
+            return result;
+        }
+
+        void xblockacct_t::touch_cache()
+        {
+            xblockcache_budget_t::instance().touch(m_access_frequency,m_access_epoch);
+        }
+
+        void xblockacct_t::report_cached_size()
+        {
+            const int64_t cached_size = (int64_t)m_all_blocks.size();
+            xblockcache_budget_t::instance().update_cached_blocks(cached_size - m_reported_cached_size);
+            m_reported_cached_size = cached_size;
         }
 
         bool xblockacct_t::clean_blocks(const int keep_blocks_count,bool force_release_unused_block)
@@ -322,6 +343,10 @@ namespace top
                                 raw_block->reset_next_block(NULL);
                             }
                             xdbg_info("xblockacct_t::clean_caches,blockptr=%llx,index=%s",it->second,it->second->dump().c_str());
+
+                            //table has deep history, keep saved committed index as flat record for next query
+                            if( (1 == view_map.size()) && (get_block_level() == base::enum_xvblock_level_table) )
+                                m_evicted_indexes.put(it->second);
                             
                             it->second->close();//disconnect from prev-block and next-block
                             it->second->release_ref();
@@ -449,6 +474,7 @@ namespace top
 
                 m_all_blocks.clear();
             }
+            m_evicted_indexes.clear();
         }
 
         //one api to get latest_commit/latest_lock/latest_cert for better performance
@@ -984,7 +1010,7 @@ namespace top
             auto it = m_all_blocks.find(target_height);
             if(it == m_all_blocks.end())//load all at certain height
             {
-                std::vector<base::xvbindex_t*> _indexes(read_index(target_height));
+                std::vector<base::xvbindex_t*> _indexes(read_evicted_index(target_height));
                 if(_indexes.empty() == false) //found index at db
                 {
                     for(auto it = _indexes.begin(); it != _indexes.end(); ++it)
@@ -1022,13 +1048,28 @@ namespace top
             return (int)it->second.size(); //found existing ones
         }
 
+        std::vector<base::xvbindex_t*>  xblockacct_t::read_evicted_index(const uint64_t target_height)
+        {
+            const uint64_t delete_height = get_latest_deleted_block_height();
+            if( (target_height > delete_height) || (0 == delete_height) ) //pruned height always go to DB
+            {
+                base::xvbindex_t * evicted_index = m_evicted_indexes.take(*get_account_obj(),target_height);
+                if(evicted_index != nullptr)
+                {
+                    XMETRICS_GAUGE(metrics::blockstore_index_ring_hit, 1);
+                    return std::vector<base::xvbindex_t*>{evicted_index};
+                }
+            }
+            return read_index(target_height);
+        }
+
         size_t   xblockacct_t::load_index_by_height(const uint64_t target_height)
         {
             auto it = m_all_blocks.find(target_height);
             if(it == m_all_blocks.end())//load all at certain height
             {
                 XMETRICS_GAUGE(metrics::blockstore_index_load, 0);
-                std::vector<base::xvbindex_t*> _indexes(read_index(target_height));
+                std::vector<base::xvbindex_t*> _indexes(read_evicted_index(target_height));
                 if(_indexes.empty() == false) //found index at db
                 {
                     for(auto it = _indexes.begin(); it != _indexes.end(); ++it)
@@ -1355,6 +1396,7 @@ namespace top
                 return false;
 
             XMETRICS_GAUGE(metrics::store_block_delete, 1);
+            m_evicted_indexes.erase(block_ptr->get_height());
 
             xkinfo("xblockacct_t::delete_block,delete block:[chainid:%u->account(%s)->height(%" PRIu64 ")->viewid(%" PRIu64 ")",block_ptr->get_chainid(),block_ptr->get_account().c_str(),block_ptr->get_height(),block_ptr->get_viewid());
 
@@ -1394,6 +1436,7 @@ namespace top
                 return false; //not allow delete genesis block
 
             xkinfo("xblockacct_t::delete_block,delete block:[chainid:%u->account(%s)->height(%" PRIu64 ")",get_account_obj()-> get_chainid(),get_account().c_str(),height);
+            m_evicted_indexes.erase(height);
 
             //allow delete outdated blocks
             if(false == m_all_blocks.empty())
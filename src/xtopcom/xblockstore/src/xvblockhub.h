@@ -9,6 +9,8 @@
 #include <map>
 #include "xvblockdb.h"
 #include "xbkstoreutl.h"
+#include "xvblockcache.h"
+#include "xvindexring.h"
 
 namespace top
 {
@@ -66,6 +68,8 @@ namespace top
             const int              get_max_cache_size() const;
             const int              get_cached_size() const;
             bool                   clean_caches(bool clean_all,bool force_release_unused_block); //clean unsed caches of account to recall memory
+            void                   touch_cache();           //record one access for node-wide cache budget
+            void                   report_cached_size();    //report change of cached heights to node-wide cache budget
             
             //inline const std::string&   get_address() const {return m_account_ptr->get_address();}
             //inline const std::string&   get_account() const {return m_account_ptr->get_account();}
@@ -148,12 +152,18 @@ namespace top
             bool                clean_blocks(const int keep_blocks_count,bool force_release_unused_block);
             bool                on_block_revoked(base::xvbindex_t* index_ptr);
             bool                on_block_committed(base::xvbindex_t* index_ptr);
+            std::vector<base::xvbindex_t*> read_evicted_index(const uint64_t target_height); //ring first then DB
 
         protected:
             base::xblockmeta_t * m_meta;
             xvblockdb_t*         m_blockdb_ptr;
             std::deque<xblockevent_t> m_events_queue;  //stored event
             std::map<uint64_t,std::map<uint64_t,base::xvbindex_t*> > m_all_blocks;  // < height#, <view#,block*> > sort from lower to higher
+        private:
+            uint32_t             m_access_frequency{0};  //decayed access count, see xblockcache_budget_t
+            uint32_t             m_access_epoch{0};
+            int64_t              m_reported_cached_size{0}; //cached heights reported to xblockcache_budget_t
+            xvindex_ring_t       m_evicted_indexes;         //committed indexes recently evicted from m_all_blocks
         };
 
         //xchainacct_t transfer block status from lower stage to higher : from cert ->lock->commit
@@ -4,6 +4,8 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <cinttypes>
+#include <algorithm>
+#include <chrono>
 #include "xmetrics/xmetrics.h"
 #include "xvblockpruner.h"
 #include "xdata/xnative_contract_address.h"
@@ -47,10 +49,13 @@ namespace top
                 addr = std::string(sys_contract_sharding_statistic_info_addr) + "@" + std::to_string(index);
                 m_prune_contract[addr] = enum_prune_fullunit;
             }
+
+            m_prune_thread.reset(new std::thread(&xvblockprune_impl::prune_loop, this));
         }
 
         xvblockprune_impl::~xvblockprune_impl()
         {
+            stop_prune_thread();
             xwarn("~xvblockprune_impl");
         }
     
@@ -74,7 +79,17 @@ namespace top
         }
     
         bool  xvblockprune_impl::recycle(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)//recylce any qualified blocks under account
-        {           
+        {
+            bool meta_updated = false;
+            if(false == check_prune_job(account_obj,account_meta,meta_updated))
+                return false; //wait for pending range deleted
+
+            const bool result = recycle_account(account_obj,account_meta);
+            return (result || meta_updated);
+        }
+
+        bool  xvblockprune_impl::recycle_account(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)
+        {
             if(account_obj.is_unit_address()) {
                 auto zone_id = account_obj.get_zone_index();
                 // if consensus zone
@@ -127,19 +142,9 @@ namespace top
             xdbg("xvblockprune_impl::recycle contract %s, adjust upper %llu, lower %llu, connect_height %llu", account_obj.get_address().c_str(),
                 upper_bound_height, lower_bound_height, account_meta._highest_cert_block_height);
 
-            const std::string begin_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_bound_height);
-            const std::string end_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_bound_height);
             XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_block_contract, upper_bound_height-lower_bound_height+1);
-            if(get_xvdb()->delete_range(begin_delete_key, end_delete_key))//["begin_key", "end_key")
-            {
-                xinfo("xvblockprune_impl::recycle contract,succsssful for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-                account_meta._highest_deleted_block_height = upper_bound_height - 1;
-            }
-            else
-            {
-                xerror("xvblockprune_impl::recycle contract,failed for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-            }
-            return true;
+            queue_prune(account_obj,lower_bound_height,upper_bound_height);
+            return false; //account meta is updated by later recycle once range is deleted
         }
         
         bool  xvblockprune_impl::recycle_table(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)
@@ -171,20 +176,9 @@ namespace top
             } else if((upper_bound_height - lower_bound_height) <= reserve_num)
                 return false;//collect big range for each prune op as performance consideration
             upper_bound_height = upper_bound_height - reserve_num; //(enum_min_batch_recycle_blocks_count << 1);
-            const std::string begin_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_bound_height);
-            const std::string end_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_bound_height);
             XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_block_table, upper_bound_height-lower_bound_height+1);
-            if(get_xvdb()->delete_range(begin_delete_key, end_delete_key))//["begin_key", "end_key")
-            {
-                xinfo("xvblockprune_impl::recycle table,succsssful for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-
-                account_meta._highest_deleted_block_height = upper_bound_height - 1;
-            }
-            else
-            {
-                xerror("xvblockprune_impl::recycle table,failed for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-            }
-            return true;
+            queue_prune(account_obj,lower_bound_height,upper_bound_height);
+            return false; //account meta is updated by later recycle once range is deleted
         }
 
         bool  xvblockprune_impl::recycle_timer(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)
@@ -206,19 +200,9 @@ namespace top
             xdbg("xvblockprune_impl::recycle timer %s, adjust upper %llu, lower %llu, connect_height %llu", account_obj.get_address().c_str(),
                 upper_bound_height, lower_bound_height, account_meta._highest_cert_block_height);
 
-            const std::string begin_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_bound_height);
-            const std::string end_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_bound_height);
             XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_block_timer, upper_bound_height-lower_bound_height+1);
-            if(get_xvdb()->delete_range(begin_delete_key, end_delete_key))//["begin_key", "end_key")
-            {
-                xinfo("xvblockprune_impl::recycle,succsssful for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-                account_meta._highest_deleted_block_height = upper_bound_height - 1;
-            }
-            else
-            {
-                xerror("xvblockprune_impl::recycle,failed for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-            }
-            return true;
+            queue_prune(account_obj,lower_bound_height,upper_bound_height);
+            return false; //account meta is updated by later recycle once range is deleted
         }
 
         bool  xvblockprune_impl::recycle_drand(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)
@@ -248,19 +232,9 @@ namespace top
             xdbg("xvblockprune_impl::recycle drand %s, adjust upper %llu, lower %llu, connect_height %llu", account_obj.get_address().c_str(),
                 upper_bound_height, lower_bound_height, account_meta._highest_commit_block_height);
 
-            const std::string begin_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_bound_height);
-            const std::string end_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_bound_height);
             XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_block_drand, upper_bound_height-lower_bound_height+1);
-            if(get_xvdb()->delete_range(begin_delete_key, end_delete_key))//["begin_key", "end_key")
-            {
-                xinfo("xvblockprune_impl::recycle,succsssful for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-                account_meta._highest_deleted_block_height = upper_bound_height - 1;
-            }
-            else
-            {
-                xerror("xvblockprune_impl::recycle,failed for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-            }
-            return true;
+            queue_prune(account_obj,lower_bound_height,upper_bound_height);
+            return false; //account meta is updated by later recycle once range is deleted
         }
     
         bool  xvblockprune_impl::recycle_unit(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta)
@@ -284,20 +258,9 @@ namespace top
             
             upper_bound_height = upper_bound_height - enum_min_batch_recycle_blocks_count;
 
-            const std::string begin_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_bound_height);
-            const std::string end_delete_key = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_bound_height);
             XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_block_unit, upper_bound_height-lower_bound_height+1);
-            if(get_xvdb()->delete_range(begin_delete_key, end_delete_key))//["begin_key", "end_key")
-            {
-                xinfo("xvblockprune_impl::recycle,succsssful for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);   
-                account_meta._highest_deleted_block_height = upper_bound_height - 1;
-            }
-            else
-            {
-                xerror("xvblockprune_impl::recycle,failed for account %s from %llu to %llu", account_obj.get_address().c_str(), lower_bound_height, upper_bound_height);
-            }
-
-            return true;
+            queue_prune(account_obj,lower_bound_height,upper_bound_height);
+            return false; //account meta is updated by later recycle once range is deleted
         }
 
         bool  xvblockprune_impl::refresh(const chainbase::enum_xmodule_type mod_id, const base::xvaccount_t & account_obj, const uint64_t permit_prune_upper_boundary) {
@@ -405,5 +368,143 @@ namespace top
             height = min_prune_boundary;
             return true;
         }
+
+        bool  xvblockprune_impl::queue_prune(const base::xvaccount_t & account_obj,const uint64_t lower_height,const uint64_t upper_height)
+        {
+            xprune_job_t job;
+            job.account      = account_obj.get_account();
+            job.begin_key    = base::xvdbkey_t::create_prunable_block_height_key(account_obj,lower_height);
+            job.end_key      = base::xvdbkey_t::create_prunable_block_height_key(account_obj,upper_height);
+            job.lower_height = lower_height;
+            job.upper_height = upper_height;
+
+            std::lock_guard<std::mutex> guard(m_prune_lock);
+            if(m_prune_stop || (m_prune_thread == nullptr))
+                return false;
+            if(m_prune_queue.size() >= enum_max_queued_prune_jobs) //same range is found again at next recycle
+            {
+                xwarn("xvblockprune_impl::queue_prune,queue full(%zu),account %s from %llu to %llu",m_prune_queue.size(),account_obj.get_address().c_str(),lower_height,upper_height);
+                return false;
+            }
+
+            xprune_job_state_t & state = m_prune_jobs[job.account];
+            state.status = enum_prune_job_pending;
+            state.deleted_height = upper_height - 1;
+            m_backlog_blocks += (upper_height - lower_height);
+            XMETRICS_GAUGE_SET_VALUE(metrics::prune_block_backlog, m_backlog_blocks);
+
+            m_prune_queue.emplace_back(std::move(job));
+            m_prune_cond.notify_one();
+            return true;
+        }
+
+        bool  xvblockprune_impl::check_prune_job(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta,bool & meta_updated)
+        {
+            std::lock_guard<std::mutex> guard(m_prune_lock);
+            auto it = m_prune_jobs.find(account_obj.get_account());
+            if(it == m_prune_jobs.end())
+                return true;
+
+            if(it->second.status == enum_prune_job_pending)
+                return false;
+
+            if( (it->second.status == enum_prune_job_done) && (it->second.deleted_height > account_meta._highest_deleted_block_height) )
+            {
+                account_meta._highest_deleted_block_height = it->second.deleted_height;
+                meta_updated = true;
+            }
+            m_prune_jobs.erase(it); //failed range is found and queued again
+            return true;
+        }
+
+        void  xvblockprune_impl::prune_loop()
+        {
+            std::unique_lock<std::mutex> lock(m_prune_lock);
+            for (;;) {
+                m_prune_cond.wait(lock, [this] { return m_prune_stop || !m_prune_queue.empty(); });
+                if (m_prune_stop) //queued ranges are found again after restart
+                    break;
+
+                //budget is read each round,so it may be tuned without restart
+                const uint32_t max_ops = std::max<uint32_t>(1, XGET_CONFIG(prune_ops_per_second));
+                const uint64_t max_blocks = std::max<uint64_t>(1, XGET_CONFIG(prune_blocks_per_second));
+
+                std::vector<xprune_job_t> jobs;
+                uint64_t blocks = 0;
+                while (!m_prune_queue.empty() && (jobs.size() < max_ops) && (jobs.size() < enum_max_ranges_per_batch)) {
+                    const uint64_t job_blocks = m_prune_queue.front().upper_height - m_prune_queue.front().lower_height;
+                    if (!jobs.empty() && (blocks + job_blocks > max_blocks))
+                        break;
+                    blocks += job_blocks;
+                    jobs.emplace_back(std::move(m_prune_queue.front()));
+                    m_prune_queue.pop_front();
+                }
+                lock.unlock();
+
+                const uint32_t ops = execute_prune_jobs(jobs);
+
+                lock.lock();
+                for (auto & job : jobs) {
+                    m_backlog_blocks -= std::min(m_backlog_blocks, job.upper_height - job.lower_height);
+                }
+                XMETRICS_GAUGE_SET_VALUE(metrics::prune_block_backlog, m_backlog_blocks);
+
+                //pace next round to keep both ops and blocks under budget of each second
+                const uint64_t wait_ms = std::max<uint64_t>((uint64_t)ops * 1000 / max_ops, blocks * 1000 / max_blocks);
+                if (wait_ms > 0)
+                    m_prune_cond.wait_for(lock, std::chrono::milliseconds(wait_ms), [this] { return m_prune_stop; });
+            }
+        }
+
+        uint32_t  xvblockprune_impl::execute_prune_jobs(const std::vector<xprune_job_t> & jobs)
+        {
+            std::vector<std::pair<std::string,std::string>> ranges;
+            ranges.reserve(jobs.size());
+            for(auto & job : jobs)
+                ranges.emplace_back(job.begin_key,job.end_key);
+
+            uint32_t ops = (uint32_t)jobs.size();
+            const bool result = get_xvdb()->delete_ranges(ranges);//["begin_key", "end_key")
+            uint64_t reclaimed_blocks = 0;
+            for(auto & job : jobs)
+            {
+                if(false == result)
+                {
+                    xerror("xvblockprune_impl::execute_prune_jobs,failed for account %s from %llu to %llu", job.account.c_str(), job.lower_height, job.upper_height);
+                    continue;
+                }
+                xinfo("xvblockprune_impl::execute_prune_jobs,succsssful for account %s from %llu to %llu", job.account.c_str(), job.lower_height, job.upper_height);
+                reclaimed_blocks += (job.upper_height - job.lower_height);
+                if((job.upper_height - job.lower_height) >= enum_min_compact_blocks_count) //drop tombstones of big range early
+                {
+                    get_xvdb()->compact_range(job.begin_key,job.end_key);
+                    ops++;
+                }
+            }
+            XMETRICS_GAUGE(metrics::prune_block_reclaimed, reclaimed_blocks);
+
+            std::lock_guard<std::mutex> guard(m_prune_lock);
+            for(auto & job : jobs)
+            {
+                auto it = m_prune_jobs.find(job.account);
+                if( (it == m_prune_jobs.end()) || (it->second.deleted_height != job.upper_height - 1) )
+                    continue;
+                it->second.status = result ? enum_prune_job_done : enum_prune_job_failed;
+            }
+            return ops;
+        }
+
+        void  xvblockprune_impl::stop_prune_thread()
+        {
+            std::unique_ptr<std::thread> prune_thread;
+            {
+                std::lock_guard<std::mutex> guard(m_prune_lock);
+                m_prune_stop = true;
+                prune_thread = std::move(m_prune_thread);
+                m_prune_cond.notify_one();
+            }
+            if (prune_thread != nullptr && prune_thread->joinable())
+                prune_thread->join();
+        }
     }
 }
@@ -9,6 +9,12 @@
 #include "xvledger/xvbindex.h"
 #include "xvledger/xvledger.h"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 namespace top
 {
     namespace store
@@ -20,6 +26,27 @@ namespace top
             {
                enum_reserved_blocks_count           = 8,  //reserved blocks even it is qualified to recycel
                enum_min_batch_recycle_blocks_count  = 64, //min blocks to recyce each time
+               enum_max_queued_prune_jobs           = 4096, //stop queue new range when background pruner falls behind
+               enum_max_ranges_per_batch            = 64, //ranges of many accounts deleted by one DB write
+               enum_min_compact_blocks_count        = 4096, //compact deleted range when it is big enough
+            };
+            enum prune_job_status {
+                enum_prune_job_pending,
+                enum_prune_job_done,
+                enum_prune_job_failed,
+            };
+            struct xprune_job_t
+            {
+                std::string  account;
+                std::string  begin_key;
+                std::string  end_key;
+                uint64_t     lower_height;
+                uint64_t     upper_height;   //[lower_height,upper_height)
+            };
+            struct xprune_job_state_t
+            {
+                prune_job_status  status;
+                uint64_t          deleted_height;
             };
             enum prune_type {
                 enum_prune_none,
@@ -57,11 +84,29 @@ namespace top
             bool  recycle_drand(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta);
         private:
             bool get_prune_boundary(const base::xvaccount_t & account_obj, uint64_t &height);
+            bool recycle_account(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta);
+
+            //deletion runs at background pruner,account meta is updated by next recycle after range is deleted
+            bool queue_prune(const base::xvaccount_t & account_obj,const uint64_t lower_height,const uint64_t upper_height);
+            //return false if prune of account is still pending,apply deleted height of finished one to account_meta
+            bool check_prune_job(const base::xvaccount_t & account_obj,base::xblockmeta_t & account_meta,bool & meta_updated);
+            void prune_loop();
+            void stop_prune_thread();
+            uint32_t execute_prune_jobs(const std::vector<xprune_job_t> & jobs);  //return ops consumed
         private:
             base::xvdbstore_t *  m_xvdb_ptr{NULL};
             std::map<std::string, std::map<chainbase::enum_xmodule_type, uint64_t>> m_prune_boundary;
             std::mutex m_lock;
             std::map<std::string, prune_type> m_prune_contract;
+
+            //background pruner
+            std::mutex                  m_prune_lock;
+            std::condition_variable     m_prune_cond;
+            std::deque<xprune_job_t>    m_prune_queue;
+            std::map<std::string, xprune_job_state_t> m_prune_jobs;
+            uint64_t                    m_backlog_blocks{0};
+            bool                        m_prune_stop{false};
+            std::unique_ptr<std::thread> m_prune_thread;
         };
     
     }
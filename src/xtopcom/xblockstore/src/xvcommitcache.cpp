@@ -0,0 +1,106 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvcommitcache.h"
+
+namespace top
+{
+    namespace store
+    {
+        xcommitted_block_cache_t::~xcommitted_block_cache_t()
+        {
+            for(auto & stripe : m_stripes)
+            {
+                for(auto & entry : stripe.blocks)
+                    entry.second->release_ref();
+                stripe.blocks.clear();
+            }
+        }
+
+        xcommitted_block_cache_t::xstripe_t &  xcommitted_block_cache_t::get_stripe(const std::string & address)
+        {
+            return m_stripes[std::hash<std::string>()(address) % enum_stripes_count];
+        }
+
+        void  xcommitted_block_cache_t::on_committed(base::xvbindex_t * index_ptr)
+        {
+            if(nullptr == index_ptr)
+                return;
+
+            base::xvblock_t * new_block = index_ptr->get_this_block();
+            xstripe_t & stripe = get_stripe(index_ptr->get_account());
+            base::xvblock_t * old_block = nullptr;
+            {
+                std::lock_guard<std::mutex> locker(stripe.lock);
+                auto it = stripe.blocks.find(index_ptr->get_account());
+                if(it != stripe.blocks.end())
+                {
+                    if(it->second->get_height() >= index_ptr->get_height()) //outdated event
+                        return;
+
+                    old_block = it->second;
+                    if(new_block != nullptr)
+                    {
+                        new_block->add_ref();
+                        it->second = new_block;
+                    }
+                    else //block not loaded, drop the older one instead of serving it as latest
+                    {
+                        stripe.blocks.erase(it);
+                    }
+                }
+                else if(new_block != nullptr)
+                {
+                    if(stripe.blocks.size() >= enum_max_accounts_per_stripe) //full, give up any one
+                    {
+                        auto victim = stripe.blocks.begin();
+                        old_block = victim->second;
+                        stripe.blocks.erase(victim);
+                    }
+                    new_block->add_ref();
+                    stripe.blocks.emplace(index_ptr->get_account(),new_block);
+                }
+            }
+            if(old_block != nullptr) //release out of lock
+                old_block->release_ref();
+        }
+
+        void  xcommitted_block_cache_t::remove(const std::string & address)
+        {
+            xstripe_t & stripe = get_stripe(address);
+            base::xvblock_t * old_block = nullptr;
+            {
+                std::lock_guard<std::mutex> locker(stripe.lock);
+                auto it = stripe.blocks.find(address);
+                if(it == stripe.blocks.end())
+                    return;
+                old_block = it->second;
+                stripe.blocks.erase(it);
+            }
+            old_block->release_ref();
+        }
+
+        base::xvblock_t*  xcommitted_block_cache_t::get_latest_committed(const std::string & address)
+        {
+            xstripe_t & stripe = get_stripe(address);
+            std::lock_guard<std::mutex> locker(stripe.lock);
+            auto it = stripe.blocks.find(address);
+            if(it == stripe.blocks.end())
+                return nullptr;
+            it->second->add_ref();
+            return it->second;
+        }
+
+        base::xvblock_t*  xcommitted_block_cache_t::get_committed(const std::string & address,const uint64_t height)
+        {
+            xstripe_t & stripe = get_stripe(address);
+            std::lock_guard<std::mutex> locker(stripe.lock);
+            auto it = stripe.blocks.find(address);
+            if( (it == stripe.blocks.end()) || (it->second->get_height() != height) )
+                return nullptr;
+            it->second->add_ref();
+            return it->second;
+        }
+    };//end of namespace of store
+};//end of namespace of top
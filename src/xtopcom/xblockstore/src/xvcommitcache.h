@@ -0,0 +1,54 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "xvledger/xvblock.h"
+#include "xvledger/xvbindex.h"
+
+namespace top
+{
+    namespace store
+    {
+        //latest committed block of accounts, published by writer under lock of table and read without that lock.
+        //committed block never changes again, so reader only needs a consistent pointer: each stripe guards its map
+        //by own mutex which is held just for a lookup or a swap, never across db or consensus work of writer.
+        //reader falls back to normal path when account is not cached, so entries may be dropped at any time.
+        class xcommitted_block_cache_t
+        {
+            enum
+            {
+                enum_stripes_count              = 64,
+                enum_max_accounts_per_stripe    = 1024,
+            };
+        public:
+            xcommitted_block_cache_t() = default;
+            ~xcommitted_block_cache_t();
+        private:
+            xcommitted_block_cache_t(const xcommitted_block_cache_t &) = delete;
+            xcommitted_block_cache_t & operator = (const xcommitted_block_cache_t &) = delete;
+        public:
+            //writer side, called with new committed index of account
+            void                    on_committed(base::xvbindex_t * index_ptr);
+            void                    remove(const std::string & address);
+
+            //reader side, return block with added reference or nullptr
+            base::xvblock_t*        get_latest_committed(const std::string & address);
+            base::xvblock_t*        get_committed(const std::string & address,const uint64_t height);
+        private:
+            struct xstripe_t
+            {
+                std::mutex                                        lock;
+                std::unordered_map<std::string,base::xvblock_t*>  blocks;
+            };
+            xstripe_t &             get_stripe(const std::string & address);
+        private:
+            std::array<xstripe_t,enum_stripes_count>  m_stripes;
+        };
+    };//end of namespace of store
+};//end of namespace of top
@@ -0,0 +1,85 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cinttypes>
+#include "xvindexring.h"
+#include "xbase/xcontext.h"
+
+namespace top
+{
+    namespace store
+    {
+        xvindex_ring_t::xvindex_ring_t(const uint32_t capacity)
+        {
+            m_capacity = (capacity > 0) ? capacity : 1;
+            m_count    = 0;
+        }
+
+        bool  xvindex_ring_t::put(base::xvbindex_t * index_ptr)
+        {
+            if( (nullptr == index_ptr) || index_ptr->check_modified_flag() ) //must be same as DB
+                return false;
+            if(false == index_ptr->check_block_flag(base::enum_xvblock_flag_committed))
+                return false;
+
+            if(m_slots.empty())
+                m_slots.resize(m_capacity);
+
+            xslot_t & slot = m_slots[index_ptr->get_height() % m_capacity];
+            std::string index_bin;
+            if(index_ptr->serialize_to(index_bin) <= 0)
+                return false;
+
+            if(slot.index_bin.empty())
+                ++m_count;
+            slot.height = index_ptr->get_height();
+            slot.index_bin.swap(index_bin);
+            return true;
+        }
+
+        base::xvbindex_t*  xvindex_ring_t::take(const base::xvaccount_t & account,const uint64_t height)
+        {
+            if(m_slots.empty())
+                return nullptr;
+
+            xslot_t & slot = m_slots[height % m_capacity];
+            if(slot.index_bin.empty() || (slot.height != height))
+                return nullptr;
+
+            base::xvbindex_t * new_index_obj = new base::xvbindex_t();
+            base::xstream_t _stream(base::xcontext_t::instance(), (uint8_t*)slot.index_bin.data(), (uint32_t)slot.index_bin.size());
+            const bool decoded = (new_index_obj->serialize_from(_stream) > 0);
+            //index goes back to cache of account,so slot is free now
+            slot.index_bin.clear();
+            --m_count;
+            if(false == decoded)
+            {
+                xerror("xvindex_ring_t::take,fail to serialize from ring for account(%s) at height(%" PRIu64 ")",account.get_address().c_str(),height);
+                new_index_obj->release_ref();
+                return nullptr;
+            }
+            new_index_obj->reset_account_addr(account); //rebind address same as read from DB
+            return new_index_obj;
+        }
+
+        void  xvindex_ring_t::erase(const uint64_t height)
+        {
+            if(m_slots.empty())
+                return;
+
+            xslot_t & slot = m_slots[height % m_capacity];
+            if( (slot.index_bin.empty() == false) && (slot.height == height) )
+            {
+                std::string().swap(slot.index_bin);
+                --m_count;
+            }
+        }
+
+        void  xvindex_ring_t::clear()
+        {
+            std::vector<xslot_t>().swap(m_slots);
+            m_count = 0;
+        }
+    };//end of namespace of store
+};//end of namespace of top
@@ -0,0 +1,50 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "xvledger/xvbindex.h"
+
+namespace top
+{
+    namespace store
+    {
+        //committed indexes evicted from cache of account, kept as serialized records at contiguous slots by height.
+        //deep history queries of table re-create xvbindex_t from the slot instead of reading it from DB again,
+        //and an evicted height costs one flat record instead of a full object linked into the map of cache.
+        //not thread safe,protected by lock of table same as xblockacct_t
+        class xvindex_ring_t
+        {
+        public:
+            enum
+            {
+                enum_default_ring_capacity = 256,
+            };
+        public:
+            xvindex_ring_t(const uint32_t capacity = enum_default_ring_capacity);
+            ~xvindex_ring_t() = default;
+        private:
+            xvindex_ring_t(const xvindex_ring_t &) = delete;
+            xvindex_ring_t & operator = (const xvindex_ring_t &) = delete;
+        public:
+            bool                put(base::xvbindex_t * index_ptr);     //record a committed and saved index
+            base::xvbindex_t*   take(const base::xvaccount_t & account,const uint64_t height);//caller release the created index
+            void                erase(const uint64_t height);
+            void                clear();
+            size_t              size() const {return m_count;}
+        private:
+            struct xslot_t
+            {
+                uint64_t        height;
+                std::string     index_bin;  //empty for unused slot
+            };
+            std::vector<xslot_t>    m_slots;    //allocated at first put
+            uint32_t                m_capacity;
+            size_t                  m_count;
+        };
+    };//end of namespace of store
+};//end of namespace of top
@@ -0,0 +1,64 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvprefetch.h"
+
+namespace top
+{
+    namespace store
+    {
+        xsequential_read_detector_t::xstripe_t &  xsequential_read_detector_t::get_stripe(const std::string & address)
+        {
+            return m_stripes[std::hash<std::string>()(address) % enum_stripes_count];
+        }
+
+        bool  xsequential_read_detector_t::on_read(const std::string & address,const uint64_t height,uint64_t & from,uint64_t & to)
+        {
+            xstripe_t & stripe = get_stripe(address);
+            std::lock_guard<std::mutex> locker(stripe.lock);
+            auto it = stripe.runs.find(address);
+            if(it == stripe.runs.end())
+            {
+                if(stripe.runs.size() >= enum_max_accounts_per_stripe) //full, give up any one
+                    stripe.runs.erase(stripe.runs.begin());
+                it = stripe.runs.emplace(address,xread_run_t()).first;
+            }
+
+            xread_run_t & run = it->second;
+            if( (run.run_length > 0) && (height == run.next_height) )
+            {
+                run.run_length++;
+            }
+            else if( (run.run_length > 0) && (height + 1 == run.next_height) ) //same height read again, keep run
+            {
+                return false;
+            }
+            else //new run
+            {
+                run.run_length = 1;
+                run.prefetched_height = height;
+            }
+            run.next_height = height + 1;
+
+            if(run.run_length < enum_min_sequential_reads)
+                return false;
+
+            //refill once reader consumed half of window
+            if(run.prefetched_height > height + enum_prefetch_window / 2)
+                return false;
+
+            from = run.prefetched_height + 1;
+            to   = height + enum_prefetch_window;
+            run.prefetched_height = to;
+            return true;
+        }
+
+        void  xsequential_read_detector_t::remove(const std::string & address)
+        {
+            xstripe_t & stripe = get_stripe(address);
+            std::lock_guard<std::mutex> locker(stripe.lock);
+            stripe.runs.erase(address);
+        }
+    };//end of namespace of store
+};//end of namespace of top
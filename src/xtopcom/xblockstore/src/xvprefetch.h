@@ -0,0 +1,59 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace top
+{
+    namespace store
+    {
+        //detect reader walking heights of one account one by one(e.g. sync service or rpc scan),
+        //and tell which heights ahead of it should be loaded in background before reader asks for them.
+        //each stripe guards its map by own mutex held just for one update, entries may be dropped at any time.
+        class xsequential_read_detector_t
+        {
+            enum
+            {
+                enum_stripes_count              = 16,
+                enum_max_accounts_per_stripe    = 64,
+            };
+        public:
+            enum
+            {
+                enum_min_sequential_reads       = 4,  //reads with continuous heights before prefetch starts
+                enum_prefetch_window            = 8,  //how many heights ahead of reader
+            };
+        public:
+            xsequential_read_detector_t() = default;
+            ~xsequential_read_detector_t() = default;
+        private:
+            xsequential_read_detector_t(const xsequential_read_detector_t &) = delete;
+            xsequential_read_detector_t & operator = (const xsequential_read_detector_t &) = delete;
+        public:
+            //return true and range [from,to] when heights should be prefetched, each height is given out only once per run
+            bool                    on_read(const std::string & address,const uint64_t height,uint64_t & from,uint64_t & to);
+            void                    remove(const std::string & address);
+        private:
+            struct xread_run_t
+            {
+                uint64_t    next_height{0};
+                uint64_t    run_length{0};
+                uint64_t    prefetched_height{0};  //highest height already given out for prefetch
+            };
+            struct xstripe_t
+            {
+                std::mutex                                    lock;
+                std::unordered_map<std::string,xread_run_t>   runs;
+            };
+            xstripe_t &             get_stripe(const std::string & address);
+        private:
+            std::array<xstripe_t,enum_stripes_count>  m_stripes;
+        };
+    };//end of namespace of store
+};//end of namespace of top
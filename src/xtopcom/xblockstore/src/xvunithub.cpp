@@ -3,6 +3,7 @@
 // Licensed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include "xbase/xhash.h"
 #include "xbase/xcontext.h"
 #include "xbase/xthread.h"
@@ -58,8 +59,14 @@ namespace top
                 // TODO(jimmy) here may delete future for performance
                 if (m_raw_ptr->get_cached_size() >= (m_raw_ptr->get_max_cache_size() * 2))
                 {
+                    if(xblockcache_budget_t::instance().is_over_budget())
+                        XMETRICS_GAUGE(metrics::blockstore_cache_budget_cleanup, 1);
                     m_raw_ptr->clean_caches(false,false);//light cleanup
                 }
+                else
+                {
+                    m_raw_ptr->report_cached_size();
+                }
 
                 //then release raw ptr
                 xblockacct_t * old_ptr = m_raw_ptr;
@@ -121,7 +128,10 @@ namespace top
             xblockacct_t * old_ptr = m_raw_ptr;
             m_raw_ptr = raw_ptr;
             if(raw_ptr != NULL)
+            {
                 raw_ptr->add_ref();
+                raw_ptr->touch_cache(); //under lock of table
+            }
             
             if(old_ptr != NULL)
                 old_ptr->release_ref();
@@ -269,14 +279,10 @@ namespace top
                 {
                     if(ask_full_load)
                     {
-                        if (false == get_blockdb_ptr()->load_block_input(target_index)) {
-                            xerror("xvblockstore_impl::load_block_from_index fail load block input.%s at store(%s)",target_index->dump().c_str(),m_store_path.c_str());
+                        if (false == get_blockdb_ptr()->load_block_input_output(target_index)) {
+                            xerror("xvblockstore_impl::load_block_from_index fail load block input or output.%s at store(%s)",target_index->dump().c_str(),m_store_path.c_str());
                             return nullptr;
                         }
-                        if (false == get_blockdb_ptr()->load_block_output(target_index)) {
-                            xerror("xvblockstore_impl::load_block_from_index fail load block output.%s at store(%s)",target_index->dump().c_str(),m_store_path.c_str());
-                            return nullptr;                            
-                        }
                         if (false == load_block_output_offdata(*target_account->get_account_obj(), target_index->get_this_block())) {
                             xerror("xvblockstore_impl::load_block_from_index fail load block output offdata.%s at store(%s)",target_index->dump().c_str(),m_store_path.c_str());
                             return nullptr;                                                        
@@ -325,8 +331,19 @@ namespace top
         }
         base::xauto_ptr<base::xvblock_t>    xvblockstore_impl::get_latest_committed_block(const base::xvaccount_t & account,const int atag)
         {
+            base::xvblock_t * cached_block = m_committed_cache.get_latest_committed(account.get_account());
+            if(cached_block != nullptr) //committed block never change,so serve it without lock of table
+            {
+                METRICS_TAG(atag, 1);
+                return cached_block;
+            }
+
             LOAD_BLOCKACCOUNT_PLUGIN(account_obj,account);
-            return load_block_from_index(account_obj.get(),account_obj->load_latest_committed_index(),0,false, atag);
+            base::xauto_ptr<base::xvbindex_t> committed_index(account_obj->load_latest_committed_index());
+            base::xvblock_t * committed_block = load_block_from_index_for_raw_index(account_obj.get(),committed_index.get(),0,false, atag);
+            if(committed_block != nullptr)
+                m_committed_cache.on_committed(committed_index.get());
+            return committed_block;
         }
 
         base::xauto_ptr<base::xvblock_t>    xvblockstore_impl::get_latest_connected_block(const base::xvaccount_t & account,const int atag)
@@ -373,6 +390,13 @@ namespace top
 
         uint64_t xvblockstore_impl::get_latest_committed_block_height(const base::xvaccount_t & account,const int atag)
         {
+            base::xauto_ptr<base::xvblock_t> cached_block(m_committed_cache.get_latest_committed(account.get_account()));
+            if(cached_block != nullptr)
+            {
+                METRICS_TAG(atag, 1);
+                return cached_block->get_height();
+            }
+
             LOAD_BLOCKACCOUNT_PLUGIN2(account_obj,account);
             METRICS_TAG(atag, 1);
             return account_obj->get_latest_committed_block_height();
@@ -533,17 +557,47 @@ namespace top
 
         base::xauto_ptr<base::xvblock_t>    xvblockstore_impl::load_block_object(const base::xvaccount_t & account,const uint64_t height,const uint64_t viewid,bool ask_full_load,const int atag)
         {
+            try_prefetch_blocks(account,height);
+            if(false == ask_full_load)
+            {
+                base::xauto_ptr<base::xvblock_t> cached_block(m_committed_cache.get_committed(account.get_account(),height));
+                if( (cached_block != nullptr) && (cached_block->get_viewid() == viewid) )
+                {
+                    METRICS_TAG(atag, 1);
+                    return cached_block;
+                }
+            }
             LOAD_BLOCKACCOUNT_PLUGIN(account_obj,account);
             return load_block_from_index(account_obj.get(),account_obj->load_index(height,viewid),height,ask_full_load,atag);
         }
         base::xauto_ptr<base::xvblock_t>    xvblockstore_impl::load_block_object(const base::xvaccount_t & account,const uint64_t height,const std::string & blockhash,bool ask_full_load,const int atag)
         {
+            try_prefetch_blocks(account,height);
+            if(false == ask_full_load)
+            {
+                base::xauto_ptr<base::xvblock_t> cached_block(m_committed_cache.get_committed(account.get_account(),height));
+                if( (cached_block != nullptr) && (cached_block->get_block_hash() == blockhash) )
+                {
+                    METRICS_TAG(atag, 1);
+                    return cached_block;
+                }
+            }
             LOAD_BLOCKACCOUNT_PLUGIN(account_obj,account);
             return load_block_from_index(account_obj.get(),account_obj->load_index(height,blockhash),height,ask_full_load,atag);
         }
 
         base::xauto_ptr<base::xvblock_t>    xvblockstore_impl::load_block_object(const base::xvaccount_t & account,const uint64_t height,base::enum_xvblock_flag required_block,bool ask_full_load,const int atag)  //just return the highest viewid of matched flag
         {
+            try_prefetch_blocks(account,height);
+            if( (false == ask_full_load) && (base::enum_xvblock_flag_committed == required_block) )
+            {
+                base::xauto_ptr<base::xvblock_t> cached_block(m_committed_cache.get_committed(account.get_account(),height));
+                if(cached_block != nullptr)
+                {
+                    METRICS_TAG(atag, 1);
+                    return cached_block;
+                }
+            }
             LOAD_BLOCKACCOUNT_PLUGIN(account_obj,account);
             return load_block_from_index(account_obj.get(),account_obj->load_index(height,required_block),height,ask_full_load,atag);
         }
@@ -845,15 +899,35 @@ namespace top
             if(batch_store_blocks.empty())
                 return true;
 
+            //link blocks from lower height,so each block find its prev one at cache instead of DB
+            std::vector<base::xvblock_t*> sorted_blocks(batch_store_blocks);
+            std::stable_sort(sorted_blocks.begin(),sorted_blocks.end(),[](base::xvblock_t* front,base::xvblock_t* back){
+                if(nullptr == front || nullptr == back)
+                    return (back != nullptr);
+                return front->get_height() < back->get_height();
+            });
+
+            //commit the batch while account is still locked,so other readers never see part of it
+            xvblockdb_batch_t db_batch(get_blockdb_ptr());
             LOAD_BLOCKACCOUNT_PLUGIN2(account_obj,account);
-            for(auto it : batch_store_blocks)
+            std::vector<base::xvblock_t*> stored_blocks;
+            stored_blocks.reserve(sorted_blocks.size());
+            for(auto it : sorted_blocks)
             {
                 if((it != nullptr) && (it->get_account() == account_obj->get_address()) )
                 {
                     if(store_block(account_obj,it,atag))
-                        on_block_stored(it);
+                        stored_blocks.push_back(it);
                 }
             }
+            //index,object,input and output of the whole batch,plus index rewrites for lock/commit,go to DB at once
+            if(false == db_batch.commit())
+            {
+                xerror("xvblockstore_impl::store_blocks,fail to commit batch of %zu blocks for account(%s)",stored_blocks.size(),account.get_address().c_str());
+                return false;
+            }
+            for(auto it : stored_blocks)
+                on_block_stored(it);
             return  true;
         }
 
@@ -866,6 +940,7 @@ namespace top
             }
             LOAD_BLOCKACCOUNT_PLUGIN2(account_obj,account);
             METRICS_TAG(atag, 1);
+            m_committed_cache.remove(account.get_account());
             return account_obj->delete_block(block);
         }
 
@@ -1126,6 +1201,7 @@ namespace top
                 xassert(false);
                 return false;
             }
+            m_committed_cache.on_committed(index_ptr);
 
             bool ret = store_units_to_db(target_account, index_ptr);
             if (!ret) {
@@ -1269,6 +1345,50 @@ namespace top
             return false;
         } 
 
+        void  xvblockstore_impl::try_prefetch_blocks(const base::xvaccount_t & account,const uint64_t height)
+        {
+            uint64_t from_height = 0;
+            uint64_t to_height = 0;
+            if(false == m_read_detector.on_read(account.get_address(),height,from_height,to_height))
+                return;
+
+            int64_t in, out;
+            const int32_t queue_size = count_calls(in, out);
+            if(queue_size >= enum_max_prefetch_calls) //prefetch is optional, never pile up behind store thread
+            {
+                xdbg("xvblockstore_impl::try_prefetch_blocks,drop for busy queue(%d),account=%s,height(%llu)",queue_size,account.get_address().c_str(),height);
+                return;
+            }
+
+            auto handler = [this, account, from_height, to_height](base::xcall_t & call, const int32_t cur_thread_id, const uint64_t timenow_ms) -> bool {
+                this->prefetch_blocks(account,from_height,to_height);
+                return true;
+            };
+            base::xcall_t asyn_call(handler,(base::xobject_t*)this);
+            send_call(asyn_call);
+        }
+
+        //load committed index and block(without input/output) into cache of account, stop at first missed height
+        bool  xvblockstore_impl::prefetch_blocks(const base::xvaccount_t & account,const uint64_t from_height,const uint64_t to_height)
+        {
+            LOAD_BLOCKACCOUNT_PLUGIN2(account_obj,account);
+            for(uint64_t height = from_height; height <= to_height; ++height)
+            {
+                base::xauto_ptr<base::xvbindex_t> index(account_obj->load_index(height,base::enum_xvblock_flag_committed));
+                if(index == nullptr)
+                    break;
+                if(index->get_this_block() != nullptr) //already cached
+                    continue;
+
+                base::xvblock_t * block = load_block_from_index_for_raw_index(account_obj.get(),index.get(),height,false);
+                if(nullptr == block)
+                    break;
+                block->release_ref();
+                XMETRICS_GAUGE(metrics::blockstore_prefetch_block, 1);
+            }
+            return true;
+        }
+
         bool xvblockstore_impl::should_store_units(int zone_index) const {
             bool is_store_units = true;
             if (base::xvchain_t::instance().is_storage_node() == false) {
@@ -10,6 +10,8 @@
 #include "../xblockstore_face.h"
 #include "xvblockdb.h"
 #include "xvblockhub.h"
+#include "xvcommitcache.h"
+#include "xvprefetch.h"
 
 namespace top
 {
@@ -42,6 +44,10 @@ namespace top
         class xvblockstore_impl : public base::xvblockstore_t
         {
             friend class auto_xblockacct_ptr;
+            enum
+            {
+                enum_max_prefetch_calls = 64, //pending calls at store thread over this, new prefetch is dropped
+            };
         public:
             xvblockstore_impl(base::xcontext_t & _context,const int32_t target_thread_id,base::xvdbstore_t* xvdb_ptr);
         protected:
@@ -165,10 +171,14 @@ namespace top
             virtual bool                on_object_close() override;
             int                         load_block_idx_by_hash(const std::string & hash, std::string & account, uint64_t & height);
             bool                        should_store_units(int zone_index) const;
+            void                        try_prefetch_blocks(const base::xvaccount_t & account,const uint64_t height);
+            bool                        prefetch_blocks(const base::xvaccount_t & account,const uint64_t from_height,const uint64_t to_height);
         private:
             xvblockdb_t*                       m_xvblockdb_ptr;
             std::string                        m_store_path;
             std::function<base::xauto_ptr<base::xvblock_t>(base::xvaccount_t const &, std::error_code &)> m_create_genesis_block_cb;
+            xcommitted_block_cache_t           m_committed_cache; //read committed block without lock of table
+            xsequential_read_detector_t        m_read_detector;   //trigger prefetch for sequential height scans
         };
 
     };//end of namespace of vstore
@@ -0,0 +1,94 @@
+// Copyright (c) 2018-Present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "xvledger/xvblock.h"
+
+namespace top
+{
+    namespace store
+    {
+        //append-only segment of finalized blocks,never changed once closed
+        //layout: [magic|version] [full block]... [index] [index offset|magic]
+        //index:  u32 accounts,then for each account: u16 address size|address|u32 count|{u64 height|u64 offset|u32 size}...
+        //block is kept as full_block_serialize_to of xblock_t(object,input,output and offdata),same as block sync
+        class xblock_archive_t
+        {
+        public:
+            enum
+            {
+                enum_archive_magic      = 0x52414254, //"TBAR"
+                enum_archive_version    = 1,
+                enum_archive_head_size  = 8,
+                enum_archive_foot_size  = 12,
+            };
+            struct xarchive_entry_t
+            {
+                uint64_t  height;
+                uint64_t  offset;
+                uint32_t  size;
+            };
+            typedef std::unordered_map<std::string,std::vector<xarchive_entry_t>> xarchive_index_t;
+        };
+
+        //build one segment,blocks of each account must come with ascending height
+        class xblock_archive_writer_t : public xblock_archive_t
+        {
+        public:
+            xblock_archive_writer_t() = default;
+            ~xblock_archive_writer_t();
+        private:
+            xblock_archive_writer_t(const xblock_archive_writer_t &) = delete;
+            xblock_archive_writer_t & operator = (const xblock_archive_writer_t &) = delete;
+        public:
+            bool                open(const std::string & file_path); //create new or truncate existing file
+            bool                append(base::xvblock_t * block);     //block must be full loaded
+            bool                close();                             //write index then segment is readable
+            size_t              get_blocks_count() const {return m_blocks_count;}
+        private:
+            bool                write_raw(const void * data,const size_t size);
+        private:
+            FILE *              m_file{nullptr};
+            uint64_t            m_write_offset{0};
+            size_t              m_blocks_count{0};
+            xarchive_index_t    m_index;
+            std::vector<std::string> m_accounts; //keep order of accounts as appended
+        };
+
+        //map a closed segment read-only,block data is read straight from mapped pages without copy
+        //it does not change after open,so it is safe to read by multiple threads
+        class xblock_archive_reader_t : public xblock_archive_t
+        {
+        public:
+            xblock_archive_reader_t() = default;
+            ~xblock_archive_reader_t();
+        private:
+            xblock_archive_reader_t(const xblock_archive_reader_t &) = delete;
+            xblock_archive_reader_t & operator = (const xblock_archive_reader_t &) = delete;
+        public:
+            bool                open(const std::string & file_path);
+            void                close();
+
+            //data points into mapped segment and keeps valid until close
+            bool                read_block_data(const std::string & address,const uint64_t height,const char* & data,size_t & size) const;
+            //return new block with added reference or nullptr,caller respond to release it
+            base::xvblock_t*    load_block(const std::string & address,const uint64_t height) const;
+
+            const xarchive_index_t &  get_index() const {return m_index;}
+        private:
+            const xarchive_entry_t *  find_entry(const std::string & address,const uint64_t height) const;
+            bool                parse_index();
+        private:
+            int                 m_fd{-1};
+            const char *        m_data{nullptr};
+            size_t              m_size{0};
+            xarchive_index_t    m_index;
+        };
+    };//end of namespace of store
+};//end of namespace of top
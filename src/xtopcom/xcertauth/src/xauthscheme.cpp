@@ -25,6 +25,19 @@ namespace top
         xauthscheme_t::~xauthscheme_t()
         {
         }
+
+        void  xauthscheme_t::verify_signs(const std::vector<const base::xvnode_t*> & signers,const std::vector<std::string> & target_hashes,const std::vector<std::string> & signatures,const std::vector<uint64_t> & auth_mutisign_tokens,std::vector<bool> & results)
+        {
+            results.assign(signers.size(),false);
+            if( (target_hashes.size() != signers.size()) || (signatures.size() != signers.size()) || (auth_mutisign_tokens.size() != signers.size()) )
+                return;
+
+            for(size_t i = 0; i < signers.size(); ++i)
+            {
+                if(signers[i] != NULL)
+                    results[i] = verify_sign(*signers[i],target_hashes[i],signatures[i],auth_mutisign_tokens[i]);
+            }
+        }
         
     }; //end of namespace of auth
 };//end of namesapce of top
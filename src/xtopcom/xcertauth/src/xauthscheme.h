@@ -25,6 +25,9 @@ namespace top
             virtual const std::string    do_sign(const base::xvnode_t & signer,const std::string & sign_target_hash,const uint64_t random_seed,const uint64_t auth_mutisign_token) = 0;
             
             virtual bool                 verify_sign(const base::xvnode_t & signer,const std::string & target_hash,const std::string & signature,const uint64_t auth_mutisign_token) = 0;
+
+            //verify signatures of many signers at once,results[i] is for signers[i]. default implementation verify them one by one
+            virtual void                 verify_signs(const std::vector<const base::xvnode_t*> & signers,const std::vector<std::string> & target_hashes,const std::vector<std::string> & signatures,const std::vector<uint64_t> & auth_mutisign_tokens,std::vector<bool> & results);
             
             //return a merged signature
             virtual const std::string    merge_muti_sign(const base::xvnodegroup_t & nodes_group,const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const uint64_t shared_mutisign_token) = 0;
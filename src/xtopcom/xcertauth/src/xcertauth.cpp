@@ -4,6 +4,14 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <cinttypes>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+#include "xbase/xutl.h"
+#include "xbasic/xlru_cache.h"
+#include "xbasic/xthreading/xparallel_pool.h"
 #include "xcertauth_face.h"
 #include "xauthscheme.h"
 #include "xmutisig/xmutisig.h"
@@ -44,6 +52,10 @@ namespace top
                                                                  const std::string & block_account, const std::string sign_hash) override;
             virtual base::enum_vcert_auth_result     verify_sign(const xvip2_t & signer,const base::xvblock_t * test_for_block) override;
 
+            //batch by scheme and fan out to few threads when there are many signatures
+            virtual void                             verify_signs(const std::vector<xvip2_t> & signers,const std::vector<const base::xvqcert_t*> & test_for_certs,
+                                                                  const std::string & block_account,std::vector<base::enum_vcert_auth_result> & results) override;
+
         public:
             //merge multiple single-signature into threshold signature,and return a merged signature
             virtual const std::string   merge_muti_sign(const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const base::xvqcert_t * for_cert) override;
@@ -69,11 +81,24 @@ namespace top
             const std::string   do_sign_impl(const xvip2_t & signer,const base::xvqcert_t * sign_for_cert,const uint64_t random_seed, const std::string ask_sign_hash);
             base::enum_vcert_auth_result            verify_sign_impl(const xvip2_t & signer,const base::xvqcert_t * test_for_cert, const std::string ask_verify_hash);
             base::enum_vcert_auth_result            verify_muti_sign_impl(const base::xvqcert_t * test_for_cert);
+            //key covers everything the multi-signature verification depends on
+            const std::string                       get_verified_cert_key(const base::xvqcert_t * target_cert,const std::string & block_account);
 
             xauthscheme_t*       get_auth_scheme(const base::xvqcert_t * test_for_cert);
         protected:
             xauthscheme_t*       m_auth_schemes[base::enum_xvchain_sign_scheme_max + 1];  //total not over 8 as refer enum_xvchain_sign_scheme
             base::xvnodesrv_t&   m_node_service;
+        private:
+            enum
+            {
+                enum_verified_certs_cache_max = 4096, //same block reach node from sync,bft and relay paths
+            };
+            //only successful result is cached,since group may be not ready yet for failed one
+            basic::xlru_cache<std::string,bool>  m_verified_certs{enum_verified_certs_cache_max};
+            //certs under verifying,same cert from other thread wait for it instead of verifying again
+            std::mutex                           m_verifying_lock;
+            std::condition_variable              m_verifying_cond;
+            std::set<std::string>                m_verifying_certs;
         };
 
         base::xvcertauth_t &  xauthcontext_t::instance(base::xvnodesrv_t & node_service)
@@ -363,6 +388,144 @@ namespace top
             return verify_sign(signer,test_for_block->get_cert(),test_for_block->get_account());
         }
 
+        enum
+        {
+            enum_verify_signs_min_per_thread = 8, //split to threads only when each thread has enough signatures to batch
+            enum_verify_signs_max_threads    = 4,
+        };
+
+        void   xauthcontext_t_impl::verify_signs(const std::vector<xvip2_t> & signers,const std::vector<const base::xvqcert_t*> & test_for_certs,
+                                                 const std::string & block_account,std::vector<base::enum_vcert_auth_result> & results)
+        {
+            results.assign(signers.size(),base::enum_vcert_auth_result::enum_bad_cert);
+            if(test_for_certs.size() != signers.size())
+                return;
+
+            struct xsigns_batch_t
+            {
+                std::vector<size_t>                   slots;
+                std::vector<const base::xvnode_t*>    nodes;
+                std::vector<std::string>              hashes;
+                std::vector<std::string>              signatures;
+                std::vector<uint64_t>                 tokens;
+            };
+            std::map<xauthscheme_t*,xsigns_batch_t> batches;
+            std::vector<base::xvnode_t*>            hold_nodes;
+
+            //step#1: do same checks as verify_sign for each one,and collect the rest by scheme
+            for(size_t i = 0; i < signers.size(); ++i)
+            {
+                const base::xvqcert_t * test_for_cert = test_for_certs[i];
+                if(NULL == test_for_cert)
+                    continue;
+
+                if(false == verify_validator_addr(block_account,test_for_cert))
+                {
+                    xerror("xauthcontext_t_impl::verify_signs,fail-validator address for block:%s",test_for_cert->dump().c_str());
+                    results[i] = base::enum_vcert_auth_result::enum_bad_address;
+                    continue;
+                }
+                if(false == test_for_cert->is_valid())
+                {
+                    xerror("xauthcontext_t_impl::verify_signs,fail-an undeliver cert:%s",test_for_cert->dump().c_str());
+                    continue;
+                }
+                if(test_for_cert->get_consensus_type() != base::enum_xconsensus_type_xhbft)
+                {
+                    xerror("xauthcontext_t_impl::verify_signs,fail-cert_auth requrest enum_xconsensus_type_xhbft for cert:%s",test_for_cert->dump().c_str());
+                    results[i] = base::enum_vcert_auth_result::enum_bad_consensus;
+                    continue;
+                }
+                xauthscheme_t * verify_scheme_obj = get_auth_scheme(test_for_cert);
+                if(NULL == verify_scheme_obj)
+                {
+                    xerror("xauthcontext_t_impl::verify_signs,fail-found related auth scheme for cert:%s",test_for_cert->dump().c_str());
+                    results[i] = base::enum_vcert_auth_result::enum_bad_scheme;
+                    continue;
+                }
+                base::xauto_ptr<base::xvnode_t> verify_node = m_node_service.get_node(signers[i]);
+                if(verify_node == nullptr)
+                {
+                    xwarn("xauthcontext_t_impl::verify_signs,fail-found target nodes for signer(%" PRIx64 " : %" PRIx64 ")",signers[i].high_addr,signers[i].low_addr);
+                    results[i] = base::enum_vcert_auth_result::enum_nodes_notfound;
+                    continue;
+                }
+                results[i] = base::enum_vcert_auth_result::enum_verify_fail;
+                std::string signature;
+                if(test_for_cert->is_validator(signers[i]))
+                    signature = test_for_cert->get_verify_signature();
+                else if(test_for_cert->is_auditor(signers[i]))
+                    signature = test_for_cert->get_audit_signature();
+                else
+                {
+                    xwarn_err("xauthcontext_t_impl::verify_signs,fail-invalid signer(%" PRIx64 " : %" PRIx64 ") for cert=%s",signers[i].high_addr,signers[i].low_addr,test_for_cert->dump().c_str());
+                    continue;
+                }
+
+                verify_node->add_ref();
+                hold_nodes.push_back(verify_node.get());
+
+                xsigns_batch_t & batch = batches[verify_scheme_obj];
+                batch.slots.push_back(i);
+                batch.nodes.push_back(verify_node.get());
+                batch.hashes.push_back(test_for_cert->get_hash_to_sign());
+                batch.signatures.push_back(signature);
+                batch.tokens.push_back(test_for_cert->get_viewid() + test_for_cert->get_viewtoken());
+            }
+
+            //step#2: verify each batch,split into chunks for threads when it is big
+            for(auto & it : batches)
+            {
+                xauthscheme_t * verify_scheme_obj = it.first;
+                xsigns_batch_t & batch = it.second;
+                const size_t total = batch.slots.size();
+                std::vector<bool> verified(total,false);
+
+                const size_t thread_count = std::min<size_t>(enum_verify_signs_max_threads,total / enum_verify_signs_min_per_thread);
+                if(thread_count <= 1)
+                {
+                    verify_scheme_obj->verify_signs(batch.nodes,batch.hashes,batch.signatures,batch.tokens,verified);
+                }
+                else
+                {
+                    const size_t chunk_size = (total + thread_count - 1) / thread_count;
+                    std::vector<std::vector<bool>> chunk_results(thread_count);
+                    auto verify_chunk = [&](const size_t chunk)->void{
+                        const size_t begin = chunk * chunk_size;
+                        const size_t end   = std::min(total,begin + chunk_size);
+                        if(begin >= end)
+                            return;
+                        const std::vector<const base::xvnode_t*> nodes(batch.nodes.begin() + begin,batch.nodes.begin() + end);
+                        const std::vector<std::string> hashes(batch.hashes.begin() + begin,batch.hashes.begin() + end);
+                        const std::vector<std::string> signatures(batch.signatures.begin() + begin,batch.signatures.begin() + end);
+                        const std::vector<uint64_t> tokens(batch.tokens.begin() + begin,batch.tokens.begin() + end);
+                        verify_scheme_obj->verify_signs(nodes,hashes,signatures,tokens,chunk_results[chunk]);
+                    };
+
+                    //chunks run at the shared long-lived pool,current thread take chunks as well
+                    threading::xparallel_pool_t::instance().run(thread_count,thread_count,verify_chunk);
+
+                    for(size_t chunk = 0; chunk < thread_count; ++chunk)
+                    {
+                        const size_t begin = chunk * chunk_size;
+                        for(size_t j = 0; j < chunk_results[chunk].size(); ++j)
+                            verified[begin + j] = chunk_results[chunk][j];
+                    }
+                }
+
+                for(size_t j = 0; j < total; ++j)
+                {
+                    if(verified[j])
+                        results[batch.slots[j]] = base::enum_vcert_auth_result::enum_successful;
+                    else
+                        xwarn("xauthcontext_t_impl::verify_signs,fail-verify signer(%" PRIx64 " : %" PRIx64 ") for cert=%s",signers[batch.slots[j]].high_addr,signers[batch.slots[j]].low_addr,test_for_certs[batch.slots[j]]->dump().c_str());
+                }
+            }
+
+            for(auto node : hold_nodes)
+                node->release_ref();
+        }
+
         ///////////////////////////////////////////merge_muti_sign/////////////////////////////////////////////////////////
         const std::string   xauthcontext_t_impl::merge_muti_sign(const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const base::xvqcert_t * for_cert)
         {
@@ -609,6 +772,15 @@ namespace top
                 return base::enum_vcert_auth_result::enum_bad_address;
             }
 
+            const std::string cert_key = get_verified_cert_key(target_cert,block_account);
+            {
+                std::unique_lock<std::mutex> lock(m_verifying_lock);
+                m_verifying_cond.wait(lock,[this,&cert_key]{return m_verifying_certs.find(cert_key) == m_verifying_certs.end();});
+                if(m_verified_certs.exist(cert_key))
+                    return base::enum_vcert_auth_result::enum_successful;
+                m_verifying_certs.insert(cert_key);
+            }
+
             base::enum_vcert_auth_result result = base::enum_vcert_auth_result::enum_verify_fail;
             if(target_cert->get_consensus_flags() & base::enum_xconsensus_flag_extend_cert) //by extend cert to verify
             {
@@ -616,20 +788,58 @@ namespace top
                 if(extend_cert == nullptr)
                 {
                     xerror("xauthcontext_t_impl::verify_muti_sign,fail-invalid extend cert carried by cert:%s",target_cert->dump().c_str());
-                    return base::enum_vcert_auth_result::enum_bad_cert;
+                    result = base::enum_vcert_auth_result::enum_bad_cert;
+                }
+                else
+                {
+                    result = verify_muti_sign_impl(extend_cert.get());
                 }
-                result = verify_muti_sign_impl(extend_cert.get());
             }
             else //go regular cert
             {
                 result = verify_muti_sign_impl(target_cert);
             }
+            if(result == base::enum_vcert_auth_result::enum_successful)
+                m_verified_certs.put(cert_key,true);
+            {
+                std::lock_guard<std::mutex> lock(m_verifying_lock);
+                m_verifying_certs.erase(cert_key);
+            }
+            m_verifying_cond.notify_all();
+
             if(result != base::enum_vcert_auth_result::enum_successful)
                 xwarn("xauthcontext_t_impl::verify_muti_sign,fail-with error code:%d",result);
 
             return result;
         }
 
+        //variable length field is prefixed by its length,so bytes moved from one field to next never make same key
+        static void append_cert_key_field(std::string & cert_key,const std::string & field)
+        {
+            cert_key += base::xstring_utl::tostring((uint64_t)field.size()) + ":";
+            cert_key += field;
+        }
+
+        const std::string   xauthcontext_t_impl::get_verified_cert_key(const base::xvqcert_t * target_cert,const std::string & block_account)
+        {
+            std::string cert_key;
+            append_cert_key_field(cert_key,block_account);
+            if(target_cert->get_consensus_flags() & base::enum_xconsensus_flag_extend_cert)
+            {
+                cert_key += ":e:";
+                append_cert_key_field(cert_key,target_cert->get_extend_cert());
+                return cert_key;
+            }
+            cert_key += ":" + base::xstring_utl::tostring(target_cert->get_validator().high_addr) + ":" + base::xstring_utl::tostring(target_cert->get_validator().low_addr);
+            cert_key += ":" + base::xstring_utl::tostring(target_cert->get_auditor().high_addr) + ":" + base::xstring_utl::tostring(target_cert->get_auditor().low_addr);
+            cert_key += ":" + base::xstring_utl::tostring(target_cert->get_viewid()) + ":" + base::xstring_utl::tostring(target_cert->get_viewtoken());
+            cert_key += ":" + base::xstring_utl::tostring(target_cert->get_consensus_flags()) + ":";
+            append_cert_key_field(cert_key,target_cert->get_hash_to_sign());
+            append_cert_key_field(cert_key,target_cert->get_verify_signature());
+            append_cert_key_field(cert_key,target_cert->get_audit_signature());
+            return cert_key;
+        }
+
         base::enum_vcert_auth_result   xauthcontext_t_impl::verify_muti_sign(const base::xvblock_t * test_for_block)
         {
             if(NULL == test_for_block)
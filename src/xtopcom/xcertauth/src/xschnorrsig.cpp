@@ -107,6 +107,86 @@ namespace top
             return false;
         }
         
+        //verify [begin,end) by one batch equation,then split into halves only when it fail,so few bad signatures cost few more verifications
+        static void  batch_verify_range(const std::vector<std::string> & hashes,const std::vector<xmutisig::xpubkey> & pubkeys,const std::vector<std::string> & seals,const std::vector<std::string> & points,const std::vector<size_t> & slots,const size_t begin,const size_t end,std::vector<bool> & results)
+        {
+            if(end <= begin)
+                return;
+
+            if(end - begin == 1)
+            {
+                results[slots[begin]] = xmutisig::xmutisig::verify_sign(hashes[begin],pubkeys[begin],seals[begin],points[begin],xmutisig::xschnorr::instance());
+                return;
+            }
+
+            const std::vector<std::string> sub_hashes(hashes.begin() + begin,hashes.begin() + end);
+            const std::vector<xmutisig::xpubkey> sub_pubkeys(pubkeys.begin() + begin,pubkeys.begin() + end);
+            const std::vector<std::string> sub_seals(seals.begin() + begin,seals.begin() + end);
+            const std::vector<std::string> sub_points(points.begin() + begin,points.begin() + end);
+            if(xmutisig::xmutisig::batch_verify_sign(sub_hashes,sub_pubkeys,sub_seals,sub_points,xmutisig::xschnorr::instance()))
+            {
+                for(size_t i = begin; i < end; ++i)
+                    results[slots[i]] = true;
+                return;
+            }
+
+            const size_t middle = begin + (end - begin) / 2;
+            batch_verify_range(hashes,pubkeys,seals,points,slots,begin,middle,results);
+            batch_verify_range(hashes,pubkeys,seals,points,slots,middle,end,results);
+        }
+
+        void    xschnorrsig_t::verify_signs(const std::vector<const base::xvnode_t*> & signers,const std::vector<std::string> & target_hashes,const std::vector<std::string> & signatures,const std::vector<uint64_t> & auth_mutisign_tokens,std::vector<bool> & results)
+        {
+            results.assign(signers.size(),false);
+            if( (target_hashes.size() != signers.size()) || (signatures.size() != signers.size()) || (auth_mutisign_tokens.size() != signers.size()) )
+            {
+                xerror("xschnorrsig_t::verify_signs,fail-bad parameters");
+                return;
+            }
+
+            std::vector<std::string>         hashes;
+            std::vector<xmutisig::xpubkey>   pubkeys;
+            std::vector<std::string>         seals;
+            std::vector<std::string>         points;
+            std::vector<size_t>              slots; //index of signers for each item to batch
+            for(size_t i = 0; i < signers.size(); ++i)
+            {
+                if( (NULL == signers[i]) || signatures[i].empty() || target_hashes[i].empty() || (0 == auth_mutisign_tokens[i]) )
+                {
+                    xerror("xschnorrsig_t::verify_signs,fail-bad parameters at slot(%d)",(int32_t)i);
+                    continue;
+                }
+                xmutisigdata_t schnorr_sig_data;
+                if(schnorr_sig_data.serialize_from_string(signatures[i]) <= 0)
+                {
+                    xerror("xschnorrsig_t::verify_signs,fail-bad signature for signer(%s)",signers[i]->get_account().c_str());
+                    continue;
+                }
+                if(schnorr_sig_data.get_mutisig_token() != auth_mutisign_tokens[i])
+                {
+                    xerror("xschnorrsig_t::verify_signs,fail-unmatched tokens,token(%" PRIx64 ") != auth-token(%" PRIx64 ") ",schnorr_sig_data.get_mutisig_token(),auth_mutisign_tokens[i]);
+                    continue;
+                }
+                if( schnorr_sig_data.get_mutisig_seal().empty() || schnorr_sig_data.get_mutisig_point().empty() )
+                {
+                    xerror("xschnorrsig_t::verify_signs,fail-empty seal or point for signer(%s)",signers[i]->get_account().c_str());
+                    continue;
+                }
+                xmutisig::xpubkey _singer_public_key(signers[i]->get_sign_pubkey());
+                if(_singer_public_key.ec_point() == nullptr)
+                {
+                    xerror("xschnorrsig_t::verify_signs,fail-an invalid public key for signer(%s)",signers[i]->get_account().c_str());
+                    continue;
+                }
+                hashes.push_back(target_hashes[i]);
+                pubkeys.push_back(_singer_public_key);
+                seals.push_back(schnorr_sig_data.get_mutisig_seal());
+                points.push_back(schnorr_sig_data.get_mutisig_point());
+                slots.push_back(i);
+            }
+            batch_verify_range(hashes,pubkeys,seals,points,slots,0,slots.size(),results);
+        }
+
         //return a merged & aggregated signature,muti_nodes must be at nodes of group
         const std::string    xschnorrsig_t::merge_muti_sign(const base::xvnodegroup_t & nodes_group,const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const uint64_t auth_mutisign_token)
         {
@@ -198,6 +278,116 @@ namespace top
             return aggregated_sig_data.serialize_to_string();//convert to string
         }
         
+        std::shared_ptr<xschnorrsig_t::xgroup_pubkeys_t>  xschnorrsig_t::get_group_pubkeys(const base::xvnodegroup_t & group)
+        {
+            const std::string cache_key = base::xstring_utl::tostring(group.get_xip2_addr().high_addr) + ":" + base::xstring_utl::tostring(group.get_xip2_addr().low_addr) + ":" + base::xstring_utl::tostring(group.get_network_height());
+            std::shared_ptr<xgroup_pubkeys_t> group_pubkeys;
+            if(m_group_pubkeys.get(cache_key,group_pubkeys))
+            {
+                //group object may be re-created by node service,so make sure it is still same committee
+                bool same_committee = (group_pubkeys->keys.size() == group.get_size());
+                for(uint32_t i = 0; same_committee && (i < group.get_size()); ++i)
+                {
+                    base::xvnode_t * _node_ptr = group.get_node(i);
+                    same_committee = (_node_ptr != NULL) && (_node_ptr->get_sign_pubkey() == group_pubkeys->keys[i]);
+                }
+                if(same_committee)
+                    return group_pubkeys;
+            }
+
+            group_pubkeys = std::make_shared<xgroup_pubkeys_t>();
+            group_pubkeys->usable = (group.get_size() > 0);
+            std::set<std::string> unique_accounts;
+            std::set<std::string> unique_keys;
+            for(uint32_t i = 0; i < group.get_size(); ++i)
+            {
+                base::xvnode_t * _node_ptr = group.get_node(i);
+                const std::string pubkey_str = (_node_ptr != NULL) ? _node_ptr->get_sign_pubkey() : std::string();
+                group_pubkeys->keys.push_back(pubkey_str);
+                if(pubkey_str.empty() || (false == unique_accounts.emplace(_node_ptr->get_account()).second) || (false == unique_keys.emplace(pubkey_str).second))
+                {
+                    group_pubkeys->usable = false;
+                    continue;
+                }
+                if(group_pubkeys->usable)
+                {
+                    group_pubkeys->pubkeys.emplace_back(xmutisig::xpubkey(pubkey_str));
+                    group_pubkeys->accounts.push_back(_node_ptr->get_account());
+                }
+            }
+            if(group_pubkeys->usable)
+            {
+                group_pubkeys->full_aggregated = xmutisig::xmutisig::aggregate_pubkeys_2(group_pubkeys->pubkeys,xmutisig::xschnorr::instance());
+                group_pubkeys->usable = (group_pubkeys->full_aggregated != nullptr);
+            }
+            if(false == group_pubkeys->usable) //keep keys only to check the committee
+            {
+                group_pubkeys->pubkeys.clear();
+                group_pubkeys->accounts.clear();
+                group_pubkeys->full_aggregated = nullptr;
+            }
+            m_group_pubkeys.put(cache_key,group_pubkeys);
+            return group_pubkeys;
+        }
+
+        //return nullptr when quick path not apply,then caller go normal path
+        std::shared_ptr<xmutisig::xpubkey>  xschnorrsig_t::aggregate_group_signers(const base::xvnodegroup_t & group,xnodebitset & nodebits,const uint32_t sig_threshold,std::set<std::string> & exclude_accounts,std::set<std::string> & exclude_keys)
+        {
+            std::shared_ptr<xgroup_pubkeys_t> group_pubkeys = get_group_pubkeys(group);
+            if( (group_pubkeys == nullptr) || (false == group_pubkeys->usable) )
+                return nullptr;
+
+            std::vector<uint32_t> signers;
+            std::vector<uint32_t> absents;
+            for(int i = 0; i < nodebits.get_alloc_bits(); ++i)
+            {
+                if(nodebits.is_set(i))
+                    signers.push_back((uint32_t)i);
+                else
+                    absents.push_back((uint32_t)i);
+            }
+            if(signers.size() < sig_threshold)
+                return nullptr;
+
+            //same as normal path,any signer excluded by prev check must be filtered,so leave it to normal path
+            for(auto slot : signers)
+            {
+                if( (exclude_accounts.find(group_pubkeys->accounts[slot]) != exclude_accounts.end()) || (exclude_keys.find(group_pubkeys->keys[slot]) != exclude_keys.end()) )
+                    return nullptr;
+            }
+
+            std::shared_ptr<xmutisig::xpubkey> agg_pubkey;
+            if(absents.empty())
+            {
+                agg_pubkey = std::make_shared<xmutisig::xpubkey>(*group_pubkeys->full_aggregated);
+            }
+            else if(absents.size() < signers.size())
+            {
+                std::vector<const xmutisig::xpubkey*> absent_pubkeys;
+                absent_pubkeys.reserve(absents.size());
+                for(auto slot : absents)
+                    absent_pubkeys.push_back(&group_pubkeys->pubkeys[slot]);
+                agg_pubkey = xmutisig::xmutisig::subtract_pubkeys(*group_pubkeys->full_aggregated,absent_pubkeys,xmutisig::xschnorr::instance());
+            }
+            else
+            {
+                std::vector<xmutisig::xpubkey*> signer_pubkeys;
+                signer_pubkeys.reserve(signers.size());
+                for(auto slot : signers)
+                    signer_pubkeys.push_back(&group_pubkeys->pubkeys[slot]);
+                agg_pubkey = xmutisig::xmutisig::aggregate_pubkeys(signer_pubkeys,xmutisig::xschnorr::instance());
+            }
+            if(agg_pubkey == nullptr)
+                return nullptr;
+
+            for(auto slot : signers)
+            {
+                exclude_accounts.insert(group_pubkeys->accounts[slot]);
+                exclude_keys.insert(group_pubkeys->keys[slot]);
+            }
+            return agg_pubkey;
+        }
+
         //std::set<std::string> & exclude_accounts filter any duplicated accounts, and std::set<std::string> & exclude_keys filter any duplicated keys
         bool                 xschnorrsig_t::verify_muti_sign(const base::xvnodegroup_t & group,const uint32_t sig_threshold,const std::string & target_hash,const std::string & aggregated_signatures_bin,const uint64_t auth_mutisign_token,std::set<std::string> & exclude_accounts,std::set<std::string> & exclude_keys)
         {
@@ -221,6 +411,17 @@ namespace top
                     return false;
                 }
 
+                //quick path: aggregate from parsed pubkeys of committee,a full or mostly full bits just subtract the absent ones
+                std::shared_ptr<xmutisig::xpubkey> cached_agg_pub = aggregate_group_signers(group,nodebits,sig_threshold,exclude_accounts,exclude_keys);
+                if(cached_agg_pub != nullptr)
+                {
+                    return xmutisig::xmutisig::verify_sign(target_hash,
+                                                           *cached_agg_pub,
+                                                           aggregated_sig_obj.get_mutisig_seal(),
+                                                           aggregated_sig_obj.get_mutisig_point(),
+                                                           xmutisig::xschnorr::instance());
+                }
+
                 std::vector<xmutisig::xpubkey> muti_signers_pubkey;
                 muti_signers_pubkey.reserve(nodebits.get_alloc_bits());
                 for(int i = 0; i < nodebits.get_alloc_bits(); ++i)
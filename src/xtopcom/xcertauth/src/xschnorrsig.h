@@ -5,6 +5,11 @@
 #pragma once
 
 #include "xauthscheme.h"
+#include "xsigndata.h"
+#include "xbasic/xlru_cache.h"
+#include "xmutisig/xpubkey.h"
+
+#include <memory>
 
 namespace top
 {
@@ -24,6 +29,9 @@ namespace top
             virtual const std::string    do_sign(const base::xvnode_t & signer,const std::string & sign_target_hash,const uint64_t random_seed,const uint64_t auth_mutisign_token) override;
             
             virtual bool                 verify_sign(const base::xvnode_t & signer,const std::string & target_hash,const std::string & signature,const uint64_t auth_mutisign_token) override;
+
+            //verify all by one batch equation,and split into halves to find out the bad ones only when batch fail
+            virtual void                 verify_signs(const std::vector<const base::xvnode_t*> & signers,const std::vector<std::string> & target_hashes,const std::vector<std::string> & signatures,const std::vector<uint64_t> & auth_mutisign_tokens,std::vector<bool> & results) override;
             
             //return a merged & aggregated signature,muti_nodes must be at same group of network
             virtual const std::string    merge_muti_sign(const base::xvnodegroup_t & nodes_group,const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const uint64_t auth_mutisign_token) override;
@@ -32,6 +40,25 @@ namespace top
             
         public:
             virtual bool                 create_keypair(std::string & prikey,std::string & pubkey) override;
+
+        private:
+            enum
+            {
+                enum_group_pubkeys_cache_max = 512, //validator & auditor groups of about 2 elections
+            };
+            //parsed public keys of whole committee,it never change for same group address and network height(election)
+            struct xgroup_pubkeys_t
+            {
+                std::vector<xmutisig::xpubkey>        pubkeys;    //same slot as nodes of group
+                std::vector<std::string>              accounts;
+                std::vector<std::string>              keys;       //serialized public keys,to check against group and fill exclude_keys
+                std::shared_ptr<xmutisig::xpubkey>    full_aggregated;
+                bool                                  usable{false}; //false if any node missed,empty or duplicated,then go normal path
+            };
+            std::shared_ptr<xgroup_pubkeys_t>  get_group_pubkeys(const base::xvnodegroup_t & group);
+            std::shared_ptr<xmutisig::xpubkey> aggregate_group_signers(const base::xvnodegroup_t & group,xnodebitset & nodebits,const uint32_t sig_threshold,std::set<std::string> & exclude_accounts,std::set<std::string> & exclude_keys);
+
+            basic::xlru_cache<std::string,std::shared_ptr<xgroup_pubkeys_t>>  m_group_pubkeys{enum_group_pubkeys_cache_max};
         };
         
     }; //end of namespace of auth
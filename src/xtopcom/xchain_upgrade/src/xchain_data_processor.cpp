@@ -15,6 +15,11 @@
 #include "xdata/xproperty.h"
 #include "xvledger/xvledger.h"
 
+#include <cctype>
+#include <functional>
+#include <map>
+#include <mutex>
+
 using json = nlohmann::json;
 
 // cannot modify if set
@@ -25,8 +30,177 @@ namespace top
 {
     namespace chain_data
     {
-        auto stake_property_json_parse = json::parse(stake_property_json);
-        auto user_property_json_parse = json::parse(user_property_json);
+        namespace {
+        // the data stays in the read-only segment of the binary which the os pages in on access. only the span of each
+        // account is indexed, an account is parsed when it is asked for instead of the whole text at startup.
+        class xchain_data_index_t {
+        public:
+            explicit xchain_data_index_t(char const * text) : m_text{text} {
+            }
+
+            bool find(std::string const & account, json & j) {
+                std::pair<char const *, std::size_t> span;
+                {
+                    std::lock_guard<std::mutex> lock{m_mutex};
+                    build();
+                    auto it = m_spans.find(account);
+                    if (it == m_spans.end()) {
+                        return false;
+                    }
+                    span = it->second;
+                }
+                j = json::parse(span.first, span.first + span.second);
+                return true;
+            }
+
+            void for_each(std::function<void(std::string const &, json const &)> const & f) {
+                std::map<std::string, std::pair<char const *, std::size_t>> spans;
+                {
+                    std::lock_guard<std::mutex> lock{m_mutex};
+                    build();
+                    spans = m_spans;
+                }
+                for (auto const & span : spans) {
+                    f(span.first, json::parse(span.second.first, span.second.first + span.second.second));
+                }
+            }
+
+            void release() {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_spans.clear();
+                m_built = true;
+            }
+
+        private:
+            static char const * skip_space(char const * p) {
+                while (*p != '\0' && std::isspace(static_cast<unsigned char>(*p))) {
+                    ++p;
+                }
+                return p;
+            }
+
+            // p is at the opening quote, returns the position after the closing one
+            static char const * skip_string(char const * p) {
+                for (++p; *p != '\0'; ++p) {
+                    if (*p == '\\') {
+                        if (*++p == '\0') {
+                            break;
+                        }
+                    } else if (*p == '"') {
+                        return p + 1;
+                    }
+                }
+                return nullptr;
+            }
+
+            static char const * skip_value(char const * p) {
+                if (*p == '"') {
+                    return skip_string(p);
+                }
+                if (*p != '{' && *p != '[') {
+                    while (*p != '\0' && *p != ',' && *p != '}' && !std::isspace(static_cast<unsigned char>(*p))) {
+                        ++p;
+                    }
+                    return p;
+                }
+                std::size_t depth = 0;
+                while (*p != '\0') {
+                    if (*p == '"') {
+                        p = skip_string(p);
+                        if (p == nullptr) {
+                            return nullptr;
+                        }
+                        continue;
+                    }
+                    if (*p == '{' || *p == '[') {
+                        ++depth;
+                    } else if ((*p == '}' || *p == ']') && --depth == 0) {
+                        return p + 1;
+                    }
+                    ++p;
+                }
+                return nullptr;
+            }
+
+            void build() {
+                if (m_built) {
+                    return;
+                }
+                m_built = true;
+
+                char const * p = skip_space(m_text);
+                if (*p == '{') {
+                    p = skip_space(p + 1);
+                    while (*p == '"') {
+                        auto const key_end = skip_string(p);
+                        if (key_end == nullptr) {
+                            break;
+                        }
+                        // keys are account addresses, nothing is escaped in them
+                        std::string account{p + 1, static_cast<std::size_t>(key_end - p - 2)};
+                        p = skip_space(key_end);
+                        if (*p != ':') {
+                            break;
+                        }
+                        auto const value_begin = skip_space(p + 1);
+                        auto const value_end = skip_value(value_begin);
+                        if (value_end == nullptr) {
+                            break;
+                        }
+                        m_spans[account] = std::make_pair(value_begin, static_cast<std::size_t>(value_end - value_begin));
+                        p = skip_space(value_end);
+                        if (*p != ',') {
+                            break;
+                        }
+                        p = skip_space(p + 1);
+                    }
+                }
+                if (*p != '}') {
+                    xerror("[xchain_data_index_t::build] malformed data at offset %zu", static_cast<std::size_t>(p - m_text));
+                    m_spans.clear();
+                    return;
+                }
+                xinfo("[xchain_data_index_t::build] accounts: %zu", m_spans.size());
+            }
+
+            char const * m_text;
+            std::mutex m_mutex;
+            bool m_built{false};
+            std::map<std::string, std::pair<char const *, std::size_t>> m_spans;
+        };
+
+        xchain_data_index_t & stake_data_index() {
+            static xchain_data_index_t index{stake_property_json};
+            return index;
+        }
+
+        xchain_data_index_t & user_data_index() {
+            static xchain_data_index_t index{user_property_json};
+            return index;
+        }
+
+        void read_account_data(std::string const & account, json const & j, data_processor_t & data) {
+            auto read_uint64 = [&j](std::string const & property) -> int64_t {
+                return j.count(property) ? base::xstring_utl::touint64(j.at(property).get<std::string>()) : 0;
+            };
+            data.address = account;
+            data.top_balance = read_uint64(data::XPROPERTY_BALANCE_AVAILABLE);
+            data.burn_balance = read_uint64(data::XPROPERTY_BALANCE_BURN);
+            data.tgas_balance = read_uint64(data::XPROPERTY_BALANCE_PLEDGE_TGAS);
+            data.vote_balance = read_uint64(data::XPROPERTY_BALANCE_PLEDGE_VOTE);
+            data.lock_balance = read_uint64(data::XPROPERTY_BALANCE_LOCK);
+            data.lock_tgas = read_uint64(data::XPROPERTY_LOCK_TGAS);
+            data.unvote_num = read_uint64(data::XPROPERTY_UNVOTE_NUM);
+            data.create_time = read_uint64(data::XPROPERTY_ACCOUNT_CREATE_TIME);
+            data.lock_token = read_uint64(data::XPROPERTY_LOCK_TOKEN_KEY);
+            if (j.count(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
+                for (auto const & item : j.at(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
+                    data.pledge_vote.emplace_back(base::xstring_utl::base64_decode(item));
+                }
+            }
+            data.expire_vote = read_uint64(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY);
+        }
+        }  // namespace
 
         bool xtop_chain_data_processor::check_state() {
             if (DATA_PROCESS_V != base::xvchain_t::instance().get_xdbstore()->get_value(DATA_PROCESS_K)) {
@@ -44,30 +218,13 @@ namespace top
             return true;
         }
 
-        void xtop_chain_data_processor::get_all_user_data(std::vector<data_processor_t> & data_vec) 
+        void xtop_chain_data_processor::get_all_user_data(std::vector<data_processor_t> & data_vec)
         {
-            for (auto it = user_property_json_parse.begin(); it != user_property_json_parse.end(); it++) {
-                common::xlegacy_account_address_t account_address{it.key()};
+            user_data_index().for_each([&data_vec](std::string const & account, json const & j) {
                 data_processor_t data;
-                data.address = it.key();
-                data.top_balance = (it->count(data::XPROPERTY_BALANCE_AVAILABLE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_AVAILABLE).get<std::string>())) : 0;
-                data.burn_balance = (it->count(data::XPROPERTY_BALANCE_BURN)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_BURN).get<std::string>())) : 0;
-                data.tgas_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_TGAS).get<std::string>())) : 0;
-                data.vote_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_VOTE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_VOTE).get<std::string>())) : 0;
-                data.lock_balance = (it->count(data::XPROPERTY_BALANCE_LOCK)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_LOCK).get<std::string>())) : 0;
-                data.lock_tgas = (it->count(data::XPROPERTY_LOCK_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TGAS).get<std::string>())) : 0;
-                data.unvote_num = (it->count(data::XPROPERTY_UNVOTE_NUM)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_UNVOTE_NUM).get<std::string>())) : 0;
-                data.create_time = (it->count(data::XPROPERTY_ACCOUNT_CREATE_TIME)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_ACCOUNT_CREATE_TIME).get<std::string>())) : 0;
-                data.lock_token = (it->count(data::XPROPERTY_LOCK_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TOKEN_KEY).get<std::string>())) : 0;
-                if (it->count(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                    for(auto const & item : it->at(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                        std::string str = base::xstring_utl::base64_decode(item);
-                        data.pledge_vote.emplace_back(str);
-                    }
-                }
-                data.expire_vote = (it->count(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY).get<std::string>())) : 0;
-                data_vec.emplace_back(data);
-            }
+                read_account_data(account, j, data);
+                data_vec.emplace_back(std::move(data));
+            });
         }
 
         std::map<common::xaccount_address_t, data_processor_t> xtop_chain_data_processor::get_all_user_data() {
@@ -81,86 +238,34 @@ namespace top
         }
 
         void xtop_chain_data_processor::get_user_data(common::xlegacy_account_address_t const &addr, data_processor_t & data) {
-            std::string account = addr.to_string();
-            auto it = user_property_json_parse.find(account);
-            if(it != user_property_json_parse.end())
-            {
-                data.address = it.key();
-                data.top_balance = (it->count(data::XPROPERTY_BALANCE_AVAILABLE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_AVAILABLE).get<std::string>())) : 0;
-                data.burn_balance = (it->count(data::XPROPERTY_BALANCE_BURN)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_BURN).get<std::string>())) : 0;
-                data.tgas_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_TGAS).get<std::string>())) : 0;
-                data.vote_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_VOTE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_VOTE).get<std::string>())) : 0;
-                data.lock_balance = (it->count(data::XPROPERTY_BALANCE_LOCK)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_LOCK).get<std::string>())) : 0;
-                data.lock_tgas = (it->count(data::XPROPERTY_LOCK_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TGAS).get<std::string>())) : 0;
-                data.unvote_num = (it->count(data::XPROPERTY_UNVOTE_NUM)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_UNVOTE_NUM).get<std::string>())) : 0;
-                data.create_time = (it->count(data::XPROPERTY_ACCOUNT_CREATE_TIME)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_ACCOUNT_CREATE_TIME).get<std::string>())) : 0;
-                data.lock_token = (it->count(data::XPROPERTY_LOCK_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TOKEN_KEY).get<std::string>())) : 0;
-                if (it->count(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                    for(auto const & item : it->at(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                        std::string str = base::xstring_utl::base64_decode(item);
-                        data.pledge_vote.emplace_back(str);
-                    }
-                }
-                data.expire_vote = (it->count(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY).get<std::string>())) : 0;
+            json j;
+            if (user_data_index().find(addr.to_string(), j)) {
+                read_account_data(addr.to_string(), j, data);
             }
         }
 
-        void xtop_chain_data_processor::get_all_contract_data(std::vector<data_processor_t> & data_vec) 
+        void xtop_chain_data_processor::get_all_contract_data(std::vector<data_processor_t> & data_vec)
         {
-            for (auto it = stake_property_json_parse.begin(); it != stake_property_json_parse.end(); it++) {
-                common::xlegacy_account_address_t account_address{it.key()};
+            stake_data_index().for_each([&data_vec](std::string const & account, json const & j) {
                 data_processor_t data;
-                data.address = it.key();
-                data.top_balance = (it->count(data::XPROPERTY_BALANCE_AVAILABLE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_AVAILABLE).get<std::string>())) : 0;
-                data.burn_balance = (it->count(data::XPROPERTY_BALANCE_BURN)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_BURN).get<std::string>())) : 0;
-                data.tgas_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_TGAS).get<std::string>())) : 0;
-                data.vote_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_VOTE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_VOTE).get<std::string>())) : 0;
-                data.lock_balance = (it->count(data::XPROPERTY_BALANCE_LOCK)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_LOCK).get<std::string>())) : 0;
-                data.lock_tgas = (it->count(data::XPROPERTY_LOCK_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TGAS).get<std::string>())) : 0;
-                data.unvote_num = (it->count(data::XPROPERTY_UNVOTE_NUM)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_UNVOTE_NUM).get<std::string>())) : 0;
-                data.create_time = (it->count(data::XPROPERTY_ACCOUNT_CREATE_TIME)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_ACCOUNT_CREATE_TIME).get<std::string>())) : 0;
-                data.lock_token = (it->count(data::XPROPERTY_LOCK_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TOKEN_KEY).get<std::string>())) : 0;
-                if (it->count(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                    for(auto const & item : it->at(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                        std::string str = base::xstring_utl::base64_decode(item);
-                        data.pledge_vote.emplace_back(str);
-                    }
-                }
-                data.expire_vote = (it->count(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY).get<std::string>())) : 0;
-                data_vec.emplace_back(data);
-            }
+                read_account_data(account, j, data);
+                data_vec.emplace_back(std::move(data));
+            });
         }
 
         void xtop_chain_data_processor::get_contract_data(common::xlegacy_account_address_t const & addr, data_processor_t & data) {
-            std::string account = addr.to_string();
-            auto it = stake_property_json_parse.find(account);
-            if(it != stake_property_json_parse.end())
-            {
-                data.address = it.key();
-                data.top_balance = (it->count(data::XPROPERTY_BALANCE_AVAILABLE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_AVAILABLE).get<std::string>())) : 0;
-                data.burn_balance = (it->count(data::XPROPERTY_BALANCE_BURN)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_BURN).get<std::string>())) : 0;
-                data.tgas_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_TGAS).get<std::string>())) : 0;
-                data.vote_balance = (it->count(data::XPROPERTY_BALANCE_PLEDGE_VOTE)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_PLEDGE_VOTE).get<std::string>())) : 0;
-                data.lock_balance = (it->count(data::XPROPERTY_BALANCE_LOCK)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_BALANCE_LOCK).get<std::string>())) : 0;
-                data.lock_tgas = (it->count(data::XPROPERTY_LOCK_TGAS)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TGAS).get<std::string>())) : 0;
-                data.unvote_num = (it->count(data::XPROPERTY_UNVOTE_NUM)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_UNVOTE_NUM).get<std::string>())) : 0;
-                data.create_time = (it->count(data::XPROPERTY_ACCOUNT_CREATE_TIME)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_ACCOUNT_CREATE_TIME).get<std::string>())) : 0;
-                data.lock_token = (it->count(data::XPROPERTY_LOCK_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_LOCK_TOKEN_KEY).get<std::string>())) : 0;
-                if (it->count(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                    for(auto const & item : it->at(data::XPROPERTY_PLEDGE_VOTE_KEY)) {
-                        std::string str = base::xstring_utl::base64_decode(item);
-                        data.pledge_vote.emplace_back(str);
-                    }
-                }
-                data.expire_vote = (it->count(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY)) ? base::xstring_utl::touint64(static_cast<std::string>(it->at(data::XPROPERTY_EXPIRE_VOTE_TOKEN_KEY).get<std::string>())) : 0;
+            json j;
+            if (stake_data_index().find(addr.to_string(), j)) {
+                read_account_data(addr.to_string(), j, data);
             }
         }
 
         void xtop_chain_data_processor::get_stake_string_property(common::xlegacy_account_address_t const & addr, std::string const & property, std::string & value)
         {
-            if (stake_property_json_parse.count(addr.to_string())) 
+            json j;
+            if (stake_data_index().find(addr.to_string(), j))
             {
-                value = base::xstring_utl::base64_decode(stake_property_json_parse.at(addr.to_string()).at(property));
+                value = base::xstring_utl::base64_decode(j.at(property));
             }
         }
 
@@ -168,9 +273,10 @@ namespace top
                                                                std::string const & property,
                                                                std::vector<std::pair<std::string, std::string>> & map)
         {
-            if (stake_property_json_parse.count(addr.to_string())) 
+            json j;
+            if (stake_data_index().find(addr.to_string(), j))
             {
-                auto data = stake_property_json_parse.at(addr.to_string()).at(property);
+                auto const & data = j.at(property);
                 for (auto _p = data.begin(); _p != data.end(); ++_p)
                 {
                     map.push_back(std::make_pair(base::xstring_utl::base64_decode(_p.key()), base::xstring_utl::base64_decode(_p.value())));
@@ -180,8 +286,8 @@ namespace top
 
         void xtop_chain_data_processor::release() {
             xdbg("[xtop_chain_data_processor::release] db reset finish, clear data memory!");
-            stake_property_json_parse.clear();
-            user_property_json_parse.clear();
+            stake_data_index().release();
+            user_data_index().release();
         }
     }
 }
@@ -10,10 +10,79 @@
 
 #include <msgpack.hpp>
 
+#include <memory>
 #include <system_error>
 
 NS_BEG3(top, codec, decorators)
 
+/// @brief msgpack stream appending into a byte buffer.
+struct xtop_msgpack_byte_buffer_writer final {
+    xbyte_buffer_t & buffer;
+
+    void write(char const * data, std::size_t const size) {
+        buffer.insert(buffer.end(), reinterpret_cast<xbyte_t const *>(data), reinterpret_cast<xbyte_t const *>(data) + size);
+    }
+};
+using xmsgpack_byte_buffer_writer_t = xtop_msgpack_byte_buffer_writer;
+
+/// @brief Returns a thread's scratch resource to its empty state for the next use.
+inline void reset_thread_resource(msgpack::zone & zone) {
+    // keeps the first chunk, so decoding a message that fits in it does not allocate
+    zone.clear();
+}
+
+inline void reset_thread_resource(xbyte_buffer_t & buffer) {
+    constexpr std::size_t max_retained_capacity{1024 * 1024};
+    buffer.clear();
+    if (buffer.capacity() > max_retained_capacity) {
+        xbyte_buffer_t{}.swap(buffer);
+    }
+}
+
+/// @brief Scratch resource of the thread, or a fresh one when the thread's is in use by an encode or decode that
+///        this one runs nested in (adaptors may encode or decode inner messages).
+template <typename ResourceT>
+class xtop_msgpack_thread_lease final {
+    struct xslot_t {
+        ResourceT resource{};
+        bool busy{false};
+    };
+
+    static xslot_t & thread_slot() {
+        thread_local xslot_t slot;
+        return slot;
+    }
+
+    xslot_t * m_slot;
+    std::unique_ptr<ResourceT> m_own;
+
+public:
+    xtop_msgpack_thread_lease(xtop_msgpack_thread_lease const &)             = delete;
+    xtop_msgpack_thread_lease & operator=(xtop_msgpack_thread_lease const &) = delete;
+
+    xtop_msgpack_thread_lease() : m_slot{thread_slot().busy ? nullptr : &thread_slot()} {
+        if (m_slot != nullptr) {
+            m_slot->busy = true;
+        } else {
+            m_own.reset(new ResourceT{});
+        }
+    }
+
+    ~xtop_msgpack_thread_lease() {
+        if (m_slot != nullptr) {
+            reset_thread_resource(m_slot->resource);
+            m_slot->busy = false;
+        }
+    }
+
+    ResourceT & get() noexcept {
+        return m_slot != nullptr ? m_slot->resource : *m_own;
+    }
+};
+
+template <typename ResourceT>
+using xmsgpack_thread_lease_t = xtop_msgpack_thread_lease<ResourceT>;
+
 template <typename T>
 struct xtop_msgpack_decorator final
 {
@@ -30,10 +99,13 @@ struct xtop_msgpack_decorator final
     xbyte_buffer_t
     encode(message_type const & message) {
         try {
-            msgpack::sbuffer buffer;
-            msgpack::pack(buffer, message);
+            // packed into the thread's buffer, which has grown to the messages of the thread already, and copied
+            // out once at the exact size
+            xmsgpack_thread_lease_t<xbyte_buffer_t> lease;
+            xmsgpack_byte_buffer_writer_t writer{lease.get()};
+            msgpack::pack(writer, message);
 
-            return { buffer.data(), buffer.data() + buffer.size() };
+            return { lease.get().begin(), lease.get().end() };
         } catch (...) {
             top::error::throw_error(top::codec::xcodec_errc_t::encode_error, "msgpack encode error");
             return {};
@@ -44,9 +116,7 @@ struct xtop_msgpack_decorator final
     message_type
     decode(xbyte_buffer_t const & in) {
         try {
-            auto object_handle = msgpack::unpack(reinterpret_cast<char const *>(in.data()), in.size(), nullptr);
-            auto object = object_handle.get();
-            return object.as<T>();
+            return unpack(in);
         } catch (...) {
             top::error::throw_error(top::codec::xcodec_errc_t::decode_error, "msgpack decode error");
             return {};
@@ -55,14 +125,25 @@ struct xtop_msgpack_decorator final
 
     static message_type decode(xbyte_buffer_t const & in, std::error_code & ec) {
         try {
-            auto object_handle = msgpack::unpack(reinterpret_cast<char const *>(in.data()), in.size(), nullptr);
-            auto object = object_handle.get();
-            return object.as<T>();
+            return unpack(in);
         } catch (...) {
             ec = top::codec::xcodec_errc_t::decode_error;
             return {};
         }
     }
+
+private:
+    // strings, bins and exts of the object point into in instead of being copied into the zone first,
+    // in outlives the conversion below
+    static bool reference_input(msgpack::type::object_type, std::size_t, void *) {
+        return true;
+    }
+
+    static message_type unpack(xbyte_buffer_t const & in) {
+        xmsgpack_thread_lease_t<msgpack::zone> lease;
+        auto object = msgpack::unpack(lease.get(), reinterpret_cast<char const *>(in.data()), in.size(), &reference_input);
+        return object.as<T>();
+    }
 };
 
 template <typename T>
@@ -0,0 +1,45 @@
+// Copyright (c) 2017-2023 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xcommon/xaccount_address_intern.h"
+
+NS_BEG2(top, common)
+
+constexpr std::size_t xtop_account_address_intern_table::shard_count;
+constexpr std::size_t xtop_account_address_intern_table::max_size;
+constexpr uint32_t xtop_account_address_intern_table::no_id;
+
+xtop_account_address_intern_table::xtop_account_address_intern_table() {
+    for (auto & shard : m_shards) {
+        shard.reset(new xshard_t);
+    }
+}
+
+xtop_account_address_intern_table & xtop_account_address_intern_table::instance() {
+    static xtop_account_address_intern_table table;
+    return table;
+}
+
+uint32_t xtop_account_address_intern_table::intern(std::string const & account_string, uint64_t const hash) {
+    auto & shard = *m_shards[hash % shard_count];
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    auto it = shard.ids.find(account_string);
+    if (it != shard.ids.end()) {
+        return it->second;
+    }
+
+    // the counter is only taken under a shard lock, so it overshoots max_size by shard_count at most
+    if (m_next_id.load(std::memory_order_relaxed) > max_size) {
+        return no_id;
+    }
+    auto const id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+    shard.ids.emplace(account_string, id);
+    return id;
+}
+
+std::size_t xtop_account_address_intern_table::size() const noexcept {
+    return m_next_id.load(std::memory_order_relaxed) - 1;
+}
+
+NS_END2
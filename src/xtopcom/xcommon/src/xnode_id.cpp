@@ -6,6 +6,7 @@
 
 #include "xbase/xutl.h"
 #include "xbasic/xbyte_buffer.h"
+#include "xcommon/xaccount_address_intern.h"
 #include "xcommon/xerror/xerror.h"
 #include "xcommon/xeth_address.h"
 #include "xutility/xhash.h"
@@ -47,6 +48,7 @@ xtop_node_id::xtop_node_id(xaccount_base_address_t base_address, uint16_t const
 
 xtop_node_id::xtop_node_id(xaccount_base_address_t base_address, xtable_id_t const table_id)
   : m_account_base_address{std::move(base_address)}, m_account_string{m_account_base_address.to_string() + "@" + top::to_string(table_id)}, m_assigned_table_id{table_id} {
+    intern();
 }
 
 xtop_node_id xtop_node_id::build_from(std::string const & account_string, std::error_code & ec) {
@@ -101,11 +103,11 @@ xaccount_base_address_t const & xtop_node_id::base_address() const noexcept {
 }
 
 uint64_t xtop_node_id::hash() const {
-    if (has_value()) {
-        return utl::xxh64_t::digest(m_account_string.data(), m_account_string.size());
-    }
+    return m_hash;
+}
 
-    return 0;
+uint32_t xtop_node_id::interned_id() const noexcept {
+    return m_interned_id;
 }
 
 std::string const & xtop_node_id::to_string() const noexcept {
@@ -116,6 +118,8 @@ void xtop_node_id::clear() {
     m_assigned_table_id.clear();
     m_account_base_address.clear();
     m_account_string.clear();
+    m_hash = 0;
+    m_interned_id = xaccount_address_intern_table_t::no_id;
 }
 
 void
@@ -123,14 +127,24 @@ xtop_node_id::swap(xtop_node_id & other) noexcept {
     std::swap(m_account_string, other.m_account_string);
     std::swap(m_account_base_address, other.m_account_base_address);
     std::swap(m_assigned_table_id, other.m_assigned_table_id);
+    std::swap(m_account_id, other.m_account_id);
+    std::swap(m_hash, other.m_hash);
+    std::swap(m_interned_id, other.m_interned_id);
 }
 
 bool
 xtop_node_id::operator==(xtop_node_id const & other) const noexcept {
+    if (m_interned_id != xaccount_address_intern_table_t::no_id && other.m_interned_id != xaccount_address_intern_table_t::no_id) {
+        return m_interned_id == other.m_interned_id;
+    }
     return m_account_string == other.m_account_string;
 }
 
 bool xtop_node_id::operator<(xtop_node_id const & other) const noexcept {
+    // ids are not ordered as the strings, ordered containers keep the string order
+    if (m_interned_id != xaccount_address_intern_table_t::no_id && m_interned_id == other.m_interned_id) {
+        return false;
+    }
     return m_account_string < other.m_account_string;
 }
 
@@ -259,6 +273,12 @@ void xtop_node_id::parse() {
     }
 
     m_account_id = xaccount_id_t{m_account_string};
+    intern();
+}
+
+void xtop_node_id::intern() {
+    m_hash = utl::xxh64_t::digest(m_account_string.data(), m_account_string.size());
+    m_interned_id = xaccount_address_intern_table_t::instance().intern(m_account_string, m_hash);
 }
 
 std::int32_t
@@ -300,7 +320,7 @@ NS_BEG1(std)
 
 std::size_t
 hash<top::common::xnode_id_t>::operator()(top::common::xnode_id_t const & id) const noexcept {
-    return std::hash<std::string>{}(id.value());
+    return static_cast<std::size_t>(id.hash());
 }
 
 NS_END1
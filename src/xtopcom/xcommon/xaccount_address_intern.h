@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2023 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+NS_BEG2(top, common)
+
+/// @brief Process wide table giving each account string a stable id, so equal addresses compare by integers.
+///        Ids are never reused. Once max_size strings are interned, new strings get no id and compare by string.
+class xtop_account_address_intern_table {
+public:
+    static constexpr std::size_t shard_count{32};
+    static constexpr std::size_t max_size{8 * 1024 * 1024};
+    static constexpr uint32_t no_id{0};
+
+    xtop_account_address_intern_table();
+    xtop_account_address_intern_table(xtop_account_address_intern_table const &) = delete;
+    xtop_account_address_intern_table & operator=(xtop_account_address_intern_table const &) = delete;
+
+    static xtop_account_address_intern_table & instance();
+
+    /// @brief The id of account_string, hash is its xxh64 digest and picks the shard.
+    uint32_t intern(std::string const & account_string, uint64_t hash);
+
+    std::size_t size() const noexcept;
+
+private:
+    struct xshard_t {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint32_t> ids;
+    };
+
+    std::array<std::unique_ptr<xshard_t>, shard_count> m_shards;
+    std::atomic<uint32_t> m_next_id{no_id + 1};
+};
+using xaccount_address_intern_table_t = xtop_account_address_intern_table;
+
+NS_END2
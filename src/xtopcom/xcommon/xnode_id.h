@@ -60,6 +60,8 @@ private:
     std::string m_account_string;
     xaccount_id_t m_account_id{};
     xtable_id_t m_assigned_table_id;
+    uint64_t m_hash{0};
+    uint32_t m_interned_id{0};  // id in xaccount_address_intern_table_t, 0 if not interned
     metrics_xtop_node_id m_nouse;
 
 public:
@@ -85,6 +87,7 @@ public:
     std::string const & value() const noexcept;
     xaccount_base_address_t const & base_address() const noexcept;
     uint64_t hash() const;
+    uint32_t interned_id() const noexcept;
     std::string const & to_string() const noexcept;
     void clear();
 
@@ -135,6 +138,7 @@ public:
 
 private:
     void parse();
+    void intern();
 
     std::int32_t
     do_read(base::xstream_t & stream);
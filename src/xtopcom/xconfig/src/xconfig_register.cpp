@@ -82,6 +82,7 @@ void xconfig_register_t::init_static_config() {
     XADD_OFFCHAIN_PARAMETER(executor_max_session_service_counts);
     XADD_OFFCHAIN_PARAMETER(executor_session_time_interval);
     XADD_OFFCHAIN_PARAMETER(executor_max_sessions);
+    XADD_OFFCHAIN_PARAMETER(sync_serve_max_bytes_per_second);
 
     XADD_OFFCHAIN_PARAMETER(grpc_port);
     XADD_OFFCHAIN_PARAMETER(dht_port);
@@ -89,6 +90,34 @@ void xconfig_register_t::init_static_config() {
     XADD_OFFCHAIN_PARAMETER(http_port);
     XADD_OFFCHAIN_PARAMETER(ws_port);
     XADD_OFFCHAIN_PARAMETER(evm_port);
+    XADD_OFFCHAIN_PARAMETER(rpc_io_threads);
+    XADD_OFFCHAIN_PARAMETER(rpc_worker_threads);
+    XADD_OFFCHAIN_PARAMETER(eth_getlogs_max_blocks);
+    XADD_OFFCHAIN_PARAMETER(eth_getlogs_max_logs);
+    XADD_OFFCHAIN_PARAMETER(eth_getlogs_worker_threads);
+    XADD_OFFCHAIN_PARAMETER(rpc_response_cache_bytes);
+    XADD_OFFCHAIN_PARAMETER(rpc_batch_max_requests);
+    XADD_OFFCHAIN_PARAMETER(rpc_batch_concurrency);
+    XADD_OFFCHAIN_PARAMETER(edge_local_query);
+    XADD_OFFCHAIN_PARAMETER(edge_local_query_max_lag_s);
+    XADD_OFFCHAIN_PARAMETER(tx_cache_max_bytes);
+    XADD_OFFCHAIN_PARAMETER(unitstate_cache_max_bytes);
+    XADD_OFFCHAIN_PARAMETER(unitstate_cache_reserved_bytes);
+    XADD_OFFCHAIN_PARAMETER(statestore_write_behind);
+    XADD_OFFCHAIN_PARAMETER(statestore_write_behind_max_blocks);
+    XADD_OFFCHAIN_PARAMETER(statestore_catchup_threads);
+    XADD_OFFCHAIN_PARAMETER(unitstate_snapshot_interval);
+    XADD_OFFCHAIN_PARAMETER(txstore_tx_index_filter_bytes);
+    XADD_OFFCHAIN_PARAMETER(evm_profile_sample_rate);
+    XADD_OFFCHAIN_PARAMETER(vnode_dispatch_threads);
+    XADD_OFFCHAIN_PARAMETER(vnode_dispatch_queue_size);
+    XADD_OFFCHAIN_PARAMETER(memory_soft_limits);
+    XADD_OFFCHAIN_PARAMETER(memory_check_interval_s);
+    XADD_OFFCHAIN_PARAMETER(thread_cpu_affinity);
+    XADD_OFFCHAIN_PARAMETER(vnetwork_payload_compression);
+    XADD_OFFCHAIN_PARAMETER(vnetwork_payload_compression_threshold);
+    XADD_OFFCHAIN_PARAMETER(hot_account_sample_rate);
+    XADD_OFFCHAIN_PARAMETER(genesis_bulk_threads);
     XADD_OFFCHAIN_PARAMETER(chain_id);
     XADD_OFFCHAIN_PARAMETER(network_id);
     XADD_OFFCHAIN_PARAMETER(log_level);
@@ -123,6 +152,10 @@ void xconfig_register_t::init_static_config() {
     XADD_OFFCHAIN_PARAMETER(slash_fulltable_interval);
     XADD_OFFCHAIN_PARAMETER(slash_table_split_num);
     XADD_OFFCHAIN_PARAMETER(prune_reserve_number);
+    XADD_OFFCHAIN_PARAMETER(prune_ops_per_second);
+    XADD_OFFCHAIN_PARAMETER(prune_blocks_per_second);
+    XADD_OFFCHAIN_PARAMETER(prune_table_state_ops_per_second);
+    XADD_OFFCHAIN_PARAMETER(prune_table_state_max_heights);
     XADD_OFFCHAIN_PARAMETER(evm_relay_txs_collection_interval);
     XADD_OFFCHAIN_PARAMETER(relayblock_batch_tx_max_num);
 
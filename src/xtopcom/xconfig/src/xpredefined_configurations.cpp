@@ -192,6 +192,7 @@ XDEFINE_CONFIGURATION(executor_max_total_sessions_service_counts);
 XDEFINE_CONFIGURATION(executor_max_session_service_counts);
 XDEFINE_CONFIGURATION(executor_session_time_interval);
 XDEFINE_CONFIGURATION(executor_max_sessions);
+XDEFINE_CONFIGURATION(sync_serve_max_bytes_per_second);
 XDEFINE_CONFIGURATION(recv_tx_cache_window);
 XDEFINE_CONFIGURATION(config_property_alias_name_max_len);
 XDEFINE_CONFIGURATION(account_send_queue_tx_max_num);
@@ -210,6 +211,10 @@ XDEFINE_CONFIGURATION(local_whitelist);
 XDEFINE_CONFIGURATION(slash_fulltable_interval);
 XDEFINE_CONFIGURATION(slash_table_split_num);
 XDEFINE_CONFIGURATION(prune_reserve_number);
+XDEFINE_CONFIGURATION(prune_ops_per_second);
+XDEFINE_CONFIGURATION(prune_blocks_per_second);
+XDEFINE_CONFIGURATION(prune_table_state_ops_per_second);
+XDEFINE_CONFIGURATION(prune_table_state_max_heights);
 
 XDEFINE_CONFIGURATION(evm_relay_txs_collection_interval);
 XDEFINE_CONFIGURATION(relayblock_batch_tx_max_num);
@@ -223,6 +228,34 @@ XDEFINE_CONFIGURATION(dht_port);
 XDEFINE_CONFIGURATION(msg_port);
 XDEFINE_CONFIGURATION(ws_port);
 XDEFINE_CONFIGURATION(evm_port);
+XDEFINE_CONFIGURATION(rpc_io_threads);
+XDEFINE_CONFIGURATION(rpc_worker_threads);
+XDEFINE_CONFIGURATION(eth_getlogs_max_blocks);
+XDEFINE_CONFIGURATION(eth_getlogs_max_logs);
+XDEFINE_CONFIGURATION(eth_getlogs_worker_threads);
+XDEFINE_CONFIGURATION(rpc_response_cache_bytes);
+XDEFINE_CONFIGURATION(rpc_batch_max_requests);
+XDEFINE_CONFIGURATION(rpc_batch_concurrency);
+XDEFINE_CONFIGURATION(edge_local_query);
+XDEFINE_CONFIGURATION(edge_local_query_max_lag_s);
+XDEFINE_CONFIGURATION(tx_cache_max_bytes);
+XDEFINE_CONFIGURATION(unitstate_cache_max_bytes);
+XDEFINE_CONFIGURATION(unitstate_cache_reserved_bytes);
+XDEFINE_CONFIGURATION(statestore_write_behind);
+XDEFINE_CONFIGURATION(statestore_write_behind_max_blocks);
+XDEFINE_CONFIGURATION(statestore_catchup_threads);
+XDEFINE_CONFIGURATION(unitstate_snapshot_interval);
+XDEFINE_CONFIGURATION(txstore_tx_index_filter_bytes);
+XDEFINE_CONFIGURATION(evm_profile_sample_rate);
+XDEFINE_CONFIGURATION(vnode_dispatch_threads);
+XDEFINE_CONFIGURATION(vnode_dispatch_queue_size);
+XDEFINE_CONFIGURATION(memory_soft_limits);
+XDEFINE_CONFIGURATION(memory_check_interval_s);
+XDEFINE_CONFIGURATION(thread_cpu_affinity);
+XDEFINE_CONFIGURATION(vnetwork_payload_compression);
+XDEFINE_CONFIGURATION(vnetwork_payload_compression_threshold);
+XDEFINE_CONFIGURATION(hot_account_sample_rate);
+XDEFINE_CONFIGURATION(genesis_bulk_threads);
 XDEFINE_CONFIGURATION(chain_id);
 XDEFINE_CONFIGURATION(network_id);
 XDEFINE_CONFIGURATION(log_level);
@@ -472,6 +472,7 @@ XDECLARE_CONFIGURATION(executor_max_total_sessions_service_counts, std::uint32_t
 XDECLARE_CONFIGURATION(executor_max_session_service_counts, std::uint32_t, 600);         // service count per session per time interval
 XDECLARE_CONFIGURATION(executor_session_time_interval, std::uint32_t, 60);               // seconds
 XDECLARE_CONFIGURATION(executor_max_sessions, std::uint32_t, 10000);                     // max session in cache
+XDECLARE_CONFIGURATION(sync_serve_max_bytes_per_second, std::uint64_t, 100 * 1024 * 1024); // byte budget of served sync responses, 0 is unlimited
 XDECLARE_CONFIGURATION(leader_election_round, std::uint32_t, 2);
 #ifdef NO_TX_BATCH
 XDECLARE_CONFIGURATION(unitblock_confirm_tx_batch_num, std::uint32_t, 1);
@@ -524,6 +525,34 @@ XDECLARE_CONFIGURATION(dht_port, uint16_t, 19083);
 XDECLARE_CONFIGURATION(msg_port, uint16_t, 19084);
 XDECLARE_CONFIGURATION(ws_port, uint16_t, 19085);
 XDECLARE_CONFIGURATION(evm_port, uint16_t, 8080);
+XDECLARE_CONFIGURATION(rpc_io_threads, uint32_t, 2);      // socket threads of each rpc server
+XDECLARE_CONFIGURATION(rpc_worker_threads, uint32_t, 4);  // request threads of each rpc server, 0 runs requests on the socket threads
+XDECLARE_CONFIGURATION(eth_getlogs_max_blocks, uint64_t, 8192);  // block range of one eth_getLogs
+XDECLARE_CONFIGURATION(eth_getlogs_max_logs, uint32_t, 1024);    // logs returned by one eth_getLogs
+XDECLARE_CONFIGURATION(eth_getlogs_worker_threads, uint32_t, 2); // threads of eth_getLogs on archive nodes, 0 runs them on the rpc thread
+XDECLARE_CONFIGURATION(rpc_response_cache_bytes, uint64_t, 64 * 1024 * 1024);  // results of queries on finalized data, 0 disables
+XDECLARE_CONFIGURATION(rpc_batch_max_requests, uint32_t, 100);  // requests in one json-rpc batch
+XDECLARE_CONFIGURATION(rpc_batch_concurrency, uint32_t, 16);    // requests of one batch running at the same time
+XDECLARE_CONFIGURATION(edge_local_query, bool, false);               // edges sync the eth table and answer its reads themselves
+XDECLARE_CONFIGURATION(edge_local_query_max_lag_s, uint32_t, 30);    // older local views forward the reads as usual
+XDECLARE_CONFIGURATION(tx_cache_max_bytes, uint64_t, 128 * 1024 * 1024);  // origin txs kept for getTransaction until confirmed
+XDECLARE_CONFIGURATION(unitstate_cache_max_bytes, uint64_t, 256 * 1024 * 1024);      // unit states of all tables of the node
+XDECLARE_CONFIGURATION(unitstate_cache_reserved_bytes, uint64_t, 64 * 1024 * 1024);  // part of it kept for the states of executed blocks
+XDECLARE_CONFIGURATION(statestore_write_behind, bool, true);                          // states of executed table blocks written to db in background
+XDECLARE_CONFIGURATION(statestore_write_behind_max_blocks, uint32_t, 64);             // blocks of a table pending write before the commit waits
+XDECLARE_CONFIGURATION(statestore_catchup_threads, uint32_t, 8);                       // threads executing the committed blocks left unexecuted at start, 0 to execute on demand only
+XDECLARE_CONFIGURATION(unitstate_snapshot_interval, uint32_t, 32);                      // unit states stored in full every n heights and as the delta to the previous state between, 0 to store full states only
+XDECLARE_CONFIGURATION(txstore_tx_index_filter_bytes, uint32_t, 128 * 1024 * 1024);     // bloom filter of tx hashes with index in db, about 10 bits each, 0 to disable
+XDECLARE_CONFIGURATION(evm_profile_sample_rate, uint32_t, 0);  // one of every n evm executions exports its profile to metrics, 0 disables
+XDECLARE_CONFIGURATION(vnode_dispatch_threads, uint32_t, 1);           // threads delivering the messages of each vnode, more than 1 gives up the arrival order
+XDECLARE_CONFIGURATION(vnode_dispatch_queue_size, uint32_t, 20000);    // messages of a vnode waiting for delivery, the newer ones are dropped when full
+XDECLARE_CONFIGURATION(memory_soft_limits, const char *, "");          // soft limits in MB of the caches, e.g. "blockstore_cache:2048,rocksdb_block_cache:1024", see GET /debug/memory of admin http for the names
+XDECLARE_CONFIGURATION(memory_check_interval_s, uint32_t, 10);         // seconds between two reads of the memory of the caches and the enforcement of their soft limits
+XDECLARE_CONFIGURATION(thread_cpu_affinity, const char *, "");         // cpus of the threads by name prefix, e.g. "cons_worker:0-7;xbft_worker:0-7;rpc:8-11;rocksdb:12-15", empty to not pin
+XDECLARE_CONFIGURATION(vnetwork_payload_compression, bool, false);      // lz4 compress large vnetwork payloads; enable once all peers run a version that decompresses them
+XDECLARE_CONFIGURATION(vnetwork_payload_compression_threshold, uint32_t, 4096);  // payloads of at least this many bytes are compressed
+XDECLARE_CONFIGURATION(hot_account_sample_rate, uint32_t, 0);          // one of every n txpool pushes, state loads and executions ranks the hot accounts of its table, 0 disables, see GET /debug/hot_accounts of admin http
+XDECLARE_CONFIGURATION(genesis_bulk_threads, uint32_t, 0);             // threads creating the genesis blocks of data and genesis accounts at first start, 0 or 1 for one by one
 XDECLARE_CONFIGURATION(log_level, uint16_t, 0);
 #if defined(XBUILD_CI) || defined(XBUILD_DEV) || defined(XBUILD_GALILEO) || defined(XBUILD_BOUNTY)
 XDECLARE_CONFIGURATION(chain_id, uint32_t, 1023);
@@ -540,6 +569,10 @@ XDECLARE_CONFIGURATION(prune_reserve_number, std::uint64_t, 1024);
 #else
 XDECLARE_CONFIGURATION(prune_reserve_number, std::uint64_t, 10000);
 #endif
+XDECLARE_CONFIGURATION(prune_ops_per_second, std::uint32_t, 32);         // max delete/compact ops per second of background block pruner
+XDECLARE_CONFIGURATION(prune_blocks_per_second, std::uint64_t, 200000);  // max blocks deleted per second of background block pruner
+XDECLARE_CONFIGURATION(prune_table_state_ops_per_second, std::uint32_t, 16);     // max delete batches/compact ops per second of table state pruner, shared by all tables
+XDECLARE_CONFIGURATION(prune_table_state_max_heights, std::uint64_t, 4096);     // max table heights pruned by one run of table state pruner
 XDECLARE_CONFIGURATION(evm_json_rpc_port, uint16_t, 19086);
 
 /* end of development parameters */
@@ -114,7 +114,9 @@ contract_runtime::xtransaction_execution_result_t xtop_account_vm::execute_actio
     case data::xtop_action_type_t::system: {
         auto const * cons_action = static_cast<data::xsystem_consensus_action_t const *>(action.get());
         contract_common::xcontract_state_t contract_state{cons_action->contract_address(), make_observer(std::addressof(sa)), param};
-        result = sys_action_runtime_->new_session(make_observer(std::addressof(contract_state)))->execute_action(std::move(action));
+        // the session only binds the runtime and the state, a stack object spares a heap allocation per action
+        contract_runtime::xaction_session_t<data::xsystem_consensus_action_t> session{make_observer(sys_action_runtime_.get()), make_observer(std::addressof(contract_state))};
+        result = session.execute_action(std::move(action));
 
         XMETRICS_GAUGE(metrics::txexecutor_total_system_contract_count, 1);
         XMETRICS_GAUGE(
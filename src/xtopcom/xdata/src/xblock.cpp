@@ -161,16 +161,23 @@ int32_t xblock_t::full_block_serialize_to(base::xstream_t & stream) {
     std::string block_object_bin;
     this->serialize_to_string(block_object_bin);
     stream << block_object_bin;
+    // get_resources_data() combines all resources into a new string, so build each of them only once
+    size_t input_resources_size = 0;
+    size_t output_resources_size = 0;
     if (get_header()->get_block_class() != base::enum_xvblock_class_nil) {
-        stream << get_input()->get_resources_data();
-        stream << get_output()->get_resources_data();
+        std::string const input_resources = get_input()->get_resources_data();
+        stream << input_resources;
+        input_resources_size = input_resources.size();
+        std::string const output_resources = get_output()->get_resources_data();
+        stream << output_resources;
+        output_resources_size = output_resources.size();
         if (!get_output_offdata_hash().empty()) {
             stream << get_output_offdata();
         }
     }
 
     xdbg("xblock_t::full_block_serialize_to,succ.block=%s,size=%zu,%zu,%zu,%zu,%d",
-        dump().c_str(), block_object_bin.size(), get_input()->get_resources_data().size(), get_output()->get_resources_data().size(), get_output_offdata().size(), stream.size());
+        dump().c_str(), block_object_bin.size(), input_resources_size, output_resources_size, get_output_offdata().size(), stream.size());
     return CALC_LEN();
 }
 
@@ -476,6 +476,10 @@ std::vector<xlightunit_action_t> xblocktool_t::unpack_all_txreceipt_action(base:
 }
 
 std::vector<xlightunit_action_t> xblocktool_t::unpack_one_txreceipt_action(base::xvblock_t* commit_block, base::xtable_shortid_t peer_table_sid, uint64_t receipt_id, enum_transaction_subtype subtype) {
+    return unpack_txreceipt_actions(commit_block, peer_table_sid, std::set<uint64_t>{receipt_id}, subtype);
+}
+
+std::vector<xlightunit_action_t> xblocktool_t::unpack_txreceipt_actions(base::xvblock_t* commit_block, base::xtable_shortid_t peer_table_sid, const std::set<uint64_t> & receipt_ids, enum_transaction_subtype subtype) {
     if (commit_block == nullptr) {
         xassert(false);
         return {};
@@ -499,16 +503,18 @@ std::vector<xlightunit_action_t> xblocktool_t::unpack_one_txreceipt_action(base:
                 continue;
             }
             xlightunit_action_t txaction(action);
-            xinfo("xblocktool_t::create_one_txreceipt peer tableid:%d:%d, receiptid:%llu:%llu", peer_table_sid, txaction.get_receipt_id_peer_tableid(), receipt_id, txaction.get_receipt_id());
-            if (txaction.get_receipt_id_peer_tableid() != peer_table_sid || txaction.get_receipt_id() != receipt_id) {
+            if (txaction.get_receipt_id_peer_tableid() != peer_table_sid || receipt_ids.count(txaction.get_receipt_id()) == 0) {
                 continue;  
             }
+            xinfo("xblocktool_t::unpack_txreceipt_actions peer tableid:%d, receiptid:%llu", peer_table_sid, txaction.get_receipt_id());
             if (false == txaction.is_need_make_txreceipt()) {
                 xassert(false);
                 continue;  
             }
             txreceipt_actions.push_back(txaction);
-            break;
+            if (txreceipt_actions.size() == receipt_ids.size()) {
+                return txreceipt_actions;
+            }
         }
     }
     return txreceipt_actions;
@@ -582,6 +588,31 @@ xcons_transaction_ptr_t xblocktool_t::create_one_txreceipt(base::xvblock_t* comm
     return txreceipts[0];
 }
 
+std::vector<xcons_transaction_ptr_t> xblocktool_t::create_txreceipts(base::xvblock_t* commit_block,
+                                                                     base::xvblock_t* cert_block,
+                                                                     base::xtable_shortid_t peer_table_sid,
+                                                                     const std::set<uint64_t> & receipt_ids,
+                                                                     enum_transaction_subtype subtype) {
+    if (commit_block == nullptr || cert_block == nullptr || receipt_ids.empty()) {
+        xassert(false);
+        return {};
+    }
+    if (subtype != enum_transaction_subtype_send && subtype != enum_transaction_subtype_recv) {
+        xassert(false);
+        return {};
+    }
+
+    std::vector<xlightunit_action_t> txreceipt_actions = xblocktool_t::unpack_txreceipt_actions(commit_block, peer_table_sid, receipt_ids, subtype);
+    if (txreceipt_actions.size() != receipt_ids.size()) {
+        xerror("xblocktool_t::create_txreceipts not find all.block=%s,tableid:%d receiptids:%zu found:%zu,subtype=%d",
+               commit_block->dump().c_str(), peer_table_sid, receipt_ids.size(), txreceipt_actions.size(), subtype);
+        if (txreceipt_actions.empty()) {
+            return {};
+        }
+    }
+    return create_txreceipts(commit_block, cert_block, txreceipt_actions);
+}
+
 std::vector<xcons_transaction_ptr_t> xblocktool_t::create_all_txreceipts(base::xvblock_t* commit_block, base::xvblock_t* cert_block) {
     std::vector<xlightunit_action_t> txreceipt_actions = xblocktool_t::unpack_all_txreceipt_action(commit_block);
     if (txreceipt_actions.empty()) {
@@ -16,6 +16,7 @@
 #include "xmetrics/xmetrics.h"
 
 #include <cinttypes>
+#include <set>
 #include <string>
 
 NS_BEG2(top, data)
@@ -70,19 +71,47 @@ size_t xbstate_ctx_t::do_snapshot() {
 }
 
 bool xbstate_ctx_t::do_rollback() {
-    if (m_snapshot_canvas_height < m_canvas->get_op_records_size()) {
-        m_canvas->rollback(m_snapshot_canvas_height);
-        std::deque<base::xvmethod_t> records = m_canvas->clone();
+    size_t records_height = m_canvas->get_op_records_size();
+    if (m_snapshot_canvas_height >= records_height) {
+        return true;
+    }
 
-        base::xauto_ptr<base::xvbstate_t> _new_bstate = dynamic_cast<base::xvbstate_t *>(m_snapshot_origin_bstate->clone());
-        bool ret = _new_bstate->apply_changes_of_binlog(std::move(records));
+    // origin bstate is moved forward lazily to snapshot point, so snapshot only records canvas height
+    std::deque<base::xvmethod_t> forward_records = m_canvas->clone(m_origin_canvas_height, m_snapshot_canvas_height);
+    if (!forward_records.empty()) {
+        bool ret = m_snapshot_origin_bstate->apply_changes_of_binlog(std::move(forward_records));
         if (!ret) {
             xerror("xbstate_ctx_t::do_rollback fail-apply_changes_of_binlog");
             return ret;
         }
+    }
+    m_origin_canvas_height = m_snapshot_canvas_height;
+
+    // undo only properties changed after snapshot, instead of cloning the whole state
+    std::set<std::string> changed_properties;
+    bool all_known = true;
+    for (auto & op : m_canvas->clone(m_snapshot_canvas_height, records_height)) {
+        std::string property_name;
+        if (false == m_bstate->get_property_of_instruction(op, property_name)) {
+            all_known = false;
+            break;
+        }
+        changed_properties.insert(property_name);
+    }
+    m_canvas->rollback(m_snapshot_canvas_height);
+
+    if (all_known) {
+        for (auto & property_name : changed_properties) {
+            if (false == m_bstate->restore_property_from(*m_snapshot_origin_bstate, property_name)) {
+                xerror("xbstate_ctx_t::do_rollback fail-restore property %s", property_name.c_str());
+                return false;
+            }
+        }
+    } else {
+        base::xauto_ptr<base::xvbstate_t> _new_bstate = dynamic_cast<base::xvbstate_t *>(m_snapshot_origin_bstate->clone());
         m_bstate = _new_bstate;
-        xdbg("xbstate_ctx_t::do_rollback rollback addr %s", account_address().c_str());
     }
+    xdbg("xbstate_ctx_t::do_rollback rollback addr %s,properties=%zu,all_known=%d", account_address().c_str(), changed_properties.size(), all_known);
     return true;
 }
 
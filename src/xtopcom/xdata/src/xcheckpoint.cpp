@@ -5,7 +5,6 @@
 
 #include "xdata/xcheckpoint.h"
 
-#include "nlohmann/fifo_map.hpp"
 #include "nlohmann/json.hpp"
 #include "xdata/xcheckpoint_data.h"
 #include "xdata/xerror/xerror.h"
@@ -13,10 +12,6 @@
 
 #include <fstream>
 
-template <class K, class V, class dummy_compare, class A>
-using my_workaround_fifo_map = nlohmann::fifo_map<K, V, nlohmann::fifo_map_compare<K>, A>;
-using json = nlohmann::basic_json<my_workaround_fifo_map>;
-
 #define TABLE_DATA_KEY "table_data"
 #define UNIT_DATA_KEY "unit_data"
 #define BLOCK_HEIGHT_KEY "height"
@@ -25,61 +20,130 @@ using json = nlohmann::basic_json<my_workaround_fifo_map>;
 namespace top {
 namespace data {
 
+namespace {
+// cp data is {clock: {table: {"table_data": {height, hash}, "unit_data": {unit: {height, hash}}}}}, the map is built
+// from the parser events so the document of the whole text is never held in memory.
+class xcheckpoint_sax_t : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit xcheckpoint_sax_t(xcheckpoints_map_t & m) : m_map{m} {
+    }
+
+    bool null() override {
+        return true;
+    }
+    bool boolean(bool) override {
+        return true;
+    }
+    bool number_integer(number_integer_t) override {
+        return true;
+    }
+    bool number_unsigned(number_unsigned_t) override {
+        return true;
+    }
+    bool number_float(number_float_t, string_t const &) override {
+        return true;
+    }
+    bool start_array(std::size_t) override {
+        return true;
+    }
+    bool end_array() override {
+        return true;
+    }
+
+    bool string(string_t & val) override {
+        if (!in_block_data()) {
+            return true;
+        }
+        if (m_path.back() == BLOCK_HEIGHT_KEY) {
+            m_data.height = base::xstring_utl::touint64(val);
+            m_has_height = true;
+        } else if (m_path.back() == BLOCK_HASH_KEY) {
+            m_data.hash = base::xstring_utl::from_hex(val);
+            m_has_hash = true;
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        m_path.emplace_back();
+        return true;
+    }
+
+    bool key(string_t & val) override {
+        m_path.back() = val;
+        return true;
+    }
+
+    bool end_object() override {
+        if (in_block_data()) {
+            auto const & account = m_path.size() == 4 ? m_path[1] : m_path[3];
+            if (!m_has_height || !m_has_hash) {
+                xerror("[xtop_chain_checkpoint::load] %s lack of height or hash at clock %s", account.c_str(), m_path[0].c_str());
+                return false;
+            }
+            m_map[common::xaccount_address_t{account}].emplace(std::make_pair(base::xstring_utl::touint64(m_path[0]), m_data));
+            m_data = {};
+            m_has_height = false;
+            m_has_hash = false;
+        } else if (m_path.size() == 2) {
+            xinfo("[xtop_chain_checkpoint::load] load cp height: %s", m_path[0].c_str());
+        }
+        m_path.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t position, std::string const &, nlohmann::detail::exception const & ex) override {
+        xerror("[xtop_chain_checkpoint::load] parse error at %zu: %s", position, ex.what());
+        return false;
+    }
+
+private:
+    // inside the object of a table or a unit, the last key is the field
+    bool in_block_data() const {
+        return (m_path.size() == 4 && m_path[2] == TABLE_DATA_KEY) || (m_path.size() == 5 && m_path[2] == UNIT_DATA_KEY);
+    }
+
+    xcheckpoints_map_t & m_map;
+    std::vector<std::string> m_path;
+    xcheckpoint_data_t m_data;
+    bool m_has_height{false};
+    bool m_has_hash{false};
+};
+}  // namespace
+
 xcheckpoints_map_t xtop_chain_checkpoint::m_checkpoints_map;
+std::once_flag xtop_chain_checkpoint::m_load_flag;
 
 void xtop_chain_checkpoint::load() {
-    json j_data;
+    std::call_once(m_load_flag, load_once);
+}
+
+void xtop_chain_checkpoint::load_once() {
+    xcheckpoint_sax_t sax{m_checkpoints_map};
+    bool ret = true;
 #ifdef CHECKPOINT_TEST
 #    define CHECKPOINT_DATA_FILE "checkpoint_data.json"
     xinfo("[xtop_chain_checkpoint::load] load from file");
     std::ifstream data_file(CHECKPOINT_DATA_FILE);
     if (data_file.good()) {
-        data_file >> j_data;
+        ret = nlohmann::json::sax_parse(data_file, &sax);
         data_file.close();
     } else {
         xwarn("[xtop_chain_checkpoint::load] file %s open error, none cp data used!", CHECKPOINT_DATA_FILE);
     }
 #else
     xinfo("[xtop_chain_checkpoint::load] load from code");
-    j_data = json::parse(checkpoint_data());
+    ret = nlohmann::json::sax_parse(checkpoint_data(), &sax);
 #endif
-    auto load_data = [](json & j) -> xcheckpoints_map_t {
-        xcheckpoints_map_t m;
-        for (auto it = j.cbegin(); it != j.cend(); it++) {
-            auto clock_str = static_cast<std::string>(it.key());
-            auto clock = base::xstring_utl::touint64(clock_str);
-            auto const & data_map = it.value();
-            // table
-            for (auto it_table = data_map.cbegin(); it_table != data_map.cend(); it_table++) {
-                auto table_str = static_cast<std::string>(it_table.key());
-                auto const & table_data = it_table->at(TABLE_DATA_KEY);
-                {
-                    data::xcheckpoint_data_t data;
-                    data.height = base::xstring_utl::touint64(table_data.at(BLOCK_HEIGHT_KEY).get<std::string>());
-                    data.hash = base::xstring_utl::from_hex(table_data.at(BLOCK_HASH_KEY).get<std::string>());
-                    m[common::xaccount_address_t{table_str}].emplace(std::make_pair(clock, data));
-                }
-                auto const & unit_data_map = it_table->at(UNIT_DATA_KEY);
-                // unit
-                for (auto it_unit = unit_data_map.cbegin(); it_unit != unit_data_map.cend(); it_unit++) {
-                    auto unit_str = static_cast<std::string>(it_unit.key());
-                    auto const & unit_data = it_unit.value();
-                    data::xcheckpoint_data_t data;
-                    data.height = base::xstring_utl::touint64(unit_data.at(BLOCK_HEIGHT_KEY).get<std::string>());
-                    data.hash = base::xstring_utl::from_hex(unit_data.at(BLOCK_HASH_KEY).get<std::string>());
-                    m[common::xaccount_address_t{unit_str}].emplace(std::make_pair(clock, data));
-                }
-            }
-            xinfo("[xtop_chain_checkpoint::load] load cp height: %lu", clock);
-        }
-        return m;
-    };
-    m_checkpoints_map = load_data(j_data);
-    j_data.clear();
+    if (!ret) {
+        xerror("[xtop_chain_checkpoint::load] bad cp data, none cp data used!");
+        m_checkpoints_map.clear();
+    }
     xinfo("[xtop_chain_checkpoint::load] cp data size: %zu", m_checkpoints_map.size());
 }
 
 xcheckpoint_data_t xtop_chain_checkpoint::get_latest_checkpoint(common::xaccount_address_t const & account, std::error_code & ec) {
+    load();
     auto it = m_checkpoints_map.find(account);
     if (it == m_checkpoints_map.end()) {
         xwarn("[xtop_chain_checkpoint::get_latest_checkpoint] %s not found!", account.c_str());
@@ -90,6 +154,7 @@ xcheckpoint_data_t xtop_chain_checkpoint::get_latest_checkpoint(common::xaccount
 }
 
 xcheckpoints_t xtop_chain_checkpoint::get_checkpoints(common::xaccount_address_t const & account, std::error_code & ec) {
+    load();
     auto it = m_checkpoints_map.find(account);
     if (it == m_checkpoints_map.end()) {
         xwarn("[xtop_chain_checkpoint::get_checkpoints] %s not found!", account.c_str());
@@ -11,11 +11,46 @@
 #include "xdata/xnative_contract_address.h"
 #include "xvledger/xvledger.h"
 #include "xdata/xblockextract.h"
+#include "xbasic/xlru_cache.h"
+
+#include <algorithm>
 
 NS_BEG2(top, data)
 
 using namespace top::evm_common;
 
+static constexpr size_t relay_block_brief_cache_max{4096};
+
+bool xrelay_block_store::load_block_brief(uint64_t load_height, xrelay_block_brief_t & brief)
+{
+    static basic::xlru_cache<uint64_t, xrelay_block_brief_t> brief_cache{relay_block_brief_cache_max};
+    if (brief_cache.get(load_height, brief)) {
+        return true;
+    }
+
+    base::xvaccount_t _table_addr(sys_contract_relay_block_addr);
+    auto _db_block = base::xvchain_t::instance().get_xblockstore()->load_block_object(_table_addr, load_height, base::enum_xvblock_flag_authenticated, false);
+    if (_db_block == nullptr) {
+        xwarn("xrelay_block_store::load_block_brief block height(%d) fail-load", load_height);
+        return false;
+    }
+
+    std::error_code ec;
+    top::data::xrelay_block db_relay_block;
+    data::xblockextract_t::unpack_relayblock_from_wrapblock(_db_block.get(), db_relay_block, ec);
+    if (ec) {
+        xerror("xrelay_block_store:load_block_brief decodeBytes decodeBytes error %s; err msg %s", ec.category().name(), ec.message().c_str());
+        return false;
+    }
+
+    brief.block_type = db_relay_block.check_block_type();
+    brief.block_hash = db_relay_block.get_block_hash();
+    if (_db_block->check_block_flag(base::enum_xvblock_flag_committed)) {
+        brief_cache.put(load_height, brief);
+    }
+    return true;
+}
+
 bool xrelay_block_store::load_block_hash_from_db(uint64_t load_height, top::data::xrelay_block& db_relay_block)
 {
     base::xvaccount_t _table_addr(sys_contract_relay_block_addr);
@@ -48,17 +83,18 @@ bool xrelay_block_store::get_all_leaf_block_hash_list_from_cache(const xrelay_bl
 
     bool check_result = true;
     uint64_t last_height = poly_block.get_block_height();
+    // collected from high to low height, reversed at the end
     if (include_self) {
-        leaf_hash_vector.insert(leaf_hash_vector.begin(), poly_block.get_block_hash());
+        leaf_hash_vector.push_back(poly_block.get_block_hash());
     }
 
     while (last_height > 1) {
         last_height--;
-        top::data::xrelay_block tx_relay_block;
-        check_result = load_block_hash_from_db(last_height, tx_relay_block);
-        if (check_result && (tx_relay_block.check_block_type() < block_type)) {
-            if (tx_relay_block.check_block_type() == cache_tx_block) {
-                leaf_hash_vector.insert(leaf_hash_vector.begin(), tx_relay_block.get_block_hash());
+        xrelay_block_brief_t tx_relay_block;
+        check_result = load_block_brief(last_height, tx_relay_block);
+        if (check_result && (tx_relay_block.block_type < block_type)) {
+            if (tx_relay_block.block_type == cache_tx_block) {
+                leaf_hash_vector.push_back(tx_relay_block.block_hash);
             }
         } else {
             break;
@@ -69,6 +105,7 @@ bool xrelay_block_store::get_all_leaf_block_hash_list_from_cache(const xrelay_bl
         xwarn("xrelay_block_store:get_all_leaf_block_hash_list_from_cache  leaf_hash_vector clear ");
         leaf_hash_vector.clear();
     }
+    std::reverse(leaf_hash_vector.begin(), leaf_hash_vector.end());
     return check_result;
 }
 
@@ -88,14 +125,14 @@ bool xrelay_block_store::get_all_poly_block_hash_list_from_cache(const xrelay_bl
 
     while (check_result) {
         last_height++;
-        top::data::xrelay_block poly_relay_block;
-        check_result = load_block_hash_from_db(last_height, poly_relay_block);
+        xrelay_block_brief_t poly_relay_block;
+        check_result = load_block_brief(last_height, poly_relay_block);
         if (check_result) {
-            if (poly_relay_block.check_block_type() > block_type) {
-                block_type = poly_relay_block.check_block_type();
+            if (poly_relay_block.block_type > block_type) {
+                block_type = poly_relay_block.block_type;
                 xdbg("xrelay_block_store:get_all_poly_block_hash_list_from_cache  height(%d) poly  height(%d)  type(%d).",
                     tx_block.get_block_height(), last_height, block_type);
-                block_hash_map.insert(std::make_pair(last_height, poly_relay_block.get_block_hash()));
+                block_hash_map.insert(std::make_pair(last_height, poly_relay_block.block_hash));
                 if (block_type == cache_poly_election_block) {
                     xinfo("xrelay_block_store:get_all_poly_block_hash_list_from_cache tx_block height(%d) poly election height(%d).",
                         tx_block.get_block_height(), last_height, block_type);
@@ -3,89 +3,166 @@
 
 namespace top { namespace data {
 
+xJson::Value xtransaction_cache_state_t::to_json() const {
+    xJson::Value jv;
+    jv["height"] = static_cast<xJson::UInt64>(height);
+    jv["used_gas"] = static_cast<xJson::UInt64>(used_gas);
+    if (flags & flag_exec_status) {
+        jv["exec_status"] = data::xtransaction_t::tx_exec_status_to_str(exec_status);
+    }
+    if (flags & flag_used_deposit) {
+        jv["used_deposit"] = static_cast<xJson::UInt64>(used_deposit);
+    }
+    if (flags & flag_recv_tx_exec_status) {
+        jv["recv_tx_exec_status"] = data::xtransaction_t::tx_exec_status_to_str(recv_tx_exec_status);
+    }
+    if (flags & flag_tx_fee) {
+        jv["tx_fee"] = static_cast<xJson::UInt64>(tx_fee);
+    }
+    return jv;
+}
+
+xtransaction_cache_t::xstripe_t & xtransaction_cache_t::stripe(const std::string& tx_hash) {
+    return m_stripes[std::hash<std::string>()(tx_hash) % stripe_count];
+}
+
+uint64_t xtransaction_cache_t::entry_bytes(const std::string& tx_hash, const xentry_t & entry) {
+    // the key is held by the map and the lru list
+    uint64_t size = tx_hash.size() * 2 + sizeof(xentry_t) + entry.states.size() * (sizeof(int) + sizeof(xtransaction_cache_state_t));
+    if (entry.tran != nullptr) {
+        size += entry.tran->get_tx_len();
+    }
+    return size;
+}
+
+void xtransaction_cache_t::erase(xstripe_t & s, std::unordered_map<std::string, xentry_t>::iterator it) {
+    s.bytes -= it->second.bytes;
+    s.lru.erase(it->second.lru);
+    s.entries.erase(it);
+    XMETRICS_GAUGE(metrics::txstore_cache_origin_tx, -1);
+}
+
+void xtransaction_cache_t::evict(xstripe_t & s) {
+    while (s.bytes > m_stripe_max_bytes && !s.lru.empty()) {
+        auto it = s.entries.find(s.lru.back());
+        xdbg("evict cache: %s", top::HexEncode(it->first).c_str());
+        erase(s, it);
+        XMETRICS_GAUGE(metrics::txstore_cache_evict, 1);
+    }
+}
+
 bool xtransaction_cache_t::tx_add(const std::string& tx_hash, const xtransaction_ptr_t tx) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto iter = m_trans.find(tx_hash);
-    if (iter != m_trans.end()) {
+    xstripe_t & s = stripe(tx_hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto iter = s.entries.find(tx_hash);
+    if (iter != s.entries.end()) {
         XMETRICS_GAUGE(metrics::txstore_request_origin_tx, 0);
         return false;
     }
 
-    xtransaction_cache_data_t cache_data;
-    cache_data.tran = tx;
-    m_trans[tx_hash] = cache_data;
-    xdbg("add cache: %s, size:%d", top::HexEncode(tx_hash).c_str(), sizeof(tx_hash) + sizeof(cache_data));
+    s.lru.push_front(tx_hash);
+    xentry_t & entry = s.entries[tx_hash];
+    entry.tran = tx;
+    entry.lru = s.lru.begin();
+    entry.bytes = entry_bytes(tx_hash, entry);
+    s.bytes += entry.bytes;
+    xdbg("add cache: %s, size:%llu", top::HexEncode(tx_hash).c_str(), entry.bytes);
     XMETRICS_GAUGE(metrics::txstore_request_origin_tx, 1);
     XMETRICS_GAUGE(metrics::txstore_cache_origin_tx, 1);
+    evict(s);
     return true;
 }
 int xtransaction_cache_t::tx_find(const std::string& tx_hash) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_trans.find(tx_hash) == m_trans.end())
+    xstripe_t & s = stripe(tx_hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.entries.find(tx_hash) == s.entries.end())
         return 0;
     return 1;
 }
-int xtransaction_cache_t::tx_get_json(const std::string& tx_hash, const int index, xJson::Value & jv) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_trans.find(tx_hash) == m_trans.end())
-        return 0;
-    jv = m_trans[tx_hash].jv[index];
-    return 1;
-}
 bool xtransaction_cache_t::tx_get(const std::string& tx_hash, xtransaction_cache_data_t& cache_data){
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_trans.find(tx_hash) == m_trans.end())
-        return false;
-    cache_data = m_trans[tx_hash];
+    xstripe_t & s = stripe(tx_hash);
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto iter = s.entries.find(tx_hash);
+        if (iter == s.entries.end()) {
+            return false;
+        }
+        s.lru.splice(s.lru.begin(), s.lru, iter->second.lru);
+        cache_data.tran = iter->second.tran;
+        cache_data.states = iter->second.states;
+        cache_data.has_recv_txinfo = iter->second.has_recv_txinfo;
+        cache_data.recv_tx_exec_status = iter->second.recv_tx_exec_status;
+    }
     return true;
 }
-int xtransaction_cache_t::tx_set_json(const std::string& tx_hash, const int index, const xJson::Value & jv) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_trans.find(tx_hash) == m_trans.end())
+int xtransaction_cache_t::tx_set_state(const std::string& tx_hash, const int index, const xtransaction_cache_state_t & state) {
+    xstripe_t & s = stripe(tx_hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto iter = s.entries.find(tx_hash);
+    if (iter == s.entries.end())
         return 1;
-    m_trans[tx_hash].jv[index] = jv;
-    xdbg("add cache json: %d, %s", index, top::HexEncode(tx_hash).c_str());
+    iter->second.states[index] = state;
+    s.bytes -= iter->second.bytes;
+    iter->second.bytes = entry_bytes(tx_hash, iter->second);
+    s.bytes += iter->second.bytes;
+    xdbg("add cache state: %d, %s", index, top::HexEncode(tx_hash).c_str());
     return 0;
 }
-int xtransaction_cache_t::tx_set_recv_txinfo(const std::string& tx_hash, const data::xlightunit_action_ptr_t tx_info){
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_trans.find(tx_hash) == m_trans.end())
+int xtransaction_cache_t::tx_set_recv_exec_status(const std::string& tx_hash, uint8_t exec_status){
+    xstripe_t & s = stripe(tx_hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto iter = s.entries.find(tx_hash);
+    if (iter == s.entries.end())
         return 1;
-    m_trans[tx_hash].recv_txinfo = tx_info;
-    xdbg("add cache recv_txinfo: %s", top::HexEncode(tx_hash).c_str());
+    iter->second.has_recv_txinfo = true;
+    iter->second.recv_tx_exec_status = exec_status;
+    xdbg("add cache recv exec status: %s", top::HexEncode(tx_hash).c_str());
     return 0;
 }
 int xtransaction_cache_t::tx_erase(const std::string& tx_hash) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    std::map<std::string, xtransaction_cache_data_t>::iterator it = m_trans.find(tx_hash);
-    if (it == m_trans.end())
+    xstripe_t & s = stripe(tx_hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.entries.find(tx_hash);
+    if (it == s.entries.end())
         return 1;
-    m_trans.erase(it);
+    erase(s, it);
     xdbg("erase cache: %s", top::HexEncode(tx_hash).c_str());
-    XMETRICS_GAUGE(metrics::txstore_cache_origin_tx, -1);
     return 0;
 }
 int xtransaction_cache_t::tx_clean() {
     struct timeval val;
     base::xtime_utl::gettimeofday(&val);
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (std::map<std::string, xtransaction_cache_data_t>::iterator it= m_trans.begin(); it != m_trans.end(); ) {
-        if (it->second.tran->get_fire_timestamp() + it->second.tran->get_expire_duration() < (uint64_t)val.tv_sec) {
-            xdbg("erase tx: %lld,%d,%lld", it->second.tran->get_fire_timestamp() , it->second.tran->get_expire_duration() , (uint64_t)val.tv_sec);
-            m_trans.erase(it++);
-            XMETRICS_GAUGE(metrics::txstore_cache_origin_tx, -1);
-            continue;
+    for (auto & s : m_stripes) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (auto it = s.entries.begin(); it != s.entries.end(); ) {
+            if (it->second.tran->get_fire_timestamp() + it->second.tran->get_expire_duration() < (uint64_t)val.tv_sec) {
+                xdbg("erase tx: %lld,%d,%lld", it->second.tran->get_fire_timestamp() , it->second.tran->get_expire_duration() , (uint64_t)val.tv_sec);
+                erase(s, it++);
+                continue;
+            }
+            ++it;
         }
-        xdbg("not erase tx: %lld,%d,%lld", it->second.tran->get_fire_timestamp() , it->second.tran->get_expire_duration() , (uint64_t)val.tv_sec);
-        ++it;
     }
     return 0;
 }
 int xtransaction_cache_t::tx_clear() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_trans.clear();
+    for (auto & s : m_stripes) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        XMETRICS_GAUGE(metrics::txstore_cache_origin_tx, -(int64_t)s.entries.size());
+        s.entries.clear();
+        s.lru.clear();
+        s.bytes = 0;
+    }
     xinfo("cleat tx cache all.");
     return 0;
 }
+uint64_t xtransaction_cache_t::bytes() const {
+    uint64_t size = 0;
+    for (auto & s : m_stripes) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        size += s.bytes;
+    }
+    return size;
+}
 }
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -69,9 +70,12 @@ class xblocktool_t {
  public:  // txreceipt create
     static xcons_transaction_ptr_t                  create_one_txreceipt(base::xvblock_t* commit_block, base::xvblock_t* cert_block, base::xtable_shortid_t peer_table_sid, uint64_t receipt_id, enum_transaction_subtype subtype);
     static std::vector<xcons_transaction_ptr_t>     create_all_txreceipts(base::xvblock_t* commit_block, base::xvblock_t* cert_block);
+    // receipts of several receipt ids in one commit block share block loading and merkle building
+    static std::vector<xcons_transaction_ptr_t>     create_txreceipts(base::xvblock_t* commit_block, base::xvblock_t* cert_block, base::xtable_shortid_t peer_table_sid, const std::set<uint64_t> & receipt_ids, enum_transaction_subtype subtype);
     static std::vector<xcons_transaction_ptr_t>     create_txreceipts(base::xvblock_t* commit_block, base::xvblock_t* cert_block, const std::vector<xlightunit_action_t> & txactions);
     static std::vector<xlightunit_action_t>         unpack_all_txreceipt_action(base::xvblock_t* commit_block);
     static std::vector<xlightunit_action_t>         unpack_one_txreceipt_action(base::xvblock_t* commit_block, base::xtable_shortid_t peer_table_sid, uint64_t receipt_id, enum_transaction_subtype subtype);
+    static std::vector<xlightunit_action_t>         unpack_txreceipt_actions(base::xvblock_t* commit_block, base::xtable_shortid_t peer_table_sid, const std::set<uint64_t> & receipt_ids, enum_transaction_subtype subtype);
  public:  // property prove    
     static base::xvproperty_prove_ptr_t             create_receiptid_property_prove(base::xvblock_t* commit_block, base::xvblock_t* cert_block, base::xvbstate_t* bstate);
     static base::xreceiptid_state_ptr_t             get_receiptid_from_property_prove(const base::xvproperty_prove_ptr_t & prop_prove);
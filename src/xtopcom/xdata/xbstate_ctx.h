@@ -118,7 +118,8 @@ protected:
     xobject_ptr_t<base::xvcanvas_t> m_canvas{nullptr};
 
 private:
-    xobject_ptr_t<base::xvbstate_t>     m_snapshot_origin_bstate{nullptr};
+    xobject_ptr_t<base::xvbstate_t>     m_snapshot_origin_bstate{nullptr};  // bstate at m_origin_canvas_height, moved forward at rollback
+    size_t                              m_origin_canvas_height{0};
     size_t                              m_snapshot_canvas_height{0};
     mutable common::xaccount_address_t m_account_address_cached;
 };
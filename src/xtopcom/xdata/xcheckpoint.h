@@ -8,6 +8,8 @@
 #include "xcommon/xaddress.h"
 #include "xvledger/xvstate.h"
 
+#include <mutex>
+
 namespace top {
 namespace data {
 
@@ -22,7 +24,7 @@ using xcheckpoints_map_t = std::map<common::xaccount_address_t, xcheckpoints_t>;
 
 class xtop_chain_checkpoint {
 public:
-    /// @brief Load all cp data and state into memory.
+    /// @brief Load all cp data into memory, done by the first query if not called before.
     static void load();
 
     /// @brief Get latest cp data of specific table.
@@ -38,7 +40,10 @@ public:
     static xcheckpoints_t get_checkpoints(common::xaccount_address_t const & account, std::error_code & ec);
 
 private:
+    static void load_once();
+
     static xcheckpoints_map_t m_checkpoints_map;
+    static std::once_flag m_load_flag;
 };
 using xchain_checkpoint_t = xtop_chain_checkpoint;
 
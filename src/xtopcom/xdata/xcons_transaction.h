@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "xbasic/xobject_pool.h"
 #include "xvledger/xtxreceipt.h"
 #include "xvledger/xvaccount.h"
 #include "xvledger/xvtxindex.h"
@@ -23,6 +24,7 @@ using base::enum_transaction_subtype_confirm;
 
 class xcons_transaction_t : public xbase_dataunit_t<xcons_transaction_t, xdata_type_cons_transaction> {
  public:
+    XDECLARE_POOLED_NEW_DELETE
     xcons_transaction_t();
     xcons_transaction_t(xtransaction_t* raw_tx);
     xcons_transaction_t(xtransaction_t* tx, const base::xtx_receipt_ptr_t & receipt);
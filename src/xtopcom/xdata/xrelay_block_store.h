@@ -20,6 +20,16 @@ namespace data {
         static bool get_all_poly_block_hash_list_from_cache(const xrelay_block& tx_block, std::map<uint64_t, evm_common::h256>& block_hash_map);
         static bool get_all_leaf_block_hash_list_from_cache(const xrelay_block& poly_block, std::vector<evm_common::h256>& leaf_hash_vector, bool include_self);
         static bool load_block_hash_from_db(uint64_t load_height, top::data::xrelay_block  &db_relay_block);
+
+    private:
+        // the hash lists only need the type and hash of each relay block
+        struct xrelay_block_brief_t {
+            enum_block_cache_type block_type{cache_error_block};
+            evm_common::h256 block_hash;
+        };
+        // committed relay blocks never change, their briefs are cached by height so the walks of
+        // repeated proof queries don't load and decode the same blocks again.
+        static bool load_block_brief(uint64_t load_height, xrelay_block_brief_t & brief);
     };
 
 }
@@ -4,35 +4,89 @@
 #pragma once
 #include "xdata/xtransaction.h"
 #include "xdata/xblockaction.h"
+#include <list>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace top { namespace data {
 
+// execution result of one subtype of a cached tx, the json of rpc is only built on read
+struct xtransaction_cache_state_t {
+    enum {
+        flag_exec_status = 1 << 0,
+        flag_used_deposit = 1 << 1,
+        flag_recv_tx_exec_status = 1 << 2,
+        flag_tx_fee = 1 << 3,
+    };
+
+    void set_exec_status(uint8_t status) { exec_status = status; flags |= flag_exec_status; }
+    void set_used_deposit(uint64_t deposit) { used_deposit = deposit; flags |= flag_used_deposit; }
+    void set_recv_tx_exec_status(uint8_t status) { recv_tx_exec_status = status; flags |= flag_recv_tx_exec_status; }
+    void set_tx_fee(uint64_t fee) { tx_fee = fee; flags |= flag_tx_fee; }
+    xJson::Value to_json() const;
+
+    uint64_t height{0};
+    uint64_t used_gas{0};
+    uint64_t used_deposit{0};
+    uint64_t tx_fee{0};
+    uint8_t exec_status{0};
+    uint8_t recv_tx_exec_status{0};
+    uint8_t flags{0};
+};
+
 struct xtransaction_cache_data_t {
     xtransaction_ptr_t tran;
-    //xJson::Value jv;
-    std::map<int, xJson::Value> jv;
-    data::xlightunit_action_ptr_t   recv_txinfo{nullptr};
+    std::map<int, xtransaction_cache_state_t> states;
+    bool has_recv_txinfo{false};
+    uint8_t recv_tx_exec_status{0};
 };
+
+// origin txs sent by this node and their execution results, until the tx is confirmed or expired.
+// entries are spread over lock stripes by tx hash, each one bounded by its share of max_bytes and
+// evicting the least recently used tx first.
 class xtransaction_cache_t{
 public:
-    //static xtransaction_cache_t & instance();
-    xtransaction_cache_t() {
+    static constexpr uint64_t default_max_bytes = 128 * 1024 * 1024;
+    static constexpr uint32_t stripe_count = 16;
+
+    explicit xtransaction_cache_t(uint64_t max_bytes = default_max_bytes)
+      : m_stripe_max_bytes(max_bytes / stripe_count) {
     }
     ~xtransaction_cache_t() {}
     bool tx_add(const std::string& tx_hash, const xtransaction_ptr_t tx);
     int tx_find(const std::string& tx_hash);
-    int tx_get_json(const std::string& tx_hash, const int index, xJson::Value & jv);
-    int tx_set_json(const std::string& tx_hash, const int index, const xJson::Value & jv);
-    int tx_set_recv_txinfo(const std::string& tx_hash, const data::xlightunit_action_ptr_t tx_info);
+    int tx_set_state(const std::string& tx_hash, const int index, const xtransaction_cache_state_t & state);
+    int tx_set_recv_exec_status(const std::string& tx_hash, uint8_t exec_status);
     bool tx_get(const std::string& tx_hash, xtransaction_cache_data_t& cache_data);
     int tx_erase(const std::string& tx_hash);
     int tx_clean();
     int tx_clear();
+    uint64_t bytes() const;
+
 private:
-    std::map<std::string, xtransaction_cache_data_t> m_trans;
-    std::mutex  m_mutex;
+    struct xentry_t {
+        xtransaction_ptr_t tran;
+        std::map<int, xtransaction_cache_state_t> states;
+        bool has_recv_txinfo{false};
+        uint8_t recv_tx_exec_status{0};
+        uint64_t bytes{0};
+        std::list<std::string>::iterator lru;
+    };
+    struct xstripe_t {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, xentry_t> entries;
+        std::list<std::string> lru;  // most recent first
+        uint64_t bytes{0};
+    };
+
+    xstripe_t & stripe(const std::string & tx_hash);
+    static uint64_t entry_bytes(const std::string & tx_hash, const xentry_t & entry);
+    void erase(xstripe_t & s, std::unordered_map<std::string, xentry_t>::iterator it);
+    void evict(xstripe_t & s);
+
+    uint64_t m_stripe_max_bytes;
+    xstripe_t m_stripes[stripe_count];
 };
 
 }
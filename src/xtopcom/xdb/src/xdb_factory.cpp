@@ -8,18 +8,27 @@
 #include "xbase/xlog.h"
 #include "xdb/xdb.h"
 #include "xdb/xdb_mem.h"
+#include "xdb/xdb_tiered.h"
 #include "xdb/xdb_face.h"
 #include "xdb/xdb_factory.h"
 
 
 namespace top { namespace db {
 
-std::shared_ptr<xdb_face_t> xdb_factory_t::create(int db_kinds, const std::string& db_root_dir,std::vector<xdb_path_t> db_data_paths) {
+std::shared_ptr<xdb_face_t> xdb_factory_t::create(int db_kinds, const std::string& db_root_dir,std::vector<xdb_path_t> db_data_paths,const xdb_options_t & db_options) {
     const xdb_kind_t kind = (xdb_kind_t)(db_kinds & 0x0F);
     switch (kind) {
         case xdb_kind_kvdb:
         {
-            return std::make_shared<xdb>(db_kinds,db_root_dir,db_data_paths);
+            if (db_options.cold_db_path.empty())
+                return std::make_shared<xdb>(db_kinds,db_root_dir,db_data_paths,db_options);
+
+            //tiered mode:cold DB keep history only,data paths are for hot DB
+            xkinfo("xdb_factory_t::create a tiered-db,hot(%s) cold(%s)", db_root_dir.c_str(), db_options.cold_db_path.c_str());
+            std::vector<xdb_path_t> cold_data_paths;
+            std::shared_ptr<xdb_face_t> hot_db  = std::make_shared<xdb>(db_kinds,db_root_dir,db_data_paths,db_options);
+            std::shared_ptr<xdb_face_t> cold_db = std::make_shared<xdb>(db_kinds,db_options.cold_db_path,cold_data_paths,db_options);
+            return std::make_shared<xdb_tiered_t>(hot_db, cold_db, db_options.cold_block_height_gap);
         }
         case xdb_kind_mem:
         {
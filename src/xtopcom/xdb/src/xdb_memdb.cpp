@@ -15,42 +15,176 @@
 
 namespace top { namespace db {
 
-bool xdb_mem_t::read(const std::string& key, std::string& value) const {
-    std::lock_guard<std::mutex> lock(m_lock);
+class xdb_mem_read_guard_t {
+ public:
+    explicit xdb_mem_read_guard_t(base::xrwlock_t & lock) : m_lock(lock) { m_lock.lock_read(); }
+    ~xdb_mem_read_guard_t() { m_lock.release_read(); }
+ private:
+    base::xrwlock_t & m_lock;
+};
+
+class xdb_mem_write_guard_t {
+ public:
+    explicit xdb_mem_write_guard_t(base::xrwlock_t & lock) : m_lock(lock) { m_lock.lock_write(); }
+    ~xdb_mem_write_guard_t() { m_lock.release_write(); }
+ private:
+    base::xrwlock_t & m_lock;
+};
+
+//pinned view refer to shared value,still valid after the key is overwritten or erased
+class xdb_mem_pinned_value_t : public xdb_pinned_value_t {
+ public:
+    explicit xdb_mem_pinned_value_t(const xdb_mem_value_ptr & value) : m_value(value) {}
+    const char* data() const override { return m_value->data(); }
+    size_t      size() const override { return m_value->size(); }
+ private:
+    xdb_mem_value_ptr m_value;
+};
+
+static bool is_start_with(const std::string& key, const std::string& prefix) {
+    return (key.size() >= prefix.size()) && (key.compare(0, prefix.size(), prefix) == 0);
+}
 
-    m_meta.m_read_count++;
+//copy entries of prefix out,so callback runs without holding lock
+static void collect_prefix(const xdb_mem_map_t & values, const std::string& prefix, std::vector<std::pair<std::string, xdb_mem_value_ptr>> & entries) {
+    for (auto it = values.lower_bound(prefix); (it != values.end()) && is_start_with(it->first, prefix); ++it) {
+        entries.emplace_back(it->first, it->second);
+    }
+}
 
-    auto iter = m_values.find(key);
-    if (iter != m_values.end()) {
-        value = iter->second;
+class xdb_mem_range_iterator_t : public xdb_range_iterator_t {
+ public:
+    xdb_mem_range_iterator_t(const std::shared_ptr<const xdb_mem_map_t> & values, const std::string& prefix)
+      : m_values(values), m_prefix(prefix), m_it(m_values->lower_bound(prefix)) {}
+    bool               valid() const override { return (m_it != m_values->end()) && is_start_with(m_it->first, m_prefix); }
+    void               next() override { ++m_it; }
+    const std::string& key() const override { return m_it->first; }
+    const std::string& value() const override { return *m_it->second; }
+ private:
+    std::shared_ptr<const xdb_mem_map_t> m_values;
+    const std::string                    m_prefix;
+    xdb_mem_map_t::const_iterator        m_it;
+};
+
+bool xdb_mem_snapshot_t::read(const std::string& key, std::string& value) const {
+    auto iter = m_values->find(key);
+    if (iter != m_values->end()) {
+        value = *iter->second;
         return true;
     }
     return false;
 }
 
-bool xdb_mem_t::exists(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(m_lock);
-    auto iter = m_values.find(key);
-    if (iter != m_values.end()) {
-        return true;
+bool xdb_mem_snapshot_t::read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie) const {
+    bool ret = false;
+    for (auto it = m_values->lower_bound(prefix); (it != m_values->end()) && is_start_with(it->first, prefix); ++it) {
+        if ((*callback)(it->first, *it->second, cookie) == false)
+            return false;
+        ret = true;
     }
-    return false;
+    return ret;
 }
 
-bool xdb_mem_t::write(const std::string& key, const std::string& value) {
-    std::lock_guard<std::mutex> lock(m_lock);
-    auto iter = m_values.find(key);
-    if (iter != m_values.end()) {
+xdb_mem_t::xdb_mem_t() {
+    m_values = std::make_shared<xdb_mem_map_t>();
+}
+
+xdb_mem_map_t & xdb_mem_t::get_writable_values() {
+    if (m_values.use_count() > 1) { //shared with snapshot,copy on write
+        m_values = std::make_shared<xdb_mem_map_t>(*m_values);
+    }
+    return *m_values;
+}
+
+void xdb_mem_t::put_value(xdb_mem_map_t & values, const std::string& key, const std::string& value) {
+    auto & entry = values[key];
+    if (entry != nullptr) {
         m_meta.m_db_key_size -= key.size();
-        m_meta.m_db_value_size -= iter->second.size();   
-        m_meta.m_key_count--;     
+        m_meta.m_db_value_size -= entry->size();
+        m_meta.m_key_count--;
     }
-    m_values[key] = value;
+    entry = std::make_shared<const std::string>(value);
     m_meta.m_db_key_size += key.size();
     m_meta.m_db_value_size += value.size();
     m_meta.m_key_count++;
 
     m_meta.m_write_count++;
+}
+
+void xdb_mem_t::erase_value(xdb_mem_map_t & values, const std::string& key) {
+    auto iter = values.find(key);
+    if (iter != values.end()) {
+        m_meta.m_db_key_size -= key.size();
+        m_meta.m_db_value_size -= iter->second->size();
+        m_meta.m_key_count--;
+
+        values.erase(iter);
+    }
+    m_meta.m_erase_count++;
+}
+
+void xdb_mem_t::reset_meta(const xdb_mem_map_t & values) {
+    m_meta.m_db_key_size = 0;
+    m_meta.m_db_value_size = 0;
+    m_meta.m_key_count = values.size();
+    for (auto & entry : values) {
+        m_meta.m_db_key_size += entry.first.size();
+        m_meta.m_db_value_size += entry.second->size();
+    }
+}
+
+bool xdb_mem_t::read(const std::string& key, std::string& value) const {
+    xdb_mem_read_guard_t guard(m_lock);
+
+    m_read_count++;
+
+    auto iter = m_values->find(key);
+    if (iter != m_values->end()) {
+        value = *iter->second;
+        return true;
+    }
+    return false;
+}
+
+bool xdb_mem_t::read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const {
+    xdb_mem_read_guard_t guard(m_lock);
+
+    m_read_count++;
+
+    auto iter = m_values->find(key);
+    if (iter != m_values->end()) {
+        value.reset(new xdb_mem_pinned_value_t(iter->second));
+        return true;
+    }
+    return false;
+}
+
+bool xdb_mem_t::multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const {
+    values.clear();
+    values.resize(keys.size());
+
+    xdb_mem_read_guard_t guard(m_lock);
+    m_read_count += keys.size();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto iter = m_values->find(keys[i]);
+        if (iter != m_values->end())
+            values[i] = *iter->second;
+    }
+    return true;
+}
+
+bool xdb_mem_t::exists(const std::string& key) const {
+    xdb_mem_read_guard_t guard(m_lock);
+    auto iter = m_values->find(key);
+    if (iter != m_values->end()) {
+        return true;
+    }
+    return false;
+}
+
+bool xdb_mem_t::write(const std::string& key, const std::string& value) {
+    xdb_mem_write_guard_t guard(m_lock);
+    put_value(get_writable_values(), key, value);
 
     xdbg("xdb_mem_t::write key=%s", key.c_str());
     return true;
@@ -62,75 +196,84 @@ bool xdb_mem_t::write(const std::string& key, const char* data, size_t size) {
 }
 
 bool xdb_mem_t::write(const std::map<std::string, std::string>& batches) {
-    std::lock_guard<std::mutex> lock(m_lock);
+    xdb_mem_write_guard_t guard(m_lock);
+    xdb_mem_map_t & values = get_writable_values();
     for (const auto& entry : batches) {
-        auto & key = entry.first;
-        auto & value = entry.second;
-
-        auto iter = m_values.find(key);
-        if (iter != m_values.end()) {
-            m_meta.m_db_key_size -= key.size();
-            m_meta.m_db_value_size -= iter->second.size();   
-            m_meta.m_key_count--;
-        }
-        m_values[key] = value;
-        m_meta.m_db_key_size += key.size();
-        m_meta.m_db_value_size += value.size();
-        m_meta.m_key_count++;
-
-        m_meta.m_write_count++;
-    }    
+        put_value(values, entry.first, entry.second);
+    }
     return true;
 }
 
 bool xdb_mem_t::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(m_lock);
-    auto iter = m_values.find(key);
-    if (iter != m_values.end()) {
-        m_meta.m_db_key_size -= key.size();
-        m_meta.m_db_value_size -= iter->second.size();
-        m_meta.m_key_count--;
-
-        m_values.erase(key);
-    }
-
-    m_meta.m_erase_count++;
+    xdb_mem_write_guard_t guard(m_lock);
+    erase_value(get_writable_values(), key);
     return true;
 }
 
 bool xdb_mem_t::erase(const std::vector<std::string>& keys) {
-    std::lock_guard<std::mutex> lock(m_lock);
+    xdb_mem_write_guard_t guard(m_lock);
+    xdb_mem_map_t & values = get_writable_values();
     for (const auto& key : keys) {
-        auto iter = m_values.find(key);
-        if (iter != m_values.end()) {
-            m_meta.m_db_key_size -= key.size();
-            m_meta.m_db_value_size -= iter->second.size();
-            m_meta.m_key_count--;
-
-            m_values.erase(key);  
-        }
-        m_meta.m_erase_count++;
+        erase_value(values, key);
     }
     return true;
 }
 
+//apply objs and delete_keys atomically,readers see all or none
 bool xdb_mem_t::batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) {
-    write(objs);
-    erase(delete_keys);
+    xdb_mem_write_guard_t guard(m_lock);
+    xdb_mem_map_t & values = get_writable_values();
+    for (const auto& entry : objs) {
+        put_value(values, entry.first, entry.second);
+    }
+    for (const auto& key : delete_keys) {
+        erase_value(values, key);
+    }
     return true;
 }
 
 //prefix must start from first char of key
 bool xdb_mem_t::read_range(const std::string& prefix, std::vector<std::string>& values)
 {
-    xassert(0);
-    return false;
+    xdb_mem_read_guard_t guard(m_lock);
+    bool ret = false;
+    for (auto it = m_values->lower_bound(prefix); (it != m_values->end()) && is_start_with(it->first, prefix); ++it) {
+        values.push_back(*it->second);
+        ret = true;
+    }
+    return ret;
+}
+
+xdb_range_iterator_ptr xdb_mem_t::new_range_iterator(const std::string& prefix)
+{
+    std::shared_ptr<const xdb_mem_map_t> values;
+    {
+        xdb_mem_read_guard_t guard(m_lock);
+        values = m_values; //next write copy the map instead of changing it under cursor
+    }
+    return xdb_range_iterator_ptr(new xdb_mem_range_iterator_t(values, prefix));
 }
+
 //note:begin_key and end_key must has same style(first char of key)
 bool xdb_mem_t::delete_range(const std::string& begin_key,const std::string& end_key)
 {
-    xassert(0);
-    return false;
+    if (end_key < begin_key) {
+        xerror("xdb_mem_t::delete_range,invalid range [%s,%s)", begin_key.c_str(), end_key.c_str());
+        return false;
+    }
+
+    xdb_mem_write_guard_t guard(m_lock);
+    xdb_mem_map_t & values = get_writable_values();
+    auto begin_it = values.lower_bound(begin_key);
+    auto end_it   = values.lower_bound(end_key);
+    for (auto it = begin_it; it != end_it; ++it) {
+        m_meta.m_db_key_size -= it->first.size();
+        m_meta.m_db_value_size -= it->second->size();
+        m_meta.m_key_count--;
+        m_meta.m_erase_count++;
+    }
+    values.erase(begin_it, end_it);
+    return true;
 }
 
 //key must be readonly(never update after PUT),otherwise the behavior is undefined
@@ -142,22 +285,66 @@ bool xdb_mem_t::single_delete(const std::string& key)
 //iterator each key of prefix.note: go throuh whole db if prefix is empty
 bool xdb_mem_t::read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie)
 {
-    return false;
+    std::vector<std::pair<std::string, xdb_mem_value_ptr>> entries;
+    {
+        xdb_mem_read_guard_t guard(m_lock);
+        collect_prefix(*m_values, prefix, entries);
+    }
+
+    bool ret = false;
+    for (auto & entry : entries) {
+        if ((*callback)(entry.first, *entry.second, cookie) == false)
+            return false;
+        ret = true;
+    }
+    return ret;
 }
 
 //compact whole DB if both begin_key and end_key are empty
 //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
 bool xdb_mem_t::compact_range(const std::string & begin_key,const std::string & end_key)
 {
-    return false;
+    return true; //nothing to compact
+}
+
+void xdb_mem_t::GetDBMemStatus() const
+{
+    xdb_mem_read_guard_t guard(m_lock);
+    xkinfo("xdb_mem_t::GetDBMemStatus,keys(%zu) key_size(%zu) value_size(%zu) shared_with_snapshot(%d)",
+        m_meta.m_key_count, m_meta.m_db_key_size, m_meta.m_db_value_size, (int)(m_values.use_count() > 1));
 }
- void xdb_mem_t::GetDBMemStatus() const
- {
- }
 
 bool xdb_mem_t::get_estimate_num_keys(uint64_t & num) const
 {
-    return false;
+    xdb_mem_read_guard_t guard(m_lock);
+    num = m_values->size();
+    return true;
+}
+
+xdb_meta_t xdb_mem_t::get_meta()
+{
+    xdb_mem_read_guard_t guard(m_lock);
+    xdb_meta_t meta = m_meta;
+    meta.m_read_count = m_read_count.load();
+    return meta;
+}
+
+xdb_mem_snapshot_ptr xdb_mem_t::get_snapshot() const
+{
+    xdb_mem_read_guard_t guard(m_lock);
+    return std::make_shared<const xdb_mem_snapshot_t>(m_values);
+}
+
+bool xdb_mem_t::restore_snapshot(const xdb_mem_snapshot_ptr & snapshot)
+{
+    if (snapshot == nullptr)
+        return false;
+
+    xdb_mem_write_guard_t guard(m_lock);
+    //share map with snapshot again,next write copy it
+    m_values = std::const_pointer_cast<xdb_mem_map_t>(snapshot->m_values);
+    reset_meta(*m_values);
+    return true;
 }
 
 bool xdb_memdb_transaction_t::rollback() {
@@ -173,19 +360,22 @@ bool xdb_memdb_transaction_t::commit() {
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_db->m_lock);
+    xdb_mem_write_guard_t guard(m_db->m_lock);
     {
         for (const auto& entry : m_read_values) {
-            if (m_db->m_values[entry.first] != entry.second) {
+            auto iter = m_db->m_values->find(entry.first);
+            const std::string current_value = (iter != m_db->m_values->end()) ? *iter->second : std::string();
+            if (current_value != entry.second) {
                 return false;
             }
         }
+        xdb_mem_map_t & values = m_db->get_writable_values();
         for (const auto& entry : m_write_values) {
-            m_db->m_values[entry.first] = entry.second;
+            m_db->put_value(values, entry.first, entry.second);
         }
 
         for (const auto& key : m_erase_keys) {
-            m_db->m_values.erase(key);
+            m_db->erase_value(values, key);
         }
     }
     return true;
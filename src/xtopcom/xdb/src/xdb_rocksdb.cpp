@@ -4,18 +4,34 @@
 
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "rocksdb/db.h"
 #include "rocksdb/slice.h"
 #include "rocksdb/options.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/perf_context.h"
+#include "rocksdb/rate_limiter.h"
 #include "rocksdb/table.h"
 #include "rocksdb/convenience.h"
 #include "rocksdb/filter_policy.h"
+#include "rocksdb/slice_transform.h"
+#include "rocksdb/sst_file_writer.h"
+#include "rocksdb/statistics.h"
 #include "rocksdb/utilities/transaction_db.h"
 #include "rocksdb/utilities/optimistic_transaction_db.h"
 
 #include "xbase/xlog.h"
+#include "xbasic/xmemory_accounting.h"
 #include "xdb/xdb.h"
 #include "xmetrics/xmetrics.h"
 
@@ -27,6 +43,13 @@
 
 using std::string;
 
+//posix env of rocksdb serves MultiRead by io_uring when built with liburing,and asks this hook(weak symbol at rocksdb) whether to
+static std::atomic<bool> s_io_uring_multiread{true};
+extern "C" bool RocksDbIOUringEnable()
+{
+    return s_io_uring_multiread.load();
+}
+
 namespace top { namespace db {
 
 typedef enum {
@@ -162,6 +185,47 @@ enum enum_xvdb_cf_type
     //old style(defined by object) and stored at default CF(column Family)
 };
 
+enum
+{
+    enum_xdb_cf_metrics_max_count = 16, //must be same as size of db_cf_block_cache_hit/miss at xmetrics
+};
+
+//layout of CFs,persisted at default CF by key of s_cf_layout_key
+enum enum_xdb_cf_layout
+{
+    enum_xdb_cf_layout_shard     = 1, //'r' & 's' keys are sharded into cf[1]~cf[4] by ledger,others at default CF
+    enum_xdb_cf_layout_migrating = 2, //moving keys to CF of key type,read fallback to CF of shard layout
+    enum_xdb_cf_layout_key_type  = 3, //hot meta and tx index are at dedicated CFs,others same as shard layout
+};
+
+static const std::string s_cf_layout_key   = "/xdb/cf_layout";
+static const std::string s_meta_cf_name    = "meta";
+static const std::string s_txindex_cf_name = "txindex";
+
+//class of key decided by first & last char,same rule as xvdbkey_t::get_dbkey_type_v2 since xdb not depend on xvledger
+enum enum_xdb_key_class
+{
+    enum_xdb_key_class_default = 0, //block body,state,mpt node and any old style,routed as shard layout
+    enum_xdb_key_class_meta    = 1, //account meta(u/..),account span(r/../a),block index(r/../h):small,hot and overwritten
+    enum_xdb_key_class_txindex = 2, //tx index(f/..):write once and point lookup by random hash
+};
+
+static enum_xdb_key_class get_xdb_key_class(const std::string & key)
+{
+    if( (key.size() < 4) || (key[1] != '/') )
+        return enum_xdb_key_class_default;
+    
+    const char first_char = key[0];
+    const char last_char  = key[key.size() - 1];
+    if(first_char == enum_xvdb_cf_type_update_most)
+        return enum_xdb_key_class_meta;
+    if( (first_char == enum_xvdb_cf_type_read_most) && ((last_char == 'h') || (last_char == 'a')) )
+        return enum_xdb_key_class_meta;
+    if(first_char == enum_xvdb_cf_type_log_only)
+        return enum_xdb_key_class_txindex;
+    return enum_xdb_key_class_default;
+}
+
 struct xColumnFamily
 {
 public:
@@ -170,25 +234,144 @@ public:
     rocksdb::ColumnFamilyHandle* cf_handle{nullptr};
 };
 
+//value pinned at block cache or memtable,released when this object is destroyed
+class xdb_rocksdb_pinned_value_t : public xdb_pinned_value_t
+{
+public:
+    const char*              data() const override { return m_slice.data(); }
+    size_t                   size() const override { return m_slice.size(); }
+    rocksdb::PinnableSlice*  slice() { return &m_slice; }
+private:
+    rocksdb::PinnableSlice   m_slice;
+};
+
+//snapshot of one RocksDB instance,released once the last handle is gone
+class xdb_rocksdb_snapshot_t : public xdb_snapshot_t
+{
+public:
+    explicit xdb_rocksdb_snapshot_t(rocksdb::DB* db) : m_db(db), m_snapshot(db->GetSnapshot()) {}
+    ~xdb_rocksdb_snapshot_t() override { m_db->ReleaseSnapshot(m_snapshot); }
+    const rocksdb::DB*       db() const { return m_db; }
+    const rocksdb::Snapshot* get() const { return m_snapshot; }
+private:
+    rocksdb::DB*             m_db;
+    const rocksdb::Snapshot* m_snapshot;
+};
+
+//node-wide block cache shared by every CF of every xdb instance,so the memory budget is controlled at one place
+//index & filter blocks are kept at high-priority pool to avoid being evicted by big block bodies
+class xshared_block_cache_t
+{
+public:
+    static constexpr uint64_t  min_capacity        = 32 << 20;  //32M
+    static constexpr double    high_pri_pool_ratio = 0.2;       //reserved for index & filter blocks
+
+    static std::shared_ptr<rocksdb::Cache> instance(const uint64_t capacity)
+    {
+        static std::mutex                       s_lock;
+        static std::shared_ptr<rocksdb::Cache>  s_cache;
+
+        const uint64_t target_capacity = (capacity > min_capacity) ? capacity : min_capacity;
+        std::lock_guard<std::mutex> guard(s_lock);
+        if (s_cache == nullptr)
+        {
+            rocksdb::LRUCacheOptions cache_options;
+            cache_options.capacity            = target_capacity;
+            cache_options.num_shard_bits      = -1; //let RocksDB decide shards by capacity
+            cache_options.strict_capacity_limit = false;
+            cache_options.high_pri_pool_ratio = high_pri_pool_ratio;
+            s_cache = rocksdb::NewLRUCache(cache_options);
+            xkinfo("xshared_block_cache_t::instance,create block cache with capacity=%llu", (unsigned long long)target_capacity);
+        }
+        else if (s_cache->GetCapacity() < target_capacity) //enlarge only,as other DB may still use it
+        {
+            s_cache->SetCapacity(target_capacity);
+            xkinfo("xshared_block_cache_t::instance,enlarge block cache to capacity=%llu", (unsigned long long)target_capacity);
+        }
+        return s_cache;
+    }
+};
+
+//prefix of key scoped by account as layouts defined at xvdbkey_t,which is the part until 3rd '/' of key,e.g.
+//  r/[ledger]/[compact-address]/[height]/...  -> r/[ledger]/[compact-address]/
+//  s/[ledger]/[compact-address]/[height]/...  -> s/[ledger]/[compact-address]/
+//  u/[ledger]/[compact-address]/m             -> u/[ledger]/[compact-address]/
+//key of other style(e.g. t/[txhash]/[type]) is out of domain,and left for whole-key bloom only
+//note:compact-address might contain '/',that just makes prefix shorter but still same for all keys of one account
+class xdb_account_prefix_transform_t : public rocksdb::SliceTransform
+{
+public:
+    enum { enum_account_prefix_separator_count = 3 };
+public:
+    //never change name since it is persisted at SST,and prefix filter of SST is ignored once name mismatched
+    const char* Name() const override { return "top.xdb.AccountPrefix.v1"; }
+
+    rocksdb::Slice Transform(const rocksdb::Slice& key) const override
+    {
+        return rocksdb::Slice(key.data(), get_prefix_size(key));
+    }
+    bool InDomain(const rocksdb::Slice& key) const override
+    {
+        return (get_prefix_size(key) > 0);
+    }
+    bool SameResultWhenAppended(const rocksdb::Slice& prefix) const override
+    {
+        return InDomain(prefix);
+    }
+    //return 0 if key is out of domain
+    static size_t get_prefix_size(const rocksdb::Slice& key)
+    {
+        if( (key.size() < 2) || (key[1] != '/') ) //all customized style must format as "x/..."
+            return 0;
+        int separator_count = 0;
+        for(size_t i = 1; i < key.size(); ++i)
+        {
+            if(key[i] == '/')
+            {
+                if(++separator_count == enum_account_prefix_separator_count)
+                    return i + 1;
+            }
+        }
+        return 0;
+    }
+    static const std::shared_ptr<const rocksdb::SliceTransform> & instance()
+    {
+        static const std::shared_ptr<const rocksdb::SliceTransform> s_instance(new xdb_account_prefix_transform_t());
+        return s_instance;
+    }
+};
+
 class xdb::xdb_impl final
 {
 public:
     static void  disable_default_compress_options(rocksdb::ColumnFamilyOptions & default_cf_options);
-    static void  setup_default_db_options(rocksdb::Options & default_db_options,const int db_kinds);//setup Default Option of whole DB Level
+    static void  setup_default_db_options(rocksdb::Options & default_db_options,const int db_kinds,const xdb_options_t & db_options);//setup Default Option of whole DB Level
+    static uint64_t get_default_block_cache_size(DB_OPTIONS_TYPE cache_type);
     void         setup_default_cf_options(xColumnFamily & cf_config,const size_t block_size,std::shared_ptr<rocksdb::Cache> & block_cache);
     
     xColumnFamily setup_default_cf();//setup Default ColumnFamily(CF),and for read&write as well
     xColumnFamily setup_universal_style_cf(const std::string & name,uint64_t memtable_memory_budget = 64 * 1024 * 1024,int num_levels = 5);
-    xColumnFamily setup_level_style_cf(DB_OPTIONS_TYPE cache_type, const std::string & name,std::shared_ptr<rocksdb::Cache> &block_cache, uint64_t memtable_memory_budget,int num_levels = 7);
+    xColumnFamily setup_level_style_cf(const std::string & name,std::shared_ptr<rocksdb::Cache> &block_cache, uint64_t memtable_memory_budget,int num_levels = 7);
     xColumnFamily setup_fifo_style_cf(const std::string & name,uint64_t ttl = 14 * 24 * 60 * 60);//setup ColumnFamily(CF) of log only,delete after 14 day as default setting);
+    //separate large values(block object,input & output) into blob files for CF holding block bodies,no-op if blob is off
+    void         setup_blob_cf_options(xColumnFamily & cf_config);
+    void         setup_dict_cf_options(xColumnFamily & cf_config);
+    xColumnFamily setup_meta_cf(const std::string & name,uint64_t memtable_memory_budget);//small & hot meta,no compression
+    xColumnFamily setup_txindex_cf(const std::string & name,uint64_t memtable_memory_budget);//write-once & random point lookup
 
  public:
     //db_kinds refer to xdb_kind_t
-    explicit xdb_impl(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths);
+    explicit xdb_impl(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths,const xdb_options_t & db_options);
     ~xdb_impl();
     bool open();
     bool close();
-    bool read(const std::string& key, std::string& value) const;
+    //read live DB if snapshot is nullptr
+    bool read(const std::string& key, std::string& value, const rocksdb::Snapshot* snapshot = nullptr) const;
+    bool read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const;
+    bool multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values, const rocksdb::Snapshot* snapshot = nullptr) const;
+    xdb_snapshot_ptr create_snapshot() const;
+    //RocksDB snapshot of handle,nullptr if handle is nullptr or not created by this DB
+    const rocksdb::Snapshot* get_snapshot(const xdb_snapshot_ptr& snapshot) const;
     bool exists(const std::string& key) const;
     bool write(const std::string& key, const std::string& value);
     bool write(const std::string& key, const char* data, size_t size);
@@ -196,32 +379,169 @@ public:
     bool erase(const std::string& key);
     bool erase(const std::vector<std::string>& keys);
     bool batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys);
+    bool write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback);
+    bool flush_async_writes();
+    bool bulk_load(const std::map<std::string, std::string>& objs);
     bool read_range(const std::string& prefix, std::vector<std::string>& values);
 
     bool single_delete(const std::string& key);
     bool delete_range(const std::string& begin_key,const std::string& end_key);
+    bool delete_ranges(const std::vector<std::pair<std::string, std::string>>& ranges);
     
     //iterator each key of prefix.note: go throuh whole db if prefix is empty
     bool read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie);
+    //native cursor when prefix is at one CF,nullptr if keys of prefix spread over several CFs
+    xdb_range_iterator_ptr new_range_iterator(const std::string& prefix);
     //iterator all cf data
     bool read_range_cf( rocksdb::ColumnFamilyHandle* target_cf, const std::string& prefix,xdb_iterator_callback callback_fuc,void * cookie);
+    //read options of iterator that seek to prefix,prefix bloom is used only when prefix cover whole account prefix
+    rocksdb::ReadOptions get_range_read_options(const std::string& prefix) const;
     //compact whole DB if both begin_key and end_key are empty
     //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
     bool compact_range(const std::string & begin_key,const std::string & end_key);
     bool get_estimate_num_keys(uint64_t & num) const;
     void GetDBMemStatus() const;
     static void destroy(const std::string& m_db_name);
+    bool migrate_cf_layout();
+    //export tickers & histograms of rocksdb::Statistics and stall related properties as metrics
+    void export_statistics() const;
+
+    //wall-clock timing of one DB call(XMETRICS_TIMER count cpu time of thread,so miss stalls and IO waits)
+    class xop_timer_t
+    {
+    public:
+        xop_timer_t(const xdb_impl & db, const char* op_name, const std::string & key, metrics::E_SIMPLE_METRICS_TAG tag)
+        : m_db(db), m_op_name(op_name), m_key(key), m_tag(tag), m_start(std::chrono::steady_clock::now()) {}
+        ~xop_timer_t() {
+            const uint64_t elapsed_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+            XMETRICS_GAUGE(m_tag, (int64_t)elapsed_us);
+            XMETRICS_HISTOGRAM(histogram_of(m_tag), elapsed_us);
+            if (m_db.m_slow_op_threshold_us > 0 && elapsed_us >= m_db.m_slow_op_threshold_us)
+                m_db.on_slow_op(m_op_name, m_key, elapsed_us);
+        }
+    private:
+        static metrics::E_HISTOGRAM_TAG histogram_of(metrics::E_SIMPLE_METRICS_TAG tag) {
+            switch (tag) {
+                case metrics::db_read_latency:    return metrics::db_read_latency_hist;
+                case metrics::db_write_latency:   return metrics::db_write_latency_hist;
+                case metrics::db_delete_latency:  return metrics::db_delete_latency_hist;
+                case metrics::db_compact_latency: return metrics::db_compact_latency_hist;
+                default:                          return metrics::e_histogram_begin; //not recorded
+            }
+        }
+        xop_timer_t(const xop_timer_t &);
+        xop_timer_t & operator = (const xop_timer_t &);
+    private:
+        const xdb_impl &                      m_db;
+        const char*                           m_op_name;
+        const std::string &                   m_key;  //caller keep it alive during the call
+        metrics::E_SIMPLE_METRICS_TAG         m_tag;
+        std::chrono::steady_clock::time_point m_start;
+    };
 
  private:
     rocksdb::ColumnFamilyHandle* get_cf_handle(const std::string& key) const;
+    rocksdb::ColumnFamilyHandle* get_shard_cf_handle(const std::string& key) const;
+    //return nullptr if key stays at CF of shard layout
+    rocksdb::ColumnFamilyHandle* get_key_type_cf_handle(const std::string& key) const;
+    //every CF that might hold keys start with prefix
+    void get_range_cf_handles(const std::string& prefix, std::vector<rocksdb::ColumnFamilyHandle*>& cf_handles) const;
+    bool read_cf(rocksdb::ColumnFamilyHandle* target_cf, const std::string& key, std::string& value, const rocksdb::Snapshot* snapshot = nullptr) const;
+    void collect_range_cf(rocksdb::ColumnFamilyHandle* target_cf, const std::string& prefix, std::map<std::string, std::string>& values) const;
+    //delete key from CFs it might be at
+    void delete_key(rocksdb::WriteBatch& batch, const std::string& key) const;
+    bool add_delete_range(rocksdb::WriteBatch& batch, const std::string& begin_key,const std::string& end_key);
+    bool is_cf_migrating() const { return (m_cf_layout.load() == enum_xdb_cf_layout_migrating); }
+    //writers go without lock while layout is settled,and only hold m_cf_migrate_lock one by one while keys are moving
+    struct xcf_write_guard_t {
+        xcf_write_guard_t() = default;
+        xcf_write_guard_t(xcf_write_guard_t && other) : lock(std::move(other.lock)), unlocked_writers(other.unlocked_writers) { other.unlocked_writers = nullptr; }
+        ~xcf_write_guard_t() {
+            if (unlocked_writers != nullptr)
+                unlocked_writers->fetch_sub(1);
+        }
+        std::unique_lock<std::mutex> lock;
+        std::atomic<uint32_t>*       unlocked_writers{nullptr}; //counted writer without lock
+    };
+    xcf_write_guard_t lock_for_cf_migration() const;
+    void load_cf_layout();
+    bool save_cf_layout(const int layout);
+    bool migrate_cf_keys(rocksdb::ColumnFamilyHandle* source_cf, uint64_t & moved_count);
+    bool move_cf_keys(rocksdb::ColumnFamilyHandle* source_cf, const std::vector<std::string>& keys, uint64_t & moved_count);
+    //build one sorted file of entries(already sorted by key) for target_cf
+    rocksdb::Status build_sst_file(rocksdb::ColumnFamilyHandle* target_cf, const std::vector<std::map<std::string, std::string>::const_iterator>& entries, const std::string& file_path) const;
     void handle_error(const rocksdb::Status& status) const;
+    void update_block_cache_metrics(rocksdb::ColumnFamilyHandle* target_cf) const;
+    
+    //async write pipeline
+    struct xwrite_request_t
+    {
+        std::map<std::string, std::string> objs;
+        std::vector<std::string>           delete_keys;
+        xdb_write_callback                 callback;
+    };
+    void async_write_loop();
+    void stop_async_writer();
+    void start_stats_exporter();
+    void stats_export_loop();
+    void stop_stats_exporter();
+    void add_memory_reporters();
+    void remove_memory_reporters();
+    void on_slow_op(const char* op_name, const std::string & key, const uint64_t elapsed_us) const;
+    //return 1 if found value,-1 if deleted,0 if key is not at queue
+    int  read_async_pending(const std::string& key, std::string& value) const;
+    //sync write only waits for queued async writes of the same keys,so it never lands before them nor waits for others
+    void wait_async_writes_before_sync_write(const std::string& key);
+    void wait_async_writes_before_sync_write(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys);
+    //caller must hold m_async_lock,return 0 if key is not at queue
+    uint64_t get_async_pending_seq(const std::string& key) const;
+    
     std::string             m_db_name{};
     rocksdb::DB*            m_db{nullptr};
     rocksdb::Options        m_options{};
     rocksdb::WriteBatch     m_batch{};
     std::vector<xColumnFamily>                m_cf_configs;
     std::vector<rocksdb::ColumnFamilyHandle*> m_cf_handles;
+    std::shared_ptr<rocksdb::Cache>           m_block_cache;  //shared by all CFs
     int                     m_db_kinds = {0};
+    
+    bool                    m_prefix_bloom_filter{true};
+    bool                    m_cf_routing_by_key_type{false};
+    bool                    m_blob_files{false};
+    uint64_t                m_min_blob_size{4096};
+    bool                    m_blob_gc{true};
+    double                  m_blob_gc_age_cutoff{0.25};
+    uint32_t                m_zstd_dict_bytes{0};
+    uint32_t                m_zstd_dict_train_ratio{100};
+    bool                    m_fresh_db{false};          //DB is created by this instance
+    rocksdb::ColumnFamilyHandle* m_meta_cf{nullptr};    //CF of enum_xdb_key_class_meta
+    rocksdb::ColumnFamilyHandle* m_txindex_cf{nullptr}; //CF of enum_xdb_key_class_txindex
+    std::atomic<int>        m_cf_layout{enum_xdb_cf_layout_shard};
+    mutable std::mutex      m_cf_migrate_lock;
+    mutable std::atomic<uint32_t> m_cf_unlocked_writers{0}; //writers going without m_cf_migrate_lock,migration waits them out before moving keys
+    bool                    m_async_write_sync{false};
+    uint32_t                m_wal_sync_interval_ms{0};
+    mutable std::mutex      m_async_lock;
+    std::condition_variable m_async_queue_cond;
+    std::condition_variable m_async_written_cond;
+    std::deque<xwrite_request_t> m_async_queue;     //waiting for next group commit
+    std::deque<xwrite_request_t> m_async_inflight;  //being written by writer,only writer modify it
+    std::atomic<uint64_t>   m_async_pending_count{0};
+    uint64_t                m_async_queued_seq{0};
+    uint64_t                m_async_written_seq{0};
+    std::unordered_map<std::string, uint64_t> m_async_pending_keys; //key -> seq of the last queued request that touch it
+    bool                    m_async_running{false};
+    std::thread             m_async_thread;
+    uint32_t                m_statistics_interval_sec{0};
+    uint64_t                m_slow_op_threshold_us{0};
+    mutable std::mutex      m_stats_lock;
+    std::condition_variable m_stats_cond;
+    bool                    m_stats_running{false};
+    std::thread             m_stats_thread;
+    mutable uint64_t        m_last_block_cache_hit{0};  //ticker value at last export,protected by m_stats_lock
+    mutable uint64_t        m_last_block_cache_miss{0};
+    uint64_t                m_memtables_reporter{0};    //ids at basic::xmemory_accounting_t
+    uint64_t                m_block_cache_reporter{0};
 };
 
 void    xdb::xdb_impl::disable_default_compress_options(rocksdb::ColumnFamilyOptions & default_db_options)
@@ -240,7 +560,7 @@ void    xdb::xdb_impl::disable_default_compress_options(rocksdb::ColumnFamilyOpt
     }
 }
 
-void xdb::xdb_impl::setup_default_db_options(rocksdb::Options & default_db_options,const int db_kinds)
+void xdb::xdb_impl::setup_default_db_options(rocksdb::Options & default_db_options,const int db_kinds,const xdb_options_t & db_options)
 {
     default_db_options.create_if_missing = true;
     default_db_options.create_missing_column_families = true;
@@ -293,9 +613,31 @@ void xdb::xdb_impl::setup_default_db_options(rocksdb::Options & default_db_optio
     //test max_open_files limit
     default_db_options.max_open_files = 4000;
 
+    //keep background I/O from hurting foreground latency:no page cache pollution,bounded bandwidth
+    default_db_options.use_direct_io_for_flush_and_compaction = db_options.direct_io_for_flush_and_compaction;
+    default_db_options.use_direct_reads = db_options.direct_reads;
+    if (db_options.compaction_readahead_size > 0)
+        default_db_options.compaction_readahead_size = (size_t)db_options.compaction_readahead_size;
+    else if (db_options.direct_io_for_flush_and_compaction)
+        default_db_options.compaction_readahead_size = 2 << 20; //direct I/O has no kernel readahead,small reads would kill compaction throughput
+    if (db_options.compaction_rate_limit_mb > 0)
+    {
+        //kAllIo:compaction reads are limited as well;foreground Get/MultiGet are never charged
+        default_db_options.rate_limiter.reset(rocksdb::NewGenericRateLimiter((int64_t)db_options.compaction_rate_limit_mb << 20, 100 * 1000, 10, rocksdb::RateLimiter::Mode::kAllIo));
+    }
+    s_io_uring_multiread.store(db_options.io_uring_multiread);
+    xkinfo("xdb_impl::setup_default_db_options,direct_io_for_flush_and_compaction(%d) direct_reads(%d) compaction_readahead_size(%zu) compaction_rate_limit_mb(%u) io_uring_multiread(%d)",
+           (int)db_options.direct_io_for_flush_and_compaction, (int)db_options.direct_reads, default_db_options.compaction_readahead_size, db_options.compaction_rate_limit_mb, (int)db_options.io_uring_multiread);
     return ;
 }
 
+uint64_t xdb::xdb_impl::get_default_block_cache_size(DB_OPTIONS_TYPE cache_type)
+{
+    if (DB_OPTIONS_DEFAULT == cache_type)
+        return 64 << 20;  //64M for small-memory machine
+    return 512 << 20;     //512M
+}
+
 void xdb::xdb_impl::setup_default_cf_options(xColumnFamily & cf_config,const size_t block_size,std::shared_ptr<rocksdb::Cache> & block_cache)
 {
     rocksdb::BlockBasedTableOptions table_options;
@@ -305,14 +647,22 @@ void xdb::xdb_impl::setup_default_cf_options(xColumnFamily & cf_config,const siz
     if(block_size > 0)
         table_options.block_size = block_size;
     if(block_cache != nullptr)
+    {
         table_options.block_cache = block_cache;
-    
-#ifdef DB_CACHE
-    table_options.cache_index_and_filter_blocks = true;
-    table_options.cache_index_and_filter_blocks_with_high_priority = true;
-    table_options.pin_l0_filter_and_index_blocks_in_cache = true;
-#endif
+        //charge index & filter to the shared budget instead of unbounded table-reader memory
+        table_options.cache_index_and_filter_blocks = true;
+        table_options.cache_index_and_filter_blocks_with_high_priority = true;
+        table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+    }
     table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    if(m_prefix_bloom_filter)
+    {
+        //filter carries both whole key(for Get) and account prefix(for Seek of read_range)
+        table_options.whole_key_filtering = true;
+        cf_config.cf_option.prefix_extractor = xdb_account_prefix_transform_t::instance();
+        cf_config.cf_option.memtable_prefix_bloom_size_ratio = 0.1;
+        cf_config.cf_option.memtable_whole_key_filtering = true;
+    }
     
     cf_config.cf_option.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
     
@@ -326,6 +676,43 @@ void xdb::xdb_impl::setup_default_cf_options(xColumnFamily & cf_config,const siz
     return;
 }
 
+void xdb::xdb_impl::setup_dict_cf_options(xColumnFamily & cf_config)
+{
+    if(0 == m_zstd_dict_bytes)
+        return;
+    
+    //blocks share much structure(addresses,property names,cert fields) that a single block is too small to exploit,
+    //so bottom level(where most data stays) trains a ZSTD dictionary from samples of each output SST and compress by it.
+    //each CF holds one kind of key(object,input,output...) so dictionary is trained per kind,and rotated by compaction
+    cf_config.cf_option.bottommost_compression = rocksdb::kZSTD;
+    cf_config.cf_option.bottommost_compression_opts.enabled = true;
+    cf_config.cf_option.bottommost_compression_opts.max_dict_bytes = m_zstd_dict_bytes;
+    cf_config.cf_option.bottommost_compression_opts.zstd_max_train_bytes = m_zstd_dict_bytes * std::max<uint32_t>(1, m_zstd_dict_train_ratio);
+    xkinfo("xdb_impl::setup_dict_cf_options,cf(%s) dict_bytes(%u) train_bytes(%u)",cf_config.cf_name.c_str(),m_zstd_dict_bytes,cf_config.cf_option.bottommost_compression_opts.zstd_max_train_bytes);
+}
+
+void xdb::xdb_impl::setup_blob_cf_options(xColumnFamily & cf_config)
+{
+    if(false == m_blob_files)
+        return;
+    
+    //integrated BlobDB:SST only keep blob index,so leveled compaction no longer rewrite big block bodies again and again
+    cf_config.cf_option.enable_blob_files = true;
+    cf_config.cf_option.min_blob_size = m_min_blob_size;
+    cf_config.cf_option.blob_file_size = 256 << 20; //256M
+    //blob is written once and cold mostly,use same compression as bottom level
+    if(cf_config.cf_option.bottommost_compression_opts.enabled)
+        cf_config.cf_option.blob_compression_type = cf_config.cf_option.bottommost_compression;
+    else
+        cf_config.cf_option.blob_compression_type = rocksdb::kNoCompression;
+    
+    //pruned blocks leave garbage at blob files,gc relocate valid blobs of oldest files then drop them
+    cf_config.cf_option.enable_blob_garbage_collection = m_blob_gc;
+    cf_config.cf_option.blob_garbage_collection_age_cutoff = m_blob_gc_age_cutoff;
+    cf_config.cf_option.blob_compaction_readahead_size = 2 << 20; //2M,blob files are read sequentially by gc
+    xkinfo("xdb_impl::setup_blob_cf_options,cf(%s) min_blob_size(%llu) blob_gc(%d) cutoff(%f)",cf_config.cf_name.c_str(),(unsigned long long)m_min_blob_size,(int)m_blob_gc,m_blob_gc_age_cutoff);
+}
+
 //setup ColumnFamily(CF) of read & write,as default CF
 xColumnFamily xdb::xdb_impl::setup_default_cf()
 {
@@ -335,8 +722,7 @@ xColumnFamily xdb::xdb_impl::setup_default_cf()
     cf_config.cf_option.compression_per_level = m_options.compression_per_level;
     
     const size_t block_size = 0; //use default one(4 * 1024)
-    std::shared_ptr<rocksdb::Cache> block_cache = nullptr; //use default one(8M)
-    setup_default_cf_options(cf_config,block_size,block_cache);
+    setup_default_cf_options(cf_config,block_size,m_block_cache);
     
     return cf_config;
 }
@@ -354,8 +740,7 @@ xColumnFamily xdb::xdb_impl::setup_universal_style_cf(const std::string & name,u
     cf_config.cf_option.OptimizeUniversalStyleCompaction(memtable_memory_budget);
     
     const size_t block_size = 0; //use default one(4 * 1024)
-    std::shared_ptr<rocksdb::Cache> block_cache = nullptr; //use default one(8M)
-    setup_default_cf_options(cf_config,block_size,block_cache);
+    setup_default_cf_options(cf_config,block_size,m_block_cache);
     
     if(false == cf_config.cf_option.compression_opts.enabled)//force turn off for each level
     {
@@ -366,7 +751,7 @@ xColumnFamily xdb::xdb_impl::setup_universal_style_cf(const std::string & name,u
     return cf_config;
 }
 
- xColumnFamily xdb::xdb_impl::setup_level_style_cf(DB_OPTIONS_TYPE cache_type,const std::string & name,std::shared_ptr<rocksdb::Cache> &block_cache, uint64_t memtable_memory_budget ,int num_levels)
+ xColumnFamily xdb::xdb_impl::setup_level_style_cf(const std::string & name,std::shared_ptr<rocksdb::Cache> &block_cache, uint64_t memtable_memory_budget ,int num_levels)
 {
     xColumnFamily  cf_config;
     cf_config.cf_name = name;
@@ -379,20 +764,8 @@ xColumnFamily xdb::xdb_impl::setup_universal_style_cf(const std::string & name,u
     //cf_config.cf_option.write_buffer_size  = (32 << 20);   //test 
     cf_config.cf_option.OptimizeLevelStyleCompaction(memtable_memory_budget);
     
-    if(NULL == block_cache) {
-        size_t block_size = 8 * 1024; //adv size 8K
-        std::shared_ptr<rocksdb::Cache> new_cache = nullptr;
-        if (DB_OPTIONS_DEFAULT == cache_type) {
-            block_size = 4 * 1024; //adv size 8K
-            new_cache = rocksdb::NewLRUCache(8 << 20); //8M
-        } else {
-            new_cache = rocksdb::NewLRUCache(32 << 20);//32M
-        }
-        setup_default_cf_options(cf_config,block_size,new_cache);
-    } else {
-        const size_t block_size = 4 * 1024; //4K
-        setup_default_cf_options(cf_config,block_size,block_cache);
-    }
+    const size_t block_size = 4 * 1024; //4K
+    setup_default_cf_options(cf_config,block_size,block_cache);
 
     if(false == cf_config.cf_option.compression_opts.enabled)//force turn off for each level
     {
@@ -434,6 +807,40 @@ xColumnFamily xdb::xdb_impl::setup_fifo_style_cf(const std::string & name,uint64
     return cf_config;
 }
 
+//setup ColumnFamily(CF) for small & hot meta(block index,account span & meta) that updated often
+//small block and no compression to get lowest latency of point lookup,and keep it apart from compaction of big block bodies
+xColumnFamily xdb::xdb_impl::setup_meta_cf(const std::string & name,uint64_t memtable_memory_budget)
+{
+    xColumnFamily  cf_config;
+    cf_config.cf_name = name;
+    cf_config.cf_option = rocksdb::ColumnFamilyOptions();
+    cf_config.cf_option.num_levels = m_options.num_levels;
+    cf_config.cf_option.OptimizeLevelStyleCompaction(memtable_memory_budget);
+    
+    const size_t block_size = 4 * 1024; //4K
+    setup_default_cf_options(cf_config,block_size,m_block_cache);
+    xdb::xdb_impl::disable_default_compress_options(cf_config.cf_option);
+    return cf_config;
+}
+
+//setup ColumnFamily(CF) for tx index,which is write once and read by random hash(no locality)
+xColumnFamily xdb::xdb_impl::setup_txindex_cf(const std::string & name,uint64_t memtable_memory_budget)
+{
+    xColumnFamily  cf_config;
+    cf_config.cf_name = name;
+    cf_config.cf_option = rocksdb::ColumnFamilyOptions();
+    cf_config.cf_option.num_levels = m_options.num_levels;
+    cf_config.cf_option.OptimizeLevelStyleCompaction(memtable_memory_budget);
+    
+    const size_t block_size = 4 * 1024; //4K
+    setup_default_cf_options(cf_config,block_size,m_block_cache);
+    if(false == cf_config.cf_option.compression_opts.enabled)//force turn off for each level
+    {
+        xdb::xdb_impl::disable_default_compress_options(cf_config.cf_option);
+    }
+    return cf_config;
+}
+
 bool xdb::xdb_impl::open()
 {
     if (m_db == nullptr)
@@ -477,9 +884,16 @@ bool xdb::xdb_impl::open()
             {
                 if(cf.cf_name == rocksdb::kDefaultColumnFamilyName)
                     m_cf_handles[0] = cf.cf_handle; //always put default one to slot of 0
+                else if(cf.cf_name == s_meta_cf_name) //CF of key type is not mapped by first char
+                    m_meta_cf = cf.cf_handle;
+                else if(cf.cf_name == s_txindex_cf_name)
+                    m_txindex_cf = cf.cf_handle;
                 else
                     m_cf_handles[cf.cf_name.at(0)] = cf.cf_handle;
             }
+            load_cf_layout();
+            start_stats_exporter();
+            add_memory_reporters();
             
             rocksdb::Options working_options = m_db->GetOptions();
             if(working_options.compression_per_level.empty())
@@ -508,6 +922,9 @@ bool xdb::xdb_impl::open()
 }
 bool xdb::xdb_impl::close()
 {
+    stop_async_writer(); //drain queued writes before handles are gone
+    stop_stats_exporter();
+    remove_memory_reporters();
     if (m_db)
     {
         rocksdb::DB* old_db_ptr = m_db;
@@ -521,6 +938,8 @@ bool xdb::xdb_impl::close()
         m_db = NULL;
         
         //clear ptr
+        m_meta_cf    = nullptr;
+        m_txindex_cf = nullptr;
         for(size_t i = 0; i < m_cf_handles.size(); ++i)
         {
             m_cf_handles[i] = NULL;
@@ -536,7 +955,7 @@ bool xdb::xdb_impl::close()
 }
 
 //db_kinds refer to xdb_kind_t
-xdb::xdb_impl::xdb_impl(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths)
+xdb::xdb_impl::xdb_impl(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths,const xdb_options_t & db_options)
 {
     m_db_kinds = db_kinds;
     m_cf_handles.clear();
@@ -568,8 +987,29 @@ xdb::xdb_impl::xdb_impl(const int db_kinds,const std::string& db_root_dir,std::v
     }
 
     xkinfo("xdb_impl::init,db_root_dir=%s,memory Totalram %llu, Available: %llu.cache_type:%d",db_root_dir.c_str(), total_ram, free_ram, cache_type);
+    
+    const uint64_t block_cache_size = (db_options.block_cache_size > 0) ? db_options.block_cache_size : get_default_block_cache_size(cache_type);
+    m_block_cache = xshared_block_cache_t::instance(block_cache_size);
+    m_prefix_bloom_filter = db_options.prefix_bloom_filter;
+    m_cf_routing_by_key_type = db_options.cf_routing_by_key_type;
+    m_blob_files = db_options.blob_files;
+    m_min_blob_size = db_options.min_blob_size;
+    m_blob_gc = db_options.blob_gc;
+    m_blob_gc_age_cutoff = db_options.blob_gc_age_cutoff;
+    m_zstd_dict_bytes = db_options.zstd_dict_bytes;
+    m_zstd_dict_train_ratio = db_options.zstd_dict_train_ratio;
+    m_async_write_sync = db_options.async_write_sync;
+    m_wal_sync_interval_ms = db_options.wal_sync_interval_ms;
+    m_statistics_interval_sec = db_options.statistics_interval_sec;
+    m_slow_op_threshold_us = (uint64_t)db_options.slow_op_threshold_ms * 1000;
     m_db_name = db_root_dir;
-    xdb::xdb_impl::setup_default_db_options(m_options,m_db_kinds);//setup base options first
+    xdb::xdb_impl::setup_default_db_options(m_options,m_db_kinds,db_options);//setup base options first
+    if (db_options.statistics)
+    {
+        //detailed timers(e.g. mutex wait) are expensive,counters & op histograms cost a few percent at most
+        m_options.statistics = rocksdb::CreateDBStatistics();
+        m_options.statistics->set_stats_level(rocksdb::StatsLevel::kExceptDetailedTimers);
+    }
     if(db_paths.empty() == false)
     {
         for(auto it : db_paths)
@@ -586,22 +1026,43 @@ xdb::xdb_impl::xdb_impl(const int db_kinds,const std::string& db_root_dir,std::v
     
     std::vector<xColumnFamily> cf_list;
     cf_list.push_back(setup_default_cf()); //default is always first one
+    if ((m_db_kinds & xdb_kind_no_multi_cf) != 0) //block bodies are at default CF as well
+    {
+        setup_dict_cf_options(cf_list[0]);
+        setup_blob_cf_options(cf_list[0]);
+    }
 
     if ((m_db_kinds & xdb_kind_no_multi_cf) == 0)
     {
         uint64_t memory_budget = 0;
-        std::shared_ptr<rocksdb::Cache> block_cache = NULL; //block_cache is NULL 
         if(DB_OPTIONS_DEFAULT == cache_type) {
             memory_budget = 64 * 1024 * 1024;
         } else {
             memory_budget = 128 * 1024 * 1024;
         }
-        cf_list.push_back(setup_level_style_cf(cache_type, "1", block_cache, memory_budget)); //block 'cf[1]
-        cf_list.push_back(setup_level_style_cf(cache_type, "2", block_cache, memory_budget)); //block 'cf[2]
-        cf_list.push_back(setup_level_style_cf(cache_type, "3", block_cache, memory_budget)); //block 'cf[3]
-        cf_list.push_back(setup_level_style_cf(cache_type, "4", block_cache, memory_budget)); //block 'cf[4]
+        cf_list.push_back(setup_level_style_cf("1", m_block_cache, memory_budget)); //block 'cf[1]
+        cf_list.push_back(setup_level_style_cf("2", m_block_cache, memory_budget)); //block 'cf[2]
+        cf_list.push_back(setup_level_style_cf("3", m_block_cache, memory_budget)); //block 'cf[3]
+        cf_list.push_back(setup_level_style_cf("4", m_block_cache, memory_budget)); //block 'cf[4]
+        for(size_t i = 1; i < cf_list.size(); ++i) //block object,input & output of 'r' keys are at cf[1]~cf[4]
+        {
+            setup_dict_cf_options(cf_list[i]); //before blob,so blob files follow bottom compression
+            setup_blob_cf_options(cf_list[i]);
+        }
         //cf_list.push_back(setup_fifo_style_cf("f"));  //fifo
         //XTODO,add other CF here
+        
+        //CFs by key type,empty until layout is switched(refer enum_xdb_cf_layout)
+        //note:readonly DB can not create CF,so only open them when exist
+        std::vector<std::string> existing_cf_names;
+        m_fresh_db = (false == rocksdb::DB::ListColumnFamilies(m_options, m_db_name, &existing_cf_names).ok());
+        const bool has_key_type_cfs = (std::find(existing_cf_names.begin(), existing_cf_names.end(), s_meta_cf_name) != existing_cf_names.end())
+                                   && (std::find(existing_cf_names.begin(), existing_cf_names.end(), s_txindex_cf_name) != existing_cf_names.end());
+        if( ((m_db_kinds & xdb_kind_readonly) == 0) || has_key_type_cfs )
+        {
+            cf_list.push_back(setup_meta_cf(s_meta_cf_name, memory_budget >> 1));
+            cf_list.push_back(setup_txindex_cf(s_txindex_cf_name, memory_budget >> 1));
+        }
     }
     
     m_cf_configs = cf_list;
@@ -615,6 +1076,80 @@ xdb::xdb_impl::~xdb_impl() {
 
 
 rocksdb::ColumnFamilyHandle* xdb::xdb_impl::get_cf_handle(const std::string& key) const
+{
+    if(m_cf_layout.load() != enum_xdb_cf_layout_shard)
+    {
+        rocksdb::ColumnFamilyHandle* key_type_cf = get_key_type_cf_handle(key);
+        if(key_type_cf != nullptr)
+            return key_type_cf;
+    }
+    return get_shard_cf_handle(key);
+}
+
+rocksdb::ColumnFamilyHandle* xdb::xdb_impl::get_key_type_cf_handle(const std::string& key) const
+{
+    switch(get_xdb_key_class(key))
+    {
+        case enum_xdb_key_class_meta:
+            return m_meta_cf;
+        case enum_xdb_key_class_txindex:
+            return m_txindex_cf;
+        default:
+            return nullptr;
+    }
+}
+
+void xdb::xdb_impl::get_range_cf_handles(const std::string& prefix, std::vector<rocksdb::ColumnFamilyHandle*>& cf_handles) const
+{
+    cf_handles.push_back(get_shard_cf_handle(prefix));
+    if( (m_cf_layout.load() == enum_xdb_cf_layout_shard) || prefix.empty() )
+        return;
+    
+    //range of account may cover both index(at meta CF) and block body(at shard CF)
+    rocksdb::ColumnFamilyHandle* key_type_cf = nullptr;
+    if( (prefix[0] == enum_xvdb_cf_type_read_most) || (prefix[0] == enum_xvdb_cf_type_update_most) )
+        key_type_cf = m_meta_cf;
+    else if(prefix[0] == enum_xvdb_cf_type_log_only)
+        key_type_cf = m_txindex_cf;
+    
+    if( (key_type_cf != nullptr) && (key_type_cf != cf_handles[0]) )
+        cf_handles.push_back(key_type_cf);
+}
+
+xdb::xdb_impl::xcf_write_guard_t xdb::xdb_impl::lock_for_cf_migration() const
+{
+    xcf_write_guard_t guard;
+    if( (m_meta_cf == nullptr) || (m_cf_layout.load() == enum_xdb_cf_layout_key_type) )
+        return guard; //layout never change
+    
+    if(m_cf_layout.load() != enum_xdb_cf_layout_migrating)
+    {
+        //count first then check layout again,migration stores layout first then waits for counted writers,so one of both sees the other
+        m_cf_unlocked_writers.fetch_add(1);
+        if(m_cf_layout.load() != enum_xdb_cf_layout_migrating)
+        {
+            guard.unlocked_writers = &m_cf_unlocked_writers;
+            return guard;
+        }
+        m_cf_unlocked_writers.fetch_sub(1);
+    }
+    guard.lock = std::unique_lock<std::mutex>(m_cf_migrate_lock);
+    return guard;
+}
+
+void xdb::xdb_impl::delete_key(rocksdb::WriteBatch& batch, const std::string& key) const
+{
+    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
+    batch.Delete(target_cf, key);
+    if(is_cf_migrating()) //old copy may still be at CF of shard layout
+    {
+        rocksdb::ColumnFamilyHandle* shard_cf = get_shard_cf_handle(key);
+        if(shard_cf != target_cf)
+            batch.Delete(shard_cf, key);
+    }
+}
+
+rocksdb::ColumnFamilyHandle* xdb::xdb_impl::get_shard_cf_handle(const std::string& key) const
 {
     if(key.size() >= 2)//hit most case
     {
@@ -683,14 +1218,92 @@ void xdb::xdb_impl::handle_error(const rocksdb::Status& status) const {
     }
 }
 
-bool xdb::xdb_impl::read(const std::string& key, std::string& value) const {
+void xdb::xdb_impl::update_block_cache_metrics(rocksdb::ColumnFamilyHandle* target_cf) const {
+#ifdef ENABLE_METRICS
+    //perf_context is thread-local and only counted for the Get just finished at this thread
+    const rocksdb::PerfContext* perf_ctx = rocksdb::get_perf_context();
+    const uint32_t cf_id = target_cf->GetID();
+    if (cf_id < (uint32_t)enum_xdb_cf_metrics_max_count) {
+        XMETRICS_ARRCNT_INCR(metrics::db_cf_block_cache_hit, cf_id, (int64_t)perf_ctx->block_cache_hit_count);
+        XMETRICS_ARRCNT_INCR(metrics::db_cf_block_cache_miss, cf_id, (int64_t)perf_ctx->block_read_count);
+    }
+#endif
+}
+
+bool xdb::xdb_impl::read(const std::string& key, std::string& value, const rocksdb::Snapshot* snapshot) const {
+    if ((snapshot == nullptr) && (m_async_pending_count.load() > 0)) { //queued writes are after any snapshot
+        const int pending_ret = read_async_pending(key, value);
+        if (pending_ret != 0)
+            return (pending_ret > 0);
+    }
     rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
+    if (read_cf(target_cf, key, value, snapshot))
+        return true;
     
+    if (is_cf_migrating()) {
+        rocksdb::ColumnFamilyHandle* shard_cf = get_shard_cf_handle(key);
+        if (shard_cf != target_cf) {
+            if (read_cf(shard_cf, key, value, snapshot))
+                return true;
+            if (snapshot != nullptr) //a key can not move under snapshot
+                return false;
+            return read_cf(target_cf, key, value); //might be moved between two reads above
+        }
+    }
+    return false;
+}
+
+bool xdb::xdb_impl::read_cf(rocksdb::ColumnFamilyHandle* target_cf, const std::string& key, std::string& value, const rocksdb::Snapshot* snapshot) const {
     rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
     target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
     target_opt.verify_checksums = false; //application has own checksum
+    target_opt.snapshot = snapshot;
     
+#ifdef ENABLE_METRICS
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+    rocksdb::get_perf_context()->Reset();
+#endif
     rocksdb::Status s = m_db->Get(target_opt, target_cf, rocksdb::Slice(key), &value);
+    update_block_cache_metrics(target_cf);
+    if (!s.ok()) {
+        if (s.IsNotFound()) {
+            return false;
+        }
+        handle_error(s);
+        return false;
+    }
+    return true;
+}
+
+bool xdb::xdb_impl::read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const {
+    if (is_cf_migrating()) { //value may be at either CF,take the fallback path of read
+        std::unique_ptr<xdb_string_value_t> string_value(new xdb_string_value_t());
+        if (!read(key, string_value->value()))
+            return false;
+        value = std::move(string_value);
+        return true;
+    }
+    if (m_async_pending_count.load() > 0) { //queued value is not at DB yet,copy it out
+        std::unique_ptr<xdb_string_value_t> string_value(new xdb_string_value_t());
+        const int pending_ret = read_async_pending(key, string_value->value());
+        if (pending_ret > 0)
+            value = std::move(string_value);
+        if (pending_ret != 0)
+            return (pending_ret > 0);
+    }
+    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
+    
+    rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
+    target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
+    target_opt.verify_checksums = false; //application has own checksum
+    
+    std::unique_ptr<xdb_rocksdb_pinned_value_t> pinned_value(new xdb_rocksdb_pinned_value_t());
+#ifdef ENABLE_METRICS
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+    rocksdb::get_perf_context()->Reset();
+#endif
+    rocksdb::Status s = m_db->Get(target_opt, target_cf, rocksdb::Slice(key), pinned_value->slice());
+    update_block_cache_metrics(target_cf);
     if (!s.ok()) {
         if (s.IsNotFound()) {
             return false;
@@ -698,15 +1311,91 @@ bool xdb::xdb_impl::read(const std::string& key, std::string& value) const {
         handle_error(s);
         return false;
     }
+    value = std::move(pinned_value);
     return true;
 }
 
+bool xdb::xdb_impl::multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values, const rocksdb::Snapshot* snapshot) const {
+    values.clear();
+    values.resize(keys.size());
+    if (keys.empty())
+        return true;
+    if (is_cf_migrating()) { //value may be at either CF,take the fallback path of read
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (!read(keys[i], values[i], snapshot))
+                values[i].clear();
+        }
+        return true;
+    }
+
+    //keys queued by async writer are answered directly,the rest go to DB by one batched MultiGet
+    std::vector<size_t> db_key_indexs;
+    db_key_indexs.reserve(keys.size());
+    const bool has_pending = (snapshot == nullptr) && (m_async_pending_count.load() > 0);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (has_pending && (read_async_pending(keys[i], values[i]) != 0))
+            continue;
+        db_key_indexs.push_back(i);
+    }
+    if (db_key_indexs.empty())
+        return true;
+
+    const size_t num_keys = db_key_indexs.size();
+    std::vector<rocksdb::ColumnFamilyHandle*> target_cfs(num_keys);
+    std::vector<rocksdb::Slice> target_keys(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+        const std::string & key = keys[db_key_indexs[i]];
+        target_cfs[i] = get_cf_handle(key);
+        target_keys[i] = rocksdb::Slice(key);
+    }
+    std::vector<rocksdb::PinnableSlice> target_values(num_keys);
+    std::vector<rocksdb::Status> target_status(num_keys);
+
+    rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
+    target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
+    target_opt.verify_checksums = false; //application has own checksum
+    target_opt.snapshot = snapshot;
+
+    m_db->MultiGet(target_opt, num_keys, target_cfs.data(), target_keys.data(), target_values.data(), target_status.data());
+
+    bool ret = true;
+    for (size_t i = 0; i < num_keys; ++i) {
+        const rocksdb::Status & s = target_status[i];
+        if (s.ok()) {
+            values[db_key_indexs[i]].assign(target_values[i].data(), target_values[i].size());
+        } else if (!s.IsNotFound()) {
+            handle_error(s);
+            ret = false;
+        }
+    }
+    return ret;
+}
+
+xdb_snapshot_ptr xdb::xdb_impl::create_snapshot() const {
+    if (m_db == nullptr)
+        return nullptr;
+    return std::make_shared<xdb_rocksdb_snapshot_t>(m_db);
+}
+
+const rocksdb::Snapshot* xdb::xdb_impl::get_snapshot(const xdb_snapshot_ptr& snapshot) const {
+    if (snapshot == nullptr)
+        return nullptr;
+    const xdb_rocksdb_snapshot_t* rocksdb_snapshot = dynamic_cast<const xdb_rocksdb_snapshot_t*>(snapshot.get());
+    if ((rocksdb_snapshot == nullptr) || (rocksdb_snapshot->db() != m_db)) {
+        xwarn("xdb_impl::get_snapshot,snapshot is not created by DB(%s),read live DB", m_db_name.c_str());
+        return nullptr;
+    }
+    return rocksdb_snapshot->get();
+}
+
 bool xdb::xdb_impl::exists(const std::string& key) const {
     std::string value;
     return read(key, value);
 }
 
 bool xdb::xdb_impl::write(const std::string& key, const std::string& value) {
+    wait_async_writes_before_sync_write(key);
+    auto migrate_guard = lock_for_cf_migration();
     rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
     
     rocksdb::Status s = m_db->Put(rocksdb::WriteOptions(), target_cf, rocksdb::Slice(key), rocksdb::Slice(value));
@@ -715,6 +1404,8 @@ bool xdb::xdb_impl::write(const std::string& key, const std::string& value) {
 }
 
 bool xdb::xdb_impl::write(const std::string& key, const char* data, size_t size) {
+    wait_async_writes_before_sync_write(key);
+    auto migrate_guard = lock_for_cf_migration();
     rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
     
     rocksdb::Status s = m_db->Put(rocksdb::WriteOptions(), target_cf, rocksdb::Slice(key), rocksdb::Slice(data, size));
@@ -723,6 +1414,8 @@ bool xdb::xdb_impl::write(const std::string& key, const char* data, size_t size)
 }
 
 bool xdb::xdb_impl::write(const std::map<std::string, std::string>& batches) {
+    wait_async_writes_before_sync_write(batches, std::vector<std::string>());
+    auto migrate_guard = lock_for_cf_migration();
     rocksdb::WriteBatch batch;
     for (const auto& entry: batches) {
         rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(entry.first);
@@ -736,9 +1429,16 @@ bool xdb::xdb_impl::write(const std::map<std::string, std::string>& batches) {
 
 
 bool xdb::xdb_impl::erase(const std::string& key) {
-    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
-    
-    rocksdb::Status s = m_db->Delete(rocksdb::WriteOptions(), target_cf, rocksdb::Slice(key));
+    wait_async_writes_before_sync_write(key);
+    auto migrate_guard = lock_for_cf_migration();
+    rocksdb::Status s;
+    if (is_cf_migrating()) {
+        rocksdb::WriteBatch batch;
+        delete_key(batch, key);
+        s = m_db->Write(rocksdb::WriteOptions(), &batch);
+    } else {
+        s = m_db->Delete(rocksdb::WriteOptions(), get_cf_handle(key), rocksdb::Slice(key));
+    }
     if (!s.ok()) {
         if (s.IsNotFound()) //possible case
             return true;
@@ -750,10 +1450,11 @@ bool xdb::xdb_impl::erase(const std::string& key) {
 }
 
 bool xdb::xdb_impl::erase(const std::vector<std::string>& keys) {
+    wait_async_writes_before_sync_write(std::map<std::string, std::string>(), keys);
+    auto migrate_guard = lock_for_cf_migration();
     rocksdb::WriteBatch batch;
     for (const auto& key: keys) {
-        rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
-        batch.Delete(target_cf, key);
+        delete_key(batch, key);
     }
     rocksdb::Status s = m_db->Write(rocksdb::WriteOptions(), &batch);
     handle_error(s);
@@ -761,6 +1462,8 @@ bool xdb::xdb_impl::erase(const std::vector<std::string>& keys) {
 }
 
 bool xdb::xdb_impl::batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) {
+    wait_async_writes_before_sync_write(objs, delete_keys);
+    auto migrate_guard = lock_for_cf_migration();
     rocksdb::WriteBatch batch;
     for (const auto& entry: objs) {
         rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(entry.first);
@@ -768,64 +1471,572 @@ bool xdb::xdb_impl::batch_change(const std::map<std::string, std::string>& objs,
         batch.Put(target_cf, entry.first, entry.second);
     }
     for (const auto& key: delete_keys) {
-        rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
         XMETRICS_GAUGE(metrics::db_delete, 1);
-        batch.Delete(target_cf, key);
+        delete_key(batch, key);
     }
     rocksdb::Status s = m_db->Write(rocksdb::WriteOptions(), &batch);
     handle_error(s);
     return s.ok();
 }
 
-bool xdb::xdb_impl::single_delete(const std::string& key)
-{
-    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
- 
-    rocksdb::Status res = m_db->SingleDelete(rocksdb::WriteOptions(), target_cf, rocksdb::Slice(key));
-    if (!res.ok())
-    {
-        if (res.IsNotFound()) //possible case
-            return true;
-        
-        handle_error(res);
-        return false;
-    }
-    return true;
-}
-
-bool xdb::xdb_impl::delete_range(const std::string& begin_key,const std::string& end_key)
+bool xdb::xdb_impl::write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback)
 {
-    rocksdb::ColumnFamilyHandle* begin_cf = get_cf_handle(begin_key);
-    rocksdb::ColumnFamilyHandle* end_cf   = get_cf_handle(end_key);
-    if(end_cf != begin_cf)
+    if ((m_db == nullptr) || ((m_db_kinds & xdb_kind_readonly) != 0))
     {
-        xerror("xdb_impl::delete_range,keys are at different CFs,beginCF(%s) != endCF(%s)",begin_cf->GetName().c_str(),end_cf->GetName().c_str());
+        xerror("xdb_impl::write_async,db is closed or readonly,db name %s", m_db_name.c_str());
         return false;
     }
     
-    rocksdb::Status res = m_db->DeleteRange(rocksdb::WriteOptions(),begin_cf,rocksdb::Slice(begin_key), rocksdb::Slice(end_key));
-    if (!res.ok())
+    xwrite_request_t request;
+    request.objs = objs;
+    request.delete_keys = delete_keys;
+    request.callback = std::move(callback);
     {
-        if (res.IsNotFound()) //possible case
-            return true;
-        
-        handle_error(res);
-        return false;
+        std::lock_guard<std::mutex> guard(m_async_lock);
+        if (false == m_async_running) //start writer at first use,so readonly tools never pay for it
+        {
+            m_async_running = true;
+            m_async_thread = std::thread(&xdb::xdb_impl::async_write_loop, this);
+        }
+        const uint64_t seq = ++m_async_queued_seq;
+        for (auto const & entry : request.objs)
+            m_async_pending_keys[entry.first] = seq;
+        for (auto const & key : request.delete_keys)
+            m_async_pending_keys[key] = seq;
+        m_async_queue.push_back(std::move(request));
+        m_async_pending_count.fetch_add(1);
     }
+    m_async_queue_cond.notify_one();
     return true;
 }
 
-void xdb::xdb_impl::destroy(const std::string& m_db_name) {
-    rocksdb::DestroyDB(m_db_name, rocksdb::Options());
+bool xdb::xdb_impl::flush_async_writes()
+{
+    std::unique_lock<std::mutex> lock(m_async_lock);
+    if (false == m_async_running)
+        return true;
+    if (std::this_thread::get_id() == m_async_thread.get_id()) //called from callback at writer thread,which never wait for itself
+        return true;
+    const uint64_t target_seq = m_async_queued_seq;
+    m_async_written_cond.wait(lock, [this, target_seq] { return m_async_written_seq >= target_seq; });
+    return true;
 }
 
-bool xdb::xdb_impl::read_range(const std::string& prefix, std::vector<std::string>& values) {
+uint64_t xdb::xdb_impl::get_async_pending_seq(const std::string& key) const
+{
+    auto it = m_async_pending_keys.find(key);
+    return (it != m_async_pending_keys.end()) ? it->second : 0;
+}
+
+void xdb::xdb_impl::wait_async_writes_before_sync_write(const std::string& key)
+{
+    if (m_async_pending_count.load() == 0)
+        return;
+    std::unique_lock<std::mutex> lock(m_async_lock);
+    if (std::this_thread::get_id() == m_async_thread.get_id()) //called from callback at writer thread,its group is written already
+        return;
+    const uint64_t target_seq = get_async_pending_seq(key);
+    if (target_seq > 0)
+        m_async_written_cond.wait(lock, [this, target_seq] { return m_async_written_seq >= target_seq; });
+}
+
+void xdb::xdb_impl::wait_async_writes_before_sync_write(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys)
+{
+    if (m_async_pending_count.load() == 0)
+        return;
+    std::unique_lock<std::mutex> lock(m_async_lock);
+    if (std::this_thread::get_id() == m_async_thread.get_id()) //called from callback at writer thread,its group is written already
+        return;
+    uint64_t target_seq = 0;
+    for (auto const & entry : objs)
+        target_seq = std::max(target_seq, get_async_pending_seq(entry.first));
+    for (auto const & key : delete_keys)
+        target_seq = std::max(target_seq, get_async_pending_seq(key));
+    if (target_seq > 0)
+        m_async_written_cond.wait(lock, [this, target_seq] { return m_async_written_seq >= target_seq; });
+}
+
+rocksdb::Status xdb::xdb_impl::build_sst_file(rocksdb::ColumnFamilyHandle* target_cf, const std::vector<std::map<std::string, std::string>::const_iterator>& entries, const std::string& file_path) const
+{
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), m_db->GetOptions(target_cf), target_cf);
+    rocksdb::Status s = writer.Open(file_path);
+    for (auto it = entries.begin(); s.ok() && (it != entries.end()); ++it)
+        s = writer.Put((*it)->first, (*it)->second);
+    if (s.ok())
+        s = writer.Finish();
+    return s;
+}
+
+bool xdb::xdb_impl::bulk_load(const std::map<std::string, std::string>& objs)
+{
+    if (objs.empty())
+        return true;
+    if ((m_db == nullptr) || ((m_db_kinds & xdb_kind_readonly) != 0))
+    {
+        xerror("xdb_impl::bulk_load,db is closed or readonly,db name %s", m_db_name.c_str());
+        return false;
+    }
+    wait_async_writes_before_sync_write(objs, std::vector<std::string>());
+    auto migrate_guard = lock_for_cf_migration();
+
+    //keys of map are sorted by bytewise order,so entries of each CF keep sorted as SstFileWriter required
+    std::map<rocksdb::ColumnFamilyHandle*, std::vector<std::map<std::string, std::string>::const_iterator>> cf_entries;
+    for (auto it = objs.begin(); it != objs.end(); ++it)
+    {
+        XMETRICS_GAUGE(metrics::db_write_size, it->second.size());
+        cf_entries[get_cf_handle(it->first)].push_back(it);
+    }
+
+    //files of CFs are built in parallel,then each one is moved into its CF
+    static std::atomic<uint64_t> s_bulk_file_seq{0};
+    const uint64_t file_seq = s_bulk_file_seq.fetch_add(1);
+    std::vector<std::pair<rocksdb::ColumnFamilyHandle*, std::string>> cf_files;
+    std::vector<std::future<rocksdb::Status>> build_results;
+    for (auto const & entry : cf_entries)
+    {
+        rocksdb::ColumnFamilyHandle* target_cf = entry.first;
+        const std::string file_path = m_db_name + "/bulk_load_" + std::to_string(file_seq) + "_" + std::to_string(target_cf->GetID()) + ".sst";
+        cf_files.emplace_back(target_cf, file_path);
+        auto const & entries = entry.second;
+        build_results.push_back(std::async(std::launch::async, [this, target_cf, &entries, file_path] { return build_sst_file(target_cf, entries, file_path); }));
+    }
+
+    bool ret = true;
+    for (size_t i = 0; i < cf_files.size(); ++i)
+    {
+        rocksdb::Status s = build_results[i].get();
+        if (s.ok())
+        {
+            rocksdb::IngestExternalFileOptions ingest_options;
+            ingest_options.move_files = true; //hard link instead of copy,file stays at same filesystem as DB
+            s = m_db->IngestExternalFile(cf_files[i].first, {cf_files[i].second}, ingest_options);
+        }
+        if (!s.ok())
+        {
+            xerror("xdb_impl::bulk_load,fail for file %s,error %s", cf_files[i].second.c_str(), s.ToString().c_str());
+            handle_error(s);
+            ret = false;
+        }
+        m_options.env->DeleteFile(cf_files[i].second); //left only if ingest failed or copied
+    }
+    xinfo("xdb_impl::bulk_load,keys=%zu,cfs=%zu,ret=%d,db name %s", objs.size(), cf_files.size(), ret, m_db_name.c_str());
+    return ret;
+}
+
+int xdb::xdb_impl::read_async_pending(const std::string& key, std::string& value) const
+{
+    std::lock_guard<std::mutex> guard(m_async_lock);
+    //newest first:queue is newer than inflight,and back of each deque is the newest one
+    const std::deque<xwrite_request_t>* groups[2] = {&m_async_queue, &m_async_inflight};
+    for (auto group : groups)
+    {
+        for (auto it = group->rbegin(); it != group->rend(); ++it)
+        {
+            //batch applies puts first then deletes,so delete wins inside one request
+            for (auto const & delete_key : it->delete_keys)
+            {
+                if (delete_key == key)
+                    return -1;
+            }
+            auto found = it->objs.find(key);
+            if (found != it->objs.end())
+            {
+                value = found->second;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+void xdb::xdb_impl::async_write_loop()
+{
+    auto last_wal_sync = std::chrono::steady_clock::now();
+    const auto wait_interval = std::chrono::milliseconds((m_wal_sync_interval_ms > 0) ? m_wal_sync_interval_ms : 1000);
+    for (;;)
+    {
+        uint64_t group_seq = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_async_lock);
+            m_async_queue_cond.wait_for(lock, wait_interval, [this] { return !m_async_queue.empty() || !m_async_running; });
+            if (m_async_queue.empty() && !m_async_running)
+                break;
+            m_async_inflight.swap(m_async_queue);
+            group_seq = m_async_queued_seq;
+        }
+        
+        rocksdb::Status s;
+        if (!m_async_inflight.empty())
+        {
+            //group commit:merge every queued request into one WriteBatch
+            auto migrate_guard = lock_for_cf_migration();
+            rocksdb::WriteBatch batch;
+            for (auto const & request : m_async_inflight)
+            {
+                for (auto const & entry : request.objs)
+                {
+                    XMETRICS_GAUGE(metrics::db_write_size, entry.second.size());
+                    batch.Put(get_cf_handle(entry.first), entry.first, entry.second);
+                }
+                for (auto const & key : request.delete_keys)
+                {
+                    delete_key(batch, key);
+                }
+            }
+            XMETRICS_GAUGE(metrics::db_write_async_group_size, m_async_inflight.size());
+            
+            rocksdb::WriteOptions write_options;
+            write_options.sync = m_async_write_sync;
+            s = m_db->Write(write_options, &batch);
+            handle_error(s);
+        }
+        
+        if (!m_async_write_sync && (m_wal_sync_interval_ms > 0))
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - last_wal_sync >= std::chrono::milliseconds(m_wal_sync_interval_ms))
+            {
+                handle_error(m_db->SyncWAL());
+                last_wal_sync = now;
+            }
+        }
+        
+        std::deque<xwrite_request_t> finished;
+        {
+            std::lock_guard<std::mutex> guard(m_async_lock);
+            finished.swap(m_async_inflight);
+            m_async_written_seq = group_seq;
+            m_async_pending_count.fetch_sub(finished.size());
+            for (auto const & request : finished)
+            {
+                //keep keys queued again by a later request
+                for (auto const & entry : request.objs)
+                {
+                    auto it = m_async_pending_keys.find(entry.first);
+                    if ((it != m_async_pending_keys.end()) && (it->second <= group_seq))
+                        m_async_pending_keys.erase(it);
+                }
+                for (auto const & key : request.delete_keys)
+                {
+                    auto it = m_async_pending_keys.find(key);
+                    if ((it != m_async_pending_keys.end()) && (it->second <= group_seq))
+                        m_async_pending_keys.erase(it);
+                }
+            }
+        }
+        m_async_written_cond.notify_all();
+        
+        for (auto & request : finished)
+        {
+            if (request.callback)
+                request.callback(s.ok());
+        }
+    }
+}
+
+void xdb::xdb_impl::stop_async_writer()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_async_lock);
+        if (false == m_async_running)
+            return;
+        m_async_running = false;
+    }
+    m_async_queue_cond.notify_one();
+    if (m_async_thread.joinable())
+        m_async_thread.join();
+}
+
+void xdb::xdb_impl::start_stats_exporter()
+{
+    if (m_options.statistics == nullptr || 0 == m_statistics_interval_sec)
+        return;
+    std::lock_guard<std::mutex> guard(m_stats_lock);
+    if (m_stats_running)
+        return;
+    m_stats_running = true;
+    m_stats_thread = std::thread(&xdb::xdb_impl::stats_export_loop, this);
+}
+
+//memtables shrink by a flush in background, the block cache by lowering its capacity
+void xdb::xdb_impl::add_memory_reporters()
+{
+    auto & accounting = basic::xmemory_accounting_t::instance();
+    basic::xmemory_accounting_t::xshrink_callback_t flush_memtables;
+    if ((m_db_kinds & xdb_kind_readonly) == 0)
+    {
+        flush_memtables = [this](const uint64_t) {
+            std::vector<rocksdb::ColumnFamilyHandle*> cf_handles;
+            for (auto & cf : m_cf_configs)
+            {
+                if (cf.cf_handle != nullptr)
+                    cf_handles.push_back(cf.cf_handle);
+            }
+            rocksdb::FlushOptions flush_options;
+            flush_options.wait = false;
+            flush_options.allow_write_stall = true;
+            handle_error(m_db->Flush(flush_options, cf_handles));
+        };
+    }
+    m_memtables_reporter = accounting.add_reporter("rocksdb_memtables",
+        [this]() {
+            basic::xmemory_usage_t usage;
+            uint64_t active_entries = 0;
+            uint64_t immutable_entries = 0;
+            m_db->GetAggregatedIntProperty("rocksdb.cur-size-all-mem-tables", &usage.bytes);
+            m_db->GetAggregatedIntProperty("rocksdb.num-entries-active-mem-table", &active_entries);
+            m_db->GetAggregatedIntProperty("rocksdb.num-entries-imm-mem-tables", &immutable_entries);
+            usage.objects = active_entries + immutable_entries;
+            return usage;
+        },
+        flush_memtables);
+
+    if (m_block_cache == nullptr)
+        return;
+    m_block_cache_reporter = accounting.add_reporter("rocksdb_block_cache",
+        [this]() { return basic::xmemory_usage_t{m_block_cache->GetUsage(), 0}; },
+        [this](const uint64_t target_bytes) {
+            const size_t min_capacity = 8 * 1024 * 1024;
+            const size_t capacity = std::max<size_t>(target_bytes, min_capacity);
+            if (capacity < m_block_cache->GetCapacity())
+            {
+                xkinfo("xdb_impl::block cache capacity %zu -> %zu by memory soft limit", m_block_cache->GetCapacity(), capacity);
+                m_block_cache->SetCapacity(capacity);
+            }
+        });
+}
+
+void xdb::xdb_impl::remove_memory_reporters()
+{
+    auto & accounting = basic::xmemory_accounting_t::instance();
+    if (m_memtables_reporter != 0)
+        accounting.remove_reporter(m_memtables_reporter);
+    if (m_block_cache_reporter != 0)
+        accounting.remove_reporter(m_block_cache_reporter);
+    m_memtables_reporter = 0;
+    m_block_cache_reporter = 0;
+}
+
+void xdb::xdb_impl::stats_export_loop()
+{
+    const auto interval = std::chrono::seconds(m_statistics_interval_sec);
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_stats_lock);
+            if (m_stats_cond.wait_for(lock, interval, [this] { return !m_stats_running; }))
+                return;
+        }
+        export_statistics();
+    }
+}
+
+void xdb::xdb_impl::stop_stats_exporter()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_stats_lock);
+        if (false == m_stats_running)
+            return;
+        m_stats_running = false;
+    }
+    m_stats_cond.notify_one();
+    if (m_stats_thread.joinable())
+        m_stats_thread.join();
+}
+
+void xdb::xdb_impl::export_statistics() const
+{
+    const std::shared_ptr<rocksdb::Statistics> & stats = m_options.statistics;
+    if (m_db == nullptr || stats == nullptr)
+        return;
+
+    rocksdb::HistogramData get_hist;
+    rocksdb::HistogramData write_hist;
+    rocksdb::HistogramData seek_hist;
+    stats->histogramData(rocksdb::DB_GET, &get_hist);
+    stats->histogramData(rocksdb::DB_WRITE, &write_hist);
+    stats->histogramData(rocksdb::DB_SEEK, &seek_hist);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_get_p50, (int64_t)get_hist.median);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_get_p99, (int64_t)get_hist.percentile99);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_write_p50, (int64_t)write_hist.median);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_write_p99, (int64_t)write_hist.percentile99);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_seek_p50, (int64_t)seek_hist.median);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_seek_p99, (int64_t)seek_hist.percentile99);
+
+    const uint64_t stall_micros = stats->getTickerCount(rocksdb::STALL_MICROS);
+    const uint64_t compact_read_bytes = stats->getTickerCount(rocksdb::COMPACT_READ_BYTES);
+    const uint64_t compact_write_bytes = stats->getTickerCount(rocksdb::COMPACT_WRITE_BYTES);
+    const uint64_t block_cache_hit = stats->getTickerCount(rocksdb::BLOCK_CACHE_HIT);
+    const uint64_t block_cache_miss = stats->getTickerCount(rocksdb::BLOCK_CACHE_MISS);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_stall_micros, (int64_t)stall_micros);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_compact_read_bytes, (int64_t)compact_read_bytes);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_compact_write_bytes, (int64_t)compact_write_bytes);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_block_cache_hit, (int64_t)block_cache_hit);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_block_cache_miss, (int64_t)block_cache_miss);
+
+    //hit rate(in 1/10000) of lookups since last export,lifetime rate hardly moves at long running node
+    uint64_t hit_rate = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_stats_lock);
+        const uint64_t hit_delta = block_cache_hit - m_last_block_cache_hit;
+        const uint64_t miss_delta = block_cache_miss - m_last_block_cache_miss;
+        if (hit_delta + miss_delta > 0)
+            hit_rate = hit_delta * 10000 / (hit_delta + miss_delta);
+        m_last_block_cache_hit = block_cache_hit;
+        m_last_block_cache_miss = block_cache_miss;
+    }
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_block_cache_hit_rate, (int64_t)hit_rate);
+
+    uint64_t pending_compaction_bytes = 0;
+    uint64_t write_stopped = 0;
+    uint64_t delayed_write_rate = 0;
+    m_db->GetAggregatedIntProperty("rocksdb.estimate-pending-compaction-bytes", &pending_compaction_bytes);
+    m_db->GetIntProperty("rocksdb.is-write-stopped", &write_stopped);
+    m_db->GetIntProperty("rocksdb.actual-delayed-write-rate", &delayed_write_rate);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_pending_compaction_bytes, (int64_t)pending_compaction_bytes);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_write_stopped, (int64_t)write_stopped);
+    XMETRICS_GAUGE_SET_VALUE(metrics::db_rocksdb_delayed_write_rate, (int64_t)delayed_write_rate);
+
+    xinfo("xdb_impl::export_statistics,db=%s,get(p50=%.0f,p99=%.0f)us,write(p50=%.0f,p99=%.0f)us,seek(p50=%.0f,p99=%.0f)us,stall=%llu us,compact(read=%llu,write=%llu),block_cache(hit=%llu,miss=%llu,rate=%llu),pending_compaction=%llu,write_stopped=%llu,delayed_write_rate=%llu",
+          m_db_name.c_str(), get_hist.median, get_hist.percentile99, write_hist.median, write_hist.percentile99, seek_hist.median, seek_hist.percentile99,
+          stall_micros, compact_read_bytes, compact_write_bytes, block_cache_hit, block_cache_miss, hit_rate,
+          pending_compaction_bytes, write_stopped, delayed_write_rate);
+}
+
+void xdb::xdb_impl::on_slow_op(const char* op_name, const std::string & key, const uint64_t elapsed_us) const
+{
+    XMETRICS_GAUGE(metrics::db_slow_op, 1);
+    uint64_t write_stopped = 0;
+    uint64_t delayed_write_rate = 0;
+    uint64_t pending_compaction_bytes = 0;
+    if (m_db != nullptr)
+    {
+        m_db->GetIntProperty("rocksdb.is-write-stopped", &write_stopped);
+        m_db->GetIntProperty("rocksdb.actual-delayed-write-rate", &delayed_write_rate);
+        m_db->GetAggregatedIntProperty("rocksdb.estimate-pending-compaction-bytes", &pending_compaction_bytes);
+    }
+    xwarn("xdb_impl::on_slow_op,op=%s,key=%s(size=%zu),cost=%llu us,write_stopped=%llu,delayed_write_rate=%llu,pending_compaction=%llu,async_pending=%llu",
+          op_name, key.c_str(), key.size(), elapsed_us, write_stopped, delayed_write_rate, pending_compaction_bytes, m_async_pending_count.load());
+}
+
+bool xdb::xdb_impl::single_delete(const std::string& key)
+{
+    if (is_cf_migrating()) //key may be at two CFs
+        return erase(key);
+    
+    wait_async_writes_before_sync_write(key);
+    auto migrate_guard = lock_for_cf_migration();
+    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(key);
  
-    rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(prefix);
+    rocksdb::Status res = m_db->SingleDelete(rocksdb::WriteOptions(), target_cf, rocksdb::Slice(key));
+    if (!res.ok())
+    {
+        if (res.IsNotFound()) //possible case
+            return true;
+        
+        handle_error(res);
+        return false;
+    }
+    return true;
+}
+
+bool xdb::xdb_impl::add_delete_range(rocksdb::WriteBatch& batch, const std::string& begin_key,const std::string& end_key)
+{
+    rocksdb::ColumnFamilyHandle* begin_cf = get_shard_cf_handle(begin_key);
+    rocksdb::ColumnFamilyHandle* end_cf   = get_shard_cf_handle(end_key);
+    if(end_cf != begin_cf)
+    {
+        xerror("xdb_impl::delete_range,keys are at different CFs,beginCF(%s) != endCF(%s)",begin_cf->GetName().c_str(),end_cf->GetName().c_str());
+        return false;
+    }
     
+    //range may cover keys at CF of key type as well
+    std::vector<rocksdb::ColumnFamilyHandle*> target_cfs;
+    get_range_cf_handles(begin_key, target_cfs);
+    for(auto target_cf : target_cfs)
+    {
+        batch.DeleteRange(target_cf, rocksdb::Slice(begin_key), rocksdb::Slice(end_key));
+    }
+    return true;
+}
+
+bool xdb::xdb_impl::delete_range(const std::string& begin_key,const std::string& end_key)
+{
+    std::vector<std::pair<std::string, std::string>> ranges;
+    ranges.emplace_back(begin_key, end_key);
+    return delete_ranges(ranges);
+}
+
+bool xdb::xdb_impl::delete_ranges(const std::vector<std::pair<std::string, std::string>>& ranges)
+{
+    if (m_async_pending_count.load() > 0) //range may cover any queued key
+        flush_async_writes();
+    auto migrate_guard = lock_for_cf_migration();
+    rocksdb::WriteBatch batch;
+    for(auto const & range : ranges)
+    {
+        if(!add_delete_range(batch, range.first, range.second))
+            return false;
+    }
+    rocksdb::Status res = m_db->Write(rocksdb::WriteOptions(), &batch);
+    if (!res.ok())
+    {
+        if (res.IsNotFound()) //possible case
+            return true;
+        
+        handle_error(res);
+        return false;
+    }
+    return true;
+}
+
+void xdb::xdb_impl::destroy(const std::string& m_db_name) {
+    rocksdb::DestroyDB(m_db_name, rocksdb::Options());
+}
+
+rocksdb::ReadOptions xdb::xdb_impl::get_range_read_options(const std::string& prefix) const
+{
     rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
     target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
     target_opt.verify_checksums = false; //application has own checksum
+    if(m_prefix_bloom_filter && xdb_account_prefix_transform_t::instance()->InDomain(rocksdb::Slice(prefix)))
+    {
+        //every key start with prefix has same account prefix,so SST and memtable of other accounts can be skipped
+        target_opt.prefix_same_as_start = true;
+    }
+    else
+    {
+        //prefix is shorter than account prefix(or empty),must go through all keys by order
+        target_opt.total_order_seek = true;
+    }
+    return target_opt;
+}
+
+void xdb::xdb_impl::collect_range_cf(rocksdb::ColumnFamilyHandle* target_cf, const std::string& prefix, std::map<std::string, std::string>& values) const
+{
+    rocksdb::ReadOptions target_opt = get_range_read_options(prefix);
+    auto iter = m_db->NewIterator(target_opt, target_cf);
+    for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix); iter->Next()) {
+        values[iter->key().ToString()] = iter->value().ToString(); //later CF(of key type) has newer value
+    }
+    delete iter;
+}
+
+bool xdb::xdb_impl::read_range(const std::string& prefix, std::vector<std::string>& values) {
+ 
+    std::vector<rocksdb::ColumnFamilyHandle*> target_cfs;
+    get_range_cf_handles(prefix, target_cfs);
+    if (target_cfs.size() > 1) { //merge by key order
+        std::map<std::string, std::string> merged_values;
+        for (auto cf : target_cfs)
+            collect_range_cf(cf, prefix, merged_values);
+        for (auto & entry : merged_values)
+            values.push_back(entry.second);
+        return (merged_values.empty() == false);
+    }
+    rocksdb::ColumnFamilyHandle* target_cf = target_cfs[0];
+    
+    rocksdb::ReadOptions target_opt = get_range_read_options(prefix);
     
     bool ret = false;
     auto iter = m_db->NewIterator(target_opt, target_cf);
@@ -843,9 +2054,7 @@ bool xdb::xdb_impl::read_range_cf( rocksdb::ColumnFamilyHandle* target_cf, const
     bool ret = false;
     if(target_cf != nullptr)//try every CF
     {
-        rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
-        target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
-        target_opt.verify_checksums = false; //application has own checksum
+        rocksdb::ReadOptions target_opt = get_range_read_options(prefix);
 
         auto iter = m_db->NewIterator(target_opt, target_cf);
         for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix); iter->Next())
@@ -864,16 +2073,70 @@ bool xdb::xdb_impl::read_range_cf( rocksdb::ColumnFamilyHandle* target_cf, const
     return ret;
 }
 
+class xdb_rocksdb_range_iterator_t : public xdb_range_iterator_t {
+ public:
+    xdb_rocksdb_range_iterator_t(rocksdb::Iterator* iter, const std::string& prefix)
+      : m_iter(iter), m_prefix(prefix)
+    {
+        m_iter->Seek(m_prefix);
+        load();
+    }
+    bool               valid() const override { return m_valid; }
+    void               next() override { m_iter->Next(); load(); }
+    const std::string& key() const override { return m_key; }
+    const std::string& value() const override { return m_value; }
+ private:
+    void load()
+    {
+        m_valid = m_iter->Valid() && m_iter->key().starts_with(m_prefix);
+        if(m_valid)
+        {
+            m_key.assign(m_iter->key().data(), m_iter->key().size());
+            m_value.assign(m_iter->value().data(), m_iter->value().size());
+        }
+    }
+ private:
+    std::unique_ptr<rocksdb::Iterator> m_iter;
+    const std::string                  m_prefix;
+    std::string                        m_key;
+    std::string                        m_value;
+    bool                               m_valid{false};
+};
+
+xdb_range_iterator_ptr xdb::xdb_impl::new_range_iterator(const std::string& prefix)
+{
+    if (prefix.size() <= 2)
+        return nullptr;
+    std::vector<rocksdb::ColumnFamilyHandle*> target_cfs;
+    get_range_cf_handles(prefix, target_cfs);
+    if (target_cfs.size() != 1)
+        return nullptr;
+    return xdb_range_iterator_ptr(new xdb_rocksdb_range_iterator_t(m_db->NewIterator(get_range_read_options(prefix), target_cfs[0]), prefix));
+}
+
 //iterator each key of prefix.note: go throuh whole db if prefix is empty
 bool xdb::xdb_impl::read_range(const std::string& prefix,xdb_iterator_callback callback_fuc,void * cookie)
 {
     bool ret = false;
 
-    if (prefix.size() > 2) {
-        rocksdb::ColumnFamilyHandle* target_cf = get_cf_handle(prefix);
-        rocksdb::ReadOptions target_opt = rocksdb::ReadOptions();
-        target_opt.ignore_range_deletions = true; //ignored deleted_ranges to improve read performance
-        target_opt.verify_checksums = false; //application has own checksum
+    std::vector<rocksdb::ColumnFamilyHandle*> target_cfs;
+    if (prefix.size() > 2)
+        get_range_cf_handles(prefix, target_cfs);
+    
+    if (target_cfs.size() > 1) { //merge by key order
+        std::map<std::string, std::string> merged_values;
+        for (auto cf : target_cfs)
+            collect_range_cf(cf, prefix, merged_values);
+        for (auto & entry : merged_values) {
+            if ((*callback_fuc)(entry.first, entry.second, cookie) == false) {
+                ret = false;
+                break;
+            }
+            ret = true;
+        }
+    } else if (prefix.size() > 2) {
+        rocksdb::ColumnFamilyHandle* target_cf = target_cfs[0];
+        rocksdb::ReadOptions target_opt = get_range_read_options(prefix);
         
         auto iter = m_db->NewIterator(target_opt, target_cf);
         for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix); iter->Next())
@@ -899,6 +2162,16 @@ bool xdb::xdb_impl::read_range(const std::string& prefix,xdb_iterator_callback c
                 }
             }
         }
+        if (ret && (m_cf_layout.load() != enum_xdb_cf_layout_shard)) {
+            rocksdb::ColumnFamilyHandle* key_type_cfs[] = {m_meta_cf, m_txindex_cf};
+            for (auto cf : key_type_cfs) {
+                if ((cf != nullptr) && (false == read_range_cf(cf, prefix, callback_fuc, cookie))) {
+                    xwarn("read_range_cf %s is error.", cf->GetName().c_str());
+                    ret = false;
+                    break;
+                }
+            }
+        }
     }
     return ret;
 }
@@ -922,15 +2195,18 @@ bool xdb::xdb_impl::compact_range(const std::string & begin_key,const std::strin
     cro.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
     if( (begin_key.empty() == false) && (end_key.empty() == false) ) //specified range of begin and end
     {
-        rocksdb::ColumnFamilyHandle* begin_cf = get_cf_handle(begin_key);
-        rocksdb::ColumnFamilyHandle* end_cf   = get_cf_handle(end_key);
+        rocksdb::ColumnFamilyHandle* begin_cf = get_shard_cf_handle(begin_key);
+        rocksdb::ColumnFamilyHandle* end_cf   = get_shard_cf_handle(end_key);
         if (end_cf == begin_cf) {
             xinfo("xdb_impl::compact_range,one cf \n");
-            rocksdb::Status res = m_db->CompactRange(cro, begin_cf, begin_slice, end_slice);
-            if (!res.ok()) {
-                if (res.IsNotFound()) { //possible case
-                    ret = true;
-                } else {
+            std::vector<rocksdb::ColumnFamilyHandle*> target_cfs;
+            get_range_cf_handles(begin_key, target_cfs);
+            for (auto target_cf : target_cfs) {
+                rocksdb::Status res = m_db->CompactRange(cro, target_cf, begin_slice, end_slice);
+                if (!res.ok()) {
+                    if (res.IsNotFound()) { //possible case
+                        continue;
+                    }
                     handle_error(res);
                     ret = false;
                 }
@@ -944,6 +2220,12 @@ bool xdb::xdb_impl::compact_range(const std::string & begin_key,const std::strin
                 m_db->CompactRange(cro,cf_handle, begin_slice, end_slice);
             }
         }
+        rocksdb::ColumnFamilyHandle* key_type_cfs[] = {m_meta_cf, m_txindex_cf};
+        for (auto cf_handle : key_type_cfs) {
+            if(cf_handle != nullptr) {
+                m_db->CompactRange(cro,cf_handle, begin_slice, end_slice);
+            }
+        }
     }
 
     delete begin_slice;
@@ -951,6 +2233,154 @@ bool xdb::xdb_impl::compact_range(const std::string & begin_key,const std::strin
     return ret;
 }
 
+void xdb::xdb_impl::load_cf_layout()
+{
+    int layout = enum_xdb_cf_layout_shard;
+    const bool has_key_type_cfs = (m_meta_cf != nullptr) && (m_txindex_cf != nullptr);
+    std::string value;
+    rocksdb::Status s = m_db->Get(rocksdb::ReadOptions(), m_cf_handles[0], rocksdb::Slice(s_cf_layout_key), &value);
+    if (s.ok()) {
+        layout = std::atoi(value.c_str());
+    } else if (m_fresh_db && m_cf_routing_by_key_type && has_key_type_cfs && ((m_db_kinds & xdb_kind_readonly) == 0)) {
+        //nothing to migrate for new DB
+        layout = enum_xdb_cf_layout_key_type;
+        save_cf_layout(layout);
+    }
+    
+    if ((layout != enum_xdb_cf_layout_shard) && (false == has_key_type_cfs)) {
+        xerror("xdb_impl::load_cf_layout,CFs of key type not found for layout(%d),db name %s", layout, m_db_name.c_str());
+        layout = enum_xdb_cf_layout_shard;
+    }
+    if ((layout == enum_xdb_cf_layout_shard) && m_cf_routing_by_key_type) {
+        xwarn("xdb_impl::load_cf_layout,db %s is at shard layout,need migrate CFs for routing by key type", m_db_name.c_str());
+    }
+    m_cf_layout.store(layout);
+    xkinfo("xdb_impl::load_cf_layout,db %s at cf_layout(%d)", m_db_name.c_str(), layout);
+}
+
+bool xdb::xdb_impl::save_cf_layout(const int layout)
+{
+    rocksdb::WriteOptions write_options;
+    write_options.sync = true; //layout must survive any crash after keys moved
+    rocksdb::Status s = m_db->Put(write_options, m_cf_handles[0], rocksdb::Slice(s_cf_layout_key), rocksdb::Slice(std::to_string(layout)));
+    handle_error(s);
+    return s.ok();
+}
+
+//move keys of meta and tx index into CFs of key type while DB keep serving,and resume from where it stop if interrupted
+bool xdb::xdb_impl::migrate_cf_layout()
+{
+    if ((m_db == nullptr) || ((m_db_kinds & xdb_kind_readonly) != 0)) {
+        xerror("xdb_impl::migrate_cf_layout,db is closed or readonly,db name %s", m_db_name.c_str());
+        return false;
+    }
+    if ((m_meta_cf == nullptr) || (m_txindex_cf == nullptr)) {
+        xerror("xdb_impl::migrate_cf_layout,CFs of key type not found,db name %s", m_db_name.c_str());
+        return false;
+    }
+    if (m_cf_layout.load() == enum_xdb_cf_layout_key_type)
+        return true;
+    
+    flush_async_writes();
+    {
+        std::lock_guard<std::mutex> guard(m_cf_migrate_lock);
+        if (false == save_cf_layout(enum_xdb_cf_layout_migrating))
+            return false;
+        m_cf_layout.store(enum_xdb_cf_layout_migrating);
+    }
+    //writers started before layout changed may still write by shard layout,let them finish before keys are scanned
+    while (m_cf_unlocked_writers.load() != 0)
+        std::this_thread::yield();
+    
+    uint64_t moved_count = 0;
+    std::vector<rocksdb::ColumnFamilyHandle*> source_cfs;
+    for (auto cf : m_cf_handles) {
+        if ((cf != nullptr) && (std::find(source_cfs.begin(), source_cfs.end(), cf) == source_cfs.end()))
+            source_cfs.push_back(cf);
+    }
+    for (auto cf : source_cfs) {
+        if (false == migrate_cf_keys(cf, moved_count)) {
+            xerror("xdb_impl::migrate_cf_layout,fail at cf(%s),moved %llu keys,db name %s", cf->GetName().c_str(), (unsigned long long)moved_count, m_db_name.c_str());
+            return false; //keep migrating layout,so reads still fallback and it can be resumed
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> guard(m_cf_migrate_lock);
+        if (false == save_cf_layout(enum_xdb_cf_layout_key_type))
+            return false;
+        m_cf_layout.store(enum_xdb_cf_layout_key_type);
+    }
+    xkinfo("xdb_impl::migrate_cf_layout,finish with %llu keys moved,db name %s", (unsigned long long)moved_count, m_db_name.c_str());
+    return true;
+}
+
+bool xdb::xdb_impl::migrate_cf_keys(rocksdb::ColumnFamilyHandle* source_cf, uint64_t & moved_count)
+{
+    enum { enum_max_keys_per_move = 1024 };
+    
+    rocksdb::ReadOptions iter_options;
+    iter_options.total_order_seek = true;
+    iter_options.fill_cache = false; //one pass scan,dont pollute block cache
+    std::unique_ptr<rocksdb::Iterator> iter(m_db->NewIterator(iter_options, source_cf));
+    
+    std::vector<std::string> keys;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        const std::string key = iter->key().ToString();
+        rocksdb::ColumnFamilyHandle* target_cf = get_key_type_cf_handle(key);
+        if ((target_cf == nullptr) || (target_cf == source_cf) || (get_shard_cf_handle(key) != source_cf))
+            continue;
+        
+        keys.push_back(key);
+        if (keys.size() >= enum_max_keys_per_move) {
+            if (false == move_cf_keys(source_cf, keys, moved_count))
+                return false;
+            keys.clear();
+        }
+    }
+    if (false == iter->status().ok()) {
+        handle_error(iter->status());
+        return false;
+    }
+    return move_cf_keys(source_cf, keys, moved_count);
+}
+
+bool xdb::xdb_impl::move_cf_keys(rocksdb::ColumnFamilyHandle* source_cf, const std::vector<std::string>& keys, uint64_t & moved_count)
+{
+    if (keys.empty())
+        return true;
+    
+    //hold writers,and re-read under lock since key may be updated or deleted after iterated
+    //note:use default ReadOptions to respect range deletions,otherwise pruned keys come back
+    std::lock_guard<std::mutex> guard(m_cf_migrate_lock);
+    rocksdb::WriteBatch batch;
+    for (auto & key : keys) {
+        std::string value;
+        rocksdb::Status s = m_db->Get(rocksdb::ReadOptions(), source_cf, rocksdb::Slice(key), &value);
+        if (s.IsNotFound())
+            continue;
+        if (!s.ok()) {
+            handle_error(s);
+            return false;
+        }
+        
+        rocksdb::ColumnFamilyHandle* target_cf = get_key_type_cf_handle(key);
+        std::string newer_value;
+        s = m_db->Get(rocksdb::ReadOptions(), target_cf, rocksdb::Slice(key), &newer_value);
+        if (s.IsNotFound()) {
+            batch.Put(target_cf, key, value);
+        } else if (!s.ok()) {
+            handle_error(s);
+            return false;
+        } //else newer value has been written to target CF already
+        batch.Delete(source_cf, key);
+        ++moved_count;
+    }
+    rocksdb::Status s = m_db->Write(rocksdb::WriteOptions(), &batch);
+    handle_error(s);
+    return s.ok();
+}
+
 bool xdb::xdb_impl::get_estimate_num_keys(uint64_t & num) const
 {
     return m_db->GetIntProperty("rocksdb.estimate-num-keys", &num);
@@ -962,7 +2392,11 @@ void xdb::xdb_impl::GetDBMemStatus() const
         uint64_t  mem_block_all  = 0;   
         uint64_t  mem_reader_memtable_all = 0; 
         uint64_t  mem_memory_all = 0; 
-        m_db->GetAggregatedIntProperty("rocksdb.block-cache-usage", &mem_block_all);
+        //block cache is shared by all CFs,so aggregate property over CFs would count it multiple times
+        if (m_block_cache != nullptr)
+            mem_block_all = m_block_cache->GetUsage();
+        else
+            m_db->GetAggregatedIntProperty("rocksdb.block-cache-usage", &mem_block_all);
         m_db->GetAggregatedIntProperty("rocksdb.estimate-table-readers-mem", &mem_reader_memtable_all);
         mem_memory_all = mem_block_all + mem_reader_memtable_all;
         xinfo("rocksdb mem_block_all: %lld, reader_memtable_all %lld mem_memory_all %lld", mem_block_all, 
@@ -970,11 +2404,18 @@ void xdb::xdb_impl::GetDBMemStatus() const
         XMETRICS_GAUGE_SET_VALUE(metrics::db_block_cache_size, mem_block_all);
         XMETRICS_GAUGE_SET_VALUE(metrics::db_memtable_cache_size, mem_reader_memtable_all);
         XMETRICS_GAUGE_SET_VALUE(metrics::db_memory_total_size, mem_memory_all);
+        if (m_block_cache != nullptr) {
+            XMETRICS_GAUGE_SET_VALUE(metrics::db_block_cache_capacity, m_block_cache->GetCapacity());
+            XMETRICS_GAUGE_SET_VALUE(metrics::db_block_cache_pinned_size, m_block_cache->GetPinnedUsage());
+        }
+        export_statistics();
   }
 }
 
-xdb::xdb(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths)
-: m_db_impl(new xdb_impl(db_kinds,db_root_dir,db_paths)) {
+static const std::string s_no_op_key; //for timing of multiple keys op
+
+xdb::xdb(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths,const xdb_options_t & db_options)
+: m_db_impl(new xdb_impl(db_kinds,db_root_dir,db_paths,db_options)) {
 }
 
 xdb::~xdb() noexcept = default;
@@ -988,18 +2429,65 @@ bool xdb::close() {
 
 bool xdb::read(const std::string& key, std::string& value) const {
     XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "read", key, metrics::db_read_latency);
     auto ret = m_db_impl->read(key, value);
     XMETRICS_GAUGE(metrics::db_read_size, value.size());
     XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
     return ret;
 }
 
+bool xdb::read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const {
+    XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "read_pinned", key, metrics::db_read_latency);
+    auto ret = m_db_impl->read_pinned(key, value);
+    XMETRICS_GAUGE(metrics::db_read_size, ret ? value->size() : 0);
+    XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
+    return ret;
+}
+
+bool xdb::multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const {
+    XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "multi_read", s_no_op_key, metrics::db_read_latency);
+    auto ret = m_db_impl->multi_read(keys, values);
+    XMETRICS_GAUGE(metrics::db_multi_read_keys, keys.size());
+    XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
+    return ret;
+}
+
+xdb_snapshot_ptr xdb::create_snapshot() const {
+    return m_db_impl->create_snapshot();
+}
+
+bool xdb::read(const xdb_snapshot_ptr& snapshot, const std::string& key, std::string& value) const {
+    XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "read_snapshot", key, metrics::db_read_latency);
+    auto ret = m_db_impl->read(key, value, m_db_impl->get_snapshot(snapshot));
+    XMETRICS_GAUGE(metrics::db_read_size, value.size());
+    XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
+    return ret;
+}
+
+bool xdb::multi_read(const xdb_snapshot_ptr& snapshot, const std::vector<std::string>& keys, std::vector<std::string>& values) const {
+    XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "multi_read_snapshot", s_no_op_key, metrics::db_read_latency);
+    auto ret = m_db_impl->multi_read(keys, values, m_db_impl->get_snapshot(snapshot));
+    XMETRICS_GAUGE(metrics::db_multi_read_keys, keys.size());
+    XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
+    return ret;
+}
+
+bool xdb::migrate_cf_layout() {
+    return m_db_impl->migrate_cf_layout();
+}
+
 bool xdb::exists(const std::string& key) const {
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "exists", key, metrics::db_read_latency);
     return m_db_impl->exists(key);
 }
 
 bool xdb::write(const std::string& key, const std::string& value) {
     XMETRICS_TIMER(metrics::db_write_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "write", key, metrics::db_write_latency);
     XMETRICS_GAUGE(metrics::db_write_size, value.size());
     auto ret = m_db_impl->write(key, value);
     XMETRICS_GAUGE(metrics::db_write, ret ? 1 : 0);
@@ -1008,6 +2496,7 @@ bool xdb::write(const std::string& key, const std::string& value) {
 
 bool xdb::write(const std::string& key, const char* data, size_t size) {
     XMETRICS_TIMER(metrics::db_write_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "write", key, metrics::db_write_latency);
     XMETRICS_GAUGE(metrics::db_write_size, size);
     auto ret = m_db_impl->write(key, data, size);
     XMETRICS_GAUGE(metrics::db_write, ret ? 1 : 0);
@@ -1016,6 +2505,7 @@ bool xdb::write(const std::string& key, const char* data, size_t size) {
 
 bool xdb::write(const std::map<std::string, std::string>& batches) {
     XMETRICS_TIMER(metrics::db_write_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "write_batch", s_no_op_key, metrics::db_write_latency);
     auto ret = m_db_impl->write(batches);
     XMETRICS_GAUGE(metrics::db_write, ret ? 1 : 0);
     return ret;
@@ -1023,6 +2513,7 @@ bool xdb::write(const std::map<std::string, std::string>& batches) {
 
 bool xdb::erase(const std::string& key) {
     XMETRICS_TIMER(metrics::db_delete_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "erase", key, metrics::db_delete_latency);
     auto ret = m_db_impl->erase(key);
     XMETRICS_GAUGE(metrics::db_delete, ret ? 1 : 0);
     return ret;
@@ -1030,15 +2521,36 @@ bool xdb::erase(const std::string& key) {
 
 bool xdb::erase(const std::vector<std::string>& keys) {
     XMETRICS_TIMER(metrics::db_delete_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "erase_batch", s_no_op_key, metrics::db_delete_latency);
     auto ret = m_db_impl->erase(keys);
     XMETRICS_GAUGE(metrics::db_delete, ret ? 1 : 0);
     return ret;
 }
 
 bool xdb::batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) {
+    XMETRICS_TIMER(metrics::db_write_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "batch_change", s_no_op_key, metrics::db_write_latency);
     return m_db_impl->batch_change(objs, delete_keys);
 }
 
+bool xdb::write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback) {
+    auto ret = m_db_impl->write_async(objs, delete_keys, std::move(callback));
+    XMETRICS_GAUGE(metrics::db_write_async, ret ? 1 : 0);
+    return ret;
+}
+
+bool xdb::flush_async_writes() {
+    return m_db_impl->flush_async_writes();
+}
+
+bool xdb::bulk_load(const std::map<std::string, std::string>& objs) {
+    XMETRICS_TIMER(metrics::db_write_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "bulk_load", s_no_op_key, metrics::db_write_latency);
+    auto ret = m_db_impl->bulk_load(objs);
+    XMETRICS_GAUGE(metrics::db_write, ret ? 1 : 0);
+    return ret;
+}
+
 void xdb::destroy(const std::string& m_db_name) {
     rocksdb::DestroyDB(m_db_name, rocksdb::Options());
 }
@@ -1046,6 +2558,7 @@ void xdb::destroy(const std::string& m_db_name) {
 bool xdb::read_range(const std::string& prefix, std::vector<std::string>& values)
 {
     XMETRICS_TIMER(metrics::db_read_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "read_range", prefix, metrics::db_read_latency);
     auto ret =  m_db_impl->read_range(prefix, values);
     XMETRICS_GAUGE(metrics::db_read, ret ? 1 : 0);
     return ret;
@@ -1054,14 +2567,27 @@ bool xdb::read_range(const std::string& prefix, std::vector<std::string>& values
 bool xdb::delete_range(const std::string& begin_key,const std::string& end_key)
 {
     XMETRICS_TIMER(metrics::db_delete_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "delete_range", begin_key, metrics::db_delete_latency);
     auto ret = m_db_impl->delete_range(begin_key, end_key);
     XMETRICS_GAUGE(metrics::db_delete_range, ret ? 1 : 0);
     return ret;
 }
 
+bool xdb::delete_ranges(const std::vector<std::pair<std::string, std::string>>& ranges)
+{
+    if (ranges.empty())
+        return true;
+    XMETRICS_TIMER(metrics::db_delete_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "delete_ranges", ranges.front().first, metrics::db_delete_latency);
+    auto ret = m_db_impl->delete_ranges(ranges);
+    XMETRICS_GAUGE(metrics::db_delete_range, ret ? 1 : 0);
+    return ret;
+}
+
 bool xdb::single_delete(const std::string& key)
 {
     XMETRICS_TIMER(metrics::db_delete_tick);
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "single_delete", key, metrics::db_delete_latency);
     auto ret =  m_db_impl->single_delete(key);
     XMETRICS_GAUGE(metrics::db_delete, ret ? 1 : 0);
     return ret;
@@ -1070,13 +2596,23 @@ bool xdb::single_delete(const std::string& key)
 //iterator each key of prefix.note: go throuh whole db if prefix is empty
 bool xdb::read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie)
 {
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "read_range", prefix, metrics::db_read_latency); //include time of callback
     return m_db_impl->read_range(prefix, callback,cookie);
 }
 
+xdb_range_iterator_ptr xdb::new_range_iterator(const std::string& prefix)
+{
+    xdb_range_iterator_ptr iter = m_db_impl->new_range_iterator(prefix);
+    if (iter == nullptr) //keys spread over several CFs,let read_range merge them
+        return xdb_face_t::new_range_iterator(prefix);
+    return iter;
+}
+
 //compact whole DB if both begin_key and end_key are empty
 //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
 bool xdb::compact_range(const std::string & begin_key,const std::string & end_key)
 {
+    xdb_impl::xop_timer_t op_timer(*m_db_impl, "compact_range", begin_key, metrics::db_compact_latency);
     return m_db_impl->compact_range(begin_key, end_key);
 }
 bool xdb::get_estimate_num_keys(uint64_t & num) const
@@ -0,0 +1,481 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <string>
+#include <algorithm>
+
+#include "xbase/xlog.h"
+#include "xdb/xdb_tiered.h"
+#include "xmetrics/xmetrics.h"
+
+namespace top { namespace db {
+
+struct xtiered_range_cookie_t
+{
+    const std::string *                  begin_key{nullptr}; //empty means no bound
+    const std::string *                  end_key{nullptr};
+    std::map<std::string, std::string> * values{nullptr};
+};
+
+static bool collect_range_callback(const std::string& key, const std::string& value,void * cookie)
+{
+    xtiered_range_cookie_t * range = (xtiered_range_cookie_t*)cookie;
+    if( (range->begin_key != nullptr) && (key < *range->begin_key) )
+        return true;
+    if( (range->end_key != nullptr) && (key >= *range->end_key) )
+        return false; //keys are sorted,stop here
+    (*range->values)[key] = value;
+    return true;
+}
+
+//merge cursors of both DB by key order,value at hot DB overrides the one at cold DB
+class xdb_tiered_range_iterator_t : public xdb_range_iterator_t
+{
+public:
+    xdb_tiered_range_iterator_t(xdb_range_iterator_ptr && hot, xdb_range_iterator_ptr && cold) : m_hot(std::move(hot)), m_cold(std::move(cold))
+    {
+        pick();
+    }
+    bool               valid() const override { return (m_current != nullptr); }
+    void               next() override
+    {
+        if ((m_current == m_hot.get()) && m_cold->valid() && (m_cold->key() == m_hot->key()))
+            m_cold->next(); //shadowed by hot one
+        m_current->next();
+        pick();
+    }
+    const std::string& key() const override { return m_current->key(); }
+    const std::string& value() const override { return m_current->value(); }
+private:
+    void pick()
+    {
+        if (!m_hot->valid())
+            m_current = m_cold->valid() ? m_cold.get() : nullptr;
+        else if (!m_cold->valid() || (m_hot->key() <= m_cold->key()))
+            m_current = m_hot.get();
+        else
+            m_current = m_cold.get();
+        if ((m_current != nullptr) && (m_current == m_cold.get()))
+            XMETRICS_GAUGE(metrics::db_tiered_cold_read, 1);
+    }
+private:
+    xdb_range_iterator_ptr m_hot;
+    xdb_range_iterator_ptr m_cold;
+    xdb_range_iterator_t * m_current{nullptr};
+};
+
+class xdb_tiered_snapshot_t : public xdb_snapshot_t
+{
+public:
+    xdb_tiered_snapshot_t(const xdb_snapshot_ptr & hot, const xdb_snapshot_ptr & cold) : m_hot(hot), m_cold(cold) {}
+    const xdb_snapshot_ptr & hot() const { return m_hot; }
+    const xdb_snapshot_ptr & cold() const { return m_cold; }
+private:
+    xdb_snapshot_ptr m_hot;
+    xdb_snapshot_ptr m_cold;
+};
+
+static const xdb_tiered_snapshot_t * to_tiered_snapshot(const xdb_snapshot_ptr & snapshot)
+{
+    if (snapshot == nullptr)
+        return nullptr;
+    const xdb_tiered_snapshot_t * tiered_snapshot = dynamic_cast<const xdb_tiered_snapshot_t*>(snapshot.get());
+    if (tiered_snapshot == nullptr)
+        xwarn("xdb_tiered_t,snapshot is not created by tiered DB,read live DB");
+    return tiered_snapshot;
+}
+
+xdb_tiered_t::xdb_tiered_t(const std::shared_ptr<xdb_face_t> & hot_db, const std::shared_ptr<xdb_face_t> & cold_db, const uint64_t cold_height_gap)
+  : m_hot_db(hot_db)
+  , m_cold_db(cold_db)
+  , m_cold_height_gap(cold_height_gap)
+{
+    xkinfo("xdb_tiered_t::xdb_tiered_t,cold_height_gap(%llu)", (unsigned long long)m_cold_height_gap);
+    m_move_thread.reset(new std::thread(&xdb_tiered_t::move_loop, this));
+}
+
+xdb_tiered_t::~xdb_tiered_t() noexcept
+{
+    stop_move_thread();
+}
+
+bool xdb_tiered_t::open()
+{
+    const bool hot_ret  = m_hot_db->open();
+    const bool cold_ret = m_cold_db->open();
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::close()
+{
+    stop_move_thread(); //finish queued moves first
+    const bool hot_ret  = m_hot_db->close();
+    const bool cold_ret = m_cold_db->close();
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::read(const std::string& key, std::string& value) const
+{
+    if (m_hot_db->read(key, value))
+        return true;
+    if (m_cold_db->read(key, value)) {
+        XMETRICS_GAUGE(metrics::db_tiered_cold_read, 1);
+        return true;
+    }
+    return false;
+}
+
+bool xdb_tiered_t::read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const
+{
+    if (m_hot_db->read_pinned(key, value))
+        return true;
+    if (m_cold_db->read_pinned(key, value)) {
+        XMETRICS_GAUGE(metrics::db_tiered_cold_read, 1);
+        return true;
+    }
+    return false;
+}
+
+bool xdb_tiered_t::multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const
+{
+    return multi_read(nullptr, keys, values);
+}
+
+xdb_snapshot_ptr xdb_tiered_t::create_snapshot() const
+{
+    xdb_snapshot_ptr hot_snapshot = m_hot_db->create_snapshot();
+    xdb_snapshot_ptr cold_snapshot = m_cold_db->create_snapshot();
+    return std::make_shared<xdb_tiered_snapshot_t>(hot_snapshot, cold_snapshot);
+}
+
+bool xdb_tiered_t::read(const xdb_snapshot_ptr& snapshot, const std::string& key, std::string& value) const
+{
+    const xdb_tiered_snapshot_t * tiered_snapshot = to_tiered_snapshot(snapshot);
+    if (tiered_snapshot == nullptr)
+        return read(key, value);
+    if (m_hot_db->read(tiered_snapshot->hot(), key, value))
+        return true;
+    if (m_cold_db->read(tiered_snapshot->cold(), key, value)) {
+        XMETRICS_GAUGE(metrics::db_tiered_cold_read, 1);
+        return true;
+    }
+    return false;
+}
+
+bool xdb_tiered_t::multi_read(const xdb_snapshot_ptr& snapshot, const std::vector<std::string>& keys, std::vector<std::string>& values) const
+{
+    const xdb_tiered_snapshot_t * tiered_snapshot = to_tiered_snapshot(snapshot);
+    const xdb_snapshot_ptr hot_snapshot  = (tiered_snapshot != nullptr) ? tiered_snapshot->hot() : nullptr;
+    const xdb_snapshot_ptr cold_snapshot = (tiered_snapshot != nullptr) ? tiered_snapshot->cold() : nullptr;
+    if (!m_hot_db->multi_read(hot_snapshot, keys, values))
+        return false;
+
+    //only read-through the missed ones
+    std::vector<size_t>      missed_pos;
+    std::vector<std::string> missed_keys;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i].empty()) {
+            missed_pos.push_back(i);
+            missed_keys.push_back(keys[i]);
+        }
+    }
+    if (missed_keys.empty())
+        return true;
+
+    std::vector<std::string> cold_values;
+    if (!m_cold_db->multi_read(cold_snapshot, missed_keys, cold_values))
+        return false;
+    for (size_t i = 0; i < missed_pos.size(); ++i) {
+        if (!cold_values[i].empty()) {
+            values[missed_pos[i]].swap(cold_values[i]);
+            XMETRICS_GAUGE(metrics::db_tiered_cold_read, 1);
+        }
+    }
+    return true;
+}
+
+bool xdb_tiered_t::exists(const std::string& key) const
+{
+    return (m_hot_db->exists(key) || m_cold_db->exists(key));
+}
+
+bool xdb_tiered_t::write(const std::string& key, const std::string& value)
+{
+    xwrite_guard_t guard = lock_for_move();
+    return m_hot_db->write(key, value);
+}
+
+bool xdb_tiered_t::write(const std::string& key, const char* data, size_t size)
+{
+    xwrite_guard_t guard = lock_for_move();
+    return m_hot_db->write(key, data, size);
+}
+
+bool xdb_tiered_t::write(const std::map<std::string, std::string>& batches)
+{
+    xwrite_guard_t guard = lock_for_move();
+    return m_hot_db->write(batches);
+}
+
+bool xdb_tiered_t::erase(const std::string& key)
+{
+    xwrite_guard_t guard = lock_for_move();
+    const bool hot_ret  = m_hot_db->erase(key);
+    const bool cold_ret = m_cold_db->erase(key);
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::erase(const std::vector<std::string>& keys)
+{
+    xwrite_guard_t guard = lock_for_move();
+    const bool hot_ret  = m_hot_db->erase(keys);
+    const bool cold_ret = m_cold_db->erase(keys);
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys)
+{
+    xwrite_guard_t guard = lock_for_move();
+    bool ret = m_hot_db->batch_change(objs, delete_keys);
+    if (!delete_keys.empty())
+        ret = m_cold_db->erase(delete_keys) && ret;
+    return ret;
+}
+
+//note:callback must not write back to this DB,since mover may wait for async writes while holding m_write_lock
+bool xdb_tiered_t::write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback)
+{
+    xwrite_guard_t guard = lock_for_move();
+    if (!delete_keys.empty())
+        m_cold_db->erase(delete_keys);
+    return m_hot_db->write_async(objs, delete_keys, callback);
+}
+
+bool xdb_tiered_t::flush_async_writes()
+{
+    const bool ret = m_hot_db->flush_async_writes();
+
+    std::unique_lock<std::mutex> lock(m_move_lock);
+    m_move_done_cond.wait(lock, [this] { return (m_move_queue.empty() && !m_move_running) || (m_move_thread == nullptr); });
+    return ret;
+}
+
+bool xdb_tiered_t::bulk_load(const std::map<std::string, std::string>& objs)
+{
+    xwrite_guard_t guard = lock_for_move();
+    return m_hot_db->bulk_load(objs);
+}
+
+xdb_tiered_t::xwrite_guard_t xdb_tiered_t::lock_for_move()
+{
+    xwrite_guard_t guard;
+    if (!m_move_finishing.load()) {
+        //count first then check again,mover raises the flag first then waits for counted writers,so one of both sees the other
+        m_unlocked_writers.fetch_add(1);
+        if (!m_move_finishing.load()) {
+            guard.unlocked_writers = &m_unlocked_writers;
+            return guard;
+        }
+        m_unlocked_writers.fetch_sub(1);
+    }
+    guard.lock = std::unique_lock<std::mutex>(m_write_lock);
+    return guard;
+}
+
+xdb_range_iterator_ptr xdb_tiered_t::new_range_iterator(const std::string& prefix)
+{
+    xdb_range_iterator_ptr hot_iter  = m_hot_db->new_range_iterator(prefix);
+    xdb_range_iterator_ptr cold_iter = m_cold_db->new_range_iterator(prefix);
+    return xdb_range_iterator_ptr(new xdb_tiered_range_iterator_t(std::move(hot_iter), std::move(cold_iter)));
+}
+
+bool xdb_tiered_t::read_range(const std::string& prefix, std::vector<std::string>& values)
+{
+    bool ret = false;
+    for (xdb_range_iterator_ptr iter = new_range_iterator(prefix); iter->valid(); iter->next()) {
+        values.push_back(iter->value());
+        ret = true;
+    }
+    return ret;
+}
+
+bool xdb_tiered_t::read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie)
+{
+    if (prefix.empty()) { //go through whole db of both,too many keys to merge at memory
+        const bool hot_ret = m_hot_db->read_range(prefix, callback, cookie);
+        if (!hot_ret)
+            return false;
+        return m_cold_db->read_range(prefix, callback, cookie);
+    }
+
+    bool ret = false;
+    for (xdb_range_iterator_ptr iter = new_range_iterator(prefix); iter->valid(); iter->next()) {
+        if ((*callback)(iter->key(), iter->value(), cookie) == false)
+            return false;
+        ret = true;
+    }
+    return ret;
+}
+
+bool xdb_tiered_t::delete_range(const std::string& begin_key,const std::string& end_key)
+{
+    xwrite_guard_t guard = lock_for_move();
+    const bool hot_ret  = m_hot_db->delete_range(begin_key, end_key);
+    const bool cold_ret = m_cold_db->delete_range(begin_key, end_key);
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::single_delete(const std::string& key)
+{
+    xwrite_guard_t guard = lock_for_move();
+    const bool hot_ret  = m_hot_db->single_delete(key);
+    const bool cold_ret = m_cold_db->single_delete(key);
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::compact_range(const std::string & begin_key,const std::string & end_key)
+{
+    const bool hot_ret  = m_hot_db->compact_range(begin_key, end_key);
+    const bool cold_ret = m_cold_db->compact_range(begin_key, end_key);
+    return (hot_ret && cold_ret);
+}
+
+void xdb_tiered_t::GetDBMemStatus() const
+{
+    m_hot_db->GetDBMemStatus();
+    m_cold_db->GetDBMemStatus();
+}
+
+bool xdb_tiered_t::get_estimate_num_keys(uint64_t & num) const
+{
+    uint64_t hot_num  = 0;
+    uint64_t cold_num = 0;
+    const bool hot_ret  = m_hot_db->get_estimate_num_keys(hot_num);
+    const bool cold_ret = m_cold_db->get_estimate_num_keys(cold_num);
+    num = hot_num + cold_num;
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::migrate_cf_layout()
+{
+    const bool hot_ret  = m_hot_db->migrate_cf_layout();
+    const bool cold_ret = m_cold_db->migrate_cf_layout();
+    return (hot_ret && cold_ret);
+}
+
+bool xdb_tiered_t::move_range_to_cold(const std::string& begin_key,const std::string& end_key)
+{
+    if (begin_key.empty() || end_key.empty() || (begin_key >= end_key)) {
+        xerror("xdb_tiered_t::move_range_to_cold,invalid range [%s,%s)", begin_key.c_str(), end_key.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_move_lock);
+    if (m_move_stop)
+        return false;
+    m_move_queue.emplace_back(begin_key, end_key);
+    m_move_cond.notify_one();
+    return true;
+}
+
+void xdb_tiered_t::move_loop()
+{
+    std::unique_lock<std::mutex> lock(m_move_lock);
+    for (;;) {
+        m_move_cond.wait(lock, [this] { return m_move_stop || !m_move_queue.empty(); });
+        if (m_move_queue.empty()) //stop after every queued range is done
+            break;
+
+        const std::pair<std::string, std::string> range = m_move_queue.front();
+        m_move_queue.pop_front();
+        m_move_running = true;
+        lock.unlock();
+
+        if (!move_range(range.first, range.second))
+            xwarn("xdb_tiered_t::move_loop,fail to move range [%s,%s)", range.first.c_str(), range.second.c_str());
+
+        lock.lock();
+        m_move_running = false;
+        m_move_done_cond.notify_all();
+    }
+    m_move_done_cond.notify_all();
+}
+
+void xdb_tiered_t::stop_move_thread()
+{
+    std::unique_ptr<std::thread> move_thread;
+    {
+        std::lock_guard<std::mutex> guard(m_move_lock);
+        m_move_stop = true;
+        move_thread = std::move(m_move_thread);
+        m_move_cond.notify_one();
+    }
+    if (move_thread != nullptr && move_thread->joinable())
+        move_thread->join();
+
+    std::lock_guard<std::mutex> guard(m_move_lock);
+    m_move_done_cond.notify_all();
+}
+
+//copy to cold DB first without blocking writers,then drop from hot DB only for keys not changed meanwhile
+bool xdb_tiered_t::move_range(const std::string& begin_key,const std::string& end_key)
+{
+    const auto mismatch_pos = std::mismatch(begin_key.begin(), begin_key.end(), end_key.begin());
+    const std::string prefix(begin_key.begin(), mismatch_pos.first);
+
+    std::map<std::string, std::string> values;
+    xtiered_range_cookie_t cookie;
+    cookie.begin_key = &begin_key;
+    cookie.end_key   = &end_key;
+    cookie.values    = &values;
+    m_hot_db->read_range(prefix, collect_range_callback, &cookie);
+    if (values.empty())
+        return true;
+
+    if (!m_cold_db->write(values))
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_write_lock);
+    m_move_finishing.store(true);
+    while (m_unlocked_writers.load() != 0) //writers started before go without lock,let them finish first
+        std::this_thread::yield();
+    const bool ret = drop_moved_keys(begin_key, end_key, values);
+    m_move_finishing.store(false);
+    return ret;
+}
+
+//caller must hold m_write_lock with every writer waited out
+bool xdb_tiered_t::drop_moved_keys(const std::string& begin_key,const std::string& end_key,std::map<std::string, std::string>& values)
+{
+    std::vector<std::string> keys;
+    keys.reserve(values.size());
+    for (auto & entry : values)
+        keys.push_back(entry.first);
+
+    m_hot_db->flush_async_writes();
+    std::vector<std::string> latest_values;
+    if (!m_hot_db->multi_read(keys, latest_values))
+        return false;
+
+    std::vector<std::string> hot_deleted_keys;
+    std::vector<std::string> cold_deleted_keys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (latest_values[i] == values[keys[i]])
+            hot_deleted_keys.push_back(keys[i]);
+        else if (latest_values[i].empty()) //deleted after copied,drop the copy as well
+            cold_deleted_keys.push_back(keys[i]);
+        //else updated after copied,newer value at hot DB shadows the copy
+    }
+    if (!hot_deleted_keys.empty() && !m_hot_db->erase(hot_deleted_keys))
+        return false;
+    if (!cold_deleted_keys.empty() && !m_cold_db->erase(cold_deleted_keys))
+        return false;
+
+    XMETRICS_GAUGE(metrics::db_tiered_moved_keys, hot_deleted_keys.size());
+    xinfo("xdb_tiered_t::move_range,moved %zu keys of [%s,%s)", hot_deleted_keys.size(), begin_key.c_str(), end_key.c_str());
+    return true;
+}
+
+}  // namespace db
+}  // namespace top
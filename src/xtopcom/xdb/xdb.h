@@ -21,11 +21,17 @@ class xdb_error : public std::runtime_error {
 class xdb : public xdb_face_t {
  public:
     //db_kinds refer to xdb_kind_t
-    explicit xdb(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths);
+    explicit xdb(const int db_kinds,const std::string& db_root_dir,std::vector<xdb_path_t> & db_paths,const xdb_options_t & db_options = xdb_options_t());
     ~xdb() noexcept;
     bool open() override;
     bool close() override;
     bool read(const std::string& key, std::string& value) const override;
+    bool read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const override;
+    bool multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const override;
+    //snapshot of RocksDB,note:writes still queued by write_async are not at the snapshot
+    xdb_snapshot_ptr create_snapshot() const override;
+    bool read(const xdb_snapshot_ptr& snapshot, const std::string& key, std::string& value) const override;
+    bool multi_read(const xdb_snapshot_ptr& snapshot, const std::vector<std::string>& keys, std::vector<std::string>& values) const override;
     bool exists(const std::string& key) const override;
     bool write(const std::string& key, const std::string& value) override;
     bool write(const std::string& key, const char* data, size_t size) override;
@@ -36,21 +42,27 @@ class xdb : public xdb_face_t {
     
     //batch mode for multiple keys with multiple ops
     bool batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) override;
+    bool write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback) override;
+    bool flush_async_writes() override;
+    bool bulk_load(const std::map<std::string, std::string>& objs) override;
     
     //prefix must start from first char of key
     bool read_range(const std::string& prefix, std::vector<std::string>& values) override;
     //note:begin_key and end_key must has same style(first char of key)
     bool delete_range(const std::string& begin_key,const std::string& end_key) override;
+    bool delete_ranges(const std::vector<std::pair<std::string, std::string>>& ranges) override;
     //key must be readonly(never update after PUT),otherwise the behavior is undefined
     bool single_delete(const std::string& key) override;
     
     //iterator each key of prefix.note: go throuh whole db if prefix is empty
     bool read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie) override;
+    xdb_range_iterator_ptr new_range_iterator(const std::string& prefix) override;
     bool get_estimate_num_keys(uint64_t & num) const override;
     //compact whole DB if both begin_key and end_key are empty
     //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
     virtual bool compact_range(const std::string & begin_key,const std::string & end_key) override;
     virtual void GetDBMemStatus() const override ;
+    bool migrate_cf_layout() override;
     xdb_meta_t  get_meta() override {return xdb_meta_t();}  // XTODO no need implement
 
  private:
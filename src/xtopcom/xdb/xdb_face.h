@@ -9,6 +9,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <functional>
 
 namespace top { namespace db {
 
@@ -42,6 +43,31 @@ struct xdb_path_t {
     xdb_path_t(const std::string& p, uint64_t t) : path(p), target_size(t) {}
 };
 
+//tuning knobs of one DB instance,0 means decided by xdb itself based on system memory
+struct xdb_options_t {
+    uint64_t    block_cache_size{0};  //total budget(in byte) of block cache shared by all CFs
+    bool        async_write_sync{false};    //fsync WAL at each group commit of async writes
+    uint32_t    wal_sync_interval_ms{1000}; //fsync WAL periodically when async_write_sync is off,0 means never
+    bool        prefix_bloom_filter{true};  //bloom filter & extractor of account prefix(refer xvdbkey_t) for range reads
+    bool        cf_routing_by_key_type{false}; //new DB put meta & tx index at dedicated CFs,old DB need migrate_cf_layout
+    bool        blob_files{false};          //keep large values(block object,input,output) at blob files instead of rewriting them by compaction
+    uint64_t    min_blob_size{4096};        //value smaller than it stays at SST even blob_files is on
+    bool        blob_gc{true};              //relocate valid blobs of oldest files during compaction,then drop those files
+    double      blob_gc_age_cutoff{0.25};   //ratio of oldest blob files that blob gc may relocate
+    std::string cold_db_path{};             //tiered mode if not empty:block history is moved to DB of this path(at cheaper volume)
+    uint64_t    cold_block_height_gap{0};   //blocks lower than (height of new block - gap) are moved to cold DB,0 means never
+    bool        statistics{true};           //collect rocksdb::Statistics(tickers & histograms) and export them as metrics
+    uint32_t    statistics_interval_sec{60};//period of exporting statistics,0 means only exported with GetDBMemStatus
+    uint32_t    slow_op_threshold_ms{200};  //log each DB call that takes longer(wall clock),0 means never
+    uint32_t    zstd_dict_bytes{0};         //bottom level of block CFs use ZSTD with dictionary of this size trained per SST,0 means no dictionary
+    uint32_t    zstd_dict_train_ratio{100}; //sample bytes fed into each training = zstd_dict_bytes * ratio
+    bool        direct_io_for_flush_and_compaction{false}; //background I/O bypass page cache,so it never evicts pages of foreground reads
+    bool        direct_reads{false};        //foreground reads bypass page cache too(whole DB,rocksdb has no per-CF switch),size block_cache_size for it
+    uint64_t    compaction_readahead_size{0}; //0 means 2M once direct_io_for_flush_and_compaction is on,else rocksdb default
+    uint32_t    compaction_rate_limit_mb{0}; //MB per second of flush & compaction I/O(read and write),0 means unlimited
+    bool        io_uring_multiread{true};   //batched reads(multi_read) go through io_uring if rocksdb is built with liburing
+};
+
 class xdb_transaction_t {
 public:
     virtual bool rollback() { return true; }
@@ -53,13 +79,94 @@ public:
     virtual bool erase(const std::string& key) = 0;
 };
 
+//read-only view of a value pinned at DB(e.g. at block cache or memtable),so caller may decode it without copying
+//note:data() is only valid while the view is alive
+class xdb_pinned_value_t {
+ public:
+    virtual ~xdb_pinned_value_t() {}
+    virtual const char* data() const = 0;
+    virtual size_t      size() const = 0;
+};
+using xdb_pinned_value_ptr = std::unique_ptr<xdb_pinned_value_t>;
+
+//fallback view that owns a copy of value,for DB has nothing to pin
+class xdb_string_value_t : public xdb_pinned_value_t {
+ public:
+    const char*  data() const override { return m_value.data(); }
+    size_t       size() const override { return m_value.size(); }
+    std::string& value() { return m_value; }
+ private:
+    std::string  m_value;
+};
+
+//point-in-time view of DB,reads through it see every key as of the moment it was created and never a write made later
+//note:release it before DB is closed,a snapshot keeps old versions of keys from being compacted while alive
+class xdb_snapshot_t {
+ public:
+    virtual ~xdb_snapshot_t() {}
+};
+using xdb_snapshot_ptr = std::shared_ptr<xdb_snapshot_t>;
+
 typedef bool (*xdb_iterator_callback)(const std::string& key, const std::string& value,void*cookie);
 
+//forward cursor over keys of one prefix by key order,caller pulls entries one by one(e.g. to merge ranges of several DB)
+//note:release it before DB is closed
+class xdb_range_iterator_t {
+ public:
+    virtual ~xdb_range_iterator_t() {}
+    virtual bool               valid() const = 0;
+    virtual void               next() = 0;
+    virtual const std::string& key() const = 0;
+    virtual const std::string& value() const = 0;
+};
+using xdb_range_iterator_ptr = std::unique_ptr<xdb_range_iterator_t>;
+
+//fallback cursor over entries collected by read_range,for DB has no native iterator
+class xdb_buffered_range_iterator_t : public xdb_range_iterator_t {
+ public:
+    bool               valid() const override { return m_pos < m_entries.size(); }
+    void               next() override { ++m_pos; }
+    const std::string& key() const override { return m_entries[m_pos].first; }
+    const std::string& value() const override { return m_entries[m_pos].second; }
+    static bool        collect_callback(const std::string& key, const std::string& value,void*cookie) {
+        ((xdb_buffered_range_iterator_t*)cookie)->m_entries.emplace_back(key, value);
+        return true;
+    }
+ private:
+    std::vector<std::pair<std::string, std::string>> m_entries;
+    size_t                                           m_pos{0};
+};
+//called with the result once an async write has been written into DB
+typedef std::function<void(bool)> xdb_write_callback;
+
 class xdb_face_t {
  public:
     virtual bool open() = 0;
     virtual bool close() = 0;
     virtual bool read(const std::string& key, std::string& value) const = 0;
+    //zero-copy read,value refer to memory pinned at DB until it is released
+    virtual bool read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const {
+        std::unique_ptr<xdb_string_value_t> string_value(new xdb_string_value_t());
+        if (!read(key, string_value->value()))
+            return false;
+        value = std::move(string_value);
+        return true;
+    }
+    //batch read of multiple keys,values[i] is empty if keys[i] is not found;return false only when DB error
+    virtual bool multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const {
+        values.clear();
+        values.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (!read(keys[i], values[i]))
+                values[i].clear();
+        }
+        return true;
+    }
+    //consistent view for a group of reads(e.g. a block index,its object and tx indexes),nullptr if DB has no snapshot
+    virtual xdb_snapshot_ptr create_snapshot() const { return nullptr; }
+    //read key as of snapshot,read live DB if snapshot is nullptr
+    virtual bool read(const xdb_snapshot_ptr& snapshot, const std::string& key, std::string& value) const { return read(key, value); }
+    virtual bool multi_read(const xdb_snapshot_ptr& snapshot, const std::vector<std::string>& keys, std::vector<std::string>& values) const { return multi_read(keys, values); }
     virtual bool exists(const std::string& key) const = 0;
     virtual bool write(const std::string& key, const std::string& value) = 0;
     virtual bool write(const std::string& key, const char* data, size_t size) = 0;
@@ -70,20 +177,54 @@ class xdb_face_t {
     
     //batch mode for multiple keys with multiple ops
     virtual bool batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) = 0;
+    //async batch mode:return once queued,concurrent batches are merged into one DB write(group commit) by background writer
+    //note:read/exists see queued data immediately,but range ops only see data after it has been written
+    virtual bool write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback) {
+        const bool ret = batch_change(objs, delete_keys);
+        if (callback)
+            callback(ret);
+        return ret;
+    }
+    //block until every async write queued before was written
+    virtual bool flush_async_writes() { return true; }
+    //bulk mode for offline jobs(migrate,restore,import):objs are built into sorted files and ingested into DB directly,skip memtable & WAL
+    //note:ingested keys override existing ones,so caller must not mix it with concurrent writes of same keys
+    virtual bool bulk_load(const std::map<std::string, std::string>& objs) { return write(objs); }
     
     //prefix must start from first char of key
     virtual bool read_range(const std::string& prefix, std::vector<std::string>& values) = 0;
     //note:begin_key and end_key must has same style(first char of key)
     virtual bool delete_range(const std::string& begin_key,const std::string& end_key) = 0;
+    //delete multiple ranges of ["begin_key", "end_key") by one write,default implementation deletes one by one
+    virtual bool delete_ranges(const std::vector<std::pair<std::string, std::string>>& ranges) {
+        bool ret = true;
+        for (auto const & range : ranges) {
+            if (!delete_range(range.first, range.second))
+                ret = false;
+        }
+        return ret;
+    }
     //key must be readonly(never update after PUT),otherwise the behavior is undefined
     virtual bool single_delete(const std::string& key) = 0;
     //iterator each key of prefix.note: go throuh whole db if prefix is empty
     virtual bool read_range(const std::string& prefix,xdb_iterator_callback callback_fuc,void * cookie) = 0;
+    //cursor over keys of prefix by key order,default one collects the whole range first
+    virtual xdb_range_iterator_ptr new_range_iterator(const std::string& prefix) {
+        std::unique_ptr<xdb_buffered_range_iterator_t> iter(new xdb_buffered_range_iterator_t());
+        read_range(prefix, xdb_buffered_range_iterator_t::collect_callback, iter.get());
+        return std::move(iter);
+    }
     //compact whole DB if both begin_key and end_key are empty
     //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
     virtual bool compact_range(const std::string & begin_key,const std::string & end_key) = 0;
     virtual void GetDBMemStatus() const = 0 ;
     virtual bool get_estimate_num_keys(uint64_t & num) const = 0;
+    //move keys into CFs by key type while DB keep serving,resume from where it stop when call again
+    virtual bool migrate_cf_layout() { return false; }
+    //tiered mode:move keys of ["begin_key", "end_key") to cold DB at background,read-through for lookup after moved
+    virtual bool     move_range_to_cold(const std::string & begin_key,const std::string & end_key) { return false; }
+    //return 0 if not tiered
+    virtual uint64_t get_cold_height_gap() const { return 0; }
 };
 
 }  // namespace ledger
@@ -14,7 +14,7 @@ class xdb_factory_t {
  public:
     xdb_factory_t() = delete;
     ~xdb_factory_t() = delete;
-    static std::shared_ptr<xdb_face_t> create(int db_kinds, const std::string& db_root_dir,std::vector<xdb_path_t> db_data_paths = std::vector<xdb_path_t>());
+    static std::shared_ptr<xdb_face_t> create(int db_kinds, const std::string& db_root_dir,std::vector<xdb_path_t> db_data_paths = std::vector<xdb_path_t>(),const xdb_options_t & db_options = xdb_options_t());
     static std::shared_ptr<xdb_face_t> instance(const std::string& db_root_dir,std::vector<xdb_path_t> db_data_paths = std::vector<xdb_path_t>());
     static std::shared_ptr<xdb_face_t> create_kvdb(const std::string& db_root_dir) {
         return create(xdb_kind_kvdb, db_root_dir);
@@ -6,23 +6,49 @@
 
 #include <string>
 #include <stdexcept>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
 
+#include "xbase/xlock.h"
 #include "xdb/xdb_face.h"
 
 namespace top { namespace db {
 
 class xdb_memdb_transaction_t;
 
+//value is shared(never modified in place),so pinned reads and snapshots hold it without copy
+using xdb_mem_value_ptr = std::shared_ptr<const std::string>;
+using xdb_mem_map_t     = std::map<std::string, xdb_mem_value_ptr>;
+
+//point-in-time view of xdb_mem_t,keep unchanged whatever writes happen to DB later
+class xdb_mem_snapshot_t {
+ public:
+    explicit xdb_mem_snapshot_t(const std::shared_ptr<const xdb_mem_map_t> & values) : m_values(values) {}
+ public:
+    bool    read(const std::string& key, std::string& value) const;
+    //iterator each key of prefix by key order.note: go throuh whole snapshot if prefix is empty
+    bool    read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie) const;
+    size_t  size() const {return m_values->size();}
+ private:
+    friend class xdb_mem_t;
+    std::shared_ptr<const xdb_mem_map_t> m_values;
+};
+using xdb_mem_snapshot_ptr = std::shared_ptr<const xdb_mem_snapshot_t>;
+
+//in-memory DB for tests,devnet and benchmark:ordered map guarded by read-write lock,readers run concurrently
+//snapshot is copy-on-write:taking one is O(1),the first write after it copy the map(key & value ptr only)
 class xdb_mem_t : public xdb_face_t {
  public:
+    xdb_mem_t();
     bool open() override { return true; }
     bool close() override { return true; }
     bool read(const std::string& key, std::string& value) const override;
+    bool read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const override;
+    bool multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const override;
     bool exists(const std::string& key) const override;
 
     bool write(const std::string& key, const std::string& value) override;
@@ -39,20 +65,35 @@ class xdb_mem_t : public xdb_face_t {
     bool delete_range(const std::string& begin_key,const std::string& end_key) override;
     //key must be readonly(never update after PUT),otherwise the behavior is undefined
     bool single_delete(const std::string& key) override;
-    
+
     //iterator each key of prefix.note: go throuh whole db if prefix is empty
+    //note:callback run without lock,so it may access DB
     bool read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie) override;
+    //cursor hold a copy-on-write view of DB,so it never blocks writers and never sees writes made later
+    xdb_range_iterator_ptr new_range_iterator(const std::string& prefix) override;
     //compact whole DB if both begin_key and end_key are empty
     //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
     bool compact_range(const std::string & begin_key,const std::string & end_key) override;
     void GetDBMemStatus() const override ;
     bool get_estimate_num_keys(uint64_t & num) const override;
-    
-    xdb_meta_t  get_meta() override {return m_meta;}  // implement for test
+
+    xdb_meta_t  get_meta() override;  // implement for test
  public:
-    std::map<std::string, std::string> m_values;
-    xdb_meta_t m_meta;
-    mutable std::mutex m_lock;
+    xdb_mem_snapshot_ptr get_snapshot() const;
+    //reset whole DB to the content of snapshot
+    bool                 restore_snapshot(const xdb_mem_snapshot_ptr & snapshot);
+ private:
+    friend class xdb_memdb_transaction_t;
+    //caller must hold write lock
+    xdb_mem_map_t &  get_writable_values();
+    void             put_value(xdb_mem_map_t & values, const std::string& key, const std::string& value);
+    void             erase_value(xdb_mem_map_t & values, const std::string& key);
+    void             reset_meta(const xdb_mem_map_t & values);
+ private:
+    std::shared_ptr<xdb_mem_map_t> m_values;
+    xdb_meta_t                     m_meta;
+    mutable std::atomic<size_t>    m_read_count{0};
+    mutable base::xrwlock_t        m_lock;
 };
 
 class xdb_memdb_transaction_t : public xdb_transaction_t {
@@ -0,0 +1,116 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "xdb/xdb_face.h"
+
+namespace top { namespace db {
+
+//tiered storage:hot DB keep recent data,cold DB(at cheaper volume) keep history moved by move_range_to_cold
+//read lookup hot DB first then read-through cold DB,write always go to hot DB,delete apply for both
+class xdb_tiered_t : public xdb_face_t {
+ public:
+    xdb_tiered_t(const std::shared_ptr<xdb_face_t> & hot_db, const std::shared_ptr<xdb_face_t> & cold_db, const uint64_t cold_height_gap);
+    ~xdb_tiered_t() noexcept;
+ private:
+    xdb_tiered_t();
+    xdb_tiered_t(const xdb_tiered_t &);
+    xdb_tiered_t & operator = (const xdb_tiered_t &);
+
+ public:
+    bool open() override;
+    bool close() override;
+    bool read(const std::string& key, std::string& value) const override;
+    bool read_pinned(const std::string& key, xdb_pinned_value_ptr& value) const override;
+    bool multi_read(const std::vector<std::string>& keys, std::vector<std::string>& values) const override;
+    //snapshot of both DB,hot DB is taken first so a key moving to cold DB meanwhile is seen at either one
+    xdb_snapshot_ptr create_snapshot() const override;
+    bool read(const xdb_snapshot_ptr& snapshot, const std::string& key, std::string& value) const override;
+    bool multi_read(const xdb_snapshot_ptr& snapshot, const std::vector<std::string>& keys, std::vector<std::string>& values) const override;
+    bool exists(const std::string& key) const override;
+
+    bool write(const std::string& key, const std::string& value) override;
+    bool write(const std::string& key, const char* data, size_t size) override;
+    bool write(const std::map<std::string, std::string>& batches) override;
+
+    bool erase(const std::string& key) override;
+    bool erase(const std::vector<std::string>& keys) override;
+    bool batch_change(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys) override;
+    bool write_async(const std::map<std::string, std::string>& objs, const std::vector<std::string>& delete_keys, xdb_write_callback callback) override;
+    //block until every async write and every move queued before are finished
+    bool flush_async_writes() override;
+    //keys are ingested into hot DB,same as other writes
+    bool bulk_load(const std::map<std::string, std::string>& objs) override;
+
+    //prefix must start from first char of key
+    bool read_range(const std::string& prefix, std::vector<std::string>& values) override;
+    //note:begin_key and end_key must has same style(first char of key)
+    bool delete_range(const std::string& begin_key,const std::string& end_key) override;
+    //key must be readonly(never update after PUT),otherwise the behavior is undefined
+    bool single_delete(const std::string& key) override;
+
+    //iterator each key of prefix.note: go throuh whole db if prefix is empty
+    bool read_range(const std::string& prefix,xdb_iterator_callback callback,void * cookie) override;
+    //stream both DB merged by key order,no range is copied as a whole
+    xdb_range_iterator_ptr new_range_iterator(const std::string& prefix) override;
+    //compact whole DB if both begin_key and end_key are empty
+    bool compact_range(const std::string & begin_key,const std::string & end_key) override;
+    void GetDBMemStatus() const override ;
+    bool get_estimate_num_keys(uint64_t & num) const override;
+    bool migrate_cf_layout() override;
+    xdb_meta_t  get_meta() override {return m_hot_db->get_meta();}
+
+    bool     move_range_to_cold(const std::string& begin_key,const std::string& end_key) override;
+    uint64_t get_cold_height_gap() const override {return m_cold_height_gap;}
+
+ private:
+    //writers go without lock,and only hold m_write_lock one by one while mover is dropping moved keys from hot DB
+    struct xwrite_guard_t {
+        xwrite_guard_t() = default;
+        xwrite_guard_t(xwrite_guard_t && other) : lock(std::move(other.lock)), unlocked_writers(other.unlocked_writers) { other.unlocked_writers = nullptr; }
+        ~xwrite_guard_t() {
+            if (unlocked_writers != nullptr)
+                unlocked_writers->fetch_sub(1);
+        }
+        std::unique_lock<std::mutex> lock;
+        std::atomic<uint32_t>*       unlocked_writers{nullptr}; //counted writer without lock
+    };
+    xwrite_guard_t lock_for_move();
+    void move_loop();
+    void stop_move_thread();
+    bool move_range(const std::string& begin_key,const std::string& end_key);
+    bool drop_moved_keys(const std::string& begin_key,const std::string& end_key,std::map<std::string, std::string>& values);
+
+ private:
+    std::shared_ptr<xdb_face_t> m_hot_db;
+    std::shared_ptr<xdb_face_t> m_cold_db;
+    const uint64_t              m_cold_height_gap;
+
+    //background mover
+    std::mutex                  m_move_lock;
+    std::condition_variable     m_move_cond;        //wake up mover
+    std::condition_variable     m_move_done_cond;   //wake up who wait for queue drained
+    std::deque<std::pair<std::string, std::string>> m_move_queue;
+    bool                        m_move_running{false}; //mover is processing one range
+    bool                        m_move_stop{false};
+    std::unique_ptr<std::thread> m_move_thread;
+    //serialize writes to hot DB with the final step of moving,so a key updated meanwhile is never dropped
+    std::mutex                  m_write_lock;
+    std::atomic<bool>           m_move_finishing{false};  //mover is dropping moved keys,writers must take m_write_lock
+    std::atomic<uint32_t>       m_unlocked_writers{0};    //writers going without m_write_lock,mover waits them out
+};
+
+}  // namespace db
+}  // namespace top
@@ -100,6 +100,19 @@ bool xstore::set_values(const std::map<std::string, std::string> & objs) {
     return m_db->batch_change(objs, empty_delete_keys);
 }
 
+bool xstore::set_values_async(const std::map<std::string, std::string> & objs, std::function<void(bool)> on_written) {
+    std::vector<std::string> empty_delete_keys;
+    const size_t objs_count = objs.size();
+    return m_db->write_async(objs, empty_delete_keys, [objs_count, on_written](bool result) {
+        if (!result) {
+            xerror("xstore::set_values_async,fail to write %zu objs", objs_count);
+        }
+        if (on_written) {
+            on_written(result);
+        }
+    });
+}
+
 bool xstore::delete_value(const std::string &key) {
     return m_db->erase(key);
 }
@@ -114,6 +127,52 @@ const std::string xstore::get_value(const std::string &key) const {
     return value;
 }
 
+bool xstore::decode_value(const std::string & key, const base::xvdb_value_decoder & decoder) const {
+    db::xdb_pinned_value_ptr value;
+    if (!m_db->read_pinned(key, value) || (value->size() == 0)) {
+        return false;
+    }
+    return decoder(value->data(), value->size());
+}
+
+std::vector<std::string> xstore::get_values(const std::vector<std::string> & keys) const {
+    std::vector<std::string> values;
+    if (!m_db->multi_read(keys, values)) {
+        xwarn("xstore::get_values fail,keys count=%zu", keys.size());
+    }
+    return values;
+}
+
+//reads of one RPC query or export go through a DB snapshot,falls back to live DB if DB has no snapshot
+class xstore_snapshot_t : public base::xvdbsnapshot_t {
+ public:
+    xstore_snapshot_t(const std::shared_ptr<db::xdb_face_t> & db, const db::xdb_snapshot_ptr & snapshot) : m_db(db), m_snapshot(snapshot) {}
+
+    const std::string get_value(const std::string & key) const override {
+        std::string value;
+        if (!m_db->read(m_snapshot, key, value)) {
+            return std::string();
+        }
+        return value;
+    }
+
+    std::vector<std::string> get_values(const std::vector<std::string> & keys) const override {
+        std::vector<std::string> values;
+        if (!m_db->multi_read(m_snapshot, keys, values)) {
+            xwarn("xstore_snapshot_t::get_values fail,keys count=%zu", keys.size());
+        }
+        return values;
+    }
+
+ private:
+    std::shared_ptr<db::xdb_face_t> m_db;  // declared first so the snapshot is released before the DB
+    db::xdb_snapshot_ptr            m_snapshot;
+};
+
+base::xvdbsnapshot_ptr_t xstore::create_snapshot() const {
+    return std::make_shared<xstore_snapshot_t>(m_db, m_db->create_snapshot());
+}
+
 bool  xstore::delete_values(const std::vector<std::string> & to_deleted_keys)
 {
     std::map<std::string, std::string> empty_put;
@@ -125,6 +184,18 @@ bool   xstore::read_range(const std::string& prefix, std::vector<std::string>& v
 {
     return m_db->read_range(prefix,values);
 }
+
+static bool visit_range_callback(const std::string& key, const std::string& value,void* cookie)
+{
+    return (*static_cast<const base::xvdb_range_visitor*>(cookie))(key, value);
+}
+
+bool   xstore::read_range(const std::string& prefix, const base::xvdb_range_visitor & visitor)
+{
+    // xdb gives false when nothing visited or the visitor stopped,both are fine here
+    m_db->read_range(prefix, visit_range_callback, const_cast<base::xvdb_range_visitor*>(&visitor));
+    return true;
+}
  
 //note:begin_key and end_key must has same style(first char of key)
 bool   xstore::delete_range(const std::string & begin_key,const std::string & end_key)
@@ -132,6 +203,11 @@ bool   xstore::delete_range(const std::string & begin_key,const std::string & en
     return m_db->delete_range(begin_key,end_key);
 }
 
+bool   xstore::delete_ranges(const std::vector<std::pair<std::string,std::string>> & ranges)
+{
+    return m_db->delete_ranges(ranges);
+}
+
 //compact whole DB if both begin_key and end_key are empty
 //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
 bool  xstore::compact_range(const std::string & begin_key,const std::string & end_key)
@@ -139,6 +215,16 @@ bool  xstore::compact_range(const std::string & begin_key,const std::string & en
     return m_db->compact_range(begin_key,end_key);
 }
 
+bool  xstore::move_range_to_cold(const std::string & begin_key,const std::string & end_key)
+{
+    return m_db->move_range_to_cold(begin_key,end_key);
+}
+
+uint64_t  xstore::get_cold_height_gap() const
+{
+    return m_db->get_cold_height_gap();
+}
+
 //key must be readonly(never update after PUT),otherwise the behavior is undefined
 bool   xstore::single_delete(const std::string & target_key)//key must be readonly(never update after PUT),otherwise the behavior is undefined
 {
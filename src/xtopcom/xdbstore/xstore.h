@@ -34,14 +34,20 @@ class xstore final: public xstore_face_t {
     virtual bool                set_value(const std::string & key, const std::string& value) override;
     virtual bool                delete_value(const std::string & key) override;
     virtual const std::string   get_value(const std::string & key) const override;
+    virtual bool                decode_value(const std::string & key, const base::xvdb_value_decoder & decoder) const override;
+    virtual std::vector<std::string> get_values(const std::vector<std::string> & keys) const override;
+    virtual base::xvdbsnapshot_ptr_t create_snapshot() const override;
     virtual bool                set_values(const std::map<std::string, std::string> & objs) override;
     virtual bool                delete_values(const std::vector<std::string> & to_deleted_keys) override;
+    virtual bool                set_values_async(const std::map<std::string, std::string> & objs, std::function<void(bool)> on_written) override;
 
 public:
     //prefix must start from first char of key
     virtual bool             read_range(const std::string& prefix, std::vector<std::string>& values) override;
+    virtual bool             read_range(const std::string& prefix, const base::xvdb_range_visitor & visitor) override;
     //note:begin_key and end_key must has same style(first char of key)
     virtual bool             delete_range(const std::string & begin_key,const std::string & end_key) override;
+    virtual bool             delete_ranges(const std::vector<std::pair<std::string,std::string>> & ranges) override;
     //key must be readonly(never update after PUT),otherwise the behavior is undefined
     virtual bool             single_delete(const std::string & target_key) override;
     
@@ -49,6 +55,8 @@ public:
     //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
     virtual bool             compact_range(const std::string & begin_key,const std::string & end_key) override;
     virtual void             GetDBMemStatus() const override;
+    virtual bool             move_range_to_cold(const std::string & begin_key,const std::string & end_key) override;
+    virtual uint64_t         get_cold_height_gap() const override;
     //iterator each key of prefix.note: go throuh whole db if prefix is empty
     bool                     read_range_callback(const std::string& prefix,db::xdb_iterator_callback callback,void * cookie);
  public:
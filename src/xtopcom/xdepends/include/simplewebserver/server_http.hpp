@@ -285,6 +285,9 @@ namespace SimpleWeb {
 
       std::shared_ptr<asio::ip::tcp::endpoint> remote_endpoint;
 
+      // bytes of the next pipelined request(s), read together with the current one
+      std::string pipelined;
+
       void close() noexcept {
         error_code ec;
         socket->lowest_layer().shutdown(asio::ip::tcp::socket::shutdown_both, ec);
@@ -322,6 +325,11 @@ namespace SimpleWeb {
           this->connection->remote_endpoint = std::make_shared<asio::ip::tcp::endpoint>(this->connection->socket->lowest_layer().remote_endpoint(ec));
         }
         request = std::shared_ptr<Request>(new Request(max_request_streambuf_size, this->connection->remote_endpoint));
+        if(!this->connection->pipelined.empty()) {
+          std::ostream stream(&request->streambuf);
+          stream.write(this->connection->pipelined.data(), this->connection->pipelined.size());
+          this->connection->pipelined.clear();
+        }
       }
 
       std::shared_ptr<Connection> connection;
@@ -568,6 +576,8 @@ namespace SimpleWeb {
                 this->on_error(session->request, make_error_code::make_error_code(errc::protocol_error));
               return;
             }
+            if(content_length < num_additional_bytes)
+              this->keep_pipelined(session, content_length);
             if(content_length > num_additional_bytes) {
               session->connection->set_timeout(config.timeout_content);
               asio::async_read(*session->connection->socket, session->request->streambuf, asio::transfer_exactly(content_length - num_additional_bytes), [this, session](const error_code &ec, std::size_t /*bytes_transferred*/) {
@@ -597,14 +607,27 @@ namespace SimpleWeb {
             auto chunks_streambuf = std::make_shared<asio::streambuf>(this->config.max_request_streambuf_size);
             this->read_chunked_transfer_encoded(session, chunks_streambuf);
           }
-          else
+          else {
+            if(num_additional_bytes > 0)
+              this->keep_pipelined(session, 0);
             this->find_resource(session);
+          }
         }
         else if(this->on_error)
           this->on_error(session->request, ec);
       });
     }
 
+    // leave only the content of this request in its streambuf, the rest is read again by the next session
+    void keep_pipelined(const std::shared_ptr<Session> &session, std::size_t content_length) {
+      auto &streambuf = session->request->streambuf;
+      std::string data(asio::buffers_begin(streambuf.data()), asio::buffers_end(streambuf.data()));
+      streambuf.consume(streambuf.size());
+      std::ostream stream(&streambuf);
+      stream.write(data.data(), content_length);
+      session->connection->pipelined.assign(data, content_length, std::string::npos);
+    }
+
     void read_chunked_transfer_encoded(const std::shared_ptr<Session> &session, const std::shared_ptr<asio::streambuf> &chunks_streambuf) {
       session->connection->set_timeout(config.timeout_content);
       asio::async_read_until(*session->connection->socket, session->request->streambuf, "\r\n", [this, session, chunks_streambuf](const error_code &ec, size_t bytes_transferred) {
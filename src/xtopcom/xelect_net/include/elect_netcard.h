@@ -48,6 +48,13 @@ public:
 
     void send_to(base::KadmliaKeyPtr const & send_kad_key, base::KadmliaKeyPtr const & recv_kad_key, xbyte_buffer_t const & bytes_message, std::error_code & ec) const;
 
+    // priority: enum_xpacket_priority_type_*, carried in the xbase packet header to pick the receiver's worker thread
+    void send_to(base::KadmliaKeyPtr const & send_kad_key,
+                 base::KadmliaKeyPtr const & recv_kad_key,
+                 xbyte_buffer_t const & bytes_message,
+                 uint16_t const priority,
+                 std::error_code & ec) const;
+
     void spread_rumor(base::KadmliaKeyPtr const & send_kad_key, base::KadmliaKeyPtr const & recv_kad_key, xbyte_buffer_t const & bytes_message, std::error_code & ec) const;
 
     void broadcast(base::KadmliaKeyPtr const & send_kad_key, base::KadmliaKeyPtr const & recv_kad_key, xbyte_buffer_t const & bytes_message, std::error_code & ec) const;
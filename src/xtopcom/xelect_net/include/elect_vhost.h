@@ -42,6 +42,11 @@ public:
 
 public:
     void send_to(common::xip2_t const & src, common::xip2_t const & dst, xbyte_buffer_t const & byte_message, std::error_code & ec) const override;
+    void send_to(common::xip2_t const & src,
+                 common::xip2_t const & dst,
+                 xbyte_buffer_t const & byte_message,
+                 network::xdeliver_priority_t const priority,
+                 std::error_code & ec) const override;
     void send_to_through_root(common::xip2_t const & src, common::xnode_id_t const & dst_node_id, xbyte_buffer_t const & byte_message, std::error_code & ec) const override;
     void spread_rumor(common::xip2_t const & src, common::xip2_t const & dst, xbyte_buffer_t const & byte_message, std::error_code & ec) const override;
     void broadcast(common::xip2_t const & src, xbyte_buffer_t const & byte_message, std::error_code & ec) const override;
@@ -6,7 +6,7 @@
 
 #include "xbasic/xbyte_buffer.h"
 #include "xbasic/xrunnable.h"
-// #include "xnetwork/xmessage_transmission_property.h"
+#include "xnetwork/xmessage_transmission_property.h"
 #include "xnetwork/xnetwork_message_ready_callback.h"
 // #include "xnetwork/xnode.h"
 // #include "xnetwork/xp2p/xdht_host_face.h"
@@ -27,6 +27,18 @@ public:
     ~xtop_network_driver_face() override = default;
 
     virtual void send_to(common::xip2_t const & src, common::xip2_t const & dst, xbyte_buffer_t const & byte_message, std::error_code & ec) const = 0;
+
+    /**
+     * \brief Send with deliver priority. Highest priority messages take the transport priority lane on both sender and receiver.
+     *        Drivers not supporting priority send it as normal.
+     */
+    virtual void send_to(common::xip2_t const & src,
+                         common::xip2_t const & dst,
+                         xbyte_buffer_t const & byte_message,
+                         top::network::xdeliver_priority_t const priority,
+                         std::error_code & ec) const {
+        send_to(src, dst, byte_message, ec);
+    }
     virtual void send_to_through_root(common::xip2_t const & src, common::xnode_id_t const & dst_node_id, xbyte_buffer_t const & byte_message, std::error_code & ec) const = 0;
     virtual void spread_rumor(common::xip2_t const & src, common::xip2_t const & dst, xbyte_buffer_t const & byte_message, std::error_code & ec) const = 0;
     virtual void broadcast(common::xip2_t const & src, xbyte_buffer_t const & byte_message, std::error_code & ec) const = 0;
@@ -119,6 +119,14 @@ void EcNetcard::send_to(base::KadmliaKeyPtr const & send_kad_key,
                         base::KadmliaKeyPtr const & recv_kad_key,
                         xbyte_buffer_t const & bytes_message,
                         std::error_code & ec) const {
+    send_to(send_kad_key, recv_kad_key, bytes_message, enum_xpacket_priority_type_routine, ec);
+}
+
+void EcNetcard::send_to(base::KadmliaKeyPtr const & send_kad_key,
+                        base::KadmliaKeyPtr const & recv_kad_key,
+                        xbyte_buffer_t const & bytes_message,
+                        uint16_t const priority,
+                        std::error_code & ec) const {
     assert(send_kad_key);
     assert(recv_kad_key);
     xdbg("[ec_netcard][send_to] src: [%d][%d][%d][%d][%d]",
@@ -136,7 +144,7 @@ void EcNetcard::send_to(base::KadmliaKeyPtr const & send_kad_key,
 
     transport::protobuf::RoutingMessage pbft_message;
     pbft_message.set_broadcast(false);
-    pbft_message.set_priority(enum_xpacket_priority_type_routine);
+    pbft_message.set_priority(priority);
     if (recv_kad_key->xnetwork_id() == kRoot) {
         pbft_message.set_is_root(true);
     } else {
@@ -397,10 +405,11 @@ void EcNetcard::HandleRumorMessage(
 
     elect::protobuf::VhostMessage vhost_msg;
     xbyte_buffer_t bytes_msg;
-    std::string data = message.data();// point2point or broadcast without header and block
+    // refer to the payload inside message, the block can be large and is not copied until handed to callbacks.
+    std::string const * data_ptr = &message.data();  // point2point or broadcast without header and block
     if (message.has_gossip()) {
         // broadcast  with header and block
-        auto gossip = message.gossip();
+        auto const & gossip = message.gossip();
         if (!gossip.has_block() && gossip.has_header_hash()) {
             xdbg("%s HandleRumorMessage header arrive", transport::FormatMsgid(message).c_str());
             return;
@@ -408,9 +417,10 @@ void EcNetcard::HandleRumorMessage(
 
         if (gossip.has_block()) {
             // broadcast with header and block (block arrive)
-            data = gossip.block();
+            data_ptr = &gossip.block();
         }
     }
+    std::string const & data = *data_ptr;
     
     
     uint32_t msg_hash = base::xhash32_t::digest(std::to_string(message.id()) + data);
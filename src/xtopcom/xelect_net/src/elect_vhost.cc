@@ -101,6 +101,14 @@ bool EcVHost::SyncMessageWhenStart(const vnetwork::xvnode_address_t & send_addre
 }
 #endif
 void EcVHost::send_to(common::xip2_t const & src, common::xip2_t const & dst, xbyte_buffer_t const & byte_message, std::error_code & ec) const {
+    send_to(src, dst, byte_message, network::xdeliver_priority_t::normal, ec);
+}
+
+void EcVHost::send_to(common::xip2_t const & src,
+                      common::xip2_t const & dst,
+                      xbyte_buffer_t const & byte_message,
+                      network::xdeliver_priority_t const priority,
+                      std::error_code & ec) const {
     assert((dst.network_id() & common::xbroadcast_id_t::network) != common::xbroadcast_id_t::network);
     assert((dst.zone_id() & common::xbroadcast_id_t::zone) != common::xbroadcast_id_t::zone);
     assert((dst.cluster_id() & common::xbroadcast_id_t::cluster) != common::xbroadcast_id_t::cluster);
@@ -115,7 +123,8 @@ void EcVHost::send_to(common::xip2_t const & src, common::xip2_t const & dst, xb
           dst.to_string().c_str(),
           send_kad_key->Get().c_str(),
           recv_kad_key->Get().c_str());
-    ec_netcard_->send_to(send_kad_key, recv_kad_key, byte_message, ec);
+    uint16_t const packet_priority = (priority == network::xdeliver_priority_t::highest) ? enum_xpacket_priority_type_flash : enum_xpacket_priority_type_routine;
+    ec_netcard_->send_to(send_kad_key, recv_kad_key, byte_message, packet_priority, ec);
 }
 
 void EcVHost::send_to_through_root(common::xip2_t const & src, common::xnode_id_t const & dst_node_id, xbyte_buffer_t const & byte_message, std::error_code & ec) const {
@@ -467,6 +467,18 @@ std::vector<std::shared_ptr<xgroup_element_t>> xtop_cluster_element::children(co
     return ret;
 }
 
+std::vector<std::shared_ptr<xgroup_element_t>> xtop_cluster_element::group_elements() const {
+    std::vector<std::shared_ptr<xgroup_element_t>> ret;
+
+    XLOCK(m_group_elements_mutex);
+    for (auto const & group_elements_info : m_group_elements) {
+        for (auto const & group_info : top::get<xgroup_info_container_t>(group_elements_info)) {
+            ret.push_back(top::get<std::shared_ptr<xgroup_element_t>>(group_info));
+        }
+    }
+    return ret;
+}
+
 bool xtop_cluster_element::exist_with_lock_hold_outside(common::xgroup_id_t const & group_id) const {
     return find_with_lock_hold_outside(group_id) != std::end(m_group_elements);
 }
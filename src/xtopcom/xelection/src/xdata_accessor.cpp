@@ -5,6 +5,7 @@
 #include "xelection/xcache/xdata_accessor.h"
 
 #include "xbase/xlog.h"
+#include "xbasic/xscope_executer.h"
 #include "xbasic/xutility.h"
 #include "xelection/xcache/xcluster_element.h"
 #include "xelection/xcache/xgroup_element.h"
@@ -16,6 +17,7 @@
 #include <cinttypes>
 #include <cstdint>
 #include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
 
@@ -38,6 +40,8 @@ std::unordered_map<common::xgroup_address_t, xgroup_update_result_t> xtop_data_a
     assert(!ec);
     assert(m_network_element);
 
+    xscope_executer_t snapshot_updater{[this] { update_snapshot(); }};
+
     if (broadcast(zone_id)) {
         ec = xdata_accessor_errc_t::zone_id_empty;
 
@@ -176,6 +180,14 @@ std::map<common::xslot_id_t, data::xnode_info_t> xtop_data_accessor::group_nodes
         return {};
     }
 
+    auto const snapshot = this->snapshot();
+    if (snapshot != nullptr) {
+        auto const group_snapshot = snapshot->group(group_address, group_logic_epoch);
+        if (group_snapshot != nullptr && !group_snapshot->nodes().empty()) {
+            return group_snapshot->nodes();
+        }
+    }
+
     auto group_element = this->group_element(group_address.network_id(), group_address.zone_id(), group_address.cluster_id(), group_address.group_id(), group_logic_epoch, ec);
 
     if (ec) {
@@ -266,6 +278,14 @@ std::shared_ptr<xnode_element_t> xtop_data_accessor::node_element(common::xgroup
                                                      common::xslot_id_t const & slot_id,
                                                      std::error_code & ec) const {
     assert(!ec);
+    auto const snapshot = this->snapshot();
+    if (snapshot != nullptr) {
+        auto const group_snapshot = snapshot->group(address, logic_epoch);
+        if (group_snapshot != nullptr && group_snapshot->node_element(slot_id) != nullptr) {
+            return group_snapshot->node_element(slot_id);
+        }
+    }
+
     auto const group_element = this->group_element(address.network_id(), address.zone_id(), address.cluster_id(), address.group_id(), logic_epoch, ec);
     if (ec) {
         xwarn("%s %s", ec.category().name(), ec.message().c_str());
@@ -278,6 +298,14 @@ std::shared_ptr<xnode_element_t> xtop_data_accessor::node_element(common::xgroup
 
 common::xaccount_address_t xtop_data_accessor::account_address_from(common::xip2_t const & xip2, std::error_code & ec) const {
     assert(!ec);
+    auto const snapshot = this->snapshot();
+    if (snapshot != nullptr) {
+        auto const group_snapshot = snapshot->group_by_height(common::xgroup_address_t{xip2.network_id(), xip2.zone_id(), xip2.cluster_id(), xip2.group_id()}, xip2.height());
+        if (group_snapshot != nullptr && group_snapshot->node_element(xip2.slot_id()) != nullptr) {
+            return group_snapshot->node_element(xip2.slot_id())->node_id();
+        }
+    }
+
     auto group_element = this->group_element_by_height(xip2.network_id(), xip2.zone_id(), xip2.cluster_id(), xip2.group_id(), xip2.height(), ec);
     if (ec) {
         xwarn("%s %s", ec.category().name(), ec.message().c_str());
@@ -410,6 +438,14 @@ std::shared_ptr<xgroup_element_t> xtop_data_accessor::parent_group_element(commo
 
 common::xelection_round_t xtop_data_accessor::election_epoch_from(common::xip2_t const & xip2, std::error_code & ec) const {
     assert(!ec);
+    auto const snapshot = this->snapshot();
+    if (snapshot != nullptr) {
+        auto const group_snapshot = snapshot->group_by_height(common::xgroup_address_t{xip2.network_id(), xip2.zone_id(), xip2.cluster_id(), xip2.group_id()}, xip2.height());
+        if (group_snapshot != nullptr) {
+            return group_snapshot->logic_epoch().election_round();
+        }
+    }
+
     auto group_element = this->group_element_by_height(xip2.network_id(), xip2.zone_id(), xip2.cluster_id(), xip2.group_id(), xip2.height(), ec);
     if (ec) {
         xwarn("%s %s", ec.category().name(), ec.message().c_str());
@@ -420,6 +456,18 @@ common::xelection_round_t xtop_data_accessor::election_epoch_from(common::xip2_t
     return group_element->election_round();
 }
 
+std::shared_ptr<xelection_snapshot_t const> xtop_data_accessor::snapshot() const {
+    return std::atomic_load(&m_snapshot);
+}
+
+void xtop_data_accessor::update_snapshot() {
+    // readers keep the snapshot they got, a new one is built from the element tree and published as a whole
+    std::lock_guard<std::mutex> lock{m_snapshot_update_mutex};
+    auto snapshot = std::make_shared<xelection_snapshot_t const>(m_network_element);
+    xinfo("xdata_accessor_t::update_snapshot network %" PRIu32 " groups %zu", static_cast<std::uint32_t>(m_network_element->network_id().value()), snapshot->group_count());
+    std::atomic_store(&m_snapshot, std::shared_ptr<xelection_snapshot_t const>{std::move(snapshot)});
+}
+
 std::unordered_map<common::xgroup_address_t, xgroup_update_result_t> xtop_data_accessor::update_zone(std::shared_ptr<xzone_element_t> const & zone_element,
                                                                                                      data::election::xelection_result_store_t const & election_result_store,
                                                                                                      std::uint64_t const associated_blk_height,
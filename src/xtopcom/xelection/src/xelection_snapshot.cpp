@@ -0,0 +1,115 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xelection/xcache/xelection_snapshot.h"
+
+#include "xelection/xcache/xcluster_element.h"
+#include "xelection/xcache/xgroup_element.h"
+#include "xelection/xcache/xnetwork_element.h"
+#include "xelection/xcache/xnode_element.h"
+#include "xelection/xcache/xzone_element.h"
+
+#include <cassert>
+
+NS_BEG3(top, election, cache)
+
+xtop_group_snapshot::xtop_group_snapshot(std::shared_ptr<xgroup_element_t> const & group_element)
+  : m_address{group_element->address().group_address()}, m_logic_epoch{group_element->logic_epoch()} {
+    std::error_code ec;
+    auto const & node_elements = group_element->children(ec);
+    for (auto const & node_element_info : node_elements) {
+        auto const & slot_id = top::get<common::xslot_id_t const>(node_element_info);
+        auto const & node_element = top::get<std::shared_ptr<xnode_element_t>>(node_element_info);
+        if (common::broadcast(slot_id)) {
+            continue;
+        }
+
+        if (m_node_elements.size() <= slot_id.value()) {
+            m_node_elements.resize(static_cast<std::size_t>(slot_id.value()) + 1);
+        }
+        m_node_elements[slot_id.value()] = node_element;
+
+        data::xnode_info_t node_info;
+        node_info.election_info = node_element->election_info();
+        node_info.address = node_element->address();
+        m_nodes.insert({slot_id, std::move(node_info)});
+    }
+}
+
+common::xgroup_address_t const & xtop_group_snapshot::address() const noexcept {
+    return m_address;
+}
+
+common::xlogic_epoch_t const & xtop_group_snapshot::logic_epoch() const noexcept {
+    return m_logic_epoch;
+}
+
+std::map<common::xslot_id_t, data::xnode_info_t> const & xtop_group_snapshot::nodes() const noexcept {
+    return m_nodes;
+}
+
+std::shared_ptr<xnode_element_t> const & xtop_group_snapshot::node_element(common::xslot_id_t const & slot_id) const noexcept {
+    static std::shared_ptr<xnode_element_t> const empty;
+    if (common::broadcast(slot_id) || slot_id.value() >= m_node_elements.size()) {
+        return empty;
+    }
+    return m_node_elements[slot_id.value()];
+}
+
+xtop_election_snapshot::xtop_election_snapshot(std::shared_ptr<xnetwork_element_t> const & network_element) {
+    assert(network_element != nullptr);
+
+    std::error_code ec;
+    for (auto const & zone_info : network_element->children(ec)) {
+        auto const & zone_element = top::get<std::shared_ptr<xzone_element_t>>(zone_info);
+        ec.clear();
+        for (auto const & cluster_info : zone_element->children(ec)) {
+            auto const & cluster_element = top::get<std::shared_ptr<xcluster_element_t>>(cluster_info);
+            for (auto const & group_element : cluster_element->group_elements()) {
+                auto snapshot = std::make_shared<xgroup_snapshot_t const>(group_element);
+                m_groups[snapshot->address()].push_back(std::move(snapshot));
+            }
+        }
+    }
+}
+
+std::shared_ptr<xgroup_snapshot_t const> xtop_election_snapshot::group(common::xgroup_address_t const & group_address,
+                                                                        common::xlogic_epoch_t const & logic_epoch) const noexcept {
+    auto const it = m_groups.find(group_address);
+    if (it == std::end(m_groups)) {
+        return nullptr;
+    }
+
+    for (auto const & group : top::get<std::vector<std::shared_ptr<xgroup_snapshot_t const>>>(*it)) {
+        if (group->logic_epoch() == logic_epoch) {
+            return group;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<xgroup_snapshot_t const> xtop_election_snapshot::group_by_height(common::xgroup_address_t const & group_address,
+                                                                                  std::uint64_t const election_blk_height) const noexcept {
+    auto const it = m_groups.find(group_address);
+    if (it == std::end(m_groups)) {
+        return nullptr;
+    }
+
+    for (auto const & group : top::get<std::vector<std::shared_ptr<xgroup_snapshot_t const>>>(*it)) {
+        if (group->logic_epoch().associated_blk_height() == election_blk_height) {
+            return group;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t xtop_election_snapshot::group_count() const noexcept {
+    std::size_t count = 0;
+    for (auto const & group_info : m_groups) {
+        count += top::get<std::vector<std::shared_ptr<xgroup_snapshot_t const>>>(group_info).size();
+    }
+    return count;
+}
+
+NS_END3
@@ -76,6 +76,9 @@ public:
     std::vector<std::shared_ptr<xgroup_element_t>> children(common::xnode_type_t const child_type, common::xlogic_time_t const logic_time, std::error_code & ec) const;
     std::vector<std::shared_ptr<xgroup_element_t>> children(common::xnode_type_t const child_type, common::xlogic_time_t const logic_time) const;
 
+    /// @brief All the groups kept in the cluster, each group id ordered by the start time, the newest first.
+    std::vector<std::shared_ptr<xgroup_element_t>> group_elements() const;
+
 private:
     bool exist_with_lock_hold_outside(common::xgroup_id_t const & group_id) const;
     bool exist_with_lock_hold_outside(common::xgroup_id_t const & group_id, common::xlogic_time_t const logic_time) const;
@@ -13,6 +13,7 @@
 #include "xelection/xcache/xnetwork_element.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 NS_BEG3(top, election, cache)
@@ -21,6 +22,8 @@ class xtop_data_accessor final : public xdata_accessor_face_t {
 private:
     std::shared_ptr<xnetwork_element_t> m_network_element;
     observer_ptr<time::xchain_time_face_t> m_logic_timer;
+    std::mutex m_snapshot_update_mutex{};
+    std::shared_ptr<xelection_snapshot_t const> m_snapshot{};  // accessed by std::atomic_load / std::atomic_store
 
 public:
     xtop_data_accessor(xtop_data_accessor const &) = delete;
@@ -88,7 +91,11 @@ public:
 
     common::xelection_round_t election_epoch_from(common::xip2_t const & xip2, std::error_code & ec) const override;
 
+    std::shared_ptr<xelection_snapshot_t const> snapshot() const override;
+
 private:
+    void update_snapshot();
+
     std::unordered_map<common::xcluster_address_t, xgroup_update_result_t> update_zone(std::shared_ptr<xzone_element_t> const & zone_element,
                                                                                        data::election::xelection_result_store_t const & election_result_store,
                                                                                        std::uint64_t const associated_blk_height,
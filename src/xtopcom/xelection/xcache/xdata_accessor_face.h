@@ -10,6 +10,7 @@
 #include "xdata/xelection/xelection_result_store.h"
 #include "xdata/xnode_info.h"
 #include "xelection/xcache/xcluster_element.h"
+#include "xelection/xcache/xelection_snapshot.h"
 #include "xelection/xcache/xnode_element.h"
 
 #include <system_error>
@@ -82,6 +83,9 @@ public:
                                                                    std::error_code & ec) const = 0;
 
     virtual common::xelection_round_t election_epoch_from(common::xip2_t const & xip2, std::error_code & ec) const = 0;
+
+    /// @brief The groups as of the last election data update, nullptr before the first one. The snapshot never changes once returned.
+    virtual std::shared_ptr<xelection_snapshot_t const> snapshot() const = 0;
 };
 using xdata_accessor_face_t = xtop_data_accessor_face;
 
@@ -0,0 +1,75 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xcommon/xaddress.h"
+#include "xdata/xnode_info.h"
+#include "xelection/xcache/xelement_fwd.h"
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG3(top, election, cache)
+
+/**
+ * @brief immutable copy of one group of one election round, nodes are indexed by slot id.
+ */
+class xtop_group_snapshot {
+private:
+    common::xgroup_address_t m_address;
+    common::xlogic_epoch_t m_logic_epoch;
+    std::vector<std::shared_ptr<xnode_element_t>> m_node_elements;
+    std::map<common::xslot_id_t, data::xnode_info_t> m_nodes;
+
+public:
+    xtop_group_snapshot(xtop_group_snapshot const &) = delete;
+    xtop_group_snapshot & operator=(xtop_group_snapshot const &) = delete;
+    xtop_group_snapshot(xtop_group_snapshot &&) = default;
+    xtop_group_snapshot & operator=(xtop_group_snapshot &&) = default;
+    ~xtop_group_snapshot() = default;
+
+    explicit xtop_group_snapshot(std::shared_ptr<xgroup_element_t> const & group_element);
+
+    common::xgroup_address_t const & address() const noexcept;
+
+    common::xlogic_epoch_t const & logic_epoch() const noexcept;
+
+    /// @brief The nodes of the group in the form returned by xdata_accessor_face_t::group_nodes.
+    std::map<common::xslot_id_t, data::xnode_info_t> const & nodes() const noexcept;
+
+    /// @brief The node at the slot, nullptr if the slot is empty.
+    std::shared_ptr<xnode_element_t> const & node_element(common::xslot_id_t const & slot_id) const noexcept;
+};
+using xgroup_snapshot_t = xtop_group_snapshot;
+
+/**
+ * @brief immutable view of all the groups in the election cache, rebuilt after each election data update.
+ *        readers share it without locks, a group lookup is a hash lookup over the few rounds the cache keeps.
+ */
+class xtop_election_snapshot {
+private:
+    // the rounds of a group are ordered by their start time, the newest first
+    std::unordered_map<common::xgroup_address_t, std::vector<std::shared_ptr<xgroup_snapshot_t const>>> m_groups;
+
+public:
+    xtop_election_snapshot(xtop_election_snapshot const &) = delete;
+    xtop_election_snapshot & operator=(xtop_election_snapshot const &) = delete;
+    xtop_election_snapshot(xtop_election_snapshot &&) = default;
+    xtop_election_snapshot & operator=(xtop_election_snapshot &&) = default;
+    ~xtop_election_snapshot() = default;
+
+    explicit xtop_election_snapshot(std::shared_ptr<xnetwork_element_t> const & network_element);
+
+    std::shared_ptr<xgroup_snapshot_t const> group(common::xgroup_address_t const & group_address, common::xlogic_epoch_t const & logic_epoch) const noexcept;
+
+    std::shared_ptr<xgroup_snapshot_t const> group_by_height(common::xgroup_address_t const & group_address, std::uint64_t const election_blk_height) const noexcept;
+
+    std::size_t group_count() const noexcept;
+};
+using xelection_snapshot_t = xtop_election_snapshot;
+
+NS_END3
@@ -68,7 +68,8 @@ contract_runtime::evm::xevm_output_t xtop_evm::execute(data::xcons_transaction_p
 evm_common::xevm_transaction_result_t xtop_evm::execute_action(std::unique_ptr<data::xbasic_top_action_t const> action, txexecutor::xvm_para_t const & vm_para) {
     assert(action->type() == data::xtop_action_type_t::evm);
 
-    return evm_action_runtime_->new_session()->execute_action(std::move(action), vm_para);
+    contract_runtime::xaction_session_t<data::xevm_consensus_action_t> session{make_observer(evm_action_runtime_.get())};
+    return session.execute_action(std::move(action), vm_para);
 }
 
 NS_END2
@@ -399,10 +399,18 @@ public:
     /// Encodes a list header.
     static xbytes_t encodeHeader(uint64_t size, uint8_t smallTag, uint8_t largeTag) noexcept;
 
+    /// Encodes a block of data to the end of out, same as append(out, encode(data)) without temporary buffer.
+    static void encodeTo(xbytes_t & out, const xbytes_t & data) noexcept;
+
+    /// Wraps bytes of out from payload_begin to end as a list in place, by inserting the list header at payload_begin.
+    /// Encoding items of a list directly into out then wrapping them needs no temporary buffer.
+    static void encodeListTo(xbytes_t & out, std::size_t payload_begin) noexcept;
+
     /// Returns the representation of an integer using the least number of bytes
     /// needed.
     static xbytes_t putVarInt(uint64_t i);
     static uint64_t parseVarInt(size_t size, const xbytes_t & data, size_t index);
+    static uint64_t parseVarInt(size_t size, bytesConstRef data, size_t index);
 
     struct DecodedItem {
         std::vector<xbytes_t> decoded;
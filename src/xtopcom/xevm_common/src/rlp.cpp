@@ -7,6 +7,7 @@
 #include "xevm_common/data.h"
 
 #include <algorithm>
+#include <cassert>
 #include <tuple>
 
 using namespace std;
@@ -257,6 +258,41 @@ xbytes_t RLP::encodeHeader(uint64_t size, uint8_t smallTag, uint8_t largeTag) no
     return header;
 }
 
+// header of size written to buf, returns header length.
+static std::size_t putHeader(uint64_t size, uint8_t smallTag, uint8_t largeTag, xbyte_t (&buf)[1 + c_rlpMaxLengthBytes]) noexcept {
+    if (size < 56) {
+        buf[0] = static_cast<xbyte_t>(smallTag + size);
+        return 1;
+    }
+    std::size_t length = 0;
+    for (auto i = size; i != 0; i >>= 8) {
+        ++length;
+    }
+    buf[0] = static_cast<xbyte_t>(largeTag + length);
+    for (std::size_t i = 0; i < length; ++i) {
+        buf[length - i] = static_cast<xbyte_t>(size >> (8 * i));
+    }
+    return 1 + length;
+}
+
+void RLP::encodeTo(xbytes_t & out, const xbytes_t & data) noexcept {
+    if (data.size() == 1 && data[0] <= 0x7f) {
+        out.push_back(data[0]);
+        return;
+    }
+    xbyte_t header[1 + c_rlpMaxLengthBytes];
+    auto const header_size = putHeader(data.size(), 0x80, 0xb7, header);
+    out.insert(out.end(), header, header + header_size);
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+void RLP::encodeListTo(xbytes_t & out, std::size_t payload_begin) noexcept {
+    assert(payload_begin <= out.size());
+    xbyte_t header[1 + c_rlpMaxLengthBytes];
+    auto const header_size = putHeader(out.size() - payload_begin, 0xc0, 0xf7, header);
+    out.insert(std::next(out.begin(), static_cast<std::ptrdiff_t>(payload_begin)), header, header + header_size);
+}
+
 xbytes_t RLP::putVarInt(uint64_t i) {
     xbytes_t bytes;  // accumulate bytes here, in reverse order
     do {
@@ -273,10 +309,14 @@ xbytes_t RLP::putVarInt(uint64_t i) {
 }
 
 uint64_t RLP::parseVarInt(size_t size, const xbytes_t & data, size_t index) {
+    return static_cast<size_t>(parseVarInt(size, bytesConstRef(data.data(), data.size()), index));
+}
+
+uint64_t RLP::parseVarInt(size_t size, bytesConstRef data, size_t index) {
     if (size < 1 || size > 8) {
         throw std::invalid_argument("invalid length length");
     }
-    if (data.size() - index < size) {
+    if (data.size() < index || data.size() - index < size) {
         throw std::invalid_argument("Not enough data for varInt");
     }
     if (size >= 2 && data[index] == 0) {
@@ -287,199 +327,112 @@ uint64_t RLP::parseVarInt(size_t size, const xbytes_t & data, size_t index) {
         val = val << 8;
         val += data[index + i];
     }
-    return static_cast<size_t>(val);
+    return val;
 }
 
-RLP::DecodedItem RLP::decodeList(const xbytes_t & input) {
-    RLP::DecodedItem item;
-    auto remainder = input;
-    while (true) {
-        auto listItem = RLP::decode(remainder);
-        if (!listItem.decoded.empty()) {
-            for (auto const & decoded : listItem.decoded) {
-                item.decoded.push_back(decoded);
-            }
-        } else {
-            item.decoded.push_back(xbytes_t());
-        }
-        if (listItem.remainder.size() == 0) {
-            break;
-        } else {
-            remainder = listItem.remainder;
-        }
-    }
-    return item;
-}
+static void decode_list_items(bytesConstRef input, std::vector<xbytes_t> & decoded);
 
-RLP::DecodedItem RLP::decode(const xbytes_t & input) {
+// decodes the item at the front of input into decoded and returns its encoded size. items of a list
+// are decoded too when expand_list, otherwise the payload of the list is the item. input is only
+// read through views, so nothing is copied except the decoded items themselves.
+static size_t decode_item(bytesConstRef input, std::vector<xbytes_t> & decoded, bool expand_list) {
     if (input.size() == 0) {
         throw std::invalid_argument("can't decode empty rlp data");
     }
-    RLP::DecodedItem item;
     auto inputLen = input.size();
     auto prefix = input[0];
     if (prefix <= 0x7f) {
         // 00--7f: a single byte whose value is in the [0x00, 0x7f] range, that byte is its own RLP encoding.
-        item.decoded.push_back(xbytes_t{input[0]});
-        item.remainder = subData(input, 1);
-        return item;
+        decoded.push_back(xbytes_t{input[0]});
+        return 1;
     }
     if (prefix <= 0xb7) {
         // 80--b7: short string
         // string is 0-55 bytes long. A single byte with value 0x80 plus the length of the string followed by the string
         // The range of the first byte is [0x80, 0xb7]
-
-        // empty string
-        if (prefix == 0x80) {
-            item.decoded.emplace_back(xbytes_t());
-            item.remainder = subData(input, 1);
-            return item;
-        }
-
         size_t strLen = prefix - 0x80;
-        if (strLen == 1 && input[1] <= 0x7f) {
-            throw std::invalid_argument("single byte below 128 must be encoded as itself");
-        }
-
         if (inputLen < (1 + strLen)) {
             throw std::invalid_argument(std::string("invalid short string, length ") + std::to_string(strLen));
         }
-        item.decoded.push_back(subData(input, 1, strLen));
-        item.remainder = subData(input, 1 + strLen);
-
-        return item;
-    }
-    if (prefix <= 0xbf) {
-        // b8--bf: long string
-        auto lenOfStrLen = size_t(prefix - 0xb7);
-        auto strLen = static_cast<size_t>(parseVarInt(lenOfStrLen, input, 1));
-        if (inputLen < lenOfStrLen || inputLen < (1 + lenOfStrLen + strLen)) {
-            throw std::invalid_argument(std::string("Invalid rlp encoding length, length ") + std::to_string(strLen));
-        }
-        auto data = subData(input, 1 + lenOfStrLen, strLen);
-        item.decoded.push_back(data);
-        item.remainder = subData(input, 1 + lenOfStrLen + strLen);
-        return item;
-    }
-    if (prefix <= 0xf7) {
-        // c0--f7: a list between  0-55 bytes long
-        auto listLen = size_t(prefix - 0xc0);
-        if (inputLen < (1 + listLen)) {
-            throw std::invalid_argument(std::string("Invalid rlp string length, length ") + std::to_string(listLen));
-        }
-        // empty list
-        if (listLen == 0) {
-            item.remainder = subData(input, 1);
-            return item;
-        }
-
-        // decode list
-        auto listItem = decodeList(subData(input, 1, listLen));
-        for (auto & data : listItem.decoded) {
-            item.decoded.push_back(data);
-        }
-        item.remainder = subData(input, 1 + listLen);
-        return item;
-    }
-    // f8--ff
-    auto lenOfListLen = size_t(prefix - 0xf7);
-    auto listLen = static_cast<size_t>(parseVarInt(lenOfListLen, input, 1));
-    if (listLen < 56) {
-        throw std::invalid_argument("length below 56 must be encoded in one byte");
-    }
-    if (inputLen < lenOfListLen || inputLen < (1 + lenOfListLen + listLen)) {
-        throw std::invalid_argument(std::string("Invalid rlp list length, length ") + std::to_string(listLen));
-    }
-
-    // decode list
-    auto listItem = decodeList(subData(input, 1 + lenOfListLen, listLen));
-    for (auto & data : listItem.decoded) {
-        item.decoded.push_back(data);
-    }
-    item.remainder = subData(input, 1 + lenOfListLen + listLen);
-    return item;
-}
-
-RLP::DecodedItem RLP::decode_once(const xbytes_t & input) {
-    if (input.size() == 0) {
-        throw std::invalid_argument("can't decode empty rlp data");
-    }
-    RLP::DecodedItem item;
-    auto inputLen = input.size();
-    auto prefix = input[0];
-    if (prefix <= 0x7f) {
-        // 00--7f: a single byte whose value is in the [0x00, 0x7f] range, that byte is its own RLP encoding.
-        item.decoded.push_back(xbytes_t{input[0]});
-        item.remainder = subData(input, 1);
-        return item;
-    }
-    if (prefix <= 0xb7) {
-        // 80--b7: short string
-        // string is 0-55 bytes long. A single byte with value 0x80 plus the length of the string followed by the string
-        // The range of the first byte is [0x80, 0xb7]
-
-        // empty string
-        if (prefix == 0x80) {
-            item.decoded.emplace_back(xbytes_t());
-            item.remainder = subData(input, 1);
-            return item;
-        }
-
-        size_t strLen = prefix - 0x80;
         if (strLen == 1 && input[1] <= 0x7f) {
             throw std::invalid_argument("single byte below 128 must be encoded as itself");
         }
-
-        if (inputLen < (1 + strLen)) {
-            throw std::invalid_argument(std::string("invalid short string, length ") + std::to_string(strLen));
-        }
-        item.decoded.push_back(subData(input, 1, strLen));
-        item.remainder = subData(input, 1 + strLen);
-
-        return item;
+        decoded.emplace_back(input.data() + 1, input.data() + 1 + strLen);
+        return 1 + strLen;
     }
     if (prefix <= 0xbf) {
         // b8--bf: long string
         auto lenOfStrLen = size_t(prefix - 0xb7);
-        auto strLen = static_cast<size_t>(parseVarInt(lenOfStrLen, input, 1));
-        if (inputLen < lenOfStrLen || inputLen < (1 + lenOfStrLen + strLen)) {
+        auto strLen = static_cast<size_t>(RLP::parseVarInt(lenOfStrLen, input, 1));
+        if (inputLen - 1 - lenOfStrLen < strLen) {
             throw std::invalid_argument(std::string("Invalid rlp encoding length, length ") + std::to_string(strLen));
         }
-        auto data = subData(input, 1 + lenOfStrLen, strLen);
-        item.decoded.push_back(data);
-        item.remainder = subData(input, 1 + lenOfStrLen + strLen);
-        return item;
+        auto payload = input.data() + 1 + lenOfStrLen;
+        decoded.emplace_back(payload, payload + strLen);
+        return 1 + lenOfStrLen + strLen;
     }
+    size_t lenOfListLen = 0;
+    size_t listLen = 0;
     if (prefix <= 0xf7) {
         // c0--f7: a list between  0-55 bytes long
-        auto listLen = size_t(prefix - 0xc0);
+        listLen = size_t(prefix - 0xc0);
         if (inputLen < (1 + listLen)) {
             throw std::invalid_argument(std::string("Invalid rlp string length, length ") + std::to_string(listLen));
         }
         // empty list
         if (listLen == 0) {
-            item.remainder = subData(input, 1);
-            return item;
+            return 1;
         }
-        auto data = subData(input, 1, listLen);
-        item.decoded.push_back(data);
-        item.remainder = subData(input, 1 + listLen);
-        return item;
     } else {
         // f8--ff
-        auto lenOfListLen = size_t(prefix - 0xf7);
-        auto listLen = static_cast<size_t>(parseVarInt(lenOfListLen, input, 1));
+        lenOfListLen = size_t(prefix - 0xf7);
+        listLen = static_cast<size_t>(RLP::parseVarInt(lenOfListLen, input, 1));
         if (listLen < 56) {
             throw std::invalid_argument("length below 56 must be encoded in one byte");
         }
-        if (inputLen < lenOfListLen || inputLen < (1 + lenOfListLen + listLen)) {
+        if (inputLen - 1 - lenOfListLen < listLen) {
             throw std::invalid_argument(std::string("Invalid rlp list length, length ") + std::to_string(listLen));
         }
-        auto data = subData(input, 1 + lenOfListLen, listLen);
-        item.decoded.push_back(data);
-        item.remainder = subData(input, 1 + lenOfListLen + listLen);
-        return item;
     }
+    auto payload = input.cropped(1 + lenOfListLen, listLen);
+    if (expand_list) {
+        decode_list_items(payload, decoded);
+    } else {
+        decoded.emplace_back(payload.data(), payload.data() + payload.size());
+    }
+    return 1 + lenOfListLen + listLen;
+}
+
+// an empty list among the items is kept as one empty item
+static void decode_list_items(bytesConstRef input, std::vector<xbytes_t> & decoded) {
+    do {
+        auto const count = decoded.size();
+        auto const size = decode_item(input, decoded, true);
+        if (decoded.size() == count) {
+            decoded.emplace_back();
+        }
+        input = input.cropped(size);
+    } while (input.size() != 0);
+}
+
+RLP::DecodedItem RLP::decodeList(const xbytes_t & input) {
+    RLP::DecodedItem item;
+    decode_list_items(bytesConstRef{&input}, item.decoded);
+    return item;
+}
+
+RLP::DecodedItem RLP::decode(const xbytes_t & input) {
+    RLP::DecodedItem item;
+    auto size = decode_item(bytesConstRef{&input}, item.decoded, true);
+    item.remainder.assign(std::next(input.begin(), static_cast<std::ptrdiff_t>(size)), input.end());
+    return item;
+}
+
+RLP::DecodedItem RLP::decode_once(const xbytes_t & input) {
+    RLP::DecodedItem item;
+    auto size = decode_item(bytesConstRef{&input}, item.decoded, false);
+    item.remainder.assign(std::next(input.begin(), static_cast<std::ptrdiff_t>(size)), input.end());
+    return item;
 }
 
 RLPStream& RLPStream::appendRaw(bytesConstRef _s, size_t _itemCount)
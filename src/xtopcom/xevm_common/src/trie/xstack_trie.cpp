@@ -13,13 +13,8 @@
 NS_BEG3(top, evm_common, trie)
 
 std::shared_ptr<xtop_stack_trie> xtop_stack_trie::NewStackTrie(xkv_db_face_ptr_t db) {
-    if (db == nullptr) {
-        xerror("build stack trie from null db");
-    }
-
-    auto st_trie = xtop_stack_trie{db};
-
-    return std::make_shared<xtop_stack_trie>(st_trie);
+    // db may be null, then stack trie only calculates root hash.
+    return std::make_shared<xtop_stack_trie>(std::move(db));
 }
 
 void xtop_stack_trie::Update(xbytes_t const & key, xbytes_t const & value) {
@@ -37,7 +32,8 @@ void xtop_stack_trie::TryUpdate(xbytes_t const & key, xbytes_t const & value, st
         xerror("stack trie not support delete");
         return;
     }
-    auto real_key = xbytes_t{k.begin() + k.size() - 1, k.end()};
+    // strip the terminator, leaf key gets it back when hashed.
+    auto real_key = xbytes_t{k.begin(), k.end() - 1};
     insert(real_key, value);
     return;
 }
@@ -47,7 +43,7 @@ void xtop_stack_trie::insert(xbytes_t const & key, xbytes_t const & value) {
     case xstack_trie_node_type_t::branchNode: {
         auto idx = static_cast<std::size_t>(key[0]);
         // Unresolve elder siblings
-        for (auto i = idx - 1; i >= 0; i--) {
+        for (auto i = static_cast<int>(idx) - 1; i >= 0; i--) {
             if (m_children[i] != nullptr) {
                 if (m_children[i]->type() != xstack_trie_node_type_t::hashedNode) {
                     m_children[i]->hash();
@@ -93,25 +89,27 @@ void xtop_stack_trie::insert(xbytes_t const & key, xbytes_t const & value) {
         }
         // Convert to hash
         n->hash();
-        std::shared_ptr<xtop_stack_trie> p;
+        xtop_stack_trie * p{nullptr};
         if (diffidx == 0) {
             // the break is on the first byte, so
             // the current node is converted into
             // a branch node.
             m_children[0] = nullptr;
-            p = std::make_shared<xtop_stack_trie>(*this);
+            p = this;
             m_type = xstack_trie_node_type_t::branchNode;
         } else {
             // the common prefix is at least one byte
             // long, insert a new intermediate branch
             // node.
             m_children[0] = std::make_shared<xtop_stack_trie>(m_db);
-            p = m_children[0];
+            p = m_children[0].get();
             p->m_type = xstack_trie_node_type_t::branchNode;
         }
-        auto rest_key = xbytes_t{m_key.begin() + diffidx + 1, m_key.end()};
+        // Create a leaf for the inserted part
+        auto rest_key = xbytes_t{key.begin() + diffidx + 1, key.end()};
         auto o = newLeaf(rest_key, value);
 
+        // Insert both child leaves where they belong
         auto originIdx = m_key[diffidx];
         auto newIdx = key[diffidx];
         p->m_children[originIdx] = n;
@@ -136,21 +134,25 @@ void xtop_stack_trie::insert(xbytes_t const & key, xbytes_t const & value) {
         // Check if the split occurs at the first nibble of the
         // chunk. In that case, no prefix extnode is necessary.
         // Otherwise, create that
-        std::shared_ptr<xtop_stack_trie> p;
+        xtop_stack_trie * p{nullptr};
         if (diffidx == 0) {
             // Convert current leaf into a branch
             m_type = xstack_trie_node_type_t::branchNode;
-            p = std::make_shared<xtop_stack_trie>(*this);
+            p = this;
             m_children[0] = nullptr;
         } else {
             // Convert current node into an ext,
             // and insert a child branch node.
             m_type = xstack_trie_node_type_t::extNode;
             m_children[0] = std::make_shared<xtop_stack_trie>(m_db);
-            p = m_children[0];
+            p = m_children[0].get();
             p->m_type = xstack_trie_node_type_t::branchNode;
         }
 
+        // Create the two child leaves: the one containing the
+        // original value and the one containing the new value.
+        // The child leave will be hashed directly in order to
+        // free up some memory.
         auto origIdx = m_key[diffidx];
         auto orig_rest_key = xbytes_t{m_key.begin() + diffidx + 1, m_key.end()};
         p->m_children[origIdx] = newLeaf(orig_rest_key, m_val);
@@ -173,6 +175,7 @@ void xtop_stack_trie::insert(xbytes_t const & key, xbytes_t const & value) {
     }
     case xstack_trie_node_type_t::hashedNode: {
         xerror("stack trie try insert into hash node");
+        return;
     }
     default: {
         xassert(false);
@@ -181,87 +184,91 @@ void xtop_stack_trie::insert(xbytes_t const & key, xbytes_t const & value) {
     __builtin_unreachable();
 }
 
+// child reference in parent: embedded rlp if shorter than a hash, otherwise the rlp string of the hash.
+static void append_child_ref(xbytes_t & encoded, xbytes_t const & child_val) {
+    if (child_val.size() < 32) {
+        append(encoded, child_val);
+    } else {
+        RLP::encodeTo(encoded, child_val);
+    }
+}
+
 void xtop_stack_trie::hash() {
     /* Shortcut if node is already hashed */
     if (m_type == xstack_trie_node_type_t::hashedNode) {
         return;
     }
+    if (m_type == xstack_trie_node_type_t::emptyNode) {
+        m_val = xbytes_t{empty_root_bytes.begin(), empty_root_bytes.end()};
+        m_key.clear();
+        m_type = xstack_trie_node_type_t::hashedNode;
+        return;
+    }
 
-    // xtrie_hasher_t h{false};
-    xbytes_t hash_buffer;
+    // children encode themselves into the same scratch buffer of the thread, so all of them are hashed
+    // before the buffer is cleared for this node.
+    if (m_type == xstack_trie_node_type_t::branchNode) {
+        for (auto const & child : m_children) {
+            if (child != nullptr) {
+                child->hash();
+            }
+        }
+    } else if (m_type == xstack_trie_node_type_t::extNode) {
+        m_children[0]->hash();
+    }
+    static thread_local xbytes_t hash_buffer;
+    hash_buffer.clear();
 
     switch (m_type) {
     case xstack_trie_node_type_t::branchNode: {
-        std::array<xtrie_node_face_ptr_t, 17> nodes;
-        for (std::size_t index = 0; index < m_children.size(); ++index) {
-            auto child = m_children[index];
+        for (auto & child : m_children) {
             if (child == nullptr) {
-                nodes[index] = std::make_shared<xtrie_value_node_t>(nilValueNode);
+                RLP::encodeTo(hash_buffer, nilValueNode.data());  // 0x80 for empty bytes.
                 continue;
             }
-            child->hash();
-            if (child->m_children.size() < 32) {
-                nodes[index] = std::make_shared<xtrie_raw_node_t>(child->m_val);
-            } else {
-                nodes[index] = std::make_shared<xtrie_hash_node_t>(child->m_val);
-            }
-            m_children[index] = nullptr;
+            append_child_ref(hash_buffer, child->m_val);
+            child = nullptr;  // Reclaim mem from subtree
         }
-        nodes[16] = std::make_shared<xtrie_value_node_t>(nilValueNode);
-        hash_buffer = xtrie_node_rlp::EncodeNodesToBytes(nodes);
+        RLP::encodeTo(hash_buffer, nilValueNode.data());
+        RLP::encodeListTo(hash_buffer, 0);
         xdbg("xtop_stack_trie hash branchNode buffer: %s", top::to_hex(hash_buffer).c_str());
+        break;
     }
     case xstack_trie_node_type_t::extNode: {
-        m_children[0]->hash();
-        xtrie_node_face_ptr_t valuenode;
-        if (m_children[0]->m_val.size() < 32) {
-            valuenode = std::make_shared<xtrie_raw_node_t>(m_children[0]->m_val);
-        } else {
-            valuenode = std::make_shared<xtrie_hash_node_t>(m_children[0]->m_val);
-        }
-        auto key = hexToCompact(m_key);
-        xbytes_t encoded;
-        append(encoded, key);
-        append(encoded, xtrie_node_rlp::EncodeToBytes(valuenode));
-        hash_buffer = RLP::encodeList(encoded);
-        m_children[0] = nullptr;
+        RLP::encodeTo(hash_buffer, hexToCompact(m_key));
+        append_child_ref(hash_buffer, m_children[0]->m_val);
+        RLP::encodeListTo(hash_buffer, 0);
+        m_children[0] = nullptr;  // Reclaim mem from subtree
         xdbg("xtop_stack_trie hash extNode buffer: %s", top::to_hex(hash_buffer).c_str());
+        break;
     }
     case xstack_trie_node_type_t::leafNode: {
         m_key.insert(m_key.end(), xbyte_t(16));
-        auto sz = hexToCompactInPlace(m_key);
-        auto key = xbytes_t{m_key.begin(), m_key.begin() + sz};
-        xbytes_t encoded;
-        append(encoded, key);
-        append(encoded, m_val);
-        hash_buffer = RLP::encodeList(encoded);
+        m_key.resize(hexToCompactInPlace(m_key));
+        RLP::encodeTo(hash_buffer, m_key);
+        RLP::encodeTo(hash_buffer, m_val);
+        RLP::encodeListTo(hash_buffer, 0);
         xdbg("xtop_stack_trie hash leafNode buffer: %s", top::to_hex(hash_buffer).c_str());
-    }
-    case xstack_trie_node_type_t::emptyNode: {
-        m_val = xbytes_t{empty_root_bytes.begin(), empty_root_bytes.end()};
-        m_key = xbytes_t{m_key.begin(), m_key.begin()};
-        m_type = xstack_trie_node_type_t::hashedNode;
-        return;
+        break;
     }
     default: {
         xassert(false);
     }
     }
-    m_key = xbytes_t{m_key.begin(), m_key.begin()};
+    m_key.clear();
     m_type = xstack_trie_node_type_t::hashedNode;
     if (hash_buffer.size() < 32) {
-        m_val = hash_buffer;
+        m_val.assign(hash_buffer.begin(), hash_buffer.end());
         return;
     }
     // Write the hash to the 'val'.
+    m_val.clear();
     utl::xkeccak256_t hasher;
     hasher.update(hash_buffer.data(), hash_buffer.size());
     hasher.get_hash(m_val);
 
     if (m_db != nullptr) {
-        std::error_code ec;
-        m_db->Put(m_key, hash_buffer, ec);
-        assert(!ec);
+        WriteTrieNode(m_db, xhash256_t{m_val}, hash_buffer);
     }
 }
 
@@ -281,10 +288,11 @@ xhash256_t xtop_stack_trie::Hash() {
 }
 
 xhash256_t xtop_stack_trie::Commit(std::error_code & ec) {
-    if (m_db = nullptr) {
+    if (m_db == nullptr) {
         ec = error::xerrc_t::trie_db_not_provided;
         return xhash256_t{};
     }
+    hash();
     if (m_val.size() != 32) {
         // If the node's RLP isn't 32 bytes long, the node will not
         // be hashed, and instead contain the  rlp-encoding of the
@@ -293,12 +301,19 @@ xhash256_t xtop_stack_trie::Commit(std::error_code & ec) {
         utl::xkeccak256_t hasher;
         hasher.update(m_val.data(), m_val.size());
         hasher.get_hash(res);
-        m_db->Put(res, m_val, ec);
+        WriteTrieNode(m_db, xhash256_t{res}, m_val);
         return xhash256_t{res};
     }
     return xhash256_t{m_val};
 }
 
+void xtop_stack_trie::Reset() {
+    m_type = xstack_trie_node_type_t::emptyNode;
+    m_key.clear();
+    m_val.clear();
+    m_children.fill(nullptr);
+}
+
 std::shared_ptr<xtop_stack_trie> xtop_stack_trie::newLeaf(xbytes_t const & key, xbytes_t const & val) {
     std::shared_ptr<xtop_stack_trie> newnode = std::make_shared<xtop_stack_trie>(m_db);
     newnode->m_type = xstack_trie_node_type_t::leafNode;
@@ -9,15 +9,46 @@
 #include "xevm_common/trie/xtrie_encoding.h"
 #include "xevm_common/trie/xtrie_hasher.h"
 #include "xevm_common/trie/xtrie_node_coding.h"
+#include "xevm_common/trie/xtrie_node_diff.h"
 #include "xevm_common/trie/xtrie_pruner.h"
 #include "xevm_common/xerror/xerror.h"
 
+#include <algorithm>
 #include <cstddef>
 
 NS_BEG3(top, evm_common, trie)
 
 xhash256_t const empty_root{empty_root_bytes};
 
+// put collected proof nodes into proof_db, skipping the first from_level of them. nodes[0] is the root node.
+static void put_proof_nodes(std::vector<xtrie_node_face_ptr_t> const & nodes, uint32_t from_level, xkv_db_face_ptr_t const & proof_db, std::error_code & ec) {
+    auto hasher = xtrie_hasher_t::newHasher(false);
+    xdbg("nodes.size():%zu", nodes.size());
+    for (std::size_t index = 0; index < nodes.size(); ++index) {
+        if (from_level > 0) {
+            from_level--;
+            continue;
+        }
+        auto n = nodes[index];
+        xtrie_node_face_ptr_t hn;
+        std::tie(n, hn) = hasher.proofHash(n);
+        if (hn->type() == xtrie_node_type_t::hashnode || index == 0) {
+            // If the node's database encoding is a hash (or is the
+            // root node), it becomes a proof element.
+            auto enc = xtrie_node_rlp::EncodeToBytes(n);
+            xtrie_hash_node_ptr_t hash;
+            if (hn->type() != xtrie_node_type_t::hashnode) {
+                hash = hasher.hashData(enc);
+            } else {
+                hash = std::dynamic_pointer_cast<xtrie_hash_node_t>(hn);
+                assert(hash != nullptr);
+            }
+            xdbg("[Prove]: put into db <%s> %s", top::to_hex(hash->data()).c_str(), top::to_hex(enc).c_str());
+            proof_db->Put(hash->data(), enc, ec);
+        }
+    }
+}
+
 xtop_trie::~xtop_trie() = default;
 
 xtop_trie::xtop_trie(xtrie_db_ptr_t db) : trie_db_{std::move(db)} {
@@ -33,6 +64,7 @@ std::shared_ptr<xtop_trie> xtop_trie::build_from(xhash256_t hash, xtrie_db_ptr_t
         xerror("build trie from null db");
     }
     auto trie = std::shared_ptr<xtop_trie>(new xtop_trie{std::move(db)});
+    trie->origin_ = hash == xhash256_t{} ? empty_root : hash;
     if ((hash != empty_root) && (hash != xhash256_t{})) {
         // resolve Hash
         auto const root_hash = std::make_shared<xtrie_hash_node_t>(hash);
@@ -46,10 +78,22 @@ std::shared_ptr<xtop_trie> xtop_trie::build_from(xhash256_t hash, xtrie_db_ptr_t
     return trie;
 }
 
+std::shared_ptr<xtop_trie> xtop_trie::build_from_root_node(xtrie_node_face_ptr_t root, xtrie_db_ptr_t db) {
+    if (db == nullptr) {
+        xerror("build trie from null db");
+    }
+    auto trie = std::shared_ptr<xtop_trie>(new xtop_trie{std::move(db)});
+    trie->trie_root_ = std::move(root);
+    trie->origin_ = empty_root;
+    return trie;
+}
+
 // Reset drops the referenced root node and cleans all internal state.
 void xtop_trie::reset() {
     trie_root_ = nullptr;
     unhashed_ = 0;
+    uncommitted_ = 0;
+    obsolete_.clear();
 }
 
 // Hash returns the root hash of the trie. It does not write to the
@@ -141,6 +185,7 @@ void xtop_trie::update(xbytes_t const & key, xbytes_t const & value) {
 void xtop_trie::try_update(xbytes_t const & key, xbytes_t const & value, std::error_code & ec) {
     xassert(!ec);
     unhashed_++;
+    uncommitted_++;
     auto const k = keybytesToHex(key);
     if (!value.empty()) {
         auto result = insert(trie_root_, {}, k, std::make_shared<xtrie_value_node_t>(value), ec);
@@ -179,6 +224,7 @@ void xtop_trie::Delete(xbytes_t const & key) {
 void xtop_trie::try_delete(xbytes_t const & key, std::error_code & ec) {
     xassert(!ec); 
     unhashed_++;
+    uncommitted_++;
     auto const k = keybytesToHex(key);
     auto result = erase(trie_root_, {}, k, ec);
     if (ec) {
@@ -199,15 +245,21 @@ std::pair<xhash256_t, int32_t> xtop_trie::commit(std::error_code & ec) {
         xerror("commit called on trie without database");
     }
     if (trie_root_ == nullptr) {
+        obsolete_.clear();
+        origin_ = empty_root;
         return std::make_pair(empty_root, 0);
     }
 
     auto root_hash = hash();
     if (!trie_root_->cache().dirty()) {
+        obsolete_.clear();
+        origin_ = root_hash;
         return std::make_pair(root_hash, 0);
     }
 
-    xtrie_committer_t h;
+    // each updated key dirties about one node per level
+    xtrie_committer_t h{uncommitted_ >= 100u, uncommitted_ * 4};
+    uncommitted_ = 0;
 
     xtrie_hash_node_ptr_t new_root;
     int32_t committed;
@@ -220,6 +272,24 @@ std::pair<xhash256_t, int32_t> xtop_trie::commit(std::error_code & ec) {
         trie_root_ = new_root;
     }
 
+    if (trie_db_->node_diff_enabled() && root_hash != origin_) {
+        xtrie_node_diff_t diff;
+        diff.parent = origin_;
+        for (auto const & node : h.committed_nodes()) {
+            // a node written again with the same content is not replaced at all.
+            if (obsolete_.erase(node.hash) == 0) {
+                diff.inserted.emplace(node.hash, node.path);
+            }
+        }
+        diff.obsolete = std::move(obsolete_);
+
+        // missing node diff only makes pruning of this root fall back to the full walk.
+        std::error_code diff_ec;
+        WriteNodeDiff(trie_db_->DiskDB(), root_hash, diff, diff_ec);
+    }
+    obsolete_.clear();
+    origin_ = root_hash;
+
     return std::make_pair(root_hash, committed);
 }
 
@@ -271,33 +341,194 @@ bool xtop_trie::prove(xbytes_t const & key, uint32_t from_level, xkv_db_face_ptr
         }
     }
 
-    auto hasher = xtrie_hasher_t::newHasher(false);
-    xdbg("nodes.size():%zu", nodes.size());
-    for (std::size_t index = 0; index < nodes.size(); ++index) {
-        if (from_level > 0) {
-            from_level--;
-            continue;
+    put_proof_nodes(nodes, from_level, proof_db, ec);
+    return true;
+}
+
+bool xtop_trie::prove_multi(std::vector<xbytes_t> const & keys, xkv_db_face_ptr_t const & proof_db, std::error_code & ec) const {
+    xassert(!ec);
+    std::vector<xbytes_t> key_paths;
+    key_paths.reserve(keys.size());
+    for (auto const & key : keys) {
+        key_paths.push_back(keybytesToHex(key));
+    }
+    std::sort(key_paths.begin(), key_paths.end());
+    key_paths.erase(std::unique(key_paths.begin(), key_paths.end()), key_paths.end());
+
+    std::vector<xtrie_node_face_ptr_t> nodes;
+    collect_proof_nodes(trie_root_, key_paths, nodes, ec);
+    if (ec) {
+        return false;
+    }
+
+    put_proof_nodes(nodes, 0, proof_db, ec);
+    return true;
+}
+
+void xtop_trie::collect_proof_nodes(xtrie_node_face_ptr_t const & node,
+                                    std::vector<xbytes_t> const & key_paths,
+                                    std::vector<xtrie_node_face_ptr_t> & nodes,
+                                    std::error_code & ec) const {
+    if (node == nullptr || key_paths.empty()) {
+        return;
+    }
+    switch (node->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+    case xtrie_node_type_t::shortnode: {
+        auto n = std::dynamic_pointer_cast<xtrie_short_node_t>(node);
+        assert(n != nullptr);
+        nodes.push_back(n);
+
+        // keys not matching the short node end here, it proves their absence.
+        std::vector<xbytes_t> rests;
+        for (auto const & key_path : key_paths) {
+            if (key_path.size() > n->key.size() && std::equal(n->key.begin(), n->key.end(), key_path.begin())) {
+                rests.emplace_back(std::next(key_path.begin(), static_cast<std::ptrdiff_t>(n->key.size())), key_path.end());
+            }
         }
-        auto n = nodes[index];
-        xtrie_node_face_ptr_t hn;
-        std::tie(n, hn) = hasher.proofHash(n);
-        if (hn->type() == xtrie_node_type_t::hashnode || index == 0) {
-            // If the node's database encoding is a hash (or is the
-            // root node), it becomes a proof element.
-            auto enc = xtrie_node_rlp::EncodeToBytes(n);
-            xtrie_hash_node_ptr_t hash;
-            if (hn->type() != xtrie_node_type_t::hashnode) {
-                hash = hasher.hashData(enc);
+        collect_proof_nodes(n->val, rests, nodes, ec);
+        break;
+    }
+    case xtrie_node_type_t::fullnode: {
+        auto n = std::dynamic_pointer_cast<xtrie_full_node_t>(node);
+        assert(n != nullptr);
+        nodes.push_back(n);
+
+        for (std::size_t begin = 0; begin < key_paths.size() && !ec;) {
+            auto const nibble = key_paths[begin][0];
+            std::vector<xbytes_t> rests;
+            std::size_t end = begin;
+            for (; end < key_paths.size() && key_paths[end][0] == nibble; ++end) {
+                if (key_paths[end].size() > 1) {
+                    rests.emplace_back(std::next(key_paths[end].begin()), key_paths[end].end());
+                }
+            }
+            collect_proof_nodes(n->Children[nibble], rests, nodes, ec);
+            begin = end;
+        }
+        break;
+    }
+    case xtrie_node_type_t::hashnode: {
+        auto n = std::dynamic_pointer_cast<xtrie_hash_node_t>(node);
+        assert(n != nullptr);
+        auto const resolved = resolve_hash(n, ec);
+        if (ec) {
+            xerror("unhandled trie error %s", ec.message().c_str());
+            return;
+        }
+        collect_proof_nodes(resolved, key_paths, nodes, ec);
+        break;
+    }
+    case xtrie_node_type_t::valuenode: {
+        break;
+    }
+    default: {
+        xassert(false);  // NOLINT(clang-diagnostic-disabled-macro-expansion)
+    }
+    }
+}
+
+void xtop_trie::range(xbytes_t const & origin,
+                      std::size_t max_count,
+                      std::size_t max_bytes,
+                      std::vector<xbytes_t> & keys,
+                      std::vector<xbytes_t> & values,
+                      std::error_code & ec) const {
+    xassert(!ec);
+    if (max_count == 0) {
+        return;
+    }
+    auto origin_path = keybytesToHex(origin);
+    origin_path.pop_back();  // terminator
+    xbytes_t path;
+    range_result result{max_count, max_bytes, 0, keys, values};
+    range(trie_root_, path, origin_path, !origin_path.empty(), result, ec);
+}
+
+bool xtop_trie::range(xtrie_node_face_ptr_t const & node, xbytes_t & path, xbytes_t const & origin, bool bounded, range_result & result, std::error_code & ec) const {
+    if (node == nullptr) {
+        return true;
+    }
+    switch (node->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+    case xtrie_node_type_t::hashnode: {
+        auto const resolved = resolve_hash(std::dynamic_pointer_cast<xtrie_hash_node_t>(node), ec);
+        if (ec) {
+            return false;
+        }
+        return range(resolved, path, origin, bounded, result, ec);
+    }
+    case xtrie_node_type_t::shortnode: {
+        auto const n = std::dynamic_pointer_cast<xtrie_short_node_t>(node);
+        assert(n != nullptr);
+
+        auto child_bounded = bounded;
+        if (bounded) {
+            auto const key_size = hasTerm(n->key) ? n->key.size() - 1 : n->key.size();
+            auto const rest = origin.size() - path.size();
+            auto const m = std::min(key_size, rest);
+            auto const origin_it = std::next(origin.begin(), static_cast<std::ptrdiff_t>(path.size()));
+            auto const key_end = std::next(n->key.begin(), static_cast<std::ptrdiff_t>(m));
+            auto const mismatch = std::mismatch(n->key.begin(), key_end, origin_it);
+            if (mismatch.first != key_end) {
+                if (*mismatch.first < *mismatch.second) {
+                    // the whole subtree is before origin.
+                    return true;
+                }
+                child_bounded = false;
             } else {
-                hash = std::dynamic_pointer_cast<xtrie_hash_node_t>(hn);
-                assert(hash != nullptr);
+                // all keys under a key covering the rest of origin are not less than origin.
+                child_bounded = key_size < rest;
             }
-            xdbg("[Prove]: put into db <%s> %s", top::to_hex(hash->data()).c_str(), top::to_hex(enc).c_str());
-            proof_db->Put(hash->data(), enc, ec);
         }
+        path.insert(path.end(), n->key.begin(), n->key.end());
+        auto const more = range(n->val, path, origin, child_bounded, result, ec);
+        path.resize(path.size() - n->key.size());
+        return more;
     }
+    case xtrie_node_type_t::fullnode: {
+        auto const n = std::dynamic_pointer_cast<xtrie_full_node_t>(node);
+        assert(n != nullptr);
 
-    return true;
+        // value of the full node itself has the shortest key, it goes first.
+        for (std::size_t i = 16, visited = 0; visited < 17; i = (i + 1) % 17, ++visited) {
+            if (n->Children[i] == nullptr) {
+                continue;
+            }
+            auto child_bounded = false;
+            if (bounded) {
+                if (i == 16 || i < origin[path.size()]) {
+                    continue;
+                }
+                child_bounded = (i == origin[path.size()]) && (path.size() + 1 < origin.size());
+            }
+            path.push_back(static_cast<xbyte_t>(i));
+            auto const more = range(n->Children[i], path, origin, child_bounded, result, ec);
+            path.pop_back();
+            if (!more) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case xtrie_node_type_t::valuenode: {
+        // a bounded value has a key which is a strict prefix of origin.
+        if (bounded) {
+            return true;
+        }
+        auto const n = std::dynamic_pointer_cast<xtrie_value_node_t>(node);
+        assert(n != nullptr);
+
+        auto key = hexToKeybytes(path);
+        result.bytes += key.size() + n->data().size();
+        result.keys.push_back(std::move(key));
+        result.values.push_back(n->data());
+        return result.keys.size() < result.max_count && result.bytes < result.max_bytes;
+    }
+    default: {
+        xwarn("xtop_trie::range unexpected node type %d", static_cast<int>(node->type()));
+        ec = error::xerrc_t::trie_node_unexpected;
+        return false;
+    }
+    }
 }
 
 std::tuple<xbytes_t, xtrie_node_face_ptr_t, bool> xtop_trie::try_get(xtrie_node_face_ptr_t const & node, xbytes_t const & key, std::size_t const pos, std::error_code & ec) const {
@@ -492,6 +723,7 @@ xtop_trie::update_result xtop_trie::insert(xtrie_node_face_ptr_t const & node, x
             if (!result.dirty || ec) {
                 return {false, short_node};
             }
+            supersede(short_node, {prefix.begin(), std::prev(prefix.end(), static_cast<std::ptrdiff_t>(matchlen))});
             return {true, std::make_shared<xtrie_short_node_t>(short_node->key, std::move(result.new_node), node_dirty())};
         }
 
@@ -522,6 +754,7 @@ xtop_trie::update_result xtop_trie::insert(xtrie_node_face_ptr_t const & node, x
                 return {false, nullptr};
             }
         }
+        supersede(short_node, prefix);
         // Replace this shortNode with the branch if it occurs at index 0.
         if (matchlen == 0) {
             return {true, branch};
@@ -542,6 +775,7 @@ xtop_trie::update_result xtop_trie::insert(xtrie_node_face_ptr_t const & node, x
             return {false, full_node};
         }
 
+        supersede(full_node, {prefix.begin(), std::prev(prefix.end())});
         full_node = full_node->clone();
         full_node->flags = node_dirty();
         full_node->Children[tkey] = std::move(result.new_node);
@@ -591,6 +825,7 @@ xtop_trie::update_result xtop_trie::erase(xtrie_node_face_ptr_t const & node, xb
             return {false, short_node};  // don't replace n on mismatch
         }
         if (matchlen == key.size()) {
+            supersede(short_node, prefix);
             return {true, nullptr};  // remove n entirely for whole matches
         }
         // The key is longer than n.Key. Remove the remaining suffix
@@ -605,6 +840,7 @@ xtop_trie::update_result xtop_trie::erase(xtrie_node_face_ptr_t const & node, xb
         if (!result.dirty || ec) {
             return {false, short_node};
         }
+        supersede(short_node, prefix);
 
         switch (result.new_node->type()) {  // NOLINT(clang-diagnostic-switch-enum)
         case xtrie_node_type_t::shortnode: {
@@ -641,6 +877,7 @@ xtop_trie::update_result xtop_trie::erase(xtrie_node_face_ptr_t const & node, xb
             return {false, full_node};
         }
 
+        supersede(full_node, prefix);
         full_node = full_node->clone();
         full_node->flags = node_dirty();
         full_node->Children[tkey] = result.new_node;
@@ -684,6 +921,11 @@ xtop_trie::update_result xtop_trie::erase(xtrie_node_face_ptr_t const & node, xb
                     return {false, nullptr};
                 }
                 if (cnode->type() == xtrie_node_type_t::shortnode) {
+                    // the child is merged into a new short node.
+                    auto child_path = prefix;
+                    child_path.push_back(static_cast<xbyte_t>(pos));
+                    supersede(cnode, child_path);
+
                     auto const short_child_node = std::dynamic_pointer_cast<xtrie_short_node_t>(cnode);
                     xbytes_t k = short_child_node->key;
                     k.insert(k.begin(), xbyte_t{static_cast<xbyte_t>(pos)});
@@ -761,6 +1003,18 @@ xbytes_t xtop_trie::resolve_blob(std::shared_ptr<xtrie_hash_node_t> const & n, s
     return trie_db_->Node(hash, ec);
 }
 
+void xtop_trie::supersede(xtrie_node_face_ptr_t const & node, xbytes_t const & path) {
+    if (!trie_db_->node_diff_enabled()) {
+        return;
+    }
+    // dirty nodes may be hashed already, but only clean ones are stored.
+    auto const cached = node->cache();
+    if (cached.hash_node() == nullptr || cached.dirty()) {
+        return;
+    }
+    obsolete_.emplace(xhash256_t{cached.hash_node()->data()}, path);
+}
+
 // hashRoot calculates the root hash of the given trie
 std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> xtop_trie::hash_root() {
     if (trie_root_ == nullptr) {
@@ -782,8 +1036,7 @@ void xtop_trie::prune(xhash256_t const & old_trie_root_hash, std::error_code & e
     assert(!ec);
 
     if (pruner_ == nullptr) {
-        pruner_ = make_unique<xtrie_pruner_t>();
-        pruner_->init(trie_root_, trie_db_, ec);
+        pruner_ = make_unique<xtrie_pruner_t>(trie_root_, hash());
     }
 
     pruner_->prune(old_trie_root_hash, trie_db_, ec);
@@ -793,7 +1046,7 @@ void xtop_trie::commit_pruned(std::error_code & ec) {
     assert(!ec);
     assert(pruner_);
 
-    trie_db_->commit_pruned(ec);
+    pruner_->commit(trie_db_, ec);
     if (ec) {
         xwarn("commit prune failed");
         return;
@@ -0,0 +1,213 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xevm_common/trie/xtrie_clean_cache.h"
+
+#include "xbase/xlog.h"
+#include "xbasic/xmemory.hpp"
+#include "xmetrics/xmetrics.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+NS_BEG3(top, evm_common, trie)
+
+constexpr std::size_t EntryOverhead = 64;  // list node + index slot + key copy, roughly
+constexpr char JournalMagic[] = "top-trie-clean-v1";
+constexpr std::size_t JournalMagicSize = sizeof(JournalMagic) - 1;
+
+xtop_trie_clean_cache::xtop_trie_clean_cache(std::size_t const capacity_bytes, std::size_t const shard_count)
+  : shard_capacity_{capacity_bytes / (shard_count == 0 ? 1 : shard_count)} {
+    shards_.reserve(shard_count == 0 ? 1 : shard_count);
+    for (std::size_t i = 0; i < shards_.capacity(); ++i) {
+        shards_.push_back(top::make_unique<xshard_t>());
+    }
+}
+
+bool xtop_trie_clean_cache::get(xhash256_t const & hash, xbytes_t & enc) {
+    auto & shard = shard_of(hash);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    auto const it = shard.index.find(hash);
+    if (it == std::end(shard.index)) {
+        return false;
+    }
+    shard.items.splice(std::begin(shard.items), shard.items, it->second);
+    enc = it->second->second;
+    return true;
+}
+
+bool xtop_trie_clean_cache::contains(xhash256_t const & hash) const {
+    auto & shard = shard_of(hash);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    return shard.index.find(hash) != std::end(shard.index);
+}
+
+void xtop_trie_clean_cache::put(xhash256_t const & hash, xbytes_t const & enc) {
+    auto const bytes = entry_bytes(enc);
+    if (bytes > shard_capacity_) {
+        return;
+    }
+
+    auto & shard = shard_of(hash);
+    int64_t delta{0};
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto const it = shard.index.find(hash);
+        if (it != std::end(shard.index)) {
+            // same hash means same content, only refresh recency.
+            shard.items.splice(std::begin(shard.items), shard.items, it->second);
+            return;
+        }
+
+        shard.items.emplace_front(hash, enc);
+        shard.index.emplace(hash, std::begin(shard.items));
+        shard.bytes += bytes;
+        delta += static_cast<int64_t>(bytes);
+
+        while (shard.bytes > shard_capacity_) {
+            auto const & victim = shard.items.back();
+            auto const victim_bytes = entry_bytes(victim.second);
+            shard.index.erase(victim.first);
+            shard.items.pop_back();
+            shard.bytes -= victim_bytes;
+            delta -= static_cast<int64_t>(victim_bytes);
+        }
+    }
+    XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_bytes, delta);
+}
+
+void xtop_trie_clean_cache::erase(xhash256_t const & hash) {
+    auto & shard = shard_of(hash);
+    std::size_t bytes{0};
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto const it = shard.index.find(hash);
+        if (it == std::end(shard.index)) {
+            return;
+        }
+        bytes = entry_bytes(it->second->second);
+        shard.items.erase(it->second);
+        shard.index.erase(it);
+        shard.bytes -= bytes;
+    }
+    XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_bytes, -static_cast<int64_t>(bytes));
+}
+
+std::size_t xtop_trie_clean_cache::size() const {
+    std::size_t result{0};
+    for (auto const & shard : shards_) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        result += shard->index.size();
+    }
+    return result;
+}
+
+std::size_t xtop_trie_clean_cache::size_bytes() const {
+    std::size_t result{0};
+    for (auto const & shard : shards_) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        result += shard->bytes;
+    }
+    return result;
+}
+
+std::size_t xtop_trie_clean_cache::capacity_bytes() const noexcept {
+    return shard_capacity_ * shards_.size();
+}
+
+void xtop_trie_clean_cache::save_journal(std::string const & path, std::error_code & ec) const {
+    assert(!ec);
+
+    // write to a temp file then rename, so a crash in the middle never leaves a broken journal.
+    std::string const tmp_path = path + ".tmp";
+    std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        ec = std::make_error_code(std::errc::io_error);
+        xwarn("xtop_trie_clean_cache::save_journal open %s failed", tmp_path.c_str());
+        return;
+    }
+
+    out.write(JournalMagic, JournalMagicSize);
+    std::size_t count{0};
+    for (auto const & shard : shards_) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        for (auto it = shard->items.rbegin(); it != shard->items.rend(); ++it) {
+            uint32_t const size = static_cast<uint32_t>(it->second.size());
+            xbyte_t const size_bytes[4] = {static_cast<xbyte_t>(size), static_cast<xbyte_t>(size >> 8), static_cast<xbyte_t>(size >> 16), static_cast<xbyte_t>(size >> 24)};
+            out.write(reinterpret_cast<char const *>(it->first.data()), it->first.size());
+            out.write(reinterpret_cast<char const *>(size_bytes), sizeof(size_bytes));
+            out.write(reinterpret_cast<char const *>(it->second.data()), it->second.size());
+            ++count;
+        }
+    }
+    out.close();
+    if (!out || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ec = std::make_error_code(std::errc::io_error);
+        xwarn("xtop_trie_clean_cache::save_journal write %s failed", path.c_str());
+        std::remove(tmp_path.c_str());
+        return;
+    }
+    xkinfo("xtop_trie_clean_cache::save_journal %zu nodes saved to %s", count, path.c_str());
+}
+
+void xtop_trie_clean_cache::load_journal(std::string const & path, std::error_code & ec) {
+    assert(!ec);
+
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        // no journal yet, e.g. first start.
+        return;
+    }
+
+    char magic[JournalMagicSize];
+    if (!in.read(magic, JournalMagicSize) || std::string(magic, JournalMagicSize) != std::string(JournalMagic, JournalMagicSize)) {
+        ec = std::make_error_code(std::errc::illegal_byte_sequence);
+        xwarn("xtop_trie_clean_cache::load_journal %s is not a clean cache journal", path.c_str());
+        return;
+    }
+
+    std::size_t count{0};
+    for (;;) {
+        xhash256_t hash;
+        xbyte_t size_bytes[4];
+        if (!in.read(reinterpret_cast<char *>(hash.data()), hash.size())) {
+            break;
+        }
+        if (!in.read(reinterpret_cast<char *>(size_bytes), sizeof(size_bytes))) {
+            ec = std::make_error_code(std::errc::illegal_byte_sequence);
+            break;
+        }
+        uint32_t const size = static_cast<uint32_t>(size_bytes[0]) | (static_cast<uint32_t>(size_bytes[1]) << 8) | (static_cast<uint32_t>(size_bytes[2]) << 16) |
+                              (static_cast<uint32_t>(size_bytes[3]) << 24);
+        if (size > shard_capacity_) {
+            ec = std::make_error_code(std::errc::illegal_byte_sequence);
+            break;
+        }
+        xbytes_t enc(size);
+        if (size > 0 && !in.read(reinterpret_cast<char *>(enc.data()), size)) {
+            ec = std::make_error_code(std::errc::illegal_byte_sequence);
+            break;
+        }
+        put(hash, enc);
+        ++count;
+    }
+    if (ec) {
+        // entries before the truncated tail are still valid nodes, keep them.
+        xwarn("xtop_trie_clean_cache::load_journal %s truncated after %zu nodes", path.c_str(), count);
+        return;
+    }
+    xkinfo("xtop_trie_clean_cache::load_journal %zu nodes loaded from %s", count, path.c_str());
+}
+
+xtop_trie_clean_cache::xshard_t & xtop_trie_clean_cache::shard_of(xhash256_t const & hash) const {
+    // node hash is keccak output, any byte of it is uniformly distributed.
+    return *shards_[hash.data()[0] % shards_.size()];
+}
+
+std::size_t xtop_trie_clean_cache::entry_bytes(xbytes_t const & enc) noexcept {
+    return enc.size() + sizeof(xhash256_t) + EntryOverhead;
+}
+
+NS_END3
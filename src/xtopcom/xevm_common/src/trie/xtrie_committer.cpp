@@ -7,10 +7,17 @@
 #include "xevm_common/trie/xtrie_encoding.h"
 #include "xevm_common/xerror/xerror.h"
 
+#include <algorithm>
 #include <cassert>
+#include <future>
+#include <thread>
 
 NS_BEG3(top, evm_common, trie)
 
+xtop_trie_committer::xtop_trie_committer(bool const parallel, std::size_t const expected_nodes) : m_parallel{parallel} {
+    m_nodes.reserve(expected_nodes);
+}
+
 std::pair<xtrie_hash_node_ptr_t, int32_t> xtop_trie_committer::Commit(xtrie_node_face_ptr_t const & n, xtrie_db_ptr_t db, std::error_code & ec) {
     if (db == nullptr) {
         ec = error::xerrc_t::trie_db_not_provided;
@@ -19,18 +26,25 @@ std::pair<xtrie_hash_node_ptr_t, int32_t> xtop_trie_committer::Commit(xtrie_node
 
     xtrie_node_face_ptr_t h;
     int32_t committed;
-    std::tie(h, committed) = commit(n, db, ec);
+    std::tie(h, committed) = commit(n, {}, ec);
     if (ec) {
+        m_nodes.clear();
         return std::make_pair(nullptr, 0);
     }
     xassert(h->type() == xtrie_node_type_t::hashnode);
     auto hashnode = std::dynamic_pointer_cast<xtrie_hash_node_t>(h);
     assert(hashnode != nullptr);
 
+    db->insert_batch(m_nodes);
+
     return std::make_pair(hashnode, committed);
 }
 
-std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node_face_ptr_t const & n, xtrie_db_ptr_t db, std::error_code & ec) {
+std::vector<xtrie_committed_node_t> const & xtop_trie_committer::committed_nodes() const noexcept {
+    return m_nodes;
+}
+
+std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node_face_ptr_t const & n, xbytes_t const & path, std::error_code & ec) {
     // if this path is clean, use available cached data
     auto const cached_data = n->cache();
     if (cached_data.hash_node() != nullptr && !cached_data.dirty()) {
@@ -50,9 +64,12 @@ std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node
         // otherwise it can only be hashNode or valueNode.
         int32_t childCommitted{0};
         if (cn->val->type() == xtrie_node_type_t::fullnode) {
+            auto child_path = path;
+            child_path.insert(child_path.end(), cn->key.begin(), cn->key.end());
+
             xtrie_node_face_ptr_t childV;
             int32_t committed;
-            std::tie(childV, committed) = commit(cn->val, db, ec);
+            std::tie(childV, committed) = commit(cn->val, child_path, ec);
             if (ec) {
                 return std::make_pair(nullptr, 0);
             }
@@ -61,7 +78,7 @@ std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node
         }
         // The key needs to be copied, since we're delivering it to database
         collapsed->key = hexToCompact(cn->key);
-        auto const hashed_node = store(collapsed, db);
+        auto const hashed_node = store(collapsed, path);
         assert(hashed_node != nullptr);
         if (hashed_node->type() == xtrie_node_type_t::hashnode) {
             auto hn = std::dynamic_pointer_cast<xtrie_hash_node_t>(hashed_node);
@@ -79,7 +96,7 @@ std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node
 
         std::array<xtrie_node_face_ptr_t, 17> hashedKids;
         int32_t childCommitted{0};
-        std::tie(hashedKids, childCommitted) = commitChildren(cn, db, ec);
+        std::tie(hashedKids, childCommitted) = commitChildren(cn, path, ec);
         if (ec) {
             return std::make_pair(nullptr, 0);
         }
@@ -87,7 +104,7 @@ std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node
         auto collapsed = cn->clone();
         collapsed->Children = hashedKids;
 
-        auto const hashed_node = store(collapsed, db);
+        auto const hashed_node = store(collapsed, path);
         assert(hashed_node != nullptr);
         if (hashed_node->type() == xtrie_node_type_t::hashnode) {
             auto hn = std::dynamic_pointer_cast<xtrie_hash_node_t>(hashed_node);
@@ -112,10 +129,15 @@ std::pair<xtrie_node_face_ptr_t, int32_t> xtop_trie_committer::commit(xtrie_node
     __builtin_unreachable();
 }
 
-std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> xtop_trie_committer::commitChildren(xtrie_full_node_ptr_t n, xtrie_db_ptr_t db, std::error_code & ec) {
+std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> xtop_trie_committer::commitChildren(xtrie_full_node_ptr_t n, xbytes_t const & path, std::error_code & ec) {
     std::array<xtrie_node_face_ptr_t, 17> children;
     int32_t committed{0};
 
+    // only the first full node goes parallel, subtries below it are committed serially by workers.
+    bool const parallel = m_parallel;
+    m_parallel = false;
+    std::vector<std::size_t> parallel_indexes;
+
     for (std::size_t index = 0; index < 16; ++index) {
         auto child = n->Children[index];
         if (child == nullptr)
@@ -132,12 +154,20 @@ std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> xtop_trie_committer::c
             continue;
         }
 
+        if (parallel && child->cache().dirty()) {
+            parallel_indexes.push_back(index);
+            continue;
+        }
+
         // Commit the child recursively and store the "hashed" value.
         // Note the returned node can be some embedded nodes, so it's
         // possible the type is not hashNode.
+        auto child_path = path;
+        child_path.push_back(static_cast<xbyte_t>(index));
+
         xtrie_node_face_ptr_t hashed;
         int32_t childCommitted;
-        std::tie(hashed, childCommitted) = commit(child, db, ec);
+        std::tie(hashed, childCommitted) = commit(child, child_path, ec);
         if (ec) {
             return std::make_pair(children, 0);
         }
@@ -145,6 +175,13 @@ std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> xtop_trie_committer::c
         committed += childCommitted;
     }
 
+    if (!parallel_indexes.empty()) {
+        committed += commitChildrenParallel(n, path, parallel_indexes, children, ec);
+        if (ec) {
+            return std::make_pair(children, 0);
+        }
+    }
+
     // For the 17th child, it's possible the type is valuenode.
     if (n->Children[16] != nullptr) {
         children[16] = n->Children[16];
@@ -153,10 +190,59 @@ std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> xtop_trie_committer::c
     return std::make_pair(children, committed);
 }
 
-// store hashes the node n and if we have a storage layer specified, it writes
-// the key/value pair to it and tracks any node->child references as well as any
-// node->external trie references.
-xtrie_node_face_ptr_t xtop_trie_committer::store(xtrie_node_face_ptr_t n, xtrie_db_ptr_t db) {
+int32_t xtop_trie_committer::commitChildrenParallel(xtrie_full_node_ptr_t const & n,
+                                                    xbytes_t const & path,
+                                                    std::vector<std::size_t> const & indexes,
+                                                    std::array<xtrie_node_face_ptr_t, 17> & children,
+                                                    std::error_code & ec) {
+    std::size_t const hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const workers = std::min(indexes.size(), hardware_threads);
+
+    // subtries of different children never share nodes, and each child slot is written by one worker only.
+    std::vector<xtop_trie_committer> committers(workers);
+    std::vector<std::error_code> errors(workers);
+    std::vector<int32_t> committed(workers, 0);
+    auto const commit_children = [&](std::size_t const worker) {
+        auto & committer = committers[worker];
+        committer.m_nodes.reserve(m_nodes.capacity() / workers);
+        for (std::size_t i = worker; i < indexes.size() && !errors[worker]; i += workers) {
+            auto const index = indexes[i];
+            auto child_path = path;
+            child_path.push_back(static_cast<xbyte_t>(index));
+            auto result = committer.commit(n->Children[index], child_path, errors[worker]);
+            children[index] = std::move(result.first);
+            committed[worker] += result.second;
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+        futures.push_back(std::async(std::launch::async, commit_children, worker));
+    }
+    commit_children(0);
+    for (auto & future : futures) {
+        future.get();
+    }
+
+    int32_t total{0};
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+        if (errors[worker]) {
+            ec = errors[worker];
+            return 0;
+        }
+        m_nodes.insert(m_nodes.end(),
+                       std::make_move_iterator(committers[worker].m_nodes.begin()),
+                       std::make_move_iterator(committers[worker].m_nodes.end()));
+        total += committed[worker];
+    }
+    return total;
+}
+
+// store hashes the node n and if it is not embedded into its parent, collects
+// the node into the buffer. The buffer is inserted into database by Commit, which
+// tracks any node->child references as well as any node->external trie references.
+xtrie_node_face_ptr_t xtop_trie_committer::store(xtrie_node_face_ptr_t n, xbytes_t const & path) {
     auto hash = n->cache().hash_node();
     int32_t size{0};
 
@@ -173,11 +259,8 @@ xtrie_node_face_ptr_t xtop_trie_committer::store(xtrie_node_face_ptr_t n, xtrie_
 
     size = estimateSize(n);
 
-    if (false) {
-        // todo leafCh
-    } else {
-        db->insert(xhash256_t{hash->data()}, size, n);
-    }
+    // todo leafCh
+    m_nodes.push_back(xtrie_committed_node_t{xhash256_t{hash->data()}, size, n, path});
     return hash;
 }
 
@@ -5,34 +5,86 @@
 #include "xevm_common/trie/xtrie_db.h"
 
 #include "xbasic/xhex.h"
+#include "xbasic/xmemory_accounting.h"
 #include "xevm_common/trie/xtrie_encoding.h"
 #include "xevm_common/trie/xtrie_node.h"
 #include "xevm_common/trie/xtrie_node_coding.h"
 #include "xevm_common/xerror/xerror.h"
 #include "xmetrics/xmetrics.h"
 
+#include <atomic>
 #include <cassert>
 
 NS_BEG3(top, evm_common, trie)
 
 constexpr uint32_t IdealBatchSize = 1024;
 
+constexpr std::size_t DefaultCleanCacheSize = 4 * 1024 * 1024;
+
 constexpr auto PreimagePrefix = ConstBytes<11>("secure-key-");
 
+// map node and key of a dirty node besides its encoded size
+constexpr uint64_t DirtyNodeOverhead = 64 + sizeof(xhash256_t) + sizeof(xtrie_cache_node_t);
+
+// dirty nodes of all the trie dbs of the node
+static std::atomic<uint64_t> all_dirties_size{0};
+static std::atomic<uint64_t> all_dirties_count{0};
+
+static void add_dirties_reporter() {
+    static uint64_t const reporter = basic::xmemory_accounting_t::instance().add_reporter("trie_dirties", [] {
+        return basic::xmemory_usage_t{all_dirties_size.load(std::memory_order_relaxed), all_dirties_count.load(std::memory_order_relaxed)};
+    });
+    (void)reporter;
+}
+
 std::shared_ptr<xtop_trie_db> xtop_trie_db::NewDatabase(xkv_db_face_ptr_t diskdb) {
     return NewDatabaseWithConfig(std::move(diskdb), nullptr);
 }
 
-std::shared_ptr<xtop_trie_db> xtop_trie_db::NewDatabaseWithConfig(xkv_db_face_ptr_t diskdb, xtrie_db_config_ptr_t /*config*/) {
-    //if (config != nullptr && config->Cache_size > 0) {
-    //    if (config->Journal.empty()) {
-    //        // todo
-    //    } else {
-    //        // todo
-    //    }
-    //}
+std::shared_ptr<xtop_trie_db> xtop_trie_db::NewDatabaseWithConfig(xkv_db_face_ptr_t diskdb, xtrie_db_config_ptr_t config) {
+    if (config == nullptr) {
+        return std::make_shared<xtop_trie_db>(std::move(diskdb));
+    }
 
-    return std::make_shared<xtop_trie_db>(std::move(diskdb));
+    auto cleans = config->Clean_cache;
+    if (cleans == nullptr) {
+        auto const cache_size = config->Cache_size > 0 ? config->Cache_size * 1024 * 1024 : DefaultCleanCacheSize;
+        cleans = std::make_shared<xtrie_clean_cache_t>(cache_size);
+    }
+    if (!config->Journal.empty()) {
+        std::error_code ec;
+        cleans->load_journal(config->Journal, ec);
+        if (ec) {
+            xwarn("xtop_trie_db::NewDatabaseWithConfig load clean cache journal %s failed: %s", config->Journal.c_str(), ec.message().c_str());
+        }
+    }
+    return std::make_shared<xtop_trie_db>(std::move(diskdb), std::move(cleans), config->Journal, config->Node_diff);
+}
+
+xtop_trie_db::xtop_trie_db(xkv_db_face_ptr_t diskdb) : diskdb_{std::move(diskdb)}, cleans_{std::make_shared<xtrie_clean_cache_t>(DefaultCleanCacheSize)} {
+    add_dirties_reporter();
+}
+
+xtop_trie_db::xtop_trie_db(xkv_db_face_ptr_t diskdb, xtrie_clean_cache_ptr_t cleans, std::string journal, bool const node_diff)
+  : diskdb_{std::move(diskdb)}, cleans_{std::move(cleans)}, journal_{std::move(journal)}, node_diff_{node_diff} {
+    assert(cleans_ != nullptr);
+    add_dirties_reporter();
+}
+
+xtop_trie_db::~xtop_trie_db() {
+    all_dirties_size -= dirties_size_;
+    all_dirties_count -= dirties_.size();
+    if (!journal_.empty()) {
+        std::error_code ec;
+        SaveCache(journal_, ec);
+    }
+}
+
+void xtop_trie_db::SaveCache(std::string const & path, std::error_code & ec) const {
+    cleans_->save_journal(path, ec);
+    if (ec) {
+        xwarn("xtop_trie_db::SaveCache to %s failed: %s", path.c_str(), ec.message().c_str());
+    }
 }
 
 void xtop_trie_db::insert(xhash256_t hash, int32_t const size, xtrie_node_face_ptr_t const & node) {
@@ -50,7 +102,10 @@ void xtop_trie_db::insert(xhash256_t hash, int32_t const size, xtrie_node_face_p
         }
     });
     xdbg("xtop_trie_db::insert %s size:%d", hash.as_hex_str().c_str(), size);
-    dirties_.insert({hash, entry});
+    dirties_.emplace(hash, std::move(entry));
+    dirties_size_ += DirtyNodeOverhead + static_cast<uint16_t>(size);
+    all_dirties_size += DirtyNodeOverhead + static_cast<uint16_t>(size);
+    ++all_dirties_count;
 
     if (oldest_ == xhash256_t{}) {
         oldest_ = hash;
@@ -58,8 +113,13 @@ void xtop_trie_db::insert(xhash256_t hash, int32_t const size, xtrie_node_face_p
         dirties_.at(newest_).flush_next_ = hash;
     }
     newest_ = hash;
+}
 
-    // todo dirties size;
+void xtop_trie_db::insert_batch(std::vector<xtrie_committed_node_t> const & nodes) {
+    dirties_.reserve(dirties_.size() + nodes.size());
+    for (auto const & committed : nodes) {
+        insert(committed.hash, committed.size, committed.node);
+    }
 }
 
 void xtop_trie_db::insertPreimage(xhash256_t hash, xbytes_t const & preimage) {
@@ -68,24 +128,24 @@ void xtop_trie_db::insertPreimage(xhash256_t hash, xbytes_t const & preimage) {
 }
 
 xtrie_node_face_ptr_t xtop_trie_db::node(xhash256_t hash) {
-    // todo:
-    if (cleans_.contains(hash)) {
-        // todo clean mark hit
-        return xtrie_node_rlp::mustDecodeNode(hash, cleans_.at(hash));
+    xbytes_t enc;
+    if (cleans_->get(hash, enc)) {
+        XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_hit, 1);
+        return xtrie_node_rlp::mustDecodeNode(hash, enc);
     }
     if (dirties_.find(hash) != dirties_.end()) {
         // todo dirty mark hit
         return dirties_.at(hash).obj(hash);
     }
-    // todo mark miss hit
+    XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_miss, 1);
 
     // retrieve from disk db
-    auto enc = ReadTrieNode(diskdb_, hash);
+    enc = ReadTrieNode(diskdb_, hash);
     if (enc.empty()) {
         return nullptr;
     }
     // put into clean cache
-    cleans_.insert({hash, enc});
+    cleans_->put(hash, enc);
     return xtrie_node_rlp::mustDecodeNode(hash, enc);
 }
 
@@ -97,26 +157,50 @@ xbytes_t xtop_trie_db::Node(xhash256_t hash, std::error_code & ec) {
     }
 
     // Retrieve the node from the clean cache if available
-    if (cleans_.contains(hash)) {
-        return cleans_.at(hash);
+    xbytes_t enc;
+    if (cleans_->get(hash, enc)) {
+        XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_hit, 1);
+        return enc;
     }
 
     // Retrieve the node from the dirty cache if available
     if (dirties_.find(hash) != dirties_.end()) {
         return dirties_.at(hash).rlp();
     }
+    XMETRICS_GAUGE(metrics::mpt_trie_clean_cache_miss, 1);
 
     // Content unavailable in memory, attempt to retrieve from disk
-    auto enc = ReadTrieNode(diskdb_, hash);
+    enc = ReadTrieNode(diskdb_, hash);
     if (enc.empty()) {
         ec = error::xerrc_t::trie_db_not_found;
         return xbytes_t{};
     }
     // put into clean cache
-    cleans_.insert({hash, enc});
+    cleans_->put(hash, enc);
     return enc;
 }
 
+void xtop_trie_db::prefetch(std::vector<xhash256_t> const & hashes) {
+    std::vector<xhash256_t> missing_hashes;
+    for (auto const & hash : hashes) {
+        if (hash.empty() || cleans_->contains(hash) || dirties_.find(hash) != dirties_.end()) {
+            continue;
+        }
+        missing_hashes.push_back(hash);
+    }
+    if (missing_hashes.size() < 2) {
+        // nothing to batch, leave it to node()/Node()
+        return;
+    }
+
+    auto const encs = ReadTrieNodeBatch(diskdb_, missing_hashes);
+    for (std::size_t i = 0; i < encs.size() && i < missing_hashes.size(); ++i) {
+        if (!encs[i].empty()) {
+            cleans_->put(missing_hashes[i], encs[i]);
+        }
+    }
+}
+
 xbytes_t xtop_trie_db::preimage(xhash256_t hash) const {
     if (preimages_.find(hash) != preimages_.end()) {
         return preimages_.at(hash);
@@ -196,10 +280,13 @@ void xtop_trie_db::commit(xhash256_t hash, std::map<xbytes_t, xbytes_t> & data,
     }
 
     // clean dirties:
+    dirties_size_ -= DirtyNodeOverhead + node.size_;
+    all_dirties_size -= DirtyNodeOverhead + node.size_;
+    --all_dirties_count;
     dirties_.erase(hash);
 
     // and move it to cleans:
-    cleans_.insert({hash, enc});
+    cleans_->put(hash, enc);
     // todo mark size everywhere with cleans/dirties' insert/erase/...
 }
 
@@ -208,7 +295,7 @@ void xtop_trie_db::prune(xhash256_t const & hash, std::error_code & ec) {
         return;
     }
 
-    cleans_.erase(hash);
+    cleans_->erase(hash);
 
     assert(dirties_.find(hash) == dirties_.end());
 
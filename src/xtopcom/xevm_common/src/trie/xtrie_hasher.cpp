@@ -8,7 +8,11 @@
 #include "xevm_common/trie/xtrie_encoding.h"
 #include "xutility/xhash.h"
 
+#include <algorithm>
 #include <cassert>
+#include <future>
+#include <thread>
+#include <vector>
 
 NS_BEG3(top, evm_common, trie)
 
@@ -63,13 +67,10 @@ std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> xtop_trie_hasher::hash(x
 
 xtrie_hash_node_ptr_t xtop_trie_hasher::hashData(xbytes_t const & input) const {
     xdbg("hashData:(%zu) %s ", input.size(), top::to_hex(input).c_str());
-    xbytes_t hashbuf;
-    utl::xkeccak256_t hasher;
-    // hasher.reset(); // make hasher class member , than need this.
-    hasher.update(input.data(), input.size());
-    hasher.get_hash(hashbuf);
+    xbytes_t hashbuf(32);
+    utl::xkeccak256_t::digest_once(input.data(), input.size(), hashbuf.data());
     xdbg(" -> hashed data:(%zu) %s", hashbuf.size(), top::to_hex(hashbuf).c_str());
-    return std::make_shared<xtrie_hash_node_t>(hashbuf);
+    return std::make_shared<xtrie_hash_node_t>(std::move(hashbuf));
 }
 
 std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> xtop_trie_hasher::proofHash(xtrie_node_face_ptr_t node) {
@@ -117,24 +118,125 @@ std::pair<xtrie_full_node_ptr_t, xtrie_full_node_ptr_t> xtop_trie_hasher::hashFu
     auto collapsed = node->clone();
     auto cached = node->clone();    // must be cloned?
 
-    // todo impl
-    // if h.parallel{}
-    // ...
-    // else{
+    // collapsed nodes are only encoded, never modified, so all unset children share one nil value node.
+    static xtrie_node_face_ptr_t const nil_child = std::make_shared<xtrie_value_node_t>(nilValueNode);
+
+    std::vector<std::size_t> dirty_children;
     for (std::size_t index = 0; index < 16; ++index) {
-        auto child = node->Children[index];
-        if (child != nullptr) {
+        auto const & child = node->Children[index];
+        if (child == nullptr) {
+            collapsed->Children[index] = nil_child;
+        } else if (child->cache().hash_node() == nullptr &&
+                   (child->type() == xtrie_node_type_t::shortnode || child->type() == xtrie_node_type_t::fullnode)) {
+            dirty_children.push_back(index);
+        } else {
             auto res = hash(child, false);
             collapsed->Children[index] = std::move(res.first);
             cached->Children[index] = std::move(res.second);
-        } else {
-            collapsed->Children[index] = std::make_shared<xtrie_value_node_t>(nilValueNode);
         }
     }
-    // }
+    if (dirty_children.empty()) {
+        return std::make_pair(collapsed, cached);
+    }
+    if (!m_parallel) {
+        hashChildrenBatch(node, collapsed, cached, dirty_children);
+        return std::make_pair(collapsed, cached);
+    }
+
+    // each worker hashes its own subtries with a serial hasher, so only the root level goes parallel.
+    // subtries never share nodes and every result slot is written by exactly one worker.
+    auto const hash_children = [&node, &collapsed, &cached, &dirty_children](std::size_t const begin, std::size_t const step) {
+        auto hasher = xtop_trie_hasher::newHasher(false);
+        for (std::size_t i = begin; i < dirty_children.size(); i += step) {
+            auto const index = dirty_children[i];
+            auto res = hasher.hash(node->Children[index], false);
+            collapsed->Children[index] = std::move(res.first);
+            cached->Children[index] = std::move(res.second);
+        }
+    };
+
+    std::size_t const hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const workers = std::min(dirty_children.size(), hardware_threads);
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers - 1);
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+        futures.push_back(std::async(std::launch::async, hash_children, worker, workers));
+    }
+    hash_children(0, workers);
+    for (auto & future : futures) {
+        future.get();
+    }
     return std::make_pair(collapsed, cached);
 }
 
+void xtop_trie_hasher::hashChildrenBatch(xtrie_full_node_ptr_t const & node,
+                                         xtrie_full_node_ptr_t const & collapsed,
+                                         xtrie_full_node_ptr_t const & cached,
+                                         std::vector<std::size_t> const & dirty_children) {
+    // siblings are independent, so their encodings are hashed together once all of them are collapsed.
+    std::vector<xbytes_t> encoded(dirty_children.size());
+    std::vector<uint8_t const *> datas;
+    std::vector<std::size_t> sizes;
+    std::vector<std::size_t> hashed;
+    for (std::size_t i = 0; i < dirty_children.size(); ++i) {
+        auto const index = dirty_children[i];
+        auto res = collapse(node->Children[index], encoded[i]);
+        if (encoded[i].size() < 32) {
+            // Nodes smaller than 32 bytes are stored inside their parent
+            setCachedHash(res.second, nullptr);
+        } else {
+            datas.push_back(encoded[i].data());
+            sizes.push_back(encoded[i].size());
+            hashed.push_back(i);
+        }
+        collapsed->Children[index] = std::move(res.first);
+        cached->Children[index] = std::move(res.second);
+    }
+    if (hashed.empty()) {
+        return;
+    }
+
+    xbytes_t digests(hashed.size() * 32);
+    utl::xkeccak256_t::digest_batch(hashed.size(), datas.data(), sizes.data(), digests.data());
+    for (std::size_t i = 0; i < hashed.size(); ++i) {
+        auto const index = dirty_children[hashed[i]];
+        auto hash_node = std::make_shared<xtrie_hash_node_t>(xbytes_t{digests.begin() + i * 32, digests.begin() + (i + 1) * 32});
+        setCachedHash(cached->Children[index], hash_node);
+        collapsed->Children[index] = std::move(hash_node);
+    }
+}
+
+std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> xtop_trie_hasher::collapse(xtrie_node_face_ptr_t const & node, xbytes_t & encoded) {
+    std::error_code ec;
+    if (node->type() == xtrie_node_type_t::shortnode) {
+        auto n = std::dynamic_pointer_cast<xtrie_short_node_t>(node);
+        assert(n != nullptr);
+
+        auto result = hashShortNodeChildren(n);
+        result.first->EncodeRLP(encoded, ec);
+        xassert(!ec);
+        return std::make_pair(result.first, result.second);
+    }
+
+    assert(node->type() == xtrie_node_type_t::fullnode);
+    auto n = std::dynamic_pointer_cast<xtrie_full_node_t>(node);
+    assert(n != nullptr);
+
+    auto result = hashFullNodeChildren(n);
+    result.first->EncodeRLP(encoded, ec);
+    xassert(!ec);
+    return std::make_pair(result.first, result.second);
+}
+
+void xtop_trie_hasher::setCachedHash(xtrie_node_face_ptr_t const & cached, xtrie_hash_node_ptr_t hash_node) {
+    if (cached->type() == xtrie_node_type_t::shortnode) {
+        std::static_pointer_cast<xtrie_short_node_t>(cached)->flags.hash_node(std::move(hash_node));
+    } else {
+        assert(cached->type() == xtrie_node_type_t::fullnode);
+        std::static_pointer_cast<xtrie_full_node_t>(cached)->flags.hash_node(std::move(hash_node));
+    }
+}
+
 xtrie_node_face_ptr_t xtop_trie_hasher::shortnodeToHash(xtrie_short_node_ptr_t node, bool force) {
     tmp.Reset();
 
@@ -128,38 +128,68 @@ void xtop_kv_db::DeleteDirectBatch(std::vector<xbytes_t> const & batch, std::err
 
 bool xtop_kv_db::Has(xbytes_t const & key, std::error_code & ec) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return (m_db->get_value(convert_key(key))) != std::string();
+    return m_db->decode_value(convert_key(key), [](const char *, const size_t) { return true; });
 }
 
 bool xtop_kv_db::HasDirect(xbytes_t const & key, std::error_code & ec) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return (m_db->get_value({key.begin(), key.end()})) != std::string();
+    return m_db->decode_value({key.begin(), key.end()}, [](const char *, const size_t) { return true; });
 }
 
 xbytes_t xtop_kv_db::Get(xbytes_t const & key, std::error_code & ec) {
     XMETRICS_COUNTER_INCREMENT("trie_get_nodes", 1);
     std::lock_guard<std::mutex> lock(m_mutex);
-    auto value = m_db->get_value(convert_key(key));
-    if (value == std::string()) {
+    xbytes_t value;
+    // copy once from pinned DB value instead of DB -> std::string -> xbytes_t
+    if (!m_db->decode_value(convert_key(key), [&value](const char * data, const size_t size) {
+            value.assign(data, data + size);
+            return true;
+        })) {
         xwarn("xtop_kv_db::Get key: %s, not found", top::to_hex(key).c_str());
         ec = error::xerrc_t::trie_db_not_found;
         return {};
     }
     xdbg("xtop_kv_db::Get key: %s, value: %s", top::to_hex(key).c_str(), top::to_hex(value).c_str());
-    return {value.begin(), value.end()};
+    return value;
 }
 
 xbytes_t xtop_kv_db::GetDirect(xbytes_t const & key, std::error_code & ec) {
     XMETRICS_COUNTER_INCREMENT("trie_get_units", 1);
     std::lock_guard<std::mutex> lock(m_mutex);
-    auto value = m_db->get_value({key.begin(), key.end()});
-    if (value == std::string()) {
+    xbytes_t value;
+    if (!m_db->decode_value({key.begin(), key.end()}, [&value](const char * data, const size_t size) {
+            value.assign(data, data + size);
+            return true;
+        })) {
         xwarn("xtop_kv_db::GetDirect key: %s, not found", top::to_hex(key).c_str());
         ec = error::xerrc_t::trie_db_not_found;
         return {};
     }
     xdbg("xtop_kv_db::GetDirect key: %s, value: %s", top::to_hex(key).c_str(), top::to_hex(value).c_str());
-    return {value.begin(), value.end()};
+    return value;
+}
+
+std::vector<xbytes_t> xtop_kv_db::GetBatch(std::vector<xbytes_t> const & keys, std::error_code & ec) {
+    XMETRICS_COUNTER_INCREMENT("trie_get_nodes", keys.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> convert_keys;
+    convert_keys.reserve(keys.size());
+    for (auto const & key : keys) {
+        convert_keys.emplace_back(convert_key(key));
+    }
+    auto const values = m_db->get_values(convert_keys);
+    if (values.size() != keys.size()) {
+        xwarn("xtop_kv_db::GetBatch error, keys count: %zu", keys.size());
+        ec = error::xerrc_t::trie_db_not_found;
+        return std::vector<xbytes_t>(keys.size());
+    }
+    std::vector<xbytes_t> result;
+    result.reserve(values.size());
+    for (auto const & value : values) {
+        result.emplace_back(value.begin(), value.end());
+    }
+    xdbg("xtop_kv_db::GetBatch keys count: %zu", keys.size());
+    return result;
 }
 
 }  // namespace trie
@@ -0,0 +1,97 @@
+// Copyright (c) 2022-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
+
+#include "xevm_common/xerror/xerror.h"
+
+NS_BEG3(top, evm_common, trie)
+
+xbytes_t xtop_memory_kv_db::Get(xbytes_t const & key, std::error_code & ec) {
+    auto const it = m_data.find(key);
+    if (it == m_data.end()) {
+        ec = error::xerrc_t::trie_db_not_found;
+        return {};
+    }
+    return it->second;
+}
+
+xbytes_t xtop_memory_kv_db::GetDirect(xbytes_t const & key, std::error_code & ec) {
+    return Get(key, ec);
+}
+
+bool xtop_memory_kv_db::Has(xbytes_t const & key, std::error_code &) {
+    return m_data.find(key) != m_data.end();
+}
+
+bool xtop_memory_kv_db::HasDirect(xbytes_t const & key, std::error_code & ec) {
+    return Has(key, ec);
+}
+
+void xtop_memory_kv_db::Put(xbytes_t const & key, xbytes_t const & value, std::error_code & ec) {
+    auto & v = m_data[key];
+    m_value_bytes = m_value_bytes - v.size() + value.size();
+    v = value;
+}
+
+void xtop_memory_kv_db::PutBatch(std::map<xbytes_t, xbytes_t> const & batch, std::error_code & ec) {
+    for (auto const & kv : batch) {
+        Put(kv.first, kv.second, ec);
+    }
+}
+
+void xtop_memory_kv_db::PutDirect(xbytes_t const & key, xbytes_t const & value, std::error_code & ec) {
+    Put(key, value, ec);
+}
+
+void xtop_memory_kv_db::PutDirectBatch(std::map<xbytes_t, xbytes_t> const & batch, std::error_code & ec) {
+    PutBatch(batch, ec);
+}
+
+void xtop_memory_kv_db::Delete(xbytes_t const & key, std::error_code &) {
+    auto const it = m_data.find(key);
+    if (it == m_data.end()) {
+        return;
+    }
+    m_value_bytes -= it->second.size();
+    m_data.erase(it);
+}
+
+void xtop_memory_kv_db::DeleteBatch(std::vector<xbytes_t> const & batch, std::error_code & ec) {
+    for (auto const & key : batch) {
+        Delete(key, ec);
+    }
+}
+
+void xtop_memory_kv_db::DeleteDirect(xbytes_t const & key, std::error_code & ec) {
+    Delete(key, ec);
+}
+
+void xtop_memory_kv_db::DeleteDirectBatch(std::vector<xbytes_t> const & batch, std::error_code & ec) {
+    DeleteBatch(batch, ec);
+}
+
+std::map<xbytes_t, xbytes_t> const & xtop_memory_kv_db::data() const noexcept {
+    return m_data;
+}
+
+std::vector<xbytes_t> xtop_memory_kv_db::values() const {
+    std::vector<xbytes_t> values;
+    values.reserve(m_data.size());
+    for (auto const & kv : m_data) {
+        values.push_back(kv.second);
+    }
+    return values;
+}
+
+std::size_t xtop_memory_kv_db::value_bytes() const noexcept {
+    return m_value_bytes;
+}
+
+void xtop_memory_kv_db::clear() noexcept {
+    m_data.clear();
+    m_value_bytes = 0;
+}
+
+NS_END3
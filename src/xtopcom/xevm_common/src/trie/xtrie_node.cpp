@@ -133,27 +133,28 @@ xtrie_node_type_t xtop_trie_short_node::type() const noexcept {
 }
 
 void xtop_trie_short_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
-    xbytes_t encoded;
-    append(encoded, RLP::encode(key));
+    // items are written straight into buf and wrapped in place, so a reused buf encodes without allocation.
+    auto const begin = buf.size();
+    RLP::encodeTo(buf, key);
 
     switch (val->type()) {  // NOLINT(clang-diagnostic-switch-enum)
     case xtrie_node_type_t::hashnode: {
         assert(dynamic_cast<xtrie_hash_node_t *>(val.get()) != nullptr);
-        append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_hash_node_t>(val)->data()));
+        RLP::encodeTo(buf, static_cast<xtrie_hash_node_t *>(val.get())->data());
 
         break;
     }
 
     case xtrie_node_type_t::valuenode: {
         assert(dynamic_cast<xtrie_value_node_t *>(val.get()) != nullptr);
-        append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_value_node_t>(val)->data()));
+        RLP::encodeTo(buf, static_cast<xtrie_value_node_t *>(val.get())->data());
 
         break;
     }
 
     case xtrie_node_type_t::fullnode: {
         assert(dynamic_cast<xtrie_full_node_t *>(val.get()) != nullptr);
-        std::dynamic_pointer_cast<xtrie_full_node_t>(val)->EncodeRLP(encoded, ec);
+        static_cast<xtrie_full_node_t *>(val.get())->EncodeRLP(buf, ec);
 
         break;
     }
@@ -165,7 +166,7 @@ void xtop_trie_short_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
         break;
     }
 
-    append(buf, RLP::encodeList(encoded));
+    RLP::encodeListTo(buf, begin);
 }
 
 std::string xtop_trie_full_node::fstring(std::string const & ind) const {
@@ -203,38 +204,38 @@ xtrie_node_type_t xtop_trie_full_node::type() const noexcept {
 }
 
 void xtop_trie_full_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
-    xbytes_t encoded;
+    auto const begin = buf.size();
     for (auto const & child : Children) {
         if (child == nullptr) {
-            append(encoded, RLP::encode(nilValueNode.data()));  // 0x80 for empty bytes.
+            RLP::encodeTo(buf, nilValueNode.data());  // 0x80 for empty bytes.
             continue;
         }
 
         switch (child->type()) {  // NOLINT(clang-diagnostic-switch-enum)
         case xtrie_node_type_t::hashnode: {
             assert(dynamic_cast<xtrie_hash_node_t *>(child.get()) != nullptr);
-            append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_hash_node_t>(child)->data()));
+            RLP::encodeTo(buf, static_cast<xtrie_hash_node_t *>(child.get())->data());
 
             break;
         }
 
         case xtrie_node_type_t::valuenode: {
             assert(dynamic_cast<xtrie_value_node_t *>(child.get()) != nullptr);
-            append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_value_node_t>(child)->data()));
+            RLP::encodeTo(buf, static_cast<xtrie_value_node_t *>(child.get())->data());
 
             break;
         }
 
         case xtrie_node_type_t::fullnode: {
             assert(dynamic_cast<xtrie_full_node_t *>(child.get()) != nullptr);
-            std::dynamic_pointer_cast<xtrie_full_node_t>(child)->EncodeRLP(encoded, ec);
+            static_cast<xtrie_full_node_t *>(child.get())->EncodeRLP(buf, ec);
 
             break;
         }
 
         case xtrie_node_type_t::shortnode: {
             assert(dynamic_cast<xtrie_short_node_t *>(child.get()) != nullptr);
-            std::dynamic_pointer_cast<xtrie_short_node_t>(child)->EncodeRLP(encoded, ec);
+            static_cast<xtrie_short_node_t *>(child.get())->EncodeRLP(buf, ec);
 
             break;
         }
@@ -246,50 +247,50 @@ void xtop_trie_full_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
             break;
         }
     }
-    append(buf, RLP::encodeList(encoded));
+    RLP::encodeListTo(buf, begin);
 }
 
 void xtop_trie_raw_full_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
-    xbytes_t encoded;
+    auto const begin = buf.size();
 
     for (auto const & child : Children) {
         if (child == nullptr) {
-            append(encoded, RLP::encode(nilValueNode.data()));  // 0x80 for empty bytes.
+            RLP::encodeTo(buf, nilValueNode.data());  // 0x80 for empty bytes.
             continue;
         }
 
         switch (child->type()) {  // NOLINT(clang-diagnostic-switch-enum)
         case xtrie_node_type_t::hashnode: {
             assert(dynamic_cast<xtrie_hash_node_t *>(child.get()) != nullptr);
-            append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_hash_node_t>(child)->data()));
+            RLP::encodeTo(buf, static_cast<xtrie_hash_node_t *>(child.get())->data());
 
             break;
         }
 
         case xtrie_node_type_t::valuenode: {
             assert(dynamic_cast<xtrie_value_node_t *>(child.get()) != nullptr);
-            append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_value_node_t>(child)->data()));
+            RLP::encodeTo(buf, static_cast<xtrie_value_node_t *>(child.get())->data());
 
             break;
         }
 
         case xtrie_node_type_t::fullnode: {
             assert(dynamic_cast<xtrie_full_node_t *>(child.get()) != nullptr);
-            std::dynamic_pointer_cast<xtrie_full_node_t>(child)->EncodeRLP(encoded, ec);
+            static_cast<xtrie_full_node_t *>(child.get())->EncodeRLP(buf, ec);
 
             break;
         }
 
         case xtrie_node_type_t::shortnode: {
             assert(dynamic_cast<xtrie_short_node_t *>(child.get()) != nullptr);
-            std::dynamic_pointer_cast<xtrie_short_node_t>(child)->EncodeRLP(encoded, ec);
+            static_cast<xtrie_short_node_t *>(child.get())->EncodeRLP(buf, ec);
 
             break;
         }
 
         case xtrie_node_type_t::rawshortnode: {
             assert(dynamic_cast<xtrie_raw_short_node_t *>(child.get()) != nullptr);
-            std::dynamic_pointer_cast<xtrie_raw_short_node_t>(child)->EncodeRLP(encoded, ec);
+            static_cast<xtrie_raw_short_node_t *>(child.get())->EncodeRLP(buf, ec);
 
             break;
         }
@@ -302,38 +303,38 @@ void xtop_trie_raw_full_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
         }
         }
     }
-    append(buf, RLP::encodeList(encoded));
+    RLP::encodeListTo(buf, begin);
 }
 
 void xtop_trie_raw_short_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
-    xbytes_t encoded;
-    append(encoded, RLP::encode(Key));
+    auto const begin = buf.size();
+    RLP::encodeTo(buf, Key);
 
     switch (Val->type()) {  // NOLINT(clang-diagnostic-switch-enum)
     case xtrie_node_type_t::hashnode: {
         assert(dynamic_cast<xtrie_hash_node_t *>(Val.get()) != nullptr);
-        append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_hash_node_t>(Val)->data()));
+        RLP::encodeTo(buf, static_cast<xtrie_hash_node_t *>(Val.get())->data());
 
         break;
     }
 
     case xtrie_node_type_t::valuenode: {
         assert(dynamic_cast<xtrie_value_node_t *>(Val.get()) != nullptr);
-        append(encoded, RLP::encode(std::dynamic_pointer_cast<xtrie_value_node_t>(Val)->data()));
+        RLP::encodeTo(buf, static_cast<xtrie_value_node_t *>(Val.get())->data());
 
         break;
     }
 
     case xtrie_node_type_t::fullnode: {
         assert(dynamic_cast<xtrie_full_node_t *>(Val.get()) != nullptr);
-        std::dynamic_pointer_cast<xtrie_full_node_t>(Val)->EncodeRLP(encoded, ec);
+        static_cast<xtrie_full_node_t *>(Val.get())->EncodeRLP(buf, ec);
 
         break;
     }
 
     case xtrie_node_type_t::rawfullnode: {
         assert(dynamic_cast<xtrie_raw_full_node_t *>(Val.get()) != nullptr);
-        std::dynamic_pointer_cast<xtrie_raw_full_node_t>(Val)->EncodeRLP(encoded, ec);
+        static_cast<xtrie_raw_full_node_t *>(Val.get())->EncodeRLP(buf, ec);
 
         break;
     }
@@ -345,7 +346,7 @@ void xtop_trie_raw_short_node::EncodeRLP(xbytes_t & buf, std::error_code & ec) {
     }
     }
 
-    append(buf, RLP::encodeList(encoded));
+    RLP::encodeListTo(buf, begin);
 }
 
 NS_END3
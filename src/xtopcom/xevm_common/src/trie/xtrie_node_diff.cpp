@@ -0,0 +1,120 @@
+// Copyright (c) 2022-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xevm_common/trie/xtrie_node_diff.h"
+
+#include "xbasic/xhex.h"
+#include "xevm_common/xerror/xerror.h"
+
+#include <cassert>
+
+NS_BEG3(top, evm_common, trie)
+
+constexpr auto NodeDiffPrefix = ConstBytes<2>("j/");
+
+// layout: parent | u32 count | { u8 path size | path | hash } ... for inserted, then the same for obsolete.
+static void encode_nodes(std::unordered_map<xhash256_t, xbytes_t> const & nodes, xbytes_t & out) {
+    auto const count = static_cast<uint32_t>(nodes.size());
+    for (std::size_t i = 0; i < 4; ++i) {
+        out.push_back(static_cast<xbyte_t>(count >> (8 * i)));
+    }
+    for (auto const & node : nodes) {
+        assert(node.second.size() <= 0xFF);
+        out.push_back(static_cast<xbyte_t>(node.second.size()));
+        out.insert(out.end(), node.second.begin(), node.second.end());
+        out.insert(out.end(), node.first.begin(), node.first.end());
+    }
+}
+
+static void decode_nodes(xbytes_t const & data, std::size_t & pos, std::unordered_map<xhash256_t, xbytes_t> & nodes, std::error_code & ec) {
+    if (data.size() < pos + 4) {
+        ec = error::xerrc_t::not_enough_data;
+        return;
+    }
+    uint32_t count{0};
+    for (std::size_t i = 0; i < 4; ++i) {
+        count |= static_cast<uint32_t>(data[pos++]) << (8 * i);
+    }
+    nodes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (data.size() < pos + 1 || data.size() < pos + 1 + data[pos] + xhash256_t::bytes_size) {
+            ec = error::xerrc_t::not_enough_data;
+            return;
+        }
+        std::size_t const path_size = data[pos++];
+        xbytes_t path{std::next(data.begin(), static_cast<std::ptrdiff_t>(pos)), std::next(data.begin(), static_cast<std::ptrdiff_t>(pos + path_size))};
+        pos += path_size;
+        xhash256_t const hash{xbytes_t{std::next(data.begin(), static_cast<std::ptrdiff_t>(pos)), std::next(data.begin(), static_cast<std::ptrdiff_t>(pos + xhash256_t::bytes_size))}};
+        pos += xhash256_t::bytes_size;
+        nodes.emplace(hash, std::move(path));
+    }
+}
+
+xbytes_t xtop_trie_node_diff::encode() const {
+    xbytes_t out;
+    out.reserve(parent.size() + 8 + (inserted.size() + obsolete.size()) * (parent.size() + 16));
+    out.insert(out.end(), parent.begin(), parent.end());
+    encode_nodes(inserted, out);
+    encode_nodes(obsolete, out);
+    return out;
+}
+
+void xtop_trie_node_diff::decode(xbytes_t const & data, std::error_code & ec) {
+    assert(!ec);
+    if (data.size() < parent.size()) {
+        ec = error::xerrc_t::not_enough_data;
+        return;
+    }
+    parent = xhash256_t{xbytes_t{data.begin(), std::next(data.begin(), static_cast<std::ptrdiff_t>(parent.size()))}};
+    std::size_t pos = parent.size();
+    decode_nodes(data, pos, inserted, ec);
+    if (ec) {
+        return;
+    }
+    decode_nodes(data, pos, obsolete, ec);
+}
+
+xbytes_t node_diff_key(xhash256_t const & root) {
+    xbytes_t key{NodeDiffPrefix.begin(), NodeDiffPrefix.end()};
+    key.insert(key.end(), root.begin(), root.end());
+    return key;
+}
+
+bool ReadNodeDiff(xkv_db_face_ptr_t const & db, xhash256_t const & root, xtrie_node_diff_t & diff) {
+    std::error_code ec;
+    if (!db->Has(node_diff_key(root), ec)) {
+        return false;
+    }
+    auto const data = db->Get(node_diff_key(root), ec);
+    if (ec || data.empty()) {
+        return false;
+    }
+    diff.decode(data, ec);
+    if (ec) {
+        xwarn("ReadNodeDiff decode node diff of %s failed: %s", root.as_hex_str().c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+void WriteNodeDiff(xkv_db_face_ptr_t const & db, xhash256_t const & root, xtrie_node_diff_t const & diff, std::error_code & ec) {
+    db->Put(node_diff_key(root), diff.encode(), ec);
+    if (ec) {
+        xwarn("Failed to store node diff: %s", ec.message().c_str());
+    }
+}
+
+void DeleteNodeDiffs(xkv_db_face_ptr_t const & db, std::vector<xhash256_t> const & roots, std::error_code & ec) {
+    std::vector<xbytes_t> keys;
+    keys.reserve(roots.size());
+    for (auto const & root : roots) {
+        keys.push_back(node_diff_key(root));
+    }
+    db->DeleteBatch(keys, ec);
+    if (ec) {
+        xwarn("Failed to delete node diff: %s", ec.message().c_str());
+    }
+}
+
+NS_END3
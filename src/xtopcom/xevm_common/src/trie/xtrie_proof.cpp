@@ -4,10 +4,15 @@
 
 #include "xevm_common/trie/xtrie_proof.h"
 
+#include "xevm_common/trie/xstack_trie.h"
+#include "xevm_common/trie/xtrie.h"
 #include "xevm_common/trie/xtrie_encoding.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
 #include "xevm_common/trie/xtrie_node_coding.h"
 #include "xevm_common/xerror/xerror.h"
 
+#include <algorithm>
+
 NS_BEG3(top, evm_common, trie)
 xbytes_t VerifyProof(xhash256_t rootHash, xbytes_t const & _key, xkv_db_face_ptr_t proofDB, std::error_code & ec) {
     auto key = keybytesToHex(_key);
@@ -53,6 +58,497 @@ xbytes_t VerifyProof(xhash256_t rootHash, xbytes_t const & _key, xkv_db_face_ptr
     __builtin_unreachable();
 }
 
+static int compare_bytes(xbytes_t::const_iterator a_begin, xbytes_t::const_iterator a_end, xbytes_t::const_iterator b_begin, xbytes_t::const_iterator b_end) {
+    if (std::lexicographical_compare(a_begin, a_end, b_begin, b_end)) {
+        return -1;
+    }
+    if (std::lexicographical_compare(b_begin, b_end, a_begin, a_end)) {
+        return 1;
+    }
+    return 0;
+}
+
+// compare key with the nibbles of path starting from pos, at most key.size() of them.
+static int compare_path(xbytes_t const & path, std::size_t pos, xbytes_t const & key) {
+    auto const begin = std::next(path.begin(), static_cast<std::ptrdiff_t>(pos));
+    auto const end = (path.size() - pos < key.size()) ? path.end() : std::next(begin, static_cast<std::ptrdiff_t>(key.size()));
+    return compare_bytes(begin, end, key.begin(), key.end());
+}
+
+// proofToPath converts a merkle proof to trie node path. The main purpose of
+// this function is recovering a node path from the merkle proof stream. All
+// necessary nodes will be resolved and leave the remaining as hashnode.
+//
+// The given edge proof is allowed to be an existent or non-existent proof.
+static xtrie_node_face_ptr_t proofToPath(xhash256_t const & rootHash,
+                                         xtrie_node_face_ptr_t root,
+                                         xbytes_t const & _key,
+                                         xkv_db_face_ptr_t const & proofDB,
+                                         bool allowNonExistent,
+                                         xbytes_t & value,
+                                         std::error_code & ec) {
+    // resolveNode retrieves and resolves trie node from merkle proof stream
+    auto resolveNode = [&proofDB](xhash256_t const & hash, std::error_code & ec) -> xtrie_node_face_ptr_t {
+        std::error_code _;
+        auto const buf = proofDB->Get(hash.to_bytes(), _);
+        if (buf.empty()) {
+            xwarn("proof node (hash: %s) missing", hash.as_hex_str().c_str());
+            ec = error::xerrc_t::trie_proof_missing;
+            return nullptr;
+        }
+        return xtrie_node_rlp::decodeNode(hash, buf, ec);
+    };
+    // If the root node is empty, resolve it first.
+    // Root node must be included in the proof.
+    if (root == nullptr) {
+        root = resolveNode(rootHash, ec);
+        if (ec) {
+            return nullptr;
+        }
+    }
+    auto key = keybytesToHex(_key);
+    auto parent = root;
+    for (;;) {
+        xbytes_t keyrest;
+        xtrie_node_face_ptr_t child;
+        std::tie(keyrest, child) = get(parent, key, false, ec);
+        if (child == nullptr) {
+            // The trie doesn't contain the key. It's possible
+            // the proof is a non-existing proof, but at least
+            // we can prove all resolved nodes are correct, it's
+            // enough for us to prove range.
+            if (allowNonExistent) {
+                return root;
+            }
+            xwarn("proofToPath the node is not contained in trie");
+            ec = error::xerrc_t::trie_proof_missing;
+            return nullptr;
+        }
+        switch (child->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+        case xtrie_node_type_t::shortnode:
+        case xtrie_node_type_t::fullnode: {
+            // Already resolved
+            key = keyrest;
+            parent = child;
+            continue;
+        }
+        case xtrie_node_type_t::hashnode: {
+            auto const n = std::dynamic_pointer_cast<xtrie_hash_node_t>(child);
+            assert(n != nullptr);
+            child = resolveNode(xhash256_t{n->data()}, ec);
+            if (ec) {
+                return nullptr;
+            }
+            break;
+        }
+        case xtrie_node_type_t::valuenode: {
+            auto const n = std::dynamic_pointer_cast<xtrie_value_node_t>(child);
+            assert(n != nullptr);
+            value = n->data();
+            break;
+        }
+        default: {
+            ec = error::xerrc_t::trie_node_unexpected;
+            return nullptr;
+        }
+        }
+        // Link the parent and child.
+        switch (parent->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+        case xtrie_node_type_t::shortnode: {
+            std::dynamic_pointer_cast<xtrie_short_node_t>(parent)->val = child;
+            break;
+        }
+        case xtrie_node_type_t::fullnode: {
+            std::dynamic_pointer_cast<xtrie_full_node_t>(parent)->Children[key[0]] = child;
+            break;
+        }
+        default: {
+            ec = error::xerrc_t::trie_node_unexpected;
+            return nullptr;
+        }
+        }
+        if (!value.empty()) {
+            // The whole path is resolved
+            return root;
+        }
+        key = keyrest;
+        parent = child;
+    }
+    __builtin_unreachable();
+}
+
+// unset removes all internal node references either the left most or right most.
+// It can meet these scenarios:
+//
+// - The given path is existent in the trie, unset the associated nodes with the
+//   specific direction
+// - The given path is non-existent in the trie
+//   - the fork point is a fullnode, the corresponding child pointed by path
+//     is nil, return
+//   - the fork point is a shortnode, the shortnode is included in the range,
+//     keep the entire branch and return.
+//   - the fork point is a shortnode, the shortnode is excluded in the range,
+//     unset the entire branch.
+static void unset(xtrie_node_face_ptr_t const & parent, xtrie_node_face_ptr_t const & child, xbytes_t const & key, std::size_t pos, bool removeLeft, std::error_code & ec) {
+    if (child == nullptr) {
+        // If the node is nil, then it's a child of the fork point
+        // fullnode(it's a non-existent branch).
+        return;
+    }
+    switch (child->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+    case xtrie_node_type_t::fullnode: {
+        auto const cld = std::dynamic_pointer_cast<xtrie_full_node_t>(child);
+        if (removeLeft) {
+            for (std::size_t i = 0; i < key[pos]; ++i) {
+                cld->Children[i] = nullptr;
+            }
+        } else {
+            for (std::size_t i = key[pos] + 1; i < 16; ++i) {
+                cld->Children[i] = nullptr;
+            }
+        }
+        cld->flags = xnode_flag_t{true};
+        unset(cld, cld->Children[key[pos]], key, pos + 1, removeLeft, ec);
+        return;
+    }
+    case xtrie_node_type_t::shortnode: {
+        auto const cld = std::dynamic_pointer_cast<xtrie_short_node_t>(child);
+        auto const fn = std::dynamic_pointer_cast<xtrie_full_node_t>(parent);
+        if (key.size() - pos < cld->key.size() || !std::equal(cld->key.begin(), cld->key.end(), std::next(key.begin(), static_cast<std::ptrdiff_t>(pos)))) {
+            // Find the fork point, it's an non-existent branch.
+            auto const cmp = compare_bytes(cld->key.begin(), cld->key.end(), std::next(key.begin(), static_cast<std::ptrdiff_t>(pos)), key.end());
+            // The key of fork shortnode is less (when removing left) or greater (when
+            // removing right) than the path, it belongs to the range, unset the entire
+            // branch. Otherwise keep it with the cached hash available.
+            if ((removeLeft && cmp < 0) || (!removeLeft && cmp > 0)) {
+                if (fn == nullptr) {
+                    ec = error::xerrc_t::trie_node_unexpected;
+                    return;
+                }
+                fn->Children[key[pos - 1]] = nullptr;
+            }
+            return;
+        }
+        if (cld->val->type() == xtrie_node_type_t::valuenode) {
+            if (fn == nullptr) {
+                ec = error::xerrc_t::trie_node_unexpected;
+                return;
+            }
+            fn->Children[key[pos - 1]] = nullptr;
+            return;
+        }
+        cld->flags = xnode_flag_t{true};
+        unset(cld, cld->val, key, pos + cld->key.size(), removeLeft, ec);
+        return;
+    }
+    default: {
+        // hashnode, valuenode
+        ec = error::xerrc_t::trie_node_unexpected;
+        return;
+    }
+    }
+}
+
+// unsetInternal removes all internal node references(hashnode, embedded node).
+// It should be called after a trie is constructed with two edge paths. Also
+// the given boundary keys must be the one used to construct the edge paths.
+//
+// It's the key step for range proof. All visited nodes should be marked dirty
+// since the node content might be modified. Besides it can happen that some
+// fullnodes only have one child which is disallowed. But if the proof is valid,
+// the missing children will be filled, otherwise it will be thrown anyway.
+//
+// Note we have the assumption here the given boundary keys are different
+// and right is larger than left.
+//
+// Returns true if the whole trie is to be rebuilt by the leaves.
+static bool unsetInternal(xtrie_node_face_ptr_t n, xbytes_t const & _left, xbytes_t const & _right, std::error_code & ec) {
+    auto const left = keybytesToHex(_left);
+    auto const right = keybytesToHex(_right);
+
+    // Step down to the fork point. There are two scenarios can happen:
+    // - the fork point is a shortnode: either the key of left proof or
+    //   right proof doesn't match with shortnode's key.
+    // - the fork point is a fullnode: both two edge proofs are allowed
+    //   to point to a non-existent key.
+    std::size_t pos{0};
+    xtrie_node_face_ptr_t parent;
+    // fork indicator, 0 means no fork, -1 means proof is less, 1 means proof is greater
+    int shortForkLeft{0};
+    int shortForkRight{0};
+    for (bool fork = false; !fork;) {
+        if (n == nullptr) {
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+        switch (n->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+        case xtrie_node_type_t::shortnode: {
+            auto const rn = std::dynamic_pointer_cast<xtrie_short_node_t>(n);
+            rn->flags = xnode_flag_t{true};
+
+            // If either the key of left proof or right proof doesn't match with
+            // shortnode, stop here and the forkpoint is the shortnode.
+            shortForkLeft = compare_path(left, pos, rn->key);
+            shortForkRight = compare_path(right, pos, rn->key);
+            if (shortForkLeft != 0 || shortForkRight != 0) {
+                fork = true;
+                break;
+            }
+            parent = n;
+            n = rn->val;
+            pos += rn->key.size();
+            break;
+        }
+        case xtrie_node_type_t::fullnode: {
+            auto const rn = std::dynamic_pointer_cast<xtrie_full_node_t>(n);
+            rn->flags = xnode_flag_t{true};
+
+            // If either the node pointed by left proof or right proof is nil,
+            // stop here and the forkpoint is the fullnode.
+            auto const & leftnode = rn->Children[left[pos]];
+            auto const & rightnode = rn->Children[right[pos]];
+            if (leftnode == nullptr || rightnode == nullptr || leftnode != rightnode) {
+                fork = true;
+                break;
+            }
+            parent = n;
+            n = leftnode;
+            pos += 1;
+            break;
+        }
+        default: {
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+        }
+    }
+
+    if (n->type() == xtrie_node_type_t::shortnode) {
+        auto const rn = std::dynamic_pointer_cast<xtrie_short_node_t>(n);
+        // There can have these five scenarios:
+        // - both proofs are less than the trie path => no valid range
+        // - both proofs are greater than the trie path => no valid range
+        // - left proof is less and right proof is greater => valid range, unset the shortnode entirely
+        // - left proof points to the shortnode, but right proof is greater
+        // - right proof points to the shortnode, but left proof is less
+        if ((shortForkLeft == -1 && shortForkRight == -1) || (shortForkLeft == 1 && shortForkRight == 1)) {
+            xwarn("unsetInternal empty range");
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+        // unset_fork removes the fork shortnode referenced by path from its parent.
+        auto unset_fork = [&](xbytes_t const & path) -> bool {
+            // The fork point is root node, unset the entire trie
+            if (parent == nullptr) {
+                return true;
+            }
+            auto const fn = std::dynamic_pointer_cast<xtrie_full_node_t>(parent);
+            if (fn == nullptr) {
+                ec = error::xerrc_t::trie_node_unexpected;
+                return false;
+            }
+            fn->Children[path[pos - 1]] = nullptr;
+            return false;
+        };
+        if (shortForkLeft != 0 && shortForkRight != 0) {
+            return unset_fork(left);
+        }
+        // Only one proof points to non-existent key.
+        if (shortForkRight != 0) {
+            if (rn->val->type() == xtrie_node_type_t::valuenode) {
+                return unset_fork(left);
+            }
+            unset(rn, rn->val, xbytes_t{std::next(left.begin(), static_cast<std::ptrdiff_t>(pos)), left.end()}, rn->key.size(), false, ec);
+            return false;
+        }
+        if (shortForkLeft != 0) {
+            if (rn->val->type() == xtrie_node_type_t::valuenode) {
+                return unset_fork(right);
+            }
+            unset(rn, rn->val, xbytes_t{std::next(right.begin(), static_cast<std::ptrdiff_t>(pos)), right.end()}, rn->key.size(), true, ec);
+            return false;
+        }
+        return false;
+    }
+
+    // fullnode: unset all internal nodes in the forkpoint
+    auto const rn = std::dynamic_pointer_cast<xtrie_full_node_t>(n);
+    for (std::size_t i = left[pos] + 1; i < right[pos]; ++i) {
+        rn->Children[i] = nullptr;
+    }
+    auto const left_rest = xbytes_t{std::next(left.begin(), static_cast<std::ptrdiff_t>(pos)), left.end()};
+    auto const right_rest = xbytes_t{std::next(right.begin(), static_cast<std::ptrdiff_t>(pos)), right.end()};
+    unset(rn, rn->Children[left[pos]], left_rest, 1, false, ec);
+    if (ec) {
+        return false;
+    }
+    unset(rn, rn->Children[right[pos]], right_rest, 1, true, ec);
+    return false;
+}
+
+// hasRightElement returns the indicator whether there exists more elements
+// in the right side of the given path. The given path can point to an existent
+// key or a non-existent one. This function has the assumption that the whole
+// path should already be resolved.
+static bool hasRightElement(xtrie_node_face_ptr_t node, xbytes_t const & _key) {
+    auto const key = keybytesToHex(_key);
+    std::size_t pos{0};
+    while (node != nullptr) {
+        switch (node->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+        case xtrie_node_type_t::fullnode: {
+            auto const rn = std::dynamic_pointer_cast<xtrie_full_node_t>(node);
+            for (std::size_t i = key[pos] + 1; i < 16; ++i) {
+                if (rn->Children[i] != nullptr) {
+                    return true;
+                }
+            }
+            node = rn->Children[key[pos]];
+            pos += 1;
+            break;
+        }
+        case xtrie_node_type_t::shortnode: {
+            auto const rn = std::dynamic_pointer_cast<xtrie_short_node_t>(node);
+            if (key.size() - pos < rn->key.size() || !std::equal(rn->key.begin(), rn->key.end(), std::next(key.begin(), static_cast<std::ptrdiff_t>(pos)))) {
+                return compare_bytes(rn->key.begin(), rn->key.end(), std::next(key.begin(), static_cast<std::ptrdiff_t>(pos)), key.end()) > 0;
+            }
+            node = rn->val;
+            pos += rn->key.size();
+            break;
+        }
+        default: {
+            // We have resolved the whole path
+            return false;
+        }
+        }
+    }
+    return false;
+}
+
+bool VerifyRangeProof(xhash256_t const & rootHash,
+                      xbytes_t const & firstKey,
+                      xbytes_t const & lastKey,
+                      std::vector<xbytes_t> const & keys,
+                      std::vector<xbytes_t> const & values,
+                      xkv_db_face_ptr_t const & proofDB,
+                      std::error_code & ec) {
+    xassert(!ec);
+    if (keys.size() != values.size()) {
+        xwarn("VerifyRangeProof inconsistent proof data, keys: %zu, values: %zu", keys.size(), values.size());
+        ec = error::xerrc_t::trie_node_unexpected;
+        return false;
+    }
+    // Ensure the received batch is monotonic increasing and contains no deletions
+    for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+        if (!(keys[i] < keys[i + 1])) {
+            xwarn("VerifyRangeProof range is not monotonically increasing");
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+    }
+    // Ensure the batch is within the edge keys
+    if (!keys.empty() && (keys.front() < firstKey || lastKey < keys.back())) {
+        xwarn("VerifyRangeProof range is out of edge keys");
+        ec = error::xerrc_t::trie_node_unexpected;
+        return false;
+    }
+    for (auto const & value : values) {
+        if (value.empty()) {
+            xwarn("VerifyRangeProof range contains deletion");
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+    }
+    // Special case, there is no edge proof at all. The given range is expected
+    // to be the whole leaf-set in the trie.
+    if (proofDB == nullptr) {
+        auto const tr = xstack_trie_t::NewStackTrie(nullptr);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            tr->Update(keys[i], values[i]);
+        }
+        auto const have = tr->Hash();
+        if (have != rootHash) {
+            xwarn("VerifyRangeProof invalid proof, want hash %s, got %s", rootHash.as_hex_str().c_str(), have.as_hex_str().c_str());
+            ec = error::xerrc_t::trie_node_unexpected;
+        }
+        return false;  // No more elements
+    }
+    // Special case, there is a provided edge proof but zero key/value
+    // pairs, ensure there are no more accounts / slots in the trie.
+    if (keys.empty()) {
+        xbytes_t value;
+        auto const root = proofToPath(rootHash, nullptr, firstKey, proofDB, true, value, ec);
+        if (ec) {
+            return false;
+        }
+        if (!value.empty() || hasRightElement(root, firstKey)) {
+            xwarn("VerifyRangeProof more entries available");
+            ec = error::xerrc_t::trie_node_unexpected;
+        }
+        return false;
+    }
+    // Special case, there is only one element and two edge keys are same.
+    // In this case, we can't construct two edge paths. So handle it here.
+    if (keys.size() == 1 && firstKey == lastKey) {
+        xbytes_t value;
+        auto const root = proofToPath(rootHash, nullptr, firstKey, proofDB, false, value, ec);
+        if (ec) {
+            return false;
+        }
+        if (firstKey != keys[0] || value != values[0]) {
+            xwarn("VerifyRangeProof correct proof but invalid data");
+            ec = error::xerrc_t::trie_node_unexpected;
+            return false;
+        }
+        return hasRightElement(root, firstKey);
+    }
+    // Ok, in all other cases, we require two edge paths available.
+    // First check the validity of edge keys.
+    if (!(firstKey < lastKey) || firstKey.size() != lastKey.size()) {
+        xwarn("VerifyRangeProof invalid edge keys");
+        ec = error::xerrc_t::trie_node_unexpected;
+        return false;
+    }
+    // Convert the edge proofs to edge trie paths. Then we can
+    // have the same tree architecture with the original one.
+    // For the first edge proof, non-existent proof is allowed.
+    xbytes_t value;
+    auto root = proofToPath(rootHash, nullptr, firstKey, proofDB, true, value, ec);
+    if (ec) {
+        return false;
+    }
+    // Pass the root node here, the second path will be merged
+    // with the first one. For the last edge proof, non-existent
+    // proof is also allowed.
+    value.clear();
+    root = proofToPath(rootHash, root, lastKey, proofDB, true, value, ec);
+    if (ec) {
+        return false;
+    }
+    // Remove all internal references. All the removed parts should
+    // be re-filled(or re-constructed) by the given leaves range.
+    auto const empty = unsetInternal(root, firstKey, lastKey, ec);
+    if (ec) {
+        return false;
+    }
+    // Rebuild the trie with the leaf stream, the shape of trie
+    // should be same with the original one.
+    auto const tr = xtrie_t::build_from_root_node(empty ? nullptr : root, xtrie_db_t::NewDatabase(std::make_shared<xmemory_kv_db_t>()));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        tr->try_update(keys[i], values[i], ec);
+        if (ec) {
+            // hit a node out of the proven paths, the proof is incomplete.
+            return false;
+        }
+    }
+    auto const have = tr->hash();
+    if (have != rootHash) {
+        xwarn("VerifyRangeProof invalid proof, want hash %s, got %s", rootHash.as_hex_str().c_str(), have.as_hex_str().c_str());
+        ec = error::xerrc_t::trie_node_unexpected;
+        return false;
+    }
+    return hasRightElement(tr->root(), keys.back());
+}
+
 std::pair<xbytes_t, xtrie_node_face_ptr_t> get(xtrie_node_face_ptr_t tn, xbytes_t key, bool skipResolved, std::error_code & ec) {
     for (;;) {
         if (tn == nullptr) {
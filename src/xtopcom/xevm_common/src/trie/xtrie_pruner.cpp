@@ -7,13 +7,21 @@
 #include "xevm_common/trie/xtrie_node.h"
 #include "xevm_common/trie/xtrie_db.h"
 #include "xevm_common/trie/xtrie_hasher.h"
+#include "xevm_common/trie/xtrie_node_diff.h"
 #include "xevm_common/xerror/xerror.h"
 
+#include <algorithm>
+
 NS_BEG3(top, evm_common, trie)
 
-void xtop_trie_pruner::init(std::shared_ptr<xtrie_node_face_t> const & trie_root, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
+xtop_trie_pruner::xtop_trie_pruner(xtrie_node_face_ptr_t keep_root, xhash256_t const & keep_root_hash) : keep_root_{std::move(keep_root)}, keep_root_hash_{keep_root_hash} {
+}
+
+void xtop_trie_pruner::init(std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
     assert(!ec);
-    load_trie_node(trie_root, trie_db, ec);
+    if (keep_root_ != nullptr) {
+        load_trie_node(keep_root_, trie_db, ec);
+    }
 }
 
 std::shared_ptr<xtrie_node_face_t> xtop_trie_pruner::load_trie_node(std::shared_ptr<xtrie_node_face_t> const & trie_node,
@@ -130,6 +138,17 @@ std::shared_ptr<xtrie_node_face_t> xtop_trie_pruner::load_hash_node(std::shared_
 void xtop_trie_pruner::load_full_node_children(std::shared_ptr<xtrie_full_node_t> const & full_node, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
     assert(!ec);
 
+    // siblings are stored apart, read the unresolved ones from db by one batch.
+    std::vector<xhash256_t> child_hashes;
+    for (auto const & child : full_node->Children) {
+        if (child != nullptr && child->type() == xtrie_node_type_t::hashnode) {
+            auto const hash_node = std::dynamic_pointer_cast<xtrie_hash_node_t>(child);
+            assert(hash_node != nullptr);
+            child_hashes.push_back(xhash256_t{hash_node->data()});
+        }
+    }
+    trie_db->prefetch(child_hashes);
+
     for (auto & child : full_node->Children) {
         if (child != nullptr) {
             child = load_trie_node(child, trie_db, ec);
@@ -140,10 +159,143 @@ void xtop_trie_pruner::load_full_node_children(std::shared_ptr<xtrie_full_node_t
 void xtop_trie_pruner::prune(xhash256_t const & old_trie_root_hash, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
     assert(!ec);
 
+    if (old_trie_root_hash == keep_root_hash_) {
+        // e.g. blocks not changing state, all nodes are kept. its node diff is needed when the kept root is pruned later.
+        return;
+    }
+
+    if (trie_db->node_diff_enabled()) {
+        xtrie_node_diff_t diff;
+        if (ReadNodeDiff(trie_db->DiskDB(), old_trie_root_hash, diff)) {
+            // nodes written by the old root and nodes of its parent replaced by it. any of them not
+            // used by the kept trie is used by no retained root, since the kept root is the oldest one.
+            for (auto & node : diff.inserted) {
+                candidates_.emplace(node.first, std::move(node.second));
+            }
+            for (auto & node : diff.obsolete) {
+                candidates_.emplace(node.first, std::move(node.second));
+            }
+            pruned_diffs_.push_back(old_trie_root_hash);
+            return;
+        }
+        if (trie_db->node(old_trie_root_hash) == nullptr) {
+            // already pruned by a former round, e.g. same root shared by blocks of different rounds.
+            return;
+        }
+    }
+
+    if (!keep_loaded_) {
+        init(trie_db, ec);
+        if (ec) {
+            return;
+        }
+        keep_loaded_ = true;
+    }
     auto const trie_root = std::make_shared<xtrie_hash_node_t>(old_trie_root_hash);
     try_prune_trie_node(trie_root, trie_db, ec);
 }
 
+void xtop_trie_pruner::commit(std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
+    assert(!ec);
+
+    for (auto const & candidate : candidates_) {
+        std::error_code lookup_ec;
+        auto const kept_hash = kept_hash_at(candidate.second, trie_db, lookup_ec);
+        if (lookup_ec) {
+            // kept trie is not complete, never delete what cannot be proven unused.
+            xwarn("xtop_trie_pruner::commit lookup %s in kept trie failed: %s", candidate.first.as_hex_str().c_str(), lookup_ec.message().c_str());
+            continue;
+        }
+        if (kept_hash == candidate.first) {
+            continue;
+        }
+        trie_db->prune(candidate.first, ec);
+    }
+
+    trie_db->commit_pruned(ec);
+    if (ec) {
+        return;
+    }
+    if (!pruned_diffs_.empty()) {
+        DeleteNodeDiffs(trie_db->DiskDB(), pruned_diffs_, ec);
+    }
+    xinfo("xtop_trie_pruner::commit %zu node diffs consumed, %zu nodes checked", pruned_diffs_.size(), candidates_.size());
+
+    candidates_.clear();
+    pruned_diffs_.clear();
+    resolved_.clear();
+}
+
+xhash256_t xtop_trie_pruner::kept_hash_at(xbytes_t const & path, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
+    assert(!ec);
+
+    if (path.empty()) {
+        return keep_root_hash_;
+    }
+
+    auto node = keep_root_;
+    std::size_t pos{0};
+    while (node != nullptr) {
+        switch (node->type()) {  // NOLINT(clang-diagnostic-switch-enum)
+        case xtrie_node_type_t::hashnode: {
+            auto const hash_node = std::dynamic_pointer_cast<xtrie_hash_node_t>(node);
+            assert(hash_node != nullptr);
+
+            auto const hash = xhash256_t{hash_node->data()};
+            if (pos == path.size()) {
+                return hash;
+            }
+
+            xbytes_t const prefix{path.begin(), std::next(path.begin(), static_cast<std::ptrdiff_t>(pos))};
+            auto it = resolved_.find(prefix);
+            if (it == std::end(resolved_)) {
+                auto resolved = trie_db->node(hash);
+                if (resolved == nullptr) {
+                    ec = error::xerrc_t::trie_db_missing_node_error;
+                    return {};
+                }
+                it = resolved_.emplace(prefix, std::move(resolved)).first;
+            }
+            node = it->second;
+            break;
+        }
+
+        case xtrie_node_type_t::shortnode: {
+            if (pos == path.size()) {
+                return {};  // embedded into its parent, never stored apart
+            }
+            auto const short_node = std::dynamic_pointer_cast<xtrie_short_node_t>(node);
+            assert(short_node != nullptr);
+
+            auto const & key = short_node->key;
+            if (path.size() - pos < key.size() || !std::equal(key.begin(), key.end(), std::next(path.begin(), static_cast<std::ptrdiff_t>(pos)))) {
+                return {};
+            }
+            pos += key.size();
+            node = short_node->val;
+            break;
+        }
+
+        case xtrie_node_type_t::fullnode: {
+            if (pos == path.size() || path[pos] > 16) {
+                return {};
+            }
+            auto const full_node = std::dynamic_pointer_cast<xtrie_full_node_t>(node);
+            assert(full_node != nullptr);
+
+            node = full_node->Children[path[pos]];
+            ++pos;
+            break;
+        }
+
+        default: {
+            return {};
+        }
+        }
+    }
+    return {};
+}
+
 void xtop_trie_pruner::try_prune_trie_node(std::shared_ptr<xtrie_node_face_t> const & trie_node, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec) {
     assert(!ec);
 
@@ -221,6 +221,14 @@ void Sync::CommitUnit(xkv_db_face_ptr_t db) {
     return;
 }
 
+void Sync::CommitNodes(xkv_db_face_ptr_t const & db) {
+    if (membatch.hasNode(syncRoot.to_bytes())) {
+        return;
+    }
+    WriteTrieNodeBatch(db, membatch.nodes);
+    membatch.nodes.clear();
+}
+
 std::size_t Sync::Pending() const {
     return nodeReqs.size() + unitReqs.size();
 }
@@ -334,6 +342,12 @@ std::vector<std::shared_ptr<Sync::request>> Sync::children(std::shared_ptr<reque
             if (membatch.hasNode(hash.to_bytes())) {
                 continue;
             }
+            // If database says this is a duplicate, then at least the trie node is
+            // present, and sync only writes a node after its whole subtree. e.g.
+            // subtrees rebuilt from leaf ranges are only healed above them.
+            if (HasTrieNode(database, hash)) {
+                continue;
+            }
 
             auto new_req = std::make_shared<request>(child_p.first, hash, req->callback);
             new_req->parents.push_back(req);
@@ -161,15 +161,18 @@ std::pair<hash256, hash256> xethash_t::hashimoto_merkle(const hash256 & header_h
                                                         uint64_t nonce,
                                                         uint64_t header_number,
                                                         const std::vector<double_node_with_merkle_proof> & nodes) const {
-    std::unique_ptr<int> index{new int(0)};
+    size_t index{0};
     auto epoch = header_number / ETHASH_EPOCH_LENGTH;
-    auto merkle_root = m_dag_merkle_roots[epoch];
     if (epoch >= m_dag_merkle_roots.size()) {
         return {};
     }
+    auto const & merkle_root = m_dag_merkle_roots[epoch];
     auto lookup = [&](uint64_t offset){
-        auto node = nodes[*index];
-        *index += 1;
+        if (index >= nodes.size()) {
+            throw std::invalid_argument{"not enough dag nodes!"};
+        }
+        auto const & node = nodes[index];
+        index += 1;
         auto calc_root =  apply_merkle_proof(offset, node);
         if (merkle_root != calc_root) {
             throw std::invalid_argument{"merkle_root calculation mismatch!"};
@@ -190,6 +193,13 @@ std::pair<hash256, hash256> xethash_t::hashimoto_merkle(const hash256 & header_h
 }
 
 bool xethash_t::verify_seal(const xeth_header_t & header, const std::vector<double_node_with_merkle_proof> & nodes) {
+    auto header_hash = header.hash().asBytes();
+    std::string sealed_key{header_hash.begin(), header_hash.end()};
+    bool sealed{false};
+    if (m_sealed_headers.get(sealed_key, sealed)) {
+        return true;
+    }
+
     hash256 hash;
     std::memcpy(hash.bytes, header.hash_without_seal().data(), 32);
     hash256 mix_hash;
@@ -205,6 +215,7 @@ bool xethash_t::verify_seal(const xeth_header_t & header, const std::vector<doub
     if (!::ethash::check_against_difficulty(hashes.second, difficulty)) {
         return false;
     }
+    m_sealed_headers.put(sealed_key, true);
     return true;
 }
 
@@ -7,6 +7,28 @@
 
 NS_BEG2(top, evm_common)
 
+static bool intersects(std::set<std::string> const & lhs, std::set<std::string> const & rhs) {
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    while (l != lhs.end() && r != rhs.end()) {
+        if (*l < *r) {
+            ++l;
+        } else if (*r < *l) {
+            ++r;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool xevm_state_access_t::conflicts_with(xevm_state_access_t const & earlier) const {
+    if (opaque || earlier.opaque) {
+        return true;
+    }
+    return intersects(reads, earlier.writes) || intersects(writes, earlier.writes) || intersects(writes, earlier.reads);
+}
+
 xevm_log_t::xevm_log_t(common::xeth_address_t const& _address, xh256s_t const& _topics, xbytes_t const& _data) : address(_address), topics(_topics), data(_data) {
 }
 
@@ -4,6 +4,9 @@
 
 #include "xevm_common/xtriehash.h"
 #include "xevm_common/xtriecommon.h"
+#include "xevm_common/trie/xstack_trie.h"
+
+#include <algorithm>
 
 
 namespace top {
@@ -97,7 +100,38 @@ h256 hash256(BytesMap const& _s)
 	return sha3(rlp256(_s));
 }
 
+static xbytes_t const & itemBytes(xbytes_t const & _item) { return _item; }
+static xbytes_t itemBytes(bytesConstRef _item) { return _item.toBytes(); }
+
+// Keys of an ordered trie are rlp(index), which sort as rlp(1..0x7f), rlp(0), rlp(0x80..).
+// Items are fed to a stack trie in that order, so the root is hashed as keys go without
+// building the trie in memory.
+template <class T>
+static h256 orderedStackTrieRoot(std::vector<T> const & _data)
+{
+	static thread_local trie::xstack_trie_t st{nullptr};
+	st.Reset();
+	auto const update = [&_data](std::size_t i) { st.Update(xrlp(static_cast<unsigned>(i)), itemBytes(_data[i])); };
+	for (std::size_t i = 1; i < std::min<std::size_t>(_data.size(), 0x80); ++i)
+		update(i);
+	if (!_data.empty())
+		update(0);
+	for (std::size_t i = 0x80; i < _data.size(); ++i)
+		update(i);
+	return h256(st.Hash().to_bytes());
+}
+
+// stack trie does not take empty values, these are kept in the map build.
+template <class T>
+static bool hasEmptyItem(std::vector<T> const & _data)
+{
+	return std::any_of(_data.begin(), _data.end(), [](T const & i) { return i.empty(); });
+}
+
 h256 orderedTrieRoot(std::vector<xbytes_t> const & _data) {
+	if (!hasEmptyItem(_data))
+		return orderedStackTrieRoot(_data);
+
 	BytesMap m;
 	unsigned j = 0;
 	for (auto i: _data)
@@ -108,6 +142,9 @@ h256 orderedTrieRoot(std::vector<xbytes_t> const & _data) {
 
 h256 orderedTrieRoot(std::vector<bytesConstRef> const& _data)
 {
+	if (!hasEmptyItem(_data))
+		return orderedStackTrieRoot(_data);
+
 	BytesMap m;
 	unsigned j = 0;
 	for (auto i: _data)
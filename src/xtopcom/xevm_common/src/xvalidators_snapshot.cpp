@@ -1,6 +1,7 @@
 #include "xevm_common/xcrosschain/xvalidators_snapshot.h"
 
 #include "xbasic/xhex.h"
+#include "xbasic/xlru_cache.h"
 #include "xcrypto/xckey.h"
 #include "xevm_common/rlp.h"
 #include "xutility/xhash.h"
@@ -192,6 +193,26 @@ static xbytes_t ecrecover(const xeth_header_t & header, const bigint chainid) {
     return {digest.begin() + 12, digest.end()};
 }
 
+// the signer only depends on the header and the chain id, so it is kept by both. relayers send the
+// same headers to every node again when a sync tx fails, and forks share their recent headers.
+static xbytes_t cached_ecrecover(const xeth_header_t & header, h256 const & header_hash, const bigint * chainid) {
+    static basic::xlru_cache<std::string, xbytes_t> signers{1024};
+    auto hash_bytes = header_hash.asBytes();
+    std::string key{hash_bytes.begin(), hash_bytes.end()};
+    if (chainid != nullptr) {
+        key += chainid->str();
+    }
+    xbytes_t signer;
+    if (signers.get(key, signer)) {
+        return signer;
+    }
+    signer = (chainid != nullptr) ? ecrecover(header, *chainid) : ecrecover(header);
+    if (!signer.empty()) {
+        signers.put(key, signer);
+    }
+    return signer;
+}
+
 bool xvalidators_snapshot_t::init_with_epoch(const xeth_header_t & header) {
     if (header.number % epoch != 0) {
         xwarn("[xvalidators_snapshot_t::init_with_epoch] not epoch header");
@@ -223,7 +244,8 @@ bool xvalidators_snapshot_t::apply(const xeth_header_t & header, bool check_intu
     if (height >= limit) {
         recents.erase(static_cast<uint64_t>(height - limit));
     }
-    auto validator = ecrecover(header);
+    auto header_hash = header.hash();
+    auto validator = cached_ecrecover(header, header_hash, nullptr);
     xinfo("[xvalidators_snapshot_t::apply] number: %s, validator: %s", height.str().c_str(), to_hex(validator).c_str());
 
     if (!validators.count(validator)) {
@@ -274,7 +296,7 @@ bool xvalidators_snapshot_t::apply(const xeth_header_t & header, bool check_intu
         }
     }
 
-    hash = header.hash();
+    hash = header_hash;
     return true;
 }
 
@@ -288,7 +310,8 @@ bool xvalidators_snapshot_t::apply_with_chainid(const xeth_header_t & header, co
     if (height >= limit) {
         recents.erase(static_cast<uint64_t>(height - limit));
     }
-    auto validator = ecrecover(header, chainid);
+    auto header_hash = header.hash();
+    auto validator = cached_ecrecover(header, header_hash, &chainid);
     xinfo("[xvalidators_snapshot_t::apply_with_chainid] number: %s, validator: %s", height.str().c_str(), to_hex(validator).c_str());
 
     if (!validators.count(validator)) {
@@ -339,7 +362,7 @@ bool xvalidators_snapshot_t::apply_with_chainid(const xeth_header_t & header, co
         }
     }
 
-    hash = header.hash();
+    hash = header_hash;
     return true;
 }
 
@@ -113,6 +113,13 @@ public:
         return m_trie->prove(key, fromLevel, proofDB, ec);
     }
 
+    // prove_multi constructs one merkle proof for all keys in a single trie walk, see xtrie_t::prove_multi.
+    // Like prove, keys are trie keys, i.e. already hashed by the caller.
+    bool prove_multi(std::vector<xbytes_t> const & keys, xkv_db_face_ptr_t const & proof_db, std::error_code & ec) const {
+        assert(m_trie != nullptr);
+        return m_trie->prove_multi(keys, proof_db, ec);
+    }
+
     void prune(xhash256_t const & old_trie_root_hash, std::error_code & ec) override;
 
     void commit_pruned(std::error_code & ec) override;
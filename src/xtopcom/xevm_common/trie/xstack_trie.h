@@ -39,6 +39,8 @@ public:
     }
 
 public:
+    // NewStackTrie allocates and initializes an empty trie. db may be null, then nodes
+    // are only hashed and never stored.
     static std::shared_ptr<xtop_stack_trie> NewStackTrie(xkv_db_face_ptr_t db);
 
 public:
@@ -73,6 +75,9 @@ public:
     // functionality should be disabled.
     xhash256_t Commit(std::error_code & ec);
 
+    // Reset empties the trie so it can be reused for another set of keys, db is kept.
+    void Reset();
+
 public:
     xstack_trie_node_type_t type() {
         return m_type;
@@ -11,6 +11,7 @@
 #include "xevm_common/trie/xtrie_pruner_fwd.h"
 
 #include <tuple>
+#include <unordered_map>
 
 NS_BEG3(top, evm_common, trie)
 
@@ -28,6 +29,10 @@ private:
     std::unique_ptr<xtrie_pruner_t> pruner_;
 
     std::size_t unhashed_{0};
+    std::size_t uncommitted_{0};  // Count of updates since last commit, decides if commit goes parallel
+
+    xhash256_t origin_;                                  // Root hash the trie is opened from or last committed to
+    std::unordered_map<xhash256_t, xbytes_t> obsolete_;  // Stored nodes replaced since last commit, hash -> hex path
 
 public:
     xtop_trie(xtop_trie const &) = delete;
@@ -44,6 +49,10 @@ public:
 
     static std::shared_ptr<xtop_trie> build_from(xhash256_t hash, std::shared_ptr<xtrie_db_t> db, std::error_code & ec);
 
+    // build_from_root_node opens a trie on an already resolved root node, e.g. one
+    // recovered from merkle proofs. A null root opens an empty trie.
+    static std::shared_ptr<xtop_trie> build_from_root_node(xtrie_node_face_ptr_t root, std::shared_ptr<xtrie_db_t> db);
+
     // Reset drops the referenced root node and cleans all internal state.
     void reset();
 
@@ -102,6 +111,18 @@ public:
     // with the node that proves the absence of the key.
     bool prove(xbytes_t const & key, uint32_t from_level, xkv_db_face_ptr_t const & proof_db, std::error_code & ec) const;
 
+    // prove_multi constructs one merkle proof for all keys in a single walk from the root. Nodes on the common
+    // prefixes of keys are resolved, hashed and put into proof_db only once, so the proof is the union of the
+    // single key proofs without duplicates. Each key is verified by VerifyProof against the same proof_db, keys
+    // not in the trie are proven absent the same way as by prove.
+    bool prove_multi(std::vector<xbytes_t> const & keys, xkv_db_face_ptr_t const & proof_db, std::error_code & ec) const;
+
+    // Range collects leaves in key order, starting from the first key not less than
+    // origin, until max_count leaves or max_bytes of keys and values are collected.
+    // Leaves returned with the proofs of origin and of the last key can be verified
+    // by VerifyRangeProof.
+    void range(xbytes_t const & origin, std::size_t max_count, std::size_t max_bytes, std::vector<xbytes_t> & keys, std::vector<xbytes_t> & values, std::error_code & ec) const;
+
     void prune(xhash256_t const & old_trie_root_hash, std::error_code & ec);
     void commit_pruned(std::error_code & ec);
 
@@ -147,6 +168,23 @@ private:
 
     xbytes_t resolve_blob(std::shared_ptr<xtrie_hash_node_t> const & n, std::error_code & ec) const;
 
+    struct range_result {
+        std::size_t max_count;
+        std::size_t max_bytes;
+        std::size_t bytes;
+        std::vector<xbytes_t> & keys;
+        std::vector<xbytes_t> & values;
+    };
+    // bounded means path is still a prefix of origin. returns false once range is full.
+    bool range(xtrie_node_face_ptr_t const & node, xbytes_t & path, xbytes_t const & origin, bool bounded, range_result & result, std::error_code & ec) const;
+
+    // collect nodes under node on the paths to keys, in pre-order. key_paths are sorted hex keys with the nibbles
+    // above node consumed, so keys sharing a child are adjacent and the child is visited once for all of them.
+    void collect_proof_nodes(xtrie_node_face_ptr_t const & node, std::vector<xbytes_t> const & key_paths, std::vector<xtrie_node_face_ptr_t> & nodes, std::error_code & ec) const;
+
+    // supersede records that the clean node at path is replaced, if node diff is enabled
+    void supersede(xtrie_node_face_ptr_t const & node, xbytes_t const & path);
+
     // hashRoot calculates the root hash of the given trie
     std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> hash_root();
 
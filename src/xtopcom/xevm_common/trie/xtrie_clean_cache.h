@@ -0,0 +1,72 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xbyte_buffer.h"
+#include "xbasic/xhash.hpp"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG3(top, evm_common, trie)
+
+// clean cache holds encoded trie nodes already persisted on disk, keyed by node hash.
+// it is split into shards (selected by node hash, which is uniformly distributed) with
+// one lock each, and bounded by total bytes of cached nodes instead of node count.
+class xtop_trie_clean_cache {
+public:
+    static constexpr std::size_t default_shard_count{16};
+
+private:
+    using xitem_list_t = std::list<std::pair<xhash256_t, xbytes_t>>;
+
+    struct xtop_shard {
+        std::mutex mutex;
+        xitem_list_t items;  // front is the most recently used
+        std::unordered_map<xhash256_t, xitem_list_t::iterator> index;
+        std::size_t bytes{0};
+    };
+    using xshard_t = xtop_shard;
+
+    std::vector<std::unique_ptr<xshard_t>> shards_;
+    std::size_t const shard_capacity_;
+
+public:
+    xtop_trie_clean_cache(xtop_trie_clean_cache const &) = delete;
+    xtop_trie_clean_cache & operator=(xtop_trie_clean_cache const &) = delete;
+    xtop_trie_clean_cache(xtop_trie_clean_cache &&) = delete;
+    xtop_trie_clean_cache & operator=(xtop_trie_clean_cache &&) = delete;
+    ~xtop_trie_clean_cache() = default;
+
+    explicit xtop_trie_clean_cache(std::size_t capacity_bytes, std::size_t shard_count = default_shard_count);
+
+    bool get(xhash256_t const & hash, xbytes_t & enc);
+    bool contains(xhash256_t const & hash) const;
+    void put(xhash256_t const & hash, xbytes_t const & enc);
+    void erase(xhash256_t const & hash);
+
+    std::size_t size() const;
+    std::size_t size_bytes() const;
+    std::size_t capacity_bytes() const noexcept;
+
+    // journal keeps cached nodes on disk to survive node restarts. entries are written
+    // from the least recently used one, so loading restores the same recency order.
+    void save_journal(std::string const & path, std::error_code & ec) const;
+    void load_journal(std::string const & path, std::error_code & ec);
+
+private:
+    xshard_t & shard_of(xhash256_t const & hash) const;
+    static std::size_t entry_bytes(xbytes_t const & enc) noexcept;
+};
+using xtrie_clean_cache_t = xtop_trie_clean_cache;
+using xtrie_clean_cache_ptr_t = std::shared_ptr<xtrie_clean_cache_t>;
+
+NS_END3
@@ -7,24 +7,47 @@
 #include "xevm_common/trie/xtrie_db.h"
 #include "xevm_common/trie/xtrie_node.h"
 
+#include <vector>
+
 NS_BEG3(top, evm_common, trie)
 
+// committer collects collapsed nodes into its own buffer and hands them to the
+// database by one batch insert after the whole trie is walked. In parallel mode
+// the dirty children of the first full node are committed by worker committers.
 class xtop_trie_committer {
+private:
+    bool m_parallel{false};
+    std::vector<xtrie_committed_node_t> m_nodes;  // children always precede parents
+
+public:
+    xtop_trie_committer() = default;
+    xtop_trie_committer(bool parallel, std::size_t expected_nodes);
+
 public:
     // Commit collapses a node down into a hash node and inserts it into the database
     std::pair<xtrie_hash_node_ptr_t, int32_t> Commit(xtrie_node_face_ptr_t const & n, xtrie_db_ptr_t db, std::error_code & ec);
 
+    // nodes inserted into database by the last Commit
+    std::vector<xtrie_committed_node_t> const & committed_nodes() const noexcept;
+
 private:
-    // commit collapses a node down into a hash node and inserts it into the database
-    std::pair<xtrie_node_face_ptr_t, int32_t> commit(xtrie_node_face_ptr_t const & n, xtrie_db_ptr_t db, std::error_code & ec);
+    // commit collapses a node at the given hex path down into a hash node and collects it into the buffer
+    std::pair<xtrie_node_face_ptr_t, int32_t> commit(xtrie_node_face_ptr_t const & n, xbytes_t const & path, std::error_code & ec);
 
     // commitChildren commits the children of the given fullnode
-    std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> commitChildren(xtrie_full_node_ptr_t n, xtrie_db_ptr_t db, std::error_code & ec);
-
-    // store hashes the node n and if we have a storage layer specified, it writes
-    // the key/value pair to it and tracks any node->child references as well as any
-    // node->external trie references.
-    xtrie_node_face_ptr_t store(xtrie_node_face_ptr_t n, xtrie_db_ptr_t db);
+    std::pair<std::array<xtrie_node_face_ptr_t, 17>, int32_t> commitChildren(xtrie_full_node_ptr_t n, xbytes_t const & path, std::error_code & ec);
+
+    // commitChildrenParallel commits the children of the given indexes on worker threads,
+    // then appends their buffers to this one.
+    int32_t commitChildrenParallel(xtrie_full_node_ptr_t const & n,
+                                   xbytes_t const & path,
+                                   std::vector<std::size_t> const & indexes,
+                                   std::array<xtrie_node_face_ptr_t, 17> & children,
+                                   std::error_code & ec);
+
+    // store hashes the node n and if it is not embedded into parent, collects the
+    // node into the buffer, which is inserted into database at the end of Commit.
+    xtrie_node_face_ptr_t store(xtrie_node_face_ptr_t n, xbytes_t const & path);
 
 private:
     // estimateSize estimates the size of an rlp-encoded node, without actually
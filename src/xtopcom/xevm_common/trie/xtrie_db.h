@@ -5,14 +5,16 @@
 #pragma once
 
 #include "xbasic/xhash.hpp"
-#include "xbasic/xlru_cache_specialize.h"
+#include "xevm_common/trie/xtrie_clean_cache.h"
 #include "xevm_common/trie/xtrie_db_fwd.h"
 #include "xevm_common/trie/xtrie_kv_db_face.h"
 #include "xevm_common/trie/xtrie_node_fwd.h"
 
 #include <functional>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 NS_BEG3(top, evm_common, trie)
 
@@ -24,6 +26,8 @@ public:
     uint64_t Cache_size{0};   // Memory allowance (MB) to use for caching trie nodes in memory
     std::string Journal{""};  // Journal of clean cache to survive node restarts
     bool Preimages{true};     // Flag whether the preimage of trie key is recorded
+    xtrie_clean_cache_ptr_t Clean_cache{nullptr};  // Clean cache shared with other trie dbs over the same disk db, Cache_size is ignored if set
+    bool Node_diff{false};    // Flag whether each trie commit records its node diff for incremental pruning
 };
 using xtrie_db_config_t = xtop_trie_db_config;
 using xtrie_db_config_ptr_t = std::shared_ptr<xtrie_db_config_t>;
@@ -32,14 +36,25 @@ using xtrie_db_config_ptr_t = std::shared_ptr<xtrie_db_config_t>;
 class xtop_trie_cache_node;
 using xtrie_cache_node_t = xtop_trie_cache_node;
 
+// collapsed node produced by trie committer, waiting to be inserted into trie db
+struct xtop_trie_committed_node {
+    xhash256_t hash;
+    int32_t size{0};
+    xtrie_node_face_ptr_t node;
+    xbytes_t path;  // hex path from trie root
+};
+using xtrie_committed_node_t = xtop_trie_committed_node;
+
 class xtop_trie_db {
 private:
     friend class xtop_trie_cache_node;
     xkv_db_face_ptr_t diskdb_;  // Persistent storage for matured trie nodes
 
-    // std::map<xhash256_t, xbytes_t> cleans_;
-    basic::xlru_cache_specialize<xhash256_t, xbytes_t> cleans_{2000}; // TODO(jimmy) 10000
-    std::map<xhash256_t, xtrie_cache_node_t> dirties_;
+    xtrie_clean_cache_ptr_t cleans_;  // Byte-bounded cache of encoded nodes already on disk
+    std::string journal_;             // Clean cache is saved here on destruction if not empty
+    bool node_diff_{false};           // Trie commits record node diffs, see xtrie_node_diff_t
+    std::unordered_map<xhash256_t, xtrie_cache_node_t> dirties_;
+    uint64_t dirties_size_{0};        // Memory of dirties_, reported to basic::xmemory_accounting_t with the other trie dbs
     std::unordered_set<xhash256_t> pruned_hashes_;
 
     xhash256_t oldest_;
@@ -48,8 +63,9 @@ private:
     std::map<xhash256_t, xbytes_t> preimages_;  // Preimages of nodes from the secure trie
 
 public:
-    explicit xtop_trie_db(xkv_db_face_ptr_t diskdb) : diskdb_(std::move(diskdb)) {
-    }
+    explicit xtop_trie_db(xkv_db_face_ptr_t diskdb);
+    xtop_trie_db(xkv_db_face_ptr_t diskdb, xtrie_clean_cache_ptr_t cleans, std::string journal, bool node_diff = false);
+    ~xtop_trie_db();
 
 public:
     // NewDatabase creates a new trie database to store ephemeral trie content before
@@ -67,6 +83,17 @@ public:
         return diskdb_;
     }
 
+    xtrie_clean_cache_ptr_t const & CleanCache() const noexcept {
+        return cleans_;
+    }
+
+    bool node_diff_enabled() const noexcept {
+        return node_diff_;
+    }
+
+    // SaveCache atomically saves clean cache content to the given path.
+    void SaveCache(std::string const & path, std::error_code & ec) const;
+
 public:
     // insert inserts a collapsed trie node into the memory database.
     // The blob size must be specified to allow proper size tracking.
@@ -74,6 +101,10 @@ public:
     // and in theory should only used for **trie nodes** insertion.
     void insert(xhash256_t hash, int32_t size, xtrie_node_face_ptr_t const & node);
 
+    // insert_batch inserts all nodes collected by one trie commit. Children must
+    // precede their parents, so that reference tracking sees them already inserted.
+    void insert_batch(std::vector<xtrie_committed_node_t> const & nodes);
+
     // insertPreimage writes a new trie node pre-image to the memory database if it's
     // yet unknown. The method will NOT make a copy of the slice,
     // only use if the preimage will NOT be changed later on.
@@ -89,6 +120,10 @@ public:
     // cached, the method queries the persistent database for the content.
     xbytes_t Node(xhash256_t hash, std::error_code & ec);
 
+    // prefetch loads nodes missing from memory cache by one batch read of the
+    // persistent database and puts them into the clean cache.
+    void prefetch(std::vector<xhash256_t> const & hashes);
+
     xbytes_t preimage(xhash256_t hash) const;
 
     using AfterCommitCallback = std::function<void(xhash256_t const &)>;
@@ -6,14 +6,24 @@
 
 #include "xevm_common/trie/xtrie_node.h"
 
+#include <vector>
+
 NS_BEG3(top, evm_common, trie)
 
 class xtop_trie_hasher {
+    // 17 items of 33 bytes at most, plus a list header.
+    static constexpr std::size_t full_node_encoded_size{17 * 33 + 3};
+
     class sliceBuffer {
     private:
         xbytes_t m_data;
 
     public:
+        sliceBuffer() {
+            // large enough for a full node of hash children, nodes are encoded into it without growing.
+            m_data.reserve(full_node_encoded_size);
+        }
+
         std::size_t Write(xbytes_t const & data) {
             m_data.insert(m_data.end(), data.begin(), data.end());
             return m_data.size();
@@ -71,6 +81,14 @@ private:
 
     std::pair<xtrie_full_node_ptr_t, xtrie_full_node_ptr_t> hashFullNodeChildren(xtrie_full_node_ptr_t node);
 
+    // hashes the dirty children of a full node together, as the serial counterpart of the parallel root level.
+    void hashChildrenBatch(xtrie_full_node_ptr_t const & node,
+                           xtrie_full_node_ptr_t const & collapsed,
+                           xtrie_full_node_ptr_t const & cached,
+                           std::vector<std::size_t> const & dirty_children);
+    // collapses the children of a short or full node and encodes it, leaving the hashing to the caller.
+    std::pair<xtrie_node_face_ptr_t, xtrie_node_face_ptr_t> collapse(xtrie_node_face_ptr_t const & node, xbytes_t & encoded);
+    static void setCachedHash(xtrie_node_face_ptr_t const & cached, xtrie_hash_node_ptr_t hash_node);
     xtrie_node_face_ptr_t shortnodeToHash(xtrie_short_node_ptr_t node, bool force);
 
     xtrie_node_face_ptr_t fullnodeToHash(xtrie_full_node_ptr_t node, bool force);
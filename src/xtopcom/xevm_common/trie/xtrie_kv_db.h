@@ -19,6 +19,7 @@ public:
 
     xbytes_t Get(xbytes_t const & key, std::error_code & ec) override;
     xbytes_t GetDirect(xbytes_t const & key, std::error_code & ec) override;
+    std::vector<xbytes_t> GetBatch(std::vector<xbytes_t> const & keys, std::error_code & ec) override;
 
     bool Has(xbytes_t const & key, std::error_code & ec) override;
     bool HasDirect(xbytes_t const & key, std::error_code & ec) override;
@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <system_error>
+#include <vector>
 
 NS_BEG3(top, evm_common, trie)
 
@@ -36,6 +37,16 @@ public:
     virtual bool HasDirect(xbytes_t const & key, std::error_code & ec) = 0;
     virtual xbytes_t Get(xbytes_t const & key, std::error_code & ec) = 0;
     virtual xbytes_t GetDirect(xbytes_t const & key, std::error_code & ec) = 0;
+    // batch version of Get, result[i] is empty if keys[i] is not found.
+    virtual std::vector<xbytes_t> GetBatch(std::vector<xbytes_t> const & keys, std::error_code & ec) {
+        std::vector<xbytes_t> values;
+        values.reserve(keys.size());
+        for (auto const & key : keys) {
+            std::error_code _;
+            values.push_back(Get(key, _));
+        }
+        return values;
+    }
 };
 using xkv_reader_face_t = xtop_kv_reader_face;
 
@@ -96,6 +107,16 @@ inline xbytes_t ReadTrieNode(xkv_db_face_ptr_t db, xhash256_t const & hash) {
     return db->Get(hash.to_bytes(), _);
 }
 
+inline std::vector<xbytes_t> ReadTrieNodeBatch(xkv_db_face_ptr_t db, std::vector<xhash256_t> const & hashes) {
+    std::error_code _;
+    std::vector<xbytes_t> keys;
+    keys.reserve(hashes.size());
+    for (auto const & hash : hashes) {
+        keys.push_back(hash.to_bytes());
+    }
+    return db->GetBatch(keys, _);
+}
+
 inline bool HasTrieNode(xkv_db_face_ptr_t db, xhash256_t const & hash) {
     std::error_code _;
     return db->Has(hash.to_bytes(), _);
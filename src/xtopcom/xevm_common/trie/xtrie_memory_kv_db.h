@@ -0,0 +1,44 @@
+// Copyright (c) 2022-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xevm_common/trie/xtrie_kv_db_face.h"
+
+#include <map>
+
+NS_BEG3(top, evm_common, trie)
+
+// in-memory kv db, e.g. to carry merkle proofs or to buffer nodes before one batch write.
+// direct keys share the same space with normal keys. not thread safe.
+class xtop_memory_kv_db : public xkv_db_face_t {
+public:
+    xbytes_t Get(xbytes_t const & key, std::error_code & ec) override;
+    xbytes_t GetDirect(xbytes_t const & key, std::error_code & ec) override;
+
+    bool Has(xbytes_t const & key, std::error_code & ec) override;
+    bool HasDirect(xbytes_t const & key, std::error_code & ec) override;
+
+    void Put(xbytes_t const & key, xbytes_t const & value, std::error_code & ec) override;
+    void PutBatch(std::map<xbytes_t, xbytes_t> const & batch, std::error_code & ec) override;
+    void PutDirect(xbytes_t const & key, xbytes_t const & value, std::error_code & ec) override;
+    void PutDirectBatch(std::map<xbytes_t, xbytes_t> const & batch, std::error_code & ec) override;
+
+    void Delete(xbytes_t const & key, std::error_code & ec) override;
+    void DeleteBatch(std::vector<xbytes_t> const & batch, std::error_code & ec) override;
+    void DeleteDirect(xbytes_t const & key, std::error_code & ec) override;
+    void DeleteDirectBatch(std::vector<xbytes_t> const & batch, std::error_code & ec) override;
+
+    std::map<xbytes_t, xbytes_t> const & data() const noexcept;
+    std::vector<xbytes_t> values() const;
+    std::size_t value_bytes() const noexcept;
+    void clear() noexcept;
+
+private:
+    std::map<xbytes_t, xbytes_t> m_data;
+    std::size_t m_value_bytes{0};
+};
+using xmemory_kv_db_t = xtop_memory_kv_db;
+
+NS_END3
@@ -0,0 +1,38 @@
+// Copyright (c) 2022-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xbyte_buffer.h"
+#include "xbasic/xhash.hpp"
+#include "xevm_common/trie/xtrie_kv_db_face.h"
+
+#include <system_error>
+#include <unordered_map>
+
+NS_BEG3(top, evm_common, trie)
+
+// node diff records what one trie commit did to the stored nodes: nodes written by
+// it and nodes of the parent root it replaced. both are keyed by node hash, valued
+// by the hex path of the node, so a pruner can check a node against the kept trie
+// by one walk down that path instead of loading the whole kept trie.
+struct xtop_trie_node_diff {
+    xhash256_t parent;
+    std::unordered_map<xhash256_t, xbytes_t> inserted;
+    std::unordered_map<xhash256_t, xbytes_t> obsolete;
+
+    xbytes_t encode() const;
+    void decode(xbytes_t const & data, std::error_code & ec);
+};
+using xtrie_node_diff_t = xtop_trie_node_diff;
+
+xbytes_t node_diff_key(xhash256_t const & root);
+
+// ReadNodeDiff returns false if no node diff is recorded for root, e.g. root committed
+// before node diff is enabled, or it is already pruned.
+bool ReadNodeDiff(xkv_db_face_ptr_t const & db, xhash256_t const & root, xtrie_node_diff_t & diff);
+void WriteNodeDiff(xkv_db_face_ptr_t const & db, xhash256_t const & root, xtrie_node_diff_t const & diff, std::error_code & ec);
+void DeleteNodeDiffs(xkv_db_face_ptr_t const & db, std::vector<xhash256_t> const & roots, std::error_code & ec);
+
+NS_END3
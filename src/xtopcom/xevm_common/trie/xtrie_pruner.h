@@ -9,26 +9,46 @@
 #include "xevm_common/trie/xtrie_node_fwd.h"
 #include "xevm_common/trie/xtrie_pruner_fwd.h"
 
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 NS_BEG3(top, evm_common, trie)
 
+// pruner deletes nodes of old roots not used by the kept trie. if the old root has a node diff
+// recorded at its commit, only nodes in that diff are checked, each by one walk of the kept trie
+// down to the node path, so the cost scales with the churn of the pruned roots. otherwise it
+// falls back to load the whole kept trie and walk the old trie.
 class xtop_trie_pruner {
-    std::unordered_set<xhash256_t> trie_node_hashes_;
+    xtrie_node_face_ptr_t keep_root_;
+    xhash256_t keep_root_hash_;
+    bool keep_loaded_{false};
+    std::unordered_set<xhash256_t> trie_node_hashes_;      // all nodes of the kept trie, only loaded for old roots without node diff
+    std::unordered_map<xhash256_t, xbytes_t> candidates_;  // nodes from node diffs of old roots, hash -> hex path
+    std::vector<xhash256_t> pruned_diffs_;                 // old roots whose node diffs are consumed
+    std::map<xbytes_t, xtrie_node_face_ptr_t> resolved_;   // kept trie nodes resolved by path
 
 public:
-    xtop_trie_pruner() = default;
     xtop_trie_pruner(xtop_trie_pruner const &) = delete;
     xtop_trie_pruner & operator=(xtop_trie_pruner const &) = delete;
     xtop_trie_pruner(xtop_trie_pruner &&) = default;
     xtop_trie_pruner & operator=(xtop_trie_pruner &&) = default;
     ~xtop_trie_pruner() = default;
 
-    void init(std::shared_ptr<xtrie_node_face_t> const & trie_root, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
+    xtop_trie_pruner(xtrie_node_face_ptr_t keep_root, xhash256_t const & keep_root_hash);
 
     void prune(xhash256_t const & old_trie_root_hash, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
 
+    // commit deletes pruned nodes from disk, then node diffs consumed by this round.
+    void commit(std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
+
 private:
+    void init(std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
+
+    // hash of the stored node at path of the kept trie, empty if there is none.
+    xhash256_t kept_hash_at(xbytes_t const & path, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
+
     std::shared_ptr<xtrie_node_face_t> load_trie_node(std::shared_ptr<xtrie_node_face_t> const & trie_node, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
     std::shared_ptr<xtrie_short_node_t> load_short_node(std::shared_ptr<xtrie_short_node_t> const & short_node, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
     std::shared_ptr<xtrie_full_node_t> load_full_node(std::shared_ptr<xtrie_full_node_t> const & full_node, std::shared_ptr<xtrie_db_t> const & trie_db, std::error_code & ec);
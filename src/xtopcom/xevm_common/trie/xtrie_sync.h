@@ -145,6 +145,11 @@ public:
 
     void CommitUnit(xkv_db_face_ptr_t db);
 
+    // CommitNodes flushes completed nodes in the membatch before the sync finishes.
+    // A node is completed only after all its children, so any node on disk always
+    // has a complete subtree. The root is left to Commit, so it is written last.
+    void CommitNodes(xkv_db_face_ptr_t const & db);
+
     // Pending returns the number of state entries currently pending for download.
     std::size_t Pending() const;
 
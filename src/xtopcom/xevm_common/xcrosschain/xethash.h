@@ -1,5 +1,6 @@
 #pragma once
 
+#include "xbasic/xlru_cache.h"
 #include "xdepends/include/ethash/ethash.hpp"
 #include "xevm_common/fixed_hash.h"
 #include "xevm_common/xcrosschain/xeth_header.h"
@@ -38,6 +39,8 @@ private:
     h128 apply_merkle_proof(const uint64_t index, const double_node_with_merkle_proof & node) const;
 
     std::vector<h128> m_dag_merkle_roots;
+    // hashes of headers whose seal passed. the seal only depends on the header, the nodes are just the proof
+    basic::xlru_cache<std::string, bool> m_sealed_headers{1024};
 };
 
 NS_END3
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "xevm_common/xbloom9.h"
 #include "xevm_common/xfixed_hash.h"
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,26 @@ enum xevm_transaction_status_t : uint32_t {
     Invalid = 32,
 };
 
+/// state keys read and written by one evm tx: storage slots and code by their storage key, nonce and
+/// balance by the 20 bytes account address. sys contract calls change states out of these keys, so
+/// a tx making one is opaque and conflicts with every other tx.
+class xevm_state_access_t {
+public:
+    void add_read(std::string const & key) {
+        reads.insert(key);
+    }
+    void add_write(std::string const & key) {
+        writes.insert(key);
+    }
+
+    /// whether the result of this tx may depend on the order against an earlier tx
+    bool conflicts_with(xevm_state_access_t const & earlier) const;
+
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+    bool opaque{false};
+};
+
 class xevm_transaction_result_t {
  public:
     xevm_transaction_result_t(){}
@@ -64,6 +85,7 @@ class xevm_transaction_result_t {
         status = evm_transaction_result.status;
         extra_msg = evm_transaction_result.extra_msg;
         logs = evm_transaction_result.logs;
+        access = evm_transaction_result.access;
     }
 
     xevm_transaction_result_t & operator = (const xevm_transaction_result_t & evm_transaction_result) {
@@ -71,6 +93,7 @@ class xevm_transaction_result_t {
         status = evm_transaction_result.status;
         extra_msg = evm_transaction_result.extra_msg;
         logs = evm_transaction_result.logs;
+        access = evm_transaction_result.access;
         return *this;
     }
 
@@ -79,6 +102,7 @@ public:
     xevm_transaction_status_t status{Invalid};
     std::string extra_msg;
     std::vector<xevm_log_t> logs;
+    xevm_state_access_t access;  // only kept in memory for the batch, never serialized
 
     void set_status(uint32_t input) {
         status = static_cast<xevm_transaction_status_t>(input);
@@ -6,16 +6,38 @@
 
 #include "xbasic/xhex.h"
 #include "xcommon/xeth_address.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xevm_contract_runtime/xevm_action_session.h"
 #include "xevm_contract_runtime/xevm_context.h"
 #include "xevm_contract_runtime/xevm_logic.h"
 #include "xevm_contract_runtime/xevm_storage.h"
 #include "xevm_runner/evm_engine_interface.h"
 #include "xevm_runner/evm_import_instance.h"
+#include "xevm_runner/evm_profile.h"
 #include "xevm_runner/proto/proto_parameters.pb.h"
+#include "xmetrics/xmetrics.h"
+
+#include <string>
 
 NS_BEG2(top, contract_runtime)
 
+namespace {
+
+void export_profile(top::evm::xevm_profile_t const & profile) {
+#ifdef ENABLE_METRICS
+    for (std::size_t i = 0; i < top::evm::xevm_profile_t::class_count; ++i) {
+        auto const labels = top::metrics::metrics_labels({{"class", top::evm::to_string(static_cast<top::evm::xevm_import_class_t>(i))}});
+        XMETRICS_COUNTER_INCREMENT("evm_profile_import_calls" + labels, profile.calls[i]);
+        XMETRICS_COUNTER_INCREMENT("evm_profile_import_us" + labels, profile.nanos[i] / 1000);
+    }
+    XMETRICS_COUNTER_INCREMENT("evm_profile_executions", profile.executions);
+    XMETRICS_COUNTER_INCREMENT("evm_profile_engine_us", profile.engine_nanos() / 1000);
+#endif
+}
+
+}  // namespace
+
 xtop_action_runtime<data::xevm_consensus_action_t>::xtop_action_runtime(observer_ptr<evm::xevm_contract_manager_t> const evm_contract_manager,
                                                                         statectx::xstatectx_face_ptr_t const statectx) noexcept
   : evm_contract_manager_{evm_contract_manager}, m_evm_statectx{statectx} {
@@ -32,22 +54,34 @@ evm_common::xevm_transaction_result_t xtop_action_runtime<data::xevm_consensus_a
 
     // try {
 
-    auto storage = top::make_unique<evm::xevm_storage>(m_evm_statectx);
-    std::shared_ptr<top::evm::xevm_logic_face_t> logic_ptr =
-        std::make_shared<top::contract_runtime::evm::xevm_logic_t>(std::move(storage), m_evm_statectx, tx_ctx, evm_contract_manager_);
+    auto storage = top::make_unique<evm::xevm_storage>(m_evm_statectx, tx_ctx->dry_run());
+    auto logic_ptr = std::make_shared<top::contract_runtime::evm::xevm_logic_t>(std::move(storage), m_evm_statectx, tx_ctx, evm_contract_manager_);
     top::evm::evm_import_instance::instance()->add_evm_logic(logic_ptr);
 
     bool evm_result{true};
 
-    // if deploy, get code and src from action, call 'deploy_code()'
-    if (tx_ctx->action_type() == data::xtop_evm_action_type::deploy_contract) {
-        evm_result = deploy_code();
+    // sampled executions export their profile to metrics, a thread that profiles itself (benchmarks) is left alone
+    bool const sampled = !top::evm::xevm_profiler_t::enabled() && top::evm::xevm_profiler_t::sample(XGET_CONFIG(evm_profile_sample_rate));
+    if (sampled) {
+        top::evm::xevm_profiler_t::profile().reset();
+        top::evm::xevm_profiler_t::enable(true);
     }
-    // if call, get code from evm manager(lru_cache) or state(state_accessor), get src and target address, call 'call_contract()'
-    else if (tx_ctx->action_type() == data::xtop_evm_action_type::call_contract) {
-        evm_result = call_contract();
-    } else {
-        xassert(false);
+    {
+        top::evm::xevm_execution_scope_t execution_scope;
+        // if deploy, get code and src from action, call 'deploy_code()'
+        if (tx_ctx->action_type() == data::xtop_evm_action_type::deploy_contract) {
+            evm_result = deploy_code();
+        }
+        // if call, get code from evm manager(lru_cache) or state(state_accessor), get src and target address, call 'call_contract()'
+        else if (tx_ctx->action_type() == data::xtop_evm_action_type::call_contract) {
+            evm_result = call_contract();
+        } else {
+            xassert(false);
+        }
+    }
+    if (sampled) {
+        top::evm::xevm_profiler_t::enable(false);
+        export_profile(top::evm::xevm_profiler_t::profile());
     }
     if (!evm_result) {
         auto error_result = top::evm::evm_import_instance::instance()->get_return_error();
@@ -59,7 +93,8 @@ evm_common::xevm_transaction_result_t xtop_action_runtime<data::xevm_consensus_a
     } else {
         top::evm_engine::parameters::SubmitResult return_result;
 
-        auto ret = return_result.ParseFromString(top::to_string(top::evm::evm_import_instance::instance()->get_return_value()));
+        auto const & return_value = top::evm::evm_import_instance::instance()->get_return_value();
+        auto ret = return_result.ParseFromArray(return_value.data(), static_cast<int>(return_value.size()));
 
         if (!ret || return_result.version() != evm_runtime::CURRENT_CALL_ARGS_VERSION) {
             top::error::throw_error(error::xerrc_t::evm_protobuf_serilized_error);
@@ -72,8 +107,8 @@ evm_common::xevm_transaction_result_t xtop_action_runtime<data::xevm_consensus_a
         result.extra_msg = top::to_hex_prefixed(return_result.status_data());
         xdbg("xtop_action_runtime<data::xevm_consensus_action_t>::execute result.extra_msg:%s", result.extra_msg.c_str());
 
-        // logs:
-        for (int i = 0; i < return_result.logs_size(); ++i) {
+        // logs, an estimate only looks at the gas:
+        for (int i = 0; !tx_ctx->dry_run() && i < return_result.logs_size(); ++i) {
             common::xeth_address_t address = common::xeth_address_t::build_from(top::to_bytes(return_result.logs(i).address().value()));
             xbytes_t data = top::to_bytes(return_result.logs(i).data());
             evm_common::xh256s_t topics;
@@ -87,6 +122,9 @@ evm_common::xevm_transaction_result_t xtop_action_runtime<data::xevm_consensus_a
         result.used_gas = return_result.gas_used();
     }
 
+    if (!tx_ctx->dry_run()) {
+        result.access = logic_ptr->state_access();
+    }
     top::evm::evm_import_instance::instance()->remove_evm_logic();
 
     return result;
@@ -21,6 +21,7 @@ xtop_evm_context::xtop_evm_context(std::unique_ptr<data::xbasic_top_action_t con
 
     m_gas_limit = static_cast<data::xevm_consensus_action_t const *>(m_action.get())->gas_limit();
     m_random_seed = vm_para.get_random_seed();
+    m_dry_run = vm_para.is_dry_run();
 
     evm_engine::parameters::FunctionCallArgs call_args;
     call_args.set_version(CURRENT_CALL_ARGS_VERSION);
@@ -73,6 +74,10 @@ uint64_t xtop_evm_context::gas_limit() const noexcept {
     return m_gas_limit;
 }
 
+bool xtop_evm_context::dry_run() const noexcept {
+    return m_dry_run;
+}
+
 // EVM API:
 uint64_t xtop_evm_context::chain_id() const noexcept {
     return m_chain_id;
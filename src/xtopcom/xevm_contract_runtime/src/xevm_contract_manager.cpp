@@ -41,7 +41,7 @@ const std::unordered_map<common::xaccount_address_t, std::unique_ptr<xevm_syscon
 bool xtop_evm_contract_manager::execute_sys_contract(xbytes_t const & input, observer_ptr<statectx::xstatectx_face_t> state_ctx, xbytes_t & output) {
     top::evm_engine::precompile::ContractBridgeArgs call_args;
 
-    auto ret = call_args.ParseFromString(top::to_string(input));
+    auto ret = call_args.ParseFromArray(input.data(), static_cast<int>(input.size()));
     if (!ret) {
         // todo need to add default return err into output;
         xwarn("[xtop_evm_contract_manager::execute_sys_contract] parse input error");
@@ -77,6 +77,9 @@ bool xtop_evm_eth_bridge_contract::sync(const xbytes_t & rlp_bytes, state_ptr st
         return false;
     }
 
+    // a batch is usually a chain, the header synced last is the parent of the next one
+    xeth_header_t last_header;
+    h256 last_header_hash;
     auto left_bytes = std::move(rlp_bytes);
     while (left_bytes.size() != 0) {
         // step 2: decode
@@ -111,10 +114,18 @@ bool xtop_evm_eth_bridge_contract::sync(const xbytes_t & rlp_bytes, state_ptr st
             nodes.emplace_back(node);
         }
         xeth_header_t parent_header;
-        if (!get_header(header.parent_hash, parent_header, state)) {
+        if (last_header_hash != h256() && header.parent_hash == last_header_hash) {
+            parent_header = last_header;
+        } else if (!get_header(header.parent_hash, parent_header, state)) {
             xwarn("[xtop_evm_eth_bridge_contract::sync] get parent header failed, hash: %s", header.parent_hash.hex().c_str());
             return false;
         }
+        // record would refuse a known header anyway, check it before paying for the ethash verification
+        auto header_hash = header.hash();
+        if (get_hashes(header.number, state).count(header_hash)) {
+            xwarn("[xtop_evm_eth_bridge_contract::sync] header existed, hash: %s", header_hash.hex().c_str());
+            return false;
+        }
         // step 5: verify header
         if (!verify(parent_header, header, nodes)) {
             xwarn("[xtop_evm_eth_bridge_contract::sync] verify header failed");
@@ -125,6 +136,8 @@ bool xtop_evm_eth_bridge_contract::sync(const xbytes_t & rlp_bytes, state_ptr st
             xwarn("[xtop_evm_eth_bridge_contract::sync] record header failed");
             return false;
         }
+        last_header = std::move(header);
+        last_header_hash = header_hash;
     }
     xinfo("[xtop_evm_eth_bridge_contract::sync] sync success");
     return true;
@@ -290,8 +303,8 @@ bool xtop_evm_eth_bridge_contract::record(const xeth_header_t & header, state_pt
         return false;
     }
     xeth_header_info_t info{header.difficulty + parent_info.difficult_sum, header.parent_hash, header.number};
-    if (!set_header_info(header.hash(), info,state)) {
-        xwarn("[xtop_evm_eth_bridge_contract::record] set_header_info failed, height: %s, hash: %s", header.number.str().c_str(), header.hash().hex().c_str());
+    if (!set_header_info(header_hash, info,state)) {
+        xwarn("[xtop_evm_eth_bridge_contract::record] set_header_info failed, height: %s, hash: %s", header.number.str().c_str(), header_hash.hex().c_str());
         return false;
     }
     if (info.difficult_sum > last_info.difficult_sum || (info.difficult_sum == last_info.difficult_sum && header.difficulty % 2 == 0)) {
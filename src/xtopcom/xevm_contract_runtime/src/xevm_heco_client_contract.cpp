@@ -112,6 +112,9 @@ bool xtop_evm_heco_client_contract::sync(const xbytes_t & rlp_bytes, state_ptr s
         return false;
     }
 
+    // a batch is usually a chain, the header synced last is the parent of the next one
+    xeth_header_t last_header;
+    h256 last_header_hash;
     auto left_bytes = std::move(rlp_bytes);
     while (left_bytes.size() != 0) {
         // step 2: decode
@@ -160,7 +163,9 @@ bool xtop_evm_heco_client_contract::sync(const xbytes_t & rlp_bytes, state_ptr s
         }
 
         xeth_header_t parent_header;
-        if (!get_header(header.parent_hash, parent_header, state)) {
+        if (last_header_hash != h256() && header.parent_hash == last_header_hash) {
+            parent_header = last_header;
+        } else if (!get_header(header.parent_hash, parent_header, state)) {
             xwarn("[xtop_evm_heco_client_contract::sync] get parent header failed, hash: %s", header.parent_hash.hex().c_str());
             return false;
         }
@@ -174,6 +179,8 @@ bool xtop_evm_heco_client_contract::sync(const xbytes_t & rlp_bytes, state_ptr s
             xwarn("[xtop_evm_heco_client_contract::sync] record header failed");
             return false;
         }
+        last_header_hash = snap.hash;  // hash of the applied header
+        last_header = std::move(header);
     }
     xinfo("[xtop_evm_heco_client_contract::sync] sync success");
     return true;
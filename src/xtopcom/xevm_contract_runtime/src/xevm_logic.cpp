@@ -10,6 +10,7 @@
 #include "xcontract_runtime/xerror/xerror.h"
 #include "xevm_common/common_data.h"
 #include "xevm_contract_runtime/xevm_memory_tools.h"
+#include "xevm_contract_runtime/xevm_storage_base.h"
 #include "xevm_runner/proto/proto_basic.pb.h"
 #include "xevm_runner/proto/proto_parameters.pb.h"
 
@@ -27,7 +28,7 @@ xtop_evm_logic::xtop_evm_logic(std::unique_ptr<xevm_storage_face_t> storage_ptr,
 }
 
 //  =========================== for runtime ===============================
-xbytes_t xtop_evm_logic::get_return_value() const {
+xbytes_t const & xtop_evm_logic::get_return_value() const {
     return m_return_data_value;
 }
 
@@ -35,14 +36,17 @@ std::pair<uint32_t, uint64_t> xtop_evm_logic::get_return_error() const {
     return m_return_error_value;
 }
 
+evm_common::xevm_state_access_t const & xtop_evm_logic::state_access() const {
+    return m_state_access;
+}
+
 //  =========================== interface to evm_import ===============================
 uint64_t xtop_evm_logic::register_len(uint64_t register_id) {
-    return m_registers.at(register_id).size();
+    return internal_read_register(register_id).size();
 }
 
 void xtop_evm_logic::read_register(uint64_t register_id, uint64_t ptr) {
-    xbytes_t data = internal_read_register(register_id);
-    memory_set_slice(ptr, data);
+    memory_set_slice(ptr, internal_read_register(register_id));
 }
 
 void xtop_evm_logic::sender_address(uint64_t register_id) {
@@ -50,11 +54,11 @@ void xtop_evm_logic::sender_address(uint64_t register_id) {
     std::error_code ec;
     auto address_bytes = top::from_hex(sender.substr(6), ec);  // remove T60004
     xassert(!ec);
-    internal_write_register(register_id, address_bytes);
+    internal_write_register(register_id, std::move(address_bytes));
 }
 
 void xtop_evm_logic::input(uint64_t register_id) {
-    internal_write_register(register_id, m_context->input_data());
+    internal_borrow_register(register_id, m_context->input_data());
     return;
 }
 
@@ -67,7 +71,7 @@ void xtop_evm_logic::block_coinbase(uint64_t register_id) {
     std::error_code ec;
     auto coinbase_bytes = top::from_hex(coinbase.substr(6), ec);  // remove T60004
     xassert(!ec);
-    internal_write_register(register_id, coinbase_bytes);
+    internal_write_register(register_id, std::move(coinbase_bytes));
 }
 uint64_t xtop_evm_logic::block_height() {
     return m_context->block_height();
@@ -79,9 +83,10 @@ uint64_t xtop_evm_logic::block_timestamp() {
 // storage:
 uint64_t xtop_evm_logic::storage_read(uint64_t key_len, uint64_t key_ptr, uint64_t register_id) {
     xbytes_t key = get_vec_from_memory_or_register(key_ptr, key_len);
+    record_access(key, false);
     xbytes_t read = m_storage_ptr->storage_get(key);
     if (!read.empty()) {
-        internal_write_register(register_id, read);
+        internal_write_register(register_id, std::move(read));
         return 1;
     } else {
         return 0;
@@ -91,13 +96,14 @@ uint64_t xtop_evm_logic::storage_read(uint64_t key_len, uint64_t key_ptr, uint64
 uint64_t xtop_evm_logic::storage_write(uint64_t key_len, uint64_t key_ptr, uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
     xbytes_t key = get_vec_from_memory_or_register(key_ptr, key_len);
     xbytes_t value = get_vec_from_memory_or_register(value_ptr, value_len);
+    record_access(key, true);
 
     xbytes_t read_old_value = m_storage_ptr->storage_get(key);
 
     m_storage_ptr->storage_set(key, value);
 
     if (!read_old_value.empty()) {
-        internal_write_register(register_id, read_old_value);
+        internal_write_register(register_id, std::move(read_old_value));
         return 1;
     } else {
         return 0;
@@ -106,6 +112,7 @@ uint64_t xtop_evm_logic::storage_write(uint64_t key_len, uint64_t key_ptr, uint6
 
 uint64_t xtop_evm_logic::storage_remove(uint64_t key_len, uint64_t key_ptr, uint64_t register_id) {
     xbytes_t key = get_vec_from_memory_or_register(key_ptr, key_len);
+    record_access(key, true);
     xbytes_t read = m_storage_ptr->storage_get(key);
 
     if (!read.empty()) {
@@ -135,7 +142,7 @@ void xtop_evm_logic::sha256(uint64_t value_len, uint64_t value_ptr, uint64_t reg
     hasher.update(value.data(), value.size());
     hasher.get_hash(value_hash);
 
-    internal_write_register(register_id, value_hash);
+    internal_write_register(register_id, std::move(value_hash));
 }
 
 void xtop_evm_logic::keccak256(uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
@@ -146,7 +153,7 @@ void xtop_evm_logic::keccak256(uint64_t value_len, uint64_t value_ptr, uint64_t
     hasher.update(value.data(), value.size());
     hasher.get_hash(value_hash);
 
-    internal_write_register(register_id, value_hash);
+    internal_write_register(register_id, std::move(value_hash));
 }
 
 void xtop_evm_logic::ripemd160(uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
@@ -157,7 +164,7 @@ void xtop_evm_logic::ripemd160(uint64_t value_len, uint64_t value_ptr, uint64_t
     hasher.update(value.data(), value.size());
     hasher.get_hash(value_hash);
 
-    internal_write_register(register_id, value_hash);
+    internal_write_register(register_id, std::move(value_hash));
 }
 
 // MATH API
@@ -176,6 +183,7 @@ bool xtop_evm_logic::extern_contract_call(uint64_t args_len, uint64_t args_ptr)
     m_result_ok.clear();
     m_result_err.clear();
     m_call_contract_args = get_vec_from_memory_or_register(args_ptr, args_len);
+    m_state_access.opaque = true;
     xbytes_t contract_output;
     xdbg("emv logic instance %p, contract manager instance %p", static_cast<void *>(this), static_cast<void *>(m_contract_manager.get()));
     assert(m_contract_manager != nullptr);
@@ -221,7 +229,21 @@ std::string xtop_evm_logic::get_utf8_string(uint64_t len, uint64_t ptr) {
 }
 
 void xtop_evm_logic::internal_write_register(uint64_t register_id, xbytes_t const & context_input) {
-    m_registers[register_id] = context_input;
+    auto & reg = m_registers[register_id];
+    reg.owned = context_input;
+    reg.borrowed = nullptr;
+}
+
+void xtop_evm_logic::internal_write_register(uint64_t register_id, xbytes_t && context_input) {
+    auto & reg = m_registers[register_id];
+    reg.owned = std::move(context_input);
+    reg.borrowed = nullptr;
+}
+
+void xtop_evm_logic::internal_borrow_register(uint64_t register_id, xbytes_t const & buffer) {
+    auto & reg = m_registers[register_id];
+    reg.owned.clear();
+    reg.borrowed = &buffer;
 }
 
 xbytes_t xtop_evm_logic::get_vec_from_memory_or_register(uint64_t offset, uint64_t len) {
@@ -232,18 +254,35 @@ xbytes_t xtop_evm_logic::get_vec_from_memory_or_register(uint64_t offset, uint64
     }
 }
 
-void xtop_evm_logic::memory_set_slice(uint64_t offset, xbytes_t buf) {
+void xtop_evm_logic::memory_set_slice(uint64_t offset, xbytes_t const & buf) {
     memory_tools::write_memory(offset, buf);
 }
 
 xbytes_t xtop_evm_logic::memory_get_vec(uint64_t offset, uint64_t len) {
-    xbytes_t buf(len, 0);
-    memory_tools::read_memory(offset, buf);
-    return buf;
+    return memory_tools::read_memory(offset, len);
 }
 
-xbytes_t xtop_evm_logic::internal_read_register(uint64_t register_id) {
-    return m_registers.at(register_id);
+xbytes_t const & xtop_evm_logic::internal_read_register(uint64_t register_id) const {
+    return m_registers.at(register_id).bytes();
+}
+
+void xtop_evm_logic::record_access(xbytes_t const & key, bool write) {
+    if (m_context->dry_run()) {
+        return;
+    }
+    // [version][key prefix][20 bytes address][extra key], see xevm_storage_base_t
+    std::string access_key;
+    if (key.size() >= 22 && (key[1] == static_cast<uint8_t>(storage_key_type::Nonce) || key[1] == static_cast<uint8_t>(storage_key_type::Balance))) {
+        // nonce and balance are also changed by the gas fee, which only knows the account
+        access_key.assign(key.begin() + 2, key.begin() + 22);
+    } else {
+        access_key.assign(key.begin(), key.end());
+    }
+    if (write) {
+        m_state_access.add_write(access_key);
+    } else {
+        m_state_access.add_read(access_key);
+    }
 }
 
 void xtop_evm_logic::engine_return(uint64_t engine_ptr) {
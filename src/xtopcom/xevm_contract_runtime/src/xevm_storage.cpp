@@ -8,6 +8,7 @@
 #include "xcommon/xaccount_address_fwd.h"
 #include "xdata/xproperty.h"
 #include "xevm_common/common_data.h"
+#include "xmetrics/xmetrics.h"
 #include "xstate_accessor/xproperties/xproperty_identifier.h"
 #include "xstate_accessor/xstate_accessor.h"
 
@@ -16,9 +17,22 @@ NS_BEG3(top, contract_runtime, evm)
 const state_accessor::properties::xproperty_type_t evm_property_type_bytes = state_accessor::properties::xproperty_type_t::bytes;
 const state_accessor::properties::xproperty_type_t evm_property_type_map = state_accessor::properties::xproperty_type_t::map;
 
+bool xtop_evm_storage::is_cached_type(storage_key_type key_type) {
+    return key_type == storage_key_type::Code || key_type == storage_key_type::Storage || key_type == storage_key_type::Generation;
+}
+
 xbytes_t xtop_evm_storage::storage_get(xbytes_t const & key) {
     xassert(m_statectx != nullptr);
     auto storage_key = decode_key_type(key);
+    std::string cache_key;
+    if (is_cached_type(storage_key.key_type)) {
+        cache_key = std::string{key.begin(), key.end()};
+        auto it = m_cache.find(cache_key);
+        if (it != m_cache.end()) {
+            XMETRICS_COUNTER_INCREMENT("evm_storage_cache_hit", 1);
+            return it->second;
+        }
+    }
 
     try {
         auto unit_state = m_statectx->load_unit_state(storage_key.address);
@@ -52,6 +66,7 @@ xbytes_t xtop_evm_storage::storage_get(xbytes_t const & key) {
             assert(!ec);
             top::error::throw_error(ec);
             xdbg("storage_get get code account:%s, size:%zu", storage_key.address.c_str(), value.size());
+            m_cache[cache_key] = value;
             return value;
 
         } else if (storage_key.key_type == storage_key_type::Storage) {
@@ -60,6 +75,7 @@ xbytes_t xtop_evm_storage::storage_get(xbytes_t const & key) {
             assert(!ec);
             xdbg("storage_get storage:%s,%s,value:%s", storage_key.address.c_str(), storage_key.extra_key.c_str(), top::to_hex(value).c_str());
             top::error::throw_error(ec);
+            m_cache[cache_key] = value;
             return value;
 
         } else if (storage_key.key_type == storage_key_type::Generation) {
@@ -67,6 +83,7 @@ xbytes_t xtop_evm_storage::storage_get(xbytes_t const & key) {
             auto value = sa.get_property<evm_property_type_bytes>(property, ec);
             assert(!ec);
             top::error::throw_error(ec);
+            m_cache[cache_key] = value;
             return value;
 
         } else {
@@ -87,6 +104,14 @@ xbytes_t xtop_evm_storage::storage_get(xbytes_t const & key) {
 void xtop_evm_storage::storage_set(xbytes_t const & key, xbytes_t const & value) {
     xassert(m_statectx != nullptr);
     auto storage_key = decode_key_type(key);
+    if (m_dry_run && is_cached_type(storage_key.key_type)) {
+        m_cache[std::string{key.begin(), key.end()}] = value;
+        return;
+    }
+    // written through, so the binlog of the unit state is the same as without the cache
+    if (is_cached_type(storage_key.key_type)) {
+        m_cache.erase(std::string{key.begin(), key.end()});
+    }
 
     try {
         auto unit_state = m_statectx->load_unit_state(storage_key.address);
@@ -124,6 +149,7 @@ void xtop_evm_storage::storage_set(xbytes_t const & key, xbytes_t const & value)
             sa.set_property<evm_property_type_bytes>(property, value, ec);
             assert(!ec);
             top::error::throw_error(ec);
+            m_cache[std::string{key.begin(), key.end()}] = value;
 
         } else if (storage_key.key_type == storage_key_type::Storage) {
             auto property = state_accessor::properties::xtypeless_property_identifier_t{data::XPROPERTY_EVM_STORAGE, state_accessor::properties::xproperty_category_t::system};
@@ -131,12 +157,14 @@ void xtop_evm_storage::storage_set(xbytes_t const & key, xbytes_t const & value)
             xdbg("storage_set storage:%s,%s,value:%s", storage_key.address.c_str(), storage_key.extra_key.c_str(), top::to_hex(value).c_str());
             assert(!ec);
             top::error::throw_error(ec);
+            m_cache[std::string{key.begin(), key.end()}] = value;
 
         } else if (storage_key.key_type == storage_key_type::Generation) {
             auto property = state_accessor::properties::xtypeless_property_identifier_t{data::XPROPERTY_EVM_GENERATION, state_accessor::properties::xproperty_category_t::system};
             sa.set_property<evm_property_type_bytes>(property, value, ec);
             assert(!ec);
             top::error::throw_error(ec);
+            m_cache[std::string{key.begin(), key.end()}] = value;
 
         } else {
             xassert(false);
@@ -157,6 +185,14 @@ void xtop_evm_storage::storage_set(xbytes_t const & key, xbytes_t const & value)
 void xtop_evm_storage::storage_remove(xbytes_t const & key) {
     xassert(m_statectx != nullptr);
     auto storage_key = decode_key_type(key);
+    if (m_dry_run && is_cached_type(storage_key.key_type)) {
+        // removed properties and cells read as empty
+        m_cache[std::string{key.begin(), key.end()}] = xbytes_t{};
+        return;
+    }
+    if (is_cached_type(storage_key.key_type)) {
+        m_cache.erase(std::string{key.begin(), key.end()});
+    }
 
     try {
         auto unit_state = m_statectx->load_unit_state(storage_key.address);
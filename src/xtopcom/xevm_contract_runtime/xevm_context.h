@@ -25,6 +25,7 @@ private:
     common::xaccount_address_t m_block_coinbase;  // T60004.....
     uint64_t m_block_height{0};
     uint64_t m_block_timestamp{0};
+    bool m_dry_run{false};
 
     std::unique_ptr<data::xbasic_top_action_t const> m_action;
 
@@ -49,6 +50,7 @@ public:
 
     std::string const & random_seed() const noexcept;
     uint64_t gas_limit() const noexcept;
+    bool dry_run() const noexcept;
 
     // EVM API:
     uint64_t chain_id() const noexcept;
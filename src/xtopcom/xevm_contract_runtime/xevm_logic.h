@@ -5,6 +5,7 @@
 #pragma once
 #include "xbasic/xbyte_buffer.h"
 #include "xbasic/xmemory.hpp"
+#include "xevm_common/xevm_transaction_result.h"
 #include "xevm_contract_runtime/xevm_context.h"
 #include "xevm_contract_runtime/xevm_contract_manager.h"
 #include "xevm_contract_runtime/xevm_storage_face.h"
@@ -34,20 +35,32 @@ private:
     observer_ptr<statectx::xstatectx_face_t> m_state_ctx;
     observer_ptr<evm_runtime::xevm_context_t> m_context;
     observer_ptr<xevm_contract_manager_t> m_contract_manager;
-    std::map<uint64_t, xbytes_t> m_registers;
+    // a register either owns its bytes or refers to a buffer that lives as long as the session,
+    // like the input of the context, so the engine reads it without another copy on this side.
+    struct xregister_t {
+        xbytes_t owned;
+        xbytes_t const * borrowed{nullptr};
+
+        xbytes_t const & bytes() const {
+            return borrowed != nullptr ? *borrowed : owned;
+        }
+    };
+    std::map<uint64_t, xregister_t> m_registers;
     xbytes_t m_return_data_value;
     std::pair<uint32_t, uint64_t> m_return_error_value;
     xbytes_t m_call_contract_args;
     xbytes_t m_result_ok;
     xbytes_t m_result_err;
+    evm_common::xevm_state_access_t m_state_access;
 
     void * m_engine_ptr{nullptr};
     void * m_executor_ptr{nullptr};
 
 public:
     // for runtime
-    xbytes_t get_return_value() const override;
+    xbytes_t const & get_return_value() const override;
     std::pair<uint32_t, uint64_t> get_return_error() const override;
+    evm_common::xevm_state_access_t const & state_access() const;
 
 public:
     // interface to evm_import_instance:
@@ -96,10 +109,13 @@ private:
     // inner api
     std::string get_utf8_string(uint64_t len, uint64_t ptr);
     void internal_write_register(uint64_t register_id, xbytes_t const & context_input);
+    void internal_write_register(uint64_t register_id, xbytes_t && context_input);
+    void internal_borrow_register(uint64_t register_id, xbytes_t const & buffer);
     xbytes_t get_vec_from_memory_or_register(uint64_t offset, uint64_t len);
-    void memory_set_slice(uint64_t offset, xbytes_t buf);
+    void memory_set_slice(uint64_t offset, xbytes_t const & buf);
     xbytes_t memory_get_vec(uint64_t offset, uint64_t len);
-    xbytes_t internal_read_register(uint64_t register_id);
+    xbytes_t const & internal_read_register(uint64_t register_id) const;
+    void record_access(xbytes_t const & key, bool write);
 };
 using xevm_logic_t = xtop_evm_logic;
 
@@ -1,26 +1,25 @@
 #pragma once
 #include "xbase/xns_macro.h"
 
+#include <cstring>
 #include <map>
 #include <string>
 #include <vector>
 
 NS_BEG4(top, contract_runtime, evm, memory_tools)
 
-void read_memory(uint64_t offset, std::vector<uint8_t> & buffer) {
-    char * begin_address = (char *)offset;
-    for (std::size_t i = 0; i < buffer.size(); ++i) {
-        buffer[i] = *begin_address;
-        begin_address++;
-    }
+// offset is an address in the memory of the engine, given through the import interface.
+
+std::vector<uint8_t> read_memory(uint64_t offset, uint64_t len) {
+    uint8_t const * begin_address = reinterpret_cast<uint8_t const *>(offset);
+    return std::vector<uint8_t>(begin_address, begin_address + len);
 }
 
 void write_memory(uint64_t offset, std::vector<uint8_t> const & buffer) {
-    char * begin_address = (char *)offset;
-    for (std::size_t i = 0; i < buffer.size(); ++i) {
-        *begin_address = buffer[i];
-        begin_address++;
+    if (buffer.empty()) {
+        return;
     }
+    std::memcpy(reinterpret_cast<void *>(offset), buffer.data(), buffer.size());
 }
 
 NS_END4
\ No newline at end of file
@@ -8,6 +8,9 @@
 #include "xbasic/xmemory.hpp"
 #include "xevm_contract_runtime/xevm_storage_base.h"
 
+#include <string>
+#include <unordered_map>
+
 #if defined(__clang__)
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wpedantic"
@@ -32,7 +35,7 @@ NS_BEG3(top, contract_runtime, evm)
 
 class xtop_evm_storage : public xevm_storage_base_t {
 public:
-    explicit xtop_evm_storage(statectx::xstatectx_face_ptr_t const statectx) : m_statectx{statectx} {
+    explicit xtop_evm_storage(statectx::xstatectx_face_ptr_t const statectx, bool const dry_run = false) : m_statectx{statectx}, m_dry_run{dry_run} {
     }
     xtop_evm_storage(xtop_evm_storage const &) = delete;
     xtop_evm_storage & operator=(xtop_evm_storage const &) = delete;
@@ -45,7 +48,15 @@ public:
     void storage_remove(xbytes_t const & key) override;
 
 private:
+    // code, storage slots and generation are only written through this storage during an action,
+    // so their values are kept for the action. nonce and balance are also changed by the system
+    // contracts, they are always read from the unit state.
+    static bool is_cached_type(storage_key_type key_type);
+
     statectx::xstatectx_face_ptr_t m_statectx;
+    // a dry run keeps the writes of cached types in m_cache only, the unit state is never serialized
+    bool m_dry_run{false};
+    std::unordered_map<std::string, xbytes_t> m_cache;
 };
 using xevm_storage = xtop_evm_storage;
 
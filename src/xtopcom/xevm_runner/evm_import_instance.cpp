@@ -1,6 +1,7 @@
 #include "xevm_runner/evm_import_instance.h"
 
-#include <cassert>
+#include "xevm_runner/evm_profile.h"
+
 #include <cassert>
 
 namespace top {
@@ -11,35 +12,22 @@ evm_import_instance * evm_import_instance::instance() {
     return &ins;
 }
 
-std::shared_ptr<top::evm::xevm_logic_face_t> evm_import_instance::current_vm_logic() const {
-    std::shared_ptr<top::evm::xevm_logic_face_t> vm_logic{nullptr};
-    auto current_thread_id_hash = std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
-    // xdbg("evm_import_instance::current_vm_logic %s", current_thread_id_hash.c_str());
-    m_rwlock.lock_read();
-    assert(m_vm_logic_dict.find(current_thread_id_hash) != m_vm_logic_dict.end());
-    vm_logic = m_vm_logic_dict.at(current_thread_id_hash);
-    m_rwlock.release_read();
-    assert(vm_logic != nullptr);
-    return vm_logic;
-}
+// the logic of the worker thread. the engine calls back on the thread that runs it, so every import
+// call finds its logic here without formatting the thread id and locking the dict.
+static thread_local top::evm::xevm_logic_face_t * t_current_vm_logic{nullptr};
 
-std::shared_ptr<top::evm::xevm_logic_face_t> evm_import_instance::current_vm_logic(std::error_code & ec) const {
-    std::shared_ptr<top::evm::xevm_logic_face_t> vm_logic{nullptr};
-    auto current_thread_id_hash = std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
-    // xdbg("evm_import_instance::current_vm_logic %s", current_thread_id_hash.c_str());
-    m_rwlock.lock_read();
-    if (m_vm_logic_dict.find(current_thread_id_hash) == m_vm_logic_dict.end()) {
-        m_rwlock.release_read();
+top::evm::xevm_logic_face_t * evm_import_instance::current_vm_logic() const {
+    assert(t_current_vm_logic != nullptr);
+    return t_current_vm_logic;
+}
 
+top::evm::xevm_logic_face_t * evm_import_instance::current_vm_logic(std::error_code & ec) const {
+    if (t_current_vm_logic == nullptr) {
         assert(!ec);
         ec = make_error_code(std::errc::result_out_of_range);
         return nullptr;
     }
-
-    vm_logic = m_vm_logic_dict.at(current_thread_id_hash);
-    m_rwlock.release_read();
-    assert(vm_logic != nullptr);
-    return vm_logic;
+    return t_current_vm_logic;
 }
 
 void evm_import_instance::add_evm_logic(std::shared_ptr<top::evm::xevm_logic_face_t> vm_logic_ptr) {
@@ -49,6 +37,7 @@ void evm_import_instance::add_evm_logic(std::shared_ptr<top::evm::xevm_logic_fac
     assert(m_vm_logic_dict.find(current_thread_id_hash) == m_vm_logic_dict.end());
     m_vm_logic_dict.insert({current_thread_id_hash, vm_logic_ptr});
     m_rwlock.release_write();
+    t_current_vm_logic = vm_logic_ptr.get();
 }
 
 void evm_import_instance::remove_evm_logic() {
@@ -58,9 +47,10 @@ void evm_import_instance::remove_evm_logic() {
     assert(m_vm_logic_dict.find(current_thread_id_hash) != m_vm_logic_dict.end());
     m_vm_logic_dict.erase(current_thread_id_hash);
     m_rwlock.release_write();
+    t_current_vm_logic = nullptr;
 }
 
-xbytes_t evm_import_instance::get_return_value() {
+xbytes_t const & evm_import_instance::get_return_value() {
     return current_vm_logic()->get_return_value();
 }
 
@@ -70,86 +60,107 @@ std::pair<uint32_t, uint64_t> evm_import_instance::get_return_error() {
 
 // register:
 void evm_import_instance::read_register(uint64_t register_id, uint64_t ptr) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     current_vm_logic()->read_register(register_id, ptr);
     return;
 }
 uint64_t evm_import_instance::register_len(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     return current_vm_logic()->register_len(register_id);
 }
 
 void evm_import_instance::sender_address(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     current_vm_logic()->sender_address(register_id);
     return;
 }
 void evm_import_instance::input(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     current_vm_logic()->input(register_id);
     return;
 }
 
 // # EVM API #
 uint64_t evm_import_instance::evm_chain_id() {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     return current_vm_logic()->chain_id();
 }
 void evm_import_instance::evm_block_coinbase(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     return current_vm_logic()->block_coinbase(register_id);
 }
 uint64_t evm_import_instance::evm_block_height() {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     return current_vm_logic()->block_height();
 }
 uint64_t evm_import_instance::evm_block_timestamp() {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     return current_vm_logic()->block_timestamp();
 }
 
 // math:
 void evm_import_instance::random_seed(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::context};
     current_vm_logic()->random_seed(register_id);
     return;
 }
 void evm_import_instance::sha256(uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::hash};
     current_vm_logic()->sha256(value_len, value_ptr, register_id);
     return;
 }
 void evm_import_instance::keccak256(uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::hash};
     current_vm_logic()->keccak256(value_len, value_ptr, register_id);
     return;
 }
 void evm_import_instance::ripemd160(uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::hash};
     current_vm_logic()->ripemd160(value_len, value_ptr, register_id);
     return;
 }
 
 // others:
 void evm_import_instance::value_return(uint64_t value_len, uint64_t value_ptr) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     return current_vm_logic()->value_return(value_len, value_ptr);
 }
 void evm_import_instance::error_return(uint32_t ec, uint64_t used_gas) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     current_vm_logic()->error_return(ec, used_gas);
     return;
 }
 void evm_import_instance::log_utf8(uint64_t len, uint64_t ptr) {
+    xevm_import_scope_t scope{xevm_import_class_t::log};
     current_vm_logic()->log_utf8(len, ptr);
     return;
 }
 
 // storage:
 uint64_t evm_import_instance::storage_write(uint64_t key_len, uint64_t key_ptr, uint64_t value_len, uint64_t value_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::storage_write};
     return current_vm_logic()->storage_write(key_len, key_ptr, value_len, value_ptr, register_id);
 }
 uint64_t evm_import_instance::storage_read(uint64_t key_len, uint64_t key_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::storage_read};
     return current_vm_logic()->storage_read(key_len, key_ptr, register_id);
 }
 uint64_t evm_import_instance::storage_remove(uint64_t key_len, uint64_t key_ptr, uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::storage_remove};
     return current_vm_logic()->storage_remove(key_len, key_ptr, register_id);
 }
 
 // extern contract:
 bool evm_import_instance::extern_contract_call(uint64_t args_len, uint64_t args_ptr) {
+    xevm_import_scope_t scope{xevm_import_class_t::extern_call};
     return current_vm_logic()->extern_contract_call(args_len, args_ptr);
 }
 uint64_t evm_import_instance::get_result(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     return current_vm_logic()->get_result(register_id);
 }
 uint64_t evm_import_instance::get_error(uint64_t register_id) {
+    xevm_import_scope_t scope{xevm_import_class_t::registers};
     return current_vm_logic()->get_error(register_id);
 }
 
@@ -21,8 +21,8 @@ private:
 
     std::map<std::string, std::shared_ptr<top::evm::xevm_logic_face_t>> m_vm_logic_dict;
     base::xrwlock_t mutable m_rwlock;
-    std::shared_ptr<top::evm::xevm_logic_face_t> current_vm_logic() const;
-    std::shared_ptr<top::evm::xevm_logic_face_t> current_vm_logic(std::error_code & ec) const;
+    top::evm::xevm_logic_face_t * current_vm_logic() const;
+    top::evm::xevm_logic_face_t * current_vm_logic(std::error_code & ec) const;
 
 public:
     // add {thread_id, vm_logic} into evm_instance.
@@ -33,7 +33,7 @@ public:
     void remove_evm_logic();
 
 public:
-    xbytes_t get_return_value();
+    xbytes_t const & get_return_value();
     std::pair<uint32_t, uint64_t> get_return_error();
 
 public:
@@ -20,7 +20,7 @@ public:
     virtual ~xtop_evm_logic_face() = default;
 
 public:
-    virtual xbytes_t get_return_value() const = 0;
+    virtual xbytes_t const & get_return_value() const = 0;
     virtual std::pair<uint32_t, uint64_t> get_return_error() const = 0;
 
 public:
@@ -0,0 +1,115 @@
+#include "xevm_runner/evm_profile.h"
+
+namespace top {
+namespace evm {
+
+namespace {
+thread_local xevm_profile_t t_profile;
+thread_local bool t_profiling{false};
+thread_local uint32_t t_executions{0};
+
+uint64_t elapsed_nanos(std::chrono::steady_clock::time_point const begin) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+}  // namespace
+
+char const * to_string(xevm_import_class_t const import_class) noexcept {
+    switch (import_class) {
+    case xevm_import_class_t::context:
+        return "context";
+    case xevm_import_class_t::registers:
+        return "registers";
+    case xevm_import_class_t::hash:
+        return "hash";
+    case xevm_import_class_t::storage_read:
+        return "storage_read";
+    case xevm_import_class_t::storage_write:
+        return "storage_write";
+    case xevm_import_class_t::storage_remove:
+        return "storage_remove";
+    case xevm_import_class_t::extern_call:
+        return "extern_call";
+    case xevm_import_class_t::log:
+        return "log";
+    default:
+        return "unknown";
+    }
+}
+
+uint64_t xtop_evm_profile::import_calls() const noexcept {
+    uint64_t total = 0;
+    for (auto const c : calls) {
+        total += c;
+    }
+    return total;
+}
+
+uint64_t xtop_evm_profile::import_nanos() const noexcept {
+    uint64_t total = 0;
+    for (auto const n : nanos) {
+        total += n;
+    }
+    return total;
+}
+
+uint64_t xtop_evm_profile::engine_nanos() const noexcept {
+    auto const imports = import_nanos();
+    return execution_nanos > imports ? execution_nanos - imports : 0;
+}
+
+void xtop_evm_profile::reset() noexcept {
+    *this = xtop_evm_profile{};
+}
+
+xevm_profile_t & xtop_evm_profiler::profile() noexcept {
+    return t_profile;
+}
+
+bool xtop_evm_profiler::enabled() noexcept {
+    return t_profiling;
+}
+
+void xtop_evm_profiler::enable(bool const on) noexcept {
+    t_profiling = on;
+}
+
+bool xtop_evm_profiler::sample(uint32_t const rate) noexcept {
+    if (rate == 0) {
+        return false;
+    }
+    if (++t_executions < rate) {
+        return false;
+    }
+    t_executions = 0;
+    return true;
+}
+
+xtop_evm_import_scope::xtop_evm_import_scope(xevm_import_class_t const import_class) noexcept : m_class{import_class}, m_enabled{t_profiling} {
+    if (m_enabled) {
+        m_begin = std::chrono::steady_clock::now();
+    }
+}
+
+xtop_evm_import_scope::~xtop_evm_import_scope() {
+    if (m_enabled) {
+        auto const index = static_cast<std::size_t>(m_class);
+        t_profile.calls[index] += 1;
+        t_profile.nanos[index] += elapsed_nanos(m_begin);
+    }
+}
+
+xtop_evm_execution_scope::xtop_evm_execution_scope() noexcept : m_enabled{t_profiling} {
+    if (m_enabled) {
+        m_begin = std::chrono::steady_clock::now();
+    }
+}
+
+xtop_evm_execution_scope::~xtop_evm_execution_scope() {
+    if (m_enabled) {
+        t_profile.executions += 1;
+        t_profile.execution_nanos += elapsed_nanos(m_begin);
+    }
+}
+
+}  // namespace evm
+}  // namespace top
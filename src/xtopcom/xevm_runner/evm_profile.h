@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace top {
+namespace evm {
+
+// classes of the calls the engine makes back into the host
+enum class xtop_evm_import_class : uint8_t {
+    context = 0,  // sender, input, chain id, block fields and random seed
+    registers,    // register reads, returned values and errors, results of extern calls
+    hash,         // sha256, keccak256 and ripemd160
+    storage_read,
+    storage_write,
+    storage_remove,
+    extern_call,  // calls of system contracts
+    log,
+    count
+};
+using xevm_import_class_t = xtop_evm_import_class;
+
+char const * to_string(xevm_import_class_t const import_class) noexcept;
+
+// what the evm executions of one thread cost on the host side. the engine is a prebuilt library, so
+// the time between import calls is accounted to it as a whole.
+struct xtop_evm_profile {
+    static constexpr std::size_t class_count = static_cast<std::size_t>(xevm_import_class_t::count);
+
+    std::array<uint64_t, class_count> calls{};
+    std::array<uint64_t, class_count> nanos{};
+    uint64_t executions{0};
+    uint64_t execution_nanos{0};
+
+    uint64_t import_calls() const noexcept;
+    uint64_t import_nanos() const noexcept;
+    uint64_t engine_nanos() const noexcept;
+    void reset() noexcept;
+};
+using xevm_profile_t = xtop_evm_profile;
+
+class xtop_evm_profiler {
+public:
+    // profile of the calling thread, only counted while the thread has profiling enabled.
+    static xevm_profile_t & profile() noexcept;
+    static bool enabled() noexcept;
+    static void enable(bool const on) noexcept;
+
+    // whether the next execution of the calling thread is the one of every rate to profile, rate 0 never samples.
+    static bool sample(uint32_t const rate) noexcept;
+};
+using xevm_profiler_t = xtop_evm_profiler;
+
+// times one import call
+class xtop_evm_import_scope {
+public:
+    explicit xtop_evm_import_scope(xevm_import_class_t const import_class) noexcept;
+    xtop_evm_import_scope(xtop_evm_import_scope const &) = delete;
+    xtop_evm_import_scope & operator=(xtop_evm_import_scope const &) = delete;
+    ~xtop_evm_import_scope();
+
+private:
+    xevm_import_class_t m_class;
+    bool m_enabled;
+    std::chrono::steady_clock::time_point m_begin;
+};
+using xevm_import_scope_t = xtop_evm_import_scope;
+
+// times one execution of the engine, on top of its import calls
+class xtop_evm_execution_scope {
+public:
+    xtop_evm_execution_scope() noexcept;
+    xtop_evm_execution_scope(xtop_evm_execution_scope const &) = delete;
+    xtop_evm_execution_scope & operator=(xtop_evm_execution_scope const &) = delete;
+    ~xtop_evm_execution_scope();
+
+private:
+    bool m_enabled;
+    std::chrono::steady_clock::time_point m_begin;
+};
+using xevm_execution_scope_t = xtop_evm_execution_scope;
+
+}  // namespace evm
+}  // namespace top
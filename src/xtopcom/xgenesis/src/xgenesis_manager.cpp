@@ -4,6 +4,8 @@
 
 #include "xgenesis/xgenesis_manager.h"
 
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xdata/xblocktool.h"
 #include "xdata/xblockbuild.h"
 #include "xdata/xgenesis_data.h"
@@ -21,6 +23,10 @@
 #include "xvm/xvm_service.h"
 #include "xpbase/base/top_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 namespace top {
 namespace genesis {
 
@@ -323,14 +329,33 @@ void xtop_genesis_manager::init_genesis_block(std::error_code & ec) {
             CHECK_EC_RETURN(ec);
         }
     }
+    // genesis blocks of units are independent of each other, so they could be created by threads
+    auto const threads = XGET_CONFIG(genesis_bulk_threads);
     // step3: user accounts with data(reset)
     if (false == chain_data::xtop_chain_data_processor::check_state()) {
-        for (auto const & pair : m_user_accounts_data) {
-            auto vblock = create_genesis_of_datauser_account(base::xvaccount_t{pair.first.value()}, pair.second, src, ec);
+        if (threads > 1) {
+            std::vector<base::xvaccount_t> accounts;
+            std::vector<chain_data::data_processor_t const *> datas;
+            accounts.reserve(m_user_accounts_data.size());
+            datas.reserve(m_user_accounts_data.size());
+            for (auto const & pair : m_user_accounts_data) {
+                accounts.emplace_back(pair.first.value());
+                datas.push_back(&pair.second);
+            }
+            create_and_store_parallel(
+                accounts,
+                [&accounts, &datas](std::size_t const i) { return data::xblocktool_t::create_genesis_lightunit(accounts[i].get_account(), *datas[i]); },
+                threads,
+                ec);
             CHECK_EC_RETURN(ec);
-            if (vblock != nullptr) {
-                store_block(base::xvaccount_t{pair.first.value()}, vblock.get(), ec);
+        } else {
+            for (auto const & pair : m_user_accounts_data) {
+                auto vblock = create_genesis_of_datauser_account(base::xvaccount_t{pair.first.value()}, pair.second, src, ec);
                 CHECK_EC_RETURN(ec);
+                if (vblock != nullptr) {
+                    store_block(base::xvaccount_t{pair.first.value()}, vblock.get(), ec);
+                    CHECK_EC_RETURN(ec);
+                }
             }
         }
         if (false == chain_data::xtop_chain_data_processor::set_state()) {
@@ -339,6 +364,22 @@ void xtop_genesis_manager::init_genesis_block(std::error_code & ec) {
         }
     }
     // step4: genesis accounts(almost included in step3, so set it at last)
+    if (threads > 1) {
+        std::vector<base::xvaccount_t> accounts;
+        std::vector<uint64_t> balances;
+        accounts.reserve(m_genesis_accounts_data.size());
+        balances.reserve(m_genesis_accounts_data.size());
+        for (auto const & pair : m_genesis_accounts_data) {
+            accounts.emplace_back(pair.first.value());
+            balances.push_back(pair.second);
+        }
+        create_and_store_parallel(
+            accounts,
+            [&accounts, &balances](std::size_t const i) { return data::xblocktool_t::create_genesis_lightunit(accounts[i].get_account(), balances[i]); },
+            threads,
+            ec);
+        return;
+    }
     for (auto const & pair : m_genesis_accounts_data) {
         auto vblock = create_genesis_of_genesis_account(base::xvaccount_t{pair.first.value()}, pair.second, src, ec);
         CHECK_EC_RETURN(ec);
@@ -349,6 +390,46 @@ void xtop_genesis_manager::init_genesis_block(std::error_code & ec) {
     }
 }
 
+void xtop_genesis_manager::create_and_store_parallel(std::vector<base::xvaccount_t> const & accounts,
+                                                     std::function<base::xauto_ptr<base::xvblock_t>(std::size_t)> const & create,
+                                                     uint32_t threads,
+                                                     std::error_code & ec) {
+    std::atomic<std::size_t> created{0};
+    std::atomic<bool> failed{false};
+    auto const worker = [&](std::size_t const first) {
+        for (std::size_t i = first; i < accounts.size() && !failed.load(std::memory_order_relaxed); i += threads) {
+            auto const & account = accounts[i];
+            if (m_blockstore->exist_genesis_block(account)) {
+                xdbg("[xtop_genesis_manager::create_and_store_parallel] account: %s, genesis block already exists", account.get_account().c_str());
+                continue;
+            }
+            base::xauto_ptr<base::xvblock_t> genesis_block = create(i);
+            xassert(genesis_block != nullptr);
+            if (false == m_blockstore->store_block(account, genesis_block.get())) {
+                xerror("[xtop_genesis_manager::create_and_store_parallel] account: %s, store genesis block failed", account.get_account().c_str());
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            created.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(std::max<std::size_t>(accounts.size(), 1)));
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back(worker, static_cast<std::size_t>(t));
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+    xkinfo("[xtop_genesis_manager::create_and_store_parallel] accounts: %zu, created: %zu, threads: %u", accounts.size(), created.load(), threads);
+    if (failed) {
+        xassert(false);
+        SET_EC_RETURN(ec, error::xenum_errc::genesis_block_store_failed);
+    }
+}
+
 base::xauto_ptr<base::xvblock_t> xtop_genesis_manager::create_genesis_block(base::xvaccount_t const & account, std::error_code & ec) {
     if (!m_root_finish) {
         ec = error::xenum_errc::genesis_root_has_not_ready;
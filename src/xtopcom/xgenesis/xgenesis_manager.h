@@ -8,8 +8,11 @@
 #include "xcommon/xaddress.h"
 #include "xvledger/xvblockstore.h"
 
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <system_error>
+#include <vector>
 
 namespace top {
 namespace genesis {
@@ -91,6 +94,17 @@ private:
     /// @param ec Log the error code.
     void store_block(base::xvaccount_t const & account, base::xvblock_t * block, std::error_code & ec);
 
+    /// @brief Create and store genesis blocks of accounts by threads, for devnets with a huge number of accounts.
+    ///        Accounts already having a genesis block are skipped like the one by one path.
+    /// @param accounts Accounts to create genesis block.
+    /// @param create Create genesis block of the account at the index, must not touch members of the manager.
+    /// @param threads Number of threads.
+    /// @param ec Log the error code.
+    void create_and_store_parallel(std::vector<base::xvaccount_t> const & accounts,
+                                   std::function<base::xauto_ptr<base::xvblock_t>(std::size_t)> const & create,
+                                   uint32_t threads,
+                                   std::error_code & ec);
+
     /// @brief Load accounts of different types.
     void load_accounts();
 
@@ -29,6 +29,7 @@ struct SyncBlockItem {
     base::ServiceType routing_service_type;
     std::string header_hash;
     std::chrono::steady_clock::time_point time_point;
+    std::string announcer_id;  // node announced the header and most likely holds the block, asked first
 };
 
 typedef struct SyncAskFilter {
@@ -48,7 +49,7 @@ private:
 
     bool HeaderHashExists(const std::string & header_hash);
     uint32_t GetBlockMsgType(const std::string & header_hash);
-    void AddHeaderHashToQueue(const std::string & header_hash, base::ServiceType service_type);
+    void AddHeaderHashToQueue(const std::string & header_hash, base::ServiceType service_type, const std::string & announcer_id);
     void CheckHeaderHashQueue();
     void SendSyncAsk(std::shared_ptr<SyncBlockItem> & sync_item);
     void HandleSyncAsk(transport::protobuf::RoutingMessage & message, base::xpacket_t & packet);
@@ -4,9 +4,10 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <vector>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "xtransport/proto/transport.pb.h"
 
@@ -18,9 +19,27 @@ class TimerRepeated;
 
 namespace gossip {
 
-static const uint32_t kRepeatedValue = 1;
 static const uint64_t kClearRstPeriod = 30ll * 1000ll * 1000ll; // 5 seconds
-typedef std::shared_ptr<std::unordered_map<uint32_t, uint32_t>> HashMapPtr;
+static const uint32_t kFilterGenerations = 3;  // current, last, and the one being cleared
+static const uint32_t kFilterSlotBits = 18;  // 256K msg hashes per generation, 1MB memory
+static const uint32_t kFilterMaxProbe = 32;
+
+// fixed size open addressing set of msg hash, lock free insert and find.
+// 0 marks empty slot, so msg hash 0 is stored as 1
+class GossipFilterGeneration {
+public:
+    GossipFilterGeneration();
+
+    bool Find(uint32_t key) const;
+    // return false if key already exist
+    bool Insert(uint32_t key);
+    void Clear();
+
+private:
+    static uint32_t Slot(uint32_t key);
+
+    std::unique_ptr<std::atomic<uint32_t>[]> slots_;
+};
 
 class GossipFilter {
 public:
@@ -28,6 +47,8 @@ public:
 
     bool Init();
     bool FilterMessage(transport::protobuf::RoutingMessage& message);
+    // receipts and duplicates of root rrs messages carrying the body since last call, feedback for rrs params
+    void TakeBodyReceiptStat(uint64_t& received, uint64_t& duplicated);
 
 protected:
     bool AddData(uint32_t);
@@ -42,9 +63,10 @@ private:
 
 private:
     bool inited_{false};
-    std::vector<HashMapPtr> time_filter_;
-    std::mutex current_index_mutex_;
-    uint32_t current_index_;
+    GossipFilterGeneration time_filter_[kFilterGenerations];
+    std::atomic<uint32_t> current_index_{0};
+    std::atomic<uint64_t> body_received_{0};
+    std::atomic<uint64_t> body_duplicated_{0};
     std::shared_ptr<base::TimerRepeated> timer_{nullptr};
     std::mutex repeat_map_mutex_;
     std::map<uint32_t, uint32_t> repeat_map_;
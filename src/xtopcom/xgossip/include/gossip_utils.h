@@ -68,6 +68,9 @@ static const uint32_t kGossipRRSNeighborNum = 6u;
 
 static const uint32_t kGossipRRSStopTimes = 3u;
 static const uint32_t kGossipRRSBloomfilterIgnoreLevel = 1u;
+// body larger than this is only pushed in the first hops, later hops announce the header hash and peers pull the body.
+static const uint32_t kGossipRRSLazyPullBodySize = 16 * 1024u;
+static const uint32_t kGossipRRSLazyPullSwitchHopNum = 1u;
 
 
 
@@ -86,7 +86,7 @@ void BlockSyncManager::NewBroadcastMessage(transport::protobuf::RoutingMessage &
 
     des_service_type = base::ServiceType(kRoot);
 
-    AddHeaderHashToQueue(message.gossip().header_hash(), des_service_type);
+    AddHeaderHashToQueue(message.gossip().header_hash(), des_service_type, message.src_node_id());
 }
 
 bool BlockSyncManager::DataExists(const std::string & header_hash) {
@@ -102,11 +102,12 @@ bool BlockSyncManager::HeaderHashExists(const std::string & header_hash) {
     return false;
 }
 
-void BlockSyncManager::AddHeaderHashToQueue(const std::string & header_hash, base::ServiceType service_type) {
+void BlockSyncManager::AddHeaderHashToQueue(const std::string & header_hash, base::ServiceType service_type, const std::string & announcer_id) {
     xinfo("[BlockSyncManager] AddHeaderHashToQueue header block hash:%s", header_hash.c_str());
     std::unique_lock<std::mutex> lock(block_map_mutex_);
     block_map_.insert(std::make_pair(
-        header_hash, std::make_shared<SyncBlockItem>(SyncBlockItem{service_type, header_hash, std::chrono::steady_clock::now() + std::chrono::milliseconds(kHeaderSavePeriod)})));
+        header_hash,
+        std::make_shared<SyncBlockItem>(SyncBlockItem{service_type, header_hash, std::chrono::steady_clock::now() + std::chrono::milliseconds(kHeaderSavePeriod), announcer_id})));
 }
 
 void BlockSyncManager::SendSyncAsk(std::shared_ptr<SyncBlockItem> & sync_item) {
@@ -126,7 +127,21 @@ void BlockSyncManager::SendSyncAsk(std::shared_ptr<SyncBlockItem> & sync_item) {
     pbft_message.set_src_service_type(sync_item->routing_service_type.value());
 
     std::vector<kadmlia::NodeInfoPtr> select_nodes;
-    if (!(routing->GetRandomNodes(select_nodes, kSyncAskNeighborCount))) {
+    // the announcer pushed the header right after getting the block, ask it first and random neighbors as fallback.
+    if (!sync_item->announcer_id.empty()) {
+        auto announcer = routing->FindLocalNode(sync_item->announcer_id);
+        if (announcer != nullptr) {
+            select_nodes.push_back(announcer);
+        }
+    }
+    std::vector<kadmlia::NodeInfoPtr> random_nodes;
+    routing->GetRandomNodes(random_nodes, kSyncAskNeighborCount);
+    for (auto & node_ptr : random_nodes) {
+        if (node_ptr != nullptr && node_ptr->node_id != sync_item->announcer_id) {
+            select_nodes.push_back(node_ptr);
+        }
+    }
+    if (select_nodes.empty()) {
         TOP_WARN("SendSyncAsk failed, select empty nodes");
         return;
     }
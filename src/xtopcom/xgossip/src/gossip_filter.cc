@@ -6,6 +6,7 @@
 
 #include <cassert>
 
+#include "xgossip/include/gossip_utils.h"
 #include "xpbase/base/top_log.h"
 #include "xpbase/base/top_timer.h"
 #include "xpbase/base/kad_key/kadmlia_key.h"
@@ -14,6 +15,54 @@ namespace top {
 
 namespace gossip {
 
+GossipFilterGeneration::GossipFilterGeneration() : slots_(new std::atomic<uint32_t>[1u << kFilterSlotBits]) {
+    Clear();
+}
+
+uint32_t GossipFilterGeneration::Slot(uint32_t key) {
+    return (key * 2654435761u) >> (32 - kFilterSlotBits);
+}
+
+bool GossipFilterGeneration::Find(uint32_t key) const {
+    key = (key == 0) ? 1 : key;
+    const uint32_t mask = (1u << kFilterSlotBits) - 1;
+    uint32_t slot = Slot(key);
+    for (uint32_t i = 0; i < kFilterMaxProbe; ++i) {
+        uint32_t value = slots_[(slot + i) & mask].load(std::memory_order_acquire);
+        if (value == key) {
+            return true;
+        }
+        if (value == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool GossipFilterGeneration::Insert(uint32_t key) {
+    key = (key == 0) ? 1 : key;
+    const uint32_t mask = (1u << kFilterSlotBits) - 1;
+    uint32_t slot = Slot(key);
+    for (uint32_t i = 0; i < kFilterMaxProbe; ++i) {
+        std::atomic<uint32_t> & cell = slots_[(slot + i) & mask];
+        uint32_t value = cell.load(std::memory_order_acquire);
+        if (value == 0 && cell.compare_exchange_strong(value, key, std::memory_order_acq_rel)) {
+            return true;
+        }
+        if (value == key) {
+            return false;
+        }
+    }
+    // too crowded, let it pass rather than drop a new message by mistake
+    return true;
+}
+
+void GossipFilterGeneration::Clear() {
+    for (uint32_t i = 0; i < (1u << kFilterSlotBits); ++i) {
+        slots_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
 GossipFilter* GossipFilter::Instance() {
     static GossipFilter ins;
 
@@ -23,10 +72,6 @@ GossipFilter* GossipFilter::Instance() {
 
 bool GossipFilter::Init() {
     assert(!inited_);
-    for (uint32_t i = 0; i < 3; ++i) {
-        auto hash_ptr = std::make_shared<std::unordered_map<uint32_t, uint32_t>>();
-        time_filter_.push_back(hash_ptr);
-    }
     timer_ = std::make_shared<base::TimerRepeated>(base::TimerManager::Instance(), "GossipFilter");
     timer_->Start(
             500ll * 1000ll,
@@ -107,68 +152,57 @@ bool GossipFilter::FilterMessage(transport::protobuf::RoutingMessage& message) {
     AddRepeatMsg(message.msg_hash());
 #endif
 
+    bool const rrs_body = message.is_root() && message.gossip().gossip_type() == kGossipRRS && message.gossip().has_block();
+    if (rrs_body) {
+        body_received_.fetch_add(1, std::memory_order_relaxed);
+    }
     if (FindData(message.msg_hash())) {
         //TOP_DEBUG("GossipFilter FindData, filter msg");
+        if (rrs_body) {
+            body_duplicated_.fetch_add(1, std::memory_order_relaxed);
+        }
         return true;
     }
     if (!AddData(message.msg_hash())) {
         TOP_WARN("GossipFilter already exist, filter msg");
+        if (rrs_body) {
+            body_duplicated_.fetch_add(1, std::memory_order_relaxed);
+        }
         return true;
     }
     return false;
 }
 
-bool GossipFilter::FindData(uint32_t key) {
-    assert(current_index_ < 3 && current_index_ >= 0);
-    std::unique_lock<std::mutex> lock(current_index_mutex_);
-    auto it_find = time_filter_[current_index_]->find(key);
-    if (it_find != time_filter_[current_index_]->end()) {
-        return it_find->second >= kRepeatedValue;
-    }
-    // last available index
-    uint32_t last_index = (current_index_ + 2) % 3;
-    auto last_it_find = time_filter_[last_index]->find(key);
-    if (last_it_find != time_filter_[last_index]->end()) {
-        return last_it_find->second >= kRepeatedValue;
-    }
-    return false;
+void GossipFilter::TakeBodyReceiptStat(uint64_t& received, uint64_t& duplicated) {
+    received = body_received_.exchange(0, std::memory_order_relaxed);
+    duplicated = body_duplicated_.exchange(0, std::memory_order_relaxed);
 }
 
-bool GossipFilter::AddData(uint32_t key) {
-    assert(current_index_ < 3 && current_index_ >= 0);
-    std::unique_lock<std::mutex> lock(current_index_mutex_);
-    auto it_find = time_filter_[current_index_]->find(key);
-    if (it_find != time_filter_[current_index_]->end()) {
-        if (it_find->second >= kRepeatedValue) {
-            return false;
-        }
-        ++it_find->second;
+bool GossipFilter::FindData(uint32_t key) {
+    uint32_t index = current_index_.load(std::memory_order_acquire);
+    assert(index < kFilterGenerations);
+    if (time_filter_[index].Find(key)) {
         return true;
     }
-
     // last available index
-    uint32_t last_index = (current_index_ + 2) % 3;
-    auto last_it_find = time_filter_[last_index]->find(key);
-    if (last_it_find != time_filter_[last_index]->end()) {
-        if (last_it_find->second >= kRepeatedValue) {
-            return false;
-        }
-        ++last_it_find->second;
-        return true;
-    }
+    uint32_t last_index = (index + kFilterGenerations - 1) % kFilterGenerations;
+    return time_filter_[last_index].Find(key);
+}
 
-    time_filter_[current_index_]->insert(std::make_pair(key, 1));
-    return true;
+bool GossipFilter::AddData(uint32_t key) {
+    uint32_t index = current_index_.load(std::memory_order_acquire);
+    assert(index < kFilterGenerations);
+    // last generation is checked by FindData already, insert decides the race of same msg from multiple threads
+    return time_filter_[index].Insert(key);
 }
 
 void GossipFilter::do_clear_and_reset() {
-    {
-        assert(current_index_ < 3 && current_index_ >= 0);
-        std::unique_lock<std::mutex> lock(current_index_mutex_);
-        uint32_t not_used_index = (current_index_ + 1) % 3;
-        time_filter_[not_used_index]->clear();
-        current_index_ = not_used_index;
-    }
+    uint32_t index = current_index_.load(std::memory_order_acquire);
+    assert(index < kFilterGenerations);
+    // the oldest one is not read any more since last reset
+    uint32_t not_used_index = (index + 1) % kFilterGenerations;
+    time_filter_[not_used_index].Clear();
+    current_index_.store(not_used_index, std::memory_order_release);
 }
 
 } // end namespace gossip
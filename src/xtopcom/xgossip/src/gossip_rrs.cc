@@ -7,8 +7,12 @@
 #include "xgossip/include/block_sync_manager.h"
 #include "xgossip/include/gossip_utils.h"
 #include "xgossip/include/mesages_with_bloomfilter.h"
+#include "xkad/routing_table/root_routing_table.h"
+#include "xwrouter/multi_routing/multi_routing.h"
 // #include "xwrouter/multi_routing/service_node_cache.h"
 
+#include <algorithm>
+
 namespace top {
 namespace gossip {
 
@@ -49,7 +53,12 @@ void GossipRRS::Broadcast(uint64_t local_hash64, transport::protobuf::RoutingMes
         return;
     }
 
-    if ((message.has_data() || message.gossip().has_block()) && hop_num <= rrs_params_switch_hash_hop_num) {
+    uint32_t switch_hash_hop_num = rrs_params_switch_hash_hop_num;
+    if (message.data().size() + message.gossip().block().size() >= kGossipRRSLazyPullBodySize) {
+        switch_hash_hop_num = (std::min)(switch_hash_hop_num, kGossipRRSLazyPullSwitchHopNum);
+    }
+
+    if ((message.has_data() || message.gossip().has_block()) && hop_num <= switch_hash_hop_num) {
         auto bloomfilter = MessageWithBloomfilter::Instance()->GetMessageBloomfilter(message);
         assert(bloomfilter);
         if (!bloomfilter) {
@@ -105,7 +114,8 @@ void GossipRRS::Broadcast(uint64_t local_hash64, transport::protobuf::RoutingMes
 
 void GossipRRS::BroadcastHash(transport::protobuf::RoutingMessage & message, std::vector<kadmlia::NodeInfoPtr> & neighbors) {
     transport::protobuf::RoutingMessage header_message(message);
-    if (header_message.has_data() || header_message.gossip().has_block()) {
+    bool const has_body = header_message.has_data() || header_message.gossip().has_block();
+    if (has_body) {
         // have not been cleared yet.
         auto gossip_header = header_message.mutable_gossip();
         gossip_header->clear_block();
@@ -117,7 +127,15 @@ void GossipRRS::BroadcastHash(transport::protobuf::RoutingMessage & message, std
     random_neighbors = GetRandomNodes(neighbors, rrs_params_neighbour_num);
     xdbg("[GossipRRS][do_send] Broadcast %d neighbors only header_hash:%s", random_neighbors.size(), header_message.gossip().header_hash().c_str());
     if (header_message.has_is_root() && header_message.is_root()) {
-        header_message.clear_src_node_id();
+        // src_node_id tells receivers where to pull the body: self when holding it, otherwise the upstream announcer.
+        if (has_body) {
+            auto root_routing_table = wrouter::MultiRouting::Instance()->GetRootRoutingTable();
+            if (root_routing_table != nullptr) {
+                header_message.set_src_node_id(root_routing_table->get_local_node_info()->kad_key());
+            } else {
+                header_message.clear_src_node_id();
+            }
+        }
         header_message.clear_des_node_id();
         MutableSendHash(header_message, random_neighbors);
     } else {
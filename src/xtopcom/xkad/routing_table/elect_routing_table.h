@@ -99,6 +99,8 @@ private:
     void PrintRoutingTable();
     void OnHeartbeatFailed(const std::string & ip, uint16_t port);
     void UpdateBroadcastNodeInfo();
+    // the group is elected ahead of its start, so connect to its members before the first message to them.
+    void PreConnectNodes(std::vector<std::pair<std::string, uint16_t>> const & endpoints);
 
 private:
     std::shared_ptr<transport::Transport> transport_ptr_;
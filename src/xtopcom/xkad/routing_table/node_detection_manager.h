@@ -26,17 +26,29 @@ public:
     ~NodeDetectionManager();
     void Join();
     int AddDetectionNode(std::shared_ptr<NodeInfo> node_ptr);
+    // the node answered, stop probing it and forget its failures
     void RemoveDetection(const std::string& ip, uint16_t port);
     bool Detected(const std::string& id);
 
 private:
+    // endpoint that never answered the handshakes is not probed again until the cooldown ends.
+    // the cooldown doubles on each failure in a row, so a dead node reported by every find nodes
+    // response costs a few packets per cooldown instead of a burst every round.
+    struct FailedDetection {
+        uint32_t fail_times{0};
+        uint64_t cooldown_until_ms{0};
+    };
+
     void DoTetection();
     int Handshake(std::shared_ptr<NodeInfo> node_ptr);
+    void OnDetectionFailed(const std::string& key);
+    void PruneFailedDetections(uint64_t now_ms);
 
     std::map<std::string, std::shared_ptr<NodeInfo>> detection_nodes_map_;
     std::mutex detection_nodes_map_mutex_;
     std::map<std::string, std::shared_ptr<NodeInfo>> detected_nodes_map_;
     std::mutex detected_nodes_map_mutex_;
+    std::map<std::string, FailedDetection> failed_detections_map_;  // guarded by detection_nodes_map_mutex_
     RootRoutingTable& root_routing_table_;
     base::TimerManager* timer_manager_{nullptr};
     std::shared_ptr<base::TimerRepeated> timer_;
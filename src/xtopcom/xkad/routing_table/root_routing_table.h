@@ -225,6 +225,11 @@ private:
     std::mutex use_nodes_mutex_;
     std::shared_ptr<std::vector<NodeInfoPtr>> no_lock_for_use_nodes_{nullptr};
 
+    // closest nodes computed from no_lock_for_use_nodes_, dropped once the snapshot is swapped.
+    std::mutex closest_nodes_cache_mutex_;
+    std::shared_ptr<std::vector<NodeInfoPtr>> closest_nodes_cache_snapshot_{nullptr};
+    std::map<std::pair<std::string, uint32_t>, std::vector<NodeInfoPtr>> closest_nodes_cache_;
+
     DISALLOW_COPY_AND_ASSIGN(RootRoutingTable);
 };  // class RootRoutingTable
 
@@ -18,6 +18,7 @@
 #include "xpbase/base/top_utils.h"
 #include "xpbase/base/uint64_bloomfilter.h"
 #include "xtransport/udp_transport/transport_util.h"
+#include "xtransport/utils/transport_utils.h"
 
 #include <stdint.h>
 #include <stdio.h>
@@ -314,6 +315,7 @@ std::map<std::string, top::base::KadmliaKeyPtr> ElectRoutingTable::GetElectionNo
 }
 
 void ElectRoutingTable::HandleElectionNodesInfoFromRoot(std::map<std::string, kadmlia::NodeInfoPtr> const & nodes) {
+    std::vector<std::pair<std::string, uint16_t>> endpoints;
     {
         xinfo("[ElectRoutingTable::HandleElectionNodesInfoFromRoot] node size:%zu local_service_type:%lld", nodes.size(), get_local_node_info()->service_type().value());
         std::vector<base::KadmliaKeyPtr> erase_keys;
@@ -333,13 +335,16 @@ void ElectRoutingTable::HandleElectionNodesInfoFromRoot(std::map<std::string, ka
                  node_ptr->public_port,
                  node_ptr->service_type.value());
             erase_keys.push_back(base::GetKadmliaKey(node_ptr->node_id));
+            endpoints.push_back(std::make_pair(node_ptr->public_ip, node_ptr->public_port));
         }
         EraseElectionNodesExpected(erase_keys);
     }
     UpdateBroadcastNodeInfo();
+    PreConnectNodes(endpoints);
 }
 
 void ElectRoutingTable::OnFindNodesFromRootRouting(std::string const & election_xip2, kadmlia::NodeInfoPtr const & node_info) {
+    std::vector<std::pair<std::string, uint16_t>> endpoints;
     {
         std::unique_lock<std::mutex> lock(m_nodes_mutex);
         if (m_nodes.find(election_xip2) != m_nodes.end()) {
@@ -350,9 +355,28 @@ void ElectRoutingTable::OnFindNodesFromRootRouting(std::string const & election_
             node_ptr->public_port = node_info->public_port;
             xdbg("[ElectRoutingTable::OnFindNodesFromRootRouting] get election_xip2: %s %s:%d", election_xip2.c_str(), node_ptr->public_ip.c_str(), node_ptr->public_port);
             DoEraseElectionNodesExpected(election_xip2);
+            endpoints.push_back(std::make_pair(node_ptr->public_ip, node_ptr->public_port));
         }
     }
     UpdateBroadcastNodeInfo();
+    PreConnectNodes(endpoints);
+}
+
+void ElectRoutingTable::PreConnectNodes(std::vector<std::pair<std::string, uint16_t>> const & endpoints) {
+    auto transport = get_transport();
+    if (transport == nullptr) {
+        return;
+    }
+    std::size_t connected{0};
+    for (auto const & endpoint : endpoints) {
+        if (endpoint.first.empty() || endpoint.second == 0) {
+            continue;
+        }
+        if (transport->PreConnect(endpoint.first, endpoint.second) == transport::kTransportSuccess) {
+            ++connected;
+        }
+    }
+    xdbg("[ElectRoutingTable::PreConnectNodes] pre connect %zu of %zu nodes", connected, endpoints.size());
 }
 
 void ElectRoutingTable::UpdateBroadcastNodeInfo() {
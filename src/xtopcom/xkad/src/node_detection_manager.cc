@@ -16,12 +16,18 @@
 #include "xkad/routing_table/local_node_info.h"
 #include "xkad/routing_table/root_routing_table.h"
 
+#include <algorithm>
+
 namespace top {
 
 namespace kadmlia {
 
 // static const int kDetectedMapClearCount = 100 * 1024;
 static const int32_t kDoDetectionPeriod = 600 * 1000;  // 600ms
+static const int32_t kMaxDetectionDelayCount = 8;       // at most 8 periods between two handshakes of a node
+static const uint64_t kFailedCooldownMinMs = 30 * 1000;       // 30s
+static const uint64_t kFailedCooldownMaxMs = 10 * 60 * 1000;  // 10min
+static const size_t kFailedDetectionsMaxSize = 10 * 1024;
 
 NodeDetectionManager::NodeDetectionManager(base::TimerManager* timer_manager, RootRoutingTable& routing_table)
         : detection_nodes_map_(),
@@ -48,6 +54,7 @@ void NodeDetectionManager::Join() {
     {
         std::unique_lock<std::mutex> lock(detection_nodes_map_mutex_);
         detection_nodes_map_.clear();
+        failed_detections_map_.clear();
     }
     {
         std::unique_lock<std::mutex> lock(detected_nodes_map_mutex_);
@@ -77,6 +84,10 @@ int NodeDetectionManager::AddDetectionNode(std::shared_ptr<NodeInfo> node_ptr) {
     std::unique_lock<std::mutex> lock(detection_nodes_map_mutex_);
     std::string key = (node_ptr->public_ip + "_" +
             base::xstring_utl::tostring(node_ptr->public_port));
+    auto failed_iter = failed_detections_map_.find(key);
+    if (failed_iter != failed_detections_map_.end() && failed_iter->second.cooldown_until_ms > GetCurrentTimeMsec()) {
+        return kKadFailed;
+    }
     auto ins_iter = detection_nodes_map_.insert(std::make_pair(key, node_ptr));
     if (ins_iter.second) {
         return kKadSuccess;
@@ -92,6 +103,30 @@ void NodeDetectionManager::RemoveDetection(const std::string& ip, uint16_t port)
     if (iter != detection_nodes_map_.end()) {
         detection_nodes_map_.erase(iter);
     }
+    failed_detections_map_.erase(key);
+}
+
+void NodeDetectionManager::OnDetectionFailed(const std::string& key) {
+    auto & failed = failed_detections_map_[key];
+    uint64_t cooldown = kFailedCooldownMinMs << std::min<uint32_t>(failed.fail_times, 5);
+    cooldown = std::min(cooldown, kFailedCooldownMaxMs);
+    failed.fail_times++;
+    failed.cooldown_until_ms = GetCurrentTimeMsec() + cooldown;
+    TOP_DEBUG("detection of %s failed %u times, cooldown %llu ms", key.c_str(), failed.fail_times, (unsigned long long)cooldown);
+}
+
+void NodeDetectionManager::PruneFailedDetections(uint64_t now_ms) {
+    if (failed_detections_map_.size() <= kFailedDetectionsMaxSize) {
+        return;
+    }
+    // keep the failure count of the endpoints still cooling down, drop the rest
+    for (auto iter = failed_detections_map_.begin(); iter != failed_detections_map_.end();) {
+        if (iter->second.cooldown_until_ms <= now_ms) {
+            failed_detections_map_.erase(iter++);
+        } else {
+            ++iter;
+        }
+    }
 }
 
 int NodeDetectionManager::Handshake(std::shared_ptr<NodeInfo> node_ptr) {
@@ -163,14 +198,19 @@ void NodeDetectionManager::DoTetection() {
             }
 
             if (iter->second->detection_count >= kDetectionTimes) {
+                OnDetectionFailed(iter->first);
                 detection_nodes_map_.erase(iter++);
                 continue;
             }
 
+            // the first handshake goes at once, then back off: 1, 2, 4... periods between retries.
+            // a live node answers the first one, only a silent node is probed more slowly.
             Handshake(iter->second);
+            iter->second->detection_delay_count = std::min((1 << iter->second->detection_count) - 1, kMaxDetectionDelayCount);
             iter->second->detection_count++;
             ++iter;
         }
+        PruneFailedDetections(GetCurrentTimeMsec());
     }
 }
 
@@ -49,6 +49,7 @@ static const int32_t kHeartbeatCheckProcPeriod = 1 * 1000 * 1000;     // 2s
 static const int32_t kRejoinPeriod = 10 * 1000 * 1000;                // 10s
 static const int32_t kFindNeighboursPeriod = 3 * 1000 * 1000;         // 3s
 static const int32_t kDumpRoutingTablePeriod = 1 * 60 * 1000 * 1000;  // 5min
+static const size_t kClosestNodesCacheMaxSize = 1024u;
 
 RootRoutingTable::RootRoutingTable(std::shared_ptr<transport::Transport> transport_ptr, std::shared_ptr<LocalNodeInfo> local_node_ptr)
   : transport_ptr_{transport_ptr}
@@ -849,11 +850,50 @@ NodeInfoPtr RootRoutingTable::GetClosestNode(const std::string & target_id, bool
 }
 
 std::vector<NodeInfoPtr> RootRoutingTable::GetClosestNodes(const std::string & target_id, uint32_t number_to_get) {
-    NodesLock lock(nodes_mutex_);
     if (number_to_get == 0) {
         return std::vector<NodeInfoPtr>();
     }
 
+    // forwarding path: sort a copy of the snapshot, never touch nodes_mutex_ shared with heartbeat and node detection.
+    auto snapshot = GetUnLockNodes();
+    if (snapshot != nullptr) {
+        auto const key = std::make_pair(target_id, number_to_get);
+        {
+            std::unique_lock<std::mutex> lock(closest_nodes_cache_mutex_);
+            if (closest_nodes_cache_snapshot_ != snapshot) {
+                closest_nodes_cache_.clear();
+                closest_nodes_cache_snapshot_ = snapshot;
+            }
+            auto iter = closest_nodes_cache_.find(key);
+            if (iter != closest_nodes_cache_.end()) {
+                return iter->second;
+            }
+        }
+
+        std::vector<NodeInfoPtr> closest_nodes;
+        closest_nodes.reserve(snapshot->size());
+        for (auto const & node : *snapshot) {
+            if (node != nullptr) {
+                closest_nodes.push_back(node);
+            }
+        }
+        auto const count = std::min(static_cast<size_t>(number_to_get), closest_nodes.size());
+        std::partial_sort(closest_nodes.begin(), closest_nodes.begin() + count, closest_nodes.end(), [&target_id, this](const NodeInfoPtr & lhs, const NodeInfoPtr & rhs) {
+            return CloserToTarget(lhs->node_id, rhs->node_id, target_id);
+        });
+        closest_nodes.resize(count);
+
+        std::unique_lock<std::mutex> lock(closest_nodes_cache_mutex_);
+        if (closest_nodes_cache_snapshot_ == snapshot) {
+            if (closest_nodes_cache_.size() >= kClosestNodesCacheMaxSize) {
+                closest_nodes_cache_.clear();
+            }
+            closest_nodes_cache_[key] = closest_nodes;
+        }
+        return closest_nodes;
+    }
+
+    NodesLock lock(nodes_mutex_);
     int sorted_count = 0;
     // if (base_xip) {
     //     sorted_count = SortNodesByTargetXip(target_id, number_to_get);
@@ -0,0 +1,188 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xmbus/xevent_async_listener.h"
+
+#include "xbase/xlog.h"
+#include "xmbus/xevent_store.h"
+#include "xmetrics/xmetrics.h"
+
+NS_BEG2(top, mbus)
+
+std::string coalesce_by_owner(const xevent_ptr_t& e) {
+    if (e->major_type != xevent_major_type_store) {
+        return std::string();
+    }
+    auto store_event = dynamic_cast<xevent_store_t*>(e.get());
+    if (store_event == nullptr) {
+        return std::string();
+    }
+    return std::to_string(e->minor_type) + ":" + store_event->owner;
+}
+
+xevent_async_listener_ptr_t xevent_async_listener_t::create(xevent_queue_cb_t cb, xevent_listener_options_t options) {
+    auto listener = std::make_shared<xevent_async_listener_t>(std::move(cb), std::move(options));
+    listener->m_thread = std::thread([listener] { listener->run(); });
+    return listener;
+}
+
+xevent_async_listener_t::xevent_async_listener_t(xevent_queue_cb_t cb, xevent_listener_options_t options)
+  : m_cb(std::move(cb)), m_options(std::move(options)), m_last_export(std::chrono::steady_clock::now()) {
+    if (m_options.max_queue_size == 0) {
+        m_options.max_queue_size = 1;
+    }
+#ifdef ENABLE_METRICS
+    m_metrics_labels = metrics::metrics_labels({{"listener", m_options.name}});
+#endif
+}
+
+xevent_async_listener_t::~xevent_async_listener_t() {
+    // the last reference is released by the thread itself once it is stopped
+    if (m_thread.joinable()) {
+        if (m_thread.get_id() == std::this_thread::get_id()) {
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+}
+
+void xevent_async_listener_t::push(const xevent_ptr_t& e) {
+    std::string key = m_options.coalesce_key ? m_options.coalesce_key(e) : std::string();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running) {
+        return;
+    }
+    if (!key.empty()) {
+        auto it = m_keyed.find(key);
+        if (it != m_keyed.end()) {
+            // keep the place and the wait time of the replaced event
+            it->second->event = e;
+            ++m_coalesced;
+            return;
+        }
+    }
+
+    if (m_queue.size() >= m_options.max_queue_size) {
+        if (m_options.overflow == xevent_overflow_policy_t::block) {
+            m_not_full.wait(lock, [this] { return !m_running || m_queue.size() < m_options.max_queue_size; });
+            if (!m_running) {
+                return;
+            }
+        } else {
+            auto & oldest = m_queue.front();
+            if (!oldest.key.empty()) {
+                m_keyed.erase(oldest.key);
+            }
+            m_queue.pop_front();
+            ++m_dropped;
+        }
+    }
+
+    m_queue.push_back(xqueued_event_t{e, key, std::chrono::steady_clock::now()});
+    if (!key.empty()) {
+        m_keyed[key] = std::prev(m_queue.end());
+    }
+    lock.unlock();
+    m_not_empty.notify_one();
+}
+
+void xevent_async_listener_t::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_dropped += m_queue.size();
+        m_queue.clear();
+        m_keyed.clear();
+    }
+    m_not_empty.notify_all();
+    m_not_full.notify_all();
+
+    if (m_thread.joinable()) {
+        // a listener removing itself from its own callback cannot wait for itself
+        if (m_thread.get_id() == std::this_thread::get_id()) {
+            m_thread.detach();
+        } else {
+            m_thread.join();
+        }
+    }
+}
+
+std::size_t xevent_async_listener_t::backlog() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+uint64_t xevent_async_listener_t::delivered() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_delivered;
+}
+
+uint64_t xevent_async_listener_t::dropped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+uint64_t xevent_async_listener_t::coalesced() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_coalesced;
+}
+
+void xevent_async_listener_t::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        m_not_empty.wait_for(lock, std::chrono::seconds(1), [this] { return !m_running || !m_queue.empty(); });
+        auto const now = std::chrono::steady_clock::now();
+        if (now - m_last_export >= std::chrono::seconds(1)) {
+            export_metrics(now);
+        }
+        if (!m_running || m_queue.empty()) {
+            continue;
+        }
+
+        xqueued_event_t queued = std::move(m_queue.front());
+        if (!queued.key.empty()) {
+            m_keyed.erase(queued.key);
+        }
+        m_queue.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+
+        auto const begin = std::chrono::steady_clock::now();
+        auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(begin - queued.enqueued);
+        try {
+            m_cb(queued.event);
+        } catch (std::exception const & eh) {
+            xerror("xevent_async_listener_t::run listener %s throws %s", m_options.name.c_str(), eh.what());
+        }
+        auto const handle = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        XMETRICS_HISTOGRAM(metrics::mbus_listener_wait_hist, static_cast<uint64_t>(wait.count()));
+        XMETRICS_HISTOGRAM(metrics::mbus_listener_handle_hist, static_cast<uint64_t>(handle.count()));
+
+        lock.lock();
+        ++m_delivered;
+        if (wait > m_max_wait) {
+            m_max_wait = wait;
+        }
+    }
+}
+
+// called with the lock held, once a second at most
+void xevent_async_listener_t::export_metrics(std::chrono::steady_clock::time_point const now) {
+    m_last_export = now;
+#ifdef ENABLE_METRICS
+    XMETRICS_COUNTER_SET("mbus_listener_backlog" + m_metrics_labels, static_cast<int64_t>(m_queue.size()));
+    XMETRICS_COUNTER_SET("mbus_listener_delivered" + m_metrics_labels, static_cast<int64_t>(m_delivered));
+    XMETRICS_COUNTER_SET("mbus_listener_dropped" + m_metrics_labels, static_cast<int64_t>(m_dropped));
+    XMETRICS_COUNTER_SET("mbus_listener_coalesced" + m_metrics_labels, static_cast<int64_t>(m_coalesced));
+    XMETRICS_COUNTER_SET("mbus_listener_max_wait_us" + m_metrics_labels, static_cast<int64_t>(m_max_wait.count()));
+#endif
+    m_max_wait = std::chrono::microseconds{0};
+}
+
+NS_END2
@@ -8,6 +8,10 @@
 
 NS_BEG2(top, mbus)
 
+xevent_ports_t::~xevent_ports_t() {
+    clear();
+}
+
 uint32_t xevent_ports_t::add_port(xevent_queue_cb_t cb) {
     m_lock.lock_write();
     m_ports[++m_cur_index] = cb;
@@ -16,10 +20,31 @@ uint32_t xevent_ports_t::add_port(xevent_queue_cb_t cb) {
     return r;
 }
 
+uint32_t xevent_ports_t::add_port(xevent_queue_cb_t cb, xevent_listener_options_t options) {
+    auto listener = xevent_async_listener_t::create(std::move(cb), std::move(options));
+    m_lock.lock_write();
+    auto r = ++m_cur_index;
+    m_ports[r] = [listener](const xevent_ptr_t& e) { listener->push(e); };
+    m_async_ports[r] = listener;
+    m_lock.release_write();
+    return r;
+}
+
 void xevent_ports_t::remove_port(uint32_t id) {
+    xevent_async_listener_ptr_t listener;
     m_lock.lock_write();
     m_ports.erase(id);
+    auto it = m_async_ports.find(id);
+    if (it != m_async_ports.end()) {
+        listener = it->second;
+        m_async_ports.erase(it);
+    }
     m_lock.release_write();
+
+    // outside the lock, the publisher may be waiting for room in the queue
+    if (listener != nullptr) {
+        listener->stop();
+    }
 }
 
 void xevent_ports_t::dispatch_event(const xevent_ptr_t& e) {
@@ -35,9 +60,15 @@ void xevent_ports_t::dispatch_event(const xevent_ptr_t& e) {
 }
 
 void xevent_ports_t::clear() {
+    std::map<uint32_t, xevent_async_listener_ptr_t> async_ports;
     m_lock.lock_write();
     m_ports.clear();
+    async_ports.swap(m_async_ports);
     m_lock.release_write();
+
+    for (auto& entry : async_ports) {
+        entry.second->stop();
+    }
 }
 
 int xevent_ports_t::size() {
@@ -20,6 +20,10 @@ uint32_t xevent_queue_t::add_listener(xevent_queue_cb_t cb) {
     return m_listeners.add_port(cb);
 }
 
+uint32_t xevent_queue_t::add_async_listener(xevent_queue_cb_t cb, xevent_listener_options_t options) {
+    return m_listeners.add_port(std::move(cb), std::move(options));
+}
+
 void xevent_queue_t::remove_listener(uint32_t id) {
     return m_listeners.remove_port(id);
 }
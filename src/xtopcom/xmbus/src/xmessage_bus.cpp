@@ -74,6 +74,11 @@ uint32_t xmessage_bus_t::add_listener(int major_type, xevent_queue_cb_t cb) {
     return m_queues[major_type]->add_listener(cb);
 }
 
+uint32_t xmessage_bus_t::add_async_listener(int major_type, xevent_queue_cb_t cb, xevent_listener_options_t options) {
+    assert((major_type > 0 && major_type < (int) m_queues.size()));
+    return m_queues[major_type]->add_async_listener(std::move(cb), std::move(options));
+}
+
 void xmessage_bus_t::remove_listener(int major_type, uint32_t id) {
     assert((major_type > 0 && major_type < (int) m_queues.size()));
     m_queues[major_type]->remove_listener(id);
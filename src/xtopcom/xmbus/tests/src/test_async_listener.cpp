@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "xmbus/xevent_store.h"
+#include "xmbus/xmessage_bus.h"
+
+using namespace top;
+
+namespace {
+
+mbus::xevent_ptr_t make_store_event(const std::string & owner) {
+    return make_object_ptr<mbus::xevent_store_t>(mbus::xevent_store_t::type_block_committed, owner);
+}
+
+std::string owner_of(const mbus::xevent_ptr_t & e) {
+    return dynamic_cast<mbus::xevent_store_t *>(e.get())->owner;
+}
+
+// holds the listener in its callback until released
+struct xgate_t {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open{false};
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return open; });
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = true;
+        }
+        cv.notify_all();
+    }
+};
+
+void wait_until(std::function<bool()> const & done) {
+    for (int i = 0; i < 500 && !done(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+}  // namespace
+
+TEST(async_listener, delivers_in_order_off_the_publisher) {
+    mbus::xmessage_bus_t bus;
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::thread::id listener_thread;
+
+    mbus::xevent_listener_options_t options;
+    options.name = "test";
+    auto id = bus.add_async_listener(mbus::xevent_major_type_store, [&](const mbus::xevent_ptr_t & e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        listener_thread = std::this_thread::get_id();
+        received.push_back(owner_of(e));
+    }, options);
+
+    for (int i = 0; i < 100; ++i) {
+        bus.push_event(make_store_event(std::to_string(i)));
+    }
+    wait_until([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size() == 100;
+    });
+    bus.remove_listener(mbus::xevent_major_type_store, id);
+
+    ASSERT_EQ(received.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+    EXPECT_NE(listener_thread, std::this_thread::get_id());
+}
+
+TEST(async_listener, coalesces_queued_events) {
+    xgate_t gate;
+    std::vector<std::string> received;
+
+    mbus::xevent_listener_options_t options;
+    options.coalesce_key = mbus::coalesce_by_owner;
+    auto listener = mbus::xevent_async_listener_t::create([&](const mbus::xevent_ptr_t & e) {
+        gate.wait();
+        received.push_back(owner_of(e));
+    }, options);
+
+    // the first event is taken by the listener and holds it, the rest queue up behind it
+    listener->push(make_store_event("busy"));
+    wait_until([&] { return listener->backlog() == 0; });
+    for (int i = 0; i < 10; ++i) {
+        listener->push(make_store_event("table_a"));
+        listener->push(make_store_event("table_b"));
+    }
+    EXPECT_EQ(listener->backlog(), 2u);
+    EXPECT_EQ(listener->coalesced(), 18u);
+
+    gate.release();
+    wait_until([&] { return listener->delivered() == 3; });
+    listener->stop();
+
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_EQ(received[1], "table_a");
+    EXPECT_EQ(received[2], "table_b");
+}
+
+TEST(async_listener, drops_oldest_when_full) {
+    xgate_t gate;
+    std::vector<std::string> received;
+
+    mbus::xevent_listener_options_t options;
+    options.max_queue_size = 2;
+    options.overflow = mbus::xevent_overflow_policy_t::drop_oldest;
+    auto listener = mbus::xevent_async_listener_t::create([&](const mbus::xevent_ptr_t & e) {
+        gate.wait();
+        received.push_back(owner_of(e));
+    }, options);
+
+    listener->push(make_store_event("busy"));
+    wait_until([&] { return listener->backlog() == 0; });
+    for (int i = 0; i < 5; ++i) {
+        listener->push(make_store_event(std::to_string(i)));
+    }
+    EXPECT_EQ(listener->backlog(), 2u);
+    EXPECT_EQ(listener->dropped(), 3u);
+
+    gate.release();
+    wait_until([&] { return listener->delivered() == 3; });
+    listener->stop();
+
+    ASSERT_EQ(received.size(), 3u);
+    EXPECT_EQ(received[1], "3");
+    EXPECT_EQ(received[2], "4");
+}
+
+TEST(async_listener, removes_itself_from_callback) {
+    mbus::xmessage_bus_t bus;
+    std::atomic<int> calls{0};
+    uint32_t id = 0;
+    mbus::xevent_listener_options_t options;
+    options.overflow = mbus::xevent_overflow_policy_t::drop_oldest;
+    id = bus.add_async_listener(mbus::xevent_major_type_store, [&](const mbus::xevent_ptr_t &) {
+        ++calls;
+        bus.remove_listener(mbus::xevent_major_type_store, id);
+    }, options);
+
+    bus.push_event(make_store_event("a"));
+    wait_until([&] { return calls.load() == 1; });
+    bus.push_event(make_store_event("b"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(bus.listeners_size(), 0);
+}
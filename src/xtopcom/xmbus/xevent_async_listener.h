@@ -0,0 +1,93 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "xmbus/xevent.h"
+
+NS_BEG2(top, mbus)
+
+using xevent_queue_cb_t = std::function<void(const xevent_ptr_t&)>;
+
+enum class xevent_overflow_policy_t {
+    block,        // the publisher waits for room, nothing is lost. the callback must not add or remove ports then
+    drop_oldest,  // the oldest queued event is dropped to make room
+};
+
+struct xevent_listener_options_t {
+    std::string name;  // label of the listener in metrics
+    std::size_t max_queue_size{1024};
+    xevent_overflow_policy_t overflow{xevent_overflow_policy_t::block};
+    // queued events with the same non-empty key are redundant: a newer one replaces the queued one in its place
+    std::function<std::string(const xevent_ptr_t&)> coalesce_key;
+};
+
+// coalesce key of store events by kind and account, for listeners that only need the latest block of an account
+std::string coalesce_by_owner(const xevent_ptr_t& e);
+
+/* delivers events to one listener on a thread of its own.
+ * the publisher only enqueues, so a slow listener costs it neither latency nor the read lock of the ports.
+ * events are delivered in publish order, except that a coalesced event takes the place of the one it replaced.
+ * the thread keeps the listener alive until stop(), so a listener may remove itself from its own callback.
+ */
+class xevent_async_listener_t {
+public:
+    static std::shared_ptr<xevent_async_listener_t> create(xevent_queue_cb_t cb, xevent_listener_options_t options);
+
+    xevent_async_listener_t(xevent_queue_cb_t cb, xevent_listener_options_t options);
+    xevent_async_listener_t(const xevent_async_listener_t&) = delete;
+    xevent_async_listener_t& operator=(const xevent_async_listener_t&) = delete;
+    ~xevent_async_listener_t();
+
+    void push(const xevent_ptr_t& e);
+    // drops the queued events and waits for the event being delivered, if called from another thread
+    void stop();
+
+    // monitor functions
+    std::size_t backlog() const;
+    uint64_t delivered() const;
+    uint64_t dropped() const;
+    uint64_t coalesced() const;
+
+private:
+    struct xqueued_event_t {
+        xevent_ptr_t event;
+        std::string key;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    void run();
+    void export_metrics(std::chrono::steady_clock::time_point const now);
+
+    xevent_queue_cb_t m_cb;
+    xevent_listener_options_t m_options;
+    std::string m_metrics_labels;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::list<xqueued_event_t> m_queue;
+    std::unordered_map<std::string, std::list<xqueued_event_t>::iterator> m_keyed;
+    bool m_running{true};
+    uint64_t m_delivered{0};
+    uint64_t m_dropped{0};
+    uint64_t m_coalesced{0};
+    std::chrono::microseconds m_max_wait{0};
+
+    std::chrono::steady_clock::time_point m_last_export;
+    std::thread m_thread;
+};
+
+using xevent_async_listener_ptr_t = std::shared_ptr<xevent_async_listener_t>;
+
+NS_END2
@@ -9,15 +9,18 @@
 #include <memory>
 #include <functional>
 #include "xmbus/xevent.h"
+#include "xmbus/xevent_async_listener.h"
 #include "xbase/xlock.h"
 
 NS_BEG2(top, mbus)
-        
-using xevent_queue_cb_t = std::function<void(const xevent_ptr_t&)>;
 
 class xevent_ports_t {
 public:
+    ~xevent_ports_t();
+
     uint32_t add_port(xevent_queue_cb_t cb);
+    // the port delivers on a thread of its own through a bounded queue
+    uint32_t add_port(xevent_queue_cb_t cb, xevent_listener_options_t options);
     void remove_port(uint32_t id);
     void dispatch_event(const xevent_ptr_t& e);
     void clear();
@@ -27,6 +30,7 @@ public:
     
 private:
     std::map<uint32_t, xevent_queue_cb_t> m_ports;
+    std::map<uint32_t, xevent_async_listener_ptr_t> m_async_ports;
     base::xrwlock_t m_lock;
     uint32_t m_cur_index {0};
 };
@@ -18,6 +18,7 @@ public:
     uint32_t add_sourcer(xevent_queue_cb_t cb);
     void remove_sourcer(uint32_t id);
     uint32_t add_listener(xevent_queue_cb_t cb);
+    uint32_t add_async_listener(xevent_queue_cb_t cb, xevent_listener_options_t options);
     void remove_listener(uint32_t id);
 
     void dispatch_event(const xevent_ptr_t& e);
@@ -45,6 +45,7 @@ public:
     uint32_t add_sourcer(int major_type, xevent_queue_cb_t cb);
     void remove_sourcer(int major_type, uint32_t id);
     uint32_t add_listener(int major_type, xevent_queue_cb_t cb);
+    uint32_t add_async_listener(int major_type, xevent_queue_cb_t cb, xevent_listener_options_t options) override;
     void remove_listener(int major_type, uint32_t id);
 
     void push_event(const xevent_ptr_t& e);
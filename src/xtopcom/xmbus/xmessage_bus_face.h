@@ -22,6 +22,11 @@ public:
     virtual uint32_t add_sourcer(int major_type, xevent_queue_cb_t cb) = 0;
     virtual void remove_sourcer(int major_type, uint32_t id) = 0;
     virtual uint32_t add_listener(int major_type, xevent_queue_cb_t cb) = 0;
+    // delivers to cb on a thread of its own instead of on the publisher's, removed with remove_listener too.
+    // buses without such threads deliver synchronously
+    virtual uint32_t add_async_listener(int major_type, xevent_queue_cb_t cb, xevent_listener_options_t options) {
+        return add_listener(major_type, std::move(cb));
+    }
     virtual void remove_listener(int major_type, uint32_t id) = 0;
 
     virtual void clear() = 0;
@@ -0,0 +1,51 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "histogram_handler.h"
+
+NS_BEG3(top, metrics, handler)
+
+metrics_variant_ptr histogram_handler_t::init_new_metrics(event_message const & msg) {
+    // histograms are registered by tag at start, not created from queued events.
+    assert(false);
+    return nullptr;
+}
+
+void histogram_handler_t::dump_metrics_info(metrics_variant_ptr const & metrics_ptr) {
+    bool dump_json_format{false};
+    XMETRICS_CONFIG_GET("dump_json_format", dump_json_format);
+    auto const & ptr = metrics_ptr.GetConstRef<metrics_histogram_unit_ptr>();
+    if (dump_json_format) {
+        json res, cont;
+        res["category"] = get_category(ptr->name);
+        res["tag"] = get_tag(ptr->name);
+        res["type"] = "histogram";
+        cont["count"] = ptr->count;
+        cont["avg"] = ptr->count == 0 ? 0 : ptr->sum / ptr->count;
+        cont["max"] = ptr->max;
+        cont["p50"] = ptr->p50;
+        cont["p90"] = ptr->p90;
+        cont["p99"] = ptr->p99;
+        cont["p999"] = ptr->p999;
+        res["content"] = cont;
+        std::stringstream ss;
+        ss << res;
+        dump(ss.str(), ptr->count != ptr->last_dump_count);
+    } else {
+        std::stringstream ss;
+        ss.setf(std::ios::left, std::ios::adjustfield);
+        ss.fill(' ');
+        ss << std::setw(calc_dump_width(ptr->name.size())) << ptr->name << ": [count:" << ptr->count << ", p50:" << ptr->p50 << ", p99:" << ptr->p99 << ", p999:" << ptr->p999
+           << ", max:" << ptr->max << "]";
+        dump(ss.str(), ptr->count != ptr->last_dump_count);
+    }
+    ptr->last_dump_count = ptr->count;
+}
+
+void histogram_handler_t::process_message_event(metrics_variant_ptr & metrics_ptr, event_message const & msg) {
+    assert(false);
+    return;
+}
+
+NS_END3
@@ -0,0 +1,151 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xmetrics/xhot_accounts.h"
+
+#include "xmetrics/xmetrics_openmetrics.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace top {
+namespace metrics {
+
+char const * hot_dimension_name(xhot_dimension_t const dimension) noexcept {
+    switch (dimension) {
+    case xhot_dimension_t::txs:
+        return "txs";
+    case xhot_dimension_t::execution_us:
+        return "execution_us";
+    case xhot_dimension_t::state_loads:
+        return "state_loads";
+    case xhot_dimension_t::state_changes:
+        return "state_changes";
+    default:
+        return "unknown";
+    }
+}
+
+xspace_saving_t::xspace_saving_t(std::size_t const capacity) : m_capacity{std::max<std::size_t>(capacity, 1)} {
+    m_counters.reserve(m_capacity);
+}
+
+void xspace_saving_t::add(std::string const & account, uint64_t const value) {
+    auto const it = m_index.find(account);
+    if (it != m_index.end()) {
+        m_counters[it->second].value += value;
+        return;
+    }
+    if (m_counters.size() < m_capacity) {
+        m_index.emplace(account, m_counters.size());
+        xhot_account_t counter;
+        counter.account = account;
+        counter.value = value;
+        m_counters.push_back(std::move(counter));
+        return;
+    }
+
+    auto const min = std::min_element(m_counters.begin(), m_counters.end(), [](xhot_account_t const & a, xhot_account_t const & b) { return a.value < b.value; });
+    m_index.erase(min->account);
+    m_index.emplace(account, static_cast<std::size_t>(min - m_counters.begin()));
+    min->account = account;
+    min->error = min->value;
+    min->value += value;
+}
+
+std::vector<xhot_account_t> xspace_saving_t::top(std::size_t const k) const {
+    auto result = m_counters;
+    std::sort(result.begin(), result.end(), [](xhot_account_t const & a, xhot_account_t const & b) { return a.value > b.value; });
+    if (result.size() > k) {
+        result.resize(k);
+    }
+    return result;
+}
+
+constexpr std::size_t xhot_accounts_t::sketch_capacity;
+constexpr std::size_t xhot_accounts_t::metrics_top_k;
+
+xhot_accounts_t & xhot_accounts_t::instance() {
+    static xhot_accounts_t accounts;
+    return accounts;
+}
+
+void xhot_accounts_t::set_sample_rate(uint32_t const rate) noexcept {
+    m_sample_rate.store(rate, std::memory_order_relaxed);
+}
+
+uint32_t xhot_accounts_t::sample_rate() const noexcept {
+    return m_sample_rate.load(std::memory_order_relaxed);
+}
+
+bool xhot_accounts_t::sampled() noexcept {
+    auto const rate = sample_rate();
+    if (rate == 0) {
+        return false;
+    }
+    thread_local uint32_t calls{0};
+    if (++calls < rate) {
+        return false;
+    }
+    calls = 0;
+    return true;
+}
+
+void xhot_accounts_t::record(xhot_dimension_t const dimension, std::string const & table, std::string const & account, uint64_t const value) {
+    auto const rate = sample_rate();
+    if (rate == 0 || dimension >= xhot_dimension_t::count) {
+        return;
+    }
+    auto & sketches = m_dimensions[static_cast<std::size_t>(dimension)];
+    std::lock_guard<std::mutex> lock{sketches.mutex};
+    auto it = sketches.tables.find(table);
+    if (it == sketches.tables.end()) {
+        it = sketches.tables.emplace(table, xspace_saving_t{sketch_capacity}).first;
+    }
+    it->second.add(account, value * rate);
+}
+
+std::map<std::string, std::vector<xhot_account_t>> xhot_accounts_t::top(xhot_dimension_t const dimension, std::size_t const k, std::string const & table) const {
+    std::map<std::string, std::vector<xhot_account_t>> result;
+    if (dimension >= xhot_dimension_t::count) {
+        return result;
+    }
+    auto const & sketches = m_dimensions[static_cast<std::size_t>(dimension)];
+    std::lock_guard<std::mutex> lock{sketches.mutex};
+    for (auto const & pair : sketches.tables) {
+        if (table.empty() || pair.first == table) {
+            result.emplace(pair.first, pair.second.top(k));
+        }
+    }
+    return result;
+}
+
+void xhot_accounts_t::openmetrics(xopenmetrics_writer_t & writer, std::size_t const k) const {
+    if (sample_rate() == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < static_cast<std::size_t>(xhot_dimension_t::count); ++i) {
+        auto const dimension = static_cast<xhot_dimension_t>(i);
+        auto const tables = top(dimension, k);
+        if (tables.empty()) {
+            continue;
+        }
+        auto const name = writer.family(std::string{"hot_account_"} + hot_dimension_name(dimension), "gauge");
+        for (auto const & table : tables) {
+            for (auto const & account : table.second) {
+                writer.sample(name, metrics_labels({{"table", table.first}, {"account", account.account}}), account.value);
+            }
+        }
+    }
+}
+
+void xhot_accounts_t::reset() {
+    for (auto & sketches : m_dimensions) {
+        std::lock_guard<std::mutex> lock{sketches.mutex};
+        sketches.tables.clear();
+    }
+}
+
+}  // namespace metrics
+}  // namespace top
@@ -0,0 +1,105 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace top {
+namespace metrics {
+
+class xopenmetrics_writer_t;
+
+/* what the accounts of a table are ranked by */
+enum class xhot_dimension_t : std::uint8_t {
+    txs,              // send txs pushed into the table's pool
+    execution_us,     // microseconds executing the account's txs
+    state_loads,      // unit states loaded by the table's state contexts
+    state_changes,    // op records the account's txs write into the states
+    count,
+};
+
+char const * hot_dimension_name(xhot_dimension_t dimension) noexcept;
+
+struct xhot_account_t {
+    std::string account;
+    uint64_t value{0};
+    uint64_t error{0};  // value overestimates the true one by at most error
+};
+
+/* space-saving sketch of the heaviest accounts of one table.
+ * it keeps a fixed number of counters; a new account evicts the smallest one and inherits its value as error,
+ * so every account above total / capacity is present and the order of the top ones is exact enough to spot them.
+ */
+class xspace_saving_t {
+public:
+    explicit xspace_saving_t(std::size_t capacity);
+
+    void add(std::string const & account, uint64_t value);
+    // the k heaviest accounts, heaviest first
+    std::vector<xhot_account_t> top(std::size_t k) const;
+
+private:
+    std::size_t m_capacity;
+    std::vector<xhot_account_t> m_counters;
+    std::unordered_map<std::string, std::size_t> m_index;
+};
+
+/* heavy hitters per table for each dimension, to find the accounts behind a serialized table or a filled pool.
+ * only one of every sample_rate events is recorded, with its value scaled by the rate, so the hot paths pay a
+ * thread local countdown when nothing is sampled. a rate of 0 turns recording off.
+ */
+class xhot_accounts_t {
+public:
+    static constexpr std::size_t sketch_capacity{32};
+    // accounts of each table exposed in /metrics, the admin http returns more on demand
+    static constexpr std::size_t metrics_top_k{3};
+
+    static xhot_accounts_t & instance();
+
+    void set_sample_rate(uint32_t rate) noexcept;
+    uint32_t sample_rate() const noexcept;
+
+    // true for one of every sample_rate calls on this thread, callers measure and record only then
+    bool sampled() noexcept;
+    void record(xhot_dimension_t dimension, std::string const & table, std::string const & account, uint64_t value);
+
+    // the k heaviest accounts of every table with samples, or only of table if it is not empty
+    std::map<std::string, std::vector<xhot_account_t>> top(xhot_dimension_t dimension, std::size_t k, std::string const & table = std::string{}) const;
+    void openmetrics(xopenmetrics_writer_t & writer, std::size_t k) const;
+    void reset();
+
+private:
+    xhot_accounts_t() = default;
+
+    struct xdimension_sketches_t {
+        mutable std::mutex mutex;
+        std::map<std::string, xspace_saving_t> tables;
+    };
+
+    std::atomic<uint32_t> m_sample_rate{0};
+    std::array<xdimension_sketches_t, static_cast<std::size_t>(xhot_dimension_t::count)> m_dimensions;
+};
+
+}  // namespace metrics
+}  // namespace top
+
+#ifdef ENABLE_METRICS
+#define XMETRICS_HOT_ACCOUNTS_SAMPLE_RATE(rate) top::metrics::xhot_accounts_t::instance().set_sample_rate(rate)
+#define XMETRICS_HOT_ACCOUNT_SAMPLED() top::metrics::xhot_accounts_t::instance().sampled()
+#define XMETRICS_HOT_ACCOUNT(dimension, table, account, value)                                                                                                                     \
+    top::metrics::xhot_accounts_t::instance().record(top::metrics::xhot_dimension_t::dimension, table, account, value)
+#else
+#define XMETRICS_HOT_ACCOUNTS_SAMPLE_RATE(rate)
+#define XMETRICS_HOT_ACCOUNT_SAMPLED() false
+#define XMETRICS_HOT_ACCOUNT(dimension, table, account, value)
+#endif
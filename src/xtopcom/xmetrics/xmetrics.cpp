@@ -4,6 +4,10 @@
 
 #include "xmetrics.h"
 
+#include "xbasic/xmemory_accounting.h"
+#include "xbasic/xthreading/xthread_name.h"
+#include "xmetrics/xhot_accounts.h"
+
 NS_BEG2(top, metrics)
 
 #define RETURN_METRICS_NAME(TAG) case TAG: return #TAG
@@ -11,6 +15,8 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
     switch (tag) {
         RETURN_METRICS_NAME(e_simple_begin);
         RETURN_METRICS_NAME(blockstore_cache_block_total);
+        RETURN_METRICS_NAME(blockstore_cache_budget_used);
+        RETURN_METRICS_NAME(blockstore_cache_budget_cleanup);
         RETURN_METRICS_NAME(vhost_recv_msg);
         RETURN_METRICS_NAME(vhost_recv_callback);
         RETURN_METRICS_NAME(vnode_recv_msg);
@@ -71,7 +77,12 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(db_key_block_output_resource);
         RETURN_METRICS_NAME(db_key_block_state);
         RETURN_METRICS_NAME(db_read);
+        RETURN_METRICS_NAME(db_multi_read_keys);
+        RETURN_METRICS_NAME(db_tiered_cold_read);
+        RETURN_METRICS_NAME(db_tiered_moved_keys);
         RETURN_METRICS_NAME(db_write);
+        RETURN_METRICS_NAME(db_write_async);
+        RETURN_METRICS_NAME(db_write_async_group_size);
         RETURN_METRICS_NAME(db_delete);
         RETURN_METRICS_NAME(db_delete_range);
         RETURN_METRICS_NAME(db_read_size);
@@ -82,6 +93,28 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(db_block_cache_size);
         RETURN_METRICS_NAME(db_memtable_cache_size);
         RETURN_METRICS_NAME(db_memory_total_size);
+        RETURN_METRICS_NAME(db_block_cache_capacity);
+        RETURN_METRICS_NAME(db_block_cache_pinned_size);
+        RETURN_METRICS_NAME(db_read_latency);
+        RETURN_METRICS_NAME(db_write_latency);
+        RETURN_METRICS_NAME(db_delete_latency);
+        RETURN_METRICS_NAME(db_compact_latency);
+        RETURN_METRICS_NAME(db_slow_op);
+        RETURN_METRICS_NAME(db_rocksdb_get_p50);
+        RETURN_METRICS_NAME(db_rocksdb_get_p99);
+        RETURN_METRICS_NAME(db_rocksdb_write_p50);
+        RETURN_METRICS_NAME(db_rocksdb_write_p99);
+        RETURN_METRICS_NAME(db_rocksdb_seek_p50);
+        RETURN_METRICS_NAME(db_rocksdb_seek_p99);
+        RETURN_METRICS_NAME(db_rocksdb_stall_micros);
+        RETURN_METRICS_NAME(db_rocksdb_compact_read_bytes);
+        RETURN_METRICS_NAME(db_rocksdb_compact_write_bytes);
+        RETURN_METRICS_NAME(db_rocksdb_block_cache_hit);
+        RETURN_METRICS_NAME(db_rocksdb_block_cache_miss);
+        RETURN_METRICS_NAME(db_rocksdb_block_cache_hit_rate);
+        RETURN_METRICS_NAME(db_rocksdb_pending_compaction_bytes);
+        RETURN_METRICS_NAME(db_rocksdb_write_stopped);
+        RETURN_METRICS_NAME(db_rocksdb_delayed_write_rate);
 
         // consensus
         RETURN_METRICS_NAME(cons_drand_leader_finish_succ);
@@ -137,6 +170,11 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(cons_tablemaker_make_proposal_tick);
         RETURN_METRICS_NAME(cons_tablemaker_check_state_tick);
         RETURN_METRICS_NAME(cons_tablemaker_refresh_cache);
+        RETURN_METRICS_NAME(cons_timeline_leader_pack_ms);
+        RETURN_METRICS_NAME(cons_timeline_leader_send_ms);
+        RETURN_METRICS_NAME(cons_timeline_backup_verify_ms);
+        RETURN_METRICS_NAME(cons_timeline_cert_ms);
+        RETURN_METRICS_NAME(cons_timeline_commit_ms);
 
         RETURN_METRICS_NAME(cons_table_leader_get_txpool_tx_count);
         RETURN_METRICS_NAME(cons_table_leader_get_txpool_sendtx_count);
@@ -183,6 +221,7 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(store_block_table_write);
         RETURN_METRICS_NAME(store_block_unit_write);
         RETURN_METRICS_NAME(store_block_other_write);
+        RETURN_METRICS_NAME(store_block_batch_write);
         RETURN_METRICS_NAME(store_block_index_table_write);
         RETURN_METRICS_NAME(store_block_index_unit_write);
         RETURN_METRICS_NAME(store_block_index_other_write);
@@ -325,9 +364,12 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(txpool_pull_recv_tx);
         RETURN_METRICS_NAME(txpool_pull_confirm_tx);
         RETURN_METRICS_NAME(txpool_push_tx_from_proposal);
+        RETURN_METRICS_NAME(txpool_push_tx_deferred);
         RETURN_METRICS_NAME(txpool_send_tx_cur);
         RETURN_METRICS_NAME(txpool_recv_tx_cur);
         RETURN_METRICS_NAME(txpool_confirm_tx_cur);
+        RETURN_METRICS_NAME(txpool_tx_bytes_cur);
+        RETURN_METRICS_NAME(txpool_send_tx_evicted);
         RETURN_METRICS_NAME(txpool_unconfirm_tx_cur);
         RETURN_METRICS_NAME(txpool_recv_tx_first_send_fail);
         RETURN_METRICS_NAME(txpool_confirm_tx_first_send_fail);
@@ -369,18 +411,25 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(txpool_alarm_confirm_tx_reached_upper_limit);
         RETURN_METRICS_NAME(txpool_alarm_recv_tx_reached_upper_limit);
         RETURN_METRICS_NAME(txpool_alarm_send_tx_reached_upper_limit);
+        RETURN_METRICS_NAME(txpool_alarm_tx_bytes_reached_upper_limit);
         RETURN_METRICS_NAME(txpool_sync_on_demand_unit);
         RETURN_METRICS_NAME(txpool_sender_unconfirm_cache);
         RETURN_METRICS_NAME(txpool_receiver_unconfirm_cache);
         RETURN_METRICS_NAME(txpool_height_record_cache);
         RETURN_METRICS_NAME(txpool_table_unconfirm_raw_txs);
+        RETURN_METRICS_NAME(txpool_tx_signature_cache_hit);
 
         // txstore
         RETURN_METRICS_NAME(txstore_request_origin_tx);
         RETURN_METRICS_NAME(txstore_cache_origin_tx);
+        RETURN_METRICS_NAME(txstore_cache_hit);
+        RETURN_METRICS_NAME(txstore_cache_miss);
+        RETURN_METRICS_NAME(txstore_cache_evict);
 
         // blockstore
         RETURN_METRICS_NAME(blockstore_index_load);
+        RETURN_METRICS_NAME(blockstore_index_ring_hit);
+        RETURN_METRICS_NAME(blockstore_prefetch_block);
         RETURN_METRICS_NAME(blockstore_blk_load);
 
         // blockstore accessing
@@ -649,9 +698,16 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(statectx_load_block_succ);
         RETURN_METRICS_NAME(statectx_load_state_succ);
         RETURN_METRICS_NAME(statectx_sync_invoke_count);
+        RETURN_METRICS_NAME(statectx_prefetch_unitstate);
 
         RETURN_METRICS_NAME(mpt_total_pruned_trie_node_cnt);
         RETURN_METRICS_NAME(mpt_cached_pruned_trie_node_cnt);
+        RETURN_METRICS_NAME(mpt_trie_clean_cache_hit);
+        RETURN_METRICS_NAME(mpt_trie_clean_cache_miss);
+        RETURN_METRICS_NAME(mpt_trie_clean_cache_bytes);
+        RETURN_METRICS_NAME(mpt_snapshot_hit);
+        RETURN_METRICS_NAME(mpt_snapshot_miss);
+        RETURN_METRICS_NAME(mpt_snapshot_diff_layers);
         //prune
         RETURN_METRICS_NAME(prune_block_table);
         RETURN_METRICS_NAME(prune_block_unit);
@@ -659,6 +715,8 @@ char const * matrics_name(xmetrics_tag_t const tag) noexcept {
         RETURN_METRICS_NAME(prune_block_timer);
         RETURN_METRICS_NAME(prune_block_contract);
         RETURN_METRICS_NAME(prune_state_unitstate);
+        RETURN_METRICS_NAME(prune_block_backlog);
+        RETURN_METRICS_NAME(prune_block_reclaimed);
 
         default: assert(false); return nullptr;
     }
@@ -679,6 +737,14 @@ std::pair<char const *, std::size_t> array_counter_info(xmetrics_array_tag_t con
         RETURN_METRICS_INFO(blockstore_sharding_table_block_genesis_connect, 64);
         RETURN_METRICS_INFO(blockstore_beacon_table_block_genesis_connect, 1);
         RETURN_METRICS_INFO(blockstore_zec_table_block_genesis_connect, 3);
+        RETURN_METRICS_INFO(db_cf_block_cache_hit, 16);
+        RETURN_METRICS_INFO(db_cf_block_cache_miss, 16);
+        RETURN_METRICS_INFO(cons_worker_queue_size, 32);
+        RETURN_METRICS_INFO(cons_worker_packer_count, 32);
+        RETURN_METRICS_INFO(cons_worker_clock_time_us, 32);
+        RETURN_METRICS_INFO(cons_sharding_table_cert_latency_ms, 64);
+        RETURN_METRICS_INFO(cons_sharding_table_cert_latency_ewma_ms, 64);
+        RETURN_METRICS_INFO(transport_worker_queue_size, 16);
         RETURN_METRICS_INFO(e_array_counter_total, 0);
 
     default:
@@ -688,6 +754,28 @@ std::pair<char const *, std::size_t> array_counter_info(xmetrics_array_tag_t con
 }
 #undef RETURN_METRICS_INFO
 
+#define RETURN_METRICS_NAME(TAG) case TAG: return #TAG
+char const * histogram_name(xmetrics_histogram_tag_t const tag) noexcept {
+    switch (tag) {
+        RETURN_METRICS_NAME(e_histogram_begin);
+        RETURN_METRICS_NAME(db_read_latency_hist);
+        RETURN_METRICS_NAME(db_write_latency_hist);
+        RETURN_METRICS_NAME(db_delete_latency_hist);
+        RETURN_METRICS_NAME(db_compact_latency_hist);
+        RETURN_METRICS_NAME(mbus_listener_wait_hist);
+        RETURN_METRICS_NAME(mbus_listener_handle_hist);
+        RETURN_METRICS_NAME(vhost_dispatch_wait_hist);
+        RETURN_METRICS_NAME(vhost_dispatch_handle_hist);
+        RETURN_METRICS_NAME(e_histogram_total);
+
+        default: assert(false); return nullptr;
+    }
+}
+#undef RETURN_METRICS_NAME
+
+
+// map node, variant and unit of a hub entry besides the two copies of its name
+static constexpr uint64_t hub_entry_overhead_bytes{256};
 
 void e_metrics::start(const std::string& log_path)
 {
@@ -714,6 +802,16 @@ void e_metrics::start() {
         a_counters[index].arr_value.resize(size, copiable_atomwrapper<int64_t>(0));
     }
 
+    for (size_t index = e_histogram_begin; index < e_histogram_total; index++) {
+        h_metrics[index] = std::make_shared<metrics_histogram_unit>(histogram_name(static_cast<xmetrics_histogram_tag_t>(index)));
+    }
+
+    // the queue is preallocated, the hub only grows by the metrics names in use
+    static uint64_t const reporter = basic::xmemory_accounting_t::instance().add_reporter("metrics", [this] {
+        return basic::xmemory_usage_t{message_queue_size * sizeof(event_message) + m_hub_bytes.load(std::memory_order_relaxed), m_hub_size.load(std::memory_order_relaxed)};
+    });
+    (void)reporter;
+
     running(true);
     // auto self = shared_from_this();
     // threading::xbackend_thread::spawn([this, self] { run_process(); });
@@ -727,9 +825,15 @@ void e_metrics::stop() {
 }
 
 void e_metrics::run_process() {
+    threading::set_current_thread_name("metrics");
     while (running()) {
-        process_message_queue();
-        std::this_thread::sleep_for(m_queue_procss_behind_sleep_time);
+        auto const processed = process_message_queue();
+        if (m_hub_openmetrics_wanted.exchange(false)) {
+            publish_hub_openmetrics();
+        }
+        if (processed < message_queue_size / 2) {
+            std::this_thread::sleep_for(m_queue_procss_behind_sleep_time);
+        }
         update_dump();
     }
 
@@ -737,10 +841,15 @@ void e_metrics::run_process() {
 
 }
 
-void e_metrics::process_message_queue() {
+std::size_t e_metrics::process_message_queue() {
     auto message_v = m_message_queue.wait_and_pop_all();
+    auto const dropped = m_message_queue.dropped();
+    if (dropped != m_message_queue_dropped) {
+        xkinfo("[xmetrics]alarm metrics_queue_dropped %" PRIu64, dropped - m_message_queue_dropped);
+        m_message_queue_dropped = dropped;
+    }
     if (message_v.empty())
-        return;
+        return 0;
     if (message_v.size() > 50000) {
         xkinfo("[xmetrics]alarm metrics_queue_size %zu", message_v.size());
     }
@@ -766,6 +875,8 @@ void e_metrics::process_message_queue() {
             }
             m_metrics_hub.insert({metrics_real_name, metrics_ptr});
             assert(m_metrics_hub.count(metrics_real_name));
+            m_hub_bytes.fetch_add(hub_entry_overhead_bytes + 2 * metrics_real_name.size(), std::memory_order_relaxed);
+            m_hub_size.fetch_add(1, std::memory_order_relaxed);
         } else {
             metrics_ptr = m_metrics_hub[metrics_real_name];
             auto index = static_cast<metrics::e_metrics_major_id>(metrics_ptr.GetType());
@@ -784,6 +895,7 @@ void e_metrics::process_message_queue() {
             }
         }
     }
+    return message_v.size();
 }
 
 void e_metrics::update_dump() {
@@ -815,6 +927,9 @@ void e_metrics::update_dump() {
     // array_counter metrics dump
     array_count_dump();
 
+    // histogram metrics dump
+    histogram_dump();
+
     XMETRICS_CONFIG_GET("dump_interval", m_dump_interval);
 }
 /*
@@ -844,22 +959,20 @@ void e_metrics::gauge(E_SIMPLE_METRICS_TAG tag, int64_t value) {
     if (tag >= e_simple_total || tag <= e_simple_begin ) {
         return;
     }
-    s_counters[tag].value += value;
-    s_counters[tag].call_count++;
+    s_counters.add(tag, value);
 }
 void e_metrics::gauge_set_value(E_SIMPLE_METRICS_TAG tag, int64_t value) {
     if (tag >= e_simple_total || tag <= e_simple_begin ) {
         return;
     }
     xassert(tag < message_category_send || tag > message_broad_category_end);
-    s_counters[tag].value = value;
-    s_counters[tag].call_count++;
+    s_counters.set(tag, value);
 }
 int64_t e_metrics::gauge_get_value(E_SIMPLE_METRICS_TAG tag) {
     if (tag >= e_simple_total || tag <= e_simple_begin ) {
         return 0;
     }
-    return s_counters[tag].value;
+    return s_counters.value(tag);
 }
 
 void e_metrics::array_counter_increase(E_ARRAY_COUNTER_TAG tag, std::size_t index, int64_t value) {
@@ -877,6 +990,20 @@ void e_metrics::array_counter_set(E_ARRAY_COUNTER_TAG tag, std::size_t index, in
     a_counters[tag].arr_value[index] = value;
 }
 
+void e_metrics::histogram_record(E_HISTOGRAM_TAG tag, uint64_t value) {
+    if (tag >= e_histogram_total || tag <= e_histogram_begin) {
+        return;
+    }
+    h_histograms[tag].record(value);
+}
+
+xhistogram_snapshot_t e_metrics::histogram_get(E_HISTOGRAM_TAG tag) {
+    if (tag >= e_histogram_total || tag <= e_histogram_begin) {
+        return xhistogram_snapshot_t{};
+    }
+    return h_histograms[tag].snapshot();
+}
+
 struct xsimple_merics_category
 {
     E_SIMPLE_METRICS_TAG category;
@@ -918,8 +1045,8 @@ void e_metrics::gauge_dump() {
         }
         auto metrics_ptr = s_metrics[index];
         auto ptr = metrics_ptr.GetRef<metrics_counter_unit_ptr>();
-        ptr->inner_val = s_counters[index].value;
-        ptr->count = s_counters[index].call_count;
+        ptr->inner_val = s_counters.value(index);
+        ptr->count = s_counters.count(index);
         m_counter_handler.dump_metrics_info(ptr);
     }
 
@@ -929,8 +1056,8 @@ void e_metrics::gauge_dump() {
         uint64_t cate_count = 0;
         auto cate = g_cates[index];
         for(auto cate_index = (int)cate.start; cate_index <= (int)cate.end; cate_index++) {
-            cate_val += s_counters[cate_index].value;
-            cate_count += s_counters[cate_index].call_count;
+            cate_val += s_counters.value(cate_index);
+            cate_count += s_counters.count(cate_index);
         }
         auto metrics_ptr = s_metrics[cate.category];
         auto ptr = metrics_ptr.GetRef<metrics_counter_unit_ptr>();
@@ -954,4 +1081,137 @@ void e_metrics::array_count_dump() {
     }
 }
 
+void e_metrics::histogram_dump() {
+    for (auto index = e_histogram_begin + 1; index < e_histogram_total; index++) {
+        auto const snapshot = h_histograms[index].snapshot();
+        auto metrics_ptr = h_metrics[index];
+        auto ptr = metrics_ptr.GetRef<metrics_histogram_unit_ptr>();
+        ptr->count = snapshot.count;
+        ptr->sum = snapshot.sum;
+        ptr->max = snapshot.max;
+        ptr->p50 = snapshot.percentile(0.5);
+        ptr->p90 = snapshot.percentile(0.9);
+        ptr->p99 = snapshot.percentile(0.99);
+        ptr->p999 = snapshot.percentile(0.999);
+        m_histogram_handler.dump_metrics_info(ptr);
+    }
+}
+
+// label of the index of an array counter
+static std::string array_counter_label(std::string const & name) {
+    if (name.find("_table_") != std::string::npos) {
+        return "table";
+    }
+    if (name.find("_worker_") != std::string::npos) {
+        return "worker";
+    }
+    if (name.find("_cf_") != std::string::npos) {
+        return "cf";
+    }
+    return "index";
+}
+
+std::string e_metrics::openmetrics_text() {
+    // the next queue pass renders the queued metrics for the scrape after this one, the unnamed event only
+    // wakes the process thread up in case nothing else is queued
+    m_hub_openmetrics_wanted.store(true);
+    m_message_queue.push(event_message(metrics::e_metrics_major_id::count, metrics::e_metrics_minor_id::increase, std::string{}, int64_t{0}));
+
+    xopenmetrics_writer_t writer;
+    for (auto index = (size_t)e_simple_begin + 1; index < (size_t)e_simple_total; index++) {
+        if (is_category((E_SIMPLE_METRICS_TAG)index)) {
+            continue;
+        }
+        std::string const name = matrics_name(static_cast<xmetrics_tag_t>(index));
+        writer.sample(writer.family(name, "gauge"), std::string{}, s_counters.value(index));
+        writer.sample(writer.family(name + "_calls", "counter") + "_total", std::string{}, s_counters.count(index));
+    }
+
+    for (auto index = (size_t)e_array_counter_begin + 1; index < (size_t)e_array_counter_total; index++) {
+        std::string const name = array_counter_info(static_cast<xmetrics_array_tag_t>(index)).first;
+        auto const label = array_counter_label(name);
+        auto const & counter = a_counters[index];
+        auto const value_family = writer.family(name, "gauge");
+        for (std::size_t i = 0; i < counter.arr_value.size(); ++i) {
+            writer.sample(value_family, xopenmetrics_writer_t::add_label(std::string{}, label, std::to_string(i)), counter.arr_value[i]._a.load());
+        }
+        auto const count_family = writer.family(name + "_calls", "counter");
+        for (std::size_t i = 0; i < counter.arr_count.size(); ++i) {
+            writer.sample(count_family + "_total", xopenmetrics_writer_t::add_label(std::string{}, label, std::to_string(i)), counter.arr_count[i]._a.load());
+        }
+    }
+
+    for (auto index = (size_t)e_histogram_begin + 1; index < (size_t)e_histogram_total; index++) {
+        auto const snapshot = h_histograms[index].snapshot();
+        auto const name = writer.family(histogram_name(static_cast<xmetrics_histogram_tag_t>(index)), "histogram", "microseconds");
+        // cumulative buckets at the end of every power of two, up to the one holding the max
+        uint64_t seen{0};
+        for (std::size_t i = 0; i < xhistogram_snapshot_t::bucket_count && seen < snapshot.count; ++i) {
+            seen += snapshot.buckets[i];
+            if (i + 1 >= 2 * xhistogram_snapshot_t::sub_bucket_count && (i + 1) % xhistogram_snapshot_t::sub_bucket_count == 0) {
+                writer.sample(name + "_bucket", xopenmetrics_writer_t::add_label(std::string{}, "le", std::to_string(xhistogram_snapshot_t::upper_bound_of(i))), seen);
+            }
+        }
+        writer.sample(name + "_bucket", "{le=\"+Inf\"}", snapshot.count);
+        writer.sample(name + "_count", std::string{}, snapshot.count);
+        writer.sample(name + "_sum", std::string{}, snapshot.sum);
+    }
+
+    xhot_accounts_t::instance().openmetrics(writer, xhot_accounts_t::metrics_top_k);
+
+    auto const hub = std::atomic_load(&m_hub_openmetrics);
+    if (hub != nullptr) {
+        writer.append(*hub);
+    }
+    return writer.finish();
+}
+
+void e_metrics::publish_hub_openmetrics() {
+    // group the samples of one family, its labelled names do not sort next to each other
+    std::map<std::string, std::vector<std::pair<std::string, metrics_variant_ptr>>> families;
+    for (auto const & pair : m_metrics_hub) {
+        auto const name_labels = xopenmetrics_writer_t::split_labels(pair.first);
+        families[name_labels.first].emplace_back(name_labels.second, pair.second);
+    }
+
+    xopenmetrics_writer_t writer;
+    for (auto const & family : families) {
+        auto const type = static_cast<metrics::e_metrics_major_id>(family.second.front().second.GetType());
+        switch (type) {
+        case metrics::e_metrics_major_id::count: {
+            auto const name = writer.family(family.first, "gauge");
+            for (auto const & sample : family.second) {
+                if (sample.second.GetType() == family.second.front().second.GetType()) {
+                    writer.sample(name, sample.first, sample.second.GetConstRef<metrics_counter_unit_ptr>()->inner_val);
+                }
+            }
+            break;
+        }
+        case metrics::e_metrics_major_id::timer: {
+            auto const name = writer.family(family.first, "summary", "microseconds");
+            for (auto const & sample : family.second) {
+                if (sample.second.GetType() == family.second.front().second.GetType()) {
+                    auto const & ptr = sample.second.GetConstRef<metrics_timer_unit_ptr>();
+                    writer.sample(name + "_count", sample.first, ptr->count);
+                    writer.sample(name + "_sum", sample.first, static_cast<int64_t>(ptr->sum_time.count()));
+                }
+            }
+            break;
+        }
+        case metrics::e_metrics_major_id::flow: {
+            auto const name = writer.family(family.first, "counter");
+            for (auto const & sample : family.second) {
+                if (sample.second.GetType() == family.second.front().second.GetType()) {
+                    writer.sample(name + "_total", sample.first, sample.second.GetConstRef<metrics_flow_unit_ptr>()->sum_flow);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    std::atomic_store(&m_hub_openmetrics, std::make_shared<std::string const>(writer.take()));
+}
+
 NS_END2
@@ -5,22 +5,26 @@
 #pragma once
 
 #include "xbasic/xrunnable.h"
-#include "xbasic/xthreading/xthreadsafe_queue.hpp"
+#include "xbasic/xthreading/xbounded_queue.hpp"
+#include "xmetrics/xmetrics_openmetrics.h"
 
 #ifdef ENABLE_METRICS
 #include "metrics_handler/basic_handler.h"
 #include "metrics_handler/array_counter_handler.h"
 #include "metrics_handler/counter_handler.h"
 #include "metrics_handler/flow_handler.h"
+#include "metrics_handler/histogram_handler.h"
 #include "metrics_handler/timer_handler.h"
 #include "metrics_handler/xmetrics_packet_info.h"
 #include "xmetrics_event.h"
+#include "xmetrics_shard.h"
 #include "xmetrics_unit.h"
 #endif
 
 #include <atomic>
 #include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <thread>
 
@@ -29,6 +33,8 @@ NS_BEG2(top, metrics)
 enum E_SIMPLE_METRICS_TAG : size_t {
     e_simple_begin = 0,
     blockstore_cache_block_total = e_simple_begin+1,
+    blockstore_cache_budget_used,
+    blockstore_cache_budget_cleanup,
 
     vhost_recv_msg,
     vhost_recv_callback,
@@ -89,7 +95,12 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     db_key_block_output_resource,
     db_key_block_state,
     db_read,
+    db_multi_read_keys,
+    db_tiered_cold_read,
+    db_tiered_moved_keys,
     db_write,
+    db_write_async,
+    db_write_async_group_size,
     db_delete,
     db_delete_range,
     db_read_size,
@@ -100,6 +111,28 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     db_block_cache_size,
     db_memtable_cache_size,
     db_memory_total_size,
+    db_block_cache_capacity,
+    db_block_cache_pinned_size,
+    db_read_latency,
+    db_write_latency,
+    db_delete_latency,
+    db_compact_latency,
+    db_slow_op,
+    db_rocksdb_get_p50,
+    db_rocksdb_get_p99,
+    db_rocksdb_write_p50,
+    db_rocksdb_write_p99,
+    db_rocksdb_seek_p50,
+    db_rocksdb_seek_p99,
+    db_rocksdb_stall_micros,
+    db_rocksdb_compact_read_bytes,
+    db_rocksdb_compact_write_bytes,
+    db_rocksdb_block_cache_hit,
+    db_rocksdb_block_cache_miss,
+    db_rocksdb_block_cache_hit_rate,
+    db_rocksdb_pending_compaction_bytes,
+    db_rocksdb_write_stopped,
+    db_rocksdb_delayed_write_rate,
 
     // consensus
     cons_drand_leader_finish_succ,// TODO(jimmy) delete future
@@ -157,6 +190,12 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     cons_tablemaker_make_proposal_tick,
     cons_tablemaker_check_state_tick,
     cons_tablemaker_refresh_cache,
+    // per proposal phase durations(ms) of table consensus, see xbatch_packer timeline
+    cons_timeline_leader_pack_ms,
+    cons_timeline_leader_send_ms,
+    cons_timeline_backup_verify_ms,
+    cons_timeline_cert_ms,
+    cons_timeline_commit_ms,
 
     cons_table_leader_get_txpool_tx_count,
     cons_table_leader_get_txpool_sendtx_count,
@@ -204,6 +243,7 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     store_block_table_write,
     store_block_unit_write,
     store_block_other_write,
+    store_block_batch_write,
     store_block_index_table_write,
     store_block_index_unit_write,
     store_block_index_other_write,
@@ -357,9 +397,12 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     txpool_pull_recv_tx,
     txpool_pull_confirm_tx,
     txpool_push_tx_from_proposal,
+    txpool_push_tx_deferred,
     txpool_send_tx_cur,
     txpool_recv_tx_cur,
     txpool_confirm_tx_cur,
+    txpool_tx_bytes_cur,
+    txpool_send_tx_evicted,
     txpool_unconfirm_tx_cur,
     txpool_recv_tx_first_send_fail,
     txpool_confirm_tx_first_send_fail,
@@ -401,17 +444,24 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     txpool_alarm_confirm_tx_reached_upper_limit,
     txpool_alarm_recv_tx_reached_upper_limit,
     txpool_alarm_send_tx_reached_upper_limit,
+    txpool_alarm_tx_bytes_reached_upper_limit,
     txpool_sync_on_demand_unit,
     txpool_sender_unconfirm_cache,
     txpool_receiver_unconfirm_cache,
     txpool_height_record_cache,
     txpool_table_unconfirm_raw_txs,
+    txpool_tx_signature_cache_hit,
     // txstore
     txstore_request_origin_tx,
     txstore_cache_origin_tx,
+    txstore_cache_hit,
+    txstore_cache_miss,
+    txstore_cache_evict,
 
     // blockstore
     blockstore_index_load,
+    blockstore_index_ring_hit,
+    blockstore_prefetch_block,
     blockstore_blk_load,
 
     // blockstore accessing
@@ -706,9 +756,16 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     statectx_load_block_succ,
     statectx_load_state_succ,
     statectx_sync_invoke_count,
+    statectx_prefetch_unitstate,
 
     mpt_total_pruned_trie_node_cnt,
     mpt_cached_pruned_trie_node_cnt,
+    mpt_trie_clean_cache_hit,
+    mpt_trie_clean_cache_miss,
+    mpt_trie_clean_cache_bytes,
+    mpt_snapshot_hit,
+    mpt_snapshot_miss,
+    mpt_snapshot_diff_layers,
     //prune
     prune_block_table,
     prune_block_unit,
@@ -716,6 +773,8 @@ enum E_SIMPLE_METRICS_TAG : size_t {
     prune_block_timer,
     prune_block_contract,
     prune_state_unitstate,
+    prune_block_backlog,
+    prune_block_reclaimed,
     e_simple_total,
 };
 using xmetrics_tag_t = E_SIMPLE_METRICS_TAG;
@@ -733,10 +792,48 @@ enum E_ARRAY_COUNTER_TAG : size_t {
     blockstore_beacon_table_block_genesis_connect,
     blockstore_zec_table_block_genesis_connect,
 
+    // indexed by column family id
+    db_cf_block_cache_hit,
+    db_cf_block_cache_miss,
+
+    // indexed by worker of consensus workpool
+    cons_worker_queue_size,
+    cons_worker_packer_count,
+    cons_worker_clock_time_us,
+
+    // indexed by sharding table id, leader proposal to cert latency
+    cons_sharding_table_cert_latency_ms,
+    cons_sharding_table_cert_latency_ewma_ms,
+
+    // indexed by worker of transport MultiThreadHandler
+    transport_worker_queue_size,
+
     e_array_counter_total,
 };
 using xmetrics_array_tag_t = E_ARRAY_COUNTER_TAG;
 
+// latency distributions in microseconds, dumped as percentiles
+enum E_HISTOGRAM_TAG : size_t {
+    e_histogram_begin = 0,
+
+    // wall-clock time of the db calls
+    db_read_latency_hist,
+    db_write_latency_hist,
+    db_delete_latency_hist,
+    db_compact_latency_hist,
+
+    // async mbus listeners, time an event waits in the queue and time the listener takes
+    mbus_listener_wait_hist,
+    mbus_listener_handle_hist,
+
+    // vnode dispatchers of vhost, time a message waits in the queue of its vnode and time the vnode takes
+    vhost_dispatch_wait_hist,
+    vhost_dispatch_handle_hist,
+
+    e_histogram_total,
+};
+using xmetrics_histogram_tag_t = E_HISTOGRAM_TAG;
+
 #ifdef ENABLE_METRICS
 // ! attention. here the copy is not atomic.
 template <typename T>
@@ -802,10 +899,12 @@ public:
 private:
     XDECLARE_DEFAULTED_DEFAULT_CONSTRUCTOR(e_metrics);
     void run_process();
-    void process_message_queue();
+    std::size_t process_message_queue();
     void update_dump();
     void gauge_dump();
     void array_count_dump();
+    void histogram_dump();
+    void publish_hub_openmetrics();
 
 public:
     void timer_start(std::string metrics_name, time_point value);
@@ -820,6 +919,12 @@ public:
     void array_counter_increase(E_ARRAY_COUNTER_TAG tag, std::size_t index, int64_t value);
     void array_counter_decrease(E_ARRAY_COUNTER_TAG tag, std::size_t index, int64_t value);
     void array_counter_set(E_ARRAY_COUNTER_TAG tag, std::size_t index, int64_t value);
+    void histogram_record(E_HISTOGRAM_TAG tag, uint64_t value);
+    xhistogram_snapshot_t histogram_get(E_HISTOGRAM_TAG tag);
+
+    // OpenMetrics exposition of all metrics. tagged metrics are read live, the queued ones come from the
+    // snapshot the process thread publishes, at most one queue pass behind.
+    std::string openmetrics_text();
 
 private:
     std::thread m_process_thread;
@@ -829,15 +934,19 @@ private:
     handler::timer_handler_t m_timer_handler;
     handler::flow_handler_t m_flow_handler;
     handler::array_counter_handler_t m_array_counter_handler;
-    constexpr static std::size_t message_queue_size{500000};
-    top::threading::xthreadsafe_queue<event_message, std::vector<event_message>> m_message_queue{message_queue_size};
+    handler::histogram_handler_t m_histogram_handler;
+    // the ring is preallocated, so it is smaller than the list it replaced; the process thread skips its sleep
+    // while the queue fills faster than it drains
+    constexpr static std::size_t message_queue_size{1 << 17};
+    top::threading::xbounded_queue<event_message> m_message_queue{message_queue_size};
+    uint64_t m_message_queue_dropped{0};
     std::map<std::string, metrics_variant_ptr> m_metrics_hub;  // {metrics_name, metrics_vaiant_ptr}
+    std::atomic<uint64_t> m_hub_bytes{0};  // estimated memory of m_metrics_hub, read by basic::xmemory_accounting_t
+    std::atomic<uint64_t> m_hub_size{0};
+    std::atomic<bool> m_hub_openmetrics_wanted{false};
+    std::shared_ptr<std::string const> m_hub_openmetrics;  // accessed with std::atomic_load / std::atomic_store only
 protected:
-    struct simple_counter{
-        std::atomic_long value;
-        std::atomic_long call_count;
-    };
-    simple_counter s_counters[e_simple_total]; // simple counter counter
+    xsharded_counters_t<e_simple_total> s_counters; // simple counter counter, sharded by thread
     metrics_variant_ptr s_metrics[e_simple_total]; // simple metrics dump info
 
     struct array_counter{
@@ -846,6 +955,9 @@ protected:
     };
     array_counter a_counters[e_array_counter_total];
     metrics_variant_ptr a_metrics[e_array_counter_total];
+
+    xlatency_histogram_t h_histograms[e_histogram_total];
+    metrics_variant_ptr h_metrics[e_histogram_total];
 };
 
 class metrics_time_auto {
@@ -992,6 +1104,8 @@ private:
 #define XMETRICS_ARRCNT_DECR(metrics_name, index, value) top::metrics::e_metrics::get_instance().array_counter_decrease(metrics_name, index, value)
 #define XMETRICS_ARRCNT_SET(metrics_name, index, value) top::metrics::e_metrics::get_instance().array_counter_set(metrics_name, index, value)
 
+#define XMETRICS_HISTOGRAM(TAG, value) top::metrics::e_metrics::get_instance().histogram_record(TAG, value)
+
 #else
 #define XMETRICS_INIT()
 #define XMETRICS_INIT2(log_path)
@@ -1023,6 +1137,7 @@ private:
 #define XMETRICS_ARRCNT_INCR(metrics_name, index, value)
 #define XMETRICS_ARRCNT_DECR(metrics_name, index, value)
 #define XMETRICS_ARRCNT_SET(metrics_name, index, value)
+#define XMETRICS_HISTOGRAM(TAG, value)
 #define XMETRICS_TIMER(tag)
 #endif
 
@@ -12,6 +12,7 @@ enum class e_metrics_major_id : size_t {
     timer = 2,
     flow = 3,
     array = 4, // only support directly used with atomic interger for now (lack of metrics queue relevant code (todo charles))
+    histogram = 5, // recorded into thread sharded buckets, never through the metrics queue
 };
 
 enum class e_metrics_minor_id : size_t {
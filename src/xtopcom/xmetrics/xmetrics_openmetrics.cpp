@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xmetrics/xmetrics_openmetrics.h"
+
+namespace top {
+namespace metrics {
+
+namespace {
+
+std::string escape_label_value(std::string const & value) {
+    std::string result;
+    result.reserve(value.size());
+    for (auto const c : value) {
+        switch (c) {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '"':
+            result += "\\\"";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        default:
+            result += c;
+            break;
+        }
+    }
+    return result;
+}
+
+std::string sanitize_name(std::string const & raw_name) {
+    std::string result{"top_"};
+    result.reserve(result.size() + raw_name.size());
+    for (auto const c : raw_name) {
+        bool const allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+        result += allowed ? c : '_';
+    }
+    return result;
+}
+
+}  // namespace
+
+constexpr char const * xopenmetrics_writer_t::content_type;
+
+std::string metrics_labels(std::initializer_list<std::pair<std::string, std::string>> labels) {
+    std::string result;
+    for (auto const & label : labels) {
+        result = xopenmetrics_writer_t::add_label(result, label.first, label.second);
+    }
+    return result;
+}
+
+std::string xopenmetrics_writer_t::family(std::string const & raw_name, char const * type, char const * unit) {
+    auto name = sanitize_name(raw_name);
+    if (unit != nullptr) {
+        name += '_';
+        name += unit;
+    }
+    m_text += "# TYPE " + name + " " + type + "\n";
+    if (unit != nullptr) {
+        m_text += "# UNIT " + name + " " + unit + "\n";
+    }
+    return name;
+}
+
+void xopenmetrics_writer_t::sample(std::string const & name, std::string const & labels, int64_t const value) {
+    m_text += name + labels + " " + std::to_string(value) + "\n";
+}
+
+void xopenmetrics_writer_t::sample(std::string const & name, std::string const & labels, uint64_t const value) {
+    m_text += name + labels + " " + std::to_string(value) + "\n";
+}
+
+void xopenmetrics_writer_t::append(std::string const & text) {
+    m_text += text;
+}
+
+std::string xopenmetrics_writer_t::take() {
+    std::string result;
+    result.swap(m_text);
+    return result;
+}
+
+std::string xopenmetrics_writer_t::finish() {
+    m_text += "# EOF\n";
+    return take();
+}
+
+std::pair<std::string, std::string> xopenmetrics_writer_t::split_labels(std::string const & raw_name) {
+    auto const pos = raw_name.find('{');
+    if (pos == std::string::npos || raw_name.back() != '}') {
+        return {raw_name, std::string{}};
+    }
+    return {raw_name.substr(0, pos), raw_name.substr(pos)};
+}
+
+std::string xopenmetrics_writer_t::add_label(std::string const & labels, std::string const & key, std::string const & value) {
+    auto const label = key + "=\"" + escape_label_value(value) + "\"";
+    if (labels.empty()) {
+        return "{" + label + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + label + "}";
+}
+
+}  // namespace metrics
+}  // namespace top
@@ -0,0 +1,48 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+namespace top {
+namespace metrics {
+
+/* label set of one metric, rendered as {key="value",...}.
+ * appended to the name of a queued metric it becomes the labels of the exposed sample instead of being
+ * part of the metric name, e.g. XMETRICS_COUNTER_INCREMENT("vhost_out_send" + metrics_labels({{"category", "3"}}), 1).
+ */
+std::string metrics_labels(std::initializer_list<std::pair<std::string, std::string>> labels);
+
+/* builds an OpenMetrics text exposition.
+ * families are prefixed with top_ and sanitized to the allowed charset, the caller supplies complete sample suffixes.
+ */
+class xopenmetrics_writer_t {
+public:
+    static constexpr char const * content_type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+    // starts a family, returns the sanitized family name to build sample names from
+    std::string family(std::string const & raw_name, char const * type, char const * unit = nullptr);
+    void sample(std::string const & name, std::string const & labels, int64_t value);
+    void sample(std::string const & name, std::string const & labels, uint64_t value);
+    void append(std::string const & text);
+    // the exposition so far, to be appended to another writer
+    std::string take();
+    // the complete exposition
+    std::string finish();
+
+    // splits "name{labels}" into its name and label set
+    static std::pair<std::string, std::string> split_labels(std::string const & raw_name);
+    // adds one more label to a rendered label set
+    static std::string add_label(std::string const & labels, std::string const & key, std::string const & value);
+
+private:
+    std::string m_text;
+};
+
+}  // namespace metrics
+}  // namespace top
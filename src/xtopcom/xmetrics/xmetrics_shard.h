@@ -0,0 +1,173 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace top {
+namespace metrics {
+
+/* shards of the metrics indexed by compile-time tags.
+ * every thread writes into the shard it is assigned on first use with relaxed atomics, so recording takes
+ * neither a lock nor an allocation and threads do not bounce each other's cache lines. readers sum all
+ * shards on scrape.
+ */
+constexpr std::size_t metrics_shard_count{16};
+
+inline std::size_t metrics_shard_index() noexcept {
+    static std::atomic<std::size_t> next_shard{0};
+    thread_local std::size_t const shard = next_shard.fetch_add(1, std::memory_order_relaxed) % metrics_shard_count;
+    return shard;
+}
+
+template <std::size_t N>
+class xsharded_counters_t {
+public:
+    void add(std::size_t const tag, int64_t const value) noexcept {
+        auto & shard = m_shards[metrics_shard_index()];
+        shard.value[tag].fetch_add(value, std::memory_order_relaxed);
+        shard.count[tag].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ! attention. adds racing against set on other threads may be lost, set is meant for gauges of a single writer.
+    void set(std::size_t const tag, int64_t const value) noexcept {
+        auto const mine = metrics_shard_index();
+        for (std::size_t i = 0; i < metrics_shard_count; ++i) {
+            m_shards[i].value[tag].store(i == mine ? value : 0, std::memory_order_relaxed);
+        }
+        m_shards[mine].count[tag].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t value(std::size_t const tag) const noexcept {
+        int64_t total{0};
+        for (auto const & shard : m_shards) {
+            total += shard.value[tag].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t count(std::size_t const tag) const noexcept {
+        uint64_t total{0};
+        for (auto const & shard : m_shards) {
+            total += shard.count[tag].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) shard_t {
+        std::array<std::atomic<int64_t>, N> value{};
+        std::array<std::atomic<uint64_t>, N> count{};
+    };
+    std::array<shard_t, metrics_shard_count> m_shards{};
+};
+
+/* hdr-style latency histogram: values below 32 have a bucket each, above that every power of two is split into
+ * 16 buckets, so any percentile is reported within 1/16 of the true value at a fixed memory cost.
+ */
+struct xhistogram_snapshot_t {
+    static constexpr std::size_t sub_bucket_bits{4};
+    static constexpr std::size_t sub_bucket_count{std::size_t{1} << sub_bucket_bits};
+    static constexpr std::size_t max_value_bits{36};  // about 19 hours in microseconds, larger values are clamped
+    static constexpr std::size_t bucket_count{(max_value_bits - sub_bucket_bits + 1) * sub_bucket_count};
+
+    std::array<uint64_t, bucket_count> buckets{};
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+
+    static std::size_t bucket_of(uint64_t value) noexcept {
+        if (value >= (uint64_t{1} << max_value_bits)) {
+            value = (uint64_t{1} << max_value_bits) - 1;
+        }
+        if (value < 2 * sub_bucket_count) {
+            return static_cast<std::size_t>(value);
+        }
+        auto const msb = static_cast<std::size_t>(63 - __builtin_clzll(value));
+        auto const shift = msb - sub_bucket_bits;
+        return shift * sub_bucket_count + static_cast<std::size_t>(value >> shift);
+    }
+
+    // lowest value that falls into the bucket
+    static uint64_t lower_bound_of(std::size_t const bucket) noexcept {
+        if (bucket < 2 * sub_bucket_count) {
+            return bucket;
+        }
+        auto const shift = bucket / sub_bucket_count - 1;
+        return static_cast<uint64_t>(bucket - shift * sub_bucket_count) << shift;
+    }
+
+    static uint64_t upper_bound_of(std::size_t const bucket) noexcept {
+        return lower_bound_of(bucket + 1) - 1;
+    }
+
+    // value at quantile q in [0, 1], reported as the upper bound of its bucket and never above the recorded max
+    uint64_t percentile(double const q) const noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+        if (rank == 0) {
+            rank = 1;
+        }
+        uint64_t seen{0};
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                auto const upper = upper_bound_of(i);
+                return upper < max ? upper : max;
+            }
+        }
+        return max;
+    }
+
+    uint64_t mean() const noexcept {
+        return count == 0 ? 0 : sum / count;
+    }
+};
+
+class xlatency_histogram_t {
+public:
+    void record(uint64_t const value) noexcept {
+        auto & shard = m_shards[metrics_shard_index()];
+        shard.buckets[xhistogram_snapshot_t::bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        auto max = shard.max.load(std::memory_order_relaxed);
+        while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    xhistogram_snapshot_t snapshot() const noexcept {
+        xhistogram_snapshot_t result;
+        for (auto const & shard : m_shards) {
+            for (std::size_t i = 0; i < xhistogram_snapshot_t::bucket_count; ++i) {
+                result.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+            }
+            result.count += shard.count.load(std::memory_order_relaxed);
+            result.sum += shard.sum.load(std::memory_order_relaxed);
+            auto const max = shard.max.load(std::memory_order_relaxed);
+            if (max > result.max) {
+                result.max = max;
+            }
+        }
+        return result;
+    }
+
+private:
+    struct alignas(64) shard_t {
+        std::array<std::atomic<uint64_t>, xhistogram_snapshot_t::bucket_count> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> max{0};
+    };
+    std::array<shard_t, metrics_shard_count> m_shards{};
+};
+
+}  // namespace metrics
+}  // namespace top
@@ -96,9 +96,28 @@ struct metrics_array_unit{
 };
 using metrics_array_unit_ptr = std::shared_ptr<metrics_array_unit>;
 
+/* histogram_unit
+ * recorder one metrics_name of its latency distribution, percentiles are taken from the buckets on dump.
+ */
+struct metrics_histogram_unit {
+    std::string name;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t last_dump_count;
+
+    metrics_histogram_unit(std::string _name) : name{_name}, count{0}, sum{0}, max{0}, p50{0}, p90{0}, p99{0}, p999{0}, last_dump_count{0} {
+    }
+};
+using metrics_histogram_unit_ptr = std::shared_ptr<metrics_histogram_unit>;
+
 // ! the Variant order must be as same as e_metrics_major_id
-// ! that is : [0-invalid], 1-counter 2-timer 3-flow
+// ! that is : [0-invalid], 1-counter 2-timer 3-flow 4-array 5-histogram
 // ! or Variant.GetType() might be wrong.
-using metrics_variant_ptr = Variant<metrics_counter_unit_ptr, metrics_timer_unit_ptr, metrics_flow_unit_ptr, metrics_array_unit_ptr>;
+using metrics_variant_ptr = Variant<metrics_counter_unit_ptr, metrics_timer_unit_ptr, metrics_flow_unit_ptr, metrics_array_unit_ptr, metrics_histogram_unit_ptr>;
 
 NS_END2
\ No newline at end of file
@@ -3,6 +3,7 @@
 // Licensed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <iostream>
 #include "xvledger/xvdbfilter.h"
 #include "xdb/xdb_factory.h"
@@ -35,26 +36,75 @@ namespace top
     
         bool  xmigratedb_t::close_db()
         {
+            flush_bulk_load();
             return m_db_face_ptr->close();
         }
+
+        void  xmigratedb_t::enable_bulk_load(const size_t batch_bytes)
+        {
+            std::lock_guard<std::mutex> _lock(m_bulk_lock);
+            m_bulk_batch_bytes = batch_bytes;
+            xkinfo("xmigratedb_t::enable_bulk_load,db_path(%s),batch_bytes=%zu",m_store_path.c_str(),batch_bytes);
+        }
+
+        bool  xmigratedb_t::flush_bulk_load()
+        {
+            std::lock_guard<std::mutex> _lock(m_bulk_lock);
+            return bulk_load(m_bulk_objs);
+        }
+
+        //caller hold m_bulk_lock,so reader never miss the keys being ingested
+        bool  xmigratedb_t::bulk_load(std::map<std::string, std::string> & batch)
+        {
+            if (batch.empty())
+                return true;
+            const bool ret = m_db_face_ptr->bulk_load(batch);
+            if (!ret)
+                xerror("xmigratedb_t::bulk_load,fail to ingest %zu keys,db_path(%s)",batch.size(),m_store_path.c_str());
+            batch.clear();
+            m_bulk_bytes = 0;
+            return ret;
+        }
     
         bool xmigratedb_t::set_value(const std::string &key, const std::string &value)
         {
-            return m_db_face_ptr->write(key, value);
+            std::map<std::string, std::string> batch;
+            batch[key] = value;
+            return set_values(batch);
         }
 
         bool xmigratedb_t::set_values(const std::map<std::string, std::string> & batch)
         {
-            return m_db_face_ptr->batch_change(batch, {});
+            std::lock_guard<std::mutex> _lock(m_bulk_lock);
+            if (0 == m_bulk_batch_bytes)
+                return m_db_face_ptr->batch_change(batch, {});
+
+            for (auto const & entry : batch)
+            {
+                auto & buffered = m_bulk_objs[entry.first];
+                m_bulk_bytes = m_bulk_bytes - std::min(m_bulk_bytes, buffered.size()) + entry.first.size() + entry.second.size();
+                buffered = entry.second;
+            }
+            if (m_bulk_bytes < m_bulk_batch_bytes)
+                return true;
+            return bulk_load(m_bulk_objs);
         }
         
         bool xmigratedb_t::delete_value(const std::string &key)
         {
+            std::lock_guard<std::mutex> _lock(m_bulk_lock);
+            m_bulk_objs.erase(key);
             return m_db_face_ptr->erase(key);
         }
         
         const std::string xmigratedb_t::get_value(const std::string &key) const
         {
+            {
+                std::lock_guard<std::mutex> _lock(m_bulk_lock);
+                auto it = m_bulk_objs.find(key);
+                if (it != m_bulk_objs.end())
+                    return it->second;
+            }
             std::string value;
             bool success = m_db_face_ptr->read(key, value);
             if (!success)
@@ -66,6 +116,9 @@ namespace top
         
         bool  xmigratedb_t::delete_values(const std::vector<std::string> & to_deleted_keys)
         {
+            std::lock_guard<std::mutex> _lock(m_bulk_lock);
+            for (auto const & key : to_deleted_keys)
+                m_bulk_objs.erase(key);
             std::map<std::string, std::string> empty_put;
             return m_db_face_ptr->batch_change(empty_put, to_deleted_keys);
         }
@@ -216,6 +269,8 @@ namespace top
                     xerror("xdbmigrate_t::init,failed to open src DB at path(%s)",src_db_path.c_str());
                     return enum_xerror_code_bad_config;
                 }
+                //dst db only receive migrated keys,so ingest them as sorted files instead of going through memtable & WAL
+                m_dst_store_ptr->enable_bulk_load(BULK_LOAD_BATCH_BYTES);
             }
 
             //step#4 : load filters at order
@@ -475,6 +530,14 @@ namespace top
                     scan_key_without_multi_thread();
 #endif
 
+                    //version is set only after every migrated key is in dst db,so a failed migration is redone at next start
+                    if (m_dst_store_ptr->flush_bulk_load() == false)
+                    {
+                        xerror("xdbmigrate_t::run,failed to flush bulk load of dst db");
+                        close();
+                        return false;
+                    }
+
 #if 0  // TODO(jimmy)
                     std::string begin_key;
                     std::string end_key;
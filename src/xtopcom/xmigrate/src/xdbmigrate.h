@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #pragma once
+#include <mutex>
 #include <thread>
 #include "../xvmigrate.h"
 #include "xvledger/xvdbstore.h"
@@ -63,9 +64,19 @@ namespace top
             bool    open_db();
             bool    close_db();
             virtual std::string      get_store_path() const  override {return m_store_path;}
+            //bulk mode:values are buffered and ingested into DB once buffer reach batch_bytes,read of buffered key still see it
+            void    enable_bulk_load(const size_t batch_bytes);
+            //ingest every buffered value,must be called before close
+            bool    flush_bulk_load();
+        private:
+            bool    bulk_load(std::map<std::string, std::string> & batch);
         private:
             std::string              m_store_path;
             std::shared_ptr<db::xdb_face_t> m_db_face_ptr;
+            mutable std::mutex       m_bulk_lock;
+            std::map<std::string, std::string> m_bulk_objs;
+            size_t                   m_bulk_bytes{0};
+            size_t                   m_bulk_batch_bytes{0}; //0 means bulk mode is off
         };
     
         class xdbmigrate_t : public xvmigrate_t
@@ -103,6 +114,7 @@ namespace top
             uint64_t                  m_total_keys_num{0};
             std::string               m_dst_db_version;
             const static uint32_t     THREAD_NUM{8};
+            const static size_t       BULK_LOAD_BATCH_BYTES{256 * 1024 * 1024};
             uint32_t                  m_thread_index_set{0};
             std::mutex                th_locks[THREAD_NUM];
             std::vector<xdbevent_t*> th_dbevents[THREAD_NUM];
@@ -70,6 +70,59 @@ bool xmutisig::verify_sign(const std::string & msg, const xpubkey & pubkey, cons
     return result;
 }
 
+bool xmutisig::batch_verify_sign(const std::vector<std::string> & msgs,
+                                 const std::vector<xpubkey> & pubkeys,
+                                 const std::vector<std::string> & sign_strs,
+                                 const std::vector<std::string> & point_strs,
+                                 xschnorr * _schnorr) {
+    const size_t count = msgs.size();
+    if (count == 0 || pubkeys.size() != count || sign_strs.size() != count || point_strs.size() != count || nullptr == _schnorr) {
+        return false;
+    }
+
+    std::vector<xsignature> signs;
+    std::vector<xrand_point> points;
+    signs.reserve(count);
+    points.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        signs.emplace_back(sign_strs[i]);
+        points.emplace_back(point_strs[i]);
+    }
+
+    std::vector<const xsignature *> sign_ptrs;
+    std::vector<const xpubkey *> pubkey_ptrs;
+    std::vector<const xrand_point *> point_ptrs;
+    std::vector<BIGNUM *> bns;
+    sign_ptrs.reserve(count);
+    pubkey_ptrs.reserve(count);
+    point_ptrs.reserve(count);
+    bns.reserve(count);
+    bool result = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (signs[i].bn_value() == nullptr || points[i].ec_point() == nullptr || pubkeys[i].ec_point() == nullptr) {
+            result = false;
+            break;
+        }
+        BIGNUM * bn = generate_object_bn(msgs[i], _schnorr);
+        if (nullptr == bn) {
+            result = false;
+            break;
+        }
+        bns.push_back(bn);
+        sign_ptrs.push_back(&signs[i]);
+        pubkey_ptrs.push_back(&pubkeys[i]);
+        point_ptrs.push_back(&points[i]);
+    }
+    if (result) {
+        result = _schnorr->batch_verify_sign(sign_ptrs, pubkey_ptrs, bns, point_ptrs);
+    }
+
+    for (auto bn : bns) {
+        BN_free(bn);
+    }
+    return result;
+}
+
 uint32_t xmutisig::sign_base(const xsecret_rand & rand, BIGNUM * object, const xprikey & prikey, xsignature & sign, xschnorr * _schnorr) {
 #ifdef DEBUG
     xassert(nullptr != object);
@@ -260,3 +313,29 @@ std::shared_ptr<xpubkey> xmutisig::aggregate_pubkeys_2(const std::vector<xpubkey
     }
     return agg_pubkey;
 }
+
+std::shared_ptr<xpubkey> xmutisig::subtract_pubkeys(const xpubkey & agg_pubkey, const std::vector<const xpubkey *> & pubkeys, xschnorr * _schnorr) {
+    xassert(nullptr != _schnorr);
+    xassert(nullptr != _schnorr->curve());
+    if (nullptr == _schnorr || nullptr == _schnorr->curve()) {
+        return nullptr;
+    }
+    std::shared_ptr<xpubkey> result = std::make_shared<xpubkey>(agg_pubkey);
+    std::unique_ptr<BN_CTX, void (*)(BN_CTX *)> ctx(BN_CTX_new(), BN_CTX_free);
+    if (nullptr == ctx) {
+        return nullptr;
+    }
+    for (auto pubkey : pubkeys) {
+        if (nullptr == pubkey) {
+            return nullptr;
+        }
+        xpubkey negative(*pubkey);
+        if (EC_POINT_invert(_schnorr->curve()->ec_group(), negative.ec_point(), ctx.get()) != 1) {
+            return nullptr;
+        }
+        if (EC_POINT_add(_schnorr->curve()->ec_group(), result->ec_point(), result->ec_point(), negative.ec_point(), ctx.get()) != 1) {
+            return nullptr;
+        }
+    }
+    return result;
+}
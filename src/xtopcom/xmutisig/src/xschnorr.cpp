@@ -107,6 +107,72 @@ bool xschnorr::verify_mutisign(const xsignature & mutisign, const xpubkey & agg_
     return result;
 }
 
+bool xschnorr::batch_verify_sign(const std::vector<const xsignature *> & signs,
+                                 const std::vector<const xpubkey *> & pubkeys,
+                                 const std::vector<BIGNUM *> & objects,
+                                 const std::vector<const xrand_point *> & points) {
+    const size_t count = signs.size();
+    if (count == 0 || pubkeys.size() != count || objects.size() != count || points.size() != count || m_curve == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (nullptr == signs[i] || nullptr == pubkeys[i] || nullptr == objects[i] || nullptr == points[i] || !signature_bignum_legal(*signs[i])) {
+            return false;
+        }
+    }
+
+    std::unique_ptr<BN_CTX, void (*)(BN_CTX *)> ctx(BN_CTX_new(), BN_CTX_free);
+    std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> sum_s(BN_new(), BN_free);
+    std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> tmp(BN_new(), BN_free);
+    std::unique_ptr<EC_POINT, void (*)(EC_POINT *)> result(generate_ec_point(), EC_POINT_free);
+    if (nullptr == ctx || nullptr == sum_s || nullptr == tmp || nullptr == result) {
+        return false;
+    }
+    BN_zero(sum_s.get());
+
+    // a_i is a random 128 bits weight, so a forged signature can not cancel out another one
+    std::vector<std::unique_ptr<BIGNUM, void (*)(BIGNUM *)>> scalars;
+    std::vector<const EC_POINT *> ec_points;
+    scalars.reserve(count * 2);
+    ec_points.reserve(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> weight(BN_new(), BN_free);
+        std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> pub_scalar(BN_new(), BN_free);
+        std::unique_ptr<BIGNUM, void (*)(BIGNUM *)> point_scalar(BN_new(), BN_free);
+        if (nullptr == weight || nullptr == pub_scalar || nullptr == point_scalar || BN_rand(weight.get(), 128, -1, 0) != 1) {
+            return false;
+        }
+        if (BN_is_zero(weight.get())) {
+            BN_one(weight.get());
+        }
+        // sum_s += a_i * s_i
+        if (BN_mod_mul(tmp.get(), weight.get(), signs[i]->bn_value(), m_curve->bn_order(), ctx.get()) != 1 ||
+            BN_mod_add(sum_s.get(), sum_s.get(), tmp.get(), m_curve->bn_order(), ctx.get()) != 1) {
+            return false;
+        }
+        // a_i * e_i for P_i, and -a_i for R_i
+        if (BN_mod_mul(pub_scalar.get(), weight.get(), objects[i], m_curve->bn_order(), ctx.get()) != 1 ||
+            BN_sub(point_scalar.get(), m_curve->bn_order(), weight.get()) != 1) {
+            return false;
+        }
+        ec_points.push_back(pubkeys[i]->ec_point());
+        scalars.push_back(std::move(pub_scalar));
+        ec_points.push_back(points[i]->ec_point());
+        scalars.push_back(std::move(point_scalar));
+    }
+
+    std::vector<const BIGNUM *> raw_scalars;
+    raw_scalars.reserve(scalars.size());
+    for (auto const & scalar : scalars) {
+        raw_scalars.push_back(scalar.get());
+    }
+    int ret = EC_POINTs_mul(m_curve->ec_group(), result.get(), sum_s.get(), ec_points.size(), ec_points.data(), raw_scalars.data(), ctx.get());
+    if (ret != 1) {
+        return false;
+    }
+    return EC_POINT_is_at_infinity(m_curve->ec_group(), result.get()) == 1;
+}
+
 BIGNUM * xschnorr::generate_nonzero_bn() {
     BIGNUM * new_bn = BN_new();
 
@@ -38,6 +38,16 @@ public:
 
     static bool verify_sign(const std::string & msg, const xpubkey & pubkey, const std::string & sign, const std::string & point, xschnorr * _schnorr);
 
+    /*
+     * verify many sign pairs<sign, point> at once, true only if all of them are good
+     */
+
+    static bool batch_verify_sign(const std::vector<std::string> & msgs,
+                                  const std::vector<xpubkey> & pubkeys,
+                                  const std::vector<std::string> & signs,
+                                  const std::vector<std::string> & points,
+                                  xschnorr * _schnorr);
+
 public:
     /*
      * verify signature/muti_signature, true: ok, false: failed
@@ -73,6 +83,8 @@ public:
 
     static std::shared_ptr<xpubkey> aggregate_pubkeys(const std::vector<xpubkey *> & pubkeys, xschnorr * _schnorr);
     static std::shared_ptr<xpubkey> aggregate_pubkeys_2(const std::vector<xpubkey> & pubkeys, xschnorr * _schnorr);
+    // agg_pubkey - sum(pubkeys), cheaper than aggregating the rest when few are removed
+    static std::shared_ptr<xpubkey> subtract_pubkeys(const xpubkey & agg_pubkey, const std::vector<const xpubkey *> & pubkeys, xschnorr * _schnorr);
 
     static std::shared_ptr<xsignature> aggregate_signs(const std::vector<xsignature *> & signs, xschnorr * _schnorr);
 
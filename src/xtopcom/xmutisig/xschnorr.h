@@ -6,6 +6,8 @@
 #include "xmutisig/xrand_pair.h"
 #include "xmutisig/xsignature.h"
 
+#include <vector>
+
 NS_BEG2(top, xmutisig)
 
 class xcurve;
@@ -32,6 +34,15 @@ public:
 
     bool verify_mutisign(const xsignature & mutisign, const xpubkey & agg_pubs, BIGNUM * object, const xrand_point & agg_point);
 
+    /*
+     * verify many signatures by one random-weighted equation: sum(a_i*s_i)*G + sum(a_i*e_i*P_i) - sum(a_i*R_i) == O
+     * true only if all of them are good (with overwhelming probability), false means at least one is bad
+     */
+    bool batch_verify_sign(const std::vector<const xsignature *> & signs,
+                           const std::vector<const xpubkey *> & pubkeys,
+                           const std::vector<BIGNUM *> & objects,
+                           const std::vector<const xrand_point *> & points);
+
     uint32_t sign(const std::string & object, const xprikey & prikey, xsignature & signature);
 
 public:
@@ -4,10 +4,13 @@
 
 #pragma once
 #include <cinttypes>
+#include <set>
 
 #include "xbase/xcontext.h"
 #include "xbase/xutl.h"
 #include "xchain_fork/xchain_upgrade_center.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xdata/xcons_transaction.h"
 #include "xdata/xdatautil.h"
 #include "xdata/xnative_contract_address.h"
@@ -17,6 +20,8 @@
 #include "xedge_rpc_handler.h"
 #include "xmetrics/xmetrics.h"
 #include "xrpc/xrpc_query_manager.h"
+#include "xrpc/xrpc_eth_query_manager.h"
+#include "xrpc/xws/xws_subscription.h"
 #include "xrpc/xerror/xrpc_error.h"
 #include "xrpc/xjson_proc.h"
 #include "xrpc/xrpc_define.h"
@@ -61,6 +66,13 @@ public:
     void forward_method(shared_ptr<conn_type> & response, xjson_proc_t & json_proc);
     shared_ptr<xrpc_msg_request_t> generate_request(const xvnode_address_t & source_address, const uint64_t uuid, const string account, xjson_proc_t & json_proc);
     virtual void write_response(shared_ptr<conn_type> & response, const string & content) = 0;
+    // write the response of json_proc, or hand it to the batch the request is in
+    void reply(shared_ptr<conn_type> & response, xjson_proc_t & json_proc, const string & content) {
+        if (json_proc.m_batch != nullptr)
+            json_proc.m_batch->set(json_proc.m_batch_index, content);
+        else
+            write_response(response, content);
+    }
     T * get_edge_handler() {
         return m_edge_handler_ptr.get();
     }
@@ -73,10 +85,15 @@ public:
     void set_tx_by_version(data::xtransaction_ptr_t & tx_ptr, uint32_t version);
     void query_process(xjson_proc_t & json_proc);
 protected:
+    // answer a read from the local view of the eth table, false if it should be forwarded
+    bool local_query(shared_ptr<conn_type> & response, xjson_proc_t & json_proc, const std::string & method);
+
     unique_ptr<T> m_edge_handler_ptr;
     unordered_map<pair<string, string>, tx_method_handler> m_edge_tx_method_map;
     unique_ptr<xedge_local_method<T>> m_edge_local_method_ptr;
     std::shared_ptr<xrpc_query_manager> m_rpc_query_mgr;
+    std::shared_ptr<xrpc_eth_query_manager> m_rpc_eth_query_mgr{nullptr};  // edge local query only
+    observer_ptr<base::xvblockstore_t> m_block_store;
     top::observer_ptr<base::xvtxstore_t> m_txstore;
     bool m_archive_flag{false};  // for local query
     bool m_enable_sign{true};
@@ -116,9 +133,13 @@ xedge_evm_method_base<T>::xedge_evm_method_base(shared_ptr<xrpc_edge_vhost> edge
                                         observer_ptr<top::election::cache::xdata_accessor_face_t> const & election_cache_data_accessor)
   : m_edge_local_method_ptr(top::make_unique<xedge_local_method<T>>(elect_main, xip2))
   , m_rpc_query_mgr(std::make_shared<xrpc_query_manager>(block_store, nullptr, xtxpool_service_v2::xtxpool_proxy_face_ptr(nullptr), txstore, archive_flag))
+  , m_block_store(block_store)
   , m_txstore{txstore}
   , m_archive_flag(archive_flag)
 {
+    if (!archive_flag && block_store != nullptr && XGET_CONFIG(edge_local_query)) {
+        m_rpc_eth_query_mgr = std::make_shared<xrpc_eth_query_manager>(block_store, nullptr, xtxpool_service_v2::xtxpool_proxy_face_ptr(nullptr), txstore);
+    }
     m_edge_handler_ptr = top::make_unique<T>(edge_vhost, ioc, election_cache_data_accessor);
     m_edge_handler_ptr->init();
     //EDGE_REGISTER_V1_ACTION(T, sendTransaction);
@@ -140,6 +161,14 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
 
     if (jsonrpc_version != "2.0") {
         xerror("xedge_evm_method_base do_method fail-jsonrpc version not 2.0 version=%s", jsonrpc_version.c_str());
+        // a batch is only written once every request has a response
+        if (json_proc.m_batch != nullptr) {
+            xJson::Value err;
+            err["id"] = json_proc.m_request_json["id"];
+            err["jsonrpc"] = "2.0";
+            eth::EthErrorCode::deal_error(err, eth::enum_eth_rpc_invalid_request, "invalid json request");
+            reply(response, json_proc, xJson::FastWriter().write(err));
+        }
         return;
     }
     xJson::Value res;
@@ -149,7 +178,7 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
         xJson::FastWriter j_writer;
         std::string s_res = j_writer.write(res);
         xdbg("rpc response:%s", s_res.c_str());
-        write_response(response, s_res);
+        reply(response, json_proc, s_res);
         return;
     }
 
@@ -161,7 +190,7 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
         xJson::FastWriter j_writer;
         std::string s_res = j_writer.write(res);
         xdbg("rpc response:%s", s_res.c_str());
-        write_response(response, s_res);
+        reply(response, json_proc, s_res);
         return;
     }
 
@@ -172,10 +201,13 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
         iter->second(json_proc, ip);
         if (json_proc.m_response_json.isMember("error"))
         {
-            write_response(response, json_proc.get_response());
+            reply(response, json_proc, json_proc.get_response());
             return ;
         }
     } else {
+        if (local_query(response, json_proc, method)) {
+            return;
+        }
         if (m_archive_flag) {
             xdbg("local arc query method: %s", method.c_str());
             json_proc.m_request_json["params"]["version"] = version;
@@ -184,7 +216,7 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
             m_rpc_query_mgr->call_method(method, json_proc.m_request_json["params"], json_proc.m_response_json["data"], strErrorMsg, nErrorCode);
             json_proc.m_response_json[RPC_ERRNO] = nErrorCode;
             json_proc.m_response_json[RPC_ERRMSG] = strErrorMsg;
-            write_response(response, json_proc.get_response());
+            reply(response, json_proc, json_proc.get_response());
             return;
         } else {
             //query_process(json_proc);
@@ -194,6 +226,49 @@ void xedge_evm_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson
     forward_method(response, json_proc);
 }
 
+template <class T>
+bool xedge_evm_method_base<T>::local_query(shared_ptr<conn_type> & response, xjson_proc_t & json_proc, const std::string & method) {
+    // reads of the account state and of transactions, which the eth table alone answers
+    static const std::set<std::string> local_methods = {"eth_blockNumber",
+                                                        "eth_getBalance",
+                                                        "eth_getTransactionCount",
+                                                        "eth_getCode",
+                                                        "eth_getStorageAt",
+                                                        "eth_getTransactionByHash",
+                                                        "eth_getTransactionReceipt"};
+    if (m_rpc_eth_query_mgr == nullptr || local_methods.find(method) == local_methods.end()) {
+        return false;
+    }
+
+    base::xvaccount_t _table_addr(sys_contract_eth_table_block_addr_with_suffix);
+    auto block = m_block_store->get_latest_cert_block(_table_addr);
+    if (block == nullptr) {
+        return false;
+    }
+    uint64_t now = base::xtime_utl::gettimeofday();
+    if (block->get_second_level_gmtime() + XGET_CONFIG(edge_local_query_max_lag_s) < now) {
+        xdbg("xedge_evm_method_base::local_query stale view,height=%" PRIu64 ",time=%" PRIu64 ",now=%" PRIu64, block->get_height(), block->get_second_level_gmtime(), now);
+        return false;
+    }
+
+    string strErrorMsg = RPC_OK_MSG;
+    uint32_t nErrorCode = 0;
+    xJson::Value js_rsp;
+    m_rpc_eth_query_mgr->call_method(method, json_proc.m_request_json["params"], js_rsp, strErrorMsg, nErrorCode);
+    // a transaction not found yet may be newer than the local view
+    if (!js_rsp.isMember("error") && js_rsp["result"].isNull()) {
+        return false;
+    }
+
+    XMETRICS_COUNTER_INCREMENT("rpc_edge_local_query", 1);
+    js_rsp["id"] = json_proc.m_request_json["id"];
+    js_rsp["jsonrpc"] = json_proc.m_request_json["jsonrpc"];
+    js_rsp["servedHeight"] = xrpc_eth_parser_t::uint64_to_hex_prefixed(block->get_height());
+    xJson::FastWriter j_writer;
+    reply(response, json_proc, j_writer.write(js_rsp));
+    return true;
+}
+
 template <class T>
 void xedge_evm_method_base<T>::sendTransaction_method(xjson_proc_t & json_proc, const std::string & ip) {
     auto & request = json_proc.m_request_json;
@@ -269,6 +344,7 @@ void xedge_evm_method_base<T>::sendTransaction_method(xjson_proc_t & json_proc,
     const auto & from = tx->get_source_addr();
     json_proc.m_account_set.emplace(from);
     json_proc.m_response_json["result"] = tx_hash;
+    xws_subscription_mgr_t::instance().on_pending_transaction(tx_hash);
 }
 
 template <class T>
@@ -348,12 +424,12 @@ void xedge_evm_method_base<T>::forward_method(shared_ptr<conn_type> & response,
             json_proc.m_response_json[RPC_ERRNO] = RPC_OK_CODE;
             json_proc.m_response_json[RPC_ERRMSG] = RPC_OK_MSG;
             XMETRICS_COUNTER_INCREMENT("rpc_edge_tx_response", 1);
-            write_response(response, json_proc.get_response());
+            reply(response, json_proc, json_proc.get_response());
         } else {
             XMETRICS_COUNTER_INCREMENT("rpc_edge_query_response", 1);
             // auditor return query result directly, so clear shard addr set
             shard_addr_set.clear();
-            m_edge_handler_ptr->insert_session(edge_msg_list, shard_addr_set, response, rpc_msg_eth_query_request);
+            m_edge_handler_ptr->insert_session(edge_msg_list, shard_addr_set, response, rpc_msg_eth_query_request, json_proc.m_batch, json_proc.m_batch_index);
         }
     } while (0);
 }
@@ -16,6 +16,7 @@
 #include "xedge_rpc_handler.h"
 #include "xmetrics/xmetrics.h"
 #include "xrpc/xrpc_query_manager.h"
+#include "xrpc/xrpc_response_cache.h"
 #include "xrpc/xerror/xrpc_error.h"
 #include "xrpc/xjson_proc.h"
 #include "xrpc/xrpc_define.h"
@@ -165,10 +166,22 @@ void xedge_method_base<T>::do_method(shared_ptr<conn_type> & response, xjson_pro
             json_proc.m_request_json["params"]["version"] = version;
             string strErrorMsg = RPC_OK_MSG;
             uint32_t nErrorCode = 0;
-            m_rpc_query_mgr->call_method(method, json_proc.m_request_json["params"], json_proc.m_response_json["data"], strErrorMsg, nErrorCode);
+            auto & cache = xrpc_response_cache_t::instance();
+            std::string cache_key = xrpc_response_cache_t::make_key(method, json_proc.m_request_json["params"]);
+            std::string cached_result;
+            if (cache.get(cache_key, cached_result)) {
+                json_proc.m_response_json["data"] = xJson::Value::null;
+            } else {
+                m_rpc_query_mgr->call_method(method, json_proc.m_request_json["params"], json_proc.m_response_json["data"], strErrorMsg, nErrorCode);
+                if (nErrorCode == 0 && m_rpc_query_mgr->is_final_result(method, json_proc.m_request_json["params"], json_proc.m_response_json["data"]))
+                    cache.put(cache_key, json_proc.m_response_json["data"]);
+            }
             json_proc.m_response_json[RPC_ERRNO] = nErrorCode;
             json_proc.m_response_json[RPC_ERRMSG] = strErrorMsg;
-            write_response(response, json_proc.get_response());
+            std::string content = json_proc.get_response();
+            if (!cached_result.empty())
+                xrpc_response_cache_t::splice(content, "data", cached_result);
+            write_response(response, content);
             return;
         } else {
             json_proc.m_tx_type = enum_xrpc_tx_type::enum_xrpc_query_type;
@@ -43,7 +43,8 @@ public:
     void init();
     virtual void on_message(const xvnode_address_t&, const xrpc_msg_response_t& msg);
     void edge_send_msg(const std::vector<std::shared_ptr<xrpc_msg_request_t>>& edge_msg_list, const std::string &tx_hash, const std::string &account, const common::xenum_message_id& msg_type);
-    virtual void insert_session(const std::vector<shared_ptr<xrpc_msg_request_t>>&, const unordered_set<xvnode_address_t>&, shared_ptr<T>&, const common::xenum_message_id& msg_type);
+    virtual void insert_session(const std::vector<shared_ptr<xrpc_msg_request_t>>&, const unordered_set<xvnode_address_t>&, shared_ptr<T>&, const common::xenum_message_id& msg_type,
+                                std::shared_ptr<xrpc_batch_response_t> const& batch = nullptr, uint32_t batch_index = 0);
     virtual enum_xrpc_type type() = 0;
     uint64_t add_seq_id() { return ++m_msg_seq_id; }
     uint64_t get_seq_id() { return m_msg_seq_id; }
@@ -174,7 +175,7 @@ void xedge_handler_base<T>::on_message(const xvnode_address_t&, const xrpc_msg_r
                     msg.m_signature_address.cluster_address()
         });
         if (iter->second->m_destination_address.empty()) {
-            iter->second->write_response(msg.m_message_body);
+            iter->second->respond(msg.m_message_body);
             iter->second->cancel_timeout();
         }
     }
@@ -184,7 +185,8 @@ void xedge_handler_base<T>::on_message(const xvnode_address_t&, const xrpc_msg_r
 }
 template <class T>
 void xedge_handler_base<T>::insert_session(const std::vector<shared_ptr<xrpc_msg_request_t>>& edge_msg_ptr_list, 
-    const unordered_set<xvnode_address_t>& addr_set, shared_ptr<T>& response, const common::xenum_message_id& msg_type)
+    const unordered_set<xvnode_address_t>& addr_set, shared_ptr<T>& response, const common::xenum_message_id& msg_type,
+    std::shared_ptr<xrpc_batch_response_t> const& batch, uint32_t batch_index)
 {
     using session_type = forward_session<T>;
     auto & forward_session_map = m_forward_session_map;
@@ -200,6 +202,9 @@ void xedge_handler_base<T>::insert_session(const std::vector<shared_ptr<xrpc_msg
             DELETE(session);
     });
 
+    forward_session->m_batch = batch;
+    forward_session->m_batch_index = batch_index;
+
     std::lock_guard<std::mutex> lock(m_mutex);
     m_forward_session_map.emplace(edge_msg_ptr_list.front()->m_uuid, forward_session.get());
     xdbg_rpc("insert_session: %x, %x", edge_msg_ptr_list.front()->m_uuid, msg_type);
@@ -18,6 +18,7 @@
 #include "xrpc/xerror/xrpc_error_json.h"
 #include "xrpc/xerror/xrpc_error_code.h"
 #include "xrpc/xrpc_method.h"
+#include "xrpc/xrpc_batch_response.h"
 
 NS_BEG2(top, xrpc)
 using vnetwork::xvnode_address_t;
@@ -41,6 +42,13 @@ public:
         m_msg_type(msg_type) {}
     virtual ~xforward_session_base() {}
     virtual void write_response(const string&) = 0;
+    // write the response, or hand it to the batch the request is in
+    void respond(const string& response) {
+        if (m_batch != nullptr)
+            m_batch->set(m_batch_index, response);
+        else
+            write_response(response);
+    }
     void set_timeout(long seconds) noexcept;
     void cancel_timeout() noexcept;
 public:
@@ -52,6 +60,8 @@ public:
     int16_t                                             m_retry_num{ 1 };
     unordered_set<xvnode_address_t>                     m_destination_address{};
     common::xenum_message_id                            m_msg_type;
+    std::shared_ptr<xrpc_batch_response_t>              m_batch{nullptr};
+    uint32_t                                            m_batch_index{0};
 };
 
 template<class T>
@@ -74,7 +84,7 @@ void xforward_session_base<T>::set_timeout(long seconds) noexcept
                 self->set_timeout(TIME_OUT);
             } else {
                 xrpc_error_json error_json(static_cast<uint32_t>(enum_xrpc_error_code::rpc_shard_exec_error), RPC_TIMEOUT_MSG, self->m_edge_msg_ptr_list.front()->m_client_id);
-                self->write_response(error_json.write());
+                self->respond(error_json.write());
             }
         }
     });
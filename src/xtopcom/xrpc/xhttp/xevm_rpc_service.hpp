@@ -16,6 +16,10 @@
 #include "xtxstore/xtxstore_face.h"
 #include "xrpc/xjson_proc.h"
 #include "xrpc/eth_rpc/eth_error_code.h"
+#include "xrpc/xrpc_batch_response.h"
+#include "xrpc/xrpc_worker_pool.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 
 NS_BEG2(top, xrpc)
 #define CLEAN_TIME          60
@@ -40,6 +44,13 @@ public:
     void clean_token_timeout(long seconds) noexcept;
     void cancel_token_timeout() noexcept;
     void reset_edge_method_mgr(shared_ptr<xrpc_edge_vhost> edge_vhost, common::xip2_t xip2);
+    // the requests of a batch run on pool, or on the io service if it has no threads
+    void set_worker_pool(xrpc_worker_pool * pool) { m_worker_pool = pool; }
+private:
+    void execute_batch(shared_ptr<conn_type> & conn, const xJson::Value & requests, const std::string & ip);
+    void execute_batch_request(shared_ptr<conn_type> & conn, const xJson::Value & request, const std::string & ip, std::shared_ptr<xrpc_batch_response_t> const & batch, uint32_t index);
+    void post(std::function<void()> task);
+    static std::string error_response(const xJson::Value & id, const std::string & msg);
 public:
     unique_ptr<T>                                   m_edge_method_mgr_ptr;
     shared_ptr<asio::io_service>                    m_io_service;
@@ -47,6 +58,7 @@ private:
     unique_ptr<xfilter_manager>                     m_rule_mgr_ptr;
     unique_ptr<xpre_request_handler_mgr>            m_pre_request_handler_mgr_ptr;
     unique_ptr<asio::steady_timer>                  m_timer;//clean token timeout
+    xrpc_worker_pool *                              m_worker_pool{nullptr};
 };
 
 template <typename T>
@@ -99,6 +111,10 @@ void xevm_rpc_service<T>::execute(shared_ptr<conn_type> & conn, const std::strin
                 m_edge_method_mgr_ptr->write_response(conn, writer.write(err));
                 return;
             }
+            if (json_proc.m_request_json.isArray()) {
+                execute_batch(conn, json_proc.m_request_json, ip);
+                return;
+            }
             pre_request_data.m_request_map.emplace(RPC_SEQUENCE_ID, json_proc.m_request_json["id"].asString());
             json_proc.m_request_json["id"];
             m_edge_method_mgr_ptr->do_method(conn, json_proc, ip);
@@ -111,6 +127,78 @@ void xevm_rpc_service<T>::execute(shared_ptr<conn_type> & conn, const std::strin
     }
 }
 
+template <typename T>
+void xevm_rpc_service<T>::execute_batch(shared_ptr<conn_type> & conn, const xJson::Value & requests, const std::string & ip) {
+    if (requests.empty()) {
+        m_edge_method_mgr_ptr->write_response(conn, error_response(xJson::Value::null, "empty batch"));
+        return;
+    }
+    if (requests.size() > XGET_CONFIG(rpc_batch_max_requests)) {
+        m_edge_method_mgr_ptr->write_response(conn, error_response(xJson::Value::null, "too many requests in batch"));
+        return;
+    }
+
+    XMETRICS_COUNTER_INCREMENT("rpc_batch_requests", requests.size());
+    auto shared_requests = std::make_shared<xJson::Value>(requests);
+    auto batch = std::make_shared<xrpc_batch_response_t>(
+        requests.size(),
+        XGET_CONFIG(rpc_batch_concurrency),
+        [this, conn, shared_requests, ip](std::shared_ptr<xrpc_batch_response_t> const & batch_ptr, uint32_t index) {
+            // never run inline, a response may be handed over while its session lock is held
+            post([this, conn, shared_requests, ip, batch_ptr, index]() mutable {
+                execute_batch_request(conn, (*shared_requests)[index], ip, batch_ptr, index);
+            });
+        },
+        [this, conn](const std::string & response) mutable {
+            m_edge_method_mgr_ptr->write_response(conn, response);
+        });
+    batch->start();
+}
+
+template <typename T>
+void xevm_rpc_service<T>::execute_batch_request(shared_ptr<conn_type> & conn,
+                                                const xJson::Value & request,
+                                                const std::string & ip,
+                                                std::shared_ptr<xrpc_batch_response_t> const & batch,
+                                                uint32_t index) {
+    if (!request.isObject()) {
+        batch->set(index, error_response(xJson::Value::null, "invalid json request"));
+        return;
+    }
+    top::xrpc::xjson_proc_t json_proc;
+    json_proc.m_request_json = request;
+    json_proc.m_batch = batch;
+    json_proc.m_batch_index = index;
+    try {
+        m_edge_method_mgr_ptr->do_method(conn, json_proc, ip);
+    } catch (const xrpc_error & e) {
+        batch->set(index, error_response(request["id"], "invalid json request"));
+    } catch (const std::exception & e) {
+        xwarn("xevm_rpc_service::execute_batch_request exception:%s", e.what());
+        batch->set(index, error_response(request["id"], "invalid json request"));
+    }
+}
+
+template <typename T>
+void xevm_rpc_service<T>::post(std::function<void()> task) {
+    if (m_worker_pool != nullptr && m_worker_pool->thread_num() > 0) {
+        m_worker_pool->post(std::move(task));
+    } else {
+        m_io_service->post(std::move(task));
+    }
+}
+
+template <typename T>
+std::string xevm_rpc_service<T>::error_response(const xJson::Value & id, const std::string & msg) {
+    xJson::Value err;
+    err["id"] = id;
+    err["jsonrpc"] = "2.0";
+    err["error"]["code"] = eth::enum_eth_rpc_invalid_request;
+    err["error"]["message"] = msg;
+    xJson::FastWriter writer;
+    return writer.write(err);
+}
+
 template<typename T>
 void xevm_rpc_service<T>::clean_token_timeout(long seconds) noexcept
 {
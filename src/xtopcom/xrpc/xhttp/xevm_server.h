@@ -19,6 +19,7 @@
 #include "simplewebserver/server_http.hpp"
 #include "xrpc/xhttp/xevm_rpc_service.hpp"
 #include "xrpc/xratelimit/xratelimit_server.h"
+#include "xrpc/xrpc_worker_pool.h"
 
 NS_BEG2(top, xrpc)
 using std::thread;
@@ -34,7 +35,8 @@ public:
                  observer_ptr<base::xvtxstore_t> txstore = nullptr,
                  observer_ptr<elect::ElectMain> elect_main = nullptr,
                  observer_ptr<top::election::cache::xdata_accessor_face_t> const & election_cache_data_accessor = nullptr);
-    void start(uint16_t nPort, uint32_t nThreadNum = 1);
+    // nThreadNum threads read and write the sockets, nWorkerNum threads run the requests
+    void start(uint16_t nPort, uint32_t nThreadNum = 1, uint32_t nWorkerNum = 0);
     void start_service(shared_ptr<SimpleWeb::ServerBase<SimpleWeb::HTTP>::Response> response, shared_ptr<SimpleWeb::ServerBase<SimpleWeb::HTTP>::Request> request);
     ~xevm_server();
     xedge_evm_http_method* get_edge_method() { return m_rpc_service->m_edge_method_mgr_ptr.get(); }
@@ -42,6 +44,7 @@ private:
     static HttpServer                                   m_server;
     static unique_ptr<xevm_rpc_service<xedge_evm_http_method>>  m_rpc_service;
     static bool                                         m_is_running;
+    static xrpc_worker_pool                             m_worker_pool;
     thread                                          m_server_thread;
     RatelimitConfig                                 m_config;
     unique_ptr<RatelimitServer>                     m_ratelimit{ nullptr };
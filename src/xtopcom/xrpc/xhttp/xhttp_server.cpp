@@ -5,6 +5,7 @@
 #include "xrpc/xhttp/xhttp_server.h"
 
 #include "xbasic/xmemory.hpp"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xmetrics/xmetrics.h"
 #include "xrpc/xratelimit/xratelimit_data.h"
 #include "xrpc/xratelimit/xratelimit_data_queue.h"
@@ -16,6 +17,7 @@ NS_BEG2(top, xrpc)
 HttpServer xhttp_server::m_server;
 unique_ptr<xrpc_service<xedge_http_method>> xhttp_server::m_rpc_service = nullptr;
 bool xhttp_server::m_is_running = false;
+xrpc_worker_pool xhttp_server::m_worker_pool;
 
 using namespace top::xChainRPC;
 xhttp_server::xhttp_server(shared_ptr<xrpc_edge_vhost> edge_vhost,
@@ -36,7 +38,7 @@ xhttp_server::xhttp_server(shared_ptr<xrpc_edge_vhost> edge_vhost,
     }
 }
 
-void xhttp_server::start(uint16_t nPort, uint32_t nThreadNum) {
+void xhttp_server::start(uint16_t nPort, uint32_t nThreadNum, uint32_t nWorkerNum) {
     if (m_is_running) {
         xdbg("rpc_service http_server already started");
         return;
@@ -45,6 +47,7 @@ void xhttp_server::start(uint16_t nPort, uint32_t nThreadNum) {
     m_server.config.port = nPort;
     m_server.config.reuse_address = true;
     m_server.config.thread_pool_size = nThreadNum;
+    m_worker_pool.start(nWorkerNum);
 
     m_server.resource["/"]["POST"] = std::bind(&xhttp_server::start_service, this, std::placeholders::_1, std::placeholders::_2);
     m_server.resource["/"]["OPTIONS"] = [](shared_ptr<HttpServer::Response> response, shared_ptr<HttpServer::Request>) {
@@ -62,6 +65,7 @@ void xhttp_server::start(uint16_t nPort, uint32_t nThreadNum) {
     m_server.io_service = m_rpc_service->m_io_service;
     auto self = shared_from_this();
     m_server_thread = std::thread([self]() {
+        threading::set_current_thread_name("rpc_http");
         // Start server
         self->m_server.start();
     });
@@ -84,8 +88,10 @@ void xhttp_server::start(uint16_t nPort, uint32_t nThreadNum) {
             asio::ip::address_v4 addr_v4(dynamic_cast<RatelimitDataHttp *>(data)->ip_);
             asio::ip::address addr(addr_v4);
             auto ip_s = addr.to_string();
-            m_rpc_service->execute(dynamic_cast<RatelimitDataHttp *>(data)->response_, dynamic_cast<RatelimitDataHttp *>(data)->content_, ip_s);
+            auto response = dynamic_cast<RatelimitDataHttp *>(data)->response_;
+            auto content = std::move(dynamic_cast<RatelimitDataHttp *>(data)->content_);
             delete data;
+            m_worker_pool.post([response, content, ip_s]() mutable { m_rpc_service->execute(response, content, ip_s); });
         });
         m_ratelimit->RegistResponseOut([self](RatelimitData * data) {
             if (data == nullptr) {
@@ -133,7 +139,7 @@ void xhttp_server::start_service(std::shared_ptr<SimpleWeb::ServerBase<SimpleWeb
     } else {
         // ipv4 expressed in ipv6 format: ::ffff:192.168.20.9
         auto ip_s = addr.to_string().substr(7);
-        m_rpc_service->execute(response, content, ip_s);
+        m_worker_pool.post([response, content, ip_s]() mutable { m_rpc_service->execute(response, content, ip_s); });
     }
 }
 
@@ -10,6 +10,7 @@
 #include "xdata/xtransaction.h"
 #include "prerequest/xpre_request_data.h"
 #include "xrpc_define.h"
+#include "xrpc_batch_response.h"
 
 NS_BEG2(top, xrpc)
 class xjson_proc_t
@@ -27,6 +28,9 @@ public:
     data::xtransaction_ptr_t      m_tx_ptr;
     enum_xrpc_tx_type       m_tx_type;
     unordered_set<string>   m_account_set{};
+    // set if the request is one of a batch, its response goes to m_batch instead of the connection
+    std::shared_ptr<xrpc_batch_response_t>  m_batch{nullptr};
+    uint32_t                m_batch_index{0};
 };
 
 NS_END2
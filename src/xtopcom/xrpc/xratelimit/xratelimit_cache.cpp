@@ -1,5 +1,7 @@
 #include "xratelimit_cache.h"
 
+#include <algorithm>
+
 
 
 NS_BEG2(top, xChainRPC)
@@ -114,20 +116,14 @@ void RatelimitCache::ThreadFunc() {
 }
 
 void RatelimitCache::CleanIdle() {
+    // entries not looked up for one to two epochs are dropped
     uint64_t now = GetSteadyClockMS();
-    account_hashmap_.ForeachErase(
-        [this, now](std::string,
-            std::shared_ptr<AccountCheckContent> p)->bool {
-        if (p != nullptr) {
-            if (p->state_ == RateLimitCheck::State::Refused) {
-                if (now < p->refused_time_)
-                    return false;
-            }
-            return (now - p->steady_time_ > clean_overtime_s_ * 1000);
-        } else {
-            return true;
-        }
-        });
+    uint64_t epoch_ms = std::max<uint64_t>(clean_overtime_s_, 1) * 1000;
+    if (now - last_rotate_ms_ < epoch_ms)
+        return;
+    last_rotate_ms_ = now;
+    ip_hashmap_.Rotate();
+    account_hashmap_.Rotate();
 }
 
 void RatelimitCache::ResetIpCheckBucket(uint32_t ip) {
@@ -98,6 +98,7 @@ private:
     std::condition_variable cv_;
     int64_t second_interval_{ 1 };
     uint64_t clean_overtime_s_{ 600 };
+    uint64_t last_rotate_ms_{ 0 };
     RatelimitThread thread_;
 };
 
@@ -2,6 +2,7 @@
 #ifndef RATELIMIT_HASH_MAP_H_
 #define RATELIMIT_HASH_MAP_H_
 
+#include <functional>
 #include <mutex>
 #include <unordered_map>
 #include "xbase/xns_macro.h"
@@ -10,7 +11,11 @@
 
 NS_BEG2(top, xChainRPC)
 
-template <class K, class V>
+// the map is split in shards, each with its own lock, so requests from different
+// ips rarely wait for each other. every shard keeps two generations: lookups move
+// entries to the current one and Rotate drops the previous one, so entries idle
+// for a whole epoch are evicted without scanning the map.
+template <class K, class V, size_t ShardCount = 64>
 class RatelimitHashmap final {
 public:
     using ForeachFunc = std::function<void(K, V)>;
@@ -22,61 +27,114 @@ public:
     size_t Size();
     bool Find(const K& key, V& val);
     bool Insert(const K& key, const V& val);
+    void Rotate();
+
     void Foreach(ForeachFunc func) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        for (auto p : hashmap_) {
-            func(p.first, p.second);
+        for (auto & shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            for (auto & generation : shard.generations_) {
+                for (auto p : generation) {
+                    func(p.first, p.second);
+                }
+            }
         }
     }
 
+    // locks one shard at a time, so a sweep only blocks the keys of the shard it is in
     void ForeachErase(ForeachEraseFunc func) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = hashmap_.begin();
-        for (; it != hashmap_.end(); ) {
-            if (func(it->first, it->second)) {
-                it = hashmap_.erase(it);
-            } else {
-                ++it;
+        for (auto & shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            for (auto & generation : shard.generations_) {
+                auto it = generation.begin();
+                for (; it != generation.end(); ) {
+                    if (func(it->first, it->second)) {
+                        it = generation.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
             }
         }
     }
 
 private:
-    std::unordered_map<K, V> hashmap_;
-    std::mutex mutex_;
+    struct Shard {
+        std::unordered_map<K, V> generations_[2];
+        size_t current_{ 0 };
+        std::mutex mutex_;
+    };
+
+    Shard& GetShard(const K& key) {
+        return shards_[std::hash<K>()(key) % ShardCount];
+    }
+
+    Shard shards_[ShardCount];
 };
 
-template<class K, class V>
-inline RatelimitHashmap<K, V>::RatelimitHashmap()
+template<class K, class V, size_t ShardCount>
+inline RatelimitHashmap<K, V, ShardCount>::RatelimitHashmap()
 {}
 
-template<class K, class V>
-inline RatelimitHashmap<K, V>::~RatelimitHashmap()
+template<class K, class V, size_t ShardCount>
+inline RatelimitHashmap<K, V, ShardCount>::~RatelimitHashmap()
 {}
 
-template<class K, class V>
-inline size_t RatelimitHashmap<K, V>::Size() {
-    return hashmap_.size();
+template<class K, class V, size_t ShardCount>
+inline size_t RatelimitHashmap<K, V, ShardCount>::Size() {
+    size_t size{ 0 };
+    for (auto & shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        size += shard.generations_[0].size() + shard.generations_[1].size();
+    }
+    return size;
 }
 
-template<class K, class V>
-inline bool RatelimitHashmap<K, V>::Find(const K& key, V& val) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = hashmap_.find(key);
-    if (it != hashmap_.end()) {
+template<class K, class V, size_t ShardCount>
+inline bool RatelimitHashmap<K, V, ShardCount>::Find(const K& key, V& val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto& current = shard.generations_[shard.current_];
+    auto it = current.find(key);
+    if (it != current.end()) {
+        val = it->second;
+        return true;
+    }
+
+    auto& previous = shard.generations_[1 - shard.current_];
+    it = previous.find(key);
+    if (it != previous.end()) {
         val = it->second;
+        current.insert(std::make_pair(key, std::move(it->second)));
+        previous.erase(it);
         return true;
     }
     return false;
 }
 
-template<class K, class V>
-inline bool RatelimitHashmap<K, V>::Insert(const K& key, const V& val) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto ret = hashmap_.insert(std::make_pair(key, val));
+template<class K, class V, size_t ShardCount>
+inline bool RatelimitHashmap<K, V, ShardCount>::Insert(const K& key, const V& val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    if (shard.generations_[1 - shard.current_].count(key) > 0) {
+        return false;
+    }
+    auto ret = shard.generations_[shard.current_].insert(std::make_pair(key, val));
     return ret.second;
 }
 
+template<class K, class V, size_t ShardCount>
+inline void RatelimitHashmap<K, V, ShardCount>::Rotate() {
+    for (auto & shard : shards_) {
+        std::unordered_map<K, V> expired;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            shard.current_ = 1 - shard.current_;
+            expired.swap(shard.generations_[shard.current_]);
+        }
+        // values are released out of the lock
+    }
+}
+
 NS_END2
 
 #endif  // !RATELIMIT_HASH_MAP_H_
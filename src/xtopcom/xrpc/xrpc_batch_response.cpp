@@ -0,0 +1,67 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xrpc_batch_response.h"
+
+#include <algorithm>
+
+NS_BEG2(top, xrpc)
+
+xrpc_batch_response_t::xrpc_batch_response_t(uint32_t size, uint32_t concurrency, dispatch_func dispatch, finish_func finish)
+  : m_responses(size), m_done(size, false), m_concurrency(std::max<uint32_t>(concurrency, 1)), m_dispatch(std::move(dispatch)), m_finish(std::move(finish)) {
+}
+
+void xrpc_batch_response_t::start() {
+    uint32_t count;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = std::min<uint32_t>(m_concurrency, m_responses.size());
+        m_next = count;
+    }
+    auto self = shared_from_this();
+    for (uint32_t i = 0; i < count; ++i) {
+        m_dispatch(self, i);
+    }
+}
+
+void xrpc_batch_response_t::set(uint32_t index, const std::string & response) {
+    bool has_next = false;
+    uint32_t next = 0;
+    bool finished = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (index >= m_responses.size() || m_done[index]) {
+            return;
+        }
+        m_responses[index] = response;
+        // the writer ends every response with a new line
+        if (!m_responses[index].empty() && m_responses[index].back() == '\n') {
+            m_responses[index].pop_back();
+        }
+        m_done[index] = true;
+        ++m_done_count;
+        if (m_next < m_responses.size()) {
+            has_next = true;
+            next = m_next++;
+        }
+        finished = (m_done_count == m_responses.size());
+    }
+
+    if (has_next) {
+        m_dispatch(shared_from_this(), next);
+    }
+    if (finished) {
+        std::string content = "[";
+        for (size_t i = 0; i < m_responses.size(); ++i) {
+            if (i > 0) {
+                content += ",";
+            }
+            content += m_responses[i];
+        }
+        content += "]";
+        m_finish(content);
+    }
+}
+
+NS_END2
@@ -0,0 +1,43 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xrpc)
+
+// responses of one json-rpc batch. at most concurrency requests of the batch run at the same time,
+// every response starts the next request, and the array is written in request order once all are in.
+class xrpc_batch_response_t : public std::enable_shared_from_this<xrpc_batch_response_t> {
+public:
+    using dispatch_func = std::function<void(std::shared_ptr<xrpc_batch_response_t> const & batch, uint32_t index)>;
+    using finish_func = std::function<void(const std::string & response)>;
+
+    xrpc_batch_response_t(uint32_t size, uint32_t concurrency, dispatch_func dispatch, finish_func finish);
+    xrpc_batch_response_t(const xrpc_batch_response_t &) = delete;
+    xrpc_batch_response_t & operator=(const xrpc_batch_response_t &) = delete;
+
+    void start();
+    // only the first response of each request is kept
+    void set(uint32_t index, const std::string & response);
+
+private:
+    std::mutex                  m_mutex;
+    std::vector<std::string>    m_responses;
+    std::vector<bool>           m_done;
+    uint32_t                    m_concurrency;
+    uint32_t                    m_next{0};
+    uint32_t                    m_done_count{0};
+    dispatch_func               m_dispatch;
+    finish_func                 m_finish;
+};
+
+NS_END2
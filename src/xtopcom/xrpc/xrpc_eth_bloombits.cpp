@@ -0,0 +1,247 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xrpc_eth_bloombits.h"
+
+#include "xbase/xlog.h"
+#include "xdata/xblockextract.h"
+#include "xdata/xethheader.h"
+#include "xdata/xnative_contract_address.h"
+#include "xevm_common/xbloom9.h"
+#include "xmetrics/xmetrics.h"
+#include "xvledger/xvchain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+
+namespace top {
+namespace xrpc {
+
+constexpr uint64_t xrpc_eth_bloombits_t::section_size;
+constexpr uint32_t xrpc_eth_bloombits_t::bloom_bit_count;
+constexpr uint32_t xrpc_eth_bloombits_t::vector_size;
+
+static std::string eth_table_address() {
+    return std::string(sys_contract_eth_table_block_addr) + "@0";
+}
+
+xrpc_eth_bloombits_t & xrpc_eth_bloombits_t::instance() {
+    // never destroyed, the indexing thread may still run at exit
+    static xrpc_eth_bloombits_t * _instance = new xrpc_eth_bloombits_t();
+    return *_instance;
+}
+
+void xrpc_eth_bloombits_t::start(observer_ptr<base::xvblockstore_t> block_store) {
+    if (block_store == nullptr) {
+        return;
+    }
+    std::call_once(m_start_flag, [this, block_store]() {
+        m_block_store = block_store;
+        std::string sections = base::xvchain_t::instance().get_xdbstore()->get_value(sections_key());
+        if (!sections.empty()) {
+            m_sections.store(std::stoull(sections), std::memory_order_release);
+        }
+        xinfo("xrpc_eth_bloombits_t::start,indexed sections:%llu", indexed_sections());
+        std::thread([this]() { run(); }).detach();
+    });
+}
+
+void xrpc_eth_bloombits_t::run() {
+    base::xvaccount_t _table_addr(eth_table_address());
+    for (;;) {
+        uint64_t committed = m_block_store->get_latest_committed_block_height(_table_addr);
+        uint64_t section = indexed_sections();
+        while ((section + 1) * section_size <= committed + 1) {
+            if (!index_section(section)) {
+                break;
+            }
+            section++;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(index_interval_s));
+    }
+}
+
+bool xrpc_eth_bloombits_t::index_section(uint64_t section) {
+    base::xvaccount_t _table_addr(eth_table_address());
+    std::vector<xbytes_t> vectors(bloom_bit_count);
+    xbytes_t full_bloom(evm_common::Bloom9ByteLength, 0xff);
+
+    for (uint64_t offset = 0; offset < section_size; offset++) {
+        uint64_t height = section * section_size + offset;
+        xobject_ptr_t<base::xvblock_t> block = m_block_store->load_block_object(_table_addr, height, base::enum_xvblock_flag_committed, false);
+        if (block == nullptr) {
+            // not here yet, left to the block by block scan of the queries
+            xwarn("xrpc_eth_bloombits_t::index_section,load block fail:%llu", height);
+            return false;
+        }
+
+        data::xeth_header_t ethheader;
+        std::error_code ec;
+        data::xblockextract_t::unpack_ethheader(block.get(), ethheader, ec);
+        if (ec) {
+            // unknown bloom, the block stays a candidate of every filter
+            set_bloom(vectors, offset, full_bloom);
+            continue;
+        }
+        set_bloom(vectors, offset, ethheader.get_logBloom().get_data());
+    }
+
+    // empty vectors are not stored, a missing vector of an indexed section reads as zero
+    std::map<std::string, std::string> objs;
+    for (uint32_t bit = 0; bit < bloom_bit_count; bit++) {
+        if (!vectors[bit].empty()) {
+            objs[vector_key(bit, section)] = std::string(vectors[bit].begin(), vectors[bit].end());
+        }
+    }
+    objs[sections_key()] = std::to_string(section + 1);
+    if (!base::xvchain_t::instance().get_xdbstore()->set_values(objs)) {
+        xerror("xrpc_eth_bloombits_t::index_section,write fail:%llu", section);
+        return false;
+    }
+
+    m_sections.store(section + 1, std::memory_order_release);
+    XMETRICS_COUNTER_INCREMENT("rpc_eth_bloombits_section", 1);
+    xinfo("xrpc_eth_bloombits_t::index_section,section:%llu,vectors:%zu", section, objs.size() - 1);
+    return true;
+}
+
+uint64_t xrpc_eth_bloombits_t::candidates(uint64_t begin, uint64_t end, xfilter_t const & filter, std::vector<uint64_t> & heights) {
+    uint64_t sections = indexed_sections();
+    uint64_t indexed_end = sections * section_size;
+    if (begin >= indexed_end) {
+        return begin;
+    }
+
+    uint64_t last = end < indexed_end ? end : indexed_end - 1;
+    for (uint64_t section = begin / section_size; section <= last / section_size; section++) {
+        xbytes_t matched = match([this, section](uint32_t bit) { return load_vector(bit, section); }, filter);
+        if (matched.empty()) {
+            continue;
+        }
+
+        uint64_t first = section * section_size;
+        for (uint64_t offset = 0; offset < section_size; offset++) {
+            uint64_t height = first + offset;
+            if (height < begin || height > last) {
+                continue;
+            }
+            if (matched[offset / 8] & (0x80 >> (offset % 8))) {
+                heights.push_back(height);
+            }
+        }
+    }
+    return last + 1;
+}
+
+xbytes_t xrpc_eth_bloombits_t::load_vector(uint32_t bit, uint64_t section) {
+    std::string key = vector_key(bit, section);
+    xbytes_t vector;
+    if (m_vectors.get(key, vector)) {
+        return vector;
+    }
+
+    std::string value = base::xvchain_t::instance().get_xdbstore()->get_value(key);
+    if (value.size() == vector_size) {
+        vector.assign(value.begin(), value.end());
+    }
+    m_vectors.put(key, vector);
+    return vector;
+}
+
+std::vector<uint32_t> xrpc_eth_bloombits_t::bit_indexes(xbytes_t const & value) {
+    evm_common::xbloom9_t bloom;
+    bloom.add(value);
+
+    std::vector<uint32_t> bits;
+    auto const & data = bloom.get_data();
+    for (uint32_t i = 0; i < (uint32_t)data.size(); i++) {
+        for (uint32_t b = 0; b < 8; b++) {
+            if (data[i] & (1 << b)) {
+                bits.push_back(i * 8 + b);
+            }
+        }
+    }
+    return bits;
+}
+
+void xrpc_eth_bloombits_t::set_bloom(std::vector<xbytes_t> & vectors, uint64_t offset, xbytes_t const & bloom) {
+    for (uint32_t i = 0; i < (uint32_t)bloom.size(); i++) {
+        if (bloom[i] == 0) {
+            continue;
+        }
+        for (uint32_t b = 0; b < 8; b++) {
+            if (bloom[i] & (1 << b)) {
+                auto & vector = vectors[i * 8 + b];
+                if (vector.empty()) {
+                    vector.resize(vector_size, 0);
+                }
+                vector[offset / 8] |= (xbyte_t)(0x80 >> (offset % 8));
+            }
+        }
+    }
+}
+
+xbytes_t xrpc_eth_bloombits_t::match(std::function<xbytes_t(uint32_t)> const & load_vector, xfilter_t const & filter) {
+    xbytes_t result;
+    bool first_group = true;
+    for (auto const & group : filter) {
+        if (group.empty()) {
+            continue;
+        }
+
+        // or of the values of the group, each value the and of its bits
+        xbytes_t group_result(vector_size, 0);
+        for (auto const & value : group) {
+            xbytes_t value_result;
+            for (auto bit : bit_indexes(value)) {
+                xbytes_t vector = load_vector(bit);
+                if (vector.empty()) {
+                    value_result.clear();
+                    break;
+                }
+                if (value_result.empty()) {
+                    value_result = vector;
+                } else {
+                    for (uint32_t i = 0; i < vector_size; i++) {
+                        value_result[i] &= vector[i];
+                    }
+                }
+            }
+            for (uint32_t i = 0; i < (uint32_t)value_result.size(); i++) {
+                group_result[i] |= value_result[i];
+            }
+        }
+
+        if (first_group) {
+            result = group_result;
+            first_group = false;
+        } else {
+            for (uint32_t i = 0; i < vector_size; i++) {
+                result[i] &= group_result[i];
+            }
+        }
+        if (std::none_of(result.begin(), result.end(), [](xbyte_t b) { return b != 0; })) {
+            return {};
+        }
+    }
+
+    // a filter without values matches every block
+    if (first_group) {
+        result.assign(vector_size, 0xff);
+    }
+    return result;
+}
+
+std::string xrpc_eth_bloombits_t::vector_key(uint32_t bit, uint64_t section) {
+    return "/rpc/bloombits/" + std::to_string(bit) + "/" + std::to_string(section);
+}
+
+std::string xrpc_eth_bloombits_t::sections_key() {
+    return "/rpc/bloombits/sections";
+}
+
+}  // namespace xrpc
+}  // namespace top
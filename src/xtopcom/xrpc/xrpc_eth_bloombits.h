@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xbyte_buffer.h"
+#include "xbasic/xsharded_lru_cache.h"
+#include "xbasic/xmemory.hpp"
+#include "xvledger/xvblockstore.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace top {
+namespace xrpc {
+
+// persistent bloombits index of the eth table, as go-ethereum core/bloombits.
+// the blocks are grouped in sections of section_size, and for each section bit b of the blooms of
+// all its blocks is stored as one vector, so a log filter touches 3 vectors per value and section
+// instead of loading every block of the range.
+class xrpc_eth_bloombits_t {
+public:
+    static constexpr uint64_t section_size = 4096;
+    static constexpr uint32_t bloom_bit_count = 2048;
+    static constexpr uint32_t vector_size = section_size / 8;
+
+    // and of the groups, or of the values in one group (the addresses, then the topics of each position)
+    using xfilter_t = std::vector<std::vector<xbytes_t>>;
+
+    static xrpc_eth_bloombits_t & instance();
+
+    // starts indexing the committed sections in background, only the first call takes effect
+    void start(observer_ptr<base::xvblockstore_t> block_store);
+
+    uint64_t indexed_sections() const {
+        return m_sections.load(std::memory_order_acquire);
+    }
+
+    // append the heights of [begin, end] in the indexed sections which may hold logs of the filter,
+    // and return the first height of the range not covered by the index
+    uint64_t candidates(uint64_t begin, uint64_t end, xfilter_t const & filter, std::vector<uint64_t> & heights);
+
+    // bits of the bloom set by value
+    static std::vector<uint32_t> bit_indexes(xbytes_t const & value);
+    // set the bloom of the block at offset of the section into its vectors
+    static void set_bloom(std::vector<xbytes_t> & vectors, uint64_t offset, xbytes_t const & bloom);
+    // candidate vector of a section, bit i set if block i of the section may match
+    static xbytes_t match(std::function<xbytes_t(uint32_t)> const & load_vector, xfilter_t const & filter);
+
+private:
+    xrpc_eth_bloombits_t() = default;
+
+    void run();
+    bool index_section(uint64_t section);
+    xbytes_t load_vector(uint32_t bit, uint64_t section);
+
+    static std::string vector_key(uint32_t bit, uint64_t section);
+    static std::string sections_key();
+
+    static constexpr uint32_t index_interval_s = 10;
+    static constexpr uint32_t vector_cache_count = 4096;
+
+    struct xvector_weigher_t {
+        size_t operator()(std::string const & key, xbytes_t const & vector) const {
+            return key.size() + vector.size();
+        }
+    };
+
+    std::once_flag m_start_flag;
+    observer_ptr<base::xvblockstore_t> m_block_store{nullptr};
+    std::atomic<uint64_t> m_sections{0};
+    // weighed in bytes, the absent vectors of unindexed sections are cached as empty ones
+    basic::xsharded_lru_cache<std::string, xbytes_t, basic::xvoid_deletor_t<xbytes_t>, xvector_weigher_t> m_vectors{vector_cache_count * vector_size};
+};
+
+}  // namespace xrpc
+}  // namespace top
@@ -116,6 +116,43 @@ void xrpc_eth_parser_t::blockheader_to_json(base::xvblock_t* _block, xJson::Valu
     js_v["transactions"].resize(0);
 }
 
+void xrpc_eth_parser_t::block_to_json(base::xvblock_t* _block, std::function<void(xrpc_json_writer_t &)> const& write_transactions, xrpc_json_writer_t & writer, std::error_code & ec) {
+    data::xeth_header_t ethheader;
+    data::xblockextract_t::unpack_ethheader(_block, ethheader, ec);
+    if (ec) {
+        return;
+    }
+
+    writer.StartObject();
+    write_json_member(writer, "baseFeePerGas", u256_to_hex_prefixed(ethheader.get_baseprice()));
+    write_json_member(writer, "difficulty", "0x0");
+    write_json_member(writer, "extraData", top::to_hex_prefixed(ethheader.get_extra_data()));
+    write_json_member(writer, "gasLimit", uint64_to_hex_prefixed(ethheader.get_gaslimit()));
+    write_json_member(writer, "gasUsed", uint64_to_hex_prefixed(ethheader.get_gasused()));
+    write_json_member(writer, "hash", top::to_hex_prefixed(_block->get_block_hash()));
+    write_json_member(writer, "logsBloom", top::to_hex_prefixed(ethheader.get_logBloom().get_data()));
+    write_json_member(writer, "miner", ethheader.get_coinbase().to_hex_string());
+    write_json_member(writer, "mixHash", std::string("0x") + std::string(64, '0'));
+    write_json_member(writer, "nonce", std::string("0x") + std::string(16, '0'));
+    write_json_member(writer, "number", uint64_to_hex_prefixed(_block->get_height()));
+    write_json_member(writer, "parentHash", top::to_hex_prefixed(_block->get_last_block_hash()));
+    write_json_member(writer, "receiptsRoot", top::to_hex_prefixed(ethheader.get_receipts_root().asBytes()));
+    write_json_member(writer, "sha3Uncles", std::string("0x") + std::string(64, '0'));
+    write_json_member(writer, "size", uint64_to_hex_prefixed(_block->get_block_size()));
+    write_json_member(writer, "stateRoot", top::to_hex_prefixed(ethheader.get_state_root().asBytes()));
+    write_json_member(writer, "timestamp", uint64_to_hex_prefixed(_block->get_timestamp()));
+    write_json_member(writer, "totalDifficulty", "0x0");
+    writer.Key("transactions");
+    writer.StartArray();
+    write_transactions(writer);
+    writer.EndArray();
+    write_json_member(writer, "transactionsRoot", top::to_hex_prefixed(ethheader.get_transactions_root().asBytes()));
+    writer.Key("uncles");
+    writer.StartArray();
+    writer.EndArray();
+    writer.EndObject();
+}
+
 data::xtransaction_ptr_t xrpc_eth_parser_t::json_to_ethtx(xJson::Value const& request, data::eth_error& ec) {
     if (request["params"].empty()) {
         ec = data::eth_error(data::error::xenum_errc::eth_invalid_params, "missing value for required argument 0");
@@ -181,6 +218,41 @@ void xrpc_eth_parser_t::transaction_to_json(xtx_location_t const& txlocation, da
     js_v["s"] = top::to_hex_prefixed(ethtx.get_signS().asBytes());
 }
 
+void xrpc_eth_parser_t::transaction_to_json(xtx_location_t const& txlocation, data::xtransaction_ptr_t const& rawtx, xrpc_json_writer_t & writer, std::error_code & ec) {
+    data::xeth_transaction_t ethtx = rawtx->to_eth_tx(ec);
+    if (ec) {
+        return;
+    }
+    transaction_to_json(txlocation, ethtx, writer);
+}
+
+void xrpc_eth_parser_t::transaction_to_json(xtx_location_t const& txlocation, data::xeth_transaction_t const& ethtx, xrpc_json_writer_t & writer) {
+    writer.StartObject();
+    write_json_member(writer, "blockHash", txlocation.m_block_hash);
+    write_json_member(writer, "blockNumber", txlocation.m_block_number);
+    write_json_member(writer, "from", ethtx.get_from().to_hex_string());
+    write_json_member(writer, "gas", u256_to_hex_prefixed(ethtx.get_gas()));
+    write_json_member(writer, "gasPrice", u256_to_hex_prefixed(ethtx.get_max_fee_per_gas()));
+    write_json_member(writer, "hash", txlocation.m_tx_hash);
+    write_json_member(writer, "input", top::to_hex_prefixed(ethtx.get_data()));
+    write_json_member(writer, "maxFeePerGas", u256_to_hex_prefixed(ethtx.get_max_fee_per_gas()));
+    write_json_member(writer, "maxPriorityFeePerGas", u256_to_hex_prefixed(ethtx.get_max_priority_fee_per_gas()));
+    write_json_member(writer, "nonce", u256_to_hex_prefixed(ethtx.get_nonce()));
+    write_json_member(writer, "r", top::to_hex_prefixed(ethtx.get_signR().asBytes()));
+    write_json_member(writer, "s", top::to_hex_prefixed(ethtx.get_signS().asBytes()));
+    writer.Key("to");
+    if (!ethtx.get_to().is_zero()) {
+        write_json_string(writer, ethtx.get_to().to_hex_string());
+    } else {
+        writer.Null();
+    }
+    write_json_member(writer, "transactionIndex", txlocation.m_transaction_index);
+    write_json_member(writer, "type", uint64_to_hex_prefixed((uint64_t)ethtx.get_tx_version()));
+    write_json_member(writer, "v", u256_to_hex_prefixed(ethtx.get_signV()));
+    write_json_member(writer, "value", u256_to_hex_prefixed(ethtx.get_value()));
+    writer.EndObject();
+}
+
 
 void xrpc_eth_parser_t::receipt_to_json(xtx_location_t const& txlocation,  data::xeth_transaction_t const& ethtx,
                                         data::xeth_store_receipt_t const &evm_tx_receipt,xJson::Value & js_v, std::error_code & ec) {
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "json/json.h"
+#include "xrpc/xrpc_json_writer.h"
 #include "xrpc/xrpc_loader.h"
 #include "xevm_common/xevm_transaction_result.h"
 #include "xdata/xethtransaction.h"
 
+#include <functional>
+
 namespace top {
 
 namespace xrpc {
@@ -39,6 +42,10 @@ class xrpc_eth_parser_t {
     static  void transaction_to_json(xtx_location_t const& txlocation, data::xtransaction_ptr_t const& rawtx, xJson::Value & js_v, std::error_code & ec);
     static  void transaction_to_json(xtx_location_t const& txlocation, data::xeth_transaction_t const& ethtx, xJson::Value & js_v, std::error_code & ec);
     static  void blockheader_to_json(base::xvblock_t* _block, xJson::Value & js_v, std::error_code & ec);
+    // streaming versions of the above, write_transactions writes the items of the transactions array
+    static  void transaction_to_json(xtx_location_t const& txlocation, data::xtransaction_ptr_t const& rawtx, xrpc_json_writer_t & writer, std::error_code & ec);
+    static  void transaction_to_json(xtx_location_t const& txlocation, data::xeth_transaction_t const& ethtx, xrpc_json_writer_t & writer);
+    static  void block_to_json(base::xvblock_t* _block, std::function<void(xrpc_json_writer_t &)> const& write_transactions, xrpc_json_writer_t & writer, std::error_code & ec);
     static  data::xtransaction_ptr_t json_to_ethtx(xJson::Value const& request, data::eth_error& ec);
 
     static  std::string                 uint64_to_hex_prefixed(uint64_t value);
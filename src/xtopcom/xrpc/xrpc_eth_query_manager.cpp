@@ -91,6 +91,75 @@ enum_query_result xrpc_eth_query_manager::query_account_by_number(const std::str
     }    
     return enum_success;
 }
+bool xrpc_eth_query_manager::is_final_result(const std::string & method, const xJson::Value & js_rsp) {
+    if (!js_rsp.isMember("result") || js_rsp.isMember("error") || !js_rsp["result"].isObject())
+        return false;
+
+    auto const & result = js_rsp["result"];
+    std::string height_field;
+    bool relay = false;
+    if (method == "eth_getBlockByNumber") {
+        height_field = "number";
+    } else if (method == "eth_getTransactionByHash" || method == "eth_getTransactionReceipt") {
+        height_field = "blockNumber";
+    } else if (method == "topRelay_getBlockByNumber" || method == "topRelay_getBlockByHash") {
+        // the aggregate list of a tx block grows until the poly election block is built
+        if (result.isMember("aggregateList"))
+            return false;
+        height_field = "number";
+        relay = true;
+    } else if (method == "topRelay_getTransactionByHash" || method == "topRelay_getTransactionReceipt") {
+        height_field = "blockNumber";
+        relay = true;
+    } else {
+        return false;
+    }
+
+    if (!result[height_field].isString())
+        return false;
+    uint64_t const height = std::strtoull(result[height_field].asString().c_str(), NULL, 16);
+    return relay ? is_committed_relay_height(height) : is_committed_height(height);
+}
+bool xrpc_eth_query_manager::is_committed_relay_height(uint64_t height) {
+    base::xvaccount_t _relay_addr(sys_contract_relay_block_addr);
+    return height <= m_block_store->get_latest_committed_block_height(_relay_addr);
+}
+bool xrpc_eth_query_manager::is_committed_height(uint64_t height) {
+    base::xvaccount_t _table_addr(std::string(sys_contract_eth_table_block_addr) + "@0");
+    return height <= m_block_store->get_latest_committed_block_height(_table_addr);
+}
+bool xrpc_eth_query_manager::write_result(const std::string & method, xJson::Value & js_req, std::string & result, bool & is_final) {
+    // invalid params and missing blocks are left to call_method, which writes the errors
+    xJson::Value js_check;
+    xobject_ptr_t<base::xvblock_t> block;
+    if (method == "eth_getBlockByNumber") {
+        if (!eth::EthErrorCode::check_req(js_req, js_check, 2) || !eth::EthErrorCode::check_hex(js_req[0].asString(), js_check, 0, eth::enum_rpc_type_block) || !js_req[1].isBool())
+            return false;
+        block = query_block_by_height(js_req[0].asString());
+    } else if (method == "eth_getBlockByHash") {
+        if (!eth::EthErrorCode::check_req(js_req, js_check, 2) || !eth::EthErrorCode::check_hex(js_req[0].asString(), js_check, 0, eth::enum_rpc_type_hash) ||
+            !eth::EthErrorCode::check_hash(js_req[0].asString(), js_check) || !js_req[1].isBool())
+            return false;
+        uint256_t hash = top::data::hex_to_uint256(js_req[0].asString());
+        std::string block_hash_str = std::string(reinterpret_cast<char *>(hash.data()), hash.size());
+        block = m_block_store->get_block_by_hash(block_hash_str);
+    } else {
+        return false;
+    }
+    if (block == nullptr)
+        return false;
+
+    std::error_code ec;
+    xrpc_json_buffer_t buffer;
+    xrpc_json_writer_t writer(buffer);
+    set_block_result(block, writer, js_req[1].asBool(), ec);
+    if (!writer.IsComplete())
+        return false;
+
+    result.assign(buffer.GetString(), buffer.GetSize());
+    is_final = is_committed_height(block->get_height());
+    return true;
+}
 xobject_ptr_t<base::xvblock_t> xrpc_eth_query_manager::query_block_by_height(const std::string& table_height) {
     xdbg("xrpc_eth_query_manager::query_block_by_height: %s, %s",  sys_contract_eth_table_block_addr, table_height.c_str());
     base::xvaccount_t _table_addr(std::string(sys_contract_eth_table_block_addr) + "@0");
@@ -386,6 +455,53 @@ void xrpc_eth_query_manager::set_block_result(const xobject_ptr_t<base::xvblock_
         }
     }    
 }
+void xrpc_eth_query_manager::set_block_result(const xobject_ptr_t<base::xvblock_t>&  block, xrpc_json_writer_t & writer, bool fullTx, std::error_code & ec) {
+    base::xvaccount_t _vaddress(block->get_account());
+    if (!_vaddress.is_table_address()) {
+        ec = common::error::xerrc_t::invalid_db_load;
+        xwarn("xrpc_eth_query_manager::set_block_result,fail invalid input for block:%s", block->dump().c_str());
+        return;
+    }
+
+    if (block->get_block_class() != base::enum_xvblock_class_nil) {
+        if (false == base::xvchain_t::instance().get_xblockstore()->load_block_input(_vaddress, block.get())) {
+            ec = common::error::xerrc_t::invalid_db_load;
+            xerror("xrpc_eth_query_manager::set_block_result,fail to load block input for block:%s", block->dump().c_str());
+            return;
+        }
+        if (false == base::xvchain_t::instance().get_xblockstore()->load_block_output(_vaddress, block.get())) {
+            ec = common::error::xerrc_t::invalid_db_load;
+            xerror("xrpc_eth_query_manager::set_block_result,fail to load block output for block:%s", block->dump().c_str());
+            return;
+        }
+    }
+
+    std::string block_hash = top::to_hex_prefixed(block->get_block_hash());
+    std::string block_num = xrpc_eth_parser_t::uint64_to_hex_prefixed(block->get_height());
+    auto write_transactions = [&](xrpc_json_writer_t & txs_writer) {
+        auto input_actions = data::xblockextract_t::unpack_eth_txactions(block.get());
+        for (uint64_t txindex = 0; txindex < (uint64_t)input_actions.size(); txindex++) {
+            auto & action = input_actions[txindex];
+            std::string tx_hash = top::to_hex_prefixed(action.get_org_tx_hash());
+            if (!fullTx) {
+                write_json_string(txs_writer, tx_hash);
+                continue;
+            }
+            data::xtransaction_ptr_t raw_tx = data::xblockextract_t::unpack_raw_tx(block.get(), action.get_org_tx_hash(), ec);
+            if (raw_tx == nullptr) {
+                xerror("xrpc_eth_query_manager::set_block_result fail.tx hash:%s", to_hex_str(action.get_org_tx_hash()).c_str());
+                continue;
+            }
+
+            xtx_location_t txlocation(block_hash, block_num, tx_hash, xrpc_eth_parser_t::uint64_to_hex_prefixed(txindex));
+            xrpc_eth_parser_t::transaction_to_json(txlocation, raw_tx, txs_writer, ec);
+            if (ec) {
+                xerror("xrpc_eth_query_manager::set_block_result fail-transaction_to_json.tx hash:%s", to_hex_str(action.get_org_tx_hash()).c_str());
+            }
+        }
+    };
+    xrpc_eth_parser_t::block_to_json(block.get(), write_transactions, writer, ec);
+}
 void xrpc_eth_query_manager::eth_getCode(xJson::Value & js_req, xJson::Value & js_rsp, string & strResult, uint32_t & nErrorCode) {
     if (!eth::EthErrorCode::check_req(js_req, js_rsp, 2))
         return;
@@ -424,6 +540,102 @@ std::string xrpc_eth_query_manager::safe_get_json_value(xJson::Value & js_req, c
         return js_req[key].asString();
     return "";
 }
+namespace {
+// gives the state context back to the pool when the call returns
+class xstatectx_guard_t {
+public:
+    xstatectx_guard_t(xrpc_statectx_pool_t & pool, const base::xvaccount_t & table_addr, base::xvblock_t * block)
+      : m_pool(pool), m_block(block), m_statectx(pool.acquire(table_addr, block)) {
+    }
+    ~xstatectx_guard_t() {
+        m_pool.release(m_block, m_statectx);
+    }
+    statectx::xstatectx_ptr_t const & get() const {
+        return m_statectx;
+    }
+
+private:
+    xrpc_statectx_pool_t & m_pool;
+    base::xvblock_t * m_block;
+    statectx::xstatectx_ptr_t m_statectx;
+};
+}  // namespace
+
+int32_t xrpc_eth_query_manager::execute_eth_call(statectx::xstatectx_ptr_t const & statectx_ptr,
+                                                 base::xvblock_t * block,
+                                                 const std::string & from,
+                                                 const std::string & to,
+                                                 const std::string & data,
+                                                 const std::string & value,
+                                                 evm_common::u256 const & gas,
+                                                 evm_common::u256 const & gas_price,
+                                                 txexecutor::xvm_output_t & output,
+                                                 bool dry_run) {
+    top::data::xtransaction_ptr_t tx = top::data::xtx_factory::create_ethcall_v3_tx(from, to, data, std::strtoul(value.c_str(), NULL, 16), gas, gas_price);
+    auto cons_tx = top::make_object_ptr<top::data::xcons_transaction_t>(tx.get());
+
+    std::string addr = std::string(sys_contract_eth_table_block_addr) + "@0";
+    uint64_t gmtime = block->get_second_level_gmtime();
+    xblock_consensus_para_t cs_para(addr, block->get_clock(), block->get_viewid(), block->get_viewtoken(), block->get_height() + 1, gmtime);
+
+    uint64_t gas_limit = XGET_ONCHAIN_GOVERNANCE_PARAMETER(block_gas_limit);
+    txexecutor::xvm_para_t vmpara(cs_para.get_clock(), cs_para.get_random_seed(), cs_para.get_total_lock_tgas_token(), gas_limit, cs_para.get_table_proposal_height(), eth_zero_address);
+    vmpara.set_dry_run(dry_run);
+    txexecutor::xvm_input_t input{statectx_ptr, vmpara, cons_tx};
+    top::evm::xtop_evm evm{top::make_observer(contract_runtime::evm::xevm_contract_manager_t::instance()), statectx_ptr};
+    return evm.execute(input, output);
+}
+
+uint64_t xrpc_eth_query_manager::estimate_gas(statectx::xstatectx_ptr_t const & statectx_ptr,
+                                              base::xvblock_t * block,
+                                              const std::string & from,
+                                              const std::string & to,
+                                              const std::string & data,
+                                              const std::string & value,
+                                              uint64_t cap,
+                                              evm_common::u256 const & gas_price,
+                                              uint64_t used_gas) {
+    // the run at cap gives the gas profile: the call needs at least its used gas, and usually only
+    // a little more, for the 63/64 of gas passed to nested calls and the stipend of value calls.
+    // so the first try is right above it, and the search only goes on when that is not enough.
+    auto enough = [&](uint64_t gas) {
+        statectx_ptr->do_rollback();
+        txexecutor::xvm_output_t output;
+        auto ret = execute_eth_call(statectx_ptr, block, from, to, data, value, evm_common::u256(gas), gas_price, output, true);
+        return ret == txexecutor::enum_exec_success && output.m_tx_result.status == evm_common::Success;
+    };
+
+    uint64_t lo = used_gas > 0 ? used_gas - 1 : 0;
+    uint64_t hi = cap;
+    uint32_t executions = 1;
+    uint64_t optimistic = (used_gas + enum_call_stipend) * 64 / 63;
+    if (optimistic < hi) {
+        executions++;
+        if (enough(optimistic)) {
+            hi = optimistic;
+        } else {
+            lo = optimistic;
+        }
+    }
+    // stop when hi is within 1.5% of the needed gas
+    while (lo + 1 < hi && (hi - lo) * 1000 > hi * 15 && executions < enum_max_estimate_executions) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        // the needed gas is usually close to lo, do not halve a large cap first
+        if (lo > 0 && mid > lo * 2) {
+            mid = lo * 2;
+        }
+        executions++;
+        if (enough(mid)) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    XMETRICS_COUNTER_INCREMENT("rpc_estimate_gas_executions", executions);
+    xdbg("xrpc_eth_query_manager::estimate_gas, used %llu, estimate %llu, executions %u", used_gas, hi, executions);
+    return hi;
+}
+
 void xrpc_eth_query_manager::eth_call(xJson::Value & js_req, xJson::Value & js_rsp, string & strResult, uint32_t & nErrorCode) {
     if (!eth::EthErrorCode::check_req(js_req, js_rsp, 2))
         return;
@@ -486,8 +698,6 @@ void xrpc_eth_query_manager::eth_call(xJson::Value & js_req, xJson::Value & js_r
         }
     }
 
-    top::data::xtransaction_ptr_t tx = top::data::xtx_factory::create_ethcall_v3_tx(from, to, data, std::strtoul(value.c_str(), NULL, 16), gas_u256, gas_price_u256);
-    auto cons_tx = top::make_object_ptr<top::data::xcons_transaction_t>(tx.get());
     xinfo("xrpc_eth_query_manager::eth_call, %s, %s, %s", jdata.c_str(), value.c_str(), gas_u256.str().c_str());
 
     std::string addr = std::string(sys_contract_eth_table_block_addr) + "@0";
@@ -499,11 +709,9 @@ void xrpc_eth_query_manager::eth_call(xJson::Value & js_req, xJson::Value & js_r
         eth::EthErrorCode::deal_error(js_rsp, eth::enum_eth_rpc_execution_reverted, msg);
         return;
     }
-    uint64_t gmtime = block->get_second_level_gmtime();
-    xblock_consensus_para_t cs_para(addr, block->get_clock(), block->get_viewid(), block->get_viewtoken(), block->get_height() + 1, gmtime);
 
-    // TODO(jimmy) should create statectx by block
-    statectx::xstatectx_ptr_t statectx_ptr = statectx::xstatectx_factory_t::create_statectx(_vaddress, block.get());
+    xstatectx_guard_t statectx_guard(m_statectx_pool, _vaddress, block.get());
+    statectx::xstatectx_ptr_t const & statectx_ptr = statectx_guard.get();
     if (statectx_ptr == nullptr) {
         xwarn("create_statectx fail: %s", addr.c_str());
         std::string msg = "err: statectx create fail";
@@ -520,13 +728,8 @@ void xrpc_eth_query_manager::eth_call(xJson::Value & js_req, xJson::Value & js_r
         return;
     }
 
-    uint64_t gas_limit = XGET_ONCHAIN_GOVERNANCE_PARAMETER(block_gas_limit);
-    txexecutor::xvm_para_t vmpara(cs_para.get_clock(), cs_para.get_random_seed(), cs_para.get_total_lock_tgas_token(), gas_limit, cs_para.get_table_proposal_height(), eth_zero_address);
-    txexecutor::xvm_input_t input{statectx_ptr, vmpara, cons_tx};
     txexecutor::xvm_output_t output;
-    top::evm::xtop_evm evm{top::make_observer(contract_runtime::evm::xevm_contract_manager_t::instance()), statectx_ptr};
-
-    auto ret = evm.execute(input, output);
+    auto ret = execute_eth_call(statectx_ptr, block.get(), from, to, data, value, gas_u256, gas_price_u256, output);
     if (ret != txexecutor::enum_exec_success) {
         xwarn("evm call fail.");
         std::string msg = "err: evm execute fail " + std::to_string(ret);
@@ -617,8 +820,6 @@ void xrpc_eth_query_manager::eth_estimateGas(xJson::Value & js_req, xJson::Value
         }
     }
 
-    top::data::xtransaction_ptr_t tx = top::data::xtx_factory::create_ethcall_v3_tx(from, to, data, std::strtoul(value.c_str(), NULL, 16), gas_u256, gas_price_u256);
-    auto cons_tx = top::make_object_ptr<top::data::xcons_transaction_t>(tx.get());
     xinfo("xrpc_eth_query_manager::eth_estimateGas, %s, %s, %s", jdata.c_str(), value.c_str(), gas_u256.str().c_str());
 
     std::string addr = std::string(sys_contract_eth_table_block_addr) + "@0";
@@ -629,10 +830,9 @@ void xrpc_eth_query_manager::eth_estimateGas(xJson::Value & js_req, xJson::Value
         eth::EthErrorCode::deal_error(js_rsp, eth::enum_eth_rpc_execution_reverted, msg);
         return;
     }
-    uint64_t gmtime = block->get_second_level_gmtime();
-    xblock_consensus_para_t cs_para(addr, block->get_clock(), block->get_viewid(), block->get_viewtoken(), block->get_height() + 1, gmtime);
 
-    statectx::xstatectx_ptr_t statectx_ptr = statectx::xstatectx_factory_t::create_statectx(_vaddress, block.get());
+    xstatectx_guard_t statectx_guard(m_statectx_pool, _vaddress, block.get());
+    statectx::xstatectx_ptr_t const & statectx_ptr = statectx_guard.get();
     if (statectx_ptr == nullptr) {
         xwarn("create statectx fail: %s", addr.c_str());
         std::string msg = "err: statectx create fail";
@@ -649,14 +849,8 @@ void xrpc_eth_query_manager::eth_estimateGas(xJson::Value & js_req, xJson::Value
         return;
     }
 
-    uint64_t gas_limit = XGET_ONCHAIN_GOVERNANCE_PARAMETER(block_gas_limit);
-    txexecutor::xvm_para_t vmpara(cs_para.get_clock(), cs_para.get_random_seed(), cs_para.get_total_lock_tgas_token(), gas_limit, cs_para.get_table_proposal_height(), eth_zero_address);
-
-    txexecutor::xvm_input_t input{statectx_ptr, vmpara, cons_tx};
     txexecutor::xvm_output_t output;
-    top::evm::xtop_evm evm{top::make_observer(contract_runtime::evm::xevm_contract_manager_t::instance()), statectx_ptr};
-
-    auto ret = evm.execute(input, output);
+    auto ret = execute_eth_call(statectx_ptr, block.get(), from, to, data, value, gas_u256, gas_price_u256, output, true);
     if (ret != txexecutor::enum_exec_success) {
         xwarn("evm call fail.");
         std::string msg = "err: evm execute fail " + std::to_string(ret);
@@ -667,9 +861,8 @@ void xrpc_eth_query_manager::eth_estimateGas(xJson::Value & js_req, xJson::Value
 
     switch (output.m_tx_result.status) {
     case evm_common::Success: {
-        std::stringstream outstr;
-        outstr << "0x" << std::hex << output.m_tx_result.used_gas + output.m_tx_result.used_gas / 2;
-        js_rsp["result"] = outstr.str();
+        uint64_t gas = estimate_gas(statectx_ptr, block.get(), from, to, data, value, gas_u256.convert_to<uint64_t>(), gas_price_u256, output.m_tx_result.used_gas);
+        js_rsp["result"] = xrpc_eth_parser_t::uint64_to_hex_prefixed(gas);
         break;
     }
 
@@ -780,6 +973,27 @@ int xrpc_eth_query_manager::parse_topics(const xJson::Value& topics, std::vector
     }
     return 0;
 }
+int xrpc_eth_query_manager::parse_addresses(const xJson::Value& t, std::set<std::string>& sAddress, xJson::Value & js_rsp) {
+    if (t.isString()) {
+        if (!eth::EthErrorCode::check_hex(t.asString(), js_rsp, 0, eth::enum_rpc_type_address))
+            return 1;
+        if (!eth::EthErrorCode::check_eth_address(t.asString(), js_rsp))
+            return 1;
+
+        sAddress.insert(t.asString());
+        xdbg("eth_getLogs, address : %s", t.asString().c_str());
+    } else if (t.isArray()) {
+        for (int i = 0; i < (int)t.size(); i++) {
+            if (!eth::EthErrorCode::check_hex(t[i].asString(), js_rsp, 0, eth::enum_rpc_type_address))
+                return 1;
+            if (!eth::EthErrorCode::check_eth_address(t[i].asString(), js_rsp))
+                return 1;
+            sAddress.insert(t[i].asString());
+            xdbg("eth_getLogs, address: %s", t[i].asString().c_str());
+        }
+    }
+    return 0;
+}
 void xrpc_eth_query_manager::eth_getLogs(xJson::Value & js_req, xJson::Value & js_rsp, string & strResult, uint32_t & nErrorCode) {
     if (js_req.size() == 0) {
         std::string msg = std::string("missing value for required argument 0");
@@ -822,25 +1036,8 @@ void xrpc_eth_query_manager::eth_getLogs(xJson::Value & js_req, xJson::Value & j
     }
     std::set<std::string> sAddress;
     if (js_req[0].isMember("address")) {
-        xJson::Value t = js_req[0]["address"];
-        if (t.isString()) {
-            if (!eth::EthErrorCode::check_hex(t.asString(), js_rsp, 0, eth::enum_rpc_type_address))
-                return;
-            if (!eth::EthErrorCode::check_eth_address(t.asString(), js_rsp))
-                return;
-
-            sAddress.insert(t.asString());
-            xdbg("eth_getLogs, address : %s", t.asString().c_str());
-        } else if (t.isArray()) {
-            for (int i = 0; i < (int)t.size(); i++) {
-                if (!eth::EthErrorCode::check_hex(t[i].asString(), js_rsp, 0, eth::enum_rpc_type_address))
-                    return;
-                if (!eth::EthErrorCode::check_eth_address(t[i].asString(), js_rsp))
-                    return;
-                sAddress.insert(t[i].asString());
-                xdbg("eth_getLogs, address: %s", t[i].asString().c_str());
-            }
-        }
+        if (parse_addresses(js_req[0]["address"], sAddress, js_rsp) != 0)
+            return;
     }
 
     if ((!from_block.empty() || !to_block.empty()) && !blockhash.empty()) {
@@ -881,8 +1078,9 @@ void xrpc_eth_query_manager::eth_getLogs(xJson::Value & js_req, xJson::Value & j
             js_rsp["result"] = xJson::Value::null;
             return;
         }
-        if (end - begin > 1024)
-            begin = end - 1024;
+        uint64_t max_blocks = XGET_CONFIG(eth_getlogs_max_blocks);
+        if (end - begin > max_blocks)
+            begin = end - max_blocks;
     }
     xinfo("xrpc_eth_query_manager::eth_getLogs, %llu, %llu", begin, end);
 
@@ -890,7 +1088,7 @@ void xrpc_eth_query_manager::eth_getLogs(xJson::Value & js_req, xJson::Value & j
     return;
 }
 
-bool xrpc_eth_query_manager::check_log_is_match(evm_common::xevm_log_t const& log, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) const {
+bool xrpc_eth_query_manager::check_log_is_match(evm_common::xevm_log_t const& log, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) {
     std::string log_address_hex = log.address.to_hex_string();
     if (!sAddress.empty() && sAddress.find(log_address_hex) == sAddress.end()) {
         xdbg("address not match: %s", log_address_hex.c_str());
@@ -979,64 +1177,101 @@ bool xrpc_eth_query_manager::check_block_log_bloom(xobject_ptr_t<base::xvblock_t
 
     return true;
 }
+bool xrpc_eth_query_manager::get_log_filter(const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress, xrpc_eth_bloombits_t::xfilter_t & filter) const {
+    std::error_code ec;
+    std::vector<xbytes_t> addresses;
+    for (auto & address : sAddress) {
+        addresses.push_back(top::from_hex(address, ec));
+        if (ec)
+            return false;
+    }
+    filter.push_back(addresses);
+    for (auto & setTopics : vTopics) {
+        std::vector<xbytes_t> topics;
+        for (auto & topic : setTopics) {
+            topics.push_back(top::from_hex(topic, ec));
+            if (ec)
+                return false;
+        }
+        filter.push_back(topics);
+    }
+    return true;
+}
 int xrpc_eth_query_manager::get_log(xJson::Value & js_rsp, const uint64_t begin, const uint64_t end, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) {
+    // the bloombits index gives the candidate blocks of its sections, the rest of the range is checked block by block
+    uint64_t scan_begin = begin;
+    xrpc_eth_bloombits_t::xfilter_t filter;
+    if ((!vTopics.empty() || !sAddress.empty()) && get_log_filter(vTopics, sAddress, filter)) {
+        std::vector<uint64_t> heights;
+        scan_begin = xrpc_eth_bloombits_t::instance().candidates(begin, end, filter, heights);
+        xdbg("xrpc_eth_query_manager::get_log, candidates: %zu, scan from %llu", heights.size(), scan_begin);
+        for (auto height : heights) {
+            if (get_block_log(js_rsp, height, vTopics, sAddress))
+                return 0;
+        }
+    }
+    for (uint64_t i = scan_begin; i <= end; i++) {  // traverse blocks
+        if (get_block_log(js_rsp, i, vTopics, sAddress))
+            return 0;
+    }
+    if (js_rsp["result"].empty())
+        js_rsp["result"].resize(0);
+    return 0;
+}
+bool xrpc_eth_query_manager::get_block_log(xJson::Value & js_rsp, const uint64_t height, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) {
     base::xvaccount_t _table_addr(std::string(sys_contract_eth_table_block_addr) + "@0");
-    for (uint64_t i = begin; i <= end; i++) {  // traverse blocks
-        xobject_ptr_t<base::xvblock_t> block = m_block_store->load_block_object(_table_addr, i, base::enum_xvblock_flag_authenticated, false);
-        if (block == nullptr) {
-            xwarn("xrpc_eth_query_manager::get_log, load_block_object fail:%llu", i);
+    xobject_ptr_t<base::xvblock_t> block = m_block_store->load_block_object(_table_addr, height, base::enum_xvblock_flag_authenticated, false);
+    if (block == nullptr) {
+        xwarn("xrpc_eth_query_manager::get_log, load_block_object fail:%llu", height);
+        return false;
+    }
+
+    if (!check_block_log_bloom(block, vTopics, sAddress)) {
+        xdbg("filter_block_log_bloom fail, %llu", height);
+        return false;
+    } else {
+        xdbg("filter_block_log_bloom ok, %llu", height);
+    }
+
+    auto input_actions = data::xblockextract_t::unpack_eth_txactions(block.get());
+    xdbg("input_actions size:%d", input_actions.size());
+    for (uint64_t txindex = 0; txindex < (uint64_t)input_actions.size(); txindex++) {
+        auto & action = input_actions[txindex];
+
+        data::xeth_store_receipt_t evm_tx_receipt;
+        auto ret = action.get_evm_transaction_receipt(evm_tx_receipt);
+        if (!ret) {
+            xerror("xrpc_eth_query_manager::get_log, fail-get evm transaction receipt,height=%llu,txindex=%llu", height, txindex);
             continue;
         }
-
-        if (!check_block_log_bloom(block, vTopics, sAddress)) {
-            xdbg("filter_block_log_bloom fail, %llu", i);
+        if (evm_tx_receipt.get_logs().empty()) {
             continue;
-        } else {
-            xdbg("filter_block_log_bloom ok, %llu", i);
         }
 
-        auto input_actions = data::xblockextract_t::unpack_eth_txactions(block.get());
-        xdbg("input_actions size:%d", input_actions.size());
-        for (uint64_t txindex = 0; txindex < (uint64_t)input_actions.size(); txindex++) {
-            auto & action = input_actions[txindex];
+        std::string block_hash = top::to_hex_prefixed(block->get_block_hash());
+        std::string block_num = xrpc_eth_parser_t::uint64_to_hex_prefixed(block->get_height());
+        std::string tx_hash = top::to_hex_prefixed(action.get_org_tx_hash());
+        std::string tx_index = xrpc_eth_parser_t::uint64_to_hex_prefixed(txindex);
+        xlog_location_t loglocation(block_hash, block_num, tx_hash, tx_index);
 
-            data::xeth_store_receipt_t evm_tx_receipt;
-            auto ret = action.get_evm_transaction_receipt(evm_tx_receipt);
-            if (!ret) {
-                xerror("xrpc_eth_query_manager::get_log, fail-get evm transaction receipt,i=%llu,txindex=%llu", i, txindex);
-                continue;
-            }
-            if (evm_tx_receipt.get_logs().empty()) {
+        uint32_t index = 0;
+        for (uint64_t logindex = 0; logindex < (uint64_t)evm_tx_receipt.get_logs().size(); logindex++) {
+            auto & log = evm_tx_receipt.get_logs()[logindex];
+            if (false == check_log_is_match(log, vTopics, sAddress)) {
                 continue;
             }
-
-            std::string block_hash = top::to_hex_prefixed(block->get_block_hash());
-            std::string block_num = xrpc_eth_parser_t::uint64_to_hex_prefixed(block->get_height());
-            std::string tx_hash = top::to_hex_prefixed(action.get_org_tx_hash());
-            std::string tx_index = xrpc_eth_parser_t::uint64_to_hex_prefixed(txindex);
-            xlog_location_t loglocation(block_hash, block_num, tx_hash, tx_index);
-
-            uint32_t index = 0;
-            for (uint64_t logindex = 0; logindex < (uint64_t)evm_tx_receipt.get_logs().size(); logindex++) {
-                auto & log = evm_tx_receipt.get_logs()[logindex];
-                if (false == check_log_is_match(log, vTopics, sAddress)) {
-                    continue;
-                }
-                loglocation.m_log_index = xrpc_eth_parser_t::uint64_to_hex_prefixed(logindex);
-
-                xJson::Value js_log;
-                xrpc_eth_parser_t::log_to_json(loglocation, log, js_log);
-                js_rsp["result"].append(js_log);
-                if (js_rsp["result"].size() >= 1024) {
-                    xwarn("xrpc_eth_query_manager::get_log,too many logs: %d,begin=%ld,end=%ld", js_rsp["result"].size(),begin,end);
-                    return 0;
-                }
+            loglocation.m_log_index = xrpc_eth_parser_t::uint64_to_hex_prefixed(logindex);
+
+            xJson::Value js_log;
+            xrpc_eth_parser_t::log_to_json(loglocation, log, js_log);
+            js_rsp["result"].append(js_log);
+            if (js_rsp["result"].size() >= XGET_CONFIG(eth_getlogs_max_logs)) {
+                xwarn("xrpc_eth_query_manager::get_log,too many logs: %d,height=%ld", js_rsp["result"].size(), height);
+                return true;
             }
         }
     }
-    if (js_rsp["result"].empty())
-        js_rsp["result"].resize(0);
-    return 0;
+    return false;
 }
 
 xobject_ptr_t<base::xvblock_t> xrpc_eth_query_manager::query_relay_block_by_height(const std::string& table_height) {
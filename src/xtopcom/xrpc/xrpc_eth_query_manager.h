@@ -15,8 +15,13 @@
 #include "xvledger/xvledger.h"
 #include "xtxpool_service_v2/xtxpool_service_face.h"
 #include "xrpc/xjson_proc.h"
+#include "xevm_common/common.h"
 #include "xevm_common/fixed_hash.h"
 #include "xrpc/eth_rpc/eth_error_code.h"
+#include "xrpc/xrpc_eth_bloombits.h"
+#include "xrpc/xrpc_json_writer.h"
+#include "xrpc/xrpc_statectx_pool.h"
+#include "xtxexecutor/xvm_face.h"
 
 namespace top {
 namespace xrpc {
@@ -102,19 +107,44 @@ public:
     void topRelay_getTransactionReceipt(xJson::Value & js_req, xJson::Value & js_rsp, string & strResult, uint32_t & nErrorCode);
 
     void top_getBalance(xJson::Value & js_req, xJson::Value & js_rsp, string & strResult, uint32_t & nErrorCode);
+
+    // whether the response of method is on committed data and never changes
+    bool is_final_result(const std::string & method, const xJson::Value & js_rsp);
+    // write the result of the large queries straight into result, false if method should be called as usual.
+    // is_final is set if the result is on committed data
+    bool write_result(const std::string & method, xJson::Value & js_req, std::string & result, bool & is_final);
+
+    // log filters of eth_getLogs, also used by the logs subscriptions. parse return non zero on error, written in js_rsp
+    static int parse_topics(const xJson::Value& t, std::vector<std::set<std::string>>& vTopics, xJson::Value & js_rsp);
+    static int parse_addresses(const xJson::Value& t, std::set<std::string>& sAddress, xJson::Value & js_rsp);
+    static bool check_log_is_match(evm_common::xevm_log_t const& log, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress);
 private:
     std::string safe_get_json_value(xJson::Value & json_value, const std::string& key);
     void set_block_result(const xobject_ptr_t<base::xvblock_t>&  block, xJson::Value& js_result, bool fullTx, std::error_code & ec);
+    void set_block_result(const xobject_ptr_t<base::xvblock_t>&  block, xrpc_json_writer_t & writer, bool fullTx, std::error_code & ec);
+    bool is_committed_height(uint64_t height);
+    bool is_committed_relay_height(uint64_t height);
     enum_query_result query_account_by_number(const std::string &unit_address, const std::string& table_height, data::xunitstate_ptr_t& ptr);
     xobject_ptr_t<base::xvblock_t> query_block_by_height(const std::string& height_str);
     xobject_ptr_t<base::xvblock_t> query_relay_block_by_height(const std::string& height_str);
     uint64_t get_block_height(const std::string& table_height);
     int get_log(xJson::Value & js_rsp, const uint64_t begin, const uint64_t end, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress);
-    bool check_log_is_match(evm_common::xevm_log_t const& log, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) const;
+    // return true once the result is full
+    bool get_block_log(xJson::Value & js_rsp, const uint64_t height, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress);
+    bool get_log_filter(const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress, xrpc_eth_bloombits_t::xfilter_t & filter) const;
     bool check_block_log_bloom(xobject_ptr_t<base::xvblock_t>& block, const std::vector<std::set<std::string>>& vTopics, const std::set<std::string>& sAddress) const;
-    int parse_topics(const xJson::Value& t, std::vector<std::set<std::string>>& vTopics, xJson::Value & js_rsp);
     int set_relay_block_result(const xobject_ptr_t<base::xvblock_t>& block, xJson::Value & js_rsp, int have_txs, std::string blocklist_type);
+    int32_t execute_eth_call(statectx::xstatectx_ptr_t const& statectx_ptr, base::xvblock_t* block, const std::string& from, const std::string& to, const std::string& data,
+                             const std::string& value, evm_common::u256 const& gas, evm_common::u256 const& gas_price, txexecutor::xvm_output_t & output,
+                             bool dry_run = false);
+    // the least gas within 1.5% which lets the call succeed, used_gas is of the run with cap
+    uint64_t estimate_gas(statectx::xstatectx_ptr_t const& statectx_ptr, base::xvblock_t* block, const std::string& from, const std::string& to, const std::string& data,
+                          const std::string& value, uint64_t cap, evm_common::u256 const& gas_price, uint64_t used_gas);
 private:
+    enum {
+        enum_call_stipend = 2300,
+        enum_max_estimate_executions = 12,
+    };
     observer_ptr<base::xvblockstore_t> m_block_store;
     sync::xsync_face_t * m_sync{nullptr};
     uint64_t m_edge_start_height;
@@ -124,6 +154,7 @@ private:
     xtxpool_service_v2::xtxpool_proxy_face_ptr m_txpool_service;
     observer_ptr<base::xvtxstore_t> m_txstore;
     bool m_exchange_flag{false};
+    xrpc_statectx_pool_t m_statectx_pool;
 };
 
 }  // namespace xrpc
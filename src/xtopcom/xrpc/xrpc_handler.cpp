@@ -6,7 +6,11 @@
 #include "xbase/xcontext.h"
 #include "xcodec/xmsgpack_codec.hpp"
 #include "xmetrics/xmetrics.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xrpc/xerror/xrpc_error_json.h"
+#include "xrpc/xrpc_eth_bloombits.h"
+#include "xrpc/xrpc_response_cache.h"
 #include "xrpc/xrpc_init.h"
 #include "xrpc/xrpc_method.h"
 #include "xrpc/xuint_format.h"
@@ -22,6 +26,16 @@ using data::xtransaction_t;
 
 #define max_cluster_rpc_mailbox_num (10000)
 
+static bool is_log_query(const xrpc_msg_request_t & msg) {
+    try {
+        xjson_proc_t json_proc;
+        json_proc.parse_json(msg.m_message_body);
+        return json_proc.m_request_json.isObject() && json_proc.m_request_json["method"].isString() && json_proc.m_request_json["method"].asString() == "eth_getLogs";
+    } catch (...) {
+        return false;
+    }
+}
+
 xrpc_handler::xrpc_handler(std::shared_ptr<xvnetwork_driver_face_t>           arc_vhost,
                            observer_ptr<xrouter_face_t>                       router_ptr,
                            xtxpool_service_v2::xtxpool_proxy_face_ptr const & txpool_service,
@@ -36,6 +50,7 @@ xrpc_handler::xrpc_handler(std::shared_ptr<xvnetwork_driver_face_t>           ar
   , m_rpc_query_mgr(std::make_shared<xrpc_query_manager>(block_store, nullptr, txpool_service, txstore, exchange_flag))
   , m_rpc_eth_query_mgr(std::make_shared<xrpc_eth_query_manager>(block_store, nullptr, txpool_service, txstore, exchange_flag))
   , m_thread(thread) {
+    xrpc_eth_bloombits_t::instance().start(block_store);
 }
 
 void xrpc_handler::on_message(const xvnode_address_t & edge_sender, const xmessage_t & message) {
@@ -55,6 +70,10 @@ void xrpc_handler::on_message(const xvnode_address_t & edge_sender, const xmessa
             if (msgid == rpc_msg_request || msgid == rpc_msg_eth_request) {
                 xdbg_rpc("wish arc tx");
                 return true;
+            } else if (msgid == rpc_msg_eth_query_request && is_log_query(msg)) {
+                // log queries may walk many blocks, keep them off the rpc thread
+                self->m_log_worker_pool.post([self, msg, edge_sender, message]() { self->cluster_process_query_request(msg, edge_sender, message); });
+                XMETRICS_GAUGE(metrics::rpc_auditor_query_request, 1);
             } else {
                 self->cluster_process_query_request(msg, edge_sender, message);
                 XMETRICS_GAUGE(metrics::rpc_auditor_query_request, 1);
@@ -169,24 +188,49 @@ void xrpc_handler::cluster_process_query_request(const xrpc_msg_request_t & edge
     // json_proc.m_request_json["params"]["jsonrpc"] = version;
     string strErrorMsg = RPC_OK_MSG;
     uint32_t nErrorCode = 0;
+    auto & cache = xrpc_response_cache_t::instance();
+    std::string raw_result;
 
     if (message.id() >= rpc_msg_request && message.id() <= rpc_msg_query_request) {
         m_rule_mgr_ptr->filter(json_proc);
         const string & version = json_proc.m_request_json["version"].asString();
         json_proc.m_request_json["params"]["version"] = version;
-        m_rpc_query_mgr->call_method(strMethod, json_proc.m_request_json["params"], json_proc.m_response_json["data"], strErrorMsg, nErrorCode);
+        std::string cache_key = xrpc_response_cache_t::make_key(strMethod, json_proc.m_request_json["params"]);
+        if (cache.get(cache_key, raw_result)) {
+            json_proc.m_response_json["data"] = xJson::Value::null;
+        } else {
+            m_rpc_query_mgr->call_method(strMethod, json_proc.m_request_json["params"], json_proc.m_response_json["data"], strErrorMsg, nErrorCode);
+            if (nErrorCode == 0 && m_rpc_query_mgr->is_final_result(strMethod, json_proc.m_request_json["params"], json_proc.m_response_json["data"]))
+                cache.put(cache_key, json_proc.m_response_json["data"]);
+        }
         json_proc.m_response_json[RPC_ERRNO] = nErrorCode;
         json_proc.m_response_json[RPC_ERRMSG] = strErrorMsg;
         json_proc.m_response_json[RPC_SEQUENCE_ID] = edge_msg.m_client_id;
     } else if (message.id() >= rpc_msg_eth_request && message.id() <= rpc_msg_eth_query_request) {
         m_rule_mgr_ptr->filter_eth(json_proc);
         const string & version = json_proc.m_request_json["jsonrpc"].asString();
-        m_rpc_eth_query_mgr->call_method(strMethod, json_proc.m_request_json["params"], json_proc.m_response_json, strErrorMsg, nErrorCode);
+        std::string cache_key = xrpc_response_cache_t::make_key(strMethod, json_proc.m_request_json["params"]);
+        bool is_final = false;
+        if (cache.get(cache_key, raw_result)) {
+            json_proc.m_response_json["result"] = xJson::Value::null;
+        } else if (m_rpc_eth_query_mgr->write_result(strMethod, json_proc.m_request_json["params"], raw_result, is_final)) {
+            json_proc.m_response_json["result"] = xJson::Value::null;
+            if (is_final)
+                cache.put(cache_key, raw_result);
+        } else {
+            m_rpc_eth_query_mgr->call_method(strMethod, json_proc.m_request_json["params"], json_proc.m_response_json, strErrorMsg, nErrorCode);
+            if (nErrorCode == 0 && m_rpc_eth_query_mgr->is_final_result(strMethod, json_proc.m_response_json))
+                cache.put(cache_key, json_proc.m_response_json["result"]);
+        }
         json_proc.m_response_json["id"] = json_proc.m_request_json["id"];  // edge_msg.m_client_id;
         json_proc.m_response_json["jsonrpc"] = version;
     }
 
     response_msg_ptr->m_message_body = json_proc.get_response();
+    if (!raw_result.empty()) {
+        // the cached or streamed result is already serialized, only the envelope is written
+        xrpc_response_cache_t::splice(response_msg_ptr->m_message_body, message.id() <= rpc_msg_query_request ? "data" : "result", raw_result);
+    }
     response_msg_ptr->m_signature_address = m_arc_vhost->address();
     xmessage_t msg(codec::xmsgpack_codec_t<xrpc_msg_response_t>::encode(*response_msg_ptr), rpc_msg_response);
     xdbg_rpc("xarc_rpc_handler response recv %" PRIx64 ", send %" PRIx64 ", %s", message.hash(), msg.hash(), response_msg_ptr->m_message_body.c_str());
@@ -219,12 +263,14 @@ void xrpc_handler::cluster_process_response(const xmessage_t & msg, const xvnode
 }
 
 void xrpc_handler::start() {
+    m_log_worker_pool.start(XGET_CONFIG(eth_getlogs_worker_threads));
     m_arc_vhost->register_message_ready_notify(xmessage_category_rpc, std::bind(&xrpc_handler::on_message, shared_from_this(), _1, _2));
     xinfo("register rpc");
 }
 
 void xrpc_handler::stop() {
     m_arc_vhost->unregister_message_ready_notify(xmessage_category_rpc);
+    m_log_worker_pool.stop();
     xinfo("unregister rpc");
 }
 NS_END2
@@ -14,6 +14,7 @@
 #include "xvnetwork/xvhost_face.h"
 #include "xrpc/xrpc_query_manager.h"
 #include "xrpc/xrpc_eth_query_manager.h"
+#include "xrpc/xrpc_worker_pool.h"
 
 NS_BEG2(top, xrpc)
 using router::xrouter_face_t;
@@ -45,6 +46,7 @@ private:
     std::shared_ptr<xrpc_query_manager>                  m_rpc_query_mgr;
     std::shared_ptr<xrpc_eth_query_manager>              m_rpc_eth_query_mgr;
     observer_ptr<top::base::xiothread_t>                 m_thread;
+    xrpc_worker_pool                                     m_log_worker_pool;
 };
 
 NS_END2
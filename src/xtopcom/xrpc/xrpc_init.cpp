@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "xrpc_init.h"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xcommon/xnode_type.h"
 #include "xrpc/xhttp/xevm_server.h"
 #include "xrpc/xhttp/xhttp_server.h"
@@ -52,13 +53,13 @@ xrpc_init::xrpc_init(std::shared_ptr<xvnetwork_driver_face_t> vhost,
 
         xdbg("edge http");
         shared_ptr<xhttp_server> http_server_ptr = std::make_shared<xhttp_server>(m_edge_handler, ip, false, block_store, txstore, elect_main, election_cache_data_accessor);
-        http_server_ptr->start(http_port);
+        http_server_ptr->start(http_port, XGET_CONFIG(rpc_io_threads), XGET_CONFIG(rpc_worker_threads));
         shared_ptr<xws_server> ws_server_ptr = std::make_shared<xws_server>(m_edge_handler, ip, false, block_store, txstore, elect_main, election_cache_data_accessor);
-        ws_server_ptr->start(ws_port);
+        ws_server_ptr->start(ws_port, XGET_CONFIG(rpc_io_threads), XGET_CONFIG(rpc_worker_threads));
 
         xdbg("edge evm");
         shared_ptr<xevm_server> evm_server_ptr = std::make_shared<xevm_server>(m_edge_handler, ip, false, block_store, txstore, elect_main, election_cache_data_accessor);
-        evm_server_ptr->start(XGET_CONFIG(evm_port));
+        evm_server_ptr->start(XGET_CONFIG(evm_port), XGET_CONFIG(rpc_io_threads), XGET_CONFIG(rpc_worker_threads));
         break;
     }
     case common::xnode_type_t::storage_archive:
@@ -75,9 +76,9 @@ xrpc_init::xrpc_init(std::shared_ptr<xvnetwork_driver_face_t> vhost,
         m_edge_handler = std::make_shared<xrpc_edge_vhost>(vhost, router_ptr, make_observer(m_thread));
         auto ip = vhost->address().xip2();
         shared_ptr<xhttp_server> http_server_ptr = std::make_shared<xhttp_server>(m_edge_handler, ip, true, block_store, txstore, elect_main, election_cache_data_accessor);
-        http_server_ptr->start(http_port);
+        http_server_ptr->start(http_port, XGET_CONFIG(rpc_io_threads), XGET_CONFIG(rpc_worker_threads));
         shared_ptr<xws_server> ws_server_ptr = std::make_shared<xws_server>(m_edge_handler, ip, true, block_store, txstore, elect_main, election_cache_data_accessor);
-        ws_server_ptr->start(ws_port);
+        ws_server_ptr->start(ws_port, XGET_CONFIG(rpc_io_threads), XGET_CONFIG(rpc_worker_threads));
         xdbg("start exchange rpc service.");
 
 //        shared_ptr<xevm_server> evm_server_ptr = std::make_shared<xevm_server>(m_edge_handler, ip, true, block_store, txstore, elect_main, election_cache_data_accessor);
@@ -129,6 +130,7 @@ void xrpc_init::stop() {
 void xrpc_init::init_rpc_cb_thread(){
     if(m_thread == nullptr){
         m_thread = base::xiothread_t::create_thread(base::xcontext_t::instance(), 0, -1);
+        threading::set_thread_name(m_thread, "rpc_cb");
     }
 }
 
@@ -0,0 +1,30 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <string>
+
+namespace top {
+namespace xrpc {
+
+// streaming writer for the large results, which are written straight into one buffer instead of
+// building an xJson tree first. members are written in sorted order, the same text as xJson gives.
+using xrpc_json_buffer_t = rapidjson::StringBuffer;
+using xrpc_json_writer_t = rapidjson::Writer<rapidjson::StringBuffer>;
+
+inline void write_json_string(xrpc_json_writer_t & writer, const std::string & value) {
+    writer.String(value.c_str(), (rapidjson::SizeType)value.size());
+}
+
+inline void write_json_member(xrpc_json_writer_t & writer, const char * key, const std::string & value) {
+    writer.Key(key);
+    write_json_string(writer, value);
+}
+
+}  // namespace xrpc
+}  // namespace top
@@ -28,8 +28,26 @@ void xtxindex_detail_t::set_raw_tx(base::xdataunit_t* tx) {
     }
 }
 
-xtxindex_detail_ptr_t  xrpc_loader_t::load_tx_indx_detail(const std::string & raw_tx_hash,base::enum_transaction_subtype type) {
-    base::xauto_ptr<base::xvtxindex_t> txindex = base::xvchain_t::instance().get_xtxstore()->load_tx_idx(raw_tx_hash, type);
+base::xauto_ptr<base::xvtxindex_t> xrpc_loader_t::load_tx_idx(const std::string & raw_tx_hash, base::enum_transaction_subtype type, const base::xvdbsnapshot_ptr_t & snapshot) {
+    if (nullptr == snapshot) {
+        return base::xvchain_t::instance().get_xtxstore()->load_tx_idx(raw_tx_hash, type);
+    }
+    const std::string tx_idx_key = base::xvdbkey_t::create_tx_index_key(raw_tx_hash, base::xvtxkey_t::transaction_subtype_to_txindex_type(type));
+    const std::string tx_idx_bin = snapshot->get_value(tx_idx_key);
+    if (tx_idx_bin.empty()) {
+        return nullptr;
+    }
+    base::xauto_ptr<base::xvtxindex_t> txindex(new base::xvtxindex_t());
+    if (txindex->serialize_from_string(tx_idx_bin) <= 0) {
+        xerror("xrpc_loader_t::load_tx_idx,found bad index for hash:%s,type:%d", base::xstring_utl::to_hex(raw_tx_hash).c_str(), type);
+        return nullptr;
+    }
+    txindex->set_tx_hash(raw_tx_hash);
+    return txindex;
+}
+
+xtxindex_detail_ptr_t  xrpc_loader_t::load_tx_indx_detail(const std::string & raw_tx_hash,base::enum_transaction_subtype type, const base::xvdbsnapshot_ptr_t & snapshot) {
+    base::xauto_ptr<base::xvtxindex_t> txindex = load_tx_idx(raw_tx_hash, type, snapshot);
     if (nullptr == txindex) {
         xwarn("xrpc_loader_t::load_tx_indx_detail,fail to index for hash:%s,type:%d", base::xstring_utl::to_hex(raw_tx_hash).c_str(), type);
         return nullptr;
@@ -120,13 +138,13 @@ xJson::Value xrpc_loader_t::parse_confirm_tx(const xtxindex_detail_ptr_t & sendi
     return jv;
 }
 
-xJson::Value xrpc_loader_t::load_and_parse_recv_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status & recvtx_status) {
+xJson::Value xrpc_loader_t::load_and_parse_recv_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status & recvtx_status, const base::xvdbsnapshot_ptr_t & snapshot) {
     xJson::Value jv;
     if (sendindex->get_txaction().get_inner_table_flag()) {  // not need recvindex, create a mock recv json
         jv = xrpc_loader_t::parse_recv_tx(sendindex, nullptr);
         recvtx_status = sendindex->get_txaction().get_tx_exec_status();
     } else {
-        xtxindex_detail_ptr_t recvindex = xrpc_loader_t::load_tx_indx_detail(raw_tx_hash, base::enum_transaction_subtype_recv);
+        xtxindex_detail_ptr_t recvindex = xrpc_loader_t::load_tx_indx_detail(raw_tx_hash, base::enum_transaction_subtype_recv, snapshot);
         if (recvindex != nullptr) {
             jv = xrpc_loader_t::parse_recv_tx(sendindex, recvindex);
             recvtx_status = recvindex->get_txaction().get_tx_exec_status();
@@ -135,12 +153,12 @@ xJson::Value xrpc_loader_t::load_and_parse_recv_tx(const std::string & raw_tx_ha
     return jv;
 }
 
-xJson::Value xrpc_loader_t::load_and_parse_confirm_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status recvtx_status) {
+xJson::Value xrpc_loader_t::load_and_parse_confirm_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status recvtx_status, const base::xvdbsnapshot_ptr_t & snapshot) {
     xJson::Value jv;
     if (sendindex->get_txaction().get_not_need_confirm()) {
         jv = xrpc_loader_t::parse_confirm_tx(sendindex, recvtx_status, nullptr);
     } else {
-        xtxindex_detail_ptr_t confirmindex = xrpc_loader_t::load_tx_indx_detail(raw_tx_hash, base::enum_transaction_subtype_confirm);
+        xtxindex_detail_ptr_t confirmindex = xrpc_loader_t::load_tx_indx_detail(raw_tx_hash, base::enum_transaction_subtype_confirm, snapshot);
         if (confirmindex != nullptr) {
             jv = xrpc_loader_t::parse_confirm_tx(sendindex, recvtx_status, confirmindex);
         }
@@ -3,6 +3,7 @@
 #include "json/json.h"
 #include "xvledger/xvtxindex.h"
 #include "xvledger/xvaction.h"
+#include "xvledger/xvdbstore.h"
 #include "xdata/xlightunit_info.h"
 #include "xdata/xtransaction.h"
 #include "xdata/xethreceipt.h"
@@ -33,15 +34,17 @@ using xtxindex_detail_ptr_t = std::shared_ptr<xtxindex_detail_t>;
 struct xtx_location_t;
 class xrpc_loader_t {
  public:
-    static  xtxindex_detail_ptr_t   load_tx_indx_detail(const std::string & raw_tx_hash,base::enum_transaction_subtype type);
+    // indexes of one query are read through the same snapshot so send/recv/confirm are seen at one point
+    static  xtxindex_detail_ptr_t   load_tx_indx_detail(const std::string & raw_tx_hash,base::enum_transaction_subtype type, const base::xvdbsnapshot_ptr_t & snapshot = nullptr);
  public:  // json transfer
     static  xJson::Value            parse_send_tx(const xtxindex_detail_ptr_t & txindex_detail);
-    static  xJson::Value            load_and_parse_recv_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status & recvtx_status);
-    static  xJson::Value            load_and_parse_confirm_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status recvtx_status);
+    static  xJson::Value            load_and_parse_recv_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status & recvtx_status, const base::xvdbsnapshot_ptr_t & snapshot = nullptr);
+    static  xJson::Value            load_and_parse_confirm_tx(const std::string & raw_tx_hash, const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status recvtx_status, const base::xvdbsnapshot_ptr_t & snapshot = nullptr);
  private:
     static  xJson::Value            parse_recv_tx(const xtxindex_detail_ptr_t & sendindex, const xtxindex_detail_ptr_t & recvindex);
     static  xJson::Value            parse_confirm_tx(const xtxindex_detail_ptr_t & sendindex, data::enum_xunit_tx_exec_status recvtx_status, const xtxindex_detail_ptr_t & confirmindex);
     static  void                    parse_common_info(const xtxindex_detail_ptr_t & txindex, xJson::Value & jv);
+    static  base::xauto_ptr<base::xvtxindex_t> load_tx_idx(const std::string & raw_tx_hash, base::enum_transaction_subtype type, const base::xvdbsnapshot_ptr_t & snapshot);
 
  public: // load ethdata
     static  xtxindex_detail_ptr_t   load_ethtx_indx_detail(const std::string & raw_tx_hash);
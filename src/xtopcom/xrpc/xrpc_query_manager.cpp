@@ -3,6 +3,7 @@
 #include "xbase/xcontext.h"
 #include "xbase/xint.h"
 #include "xbase/xutl.h"
+#include "xbasic/xhex.h"
 #include "xbasic/xutility.h"
 #include "xcodec/xmsgpack_codec.hpp"
 #include "xcommon/xip.h"
@@ -22,6 +23,7 @@
 #include "xdata/xelection/xelection_result_store.h"
 #include "xdata/xelection/xstandby_result_store.h"
 #include "xdata/xfull_tableblock.h"
+#include "xdata/xblockextract.h"
 #include "xdata/xgenesis_data.h"
 #include "xdata/xproposal_data.h"
 #include "xdata/xtable_bstate.h"
@@ -40,6 +42,8 @@
 #include "xmbus/xevent_behind.h"
 #include "xdata/xblocktool.h"
 #include "xstatestore/xstatestore_face.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
+#include "xstate_mpt/xstate_mpt_reader.h"
 
 #include <cstdint>
 #include <iostream>
@@ -55,6 +59,7 @@ using namespace base;
 using namespace store;
 using namespace xrpc;
 const std::string INVALID_ACCOUNT = "Invalid Account!";
+const uint32_t MAX_UNIT_STATE_PROOF_ACCOUNTS = 256;
 
 void xrpc_query_manager::call_method(std::string strMethod, xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode) {
     auto iter = m_query_method_map.find(strMethod);
@@ -63,6 +68,24 @@ void xrpc_query_manager::call_method(std::string strMethod, xJson::Value & js_re
     }
 }
 
+bool xrpc_query_manager::is_final_result(const std::string & method, const xJson::Value & js_req, const xJson::Value & js_rsp) const {
+    if (!js_rsp.isObject())
+        return false;
+    if (method == "getBlock") {
+        // blocks by height are loaded committed
+        return js_req["type"].asString() == "height" && js_rsp.isMember("value") && !js_rsp["value"].isNull();
+    }
+    if (method == "getUnitStateProofs") {
+        // proofs are against the state root of a committed table block
+        return js_rsp.isMember("value") && !js_rsp["value"].isNull();
+    }
+    if (method == "getTransaction") {
+        const std::string tx_state = js_rsp["tx_state"].asString();
+        return tx_state == "success" || tx_state == "fail";
+    }
+    return false;
+}
+
 bool xrpc_query_manager::handle(std::string & strReq, xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode) {
     std::string action = js_req["action"].asString();
     auto iter = m_query_method_map.find(action);
@@ -639,7 +662,9 @@ void xrpc_query_manager::update_tx_state(xJson::Value & result_json, const xJson
 
 int xrpc_query_manager::parse_tx(const uint256_t & tx_hash, xtransaction_t * cons_tx_ptr, const std::string & rpc_version, xJson::Value& result_json, std::string & strResult, uint32_t & nErrorCode) {
     std::string tx_hash_str = std::string(reinterpret_cast<char*>(tx_hash.data()), tx_hash.size());
-    xtxindex_detail_ptr_t sendindex = xrpc_loader_t::load_tx_indx_detail(tx_hash_str, base::enum_transaction_subtype_send);
+    // send/recv/confirm indexes come from one snapshot, a tx confirmed in between is not reported half done
+    base::xvdbsnapshot_ptr_t snapshot = base::xvchain_t::instance().get_xdbstore()->create_snapshot();
+    xtxindex_detail_ptr_t sendindex = xrpc_loader_t::load_tx_indx_detail(tx_hash_str, base::enum_transaction_subtype_send, snapshot);
     xJson::Value cons;
     if (sendindex != nullptr) {
         auto ori_tx_info = parse_tx(sendindex->get_raw_tx().get(), rpc_version);
@@ -653,9 +678,9 @@ int xrpc_query_manager::parse_tx(const uint256_t & tx_hash, xtransaction_t * con
         } else {
             cons[jk.m_send] = sendjson;
             data::enum_xunit_tx_exec_status recvtx_status;
-            cons[jk.m_recv] = xrpc_loader_t::load_and_parse_recv_tx(tx_hash_str, sendindex, recvtx_status);
+            cons[jk.m_recv] = xrpc_loader_t::load_and_parse_recv_tx(tx_hash_str, sendindex, recvtx_status, snapshot);
             if (cons[jk.m_recv]["height"].asUInt64() > 0) {  // only recv exist will load confirm
-                cons[jk.m_confirm] = xrpc_loader_t::load_and_parse_confirm_tx(tx_hash_str, sendindex, recvtx_status);
+                cons[jk.m_confirm] = xrpc_loader_t::load_and_parse_confirm_tx(tx_hash_str, sendindex, recvtx_status, snapshot);
             }
         }
         result_json["tx_consensus_state"] = cons;
@@ -818,7 +843,10 @@ void xrpc_query_manager::getTransaction(xJson::Value & js_req, xJson::Value & js
     std::shared_ptr<xtransaction_cache_data_t> cache_data_ptr = std::make_shared<xtransaction_cache_data_t>();
     if (m_txstore != nullptr && m_txstore->tx_cache_get(tx_hash_str, cache_data_ptr)) {
         const xrpc::xtx_exec_json_key jk(version);
-        std::map<int, xJson::Value> map_jv = cache_data_ptr->jv;
+        std::map<int, xJson::Value> map_jv;
+        for (auto & state : cache_data_ptr->states) {
+            map_jv[state.first] = state.second.to_json();
+        }
         if (map_jv.find(base::enum_transaction_subtype_send) == map_jv.end()) {
             xdbg("not find tx:%s", tx_hash_str.c_str());
 
@@ -2104,5 +2132,75 @@ void xrpc_query_manager::getLatestTables(xJson::Value & js_req, xJson::Value & j
     js_rsp = jv;
 }
 
+void xrpc_query_manager::getUnitStateProofs(xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode) {
+    std::string table = js_req["account_addr"].asString();
+    ADDRESS_CHECK_VALID(table)
+    base::xvaccount_t const table_vaccount{table};
+    xJson::Value const & accounts_json = js_req["accounts"];
+    if (!table_vaccount.is_table_address() || !accounts_json.isArray() || accounts_json.empty() || accounts_json.size() > MAX_UNIT_STATE_PROOF_ACCOUNTS) {
+        strResult = "table address or accounts is invalid";
+        nErrorCode = (uint32_t)enum_xrpc_error_code::rpc_param_param_error;
+        return;
+    }
+    std::vector<common::xaccount_address_t> accounts;
+    for (xJson::ArrayIndex i = 0; i < accounts_json.size(); ++i) {
+        std::string account = accounts_json[i].asString();
+        ADDRESS_CHECK_VALID(account)
+        if (base::xvaccount_t{account}.get_short_table_id() != table_vaccount.get_short_table_id()) {
+            strResult = "account " + account + " is not in table " + table;
+            nErrorCode = (uint32_t)enum_xrpc_error_code::rpc_param_param_error;
+            return;
+        }
+        accounts.push_back(common::xaccount_address_t{account});
+    }
+
+    uint64_t height = js_req["height"].asUInt64();
+    auto vblock = m_block_store->load_block_object(table_vaccount, height, base::enum_xvblock_flag_committed, true, metrics::blockstore_access_from_rpc_get_block_by_height);
+    if (vblock == nullptr) {
+        strResult = "table block not found";
+        nErrorCode = (uint32_t)enum_xrpc_error_code::rpc_shard_exec_error;
+        return;
+    }
+    xhash256_t const root = data::xblockextract_t::get_state_root_from_block(vblock.get());
+    if (root.empty()) {
+        strResult = "table block has no state root";
+        nErrorCode = (uint32_t)enum_xrpc_error_code::rpc_shard_exec_error;
+        return;
+    }
+
+    // all accounts are proven in one walk of the committed MPT, nodes shared by them are returned once
+    std::error_code ec;
+    auto const proof_db = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+    std::vector<base::xaccount_index_t> indexes;
+    auto reader = state_mpt::xstate_mpt_reader_t::create(common::xaccount_address_t{table}, root, base::xvchain_t::instance().get_xdbstore(), ec);
+    if (reader != nullptr) {
+        indexes = reader->prove_account_indexes(accounts, proof_db, ec);
+    }
+    if (ec) {
+        xwarn("xrpc_query_manager::getUnitStateProofs fail.table=%s,height=%llu,ec=%s", table.c_str(), height, ec.message().c_str());
+        strResult = "state of table block is not available";
+        nErrorCode = (uint32_t)enum_xrpc_error_code::rpc_shard_exec_error;
+        return;
+    }
+
+    xJson::Value jv;
+    jv["table_height"] = static_cast<xJson::UInt64>(height);
+    jv["state_root"] = top::to_hex_prefixed(root.to_bytes());
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        xJson::Value ja;
+        ja["account_addr"] = accounts[i].value();
+        ja["unit_height"] = static_cast<xJson::UInt64>(indexes[i].get_latest_unit_height());
+        ja["unit_hash"] = top::to_hex_prefixed(indexes[i].get_latest_unit_hash());
+        ja["state_hash"] = top::to_hex_prefixed(indexes[i].get_latest_state_hash());
+        jv["accounts"].append(ja);
+    }
+    // rlp encoded trie nodes, verifiers look them up by their keccak256 hash from state_root
+    jv["proof"] = xJson::Value(xJson::arrayValue);
+    for (auto const & node : proof_db->data()) {
+        jv["proof"].append(top::to_hex_prefixed(node.second));
+    }
+    js_rsp["value"] = jv;
+}
+
 }  // namespace chain_info
 }  // namespace top
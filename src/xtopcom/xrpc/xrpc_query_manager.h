@@ -107,10 +107,13 @@ public:
         REGISTER_QUERY_METHOD(queryVoterDividend);
         REGISTER_QUERY_METHOD(queryProposal);
         REGISTER_QUERY_METHOD(getLatestTables);
+        REGISTER_QUERY_METHOD(getUnitStateProofs);
         REGISTER_QUERY_METHOD(getChainId);
     }
     void call_method(std::string strMethod, xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode);
     bool handle(std::string & strReq, xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode) override;
+    // whether the data returned by method is on committed blocks and never changes
+    bool is_final_result(const std::string & method, const xJson::Value & js_req, const xJson::Value & js_rsp) const;
     xJson::Value get_block_json(data::xblock_t * bp, const std::string & rpc_version = data::RPC_VERSION_V2);
     xJson::Value get_blocks_json(data::xblock_t * bp, const std::string & rpc_version = data::RPC_VERSION_V2);
     //void query_account_property_base(xJson::Value & jph, const std::string & owner, const std::string & prop_name, top::data::xunitstate_ptr_t unitstate, bool compatible_mode);
@@ -201,6 +204,8 @@ private:
     void queryVoterDividend(xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode);
     void queryProposal(xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode);
     void getLatestTables(xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode);
+    // index of many units at one table height with one merkle proof against the table state root
+    void getUnitStateProofs(xJson::Value & js_req, xJson::Value & js_rsp, std::string & strResult, uint32_t & nErrorCode);
 
 
 
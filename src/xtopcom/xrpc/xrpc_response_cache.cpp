@@ -0,0 +1,145 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xrpc_response_cache.h"
+
+#include "xbase/xlog.h"
+#include "xbase/xutl.h"
+#include "xchain_fork/xchain_upgrade_center.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
+#include "xdata/xnative_contract_address.h"
+#include "xmetrics/xmetrics.h"
+#include "xvledger/xvchain.h"
+
+namespace top {
+namespace xrpc {
+
+xrpc_response_cache_t & xrpc_response_cache_t::instance() {
+    static xrpc_response_cache_t _instance;
+    return _instance;
+}
+
+std::string xrpc_response_cache_t::make_key(const std::string & method, const xJson::Value & params) {
+    xJson::FastWriter writer;
+    return method + "\n" + writer.write(params);
+}
+
+bool xrpc_response_cache_t::splice(std::string & response, const std::string & field, const std::string & result) {
+    // string values are escaped, so the pattern can only be the member itself
+    std::string pattern = "\"" + field + "\":null";
+    auto pos = response.rfind(pattern);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    response.replace(pos + field.size() + 3, 4, result);
+    return true;
+}
+
+bool xrpc_response_cache_t::get(const std::string & key, std::string & result) {
+    if (XGET_CONFIG(rpc_response_cache_bytes) == 0) {
+        return false;
+    }
+    check_fork();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        XMETRICS_COUNTER_INCREMENT("rpc_response_cache_miss", 1);
+        return false;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    result = it->second->second;
+    XMETRICS_COUNTER_INCREMENT("rpc_response_cache_hit", 1);
+    return true;
+}
+
+void xrpc_response_cache_t::put(const std::string & key, const xJson::Value & result) {
+    if (XGET_CONFIG(rpc_response_cache_bytes) == 0) {
+        return;
+    }
+
+    xJson::FastWriter writer;
+    std::string value = writer.write(result);
+    if (!value.empty() && value.back() == '\n') {
+        value.pop_back();
+    }
+    put(key, std::move(value));
+}
+
+void xrpc_response_cache_t::put(const std::string & key, std::string result) {
+    if (XGET_CONFIG(rpc_response_cache_bytes) == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_index.find(key) != m_index.end()) {
+        return;
+    }
+    m_entries.emplace_front(key, std::move(result));
+    m_index[key] = m_entries.begin();
+    m_bytes += m_entries.front().first.size() + m_entries.front().second.size();
+    evict();
+}
+
+void xrpc_response_cache_t::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+void xrpc_response_cache_t::evict() {
+    uint64_t max_bytes = XGET_CONFIG(rpc_response_cache_bytes);
+    while (m_bytes > max_bytes && !m_entries.empty()) {
+        auto & entry = m_entries.back();
+        m_bytes -= entry.first.size() + entry.second.size();
+        m_index.erase(entry.first);
+        m_entries.pop_back();
+    }
+}
+
+void xrpc_response_cache_t::check_fork() {
+    int64_t now = base::xtime_utl::time_now_ms();
+    int64_t last = m_last_fork_check_ms.load(std::memory_order_relaxed);
+    if (now - last < fork_check_interval_ms || !m_last_fork_check_ms.compare_exchange_strong(last, now)) {
+        return;
+    }
+
+    auto blockstore = base::xvchain_t::instance().get_xblockstore();
+    if (blockstore == nullptr) {
+        return;
+    }
+    uint64_t clock = blockstore->get_latest_cert_block_height(base::xvaccount_t(sys_contract_beacon_timer_addr));
+
+    auto const & fork_config = chain_fork::xchain_fork_config_center_t::chain_fork_config();
+    uint32_t fork_count = 0;
+    for (auto const & fork_point : {fork_config.block_fork_point,
+                                    fork_config.V3_0_0_0_block_fork_point,
+                                    fork_config.tx_v2_fee_fork_point,
+                                    fork_config.partly_remove_confirm,
+                                    fork_config.add_rsp_id,
+                                    fork_config.inner_table_tx,
+                                    fork_config.eth_fork_point,
+                                    fork_config.relay_fork_point,
+                                    fork_config.v1_6_0_version_point,
+                                    fork_config.v1_7_0_block_fork_point,
+                                    fork_config.v1_7_0_sync_point}) {
+        if (chain_fork::xchain_fork_config_center_t::is_forked(fork_point, clock)) {
+            fork_count++;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (fork_count != m_fork_count) {
+        xinfo("xrpc_response_cache_t::check_fork,fork points passed:%u,clear %zu entries", fork_count, m_entries.size());
+        m_fork_count = fork_count;
+        m_entries.clear();
+        m_index.clear();
+        m_bytes = 0;
+    }
+}
+
+}  // namespace xrpc
+}  // namespace top
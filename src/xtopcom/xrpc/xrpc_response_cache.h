@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "json/json.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace top {
+namespace xrpc {
+
+// serialized results of queries on finalized data (old blocks, committed transactions), keyed by
+// method and canonical params. the results never change, so entries are only evicted by the byte
+// budget and dropped all together when the chain passes a fork point, which may change the format.
+class xrpc_response_cache_t {
+public:
+    static xrpc_response_cache_t & instance();
+
+    // params are written with sorted keys, so equal params give the same key
+    static std::string make_key(const std::string & method, const xJson::Value & params);
+    // replace the null field of a serialized response by the cached result
+    static bool splice(std::string & response, const std::string & field, const std::string & result);
+
+    bool get(const std::string & key, std::string & result);
+    void put(const std::string & key, const xJson::Value & result);
+    void put(const std::string & key, std::string result);
+    void clear();
+
+private:
+    xrpc_response_cache_t() = default;
+
+    void check_fork();
+    void evict();
+
+    static constexpr int64_t fork_check_interval_ms = 1000;
+
+    std::mutex m_mutex;
+    std::list<std::pair<std::string, std::string>> m_entries;  // most recent first
+    std::unordered_map<std::string, std::list<std::pair<std::string, std::string>>::iterator> m_index;
+    uint64_t m_bytes{0};
+    uint32_t m_fork_count{0};
+    std::atomic<int64_t> m_last_fork_check_ms{0};
+};
+
+}  // namespace xrpc
+}  // namespace top
@@ -0,0 +1,56 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xrpc_statectx_pool.h"
+
+#include "xmetrics/xmetrics.h"
+
+namespace top {
+namespace xrpc {
+
+statectx::xstatectx_ptr_t xrpc_statectx_pool_t::acquire(const base::xvaccount_t & table_addr, base::xvblock_t * block) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_blocks.find(block->get_height());
+        if (it != m_blocks.end() && it->second.block_hash == block->get_block_hash() && !it->second.contexts.empty()) {
+            statectx::xstatectx_ptr_t statectx_ptr = it->second.contexts.back();
+            it->second.contexts.pop_back();
+            XMETRICS_COUNTER_INCREMENT("rpc_statectx_reuse", 1);
+            return statectx_ptr;
+        }
+    }
+    return statectx::xstatectx_factory_t::create_statectx(table_addr, block);
+}
+
+void xrpc_statectx_pool_t::release(base::xvblock_t * block, statectx::xstatectx_ptr_t const & statectx_ptr) {
+    if (statectx_ptr == nullptr || !statectx_ptr->do_rollback()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto & entry = m_blocks[block->get_height()];
+    if (entry.block_hash != block->get_block_hash()) {
+        // a cert block replaced at the same height
+        entry.block_hash = block->get_block_hash();
+        entry.contexts.clear();
+    }
+    if (entry.contexts.size() < max_contexts_per_block) {
+        entry.contexts.push_back(statectx_ptr);
+    }
+    while (m_blocks.size() > max_blocks) {
+        m_blocks.erase(m_blocks.begin());
+    }
+}
+
+size_t xrpc_statectx_pool_t::idle_size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t size = 0;
+    for (auto & it : m_blocks) {
+        size += it.second.contexts.size();
+    }
+    return size;
+}
+
+}  // namespace xrpc
+}  // namespace top
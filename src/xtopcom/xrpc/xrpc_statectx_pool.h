@@ -0,0 +1,48 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xstatectx/xstatectx.h"
+#include "xvledger/xvblock.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace top {
+namespace xrpc {
+
+// state contexts of eth_call and eth_estimateGas, kept by block so the next call on the same block
+// starts with the unit states already loaded. a context is used by one call at a time and rolled
+// back to the block state when it is given back, so no call sees the writes of another.
+class xrpc_statectx_pool_t {
+public:
+    static constexpr size_t max_blocks = 2;
+    static constexpr size_t max_contexts_per_block = 8;
+
+    xrpc_statectx_pool_t() = default;
+    xrpc_statectx_pool_t(const xrpc_statectx_pool_t &) = delete;
+    xrpc_statectx_pool_t & operator=(const xrpc_statectx_pool_t &) = delete;
+
+    // an idle context of block, or a new one. nullptr if it can not be created
+    statectx::xstatectx_ptr_t acquire(const base::xvaccount_t & table_addr, base::xvblock_t * block);
+    // roll back the writes of the call and keep the context for the next call on block
+    void release(base::xvblock_t * block, statectx::xstatectx_ptr_t const & statectx_ptr);
+
+    size_t idle_size() const;
+
+private:
+    struct xblock_contexts_t {
+        std::string block_hash;
+        std::vector<statectx::xstatectx_ptr_t> contexts;
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<uint64_t, xblock_contexts_t> m_blocks;  // by height, at most max_blocks
+};
+
+}  // namespace xrpc
+}  // namespace top
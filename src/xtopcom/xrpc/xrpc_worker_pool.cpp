@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xrpc_worker_pool.h"
+
+#include "xbase/xlog.h"
+#include "xbasic/xmemory.hpp"
+#include "xbasic/xthreading/xthread_name.h"
+
+NS_BEG2(top, xrpc)
+
+xrpc_worker_pool::~xrpc_worker_pool() {
+    stop();
+}
+
+void xrpc_worker_pool::start(uint32_t thread_num) {
+    if (!m_threads.empty() || thread_num == 0) {
+        return;
+    }
+    m_work = top::make_unique<asio::io_service::work>(m_io_service);
+    for (uint32_t i = 0; i < thread_num; ++i) {
+        m_threads.emplace_back([this, i]() {
+            threading::set_current_thread_name("rpc_worker" + std::to_string(i));
+            for (;;) {
+                try {
+                    m_io_service.run();
+                    break;
+                } catch (const std::exception & e) {
+                    xerror("rpc worker exception:%s", e.what());
+                }
+            }
+        });
+    }
+    xinfo("rpc worker pool started, threads:%u", thread_num);
+}
+
+void xrpc_worker_pool::stop() {
+    if (m_threads.empty()) {
+        return;
+    }
+    m_work = nullptr;
+    m_io_service.stop();
+    for (auto & t : m_threads) {
+        // stopped by one of its own tasks, e.g. releasing the last owner of the pool
+        if (t.get_id() == std::this_thread::get_id()) {
+            t.detach();
+        } else if (t.joinable()) {
+            t.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void xrpc_worker_pool::post(std::function<void()> task) {
+    if (m_threads.empty()) {
+        task();
+        return;
+    }
+    m_io_service.post(std::move(task));
+}
+
+NS_END2
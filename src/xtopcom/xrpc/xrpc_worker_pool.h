@@ -0,0 +1,39 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xbasic/xasio_config.h"
+
+#include <asio/io_service.hpp>
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+NS_BEG2(top, xrpc)
+
+// threads running the rpc requests, so the socket threads of a server only read and write.
+// a pool without threads runs the requests in the calling thread.
+class xrpc_worker_pool {
+public:
+    xrpc_worker_pool() = default;
+    xrpc_worker_pool(const xrpc_worker_pool &) = delete;
+    xrpc_worker_pool & operator=(const xrpc_worker_pool &) = delete;
+    ~xrpc_worker_pool();
+
+    void start(uint32_t thread_num);
+    void stop();
+    void post(std::function<void()> task);
+    uint32_t thread_num() const { return m_threads.size(); }
+
+private:
+    asio::io_service                          m_io_service;
+    std::unique_ptr<asio::io_service::work>   m_work{nullptr};
+    std::vector<std::thread>                  m_threads;
+};
+
+NS_END2
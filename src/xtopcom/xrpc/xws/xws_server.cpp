@@ -5,9 +5,11 @@
 #include "xrpc/xws/xws_server.h"
 
 #include "xbasic/xmemory.hpp"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xmetrics/xmetrics.h"
 #include "xrpc/xratelimit/xratelimit_data.h"
 #include "xrpc/xratelimit/xratelimit_data_queue.h"
+#include "xrpc/xws/xws_subscription.h"
 
 NS_BEG2(top, xrpc)
 using namespace top::xChainRPC;
@@ -15,6 +17,7 @@ using namespace top::xChainRPC;
 WsServer xws_server::m_server;
 unique_ptr<xrpc_service<xedge_ws_method>> xws_server::m_rpc_service = nullptr;
 bool xws_server::m_is_running = false;
+xrpc_worker_pool xws_server::m_worker_pool;
 
 xws_server::xws_server(shared_ptr<xrpc_edge_vhost> edge_vhost,
                        common::xip2_t xip2,
@@ -32,7 +35,7 @@ xws_server::xws_server(shared_ptr<xrpc_edge_vhost> edge_vhost,
         m_rpc_service->reset_edge_method_mgr(edge_vhost, xip2);
     }
 }
-void xws_server::start(uint16_t nPort, uint32_t nThreadNum) {
+void xws_server::start(uint16_t nPort, uint32_t nThreadNum, uint32_t nWorkerNum) {
     if (m_is_running) {
         xdbg("rpc_service ws_server already started");
         return;
@@ -40,6 +43,7 @@ void xws_server::start(uint16_t nPort, uint32_t nThreadNum) {
     m_is_running = true;
     m_server.config.port = nPort;
     m_server.config.thread_pool_size = nThreadNum;
+    m_worker_pool.start(nWorkerNum);
 
     auto & service = m_server.endpoint["/"];
     service.on_message = std::bind(&xws_server::start_service, this, _1, _2);
@@ -52,16 +56,21 @@ void xws_server::start(uint16_t nPort, uint32_t nThreadNum) {
     // See RFC 6455 7.4.1. for status codes
     service.on_close = [](shared_ptr<WsServer::Connection> connection, int status, const string & /*reason*/) {
         XMETRICS_COUNTER_INCREMENT("rpc_ws_close", 1);
+        xws_subscription_mgr_t::instance().remove(connection.get());
         xinfo_rpc("Server: Closed connection %p with status code %d", connection.get(), status);
     };
 
     service.on_error = [](shared_ptr<WsServer::Connection> connection, const SimpleWeb::error_code & ec) {
         xinfo_rpc("Server: Error in connection %p.Error:%d,error message: %s", connection.get(), ec, ec.message().c_str());
+        xws_subscription_mgr_t::instance().remove(connection.get());
     };
 
+    xws_subscription_mgr_t::instance().start();
+
     m_server.io_service = m_rpc_service->m_io_service;
     auto self = shared_from_this();
     m_server_thread = std::thread([self]() {
+        threading::set_current_thread_name("rpc_ws");
         // Start server
         self->m_server.start();
     });
@@ -83,8 +92,10 @@ void xws_server::start(uint16_t nPort, uint32_t nThreadNum) {
             asio::ip::address_v4 addr_v4(dynamic_cast<RatelimitDataWs *>(data)->ip_);
             asio::ip::address addr(addr_v4);
             auto ip_s = addr.to_string();
-            m_rpc_service->execute(dynamic_cast<RatelimitDataWs *>(data)->connection_, dynamic_cast<RatelimitDataWs *>(data)->content_, ip_s);
+            auto connection = dynamic_cast<RatelimitDataWs *>(data)->connection_;
+            auto content = std::move(dynamic_cast<RatelimitDataWs *>(data)->content_);
             delete data;
+            m_worker_pool.post([connection, content, ip_s]() mutable { m_rpc_service->execute(connection, content, ip_s); });
         });
         m_ratelimit->RegistResponseOut([self](RatelimitData * data) {
             if (data == nullptr) {
@@ -109,6 +120,18 @@ void xws_server::start(uint16_t nPort, uint32_t nThreadNum) {
 void xws_server::start_service(shared_ptr<WsServer::Connection> connection, shared_ptr<WsServer::InMessage> in_message) {
     auto content = in_message->string();
     XMETRICS_COUNTER_INCREMENT("rpc_ws_request", 1);
+    if (xws_subscription_mgr_t::is_subscription_request(content)) {
+        // the connection is held by the subscriptions until it is closed
+        std::weak_ptr<WsServer::Connection> weak_connection = connection;
+        auto send = [weak_connection](const std::string & message) {
+            auto conn = weak_connection.lock();
+            if (conn != nullptr) {
+                conn->send(message);
+            }
+        };
+        connection->send(xws_subscription_mgr_t::instance().handle_request(connection.get(), send, content));
+        return;
+    }
     asio::ip::address addr = connection->remote_endpoint.address();
     if (m_enable_ratelimit) {
         // get ip
@@ -131,7 +154,7 @@ void xws_server::start_service(shared_ptr<WsServer::Connection> connection, shar
     } else {
         // ipv4 expressed in ipv6 format: ::ffff:192.168.20.9
         auto ip_s = addr.to_string().substr(7);
-        m_rpc_service->execute(connection, content, ip_s);
+        m_worker_pool.post([connection, content, ip_s]() mutable { m_rpc_service->execute(connection, content, ip_s); });
     }
 }
 
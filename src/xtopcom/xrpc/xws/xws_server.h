@@ -18,6 +18,7 @@
 #include "xrpc/xedge/xedge_method_manager.hpp"
 #include "xrpc/xhttp/xrpc_service.hpp"
 #include "xrpc/xratelimit/xratelimit_server.h"
+#include "xrpc/xrpc_worker_pool.h"
 #include "xrpc/prerequest/xpre_request_handler_server.h"
 
 NS_BEG2(top, xrpc)
@@ -34,7 +35,8 @@ public:
                observer_ptr<base::xvtxstore_t> txstore = nullptr,
                observer_ptr<elect::ElectMain> elect_main = nullptr,
                observer_ptr<top::election::cache::xdata_accessor_face_t> const & election_cache_data_accessor = nullptr);
-    void start(uint16_t nPort, uint32_t nThreadNum = 1);
+    // nThreadNum threads read and write the sockets, nWorkerNum threads run the requests
+    void start(uint16_t nPort, uint32_t nThreadNum = 1, uint32_t nWorkerNum = 0);
     void start_service(shared_ptr<WsServer::Connection> connection, shared_ptr<WsServer::InMessage> in_message);
     ~xws_server();
     xedge_ws_method* get_edge_method();
@@ -42,6 +44,7 @@ private:
     static WsServer                                     m_server;
     static unique_ptr<xrpc_service<xedge_ws_method>>    m_rpc_service;
     static bool                                         m_is_running;
+    static xrpc_worker_pool                             m_worker_pool;
     thread                                          m_server_thread;
     RatelimitConfig                                 m_config;
     unique_ptr<RatelimitServer>                     m_ratelimit{ nullptr };
@@ -0,0 +1,302 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xrpc/xws/xws_subscription.h"
+
+#include <algorithm>
+
+#include "xdata/xblockextract.h"
+#include "xdata/xnative_contract_address.h"
+#include "xmbus/xevent_store.h"
+#include "xmetrics/xmetrics.h"
+#include "xrpc/xrpc_eth_parser.h"
+#include "xrpc/xrpc_eth_query_manager.h"
+#include "xvledger/xvledger.h"
+
+NS_BEG2(top, xrpc)
+
+xws_subscription_mgr_t & xws_subscription_mgr_t::instance() {
+    static xws_subscription_mgr_t mgr;
+    return mgr;
+}
+
+xws_subscription_mgr_t::~xws_subscription_mgr_t() {
+    stop();
+}
+
+void xws_subscription_mgr_t::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_started) {
+        return;
+    }
+    auto mbus = (mbus::xmessage_bus_t *)base::xvchain_t::instance().get_xevmbus();
+    if (mbus == nullptr) {
+        xwarn("xws_subscription_mgr_t::start no message bus");
+        return;
+    }
+    // one thread, so the notifications keep the block order
+    m_worker_pool.start(1);
+    m_listener_id = mbus->add_listener(mbus::xevent_major_type_store, std::bind(&xws_subscription_mgr_t::on_event, this, std::placeholders::_1));
+    m_started = true;
+}
+
+void xws_subscription_mgr_t::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_started) {
+            return;
+        }
+        auto mbus = (mbus::xmessage_bus_t *)base::xvchain_t::instance().get_xevmbus();
+        if (mbus != nullptr) {
+            mbus->remove_listener(mbus::xevent_major_type_store, m_listener_id);
+        }
+        m_started = false;
+    }
+    m_worker_pool.stop();
+}
+
+bool xws_subscription_mgr_t::is_subscription_request(const std::string & content) {
+    return content.find("eth_subscribe") != std::string::npos || content.find("eth_unsubscribe") != std::string::npos;
+}
+
+std::string xws_subscription_mgr_t::handle_request(const void * connection, send_func send, const std::string & content) {
+    xJson::Value js_req;
+    xJson::Value js_rsp;
+    xJson::Reader reader;
+    js_rsp["jsonrpc"] = "2.0";
+    if (!reader.parse(content, js_req) || !js_req.isObject()) {
+        js_rsp["id"] = xJson::Value::null;
+        eth::EthErrorCode::deal_error(js_rsp, eth::enum_eth_rpc_parse_error, "parse error");
+        return xJson::FastWriter().write(js_rsp);
+    }
+
+    js_rsp["id"] = js_req["id"];
+    const xJson::Value & params = js_req["params"];
+    const std::string method = js_req["method"].asString();
+    if (method == "eth_subscribe") {
+        std::string error;
+        std::string id = subscribe(connection, std::move(send), params, error);
+        if (id.empty()) {
+            eth::EthErrorCode::deal_error(js_rsp, eth::enum_eth_rpc_invalid_params, error);
+        } else {
+            js_rsp["result"] = id;
+        }
+    } else if (method == "eth_unsubscribe" && params.isArray() && params.size() == 1 && params[0].isString()) {
+        js_rsp["result"] = unsubscribe(connection, params[0].asString());
+    } else {
+        eth::EthErrorCode::deal_error(js_rsp, eth::enum_eth_rpc_invalid_params, "invalid argument");
+    }
+    return xJson::FastWriter().write(js_rsp);
+}
+
+std::string xws_subscription_mgr_t::subscribe(const void * connection, send_func send, const xJson::Value & params, std::string & error) {
+    if (!params.isArray() || params.size() == 0 || params.size() > 2 || !params[0].isString()) {
+        error = "invalid argument";
+        return std::string();
+    }
+
+    auto sub = std::make_shared<subscriber_t>();
+    sub->connection = connection;
+    sub->send = std::move(send);
+    const std::string type = params[0].asString();
+    if (type == "newHeads") {
+        sub->type = enum_ws_subscription_new_heads;
+    } else if (type == "newPendingTransactions") {
+        sub->type = enum_ws_subscription_pending_transactions;
+    } else if (type == "logs") {
+        sub->type = enum_ws_subscription_logs;
+        if (params.size() == 2 && !params[1].isNull()) {
+            const xJson::Value & filter = params[1];
+            xJson::Value js_rsp;
+            if (!filter.isObject()
+                || (filter.isMember("address") && xrpc_eth_query_manager::parse_addresses(filter["address"], sub->addresses, js_rsp) != 0)
+                || (filter.isMember("topics") && xrpc_eth_query_manager::parse_topics(filter["topics"], sub->topics, js_rsp) != 0)) {
+                error = js_rsp["error"]["message"].asString();
+                if (error.empty()) {
+                    error = "invalid filter";
+                }
+                return std::string();
+            }
+        }
+    } else {
+        error = "unsupported subscription type " + type;
+        return std::string();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t & count = m_connection_count[connection];
+    if (count >= max_subscriptions_per_connection) {
+        error = "too many subscriptions";
+        return std::string();
+    }
+    count++;
+    char id[32] = {0};
+    snprintf(id, sizeof(id), "0x%lx", m_next_id++);
+    sub->id = id;
+    m_subscribers[sub->id] = sub;
+    XMETRICS_COUNTER_INCREMENT("rpc_ws_subscription", 1);
+    xdbg("xws_subscription_mgr_t::subscribe %s, type %s, connection %p", id, type.c_str(), connection);
+    return sub->id;
+}
+
+bool xws_subscription_mgr_t::unsubscribe(const void * connection, const std::string & id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_subscribers.find(id);
+    if (it == m_subscribers.end() || it->second->connection != connection) {
+        return false;
+    }
+    m_subscribers.erase(it);
+    if (--m_connection_count[connection] == 0) {
+        m_connection_count.erase(connection);
+    }
+    XMETRICS_COUNTER_INCREMENT("rpc_ws_subscription", -1);
+    return true;
+}
+
+void xws_subscription_mgr_t::remove(const void * connection) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto count_it = m_connection_count.find(connection);
+    if (count_it == m_connection_count.end()) {
+        return;
+    }
+    XMETRICS_COUNTER_INCREMENT("rpc_ws_subscription", -(int64_t)count_it->second);
+    m_connection_count.erase(count_it);
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end();) {
+        if (it->second->connection == connection) {
+            it = m_subscribers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t xws_subscription_mgr_t::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_subscribers.size();
+}
+
+std::vector<xws_subscription_mgr_t::subscriber_ptr_t> xws_subscription_mgr_t::subscribers(enum_ws_subscription_type type) const {
+    std::vector<subscriber_ptr_t> result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto & it : m_subscribers) {
+        if (it.second->type == type) {
+            result.push_back(it.second);
+        }
+    }
+    return result;
+}
+
+std::string xws_subscription_mgr_t::notification(const std::string & id, const std::string & result) {
+    // result is already encoded, only the envelope is written for each subscriber
+    std::string message;
+    message.reserve(result.size() + id.size() + 96);
+    message += "{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"result\":";
+    message += result;
+    message += ",\"subscription\":\"";
+    message += id;
+    message += "\"}}";
+    return message;
+}
+
+void xws_subscription_mgr_t::on_event(mbus::xevent_ptr_t const & e) {
+    if (e->minor_type != mbus::xevent_store_t::type_block_committed) {
+        return;
+    }
+    mbus::xevent_store_block_committed_ptr_t block_event = dynamic_xobject_ptr_cast<mbus::xevent_store_block_committed_t>(e);
+    if (block_event == nullptr || block_event->owner != sys_contract_eth_table_block_addr_with_suffix) {
+        return;
+    }
+
+    uint64_t height = block_event->blk_height;
+    m_worker_pool.post([this, height]() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // blocks synced from behind are history, not news
+            if (height <= m_last_height || m_subscribers.empty()) {
+                m_last_height = std::max(m_last_height, height);
+                return;
+            }
+            m_last_height = height;
+        }
+        base::xvaccount_t table_addr(sys_contract_eth_table_block_addr_with_suffix);
+        xobject_ptr_t<base::xvblock_t> block =
+            base::xvchain_t::instance().get_xblockstore()->load_block_object(table_addr, height, base::enum_xvblock_flag_committed, false);
+        if (block == nullptr) {
+            xwarn("xws_subscription_mgr_t::on_event load block fail, height %lu", height);
+            return;
+        }
+        on_block(block.get());
+    });
+}
+
+void xws_subscription_mgr_t::on_block(base::xvblock_t * block) {
+    auto heads_subscribers = subscribers(enum_ws_subscription_new_heads);
+    if (!heads_subscribers.empty()) {
+        xJson::Value js_header;
+        std::error_code ec;
+        xrpc_eth_parser_t::blockheader_to_json(block, js_header, ec);
+        if (!ec) {
+            // a header, not a block
+            js_header.removeMember("transactions");
+            js_header.removeMember("uncles");
+            js_header.removeMember("size");
+            js_header.removeMember("totalDifficulty");
+            std::string result = xJson::FastWriter().write(js_header);
+            result.pop_back();  // '\n' of FastWriter
+            for (auto & sub : heads_subscribers) {
+                sub->send(notification(sub->id, result));
+            }
+            XMETRICS_COUNTER_INCREMENT("rpc_ws_notification", heads_subscribers.size());
+        }
+    }
+
+    auto logs_subscribers = subscribers(enum_ws_subscription_logs);
+    if (logs_subscribers.empty()) {
+        return;
+    }
+    std::string block_hash = top::to_hex_prefixed(block->get_block_hash());
+    std::string block_num = xrpc_eth_parser_t::uint64_to_hex_prefixed(block->get_height());
+    auto input_actions = data::xblockextract_t::unpack_eth_txactions(block);
+    for (uint64_t txindex = 0; txindex < (uint64_t)input_actions.size(); txindex++) {
+        auto & action = input_actions[txindex];
+        data::xeth_store_receipt_t evm_tx_receipt;
+        if (!action.get_evm_transaction_receipt(evm_tx_receipt) || evm_tx_receipt.get_logs().empty()) {
+            continue;
+        }
+
+        xlog_location_t loglocation(block_hash, block_num, top::to_hex_prefixed(action.get_org_tx_hash()), xrpc_eth_parser_t::uint64_to_hex_prefixed(txindex));
+        for (uint64_t logindex = 0; logindex < (uint64_t)evm_tx_receipt.get_logs().size(); logindex++) {
+            auto & log = evm_tx_receipt.get_logs()[logindex];
+            std::string result;
+            for (auto & sub : logs_subscribers) {
+                if (!xrpc_eth_query_manager::check_log_is_match(log, sub->topics, sub->addresses)) {
+                    continue;
+                }
+                if (result.empty()) {
+                    loglocation.m_log_index = xrpc_eth_parser_t::uint64_to_hex_prefixed(logindex);
+                    xJson::Value js_log;
+                    xrpc_eth_parser_t::log_to_json(loglocation, log, js_log);
+                    result = xJson::FastWriter().write(js_log);
+                    result.pop_back();
+                }
+                sub->send(notification(sub->id, result));
+                XMETRICS_COUNTER_INCREMENT("rpc_ws_notification", 1);
+            }
+        }
+    }
+}
+
+void xws_subscription_mgr_t::on_pending_transaction(const std::string & tx_hash) {
+    auto pending_subscribers = subscribers(enum_ws_subscription_pending_transactions);
+    if (pending_subscribers.empty()) {
+        return;
+    }
+    std::string result = "\"" + tx_hash + "\"";
+    for (auto & sub : pending_subscribers) {
+        sub->send(notification(sub->id, result));
+    }
+    XMETRICS_COUNTER_INCREMENT("rpc_ws_notification", pending_subscribers.size());
+}
+
+NS_END2
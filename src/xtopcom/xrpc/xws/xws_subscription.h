@@ -0,0 +1,90 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "json/json.h"
+#include "xbase/xns_macro.h"
+#include "xbase/xobject.h"
+#include "xmbus/xmessage_bus.h"
+#include "xrpc/xrpc_worker_pool.h"
+#include "xvledger/xvblock.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+NS_BEG2(top, xrpc)
+
+enum enum_ws_subscription_type {
+    enum_ws_subscription_new_heads,
+    enum_ws_subscription_logs,
+    enum_ws_subscription_pending_transactions,
+};
+
+// eth_subscribe of the websocket clients. committed blocks of the eth table are encoded once
+// and the same notification is sent to every matching subscriber, instead of each client polling.
+class xws_subscription_mgr_t {
+public:
+    using send_func = std::function<void(const std::string & message)>;
+
+    static constexpr uint32_t max_subscriptions_per_connection = 64;
+
+    static xws_subscription_mgr_t & instance();
+
+    xws_subscription_mgr_t() = default;
+    xws_subscription_mgr_t(const xws_subscription_mgr_t &) = delete;
+    xws_subscription_mgr_t & operator=(const xws_subscription_mgr_t &) = delete;
+    ~xws_subscription_mgr_t();
+
+    // listen to the committed blocks, more calls do nothing
+    void start();
+    void stop();
+
+    // whether the message may be an eth_subscribe or eth_unsubscribe request, without parsing it
+    static bool is_subscription_request(const std::string & content);
+    // handle a eth_subscribe or eth_unsubscribe request of connection, return the response
+    std::string handle_request(const void * connection, send_func send, const std::string & content);
+
+    // params are [type, filter], return the subscription id, or empty with error set
+    std::string subscribe(const void * connection, send_func send, const xJson::Value & params, std::string & error);
+    bool unsubscribe(const void * connection, const std::string & id);
+    // the connection is closed
+    void remove(const void * connection);
+
+    void on_block(base::xvblock_t * block);
+    void on_pending_transaction(const std::string & tx_hash);
+
+    size_t size() const;
+
+private:
+    struct subscriber_t {
+        const void * connection{nullptr};
+        std::string id;
+        enum_ws_subscription_type type{enum_ws_subscription_new_heads};
+        std::vector<std::set<std::string>> topics;
+        std::set<std::string> addresses;
+        send_func send;
+    };
+    using subscriber_ptr_t = std::shared_ptr<subscriber_t>;
+
+    void on_event(mbus::xevent_ptr_t const & e);
+    std::vector<subscriber_ptr_t> subscribers(enum_ws_subscription_type type) const;
+    static std::string notification(const std::string & id, const std::string & result);
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, subscriber_ptr_t> m_subscribers;
+    std::map<const void *, uint32_t> m_connection_count;
+    uint64_t m_next_id{1};
+    uint64_t m_last_height{0};
+    uint32_t m_listener_id{0};
+    bool m_started{false};
+    xrpc_worker_pool m_worker_pool;
+};
+
+NS_END2
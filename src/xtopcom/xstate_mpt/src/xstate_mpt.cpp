@@ -8,8 +8,12 @@
 #include "xevm_common/trie/xtrie_kv_db.h"
 #include "xmetrics/xmetrics.h"
 #include "xstate_mpt/xerror.h"
+#include "xstate_mpt/xstate_mpt_reader.h"
 #include "xstate_mpt/xstate_mpt_store.h"
 
+#include <map>
+#include <mutex>
+
 namespace top {
 namespace state_mpt {
 
@@ -31,6 +35,22 @@ void xaccount_info_t::decode(const std::string & str) {
     return;
 }
 
+// a state mpt is created for each table block, so clean trie nodes are cached per table rather
+// than per mpt, otherwise each block execution starts with a cold cache.
+// node keys on disk are prefixed by table, sharing the cache across tables is not safe for existence checks.
+evm_common::trie::xtrie_clean_cache_ptr_t table_clean_cache(common::xaccount_address_t const & table) {
+    constexpr std::size_t table_clean_cache_size = 8 * 1024 * 1024;
+    static std::mutex caches_mutex;
+    static std::map<std::string, evm_common::trie::xtrie_clean_cache_ptr_t> caches;
+
+    std::lock_guard<std::mutex> lock{caches_mutex};
+    auto & cache = caches[table.to_string()];
+    if (cache == nullptr) {
+        cache = std::make_shared<evm_common::trie::xtrie_clean_cache_t>(table_clean_cache_size);
+    }
+    return cache;
+}
+
 std::shared_ptr<xtop_state_mpt> xtop_state_mpt::create(const common::xaccount_address_t & table,
                                                        const xhash256_t & root,
                                                        base::xvdbstore_t * db,
@@ -46,14 +66,20 @@ std::shared_ptr<xtop_state_mpt> xtop_state_mpt::create(const common::xaccount_ad
 
 void xtop_state_mpt::init(const common::xaccount_address_t & table, const xhash256_t & root, base::xvdbstore_t * db, std::error_code & ec) {
     m_table_address = table;
+    m_dbstore = db;
     auto const kv_db = std::make_shared<evm_common::trie::xkv_db_t>(db, table);
-    m_db = evm_common::trie::xtrie_db_t::NewDatabase(kv_db);
+    auto config = std::make_shared<evm_common::trie::xtrie_db_config_t>();
+    config->Clean_cache = table_clean_cache(table);
+    config->Node_diff = true;
+    m_db = evm_common::trie::xtrie_db_t::NewDatabaseWithConfig(kv_db, config);
     m_trie = evm_common::trie::xsecure_trie_t::build_from(root, m_db, ec);
     if (ec) {
         xwarn("xtop_state_mpt::init trie with %s %s maybe not complete yes", table.c_str(), root.as_hex_str().c_str());
         return;
     }
     m_original_root = root;
+    m_snapshot = xstate_snapshot_t::instance(table, db);
+    m_snapshot_root = root;
     return;
 }
 
@@ -140,22 +166,31 @@ std::shared_ptr<xstate_object_t> xtop_state_mpt::get_deleted_state_object(common
     if (nullptr != cache_obj) {
         return cache_obj;
     }
-    // get from db
-    xbytes_t index_bytes;
+    // get from snapshot, which is one db read, then from trie
+    std::string index_str;
+    xhash256_t snapshot_root;
     {
-        XMETRICS_TIME_RECORD("state_mpt_load_db_index");
         std::lock_guard<std::mutex> lock(m_trie_lock);
-        index_bytes = m_trie->try_get(to_bytes(account), ec);
+        snapshot_root = m_snapshot_root;
     }
-    if (ec) {
-        xwarn("xtop_state_mpt::get_deleted_state_object TryGet %s error, %s %s", account.c_str(), ec.category().name(), ec.message().c_str());
-        return nullptr;
+    if (m_snapshot == nullptr || !m_snapshot->get(snapshot_root, account, index_str)) {
+        xbytes_t index_bytes;
+        {
+            XMETRICS_TIME_RECORD("state_mpt_load_db_index");
+            std::lock_guard<std::mutex> lock(m_trie_lock);
+            index_bytes = m_trie->try_get(to_bytes(account), ec);
+        }
+        if (ec) {
+            xwarn("xtop_state_mpt::get_deleted_state_object TryGet %s error, %s %s", account.c_str(), ec.category().name(), ec.message().c_str());
+            return nullptr;
+        }
+        index_str.assign(index_bytes.begin(), index_bytes.end());
     }
-    if (index_bytes.empty()) {
+    if (index_str.empty()) {
         return nullptr;
     }
     xaccount_info_t info;
-    info.decode({index_bytes.begin(), index_bytes.end()});
+    info.decode(index_str);
     auto obj = xstate_object_t::new_object(account, info.m_index);
     set_state_object(obj);
     return obj;
@@ -219,9 +254,11 @@ void xtop_state_mpt::prune_unit(const common::xaccount_address_t & account, std:
     }
     xaccount_info_t info;
     info.decode({index_bytes.begin(), index_bytes.end()});
-    auto hash = info.m_index.get_latest_unit_hash();
-    auto key = base::xvdbkey_t::create_prunable_unit_state_key(base::xvaccount_t{account.value()}, info.m_index.get_latest_unit_height(), info.m_index.get_latest_unit_hash());
-    m_db->DiskDB()->DeleteDirect({key.begin(), key.end()}, ec);
+    base::xvaccount_t const vaccount{account.value()};
+    // the unit state is stored either in full or as the delta to the previous state, drop both
+    auto key = base::xvdbkey_t::create_prunable_unit_state_key(vaccount, info.m_index.get_latest_unit_height(), info.m_index.get_latest_unit_hash());
+    auto delta_key = base::xvdbkey_t::create_prunable_unit_state_delta_key(vaccount, info.m_index.get_latest_unit_height(), info.m_index.get_latest_unit_hash());
+    m_db->DiskDB()->DeleteDirectBatch({{key.begin(), key.end()}, {delta_key.begin(), delta_key.end()}}, ec);
     if (ec) {
         xwarn("xtop_state_mpt::prune_unit db Delete error: %s, %s", ec.category().name(), ec.message().c_str());
         return;
@@ -260,11 +297,16 @@ xhash256_t xtop_state_mpt::commit(std::error_code & ec) {
         return {};
     }
 
+    std::map<std::string, std::string> snapshot_accounts;
     for (auto & acc : m_state_objects_dirty) {
         auto obj = query_state_object(acc);
         if (obj == nullptr) {
             continue;
         }
+        xaccount_info_t info;
+        info.m_account = acc;
+        info.m_index = obj->index;
+        snapshot_accounts.emplace(acc.to_string(), info.encode());
         std::map<xbytes_t, xbytes_t> batch;
         if (!obj->unit_bytes.empty() && obj->dirty_unit) {
             auto unit_key =
@@ -301,9 +343,22 @@ xhash256_t xtop_state_mpt::commit(std::error_code & ec) {
         xwarn("xtop_state_mpt::commit db commit error, %s %s", ec.category().name(), ec.message().c_str());
         return {};
     }
+    if (m_snapshot != nullptr) {
+        m_snapshot->update(m_snapshot_root, res.first, std::move(snapshot_accounts));
+    }
+    m_snapshot_root = res.first;
     return res.first;
 }
 
+std::shared_ptr<xstate_mpt_reader_t> xtop_state_mpt::reader(std::error_code & ec) const {
+    xhash256_t root;
+    {
+        std::lock_guard<std::mutex> lock(m_trie_lock);
+        root = m_snapshot_root;
+    }
+    return xstate_mpt_reader_t::create(m_table_address, root, m_dbstore, ec);
+}
+
 void xtop_state_mpt::load_into(std::unique_ptr<xstate_mpt_store_t> const & state_mpt_store, std::error_code & ec) {
 }
 
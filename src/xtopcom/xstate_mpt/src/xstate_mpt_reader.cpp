@@ -0,0 +1,137 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xstate_mpt/xstate_mpt_reader.h"
+
+#include "xevm_common/trie/xtrie_kv_db.h"
+#include "xevm_common/trie/xtrie_proof.h"
+#include "xmetrics/xmetrics.h"
+#include "xstate_mpt/xstate_mpt.h"
+#include "xstate_mpt/xstate_object.h"
+#include "xutility/xhash.h"
+
+namespace top {
+namespace state_mpt {
+
+// key of account in the underlying trie. secure trie hashes keys itself, but proofs are made and verified on hashed keys.
+static xbytes_t trie_key(common::xaccount_address_t const & account) {
+    auto const key = to_bytes(account);
+    xbytes_t hashed;
+    utl::xkeccak256_t hasher;
+    hasher.update(key.data(), key.size());
+    hasher.get_hash(hashed);
+    return hashed;
+}
+
+xtop_state_mpt_reader::xtop_state_mpt_reader(common::xaccount_address_t const & table, xhash256_t const & root, base::xvdbstore_t * db)
+  : m_table_address{table}, m_root{root} {
+    auto const kv_db = std::make_shared<evm_common::trie::xkv_db_t>(db, table);
+    auto config = std::make_shared<evm_common::trie::xtrie_db_config_t>();
+    config->Clean_cache = table_clean_cache(table);
+    m_db = evm_common::trie::xtrie_db_t::NewDatabaseWithConfig(kv_db, config);
+    m_snapshot = xstate_snapshot_t::instance(table, db);
+}
+
+std::shared_ptr<xtop_state_mpt_reader> xtop_state_mpt_reader::create(common::xaccount_address_t const & table,
+                                                                     xhash256_t const & root,
+                                                                     base::xvdbstore_t * db,
+                                                                     std::error_code & ec) {
+    auto reader = std::make_shared<xtop_state_mpt_reader>(table, root, db);
+    reader->m_trie = evm_common::trie::xsecure_trie_t::build_from(root, reader->m_db, ec);
+    if (ec) {
+        xwarn("xtop_state_mpt_reader::create trie with %s %s error, %s %s", table.c_str(), root.as_hex_str().c_str(), ec.category().name(), ec.message().c_str());
+        return nullptr;
+    }
+    return reader;
+}
+
+base::xaccount_index_t xtop_state_mpt_reader::get_account_index(common::xaccount_address_t const & account, std::error_code & ec) const {
+    auto const info_str = get_account_info(account, ec);
+    if (ec) {
+        xwarn("xtop_state_mpt_reader::get_account_index %s error: %s %s", account.c_str(), ec.category().name(), ec.message().c_str());
+        return {};
+    }
+    if (info_str.empty()) {
+        return {};
+    }
+    xaccount_info_t info;
+    info.decode(info_str);
+    return info.m_index;
+}
+
+xbytes_t xtop_state_mpt_reader::get_unit(common::xaccount_address_t const & account, std::error_code & ec) const {
+    auto const info_str = get_account_info(account, ec);
+    if (ec) {
+        xwarn("xtop_state_mpt_reader::get_unit %s error: %s %s", account.c_str(), ec.category().name(), ec.message().c_str());
+        return {};
+    }
+    if (info_str.empty()) {
+        return {};
+    }
+    xaccount_info_t info;
+    info.decode(info_str);
+    // a temporary object, so nothing read is shared between threads.
+    return xstate_object_t::new_object(account, info.m_index)->get_unit(m_db->DiskDB());
+}
+
+std::vector<base::xaccount_index_t> xtop_state_mpt_reader::prove_account_indexes(std::vector<common::xaccount_address_t> const & accounts,
+                                                                                 evm_common::trie::xkv_db_face_ptr_t const & proof_db,
+                                                                                 std::error_code & ec) const {
+    std::vector<base::xaccount_index_t> indexes;
+    std::vector<xbytes_t> keys;
+    indexes.reserve(accounts.size());
+    keys.reserve(accounts.size());
+    for (auto const & account : accounts) {
+        indexes.push_back(get_account_index(account, ec));
+        if (ec) {
+            return {};
+        }
+        keys.push_back(trie_key(account));
+    }
+
+    XMETRICS_TIME_RECORD("state_mpt_prove_account_indexes");
+    m_trie->prove_multi(keys, proof_db, ec);
+    if (ec) {
+        xwarn("xtop_state_mpt_reader::prove_account_indexes %s %s error: %s %s", m_table_address.c_str(), m_root.as_hex_str().c_str(), ec.category().name(), ec.message().c_str());
+        return {};
+    }
+    return indexes;
+}
+
+base::xaccount_index_t xtop_state_mpt_reader::verify_account_index(xhash256_t const & root,
+                                                                   common::xaccount_address_t const & account,
+                                                                   evm_common::trie::xkv_db_face_ptr_t const & proof_db,
+                                                                   std::error_code & ec) {
+    auto const info_bytes = evm_common::trie::VerifyProof(root, trie_key(account), proof_db, ec);
+    if (ec || info_bytes.empty()) {
+        return {};
+    }
+    xaccount_info_t info;
+    info.decode({info_bytes.begin(), info_bytes.end()});
+    return info.m_index;
+}
+
+xhash256_t const & xtop_state_mpt_reader::get_root_hash() const noexcept {
+    return m_root;
+}
+
+std::string xtop_state_mpt_reader::get_account_info(common::xaccount_address_t const & account, std::error_code & ec) const {
+    std::string info_str;
+    if (m_snapshot != nullptr && m_snapshot->get(m_root, account, info_str)) {
+        return info_str;
+    }
+
+    xbytes_t info_bytes;
+    {
+        XMETRICS_TIME_RECORD("state_mpt_load_db_index");
+        info_bytes = m_trie->try_get(to_bytes(account), ec);
+    }
+    if (ec) {
+        return {};
+    }
+    return {info_bytes.begin(), info_bytes.end()};
+}
+
+}  // namespace state_mpt
+}  // namespace top
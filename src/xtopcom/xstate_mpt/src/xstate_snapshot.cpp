@@ -0,0 +1,296 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xstate_mpt/xstate_snapshot.h"
+
+#include "xbase/xdata.h"
+#include "xbase/xlog.h"
+#include "xevm_common/trie/xtrie.h"
+#include "xmetrics/xmetrics.h"
+#include "xvledger/xvaccount.h"
+#include "xvledger/xvdbkey.h"
+
+#include <cassert>
+#include <vector>
+
+namespace top {
+namespace state_mpt {
+
+constexpr std::size_t max_unknown_roots = 1024;
+
+std::string xtop_state_snapshot_diff::encode() const {
+    base::xstream_t stream(base::xcontext_t::instance());
+    stream << std::string{reinterpret_cast<char const *>(parent.data()), parent.size()};
+    stream << static_cast<uint32_t>(accounts.size());
+    for (auto const & account : accounts) {
+        stream << account.first;
+        stream << account.second;
+    }
+    return std::string{(const char *)stream.data(), (size_t)stream.size()};
+}
+
+bool xtop_state_snapshot_diff::decode(std::string const & str) {
+    base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)str.data(), (int32_t)str.size());
+    std::string parent_str;
+    uint32_t count{0};
+    stream >> parent_str;
+    stream >> count;
+    if (parent_str.size() != parent.size()) {
+        return false;
+    }
+    parent = xhash256_t{xbytes_t{parent_str.begin(), parent_str.end()}};
+    accounts.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string account;
+        std::string value;
+        stream >> account;
+        stream >> value;
+        accounts.emplace(std::move(account), std::move(value));
+    }
+    return true;
+}
+
+xtop_state_snapshot::xtop_state_snapshot(common::xaccount_address_t const & table, base::xvdbstore_t * db)
+  : m_prefix{base::xvdbkey_t::create_prunable_mpt_node_key_prefix(base::xvaccount_t{table.value()})}, m_db{db} {
+}
+
+std::shared_ptr<xtop_state_snapshot> xtop_state_snapshot::instance(common::xaccount_address_t const & table, base::xvdbstore_t * db) {
+    static std::mutex snapshots_mutex;
+    static std::map<std::string, std::shared_ptr<xtop_state_snapshot>> snapshots;
+
+    std::shared_ptr<xtop_state_snapshot> snapshot;
+    {
+        std::lock_guard<std::mutex> lock{snapshots_mutex};
+        auto & s = snapshots[table.to_string()];
+        if (s == nullptr || s->m_db != db) {
+            s = std::make_shared<xtop_state_snapshot>(table, db);
+        }
+        snapshot = s;
+    }
+    // disk root is reloaded each time, so the snapshot never outlives what is really on disk.
+    snapshot->load_disk_root();
+    return snapshot;
+}
+
+bool xtop_state_snapshot::get(xhash256_t const & root, common::xaccount_address_t const & account, std::string & value) {
+    auto const target = normalize(root);
+    auto const account_str = account.to_string();
+    for (;;) {
+        uint64_t generation{0};
+        {
+            std::lock_guard<std::mutex> lock{m_lock};
+            if (!m_disk_ready) {
+                XMETRICS_GAUGE(metrics::mpt_snapshot_miss, 1);
+                return false;
+            }
+            auto cur = target;
+            std::size_t depth{0};
+            while (cur != m_disk_root) {
+                auto const * diff = layer(cur);
+                if (diff == nullptr || ++depth > 2 * max_diff_layers) {
+                    XMETRICS_GAUGE(metrics::mpt_snapshot_miss, 1);
+                    return false;
+                }
+                auto const it = diff->accounts.find(account_str);
+                if (it != diff->accounts.end()) {
+                    value = it->second;
+                    XMETRICS_GAUGE(metrics::mpt_snapshot_hit, 1);
+                    return true;
+                }
+                cur = diff->parent;
+            }
+            generation = m_disk_generation;
+        }
+
+        // disk read runs without lock. if disk layer moved meanwhile, the value may be newer than root, walk again.
+        value = m_db->get_value(base::xvdbkey_t::create_mpt_snapshot_account_key(m_prefix, account_str));
+        std::lock_guard<std::mutex> lock{m_lock};
+        if (generation == m_disk_generation) {
+            XMETRICS_GAUGE(metrics::mpt_snapshot_hit, 1);
+            return true;
+        }
+    }
+}
+
+void xtop_state_snapshot::update(xhash256_t const & parent, xhash256_t const & root, std::map<std::string, std::string> accounts) {
+    auto const parent_root = normalize(parent);
+    auto const new_root = normalize(root);
+    if (parent_root == new_root) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{m_lock};
+    if (!m_disk_ready) {
+        // only a table starting from an empty state can be snapshotted from its first commit.
+        if (parent_root != evm_common::trie::empty_root) {
+            return;
+        }
+        std::string const root_str{reinterpret_cast<char const *>(parent_root.data()), parent_root.size()};
+        m_db->set_value(base::xvdbkey_t::create_mpt_snapshot_root_key(m_prefix), root_str);
+        m_disk_root = parent_root;
+        m_disk_ready = true;
+        ++m_disk_generation;
+        xinfo("xtop_state_snapshot::update %s start from empty root", m_prefix.c_str());
+    }
+    if (m_layers.find(new_root) != m_layers.end() || new_root == m_disk_root) {
+        return;
+    }
+    if (!covers_locked(parent_root)) {
+        xdbg("xtop_state_snapshot::update parent %s not covered", parent_root.as_hex_str().c_str());
+        return;
+    }
+
+    xstate_snapshot_diff_t diff;
+    diff.parent = parent_root;
+    diff.accounts = std::move(accounts);
+    std::string const root_str{reinterpret_cast<char const *>(new_root.data()), new_root.size()};
+    m_db->set_value(base::xvdbkey_t::create_mpt_snapshot_diff_key(m_prefix, root_str), diff.encode());
+    m_layers.emplace(new_root, std::move(diff));
+    m_unknown.erase(new_root);
+
+    cap(new_root);
+    XMETRICS_GAUGE_SET_VALUE(metrics::mpt_snapshot_diff_layers, static_cast<int64_t>(m_layers.size()));
+}
+
+bool xtop_state_snapshot::covers(xhash256_t const & root) {
+    std::lock_guard<std::mutex> lock{m_lock};
+    return covers_locked(normalize(root));
+}
+
+xhash256_t xtop_state_snapshot::disk_root() const {
+    std::lock_guard<std::mutex> lock{m_lock};
+    return m_disk_root;
+}
+
+std::size_t xtop_state_snapshot::diff_layer_count() const {
+    std::lock_guard<std::mutex> lock{m_lock};
+    return m_layers.size();
+}
+
+xhash256_t xtop_state_snapshot::normalize(xhash256_t const & root) {
+    // state mpt of an empty table is created with zero hash, but committed empty trie is empty_root.
+    if (root == xhash256_t{}) {
+        return evm_common::trie::empty_root;
+    }
+    return root;
+}
+
+void xtop_state_snapshot::load_disk_root() {
+    // read under lock, otherwise a concurrent flatten may be overwritten by an older disk root.
+    std::lock_guard<std::mutex> lock{m_lock};
+    auto const root_str = m_db->get_value(base::xvdbkey_t::create_mpt_snapshot_root_key(m_prefix));
+    if (root_str.size() != m_disk_root.size()) {
+        m_disk_ready = false;
+        return;
+    }
+    auto const root = xhash256_t{xbytes_t{root_str.begin(), root_str.end()}};
+    if (!m_disk_ready || root != m_disk_root) {
+        m_disk_root = root;
+        m_disk_ready = true;
+        ++m_disk_generation;
+    }
+}
+
+xstate_snapshot_diff_t const * xtop_state_snapshot::layer(xhash256_t const & root) {
+    auto it = m_layers.find(root);
+    if (it != m_layers.end()) {
+        return &it->second;
+    }
+    if (m_unknown.find(root) != m_unknown.end()) {
+        return nullptr;
+    }
+
+    // not in memory, e.g. after restart. load the persisted one.
+    std::string const root_str{reinterpret_cast<char const *>(root.data()), root.size()};
+    auto const value = m_db->get_value(base::xvdbkey_t::create_mpt_snapshot_diff_key(m_prefix, root_str));
+    xstate_snapshot_diff_t diff;
+    if (value.empty() || !diff.decode(value)) {
+        if (m_unknown.size() >= max_unknown_roots) {
+            m_unknown.clear();
+        }
+        m_unknown.insert(root);
+        return nullptr;
+    }
+    return &m_layers.emplace(root, std::move(diff)).first->second;
+}
+
+bool xtop_state_snapshot::covers_locked(xhash256_t const & root) {
+    if (!m_disk_ready) {
+        return false;
+    }
+    auto cur = root;
+    std::size_t depth{0};
+    while (cur != m_disk_root) {
+        auto const * diff = layer(cur);
+        if (diff == nullptr || ++depth > 2 * max_diff_layers) {
+            return false;
+        }
+        cur = diff->parent;
+    }
+    return true;
+}
+
+void xtop_state_snapshot::cap(xhash256_t const & root) {
+    std::vector<xhash256_t> chain;  // from root down to the layer right above disk
+    for (auto cur = root; cur != m_disk_root;) {
+        chain.push_back(cur);
+        cur = m_layers.at(cur).parent;
+    }
+    if (chain.size() <= max_diff_layers) {
+        return;
+    }
+    while (chain.size() > max_diff_layers) {
+        flatten(chain.back());
+        chain.pop_back();
+    }
+    drop_orphans();
+}
+
+void xtop_state_snapshot::flatten(xhash256_t const & bottom) {
+    auto it = m_layers.find(bottom);
+    assert(it != m_layers.end());
+    assert(it->second.parent == m_disk_root);
+
+    // accounts and new disk root go in one batch, so disk layer is always consistent with its root.
+    std::map<std::string, std::string> batch;
+    for (auto const & account : it->second.accounts) {
+        batch.emplace(base::xvdbkey_t::create_mpt_snapshot_account_key(m_prefix, account.first), account.second);
+    }
+    std::string const root_str{reinterpret_cast<char const *>(bottom.data()), bottom.size()};
+    batch.emplace(base::xvdbkey_t::create_mpt_snapshot_root_key(m_prefix), root_str);
+    m_db->set_values(batch);
+    m_db->delete_value(base::xvdbkey_t::create_mpt_snapshot_diff_key(m_prefix, root_str));
+
+    m_disk_root = bottom;
+    ++m_disk_generation;
+    m_layers.erase(it);
+}
+
+void xtop_state_snapshot::drop_orphans() {
+    // layers of forks not built on new disk root are never reachable again.
+    // ancestors of a layer may not be loaded yet after restart, so check by walking down to disk.
+    std::vector<xhash256_t> roots;
+    roots.reserve(m_layers.size());
+    for (auto const & l : m_layers) {
+        roots.push_back(l.first);
+    }
+    std::vector<xhash256_t> orphans;
+    for (auto const & root : roots) {
+        if (!covers_locked(root)) {
+            orphans.push_back(root);
+        }
+    }
+    std::vector<std::string> keys;
+    for (auto const & root : orphans) {
+        std::string const root_str{reinterpret_cast<char const *>(root.data()), root.size()};
+        keys.push_back(base::xvdbkey_t::create_mpt_snapshot_diff_key(m_prefix, root_str));
+        m_layers.erase(root);
+    }
+    if (!keys.empty()) {
+        m_db->delete_values(keys);
+    }
+}
+
+}  // namespace state_mpt
+}  // namespace top
@@ -9,11 +9,20 @@
 #include "xevm_common/trie/xsecure_trie.h"
 #include "xstate_mpt/xstate_mpt_store_fwd.h"
 #include "xstate_mpt/xstate_object.h"
+#include "xstate_mpt/xstate_snapshot.h"
 #include "xvledger/xvdbstore.h"
 
+#include <unordered_map>
+
 namespace top {
 namespace state_mpt {
 
+class xtop_state_mpt_reader;
+using xstate_mpt_reader_t = xtop_state_mpt_reader;
+
+/// @brief Clean trie node cache of table, shared by all state MPT and readers of the table.
+evm_common::trie::xtrie_clean_cache_ptr_t table_clean_cache(common::xaccount_address_t const & table);
+
 struct xaccount_info_t {
 public:
     xaccount_info_t() = default;
@@ -89,6 +98,12 @@ public:
     /// @return New root hash.
     xhash256_t commit(std::error_code & ec);
 
+    /// @brief Create a read-only view of the last committed root, which can be queried by many threads without lock.
+    ///        Modifies not committed yet are not visible to it.
+    /// @param ec Log the error code.
+    /// @return Reader of last committed root.
+    std::shared_ptr<xstate_mpt_reader_t> reader(std::error_code & ec) const;
+
     void load_into(std::unique_ptr<xstate_mpt_store_t> const & state_mpt_store, std::error_code & ec);
 
     void prune(xhash256_t const & old_trie_root_hash, std::error_code & ec) const;
@@ -143,15 +158,19 @@ private:
     std::shared_ptr<xstate_object_t> query_state_object(common::xaccount_address_t const& account) const;
 
     common::xaccount_address_t m_table_address;
+    base::xvdbstore_t * m_dbstore{nullptr};
 
     std::shared_ptr<evm_common::trie::xsecure_trie_t> m_trie{nullptr};
     std::shared_ptr<evm_common::trie::xtrie_db_t> m_db{nullptr};
     xhash256_t m_original_root;
+    std::shared_ptr<xstate_snapshot_t> m_snapshot{nullptr};
+    xhash256_t m_snapshot_root;  // last committed root, account index not in cache is read from snapshot at it
 
     mutable std::mutex m_state_objects_lock;
     mutable std::mutex m_trie_lock;
 
-    std::map<common::xaccount_address_t, std::shared_ptr<xstate_object_t>> m_state_objects;
+    // only looked up, never iterated, so it is keyed by the cached hash of the address
+    std::unordered_map<common::xaccount_address_t, std::shared_ptr<xstate_object_t>> m_state_objects;
     std::set<common::xaccount_address_t> m_state_objects_pending;
     std::set<common::xaccount_address_t> m_state_objects_dirty;
 };
@@ -0,0 +1,96 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xhash.hpp"
+#include "xcommon/xaccount_address.h"
+#include "xevm_common/trie/xsecure_trie.h"
+#include "xevm_common/trie/xtrie_db.h"
+#include "xstate_mpt/xstate_snapshot.h"
+#include "xvledger/xaccountindex.h"
+#include "xvledger/xvdbstore.h"
+
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace top {
+namespace state_mpt {
+
+/// @brief Read-only view of one committed root of a table state MPT.
+///        It never changes after creation: there is no state object cache and no pending update, trie is only read
+///        through const lookups on its own trie db which holds no dirty node. So any number of threads can query
+///        it at the same time without lock, e.g. RPC queries running along with block execution on the same table.
+///        Clean node cache and snapshot of the table are shared with the writer.
+class xtop_state_mpt_reader {
+public:
+    xtop_state_mpt_reader(xtop_state_mpt_reader const &) = delete;
+    xtop_state_mpt_reader & operator=(xtop_state_mpt_reader const &) = delete;
+    xtop_state_mpt_reader(xtop_state_mpt_reader &&) = delete;
+    xtop_state_mpt_reader & operator=(xtop_state_mpt_reader &&) = delete;
+    ~xtop_state_mpt_reader() = default;
+
+    xtop_state_mpt_reader(common::xaccount_address_t const & table, xhash256_t const & root, base::xvdbstore_t * db);
+
+    /// @brief Create a reader of specific committed root.
+    /// @param table Table address of state MPT.
+    /// @param root Root hash of MPT, must be committed.
+    /// @param db Db interface.
+    /// @param ec Log the error code.
+    /// @return Reader of given root hash. Error occurred if cannot find root in db.
+    static std::shared_ptr<xtop_state_mpt_reader> create(common::xaccount_address_t const & table, xhash256_t const & root, base::xvdbstore_t * db, std::error_code & ec);
+
+    /// @brief Get index of specific account.
+    /// @param account Account string.
+    /// @param ec Log the error code.
+    /// @return Account index of given account. Return empty index if not find in db.
+    base::xaccount_index_t get_account_index(common::xaccount_address_t const & account, std::error_code & ec) const;
+
+    /// @brief Get unit data of specific account.
+    /// @param account Account string.
+    /// @param ec Log the error code.
+    /// @return Unit data of given account. Return empty data if not find in db.
+    xbytes_t get_unit(common::xaccount_address_t const & account, std::error_code & ec) const;
+
+    /// @brief Prove indexes of many accounts against the root viewed, in one trie walk for all of them.
+    ///        Nodes on common paths are put into proof db once, so a batch proof is smaller and cheaper than
+    ///        proving the accounts one by one.
+    /// @param accounts Accounts of the table.
+    /// @param proof_db Kv db the proof nodes are put into, keyed by node hash.
+    /// @param ec Log the error code.
+    /// @return Account index of each account in order, empty index if the account is not in MPT, whose absence is proven.
+    std::vector<base::xaccount_index_t> prove_account_indexes(std::vector<common::xaccount_address_t> const & accounts,
+                                                              evm_common::trie::xkv_db_face_ptr_t const & proof_db,
+                                                              std::error_code & ec) const;
+
+    /// @brief Verify index of account with a proof of prove_account_indexes, e.g. by a light client knowing root only.
+    /// @param root Root hash the proof is against.
+    /// @param account Account to verify.
+    /// @param proof_db Kv db of proof nodes.
+    /// @param ec Log the error code, set if proof is incomplete or invalid.
+    /// @return Account index proven, empty index if the account is proven not in MPT.
+    static base::xaccount_index_t verify_account_index(xhash256_t const & root,
+                                                       common::xaccount_address_t const & account,
+                                                       evm_common::trie::xkv_db_face_ptr_t const & proof_db,
+                                                       std::error_code & ec);
+
+    /// @brief Get root hash viewed.
+    /// @return Root hash.
+    xhash256_t const & get_root_hash() const noexcept;
+
+private:
+    /// @brief Get encoded xaccount_info_t of account, from snapshot first, then from trie.
+    std::string get_account_info(common::xaccount_address_t const & account, std::error_code & ec) const;
+
+    common::xaccount_address_t const m_table_address;
+    xhash256_t const m_root;
+    std::shared_ptr<evm_common::trie::xtrie_db_t> m_db{nullptr};
+    std::shared_ptr<evm_common::trie::xsecure_trie_t> m_trie{nullptr};
+    std::shared_ptr<xstate_snapshot_t> m_snapshot{nullptr};
+};
+using xstate_mpt_reader_t = xtop_state_mpt_reader;
+
+}  // namespace state_mpt
+}  // namespace top
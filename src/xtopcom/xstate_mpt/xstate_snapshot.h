@@ -0,0 +1,93 @@
+// Copyright (c) 2017-present Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xhash.hpp"
+#include "xcommon/xaccount_address.h"
+#include "xvledger/xvdbstore.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace top {
+namespace state_mpt {
+
+/// @brief Account indexes changed from parent root to this root.
+struct xtop_state_snapshot_diff {
+    xhash256_t parent;
+    std::map<std::string, std::string> accounts;  // account -> encoded xaccount_info_t, empty if account removed
+
+    std::string encode() const;
+    bool decode(std::string const & str);
+};
+using xstate_snapshot_diff_t = xtop_state_snapshot_diff;
+
+/// @brief Flat account index snapshot of one table, lets account index be read by one KV lookup instead of a trie walk.
+///        A disk layer holds every account of one root as flat KV, diff layers of the recent roots stack on top of it
+///        (a tree, forks allowed). Once the stack is deeper than max_diff_layers, the bottom layer is merged into disk layer.
+///        Diff layers are persisted as well, so they are still usable after restart.
+///        Trie is still the source of truth: any root not covered by snapshot must be read from trie.
+class xtop_state_snapshot {
+public:
+    static constexpr std::size_t max_diff_layers{128};
+
+    xtop_state_snapshot(xtop_state_snapshot const &) = delete;
+    xtop_state_snapshot & operator=(xtop_state_snapshot const &) = delete;
+    xtop_state_snapshot(xtop_state_snapshot &&) = delete;
+    xtop_state_snapshot & operator=(xtop_state_snapshot &&) = delete;
+    ~xtop_state_snapshot() = default;
+
+    xtop_state_snapshot(common::xaccount_address_t const & table, base::xvdbstore_t * db);
+
+    /// @brief Snapshot of table, shared by all state mpt of the table.
+    static std::shared_ptr<xtop_state_snapshot> instance(common::xaccount_address_t const & table, base::xvdbstore_t * db);
+
+    /// @brief Get account info at given root.
+    /// @param root Root hash of state mpt.
+    /// @param account Account address.
+    /// @param value Encoded xaccount_info_t, empty if account not exist at root.
+    /// @return False if root is not covered by snapshot, caller should read trie then.
+    bool get(xhash256_t const & root, common::xaccount_address_t const & account, std::string & value);
+
+    /// @brief Stack changes of one commit on parent layer. Ignored if parent is not covered.
+    /// @param parent Root hash before commit.
+    /// @param root Root hash after commit.
+    /// @param accounts Account -> encoded xaccount_info_t of all accounts changed by the commit.
+    void update(xhash256_t const & parent, xhash256_t const & root, std::map<std::string, std::string> accounts);
+
+    bool covers(xhash256_t const & root);
+    xhash256_t disk_root() const;
+    std::size_t diff_layer_count() const;
+
+private:
+    static xhash256_t normalize(xhash256_t const & root);
+    void load_disk_root();
+
+    // caller must hold m_lock
+    xstate_snapshot_diff_t const * layer(xhash256_t const & root);
+    bool covers_locked(xhash256_t const & root);
+    void cap(xhash256_t const & root);
+    void flatten(xhash256_t const & bottom);
+    void drop_orphans();
+
+    std::string const m_prefix;
+    base::xvdbstore_t * m_db{nullptr};
+
+    mutable std::mutex m_lock;
+    bool m_disk_ready{false};
+    xhash256_t m_disk_root;
+    uint64_t m_disk_generation{0};  // changed each time disk layer moves, readers of disk layer recheck it
+    std::unordered_map<xhash256_t, xstate_snapshot_diff_t> m_layers;
+    std::unordered_set<xhash256_t> m_unknown;  // roots known not persisted, avoid reading db again
+};
+using xstate_snapshot_t = xtop_state_snapshot;
+
+}  // namespace state_mpt
+}  // namespace top
@@ -13,5 +13,9 @@ namespace state_mpt {
 
 std::shared_ptr<evm_common::trie::Sync> new_state_sync(const common::xaccount_address_t & table, const xhash256_t & root, base::xvdbstore_t * db, bool sync_unit);
 
+// schedule unit state referenced by an account leaf of state mpt, parent is the hash of node holding the leaf,
+// empty if the leaf is not fetched by node sync, e.g. from a range of leaves.
+void add_unit_entry(evm_common::trie::Sync & syncer, const xbytes_t & hexpath, const xbytes_t & value, const xhash256_t & parent, std::error_code & ec);
+
 }  // namespace state_mpt
 }  // namespace top
\ No newline at end of file
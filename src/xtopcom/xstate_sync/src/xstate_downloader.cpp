@@ -4,6 +4,8 @@
 
 #include "xstate_sync/xstate_downloader.h"
 
+#include "xevm_common/trie/xtrie.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
 #include "xmbus/xevent_state_sync.h"
 #include "xstate_sync/xerror.h"
 #include "xstate_sync/xstate_sync.h"
@@ -13,6 +15,8 @@ namespace top {
 namespace state_sync {
 
 constexpr uint32_t execution_overtime = 10 * 60;
+constexpr std::size_t range_response_leaves = 1024;
+constexpr std::size_t range_response_bytes = 512 * 1024;
 
 xtop_state_downloader::xtop_state_downloader(base::xvdbstore_t * db,
                                              statestore::xstatestore_face_t * store,
@@ -196,6 +200,10 @@ void xtop_state_downloader::handle_message(const vnetwork::xvnode_address_t & se
         process_unit_request(sender, network, message);
     } else if (message.id() == xmessage_id_sync_unit_response) {
         process_unit_response(message);
+    } else if (message.id() == xmessage_id_sync_range_request) {
+        process_range_request(sender, network, message);
+    } else if (message.id() == xmessage_id_sync_range_response) {
+        process_range_response(message);
     } else {
         xerror("xtop_state_downloader::handle_message unknown msg id: %lu", static_cast<uint32_t>(message.id()));
     }
@@ -303,6 +311,9 @@ void xtop_state_downloader::process_table_request(const vnetwork::xvnode_address
     stream >> id;
     auto state_key = base::xvdbkey_t::create_prunable_state_key(base::xvaccount_t{table}, height, {hash.begin(), hash.end()});
     auto v = m_db->get_value(state_key);
+    if (v.empty()) {
+        v = m_db->get_value(base::xvdbkey_t::create_prunable_state_key_old(base::xvaccount_t{table}, height, {hash.begin(), hash.end()}));
+    }
     if (v.empty()) {
         xwarn("xtop_state_downloader::process_table_request empty, table %s, height: %lu, hash: %s", table.c_str(), height, to_hex(hash).c_str());
     }
@@ -408,6 +419,100 @@ void xtop_state_downloader::process_unit_response(const vnetwork::xmessage_t & m
     }
 }
 
+void xtop_state_downloader::process_range_request(const vnetwork::xvnode_address_t & sender,
+                                                  std::shared_ptr<vnetwork::xvnetwork_driver_face_t> network,
+                                                  const vnetwork::xmessage_t & message) const {
+    base::xstream_t stream(base::xcontext_t::instance(), const_cast<uint8_t *>(message.payload().data()), (uint32_t)message.payload().size());
+    std::string table;
+    uint32_t id;
+    xbytes_t root;
+    xbytes_t origin;
+    stream >> table;
+    stream >> id;
+    stream >> root;
+    stream >> origin;
+    std::vector<xbytes_t> keys;
+    std::vector<xbytes_t> values;
+    std::vector<xbytes_t> proof;
+    do {
+        if (root.size() != xhash256_t::bytes_size) {
+            xwarn("xtop_state_downloader::process_range_request invalid root, table: %s, id: %u, root: %s", table.c_str(), id, to_hex(root).c_str());
+            break;
+        }
+        auto kv_db = std::make_shared<evm_common::trie::xkv_db_t>(m_db, common::xaccount_address_t{table});
+        std::error_code ec;
+        auto const trie = evm_common::trie::xtrie_t::build_from(xhash256_t{root}, evm_common::trie::xtrie_db_t::NewDatabase(kv_db), ec);
+        if (ec) {
+            xwarn("xtop_state_downloader::process_range_request root not found, table: %s, id: %u, root: %s", table.c_str(), id, to_hex(root).c_str());
+            break;
+        }
+        trie->range(origin, range_response_leaves, range_response_bytes, keys, values, ec);
+        if (ec) {
+            xwarn("xtop_state_downloader::process_range_request range error: %s %s, table: %s, id: %u", ec.category().name(), ec.message().c_str(), table.c_str(), id);
+            keys.clear();
+            values.clear();
+            break;
+        }
+        // proofs of both edges, the last one is skipped if no leaf left from origin.
+        auto const proof_db = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+        trie->prove(origin, 0, proof_db, ec);
+        if (!ec && !keys.empty()) {
+            trie->prove(keys.back(), 0, proof_db, ec);
+        }
+        if (ec) {
+            xwarn("xtop_state_downloader::process_range_request prove error: %s %s, table: %s, id: %u", ec.category().name(), ec.message().c_str(), table.c_str(), id);
+            keys.clear();
+            values.clear();
+            break;
+        }
+        proof = proof_db->values();
+    } while (false);
+
+    base::xstream_t stream_back{top::base::xcontext_t::instance()};
+    stream_back << table;
+    stream_back << id;
+    stream_back << keys;
+    stream_back << values;
+    stream_back << proof;
+    vnetwork::xmessage_t const _msg = vnetwork::xmessage_t({stream_back.data(), stream_back.data() + stream_back.size()}, xmessage_id_sync_range_response);
+    std::error_code ec;
+    network->send_to(sender, _msg, ec);
+    if (ec) {
+        xwarn("xtop_state_downloader::process_range_request network error %s %s, table: %s, id: %u, %s->%s",
+              ec.category().name(),
+              ec.message().c_str(),
+              table.c_str(),
+              id,
+              network->address().to_string().c_str(),
+              sender.to_string().c_str());
+        return;
+    }
+    xinfo("xtop_state_downloader::process_range_request success table: %s, id: %u, origin: %s, leaves: %zu, proof: %zu",
+          table.c_str(),
+          id,
+          to_hex(origin).c_str(),
+          keys.size(),
+          proof.size());
+}
+
+void xtop_state_downloader::process_range_response(const vnetwork::xmessage_t & message) const {
+    base::xstream_t stream(base::xcontext_t::instance(), const_cast<uint8_t *>(message.payload().data()), (uint32_t)message.payload().size());
+    std::string addr;
+    state_res res;
+    stream >> addr;
+    stream >> res.id;
+    stream >> res.keys;
+    stream >> res.values;
+    stream >> res.nodes;
+    auto account = common::xaccount_address_t{addr};
+    std::lock_guard<std::mutex> lock(m_table_dispatch);
+    if (m_running_tables.count(account)) {
+        auto executer = m_running_tables.at(account);
+        executer->push_state_pack(res);
+    }
+    xinfo("xtop_state_downloader::process_range_response table: %s, id: %u, leaves: %zu, proof: %zu", account.c_str(), res.id, res.keys.size(), res.nodes.size());
+}
+
 sync_peers xtop_state_downloader::latest_peers(const common::xtable_id_t & id) const {
     std::lock_guard<std::mutex> lock(m_mutex);
     sync_peers res;
@@ -111,6 +111,8 @@ void xtop_download_executer::loop(std::shared_ptr<xstate_sync_face_t> syncer, st
             auto req = active[res.id];
             req.nodes_response = res.nodes;
             req.units_response = res.units;
+            req.keys_response = res.keys;
+            req.values_response = res.values;
             req.delivered = base::xtime_utl::gettimeofday();
             syncer->deliver_req(req);
             active.erase(res.id);
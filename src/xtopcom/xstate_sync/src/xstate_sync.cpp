@@ -7,6 +7,9 @@
 #include "xcodec/xmsgpack_codec.hpp"
 #include "xdata/xtable_bstate.h"
 #include "xdata/xunit_bstate.h"
+#include "xevm_common/trie/xtrie.h"
+#include "xevm_common/trie/xtrie_encoding.h"
+#include "xevm_common/trie/xtrie_proof.h"
 #include "xevm_common/xerror/xerror.h"
 #include "xpbase/base/top_utils.h"
 #include "xstate_mpt/xstate_sync.h"
@@ -15,11 +18,28 @@
 #include "xvledger/xvdbkey.h"
 #include "xvnetwork/xvnetwork_message.h"
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 namespace top {
 namespace state_sync {
 
 constexpr uint32_t ideal_batch_size = 100 * 1024;
 constexpr uint32_t fetch_num = 64;
+// nodes hashed by one worker when verifying responses in parallel.
+constexpr std::size_t verify_nodes_per_worker = 256;
+constexpr uint64_t progress_interval_ms = 10 * 1000;
+
+// next key of the same length, false if key is the last one.
+static bool next_range_key(xbytes_t & key) {
+    for (auto it = key.rbegin(); it != key.rend(); ++it) {
+        if (++(*it) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
 
 xtop_state_sync::xtop_state_sync() {
     XMETRICS_COUNTER_INCREMENT("statesync_syncers", 1);
@@ -49,6 +69,7 @@ std::shared_ptr<xtop_state_sync> xtop_state_sync::new_state_sync(const common::x
     sync->m_peers_func = peers;
     sync->m_track_func = track_req;
     sync->m_db = db;
+    sync->m_sync_unit = sync_unit;
     sync->m_kv_db = std::make_shared<evm_common::trie::xkv_db_t>(db, table);
     sync->m_items_per_task = fetch_num;
     xinfo("xtop_state_sync::new_state_sync {%s}", sync->symbol().c_str());
@@ -69,6 +90,11 @@ void xtop_state_sync::run() {
             xwarn("xtop_state_sync::run sync_table error: %s %s, {%s}", m_ec.category().name(), m_ec.message().c_str(), symbol().c_str());
             break;
         }
+        sync_range(m_ec);
+        if (m_ec) {
+            xwarn("xtop_state_sync::run sync_range error: %s %s, {%s}", m_ec.category().name(), m_ec.message().c_str(), symbol().c_str());
+            break;
+        }
         sync_trie(m_ec);
         if (m_ec) {
             xwarn("xtop_state_sync::run sync_trie error: %s %s, {%s}", m_ec.category().name(), m_ec.message().c_str(), symbol().c_str());
@@ -128,8 +154,8 @@ void xtop_state_sync::sync_table(std::error_code & ec) {
 #endif
     // check exist
     auto const key = base::xvdbkey_t::create_prunable_state_key(m_table.value(), m_height, {m_table_block_hash.begin(), m_table_block_hash.end()});
-    auto const value = m_db->get_value(key);
-    if (!value.empty()) {
+    auto const old_key = base::xvdbkey_t::create_prunable_state_key_old(m_table.value(), m_height, {m_table_block_hash.begin(), m_table_block_hash.end()});
+    if (!m_db->get_value(key).empty() || !m_db->get_value(old_key).empty()) {
         xinfo("xtop_state_sync::sync_table state already exist, %s, block_hash: %s", symbol().c_str(), to_hex(m_table_block_hash).c_str());
         m_sync_table_finish = true;
         return;
@@ -146,6 +172,49 @@ void xtop_state_sync::sync_table(std::error_code & ec) {
     return;
 }
 
+void xtop_state_sync::sync_range(std::error_code & ec) {
+#if !defined(NDEBUG)
+    assert(running_thead_id_ == std::this_thread::get_id());
+#endif
+    if (m_root.empty() || m_root == evm_common::trie::empty_root || evm_common::trie::HasTrieNode(m_kv_db, m_root)) {
+        xinfo("xtop_state_sync::sync_range root empty or existed, skip sync_range, {%s}", symbol().c_str());
+        return;
+    }
+
+    xinfo("xtop_state_sync::sync_range {%s}", symbol().c_str());
+    m_start_time = base::xtime_utl::time_now_ms();
+    m_progress_time = m_start_time;
+    m_range_origin = xbytes_t(xhash256_t::bytes_size, 0);
+    m_range_batch = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+    m_stack_trie = evm_common::trie::xstack_trie_t::NewStackTrie(m_range_batch);
+    auto condition = [this]() -> bool { return !m_range_done; };
+    auto add_task = [this](sync_peers const & peers) { return assign_range_tasks(peers); };
+    auto process_task = [this](state_req & req, std::error_code & ec) { return process_range(req, ec); };
+    loop(condition, add_task, process_task, ec);
+    if (ec) {
+        xwarn("xtop_state_sync::sync_range loop error: %s %s, exit, {%s}", ec.category().name(), ec.message().c_str(), symbol().c_str());
+        return;
+    }
+
+    if (!m_range_failed) {
+        auto const root = m_stack_trie->Hash();
+        if (root != m_root) {
+            xwarn("xtop_state_sync::sync_range root mismatch: %s, {%s}", root.as_hex_str().c_str(), symbol().c_str());
+            m_range_failed = true;
+        }
+    }
+    // root node is left to node sync, it is written last after all units, so a stored root always means a complete state.
+    std::error_code _;
+    m_range_batch->Delete(m_root.to_bytes(), _);
+    flush_range_batch();
+    m_stack_trie = nullptr;
+    m_range_batch = nullptr;
+    if (m_range_failed) {
+        xwarn("xtop_state_sync::sync_range failed, left to node sync, {%s}", symbol().c_str());
+    }
+    report_progress(true);
+}
+
 void xtop_state_sync::sync_trie(std::error_code & ec) {
 #if !defined(NDEBUG)
     assert(running_thead_id_ == std::this_thread::get_id());
@@ -156,6 +225,8 @@ void xtop_state_sync::sync_trie(std::error_code & ec) {
     }
 
     xinfo("xtop_state_sync::sync_trie {%s}", symbol().c_str());
+    m_start_time = base::xtime_utl::time_now_ms();
+    m_progress_time = m_start_time;
     auto condition = [this]() -> bool { return (m_sched->Pending() > 0); };
     auto add_task = [this](sync_peers const & peers) { return assign_trie_tasks(peers); };
     auto process_task = [this](state_req & req, std::error_code & ec) { return process_trie(req, ec); };
@@ -166,6 +237,7 @@ void xtop_state_sync::sync_trie(std::error_code & ec) {
     }
 
     m_sched->Commit(m_kv_db);
+    report_progress(true);
     return;
 }
 
@@ -190,6 +262,11 @@ void xtop_state_sync::loop(std::function<bool()> condition,
             m_sched->CommitUnit(m_kv_db);
             m_unit_bytes_uncommitted = 0;
         }
+        if (m_node_bytes_uncommitted >= ideal_batch_size) {
+            m_sched->CommitNodes(m_kv_db);
+            m_node_bytes_uncommitted = 0;
+        }
+        report_progress(false);
         // step2: check peers
         if (net.peers.empty()) {
             xwarn("xtop_state_sync::loop peers empty, exit, {%s}", symbol().c_str());
@@ -214,7 +291,9 @@ void xtop_state_sync::loop(std::function<bool()> condition,
                 m_deliver_list.pop();
             }
         }
-        // step5: process reqs
+        // step5: verify all responses of this round in batch
+        verify_nodes(reqs);
+        // step6: process reqs
         for (auto & req : reqs) {
             if (req.nodes_response.empty() && req.units_response.empty()) {
                 auto it = std::find(net.peers.begin(), net.peers.end(), req.peer);
@@ -249,8 +328,40 @@ void xtop_state_sync::assign_table_tasks(const sync_peers & peers) {
     m_track_func(req);
 }
 
+void xtop_state_sync::assign_range_tasks(const sync_peers & peers) {
+    // ranges are requested one by one, stack trie must be fed with leaves in key order.
+    if (m_range_inflight || m_range_done || m_cancel) {
+        return;
+    }
+    common::xnode_address_t peer;
+    if (!pick_peer(peers, peer)) {
+        return;
+    }
+    base::xstream_t stream(base::xcontext_t::instance());
+    stream << m_table.value();
+    stream << m_req_sequence_id;
+    stream << m_root.to_bytes();
+    stream << m_range_origin;
+    stream << rand();
+    xinfo("xtop_state_sync::assign_range_tasks origin: %s, id: %u, {%s}", to_hex(m_range_origin).c_str(), m_req_sequence_id, symbol().c_str());
+    send_message(peers, peer, {stream.data(), stream.data() + stream.size()}, xmessage_id_sync_range_request);
+    state_req req;
+    req.peer = peer;
+    req.start = base::xtime_utl::time_now_ms();
+    req.id = m_req_sequence_id++;
+    req.type = state_req_type::enum_state_req_range;
+    req.range_origin = m_range_origin;
+    m_range_inflight = true;
+    m_track_func(req);
+}
+
 void xtop_state_sync::assign_trie_tasks(const sync_peers & peers) {
     for (;;) {
+        common::xnode_address_t peer;
+        if (!pick_peer(peers, peer)) {
+            // every peer is busy, more tasks are sent as responses come back.
+            return;
+        }
         state_req req;
         std::vector<xhash256_t> nodes;
         std::vector<xbytes_t> units;
@@ -278,14 +389,49 @@ void xtop_state_sync::assign_trie_tasks(const sync_peers & peers) {
         stream << units_bytes;
         stream << rand();
         xinfo("xtop_state_sync::assign_trie_tasks total %zu, %zu, {%s}", nodes_bytes.size(), units_bytes.size(), symbol().c_str());
-        req.peer = send_message(peers, {stream.data(), stream.data() + stream.size()}, xmessage_id_sync_trie_request);
+        send_message(peers, peer, {stream.data(), stream.data() + stream.size()}, xmessage_id_sync_trie_request);
+        req.peer = peer;
         req.start = base::xtime_utl::time_now_ms();
         req.id = m_req_sequence_id++;
         req.type = state_req_type::enum_state_req_trie;
+        m_peer_inflight[peer]++;
+        XMETRICS_COUNTER_INCREMENT("statesync_inflight_reqs", 1);
         m_track_func(req);
     }
 }
 
+bool xtop_state_sync::pick_peer(const sync_peers & peers, common::xnode_address_t & peer) {
+    // least loaded peer first. tasks come out of the scheduler in path order, so consecutive
+    // requests cover consecutive path ranges, rotating the start spreads the ranges over all peers.
+    auto const n = peers.peers.size();
+    std::size_t best{n};
+    uint32_t best_inflight{max_inflight_per_peer};
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const idx = (m_peer_cursor + i) % n;
+        auto const it = m_peer_inflight.find(peers.peers[idx]);
+        auto const inflight = (it == m_peer_inflight.end()) ? 0 : it->second;
+        if (inflight < best_inflight) {
+            best = idx;
+            best_inflight = inflight;
+        }
+    }
+    if (best == n) {
+        return false;
+    }
+    m_peer_cursor = best + 1;
+    peer = peers.peers[best];
+    return true;
+}
+
+void xtop_state_sync::send_message(const sync_peers & peers, const common::xnode_address_t & peer, const xbytes_t & msg, common::xmessage_id_t id) {
+    vnetwork::xmessage_t _msg = vnetwork::xmessage_t(msg, id);
+    std::error_code ec;
+    peers.network->send_to(peer, _msg, ec);
+    if (ec) {
+        xwarn("xtop_state_sync::send_message send net error, %s, %s", peer.account_address().c_str(), peers.network->address().account_address().c_str());
+    }
+}
+
 common::xnode_address_t xtop_state_sync::send_message(const sync_peers & peers, const xbytes_t & msg, common::xmessage_id_t id) {
     vnetwork::xmessage_t _msg = vnetwork::xmessage_t(msg, id);
     auto random_fullnode = peers.peers.at(RandomUint32() % peers.peers.size());
@@ -370,14 +516,101 @@ void xtop_state_sync::process_table(state_req & req, std::error_code & ec) {
     m_sync_table_finish = true;
 }
 
+void xtop_state_sync::process_range(state_req & req, std::error_code & ec) {
+    if (req.type != state_req_type::enum_state_req_range) {
+        return;
+    }
+    m_range_inflight = false;
+    if (req.range_origin != m_range_origin) {
+        return;
+    }
+    if (req.nodes_response.empty()) {
+        // timeout, or peer without the root or not serving ranges. the peer is dropped by loop, leave the rest to node sync.
+        xwarn("xtop_state_sync::process_range empty range from %s, origin: %s, {%s}", req.peer.to_string().c_str(), to_hex(req.range_origin).c_str(), symbol().c_str());
+        m_range_failed = true;
+        m_range_done = true;
+        return;
+    }
+    auto const proof_db = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+    std::error_code ec_internal;
+    for (auto const & blob : req.nodes_response) {
+        proof_db->Put(to_bytes(utl::xkeccak256_t::digest({blob.begin(), blob.end()})), blob, ec_internal);
+    }
+    auto const & keys = req.keys_response;
+    auto const & values = req.values_response;
+    auto const last = keys.empty() ? req.range_origin : keys.back();
+    auto const more = evm_common::trie::VerifyRangeProof(m_root, req.range_origin, last, keys, values, proof_db, ec_internal);
+    if (ec_internal) {
+        xwarn("xtop_state_sync::process_range invalid range from %s, origin: %s, leaves: %zu, %s %s, {%s}",
+              req.peer.to_string().c_str(),
+              to_hex(req.range_origin).c_str(),
+              keys.size(),
+              ec_internal.category().name(),
+              ec_internal.message().c_str(),
+              symbol().c_str());
+        if (++m_range_failures >= max_range_failures) {
+            m_range_failed = true;
+            m_range_done = true;
+        }
+        return;
+    }
+
+    auto const bytes_before = m_bytes_synced;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        m_stack_trie->Update(keys[i], values[i]);
+        if (m_sync_unit) {
+            auto hexpath = evm_common::trie::keybytesToHex(keys[i]);
+            hexpath.pop_back();  // terminator, same as leaf path reported by node sync
+            state_mpt::add_unit_entry(*m_sched, hexpath, values[i], {}, ec);
+            if (ec) {
+                xwarn("xtop_state_sync::process_range invalid leaf: %s, %s %s", to_hex(keys[i]).c_str(), ec.category().name(), ec.message().c_str());
+                return;
+            }
+        }
+        m_bytes_synced += keys[i].size() + values[i].size();
+    }
+    m_leaves_synced += keys.size();
+    XMETRICS_COUNTER_INCREMENT("statesync_range_leaves_received", keys.size());
+    XMETRICS_COUNTER_INCREMENT("statesync_range_bytes_received", m_bytes_synced - bytes_before);
+    if (m_range_batch->value_bytes() >= ideal_batch_size) {
+        flush_range_batch();
+    }
+
+    m_range_origin = last;
+    if (!more || (!keys.empty() && !next_range_key(m_range_origin))) {
+        m_range_done = true;
+    }
+}
+
+void xtop_state_sync::flush_range_batch() {
+    if (m_range_batch == nullptr || m_range_batch->data().empty()) {
+        return;
+    }
+    evm_common::trie::WriteTrieNodeBatch(m_kv_db, m_range_batch->data());
+    m_range_batch->clear();
+}
+
 void xtop_state_sync::process_trie(state_req & req, std::error_code & ec) {
     if (req.type != state_req_type::enum_state_req_trie) {
         return;
     }
+    auto const it = m_peer_inflight.find(req.peer);
+    if (it != m_peer_inflight.end() && it->second > 0) {
+        it->second--;
+        XMETRICS_COUNTER_DECREMENT("statesync_inflight_reqs", 1);
+    }
+    if (req.nodes_hash.size() != req.nodes_response.size()) {
+        req.nodes_hash.clear();
+        for (auto const & blob : req.nodes_response) {
+            req.nodes_hash.emplace_back(to_bytes(utl::xkeccak256_t::digest({blob.begin(), blob.end()})));
+        }
+    }
+    auto const bytes_before = m_bytes_synced;
     std::error_code ec_internal;
-    for (auto const & blob : req.nodes_response) {
-        xinfo("xtop_state_sync::process_trie node id: %u, blob: %s, {%s}", req.id, to_hex(blob).c_str(), symbol().c_str());
-        auto hash = process_node_data(blob, ec_internal);
+    for (std::size_t i = 0; i < req.nodes_response.size(); ++i) {
+        auto const & blob = req.nodes_response[i];
+        xdbg("xtop_state_sync::process_trie node id: %u, blob: %s, {%s}", req.id, to_hex(blob).c_str(), symbol().c_str());
+        auto hash = process_node_data(blob, req.nodes_hash[i], ec_internal);
         if (ec_internal) {
             if (ec_internal != evm_common::error::make_error_code(evm_common::error::xerrc_t::trie_sync_not_requested) &&
                 ec_internal != evm_common::error::make_error_code(evm_common::error::xerrc_t::trie_sync_already_processed)) {
@@ -388,8 +621,12 @@ void xtop_state_sync::process_trie(state_req & req, std::error_code & ec) {
                 xwarn("xtop_state_sync::process_trie process_node_data abnormal: %s, %s %s", hash.as_hex_str().c_str(), ec_internal.category().name(), ec_internal.message().c_str());      
             }
         }
+        m_node_bytes_uncommitted += blob.size();
+        m_bytes_synced += blob.size();
+        m_nodes_synced++;
         req.trie_tasks.erase(hash);
     }
+    XMETRICS_COUNTER_INCREMENT("statesync_trie_nodes_received", req.nodes_response.size());
     for (auto const & blob : req.units_response) {
         xinfo("xtop_state_sync::process_trie unit id: %u, blob size: %zu, {%s}", req.id, blob.size(), symbol().c_str());
         auto hash = process_unit_data(blob, ec_internal);
@@ -404,8 +641,12 @@ void xtop_state_sync::process_trie(state_req & req, std::error_code & ec) {
             }
         }
         m_unit_bytes_uncommitted += blob.size();
+        m_bytes_synced += blob.size();
+        m_units_synced++;
         req.unit_tasks.erase(hash);
     }
+    XMETRICS_COUNTER_INCREMENT("statesync_trie_units_received", req.units_response.size());
+    XMETRICS_COUNTER_INCREMENT("statesync_trie_bytes_received", m_bytes_synced - bytes_before);
     // retry queue
     for (auto pair : req.trie_tasks) {
         m_trie_tasks.insert(pair);
@@ -416,13 +657,76 @@ void xtop_state_sync::process_trie(state_req & req, std::error_code & ec) {
     return;
 }
 
+void xtop_state_sync::verify_nodes(std::vector<state_req> & reqs) const {
+    // hashing responses is the only part of processing not touching the scheduler, so it runs in parallel.
+    std::vector<std::pair<xbytes_t const *, xhash256_t *>> items;
+    for (auto & req : reqs) {
+        if (req.type != state_req_type::enum_state_req_trie) {
+            continue;
+        }
+        req.nodes_hash.resize(req.nodes_response.size());
+        for (std::size_t i = 0; i < req.nodes_response.size(); ++i) {
+            items.emplace_back(&req.nodes_response[i], &req.nodes_hash[i]);
+        }
+    }
+    auto hash_items = [&items](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto const & blob = *items[i].first;
+            *items[i].second = xhash256_t{to_bytes(utl::xkeccak256_t::digest({blob.begin(), blob.end()}))};
+        }
+    };
+
+    std::size_t const hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const workers = std::min(hardware_threads, items.size() / verify_nodes_per_worker);
+    if (workers <= 1) {
+        hash_items(0, items.size());
+        return;
+    }
+    auto const step = (items.size() + workers - 1) / workers;
+    std::vector<std::future<void>> futures;
+    for (std::size_t begin = step; begin < items.size(); begin += step) {
+        futures.push_back(std::async(std::launch::async, hash_items, begin, std::min(begin + step, items.size())));
+    }
+    hash_items(0, step);
+    for (auto & f : futures) {
+        f.get();
+    }
+}
+
+void xtop_state_sync::report_progress(bool force) {
+    auto const now = base::xtime_utl::time_now_ms();
+    if (!force && now < m_progress_time + progress_interval_ms) {
+        return;
+    }
+    m_progress_time = now;
+    auto const elapsed_ms = std::max<uint64_t>(now - m_start_time, 1);
+    uint32_t inflight{0};
+    for (auto const & peer : m_peer_inflight) {
+        inflight += peer.second;
+    }
+    xinfo("xtop_state_sync::report_progress leaves: %lu, nodes: %lu, units: %lu, bytes: %lu, pending: %zu, inflight: %u, peers: %zu, %lu items/s, %lu KB/s, {%s}",
+          m_leaves_synced,
+          m_nodes_synced,
+          m_units_synced,
+          m_bytes_synced,
+          m_sched->Pending(),
+          inflight,
+          m_peer_inflight.size(),
+          (m_leaves_synced + m_nodes_synced + m_units_synced) * 1000 / elapsed_ms,
+          m_bytes_synced / elapsed_ms,
+          symbol().c_str());
+}
+
 xhash256_t xtop_state_sync::process_node_data(const xbytes_t & blob, std::error_code & ec) {
+    return process_node_data(blob, xhash256_t{to_bytes(utl::xkeccak256_t::digest({blob.begin(), blob.end()}))}, ec);
+}
+
+xhash256_t xtop_state_sync::process_node_data(const xbytes_t & blob, const xhash256_t & hash, std::error_code & ec) {
     evm_common::trie::SyncResult res;
-    auto hash_bytes = to_bytes(utl::xkeccak256_t::digest({blob.begin(), blob.end()}));
-    res.Hash = xhash256_t{hash_bytes};
+    res.Hash = hash;
     res.Data = blob;
     m_sched->Process(res, ec);
-    xinfo("xtop_state_sync::process_node_data hash: %s, data: %s", res.Hash.as_hex_str().c_str(), to_hex(res.Data).c_str());
+    xdbg("xtop_state_sync::process_node_data hash: %s, data: %s", res.Hash.as_hex_str().c_str(), to_hex(res.Data).c_str());
     return res.Hash;
 }
 
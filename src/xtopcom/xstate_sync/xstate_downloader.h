@@ -66,6 +66,8 @@ private:
     void process_table_response(const vnetwork::xmessage_t & message) const;
     void process_unit_request(const vnetwork::xvnode_address_t & sender, std::shared_ptr<vnetwork::xvnetwork_driver_face_t> network, const vnetwork::xmessage_t & message) const;
     void process_unit_response(const vnetwork::xmessage_t & message) const;
+    void process_range_request(const vnetwork::xvnode_address_t & sender, std::shared_ptr<vnetwork::xvnetwork_driver_face_t> network, const vnetwork::xmessage_t & message) const;
+    void process_range_response(const vnetwork::xmessage_t & message) const;
     void process_trie_finish(const sync_result & res);
     void process_unit_finish(const sync_result & res);
 };
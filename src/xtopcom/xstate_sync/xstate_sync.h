@@ -5,7 +5,9 @@
 #pragma once
 
 #include "xbasic/xsimple_message.hpp"
+#include "xevm_common/trie/xstack_trie.h"
 #include "xevm_common/trie/xtrie_kv_db.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
 #include "xevm_common/trie/xtrie_sync.h"
 #include "xstate_sync/xstate_sync_face.h"
 #include "xvnetwork/xmessage.h"
@@ -19,6 +21,12 @@ namespace top {
 namespace state_sync {
 
 class xtop_state_sync : public xstate_sync_face_t {
+public:
+    // trie requests kept in flight to each peer, so a peer is never idle waiting for the round trip of its last response.
+    static constexpr uint32_t max_inflight_per_peer{4};
+    // invalid range responses tolerated before leaving the rest of the trie to node sync.
+    static constexpr uint32_t max_range_failures{3};
+
 private:
 #if !defined(NDEBUG)
     std::thread::id running_thead_id_;
@@ -31,6 +39,7 @@ private:
     xhash256_t m_root;
     std::string m_symbol;
     base::xvdbstore_t * m_db{nullptr};
+    bool m_sync_unit{false};
     evm_common::trie::xkv_db_face_ptr_t m_kv_db{nullptr};
     std::shared_ptr<evm_common::trie::Sync> m_sched{nullptr};
     std::function<sync_peers(const common::xtable_id_t & id)> m_peers_func{nullptr};
@@ -50,6 +59,27 @@ private:
     uint32_t m_items_per_task{0};
     uint32_t m_req_sequence_id{0};
     uint32_t m_unit_bytes_uncommitted{0};
+    uint32_t m_node_bytes_uncommitted{0};
+
+    // range sync: leaves are downloaded in key order and rebuilt by stack trie, nodes buffered in m_range_batch.
+    std::shared_ptr<evm_common::trie::xstack_trie_t> m_stack_trie{nullptr};
+    std::shared_ptr<evm_common::trie::xmemory_kv_db_t> m_range_batch{nullptr};
+    xbytes_t m_range_origin;
+    bool m_range_inflight{false};
+    bool m_range_done{false};
+    bool m_range_failed{false};
+    uint32_t m_range_failures{0};
+
+    std::map<common::xnode_address_t, uint32_t> m_peer_inflight;  // trie requests in flight per peer
+    std::size_t m_peer_cursor{0};
+
+    // progress
+    uint64_t m_start_time{0};
+    uint64_t m_progress_time{0};
+    uint64_t m_nodes_synced{0};
+    uint64_t m_units_synced{0};
+    uint64_t m_leaves_synced{0};
+    uint64_t m_bytes_synced{0};
 
 public:
     xtop_state_sync();
@@ -76,16 +106,25 @@ public:
 private:
     void wait() const;
     void sync_table(std::error_code & ec);
+    void sync_range(std::error_code & ec);
     void sync_trie(std::error_code & ec);
     void loop(std::function<bool()> condition, std::function<void(sync_peers const &)> add_task, std::function<void(state_req &, std::error_code &)> process, std::error_code & ec);
     void assign_table_tasks(const sync_peers & sync_peers);
+    void assign_range_tasks(const sync_peers & sync_peers);
     void assign_trie_tasks(const sync_peers & sync_peers);
+    bool pick_peer(const sync_peers & sync_peers, common::xnode_address_t & peer);
     void fill_tasks(uint32_t n, state_req & req, std::vector<xhash256_t> & nodes, std::vector<xbytes_t> & units);
     void process_table(state_req & req, std::error_code & ec);
+    void process_range(state_req & req, std::error_code & ec);
     void process_trie(state_req & req, std::error_code & ec);
+    void flush_range_batch();
+    void verify_nodes(std::vector<state_req> & reqs) const;
+    void report_progress(bool force);
     xhash256_t process_node_data(const xbytes_t & blob, std::error_code & ec);
+    xhash256_t process_node_data(const xbytes_t & blob, const xhash256_t & hash, std::error_code & ec);
     xhash256_t process_unit_data(const xbytes_t & blob, std::error_code & ec);
     common::xnode_address_t send_message(const sync_peers & sync_peers, const xbytes_t & msg, common::xmessage_id_t id);
+    void send_message(const sync_peers & sync_peers, const common::xnode_address_t & peer, const xbytes_t & msg, common::xmessage_id_t id);
 };
 using xstate_sync_t = xtop_state_sync;
 
@@ -18,6 +18,8 @@ XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_table_request, 0x0
 XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_table_response, 0x04);
 XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_unit_request, 0x05);
 XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_unit_response, 0x06);
+XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_range_request, 0x07);
+XDEFINE_MSG_ID(xmessage_category_state_sync, xmessage_id_sync_range_response, 0x08);
 
 struct sync_result {
     common::xaccount_address_t account;
@@ -42,6 +44,7 @@ enum class state_req_type {
     enum_state_req_table,
     enum_state_req_trie,
     enum_state_req_unit,
+    enum_state_req_range,
 };
 
 struct state_req {
@@ -54,13 +57,19 @@ struct state_req {
     uint64_t start{0};
     uint64_t delivered{0};
     std::vector<xbytes_t> nodes_response;
+    std::vector<xhash256_t> nodes_hash;  // keccak of nodes_response, filled by syncer in batch before processing
     std::vector<xbytes_t> units_response;
+    xbytes_t range_origin;                 // first key of requested leaves range
+    std::vector<xbytes_t> keys_response;   // leaves range, with boundary proofs in nodes_response
+    std::vector<xbytes_t> values_response;
 };
 
 struct state_res {
     uint32_t id;
     std::vector<xbytes_t> nodes;
     std::vector<xbytes_t> units;
+    std::vector<xbytes_t> keys;
+    std::vector<xbytes_t> values;
 };
 
 class xtop_state_sync_face {
@@ -3,6 +3,11 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
 #include "xbasic/xmemory.hpp"
 #include "xvledger/xvstate.h"
 #include "xvledger/xvblock.h"
@@ -17,6 +22,9 @@
 #include "xstatectx/xstatectx_face.h"
 #include "xstatectx/xstatectx.h"
 #include "xstatestore/xstatestore_face.h"
+#include "xstate_mpt/xstate_mpt_reader.h"
+#include "xmetrics/xhot_accounts.h"
+#include "xmetrics/xmetrics.h"
 
 NS_BEG2(top, statectx)
 
@@ -37,6 +45,10 @@ xstatectx_t::xstatectx_t(base::xvblock_t* prev_block, const statestore::xtablest
     m_prev_tablestate_ext = tablestate;
 }
 
+xstatectx_t::~xstatectx_t() {
+    wait_async_prefetch();
+}
+
 bool xstatectx_t::is_same_table(const base::xvaccount_t & addr) const {
     return get_tableid() == addr.get_short_table_id();
 }
@@ -110,6 +122,9 @@ xunitstate_ctx_ptr_t xstatectx_t::load_unit_ctx(const base::xvaccount_t & addr)
 
         data::xunitstate_ptr_t unitstate_proposal = std::make_shared<data::xunit_bstate_t>(bstate.get(), false);  // modify-state
         unit_ctx = std::make_shared<xunitstate_ctx_t>(unitstate_proposal, unitblock);
+        if (XMETRICS_HOT_ACCOUNT_SAMPLED()) {
+            XMETRICS_HOT_ACCOUNT(state_loads, get_table_address(), addr.get_account(), 1);
+        }
         xdbg("xstatectx_t::load_unit_ctx succ-return unit unitstate.table=%s,account=%s,index=%s", m_prev_tablestate_ext->get_table_state()->get_bstate()->dump().c_str(), addr.get_account().c_str(), account_index.dump().c_str());
     } else { // different table unit state is readonly        
         data::xunitstate_ptr_t unitstate = m_statectx_base.load_different_table_unit_state(addr);
@@ -134,6 +149,102 @@ data::xunitstate_ptr_t xstatectx_t::load_unit_state(const base::xvaccount_t & ad
     return nullptr;
 }
 
+std::vector<std::string> xstatectx_t::get_prefetch_accounts(const std::vector<std::string> & accounts) {
+    // only same-table unit states are loaded by account index, other table states are readonly and rarely used
+    std::set<std::string> unique_accounts;
+    for (auto & account : accounts) {
+        base::xvaccount_t vaccount(account);
+        if (is_same_table(vaccount) && nullptr == find_unit_ctx(account, true)) {
+            unique_accounts.insert(account);
+        }
+    }
+    if (unique_accounts.size() < enum_min_prefetch_accounts) {
+        return {};
+    }
+    return std::vector<std::string>(unique_accounts.begin(), unique_accounts.end());
+}
+
+std::shared_ptr<state_mpt::xstate_mpt_reader_t> xstatectx_t::create_prefetch_reader() const {
+    // the reader views the same committed root as prev table state, it is lock-free and never touches this context.
+    // unit states loaded by workers only go to statestore cache, so load_unit_ctx later stays the only writer of context
+    std::error_code ec;
+    auto reader = state_mpt::xstate_mpt_reader_t::create(common::xaccount_address_t(get_table_address()),
+                                                         m_prev_tablestate_ext->get_state_mpt()->get_original_root_hash(),
+                                                         base::xvchain_t::instance().get_xdbstore(),
+                                                         ec);
+    if (nullptr == reader) {
+        xwarn("xstatectx_t::create_prefetch_reader fail-create reader.table=%s,ec=%s", get_table_address().c_str(), ec.message().c_str());
+    }
+    return reader;
+}
+
+void xstatectx_t::load_unit_states_by_reader(const std::shared_ptr<state_mpt::xstate_mpt_reader_t> & reader, const std::vector<std::string> & prefetch_accounts) {
+    std::atomic<size_t> next_index{0};
+    std::atomic<size_t> loaded_count{0};
+    auto worker = [&]() {
+        for (size_t i = next_index.fetch_add(1); i < prefetch_accounts.size(); i = next_index.fetch_add(1)) {
+            std::error_code _ec;
+            common::xaccount_address_t account_address(prefetch_accounts[i]);
+            base::xaccount_index_t account_index = reader->get_account_index(account_address, _ec);
+            if (_ec || account_index.get_latest_unit_height() == 0) {
+                continue;  // let load_unit_ctx handle not found or error account
+            }
+            if (nullptr != statestore::xstatestore_hub_t::instance()->get_unit_state_by_accountindex(account_address, account_index)) {
+                loaded_count.fetch_add(1);
+            }
+        }
+    };
+
+    size_t hardware_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t thread_count = std::min<size_t>({hardware_threads, (size_t)enum_max_prefetch_threads, prefetch_accounts.size() / enum_min_prefetch_accounts});
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto & t : threads) {
+        t.join();
+    }
+    XMETRICS_GAUGE(metrics::statectx_prefetch_unitstate, loaded_count.load());
+    xdbg("xstatectx_t::load_unit_states_by_reader accounts=%zu,loaded=%zu,threads=%zu", prefetch_accounts.size(), loaded_count.load(), thread_count);
+}
+
+void xstatectx_t::prefetch_unit_states(const std::vector<std::string> & accounts) {
+    // accounts already warmed by async prefetch are quickly hit in statestore cache
+    wait_async_prefetch();
+    std::vector<std::string> prefetch_accounts = get_prefetch_accounts(accounts);
+    if (prefetch_accounts.empty()) {
+        return;
+    }
+    auto reader = create_prefetch_reader();
+    if (nullptr == reader) {
+        return;
+    }
+    load_unit_states_by_reader(reader, prefetch_accounts);
+}
+
+void xstatectx_t::async_prefetch_unit_states(const std::vector<std::string> & accounts) {
+    wait_async_prefetch();
+    std::vector<std::string> prefetch_accounts = get_prefetch_accounts(accounts);
+    if (prefetch_accounts.empty()) {
+        return;
+    }
+    auto reader = create_prefetch_reader();
+    if (nullptr == reader) {
+        return;
+    }
+    // the thread only holds its own copies, it is joined before next prefetch or at destruction
+    m_prefetch_thread = std::thread([reader, prefetch_accounts]() {
+        load_unit_states_by_reader(reader, prefetch_accounts);
+    });
+}
+
+void xstatectx_t::wait_async_prefetch() {
+    if (m_prefetch_thread.joinable()) {
+        m_prefetch_thread.join();
+    }
+}
+
 data::xunitstate_ptr_t xstatectx_t::load_commit_unit_state(const base::xvaccount_t & addr) {
     bool is_same = is_same_table(addr);
     data::xunitstate_ptr_t unitstate = nullptr;
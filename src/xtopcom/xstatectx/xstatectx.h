@@ -5,6 +5,8 @@
 #pragma once
 
 #include <string>
+#include <thread>
+#include <vector>
 #include "xbasic/xmemory.hpp"
 #include "xvledger/xvstate.h"
 #include "xvledger/xvblock.h"
@@ -16,6 +18,7 @@
 #include "xstatectx/xunitstate_ctx.h"
 #include "xstatectx/xstatectx_face.h"
 #include "xstatectx/xstatectx_base.h"
+#include "xstate_mpt/xstate_mpt_reader.h"
 
 NS_BEG2(top, statectx)
 
@@ -23,6 +26,7 @@ NS_BEG2(top, statectx)
 class xstatectx_t : public xstatectx_face_t {
  public:
     xstatectx_t(base::xvblock_t* prev_block, const statestore::xtablestate_ext_ptr_t & prev_table_state, base::xvblock_t* commit_block, const statestore::xtablestate_ext_ptr_t & commit_table_state, const xstatectx_para_t & para);
+    ~xstatectx_t();
  public:// APIs for vm & tx executor
     const data::xtablestate_ptr_t &     get_table_state() const override;
     data::xunitstate_ptr_t              load_unit_state(const base::xvaccount_t & addr) override;
@@ -33,12 +37,23 @@ class xstatectx_t : public xstatectx_face_t {
     void                                do_commit(base::xvblock_t* current_blockc) override;
     std::string                         get_table_address() const override {return m_table_ctx->get_table_address();}
     bool                                is_state_dirty() const override;
+    void                                prefetch_unit_states(const std::vector<std::string> & accounts) override;
+    // start prefetch at background and return at once, e.g. overlap state reads with preparing txs
+    void                                async_prefetch_unit_states(const std::vector<std::string> & accounts);
     base::xtable_shortid_t              get_tableid() const {return m_table_ctx->get_tableid();}
     std::vector<xunitstate_ctx_ptr_t>   get_modified_unit_ctx() const;
     statestore::xtablestate_ext_ptr_t const&   get_prev_tablestate_ext() const {return m_prev_tablestate_ext;}
 
  private:
+    enum {
+        enum_min_prefetch_accounts = 4,    // too few accounts is not worth to start threads
+        enum_max_prefetch_threads = 4,
+    };
     xunitstate_ctx_ptr_t    load_unit_ctx(const base::xvaccount_t & addr);
+    std::vector<std::string>    get_prefetch_accounts(const std::vector<std::string> & accounts);
+    std::shared_ptr<state_mpt::xstate_mpt_reader_t> create_prefetch_reader() const;
+    static void             load_unit_states_by_reader(const std::shared_ptr<state_mpt::xstate_mpt_reader_t> & reader, const std::vector<std::string> & prefetch_accounts);
+    void                    wait_async_prefetch();
     xunitstate_ctx_ptr_t    find_unit_ctx(const std::string & addr, bool is_same_table);
     void                    add_unit_ctx(const std::string & addr, bool is_same_table, const xunitstate_ctx_ptr_t & unit_ctx);
     bool                    is_same_table(const base::xvaccount_t & addr) const;
@@ -50,6 +65,7 @@ class xstatectx_t : public xstatectx_face_t {
     xtablestate_ctx_ptr_t   m_table_ctx{nullptr};
     std::map<std::string, xunitstate_ctx_ptr_t>   m_unit_ctxs;
     std::map<std::string, xunitstate_ctx_ptr_t>   m_other_table_unit_ctxs;
+    std::thread             m_prefetch_thread;
 };
 using xstatectx_ptr_t = std::shared_ptr<xstatectx_t>;
 
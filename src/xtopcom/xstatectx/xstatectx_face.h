@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "xbasic/xmemory.hpp"
 #include "xvledger/xvstate.h"
 #include "xvledger/xvblock.h"
@@ -40,6 +41,8 @@ class xstatectx_face_t {
     virtual void                    do_commit(base::xvblock_t* current_block) {return;}  // TODO(jimmy) do commit changed state to db
     virtual std::string             get_table_address() const = 0;
     virtual bool                    is_state_dirty() const = 0;
+    // warm up states of accounts which will be loaded later, it must not change any state of context
+    virtual void                    prefetch_unit_states(const std::vector<std::string> & accounts) {return;}
 };
 using xstatectx_face_ptr_t = std::shared_ptr<xstatectx_face_t>;
 
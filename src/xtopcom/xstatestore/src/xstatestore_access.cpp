@@ -4,12 +4,15 @@
 
 #include <string>
 #include "xbasic/xmemory.hpp"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xstatestore/xstatestore_access.h"
 #include "xstatestore/xerror.h"
+#include "xstatestore/xunitstate_cache.h"
 
 NS_BEG2(top, statestore)
 
-xstatestore_cache_t::xstatestore_cache_t() : m_tablestate_cache(enum_max_table_state_lru_cache_max), m_unitstate_cache(enum_max_unit_state_lru_cache_max) {
+xstatestore_cache_t::xstatestore_cache_t() : m_tablestate_cache(enum_max_table_state_lru_cache_max) {
 
 }
 
@@ -36,18 +39,6 @@ void xstatestore_cache_t::set_tablestate(std::string const& block_hash, xtablest
     xdbg("xstatestore_cache_t::set_tablestate hash=%s,state=%s", base::xstring_utl::to_hex(block_hash).c_str(), state->get_table_state()->get_bstate()->dump().c_str());
 }
 
-data::xunitstate_ptr_t xstatestore_cache_t::get_unitstate(std::string const& block_hash) const {
-    data::xunitstate_ptr_t state = nullptr;
-    m_unitstate_cache.get(block_hash, state);
-    XMETRICS_GAUGE(metrics::statestore_get_unit_state_from_cache, state != nullptr ? 1 : 0);
-    return state;
-}
-
-void xstatestore_cache_t::set_unitstate(std::string const& block_hash, data::xunitstate_ptr_t const& state) const {
-    m_unitstate_cache.put(block_hash, state);
-    xdbg("xstatestore_cache_t::set_unitstate hash=%s,state=%s", base::xstring_utl::to_hex(block_hash).c_str(), state->get_bstate()->dump().c_str());
-}
-
 
 //============================xstatestore_dbaccess_t============================
 void xstatestore_dbaccess_t::write_table_bstate(common::xaccount_address_t const& address, data::xtablestate_ptr_t const& tablestate, const std::string & block_hash, std::error_code & ec) const {
@@ -68,8 +59,13 @@ void xstatestore_dbaccess_t::write_table_bstate(common::xaccount_address_t const
 }
 
 data::xtablestate_ptr_t xstatestore_dbaccess_t::read_table_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash) const {
-    const std::string state_db_key = base::xvdbkey_t::create_prunable_state_key(address.vaccount(), height, block_hash);
-    const std::string state_db_bin = m_statestore_base.get_dbstore()->get_value(state_db_key);
+    std::string state_db_key = base::xvdbkey_t::create_prunable_state_key(address.vaccount(), height, block_hash);
+    std::string state_db_bin = m_statestore_base.get_dbstore()->get_value(state_db_key);
+    if(state_db_bin.empty()) {
+        // written before table states moved to the state height key
+        state_db_key = base::xvdbkey_t::create_prunable_state_key_old(address.vaccount(), height, block_hash);
+        state_db_bin = m_statestore_base.get_dbstore()->get_value(state_db_key);
+    }
     if(state_db_bin.empty()) {
         XMETRICS_GAUGE(metrics::statestore_get_table_state_from_db, 0);
         xwarn("xstatestore_dbaccess_t::read_table_bstate,fail to read from db for account=%s,height=%ld,hash=%s",address.value().c_str(), height, base::xstring_utl::to_hex(block_hash).c_str());
@@ -92,35 +88,59 @@ data::xtablestate_ptr_t xstatestore_dbaccess_t::read_table_bstate(common::xaccou
     return tablestate;
 }
 
-void xstatestore_dbaccess_t::write_unit_bstate(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec) const {
+std::size_t xstatestore_dbaccess_t::write_unit_bstate(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec, data::xunitstate_ptr_t const& base_unitstate, std::size_t base_state_bytes) const {
     XMETRICS_GAUGE(metrics::store_state_unit_write, 1);
+    uint32_t const snapshot_interval = XGET_CONFIG(unitstate_snapshot_interval);
+    if (snapshot_interval > 0 && (unitstate->height() % snapshot_interval) != 0 && nullptr != base_unitstate && base_unitstate->height() + 1 == unitstate->height()) {
+        std::string delta_bin;
+        if (unitstate->get_bstate()->take_delta(*base_unitstate->get_bstate(), delta_bin)) {
+            std::string state_db_key = base::xvdbkey_t::create_prunable_unit_state_delta_key(unitstate->account_address().vaccount(), unitstate->height(), block_hash);
+            if (m_statestore_base.get_dbstore()->set_value(state_db_key, delta_bin)) {
+                xinfo("xstatestore_dbaccess_t::write_unit_bstate succ delta.state=%s,hash=%s,size=%zu",unitstate->get_bstate()->dump().c_str(),base::xstring_utl::to_hex(block_hash).c_str(),delta_bin.size());
+                // the state in memory is as large as the base one besides the changes
+                return base_state_bytes + delta_bin.size();
+            }
+            ec = error::xerrc_t::statestore_db_write_err;
+            xerror("xstatestore_dbaccess_t::write_unit_bstate fail delta.state=%s",unitstate->get_bstate()->dump().c_str());
+            return 0;
+        }
+        // the full state is written instead
+        xwarn("xstatestore_dbaccess_t::write_unit_bstate fail take delta.state=%s",unitstate->get_bstate()->dump().c_str());
+    }
+
     std::string state_db_key = base::xvdbkey_t::create_prunable_unit_state_key(unitstate->account_address().vaccount(), unitstate->height(), block_hash);
     std::string state_db_bin;
     int32_t ret = unitstate->get_bstate()->serialize_to_string(state_db_bin);
     if(ret > 0) {
         if (m_statestore_base.get_dbstore()->set_value(state_db_key, state_db_bin)) {
             xinfo("xstatestore_dbaccess_t::write_unit_bstate succ.state=%s,hash=%s",unitstate->get_bstate()->dump().c_str(),base::xstring_utl::to_hex(block_hash).c_str());
-            return;
+            return state_db_bin.size();
         }
     }
     ec = error::xerrc_t::statestore_db_write_err;
     xerror("xstatestore_dbaccess_t::write_unit_bstate fail.state=%s",unitstate->get_bstate()->dump().c_str());
+    return 0;
 }
 
-data::xunitstate_ptr_t xstatestore_dbaccess_t::read_unit_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash) const {
+data::xunitstate_ptr_t xstatestore_dbaccess_t::read_unit_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash, std::size_t * state_bytes) const {
     std::string state_db_key = base::xvdbkey_t::create_prunable_unit_state_key(address.vaccount(), height, block_hash);
     const std::string state_db_bin = m_statestore_base.get_dbstore()->get_value(state_db_key);
+    std::size_t db_state_bytes = state_db_bin.size();
+    base::xauto_ptr<base::xvbstate_t> state_ptr = nullptr;
     if(state_db_bin.empty()) {
-        XMETRICS_GAUGE(metrics::statestore_get_unit_state_from_db, 0);
-        xwarn("xstatestore_dbaccess_t::read_unit_bstate,fail to read from db for account=%s,hash=%s",address.value().c_str(), base::xstring_utl::to_hex(block_hash).c_str());
-        return nullptr;
-    }
-
-    base::xauto_ptr<base::xvbstate_t> state_ptr = base::xvblock_t::create_state_object(state_db_bin);
-    if(nullptr == state_ptr) {//remove the error data for invalid data
-        m_statestore_base.get_dbstore()->delete_value(state_db_key);
-        xerror("xstatestore_dbaccess_t::read_unit_bstate,fail invalid data at db for account=%s,hash=%s",address.value().c_str(), base::xstring_utl::to_hex(block_hash).c_str());
-        return nullptr;
+        state_ptr = read_unit_bstate_from_delta(address, height, block_hash, XGET_CONFIG(unitstate_snapshot_interval), db_state_bytes);
+        if(nullptr == state_ptr) {
+            XMETRICS_GAUGE(metrics::statestore_get_unit_state_from_db, 0);
+            xwarn("xstatestore_dbaccess_t::read_unit_bstate,fail to read from db for account=%s,hash=%s",address.value().c_str(), base::xstring_utl::to_hex(block_hash).c_str());
+            return nullptr;
+        }
+    } else {
+        state_ptr = base::xvblock_t::create_state_object(state_db_bin);
+        if(nullptr == state_ptr) {//remove the error data for invalid data
+            m_statestore_base.get_dbstore()->delete_value(state_db_key);
+            xerror("xstatestore_dbaccess_t::read_unit_bstate,fail invalid data at db for account=%s,hash=%s",address.value().c_str(), base::xstring_utl::to_hex(block_hash).c_str());
+            return nullptr;
+        }
     }
     if(state_ptr->get_address() != address.value()) {
         xerror("xstatestore_dbaccess_t::read_unit_bstate,fail bad state(%s) vs ask(account:%s) ",state_ptr->dump().c_str(),address.value().c_str());
@@ -129,9 +149,49 @@ data::xunitstate_ptr_t xstatestore_dbaccess_t::read_unit_bstate(common::xaccount
     XMETRICS_GAUGE(metrics::statestore_get_unit_state_from_db, 1);
     xdbg("xstatestore_dbaccess_t::read_unit_bstate succ.account=%s,hash=%s",address.value().c_str(),  base::xstring_utl::to_hex(block_hash).c_str());
     data::xunitstate_ptr_t unitstate = std::make_shared<data::xunit_bstate_t>(state_ptr.get());
+    if (nullptr != state_bytes) {
+        *state_bytes = db_state_bytes;
+    }
     return unitstate;
 }
 
+base::xauto_ptr<base::xvbstate_t> xstatestore_dbaccess_t::read_unit_bstate_from_delta(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash, uint32_t max_depth, std::size_t & state_bytes) const {
+    // a delta goes back to the full state of the last snapshot height, deeper is a broken chain
+    if (0 == max_depth || 0 == height) {
+        return nullptr;
+    }
+    std::string delta_db_key = base::xvdbkey_t::create_prunable_unit_state_delta_key(address.vaccount(), height, block_hash);
+    const std::string delta_db_bin = m_statestore_base.get_dbstore()->get_value(delta_db_key);
+    if (delta_db_bin.empty()) {
+        return nullptr;
+    }
+    const std::string base_block_hash = base::xvbstate_t::get_delta_base_hash(delta_db_bin);
+    if (base_block_hash.empty()) {
+        xerror("xstatestore_dbaccess_t::read_unit_bstate_from_delta,fail invalid delta at db for account=%s,hash=%s",address.value().c_str(), base::xstring_utl::to_hex(block_hash).c_str());
+        return nullptr;
+    }
+
+    base::xauto_ptr<base::xvbstate_t> base_state = nullptr;
+    std::string state_db_key = base::xvdbkey_t::create_prunable_unit_state_key(address.vaccount(), height - 1, base_block_hash);
+    const std::string state_db_bin = m_statestore_base.get_dbstore()->get_value(state_db_key);
+    if (!state_db_bin.empty()) {
+        base_state = base::xvblock_t::create_state_object(state_db_bin);
+        state_bytes = state_db_bin.size();
+    } else {
+        base_state = read_unit_bstate_from_delta(address, height - 1, base_block_hash, max_depth - 1, state_bytes);
+    }
+    if (nullptr == base_state || base_state->get_address() != address.value()) {
+        xwarn("xstatestore_dbaccess_t::read_unit_bstate_from_delta,fail to read base for account=%s,height=%llu",address.value().c_str(), height);
+        return nullptr;
+    }
+
+    base::xauto_ptr<base::xvbstate_t> state_ptr(base::xvbstate_t::create_from_delta(*base_state, delta_db_bin));
+    if (nullptr != state_ptr) {
+        state_bytes += delta_db_bin.size();
+    }
+    return state_ptr;
+}
+
 
 //============================xstatestore_accessor_t============================
 xstatestore_accessor_t::xstatestore_accessor_t(common::xaccount_address_t const& address)
@@ -172,15 +232,34 @@ xtablestate_ext_ptr_t xstatestore_accessor_t::read_table_bstate(common::xaccount
     if (nullptr != tablestate) {
         return tablestate;
     }
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        auto iter = m_pending_tablestates.find(block->get_block_hash());
+        if (iter != m_pending_tablestates.end()) {
+            return iter->second;
+        }
+    }
     return read_table_bstate_from_db(address, block);
 }
 
 data::xunitstate_ptr_t xstatestore_accessor_t::read_unit_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash) const {
-    data::xunitstate_ptr_t unitstate = m_state_cache.get_unitstate(block_hash);
+    data::xunitstate_ptr_t unitstate = xunitstate_cache_t::instance().get(m_table_addr, block_hash);
     if (nullptr != unitstate) {
         return unitstate;
     }
-    return m_dbaccess.read_unit_bstate(address, height, block_hash);
+    {
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        auto iter = m_pending_unitstates.find(block_hash);
+        if (iter != m_pending_unitstates.end()) {
+            return iter->second;
+        }
+    }
+    std::size_t state_bytes = 0;
+    unitstate = m_dbaccess.read_unit_bstate(address, height, block_hash, &state_bytes);
+    if (nullptr != unitstate) {
+        xunitstate_cache_t::instance().put(m_table_addr, block_hash, unitstate, state_bytes, false);
+    }
+    return unitstate;
 }
 
 void xstatestore_accessor_t::set_latest_connectted_tablestate(xtablestate_ext_ptr_t const& tablestate) const {
@@ -198,12 +277,35 @@ void xstatestore_accessor_t::write_table_bstate_to_cache(common::xaccount_addres
     m_state_cache.set_tablestate(block_hash, state);
 }
 
-void xstatestore_accessor_t::write_unitstate_to_db(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec) const {
-    m_dbaccess.write_unit_bstate(unitstate, block_hash, ec);
+std::size_t xstatestore_accessor_t::write_unitstate_to_db(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec) const {
+    // the state of the previous unit block is the base of the delta, it is in the cache after its own write
+    std::size_t base_state_bytes = 0;
+    data::xunitstate_ptr_t base_unitstate = nullptr;
+    if (XGET_CONFIG(unitstate_snapshot_interval) > 0 && unitstate->height() > 0) {
+        base_unitstate = xunitstate_cache_t::instance().get(m_table_addr, unitstate->get_bstate()->get_last_block_hash(), &base_state_bytes);
+    }
+    return m_dbaccess.write_unit_bstate(unitstate, block_hash, ec, base_unitstate, base_state_bytes);
+}
+
+void xstatestore_accessor_t::write_unitstate_to_cache(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::size_t state_bytes) const {
+    xunitstate_cache_t::instance().put(m_table_addr, block_hash, unitstate, state_bytes, true);
+    xdbg("xstatestore_accessor_t::write_unitstate_to_cache hash=%s,state=%s", base::xstring_utl::to_hex(block_hash).c_str(), unitstate->get_bstate()->dump().c_str());
+}
+
+void xstatestore_accessor_t::add_pending_states(std::string const& block_hash, xtablestate_ext_ptr_t const& tablestate, std::vector<std::pair<data::xunitstate_ptr_t, std::string>> const& unitstates) const {
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    m_pending_tablestates[block_hash] = tablestate;
+    for (auto & v : unitstates) {
+        m_pending_unitstates[v.second] = v.first;
+    }
 }
 
-void xstatestore_accessor_t::write_unitstate_to_cache(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash) const {
-    m_state_cache.set_unitstate(block_hash, unitstate);
+void xstatestore_accessor_t::remove_pending_states(std::string const& block_hash, std::vector<std::pair<data::xunitstate_ptr_t, std::string>> const& unitstates) const {
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    m_pending_tablestates.erase(block_hash);
+    for (auto & v : unitstates) {
+        m_pending_unitstates.erase(v.second);
+    }
 }
 
 
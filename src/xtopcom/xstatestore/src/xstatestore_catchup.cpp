@@ -0,0 +1,114 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xstatestore/xstatestore_catchup.h"
+
+#include "xbase/xlog.h"
+#include "xmetrics/xmetrics.h"
+
+#include <algorithm>
+#include <chrono>
+
+NS_BEG2(top, statestore)
+
+xstatestore_catchup_t::xstatestore_catchup_t(std::map<std::string, xstatestore_table_ptr_t> const & tables) : m_tables(tables) {
+    for (auto const & table : m_tables) {
+        m_pending_tables.push_back(table.first);
+    }
+}
+
+xstatestore_catchup_t::~xstatestore_catchup_t() {
+    stop();
+}
+
+void xstatestore_catchup_t::start(uint32_t thread_count) {
+    thread_count = std::min<uint32_t>(thread_count, static_cast<uint32_t>(m_tables.size()));
+    xinfo("xstatestore_catchup_t::start tables:%zu,threads:%u", m_tables.size(), thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        m_threads.emplace_back([this] { run(); });
+    }
+}
+
+void xstatestore_catchup_t::stop() {
+    // the table running stops after its current batch, the rest are executed on demand as before
+    m_stop = true;
+    for (auto & thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void xstatestore_catchup_t::prioritize(std::vector<common::xaccount_address_t> const & table_addrs) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    for (auto it = table_addrs.rbegin(); it != table_addrs.rend(); ++it) {
+        auto pending = std::find(m_pending_tables.begin(), m_pending_tables.end(), it->value());
+        if (pending == m_pending_tables.end()) {
+            continue;
+        }
+        m_pending_tables.erase(pending);
+        m_pending_tables.push_front(it->value());
+    }
+}
+
+std::size_t xstatestore_catchup_t::pending_table_count() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_pending_tables.size();
+}
+
+std::size_t xstatestore_catchup_t::done_table_count() const {
+    return m_done_tables.load();
+}
+
+void xstatestore_catchup_t::run() {
+    while (!m_stop) {
+        std::string table_addr;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_pending_tables.empty()) {
+                return;
+            }
+            table_addr = m_pending_tables.front();
+            m_pending_tables.pop_front();
+        }
+        catch_up(m_tables.at(table_addr));
+        m_done_tables++;
+        export_metrics();
+    }
+}
+
+void xstatestore_catchup_t::catch_up(xstatestore_table_ptr_t const & table) {
+    auto const begin = std::chrono::steady_clock::now();
+    auto const & table_addr = table->get_table_address();
+    uint64_t const committed_height = m_store_base.get_latest_committed_block_height(table_addr);
+    uint64_t const old_height = table->get_latest_executed_block_height();
+    uint64_t height = old_height;
+    // each batch holds the execute lock of the table shortly, blocks committed meanwhile are still executed by the event thread
+    while (!m_stop && height < committed_height) {
+        uint64_t const new_height = table->catch_up_execute_height();
+        if (new_height <= height) {
+            break;
+        }
+        m_executed_blocks += new_height - height;
+        height = new_height;
+    }
+    auto const time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    xinfo("xstatestore_catchup_t::catch_up table:%s,execute height:%llu->%llu,committed height:%llu,time_ms:%lld",
+          table_addr.value().c_str(),
+          old_height,
+          height,
+          committed_height,
+          static_cast<long long>(time_ms));
+}
+
+void xstatestore_catchup_t::export_metrics() const {
+#ifdef ENABLE_METRICS
+    XMETRICS_COUNTER_SET("statestore_catchup_pending_tables", static_cast<int64_t>(pending_table_count()));
+    XMETRICS_COUNTER_SET("statestore_catchup_done_tables", static_cast<int64_t>(done_table_count()));
+    XMETRICS_COUNTER_SET("statestore_catchup_executed_blocks", static_cast<int64_t>(m_executed_blocks.load()));
+#endif
+}
+
+NS_END2
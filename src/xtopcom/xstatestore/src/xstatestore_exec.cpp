@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <string>
 #include "xbase/xutl.h"
 #include "xbasic/xmemory.hpp"
@@ -10,6 +11,9 @@
 #include "xmbus/xevent_behind.h"
 #include "xstatestore/xstatestore_exec.h"
 #include "xstatestore/xerror.h"
+#include "xstatestore/xstatestore_writer.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xvledger/xvledger.h"
 
 NS_BEG2(top, statestore)
@@ -21,8 +25,21 @@ xstatestore_executor_t::xstatestore_executor_t(common::xaccount_address_t const&
 
 }
 
+xstatestore_executor_t::~xstatestore_executor_t() {
+    wait_states_written();
+}
+
+void xstatestore_executor_t::wait_states_written() const {
+    std::unique_lock<std::mutex> lock(m_write_behind_lock);
+    m_write_behind_cond.wait(lock, [this] { return m_write_behind_blocks == 0; });
+}
+
 void xstatestore_executor_t::init() {
     uint64_t old_executed_height = m_statestore_base.get_latest_executed_block_height(m_table_addr);
+    {
+        std::lock_guard<std::mutex> l(m_write_behind_lock);
+        m_persisted_height = old_executed_height;
+    }
     recover_execute_height(old_executed_height);
 }
 
@@ -99,14 +116,31 @@ void xstatestore_executor_t::on_table_block_committed(base::xvblock_t* block) co
     }
 }
 
-void xstatestore_executor_t::update_latest_executed_info(base::xvblock_t* block) const {
-    // update execute height
+uint64_t xstatestore_executor_t::catch_up_execute_height() const {
+    std::lock_guard<std::mutex> l(m_execute_lock);
+    return update_execute_from_execute_height(get_latest_executed_block_height());
+}
+
+bool xstatestore_executor_t::get_executed_info(base::xvblock_t* block, uint64_t & height, std::string & blockhash) {
     if (block->check_block_flag(base::enum_xvblock_flag_committed)) {
-        set_latest_executed_info(block->get_height(), block->get_block_hash());
-    } else {
-        if (block->get_height() > 2) {
-            set_latest_executed_info(block->get_height()-2, std::string());  // TODO(jimmy) execute hash not need
-        }
+        height = block->get_height();
+        blockhash = block->get_block_hash();
+        return true;
+    }
+    if (block->get_height() > 2) {
+        height = block->get_height() - 2;
+        blockhash = std::string();  // TODO(jimmy) execute hash not need
+        return true;
+    }
+    return false;
+}
+
+void xstatestore_executor_t::update_latest_executed_info(base::xvblock_t* block, bool persist) const {
+    // update execute height
+    uint64_t height = 0;
+    std::string blockhash;
+    if (get_executed_info(block, height, blockhash)) {
+        set_latest_executed_info(height, blockhash, persist);
     }
 }
 
@@ -384,24 +418,28 @@ xtablestate_ext_ptr_t xstatestore_executor_t::write_table_all_states(base::xvblo
     }
 #endif
    
-    // write all table "state" to db
-    for (auto & v : tablestate_store->get_unitstates()) {
-        m_state_accessor.write_unitstate_to_db(v.first, v.second, ec);
+    // the unit states and the table state go to db in background, the next block only needs the mpt in db
+    bool const write_behind = XGET_CONFIG(statestore_write_behind);
+    if (!write_behind) {
+        // write all table "state" to db
+        for (auto & v : tablestate_store->get_unitstates()) {
+            auto const state_bytes = m_state_accessor.write_unitstate_to_db(v.first, v.second, ec);
+            if (ec) {
+                xerror("xstatestore_executor_t::write_table_all_states fail-write unitstate,block:%s", current_block->dump().c_str());
+                return nullptr;
+            }
+            m_state_accessor.write_unitstate_to_cache(v.first, v.second, state_bytes);
+            xdbg("xstatestore_executor_t::write_table_all_states unitstate=%s.block=%s", v.first->get_bstate()->dump().c_str(), current_block->dump().c_str());
+        }
+
+        m_state_accessor.write_table_bstate_to_db(m_table_addr, current_block->get_block_hash(), tablestate_store->get_table_state(), ec);
         if (ec) {
-            xerror("xstatestore_executor_t::write_table_all_states fail-write unitstate,block:%s", current_block->dump().c_str());
+            xerror("xstatestore_executor_t::write_table_all_states fail-write tablestate,block:%s", current_block->dump().c_str());
             return nullptr;
         }
-        m_state_accessor.write_unitstate_to_cache(v.first, v.second);
-        xdbg("xstatestore_executor_t::write_table_all_states unitstate=%s.block=%s", v.first->get_bstate()->dump().c_str(), current_block->dump().c_str());
+        xdbg("xstatestore_executor_t::write_table_all_states tablestate=%s.block=%s", tablestate_store->get_table_state()->get_bstate()->dump().c_str(), current_block->dump().c_str());
     }
 
-    m_state_accessor.write_table_bstate_to_db(m_table_addr, current_block->get_block_hash(), tablestate_store->get_table_state(), ec);
-    if (ec) {
-        xerror("xstatestore_executor_t::write_table_all_states fail-write tablestate,block:%s", current_block->dump().c_str());
-        return nullptr;
-    }
-    xdbg("xstatestore_executor_t::write_table_all_states tablestate=%s.block=%s", tablestate_store->get_table_state()->get_bstate()->dump().c_str(), current_block->dump().c_str());
-    
     if (current_block->get_block_class() != base::enum_xvblock_class_nil) {
         if (tablestate_store->get_state_root() != xhash256_t()) {
             tablestate_store->get_state_mpt()->commit(ec);
@@ -425,12 +463,75 @@ xtablestate_ext_ptr_t xstatestore_executor_t::write_table_all_states(base::xvblo
     }
 
     // update execute height
-    update_latest_executed_info(current_block);
+    if (write_behind) {
+        write_table_all_states_behind(current_block, tablestate_store, tablestate);
+        update_latest_executed_info(current_block, false);
+    } else {
+        update_latest_executed_info(current_block);
+    }
     xinfo("xstatestore_executor_t::write_table_all_states succ,block:%s,execute_height=%ld,unitstates=%zu,state_root=%s", 
         current_block->dump().c_str(), get_latest_executed_block_height(),tablestate_store->get_unitstates().size(),tablestate_store->get_state_root().as_hex_str().c_str());
     return tablestate;
 }
 
+void xstatestore_executor_t::write_table_all_states_behind(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, xtablestate_ext_ptr_t const& tablestate) const {
+    uint64_t executed_height = 0;
+    std::string executed_hash;
+    bool const has_executed_info = get_executed_info(current_block, executed_height, executed_hash);
+    {
+        // the commit waits when the writer falls too far behind
+        std::unique_lock<std::mutex> lock(m_write_behind_lock);
+        uint32_t const max_blocks = std::max<uint32_t>(1, XGET_CONFIG(statestore_write_behind_max_blocks));
+        if (m_write_behind_blocks >= max_blocks) {
+            xwarn("xstatestore_executor_t::write_table_all_states_behind wait writer.pending=%u,block=%s", m_write_behind_blocks, current_block->dump().c_str());
+            m_write_behind_cond.wait(lock, [this, max_blocks] { return m_write_behind_blocks < max_blocks; });
+        }
+        m_write_behind_blocks++;
+    }
+
+    std::string const block_hash = current_block->get_block_hash();
+    std::string const block_desc = current_block->dump();
+    m_state_accessor.add_pending_states(block_hash, tablestate, tablestate_store->get_unitstates());
+    xstatestore_writer_t::instance().post(m_table_addr, [this, block_hash, block_desc, tablestate_store, has_executed_info, executed_height, executed_hash] {
+        write_pending_states_to_db(block_hash, block_desc, tablestate_store, has_executed_info, executed_height, executed_hash);
+    });
+}
+
+void xstatestore_executor_t::write_pending_states_to_db(std::string const& block_hash, std::string const& block_desc, xtablestate_store_ptr_t const& tablestate_store,
+                                                        bool has_executed_info, uint64_t executed_height, std::string const& executed_hash) const {
+    std::error_code ec;
+    for (auto & v : tablestate_store->get_unitstates()) {
+        auto const state_bytes = m_state_accessor.write_unitstate_to_db(v.first, v.second, ec);
+        if (ec) {
+            xerror("xstatestore_executor_t::write_pending_states_to_db fail-write unitstate,block:%s", block_desc.c_str());
+            break;
+        }
+        m_state_accessor.write_unitstate_to_cache(v.first, v.second, state_bytes);
+    }
+    if (!ec) {
+        m_state_accessor.write_table_bstate_to_db(m_table_addr, block_hash, tablestate_store->get_table_state(), ec);
+        if (ec) {
+            xerror("xstatestore_executor_t::write_pending_states_to_db fail-write tablestate,block:%s", block_desc.c_str());
+        }
+    }
+    m_state_accessor.remove_pending_states(block_hash, tablestate_store->get_unitstates());
+
+    {
+        std::lock_guard<std::mutex> lock(m_write_behind_lock);
+        if (ec) {
+            // executed height in db stays before the failed block, a restart executes again from there
+            m_write_behind_failed = true;
+        }
+        if (!m_write_behind_failed && has_executed_info && executed_height > m_persisted_height) {
+            m_persisted_height = executed_height;
+            m_statestore_base.set_latest_executed_info(m_table_addr, executed_height, executed_hash);
+        }
+        m_write_behind_blocks--;
+    }
+    m_write_behind_cond.notify_all();
+    xdbg("xstatestore_executor_t::write_pending_states_to_db finish.ec=%s,block=%s", ec.message().c_str(), block_desc.c_str());
+}
+
 xtablestate_ext_ptr_t xstatestore_executor_t::make_state_from_prev_state_and_table(base::xvblock_t* current_block, xtablestate_ext_ptr_t const& prev_state, std::error_code & ec) const {
     class alocker
     {
@@ -628,12 +729,14 @@ xtablestate_ext_ptr_t xstatestore_executor_t::make_state_from_prev_state_and_tab
     return tablestate;
 }
 
-void xstatestore_executor_t::set_latest_executed_info(uint64_t height,const std::string & blockhash) const {
+void xstatestore_executor_t::set_latest_executed_info(uint64_t height,const std::string & blockhash, bool persist) const {
     std::lock_guard<std::mutex> l(m_execute_height_lock);
     if (m_executed_height < height) {                
         xinfo("xstatestore_executor_t::set_latest_executed_info succ,account=%s,old=%ld,new=%ld,need_height=%ld,this=%p",m_table_addr.value().c_str(),m_executed_height,height,m_need_all_state_sync_height,this);
         m_executed_height = height;
-        m_statestore_base.set_latest_executed_info(m_table_addr, height, blockhash);
+        if (persist) {
+            persist_latest_executed_info(height, blockhash);
+        }
 
         if (m_need_all_state_sync_height != 0 && m_executed_height > m_need_all_state_sync_height) {
             m_need_all_state_sync_height = 0;
@@ -645,6 +748,14 @@ void xstatestore_executor_t::set_latest_executed_info(uint64_t height,const std:
     }
 }
 
+void xstatestore_executor_t::persist_latest_executed_info(uint64_t height,const std::string & blockhash) const {
+    std::lock_guard<std::mutex> l(m_write_behind_lock);
+    if (m_persisted_height < height) {
+        m_persisted_height = height;
+        m_statestore_base.set_latest_executed_info(m_table_addr, height, blockhash);
+    }
+}
+
 void xstatestore_executor_t::set_need_sync_state_block_height(uint64_t height) const {
     std::lock_guard<std::mutex> l(m_execute_height_lock);
     xinfo("xstatestore_executor_t::set_need_sync_state_block_height succ,account=%s,old=%ld,new=%ld",m_table_addr.value().c_str(),m_need_all_state_sync_height,height);
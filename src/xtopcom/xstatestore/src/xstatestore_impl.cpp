@@ -5,6 +5,8 @@
 #include <string>
 #include "xbasic/xmemory.hpp"
 #include "xblockstore/xblockstore_face.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xmbus/xevent_store.h"
 #include "xmbus/xevent_state_sync.h"
 #include "xverifier/xverifier_utl.h"
@@ -47,6 +49,7 @@ void xstatestore_impl_t::init_all_tablestate() {
         xstatestore_table_ptr_t tablestore = std::make_shared<xstatestore_table_t>(common::xaccount_address_t(v), m_para);
         m_table_statestore[v] = tablestore;
     }
+    m_catchup.reset(new xstatestore_catchup_t(m_table_statestore));
 }
 
 bool xstatestore_impl_t::start(const xobject_ptr_t<base::xiothread_t> & iothread, const xobject_ptr_t<base::xiothread_t> & iothread_for_prune) {
@@ -61,6 +64,7 @@ bool xstatestore_impl_t::start(const xobject_ptr_t<base::xiothread_t> & iothread
     // todo(nathan):use timer to update mpt and table state.
     m_timer = new xstatestore_timer_t(top::base::xcontext_t::instance(), iothread->get_thread_id(), this);
     m_timer->start(0, 1000);
+    m_catchup->start(XGET_CONFIG(statestore_catchup_threads));
     m_store_block_listen_id = get_mbus()->add_listener(top::mbus::xevent_major_type_store, std::bind(&xstatestore_impl_t::on_block_to_db_event, this, std::placeholders::_1));
     m_state_sync_listen_id = get_mbus()->add_listener(top::mbus::xevent_major_type_state_sync, std::bind(&xstatestore_impl_t::on_state_sync_event, this, std::placeholders::_1));
     return false;
@@ -111,6 +115,10 @@ void xstatestore_impl_t::on_block_to_db_event(mbus::xevent_ptr_t e) {
     m_timer->send_call(asyn_call);
 }
 
+void xstatestore_impl_t::prioritize_tables_catch_up(std::vector<common::xaccount_address_t> const & table_addrs) {
+    m_catchup->prioritize(table_addrs);
+}
+
 uint64_t xstatestore_impl_t::get_latest_executed_block_height(common::xaccount_address_t const & table_address) const {
     xdbg("xstatestore_impl_t::get_latest_executed_block_height table:%s,this=%p", table_address.value().c_str(),this);
     xstatestore_table_ptr_t tablestore = get_table_statestore_from_table_addr(table_address.value());
@@ -5,6 +5,8 @@
 #include "xstatestore/xstatestore_prune.h"
 
 #include "xbasic/xmemory.hpp"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xdata/xblockbuild.h"
 #include "xdata/xtable_bstate.h"
 #include "xmbus/xevent_behind.h"
@@ -13,10 +15,16 @@
 #include "xsync/xsync_on_demand.h"
 #include "xvledger/xvledger.h"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <thread>
 
 NS_BEG2(top, statestore)
 
+// tombstones of deleted ranges are dropped by compaction once the pruned heights since last compaction are enough
+static constexpr uint64_t min_compact_heights{4096};
+
 void xaccounts_prune_info_t::insert_from_tableblock(base::xvblock_t * table_block) {
     base::xaccount_indexs_t account_indexs;
     get_account_indexs(table_block, account_indexs);
@@ -52,23 +60,66 @@ void xaccounts_prune_info_t::get_account_indexs(base::xvblock_t * table_block, b
 }
 
 void xtablestate_and_offdata_prune_info_t::insert_from_tableblock(base::xvblock_t * table_block) {
+    auto & height_keys = m_height_keys[table_block->get_height()];
     if (table_block->get_block_class() != base::enum_xvblock_class_full) {
-        const std::string delete_key = base::xvdbkey_t::create_prunable_state_key(table_block->get_account(), table_block->get_height(), table_block->get_block_hash());
-        m_tablestate_keys.push_back(delete_key);
+        height_keys.push_back(base::xvdbkey_t::create_prunable_state_key(table_block->get_account(), table_block->get_height(), table_block->get_block_hash()));
+        m_legacy_keys.push_back(base::xvdbkey_t::create_prunable_state_key_old(table_block->get_account(), table_block->get_height(), table_block->get_block_hash()));
+        m_prune_count++;
+    } else {
+        m_full_heights.insert(table_block->get_height());
     }
 
     if (table_block->get_block_class() != base::enum_xvblock_class_nil) {
-        const std::string delete_key = base::xvdbkey_t::create_prunable_block_output_offdata_key(table_block->get_account(), table_block->get_height(), table_block->get_viewid());
-        m_offdata_keys.push_back(delete_key);
+        height_keys.push_back(base::xvdbkey_t::create_prunable_block_output_offdata_key(table_block->get_account(), table_block->get_height(), table_block->get_viewid()));
+        m_legacy_keys.push_back(base::xvdbkey_t::create_prunable_block_output_offdata_key_old(table_block->get_account(), table_block->get_height(), table_block->get_viewid()));
+        m_prune_count++;
     }
 }
 
-const std::vector<std::string> & xtablestate_and_offdata_prune_info_t::get_tablestate_prune_keys() const {
-    return m_tablestate_keys;
+std::vector<std::pair<std::string, std::string>> xtablestate_and_offdata_prune_info_t::get_prune_ranges(base::xvaccount_t const & table,
+                                                                                                        uint64_t from_height,
+                                                                                                        uint64_t to_height) const {
+    std::vector<std::pair<std::string, std::string>> ranges;
+    bool in_range = false;
+    uint64_t begin_height = 0;
+    uint64_t end_height = 0;
+    for (auto & height_keys : m_height_keys) {
+        auto const height = height_keys.first;
+        if (height < from_height || height > to_height || m_full_heights.count(height) > 0) {
+            continue;
+        }
+        if (in_range && height == end_height) {
+            end_height = height + 1;
+            continue;
+        }
+        if (in_range) {
+            ranges.emplace_back(base::xvdbkey_t::create_prunable_state_height_key(table, begin_height), base::xvdbkey_t::create_prunable_state_height_key(table, end_height));
+        }
+        in_range = true;
+        begin_height = height;
+        end_height = height + 1;
+    }
+    if (in_range) {
+        ranges.emplace_back(base::xvdbkey_t::create_prunable_state_height_key(table, begin_height), base::xvdbkey_t::create_prunable_state_height_key(table, end_height));
+    }
+    return ranges;
 }
 
-const std::vector<std::string> & xtablestate_and_offdata_prune_info_t::get_offdata_prune_keys() const {
-    return m_offdata_keys;
+std::vector<std::string> xtablestate_and_offdata_prune_info_t::get_prune_keys() const {
+    std::vector<std::string> keys;
+    for (auto full_height : m_full_heights) {
+        auto const & height_keys = m_height_keys.at(full_height);
+        keys.insert(keys.end(), height_keys.begin(), height_keys.end());
+    }
+    return keys;
+}
+
+const std::vector<std::string> & xtablestate_and_offdata_prune_info_t::get_legacy_prune_keys() const {
+    return m_legacy_keys;
+}
+
+std::size_t xtablestate_and_offdata_prune_info_t::get_prune_count() const {
+    return m_prune_count;
 }
 
 xstatestore_prune_t::xstatestore_prune_t(common::xaccount_address_t const & table_addr, std::shared_ptr<xstatestore_resources_t> para) : m_table_addr(table_addr), m_para(para) {
@@ -79,9 +130,11 @@ bool xstatestore_prune_t::need_prune(uint64_t exec_height) {
     uint64_t prune_table_state_diff = XGET_CONFIG(prune_table_state_diff);
 
     std::lock_guard<std::mutex> l(m_prune_lock);
-    if (exec_height < m_pruned_height + prune_table_state_diff) {
+    // the queued job is triggered again by blocks executed after it
+    if (m_prune_queued || exec_height < m_pruned_height + prune_table_state_diff) {
         return false;
     }
+    m_prune_queued = true;
     xdbg("xstatestore_prune_t::need_prune table:%s will prune.pruned height:%llu,exec height:%llu", m_table_addr.value().c_str(), m_pruned_height, exec_height);
     return true;
 }
@@ -89,12 +142,14 @@ bool xstatestore_prune_t::need_prune(uint64_t exec_height) {
 bool xstatestore_prune_t::get_prune_section(uint64_t exec_height, uint64_t & from_height, uint64_t & to_height) {
     uint64_t keep_table_states_max_num = XGET_CONFIG(keep_table_states_max_num);
     uint64_t prune_table_state_diff = XGET_CONFIG(prune_table_state_diff);
+    uint64_t prune_table_state_max_heights = std::max<uint64_t>(1, XGET_CONFIG(prune_table_state_max_heights));
     std::lock_guard<std::mutex> l(m_prune_lock);
     if (exec_height < m_pruned_height + prune_table_state_diff) {
         return false;
     }
     from_height = m_pruned_height + 1;
-    to_height = exec_height - keep_table_states_max_num;
+    // a table far behind is pruned by several runs, so it does not hold the prune thread from other tables
+    to_height = std::min(exec_height - keep_table_states_max_num, m_pruned_height + prune_table_state_max_heights);
     return true;
 }
 
@@ -106,28 +161,29 @@ void xstatestore_prune_t::set_pruned_height(uint64_t pruned_height) {
     }
 }
 
-void xstatestore_prune_t::prune_imp(uint64_t exec_height) {
+uint32_t xstatestore_prune_t::prune_imp(uint64_t exec_height) {
     uint64_t from_height;
     uint64_t to_height;
     auto ret = get_prune_section(exec_height, from_height, to_height);
     if (!ret) {
-        return;
+        return 0;
     }
 
     xdbg("xstatestore_prune_t::prune_imp in table:%", m_table_addr.value().c_str());
     bool is_storage_node = base::xvchain_t::instance().is_storage_node();
     bool is_consensus_node = base::xvchain_t::instance().has_other_node();
     uint64_t pruned_height;
+    uint32_t ops = 0;
     if (is_storage_node && !is_consensus_node) {
-        pruned_height = prune_exec_storage(from_height, to_height);
+        pruned_height = prune_exec_storage(from_height, to_height, ops);
     } else if (is_storage_node && is_consensus_node) {
-        pruned_height = prune_exec_storage_and_cons(from_height, to_height);
+        pruned_height = prune_exec_storage_and_cons(from_height, to_height, ops);
     } else if (!is_storage_node) {
         // include consensus nodes and edge nodes.
-        pruned_height = prune_exec_cons(from_height, to_height, exec_height);
+        pruned_height = prune_exec_cons(from_height, to_height, exec_height, ops);
     } else {
         xwarn("xstatestore_prune_t::prune_imp not storage node nor cons node. can not prune.table:%s", m_table_addr.value().c_str());
-        return;
+        return 0;
     }
 
     xdbg("xstatestore_prune_t::prune_imp table:%s prune finish from %llu to %llu isstorage:%d iscons:%d.pruned_height:%llu",
@@ -139,6 +195,7 @@ void xstatestore_prune_t::prune_imp(uint64_t exec_height) {
          pruned_height);
 
     set_pruned_height(pruned_height);
+    return ops;
 }
 
 void xstatestore_prune_t::on_table_block_executed(uint64_t exec_height) {
@@ -152,7 +209,17 @@ void xstatestore_prune_t::on_table_block_executed(uint64_t exec_height) {
 
     auto self = shared_from_this();
     auto handler = [this, self, exec_height](base::xcall_t & call, const int32_t cur_thread_id, const uint64_t timenow_ms) -> bool {
-        this->prune_imp(exec_height);
+        const uint32_t ops = this->prune_imp(exec_height);
+        {
+            std::lock_guard<std::mutex> l(m_prune_lock);
+            m_prune_queued = false;
+        }
+        // jobs of all tables run one by one at the prune thread, so pacing here keeps db ops of all tables under budget of each second
+        const uint32_t max_ops = std::max<uint32_t>(1, XGET_CONFIG(prune_table_state_ops_per_second));
+        const uint64_t wait_ms = (uint64_t)ops * 1000 / max_ops;
+        if (wait_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+        }
         return true;
     };
 
@@ -160,14 +227,22 @@ void xstatestore_prune_t::on_table_block_executed(uint64_t exec_height) {
     m_para->get_prune_dispatcher()->dispatch(asyn_call);
 }
 
-void xstatestore_prune_t::unitstate_prune_batch(const xaccounts_prune_info_t & accounts_prune_info) {
+uint32_t xstatestore_prune_t::unitstate_prune_batch(const xaccounts_prune_info_t & accounts_prune_info) {
     if (accounts_prune_info.get_prune_info().empty()) {
-        return;
+        return 0;
     }
 
+    // ranges of all accounts are deleted by one write
+    std::vector<std::pair<std::string, std::string>> ranges;
+    std::vector<std::pair<common::xaccount_address_t, uint64_t>> pruned_heights;
+    uint32_t const snapshot_interval = XGET_CONFIG(unitstate_snapshot_interval);
     for (auto & prune_info : accounts_prune_info.get_prune_info()) {
         common::xaccount_address_t account_addr(prune_info.first);
-        auto & upper_height = prune_info.second;
+        uint64_t upper_height = prune_info.second;
+        // the states kept start from a full one, the deltas after it need it
+        if (snapshot_interval > 0) {
+            upper_height = upper_height / snapshot_interval * snapshot_interval;
+        }
         // delete range for unit state.
         uint64_t account_pruned_height = m_statestore_base.get_lowest_executed_block_height(account_addr);
         if (upper_height <= account_pruned_height + 1) {
@@ -179,18 +254,73 @@ void xstatestore_prune_t::unitstate_prune_batch(const xaccounts_prune_info_t & a
         const std::string end_delete_key = base::xvdbkey_t::create_prunable_unit_state_height_key(account_addr.vaccount(), upper_height);
         //["begin_key", "end_key")
         XMETRICS_GAUGE(metrics::xmetrics_tag_t::prune_state_unitstate, upper_height - account_pruned_height);
-        if (base::xvchain_t::instance().get_xdbstore()->delete_range(begin_delete_key, end_delete_key)) {
-            xinfo(
-                "xstatestore_prune_t::unitstate_prune_batch unitstate prune succ %s from %llu to %llu", account_addr.value().c_str(), account_pruned_height + 1, upper_height - 1);
-            m_statestore_base.set_lowest_executed_block_height(account_addr, upper_height - 1);
-        } else {
-            xerror("xstatestore_prune_t::unitstate_prune_batch unitstate prune failed %s from %llu to %llu",
-                   account_addr.value().c_str(),
-                   account_pruned_height + 1,
-                   upper_height - 1);
+        ranges.emplace_back(begin_delete_key, end_delete_key);
+        pruned_heights.emplace_back(account_addr, upper_height - 1);
+    }
+    if (ranges.empty()) {
+        return 0;
+    }
+
+    if (base::xvchain_t::instance().get_xdbstore()->delete_ranges(ranges)) {
+        for (auto & pruned : pruned_heights) {
+            m_statestore_base.set_lowest_executed_block_height(pruned.first, pruned.second);
         }
+        xinfo("xstatestore_prune_t::unitstate_prune_batch unitstate prune succ table:%s accounts:%zu", m_table_addr.value().c_str(), ranges.size());
+    } else {
+        xerror("xstatestore_prune_t::unitstate_prune_batch unitstate prune failed table:%s accounts:%zu", m_table_addr.value().c_str(), ranges.size());
     }
     XMETRICS_GAUGE(metrics::state_delete_unit_state, accounts_prune_info.get_prune_info().size());
+    return 1;
+}
+
+uint32_t xstatestore_prune_t::tablestate_and_offdata_prune_batch(const xtablestate_and_offdata_prune_info_t & prune_info, uint64_t from_height, uint64_t to_height) {
+    if (to_height < from_height) {
+        return 0;
+    }
+
+    uint32_t ops = 0;
+    auto dbstore = base::xvchain_t::instance().get_xdbstore();
+    auto const ranges = prune_info.get_prune_ranges(get_account().vaccount(), from_height, to_height);
+    if (!ranges.empty()) {
+        if (!dbstore->delete_ranges(ranges)) {
+            xerror("xstatestore_prune_t::tablestate_and_offdata_prune_batch delete ranges fail.table:%s from %llu to %llu", m_table_addr.value().c_str(), from_height, to_height);
+        }
+        ops++;
+    }
+    auto const keys = prune_info.get_prune_keys();
+    if (!keys.empty()) {
+        dbstore->delete_values(keys);
+        ops++;
+    }
+
+    // keys of the old layout only exist under heights executed before the upgrade, once a section has none of them the later ones have none either
+    if (!m_legacy_keys_pruned && !prune_info.get_legacy_prune_keys().empty()) {
+        std::vector<std::string> legacy_keys;
+        for (auto & key : prune_info.get_legacy_prune_keys()) {
+            if (!dbstore->get_value(key).empty()) {
+                legacy_keys.push_back(key);
+            }
+        }
+        if (legacy_keys.empty()) {
+            m_legacy_keys_pruned = true;
+        } else {
+            dbstore->delete_values(legacy_keys);
+            ops++;
+        }
+    }
+    XMETRICS_GAUGE(metrics::state_delete_table_data, prune_info.get_prune_count());
+
+    if (m_compact_from_height == 0) {
+        m_compact_from_height = from_height;
+    }
+    if (to_height + 1 - m_compact_from_height >= min_compact_heights) {
+        dbstore->compact_range(base::xvdbkey_t::create_prunable_state_height_key(get_account().vaccount(), m_compact_from_height),
+                               base::xvdbkey_t::create_prunable_state_height_key(get_account().vaccount(), to_height + 1));
+        xinfo("xstatestore_prune_t::tablestate_and_offdata_prune_batch compact table:%s from %llu to %llu", m_table_addr.value().c_str(), m_compact_from_height, to_height);
+        m_compact_from_height = 0;
+        ops++;
+    }
+    return ops;
 }
 
 void xstatestore_prune_t::init() {
@@ -198,7 +328,7 @@ void xstatestore_prune_t::init() {
     xinfo("xstatestore_prune_t::init table:%s init prune height:%llu", m_table_addr.value().c_str(), m_pruned_height);
 }
 
-uint64_t xstatestore_prune_t::prune_exec_storage(uint64_t from_height, uint64_t to_height) {
+uint64_t xstatestore_prune_t::prune_exec_storage(uint64_t from_height, uint64_t to_height, uint32_t & ops) {
     xtablestate_and_offdata_prune_info_t prune_info;
     uint64_t height = from_height;
     for (; height <= to_height; height++) {
@@ -213,15 +343,13 @@ uint64_t xstatestore_prune_t::prune_exec_storage(uint64_t from_height, uint64_t
         }
     }
 
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_tablestate_prune_keys());
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_offdata_prune_keys());
-    XMETRICS_GAUGE(metrics::state_delete_table_data, prune_info.get_tablestate_prune_keys().size() + prune_info.get_offdata_prune_keys().size());
+    ops += tablestate_and_offdata_prune_batch(prune_info, from_height, height - 1);
     xinfo("xstatestore_prune_t::prune_exec_storage prune tablestate and offdata for table %s from %llu to %llu", m_table_addr.value().c_str(), from_height, height - 1);
     // tablestate_prune_batch(from_height, to_height);
     return height - 1;
 }
 
-uint64_t xstatestore_prune_t::prune_exec_storage_and_cons(uint64_t from_height, uint64_t to_height) {
+uint64_t xstatestore_prune_t::prune_exec_storage_and_cons(uint64_t from_height, uint64_t to_height, uint32_t & ops) {
     xaccounts_prune_info_t accounts_prune_info;
     xtablestate_and_offdata_prune_info_t prune_info;
     uint64_t height = from_height;
@@ -239,10 +367,8 @@ uint64_t xstatestore_prune_t::prune_exec_storage_and_cons(uint64_t from_height,
             }
         }
     }
-    unitstate_prune_batch(accounts_prune_info);
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_tablestate_prune_keys());
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_offdata_prune_keys());
-    XMETRICS_GAUGE(metrics::state_delete_table_data, prune_info.get_tablestate_prune_keys().size() + prune_info.get_offdata_prune_keys().size());
+    ops += unitstate_prune_batch(accounts_prune_info);
+    ops += tablestate_and_offdata_prune_batch(prune_info, from_height, height - 1);
     xinfo("xstatestore_prune_t::prune_exec_storage_and_cons prune tablestate,offdata,unitstate for table %s from %llu to %llu",
           m_table_addr.value().c_str(),
           from_height,
@@ -251,7 +377,7 @@ uint64_t xstatestore_prune_t::prune_exec_storage_and_cons(uint64_t from_height,
     return height - 1;
 }
 
-uint64_t xstatestore_prune_t::prune_exec_cons(uint64_t from_height, uint64_t to_height, uint64_t exec_height) {
+uint64_t xstatestore_prune_t::prune_exec_cons(uint64_t from_height, uint64_t to_height, uint64_t exec_height, uint32_t & ops) {
     uint64_t lowest_keep_height = to_height + 1;
     xobject_ptr_t<base::xvblock_t> lowest_keep_block =
         base::xvchain_t::instance().get_xblockstore()->load_block_object(get_account().vaccount(), lowest_keep_height, base::enum_xvblock_flag_committed, false);
@@ -351,12 +477,11 @@ uint64_t xstatestore_prune_t::prune_exec_cons(uint64_t from_height, uint64_t to_
             xwarn("xstatestore_prune_t::prune_exec_cons mpt commit prune fail table %s from %llu to %llu", m_table_addr.value().c_str(), from_height, to_height);
         }
         XMETRICS_GAUGE(metrics::state_delete_mpt, delete_mpt_num);
+        ops++;
     }
 
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_tablestate_prune_keys());
-    base::xvchain_t::instance().get_xdbstore()->delete_values(prune_info.get_offdata_prune_keys());
-    XMETRICS_GAUGE(metrics::state_delete_table_data, prune_info.get_tablestate_prune_keys().size() + prune_info.get_offdata_prune_keys().size());
-    unitstate_prune_batch(accounts_prune_info);
+    ops += tablestate_and_offdata_prune_batch(prune_info, from_height, to_height);
+    ops += unitstate_prune_batch(accounts_prune_info);
 
     xinfo("xstatestore_prune_t::prune_exec_cons prune mpt tablestate and unitstate for table %s from %llu to %llu", m_table_addr.value().c_str(), from_height, to_height);
     return to_height;
@@ -84,6 +84,10 @@ void xstatestore_table_t::raise_execute_height(const xstate_sync_info_t & sync_i
     return m_table_executor.raise_execute_height(sync_info);
 }
 
+uint64_t xstatestore_table_t::catch_up_execute_height() const {
+    return m_table_executor.catch_up_execute_height();
+}
+
 // void xstatestore_table_t::state_prune() {
 //     m_prune.prune(get_latest_executed_block_height());
 // }
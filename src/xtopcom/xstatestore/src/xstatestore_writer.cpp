@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xstatestore/xstatestore_writer.h"
+
+NS_BEG2(top, statestore)
+
+xstatestore_writer_t::xstatestore_writer_t() {
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        m_workers.emplace_back(new xworker_t);
+        auto & worker = *m_workers.back();
+        worker.thread = std::thread([&worker] { run(worker); });
+    }
+}
+
+xstatestore_writer_t::~xstatestore_writer_t() {
+    // the jobs already posted are still written
+    for (auto & worker : m_workers) {
+        {
+            std::lock_guard<std::mutex> lock{worker->mutex};
+            worker->stop = true;
+        }
+        worker->cond.notify_one();
+    }
+    for (auto & worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+xstatestore_writer_t & xstatestore_writer_t::instance() {
+    static xstatestore_writer_t writer;
+    return writer;
+}
+
+void xstatestore_writer_t::post(common::xaccount_address_t const & table_addr, std::function<void()> job) {
+    auto & worker = *m_workers[std::hash<std::string>{}(table_addr.value()) % worker_count];
+    {
+        std::lock_guard<std::mutex> lock{worker.mutex};
+        worker.jobs.push_back(std::move(job));
+    }
+    worker.cond.notify_one();
+}
+
+void xstatestore_writer_t::flush() {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::size_t done = 0;
+    for (auto & worker : m_workers) {
+        {
+            std::lock_guard<std::mutex> lock{worker->mutex};
+            worker->jobs.push_back([&mutex, &cond, &done] {
+                std::lock_guard<std::mutex> lock{mutex};
+                ++done;
+                cond.notify_one();
+            });
+        }
+        worker->cond.notify_one();
+    }
+    std::unique_lock<std::mutex> lock{mutex};
+    cond.wait(lock, [this, &done] { return done == m_workers.size(); });
+}
+
+void xstatestore_writer_t::run(xworker_t & worker) {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock{worker.mutex};
+            worker.cond.wait(lock, [&worker] { return worker.stop || !worker.jobs.empty(); });
+            if (worker.jobs.empty()) {
+                return;
+            }
+            job = std::move(worker.jobs.front());
+            worker.jobs.pop_front();
+        }
+        job();
+    }
+}
+
+NS_END2
@@ -0,0 +1,229 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xstatestore/xunitstate_cache.h"
+
+#include "xbasic/xmemory_accounting.h"
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
+#include "xmetrics/xmetrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+NS_BEG2(top, statestore)
+
+// bookkeeping of an entry besides the serialized state: the key in the map and the list, the node and the object
+static constexpr uint64_t entry_overhead_bytes{256};
+static constexpr int64_t metrics_export_interval_ms{60 * 1000};
+
+xunitstate_cache_t::xunitstate_cache_t(uint64_t const shared_bytes, uint64_t const reserved_bytes) {
+    m_shards.reserve(shard_count);
+    for (std::size_t i = 0; i < shard_count; ++i) {
+        m_shards.emplace_back(new xshard_t);
+        m_shards.back()->shared.max_bytes = shared_bytes / shard_count;
+        m_shards.back()->reserved.max_bytes = reserved_bytes / shard_count;
+    }
+}
+
+xunitstate_cache_t & xunitstate_cache_t::instance() {
+    static xunitstate_cache_t cache{XGET_CONFIG(unitstate_cache_max_bytes) - std::min(XGET_CONFIG(unitstate_cache_reserved_bytes), XGET_CONFIG(unitstate_cache_max_bytes)),
+                                    std::min(XGET_CONFIG(unitstate_cache_reserved_bytes), XGET_CONFIG(unitstate_cache_max_bytes))};
+    static uint64_t const reporter = basic::xmemory_accounting_t::instance().add_reporter(
+        "statestore_unitstate_cache",
+        [] { return basic::xmemory_usage_t{cache.bytes(), cache.size()}; },
+        [](uint64_t const target_bytes) { cache.shrink(target_bytes); });
+    (void)reporter;
+    return cache;
+}
+
+xunitstate_cache_t::xshard_t & xunitstate_cache_t::shard_of(std::string const & block_hash) {
+    return *m_shards[std::hash<std::string>{}(block_hash) % shard_count];
+}
+
+xunitstate_cache_t::xpart_t & xunitstate_cache_t::part_of(xshard_t & shard, xentry_t const & entry) {
+    return entry.reserved ? shard.reserved : shard.shared;
+}
+
+data::xunitstate_ptr_t xunitstate_cache_t::get(common::xaccount_address_t const & table_address, std::string const & block_hash, std::size_t * state_bytes) {
+    data::xunitstate_ptr_t state;
+    {
+        auto & shard = shard_of(block_hash);
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        auto & stats = shard.stats[table_address.value()];
+        auto it = shard.entries.find(block_hash);
+        if (it == shard.entries.end()) {
+            ++stats.misses;
+        } else {
+            ++stats.hits;
+            touch(shard, it->second);
+            state = it->second.state;
+            if (state_bytes != nullptr) {
+                *state_bytes = it->second.bytes - block_hash.size() - entry_overhead_bytes;
+            }
+        }
+    }
+    XMETRICS_GAUGE(metrics::statestore_get_unit_state_from_cache, state != nullptr ? 1 : 0);
+    export_metrics_periodically();
+    return state;
+}
+
+void xunitstate_cache_t::put(common::xaccount_address_t const & table_address,
+                             std::string const & block_hash,
+                             data::xunitstate_ptr_t const & state,
+                             std::size_t const state_bytes,
+                             bool const executed) {
+    (void)table_address;
+    auto & shard = shard_of(block_hash);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    auto it = shard.entries.find(block_hash);
+    if (it != shard.entries.end()) {
+        // a state read before its block is executed here moves to the reserved part
+        if (!executed || it->second.reserved || shard.reserved.max_bytes == 0) {
+            it->second.state = state;
+            touch(shard, it->second);
+            return;
+        }
+        erase(shard, it);
+    }
+
+    xentry_t entry;
+    entry.state = state;
+    entry.bytes = state_bytes + block_hash.size() + entry_overhead_bytes;
+    entry.reserved = executed && shard.reserved.max_bytes > 0;
+    auto & part = part_of(shard, entry);
+    if (entry.bytes > part.max_bytes) {
+        return;
+    }
+
+    part.probation.push_front(block_hash);
+    entry.position = part.probation.begin();
+    part.bytes += entry.bytes;
+    shard.entries.emplace(block_hash, std::move(entry));
+    evict(shard, part);
+}
+
+void xunitstate_cache_t::touch(xshard_t & shard, xentry_t & entry) {
+    auto & part = part_of(shard, entry);
+    if (entry.segment == xsegment_t::protect) {
+        part.protect.splice(part.protect.begin(), part.protect, entry.position);
+        return;
+    }
+
+    // the second hit promotes, the protected segment keeps at most 80% of the part
+    part.protect.splice(part.protect.begin(), part.probation, entry.position);
+    entry.segment = xsegment_t::protect;
+    part.protected_bytes += entry.bytes;
+    while (part.protected_bytes > part.max_bytes / 5 * 4 && part.protect.size() > 1) {
+        auto & demoted = shard.entries.at(part.protect.back());
+        part.probation.splice(part.probation.begin(), part.protect, demoted.position);
+        demoted.segment = xsegment_t::probation;
+        part.protected_bytes -= demoted.bytes;
+    }
+}
+
+void xunitstate_cache_t::erase(xshard_t & shard, std::unordered_map<std::string, xentry_t>::iterator it) {
+    auto & entry = it->second;
+    auto & part = part_of(shard, entry);
+    if (entry.segment == xsegment_t::protect) {
+        part.protect.erase(entry.position);
+        part.protected_bytes -= entry.bytes;
+    } else {
+        part.probation.erase(entry.position);
+    }
+    part.bytes -= entry.bytes;
+    shard.entries.erase(it);
+}
+
+void xunitstate_cache_t::evict(xshard_t & shard, xpart_t & part) {
+    while (part.bytes > part.max_bytes) {
+        auto const & victim = part.probation.empty() ? part.protect.back() : part.probation.back();
+        erase(shard, shard.entries.find(victim));
+    }
+}
+
+void xunitstate_cache_t::clear() {
+    for (auto & shard : m_shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        shard->entries.clear();
+        for (auto part : {&shard->shared, &shard->reserved}) {
+            part->bytes = 0;
+            part->protected_bytes = 0;
+            part->probation.clear();
+            part->protect.clear();
+        }
+    }
+}
+
+void xunitstate_cache_t::shrink(uint64_t const target_bytes) {
+    uint64_t const shard_target = target_bytes / shard_count;
+    for (auto & shard : m_shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        auto & part = shard->shared;
+        while (part.bytes + shard->reserved.bytes > shard_target && !(part.probation.empty() && part.protect.empty())) {
+            auto const & victim = part.probation.empty() ? part.protect.back() : part.probation.back();
+            erase(*shard, shard->entries.find(victim));
+        }
+    }
+}
+
+std::size_t xunitstate_cache_t::size() const {
+    std::size_t size = 0;
+    for (auto const & shard : m_shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        size += shard->entries.size();
+    }
+    return size;
+}
+
+uint64_t xunitstate_cache_t::bytes() const {
+    uint64_t bytes = 0;
+    for (auto const & shard : m_shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        bytes += shard->shared.bytes + shard->reserved.bytes;
+    }
+    return bytes;
+}
+
+std::map<std::string, xunitstate_cache_table_stats_t> xunitstate_cache_t::table_stats() const {
+    std::map<std::string, xunitstate_cache_table_stats_t> result;
+    for (auto const & shard : m_shards) {
+        std::lock_guard<std::mutex> lock{shard->mutex};
+        for (auto const & stats : shard->stats) {
+            auto & total = result[stats.first];
+            total.hits += stats.second.hits;
+            total.misses += stats.second.misses;
+        }
+    }
+    return result;
+}
+
+void xunitstate_cache_t::export_metrics() const {
+#ifdef ENABLE_METRICS
+    XMETRICS_COUNTER_SET("statestore_unitstate_cache_bytes", static_cast<int64_t>(bytes()));
+    XMETRICS_COUNTER_SET("statestore_unitstate_cache_size", static_cast<int64_t>(size()));
+    for (auto const & stats : table_stats()) {
+        auto const total = stats.second.hits + stats.second.misses;
+        if (total > 0) {
+            XMETRICS_COUNTER_SET("statestore_unitstate_cache_hit_permille_" + stats.first, static_cast<int64_t>(stats.second.hits * 1000 / total));
+        }
+    }
+#endif
+}
+
+void xunitstate_cache_t::export_metrics_periodically() {
+    auto const now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto last_ms = m_last_export_ms.load(std::memory_order_relaxed);
+    if (now_ms - last_ms < metrics_export_interval_ms) {
+        return;
+    }
+    // one reader exports, the others go on
+    if (m_last_export_ms.compare_exchange_strong(last_ms, now_ms, std::memory_order_relaxed)) {
+        export_metrics();
+    }
+}
+
+NS_END2
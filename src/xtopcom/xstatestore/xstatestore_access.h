@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "xbasic/xmemory.hpp"
 #include "xstatestore/xstatestore_base.h"
 #include "xstatestore/xtablestate_ext.h"
@@ -18,39 +21,39 @@ protected:
     enum
     {
         enum_max_table_state_lru_cache_max     = 4, //max table state lru cache count
-        enum_max_unit_state_lru_cache_max      = 32, //max unit state lru cache count
     };
 public:
     xstatestore_cache_t();
 public:
     xtablestate_ext_ptr_t   get_tablestate(std::string const& block_hash) const;
-    data::xunitstate_ptr_t  get_unitstate(std::string const& block_hash) const;
     xtablestate_ext_ptr_t   get_latest_connectted_tablestate() const;
 
 public:
     void    set_latest_connectted_tablestate(xtablestate_ext_ptr_t const& tablestate) const;
     void    set_tablestate(std::string const& block_hash, xtablestate_ext_ptr_t const& tablestate) const;
-    void    set_unitstate(std::string const& block_hash, data::xunitstate_ptr_t const& unitstate) const;
 
 private:
    // TODO(jimmy) it is better to use non-lock cache
    mutable std::mutex m_mutex;
    mutable xtablestate_ext_ptr_t    m_latest_connectted_tablestate{nullptr};
    mutable base::xlru_cache<std::string, xtablestate_ext_ptr_t> m_tablestate_cache;  //tablestate cache
-   mutable base::xlru_cache<std::string, data::xunitstate_ptr_t> m_unitstate_cache;  //unitstate cache
 };
 
 
 class xstatestore_dbaccess_t {
  public:
     void    write_table_bstate(common::xaccount_address_t const& address, data::xtablestate_ptr_t const& tablestate, const std::string & block_hash, std::error_code & ec) const;
-    void    write_unit_bstate(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec) const;
+    // return the serialized bytes of the state, 0 if fail
+    // with base_unitstate of the previous height, the state between snapshots(unitstate_snapshot_interval) is written as the delta to it
+    std::size_t write_unit_bstate(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & ec, data::xunitstate_ptr_t const& base_unitstate = nullptr, std::size_t base_state_bytes = 0) const;
 
  public:
     data::xtablestate_ptr_t     read_table_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash) const;
-    data::xunitstate_ptr_t      read_unit_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash) const;
+    data::xunitstate_ptr_t      read_unit_bstate(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash, std::size_t * state_bytes = nullptr) const;
 
  private:
+    base::xauto_ptr<base::xvbstate_t> read_unit_bstate_from_delta(common::xaccount_address_t const& address, uint64_t height, const std::string & block_hash, uint32_t max_depth, std::size_t & state_bytes) const;
+
     xstatestore_base_t          m_statestore_base;
 };
 
@@ -69,14 +72,21 @@ public:
     void    set_latest_connectted_tablestate(xtablestate_ext_ptr_t const& tablestate) const;
     void    write_table_bstate_to_db(common::xaccount_address_t const& address, std::string const& block_hash, data::xtablestate_ptr_t const& tablestate, std::error_code & ec) const;
     void    write_table_bstate_to_cache(common::xaccount_address_t const& address, std::string const& block_hash, xtablestate_ext_ptr_t const& state) const;
-    void    write_unitstate_to_db(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & e) const;
-    void    write_unitstate_to_cache(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash) const;
+    std::size_t write_unitstate_to_db(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::error_code & e) const;
+    // unit states are kept in the cache shared by all tables, see xunitstate_cache_t
+    void    write_unitstate_to_cache(data::xunitstate_ptr_t const& unitstate, const std::string & block_hash, std::size_t state_bytes) const;
+    // states of an executed block queued for the background writer, they are read from here until written to db
+    void    add_pending_states(std::string const& block_hash, xtablestate_ext_ptr_t const& tablestate, std::vector<std::pair<data::xunitstate_ptr_t, std::string>> const& unitstates) const;
+    void    remove_pending_states(std::string const& block_hash, std::vector<std::pair<data::xunitstate_ptr_t, std::string>> const& unitstates) const;
 
 private:
     common::xaccount_address_t  m_table_addr;
     xstatestore_cache_t         m_state_cache;
     xstatestore_dbaccess_t      m_dbaccess;
     xstatestore_base_t          m_store_base;
+    mutable std::mutex          m_pending_mutex;
+    mutable std::map<std::string, xtablestate_ext_ptr_t>    m_pending_tablestates;
+    mutable std::map<std::string, data::xunitstate_ptr_t>   m_pending_unitstates;
 };
 
 NS_END2
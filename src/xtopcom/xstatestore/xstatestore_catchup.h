@@ -0,0 +1,56 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xstatestore/xstatestore_base.h"
+#include "xstatestore/xstatestore_table.h"
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+NS_BEG2(top, statestore)
+
+/* executes the committed blocks which are not executed yet when the node starts.
+ * tables are independent, so they are caught up in parallel by a pool of threads.
+ * the tables waiting are taken in order, and the tables served by this node may be moved to the front.
+ */
+class xstatestore_catchup_t {
+public:
+    explicit xstatestore_catchup_t(std::map<std::string, xstatestore_table_ptr_t> const & tables);
+    ~xstatestore_catchup_t();
+    xstatestore_catchup_t(xstatestore_catchup_t const &) = delete;
+    xstatestore_catchup_t & operator=(xstatestore_catchup_t const &) = delete;
+
+    void start(uint32_t thread_count);
+    void stop();
+
+    /// @brief Moves the tables still waiting to the front, in the given order.
+    void prioritize(std::vector<common::xaccount_address_t> const & table_addrs);
+
+    std::size_t pending_table_count() const;
+    std::size_t done_table_count() const;
+
+private:
+    void run();
+    void catch_up(xstatestore_table_ptr_t const & table);
+    void export_metrics() const;
+
+    std::map<std::string, xstatestore_table_ptr_t> const & m_tables;
+    xstatestore_base_t m_store_base;
+    mutable std::mutex m_mutex;
+    std::deque<std::string> m_pending_tables;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_stop{false};
+    std::atomic<std::size_t> m_done_tables{0};
+    std::atomic<uint64_t> m_executed_blocks{0};
+};
+
+NS_END2
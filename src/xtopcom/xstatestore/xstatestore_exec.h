@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <string>
 #include "xbasic/xmemory.hpp"
 #include "xdata/xtable_bstate.h"
@@ -28,7 +29,10 @@ public:
 
 public:
     xstatestore_executor_t(common::xaccount_address_t const& table_addr, xexecute_listener_face_t * execute_listener);
+    ~xstatestore_executor_t();
     void    init();
+    // wait for the states of executed blocks still written in background
+    void    wait_states_written() const;
 
 public:
     xtablestate_ext_ptr_t   execute_and_get_tablestate_ext(base::xvblock_t* target_block, std::error_code & ec) const;
@@ -36,6 +40,8 @@ public:
     xtablestate_ext_ptr_t   do_commit_table_all_states(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, std::error_code & ec) const;
     void                    on_table_block_committed(base::xvblock_t* block) const;
     void                    raise_execute_height(const xstate_sync_info_t & sync_info);
+    // execute at most execute_update_limit committed blocks after execute height, return the new execute height
+    uint64_t                catch_up_execute_height() const;
 
     void    execute_and_get_accountindex(base::xvblock_t* block, common::xaccount_address_t const& unit_addr, base::xaccount_index_t & account_index, std::error_code & ec) const;
     void    execute_and_get_tablestate(base::xvblock_t* block, data::xtablestate_ptr_t &tablestate, std::error_code & ec) const;
@@ -48,12 +54,18 @@ public:
 
 protected:
     uint64_t update_execute_from_execute_height(uint64_t old_execute_height) const;
-    void    set_latest_executed_info(uint64_t height,const std::string & blockhash) const;
+    // persist is false when the states of the block are still written in background, see write_table_all_states_behind
+    void    set_latest_executed_info(uint64_t height,const std::string & blockhash, bool persist = true) const;
+    void    persist_latest_executed_info(uint64_t height,const std::string & blockhash) const;
     void    set_need_sync_state_block_height(uint64_t height) const;
-    void    update_latest_executed_info(base::xvblock_t* block) const;
+    void    update_latest_executed_info(base::xvblock_t* block, bool persist = true) const;
+    static bool get_executed_info(base::xvblock_t* block, uint64_t & height, std::string & blockhash);
     void    recover_execute_height(uint64_t old_executed_height);
     bool    need_store_unitstate() const;
     xtablestate_ext_ptr_t write_table_all_states(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, std::error_code & ec) const;
+    void    write_table_all_states_behind(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, xtablestate_ext_ptr_t const& tablestate) const;
+    void    write_pending_states_to_db(std::string const& block_hash, std::string const& block_desc, xtablestate_store_ptr_t const& tablestate_store,
+                                       bool has_executed_info, uint64_t executed_height, std::string const& executed_hash) const;
 
     data::xunitstate_ptr_t make_state_from_current_unit(common::xaccount_address_t const& unit_addr, base::xvblock_t * current_block, std::error_code & ec) const;
     data::xunitstate_ptr_t make_state_from_prev_state_and_unit(common::xaccount_address_t const& unit_addr, base::xvblock_t * current_block, data::xunitstate_ptr_t const& prev_bstate, std::error_code & ec) const;
@@ -76,6 +88,13 @@ protected:
     xstatestore_base_t          m_statestore_base;
     xstatestore_accessor_t      m_state_accessor;
     xexecute_listener_face_t *  m_execute_listener{nullptr};
+
+    // the states of executed blocks still written by the background writer, executed height in db never passes them
+    mutable std::mutex              m_write_behind_lock;
+    mutable std::condition_variable m_write_behind_cond;
+    mutable uint32_t                m_write_behind_blocks{0};
+    mutable bool                    m_write_behind_failed{false};
+    mutable uint64_t                m_persisted_height{0};
 };
 
 NS_END2
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "xbasic/xmemory.hpp"
 #include "xdata/xtable_bstate.h"
 #include "xdata/xunit_bstate.h"
@@ -86,6 +87,8 @@ class xstatestore_face_t {
     virtual uint64_t get_latest_executed_block_height(common::xaccount_address_t const & table_address) const = 0;
     virtual uint64_t get_need_sync_state_block_height(common::xaccount_address_t const & table_address) const = 0;
     virtual xtablestate_ext_ptr_t do_commit_table_all_states(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, std::error_code & ec) const = 0;
+    // tables served by this node are caught up first after restart
+    virtual void prioritize_tables_catch_up(std::vector<common::xaccount_address_t> const & table_addrs) = 0;
 };
 
 class xstatestore_hub_t {
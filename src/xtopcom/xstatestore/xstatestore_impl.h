@@ -9,6 +9,7 @@
 #include "xdata/xtable_bstate.h"
 #include "xdata/xunit_bstate.h"
 #include "xmbus/xmessage_bus.h"
+#include "xstatestore/xstatestore_catchup.h"
 #include "xstatestore/xstatestore_face.h"
 #include "xstatestore/xstatestore_table.h"
 #include "xstatestore/xstatestore_resource.h"
@@ -55,6 +56,7 @@ class xstatestore_impl_t : public xstatestore_face_t {
     virtual uint64_t get_latest_executed_block_height(common::xaccount_address_t const & table_address) const override;
     virtual uint64_t get_need_sync_state_block_height(common::xaccount_address_t const & table_address) const override;
     virtual xtablestate_ext_ptr_t do_commit_table_all_states(base::xvblock_t* current_block, xtablestate_store_ptr_t const& tablestate_store, std::error_code & ec) const override;
+    virtual void prioritize_tables_catch_up(std::vector<common::xaccount_address_t> const & table_addrs) override;
 
     // void prune();
 
@@ -83,6 +85,7 @@ private:
     bool m_started{false};
     xobject_ptr_t<statestore_prune_dispatcher_t> m_prune_dispather{nullptr};
     std::shared_ptr<xstatestore_resources_t> m_para;
+    std::unique_ptr<xstatestore_catchup_t> m_catchup;
 };
 
 class xstatestore_timer_t : public top::base::xxtimer_t {
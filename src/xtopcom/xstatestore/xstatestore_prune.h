@@ -10,7 +10,10 @@
 #include "xstatestore/xstatestore_base.h"
 #include "xstatestore/xstatestore_resource.h"
 
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 NS_BEG2(top, statestore)
 
@@ -25,15 +28,24 @@ private:
     std::map<std::string, uint64_t> m_prune_info;   // key:account, value:max delete unit height
 };
 
+// table states and offdata of a height are all under its state height key, so a section of heights is deleted by range.
+// states of full blocks are kept, so heights of full blocks are left out of ranges and their keys are deleted one by one.
+// heights without loaded blocks are left out as well, nothing is deleted under them.
 class xtablestate_and_offdata_prune_info_t {
 public:
     void insert_from_tableblock(base::xvblock_t * table_block);
-    const std::vector<std::string> & get_tablestate_prune_keys() const;
-    const std::vector<std::string> & get_offdata_prune_keys() const;
+    // ["begin_key", "end_key") of state height keys from from_height to to_height
+    std::vector<std::pair<std::string, std::string>> get_prune_ranges(base::xvaccount_t const & table, uint64_t from_height, uint64_t to_height) const;
+    std::vector<std::string> get_prune_keys() const;
+    // keys written before table states and offdata moved to the state height key
+    const std::vector<std::string> & get_legacy_prune_keys() const;
+    std::size_t get_prune_count() const;
 
 private:
-    std::vector<std::string> m_tablestate_keys;
-    std::vector<std::string> m_offdata_keys;
+    std::set<uint64_t> m_full_heights;
+    std::map<uint64_t, std::vector<std::string>> m_height_keys;
+    std::vector<std::string> m_legacy_keys;
+    std::size_t m_prune_count{0};
 };
 
 class xstatestore_prune_t : public std::enable_shared_from_this<xstatestore_prune_t> {
@@ -45,8 +57,10 @@ public:
 
 // protected:
 private:
-    void prune_imp(uint64_t exec_height);
-    void unitstate_prune_batch(const xaccounts_prune_info_t & accounts_prune_info);
+    // return the db ops issued, the prune thread is paced by them
+    uint32_t prune_imp(uint64_t exec_height);
+    uint32_t unitstate_prune_batch(const xaccounts_prune_info_t & accounts_prune_info);
+    uint32_t tablestate_and_offdata_prune_batch(const xtablestate_and_offdata_prune_info_t & prune_info, uint64_t from_height, uint64_t to_height);
     common::xaccount_address_t const & get_account() const {return m_table_addr;}
     bool need_prune(uint64_t exec_height);
     bool get_prune_section(uint64_t exec_height, uint64_t & from_height, uint64_t & to_height);
@@ -55,14 +69,17 @@ private:
 private:
     void init();
     // virtual uint64_t prune_exec(uint64_t from_height, uint64_t to_height) = 0;
-    uint64_t prune_exec_storage(uint64_t from_height, uint64_t to_height);
-    uint64_t prune_exec_storage_and_cons(uint64_t from_height, uint64_t to_height);
-    uint64_t prune_exec_cons(uint64_t from_height, uint64_t to_height, uint64_t exec_height);
+    uint64_t prune_exec_storage(uint64_t from_height, uint64_t to_height, uint32_t & ops);
+    uint64_t prune_exec_storage_and_cons(uint64_t from_height, uint64_t to_height, uint32_t & ops);
+    uint64_t prune_exec_cons(uint64_t from_height, uint64_t to_height, uint64_t exec_height, uint32_t & ops);
 
 private:
     mutable std::mutex m_prune_lock;
     common::xaccount_address_t m_table_addr;
     uint64_t m_pruned_height{0};
+    bool m_prune_queued{false};
+    bool m_legacy_keys_pruned{false};
+    uint64_t m_compact_from_height{0};
     xstatestore_base_t m_statestore_base;
     std::shared_ptr<xstatestore_resources_t> m_para;
 };
@@ -40,6 +40,7 @@ public:
     uint64_t                get_latest_executed_block_height() const;
     uint64_t                get_need_sync_state_block_height() const;
     void                    raise_execute_height(const xstate_sync_info_t & sync_info);
+    uint64_t                catch_up_execute_height() const;
     virtual void            on_executed(uint64_t height);    
 
 private:
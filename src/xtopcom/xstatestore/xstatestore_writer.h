@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcommon/xaccount_address.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NS_BEG2(top, statestore)
+
+/* background writer of the states committed by table execution, shared by all tables of the node.
+ * a table always goes to the same worker, so the jobs of one table run in the order they are posted.
+ */
+class xstatestore_writer_t {
+public:
+    static constexpr std::size_t worker_count{4};
+
+    xstatestore_writer_t();
+    ~xstatestore_writer_t();
+    xstatestore_writer_t(xstatestore_writer_t const &) = delete;
+    xstatestore_writer_t & operator=(xstatestore_writer_t const &) = delete;
+
+    static xstatestore_writer_t & instance();
+
+    void post(common::xaccount_address_t const & table_addr, std::function<void()> job);
+
+    /// @brief Waits for the jobs posted before the call.
+    void flush();
+
+private:
+    struct xworker_t {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<std::function<void()>> jobs;
+        bool stop{false};
+        std::thread thread;
+    };
+
+    static void run(xworker_t & worker);
+
+    std::vector<std::unique_ptr<xworker_t>> m_workers;
+};
+
+NS_END2
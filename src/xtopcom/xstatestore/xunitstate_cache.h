@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xcommon/xaccount_address.h"
+#include "xdata/xunit_bstate.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+NS_BEG2(top, statestore)
+
+struct xunitstate_cache_table_stats_t {
+    uint64_t hits{0};
+    uint64_t misses{0};
+};
+
+/* unit states of all the tables of the node under one byte budget, keyed by the hash of the unit block.
+ * each of the two parts evicts as a segmented lru: a state enters the probation segment and moves to the protected
+ * segment on its second hit, so states read again outlive the ones read once whatever table they belong to.
+ * the reserved part keeps the states written by table execution, which the next blocks of the executing tables read,
+ * and states loaded on reads cannot evict them. the shared part holds the states loaded from db or built on reads.
+ * keys are spread over shards with their own lock, the budgets are split evenly over the shards.
+ */
+class xunitstate_cache_t {
+public:
+    static constexpr std::size_t shard_count{16};
+
+    xunitstate_cache_t(uint64_t shared_bytes, uint64_t reserved_bytes);
+
+    /// @brief The cache of the node, sized by unitstate_cache_max_bytes and unitstate_cache_reserved_bytes.
+    static xunitstate_cache_t & instance();
+
+    /// @brief Gives the state_bytes of the state put too when state_bytes is not null.
+    data::xunitstate_ptr_t get(common::xaccount_address_t const & table_address, std::string const & block_hash, std::size_t * state_bytes = nullptr);
+
+    /// @brief Keeps a state of state_bytes (its serialized size) in the reserved part when executed is set.
+    void put(common::xaccount_address_t const & table_address,
+             std::string const & block_hash,
+             data::xunitstate_ptr_t const & state,
+             std::size_t state_bytes,
+             bool executed);
+
+    void clear();
+
+    /// @brief Evicts the states loaded on reads until the cache holds at most target_bytes, or only reserved states.
+    void shrink(uint64_t target_bytes);
+
+    std::size_t size() const;
+    uint64_t bytes() const;
+
+    std::map<std::string, xunitstate_cache_table_stats_t> table_stats() const;
+
+    /// @brief Sets the gauges of the size and of the hit rate of every table (in permille).
+    void export_metrics() const;
+
+private:
+    enum class xsegment_t : uint8_t { probation, protect };
+
+    struct xentry_t {
+        data::xunitstate_ptr_t state;
+        uint64_t bytes{0};
+        std::list<std::string>::iterator position;
+        xsegment_t segment{xsegment_t::probation};
+        bool reserved{false};
+    };
+
+    struct xpart_t {
+        uint64_t max_bytes{0};
+        uint64_t bytes{0};
+        uint64_t protected_bytes{0};
+        std::list<std::string> probation;  // most recent first
+        std::list<std::string> protect;
+    };
+
+    struct xshard_t {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, xentry_t> entries;
+        xpart_t shared;
+        xpart_t reserved;
+        std::map<std::string, xunitstate_cache_table_stats_t> stats;
+    };
+
+    xshard_t & shard_of(std::string const & block_hash);
+    static xpart_t & part_of(xshard_t & shard, xentry_t const & entry);
+    static void touch(xshard_t & shard, xentry_t & entry);
+    static void erase(xshard_t & shard, std::unordered_map<std::string, xentry_t>::iterator it);
+    static void evict(xshard_t & shard, xpart_t & part);
+    void export_metrics_periodically();
+
+    std::vector<std::unique_ptr<xshard_t>> m_shards;
+    std::atomic<int64_t> m_last_export_ms{0};
+};
+
+NS_END2
@@ -12,8 +12,58 @@
 #include "xsystem_contract_runtime/xsystem_contract_manager.h"
 #include "xsystem_contracts/xtransfer_contract.h"
 
+#include <unordered_map>
+
 NS_BEG2(top, contract_runtime)
 
+namespace {
+
+/// @brief Lends the system contract object of an address to one execution. Building a contract object registers a dozen
+///        properties, yet the object keeps nothing between calls but the execution context execute() is given. So each
+///        executor thread keeps one object per contract, created by the manager on first use. An object still executing
+///        (nested call of the same contract) is not lent twice, the nested call gets an object of its own.
+class xsystem_contract_lease_t {
+    struct xcached_contract_t {
+        std::unique_ptr<contract_common::xbasic_contract_t> contract;
+        bool in_use{false};
+    };
+    using xcache_t = std::unordered_map<system::xsystem_contract_manager_t const *, std::unordered_map<common::xaccount_base_address_t, xcached_contract_t>>;
+
+    xcached_contract_t * m_cached{nullptr};
+    std::unique_ptr<contract_common::xbasic_contract_t> m_owned;
+
+public:
+    xsystem_contract_lease_t(xsystem_contract_lease_t const &) = delete;
+    xsystem_contract_lease_t & operator=(xsystem_contract_lease_t const &) = delete;
+
+    xsystem_contract_lease_t(observer_ptr<system::xsystem_contract_manager_t> const & manager, common::xaccount_address_t const & address) {
+        thread_local xcache_t cache;
+        auto & cached = cache[manager.get()][address.base_address()];
+        if (cached.in_use) {
+            m_owned = manager->system_contract(address);
+            return;
+        }
+        if (cached.contract == nullptr) {
+            cached.contract = manager->system_contract(address);
+        }
+        cached.in_use = true;
+        m_cached = &cached;
+    }
+
+    ~xsystem_contract_lease_t() {
+        if (m_cached != nullptr) {
+            m_cached->contract->reset_execution_context(nullptr);  // the context dies with the session
+            m_cached->in_use = false;
+        }
+    }
+
+    observer_ptr<contract_common::xbasic_contract_t> contract() const noexcept {
+        return make_observer(m_cached != nullptr ? m_cached->contract.get() : m_owned.get());
+    }
+};
+
+}  // namespace
+
 xtop_action_runtime<data::xsystem_consensus_action_t>::xtop_action_runtime(observer_ptr<system::xsystem_contract_manager_t> const & system_contract_manager) noexcept
   : system_contract_manager_{system_contract_manager} {
 }
@@ -29,9 +79,9 @@ xtransaction_execution_result_t xtop_action_runtime<data::xsystem_consensus_acti
         assert(system_contract_manager_ != nullptr);
 
         // exe_ctx->system_contract(std::bind(&system::xsystem_contract_manager_t::system_contract, system_contract_manager_, std::placeholders::_1));
-        auto system_contract = system_contract_manager_->system_contract(exe_ctx->contract_address());
-        assert(system_contract != nullptr);
-        result = system_contract->execute(exe_ctx);
+        xsystem_contract_lease_t const system_contract{system_contract_manager_, exe_ctx->contract_address()};
+        assert(system_contract.contract() != nullptr);
+        result = system_contract.contract()->execute(exe_ctx);
     } catch (top::error::xtop_error_t const & eh) {
         result.status.ec = eh.code();
     } catch (std::exception const & eh) {
@@ -61,6 +61,11 @@ public:
      */
     void transfer1(std::string & to, std::string & amount, std::string & note, std::string & tx_deposit, std::ostringstream & out_str);
 
+    /*
+     * load generator, transfers among the accounts of private keys in keys_path, one hex key per line
+     */
+    void load_gen(const std::string & keys_path, uint32_t tx_per_account, uint32_t tps, uint32_t connections, std::ostringstream & out_str);
+
     /*
      * query transaction
      */
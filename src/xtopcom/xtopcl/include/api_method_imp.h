@@ -54,6 +54,12 @@ public:
                   std::ostringstream & out_str,
                   std::function<void(TransferResult *)> func = nullptr);
 
+    // signed transfer from uinfo.account with nonce uinfo.nonce, encoded as a request body for callers owning their connections
+    bool make_transfer_request(const user_info & uinfo, const std::string & to, uint64_t amount, std::string & tx_hash, std::string & content);
+
+    // query request body of method (CMD_ACCOUNT_INFO, CMD_ACCOUNT_TRANSACTION ...) with body params
+    void make_query_request(const user_info & uinfo, const std::string & method, const std::map<std::string, std::string> & params, std::string & content);
+
     bool estimategas(const user_info & uinfo,
                   const std::string & from,
                   const std::string & to,
@@ -210,6 +216,12 @@ public:
     bool getCGP(const user_info & uinfo, const std::string & target, std::ostringstream & out_str, std::function<void(GetProposalResult *)> func = nullptr);
 
 private:
+    bool sign_transfer(top::data::xtransaction_t * trans_action,
+                       const user_info & uinfo,
+                       const std::string & from,
+                       const std::string & to,
+                       uint64_t amount,
+                       const std::string & memo);
     bool hash_signature(top::data::xtransaction_t * trans_action, const std::array<uint8_t, PRI_KEY_LEN> & private_key);
 
     uint64_t get_timestamp();
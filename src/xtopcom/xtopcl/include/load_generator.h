@@ -0,0 +1,70 @@
+// Copyright (c) 2017-2021 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "api_method_imp.h"
+#include "json/json.h"
+#include "user_info.h"
+#include "xtopcl/include/web/client_http.hpp"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace xChainSDK {
+
+struct load_gen_config {
+    uint32_t tx_per_account{100};
+    uint32_t target_tps{100};
+    uint32_t connections{8};
+    uint32_t sign_threads{4};
+    uint32_t confirm_timeout_s{120};
+    uint64_t amount{1};
+};
+
+// stress a shard with transfers: transfers of all accounts are signed up front in parallel,
+// sent at target tps over keep-alive connections, and polled in bulk for end-to-end confirm latency.
+// account i transfers to account i+1, so funded accounts keep their balance through the ring.
+class load_generator final {
+public:
+    using HttpClient = SimpleWeb::Client<SimpleWeb::HTTP>;
+
+    load_generator(api_method_imp & api, std::vector<user_info> const & accounts, load_gen_config const & config);
+
+    void run(std::ostringstream & out_str);
+
+private:
+    struct xtx_load_t {
+        size_t account_index{0};
+        std::string hash;
+        std::string content;
+        std::atomic<uint64_t> send_ms{0};
+        std::atomic<uint64_t> confirm_ms{0};
+        std::atomic<bool> failed{false};
+    };
+
+    bool fetch_nonces(std::ostringstream & out_str);
+    void sign_all();
+    void submit(uint32_t connection_index);
+    void poll(uint32_t connection_index);
+    bool post(HttpClient & client, std::string const & content, xJson::Value & root);
+    void report(uint64_t sign_ms, uint64_t submit_ms, std::ostringstream & out_str);
+
+    // transfers of an account all go through the same connection, in nonce order
+    bool owned_by(size_t tx_index, uint32_t connection_index) const {
+        return m_txs[tx_index].account_index % m_config.connections == connection_index;
+    }
+
+    api_method_imp & m_api;
+    std::vector<user_info> m_accounts;
+    load_gen_config m_config;
+    std::vector<xtx_load_t> m_txs;  // account major: tx j of account i is at i * tx_per_account + j
+    std::atomic<bool> m_submit_done{false};
+    std::atomic<uint32_t> m_send_failed{0};
+    std::atomic<uint32_t> m_tx_failed{0};
+};
+
+}  // namespace xChainSDK
@@ -13,6 +13,7 @@
 #include "xpbase/base/top_utils.h"
 
 #include "console_log.h"
+#include "load_generator.h"
 
 #include <dirent.h>
 
@@ -23,6 +24,7 @@
 #include <iostream>
 #include <memory>
 #include <cmath>
+#include <thread>
 
 namespace xChainSDK {
 using namespace xcrypto;
@@ -883,6 +885,48 @@ void ApiMethod::transfer1(std::string & to, std::string & amount_d, std::string
     tackle_send_tx_request(out_str);
 }
 
+void ApiMethod::load_gen(const std::string & keys_path, uint32_t tx_per_account, uint32_t tps, uint32_t connections, std::ostringstream & out_str) {
+    std::ifstream keys_file(keys_path);
+    if (!keys_file) {
+        out_str << keys_path << " Open Error!" << std::endl;
+        return;
+    }
+    std::vector<user_info> accounts;
+    std::string pri_key;
+    while (std::getline(keys_file, pri_key)) {
+        if (pri_key.empty()) {
+            continue;
+        }
+        if (pri_key.size() > 2 && pri_key.substr(0, 2) == "0x") {
+            pri_key = pri_key.substr(2);
+        }
+        user_info uinfo;
+        if (!api_method_imp_.set_private_key(uinfo, pri_key)) {
+            out_str << "Invalid private key in " << keys_path << std::endl;
+            return;
+        }
+        accounts.push_back(uinfo);
+    }
+    if (accounts.empty()) {
+        out_str << "No private key in " << keys_path << std::endl;
+        return;
+    }
+
+    g_userinfo.account = accounts.front().account;
+    get_token();
+    for (auto & uinfo : accounts) {
+        uinfo.identity_token = g_userinfo.identity_token;
+    }
+
+    load_gen_config config;
+    config.tx_per_account = tx_per_account;
+    config.target_tps = tps;
+    config.connections = connections;
+    config.sign_threads = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+    load_generator generator(api_method_imp_, accounts, config);
+    generator.run(out_str);
+}
+
 void ApiMethod::estimategas(std::string & to, std::string & amount_d, std::string & note, std::string & tx_deposit_d, std::ostringstream & out_str) {
     std::ostringstream res;
     if (update_account(res) != 0) {
@@ -18,6 +18,7 @@
 #include "xvledger/xvblock.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <memory>
 
@@ -28,7 +29,7 @@ using namespace top::data;
 using namespace top::xvm;
 
 uint32_t get_sequence_id() {
-    static uint32_t sequence_id = 0;
+    static std::atomic<uint32_t> sequence_id{0};
     return ++sequence_id;
 }
 
@@ -173,32 +174,7 @@ bool api_method_imp::transfer(const user_info & uinfo,
     auto info = new task_info_callback<TransferResult>();
     set_user_info(info, uinfo, CMD_TRANSFER, func);
 
-    // body->params
-    xaction_asset_param asset_param(this, "", amount);
-    std::string param = asset_param.create();
-
-    info->trans_action->set_memo(memo);
-    info->trans_action->set_deposit(m_deposit);
-    info->trans_action->set_tx_type(xtransaction_type_transfer);
-    info->trans_action->set_last_nonce(uinfo.nonce);
-    info->trans_action->set_fire_timestamp(get_timestamp());
-    info->trans_action->set_expire_duration(100);
-
-    if (info->trans_action->get_tx_version() == xtransaction_version_2) {
-        info->trans_action->set_amount(amount);
-        info->trans_action->set_source_addr(from);
-        info->trans_action->set_target_addr(to);
-    } else {
-        info->trans_action->set_last_hash(uinfo.last_hash_xxhash64);
-        info->trans_action->set_source_action_type(xaction_type_asset_out);
-        info->trans_action->set_source_addr(from);
-        info->trans_action->set_source_action_para(param);
-        info->trans_action->set_target_action_type(xaction_type_asset_in);
-        info->trans_action->set_target_addr(to);
-        info->trans_action->set_target_action_para(param);
-    }
-    
-    if (!hash_signature(info->trans_action.get(), uinfo.private_key)) {
+    if (!sign_transfer(info->trans_action.get(), uinfo, from, to, amount, memo)) {
         delete info;
         return false;
     }
@@ -210,6 +186,33 @@ bool api_method_imp::transfer(const user_info & uinfo,
     return true;
 }
 
+bool api_method_imp::make_transfer_request(const user_info & uinfo, const std::string & to, uint64_t amount, std::string & tx_hash, std::string & content) {
+    task_info_callback<TransferResult> info;
+    set_user_info(&info, uinfo, CMD_TRANSFER, nullptr);
+    if (!sign_transfer(info.trans_action.get(), uinfo, uinfo.account, to, amount, "")) {
+        return false;
+    }
+    tx_hash = info.trans_action->get_digest_hex_str();
+
+    std::unique_ptr<protocol> proto(protocol::create(info.method));
+    proto->set_transaction(info.trans_action);
+    content.clear();
+    proto->encode(info.params, content);
+    return true;
+}
+
+void api_method_imp::make_query_request(const user_info & uinfo, const std::string & method, const std::map<std::string, std::string> & params, std::string & content) {
+    task_info_callback<ResultBase> info;
+    set_user_info(&info, uinfo, method, nullptr, false);
+    for (auto const & param : params) {
+        info.params[param.first] = param.second;
+    }
+
+    std::unique_ptr<protocol> proto(protocol::create(info.method));
+    content.clear();
+    proto->encode(info.params, content);
+}
+
 bool api_method_imp::estimategas(const user_info & uinfo,
                               const std::string & from,
                               const std::string & to,
@@ -443,6 +446,39 @@ bool api_method_imp::getProperty(const user_info & uinfo,
     return true;
 }
 
+bool api_method_imp::sign_transfer(top::data::xtransaction_t * trans_action,
+                                   const user_info & uinfo,
+                                   const std::string & from,
+                                   const std::string & to,
+                                   uint64_t amount,
+                                   const std::string & memo) {
+    xaction_asset_param asset_param(this, "", amount);
+    std::string param = asset_param.create();
+
+    trans_action->set_memo(memo);
+    trans_action->set_deposit(m_deposit);
+    trans_action->set_tx_type(xtransaction_type_transfer);
+    trans_action->set_last_nonce(uinfo.nonce);
+    trans_action->set_fire_timestamp(get_timestamp());
+    trans_action->set_expire_duration(100);
+
+    if (trans_action->get_tx_version() == xtransaction_version_2) {
+        trans_action->set_amount(amount);
+        trans_action->set_source_addr(from);
+        trans_action->set_target_addr(to);
+    } else {
+        trans_action->set_last_hash(uinfo.last_hash_xxhash64);
+        trans_action->set_source_action_type(xaction_type_asset_out);
+        trans_action->set_source_addr(from);
+        trans_action->set_source_action_para(param);
+        trans_action->set_target_action_type(xaction_type_asset_in);
+        trans_action->set_target_addr(to);
+        trans_action->set_target_action_para(param);
+    }
+
+    return hash_signature(trans_action, uinfo.private_key);
+}
+
 bool api_method_imp::hash_signature(top::data::xtransaction_t * trans_action, const std::array<std::uint8_t, PRI_KEY_LEN> & private_key) {
     trans_action->set_digest();
     std::string auth_str = xcrypto_util::digest_sign(trans_action->digest(), private_key);
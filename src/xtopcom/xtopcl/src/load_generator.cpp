@@ -0,0 +1,206 @@
+// Copyright (c) 2017-2021 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "load_generator.h"
+
+#include "global_definition.h"
+#include "request_result_definition.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace xChainSDK {
+
+static uint64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+load_generator::load_generator(api_method_imp & api, std::vector<user_info> const & accounts, load_gen_config const & config)
+  : m_api(api), m_accounts(accounts), m_config(config), m_txs(accounts.size() * config.tx_per_account) {
+    m_config.target_tps = std::max<uint32_t>(m_config.target_tps, 1);
+    m_config.connections = std::max<uint32_t>(std::min<uint32_t>(m_config.connections, m_accounts.size()), 1);
+    m_config.sign_threads = std::max<uint32_t>(m_config.sign_threads, 1);
+}
+
+void load_generator::run(std::ostringstream & out_str) {
+    if (m_accounts.size() < 2) {
+        out_str << "load generator needs at least 2 accounts." << std::endl;
+        return;
+    }
+    if (!fetch_nonces(out_str)) {
+        return;
+    }
+
+    auto const sign_begin = now_ms();
+    sign_all();
+    auto const sign_ms = now_ms() - sign_begin;
+
+    auto const submit_begin = now_ms();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < m_config.connections; ++i) {
+        threads.emplace_back(&load_generator::submit, this, i);
+        threads.emplace_back(&load_generator::poll, this, i);
+    }
+    for (size_t i = 0; i < threads.size(); i += 2) {
+        threads[i].join();
+    }
+    auto const submit_ms = now_ms() - submit_begin;
+    m_submit_done = true;
+    for (size_t i = 1; i < threads.size(); i += 2) {
+        threads[i].join();
+    }
+
+    report(sign_ms, submit_ms, out_str);
+}
+
+bool load_generator::fetch_nonces(std::ostringstream & out_str) {
+    HttpClient client(g_server_host_port);
+    for (auto & account : m_accounts) {
+        std::string content;
+        m_api.make_query_request(account, CMD_ACCOUNT_INFO, {{"account_addr", account.account}}, content);
+        xJson::Value root;
+        if (!post(client, content, root) || root["data"].empty()) {
+            out_str << account.account << " not found on chain!" << std::endl;
+            return false;
+        }
+        account.nonce = root["data"]["nonce"].asUInt();
+        account.balance = root["data"]["balance"].asUInt64();
+    }
+    return true;
+}
+
+void load_generator::sign_all() {
+    // only version 2 transactions chain by nonce, so every transfer of an account can be signed before any is sent
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < m_config.sign_threads; ++t) {
+        threads.emplace_back([this, t]() {
+            for (size_t i = t; i < m_accounts.size(); i += m_config.sign_threads) {
+                user_info uinfo = m_accounts[i];
+                auto const & to = m_accounts[(i + 1) % m_accounts.size()].account;
+                for (uint32_t j = 0; j < m_config.tx_per_account; ++j) {
+                    auto & tx = m_txs[i * m_config.tx_per_account + j];
+                    tx.account_index = i;
+                    if (!m_api.make_transfer_request(uinfo, to, m_config.amount, tx.hash, tx.content)) {
+                        tx.failed = true;
+                    }
+                    uinfo.nonce++;
+                }
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+}
+
+void load_generator::submit(uint32_t connection_index) {
+    HttpClient client(g_server_host_port);
+    // each connection sends its share of target tps, one round of its accounts at a time to keep nonce order
+    uint64_t const interval_us = 1000000ULL * m_config.connections / m_config.target_tps;
+    auto next_send = std::chrono::steady_clock::now();
+    for (uint32_t j = 0; j < m_config.tx_per_account; ++j) {
+        for (size_t i = connection_index; i < m_accounts.size(); i += m_config.connections) {
+            auto & tx = m_txs[i * m_config.tx_per_account + j];
+            if (tx.failed) {
+                continue;
+            }
+            std::this_thread::sleep_until(next_send);
+            next_send += std::chrono::microseconds(interval_us);
+
+            xJson::Value root;
+            auto const send_ms = now_ms();
+            if (!post(client, tx.content, root) || root[ERROR_NO].asInt() != 0) {
+                tx.failed = true;
+                m_send_failed++;
+                continue;
+            }
+            tx.send_ms = send_ms;
+        }
+    }
+}
+
+void load_generator::poll(uint32_t connection_index) {
+    HttpClient client(g_server_host_port);
+    uint64_t deadline_ms = 0;
+    for (;;) {
+        bool pending = false;
+        for (size_t i = 0; i < m_txs.size(); ++i) {
+            auto & tx = m_txs[i];
+            if (!owned_by(i, connection_index) || tx.send_ms == 0 || tx.confirm_ms != 0 || tx.failed) {
+                continue;
+            }
+            pending = true;
+
+            std::string content;
+            m_api.make_query_request(m_accounts[tx.account_index], CMD_ACCOUNT_TRANSACTION, {{"account_addr", m_accounts[tx.account_index].account}, {"tx_hash", tx.hash}}, content);
+            xJson::Value root;
+            if (!post(client, content, root)) {
+                continue;
+            }
+            auto const tx_state = root["data"]["tx_state"].asString();
+            if (tx_state == "success") {
+                tx.confirm_ms = now_ms();
+            } else if (tx_state == "fail") {
+                tx.confirm_ms = now_ms();
+                tx.failed = true;
+                m_tx_failed++;
+            }
+        }
+
+        if (m_submit_done) {
+            if (deadline_ms == 0) {
+                deadline_ms = now_ms() + m_config.confirm_timeout_s * 1000ULL;
+            }
+            if (!pending || now_ms() > deadline_ms) {
+                return;
+            }
+        }
+        if (!pending) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+bool load_generator::post(HttpClient & client, std::string const & content, xJson::Value & root) {
+    try {
+        auto response = client.request("POST", "/", content);
+        xJson::Reader reader;
+        return reader.parse(response->content.string(), root);
+    } catch (...) {
+        return false;
+    }
+}
+
+void load_generator::report(uint64_t sign_ms, uint64_t submit_ms, std::ostringstream & out_str) {
+    std::vector<uint64_t> latency;
+    uint32_t sign_failed = 0;
+    uint32_t sent = 0;
+    for (auto const & tx : m_txs) {
+        if (tx.send_ms != 0) {
+            sent++;
+        } else if (tx.failed && tx.content.empty()) {
+            sign_failed++;
+        }
+        if (tx.confirm_ms != 0 && !tx.failed) {
+            latency.push_back(tx.confirm_ms - tx.send_ms);
+        }
+    }
+    std::sort(latency.begin(), latency.end());
+    auto percentile = [&latency](uint32_t percent) -> uint64_t {
+        if (latency.empty()) {
+            return 0;
+        }
+        return latency[(latency.size() - 1) * percent / 100];
+    };
+
+    out_str << "accounts: " << m_accounts.size() << ", transactions: " << m_txs.size() << std::endl;
+    out_str << "signed in " << sign_ms << " ms, sign failed: " << sign_failed << std::endl;
+    out_str << "sent: " << sent << ", send failed: " << m_send_failed << ", in " << submit_ms << " ms, tps: " << (submit_ms > 0 ? sent * 1000ULL / submit_ms : sent)
+            << " (target " << m_config.target_tps << ")" << std::endl;
+    out_str << "confirmed: " << latency.size() << ", exec failed: " << m_tx_failed << ", unconfirmed: " << sent - latency.size() - m_tx_failed << std::endl;
+    out_str << "confirm latency ms p50: " << percentile(50) << " p90: " << percentile(90) << " p99: " << percentile(99) << " max: " << percentile(100) << std::endl;
+}
+
+}  // namespace xChainSDK
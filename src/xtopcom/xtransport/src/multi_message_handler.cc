@@ -5,12 +5,14 @@
 #include "xtransport/udp_transport/multi_message_handler.h"
 
 #include "xbase/xutl.h"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xmetrics/xmetrics.h"
 #include "xpbase/base/top_log.h"
 #include "xpbase/base/top_string_util.h"
 #include "xpbase/base/top_utils.h"
 #include "xtransport/udp_transport/transport_util.h"
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 
@@ -18,6 +20,12 @@ namespace top {
 
 namespace transport {
 
+enum {
+    enum_min_worker_threads_count = 2,
+    enum_max_worker_threads_count = 16,  // same as size of metrics transport_worker_queue_size
+    enum_cpu_cores_per_worker_thread = 8,
+};
+
 ThreadHandler::ThreadHandler(base::xiothread_t * raw_thread_ptr, const uint32_t raw_thread_index)
   : base::xiobject_t(base::xcontext_t::instance(), raw_thread_ptr->get_thread_id(), base::enum_xobject_type_thread) {
     xassert(raw_thread_ptr != NULL);
@@ -90,9 +98,15 @@ void ThreadHandler::unregister_on_dispatch_callback() {
     callback_ = nullptr;
 }
 
-MultiThreadHandler::MultiThreadHandler() {
+MultiThreadHandler::MultiThreadHandler(size_t worker_threads_count) {
 #ifdef __DIRECT_PASS_PACKET_WITHOUT_DATABOX__
     m_callback = nullptr;
+#else
+    if (worker_threads_count == 0) {
+        // 2 threads are enough for small machine, add one thread for every 8 cores of bigger one
+        worker_threads_count = std::thread::hardware_concurrency() / enum_cpu_cores_per_worker_thread;
+    }
+    m_woker_threads_count = std::min<size_t>(std::max<size_t>(worker_threads_count, enum_min_worker_threads_count), enum_max_worker_threads_count);
 #endif
 }
 
@@ -101,6 +115,7 @@ void MultiThreadHandler::Init() {
     for (size_t i = 0; i < m_woker_threads_count; ++i) {
         base::xiothread_t * raw_thread_ptr = base::xiothread_t::create_thread(base::xcontext_t::instance(), base::xiothread_t::enum_xthread_type_private, -1);
         m_worker_threads[i] = new ThreadHandler(raw_thread_ptr, i);
+        threading::set_thread_name(raw_thread_ptr, "transport" + std::to_string(i));
 
         TOP_INFO("starting thread(ThreadHandler)-index:%d and thread_id:%d", (int)i, raw_thread_ptr->get_thread_id());
     }
@@ -166,47 +181,31 @@ void MultiThreadHandler::HandleMessage(base::xpacket_t & packet) {
     return;
 #endif  //
 
-#if defined(DEBUG)
     uint32_t index = 0;
-#endif
     if (m_worker_threads.size() == 1u)  // optimize,direct post
     {
-        m_worker_threads[0]->get_databox()->send_packet(packet);
-#if defined(DEBUG)
         index = 0;
-#endif
     } else {
         if (priority_level >= enum_xpacket_priority_type_flash)  // priority packet
         {
-            m_worker_threads[0]->get_databox()->send_packet(packet);
-#if defined(DEBUG)
             index = 0;
-#endif
         } else if (m_worker_threads.size() == 2u) {
-            m_worker_threads[1]->get_databox()->send_packet(packet);
-#if defined(DEBUG)
             index = 1;
-#endif
         } else {
-            uint32_t hash_size = 128 < (packet.get_body().size() - enum_xbase_header_len) ? 128 : (packet.get_body().size() - enum_xbase_header_len);
-            const std::string src_data((const char *)packet.get_body().data() + enum_xbase_header_len, hash_size);
-            uint32_t msg_hash = base::xhash32_t::digest(src_data);
-
-            const uint32_t th_index = (msg_hash % (m_worker_threads.size() - 1)) + 1;  // thread 0 is reserved for priority packets
-            m_worker_threads[th_index]->get_databox()->send_packet(packet);
-#if defined(DEBUG)
-            index = th_index;
-#endif
+            // hash by sender, so packets from one peer keep their order at the same thread
+            uint32_t msg_hash = base::xhash32_t::digest(packet.get_from_ip_addr()) + packet.get_from_ip_port();
+            index = (msg_hash % (m_worker_threads.size() - 1)) + 1;  // thread 0 is reserved for priority packets
         }
     }  // end  if(enum_const_woker_threads_count == 1) //optimize,direct post
+    m_worker_threads[index]->get_databox()->send_packet(packet);
 
-#if defined(DEBUG)
     static std::atomic<uint32_t> packet_count(0);
     ++packet_count;
     if (packet_count % 64 == 0) {
         int64_t in = 0;
         int64_t out = 0;
         const int32_t total_holding = m_worker_threads[index]->get_databox()->count_packets(in, out);
+        XMETRICS_ARRCNT_SET(metrics::transport_worker_queue_size, index, total_holding);
         if (total_holding > 8192)  // too much packets pending in the queues
         {
             TOP_WARN("TOO MUCH PENDING,packet_count: thread_index:%d,thread_id:%d, packets(in:%lld out:%lld hold:%d)",
@@ -216,10 +215,9 @@ void MultiThreadHandler::HandleMessage(base::xpacket_t & packet) {
                      out,
                      total_holding);
         } else if (packet_count % 1024 == 0) {
-            TOP_INFO("packet_count: thread_index:%d,thread_id:%d, packets(in:%lld out:%lld hold:%d)", index, m_worker_threads[index]->get_thread_id(), in, out, total_holding);
+            TOP_DEBUG("packet_count: thread_index:%d,thread_id:%d, packets(in:%lld out:%lld hold:%d)", index, m_worker_threads[index]->get_thread_id(), in, out, total_holding);
         }
     }
-#endif
 }
 
 }  // namespace transport
@@ -5,6 +5,7 @@
 #include <string>
 
 #define XQC_PACKET_TMP_BUF_LEN 1500
+#define XQC_PACKET_RECV_BATCH 16                // datagrams read by one recvmmsg
 #define g_conn_check_timeout 1                  // 1s each check
 #define g_conn_timeout 25                       // 25s
 #define g_stream_handle_timeout 24              // 24s
@@ -22,7 +23,12 @@
 #include "xbasic/xmemory.hpp"
 
 #include <errno.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
 
+#include <fstream>
 #include <set>
 
 /**
@@ -109,6 +115,7 @@ void xquic_client_alive_timer(int fd, short what, void * user_data) {
     // printf("client try send alive at : %" PRIu64 " \n", xqc_now());
     xquic_client_t * client = (xquic_client_t *)user_data;
     client->quic_engine_do_connect();
+    client->quic_engine_do_close();
     client->quic_engine_do_send();
 }
 
@@ -230,16 +237,15 @@ ssize_t xquic_client_write_socket(const unsigned char * buf, size_t size, const
 }
 void xquic_client_save_token(const unsigned char * token, unsigned token_len, void * user_data) {
     cli_user_conn_t * cli_user_conn = (cli_user_conn_t *)user_data;
-    // char *ip = inet_ntoa(((struct sockaddr_in *)&cli_user_conn->peer_addr)->sin_addr);// might add connection address key
-    cli_user_conn->client->xclient_save_token_cb(token, token_len);
+    cli_user_conn->client->xclient_save_token_cb(cli_user_conn, token, token_len);
 }
 void xquic_client_save_session_cb(const char * data, size_t data_len, void * user_data) {
     cli_user_conn_t * cli_user_conn = (cli_user_conn_t *)user_data;
-    cli_user_conn->client->xclient_save_session_ticket_cb(data, data_len);
+    cli_user_conn->client->xclient_save_session_ticket_cb(cli_user_conn, data, data_len);
 }
 void xquic_client_save_tp_cb(const char * data, size_t data_len, void * user_data) {
     cli_user_conn_t * cli_user_conn = (cli_user_conn_t *)user_data;
-    cli_user_conn->client->xclient_save_transport_parameter_cb(data, data_len);
+    cli_user_conn->client->xclient_save_transport_parameter_cb(cli_user_conn, data, data_len);
 }
 int xquic_client_cert_verify(const unsigned char * certs[], const size_t cert_len[], size_t certs_len, void * conn_user_data) {
     /* self-signed cert used in test cases, return >= 0 means success */
@@ -554,6 +560,55 @@ void xqc_server_socket_write_handler(xquic_server_t * server) {
     return;
 }
 void xqc_server_socket_read_handler(xquic_server_t * server) {
+#if defined(__linux__)
+    // read a batch of datagrams by one syscall, buffers are allocated once per io thread and reused
+    static thread_local unsigned char packet_bufs[XQC_PACKET_RECV_BATCH][XQC_PACKET_TMP_BUF_LEN];
+    struct sockaddr_in peer_addrs[XQC_PACKET_RECV_BATCH];
+    struct iovec iovecs[XQC_PACKET_RECV_BATCH];
+    struct mmsghdr msgs[XQC_PACKET_RECV_BATCH];
+    int recv_count = 0;
+
+    do {
+        memset(msgs, 0, sizeof(msgs));
+        for (int i = 0; i < XQC_PACKET_RECV_BATCH; ++i) {
+            iovecs[i].iov_base = packet_bufs[i];
+            iovecs[i].iov_len = XQC_PACKET_TMP_BUF_LEN;
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &peer_addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        }
+        recv_count = recvmmsg(server->fd, msgs, XQC_PACKET_RECV_BATCH, 0, nullptr);
+        if (recv_count < 0 && get_last_sys_errno() == EAGAIN) {
+            break;
+        }
+
+        if (recv_count < 0) {
+            printf("!!!!!!!!!recvmmsg: recv_count = %d err=%s\n", recv_count, strerror(get_last_sys_errno()));
+            break;
+        }
+
+        uint64_t recv_time = xqc_now();
+        for (int i = 0; i < recv_count; ++i) {
+            xqc_int_t result = xqc_engine_packet_process(server->engine,
+                                                         packet_bufs[i],
+                                                         msgs[i].msg_len,
+                                                         (struct sockaddr *)(&server->local_addr),
+                                                         server->local_addrlen,
+                                                         (struct sockaddr *)(&peer_addrs[i]),
+                                                         msgs[i].msg_hdr.msg_namelen,
+                                                         (xqc_msec_t)recv_time,
+                                                         server);
+
+            if (result != XQC_OK) {
+                printf("xqc_server_read_handler: packet process err %d \n", result);
+                return;
+            }
+        }
+    } while (recv_count > 0);
+
+    xqc_engine_finish_recv(server->engine);
+#else
     ssize_t recv_sum = 0;
     struct sockaddr_in peer_addr;
     socklen_t peer_addrlen = sizeof(struct sockaddr_in);
@@ -594,6 +649,7 @@ void xqc_server_socket_read_handler(xquic_server_t * server) {
 
     // printf("server socket recv size:%zu\n", recv_sum);
     xqc_engine_finish_recv(server->engine);
+#endif
 }
 static void xqc_server_socket_event_callback(int fd, short what, void * arg) {
     xquic_server_t * server = (xquic_server_t *)arg;
@@ -1026,9 +1082,14 @@ cli_user_conn_t * xquic_client_t::connect(std::string const & server_addr, uint3
     cli_user_conn->conn_create_time = xqc_now();
     xquic_client_init_addr(cli_user_conn, server_addr.c_str(), server_port);
     cli_user_conn->server_addr = server_addr;
+    cli_user_conn->peer_key = server_addr + ":" + std::to_string(server_port);
     assert(cli_user_conn);
 
-    m_conn_queue.push(cli_user_conn);
+    if (!m_conn_queue.push(cli_user_conn)) {
+        xwarn("[xquic_client_engine]connect queue full, connection to %s:%u dropped", server_addr.c_str(), server_port);
+        delete cli_user_conn;
+        return nullptr;
+    }
     return cli_user_conn;
 }
 
@@ -1084,35 +1145,28 @@ void xquic_client_t::quic_engine_do_connect() {
         conn->ev_socket = event_new(eb, conn->fd, EV_READ | EV_PERSIST, xquic_client_socket_event_callback, conn);
         event_add(conn->ev_socket, NULL);
 
-        std::string read_token = xclient_read_token();
-        if (!read_token.empty()) {
-            conn->token = read_token;
+        auto const resumption = xclient_read_resumption(conn->peer_key);
+        if (!resumption.token.empty()) {
+            conn->token = resumption.token;
         }
 
         xqc_conn_ssl_config_t conn_ssl_config;
         memset(&conn_ssl_config, 0, sizeof(conn_ssl_config));
 
-        // perf read st/td 's key
-        char * session_ticket_data;
-        unsigned session_ticket_data_len = 0;
-        char * tp_data;
-        unsigned tp_data_len = 0;
-
-        xclient_read_session_ticket(&session_ticket_data, &session_ticket_data_len);
-        xclient_read_transport_parameter(&tp_data, &tp_data_len);
-
         // open ssl verify.
         // conn_ssl_config.cert_verify_flag |= XQC_TLS_CERT_FLAG_NEED_VERIFY;
         // conn_ssl_config.cert_verify_flag |= XQC_TLS_CERT_FLAG_ALLOW_SELF_SIGNED;
 
-        if (session_ticket_data_len == 0 || tp_data_len == 0) {
+        // session ticket with transport parameters of the same server make 0-RTT possible.
+        // both are copied by xqc_connect, so `resumption` only has to outlive the call.
+        if (resumption.session_ticket.empty() || resumption.transport_parameter.empty()) {
             conn_ssl_config.session_ticket_data = NULL;
             conn_ssl_config.transport_parameter_data = NULL;
         } else {
-            conn_ssl_config.session_ticket_data = session_ticket_data;
-            conn_ssl_config.session_ticket_len = session_ticket_data_len;
-            conn_ssl_config.transport_parameter_data = tp_data;
-            conn_ssl_config.transport_parameter_data_len = tp_data_len;
+            conn_ssl_config.session_ticket_data = const_cast<char *>(resumption.session_ticket.data());
+            conn_ssl_config.session_ticket_len = resumption.session_ticket.size();
+            conn_ssl_config.transport_parameter_data = const_cast<char *>(resumption.transport_parameter.data());
+            conn_ssl_config.transport_parameter_data_len = resumption.transport_parameter.size();
         }
 
         const xqc_cid_t * cid;
@@ -1137,6 +1191,25 @@ void xquic_client_t::quic_engine_do_connect() {
     }
 }
 
+void xquic_client_t::quic_engine_do_close() {
+    if (!m_close_queue.unsafe_size()) {
+        return;
+    }
+
+    auto all_connection = m_close_queue.wait_and_pop_all();
+    for (cli_user_conn_t * conn : all_connection) {
+        assert(conn != nullptr);
+        if (conn->conn_status == cli_conn_status_t::after_connected) {
+            continue;
+        }
+        xdbg("[xquic_client_engine]quic_engine_do_close close connection to %s", conn->peer_key.c_str());
+        int rc = xqc_conn_close(engine, &conn->cid);
+        if (rc) {
+            xwarn("[xquic_client_engine]quic_engine_do_close xqc_conn_close error %d", rc);
+        }
+    }
+}
+
 void xquic_client_t::quic_engine_do_send() {
     // must set next time do_send wake timer before return!
 
@@ -1153,6 +1226,11 @@ void xquic_client_t::quic_engine_do_send() {
 
         auto all_message = m_send_queue.wait_and_pop_all();
         xdbg("[xquic_client_engine]quic_engine_do_send: get size %zu ", all_message.size());
+        std::size_t popped_bytes = 0;
+        for (auto const & send_buffer_ptr : all_message) {
+            popped_bytes += send_buffer_ptr->send_data.size();
+        }
+        m_send_queue_bytes.fetch_sub(popped_bytes, std::memory_order_relaxed);
 
         for (auto & send_buffer_ptr : all_message) {
             cli_user_conn_t * cli_user_conn = send_buffer_ptr->cli_user_conn;
@@ -1168,7 +1246,7 @@ void xquic_client_t::quic_engine_do_send() {
             if (cli_user_conn->conn_status != cli_conn_status_t::well_connected) {
                 if (cli_user_conn->conn_status == cli_conn_status_t::before_connected && xqc_now() - cli_user_conn->conn_create_time < BEFORE_WELL_CONNECTED_KEEP_MSG_TIMER) {
                     xdbg("[xquic_client_engine]quic_engine_do_send: connection not well connected. messsage shoule be keep , push it back to queue");
-                    m_send_queue.push(std::move(send_buffer_ptr));
+                    requeue_send_buffer(std::move(send_buffer_ptr));
                     continue;
                 }
                 // connection error, has not established or after_connected.
@@ -1216,7 +1294,7 @@ void xquic_client_t::quic_engine_do_send() {
                 cli_user_stream->send_queue.insert(cli_user_stream->send_queue.end(), send_buffer_ptr->send_data.begin(), send_buffer_ptr->send_data.end());
             } else {
                 xwarn("[xquic_client_engine]quic_engine_do_send: send_queue_full at conn: %s", xqc_scid_str(&cli_user_conn->cid));
-                m_send_queue.push(std::move(send_buffer_ptr));
+                requeue_send_buffer(std::move(send_buffer_ptr));
                 continue;
             }
 
@@ -1240,15 +1318,37 @@ void xquic_client_t::quic_engine_do_send() {
     return;
 }
 
+/// NOTED: API, this function is used by quic_node thread. so be careful about multi-thread issus.
+bool xquic_client_t::close(cli_user_conn_t * cli_user_conn) {
+    if (!m_close_queue.push(cli_user_conn)) {
+        xwarn("[xquic_client_engine]close queue full, connection to %s kept", cli_user_conn->peer_key.c_str());
+        return false;
+    }
+    return true;
+}
+
 /// NOTED: API, this function is used by quic_node thread. so be careful about multi-thread issus.
 /// api for quic_node , create a event (`client_send_buffer_t`) and let client thread handle this send data buffer.
 bool xquic_client_t::send(cli_user_conn_t * cli_user_conn, top::xbytes_t send_data) {
+    if (m_send_queue.unsafe_size() >= max_send_queue_size) {
+        return false;
+    }
     std::unique_ptr<client_send_buffer_t> send_buffer_ptr = top::make_unique<client_send_buffer_t>();
     send_buffer_ptr->send_data = std::move(send_data);
     send_buffer_ptr->cli_user_conn = cli_user_conn;
 
-    m_send_queue.push(std::move(send_buffer_ptr));
+    return requeue_send_buffer(std::move(send_buffer_ptr));
+}
 
+// counts the bytes before the push, so the engine thread never sees the buffer without its bytes
+bool xquic_client_t::requeue_send_buffer(std::unique_ptr<client_send_buffer_t> send_buffer_ptr) {
+    auto const size = send_buffer_ptr->send_data.size();
+    m_send_queue_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (!m_send_queue.push(std::move(send_buffer_ptr))) {
+        m_send_queue_bytes.fetch_sub(size, std::memory_order_relaxed);
+        xwarn("[xquic_client_engine]send queue full, %zu bytes dropped, %" PRIu64 " in total", size, m_send_queue.dropped());
+        return false;
+    }
     return true;
 }
 
@@ -1267,3 +1367,90 @@ void xquic_client_t::release_connection(cli_user_conn_t * cli_user_conn) {
 
     free(cli_user_conn->local_addr);
 }
+
+xquic_resumption_t & xquic_client_t::resumption_of(std::string const & peer_key) {
+    // m_resumption_mutex is held outside
+    if (m_resumption.find(peer_key) == m_resumption.end() && m_resumption.size() >= max_resumption_size) {
+        m_resumption.erase(m_resumption.begin());
+    }
+    return m_resumption[peer_key];
+}
+
+xquic_resumption_t xquic_client_t::xclient_read_resumption(std::string const & peer_key) {
+    std::lock_guard<std::mutex> lock(m_resumption_mutex);
+    auto it = m_resumption.find(peer_key);
+    if (it == m_resumption.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+void xquic_client_t::xclient_save_token_cb(cli_user_conn_t const * cli_user_conn, const unsigned char * token, unsigned token_len) {
+    if (token_len > 0) {
+        std::lock_guard<std::mutex> lock(m_resumption_mutex);
+        resumption_of(cli_user_conn->peer_key).token.assign((char const *)token, static_cast<std::size_t>(token_len));
+    }
+}
+
+void xquic_client_t::xclient_save_session_ticket_cb(cli_user_conn_t const * cli_user_conn, const char * session, unsigned session_len) {
+    if (session_len > 0) {
+        std::lock_guard<std::mutex> lock(m_resumption_mutex);
+        resumption_of(cli_user_conn->peer_key).session_ticket.assign(session, static_cast<std::size_t>(session_len));
+    }
+}
+
+void xquic_client_t::xclient_save_transport_parameter_cb(cli_user_conn_t const * cli_user_conn, const char * tp_para, unsigned tp_para_len) {
+    if (tp_para_len > 0) {
+        std::lock_guard<std::mutex> lock(m_resumption_mutex);
+        resumption_of(cli_user_conn->peer_key).transport_parameter.assign(tp_para, static_cast<std::size_t>(tp_para_len));
+    }
+}
+
+// file layout: repeated [key][token][session_ticket][transport_parameter], each as uint32 length + bytes.
+static void write_resumption_field(std::ofstream & out, std::string const & field) {
+    uint32_t const len = static_cast<uint32_t>(field.size());
+    out.write((char const *)&len, sizeof(len));
+    out.write(field.data(), field.size());
+}
+
+static bool read_resumption_field(std::ifstream & in, std::string & field) {
+    uint32_t len{0};
+    if (!in.read((char *)&len, sizeof(len)) || len > MAX_BUF_SIZE) {
+        return false;
+    }
+    field.resize(len);
+    return static_cast<bool>(in.read(&field[0], len));
+}
+
+bool xquic_client_t::load_resumption(std::string const & file_path) {
+    std::ifstream in(file_path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_resumption_mutex);
+    std::string key;
+    xquic_resumption_t resumption;
+    while (read_resumption_field(in, key) && read_resumption_field(in, resumption.token) && read_resumption_field(in, resumption.session_ticket) &&
+           read_resumption_field(in, resumption.transport_parameter)) {
+        resumption_of(key) = resumption;
+    }
+    xinfo("[xquic_client_engine] load %zu resumption(s) from %s", m_resumption.size(), file_path.c_str());
+    return true;
+}
+
+bool xquic_client_t::save_resumption(std::string const & file_path) {
+    std::ofstream out(file_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        xwarn("[xquic_client_engine] open %s failed", file_path.c_str());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_resumption_mutex);
+    for (auto const & p : m_resumption) {
+        write_resumption_field(out, p.first);
+        write_resumption_field(out, p.second.token);
+        write_resumption_field(out, p.second.session_ticket);
+        write_resumption_field(out, p.second.transport_parameter);
+    }
+    xinfo("[xquic_client_engine] save %zu resumption(s) to %s", m_resumption.size(), file_path.c_str());
+    return static_cast<bool>(out);
+}
@@ -5,6 +5,7 @@
 #include "xtransport/udp_transport/udp_transport.h"
 
 #include "xbase/xcontext.h"
+#include "xbasic/xthreading/xthread_name.h"
 #include "xpbase/base/line_parser.h"
 #include "xpbase/base/top_log.h"
 #include "xpbase/base/top_utils.h"
@@ -68,6 +69,7 @@ bool UdpTransport::Init(std::string const & local_ip, uint16_t local_port, Multi
         TOP_ERROR("create xio thread failed!");
         return false;
     }
+    threading::set_thread_name(io_thread_, "udp_io");
     quic_node_ = std::make_shared<quic::xquic_node_t>(local_port);  // quic node should save p2p inbound port . as it can be user-configured.
 
     udp_handle_ = base::xsocket_utl::udp_listen("0.0.0.0", local_port);
@@ -207,5 +209,10 @@ int UdpTransport::CheckRatelimitMap(const std::string & to_addr) {
         return udp_socket_->CheckRatelimitMap(to_addr);
     return kTransportSuccess;
 }
+int UdpTransport::PreConnect(const std::string & peer_ip, uint16_t peer_port) {
+    if (udp_socket_)
+        return udp_socket_->PreConnect(peer_ip, peer_port);
+    return kTransportFailed;
+}
 }  // namespace transport
 }  // namespace top
@@ -20,6 +20,8 @@ static const std::size_t DEFAULT_QUIC_SERVER_PORT_DETLA = 1000;  // quic_port is
 static const std::size_t DEFAULT_QUIC_SERVER_PORT_DETLA = 1;  // quic_port is greater than p2p_port;
 #endif
 
+static const std::string QUIC_RESUMPTION_FILE = "./quic_resumption.dat";
+
 void xquic_node_t::check_cert_file() {
     std::ofstream cert_file_hd;
     cert_file_hd.open("./server.crt");
@@ -43,6 +45,7 @@ void xquic_node_t::start() {
     assert(!running());
 
     check_cert_file();
+    m_client_ptr->load_resumption(QUIC_RESUMPTION_FILE);
 
     auto self = shared_from_this();
     top::threading::xbackend_thread::spawn([this, self] {
@@ -60,6 +63,7 @@ void xquic_node_t::start() {
 void xquic_node_t::stop() {
     assert(running());
     running(false);
+    m_client_ptr->save_resumption(QUIC_RESUMPTION_FILE);
     xinfo("xquic_node_t::stop quic node stop.");
     assert(!running());
 }
@@ -80,14 +84,18 @@ int xquic_node_t::send_data(std::string const & data, std::string const & addr,
 
     std::unique_lock<std::mutex> lock(m_conn_map_mutex);
 
+    clean_closing_conns();
+
     // erase closed connection:
-    if (m_conn_map.find(addr_port) != m_conn_map.end() && m_conn_map.at(addr_port)->conn_status == cli_conn_status_t::after_connected) {
-        delete m_conn_map.at(addr_port);
+    auto it = m_conn_map.find(addr_port);
+    if (it != m_conn_map.end() && it->second.conn->conn_status == cli_conn_status_t::after_connected) {
+        delete it->second.conn;
         xdbg("xquic_node_t::send_data close connection to %s", addr_port.c_str());
-        m_conn_map.erase(addr_port);
+        erase_conn(addr_port);
+        it = m_conn_map.end();
     }
 
-    if (m_conn_map.find(addr_port) == m_conn_map.end()) {
+    if (it == m_conn_map.end()) {
         xdbg("xquic_node_t::send_data try connect to %s", addr_port.c_str());
         cli_user_conn_t * new_conn = m_client_ptr->connect(addr, port);
         if (new_conn == nullptr) {
@@ -96,9 +104,13 @@ int xquic_node_t::send_data(std::string const & data, std::string const & addr,
         }
         assert(new_conn);
         xdbg("xquic_node_t::send_data new connection to %s ptr: %p %p", addr_port.c_str(), new_conn, new_conn->cli_user_stream);
-        m_conn_map.insert({addr_port, new_conn});
+        m_conn_lru.push_front(addr_port);
+        it = m_conn_map.insert({addr_port, conn_entry_t{new_conn, m_conn_lru.begin()}}).first;
+        evict_conns();
+    } else {
+        m_conn_lru.splice(m_conn_lru.begin(), m_conn_lru, it->second.lru_pos);
     }
-    cli_user_conn_t * conn = m_conn_map.at(addr_port);
+    cli_user_conn_t * conn = it->second.conn;
     if (conn == nullptr) {
         assert(false);
         return 1;
@@ -118,6 +130,46 @@ int xquic_node_t::send_data(std::string const & data, std::string const & addr,
     return 0;  // kadmlia::kKadSuccess
 }
 
+void xquic_node_t::erase_conn(std::string const & addr_port) {
+    auto it = m_conn_map.find(addr_port);
+    if (it == m_conn_map.end()) {
+        return;
+    }
+    m_conn_lru.erase(it->second.lru_pos);
+    m_conn_map.erase(it);
+}
+
+void xquic_node_t::evict_conns() {
+    // m_conn_map_mutex is held outside. the just used connection is at the front, never evicted.
+    while (m_conn_map.size() > max_conn_pool_size) {
+        auto const addr_port = m_conn_lru.back();
+        cli_user_conn_t * conn = m_conn_map.at(addr_port).conn;
+        if (conn->conn_status == cli_conn_status_t::after_connected) {
+            delete conn;
+        } else {
+            if (!m_client_ptr->close(conn)) {
+                return;
+            }
+            m_closing_conns.push_back(conn);
+        }
+        xdbg("xquic_node_t::evict_conns evict connection to %s", addr_port.c_str());
+        XMETRICS_COUNTER_INCREMENT("xquic_conn_evicted", 1);
+        erase_conn(addr_port);
+    }
+}
+
+void xquic_node_t::clean_closing_conns() {
+    // m_conn_map_mutex is held outside
+    for (auto it = m_closing_conns.begin(); it != m_closing_conns.end();) {
+        if ((*it)->conn_status == cli_conn_status_t::after_connected) {
+            delete *it;
+            it = m_closing_conns.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void xquic_node_t::on_quic_message_ready(top::xbytes_t const & bytes, std::string const & peer_ip, std::size_t peer_inbound_port) {
     transport::protobuf::RoutingMessage proto_message;
     if (proto_message.ParseFromArray((const char *)bytes.data() + enum_xbase_header_len, bytes.size() - enum_xbase_header_len) == false) {
@@ -425,27 +425,53 @@ int XudpSocket::SendDataWithProp(base::xpacket_t & packet, UdpPropertyPtr & udp_
     }
 
     // add connect for xudp
+    std::unique_lock<std::recursive_mutex> autolock(xudp_mutex_);
+    xp2pudp_t * peer_xudp_socket = GetOrConnectXudp(packet.get_to_ip_addr(), packet.get_to_ip_port());
+    if (peer_xudp_socket == nullptr) {
+        return kTransportSuccess;
+    }
+
+    if (udp_property != nullptr) {
+        udp_property->SetXudp(peer_xudp_socket);
+        TOP_DEBUG("setxudp,udp_property:%p,xudp:%p", udp_property.get(), peer_xudp_socket);
+    } else {
+        TOP_DEBUG("udp_property null");
+    }
+
+    if (peer_xudp_socket->send(packet) != enum_xcode_successful) {
+        TOP_ERROR("send xpacket failed!packet size is :%d\n", packet.get_size());
+        return kTransportFailed;
+    }
+    TOP_DEBUG("send xpacket packet size:%d src %s:%d dest %s:%d\n",
+              packet.get_size(),
+              packet.get_from_ip_addr().c_str(),
+              packet.get_from_ip_port(),
+              packet.get_to_ip_addr().c_str(),
+              packet.get_to_ip_port());
+
+    return kTransportSuccess;
+}
+xp2pudp_t * XudpSocket::GetOrConnectXudp(const std::string & peer_ip, uint16_t peer_port) {
     std::map<std::string, xp2pudp_t *>::iterator iter;
     int ret;
-    std::unique_lock<std::recursive_mutex> autolock(xudp_mutex_);
-    std::string to_addr(packet.get_to_ip_addr() + ":" + std::to_string(packet.get_to_ip_port()));
+    std::string to_addr(peer_ip + ":" + std::to_string(peer_port));
     iter = xudp_client_map.find(to_addr);
     xp2pudp_t * peer_xudp_socket = nullptr;
     if (iter == xudp_client_map.end()) {
         if ((ret = CheckRatelimitMap(to_addr)) != enum_xcode_successful) {
             TOP_ERROR("reach xudp connection rate limit, drop this packet:%s,ret:%d", to_addr.c_str(), ret);
-            return kTransportSuccess;
+            return nullptr;
         }
-        TOP_DEBUG("not find:%s, size:%d", to_addr.c_str(), packet.get_body().size());
+        TOP_DEBUG("not find:%s", to_addr.c_str());
         //        peer_xudp_socket = (xp2pudp_t*)xudplisten_t::create_xslsocket(enum_socket_type_xudp);
         std::string node_sign;
         if (GetSign(node_sign) != enum_xcode_successful) {
             TOP_ERROR("get sign failed.");
-            return kTransportSuccess;
+            return nullptr;
         }
-        TOP_DEBUG("xudp first connect %s:%u", packet.get_to_ip_addr().c_str(), packet.get_to_ip_port());
+        TOP_DEBUG("xudp first connect %s:%u", peer_ip.c_str(), peer_port);
         peer_xudp_socket = (xp2pudp_t *)xudplisten_t::create_xslsocket(global_node_id, node_sign, XUDP_VERSION, enum_socket_type_xudp);
-        peer_xudp_socket->connect_xudp(packet.get_to_ip_addr(), packet.get_to_ip_port(), this);
+        peer_xudp_socket->connect_xudp(peer_ip, peer_port, this);
 
         xudp_client_map[to_addr] = peer_xudp_socket;
         XMETRICS_COUNTER_INCREMENT("xtransport_xudp_num", 1);
@@ -453,7 +479,7 @@ int XudpSocket::SendDataWithProp(base::xpacket_t & packet, UdpPropertyPtr & udp_
         AddToRatelimitMap(to_addr);
     } else {
         peer_xudp_socket = xudp_client_map[to_addr];
-        TOP_DEBUG("find:%s, size:%d", to_addr.c_str(), packet.get_body().size());
+        TOP_DEBUG("find:%s", to_addr.c_str());
 
         if (peer_xudp_socket->is_close() || (peer_xudp_socket->GetStatus() == top::transport::enum_xudp_status::enum_xudp_closed) ||
             (peer_xudp_socket->GetStatus() == top::transport::enum_xudp_status::enum_xudp_closed_released)) {
@@ -470,16 +496,16 @@ int XudpSocket::SendDataWithProp(base::xpacket_t & packet, UdpPropertyPtr & udp_
 
             if ((ret = CheckRatelimitMap(to_addr)) != enum_xcode_successful) {
                 TOP_ERROR("reach xudp connection rate limit2, drop this packet:%s, ret:%d", to_addr.c_str(), ret);
-                return kTransportSuccess;
+                return nullptr;
             }
             std::string node_sign;
             if (GetSign(node_sign) != enum_xcode_successful) {
                 TOP_ERROR("get sign failed.");
-                return kTransportSuccess;
+                return nullptr;
             }
-            TOP_DEBUG("xudp reconnect %s:%u", packet.get_to_ip_addr().c_str(), packet.get_to_ip_port());
+            TOP_DEBUG("xudp reconnect %s:%u", peer_ip.c_str(), peer_port);
             peer_xudp_socket = (xp2pudp_t *)xudplisten_t::create_xslsocket(global_node_id, node_sign, XUDP_VERSION, enum_socket_type_xudp);
-            peer_xudp_socket->connect_xudp(packet.get_to_ip_addr(), packet.get_to_ip_port(), this);
+            peer_xudp_socket->connect_xudp(peer_ip, peer_port, this);
 
             xudp_client_map[to_addr] = peer_xudp_socket;
             XMETRICS_COUNTER_INCREMENT("xtransport_xudp_num", 1);
@@ -487,27 +513,20 @@ int XudpSocket::SendDataWithProp(base::xpacket_t & packet, UdpPropertyPtr & udp_
             TOP_INFO("reconn %s:%p", to_addr.c_str(), peer_xudp_socket);
         }
     }
+    return peer_xudp_socket;
+}
 
-    if (udp_property != nullptr) {
-        udp_property->SetXudp(peer_xudp_socket);
-        TOP_DEBUG("setxudp,udp_property:%p,xudp:%p", udp_property.get(), peer_xudp_socket);
-    } else {
-        TOP_DEBUG("udp_property null");
+int XudpSocket::PreConnect(const std::string & peer_ip, uint16_t peer_port) {
+    if (peer_port == 0 || (GetLocalIp() == peer_ip && GetLocalPort() == peer_port)) {
+        return kTransportFailed;
     }
-
-    if (peer_xudp_socket->send(packet) != enum_xcode_successful) {
-        TOP_ERROR("send xpacket failed!packet size is :%d\n", packet.get_size());
+    std::unique_lock<std::recursive_mutex> autolock(xudp_mutex_);
+    if (GetOrConnectXudp(peer_ip, peer_port) == nullptr) {
         return kTransportFailed;
     }
-    TOP_DEBUG("send xpacket packet size:%d src %s:%d dest %s:%d\n",
-              packet.get_size(),
-              packet.get_from_ip_addr().c_str(),
-              packet.get_from_ip_port(),
-              packet.get_to_ip_addr().c_str(),
-              packet.get_to_ip_port());
-
     return kTransportSuccess;
 }
+
 int XudpSocket::GetSign(std::string & node_sign) {
     if (global_node_id.empty() || global_node_signkey.empty())
         return enum_xerror_code_fail;
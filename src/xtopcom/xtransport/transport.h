@@ -48,6 +48,8 @@ public:
     virtual int RegisterOfflineCallback(std::function<void(const std::string & ip, const uint16_t port)> cb) = 0;
     virtual int RegisterNodeCallback(std::function<int32_t(std::string const & node_addr, std::string const & node_sign)> cb) = 0;
     virtual int CheckRatelimitMap(const std::string & to_addr) = 0;
+    // set up the connection to the peer ahead of the first packet, e.g. for the peers of an elected group before the group starts
+    virtual int PreConnect(const std::string & peer_ip, uint16_t peer_port) = 0;
 
 protected:
     Transport() {
@@ -71,7 +71,8 @@ private:
 
 class MultiThreadHandler : public std::enable_shared_from_this<MultiThreadHandler> {
 public:
-    MultiThreadHandler();
+    // worker_threads_count 0 means sized by cpu cores
+    explicit MultiThreadHandler(size_t worker_threads_count = 0);
     ~MultiThreadHandler();
 
     void Init();
@@ -87,7 +88,7 @@ private:
     on_receive_callback_t m_callback;
     size_t m_woker_threads_count{0};  // if need asynch message-handle,may create 1 threads
 #else
-    size_t m_woker_threads_count{2};  // 2 threads are enough to handle messages
+    size_t m_woker_threads_count{2};  // thread 0 for priority packets, others for normal packets
 #endif
     std::vector<ThreadHandler *> m_worker_threads;
 };
@@ -64,6 +64,7 @@ public:
     virtual int RegisterOfflineCallback(std::function<void(const std::string & ip, const uint16_t port)> cb) override;
     virtual int RegisterNodeCallback(std::function<int32_t(std::string const & node_addr, std::string const & node_sign)> cb) override;
     virtual int CheckRatelimitMap(const std::string & to_addr) override;
+    virtual int PreConnect(const std::string & peer_ip, uint16_t peer_port) override;
 
 private:
     void SetOptBuffer();
@@ -182,6 +182,7 @@ public:
     virtual int RegisterOfflineCallback(std::function<void(const std::string & ip, const uint16_t port)> cb) override;
     virtual int RegisterNodeCallback(std::function<int32_t(std::string const & node_addr, std::string const & node_sign)> cb) override;
     virtual int CheckRatelimitMap(const std::string & to_addr) override;
+    virtual int PreConnect(const std::string & peer_ip, uint16_t peer_port) override;
 
 protected:
     virtual xslsocket_t * create_xslsocket(xendpoint_t * parent, xfd_handle_t handle, xsocket_property & property, int32_t cur_thread_id, uint64_t timenow_ms) override;
@@ -206,6 +207,9 @@ private:
     XudpSocket & operator=(const XudpSocket &);
     int AddToRatelimitMap(const std::string & to_addr);
     int GetSign(std::string & node_sign);
+    // connected or connecting xudp to the peer, a new one if there is none or it is closed. nullptr if it can't connect now.
+    // xudp_mutex_ is held outside
+    xp2pudp_t * GetOrConnectXudp(const std::string & peer_ip, uint16_t peer_port);
 
 #ifdef ENABLE_XSECURITY
     uint32_t IpToUInt(const std::string & ip);
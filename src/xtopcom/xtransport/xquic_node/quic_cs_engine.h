@@ -1,7 +1,7 @@
 #pragma once
 
 #include "xbasic/xbyte_buffer.h"
-#include "xbasic/xthreading/xthreadsafe_queue.hpp"
+#include "xbasic/xthreading/xbounded_queue.hpp"
 
 #include <errno.h>
 #include <event2/event.h>
@@ -19,7 +19,9 @@
 #include <atomic>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 class xquic_server_t;
@@ -69,6 +71,7 @@ struct cli_user_conn_t {
     xqc_cid_t cid;
 
     std::string server_addr{""};
+    std::string peer_key{""};  // server addr:port
     struct sockaddr peer_addr;
     socklen_t peer_addrlen;
     struct sockaddr * local_addr;
@@ -110,6 +113,12 @@ struct srv_user_stream_t {
     std::size_t peer_inbound_port{0};
 };
 
+struct xquic_resumption_t {
+    std::string token;
+    std::string session_ticket;
+    std::string transport_parameter;
+};
+
 struct client_send_buffer_t {
     top::xbytes_t send_data;
     cli_user_conn_t * cli_user_conn{nullptr};
@@ -156,66 +165,39 @@ private:
     std::size_t m_inbound_port{0};
 
 public:
+    // backpressure by bytes waiting for quic engine thread, count limit only guards the queue capacity
     bool send_queue_full() {
-        return m_send_queue.unsafe_size() > 10000;
-    }
-
-    std::string xclient_read_token() {
-        // printf("read_token: %s\n", m_token.c_str());
-        return m_token;
-    }
-
-    void xclient_save_token_cb(const unsigned char * token, unsigned token_len) {
-        if (token_len > 0) {
-            m_token.clear();
-            m_token.assign((char *)token, static_cast<std::size_t>(token_len));
-            // printf("save_token: %s\n", m_token.c_str());
-        }
+        return m_send_queue_bytes.load(std::memory_order_relaxed) > max_send_queue_bytes || m_send_queue.unsafe_size() >= max_send_queue_size;
     }
 
-    void xclient_read_session_ticket(char ** session, unsigned * session_len) {
-        if (m_session_len) {
-            *session = (char *)malloc(m_session_len);
-            memcpy(*session, m_session, m_session_len);
-            *session_len = m_session_len;
-        }
-    }
-    void xclient_save_session_ticket_cb(const char * session, unsigned session_len) {
-        if (session_len) {
-            m_session_len = session_len;
-            m_session = (char *)malloc(m_session_len);
-            memcpy(m_session, session, m_session_len);
-        }
-    }
+    // resumption data are kept per server, a token or session ticket issued by one server is useless to another.
+    xquic_resumption_t xclient_read_resumption(std::string const & peer_key);
+    void xclient_save_token_cb(cli_user_conn_t const * cli_user_conn, const unsigned char * token, unsigned token_len);
+    void xclient_save_session_ticket_cb(cli_user_conn_t const * cli_user_conn, const char * session, unsigned session_len);
+    void xclient_save_transport_parameter_cb(cli_user_conn_t const * cli_user_conn, const char * tp_para, unsigned tp_para_len);
 
-    void xclient_read_transport_parameter(char ** tp_para, unsigned * tp_para_len) {
-        if (m_tp_para_len) {
-            *tp_para = (char *)malloc(m_tp_para_len);
-            memcpy(*tp_para, m_tp_para, m_tp_para_len);
-            *tp_para_len = m_tp_para_len;
-        }
-    }
-    void xclient_save_transport_parameter_cb(const char * tp_para, unsigned tp_para_len) {
-        if (tp_para_len) {
-            m_tp_para_len = tp_para_len;
-            m_tp_para = (char *)malloc(m_tp_para_len);
-            memcpy(m_tp_para, tp_para, m_tp_para_len);
-        }
-    }
+    // persist resumption data across restarts, so the first connection to a known server can send 0-RTT data.
+    bool load_resumption(std::string const & file_path);
+    bool save_resumption(std::string const & file_path);
 
 private:
     constexpr static std::size_t max_conn_queue_size{100};
-    top::threading::xthreadsafe_queue<cli_user_conn_t *, std::vector<cli_user_conn_t *>> m_conn_queue{max_conn_queue_size};
+    top::threading::xbounded_queue<cli_user_conn_t *> m_conn_queue{max_conn_queue_size};
 
     constexpr static std::size_t max_send_queue_size{100000};
-    top::threading::xthreadsafe_queue<std::unique_ptr<client_send_buffer_t>, std::vector<std::unique_ptr<client_send_buffer_t>>> m_send_queue{max_send_queue_size};
+    top::threading::xbounded_queue<std::unique_ptr<client_send_buffer_t>> m_send_queue{max_send_queue_size};
+    constexpr static std::size_t max_send_queue_bytes{32 * 1024 * 1024};
+    std::atomic<std::size_t> m_send_queue_bytes{0};  // total size of send_data in m_send_queue
+    bool requeue_send_buffer(std::unique_ptr<client_send_buffer_t> send_buffer_ptr);
+
+    constexpr static std::size_t max_close_queue_size{100};
+    top::threading::xbounded_queue<cli_user_conn_t *> m_close_queue{max_close_queue_size};
 
 private:
-    std::string m_token;
-    char * m_session{nullptr};
-    unsigned m_session_len{0};
-    char * m_tp_para{nullptr};
-    unsigned m_tp_para_len{0};
+    constexpr static std::size_t max_resumption_size{1024};
+    std::mutex m_resumption_mutex;
+    std::map<std::string, xquic_resumption_t> m_resumption;  // key: server addr:port
+    xquic_resumption_t & resumption_of(std::string const & peer_key);
 
 private:
     uint64_t do_send_interval{4};  // should be 128us - 2048us
@@ -226,7 +208,11 @@ public:
 
     cli_user_conn_t * connect(std::string const & server_addr, uint32_t server_port);
 
+    // close a live connection, e.g. evicted from the connection pool. it is released as usual by conn_close_notify.
+    bool close(cli_user_conn_t * cli_user_conn);
+
     void quic_engine_do_connect();
+    void quic_engine_do_close();
     void quic_engine_do_send();
     bool send(cli_user_conn_t * cli_user_conn, top::xbytes_t send_data);
 
@@ -6,6 +6,7 @@
 #include "xtransport/transport_fwd.h"
 
 #include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -50,8 +51,22 @@ private:
     std::shared_ptr<xquic_server_t> m_server_ptr;
     std::shared_ptr<xquic_client_t> m_client_ptr;
 
+    // bounded pool of client connections keyed by peer addr:port. the least recently used one is closed
+    // when the pool is full, and kept in m_closing_conns until the client engine releases it.
+    struct conn_entry_t {
+        cli_user_conn_t * conn;
+        std::list<std::string>::iterator lru_pos;
+    };
+    constexpr static std::size_t max_conn_pool_size{64};
+
     std::mutex m_conn_map_mutex;
-    std::unordered_map<std::string, cli_user_conn_t *> m_conn_map;
+    std::unordered_map<std::string, conn_entry_t> m_conn_map;
+    std::list<std::string> m_conn_lru;  // front is the most recently used
+    std::list<cli_user_conn_t *> m_closing_conns;
+
+    void erase_conn(std::string const & addr_port);
+    void evict_conns();
+    void clean_closing_conns();
 };
 
 NS_END3
\ No newline at end of file
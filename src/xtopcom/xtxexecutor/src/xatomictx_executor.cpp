@@ -11,9 +11,11 @@
 #include "xgasfee/xerror/xerror.h"
 #include "xgasfee/xgasfee.h"
 #include "xgasfee/xgas_estimate.h"
+#include "xmetrics/xhot_accounts.h"
 #include "xtxexecutor/xtvm.h"
 #include "xtxexecutor/xtvm_v2.h"
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -436,8 +438,15 @@ enum_execute_result_type xatomictx_executor_t::execute(const xcons_transaction_p
         return result;
     }
 
+    bool const sampled = XMETRICS_HOT_ACCOUNT_SAMPLED();
+    auto const begin = sampled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
     result = vm_execute(tx, output);
     vm_execute_after_process(tx_unitstate, tx, result, output, gas_used);
+    if (sampled) {
+        XMETRICS_HOT_ACCOUNT(execution_us, m_statectx->get_table_address(), address,
+                             static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count()));
+        XMETRICS_HOT_ACCOUNT(state_changes, m_statectx->get_table_address(), address, static_cast<uint64_t>(output.m_snapshot_size));
+    }
     return result;
 }
 
@@ -27,6 +27,10 @@ class xbatchtx_executor_t {
 
  public:
     int32_t execute(const std::vector<xcons_transaction_ptr_t> & txs, xexecute_output_t & outputs);
+    static std::vector<std::string> get_batch_accounts(const std::vector<xcons_transaction_ptr_t> & txs);
+    // number of rounds the packed evm txs would need when each round runs txs without conflicts in
+    // parallel and keeps the order of conflicting ones. 0 if there is no evm tx.
+    static uint32_t get_evm_parallel_depth(const std::vector<xatomictx_output_t> & pack_outputs);
  private:
     statectx::xstatectx_face_ptr_t  m_statectx{nullptr};
     xvm_para_t                      m_para;
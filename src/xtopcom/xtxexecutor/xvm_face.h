@@ -46,6 +46,9 @@ class xvm_para_t {
     uint64_t                get_gas_limit() const {return m_gas_limit;}
     uint64_t                get_block_height() const {return m_block_height;}
     common::xaccount_address_t const&   get_block_coinbase() const {return m_block_coinbase;}
+    // gas estimates only need the used gas: evm storage writes stay in the session and no logs or access sets are built
+    void                    set_dry_run(bool dry_run) {m_dry_run = dry_run;}
+    bool                    is_dry_run() const {return m_dry_run;}
 
  private:
     uint64_t        m_clock{0};
@@ -54,6 +57,7 @@ class xvm_para_t {
     uint64_t        m_gas_limit{0};
     uint64_t        m_block_height{0};
     common::xaccount_address_t  m_block_coinbase;
+    bool            m_dry_run{false};
 };
 
 struct xvm_gasfee_detail_t {
@@ -132,6 +132,12 @@ bool xtxpool_service::start(const xvip2_t & xip) {
           m_cover_front_table_id,
           m_cover_back_table_id,
           m_is_send_receipt_role);
+    // states of the served tables are caught up first if the node has just started
+    std::vector<common::xaccount_address_t> table_addrs;
+    for (uint32_t table_id = m_cover_front_table_id; table_id <= m_cover_back_table_id; table_id++) {
+        table_addrs.emplace_back(data::xblocktool_t::make_address_table_account(m_zone_index, table_id));
+    }
+    statestore::xstatestore_hub_t::instance()->prioritize_tables_catch_up(table_addrs);
     m_status.store(enum_txpool_service_status_running, std::memory_order_release);
     return true;
 }
@@ -388,7 +394,7 @@ void xtxpool_service::on_message_unit_receipt(vnetwork::xvnode_address_t const &
     xinfo("xtxpool_service::on_message_unit_receipt receipt=%s,at_node:%s,msg id:%x,hash:%x", receipt->dump().c_str(), m_vnetwork_str.c_str(), message.id(), message.hash());
 
     xtxpool_v2::xtx_para_t para;
-    std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = std::make_shared<xtxpool_v2::xtx_entry>(receipt, para);
+    std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = basic::make_pooled_shared<xtxpool_v2::xtx_entry>(receipt, para);
     XMETRICS_GAUGE(metrics::txpool_received_other_send_receipt_num, 1);
     ret = m_para->get_txpool()->push_receipt(tx_ent, false, false);
     XMETRICS_GAUGE(metrics::txpool_receipt_tx, (ret == xsuccess) ? 1 : 0);
@@ -519,7 +525,7 @@ int32_t xtxpool_service::request_transaction_consensus(const data::xtransaction_
 
     data::xcons_transaction_ptr_t cons_tx = make_object_ptr<data::xcons_transaction_t>(tx.get());
     xtxpool_v2::xtx_para_t para;
-    std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = std::make_shared<xtxpool_v2::xtx_entry>(cons_tx, para);
+    std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = basic::make_pooled_shared<xtxpool_v2::xtx_entry>(cons_tx, para);
     ret = m_para->get_txpool()->push_send_tx(tx_ent);
     push_send_fail_record(ret);
     return ret;
@@ -613,7 +619,7 @@ void xtxpool_service::on_message_push_receipt_received(vnetwork::xvnode_address_
              pushed_receipt.m_tx_to_account.c_str(),
              tx->dump().c_str());
         xtxpool_v2::xtx_para_t para;
-        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = std::make_shared<xtxpool_v2::xtx_entry>(tx, para);
+        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = basic::make_pooled_shared<xtxpool_v2::xtx_entry>(tx, para);
         m_para->get_txpool()->push_receipt(tx_ent, false, true);
     }
 }
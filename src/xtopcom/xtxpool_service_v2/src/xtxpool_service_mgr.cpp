@@ -28,6 +28,7 @@ NS_BEG2(top, xtxpool_service_v2)
 
 #define print_txpool_statistic_values_freq (300)  // print txpool statistic values every 5 minites
 #define refresh_block_recycler_rule_for_txpool_freq (300)
+#define save_txpool_journal_freq (60)  // journal pending txs every minute, a crash loses at most the last minute of txs
 
 xtxpool_service_mgr::xtxpool_service_mgr(const observer_ptr<base::xvblockstore_t> & blockstore,
                                          const observer_ptr<xtxpool_v2::xtxpool_face_t> & txpool,
@@ -212,6 +213,7 @@ void xtxpool_service_mgr::stop() {
     xinfo("xtxpool_service_mgr::stop");
     m_timer->close();
     m_timer->release_ref();
+    m_para->get_txpool()->save_journal();
 }
 
 void xtxpool_service_mgr::on_timer() {
@@ -283,6 +285,10 @@ void xtxpool_service_mgr::on_timer() {
             }
         }
     }
+
+    if ((now % save_txpool_journal_freq) == 0) {
+        m_para->get_txpool()->save_journal();
+    }
 }
 
 std::shared_ptr<xtxpool_service_mgr_face> xtxpool_service_mgr_instance::create_xtxpool_service_mgr_inst(const observer_ptr<base::xvblockstore_t> & blockstore,
@@ -14,28 +14,53 @@ NS_BEG2(top, xtxpool_v2)
 //     m_receiptid_state_map[tableindex.to_table_shortid()] = receiptid_state;
 // }
 
+bool xreceiptid_state_cache_t::get_slot(base::xtable_shortid_t table_id, size_t & slot) {
+    size_t const zone = table_id >> 10;
+    size_t const subaddr = table_id & 0x3FF;
+    if (zone >= (1 << enum_zone_bits) || subaddr >= (1 << enum_subaddr_bits)) {
+        xwarn("xreceiptid_state_cache_t::get_slot invalid table:%d", table_id);
+        return false;
+    }
+    slot = (zone << enum_subaddr_bits) | subaddr;
+    return true;
+}
+
+const xreceiptid_state_and_prove * xreceiptid_state_cache_t::find(base::xtable_shortid_t table_id) const {
+    size_t slot;
+    if (!get_slot(table_id, slot) || m_receiptid_states[slot].m_receiptid_state == nullptr) {
+        return nullptr;
+    }
+    return &m_receiptid_states[slot];
+}
+
 void xreceiptid_state_cache_t::update_table_receiptid_state(const base::xvproperty_prove_ptr_t & property_prove_ptr, const base::xreceiptid_state_ptr_t & receiptid_state) {
     auto table_id = receiptid_state->get_self_tableid();
+    size_t slot;
+    if (!get_slot(table_id, slot)) {
+        return;
+    }
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        auto & old_receiptid_state = iter->second.m_receiptid_state;
-        if (receiptid_state->get_block_height() <= old_receiptid_state->get_block_height()) {
-            return;
-        }
+    auto & old_receiptid_state = m_receiptid_states[slot].m_receiptid_state;
+    if (old_receiptid_state != nullptr && receiptid_state->get_block_height() <= old_receiptid_state->get_block_height()) {
+        return;
     }
-    xinfo("xreceiptid_state_cache_t::update_table_receiptid_state table:%d,height:%llu,pairs:%s",
+    // the state is shared with the table state, only the pointers are replaced. dumping all pairs is left to debug logs.
+    xinfo("xreceiptid_state_cache_t::update_table_receiptid_state table:%d,height:%llu,pairs:%zu",
           receiptid_state->get_self_tableid(),
           receiptid_state->get_block_height(),
-          receiptid_state->get_all_receiptid_pairs()->dump().c_str());
-    m_receiptid_state_map[table_id] = xreceiptid_state_and_prove(property_prove_ptr, receiptid_state);
+          receiptid_state->get_all_receiptid_pairs()->get_size());
+    xdbg("xreceiptid_state_cache_t::update_table_receiptid_state table:%d,height:%llu,pairs:%s",
+         receiptid_state->get_self_tableid(),
+         receiptid_state->get_block_height(),
+         receiptid_state->get_all_receiptid_pairs()->dump().c_str());
+    m_receiptid_states[slot] = xreceiptid_state_and_prove(property_prove_ptr, receiptid_state);
 }
 
 uint64_t xreceiptid_state_cache_t::get_confirmid_max(base::xtable_shortid_t table_id, base::xtable_shortid_t peer_table_id) const {
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter->second.m_receiptid_state;
+    auto info = find(table_id);
+    if (info != nullptr) {
+        auto & table_receiptid_state = info->m_receiptid_state;
         base::xreceiptid_pair_t pair;
         table_receiptid_state->find_pair(peer_table_id, pair);
         return pair.get_confirmid_max();
@@ -45,9 +70,9 @@ uint64_t xreceiptid_state_cache_t::get_confirmid_max(base::xtable_shortid_t tabl
 
 uint64_t xreceiptid_state_cache_t::get_recvid_max(base::xtable_shortid_t table_id, base::xtable_shortid_t peer_table_id) const {
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter->second.m_receiptid_state;
+    auto info = find(table_id);
+    if (info != nullptr) {
+        auto & table_receiptid_state = info->m_receiptid_state;
         base::xreceiptid_pair_t pair;
         table_receiptid_state->find_pair(peer_table_id, pair);
         return pair.get_recvid_max();
@@ -57,9 +82,9 @@ uint64_t xreceiptid_state_cache_t::get_recvid_max(base::xtable_shortid_t table_i
 
 uint64_t xreceiptid_state_cache_t::get_sendid_max(base::xtable_shortid_t table_id, base::xtable_shortid_t peer_table_id) const {
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter->second.m_receiptid_state;
+    auto info = find(table_id);
+    if (info != nullptr) {
+        auto & table_receiptid_state = info->m_receiptid_state;
         base::xreceiptid_pair_t pair;
         table_receiptid_state->find_pair(peer_table_id, pair);
         return pair.get_sendid_max();
@@ -69,9 +94,9 @@ uint64_t xreceiptid_state_cache_t::get_sendid_max(base::xtable_shortid_t table_i
 
 uint64_t xreceiptid_state_cache_t::get_height(base::xtable_shortid_t table_id) const {
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter->second.m_receiptid_state;
+    auto info = find(table_id);
+    if (info != nullptr) {
+        auto & table_receiptid_state = info->m_receiptid_state;
         return table_receiptid_state->get_block_height();
     }
     return 0;
@@ -79,9 +104,9 @@ uint64_t xreceiptid_state_cache_t::get_height(base::xtable_shortid_t table_id) c
 
 base::xreceiptid_state_ptr_t xreceiptid_state_cache_t::get_table_receiptid_state(base::xtable_shortid_t table_id) const {
     std::lock_guard<std::mutex> lck(m_mutex);
-    auto iter = m_receiptid_state_map.find(table_id);
-    if (iter != m_receiptid_state_map.end()) {
-        return iter->second.m_receiptid_state;
+    auto info = find(table_id);
+    if (info != nullptr) {
+        return info->m_receiptid_state;
     }
     return nullptr;
 }
@@ -105,17 +130,17 @@ void xreceiptid_state_cache_t::get_unconfirm_id_section_as_sender(base::xtable_s
     uint64_t confirmid_max = 0;
     uint64_t recvid_max = 0;
 
-    auto iter_peer = m_receiptid_state_map.find(peer_table_id);
-    if (iter_peer != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter_peer->second.m_receiptid_state;
+    auto info_peer = find(peer_table_id);
+    if (info_peer != nullptr) {
+        auto & table_receiptid_state = info_peer->m_receiptid_state;
         base::xreceiptid_pair_t peer_pair;
         table_receiptid_state->find_pair(table_id, peer_pair);
         recvid_max = peer_pair.get_recvid_max();
     }
 
-    auto iter_self = m_receiptid_state_map.find(table_id);
-    if (iter_self != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter_self->second.m_receiptid_state;
+    auto info_self = find(table_id);
+    if (info_self != nullptr) {
+        auto & table_receiptid_state = info_self->m_receiptid_state;
         base::xreceiptid_pair_t self_pair;
         table_receiptid_state->find_pair(peer_table_id, self_pair);
         sendid_max = self_pair.get_sendid_max();
@@ -153,17 +178,17 @@ void xreceiptid_state_cache_t::get_unconfirm_id_section_as_receiver(base::xtable
     std::lock_guard<std::mutex> lck(m_mutex);
     uint64_t recvid_max = 0;
     uint64_t confirmid_max = 0;
-    auto iter_self = m_receiptid_state_map.find(table_id);
-    if (iter_self != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter_self->second.m_receiptid_state;
+    auto info_self = find(table_id);
+    if (info_self != nullptr) {
+        auto & table_receiptid_state = info_self->m_receiptid_state;
         base::xreceiptid_pair_t self_pair;
         table_receiptid_state->find_pair(peer_table_id, self_pair);
         recvid_max = self_pair.get_recvid_max();
     }
 
-    auto iter_peer = m_receiptid_state_map.find(peer_table_id);
-    if (iter_peer != m_receiptid_state_map.end()) {
-        auto & table_receiptid_state = iter_peer->second.m_receiptid_state;
+    auto info_peer = find(peer_table_id);
+    if (info_peer != nullptr) {
+        auto & table_receiptid_state = info_peer->m_receiptid_state;
         base::xreceiptid_pair_t peer_pair;
         table_receiptid_state->find_pair(table_id, peer_pair);
         if (peer_pair.all_confirmed_as_sender()) {
@@ -197,11 +222,11 @@ const xreceiptid_state_and_prove xreceiptid_state_cache_t::get_receiptid_state_a
                                                                                          uint64_t max_not_need_confirm_receiptid) const {
     std::lock_guard<std::mutex> lck(m_mutex);
 
-    auto iter_peer = m_receiptid_state_map.find(peer_table_id);
-    if (iter_peer == m_receiptid_state_map.end()) {
+    auto info_peer = find(peer_table_id);
+    if (info_peer == nullptr) {
         return {};
     }
-    auto & peer_receiptid_info = iter_peer->second;
+    auto & peer_receiptid_info = *info_peer;
     auto & peer_receiptid_state = peer_receiptid_info.m_receiptid_state;
 
     base::xreceiptid_pair_t peer_pair;
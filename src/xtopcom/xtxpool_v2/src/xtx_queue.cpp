@@ -31,6 +31,7 @@ void xsend_tx_queue_internal_t::insert_tx(const std::shared_ptr<xtx_entry> & tx_
     xsed_tx_set_iters_t iters(it, it_timeout_queue);
     m_tx_map[tx_ent->get_tx()->get_tx_hash()] = iters;
     m_xtable_info->send_tx_inc(1);
+    m_xtable_info->tx_bytes_inc(get_tx_entry_bytes(tx_ent->get_tx()));
     xtxpool_info("xsend_tx_queue_internal_t::insert_tx push tx to send queue,table:%s,tx:%s", m_xtable_info->get_table_addr().c_str(), tx_ent->get_tx()->dump(true).c_str());
 }
 
@@ -49,6 +50,7 @@ void xsend_tx_queue_internal_t::erase_tx(const uint256_t & hash) {
         m_tx_time_order_set.erase(it_ready->second.m_send_tx_time_order_set_iter);
         m_tx_map.erase(it_ready);
         m_xtable_info->send_tx_dec(1);
+        m_xtable_info->tx_bytes_dec(get_tx_entry_bytes(tx_ent->get_tx()));
         return;
     }
 }
@@ -136,27 +138,26 @@ void xsend_tx_account_t::update_latest_nonce(uint64_t latest_nonce) {
 }
 
 const std::vector<xcons_transaction_ptr_t> xsend_tx_account_t::get_continuous_txs(uint32_t max_num, uint64_t upper_nonce, uint64_t lower_nonce) const {
-    uint64_t last_nonce = (lower_nonce == 0) ? m_latest_nonce : lower_nonce;
     std::vector<xcons_transaction_ptr_t> txs;
-    for (auto & iter_tx : m_txs) {
-        xtxpool_dbg("xsend_tx_account_t::get_continuous_txs tx:%s,upper_nonce:%llu,lower_nonce:%llu,m_latest_nonce:%llu", iter_tx.second->get_tx()->dump().c_str(), upper_nonce, lower_nonce, m_latest_nonce);
-        auto tx_nonce = iter_tx.second->get_tx()->get_transaction()->get_tx_nonce();
-        if (tx_nonce > upper_nonce) {
-            break;
-        }
-        if (tx_nonce <= last_nonce) {
-            continue;
-        } else if (tx_nonce == last_nonce + 1) {
-            txs.push_back(iter_tx.second->get_tx());
-            if (txs.size() >= max_num) {
-                break;
-            }
-            last_nonce++;
-        } else {
+    get_continuous_txs(max_num, upper_nonce, lower_nonce, txs);
+    return txs;
+}
+
+uint32_t xsend_tx_account_t::get_continuous_txs(uint32_t max_num, uint64_t upper_nonce, uint64_t lower_nonce, std::vector<xcons_transaction_ptr_t> & txs) const {
+    uint64_t last_nonce = (lower_nonce == 0) ? m_latest_nonce : lower_nonce;
+    uint32_t count = 0;
+    // txs are keyed by nonce, start from the first one after last_nonce instead of walking from the beginning
+    for (auto iter = m_txs.upper_bound(last_nonce); iter != m_txs.end() && count < max_num; iter++) {
+        xtxpool_dbg("xsend_tx_account_t::get_continuous_txs tx:%s,upper_nonce:%llu,lower_nonce:%llu,m_latest_nonce:%llu", iter->second->get_tx()->dump().c_str(), upper_nonce, lower_nonce, m_latest_nonce);
+        auto tx_nonce = iter->first;
+        if (tx_nonce > upper_nonce || tx_nonce != last_nonce + 1) {
             break;
         }
+        txs.push_back(iter->second->get_tx());
+        count++;
+        last_nonce++;
     }
-    return txs;
+    return count;
 }
 
 void xsend_tx_account_t::erase(uint64_t nonce, bool clear_follower) {
@@ -211,19 +212,54 @@ int32_t xsend_tx_queue_t::push_tx(const std::shared_ptr<xtx_entry> & tx_ent, uin
         }
         tx_info_t txinfo(to_be_droped_tx->get_tx());
         pop_tx(txinfo, true);
+        XMETRICS_GAUGE(metrics::txpool_send_tx_evicted, 1);
         if (to_be_droped_tx->get_tx()->get_tx_hash_256() == tx_ent->get_tx()->get_tx_hash_256()) {
             return err;
         }
     }
-    if (send_tx_account->empty()) {
-        m_send_tx_accounts.erase(account_addr);
+    if ((ret == xsuccess) && m_send_tx_queue_internal.bytes_full()) {
+        // one big tx may take the room of several small ones, the new tx itself or its preceding tx may be dropped too.
+        while (m_send_tx_queue_internal.bytes_full() && drop_lowest_tx()) {
+        }
+        if (m_send_tx_queue_internal.find(tx_ent->get_tx()->get_tx_hash_256()) == nullptr) {
+            return xtxpool_error_table_reached_upper_limit;
+        }
+    }
+    auto it_account = m_send_tx_accounts.find(account_addr);
+    if (it_account != m_send_tx_accounts.end() && it_account->second->empty()) {
+        m_send_tx_accounts.erase(it_account);
     }
     return ret;
 }
 
+bool xsend_tx_queue_t::drop_lowest_tx() {
+    auto to_be_droped_tx = m_send_tx_queue_internal.pick_to_be_droped_tx();
+    if (to_be_droped_tx == nullptr) {
+        return false;
+    }
+    xtxpool_info("xsend_tx_queue_t::drop_lowest_tx drop tx for pool is full,tx:%s", to_be_droped_tx->get_tx()->dump().c_str());
+    tx_info_t txinfo(to_be_droped_tx->get_tx());
+    pop_tx(txinfo, true);
+    XMETRICS_GAUGE(metrics::txpool_send_tx_evicted, 1);
+    return true;
+}
+
+void xsend_tx_queue_t::get_all_txs(std::vector<xcons_transaction_ptr_t> & txs) const {
+    for (auto & tx_ent : m_send_tx_queue_internal.get_queue()) {
+        txs.push_back(tx_ent->get_tx());
+    }
+}
+
 const std::vector<xcons_transaction_ptr_t> xsend_tx_queue_t::get_txs(uint32_t max_num, base::xvblock_t * cert_block) const {
-    std::map<std::string, std::vector<xcons_transaction_ptr_t>> account_txs_map;
-    std::vector<std::string> ordered_accounts;
+    // per account pick state of this round, each account is looked up in queue and in state only once
+    struct xaccount_pick_t {
+        const xsend_tx_account_t * account{nullptr};
+        std::vector<xcons_transaction_ptr_t> txs;
+        uint64_t last_nonce{0};
+        bool blocked{false};  // state unavailable or nonce gap, no more tx of account can be continuous in this round
+    };
+    std::unordered_map<std::string, xaccount_pick_t> account_picks;
+    std::vector<xaccount_pick_t *> ordered_accounts;
     auto & send_txs = m_send_tx_queue_internal.get_queue();
     uint32_t continuous_tx_num = 0;
 
@@ -232,53 +268,46 @@ const std::vector<xcons_transaction_ptr_t> xsend_tx_queue_t::get_txs(uint32_t ma
         uint64_t nonce = it_send_tx->get()->get_tx()->get_transaction()->get_tx_nonce();
         xtxpool_dbg("xsend_tx_queue_t::get_txs tx:%s", it_send_tx->get()->get_tx()->dump().c_str());
 
-        auto it_account_txs_map = account_txs_map.find(account_addr);
-        if (it_account_txs_map != account_txs_map.end()) {
-            auto & account_txs = it_account_txs_map->second;
-            auto lower_nonce = account_txs.back()->get_transaction()->get_tx_nonce();
-            if (nonce > lower_nonce) {
-                auto iter_send_tx_account = m_send_tx_accounts.find(account_addr);
-                xassert(iter_send_tx_account != m_send_tx_accounts.end());
-                if (iter_send_tx_account != m_send_tx_accounts.end()) {
-                    auto txs = iter_send_tx_account->second->get_continuous_txs(max_num - continuous_tx_num, nonce, lower_nonce);
-                    if (!txs.empty()) {
-                        account_txs.insert(account_txs.end(), txs.begin(), txs.end());
-                        continuous_tx_num += (txs.size());
-                        xtxpool_dbg("xsend_tx_queue_t::get_txs ordered_accounts size:%u account:%s,nonce:%llu,lower_nonce:%llu", ordered_accounts.size(), account_addr.c_str(), nonce, lower_nonce);
-                    }
-                }
-            }
-        } else {
+        auto it_pick = account_picks.find(account_addr);
+        if (it_pick == account_picks.end()) {
+            xaccount_pick_t pick;
+            auto iter_send_tx_account = m_send_tx_accounts.find(account_addr);
+            xassert(iter_send_tx_account != m_send_tx_accounts.end());
             base::xaccount_index_t account_index;
-            auto ret = statestore::xstatestore_hub_t::instance()->get_accountindex_from_table_block(common::xaccount_address_t(account_addr), cert_block, account_index);
-            if (!ret) {
+            if (iter_send_tx_account == m_send_tx_accounts.end()) {
+                pick.blocked = true;
+            } else if (!statestore::xstatestore_hub_t::instance()->get_accountindex_from_table_block(common::xaccount_address_t(account_addr), cert_block, account_index)) {
                 xwarn("xsend_tx_queue_t::get_txs mpt get account index fail account:%s", account_addr.c_str());
-                continue;
-            }
-            auto lower_nonce = account_index.get_latest_tx_nonce();
-            if (nonce > lower_nonce) {
-                auto iter_send_tx_account = m_send_tx_accounts.find(account_addr);
-                xassert(iter_send_tx_account != m_send_tx_accounts.end());
-                if (iter_send_tx_account != m_send_tx_accounts.end()) {
-                    auto txs = iter_send_tx_account->second->get_continuous_txs(max_num - continuous_tx_num, nonce, lower_nonce);
-                    if (!txs.empty()) {
-                        account_txs_map[account_addr] = txs;
-                        continuous_tx_num += txs.size();
-                        ordered_accounts.push_back(account_addr);
-                    }
-                }
-                xtxpool_dbg("xsend_tx_queue_t::get_txs ordered_accounts size:%u account:%s,nonce:%llu,lower_nonce:%llu", ordered_accounts.size(), account_addr.c_str(), nonce, lower_nonce);
+                pick.blocked = true;
+            } else {
+                pick.account = iter_send_tx_account->second.get();
+                pick.last_nonce = account_index.get_latest_tx_nonce();
             }
+            it_pick = account_picks.emplace(account_addr, std::move(pick)).first;
         }
+
+        auto & pick = it_pick->second;
+        if (pick.blocked || nonce <= pick.last_nonce) {
+            continue;
+        }
+        bool first_pick = pick.txs.empty();
+        uint32_t count = pick.account->get_continuous_txs(max_num - continuous_tx_num, nonce, pick.last_nonce, pick.txs);
+        if (count == 0) {
+            pick.blocked = true;  // nonce gap before this tx, later txs of account have bigger nonce
+            continue;
+        }
+        pick.last_nonce = pick.txs.back()->get_transaction()->get_tx_nonce();
+        continuous_tx_num += count;
+        if (first_pick) {
+            ordered_accounts.push_back(&pick);
+        }
+        xtxpool_dbg("xsend_tx_queue_t::get_txs ordered_accounts size:%u account:%s,nonce:%llu,last_nonce:%llu", ordered_accounts.size(), account_addr.c_str(), nonce, pick.last_nonce);
     }
 
     std::vector<xcons_transaction_ptr_t> ret_txs;
-    for (auto & account_addr : ordered_accounts) {
-        auto iter = account_txs_map.find(account_addr);
-        xassert(iter != account_txs_map.end());
-        if (iter != account_txs_map.end()) {
-            ret_txs.insert(ret_txs.end(), iter->second.begin(), iter->second.end());
-        }
+    ret_txs.reserve(continuous_tx_num);
+    for (auto pick : ordered_accounts) {
+        ret_txs.insert(ret_txs.end(), pick->txs.begin(), pick->txs.end());
     }
 
     return ret_txs;
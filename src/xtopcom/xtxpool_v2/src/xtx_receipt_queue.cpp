@@ -12,6 +12,8 @@
 #include "xverifier/xtx_verifier.h"
 #include "xverifier/xverifier_utl.h"
 
+#include <algorithm>
+
 namespace top {
 namespace xtxpool_v2 {
 
@@ -23,6 +25,7 @@ void xreceipt_queue_internal_t::insert_tx(const std::shared_ptr<xtx_entry> & tx_
     auto it = m_tx_queue.insert(tx_ent);
     m_tx_map[tx_ent->get_tx()->get_tx_hash()] = it;
     m_xtable_info->tx_inc(tx_ent->get_tx()->get_tx_subtype(), 1);
+    m_xtable_info->tx_bytes_inc(get_tx_entry_bytes(tx_ent->get_tx()));
     xtxpool_info("xreceipt_queue_internal_t::insert_tx table:%s,tx:%s", m_xtable_info->get_table_addr().c_str(), tx_ent->get_tx()->dump(true).c_str());
 }
 
@@ -40,6 +43,7 @@ void xreceipt_queue_internal_t::erase_tx(const uint256_t & hash) {
         }
 
         m_xtable_info->tx_dec(tx_ent->get_tx()->get_tx_subtype(), 1);
+        m_xtable_info->tx_bytes_dec(get_tx_entry_bytes(tx_ent->get_tx()));
         m_tx_queue.erase(it_tx_map->second);
         m_tx_map.erase(it_tx_map);
         return;
@@ -69,9 +73,18 @@ int32_t xpeer_table_receipts_t::push_tx(const std::shared_ptr<xtx_entry> & tx_en
 
     m_txs[new_receipt_id] = tx_ent;
     m_receipt_queue_internal->insert_tx(tx_ent);
+    if (new_receipt_id == m_continuous_receipt_id + 1) {
+        extend_continuous_receipt_id();
+    }
     return xsuccess;
 }
 
+void xpeer_table_receipts_t::extend_continuous_receipt_id() {
+    for (auto it = m_txs.upper_bound(m_continuous_receipt_id); it != m_txs.end() && it->first == m_continuous_receipt_id + 1; it++) {
+        m_continuous_receipt_id++;
+    }
+}
+
 void xpeer_table_receipts_t::update_latest_receipt_id(uint64_t latest_receipt_id) {
     if (latest_receipt_id <= m_latest_receipt_id) {
         return;
@@ -85,16 +98,25 @@ void xpeer_table_receipts_t::update_latest_receipt_id(uint64_t latest_receipt_id
         }
     }
     m_latest_receipt_id = latest_receipt_id;
+    if (m_continuous_receipt_id < latest_receipt_id) {
+        m_continuous_receipt_id = latest_receipt_id;
+        extend_continuous_receipt_id();
+    }
 }
 
 const std::vector<xcons_transaction_ptr_t> xpeer_table_receipts_t::get_txs(uint64_t lower_receipt_id, uint64_t upper_receipt_id, bool continuous) const {
     std::vector<xcons_transaction_ptr_t> ret_txs;
     uint64_t last_id = lower_receipt_id - 1;
-    for (auto it = m_txs.begin(); it != m_txs.end(); it++) {
-        uint64_t cur_id = it->first;
-        if (cur_id < lower_receipt_id) {
-            continue;
+    if (continuous && last_id >= m_latest_receipt_id && last_id <= m_continuous_receipt_id) {
+        // ids are known continuous up to m_continuous_receipt_id and the next one is lacking
+        uint64_t end_id = std::min(upper_receipt_id, m_continuous_receipt_id);
+        for (auto it = m_txs.lower_bound(lower_receipt_id); it != m_txs.end() && it->first <= end_id; it++) {
+            ret_txs.push_back(it->second->get_tx());
         }
+        return ret_txs;
+    }
+    for (auto it = m_txs.lower_bound(lower_receipt_id); it != m_txs.end(); it++) {
+        uint64_t cur_id = it->first;
         if (cur_id <= upper_receipt_id) {
             if (continuous) {
                 if (cur_id != last_id + 1) {
@@ -115,13 +137,16 @@ void xpeer_table_receipts_t::erase(uint64_t receipt_id) {
     if (it != m_txs.end()) {
         m_receipt_queue_internal->erase_tx(it->second->get_tx()->get_tx_hash_256());
         m_txs.erase(it);
+        if (receipt_id > m_latest_receipt_id && receipt_id <= m_continuous_receipt_id) {
+            m_continuous_receipt_id = receipt_id - 1;
+        }
     }
 }
 
 void xpeer_table_receipts_t::get_lacking_ids(std::vector<uint64_t> & lacking_ids, uint64_t max_pull_id) const {
     uint64_t last_receipt_id = m_latest_receipt_id;
 
-    if (m_txs.size() == max_pull_id - m_latest_receipt_id) {
+    if (m_continuous_receipt_id >= max_pull_id || m_txs.size() == max_pull_id - m_latest_receipt_id) {
         return;
     }
 
@@ -459,6 +484,12 @@ uint32_t xreceipt_queue_new_t::size() const {
     return m_receipt_queue_internal.size();
 }
 
+void xreceipt_queue_new_t::get_all_txs(std::vector<xcons_transaction_ptr_t> & txs) const {
+    for (auto & tx_ent : m_receipt_queue_internal.get_queue()) {
+        txs.push_back(tx_ent->get_tx());
+    }
+}
+
 const std::vector<xtxpool_table_lacking_receipt_ids_t> xreceipt_queue_new_t::get_lacking_discrete_confirm_tx_ids(
     const std::map<base::xtable_shortid_t, xneed_confirm_ids> & need_confirm_ids_map,
     uint32_t & total_num) const {
@@ -66,6 +66,11 @@ int32_t xtxmgr_table_t::push_receipt(const std::shared_ptr<xtx_entry> & tx) {
     }
 
     int32_t ret = m_new_receipt_queue.push_tx(tx);
+    if (ret == xsuccess) {
+        // receipts should not be dropped, give room to them by send txs of lowest score.
+        while (m_xtable_info->is_tx_bytes_reached_upper_limit() && m_send_tx_queue.drop_lowest_tx()) {
+        }
+    }
     if (ret != xsuccess) {
         xtxpool_warn("xtxmgr_table_t::push_receipt fail.table %s(receipt queue size:%u, receipt counter:%d recv:%d,confirm:%d),tx:%s,ret:%s",
                      m_xtable_info->get_table_addr().c_str(),
@@ -211,5 +216,12 @@ void xtxmgr_table_t::update_receiptid_state(const base::xreceiptid_state_ptr_t &
     m_new_receipt_queue.update_receiptid_state(receiptid_state);
 }
 
+std::vector<xcons_transaction_ptr_t> xtxmgr_table_t::get_all_txs() const {
+    std::vector<xcons_transaction_ptr_t> txs;
+    m_send_tx_queue.get_all_txs(txs);
+    m_new_receipt_queue.get_all_txs(txs);
+    return txs;
+}
+
 }  // namespace xtxpool_v2
 }  // namespace top
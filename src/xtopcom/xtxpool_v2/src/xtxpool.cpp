@@ -4,6 +4,7 @@
 
 #include "xtxpool_v2/xtxpool.h"
 
+#include "xbasic/xmemory_accounting.h"
 #include "xdata/xblocktool.h"
 #include "xdata/xnative_contract_address.h"
 #include "xtxpool_v2/xtxpool_error.h"
@@ -11,6 +12,15 @@
 #include "xtxpool_v2/xtxpool_para.h"
 #include "xvledger/xvledger.h"
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
 namespace top {
 namespace xtxpool_v2 {
 
@@ -46,6 +56,15 @@ xtxpool_t::xtxpool_t(const std::shared_ptr<xtxpool_resources_face> & para) : m_p
         m_all_table_sids.insert(tableindex.to_table_shortid());
     }
     m_tables_mgr.add_tables(base::enum_chain_zone_relay_index, MAIN_CHAIN_RELAY_TABLE_USED_NUM);
+
+    // txs are bounded by the queue sizes of the tables, so the txpool reports only and has nothing to shrink
+    m_memory_reporter = basic::xmemory_accounting_t::instance().add_reporter("txpool", [this] {
+        return basic::xmemory_usage_t{static_cast<uint64_t>(std::max<int64_t>(m_statistic.get_push_tx_bytes_cur(), 0)), m_statistic.get_push_tx_cur_num()};
+    });
+}
+
+xtxpool_t::~xtxpool_t() {
+    basic::xmemory_accounting_t::instance().remove_reporter(m_memory_reporter);
 }
 
 bool table_zone_subaddr_check(uint8_t zone, uint16_t subaddr) {
@@ -233,10 +252,12 @@ void xtxpool_t::subscribe_tables(uint8_t zone, uint16_t front_table_id, uint16_t
     xtxpool_info("xtxpool_t::subscribe_tables sub tables:zone:%d,front_table_id:%d,back_table_id:%d,node_type:%d", zone, front_table_id, back_table_id, node_type);
 
     uint32_t add_table_num = 0;
+    std::vector<std::shared_ptr<xtxpool_table_t>> new_tables;
     for (uint16_t i = front_table_id; i <= back_table_id; i++) {
         bool is_add_new = m_tables_mgr.subscribe_table(zone, i, m_para.get(), role.get(), &m_statistic, &m_all_table_sids);
         if (is_add_new) {
             add_table_num++;
+            new_tables.push_back(m_tables_mgr.get_table(zone, i));
         }
     }
     if (add_table_num > 0) {
@@ -245,6 +266,7 @@ void xtxpool_t::subscribe_tables(uint8_t zone, uint16_t front_table_id, uint16_t
             std::lock_guard<std::mutex> lck(m_peer_table_height_cache_mutex);
             m_peer_table_height_cache.clear();
         }
+        load_journals(new_tables);
     }
 }
 
@@ -468,6 +490,150 @@ void xtxpool_t::build_confirm_tx(base::xtable_shortid_t from_table_sid,
     table->build_confirm_tx(from_table_sid, receiptids, receipts);
 }
 
+// journal layout: version, tx count, then the txs serialized one after another
+#define txpool_journal_version (1)
+#define txpool_journal_load_threads (4)
+
+void xtxpool_t::set_journal_dir(const std::string & dir) {
+    std::lock_guard<std::mutex> lck(m_journal_mutex);
+    m_journal_dir = dir;
+    if (!m_journal_dir.empty()) {
+        mkdir(m_journal_dir.c_str(), 0750);
+    }
+}
+
+std::string xtxpool_t::journal_path(const std::string & table_addr) const {
+    return m_journal_dir + "/" + table_addr + ".journal";
+}
+
+void xtxpool_t::save_journal() {
+    std::lock_guard<std::mutex> lck(m_journal_mutex);
+    if (m_journal_dir.empty()) {
+        return;
+    }
+    for (uint8_t zone = 0; zone < xtxpool_zone_type_max; zone++) {
+        for (uint16_t i = 0; i < m_tables_mgr.m_tables[zone].size(); i++) {
+            auto table = m_tables_mgr.get_table(zone, i);
+            if (table != nullptr) {
+                save_table_journal(table);
+            }
+        }
+    }
+}
+
+void xtxpool_t::save_table_journal(const std::shared_ptr<xtxpool_table_t> & table) const {
+    const std::string path = journal_path(table->get_table_addr());
+    auto txs = table->get_all_txs();
+    if (txs.empty()) {
+        std::remove(path.c_str());
+        return;
+    }
+
+    base::xstream_t stream(base::xcontext_t::instance());
+    stream << (uint32_t)txpool_journal_version;
+    stream << (uint32_t)txs.size();
+    for (auto & tx : txs) {
+        tx->serialize_to(stream);
+    }
+
+    // a crash while writing leaves the previous journal intact
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        file.write((const char *)stream.data(), stream.size());
+        if (!file) {
+            xwarn("xtxpool_t::save_table_journal write fail table:%s path:%s", table->get_table_addr().c_str(), tmp_path.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        xwarn("xtxpool_t::save_table_journal rename fail table:%s path:%s", table->get_table_addr().c_str(), path.c_str());
+        return;
+    }
+    xinfo("xtxpool_t::save_table_journal table:%s txs:%zu bytes:%d", table->get_table_addr().c_str(), txs.size(), stream.size());
+}
+
+void xtxpool_t::load_journals(const std::vector<std::shared_ptr<xtxpool_table_t>> & tables) {
+    std::vector<std::shared_ptr<xtxpool_table_t>> to_load;
+    {
+        std::lock_guard<std::mutex> lck(m_journal_mutex);
+        if (m_journal_dir.empty()) {
+            return;
+        }
+        for (auto & table : tables) {
+            if (table != nullptr && m_journal_loaded.insert(table->get_table_addr()).second) {
+                to_load.push_back(table);
+            }
+        }
+    }
+    if (to_load.empty()) {
+        return;
+    }
+
+    // txs are verified again when pushed, which is cpu bound, so tables are loaded in parallel
+    std::atomic<std::size_t> next{0};
+    auto load = [&] {
+        for (std::size_t i = next++; i < to_load.size(); i = next++) {
+            load_table_journal(to_load[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    std::size_t thread_num = std::min<std::size_t>(txpool_journal_load_threads, to_load.size()) - 1;
+    for (std::size_t i = 0; i < thread_num; i++) {
+        threads.emplace_back(load);
+    }
+    load();
+    for (auto & thread : threads) {
+        thread.join();
+    }
+}
+
+void xtxpool_t::load_table_journal(const std::shared_ptr<xtxpool_table_t> & table) {
+    const std::string path = journal_path(table->get_table_addr());
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)content.data(), (uint32_t)content.size());
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (content.size() < sizeof(version) + sizeof(count)) {
+        xwarn("xtxpool_t::load_table_journal truncated journal table:%s", table->get_table_addr().c_str());
+        return;
+    }
+    stream >> version;
+    stream >> count;
+    if (version != txpool_journal_version) {
+        xwarn("xtxpool_t::load_table_journal unknown version:%u table:%s", version, table->get_table_addr().c_str());
+        return;
+    }
+
+    uint32_t pushed = 0;
+    uint32_t rejected = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        xcons_transaction_ptr_t tx = make_object_ptr<data::xcons_transaction_t>();
+        if (tx->serialize_from(stream) <= 0) {
+            xwarn("xtxpool_t::load_table_journal serialize_from fail table:%s index:%u", table->get_table_addr().c_str(), i);
+            break;
+        }
+        xtx_para_t para;
+        auto tx_ent = basic::make_pooled_shared<xtx_entry>(tx, para);
+        // txs confirmed or expired while the node was down are rejected here
+        int32_t ret = tx->is_send_or_self_tx() ? table->push_send_tx(tx_ent) : table->push_receipt(tx_ent, false);
+        if (ret == xsuccess) {
+            pushed++;
+        } else {
+            rejected++;
+            xdbg("xtxpool_t::load_table_journal push fail table:%s tx:%s ret:%d", table->get_table_addr().c_str(), tx->dump().c_str(), ret);
+        }
+    }
+    xinfo("xtxpool_t::load_table_journal table:%s count:%u pushed:%u rejected:%u", table->get_table_addr().c_str(), count, pushed, rejected);
+}
+
 void xtables_mgr::add_tables(uint8_t zone, uint32_t size) {
     m_tables[zone].resize(size);
 }
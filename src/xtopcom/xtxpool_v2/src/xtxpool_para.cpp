@@ -34,4 +34,8 @@ xreceiptid_state_cache_t & xtxpool_resources::get_receiptid_state_cache() {
     return m_receiptid_state_cache;
 }
 
+xverified_prove_cert_cache_t & xtxpool_resources::get_verified_prove_cert_cache() {
+    return m_verified_prove_cert_cache;
+}
+
 NS_END2
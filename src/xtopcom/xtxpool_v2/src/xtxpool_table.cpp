@@ -5,6 +5,7 @@
 #include "xtxpool_v2/xtxpool_table.h"
 
 #include "xbasic/xmodule_type.h"
+#include "xbasic/xthreading/xparallel_pool.h"
 #include "xdata/xblocktool.h"
 #include "xdata/xlightunit.h"
 #include "xdata/xtable_bstate.h"
@@ -22,6 +23,9 @@
 #include "xvledger/xvledger.h"
 #include "xbase/xutl.h"
 #include "xstatestore/xstatestore_face.h"
+#include "xmetrics/xhot_accounts.h"
+
+#include <algorithm>
 
 namespace top {
 namespace xtxpool_v2 {
@@ -70,14 +74,23 @@ int32_t xtxpool_table_t::push_send_tx_real(const std::shared_ptr<xtx_entry> & tx
         tx->get_para().set_tx_type_score(enum_xtx_type_socre_normal);
     }
 
-    int32_t ret;
-    {
-        std::lock_guard<std::mutex> lck(m_mgr_mutex);
-        // if (!is_cached_nonce) {
-        m_txmgr_table.updata_latest_nonce(account_addr, latest_nonce);
-        // }
-        ret = m_txmgr_table.push_send_tx(tx, latest_nonce);
+    // never wait for the table lock, packing may hold it for a long time under burst load
+    std::unique_lock<std::mutex> lck(m_mgr_mutex, std::try_to_lock);
+    if (!lck.owns_lock()) {
+        m_deferred_send_txs.push(std::make_pair(tx, latest_nonce));
+        XMETRICS_GAUGE(metrics::txpool_push_tx_deferred, 1);
+        xtxpool_dbg("xtxpool_table_t::push_send_tx deferred tx:%s,deferred:%zu", tx->get_tx()->dump().c_str(), m_deferred_send_txs.size());
+        return xsuccess;
     }
+    drain_deferred_send_txs();
+    return insert_send_tx(tx, latest_nonce);
+}
+
+int32_t xtxpool_table_t::insert_send_tx(const std::shared_ptr<xtx_entry> & tx, uint64_t latest_nonce) {
+    // if (!is_cached_nonce) {
+    m_txmgr_table.updata_latest_nonce(tx->get_tx()->get_source_addr(), latest_nonce);
+    // }
+    int32_t ret = m_txmgr_table.push_send_tx(tx, latest_nonce);
     if (ret != xsuccess) {
         // XMETRICS_COUNTER_INCREMENT("txpool_push_tx_send_fail", 1);
         m_xtable_info.get_statistic()->inc_push_tx_send_fail_num(1);
@@ -85,7 +98,23 @@ int32_t xtxpool_table_t::push_send_tx_real(const std::shared_ptr<xtx_entry> & tx
     return ret;
 }
 
+void xtxpool_table_t::drain_deferred_send_txs() {
+    if (m_deferred_send_txs.empty()) {
+        return;
+    }
+    for (auto & deferred : m_deferred_send_txs.pop_all()) {
+        int32_t ret = insert_send_tx(deferred.first, deferred.second);
+        if (ret != xsuccess) {
+            xtxpool_warn("xtxpool_table_t::drain_deferred_send_txs fail-push tx:%s,ret:%d", deferred.first->get_tx()->dump().c_str(), ret);
+        }
+    }
+}
+
 int32_t xtxpool_table_t::push_send_tx(const std::shared_ptr<xtx_entry> & tx) {
+    // counted before any check, a spammer is as visible when its txs are rejected
+    if (XMETRICS_HOT_ACCOUNT_SAMPLED()) {
+        XMETRICS_HOT_ACCOUNT(txs, m_table_address.value(), tx->get_tx()->get_source_addr(), 1);
+    }
     if (is_reach_limit(tx)) {
         return xtxpool_error_account_unconfirm_txs_reached_upper_limit;
     }
@@ -120,6 +149,7 @@ int32_t xtxpool_table_t::push_receipt_real(const std::shared_ptr<xtx_entry> & tx
     int32_t ret;
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         ret = m_txmgr_table.push_receipt(tx);
     }
     if (ret != xsuccess) {
@@ -184,6 +214,7 @@ int32_t xtxpool_table_t::push_receipt(const std::shared_ptr<xtx_entry> & tx, boo
 std::shared_ptr<xtx_entry> xtxpool_table_t::pop_tx(const tx_info_t & txinfo, bool clear_follower) {
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         bool exist = false;
         auto tx_ent = m_txmgr_table.pop_tx(txinfo, clear_follower);
         if (tx_ent != nullptr) {
@@ -199,6 +230,7 @@ std::shared_ptr<xtx_entry> xtxpool_table_t::pop_tx(const tx_info_t & txinfo, boo
 void xtxpool_table_t::update_id_state(const std::vector<update_id_state_para> & para_vec) {
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         for (auto & para : para_vec) {
             m_txmgr_table.update_id_state(para.m_txinfo, para.m_peer_table_sid, para.m_receiptid, para.m_nonce);
         }
@@ -212,7 +244,10 @@ xpack_resource xtxpool_table_t::get_pack_resource(const xtxs_pack_para_t & pack_
     std::vector<xcons_transaction_ptr_t> txs;
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         txs = m_txmgr_table.get_ready_txs(pack_para, m_unconfirm_id_height);
+        // txs arrived while packing are inserted now, not left for the next push
+        drain_deferred_send_txs();
     }
 
     if (txs.empty()) {
@@ -260,6 +295,7 @@ xpack_resource xtxpool_table_t::get_pack_resource(const xtxs_pack_para_t & pack_
 const std::shared_ptr<xtx_entry> xtxpool_table_t::query_tx(const std::string & account, const uint256_t & hash) {
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         auto tx_ent = m_txmgr_table.query_tx(account, hash);
         if (tx_ent != nullptr) {
             return tx_ent;
@@ -360,19 +396,43 @@ void xtxpool_table_t::on_block_confirmed(xblock_t * table_block) {
 }
 
 int32_t xtxpool_table_t::verify_txs(const std::string & account, const std::vector<xcons_transaction_ptr_t> & txs) {
-    for (auto & tx : txs) {
-        {
-            std::lock_guard<std::mutex> lck(m_mgr_mutex);
+    // cheap order check of the whole proposal at first, a proposal with broken order would fail at execution anyway
+    int32_t ret = check_txs_order(txs);
+    if (ret != xsuccess) {
+        return ret;
+    }
+
+    // txs already in pool have been verified when pushed
+    std::vector<xcons_transaction_ptr_t> verify_txs;
+    std::vector<bool> tx_in_pool(txs.size(), false);
+    {
+        std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        for (size_t i = 0; i < txs.size(); i++) {
+            auto & tx = txs[i];
             auto tx_inside = m_txmgr_table.query_tx(tx->get_account_addr(), tx->get_tx_hash_256());
             if (tx_inside != nullptr) {
                 if (tx_inside->get_tx()->get_tx_subtype() == tx->get_tx_subtype()) {
+                    tx_in_pool[i] = true;
                     continue;
                 } else if (tx_inside->get_tx()->get_tx_subtype() > tx->get_tx_subtype()) {
                     return xtxpool_error_request_tx_repeat;
                 }
             }
+            verify_txs.push_back(tx);
+        }
+    }
+
+    // signature, hash and receipt prove are checked in parallel, then results are handled in proposal order
+    std::vector<int32_t> verify_results;
+    parallel_verify_cons_txs(verify_txs, verify_results);
+
+    size_t verify_index = 0;
+    for (size_t i = 0; i < txs.size(); i++) {
+        if (tx_in_pool[i]) {
+            continue;
         }
-        int32_t ret = verify_cons_tx(tx);
+        auto & tx = txs[i];
+        ret = verify_results[verify_index++];
         if (ret != xsuccess) {
             xtxpool_warn("xtxpool_table_t::verify_txs verify fail,tx:%s,err:%u", tx->dump(true).c_str(), ret);
             if (ret == xverifier::xverifier_error::xverifier_error_tx_duration_expired) {
@@ -382,7 +442,7 @@ int32_t xtxpool_table_t::verify_txs(const std::string & account, const std::vect
         }
 
         xtxpool_v2::xtx_para_t para;
-        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = std::make_shared<xtxpool_v2::xtx_entry>(tx, para);
+        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = basic::make_pooled_shared<xtxpool_v2::xtx_entry>(tx, para);
         if (tx->is_send_tx() || tx->is_self_tx()) {
             if (!is_reach_limit(tx_ent)) {
                 xtxpool_info("xtxpool_table_t::verify_txs push tx from proposal tx:%s", tx->dump().c_str());
@@ -405,6 +465,93 @@ int32_t xtxpool_table_t::verify_txs(const std::string & account, const std::vect
     return xsuccess;
 }
 
+int32_t xtxpool_table_t::check_txs_order(const std::vector<xcons_transaction_ptr_t> & txs) {
+    // txs of proposal are executed in order, so inside one proposal nonces of one account and receipt ids of one peer table
+    // must be continuous, the same as check_account_order and check_receiptid_order of tx executor
+    std::map<std::string, uint64_t> account_nonces;
+    std::map<base::xtable_shortid_t, uint64_t> recv_ids;
+    std::map<base::xtable_shortid_t, uint64_t> confirm_rsp_ids;
+    for (auto & tx : txs) {
+        if (tx->is_send_or_self_tx()) {
+            auto iter = account_nonces.find(tx->get_source_addr());
+            if (iter != account_nonces.end() && tx->get_tx_nonce() != iter->second + 1) {
+                xtxpool_warn("xtxpool_table_t::check_txs_order fail-nonce uncontinuous.tx:%s,last_nonce:%llu", tx->dump().c_str(), iter->second);
+                return xtxpool_error_tx_nonce_uncontinuous;
+            }
+            account_nonces[tx->get_source_addr()] = tx->get_tx_nonce();
+        } else if (tx->is_recv_tx()) {
+            auto iter = recv_ids.find(tx->get_peer_tableid());
+            if (iter != recv_ids.end() && tx->get_last_action_receipt_id() != iter->second + 1) {
+                xtxpool_warn("xtxpool_table_t::check_txs_order fail-receipt id uncontinuous.tx:%s,last_id:%llu", tx->dump().c_str(), iter->second);
+                return xtxpool_error_receipt_id_uncontinuous;
+            }
+            recv_ids[tx->get_peer_tableid()] = tx->get_last_action_receipt_id();
+        } else if (tx->is_confirm_tx()) {
+            auto iter = confirm_rsp_ids.find(tx->get_peer_tableid());
+            if (iter != confirm_rsp_ids.end() && tx->get_last_action_rsp_id() != iter->second + 1) {
+                xtxpool_warn("xtxpool_table_t::check_txs_order fail-rsp id uncontinuous.tx:%s,last_id:%llu", tx->dump().c_str(), iter->second);
+                return xtxpool_error_receipt_id_uncontinuous;
+            }
+            confirm_rsp_ids[tx->get_peer_tableid()] = tx->get_last_action_rsp_id();
+        }
+    }
+    return xsuccess;
+}
+
+void xtxpool_table_t::parallel_verify_cons_txs(const std::vector<xcons_transaction_ptr_t> & txs, std::vector<int32_t> & results) const {
+    // signatures are the most expensive part and not bound to account, verify all of them first in parallel.
+    // a tx of bad signature fails here directly, good ones are cached by verifier so verify_cons_tx gets them directly later.
+    std::vector<data::xtransaction_t const *> send_txs;
+    std::vector<size_t> send_tx_indexes;
+    for (size_t i = 0; i < txs.size(); i++) {
+        if (txs[i]->is_send_tx() || txs[i]->is_self_tx()) {
+            send_txs.push_back(txs[i]->get_transaction());
+            send_tx_indexes.push_back(i);
+        }
+    }
+    std::vector<int32_t> signature_results;
+    xverifier::xtx_verifier::verify_txs_signature(send_txs, signature_results);
+
+    results.assign(txs.size(), xsuccess);
+    std::vector<bool> verified(txs.size(), false);
+    for (size_t j = 0; j < send_tx_indexes.size(); j++) {
+        if (signature_results[j] != xverifier::xverifier_error::xverifier_success) {
+            results[send_tx_indexes[j]] = signature_results[j];
+            verified[send_tx_indexes[j]] = true;
+        }
+    }
+
+    size_t const thread_count = std::min<size_t>((size_t)enum_parallel_verify_max_threads, txs.size() / enum_parallel_verify_min_txs);
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < txs.size(); i++) {
+            if (!verified[i]) {
+                results[i] = verify_cons_tx(txs[i]);
+            }
+        }
+        return;
+    }
+
+    // partition by account, so one account is always verified by one thread. verify_cons_tx only reads shared members
+    std::map<std::string, std::vector<size_t>> account_txs;
+    for (size_t i = 0; i < txs.size(); i++) {
+        if (!verified[i]) {
+            account_txs[txs[i]->get_account_addr()].push_back(i);
+        }
+    }
+    std::vector<const std::vector<size_t> *> partitions;
+    partitions.reserve(account_txs.size());
+    for (auto & v : account_txs) {
+        partitions.push_back(&v.second);
+    }
+
+    threading::xparallel_pool_t::instance().run(partitions.size(), thread_count, [&](std::size_t p) {
+        for (auto index : *partitions[p]) {
+            results[index] = verify_cons_tx(txs[index]);
+        }
+    });
+    xtxpool_dbg("xtxpool_table_t::parallel_verify_cons_txs table:%s,txs:%zu,accounts:%zu,threads:%zu", m_xtable_info.get_account().c_str(), txs.size(), partitions.size(), thread_count);
+}
+
 void xtxpool_table_t::refresh_table(bool refresh_state_only) {
     auto latest_committed_block = base::xvchain_t::instance().get_xblockstore()->get_latest_committed_block(m_xtable_info, metrics::blockstore_access_from_txpool_refresh_table);
     xtxpool_dbg("xtxpool_table_t::refresh_table begin table:%s,commit_height:%llu", m_xtable_info.get_account().c_str(), latest_committed_block->get_height());
@@ -430,6 +577,7 @@ void xtxpool_table_t::refresh_table(bool refresh_state_only) {
 
     {
         std::lock_guard<std::mutex> lck(m_mgr_mutex);
+        drain_deferred_send_txs();
         if (receiptid_state != nullptr) {
             m_txmgr_table.update_receiptid_state(receiptid_state);
         }
@@ -580,6 +728,11 @@ int32_t xtxpool_table_t::verify_receipt_tx(const xcons_transaction_ptr_t & tx) c
         return xtxpool_error_tx_multi_sign_error;
     }
 
+    auto & verified_prove_certs = m_para->get_verified_prove_cert_cache();
+    if (verified_prove_certs.is_verified(prove_account, prove_cert.get())) {
+        return xsuccess;
+    }
+
     XMETRICS_GAUGE(metrics::cpu_ca_verify_multi_sign_txreceipt, 1);
     base::enum_vcert_auth_result auth_result = m_para->get_certauth()->verify_muti_sign(prove_cert.get(), prove_account);
     if (auth_result != base::enum_vcert_auth_result::enum_successful) {
@@ -587,6 +740,7 @@ int32_t xtxpool_table_t::verify_receipt_tx(const xcons_transaction_ptr_t & tx) c
         xtxpool_warn("xtxpool_table_t::verify_receipt_tx fail. account=%s,tx=%s,auth_result:%d,fail-%u", prove_account.c_str(), tx->dump(true).c_str(), auth_result, ret);
         return ret;
     }
+    verified_prove_certs.set_verified(prove_account, prove_cert.get());
     return xsuccess;
 }
 
@@ -629,36 +783,43 @@ const std::vector<xtxpool_table_lacking_receipt_ids_t> xtxpool_table_t::get_lack
     return m_txmgr_table.get_lacking_discrete_confirm_tx_ids(need_confirm_ids_vec, total_num);
 }
 
-xcons_transaction_ptr_t xtxpool_table_t::build_receipt(base::xtable_shortid_t peer_table_sid, uint64_t receipt_id, uint64_t commit_height, enum_transaction_subtype subtype) {
-    base::xauto_ptr<base::xvblock_t> commit_block =
-        m_para->get_vblockstore()->load_block_object(m_xtable_info, commit_height, base::enum_xvblock_flag_committed, false, metrics::blockstore_access_from_txpool_create_receipt);
-    if (commit_block == nullptr) {
-        xerror("xtxpool_table_t::build_receipt fail-commit table block not exist table=%s,peer table:%d,receipt id:%llu,table_height:%llu,subtype:%d",
-               m_xtable_info.get_account().c_str(),
-               peer_table_sid,
-               receipt_id,
-               commit_height,
-               subtype);
-        return nullptr;
-    }
+void xtxpool_table_t::build_receipts(base::xtable_shortid_t peer_table_sid,
+                                     const std::map<uint64_t, std::set<uint64_t>> & height_receiptids,
+                                     enum_transaction_subtype subtype,
+                                     std::vector<xcons_transaction_ptr_t> & receipts) {
+    // receipts of one commit height are made from the same pair of blocks, load and build merkle once for them
+    for (auto & height_ids : height_receiptids) {
+        uint64_t commit_height = height_ids.first;
+        base::xauto_ptr<base::xvblock_t> commit_block =
+            m_para->get_vblockstore()->load_block_object(m_xtable_info, commit_height, base::enum_xvblock_flag_committed, false, metrics::blockstore_access_from_txpool_create_receipt);
+        if (commit_block == nullptr) {
+            xerror("xtxpool_table_t::build_receipts fail-commit table block not exist table=%s,peer table:%d,receipt ids:%zu,table_height:%llu,subtype:%d",
+                   m_xtable_info.get_account().c_str(),
+                   peer_table_sid,
+                   height_ids.second.size(),
+                   commit_height,
+                   subtype);
+            continue;
+        }
 
-    base::xauto_ptr<base::xvblock_t> cert_block =
-        m_para->get_vblockstore()->load_block_object(m_xtable_info, commit_height + 2, 0, false, metrics::blockstore_access_from_txpool_create_receipt);
-    if (cert_block == nullptr) {
-        xerror("xtxpool_table_t::build_receipt fail-cert table block not exist table=%s,peer table:%d,receipt id:%llu,table_height:%llu,subtype:%d",
-               m_xtable_info.get_account().c_str(),
-               peer_table_sid,
-               receipt_id,
-               commit_height + 2,
-               subtype);
-        return nullptr;
-    }
+        base::xauto_ptr<base::xvblock_t> cert_block =
+            m_para->get_vblockstore()->load_block_object(m_xtable_info, commit_height + 2, 0, false, metrics::blockstore_access_from_txpool_create_receipt);
+        if (cert_block == nullptr) {
+            xerror("xtxpool_table_t::build_receipts fail-cert table block not exist table=%s,peer table:%d,receipt ids:%zu,table_height:%llu,subtype:%d",
+                   m_xtable_info.get_account().c_str(),
+                   peer_table_sid,
+                   height_ids.second.size(),
+                   commit_height + 2,
+                   subtype);
+            continue;
+        }
 
-    m_para->get_vblockstore()->load_block_input(commit_block->get_account(), commit_block.get());
+        m_para->get_vblockstore()->load_block_input(commit_block->get_account(), commit_block.get());
 
-    auto tx = xblocktool_t::create_one_txreceipt(dynamic_cast<xblock_t *>(commit_block.get()), dynamic_cast<xblock_t *>(cert_block.get()), peer_table_sid, receipt_id, subtype);
-    xassert(tx != nullptr);
-    return tx;
+        auto txs = xblocktool_t::create_txreceipts(commit_block.get(), cert_block.get(), peer_table_sid, height_ids.second, subtype);
+        xassert(txs.size() == height_ids.second.size());
+        receipts.insert(receipts.end(), txs.begin(), txs.end());
+    }
 }
 
 void xtxpool_table_t::build_recv_tx(base::xtable_shortid_t peer_table_sid, std::vector<uint64_t> receiptids, std::vector<xcons_transaction_ptr_t> & receipts) {
@@ -666,6 +827,7 @@ void xtxpool_table_t::build_recv_tx(base::xtable_shortid_t peer_table_sid, std::
     auto self_confirmid = m_para->get_receiptid_state_cache().get_confirmid_max(self_table_sid, peer_table_sid);
     auto peer_recvid = m_para->get_receiptid_state_cache().get_recvid_max(peer_table_sid, self_table_sid);
     uint64_t id_lower_bound = (self_confirmid > peer_recvid) ? self_confirmid : peer_recvid;
+    std::map<uint64_t, std::set<uint64_t>> height_receiptids;
     for (auto & receiptid : receiptids) {
         if (receiptid <= id_lower_bound) {
             continue;
@@ -677,17 +839,15 @@ void xtxpool_table_t::build_recv_tx(base::xtable_shortid_t peer_table_sid, std::
             xtxpool_info("xtxpool_table_t::build_recv_tx fail-receipt id not found self:%d,peer:%d,receipt id:%lu", self_table_sid, peer_table_sid, receiptid);
             continue;
         }
-
-        auto receipt = build_receipt(peer_table_sid, receiptid, commit_height, enum_transaction_subtype_send);
-        if (receipt != nullptr) {
-            receipts.push_back(receipt);
-        }
+        height_receiptids[commit_height].insert(receiptid);
     }
+    build_receipts(peer_table_sid, height_receiptids, enum_transaction_subtype_send, receipts);
 }
 
 void xtxpool_table_t::build_confirm_tx(base::xtable_shortid_t peer_table_sid, std::vector<uint64_t> receiptids, std::vector<xcons_transaction_ptr_t> & receipts) {
     auto self_table_sid = m_xtable_info.get_short_table_id();
     auto peer_confirmid = m_para->get_receiptid_state_cache().get_confirmid_max(peer_table_sid, self_table_sid);
+    std::map<uint64_t, std::set<uint64_t>> height_receiptids;
     for (auto & receiptid : receiptids) {
         if (receiptid <= peer_confirmid) {
             continue;
@@ -704,12 +864,9 @@ void xtxpool_table_t::build_confirm_tx(base::xtable_shortid_t peer_table_sid, st
             xtxpool_warn("xtxpool_table_t::build_confirm_tx receipt id not need confirm self:%d,peer:%d,receipt id:%lu", self_table_sid, peer_table_sid, receiptid);
             continue;
         }
-
-        auto receipt = build_receipt(peer_table_sid, receiptid, commit_height, enum_transaction_subtype_recv);
-        if (receipt != nullptr) {
-            receipts.push_back(receipt);
-        }
+        height_receiptids[commit_height].insert(receiptid);
     }
+    build_receipts(peer_table_sid, height_receiptids, enum_transaction_subtype_recv, receipts);
 }
 
 void xtxpool_table_t::unconfirm_cache_status(uint32_t & sender_cache_size, uint32_t & receiver_cache_size, uint32_t & height_record_size, uint32_t & unconfirm_raw_txs_size) const {
@@ -744,5 +901,10 @@ xtransaction_ptr_t xtxpool_table_t::get_raw_tx(base::xtable_shortid_t peer_table
     return m_unconfirm_raw_txs.get_raw_tx(peer_table_sid, receipt_id);
 }
 
+std::vector<xcons_transaction_ptr_t> xtxpool_table_t::get_all_txs() const {
+    std::lock_guard<std::mutex> lck(m_mgr_mutex);
+    return m_txmgr_table.get_all_txs();
+}
+
 }  // namespace xtxpool_v2
 }  // namespace top
@@ -0,0 +1,28 @@
+// Copyright (c) 2017-2020 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xtxpool_v2/xverified_prove_cert_cache.h"
+
+NS_BEG2(top, xtxpool_v2)
+
+bool xverified_prove_cert_cache_t::is_verified(const std::string & prove_account, base::xvqcert_t * prove_cert) const {
+    return m_verified_certs.exist(make_key(prove_account, prove_cert));
+}
+
+void xverified_prove_cert_cache_t::set_verified(const std::string & prove_account, base::xvqcert_t * prove_cert) {
+    m_verified_certs.put(make_key(prove_account, prove_cert), true);
+}
+
+std::string xverified_prove_cert_cache_t::make_key(const std::string & prove_account, base::xvqcert_t * prove_cert) {
+    std::string key = prove_account;
+    key += '/';
+    key += std::to_string(prove_cert->get_viewid());
+    key += '/';
+    key += prove_cert->get_hash_to_sign();
+    key += prove_cert->get_verify_signature();
+    key += prove_cert->get_audit_signature();
+    return key;
+}
+
+NS_END2
@@ -9,6 +9,7 @@
 #include "xvledger/xvpropertyprove.h"
 
 #include <string>
+#include <vector>
 
 NS_BEG2(top, xtxpool_v2)
 
@@ -34,9 +35,17 @@ public:
                                                                    uint64_t max_not_need_confirm_receiptid) const;
 
 private:
+    enum {
+        enum_zone_bits = 4,
+        enum_subaddr_bits = 8,
+        enum_max_table_slots = 1 << (enum_zone_bits + enum_subaddr_bits),
+    };
+    // the states are kept in a flat array indexed by zone and subaddr of the table short id
+    static bool get_slot(base::xtable_shortid_t table_id, size_t & slot);
+    const xreceiptid_state_and_prove * find(base::xtable_shortid_t table_id) const;
+
     mutable std::mutex m_mutex;
-    std::map<base::xtable_shortid_t, xreceiptid_state_and_prove> m_receiptid_state_map;
-    mutable bool m_all_cached{false};
+    std::vector<xreceiptid_state_and_prove> m_receiptid_states = std::vector<xreceiptid_state_and_prove>(enum_max_table_slots);
 };
 
 NS_END2
@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -79,6 +80,9 @@ public:
     int32_t check_full() const {
         return m_xtable_info->check_send_tx_reached_upper_limit();
     }
+    bool bytes_full() const {
+        return !m_tx_set.empty() && m_xtable_info->is_tx_bytes_reached_upper_limit();
+    }
 
 private:
     xsend_tx_set_t m_tx_set;
@@ -94,6 +98,8 @@ public:
     int32_t push_tx(const std::shared_ptr<xtx_entry> & tx_ent);
     void update_latest_nonce(uint64_t latest_nonce);
     const std::vector<xcons_transaction_ptr_t> get_continuous_txs(uint32_t max_num, uint64_t upper_nonce, uint64_t lower_nonce) const;
+    // append continuous txs to txs, return appended count
+    uint32_t get_continuous_txs(uint32_t max_num, uint64_t upper_nonce, uint64_t lower_nonce, std::vector<xcons_transaction_ptr_t> & txs) const;
     void erase(uint64_t nonce, bool clear_follower);
     bool empty() const {
         return m_txs.empty();
@@ -119,6 +125,10 @@ public:
     const std::shared_ptr<xtx_entry> find(const std::string & account_addr, const uint256_t & hash) const;
     void updata_latest_nonce(const std::string & account_addr, uint64_t latest_nonce);
     void clear_expired_txs();
+    // drop the send tx of lowest score to give room to others, return false if queue is empty.
+    bool drop_lowest_tx();
+    // append all txs in the queue to txs
+    void get_all_txs(std::vector<xcons_transaction_ptr_t> & txs) const;
     uint32_t size() const {
         return m_send_tx_queue_internal.size();
     }
@@ -90,11 +90,18 @@ public:
         return m_txs.size();
     }
     const std::shared_ptr<xtx_entry> get_tx_by_receipt_id(uint64_t receipt_id) const;
+    uint64_t get_continuous_receipt_id() const {
+        return m_continuous_receipt_id;
+    }
 
 private:
+    void extend_continuous_receipt_id();
+
     std::map<uint64_t, std::shared_ptr<xtx_entry>> m_txs;
     xreceipt_queue_internal_t * m_receipt_queue_internal;
     uint64_t m_latest_receipt_id{0};
+    // all receipts in (m_latest_receipt_id, m_continuous_receipt_id] are in m_txs, maintained on push and erase, so packing need not check continuity
+    uint64_t m_continuous_receipt_id{0};
 };
 
 using xtx_peer_table_map_t = std::map<base::xtable_shortid_t, std::shared_ptr<xpeer_table_receipts_t>>;
@@ -117,6 +124,8 @@ public:
     const std::vector<xtxpool_table_lacking_receipt_ids_t> get_lacking_discrete_confirm_tx_ids(const std::map<base::xtable_shortid_t, xneed_confirm_ids> & need_confirm_ids_map,
                                                                                                uint32_t & total_num) const;
     void update_receipt_id_by_confirmed_tx(const tx_info_t & txinfo, base::xtable_shortid_t peer_table_sid, uint64_t receiptid);
+    // append all receipts in the queue to txs
+    void get_all_txs(std::vector<xcons_transaction_ptr_t> & txs) const;
     // uint64_t get_latest_recv_receipt_id(base::xtable_shortid_t peer_table_sid) const;
     // uint64_t get_latest_confirm_receipt_id(base::xtable_shortid_t peer_table_sid) const;
     uint32_t size() const;
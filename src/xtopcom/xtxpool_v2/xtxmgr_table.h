@@ -38,6 +38,8 @@ public:
                                                                                                uint32_t & total_num) const;
     void clear_expired_txs();
     void update_receiptid_state(const base::xreceiptid_state_ptr_t & receiptid_state);
+    // all pending send txs and receipts
+    std::vector<xcons_transaction_ptr_t> get_all_txs() const;
 
 private:
     xtxpool_table_info_t * m_xtable_info;
@@ -46,6 +46,7 @@ public:
 class xtxpool_t : public xtxpool_face_t {
 public:
     xtxpool_t(const std::shared_ptr<xtxpool_resources_face> & para);
+    ~xtxpool_t();
 
     int32_t push_send_tx(const std::shared_ptr<xtx_entry> & tx) override;
     int32_t push_receipt(const std::shared_ptr<xtx_entry> & tx, bool is_self_send, bool is_pulled) override;
@@ -75,11 +76,17 @@ public:
     std::map<std::string, uint64_t> get_min_keep_heights() const override;
     xtransaction_ptr_t get_raw_tx(const std::string & account_addr, base::xtable_shortid_t peer_table_sid, uint64_t receipt_id) const override;
     const std::set<base::xtable_shortid_t> & get_all_table_sids() const override;
+    void set_journal_dir(const std::string & dir) override;
+    void save_journal() override;
 
 private:
     std::shared_ptr<xtxpool_table_t> get_txpool_table_by_addr(const std::string & address) const;
     std::shared_ptr<xtxpool_table_t> get_txpool_table_by_addr(const std::shared_ptr<xtx_entry> & tx) const;
     std::shared_ptr<xtxpool_table_t> get_txpool_table(uint8_t zone, uint16_t subaddr) const;
+    std::string journal_path(const std::string & table_addr) const;
+    void save_table_journal(const std::shared_ptr<xtxpool_table_t> & table) const;
+    void load_table_journal(const std::shared_ptr<xtxpool_table_t> & table);
+    void load_journals(const std::vector<std::shared_ptr<xtxpool_table_t>> & tables);
 
     xtables_mgr m_tables_mgr;
     std::vector<std::shared_ptr<xtxpool_role_info_t>> m_roles[xtxpool_zone_type_max];
@@ -89,6 +96,10 @@ private:
     std::set<base::xtable_shortid_t> m_all_table_sids;
     std::map<base::xtable_shortid_t, uint64_t> m_peer_table_height_cache;
     mutable std::mutex m_peer_table_height_cache_mutex;
+    uint64_t m_memory_reporter{0};
+    std::string m_journal_dir;
+    mutable std::mutex m_journal_mutex;     // serializes journal writes and guards m_journal_loaded
+    std::set<std::string> m_journal_loaded;  // tables whose journal was loaded, a journal is loaded once a process
 };
 
 }  // namespace xtxpool_v2
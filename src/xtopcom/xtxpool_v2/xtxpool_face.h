@@ -5,6 +5,7 @@
 #pragma once
 
 #include "xbasic/xmemory.hpp"
+#include "xbasic/xobject_pool.h"
 #include "xchain_timer/xchain_timer_face.h"
 #include "xcommon/xmessage_id.h"
 #include "xdata/xblock.h"
@@ -270,6 +271,10 @@ public:
     virtual std::map<std::string, uint64_t> get_min_keep_heights() const = 0;
     virtual xtransaction_ptr_t get_raw_tx(const std::string & account_addr, base::xtable_shortid_t peer_table_sid, uint64_t receipt_id) const = 0;
     virtual const std::set<base::xtable_shortid_t> & get_all_table_sids() const = 0;
+    // directory of the journals of pending txs, empty disables journaling. set before any table is subscribed.
+    virtual void set_journal_dir(const std::string & dir) = 0;
+    // writes the pending txs of all subscribed tables to their journals
+    virtual void save_journal() = 0;
 };
 
 class xtxpool_instance {
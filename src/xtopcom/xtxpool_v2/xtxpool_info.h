@@ -25,6 +25,15 @@ using namespace top::data;
 #define role_recv_tx_queue_size_max_for_each_table (800)
 #define role_confirm_tx_queue_size_max_for_each_table (800)
 
+// memory limits of txs in pool, a big payload tx costs more than a tiny transfer.
+#define table_tx_queue_bytes_max (16 * 1024 * 1024)
+#define txpool_tx_queue_bytes_max (1024 * 1024 * 1024)
+#define tx_entry_bytes_overhead (512)  // entry, indexes and receipt beside raw tx
+
+inline int64_t get_tx_entry_bytes(const xcons_transaction_ptr_t & tx) {
+    return (int64_t)tx->get_transaction()->get_tx_len() + tx_entry_bytes_overhead;
+}
+
 class xtx_counter_t {
 public:
     void send_tx_inc(int32_t count) {
@@ -46,6 +55,10 @@ public:
     void set_unconfirm_tx_count(uint32_t count) {
         m_unconfirm_tx_count = count;
     }
+    void tx_bytes_inc(int64_t bytes) {
+        xassert(m_tx_bytes + bytes >= 0);
+        m_tx_bytes += bytes;
+    }
     int32_t get_send_tx_count() const {
         return m_send_tx_count;
     }
@@ -58,12 +71,16 @@ public:
     int32_t get_unconfirm_tx_count() const {
         return m_unconfirm_tx_count;
     }
+    int64_t get_tx_bytes() const {
+        return m_tx_bytes;
+    }
 
 private:
     std::atomic<int32_t> m_send_tx_count{0};
     std::atomic<int32_t> m_recv_tx_count{0};
     std::atomic<int32_t> m_conf_tx_count{0};
     std::atomic<int32_t> m_unconfirm_tx_count{0};
+    std::atomic<int64_t> m_tx_bytes{0};
 };
 
 class xtxpool_statistic_t {
@@ -154,6 +171,18 @@ public:
     void dec_push_tx_confirm_cur_num(uint32_t num) {
         m_push_tx_confirm_cur_num -= num;
     }
+    void inc_push_tx_bytes_cur(int64_t bytes) {
+        m_push_tx_bytes_cur += bytes;
+    }
+    void dec_push_tx_bytes_cur(int64_t bytes) {
+        m_push_tx_bytes_cur -= bytes;
+    }
+    int64_t get_push_tx_bytes_cur() const {
+        return m_push_tx_bytes_cur;
+    }
+    uint32_t get_push_tx_cur_num() const {
+        return m_push_tx_send_cur_num + m_push_tx_recv_cur_num + m_push_tx_confirm_cur_num;
+    }
     void inc_push_tx_send_fail_num(uint32_t num) {
         m_push_tx_send_fail_num += num;
     }
@@ -211,6 +240,8 @@ public:
                              m_push_tx_confirm_cur_num.load(),
                              "unconfirm_cur",
                              m_unconfirm_tx_cache_num.load(),
+                             "bytes_cur",
+                             m_push_tx_bytes_cur.load(),
                              "push_send_fail",
                              m_push_tx_send_fail_num.load(),
                              "push_receipt_fail",
@@ -288,6 +319,7 @@ private:
     std::atomic<uint32_t> m_push_tx_send_cur_num{0};
     std::atomic<uint32_t> m_push_tx_recv_cur_num{0};
     std::atomic<uint32_t> m_push_tx_confirm_cur_num{0};
+    std::atomic<int64_t> m_push_tx_bytes_cur{0};
     std::atomic<uint32_t> m_push_tx_send_fail_num{0};
     std::atomic<uint32_t> m_push_tx_receipt_fail_num{0};
     std::atomic<uint32_t> m_receipt_duplicate_num{0};
@@ -356,11 +388,13 @@ public:
         m_statistic->dec_push_tx_send_cur_num(m_counter.get_send_tx_count());
         m_statistic->dec_push_tx_recv_cur_num(m_counter.get_recv_tx_count());
         m_statistic->dec_push_tx_confirm_cur_num(m_counter.get_conf_tx_count());
+        m_statistic->dec_push_tx_bytes_cur(m_counter.get_tx_bytes());
         set_unconfirm_tx_count(0);
 
         XMETRICS_GAUGE(metrics::txpool_send_tx_cur, -m_counter.get_send_tx_count());
         XMETRICS_GAUGE(metrics::txpool_recv_tx_cur, -m_counter.get_recv_tx_count());
         XMETRICS_GAUGE(metrics::txpool_confirm_tx_cur, -m_counter.get_conf_tx_count());
+        XMETRICS_GAUGE(metrics::txpool_tx_bytes_cur, -m_counter.get_tx_bytes());
         // XMETRICS_COUNTER_SET("table_send_tx_cur" + get_address(), 0);
         // XMETRICS_COUNTER_SET("table_recv_tx_cur" + get_address(), 0);
         // XMETRICS_COUNTER_SET("table_confirm_tx_cur" + get_address(), 0);
@@ -456,10 +490,33 @@ public:
         }
     }
 
+    void tx_bytes_inc(int64_t bytes) {
+        m_counter.tx_bytes_inc(bytes);
+        m_statistic->inc_push_tx_bytes_cur(bytes);
+        XMETRICS_GAUGE(metrics::txpool_tx_bytes_cur, bytes);
+    }
+
+    void tx_bytes_dec(int64_t bytes) {
+        m_counter.tx_bytes_inc(-bytes);
+        m_statistic->dec_push_tx_bytes_cur(bytes);
+        XMETRICS_GAUGE(metrics::txpool_tx_bytes_cur, -bytes);
+    }
+
+    // bytes of all txs of this table, or of all tables of this node, exceed the limit.
+    bool is_tx_bytes_reached_upper_limit() const {
+        if (m_counter.get_tx_bytes() >= table_tx_queue_bytes_max || m_statistic->get_push_tx_bytes_cur() >= txpool_tx_queue_bytes_max) {
+            XMETRICS_GAUGE(metrics::txpool_alarm_tx_bytes_reached_upper_limit, 1);
+            return true;
+        }
+        return false;
+    }
+
     int32_t check_send_tx_reached_upper_limit() {
         if (m_counter.get_send_tx_count() >= table_send_tx_queue_size_max) {
             XMETRICS_GAUGE(metrics::txpool_alarm_send_tx_reached_upper_limit, 1);
             return xtxpool_error_table_reached_upper_limit;
+        } else if (is_tx_bytes_reached_upper_limit()) {
+            return xtxpool_error_table_reached_upper_limit;
         }/* else if (any_role_send_tx_reached_upper_limit()) {
             return xtxpool_error_role_reached_upper_limit;
         }*/
@@ -577,6 +634,10 @@ public:
         return m_counter.get_conf_tx_count();
     }
 
+    int64_t get_tx_bytes() const {
+        return m_counter.get_tx_bytes();
+    }
+
     const std::set<base::xtable_shortid_t> get_all_table_sids() const {
         if (m_all_table_sids == nullptr) {
             return m_empty;
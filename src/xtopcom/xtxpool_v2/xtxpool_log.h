@@ -6,6 +6,7 @@
 
 #include "xbase/xlog.h"
 #include "xbase/xns_macro.h"
+#include "xbasic/xasync_log.h"
 
 #include <string>
 
@@ -16,11 +17,11 @@ NS_BEG2(top, xtxpool_v2)
 
 std::string get_error_str(int32_t code);
 
-#define xtxpool_dbg xdbg
+#define xtxpool_dbg(fmt, ...) xasync_log(enum_xlog_level_debug, fmt, ##__VA_ARGS__)
 #define xtxpool_dbg_info xdbg_info
-#define xtxpool_info xinfo
-#define xtxpool_kinfo xkinfo
-#define xtxpool_warn xwarn
+#define xtxpool_info(fmt, ...) xasync_log(enum_xlog_level_info, fmt, ##__VA_ARGS__)
+#define xtxpool_kinfo(fmt, ...) xasync_log(enum_xlog_level_key_info, fmt, ##__VA_ARGS__)
+#define xtxpool_warn(fmt, ...) xasync_log(enum_xlog_level_warn, fmt, ##__VA_ARGS__)
 #define xtxpool_error xerror
 
 NS_END2
@@ -30,12 +30,14 @@ public:
     virtual base::xvcertauth_t * get_certauth() const override;
     virtual mbus::xmessage_bus_face_t * get_bus() const override;
     virtual xreceiptid_state_cache_t & get_receiptid_state_cache() override;
+    virtual xverified_prove_cert_cache_t & get_verified_prove_cert_cache() override;
 
 private:
     observer_ptr<base::xvblockstore_t> m_blockstore;
     observer_ptr<base::xvcertauth_t> m_certauth;
     observer_ptr<mbus::xmessage_bus_face_t> m_bus;
     xreceiptid_state_cache_t m_receiptid_state_cache;
+    xverified_prove_cert_cache_t m_verified_prove_cert_cache;
 };
 
 NS_END2
@@ -12,6 +12,7 @@
 
 #include "xmbus/xmessage_bus.h"
 #include "xtxpool_v2/xreceiptid_state_cache.h"
+#include "xtxpool_v2/xverified_prove_cert_cache.h"
 
 NS_BEG2(top, xtxpool_v2)
 
@@ -21,6 +22,7 @@ public:
     virtual base::xvcertauth_t * get_certauth() const =0;
     virtual mbus::xmessage_bus_face_t * get_bus() const = 0;
     virtual xreceiptid_state_cache_t & get_receiptid_state_cache() = 0;
+    virtual xverified_prove_cert_cache_t & get_verified_prove_cert_cache() = 0;
 };
 
 NS_END2
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "xbasic/xmemory.hpp"
+#include "xbasic/xthreading/xmpsc_queue.hpp"
 #include "xdata/xcons_transaction.h"
 #include "xdata/xtable_bstate.h"
 #include "xdata/xunit_bstate.h"
@@ -122,9 +123,20 @@ public:
     xtransaction_ptr_t get_raw_tx(base::xtable_shortid_t peer_table_sid, uint64_t receipt_id) const;
 
     void get_min_keep_height(std::string & table_addr, uint64_t & height) const;
+    // pending send txs and receipts, journaled to be pushed again after a restart
+    std::vector<xcons_transaction_ptr_t> get_all_txs() const;
+    const std::string & get_table_addr() const {
+        return m_xtable_info.get_address();
+    }
 
 private:
+    enum {
+        enum_parallel_verify_min_txs = 8,  // verify serially for small proposals, not worth to start threads
+        enum_parallel_verify_max_threads = 4,
+    };
     // bool is_account_need_update(const std::string & account_addr) const;
+    static int32_t check_txs_order(const std::vector<xcons_transaction_ptr_t> & txs);
+    void parallel_verify_cons_txs(const std::vector<xcons_transaction_ptr_t> & txs, std::vector<int32_t> & results) const;
     int32_t verify_tx_common(const xcons_transaction_ptr_t & tx) const;
     int32_t verify_send_tx(const xcons_transaction_ptr_t & tx, bool is_first_time_push_tx) const;
     int32_t verify_receipt_tx(const xcons_transaction_ptr_t & tx) const;
@@ -133,9 +145,14 @@ private:
     void update_id_state(const std::vector<update_id_state_para> & para_vec);
     bool is_reach_limit(const std::shared_ptr<xtx_entry> & tx) const;
     int32_t push_send_tx_real(const std::shared_ptr<xtx_entry> & tx);
+    int32_t insert_send_tx(const std::shared_ptr<xtx_entry> & tx, uint64_t latest_nonce);  // must hold m_mgr_mutex
+    void drain_deferred_send_txs();  // must hold m_mgr_mutex
     int32_t push_receipt_real(const std::shared_ptr<xtx_entry> & tx);
     void deal_commit_table_block(xblock_t * table_block, bool update_txmgr);
-    xcons_transaction_ptr_t build_receipt(base::xtable_shortid_t peer_table_sid, uint64_t receipt_id, uint64_t commit_height, enum_transaction_subtype subtype);
+    void build_receipts(base::xtable_shortid_t peer_table_sid,
+                        const std::map<uint64_t, std::set<uint64_t>> & height_receiptids,
+                        enum_transaction_subtype subtype,
+                        std::vector<xcons_transaction_ptr_t> & receipts);
 
     common::xaccount_address_t m_table_address;
     xtxpool_resources_face * m_para;
@@ -143,6 +160,8 @@ private:
     xtxpool_table_info_t m_xtable_info;
     xtxmgr_table_t m_txmgr_table;
     mutable std::mutex m_mgr_mutex;        // lock m_txmgr_table
+    // verified send txs pushed while m_mgr_mutex is busy(e.g. packing), inserted by next lock holder
+    threading::xmpsc_queue<std::pair<std::shared_ptr<xtx_entry>, uint64_t>> m_deferred_send_txs;
 
     xunconfirm_id_height m_unconfirm_id_height;
     xunconfirm_raw_txs m_unconfirm_raw_txs;
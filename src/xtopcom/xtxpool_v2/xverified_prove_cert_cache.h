@@ -0,0 +1,33 @@
+// Copyright (c) 2017-2020 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xlru_cache.h"
+#include "xvledger/xvblock.h"
+
+#include <string>
+
+NS_BEG2(top, xtxpool_v2)
+
+// prove certs of peer table blocks whose multi-sign is verified, shared by all tables of the txpool.
+// the receipts made from one peer table block share the same cert, so its multi-sign is verified once
+// for all the receiving tables. the merkle path of each receipt is still checked per receipt.
+class xverified_prove_cert_cache_t {
+public:
+    enum {
+        enum_verified_prove_cert_cache_max = 4096,
+    };
+
+    bool is_verified(const std::string & prove_account, base::xvqcert_t * prove_cert) const;
+    void set_verified(const std::string & prove_account, base::xvqcert_t * prove_cert);
+
+private:
+    // keyed by (table, viewid, cert hash), the signatures are part of the key so a cert with the same content but other signatures is verified again
+    static std::string make_key(const std::string & prove_account, base::xvqcert_t * prove_cert);
+
+    mutable basic::xlru_cache<std::string, bool> m_verified_certs{enum_verified_prove_cert_cache_max};
+};
+
+NS_END2
@@ -1,5 +1,7 @@
 #include "xtxstore/xtransaction_prepare_mgr.h"
 
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xdata/xtransaction_cache.h"
 #include "xmbus/xevent_store.h"
 #include "xpbase/base/top_utils.h"
@@ -10,7 +12,7 @@
 NS_BEG2(top, txexecutor)
 
 xtransaction_prepare_mgr::xtransaction_prepare_mgr(observer_ptr<mbus::xmessage_bus_face_t> const & mbus, observer_ptr<xbase_timer_driver_t> const & timer_driver)
-  : m_mbus{mbus}, m_timer_driver{timer_driver}, m_transaction_cache{std::make_shared<data::xtransaction_cache_t>()} {
+  : m_mbus{mbus}, m_timer_driver{timer_driver}, m_transaction_cache{std::make_shared<data::xtransaction_cache_t>(XGET_CONFIG(tx_cache_max_bytes))} {
     xdbg("xtransaction_prepare_mgr init %p, %p, %p", this, m_timer_driver.get(), m_transaction_cache.get());
 }
 
@@ -18,8 +20,14 @@ void xtransaction_prepare_mgr::start() {
     if (running()) {
         return;
     }
-    if (m_mbus != nullptr)
-        m_listener = m_mbus->add_listener(top::mbus::xevent_major_type_store, std::bind(&xtransaction_prepare_mgr::on_block_to_db_event, this, std::placeholders::_1));
+    if (m_mbus != nullptr) {
+        // extracting the block may load it from db, keep that off the thread committing blocks
+        mbus::xevent_listener_options_t options;
+        options.name = "txstore_prepare";
+        m_listener = m_mbus->add_async_listener(top::mbus::xevent_major_type_store,
+                                                std::bind(&xtransaction_prepare_mgr::on_block_to_db_event, this, std::placeholders::_1),
+                                                std::move(options));
+    }
     assert(!running());
     running(true);
     assert(running());
@@ -36,10 +44,11 @@ void xtransaction_prepare_mgr::stop() {
     assert(running());
     running(false);
     assert(!running());
-    m_transaction_cache->tx_clear();
-
+    // the listener is stopped first, so no queued block updates the cache after it is cleared
     if (m_mbus != nullptr)
         m_mbus->remove_listener(top::mbus::xevent_major_type_store, m_listener);
+
+    m_transaction_cache->tx_clear();
 }
 
 std::shared_ptr<data::xtransaction_cache_t> xtransaction_prepare_mgr::transaction_cache() {
@@ -63,7 +72,7 @@ void xtransaction_prepare_mgr::on_block_to_db_event(mbus::xevent_ptr_t e) {
 }
 
 int xtransaction_prepare_mgr::update_prepare_cache(const data::xblock_ptr_t bp) {
-    xJson::Value jv;
+    data::xtransaction_cache_state_t state;
     auto input_actions = data::xblockextract_t::unpack_txactions((base::xvblock_t*)bp.get());
     for(auto & action : input_actions) {
         base::enum_transaction_subtype _subtype = (base::enum_transaction_subtype)action.get_org_tx_action_id();
@@ -71,36 +80,34 @@ int xtransaction_prepare_mgr::update_prepare_cache(const data::xblock_ptr_t bp)
         data::xlightunit_action_ptr_t txaction = std::make_shared<data::xlightunit_action_t>(action);
         xdbg("tran hash: %s", top::HexEncode(txaction->get_tx_hash()).c_str());
 
-        data::xlightunit_action_ptr_t recv_txinfo;
         data::xtransaction_cache_data_t cache_data;
         if (m_transaction_cache->tx_get(txaction->get_tx_hash(), cache_data) == 0) {
             xdbg("not find tran: %s", top::HexEncode(txaction->get_tx_hash()).c_str());
             continue;
         }
-        recv_txinfo = cache_data.recv_txinfo;
 
         data::xtransaction_ptr_t tx_ptr = cache_data.tran;
 
-        jv["height"] = static_cast<xJson::UInt64>(bp->get_height());
+        state.height = bp->get_height();
         auto tx_info = txaction;
         if (tx_info != nullptr) {
-            jv["used_gas"] = static_cast<xJson::UInt64>(tx_info->get_used_tgas());
+            state.used_gas = tx_info->get_used_tgas();
             if (tx_info->is_self_tx()) {
-                jv["exec_status"] = data::xtransaction_t::tx_exec_status_to_str(tx_info->get_tx_exec_status());
-                jv["used_deposit"] = static_cast<xJson::UInt64>(tx_info->get_used_deposit());
+                state.set_exec_status(tx_info->get_tx_exec_status());
+                state.set_used_deposit(tx_info->get_used_deposit());
             }
             if (tx_info->is_send_tx()) {
                 if ((tx_ptr->get_tx_type() == data::xtransaction_type_transfer) && (tx_ptr->get_tx_version() == data::xtransaction_version_2 || tx_info->get_not_need_confirm())) {
-                    jv["used_deposit"] = static_cast<xJson::UInt64>(tx_info->get_used_deposit());
+                    state.set_used_deposit(tx_info->get_used_deposit());
                 } else {
-                    jv["used_deposit"] = 0;
+                    state.set_used_deposit(0);
                 }
             }
             if (tx_info->is_confirm_tx()) {
-                jv["used_deposit"] = static_cast<xJson::UInt64>(tx_info->get_used_deposit());
-                if (recv_txinfo != nullptr) {
-                    jv["recv_tx_exec_status"] = data::xtransaction_t::tx_exec_status_to_str(recv_txinfo->get_tx_exec_status());
-                    jv["exec_status"] = data::xtransaction_t::tx_exec_status_to_str(tx_info->get_tx_exec_status() | recv_txinfo->get_tx_exec_status());
+                state.set_used_deposit(tx_info->get_used_deposit());
+                if (cache_data.has_recv_txinfo) {
+                    state.set_recv_tx_exec_status(cache_data.recv_tx_exec_status);
+                    state.set_exec_status(tx_info->get_tx_exec_status() | cache_data.recv_tx_exec_status);
                 }
             }
         }
@@ -109,13 +116,13 @@ int xtransaction_prepare_mgr::update_prepare_cache(const data::xblock_ptr_t bp)
             continue;
         } else if (_subtype == base::enum_transaction_subtype_send) {
             auto beacon_tx_fee = txexecutor::xtransaction_fee_t::cal_service_fee(tx_ptr->get_source_addr(), tx_ptr->get_target_addr());
-            jv["tx_fee"] = static_cast<xJson::UInt64>(beacon_tx_fee);
-            m_transaction_cache->tx_set_json(txaction->get_tx_hash(), base::enum_transaction_subtype_send, jv);
+            state.set_tx_fee(beacon_tx_fee);
+            m_transaction_cache->tx_set_state(txaction->get_tx_hash(), base::enum_transaction_subtype_send, state);
         } else if (_subtype == base::enum_transaction_subtype_recv) {
-            m_transaction_cache->tx_set_recv_txinfo(txaction->get_tx_hash(), txaction);
-            m_transaction_cache->tx_set_json(txaction->get_tx_hash(), base::enum_transaction_subtype_recv, jv);
+            m_transaction_cache->tx_set_recv_exec_status(txaction->get_tx_hash(), txaction->get_tx_exec_status());
+            m_transaction_cache->tx_set_state(txaction->get_tx_hash(), base::enum_transaction_subtype_recv, state);
         } else if (_subtype == base::enum_transaction_subtype_confirm) {
-            m_transaction_cache->tx_set_json(txaction->get_tx_hash(), base::enum_transaction_subtype_confirm, jv);
+            m_transaction_cache->tx_set_state(txaction->get_tx_hash(), base::enum_transaction_subtype_confirm, state);
         } else
             continue;
 
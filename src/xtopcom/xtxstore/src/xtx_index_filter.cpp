@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2020 Telos Foundation & contributors
+// Licensed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xtxstore/xtx_index_filter.h"
+
+#include "xutility/xhash.h"
+
+#include <algorithm>
+
+NS_BEG2(top, txstore)
+
+constexpr std::size_t xtx_index_filter_t::block_bytes;
+constexpr std::size_t xtx_index_filter_t::bits_per_key;
+constexpr std::size_t xtx_index_filter_t::words_per_block;
+
+xtx_index_filter_t::xtx_index_filter_t(std::size_t const filter_bytes)
+  : m_block_count{std::max<std::size_t>(1, filter_bytes / block_bytes)}, m_words{new std::atomic<uint64_t>[m_block_count * words_per_block]} {
+    for (std::size_t i = 0; i < m_block_count * words_per_block; ++i) {
+        m_words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// the high half of the digest picks the block, the low half gives the probes inside it by double hashing
+static std::size_t block_of(uint64_t const digest, std::size_t const block_count) noexcept {
+    return static_cast<std::size_t>(((digest >> 32) * block_count) >> 32);
+}
+
+static uint32_t probe_bit(uint64_t const digest, std::size_t const i) noexcept {
+    uint32_t const low = static_cast<uint32_t>(digest);
+    uint32_t const step = (low >> 16) | 1;
+    return static_cast<uint32_t>(((low & 0xFFFF) + i * step) % (xtx_index_filter_t::block_bytes * 8));
+}
+
+void xtx_index_filter_t::add(std::string const & tx_hash) noexcept {
+    uint64_t const digest = utl::xxh64_t::digest(tx_hash.data(), tx_hash.size());
+    std::atomic<uint64_t> * block = &m_words[block_of(digest, m_block_count) * words_per_block];
+    for (std::size_t i = 0; i < bits_per_key; ++i) {
+        uint32_t const bit = probe_bit(digest, i);
+        block[bit / 64].fetch_or(uint64_t{1} << (bit % 64), std::memory_order_relaxed);
+    }
+    m_added.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool xtx_index_filter_t::may_contain(std::string const & tx_hash) const noexcept {
+    if (!m_ready.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    uint64_t const digest = utl::xxh64_t::digest(tx_hash.data(), tx_hash.size());
+    std::atomic<uint64_t> const * block = &m_words[block_of(digest, m_block_count) * words_per_block];
+    for (std::size_t i = 0; i < bits_per_key; ++i) {
+        uint32_t const bit = probe_bit(digest, i);
+        if ((block[bit / 64].load(std::memory_order_relaxed) & (uint64_t{1} << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void xtx_index_filter_t::set_ready() noexcept {
+    m_ready.store(true, std::memory_order_release);
+}
+
+bool xtx_index_filter_t::ready() const noexcept {
+    return m_ready.load(std::memory_order_acquire);
+}
+
+std::size_t xtx_index_filter_t::added() const noexcept {
+    return m_added.load(std::memory_order_relaxed);
+}
+
+NS_END2
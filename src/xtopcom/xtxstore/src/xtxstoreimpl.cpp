@@ -3,6 +3,11 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "xtxstore/xtxstoreimpl.h"
+
+#include <future>
+
+#include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xvledger/xvledger.h"
 #include "xvledger/xvtxindex.h"
 #include "xmetrics/xmetrics.h"
@@ -25,14 +30,26 @@ xtxstoreimpl::xtxstoreimpl(observer_ptr<mbus::xmessage_bus_face_t> const & mbus,
   , m_tx_prepare_mgr{std::make_shared<txexecutor::xtransaction_prepare_mgr>(mbus, timer_driver)}
   , m_tx_cache_strategy{common::define_bool_strategy(xdefault_strategy_t{xstrategy_value_enum_t::disable, xstrategy_priority_enum_t::low},
                                                      xnode_type_strategy_t{xnode_type_t::storage_exchange, xstrategy_value_enum_t::enable, xstrategy_priority_enum_t::normal})} {
+    auto const filter_bytes = XGET_CONFIG(txstore_tx_index_filter_bytes);
+    if (filter_bytes > 0) {
+        m_tx_index_filter.reset(new xtx_index_filter_t{filter_bytes});
+    }
 }
 
 xtxstoreimpl::~xtxstoreimpl() {
+    m_closed = true;
+    if (m_tx_index_filter_thread.joinable()) {
+        m_tx_index_filter_thread.join();
+    }
 }
 
 bool xtxstoreimpl::close(bool force_async)  // must call close before release object,otherwise object never be cleanup
 {
     base::xobject_t::close(force_async);  // since mutiple base class has close(),we need call seperately
+    m_closed = true;
+    if (m_tx_index_filter_thread.joinable()) {
+        m_tx_index_filter_thread.join();
+    }
 
     xkinfo("xtxstoreimpl::close");
     return true;
@@ -46,6 +63,10 @@ void * xtxstoreimpl::query_interface(const int32_t _enum_xobject_type_) {
 }
 
 base::xauto_ptr<base::xvtxindex_t> xtxstoreimpl::load_tx_idx(const std::string & raw_tx_hash, base::enum_transaction_subtype type) {
+    if (m_tx_index_filter != nullptr && !m_tx_index_filter->may_contain(raw_tx_hash)) {
+        xdbg("xvtxstore_t::load_tx_idx,index filtered out for hahs_tx=%s", base::xstring_utl::to_hex(raw_tx_hash).c_str());
+        return nullptr;
+    }
     base::enum_txindex_type txindex_type = base::xvtxkey_t::transaction_subtype_to_txindex_type(type);
     const std::string tx_idx_key = base::xvdbkey_t::create_tx_index_key(raw_tx_hash, txindex_type);
     const std::string tx_idx_bin = base::xvchain_t::instance().get_xdbstore()->get_value(tx_idx_key);
@@ -130,8 +151,8 @@ bool xtxstoreimpl::store_relay_txs(base::xvblock_t * block_ptr) {
     }
 
 
-    // get tx hash from txs
-    bool has_error = false;
+    // all tx indexes of the relay block go to DB by one write
+    std::map<std::string, std::string> tx_objs;
     for (auto & tx : extra_relay_block.get_all_transactions()) {
         auto tx_hash_u256 = tx.get_tx_hash();
         std::string tx_hash = std::string(reinterpret_cast<char *>(tx_hash_u256.data()), tx_hash_u256.size());
@@ -141,18 +162,15 @@ bool xtxstoreimpl::store_relay_txs(base::xvblock_t * block_ptr) {
         const std::string tx_key = base::xvdbkey_t::create_prunable_relay_tx_index_key(tx_index->get_tx_hash(), txindex_type);
         std::string tx_bin;
         tx_index->serialize_to_string(tx_bin);
-
-        if (base::xvchain_t::instance().get_xdbstore()->set_value(tx_key, tx_bin) == false) {
-            xerror("txstoreimpl::store_relay_txs,fail to store tx for block(%s)", block_ptr->dump().c_str());
-            has_error = true;  // mark it but let do rest work
-        } else {
-            xinfo("txstoreimpl::store_relay_txs,succ store tx:%s,block=%s",
-                base::xvtxkey_t::transaction_hash_subtype_to_string(tx_index->get_tx_hash(), tx_index->get_tx_phase_type()).c_str(), extra_relay_block.dump().c_str());
-        }        
+        tx_objs[tx_key] = tx_bin;
+        xinfo("txstoreimpl::store_relay_txs,store tx:%s,block=%s",
+            base::xvtxkey_t::transaction_hash_subtype_to_string(tx_index->get_tx_hash(), tx_index->get_tx_phase_type()).c_str(), extra_relay_block.dump().c_str());
     }
 
-    if (has_error)
+    if (base::xvchain_t::instance().get_xdbstore()->set_values(tx_objs) == false) {
+        xerror("txstoreimpl::store_relay_txs,fail to store txs for block(%s)", block_ptr->dump().c_str());
         return false;
+    }
     return true;
 }
 
@@ -171,8 +189,9 @@ bool xtxstoreimpl::store_txs(base::xvblock_t * block_ptr) {
 
     std::vector<xobject_ptr_t<base::xvtxindex_t>> sub_txs;
     if (block_ptr->extract_sub_txs(sub_txs)) {
-        bool has_error = false;
         xassert(!sub_txs.empty());
+        // all tx indexes of one block are merged with other writers into one DB write
+        std::map<std::string, std::string> tx_objs;
         for (auto & v : sub_txs) {
             base::enum_txindex_type txindex_type = base::xvtxkey_t::transaction_subtype_to_txindex_type(v->get_tx_phase_type());
             const std::string tx_key = base::xvdbkey_t::create_tx_index_key(v->get_tx_hash(), txindex_type);
@@ -190,17 +209,26 @@ bool xtxstoreimpl::store_txs(base::xvblock_t * block_ptr) {
                 XMETRICS_GAUGE(metrics::store_tx_index_confirm, 1);
             }
 
-            if (base::xvchain_t::instance().get_xdbstore()->set_value(tx_key, tx_bin) == false) {
-                xerror("xvtxstore_t::store_txs_index,fail to store tx for block(%s)", block_ptr->dump().c_str());
-                has_error = false;  // mark it but let do rest work
-            } else {
-                xinfo("xvtxstore_t::store_txs_index,store tx to DB for block=%s,tx=%s",
-                      block_ptr->dump().c_str(),
-                      base::xvtxkey_t::transaction_hash_subtype_to_string(v->get_tx_hash(), v->get_tx_phase_type()).c_str());
+            tx_objs[tx_key] = tx_bin;
+            // added before the write, so a lookup never sees the index in db but not in the filter
+            if (m_tx_index_filter != nullptr) {
+                m_tx_index_filter->add(v->get_tx_hash());
             }
+            xinfo("xvtxstore_t::store_txs_index,store tx to DB for block=%s,tx=%s",
+                  block_ptr->dump().c_str(),
+                  base::xvtxkey_t::transaction_hash_subtype_to_string(v->get_tx_hash(), v->get_tx_phase_type()).c_str());
         }
-        if (has_error)
+        // caller marks the block as stored once this returns true, so wait for the group commit carrying these indexes
+        std::shared_ptr<std::promise<bool>> written = std::make_shared<std::promise<bool>>();
+        std::future<bool> written_result = written->get_future();
+        if (base::xvchain_t::instance().get_xdbstore()->set_values_async(tx_objs, [written](bool result) { written->set_value(result); }) == false) {
+            xerror("xvtxstore_t::store_txs_index,fail to queue txs for block(%s)", block_ptr->dump().c_str());
             return false;
+        }
+        if (written_result.get() == false) {
+            xerror("xvtxstore_t::store_txs_index,fail to store txs for block(%s)", block_ptr->dump().c_str());
+            return false;
+        }
         return true;
     } else {
         xerror("xvtxstore_t::store_txs_index,fail to extract subtxs for block(%s)", block_ptr->dump().c_str());
@@ -217,12 +245,18 @@ bool xtxstoreimpl::tx_cache_add(std::string const & tx_hash, data::xtransaction_
 
 bool xtxstoreimpl::tx_cache_get(std::string const & tx_hash, std::shared_ptr<data::xtransaction_cache_data_t> tx_cache_data_ptr) {
     if (strategy_permission(m_tx_cache_strategy)) {
-        return m_tx_prepare_mgr->transaction_cache()->tx_get(tx_hash, *tx_cache_data_ptr.get());  // todo change tx_get interface.
+        bool hit = m_tx_prepare_mgr->transaction_cache()->tx_get(tx_hash, *tx_cache_data_ptr.get());  // todo change tx_get interface.
+        XMETRICS_GAUGE(hit ? metrics::txstore_cache_hit : metrics::txstore_cache_miss, 1);
+        return hit;
     }
     return false;
 }
 
 void xtxstoreimpl::update_node_type(uint32_t combined_node_type) noexcept {
+    // db is ready once the node joins, the filter is built at background since it scans every tx index
+    if (m_tx_index_filter != nullptr) {
+        std::call_once(m_tx_index_filter_flag, [this] { m_tx_index_filter_thread = std::thread{&xtxstoreimpl::build_tx_index_filter, this}; });
+    }
     XLOCK_GUARD(m_node_type_mutex) {
         m_combined_node_type = static_cast<common::xnode_type_t>(combined_node_type);
         xdbg("xtxstoreimpl::update_node_type update to %s", common::to_string(m_combined_node_type).c_str());
@@ -234,6 +268,24 @@ void xtxstoreimpl::update_node_type(uint32_t combined_node_type) noexcept {
     }
 }
 
+void xtxstoreimpl::build_tx_index_filter() {
+    // key of tx index is "t/" + raw tx hash + "/" + type, the raw hash may have '/' inside
+    std::string const prefix{"t/"};
+    bool const supported = base::xvchain_t::instance().get_xdbstore()->read_range(prefix, [this, &prefix](std::string const & key, std::string const &) {
+        auto const pos = key.rfind('/');
+        if (pos != std::string::npos && pos > prefix.size()) {
+            m_tx_index_filter->add(key.substr(prefix.size(), pos - prefix.size()));
+        }
+        return !m_closed.load();
+    });
+    if (!supported || m_closed) {
+        xwarn("xtxstoreimpl::build_tx_index_filter not ready,supported=%d", supported);
+        return;
+    }
+    m_tx_index_filter->set_ready();
+    xinfo("xtxstoreimpl::build_tx_index_filter ready,tx hashes=%zu", m_tx_index_filter->added());
+}
+
 bool xtxstoreimpl::strategy_permission(common::xbool_strategy_t const & strategy) const noexcept {
     XLOCK_GUARD(m_node_type_mutex) {
         return strategy.allow(m_combined_node_type);
@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2020 Telos Foundation & contributors
+// Licensed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+NS_BEG2(top, txstore)
+
+/* blocked bloom filter of the tx hashes that have a tx index in db, every probe of a hash falls in one cache line.
+ * it only says "maybe" until ready, and hashes are never removed, so pruned tx indexes stay as false positives.
+ */
+class xtx_index_filter_t {
+public:
+    static constexpr std::size_t block_bytes{64};
+    static constexpr std::size_t bits_per_key{8};  // probes of a hash inside its block
+
+    explicit xtx_index_filter_t(std::size_t filter_bytes);
+    xtx_index_filter_t(xtx_index_filter_t const &) = delete;
+    xtx_index_filter_t & operator=(xtx_index_filter_t const &) = delete;
+
+    void add(std::string const & tx_hash) noexcept;
+    /// @brief False only if the tx hash is surely not added, true before set_ready().
+    bool may_contain(std::string const & tx_hash) const noexcept;
+
+    /// @brief Called after all tx hashes in db were added.
+    void set_ready() noexcept;
+    bool ready() const noexcept;
+    std::size_t added() const noexcept;
+
+private:
+    static constexpr std::size_t words_per_block{block_bytes / sizeof(uint64_t)};
+
+    std::size_t m_block_count;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+    std::atomic<bool> m_ready{false};
+    std::atomic<std::size_t> m_added{0};
+};
+
+NS_END2
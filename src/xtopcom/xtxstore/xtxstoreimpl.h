@@ -10,6 +10,12 @@
 #include "xvledger/xvtxstore.h"
 
 #include "xtxstore/xtransaction_prepare_mgr.h"
+#include "xtxstore/xtx_index_filter.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 NS_BEG2(top, txstore)
 
@@ -47,12 +53,18 @@ private:
     bool strategy_permission(common::xbool_strategy_t const & strategy) const noexcept;
     std::vector<base::xvblock_ptr_t> load_block_objects(const std::string & tx_hash, const base::enum_transaction_subtype type);
     std::vector<base::xvblock_ptr_t> load_block_objects(const std::string & account, const uint64_t height);
+    // adds hashes of the tx indexes in db to the filter, it answers "maybe" until done
+    void build_tx_index_filter();
 private:
     mutable std::mutex m_node_type_mutex{};
     common::xnode_type_t m_combined_node_type;
     common::xbool_strategy_t m_txstore_strategy;
     std::shared_ptr<txexecutor::xtransaction_prepare_mgr> m_tx_prepare_mgr;
     common::xbool_strategy_t m_tx_cache_strategy;
+    std::unique_ptr<xtx_index_filter_t> m_tx_index_filter;
+    std::once_flag m_tx_index_filter_flag;
+    std::thread m_tx_index_filter_thread;
+    std::atomic<bool> m_closed{false};
 };
 
 NS_END2
\ No newline at end of file
@@ -128,11 +128,13 @@ bool xbatch_packer::start_proposal(uint32_t min_tx_num) {
     }
     data::xblock_consensus_para_t & proposal_para = *m_leader_cs_para;
     xunit_dbg_info("xbatch_packer::start_proposal leader begin make_proposal.%s", proposal_para.dump().c_str());
+    uint64_t pack_start_ms = base::xtime_utl::time_now_ms();
     data::xblock_ptr_t proposal_block = m_proposal_maker->make_proposal(proposal_para, min_tx_num);
     if (proposal_block == nullptr) {
         xunit_dbg("xbatch_packer::start_proposal fail-make_proposal.%s", proposal_para.dump().c_str());  // may has no txs for proposal
         return false;
     }
+    uint64_t packed_ms = base::xtime_utl::time_now_ms();
 
     set_vote_extend_data(proposal_block.get(), proposal_para.get_vote_extend_hash(), true);
 
@@ -148,6 +150,8 @@ bool xbatch_packer::start_proposal(uint32_t min_tx_num) {
     }
 
     XMETRICS_GAUGE(metrics::cons_table_leader_make_proposal_succ, 1);
+    m_cons_start_time_ms = base::xtime_utl::time_now_ms();
+    add_timeline(proposal_block.get(), true, pack_start_ms, 0, packed_ms, m_cons_start_time_ms);
     xunit_info("xbatch_packer::start_proposal succ-leader start consensus. block=%s this:%p node:%s xip:%s",
             proposal_block->dump().c_str(), this, m_para->get_resources()->get_account().c_str(), xcons_utl::xip_to_hex(proposal_para.get_leader_xip()).c_str());
 
@@ -543,6 +547,7 @@ int xbatch_packer::verify_proposal(base::xvblock_t * proposal_block, base::xvqce
     if (!connect_to_checkpoint()) {
         return blockmaker::xblockmaker_error_proposal_cannot_connect_to_cp;
     }
+    uint64_t verify_start_ms = base::xtime_utl::time_now_ms();
 
     data::xblock_consensus_para_t proposal_para(get_account(), proposal_block->get_clock(), proposal_block->get_viewid(), proposal_block->get_viewtoken(), proposal_block->get_height(), proposal_block->get_second_level_gmtime());
     set_election_round(false, proposal_para);
@@ -550,6 +555,9 @@ int xbatch_packer::verify_proposal(base::xvblock_t * proposal_block, base::xvqce
     if (ret == xsuccess) {
         ret = set_vote_extend_data(proposal_block, proposal_para.get_vote_extend_hash(), false);
     }
+    if (ret == xsuccess) {
+        add_timeline(proposal_block, false, verify_start_ms, base::xtime_utl::time_now_ms(), 0, 0);
+    }
     return ret;
 }
 
@@ -654,6 +662,7 @@ bool xbatch_packer::on_proposal_finish(const base::xvevent_t & event, xcsobject_
 
         base::xvblock_t *vblock = _evt_obj->get_target_proposal();
         xassert(vblock->is_body_and_offdata_ready(false));
+        update_timeline_cert(vblock);
 
         if (vblock->get_excontainer() != nullptr) {
             vblock->get_excontainer()->commit(vblock);
@@ -665,6 +674,7 @@ bool xbatch_packer::on_proposal_finish(const base::xvevent_t & event, xcsobject_
         XMETRICS_GAUGE(metrics::cons_tableblock_total_succ, 1);
         if (is_leader) {
             XMETRICS_GAUGE(metrics::cons_tableblock_leader_succ, 1);
+            update_cert_latency();
             if (vblock->get_height() > 2) {
                 send_receipts(vblock);
             }
@@ -674,6 +684,81 @@ bool xbatch_packer::on_proposal_finish(const base::xvevent_t & event, xcsobject_
     }
     return false;  // throw event up again to let txs-pool or other object start new consensus
 }
+void xbatch_packer::update_cert_latency() {
+    if (m_cons_start_time_ms == 0) {
+        return;
+    }
+    uint64_t now_ms = base::xtime_utl::time_now_ms();
+    uint64_t latency_ms = now_ms > m_cons_start_time_ms ? now_ms - m_cons_start_time_ms : 0;
+    m_cons_start_time_ms = 0;
+    // weight 1/8 for new sample, so one slow round does not hide the trend
+    m_cons_latency_ewma_ms = (m_cons_latency_ewma_ms == 0) ? latency_ms : (m_cons_latency_ewma_ms * 7 + latency_ms) / 8;
+    xunit_dbg("xbatch_packer::update_cert_latency table:%s latency:%" PRIu64 " ewma:%" PRIu64, get_account().c_str(), latency_ms, m_cons_latency_ewma_ms);
+    if (m_tableid.get_zone_index() == base::enum_chain_zone_consensus_index && m_tableid.get_subaddr() < 64) {
+        XMETRICS_ARRCNT_SET(metrics::cons_sharding_table_cert_latency_ms, m_tableid.get_subaddr(), (int64_t)latency_ms);
+        XMETRICS_ARRCNT_SET(metrics::cons_sharding_table_cert_latency_ewma_ms, m_tableid.get_subaddr(), (int64_t)m_cons_latency_ewma_ms);
+    }
+}
+
+void xbatch_packer::add_timeline(base::xvblock_t * proposal, bool is_leader, uint64_t start_ms, uint64_t verified_ms, uint64_t packed_ms, uint64_t sent_ms) {
+    std::lock_guard<std::mutex> lock(m_timeline_mutex);
+    xcons_timeline_t & timeline = m_cons_timelines[proposal->get_height()];
+    timeline = xcons_timeline_t{};
+    timeline.viewid = proposal->get_viewid();
+    timeline.is_leader = is_leader;
+    timeline.start_ms = start_ms;
+    timeline.verified_ms = verified_ms;
+    timeline.packed_ms = packed_ms;
+    timeline.sent_ms = sent_ms;
+    if (is_leader) {
+        XMETRICS_GAUGE(metrics::cons_timeline_leader_pack_ms, packed_ms - start_ms);
+        XMETRICS_GAUGE(metrics::cons_timeline_leader_send_ms, sent_ms - packed_ms);
+    } else {
+        XMETRICS_GAUGE(metrics::cons_timeline_backup_verify_ms, verified_ms - start_ms);
+    }
+    // failed proposals are never committed, keep only the latest ones
+    while (m_cons_timelines.size() > m_timeline_max_num) {
+        m_cons_timelines.erase(m_cons_timelines.begin());
+    }
+}
+
+void xbatch_packer::update_timeline_cert(base::xvblock_t * cert_block) {
+    std::lock_guard<std::mutex> lock(m_timeline_mutex);
+    auto iter = m_cons_timelines.find(cert_block->get_height());
+    if (iter == m_cons_timelines.end() || iter->second.viewid != cert_block->get_viewid()) {
+        return;
+    }
+    xcons_timeline_t & timeline = iter->second;
+    timeline.cert_ms = base::xtime_utl::time_now_ms();
+    uint64_t voted_ms = timeline.is_leader ? timeline.sent_ms : timeline.verified_ms;
+    XMETRICS_GAUGE(metrics::cons_timeline_cert_ms, timeline.cert_ms - voted_ms);
+}
+
+void xbatch_packer::update_timeline_commit(base::xvblock_t * commit_block) {
+    std::lock_guard<std::mutex> lock(m_timeline_mutex);
+    auto iter = m_cons_timelines.find(commit_block->get_height());
+    if (iter != m_cons_timelines.end() && iter->second.viewid == commit_block->get_viewid() && iter->second.cert_ms != 0) {
+        xcons_timeline_t const & timeline = iter->second;
+        uint64_t commit_ms = base::xtime_utl::time_now_ms();
+        XMETRICS_GAUGE(metrics::cons_timeline_commit_ms, commit_ms - timeline.cert_ms);
+        if (commit_block->get_height() % m_timeline_log_sample == 0) {
+            xunit_info("xbatch_packer::update_timeline_commit timeline table:%s,height:%" PRIu64 ",viewid:%" PRIu64 ",leader:%d,start:%" PRIu64 ",verified:+%" PRIu64
+                       ",packed:+%" PRIu64 ",sent:+%" PRIu64 ",cert:+%" PRIu64 ",commit:+%" PRIu64,
+                       get_account().c_str(),
+                       commit_block->get_height(),
+                       timeline.viewid,
+                       timeline.is_leader,
+                       timeline.start_ms,
+                       timeline.verified_ms != 0 ? timeline.verified_ms - timeline.start_ms : 0,
+                       timeline.packed_ms != 0 ? timeline.packed_ms - timeline.start_ms : 0,
+                       timeline.sent_ms != 0 ? timeline.sent_ms - timeline.start_ms : 0,
+                       timeline.cert_ms - timeline.start_ms,
+                       commit_ms - timeline.start_ms);
+        }
+    }
+    m_cons_timelines.erase(m_cons_timelines.begin(), m_cons_timelines.upper_bound(commit_block->get_height()));
+}
+
 bool  xbatch_packer::on_replicate_finish(const base::xvevent_t & event,xcsobject_t* from_child,const int32_t cur_thread_id,const uint64_t timenow_ms)  //call from lower layer to higher layer(parent)
 {
     xcsaccount_t::on_replicate_finish(event, from_child, cur_thread_id, timenow_ms);
@@ -697,6 +782,7 @@ bool xbatch_packer::on_consensus_commit(const base::xvevent_t & event, xcsobject
     xconsensus::xconsensus_commit * _evt_obj = (xconsensus::xconsensus_commit *)&event;
     xunit_dbg("xbatch_packer::on_consensus_commit, %s class=%d, at_node:%s",
         _evt_obj->get_target_commit()->dump().c_str(), _evt_obj->get_target_commit()->get_block_class(), xcons_utl::xip_to_hex(get_xip2_addr()).c_str());
+    update_timeline_commit(_evt_obj->get_target_commit());
     return false;  // throw event up again to let txs-pool or other object start new consensus
 }
 
@@ -725,7 +811,7 @@ void xbatch_packer::make_receipts_and_send(data::xblock_t * commit_block, data::
 
     for (auto & tx : non_shard_cross_receipts) {
         xtxpool_v2::xtx_para_t para;
-        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = std::make_shared<xtxpool_v2::xtx_entry>(tx, para);
+        std::shared_ptr<xtxpool_v2::xtx_entry> tx_ent = basic::make_pooled_shared<xtxpool_v2::xtx_entry>(tx, para);
         m_para->get_resources()->get_txpool()->push_receipt(tx_ent, true, false);
         XMETRICS_GAUGE(metrics::txpool_received_self_send_receipt_num, 1);
     }
@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 #include "xunit_service/xcons_service_mgr.h"
 
+#include "xbasic/xthreading/xthread_name.h"
 #include "xcommon/xnode_type.h"
 // #include "xunit_service/xcons_proxy.h"
 #include "xunit_service/xleader_election.h"
@@ -43,6 +44,12 @@ xcons_service_mgr_ptr xcons_mgr_build(std::string const & node_account,
                                       observer_ptr<state_sync::xstate_downloader_t> const & downloader) {
     auto work_pool = make_object_ptr<base::xworkerpool_t_impl<3>>(top::base::xcontext_t::instance());
     auto xbft_work_pool = make_object_ptr<base::xworkerpool_t_impl<3>>(top::base::xcontext_t::instance());
+    for (int32_t i = 0; i < (int32_t)work_pool->get_count(); i++) {
+        threading::set_thread_name(work_pool->get_thread(i), "cons_worker" + std::to_string(i));
+    }
+    for (int32_t i = 0; i < (int32_t)xbft_work_pool->get_count(); i++) {
+        threading::set_thread_name(xbft_work_pool->get_thread(i), "xbft_worker" + std::to_string(i));
+    }
 
     auto face = std::make_shared<xunit_service::xelection_cache_imp>();
     std::shared_ptr<xunit_service::xleader_election_face> pelection = std::make_shared<xunit_service::xrotate_leader_election>(blockstore, face);
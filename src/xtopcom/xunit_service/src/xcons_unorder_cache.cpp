@@ -54,28 +54,25 @@ void xcons_unorder_cache::set_unorder_event(const xvip2_t &from_addr, const xvip
 }
 
 void xcons_unorder_cache::clear_old_unorder_event(uint64_t account_viewid) {
-    for (auto iter = m_unorder_events.begin(); iter != m_unorder_events.end();) {
-        if (iter->first < account_viewid) {
-            xunit_warn("cons_unorder_cache::clear_old_unorder_event erase old event.account_viewid=%ld,old packet=%s",
-                       account_viewid, iter->second->_packet.dump().c_str());
-            iter->second->release_ref();
-            iter = m_unorder_events.erase(iter);
-            continue;
-        }
-        iter++;
+    // events are ordered by viewid, so old ones are just the range before account_viewid
+    auto end = m_unorder_events.lower_bound(account_viewid);
+    for (auto iter = m_unorder_events.begin(); iter != end; iter++) {
+        xunit_warn("cons_unorder_cache::clear_old_unorder_event erase old event.account_viewid=%ld,old packet=%s",
+                   account_viewid, iter->second->_packet.dump().c_str());
+        iter->second->release_ref();
     }
+    m_unorder_events.erase(m_unorder_events.begin(), end);
 }
 
 xconsensus::xcspdu_fire* xcons_unorder_cache::get_proposal_event(uint64_t account_viewid) {
-    for (auto iter = m_unorder_events.begin(); iter != m_unorder_events.end();) {
-        if (iter->first == account_viewid && iter->second->_packet.get_msg_type() == xconsensus::enum_consensus_msg_type_proposal) {
-            xconsensus::xcspdu_fire* event = iter->second;
-            xunit_dbg("xcons_unorder_cache::get_proposal_event find event.account_viewid=%ld", account_viewid);
-            iter = m_unorder_events.erase(iter);
-            return event;
-        }
+    auto iter = m_unorder_events.find(account_viewid);
+    if (iter == m_unorder_events.end() || iter->second->_packet.get_msg_type() != xconsensus::enum_consensus_msg_type_proposal) {
+        return nullptr;
     }
-    return nullptr;
+    xconsensus::xcspdu_fire* event = iter->second;
+    xunit_dbg("xcons_unorder_cache::get_proposal_event find event.account_viewid=%ld", account_viewid);
+    m_unorder_events.erase(iter);
+    return event;
 }
 
 NS_END2
@@ -105,6 +105,7 @@ bool xnetwork_proxy::send_out(common::xmessage_id_t const & id, const xvip2_t &
         }
     }
 
+    // proposal goes to group address, so it is spread by group gossip and relayed by peers, leader does not send it to every replica itself
     if (common::broadcast(dst.network_id()) || common::broadcast(dst.zone_id()) || common::broadcast(dst.cluster_id()) || common::broadcast(dst.group_id()) ||
         common::broadcast(dst.slot_id())) {
         network->broadcast(dst, msg, ec);
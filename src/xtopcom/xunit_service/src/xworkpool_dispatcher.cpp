@@ -10,11 +10,15 @@
 #include "xunit_service/xcons_utl.h"
 #include "xblockstore/xblockstore_face.h"
 #include "xunit_service/xrelay_packer2.h"
+#include "xmetrics/xmetrics.h"
 
+#include <chrono>
 #include <cinttypes>
 
 NS_BEG2(top, xunit_service)
 #define WORK_DISPATCH_WATCHER "table_dispatch_timer"
+// size of the per worker array counters in xmetrics
+static constexpr int32_t worker_metrics_max = 32;
 xworkpool_dispatcher::xworkpool_dispatcher(observer_ptr<mbus::xmessage_bus_face_t> const &mb, std::shared_ptr<xcons_service_para_face> const & p_para, std::shared_ptr<xblock_maker_face> const & block_maker)
   : xcons_dispatcher(e_table), m_mbus(mb), m_para(p_para), m_blockmaker(block_maker) {
     xunit_info("xworkpool_dispatcher::xworkpool_dispatcher,create,this=%p", this);
@@ -39,6 +43,29 @@ int16_t xworkpool_dispatcher::get_thread_index(base::xworkerpool_t * pool, base:
     }
 }
 
+// pick the worker with least packers for new table, the hashed one first if it is not busier than others.
+// caller should hold m_mutex
+int16_t xworkpool_dispatcher::select_thread_index(base::xworkerpool_t * pool, base::xtable_index_t & table_id) {
+    auto hashed_index = get_thread_index(pool, table_id);
+    if (hashed_index == 0) {
+        return hashed_index;
+    }
+
+    std::vector<uint32_t> packer_counts(pool->get_count(), 0);
+    for (auto const & pair : m_thread_indexes) {
+        if (pair.second >= 0 && (size_t)pair.second < packer_counts.size()) {
+            packer_counts[pair.second]++;
+        }
+    }
+    int16_t selected_index = hashed_index;
+    for (int16_t index = 1; index < (int16_t)packer_counts.size(); index++) {
+        if (packer_counts[index] < packer_counts[selected_index]) {
+            selected_index = index;
+        }
+    }
+    return selected_index;
+}
+
 bool xworkpool_dispatcher::dispatch(base::xworkerpool_t * pool, base::xcspdu_t * pdu, const xvip2_t & xip_from, const xvip2_t & xip_to) {
     auto            table_id = get_tableid(pdu->get_block_account());
     xdbg("xworkpool_dispatcher::dispatch,pdu=%s,", pdu->dump().c_str());
@@ -94,12 +121,41 @@ void xworkpool_dispatcher::on_clock(base::xvblock_t * clock_block) {
             xunit_warn("xworkpool_dispatcher::on_clock m_packers is empty this:%p TC %" PRIu64, this, clock_block->get_height());
             return;
         }
+        // one call per worker carrying all its packers, instead of one call per packer
+        std::map<int16_t, xbatch_packers> worker_packers;
         for (auto const & pair : m_packers) {
             auto table_index = pair.first;
             xunit_dbg("xworkpool_dispatcher::on_clock this:%p table:%d TC %" PRIu64, this, table_index.to_table_shortid(), clock_block->get_height());
-            auto worker = get_worker(work_pool, table_index);
-            fire_clock(clock_block, worker, pair.second);
+            auto iter = m_thread_indexes.find(table_index);
+            worker_packers[iter != m_thread_indexes.end() ? iter->second : get_thread_index(work_pool, table_index)].push_back(pair.second);
+        }
+        for (auto & pair : worker_packers) {
+            fire_clock(clock_block, work_pool->get_thread(pair.first), pair.first, std::move(pair.second));
+        }
+    }
+    update_worker_metrics(work_pool);
+}
+
+void xworkpool_dispatcher::update_worker_metrics(base::xworkerpool_t * pool) {
+    std::vector<int64_t> packer_counts(pool->get_count(), 0);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto const & pair : m_thread_indexes) {
+            if (pair.second >= 0 && (size_t)pair.second < packer_counts.size()) {
+                packer_counts[pair.second]++;
+            }
+        }
+    }
+    for (int32_t index = 0; index < (int32_t)packer_counts.size() && index < worker_metrics_max; index++) {
+        auto worker = pool->get_thread(index);
+        if (worker == nullptr) {
+            continue;
         }
+        int64_t in, out;
+        int32_t queue_size = worker->count_calls(in, out);
+        xunit_dbg("xworkpool_dispatcher::update_worker_metrics this:%p worker:%d packers:%" PRId64 " queue:%d", this, index, packer_counts[index], queue_size);
+        XMETRICS_ARRCNT_SET(metrics::cons_worker_queue_size, index, queue_size);
+        XMETRICS_ARRCNT_SET(metrics::cons_worker_packer_count, index, packer_counts[index]);
     }
 }
 
@@ -193,6 +249,7 @@ bool xworkpool_dispatcher::destroy(const xvip2_t & xip) {
         packer.second->close();
     }
     m_packers.clear();
+    m_thread_indexes.clear();
     return true;
 }
 
@@ -207,7 +264,7 @@ bool xworkpool_dispatcher::subscribe(const std::vector<base::xtable_index_t> & t
             auto table_id = tables[index];
             auto iter = m_packers.find(table_id);
             if (iter == m_packers.end()) {
-                auto pool_index = get_thread_index(pool, table_id);
+                auto pool_index = select_thread_index(pool, table_id);
                 auto thread_id = pool_thread_ids[pool_index];
                 auto account_id = account(table_id);
 
@@ -220,6 +277,7 @@ bool xworkpool_dispatcher::subscribe(const std::vector<base::xtable_index_t> & t
                 }
                 // packer_ptr->reset_xip_addr(xip);
                 m_packers[table_id] = packer_ptr;
+                m_thread_indexes[table_id] = pool_index;
                 reset_packers.push_back(packer_ptr);
                 xunit_dbg("[xunitservice] subscribe %s %d @ %s %p", account_id.c_str(), table_id.to_table_shortid(), xcons_utl::xip_to_hex(xip).c_str(), this);
             } else {
@@ -246,22 +304,31 @@ bool xworkpool_dispatcher::subscribe(const std::vector<base::xtable_index_t> & t
     return true;
 }
 
+// caller should hold m_mutex
 base::xworker_t * xworkpool_dispatcher::get_worker(base::xworkerpool_t * pool, base::xtable_index_t & table_id) {
-    auto pool_index = get_thread_index(pool, table_id);
+    auto iter = m_thread_indexes.find(table_id);
+    auto pool_index = iter != m_thread_indexes.end() ? iter->second : get_thread_index(pool, table_id);
 //    auto pool_thread_ids = pool->get_thread_ids();
     return pool->get_thread(pool_index);
 }
 
-void xworkpool_dispatcher::fire_clock(base::xvblock_t * block, base::xworker_t * worker, xbatch_packer_ptr_t packer) {
-    auto _call = [](base::xcall_t & call, const int32_t cur_thread_id, const uint64_t timenow_ms) -> bool {
-        auto packer = dynamic_cast<xbatch_packer *>(call.get_param1().get_object());
-        auto block_ptr = dynamic_cast<base::xvblock_t *>(call.get_param2().get_object());
-        packer->fire_clock(*block_ptr, 0, 0);
+void xworkpool_dispatcher::fire_clock(base::xvblock_t * block, base::xworker_t * worker, int16_t thread_index, xbatch_packers packers) {
+    auto packer_count = packers.size();
+    auto _call = [thread_index, packers](base::xcall_t & call, const int32_t cur_thread_id, const uint64_t timenow_ms) -> bool {
+        auto block_ptr = dynamic_cast<base::xvblock_t *>(call.get_param1().get_object());
+        auto begin = std::chrono::steady_clock::now();
+        for (auto const & packer : packers) {
+            packer->fire_clock(*block_ptr, 0, 0);
+        }
+        auto cost_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        if (thread_index < worker_metrics_max) {
+            XMETRICS_ARRCNT_INCR(metrics::cons_worker_clock_time_us, thread_index, (int64_t)cost_us);
+        }
         return true;
     };
-    base::xcall_t asyn_call((base::xcallback_t)_call, packer.get(), block);
+    base::xcall_t asyn_call((base::xcallback_t)_call, block);
     auto ret = worker->send_call(asyn_call); {
-        xunit_dbg("xworkpool_dispatcher::fire_clock ret:%d TC: %" PRIu64, ret, block->get_height());
+        xunit_dbg("xworkpool_dispatcher::fire_clock ret:%d thread:%d packers:%zu TC: %" PRIu64, ret, thread_index, packer_count, block->get_height());
     }
 }
 
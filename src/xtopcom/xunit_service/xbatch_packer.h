@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 #include "xBFT/xconsaccount.h"
 #include "xbase/xobject_ptr.h"
 #include "xunit_service/xcons_face.h"
@@ -74,6 +75,10 @@ private:
     bool    verify_proposal_packet(const xvip2_t & from_addr, const xvip2_t & local_addr, const base::xcspdu_t & packet);
     void    check_latest_cert_block(base::xvblock_t* _cert_block, const xconsensus::xcsview_fire* viewfire, std::error_code & ec);
     void    reset_leader_info();
+    void    update_cert_latency();
+    void    add_timeline(base::xvblock_t * proposal, bool is_leader, uint64_t start_ms, uint64_t verified_ms, uint64_t packed_ms, uint64_t sent_ms);
+    void    update_timeline_cert(base::xvblock_t * cert_block);
+    void    update_timeline_commit(base::xvblock_t * commit_block);
     void    make_receipts_and_send(data::xblock_t * commit_block, data::xblock_t * cert_block);
     virtual uint32_t calculate_min_tx_num(bool first_packing);
     virtual int32_t set_vote_extend_data(base::xvblock_t * proposal_block, const uint256_t & hash, bool is_leader);
@@ -84,14 +89,30 @@ private:
     bool    do_state_sync(uint64_t sync_height);
 
 private:
+    // phase timestamps(ms) of one proposal at local node, from pack or verify until commit
+    struct xcons_timeline_t {
+        uint64_t viewid{0};
+        bool     is_leader{false};
+        uint64_t start_ms{0};     // leader: pack start, backup: verify start
+        uint64_t verified_ms{0};  // backup only, vote is sent right after
+        uint64_t packed_ms{0};    // leader only
+        uint64_t sent_ms{0};      // leader only, proposal passed to xBFT
+        uint64_t cert_ms{0};
+    };
+
     observer_ptr<mbus::xmessage_bus_face_t>  m_mbus;
     base::xtable_index_t                     m_tableid;
     volatile uint64_t                        m_last_view_id;
     std::shared_ptr<xcons_service_para_face> m_para;
     std::shared_ptr<xblock_maker_face>       m_block_maker;
     std::shared_ptr<xproposal_maker_face>    m_proposal_maker;
-    uint64_t                                 m_cons_start_time_ms;
+    uint64_t                                 m_cons_start_time_ms{0};  // when leader start current proposal, 0 if none
+    uint64_t                                 m_cons_latency_ewma_ms{0};  // ewma of leader proposal to cert latency
     static constexpr uint32_t                m_empty_block_max_num{2};
+    static constexpr uint32_t                m_timeline_max_num{8};  // proposals not committed yet, and the failed ones
+    static constexpr uint32_t                m_timeline_log_sample{16};  // trace log one of every sample heights
+    std::mutex                               m_timeline_mutex;  // backup verify proposal at worker thread of pool
+    std::map<uint64_t, xcons_timeline_t>     m_cons_timelines;  // key is block height
     static constexpr uint32_t                m_timer_repeat_time_ms{1000};  // check account by every 3 seconds
     std::string                              m_account_id;
     std::string                              m_latest_cert_block_hash;
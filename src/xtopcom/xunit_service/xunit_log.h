@@ -6,6 +6,7 @@
 
 #include "xbase/xlog.h"
 #include "xbase/xns_macro.h"
+#include "xbasic/xasync_log.h"
 
 #include <string>
 
@@ -14,11 +15,11 @@ NS_BEG2(top, xunit_v2)
 #undef __MODULE__
 #define __MODULE__ "xunit"
 
-#define xunit_dbg xdbg
+#define xunit_dbg(fmt, ...) xasync_log(enum_xlog_level_debug, fmt, ##__VA_ARGS__)
 #define xunit_dbg_info xdbg_info
-#define xunit_info xinfo
-#define xunit_kinfo xkinfo
-#define xunit_warn xwarn
+#define xunit_info(fmt, ...) xasync_log(enum_xlog_level_info, fmt, ##__VA_ARGS__)
+#define xunit_kinfo(fmt, ...) xasync_log(enum_xlog_level_key_info, fmt, ##__VA_ARGS__)
+#define xunit_warn(fmt, ...) xasync_log(enum_xlog_level_warn, fmt, ##__VA_ARGS__)
 #define xunit_error xerror
 
 NS_END2
@@ -7,6 +7,7 @@
 #include "xunit_service/xbatch_packer.h"
 #include "xunit_service/xcons_face.h"
 
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -39,8 +40,10 @@ protected:
     std::string       account(base::xtable_index_t & tableid);
     base::xtable_index_t get_tableid(const std::string & account);
     int16_t           get_thread_index(base::xworkerpool_t * pool, base::xtable_index_t& tableid);
+    int16_t           select_thread_index(base::xworkerpool_t * pool, base::xtable_index_t& tableid);
     base::xworker_t * get_worker(base::xworkerpool_t * pool, base::xtable_index_t& table_id);
-    void              fire_clock(base::xvblock_t * block, base::xworker_t *, xbatch_packer_ptr_t packer);
+    void              fire_clock(base::xvblock_t * block, base::xworker_t *, int16_t thread_index, xbatch_packers packers);
+    void              update_worker_metrics(base::xworkerpool_t * pool);
     void              chain_timer(common::xlogic_time_t time);
     void              on_clock(base::xvblock_t * clock_block) override;
 
@@ -48,6 +51,8 @@ protected:
     observer_ptr<mbus::xmessage_bus_face_t>  m_mbus;
     std::mutex                               m_mutex;
     xbatch_paker_map                         m_packers;
+    // worker of each packer, fixed while packer alive so that all events of a table run in order on the same worker
+    std::map<base::xtable_index_t, int16_t, table_index_compare> m_thread_indexes;
     std::shared_ptr<xcons_service_para_face> m_para;
     std::shared_ptr<xblock_maker_face>       m_blockmaker;
     std::string                              m_watcher_name;
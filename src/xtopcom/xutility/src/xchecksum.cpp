@@ -0,0 +1,250 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+#include "xutility/xchecksum.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define XCHECKSUM_HAS_X86_PATH 1
+#endif
+
+// the checksums are computed on the inverted crc, as in zlib. the software path is slicing-by-8 on tables
+// built once per polynomial, the x86 paths are picked by cpuid at the first call.
+namespace top
+{
+    namespace utl
+    {
+        namespace
+        {
+            constexpr uint32_t crc32_polynomial = 0xEDB88320;   // reflected 0x04C11DB7
+            constexpr uint32_t crc32c_polynomial = 0x82F63B78;  // reflected 0x1EDC6F41
+
+            struct xcrc_tables_t
+            {
+                uint32_t t[8][256];
+
+                explicit xcrc_tables_t(uint32_t polynomial)
+                {
+                    for (uint32_t i = 0; i < 256; ++i)
+                    {
+                        uint32_t crc = i;
+                        for (int j = 0; j < 8; ++j)
+                            crc = (crc >> 1) ^ ((crc & 1) * polynomial);
+                        t[0][i] = crc;
+                    }
+                    for (uint32_t i = 0; i < 256; ++i)
+                    {
+                        for (int k = 1; k < 8; ++k)
+                            t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+                    }
+                }
+            };
+
+            inline uint32_t load32(const uint8_t * p)
+            {
+                return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+            }
+
+            uint32_t slicing_by_8(const xcrc_tables_t & tables, uint32_t crc, const uint8_t * p, size_t size)
+            {
+                const auto & t = tables.t;
+                while (size >= 8)
+                {
+                    const uint32_t one = load32(p) ^ crc;
+                    const uint32_t two = load32(p + 4);
+                    crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+                          t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+                    p += 8;
+                    size -= 8;
+                }
+                while (size-- > 0)
+                    crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+                return crc;
+            }
+
+            const xcrc_tables_t & crc32_tables()
+            {
+                static const xcrc_tables_t tables(crc32_polynomial);
+                return tables;
+            }
+
+            const xcrc_tables_t & crc32c_tables()
+            {
+                static const xcrc_tables_t tables(crc32c_polynomial);
+                return tables;
+            }
+
+#ifdef XCHECKSUM_HAS_X86_PATH
+            constexpr size_t crc32_fold_minimum = 64;
+
+            // folding constants of the reflected crc32 polynomial and its barrett reduction, from
+            // "fast crc computation for generic polynomials using pclmulqdq instruction" (intel, 2009)
+            alignas(16) const uint64_t crc32_k1k2[2] = {0x0154442bd4, 0x01c6e41596};
+            alignas(16) const uint64_t crc32_k3k4[2] = {0x01751997d0, 0x00ccaa009e};
+            alignas(16) const uint64_t crc32_k5[2] = {0x0163cd6124, 0x0000000000};
+            alignas(16) const uint64_t crc32_poly[2] = {0x01db710641, 0x01f7011641};
+
+            // crc of a multiple of 16 bytes, at least 64, on the inverted crc
+            __attribute__((target("pclmul,sse4.1"))) uint32_t crc32_fold(uint32_t crc, const uint8_t * p, size_t size)
+            {
+                __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+                x1 = _mm_loadu_si128((const __m128i *)(p + 0x00));
+                x2 = _mm_loadu_si128((const __m128i *)(p + 0x10));
+                x3 = _mm_loadu_si128((const __m128i *)(p + 0x20));
+                x4 = _mm_loadu_si128((const __m128i *)(p + 0x30));
+                x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+                x0 = _mm_load_si128((const __m128i *)crc32_k1k2);
+                p += 64;
+                size -= 64;
+
+                // four lanes of 128 bits folded in parallel
+                while (size >= 64)
+                {
+                    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+                    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+                    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+                    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+                    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+                    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+                    y5 = _mm_loadu_si128((const __m128i *)(p + 0x00));
+                    y6 = _mm_loadu_si128((const __m128i *)(p + 0x10));
+                    y7 = _mm_loadu_si128((const __m128i *)(p + 0x20));
+                    y8 = _mm_loadu_si128((const __m128i *)(p + 0x30));
+                    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+                    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+                    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+                    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+                    p += 64;
+                    size -= 64;
+                }
+
+                // the four lanes into one
+                x0 = _mm_load_si128((const __m128i *)crc32_k3k4);
+                x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+                x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+                x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+                while (size >= 16)
+                {
+                    x2 = _mm_loadu_si128((const __m128i *)p);
+                    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+                    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+                    p += 16;
+                    size -= 16;
+                }
+
+                // 128 bits to 64
+                x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+                x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+                x1 = _mm_srli_si128(x1, 8);
+                x1 = _mm_xor_si128(x1, x2);
+                x0 = _mm_loadl_epi64((const __m128i *)crc32_k5);
+                x2 = _mm_srli_si128(x1, 4);
+                x1 = _mm_and_si128(x1, x3);
+                x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+                x1 = _mm_xor_si128(x1, x2);
+
+                // barrett reduction to 32 bits
+                x0 = _mm_load_si128((const __m128i *)crc32_poly);
+                x2 = _mm_and_si128(x1, x3);
+                x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+                x2 = _mm_and_si128(x2, x3);
+                x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+                x1 = _mm_xor_si128(x1, x2);
+
+                return (uint32_t)_mm_extract_epi32(x1, 1);
+            }
+
+            __attribute__((target("sse4.2"))) uint32_t crc32c_sse42(uint32_t crc, const uint8_t * p, size_t size)
+            {
+                uint64_t crc64 = crc;
+                while (size >= 8)
+                {
+                    uint64_t word;
+                    __builtin_memcpy(&word, p, sizeof(word));
+                    crc64 = _mm_crc32_u64(crc64, word);
+                    p += 8;
+                    size -= 8;
+                }
+                crc = (uint32_t)crc64;
+                while (size-- > 0)
+                    crc = _mm_crc32_u8(crc, *p++);
+                return crc;
+            }
+
+            bool crc32_use_pclmul()
+            {
+                static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+                return supported;
+            }
+
+            bool crc32c_use_sse42()
+            {
+                static const bool supported = __builtin_cpu_supports("sse4.2");
+                return supported;
+            }
+#endif
+        }
+
+        uint32_t crc32_software(uint32_t crc, const void * data, size_t size)
+        {
+            return ~slicing_by_8(crc32_tables(), ~crc, static_cast<const uint8_t *>(data), size);
+        }
+
+        uint32_t crc32c_software(uint32_t crc, const void * data, size_t size)
+        {
+            return ~slicing_by_8(crc32c_tables(), ~crc, static_cast<const uint8_t *>(data), size);
+        }
+
+        uint32_t crc32(uint32_t crc, const void * data, size_t size)
+        {
+#ifdef XCHECKSUM_HAS_X86_PATH
+            if (size >= crc32_fold_minimum && crc32_use_pclmul())
+            {
+                auto p = static_cast<const uint8_t *>(data);
+                const size_t folded = size & ~static_cast<size_t>(15);
+                crc = ~crc32_fold(~crc, p, folded);
+                return crc32_software(crc, p + folded, size - folded);
+            }
+#endif
+            return crc32_software(crc, data, size);
+        }
+
+        uint32_t crc32c(uint32_t crc, const void * data, size_t size)
+        {
+#ifdef XCHECKSUM_HAS_X86_PATH
+            if (crc32c_use_sse42())
+                return ~crc32c_sse42(~crc, static_cast<const uint8_t *>(data), size);
+#endif
+            return crc32c_software(crc, data, size);
+        }
+
+        const char * crc32_implementation()
+        {
+#ifdef XCHECKSUM_HAS_X86_PATH
+            if (crc32_use_pclmul())
+                return "pclmulqdq";
+#endif
+            return "slicing-by-8";
+        }
+
+        const char * crc32c_implementation()
+        {
+#ifdef XCHECKSUM_HAS_X86_PATH
+            if (crc32c_use_sse42())
+                return "sse4.2";
+#endif
+            return "slicing-by-8";
+        }
+    }
+}
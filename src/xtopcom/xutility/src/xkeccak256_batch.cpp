@@ -0,0 +1,270 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+#include "xutility/xhash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define XKECCAK_HAS_AVX2_PATH 1
+#endif
+
+// keccak-256 of many independent messages, the scalar path hashes on the stack without
+// allocating a context, the avx2 path runs four messages through one permutation.
+namespace top
+{
+    namespace utl
+    {
+        namespace
+        {
+            constexpr size_t keccak256_rate = 136;  // bytes absorbed per permutation
+            constexpr size_t keccak256_rate_words = keccak256_rate / 8;
+            constexpr size_t keccak256_digest = 32;
+
+            constexpr uint64_t keccak_round_constants[24] = {
+                0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+                0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+                0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+                0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+                0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+                0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+            constexpr int keccak_rotations[24] = {1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+            constexpr int keccak_pi_lanes[24] = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+            inline uint64_t rotl64(uint64_t x, int n)
+            {
+                return (x << n) | (x >> (64 - n));
+            }
+
+            inline uint64_t load64(const uint8_t * p)
+            {
+                uint64_t v = 0;
+                for (int i = 7; i >= 0; --i)
+                    v = (v << 8) | p[i];
+                return v;
+            }
+
+            void keccakf(uint64_t s[25])
+            {
+                uint64_t bc[5];
+                for (int round = 0; round < 24; ++round)
+                {
+                    // theta
+                    for (int i = 0; i < 5; ++i)
+                        bc[i] = s[i] ^ s[i + 5] ^ s[i + 10] ^ s[i + 15] ^ s[i + 20];
+                    for (int i = 0; i < 5; ++i)
+                    {
+                        const uint64_t t = bc[(i + 4) % 5] ^ rotl64(bc[(i + 1) % 5], 1);
+                        for (int j = 0; j < 25; j += 5)
+                            s[j + i] ^= t;
+                    }
+                    // rho and pi
+                    uint64_t t = s[1];
+                    for (int i = 0; i < 24; ++i)
+                    {
+                        const int j = keccak_pi_lanes[i];
+                        const uint64_t next = s[j];
+                        s[j] = rotl64(t, keccak_rotations[i]);
+                        t = next;
+                    }
+                    // chi
+                    for (int j = 0; j < 25; j += 5)
+                    {
+                        for (int i = 0; i < 5; ++i)
+                            bc[i] = s[j + i];
+                        for (int i = 0; i < 5; ++i)
+                            s[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+                    }
+                    // iota
+                    s[0] ^= keccak_round_constants[round];
+                }
+            }
+
+            // number of permutations of a message, the padding always takes at least one byte
+            inline size_t keccak256_blocks(size_t size)
+            {
+                return size / keccak256_rate + 1;
+            }
+
+            // block-th rate-sized block of the message, padded with keccak's 0x01 .. 0x80 when it is the last one
+            inline const uint8_t * keccak256_block(const uint8_t * data, size_t size, size_t block, uint8_t * pad_buffer)
+            {
+                const size_t offset = block * keccak256_rate;
+                if (offset + keccak256_rate <= size)
+                    return data + offset;
+
+                const size_t remain = size - offset;
+                memset(pad_buffer, 0, keccak256_rate);
+                if (remain > 0)
+                    memcpy(pad_buffer, data + offset, remain);
+                pad_buffer[remain] ^= 0x01;
+                pad_buffer[keccak256_rate - 1] ^= 0x80;
+                return pad_buffer;
+            }
+
+            inline void store_digest(const uint64_t s[25], uint8_t * output)
+            {
+                for (size_t i = 0; i < keccak256_digest; ++i)
+                    output[i] = (uint8_t)(s[i / 8] >> (8 * (i % 8)));
+            }
+
+            void keccak256_scalar(const uint8_t * data, size_t size, uint8_t * output)
+            {
+                uint64_t s[25] = {0};
+                uint8_t pad_buffer[keccak256_rate];
+                const size_t blocks = keccak256_blocks(size);
+                for (size_t b = 0; b < blocks; ++b)
+                {
+                    const uint8_t * block = keccak256_block(data, size, b, pad_buffer);
+                    for (size_t i = 0; i < keccak256_rate_words; ++i)
+                        s[i] ^= load64(block + 8 * i);
+                    keccakf(s);
+                }
+                store_digest(s, output);
+            }
+
+#ifdef XKECCAK_HAS_AVX2_PATH
+            __attribute__((target("avx2"))) inline __m256i rotl256(__m256i x, int n)
+            {
+                return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+            }
+
+            // four keccak-f[1600] states side by side, lane i of every state in one register
+            __attribute__((target("avx2"))) void keccakf_x4(__m256i s[25])
+            {
+                __m256i bc[5];
+                for (int round = 0; round < 24; ++round)
+                {
+                    for (int i = 0; i < 5; ++i)
+                        bc[i] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(s[i], s[i + 5]), _mm256_xor_si256(s[i + 10], s[i + 15])), s[i + 20]);
+                    for (int i = 0; i < 5; ++i)
+                    {
+                        const __m256i t = _mm256_xor_si256(bc[(i + 4) % 5], rotl256(bc[(i + 1) % 5], 1));
+                        for (int j = 0; j < 25; j += 5)
+                            s[j + i] = _mm256_xor_si256(s[j + i], t);
+                    }
+                    __m256i t = s[1];
+                    for (int i = 0; i < 24; ++i)
+                    {
+                        const int j = keccak_pi_lanes[i];
+                        const __m256i next = s[j];
+                        s[j] = rotl256(t, keccak_rotations[i]);
+                        t = next;
+                    }
+                    for (int j = 0; j < 25; j += 5)
+                    {
+                        for (int i = 0; i < 5; ++i)
+                            bc[i] = s[j + i];
+                        for (int i = 0; i < 5; ++i)
+                            s[j + i] = _mm256_xor_si256(s[j + i], _mm256_andnot_si256(bc[(i + 1) % 5], bc[(i + 2) % 5]));
+                    }
+                    s[0] = _mm256_xor_si256(s[0], _mm256_set1_epi64x((long long)keccak_round_constants[round]));
+                }
+            }
+
+            // lanes run until the longest message is absorbed, a shorter one takes its digest after its
+            // own last block and absorbs nothing afterwards, so its lanes are simply ignored.
+            __attribute__((target("avx2"))) void keccak256_x4(const uint8_t * const datas[4], const size_t sizes[4], uint8_t * const outputs[4])
+            {
+                __m256i s[25];
+                for (int i = 0; i < 25; ++i)
+                    s[i] = _mm256_setzero_si256();
+
+                size_t blocks[4];
+                size_t max_blocks = 0;
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    blocks[lane] = keccak256_blocks(sizes[lane]);
+                    max_blocks = std::max(max_blocks, blocks[lane]);
+                }
+
+                uint8_t pad_buffers[4][keccak256_rate];
+                alignas(32) uint64_t words[keccak256_rate_words][4];
+                alignas(32) uint64_t digest_words[4][4];
+                for (size_t b = 0; b < max_blocks; ++b)
+                {
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        if (b < blocks[lane])
+                        {
+                            const uint8_t * block = keccak256_block(datas[lane], sizes[lane], b, pad_buffers[lane]);
+                            for (size_t i = 0; i < keccak256_rate_words; ++i)
+                                words[i][lane] = load64(block + 8 * i);
+                        }
+                        else
+                        {
+                            for (size_t i = 0; i < keccak256_rate_words; ++i)
+                                words[i][lane] = 0;
+                        }
+                    }
+                    for (size_t i = 0; i < keccak256_rate_words; ++i)
+                        s[i] = _mm256_xor_si256(s[i], _mm256_load_si256((const __m256i *)words[i]));
+                    keccakf_x4(s);
+
+                    for (int i = 0; i < 4; ++i)
+                        _mm256_store_si256((__m256i *)digest_words[i], s[i]);
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        if (b + 1 != blocks[lane])
+                            continue;
+                        const uint64_t lane_state[4] = {digest_words[0][lane], digest_words[1][lane], digest_words[2][lane], digest_words[3][lane]};
+                        for (size_t i = 0; i < keccak256_digest; ++i)
+                            outputs[lane][i] = (uint8_t)(lane_state[i / 8] >> (8 * (i % 8)));
+                    }
+                }
+            }
+
+            bool keccak256_use_avx2()
+            {
+                static const bool supported = __builtin_cpu_supports("avx2");
+                return supported;
+            }
+#endif
+        }
+
+        void xkeccak256_t::digest_batch(size_t count, const uint8_t * const * datas, const size_t * sizes, uint8_t * outputs)
+        {
+            size_t done = 0;
+#ifdef XKECCAK_HAS_AVX2_PATH
+            if (count >= 4 && keccak256_use_avx2())
+            {
+                // messages of close sizes share their permutations, so the avx2 lanes are filled by size
+                std::vector<size_t> order(count);
+                std::iota(order.begin(), order.end(), 0);
+                std::sort(order.begin(), order.end(), [sizes](size_t a, size_t b) { return sizes[a] < sizes[b]; });
+                for (; done + 4 <= count; done += 4)
+                {
+                    const uint8_t * lane_datas[4];
+                    size_t lane_sizes[4];
+                    uint8_t * lane_outputs[4];
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        const size_t index = order[done + lane];
+                        lane_datas[lane] = datas[index];
+                        lane_sizes[lane] = sizes[index];
+                        lane_outputs[lane] = outputs + index * keccak256_digest;
+                    }
+                    keccak256_x4(lane_datas, lane_sizes, lane_outputs);
+                }
+                for (; done < count; ++done)
+                {
+                    const size_t index = order[done];
+                    keccak256_scalar(datas[index], sizes[index], outputs + index * keccak256_digest);
+                }
+                return;
+            }
+#endif
+            for (; done < count; ++done)
+                keccak256_scalar(datas[done], sizes[done], outputs + done * keccak256_digest);
+        }
+
+        void xkeccak256_t::digest_once(const void * data, size_t numBytes, uint8_t output[32])
+        {
+            keccak256_scalar((const uint8_t *)data, numBytes, output);
+        }
+    }
+}
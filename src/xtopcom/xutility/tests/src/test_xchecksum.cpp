@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "xutility/xchecksum.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST(xchecksum, check_values) {
+    const char * check = "123456789";
+    EXPECT_EQ(0xCBF43926u, top::utl::crc32(0, check, std::strlen(check)));
+    EXPECT_EQ(0xE3069283u, top::utl::crc32c(0, check, std::strlen(check)));
+    EXPECT_EQ(0xCBF43926u, top::utl::crc32_software(0, check, std::strlen(check)));
+    EXPECT_EQ(0xE3069283u, top::utl::crc32c_software(0, check, std::strlen(check)));
+    EXPECT_EQ(0u, top::utl::crc32(0, nullptr, 0));
+    EXPECT_EQ(0u, top::utl::crc32c(0, nullptr, 0));
+}
+
+TEST(xchecksum, same_as_software) {
+    // sizes and alignments around the 64 byte folding minimum and its 16 byte tail
+    std::mt19937 rng(11);
+    std::vector<uint8_t> buffer(70000);
+    for (auto & c : buffer) {
+        c = static_cast<uint8_t>(rng());
+    }
+    for (size_t offset = 0; offset < 9; ++offset) {
+        for (size_t size : {0, 1, 7, 8, 15, 16, 63, 64, 65, 79, 80, 127, 128, 129, 1000, 4096, 65537}) {
+            const uint8_t * p = buffer.data() + offset;
+            EXPECT_EQ(top::utl::crc32_software(0, p, size), top::utl::crc32(0, p, size)) << "size " << size << " offset " << offset;
+            EXPECT_EQ(top::utl::crc32c_software(0, p, size), top::utl::crc32c(0, p, size)) << "size " << size << " offset " << offset;
+        }
+    }
+}
+
+TEST(xchecksum, streaming) {
+    std::vector<uint8_t> buffer(5000);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<uint8_t>(i * 31);
+    }
+    uint32_t crc = 0;
+    uint32_t crcc = 0;
+    for (size_t done = 0, step = 1; done < buffer.size(); done += step, step = step * 2 + 3) {
+        const size_t size = std::min(step, buffer.size() - done);
+        crc = top::utl::crc32(crc, buffer.data() + done, size);
+        crcc = top::utl::crc32c(crcc, buffer.data() + done, size);
+    }
+    EXPECT_EQ(top::utl::crc32(0, buffer.data(), buffer.size()), crc);
+    EXPECT_EQ(top::utl::crc32c(0, buffer.data(), buffer.size()), crcc);
+}
+
+TEST(xchecksum, benchmark) {
+    std::vector<uint8_t> buffer(64 * 1024, 0x5A);
+    const int rounds = 2000;
+    auto run = [&](const char * name, uint32_t (*f)(uint32_t, const void *, size_t)) {
+        uint32_t crc = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            crc = f(crc, buffer.data(), buffer.size());
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+        double const gbps = static_cast<double>(buffer.size()) * rounds / (us > 0 ? us : 1) / 1000.0;
+        std::printf("%-24s %8ld us  %6.2f GB/s  crc %08x\n", name, static_cast<long>(us), gbps, crc);
+    };
+    std::printf("crc32 uses %s, crc32c uses %s\n", top::utl::crc32_implementation(), top::utl::crc32c_implementation());
+    run("crc32 slicing-by-8", top::utl::crc32_software);
+    run("crc32 dispatched", top::utl::crc32);
+    run("crc32c slicing-by-8", top::utl::crc32c_software);
+    run("crc32c dispatched", top::utl::crc32c);
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+
+#include <cstddef>
+#include <cstdint>
+
+NS_BEG2(top, utl)
+
+/// crc32 of the ieee polynomial, the same value as zlib's crc32(crc, data, size).
+/// crc is the value of the bytes before data, 0 to start. the implementation is picked at the first call,
+/// pclmulqdq folding on x86 cpus having it and slicing-by-8 otherwise.
+uint32_t crc32(uint32_t crc, const void * data, size_t size);
+
+/// crc32c of the castagnoli polynomial (iscsi, ext4), not compatible with crc32 above.
+/// uses the sse4.2 crc32 instruction when the cpu has it and slicing-by-8 otherwise.
+uint32_t crc32c(uint32_t crc, const void * data, size_t size);
+
+/// names of the implementations picked on this cpu, for logs and benchmarks
+const char * crc32_implementation();
+const char * crc32c_implementation();
+
+/// the portable paths, always available, for tests and benchmarks against the accelerated ones
+uint32_t crc32_software(uint32_t crc, const void * data, size_t size);
+uint32_t crc32c_software(uint32_t crc, const void * data, size_t size);
+
+NS_END2
@@ -273,6 +273,10 @@ class xkeccak256_t : public xhash_t
 public:
     static uint256_t  digest(const void* data, size_t numBytes);
     static uint256_t  digest(const std::string & text);
+    //hash without allocating a context, output must hold 32 bytes
+    static void       digest_once(const void* data, size_t numBytes, uint8_t output[32]);
+    //hash count independent messages, output i is written to outputs + 32 * i. four lanes at a time on avx2 cpus
+    static void       digest_batch(size_t count, const uint8_t * const * datas, const size_t * sizes, uint8_t * outputs);
 public:
     xkeccak256_t();
     ~xkeccak256_t();
@@ -4,17 +4,21 @@
 #include "xverifier/xtx_verifier.h"
 
 #include "xbase/xutl.h"
+#include "xbasic/xsharded_lru_cache.h"
 #include "xbasic/xmodule_type.h"
+#include "xbasic/xthreading/xparallel_pool.h"
 #include "xchain_fork/xchain_upgrade_center.h"
 #include "xdata/xgenesis_data.h"
 #include "xdata/xnative_contract_address.h"
 #include "xdata/xsystem_contract/xdata_structures.h"
+#include "xmetrics/xmetrics.h"
 #include "xverifier/xverifier_utl.h"
 #include "xverifier/xwhitelist_verifier.h"
 #include "xverifier/xblacklist_verifier.h"
 #include "xvledger/xvblock.h"
 #include "xstatestore/xstatestore_face.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 NS_BEG2(top, xverifier)
@@ -139,13 +143,35 @@ data::system_contract::xreg_node_info get_reg_info(common::xaccount_address_t co
     return node_info;
 }
 
+enum {
+    enum_verified_signature_cache_max = 32768,
+    enum_batch_verify_min_txs = 8,
+    enum_batch_verify_max_threads = 4,
+};
+
+// a tx is usually verified several times on one node: relayed by several peers, pushed to txpool, and packed by leader then verified by backups.
+// keyed by digest together with authorization, so a tx carrying another signature is verified again.
+static basic::xsharded_lru_cache<std::string, bool> & verified_signature_cache() {
+    static basic::xsharded_lru_cache<std::string, bool> cache(enum_verified_signature_cache_max);
+    return cache;
+}
+
 int32_t xtx_verifier::verify_tx_signature(data::xtransaction_t const * trx) {
     // verify signature
     if (!data::is_sys_contract_address(common::xaccount_address_t{trx->get_source_addr()}) /*&& !data::is_user_contract_address(common::xaccount_address_t{trx->get_source_addr()})*/) {
         bool check_success = false;
         if (trx->get_target_addr() != sys_contract_rec_standby_pool_addr) {
             xdbg("[global_trace][xtx_verifier][verify_tx_signature][sign_check], tx:%s", trx->dump().c_str());
-            check_success = trx->sign_check();
+            std::string cache_key = trx->get_digest_str() + trx->get_authorization();
+            if (verified_signature_cache().exist(cache_key)) {
+                XMETRICS_GAUGE(metrics::txpool_tx_signature_cache_hit, 1);
+                check_success = true;
+            } else {
+                check_success = trx->sign_check();
+                if (check_success) {
+                    verified_signature_cache().put(cache_key, true);
+                }
+            }
         } else {
 #ifdef XENABLE_MOCK_ZEC_STAKE
             check_success = true;
@@ -170,6 +196,13 @@ int32_t xtx_verifier::verify_tx_signature(data::xtransaction_t const * trx) {
     return xverifier_error::xverifier_success;
 }
 
+void xtx_verifier::verify_txs_signature(std::vector<data::xtransaction_t const *> const & txs, std::vector<int32_t> & results) {
+    results.assign(txs.size(), xverifier_error::xverifier_success);
+    size_t const thread_count = std::min<size_t>((size_t)enum_batch_verify_max_threads, txs.size() / enum_batch_verify_min_txs);
+    // secp256k1 verify context is only read by verification, so all threads of the shared pool use it.
+    threading::xparallel_pool_t::instance().run(txs.size(), thread_count, [&](std::size_t i) { results[i] = verify_tx_signature(txs[i]); });
+}
+
 // verify trx fire expiration
 int32_t xtx_verifier::verify_tx_fire_expiration(data::xtransaction_t const * trx, uint64_t now, bool is_first_time_push_tx) {
     uint32_t trx_fire_tolerance_time = XGET_ONCHAIN_GOVERNANCE_PARAMETER(tx_send_timestamp_tolerance);
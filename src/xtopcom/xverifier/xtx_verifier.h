@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "xdata/xtransaction.h"
 #include "xconfig/xconfig_register.h"
 #include "xbasic/xmemory.hpp"
@@ -23,6 +24,14 @@ public:
      */
     static int32_t verify_tx_signature(data::xtransaction_t const * trx);
 
+    /**
+     * @brief  verify sigatures of a batch of transactions in parallel, the same as verify_tx_signature one by one
+     *
+     * @param txs  the transactions to verify
+     * @param results  result of each transaction, see xverifier_errors definition
+     */
+    static void verify_txs_signature(std::vector<data::xtransaction_t const *> const & txs, std::vector<int32_t> & results);
+
     /**
      * @brief verify address whether valid
      *
@@ -1543,6 +1543,8 @@ namespace top
         
         xvblock_t & xvblock_t::operator = (const xvblock_t & other)
         {
+            if(other.m_lazy_body_pending.load(std::memory_order_acquire))
+                other.decode_lazy_body(); //copy share the decoded input and output
             if(m_vheader_ptr != NULL)
                 m_vheader_ptr->release_ref();
             if(m_vqcert_ptr != NULL)
@@ -1884,13 +1886,43 @@ namespace top
     
         xvinput_t *  xvblock_t::get_input() const
         {
+            if(m_lazy_body_pending.load(std::memory_order_acquire))
+                decode_lazy_body();
             return m_vinput_ptr;
         }
     
         xvoutput_t*  xvblock_t::get_output() const
         {
+            if(m_lazy_body_pending.load(std::memory_order_acquire))
+                decode_lazy_body();
             return m_voutput_ptr;
         }
+
+        void  xvblock_t::decode_lazy_body() const
+        {
+            std::lock_guard<std::mutex> locker(m_lazy_body_lock);
+            if(false == m_lazy_body_pending.load(std::memory_order_relaxed)) //decoded by other thread
+                return;
+
+            //bytes have passed hash check at do_read,so decode failure means bug instead of bad data
+            xvinput_t*  vinput_ptr = xvblock_t::create_input_object(m_lazy_input_bin);
+            if(NULL == vinput_ptr)
+            {
+                xerror("xvblock_t::decode_lazy_body,fail to decode input of block(%s)",dump().c_str());
+                vinput_ptr = new xvinput_t();
+            }
+            xvoutput_t* voutput_ptr = xvblock_t::create_output_object(m_lazy_output_bin);
+            if(NULL == voutput_ptr)
+            {
+                xerror("xvblock_t::decode_lazy_body,fail to decode output of block(%s)",dump().c_str());
+                voutput_ptr = new xvoutput_t();
+            }
+            m_vinput_ptr  = vinput_ptr;
+            m_voutput_ptr = voutput_ptr;
+            std::string().swap(m_lazy_input_bin);
+            std::string().swap(m_lazy_output_bin);
+            m_lazy_body_pending.store(false, std::memory_order_release);
+        }
         
         const std::string xvblock_t::get_fullstate_hash()
         {
@@ -2313,6 +2345,8 @@ namespace top
             return xdataobj_t::serialize_from(stream);
         }
         
+        static thread_local bool t_lazy_body_read = false; //set by create_block_object for do_read at same thread
+
         //only just store m_vblock_header_path , m_vblock_body_path and related managed-purpose information
         int32_t  xvblock_t::do_write(xstream_t & stream)
         {
@@ -2329,6 +2363,16 @@ namespace top
             stream.write_compact_var(vqcert_bin);
         
             stream.write_compact_var(vheader_bin);
+            if( (get_block_class() != enum_xvblock_class_nil) && m_lazy_body_pending.load(std::memory_order_acquire) )
+            {
+                std::lock_guard<std::mutex> locker(m_lazy_body_lock);
+                if(m_lazy_body_pending.load(std::memory_order_relaxed)) //write the same bytes as read,without decode
+                {
+                    stream.write_compact_var(m_lazy_input_bin);
+                    stream.write_compact_var(m_lazy_output_bin);
+                    return (stream.size() - begin_size);
+                }
+            }
             if(get_block_class() != enum_xvblock_class_nil)
             {
                 std::string vinput_bin;
@@ -2388,6 +2432,9 @@ namespace top
                 m_voutput_ptr->release_ref();
                 m_voutput_ptr = NULL;
             }
+            m_lazy_body_pending.store(false, std::memory_order_release);
+            std::string().swap(m_lazy_input_bin);
+            std::string().swap(m_lazy_output_bin);
             
             //start read hash
             const int32_t begin_size = stream.size();
@@ -2487,6 +2534,13 @@ namespace top
             }
             
             //------------------------------create input/output object------------------------------//
+            if( t_lazy_body_read && (vinput_bin.empty() == false) && (voutput_bin.empty() == false) )
+            {
+                m_lazy_input_bin.swap(vinput_bin);
+                m_lazy_output_bin.swap(voutput_bin);
+                m_lazy_body_pending.store(true, std::memory_order_release);
+                return (begin_size - stream.size());
+            }
             if(vinput_bin.empty() == false)
             {
                 xvinput_t*  vinput_ptr = xvblock_t::create_input_object(vinput_bin);
@@ -2721,11 +2775,23 @@ namespace top
         //create a  xvheader_t from bin data(could be from DB or from network)
         base::xvblock_t*  xvblock_t::create_block_object(const std::string & vblock_serialized_data)
         {
-            if(vblock_serialized_data.empty()) //check first
+            return create_block_object(vblock_serialized_data.data(), vblock_serialized_data.size());
+        }
+        
+        base::xvblock_t*  xvblock_t::create_block_object(const char* vblock_serialized_data, const size_t data_size)
+        {
+            return create_block_object(vblock_serialized_data, data_size, false);
+        }
+
+        base::xvblock_t*  xvblock_t::create_block_object(const char* vblock_serialized_data, const size_t data_size, bool lazy_body)
+        {
+            if((NULL == vblock_serialized_data) || (0 == data_size)) //check first
                 return NULL;
             
-            xstream_t _stream(xcontext_t::instance(),(uint8_t*)vblock_serialized_data.data(),(uint32_t)vblock_serialized_data.size());
+            xstream_t _stream(xcontext_t::instance(),(uint8_t*)vblock_serialized_data,(uint32_t)data_size);
+            t_lazy_body_read = lazy_body; //do_read has no parameter,pass mode by thread
             xdataunit_t*  _data_obj_ptr = xdataunit_t::read_from(_stream);
+            t_lazy_body_read = false;
             if(NULL == _data_obj_ptr)
             {
                 xerror("xvblock_t::create_block_object,bad vblock_serialized_data that not follow spec");
@@ -2745,7 +2811,7 @@ namespace top
                 _data_obj_ptr->release_ref();
                 return NULL;
             }
-            if((block_ptr->get_input() == NULL) || (block_ptr->get_output() == NULL) )
+            if( block_ptr->is_body_decoded() && ((block_ptr->get_input() == NULL) || (block_ptr->get_output() == NULL)) )
             {
                 xerror("xvblock_t::create_block_object,bad vblock_serialized_data");
                 _data_obj_ptr->release_ref();
@@ -3,6 +3,7 @@
 // Licensed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <cinttypes>
 #include "xbase/xutl.h"
 #include "xbase/xcontext.h"
@@ -326,6 +327,16 @@ namespace top
             return _records;
         }
 
+        std::deque<xvmethod_t>  xvcanvas_t::clone(size_t from_height,size_t to_height)
+        {
+            std::lock_guard<std::recursive_mutex> locker(m_lock);
+            std::deque<xvmethod_t> _records;
+            to_height = std::min(to_height,m_records.size());
+            if(from_height < to_height)
+                _records.insert(_records.end(),m_records.begin() + from_height,m_records.begin() + to_height);
+            return _records;
+        }
+
         const int  xvcanvas_t::encode(xstream_t & output_bin,const int compile_options)
         {
             std::lock_guard<std::recursive_mutex> locker(m_lock);
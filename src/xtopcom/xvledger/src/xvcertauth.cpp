@@ -17,5 +17,32 @@ namespace top
         xvcertauth_t::~xvcertauth_t()
         {
         }
+
+        void  xvcertauth_t::verify_signs(const std::vector<xvip2_t> & signers,const std::vector<const xvqcert_t*> & test_for_certs,
+                                         const std::string & block_account,std::vector<enum_vcert_auth_result> & results)
+        {
+            results.assign(signers.size(),enum_vcert_auth_result::enum_bad_cert);
+            if(test_for_certs.size() != signers.size())
+                return;
+
+            for(size_t i = 0; i < signers.size(); ++i)
+                results[i] = verify_sign(signers[i],test_for_certs[i],block_account);
+        }
+
+        const std::string  xvcertauth_t::merge_muti_sign(const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const xvblock_t * for_block)
+        {
+            if(NULL == for_block)
+                return std::string();
+
+            #ifndef DEBUG //add protection at release mode first
+            if( (for_block->check_block_flag(enum_xvblock_flag_authenticated))
+               ||(for_block->get_cert_hash().empty() == false) ) //should not set any those before verify_sign
+            {
+                xerror("xvcertauth_t::merge_muti_sign,fail-bad status for block:%s",for_block->dump().c_str());
+                return std::string();
+            }
+            #endif
+            return merge_muti_sign(muti_nodes,muti_signatures,for_block->get_cert());
+        }
     };//end of namespace of base
 };//end of namespace of top
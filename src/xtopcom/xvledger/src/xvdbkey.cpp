@@ -167,11 +167,24 @@ namespace top
         }
         
         const std::string  xvdbkey_t::create_prunable_state_key(const xvaccount_t & account,const uint64_t target_height,const std::string & block_hash)
+        {
+            // state key should be different with block key, because of batch_delete policy
+            const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + block_hash + "/t";//t for table state
+            return key_path;
+        }
+
+        const std::string  xvdbkey_t::create_prunable_state_key_old(const xvaccount_t & account,const uint64_t target_height,const std::string & block_hash)
         {
             //enum_xdb_cf_type_read_most = 's'
             const std::string key_path = "r/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + block_hash + "/s";//a for state
             return key_path;
         }
+
+        const std::string  xvdbkey_t::create_prunable_state_height_key(const xvaccount_t & account,const uint64_t target_height)
+        {
+            const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/";
+            return key_path;
+        }
     
         const std::string xvdbkey_t::create_prunable_unit_state_key(const xvaccount_t & account, uint64_t target_height,std::string const& block_hash)
         {
@@ -179,6 +192,11 @@ namespace top
             const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + block_hash + "/u";
             return key_path;            
         }
+        const std::string xvdbkey_t::create_prunable_unit_state_delta_key(const xvaccount_t & account, uint64_t target_height,std::string const& block_hash)
+        {
+            const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + block_hash + "/d";
+            return key_path;
+        }
         const std::string  xvdbkey_t::create_prunable_unit_state_height_key(const xvaccount_t & account,const uint64_t target_height)
         {
             const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/";
@@ -250,6 +268,12 @@ namespace top
         }
 
         const std::string  xvdbkey_t::create_prunable_block_output_offdata_key(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid)
+        {
+            const std::string key_path = "s/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + xstring_utl::uint642hex(target_viewid) + "/f";
+            return key_path;
+        }
+
+        const std::string  xvdbkey_t::create_prunable_block_output_offdata_key_old(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid)
         {
             const std::string key_path = "r/" + account.get_storage_key() + "/" + uint64_to_full_hex(target_height) + "/" + xstring_utl::uint642hex(target_viewid) + "/f";
             return key_path;
@@ -278,6 +302,21 @@ namespace top
             auto const key_path = prefix + key + "/m";
             return key_path;
         }
+        const std::string xvdbkey_t::create_mpt_snapshot_account_key(const std::string & prefix, const std::string & account)
+        {
+            const std::string key_path = prefix + "a/" + account + "/n";
+            return key_path;
+        }
+        const std::string xvdbkey_t::create_mpt_snapshot_root_key(const std::string & prefix)
+        {
+            const std::string key_path = prefix + "r/n";
+            return key_path;
+        }
+        const std::string xvdbkey_t::create_mpt_snapshot_diff_key(const std::string & prefix, const std::string & root)
+        {
+            const std::string key_path = prefix + "d/" + root + "/n";
+            return key_path;
+        }
         enum_xdbkey_type xvdbkey_t::get_dbkey_type_v2(const std::string & key, const char first_char, const char last_char, const int key_length) {
             struct xvdbkey_first_last_char_type_t
             {
@@ -293,7 +332,11 @@ namespace top
                 {enum_xdbkey_type_relaytx_index,        'f', 'l'},
 
                 {enum_xdbkey_type_unitstate_v2,         's', 'u'},
+                {enum_xdbkey_type_unitstate_v2,         's', 'd'},
                 {enum_xdbkey_type_mptnode,              's', 'm'},
+                {enum_xdbkey_type_mpt_snapshot,         's', 'n'},
+                {enum_xdbkey_type_state_object,         's', 't'},
+                {enum_xdbkey_type_block_out_offdata,    's', 'f'},
 
                 {enum_xdbkey_type_account_span,         'r', 'a'},
                 {enum_xdbkey_type_block_object,         'r', 'b'},
@@ -394,7 +437,7 @@ namespace top
         {
             static std::string key_name_array[enum_xdbkey_type_max] = {"unknow", "keyvalue", "block_index", "block_object",
                             "state_object", "account_meta", "account_span", "transaction", "input_resource",
-                            "output_resource",  "span_height", "unit_proof", "out_offdata", "trelayx_index", "unitstate_v2", "mptnode"};
+                            "output_resource",  "span_height", "unit_proof", "out_offdata", "trelayx_index", "unitstate_v2", "mptnode", "mpt_snapshot"};
             if (type >= enum_xdbkey_type_max) {
                 return "unknow_2";
             }
@@ -299,6 +299,7 @@ namespace top
                 child->set_parent_unit(this); //setup execution uri and parent ptr first
                 m_child_units[child->get_unit_name()] = child;//copy ptr,the above code did add_ref already
             }
+            on_child_unit_changed(child->get_unit_name(),child);
             return true;
         }
     
@@ -309,6 +310,7 @@ namespace top
             auto it = m_child_units.find(unit_name);
             if(it != m_child_units.end())
             {
+                on_child_unit_changed(unit_name,nullptr);
                 it->second->set_parent_unit(NULL);
                 it->second->release_ref();
                 m_child_units.erase(it);
@@ -1629,10 +1629,11 @@ namespace top
             }
         }
 
-        void    xvchain_t::get_db_config_custom(std::vector<db::xdb_path_t> &extra_db_path, int &extra_db_kind)
+        void    xvchain_t::get_db_config_custom(std::vector<db::xdb_path_t> &extra_db_path, int &extra_db_kind, db::xdb_options_t &extra_db_options)
         {
             int db_kind = top::db::xdb_kind_kvdb;
             std::vector<db::xdb_path_t> db_data_paths;
+            db::xdb_options_t db_options;
             std::string extra_config = get_data_dir_path();
             if(extra_config.empty()) {
                 extra_config = ".extra_conf.json"; 
@@ -1660,6 +1661,10 @@ namespace top
                 } else if (db_compress == "bottom_compress" ) {
                     db_kind |= top::db::xdb_kind_bottom_compress;
                 }
+                //get db type,memory db is for devnet & benchmark without any disk io
+                if (key_info_js["db_type"].asString() == "mem") {
+                    db_kind = (db_kind & ~0x0F) | top::db::xdb_kind_mem;
+                }
                 //get db path
                 if (key_info_js["db_path_num"] > 1) {   
                     int db_path_num  = key_info_js["db_path_num"].asInt();
@@ -1677,9 +1682,77 @@ namespace top
                         db_data_paths.emplace_back(db_path_result, db_size_result);
                     }
                 }
+                //get total budget(MB) of block cache shared by all CFs
+                if (key_info_js.isMember("db_block_cache_mb")) {
+                    const uint64_t block_cache_mb = key_info_js["db_block_cache_mb"].asUInt64();
+                    db_options.block_cache_size = block_cache_mb << 20;
+                    xinfo("xvchain_t::read db block cache size %llu MB", block_cache_mb);
+                }
+                //get WAL sync policy of async writes
+                if (key_info_js.isMember("db_async_write_sync")) {
+                    db_options.async_write_sync = key_info_js["db_async_write_sync"].asBool();
+                }
+                if (key_info_js.isMember("db_wal_sync_interval_ms")) {
+                    db_options.wal_sync_interval_ms = key_info_js["db_wal_sync_interval_ms"].asUInt();
+                }
+                if (key_info_js.isMember("db_prefix_bloom_filter")) {
+                    db_options.prefix_bloom_filter = key_info_js["db_prefix_bloom_filter"].asBool();
+                }
+                if (key_info_js.isMember("db_cf_routing_by_key_type")) {
+                    db_options.cf_routing_by_key_type = key_info_js["db_cf_routing_by_key_type"].asBool();
+                }
+                if (key_info_js.isMember("db_blob_files")) {
+                    db_options.blob_files = key_info_js["db_blob_files"].asBool();
+                }
+                if (key_info_js.isMember("db_min_blob_size")) {
+                    db_options.min_blob_size = key_info_js["db_min_blob_size"].asUInt64();
+                }
+                if (key_info_js.isMember("db_blob_gc")) {
+                    db_options.blob_gc = key_info_js["db_blob_gc"].asBool();
+                }
+                if (key_info_js.isMember("db_blob_gc_age_cutoff")) {
+                    db_options.blob_gc_age_cutoff = key_info_js["db_blob_gc_age_cutoff"].asDouble();
+                }
+                if (key_info_js.isMember("db_cold_path")) {
+                    db_options.cold_db_path = key_info_js["db_cold_path"].asString();
+                }
+                if (key_info_js.isMember("db_cold_block_height_gap")) {
+                    db_options.cold_block_height_gap = key_info_js["db_cold_block_height_gap"].asUInt64();
+                }
+                if (key_info_js.isMember("db_statistics")) {
+                    db_options.statistics = key_info_js["db_statistics"].asBool();
+                }
+                if (key_info_js.isMember("db_statistics_interval_sec")) {
+                    db_options.statistics_interval_sec = key_info_js["db_statistics_interval_sec"].asUInt();
+                }
+                if (key_info_js.isMember("db_slow_op_threshold_ms")) {
+                    db_options.slow_op_threshold_ms = key_info_js["db_slow_op_threshold_ms"].asUInt();
+                }
+                if (key_info_js.isMember("db_zstd_dict_bytes")) {
+                    db_options.zstd_dict_bytes = key_info_js["db_zstd_dict_bytes"].asUInt();
+                }
+                if (key_info_js.isMember("db_zstd_dict_train_ratio")) {
+                    db_options.zstd_dict_train_ratio = key_info_js["db_zstd_dict_train_ratio"].asUInt();
+                }
+                if (key_info_js.isMember("db_direct_io_for_flush_and_compaction")) {
+                    db_options.direct_io_for_flush_and_compaction = key_info_js["db_direct_io_for_flush_and_compaction"].asBool();
+                }
+                if (key_info_js.isMember("db_direct_reads")) {
+                    db_options.direct_reads = key_info_js["db_direct_reads"].asBool();
+                }
+                if (key_info_js.isMember("db_compaction_readahead_size")) {
+                    db_options.compaction_readahead_size = key_info_js["db_compaction_readahead_size"].asUInt64();
+                }
+                if (key_info_js.isMember("db_compaction_rate_limit_mb")) {
+                    db_options.compaction_rate_limit_mb = key_info_js["db_compaction_rate_limit_mb"].asUInt();
+                }
+                if (key_info_js.isMember("db_io_uring_multiread")) {
+                    db_options.io_uring_multiread = key_info_js["db_io_uring_multiread"].asBool();
+                }
             }
             extra_db_path = db_data_paths;
             extra_db_kind = db_kind;
+            extra_db_options = db_options;
         }
 
     };//end of namespace of base
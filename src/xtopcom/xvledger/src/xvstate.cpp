@@ -55,6 +55,7 @@ namespace top
             :xvexegroup_t(type),
              xvaccount_t()
         {
+            memset(m_native_units,0,sizeof(m_native_units));
             XMETRICS_GAUGE_DATAOBJECT(metrics::dataobject_xvexestate_t, 1);
             //then register execution methods
             REGISTER_XVIFUNC_ID_API(enum_xvinstruct_class_state_function);
@@ -64,6 +65,7 @@ namespace top
             :xvexegroup_t(type),
              xvaccount_t(account_addr)
         {
+            memset(m_native_units,0,sizeof(m_native_units));
             XMETRICS_GAUGE_DATAOBJECT(metrics::dataobject_xvexestate_t, 1);
             //then register execution methods
             REGISTER_XVIFUNC_ID_API(enum_xvinstruct_class_state_function);
@@ -73,6 +75,11 @@ namespace top
             :xvexegroup_t(obj),
              xvaccount_t(obj.get_address())
         {
+            //units cloned by xvexegroup_t before this object is constructed
+            memset(m_native_units,0,sizeof(m_native_units));
+            for(auto & it : get_child_units())
+                on_child_unit_changed(it.first,it.second);
+            
             XMETRICS_GAUGE_DATAOBJECT(metrics::dataobject_xvexestate_t, 1);
             //then register execution methods
             REGISTER_XVIFUNC_ID_API(enum_xvinstruct_class_state_function);
@@ -89,6 +96,48 @@ namespace top
             return clone_units_from(source);
         }
     
+        bool    xvexestate_t::get_property_of_instruction(const xvmethod_t & op,std::string & property_name) const
+        {
+            const std::string & target_execution_uri = op.get_method_uri();
+            const std::string & this_execution_uri = get_execute_uri();
+            if(target_execution_uri == this_execution_uri) //state function,property name is always the first parameter
+            {
+                if(op.get_method_type() != enum_xvinstruct_class_state_function)
+                    return false;
+                if(op.get_params_count() < 1)
+                    return false;
+                property_name = op.get_method_params().at(0).get_string();
+                return (property_name.empty() == false);
+            }
+            //same as xvexegroup_t::execute,uri of property function is [state uri]/[property name]
+            if( (target_execution_uri.size() <= this_execution_uri.size() + 1) || (target_execution_uri.find(this_execution_uri) != 0) )
+                return false;
+            
+            const std::string left_path = target_execution_uri.substr(this_execution_uri.size() + 1);//skip '/'
+            property_name = left_path.substr(0,left_path.find_first_of('/'));
+            return (property_name.empty() == false);
+        }
+    
+        bool    xvexestate_t::restore_property_from(const xvexestate_t & source,const std::string & property_name)
+        {
+            std::lock_guard<std::recursive_mutex> locker(get_mutex());
+            
+            xvexeunit_t * source_unit = source.find_child_unit(property_name);
+            if(nullptr == source_unit)
+            {
+                remove_child_unit(property_name);
+                return true;
+            }
+            xvexeunit_t * clone_unit = source_unit->clone();
+            xassert(clone_unit != nullptr);
+            if(nullptr == clone_unit)
+                return false;
+            
+            add_child_unit(clone_unit);//replace existing one
+            clone_unit->release_ref();
+            return true;
+        }
+    
         bool    xvexestate_t::take_snapshot(std::string & to_full_state_bin)
         {
             auto canvas  = rebase_change_to_snapshot();
@@ -127,6 +176,154 @@ namespace top
             return new_canvas;
         }
   
+        //entries of new_ptr that differ from base_ptr,both are map<string,string> properties
+        static bool record_delta_of_string_map(xvproperty_t * base_ptr,xvproperty_t * new_ptr,xvcanvas_t * canvas)
+        {
+            const std::map<std::string,std::string>* base_map = base_ptr->get_value().get_map<std::string>();
+            const std::map<std::string,std::string>* new_map = new_ptr->get_value().get_map<std::string>();
+            if( (base_map == nullptr) || (new_map == nullptr) )
+                return false;
+            
+            const std::string & target_uri = new_ptr->get_execute_uri();
+            for(auto & item : *new_map)
+            {
+                auto base_it = base_map->find(item.first);
+                if( (base_it != base_map->end()) && (base_it->second == item.second) )
+                    continue;
+                
+                xvalue_t new_key(item.first);
+                xvalue_t new_value(item.second);
+                xvmethod_t instruction(target_uri,enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_map_insert,new_key,new_value);
+                if(false == canvas->record(instruction))
+                    return false;
+            }
+            for(auto & item : *base_map)
+            {
+                if(new_map->find(item.first) != new_map->end())
+                    continue;
+                
+                xvalue_t target_key(item.first);
+                xvmethod_t instruction(target_uri,enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_map_erase,target_key);
+                if(false == canvas->record(instruction))
+                    return false;
+            }
+            return true;
+        }
+    
+        //entries of new_ptr that differ from base_ptr,both are hashmap properties. false when it can not be expressed by entries,
+        //as a key with empty fields which insert and erase can not leave
+        static bool record_delta_of_hashmap(xvproperty_t * base_ptr,xvproperty_t * new_ptr,xvcanvas_t * canvas)
+        {
+            auto base_map = base_ptr->get_value().get_hashmap();
+            auto new_map = new_ptr->get_value().get_hashmap();
+            if( (base_map == nullptr) || (new_map == nullptr) )
+                return false;
+            
+            for(auto & item : *new_map)
+            {
+                if(item.second.empty())
+                    return false;
+            }
+            
+            const std::string & target_uri = new_ptr->get_execute_uri();
+            for(auto & item : *new_map)
+            {
+                auto base_it = base_map->find(item.first);
+                for(auto & field : item.second)
+                {
+                    if(base_it != base_map->end())
+                    {
+                        auto base_field = base_it->second.find(field.first);
+                        if( (base_field != base_it->second.end()) && (base_field->second == field.second) )
+                            continue;
+                    }
+                    xvalue_t new_key(item.first);
+                    xvalue_t new_field(field.first);
+                    xvalue_t new_value(field.second);
+                    xvmethod_t instruction(target_uri,enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_hashmap_insert,new_key,new_field,new_value);
+                    if(false == canvas->record(instruction))
+                        return false;
+                }
+                if(base_it == base_map->end())
+                    continue;
+                
+                for(auto & base_field : base_it->second)
+                {
+                    if(item.second.find(base_field.first) != item.second.end())
+                        continue;
+                    
+                    xvalue_t target_key(item.first);
+                    xvalue_t target_field(base_field.first);
+                    xvmethod_t instruction(target_uri,enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_hashmap_erase,target_key,target_field);
+                    if(false == canvas->record(instruction))
+                        return false;
+                }
+            }
+            for(auto & item : *base_map)
+            {
+                if(new_map->find(item.first) != new_map->end())
+                    continue;
+                
+                xvalue_t target_key(item.first);
+                xvmethod_t instruction(target_uri,enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_hashmap_erase,target_key);
+                if(false == canvas->record(instruction))
+                    return false;
+            }
+            return true;
+        }
+    
+        xauto_ptr<xvcanvas_t>  xvexestate_t::rebase_change_to_delta(xvexestate_t & base_state)
+        {
+            std::lock_guard<std::recursive_mutex> locker(get_mutex());
+            std::lock_guard<std::recursive_mutex> base_locker(base_state.get_mutex());
+            
+            xvcanvas_t* new_canvas = new xvcanvas_t();
+            const std::map<std::string,xvexeunit_t*> & all_units = get_child_units();
+            for(auto & it : all_units)
+            {
+                xvproperty_t * property_ptr = (xvproperty_t*)it.second;
+                xvproperty_t * base_ptr = (xvproperty_t*)base_state.find_child_unit(it.first);
+                if( (base_ptr != nullptr) && (base_ptr->get_obj_type() == property_ptr->get_obj_type()) )
+                {
+                    //records of a failed entry delta are overwritten by the renew below
+                    if( (property_ptr->get_obj_type() == xmapvar_t<std::string>::query_obj_type()) && record_delta_of_string_map(base_ptr,property_ptr,new_canvas) )
+                        continue;
+                    if( (property_ptr->get_obj_type() == enum_xobject_type_vprop_hashmap) && record_delta_of_hashmap(base_ptr,property_ptr,new_canvas) )
+                        continue;
+                    
+                    std::string base_bin;
+                    std::string property_bin;
+                    base_ptr->serialize_to_string(base_bin);
+                    property_ptr->serialize_to_string(property_bin);
+                    if(base_bin == property_bin)
+                        continue;
+                }
+                
+                xvmethod_t instruction(renew_property_instruction(property_ptr->get_name(),property_ptr->get_obj_type(),property_ptr->get_value()));
+                if(false == new_canvas->record(instruction))
+                {
+                    xerror("xvexestate_t::rebase_change_to_delta,abort as property fail to take delta,propery(%s)",it.second->dump().c_str());
+                    new_canvas->release_ref();
+                    return nullptr;
+                }
+            }
+            for(auto & it : base_state.get_child_units())
+            {
+                if(find_child_unit(it.first) != nullptr)
+                    continue;
+                
+                xvalue_t param_pname(it.first);
+                xvmethod_t instruction(get_execute_uri(),enum_xvinstruct_class_state_function,enum_xvinstruct_state_method_del_property,param_pname);
+                if(false == new_canvas->record(instruction))
+                {
+                    xerror("xvexestate_t::rebase_change_to_delta,abort as fail to record del of propery(%s)",it.first.c_str());
+                    new_canvas->release_ref();
+                    return nullptr;
+                }
+            }
+            return new_canvas;
+        }
+  
         std::string  xvexestate_t::get_property_value(const std::string & name)
         {
             std::lock_guard<std::recursive_mutex> locker(get_mutex());
@@ -139,8 +336,60 @@ namespace top
             return bin_data;
         }
         
+        enum_xvstate_native_property  xvexestate_t::get_native_property_slot(const std::string & name)
+        {
+            //native names are "$" + one or two chars,decode by chars instead of comparing strings
+            if( (name.size() < 2) || (name.size() > 3) || (name[0] != '$') )
+                return enum_xvstate_native_property_max;
+            
+            if(name.size() == 2)
+            {
+                switch(name[1])
+                {
+                    case '0': return enum_xvstate_native_property_balance;
+                    case 'a': return enum_xvstate_native_property_burn_balance;
+                    case 'b': return enum_xvstate_native_property_lock_balance;
+                    case 'c': return enum_xvstate_native_property_tgas_balance;
+                    case 'd': return enum_xvstate_native_property_vote_balance;
+                    default:  return enum_xvstate_native_property_max;
+                }
+            }
+            if(name[1] != '0')
+                return enum_xvstate_native_property_max;
+            
+            switch(name[2])
+            {
+                case '0': return enum_xvstate_native_property_lock_tgas;
+                case '1': return enum_xvstate_native_property_used_tgas;
+                case '2': return enum_xvstate_native_property_last_tx_hour;
+                case '6': return enum_xvstate_native_property_tx_info;
+                case '8': return enum_xvstate_native_property_lock_token;
+                default:  return enum_xvstate_native_property_max;
+            }
+        }
+    
+        void  xvexestate_t::on_child_unit_changed(const std::string & unit_name,xvexeunit_t * unit)
+        {
+            const enum_xvstate_native_property slot = get_native_property_slot(unit_name);
+            if(slot != enum_xvstate_native_property_max)
+                m_native_units[slot] = unit;
+        }
+    
+        xvproperty_t*   xvexestate_t::get_property_object(enum_xvstate_native_property slot) const
+        {
+            if( (slot < 0) || (slot >= enum_xvstate_native_property_max) )
+                return nullptr;
+            
+            std::lock_guard<std::recursive_mutex> locker(get_mutex());
+            return (xvproperty_t*)m_native_units[slot];
+        }
+    
         xvproperty_t*   xvexestate_t::get_property_object(const std::string & name) const
         {
+            const enum_xvstate_native_property slot = get_native_property_slot(name);
+            if(slot != enum_xvstate_native_property_max)
+                return get_property_object(slot);
+            
             xvexeunit_t * target = find_child_unit(name);
             if(target != nullptr)
                 return (xvproperty_t*)target;
@@ -1180,6 +1429,106 @@ namespace top
             return (begin_size - stream.size());
         }
     
+        //---------------------------------delta ---------------------------------//
+        bool   xvbstate_t::take_delta(xvbstate_t & base_state,std::string & to_delta_bin)
+        {
+            if( (base_state.get_address() != get_address()) || (base_state.get_block_height() + 1 != m_block_height) )
+            {
+                xerror("xvbstate_t::take_delta,base(%s) is not previous state of %s",base_state.dump().c_str(),dump().c_str());
+                return false;
+            }
+            
+            auto canvas = rebase_change_to_delta(base_state);
+            if(nullptr == canvas)
+                return false;
+            
+            std::string changes_bin;
+            if( (canvas->get_op_records_size() > 0) && (canvas->encode(changes_bin) != enum_xcode_successful) )
+                return false;
+            
+            //same header as do_write except the account,which is the one of base_state
+            xstream_t stream(xcontext_t::instance());
+            stream << m_block_types;
+            stream << m_block_versions;
+            
+            stream.write_compact_var(m_block_height);
+            stream.write_compact_var(m_block_viewid);
+            stream.write_compact_var(m_last_full_block_height);
+            
+            stream.write_tiny_string(m_last_block_hash);
+            stream.write_tiny_string(m_last_full_block_hash);
+            stream << changes_bin;
+            
+            to_delta_bin.assign((const char*)stream.data(),stream.size());
+            return true;
+        }
+    
+        xvbstate_t*   xvbstate_t::create_from_delta(xvbstate_t & base_state,const std::string & delta_bin)
+        {
+            xstream_t stream(xcontext_t::instance(),(uint8_t*)delta_bin.data(),(uint32_t)delta_bin.size());
+            
+            uint16_t    block_types = 0;
+            uint32_t    block_versions = 0;
+            uint64_t    block_height = 0;
+            uint64_t    block_viewid = 0;
+            uint64_t    last_full_block_height = 0;
+            std::string last_block_hash;
+            std::string last_full_block_hash;
+            std::string changes_bin;
+            
+            stream >> block_types;
+            stream >> block_versions;
+            
+            stream.read_compact_var(block_height);
+            stream.read_compact_var(block_viewid);
+            stream.read_compact_var(last_full_block_height);
+            
+            stream.read_tiny_string(last_block_hash);
+            stream.read_tiny_string(last_full_block_hash);
+            stream >> changes_bin;
+            
+            if(block_height != base_state.get_block_height() + 1)
+            {
+                xerror("xvbstate_t::create_from_delta,delta of height(%" PRIu64 ") not on base(%s)",block_height,base_state.dump().c_str());
+                return nullptr;
+            }
+            
+            xvbstate_t* new_state = new xvbstate_t(base_state.get_address(),block_height,block_viewid,last_block_hash,last_full_block_hash,last_full_block_height,block_versions,block_types);
+            new_state->clone_properties_from(base_state);
+            if( (changes_bin.empty() == false) && (false == new_state->apply_changes_of_binlog(changes_bin)) )
+            {
+                xerror("xvbstate_t::create_from_delta,invalid changes for state(%s)",new_state->dump().c_str());
+                new_state->release_ref();
+                return nullptr;
+            }
+            return new_state;
+        }
+    
+        const std::string   xvbstate_t::get_delta_base_hash(const std::string & delta_bin)
+        {
+            xstream_t stream(xcontext_t::instance(),(uint8_t*)delta_bin.data(),(uint32_t)delta_bin.size());
+            
+            uint16_t    block_types = 0;
+            uint32_t    block_versions = 0;
+            uint64_t    block_height = 0;
+            uint64_t    block_viewid = 0;
+            uint64_t    last_full_block_height = 0;
+            std::string last_block_hash;
+            
+            if(stream.size() < (int32_t)(sizeof(block_types) + sizeof(block_versions)))
+                return std::string();
+            
+            stream >> block_types;
+            stream >> block_versions;
+            
+            stream.read_compact_var(block_height);
+            stream.read_compact_var(block_viewid);
+            stream.read_compact_var(last_full_block_height);
+            
+            stream.read_tiny_string(last_block_hash);
+            return last_block_hash;
+        }
+    
         //---------------------------------bin log ---------------------------------//
         bool   xvbstate_t::apply_changes_of_binlog(std::deque<base::xvmethod_t> && records) //apply changes to current states
         {
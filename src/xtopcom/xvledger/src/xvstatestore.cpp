@@ -83,7 +83,12 @@ namespace top
 
             XMETRICS_GAUGE(metrics::store_state_read, 1);
             // const std::string state_db_key = xvdbkey_t::create_prunable_state_key(target_account,block_height,block_hash);
-            const std::string state_db_bin = xvchain_t::instance().get_xdbstore()->get_value(state_db_key);
+            std::string state_db_bin = xvchain_t::instance().get_xdbstore()->get_value(state_db_key);
+            if(state_db_bin.empty() && target_account.is_table_address())
+            {
+                state_db_key = xvdbkey_t::create_prunable_state_key_old(target_account,block_height,block_hash);
+                state_db_bin = xvchain_t::instance().get_xdbstore()->get_value(state_db_key);
+            }
             if(state_db_bin.empty())
             {
                 xdbg("xvblkstatestore_t::read_state_from_db,fail to read from db for account=%s,height=%ld,hash=%s",target_account.get_account().c_str(), block_height, base::xstring_utl::to_hex(block_hash).c_str());
@@ -119,8 +124,9 @@ namespace top
         bool   xvblkstatestore_t::delete_state_of_db(const xvaccount_t & target_account,uint64_t block_height,const std::string & block_hash)
         {
             XMETRICS_GAUGE(metrics::store_state_delete, 1);
-            const std::string state_db_key = xvdbkey_t::create_prunable_state_key(target_account,block_height,block_hash);
-            return xvchain_t::instance().get_xdbstore()->delete_value(state_db_key);
+            const std::vector<std::string> state_db_keys{xvdbkey_t::create_prunable_state_key(target_account,block_height,block_hash),
+                                                         xvdbkey_t::create_prunable_state_key_old(target_account,block_height,block_hash)};
+            return xvchain_t::instance().get_xdbstore()->delete_values(state_db_keys);
         }
         bool   xvblkstatestore_t::delete_states_of_db(const xvaccount_t & target_account,const uint64_t block_height)
         {
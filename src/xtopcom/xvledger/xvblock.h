@@ -7,6 +7,9 @@
 #include "xbase/xdata.h"
 #include "xbase/xmem.h"
 #include "xbase/xobject_ptr.h"
+#include "xbasic/xobject_pool.h"
+#include <atomic>
+#include <mutex>
 #include "xventity.h"
 #include "xvtransact.h"
 #include "xvblock_fork.h"
@@ -631,6 +634,9 @@ namespace top
 
         public: //create object from serialized data
             static xvblock_t*          create_block_object(const std::string  & vblock_serialized_data);
+            static xvblock_t*          create_block_object(const char* vblock_serialized_data, const size_t data_size);
+            //lazy_body keep input and output as verified bytes, decode them at first access of get_input()/get_output()
+            static xvblock_t*          create_block_object(const char* vblock_serialized_data, const size_t data_size, bool lazy_body);
             static xvheader_t*         create_header_object(const std::string & vheader_serialized_data);
             static xvqcert_t*          create_qcert_object(const std::string  & vqcert_serialized_data);
             static xvinput_t*          create_input_object(const std::string  & vinput_serialized_data);
@@ -644,6 +650,7 @@ namespace top
             //check whether those qcert,header,input,output etc are constist and pass test of hash
             static  bool  prepare_block(xvqcert_t & _vcert,xvheader_t & _vheader,xvinput_t * _vinput,xvoutput_t * _voutput);
             static  void                register_object(xcontext_t & _context); //internal use only
+            XDECLARE_POOLED_NEW_DELETE  //blocks of all classes are drawn from the object pool
         public:
             xvblock_t(const xvblock_t & obj,enum_xdata_type type = (enum_xdata_type)enum_xobject_type_vblock);
         protected:
@@ -726,6 +733,7 @@ namespace top
         public:
             xvinput_t *                 get_input()  const;//raw ptr of xvinput_t
             xvoutput_t*                 get_output() const;//raw ptr of xvoutput_t
+            bool                        is_body_decoded() const {return (false == m_lazy_body_pending.load(std::memory_order_acquire));}
             virtual std::vector<base::xvaction_t> get_tx_actions() const {return std::vector<base::xvaction_t>{};}
             virtual std::vector<base::xvaction_t> get_one_tx_action(const std::string & txhash) const {return std::vector<base::xvaction_t>{};}
             virtual std::vector<xvsubblock_index_t> get_subblocks_index() const {return std::vector<xvsubblock_index_t>{};}
@@ -786,6 +794,7 @@ namespace top
             //generated the unique path of object(like vblock) under store-space(get_store_path()) to store data to DB
             //path like :   chainid/account/height/name
             static std::string          get_object_path(const std::string & account,uint64_t height,const std::string & name);
+            void                        decode_lazy_body() const; //create input and output from bytes kept by lazy read
             void                        remove_block_flag(enum_xvblock_flag flag);  //not allow remove flag
 
             //only just store m_vheader_hash , m_vbody_hash and related managed-purpose information(height,account,path etc)
@@ -800,8 +809,8 @@ namespace top
             xvheader_t*                 m_vheader_ptr;      //note: it must be valid at all time
             xvqcert_t *                 m_vqcert_ptr;       //note: it must be valid at all time
 
-            xvinput_t*                  m_vinput_ptr;       //note: it must be valid at all time,even a empty input
-            xvoutput_t*                 m_voutput_ptr;      //note: it must be valid at all time,even a empty output
+            mutable xvinput_t*          m_vinput_ptr;       //note: it must be valid at all time,even a empty input(except pending lazy body)
+            mutable xvoutput_t*         m_voutput_ptr;      //note: it must be valid at all time,even a empty output(except pending lazy body)
             xvbstate_t*                 m_vbstate_ptr;      //note: it might be empty. point to current state of this block
             uint64_t                    m_next_next_viewid; //persist store viewid of next and next hqc
 
@@ -822,6 +831,12 @@ namespace top
             std::string                 m_vote_extend_data;
             std::string                 m_output_offdata;
             std::shared_ptr<xvblock_excontainer_base> m_excontainer{nullptr};
+
+        private://lazy body,input and output stay as bytes(already verified by hash) until first access
+            mutable std::atomic<bool>   m_lazy_body_pending{false};
+            mutable std::mutex          m_lazy_body_lock;
+            mutable std::string         m_lazy_input_bin;
+            mutable std::string         m_lazy_output_bin;
         };
         using xvblock_ptr_t = xobject_ptr_t<base::xvblock_t>;
 
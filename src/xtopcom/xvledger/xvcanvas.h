@@ -47,6 +47,7 @@ namespace top
             bool       record(const xvmethod_t & op);//record instruction
             bool       rollback(size_t height);
             std::deque<xvmethod_t>  clone();
+            std::deque<xvmethod_t>  clone(size_t from_height,size_t to_height);//clone records of [from_height,to_height)
             
             const int  encode(xstream_t & output_bin,const int compile_options = xvcanvas_t::enum_compile_optimization_all);
             const int  encode(std::string & output_bin,const int compile_options = xvcanvas_t::enum_compile_optimization_all);
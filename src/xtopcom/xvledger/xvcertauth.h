@@ -61,12 +61,18 @@ namespace top
             virtual enum_vcert_auth_result   verify_sign(const xvip2_t & signer,const xvqcert_t * test_for_cert,
                                                          const std::string & block_account, const std::string sign_hash)  = 0;   
             virtual enum_vcert_auth_result   verify_sign(const xvip2_t & signer,const xvblock_t * test_for_block) = 0;
+
+            //verify signatures of many signers at once,results[i] is for signers[i] of test_for_certs[i]. default implementation verify them one by one
+            virtual void                     verify_signs(const std::vector<xvip2_t> & signers,const std::vector<const xvqcert_t*> & test_for_certs,
+                                                          const std::string & block_account,std::vector<enum_vcert_auth_result> & results);
             
         public:
             //merge multiple single-signature into threshold signature,and return a merged signature
             virtual const std::string   merge_muti_sign(const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const xvqcert_t * for_cert) = 0;
             virtual const std::string   merge_muti_sign(const std::map<xvip2_t,std::string,xvip2_compare> & muti_nodes_signatures,const xvqcert_t * for_cert) = 0;
             virtual const std::string   merge_muti_sign(const std::map<xvip2_t,std::string,xvip2_compare> & muti_nodes_signatures,const xvblock_t * for_block) = 0;
+            //merge for cert of for_block,but refuse block that is already authenticated or has cert hash. default implementation check then merge by cert
+            virtual const std::string   merge_muti_sign(const std::vector<xvip2_t> & muti_nodes,const std::vector<std::string> & muti_signatures,const xvblock_t * for_block);
             
         public://returned_errcode parameter carry detail error if verify_muti_sign fail(return false)
             //note:just verify multi-sign of group is ok for 'sign_hash', but not check whether the sign_hash is good or not
@@ -38,6 +38,7 @@ namespace top
            enum_xdbkey_type_relaytx_index          = 0x000d,
            enum_xdbkey_type_unitstate_v2           = 0x000e,
            enum_xdbkey_type_mptnode                = 0x000f,
+           enum_xdbkey_type_mpt_snapshot           = 0x0010, //flat account index snapshot of state mpt
            
            enum_xdbkey_type_max, //not over this max value
        };
@@ -84,9 +85,15 @@ namespace top
            static const std::string  create_account_span_key(const xvaccount_t & account,const uint64_t target_height);
            
            static const std::string  create_prunable_state_key(const xvaccount_t & account,const uint64_t target_height);
+           // table state key stays under the state height key, so states of pruned heights are deleted by range
            static const std::string  create_prunable_state_key(const xvaccount_t & account,const uint64_t target_height,const std::string & block_hash);
+           static const std::string  create_prunable_state_key_old(const xvaccount_t & account,const uint64_t target_height,const std::string & block_hash);
+           //all state and offdata keys under of same height
+           static const std::string  create_prunable_state_height_key(const xvaccount_t & account,const uint64_t target_height);
            // now unit state key, different from block
            static const std::string  create_prunable_unit_state_key(const xvaccount_t & account, uint64_t target_height,std::string const& block_hash);
+           //unit state stored as the delta to the state of previous block,under the same height as the full one
+           static const std::string  create_prunable_unit_state_delta_key(const xvaccount_t & account, uint64_t target_height,std::string const& block_hash);
            //all keys under of same height state
            static const std::string  create_prunable_unit_state_height_key(const xvaccount_t & account,const uint64_t target_height);
 
@@ -112,12 +119,18 @@ namespace top
            static const std::string  create_prunable_block_input_resource_key(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid);
            static const std::string  create_prunable_block_output_key(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid);
            static const std::string  create_prunable_block_output_resource_key(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid);
+           // offdata is pruned along with table state, so it stays under the state height key as well
            static const std::string  create_prunable_block_output_offdata_key(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid);
+           static const std::string  create_prunable_block_output_offdata_key_old(const xvaccount_t & account,const uint64_t target_height,const uint64_t target_viewid);
            
            static const std::string  create_prunable_unit_proof_key(const xvaccount_t & account, const uint64_t target_height);
            static const std::string  create_prunable_mpt_node_key(const xvaccount_t & account, const std::string & key);
            static const std::string  create_prunable_mpt_node_key_prefix(const xvaccount_t & account);
            static const std::string  create_prunable_mpt_node_key(const std::string & prefix, const std::string & key);
+           //prefix is same as mpt node,so snapshot of one table stays close to its trie nodes
+           static const std::string  create_mpt_snapshot_account_key(const std::string & prefix, const std::string & account);
+           static const std::string  create_mpt_snapshot_root_key(const std::string & prefix);
+           static const std::string  create_mpt_snapshot_diff_key(const std::string & prefix, const std::string & root);
            
            static const std::string  get_account_prefix_key(const std::string & key);
            static const std::string  get_account_address_from_key(const std::string & key);
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "xbase/xdata.h"
 #include "xvblock.h"
@@ -13,6 +16,23 @@ namespace top
 {
     namespace base
     {
+        //decode value from raw memory of DB,must not keep data pointer after return
+        typedef std::function<bool(const char* data, const size_t size)> xvdb_value_decoder;
+        //visit key and value of range,return false to stop
+        typedef std::function<bool(const std::string & key, const std::string & value)> xvdb_range_visitor;
+        
+        //consistent read view of DB:reads see every key as of the moment the view was taken,never a write made later
+        //so a group of related keys(e.g. index of a tx at send/recv/confirm phase) is never read half updated
+        class xvdbsnapshot_t
+        {
+        public:
+            virtual ~xvdbsnapshot_t() {}
+            virtual const std::string        get_value(const std::string & key) const = 0;
+            //result[i] is empty if keys[i] is not found
+            virtual std::vector<std::string> get_values(const std::vector<std::string> & keys) const = 0;
+        };
+        using xvdbsnapshot_ptr_t = std::shared_ptr<xvdbsnapshot_t>;
+
         class xvdbstore_t : public xobject_t
         {
             friend class xvchain_t;
@@ -35,11 +55,50 @@ namespace top
 
         public://key-value manage
             virtual const std::string get_value(const std::string & key) const = 0;
+            //decode value straight from memory pinned at DB instead of copying out,return false if not found or decoder fail
+            virtual bool              decode_value(const std::string & key, const xvdb_value_decoder & decoder) const
+            {
+                const std::string value = get_value(key);
+                if(value.empty())
+                    return false;
+                return decoder(value.data(), value.size());
+            }
+            //batch read multiple keys,result[i] is empty if keys[i] is not found
+            virtual std::vector<std::string> get_values(const std::vector<std::string> & keys) const
+            {
+                std::vector<std::string> values;
+                values.reserve(keys.size());
+                for(auto & key : keys)
+                    values.push_back(get_value(key));
+                return values;
+            }
+            //take a read view of DB,release it before the store;default view reads live DB,for stores without snapshot
+            virtual xvdbsnapshot_ptr_t create_snapshot() const
+            {
+                class xlive_view_t : public xvdbsnapshot_t
+                {
+                public:
+                    explicit xlive_view_t(const xvdbstore_t * store) : m_store(store) {}
+                    const std::string        get_value(const std::string & key) const override {return m_store->get_value(key);}
+                    std::vector<std::string> get_values(const std::vector<std::string> & keys) const override {return m_store->get_values(keys);}
+                private:
+                    const xvdbstore_t * m_store;
+                };
+                return std::make_shared<xlive_view_t>(this);
+            }
             virtual bool              set_value(const std::string & key, const std::string& value) = 0;
             virtual bool              set_values(const std::map<std::string, std::string> & objs) = 0;
             virtual bool              delete_value(const std::string & key) = 0;
             //batch deleted keys
             virtual bool              delete_values(const std::vector<std::string> & to_deleted_keys) = 0;
+            //queue objs to be merged with other writers into one DB write,return once queued;on_written(if any) get the result once written
+            //note:get_value see queued objs immediately;default implementation writes synchronously
+            virtual bool              set_values_async(const std::map<std::string, std::string> & objs, std::function<void(bool)> on_written) {
+                const bool ret = set_values(objs);
+                if (on_written)
+                    on_written(ret);
+                return ret;
+            }
 
         public://old API, here just for compatible
             virtual bool             set_vblock(const std::string & store_path,xvblock_t* block) = 0;
@@ -53,6 +112,8 @@ namespace top
         public://new api for range ops
             //prefix must start from first char of key
             virtual bool             read_range(const std::string& prefix, std::vector<std::string>& values) = 0;
+            //visit each key of prefix,return false if not support
+            virtual bool             read_range(const std::string& prefix, const xvdb_range_visitor & visitor) {return false;}
             
             //note:begin_key and end_key must has same style(first char of key)
             // Removes the database entries in the range ["begin_key", "end_key"), i.e.,
@@ -63,6 +124,17 @@ namespace top
             // If "end_key" comes before "start_key" according to the user's comparator,
             // a `Status::InvalidArgument` is returned.
             virtual bool             delete_range(const std::string & begin_key,const std::string & end_key) = 0;
+            //delete multiple ranges by one DB write,default implementation deletes one by one
+            virtual bool             delete_ranges(const std::vector<std::pair<std::string,std::string>> & ranges)
+            {
+                bool ret = true;
+                for(auto & range : ranges)
+                {
+                    if(false == delete_range(range.first,range.second))
+                        ret = false;
+                }
+                return ret;
+            }
             
             //key must be readonly(never update after PUT),otherwise the behavior is undefined
             virtual bool             single_delete(const std::string & target_key) = 0;
@@ -71,6 +143,11 @@ namespace top
             //note: begin_key and end_key must be at same CF while XDB configed by multiple CFs
             virtual bool             compact_range(const std::string & begin_key,const std::string & end_key) = 0;
             virtual void             GetDBMemStatus() const = 0;
+            
+            //tiered storage:move keys of ["begin_key", "end_key") to cold DB at background,return false if not tiered
+            virtual bool             move_range_to_cold(const std::string & begin_key,const std::string & end_key) {return false;}
+            //blocks lower than (height of new block - gap) are qualified to move to cold DB,return 0 if not tiered
+            virtual uint64_t         get_cold_height_gap() const {return 0;}
         protected:
 //            using xobject_t::add_ref;
 //            using xobject_t::release_ref;
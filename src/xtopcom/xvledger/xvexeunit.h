@@ -91,6 +91,8 @@ namespace top
             const int           get_childs_count() const {return (int)m_child_units.size();}
             const std::map<std::string,xvexeunit_t*> & get_child_units() const {return m_child_units;}
             virtual void        set_parent_unit(xvexeunit_t * parent_ptr) override;
+            //notify subclass that child of unit_name is added or replaced by unit,or removed when unit is nullptr
+            virtual void        on_child_unit_changed(const std::string & unit_name,xvexeunit_t * unit){}
         protected:
             virtual int32_t     do_write(xstream_t & stream) override; //allow subclass extend behavior
             virtual int32_t     do_read(xstream_t & stream)  override; //allow subclass extend behavior
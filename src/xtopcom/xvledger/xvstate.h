@@ -13,6 +13,22 @@ namespace top
     {
         //xvexestate_t manage property and instructions, it might be used for the block-based state-object, or the account-based state-object
         //note: xvexestate_t is NOT multiple-thread safe,caller need ensure all api are called at same thread
+        //native properties that every transaction touch,xvexestate_t keep them at fixed slots besides the named map
+        enum enum_xvstate_native_property
+        {
+            enum_xvstate_native_property_balance        = 0,  //"$0" available balance
+            enum_xvstate_native_property_burn_balance   = 1,  //"$a"
+            enum_xvstate_native_property_lock_balance   = 2,  //"$b"
+            enum_xvstate_native_property_tgas_balance   = 3,  //"$c" pledge balance for tgas
+            enum_xvstate_native_property_vote_balance   = 4,  //"$d" pledge balance for vote
+            enum_xvstate_native_property_lock_tgas      = 5,  //"$00"
+            enum_xvstate_native_property_used_tgas      = 6,  //"$01"
+            enum_xvstate_native_property_last_tx_hour   = 7,  //"$02"
+            enum_xvstate_native_property_tx_info        = 8,  //"$06" nonce and hash of latest sent tx
+            enum_xvstate_native_property_lock_token     = 9,  //"$08"
+            enum_xvstate_native_property_max
+        };
+    
         class xvexestate_t : public xvexegroup_t,public xvaccount_t
         {
         protected:
@@ -32,12 +48,22 @@ namespace top
             //check whether property already existing
             bool                        find_property(const std::string & property_name) const;
             virtual xvproperty_t*       get_property_object(const std::string & name) const;
+            xvproperty_t*               get_property_object(enum_xvstate_native_property slot) const;
             std::set<std::string>       get_all_property_names() const;
+            //slot of native property,or enum_xvstate_native_property_max for others
+            static enum_xvstate_native_property get_native_property_slot(const std::string & name);
             int                         get_property_num() const;
 
             bool                        take_snapshot(std::string & to_full_state_bin);
             xauto_ptr<xvcanvas_t>       take_snapshot();
             xauto_ptr<xvcanvas_t>       rebase_change_to_snapshot(); //snapshot for whole xvbstate of every properties
+            //instructions that turn base_state into this state: changed entries of map and hashmap properties,renew of other changed properties and del of removed ones
+            xauto_ptr<xvcanvas_t>       rebase_change_to_delta(xvexestate_t & base_state);
+            //find which property is changed by the instruction,return false if instruction not target to any property
+            bool                        get_property_of_instruction(const xvmethod_t & op,std::string & property_name) const;
+            
+        public://copy-on-write support,restore one property to the same as source state,or delete it if source not have it
+            bool                        restore_property_from(const xvexestate_t & source,const std::string & property_name);
             
         public://note: only allow access by our kernel module. it means private for application'contract
             xauto_ptr<xtokenvar_t>              load_token_var(const std::string & property_name);//for main token(e.g. TOP Token)
@@ -110,6 +136,7 @@ namespace top
             
             virtual std::string     get_property_value(const std::string & name);
 //            virtual xvproperty_t*   get_property_object(const std::string & name);
+            virtual void            on_child_unit_changed(const std::string & unit_name,xvexeunit_t * unit) override;
  
         private: //functions to modify value actually
             const xvalue_t  do_new_property(const xvmethod_t & op,xvcanvas_t * canvas);
@@ -129,6 +156,9 @@ namespace top
                 IMPL_XVIFUNCE_ID_API(enum_xvinstruct_state_method_renew_property,do_renew_property)
                 IMPL_XVIFUNCE_ID_API(enum_xvinstruct_state_method_del_property,do_del_property)
             END_DECLARE_XVIFUNC_ID_API(enum_xvinstruct_class_state_function)
+            
+        private:
+            xvexeunit_t*    m_native_units[enum_xvstate_native_property_max]; //raw ptr to the ones held by child units
         };
     
         class xvblock_t;
@@ -194,6 +224,14 @@ namespace top
             bool                  apply_changes_of_binlog(const std::string & from_bin_log);//apply changes to current states,use carefully
             virtual bool          apply_changes_of_binlog(xstream_t & from_bin_log,const uint32_t bin_log_size);//apply changes to current states,use carefully
             
+        public://delta against the state of previous block,that carry only what changed instead of every property
+            //base_state must be the state of previous block of the same account
+            bool                  take_delta(xvbstate_t & base_state,std::string & to_delta_bin);
+            //rebuild the state from the state of previous block and the delta of take_delta,caller need release the returned one
+            static xvbstate_t*    create_from_delta(xvbstate_t & base_state,const std::string & delta_bin);
+            //hash of previous block that the delta based on,empty for invalid delta
+            static const std::string  get_delta_base_hash(const std::string & delta_bin);
+            
         protected:
             //subclass extend behavior and load more information instead of a raw one
             //return how many bytes readout /writed in, return < 0(enum_xerror_code_type) when have error
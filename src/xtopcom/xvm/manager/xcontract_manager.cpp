@@ -29,6 +29,7 @@
 #include "xmetrics/xmetrics.h"
 #include "xvledger/xvblock.h"
 #include "xvm/manager/xcontract_address_map.h"
+#include "xvm/manager/xcontract_property_view.h"
 #include "xvm/manager/xmessage_ids.h"
 #include "xvm/xsystem_contracts/deploy/xcontract_deploy.h"
 #include "xvm/xsystem_contracts/tcc/xrec_proposal_contract.h"
@@ -203,6 +204,7 @@ void xtop_contract_manager::clear() {
         delete pair.second;
     }
     m_map.clear();
+    m_sniffed_tables_dirty = true;
 
     m_contract_inst_map.clear();
 }
@@ -266,6 +268,28 @@ void xtop_contract_manager::do_destory_vnode(const xevent_vnode_ptr_t & e) {
             ++it;
         }
     }
+    m_sniffed_tables_dirty = true;
+}
+
+bool xtop_contract_manager::is_sniffed_block(std::string const & owner, base::enum_xvblock_class blk_class) {
+    if (m_sniffed_tables_dirty) {
+        m_sniffed_block_owners.clear();
+        m_sniffed_fulltable_bases.clear();
+        for (auto const & pair : m_map) {
+            for (auto const & pr : *(pair.second)) {
+                pr.second->sniffed_tables(m_sniffed_block_owners, m_sniffed_fulltable_bases);
+            }
+        }
+        m_sniffed_tables_dirty = false;
+    }
+
+    if (m_sniffed_block_owners.find(owner) != m_sniffed_block_owners.end()) {
+        return true;
+    }
+    if (blk_class == base::enum_xvblock_class_full) {
+        return m_sniffed_fulltable_bases.find(owner.substr(0, owner.find('@'))) != m_sniffed_fulltable_bases.end();
+    }
+    return false;
 }
 
 void xtop_contract_manager::do_on_block(const xevent_ptr_t & e) {
@@ -291,6 +315,9 @@ void xtop_contract_manager::do_on_block(const xevent_ptr_t & e) {
         if (store_event->blk_level != base::enum_xvblock_level_table) {  // only broadcast table
             return;
         }
+        if (!is_sniffed_block(store_event->owner, store_event->blk_class)) {  // skip loading blocks no contract acts on
+            return;
+        }
 
         auto block = mbus::extract_block_from(store_event, metrics::blockstore_access_from_mbus_contract_db_on_block); // load mini-block firstly
         if (block == nullptr) {  // should not happen
@@ -322,6 +349,7 @@ void xtop_contract_manager::do_new_vnode(const xevent_vnode_ptr_t & e) {
         xdbg("[xtop_contract_manager::do_new_vnode] add all evm contracts' rcs");
         add_role_contexts_by_type(e, common::xnode_type_t::evm_validator, true);  // add sharding rcs, but disable broadcasts
     }
+    m_sniffed_tables_dirty = true;
 }
 
 void xtop_contract_manager::add_role_contexts_by_type(const xevent_vnode_ptr_t & e, common::xnode_type_t type, bool disable_broadcasts) {
@@ -448,12 +476,11 @@ static void get_election_result_property_data(common::xaccount_address_t const &
            contract_address == rec_elect_fullnode_contract_address  ||  // NOLINT
            contract_address == zec_elect_eth_contract_address);
 
-    std::string serialized_value{};
+    auto const unitstate = statestore::xstatestore_hub_t::instance()->get_unit_latest_connectted_state(contract_address);
     for (auto const & property_name : data::election::get_property_name_by_addr(contract_address)) {
-        serialized_value.clear();
-        if (statestore::xstatestore_hub_t::instance()->string_get(contract_address, property_name, serialized_value) == 0 && !serialized_value.empty()) {
-            auto election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
-            for (auto const & election_network_result_info : election_result_store) {
+        auto const election_result_store = xcontract_property_view_t<data::election::xelection_result_store_t>::instance().get(unitstate, property_name);
+        if (election_result_store != nullptr) {
+            for (auto const & election_network_result_info : *election_result_store) {
                 auto const network_id = top::get<common::xnetwork_id_t const>(election_network_result_info);
                 auto const & election_network_result = top::get<data::election::xelection_network_result_t>(election_network_result_info);
                 xJson::Value jn;
@@ -524,10 +551,10 @@ static void get_election_result_property_data(common::xaccount_address_t const &
            contract_address == rec_elect_fullnode_contract_address  ||
            contract_address == zec_elect_eth_contract_address);
 
-    std::string serialized_value{};
-    if (statestore::xstatestore_hub_t::instance()->string_get(contract_address, property_name, serialized_value) == 0 && !serialized_value.empty()) {
-        auto election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
-        for (auto const & election_network_result_info : election_result_store) {
+    auto const unitstate = statestore::xstatestore_hub_t::instance()->get_unit_latest_connectted_state(contract_address);
+    auto const election_result_store = xcontract_property_view_t<data::election::xelection_result_store_t>::instance().get(unitstate, property_name);
+    if (election_result_store != nullptr) {
+        for (auto const & election_network_result_info : *election_result_store) {
             auto const network_id = top::get<common::xnetwork_id_t const>(election_network_result_info);
             auto const & election_network_result = top::get<data::election::xelection_network_result_t>(election_network_result_info);
 
@@ -611,10 +638,9 @@ static void get_election_result_property_data(const data::xunitstate_ptr_t units
            contract_address == zec_elect_relay_contract_address                || // NOLINT
            contract_address == relay_make_block_contract_address);
 
-    std::string serialized_value = unitstate->string_get(property_name);
-    if (!serialized_value.empty()) {
-        auto election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
-        for (auto const & election_network_result_info : election_result_store) {
+    auto const election_result_store = xcontract_property_view_t<data::election::xelection_result_store_t>::instance().get(unitstate, property_name);
+    if (election_result_store != nullptr) {
+        for (auto const & election_network_result_info : *election_result_store) {
             auto const network_id = top::get<common::xnetwork_id_t const>(election_network_result_info);
             auto const & election_network_result = top::get<data::election::xelection_network_result_t>(election_network_result_info);
 
@@ -688,9 +714,10 @@ static void get_rec_standby_pool_property_data(common::xaccount_address_t const
                                                xJson::Value & json) {
     assert(property_name == XPROPERTY_CONTRACT_STANDBYS_KEY);
     assert(contract_address == common::xaccount_address_t{sys_contract_rec_standby_pool_addr});
-    std::string serialized_value{};
-    if (statestore::xstatestore_hub_t::instance()->string_get(contract_address, property_name, serialized_value) == 0 && !serialized_value.empty()) {
-        auto const & standby_result_store = codec::msgpack_decode<data::election::xstandby_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
+    auto const unitstate = statestore::xstatestore_hub_t::instance()->get_unit_latest_connectted_state(contract_address);
+    auto const standby_result_store_ptr = xcontract_property_view_t<data::election::xstandby_result_store_t>::instance().get(unitstate, property_name);
+    if (standby_result_store_ptr != nullptr) {
+        auto const & standby_result_store = *standby_result_store_ptr;
         for (auto const & standby_network_result_info : standby_result_store) {
             auto const network_id = top::get<common::xnetwork_id_t const>(standby_network_result_info);
             auto const & standby_network_result = top::get<data::election::xstandby_network_storage_result_t>(standby_network_result_info).all_network_result();
@@ -743,11 +770,10 @@ static void get_association_result_property_data(common::xaccount_address_t cons
                                                  std::string const & property_name,
                                                  xJson::Value & json) {
     assert(contract_address == xaccount_address_t{sys_contract_zec_group_assoc_addr});
-    std::string serialized_value{};
-    if (statestore::xstatestore_hub_t::instance()->string_get(contract_address, property_name, serialized_value) == 0 && !serialized_value.empty()) {
-        auto const & association_result_store =
-            codec::msgpack_decode<data::election::xelection_association_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
-        for (auto const & election_association_result : association_result_store) {
+    auto const unitstate = statestore::xstatestore_hub_t::instance()->get_unit_latest_connectted_state(contract_address);
+    auto const association_result_store = xcontract_property_view_t<data::election::xelection_association_result_store_t>::instance().get(unitstate, property_name);
+    if (association_result_store != nullptr) {
+        for (auto const & election_association_result : *association_result_store) {
             for (auto const & association_result : election_association_result.second) {
                 json[association_result.second.to_string()].append(association_result.first.value());
             }
@@ -1776,10 +1802,9 @@ void xtop_contract_manager::get_election_data(common::xaccount_address_t const &
             contract_address == zec_elect_relay_contract_address     ||
             contract_address == relay_make_block_contract_address);
 
-    std::string serialized_value = unitstate->string_get(property_name);
-    if (!serialized_value.empty()) {
-        auto election_result_store = codec::msgpack_decode<data::election::xelection_result_store_t>({std::begin(serialized_value), std::end(serialized_value)});
-        for (auto const & election_network_result_info : election_result_store) {
+    auto const election_result_store = xcontract_property_view_t<data::election::xelection_result_store_t>::instance().get(unitstate, property_name);
+    if (election_result_store != nullptr) {
+        for (auto const & election_network_result_info : *election_result_store) {
             auto const & election_network_result = top::get<data::election::xelection_network_result_t>(election_network_result_info);
 
             for (auto const & election_result_info : election_network_result) {
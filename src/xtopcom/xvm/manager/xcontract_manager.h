@@ -23,6 +23,7 @@
 #include <list>
 #include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 NS_BEG2(top, contract)
@@ -220,6 +221,14 @@ private:
      * @param disable_broadcasts if disabling broadcasts
      */
     void add_role_contexts_by_type(const xevent_vnode_ptr_t & e, common::xnode_type_t type, bool disable_broadcasts);
+    /**
+     * @brief check if any role context acts on the committed table block, before loading it
+     *
+     * @param owner block owner
+     * @param blk_class block class
+     * @return true if the block should be loaded and dispatched
+     */
+    bool is_sniffed_block(std::string const & owner, base::enum_xvblock_class blk_class);
 
     /**
      * @brief Set up contract
@@ -238,6 +247,11 @@ private:
     static base::xvnodesrv_t                                         *m_nodesvr_ptr;
 
     uint64_t                                                         m_latest_timer{};
+
+    // table blocks sniffed by the role contexts in m_map, rebuilt on vnode changes
+    std::unordered_set<std::string>                                  m_sniffed_block_owners;
+    std::unordered_set<std::string>                                  m_sniffed_fulltable_bases;
+    bool                                                             m_sniffed_tables_dirty{true};
 };
 using xcontract_manager_t = xtop_contract_manager;
 
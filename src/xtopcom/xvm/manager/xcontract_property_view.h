@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbase/xns_macro.h"
+#include "xcodec/xmsgpack_codec.hpp"
+#include "xdata/xunit_bstate.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+NS_BEG2(top, contract)
+
+/* decoded view of a msgpack encoded string property of a system contract (election results, standby pool, group association).
+ * one object is kept per (contract, property) and reused until the contract's state moves to another unit block,
+ * so repeated reads between two blocks of the contract do no property copy or decode.
+ * states older than the cached one are decoded without replacing it.
+ */
+template <typename T>
+class xtop_contract_property_view {
+public:
+    xtop_contract_property_view() = default;
+    xtop_contract_property_view(xtop_contract_property_view const &) = delete;
+    xtop_contract_property_view & operator=(xtop_contract_property_view const &) = delete;
+
+    static xtop_contract_property_view & instance() {
+        static xtop_contract_property_view view;
+        return view;
+    }
+
+    /// @brief Gets the decoded property of the state, nullptr if the property is empty.
+    std::shared_ptr<T const> get(data::xunitstate_ptr_t const & unitstate, std::string const & property_name) {
+        if (unitstate == nullptr) {
+            return nullptr;
+        }
+
+        auto const height = unitstate->height();
+        auto const & block_hash = unitstate->get_bstate()->get_last_block_hash();
+        auto key = std::make_pair(unitstate->account_address().value(), property_name);
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            auto const it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                if (it->second.height == height && it->second.block_hash == block_hash) {
+                    return it->second.value;
+                }
+                if (it->second.height > height) {
+                    return decode(unitstate, property_name);
+                }
+            }
+        }
+
+        auto value = decode(unitstate, property_name);
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto & entry = m_entries[std::move(key)];
+        if (entry.value == nullptr || entry.height <= height) {
+            entry.height = height;
+            entry.block_hash = block_hash;
+            entry.value = value;
+        }
+        return value;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_entries.clear();
+    }
+
+private:
+    struct xentry_t {
+        uint64_t height{0};
+        std::string block_hash;
+        std::shared_ptr<T const> value;
+    };
+
+    static std::shared_ptr<T const> decode(data::xunitstate_ptr_t const & unitstate, std::string const & property_name) {
+        auto const serialized_value = unitstate->string_get(property_name);
+        if (serialized_value.empty()) {
+            return nullptr;
+        }
+        return std::make_shared<T const>(codec::msgpack_decode<T>({std::begin(serialized_value), std::end(serialized_value)}));
+    }
+
+    std::mutex m_mutex;
+    std::map<std::pair<std::string, std::string>, xentry_t> m_entries;
+};
+
+template <typename T>
+using xcontract_property_view_t = xtop_contract_property_view<T>;
+
+NS_END2
@@ -132,6 +132,20 @@ void xrole_context_t::on_block_to_db(const xblock_ptr_t & block, bool & event_br
     }
 }
 
+void xrole_context_t::sniffed_tables(std::unordered_set<std::string> & block_owners, std::unordered_set<std::string> & fulltable_bases) const {
+    // keep in line with on_block_to_db
+    if (m_contract_info->has_block_monitors()) {
+        if (m_contract_info->address == sharding_statistic_info_contract_address) {
+            fulltable_bases.insert(sys_contract_sharding_table_block_addr);
+        } else if (m_contract_info->address == eth_statistic_info_contract_address) {
+            fulltable_bases.insert(sys_contract_eth_table_block_addr);
+        }
+    }
+    if (m_contract_info->has_broadcasts()) {
+        block_owners.insert(data::account_address_to_block_address(m_contract_info->address));
+    }
+}
+
 void xrole_context_t::on_block_timer(const xevent_ptr_t & e) {
     if (!m_contract_info->has_monitors()) {
         return;
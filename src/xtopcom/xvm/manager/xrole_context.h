@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "xbase/xns_macro.h"
 #include "xblockstore/xsyncvstore_face.h"
 #include "xdata/xblock_statistics_data.h"
@@ -46,6 +48,14 @@ public:
      */
     void on_block_to_db(const xblock_ptr_t & block, bool & event_broadcasted);
 
+    /**
+     * @brief collect the table blocks on_block_to_db acts on
+     *
+     * @param block_owners owners of the table blocks processed in any class
+     * @param fulltable_bases base addresses of the tables whose full blocks are processed
+     */
+    void sniffed_tables(std::unordered_set<std::string> & block_owners, std::unordered_set<std::string> & fulltable_bases) const;
+
     /**
      * @brief process chain timer event
      *
@@ -4,8 +4,10 @@
 
 #include "xbase/xcontext.h"
 #include "xbase/xmem.h"
+#include "xbasic/xlru_cache.h"
 #include "xbasic/xscope_executer.h"
 #include "xerror/xvm_error.h"
+#include "xmetrics/xmetrics.h"
 #include "xvm/xvm_context.h"
 #include "xvm/xvm_engine.h"
 #include "xvm/xvm_lua_api.h"
@@ -14,19 +16,207 @@ NS_BEG2(top, xvm)
 using base::xcontext_t;
 using base::xstream_t;
 
-xlua_engine::xlua_engine() {
-    m_lua_mgr = luaL_newstate();
-    if (m_lua_mgr == NULL) {
+namespace {
+
+struct xlua_state_pool_t {
+    std::vector<lua_State*> idle;
+    ~xlua_state_pool_t() {
+        for (auto L : idle) {
+            lua_close(L);
+        }
+    }
+};
+
+thread_local xlua_state_pool_t t_lua_states;
+// compiled chunks by keccak256 of the source, only chunks dumped from source that loaded are kept
+basic::xlru_cache<std::string, std::string> g_lua_chunks(MAX_CACHED_LUA_CHUNKS);
+
+const char* const pristine_tables_key = "xvm.pristine_tables";
+const char* const pristine_string_mt_key = "xvm.pristine_string_mt";
+
+int chunk_writer(lua_State*, const void* p, size_t sz, void* ud) {
+    reinterpret_cast<std::string*>(ud)->append(reinterpret_cast<const char*>(p), sz);
+    return 0;
+}
+
+// copies the table at index into snapshot[table], and the tables it holds up to depth levels down
+void snapshot_table(lua_State* L, int index, int snapshot, int depth) {
+    index = lua_absindex(L, index);
+    lua_pushvalue(L, index);
+    if (lua_rawget(L, snapshot) != LUA_TNIL) {
+        lua_pop(L, 1);
+        return;
+    }
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, index);
+    lua_newtable(L);
+    lua_pushnil(L);
+    while (lua_next(L, index) != 0) {
+        lua_pushvalue(L, -2);
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+    }
+    lua_rawset(L, snapshot);
+
+    if (depth == 0) {
+        return;
+    }
+    lua_pushnil(L);
+    while (lua_next(L, index) != 0) {
+        if (lua_type(L, -1) == LUA_TTABLE) {
+            snapshot_table(L, -1, snapshot, depth - 1);
+        }
+        lua_pop(L, 1);
+    }
+}
+
+// whether the table at index has no metatable and exactly the entries of its copy
+bool same_as_copy(lua_State* L, int index, int copy) {
+    if (lua_getmetatable(L, index)) {
+        lua_pop(L, 1);
+        return false;
+    }
+    size_t entries = 0;
+    lua_pushnil(L);
+    while (lua_next(L, index) != 0) {
+        lua_pushvalue(L, -2);
+        lua_rawget(L, copy);
+        bool const same = lua_rawequal(L, -1, -2);
+        lua_pop(L, 2);
+        if (!same) {
+            lua_pop(L, 1);
+            return false;
+        }
+        ++entries;
+    }
+    size_t copy_entries = 0;
+    lua_pushnil(L);
+    while (lua_next(L, copy) != 0) {
+        lua_pop(L, 1);
+        ++copy_entries;
+    }
+    return entries == copy_entries;
+}
+
+}
+
+lua_State* xlua_engine::new_state() {
+    lua_State* L = luaL_newstate();
+    if (L == NULL) {
         xerror_lua("luaL_newstate error\n");
+        return NULL;
+    }
+    luaL_openlibs(L);
+    snapshot_globals(L);
+    return L;
+}
+
+void xlua_engine::snapshot_globals(lua_State* L) {
+    // the globals, the libraries and their tables like package.loaded
+    lua_newtable(L);
+    lua_pushglobaltable(L);
+    snapshot_table(L, -1, lua_absindex(L, -2), 2);
+    lua_pop(L, 1);
+    lua_setfield(L, LUA_REGISTRYINDEX, pristine_tables_key);
+
+    lua_pushliteral(L, "");
+    if (!lua_getmetatable(L, -1)) {
+        lua_pushnil(L);
+    }
+    lua_setfield(L, LUA_REGISTRYINDEX, pristine_string_mt_key);
+    lua_pop(L, 1);
+}
+
+bool xlua_engine::globals_untouched(lua_State* L) {
+    bool untouched = true;
+    lua_getfield(L, LUA_REGISTRYINDEX, pristine_tables_key);
+    int const snapshot = lua_gettop(L);
+    lua_pushnil(L);
+    while (untouched && lua_next(L, snapshot) != 0) {
+        untouched = same_as_copy(L, lua_absindex(L, -2), lua_absindex(L, -1));
+        lua_pop(L, 1);
+    }
+    lua_settop(L, snapshot - 1);
+
+    if (untouched) {
+        lua_pushliteral(L, "");
+        if (!lua_getmetatable(L, -1)) {
+            lua_pushnil(L);
+        }
+        lua_getfield(L, LUA_REGISTRYINDEX, pristine_string_mt_key);
+        untouched = lua_rawequal(L, -1, -2);
+        lua_settop(L, snapshot - 1);
+    }
+    return untouched;
+}
+
+lua_State* xlua_engine::acquire_state() {
+    auto & idle = t_lua_states.idle;
+    if (!idle.empty()) {
+        lua_State* L = idle.back();
+        idle.pop_back();
+        XMETRICS_COUNTER_INCREMENT("xvm_lua_state_reuse", 1);
+        return L;
+    }
+    return new_state();
+}
+
+void xlua_engine::release_state(lua_State* L) {
+    if (L == NULL) {
         return;
     }
-    luaL_openlibs(m_lua_mgr);
+    lua_settop(L, 0);
+    auto & idle = t_lua_states.idle;
+    // a script that reached the shared tables, e.g. through package.loaded._G, spoils the state
+    if (idle.size() < MAX_IDLE_LUA_STATES && globals_untouched(L)) {
+        idle.push_back(L);
+        return;
+    }
+    lua_close(L);
+}
+
+xlua_engine::xlua_engine() {
+    m_lua_mgr = acquire_state();
 }
 
 void xlua_engine::register_function() {
+    // into the environment of the script, so they still shadow globals the script defines
+    lua_rawgeti(m_lua_mgr, LUA_REGISTRYINDEX, m_env_ref);
     for (size_t i = 0; i < sizeof(g_lua_chain_func) / sizeof(xlua_chain_func); i++) {
-        lua_register(m_lua_mgr, g_lua_chain_func[i].name, g_lua_chain_func[i].func);
+        lua_pushcfunction(m_lua_mgr, g_lua_chain_func[i].func);
+        lua_setfield(m_lua_mgr, -2, g_lua_chain_func[i].name);
     }
+    lua_pop(m_lua_mgr, 1);
+}
+
+void xlua_engine::load_chunk(const std::string &code) {
+    auto const digest = utl::xkeccak256_t::digest(code);
+    std::string const code_hash{reinterpret_cast<const char*>(digest.raw_uint8), 32};
+    std::string chunk;
+    if (g_lua_chunks.get(code_hash, chunk) && luaL_loadbufferx(m_lua_mgr, chunk.data(), chunk.size(), "=contract", "b") == LUA_OK) {
+        XMETRICS_COUNTER_INCREMENT("xvm_lua_chunk_cache_hit", 1);
+        return;
+    }
+    lua_settop(m_lua_mgr, 0);
+
+    if (luaL_loadstring(m_lua_mgr, code.c_str())) {
+        string error_msg = lua_tostring(m_lua_mgr, -1);
+        xkinfo_lua("load lua code error\n %s", code.c_str());
+        std::error_code ec{ enum_xvm_error_code::enum_lua_code_parse_error };
+        top::error::throw_error(ec, "lua load code error:" + error_msg);
+    }
+    chunk.clear();
+    if (lua_dump(m_lua_mgr, chunk_writer, &chunk, 0) == 0) {
+        g_lua_chunks.put(code_hash, chunk);
+    }
+}
+
+int xlua_engine::get_contract_field(const char* name) {
+    lua_rawgeti(m_lua_mgr, LUA_REGISTRYINDEX, m_env_ref);
+    int const type = lua_getfield(m_lua_mgr, -1, name);
+    lua_remove(m_lua_mgr, -2);
+    return type;
 }
 
 void xlua_engine::validate_script(const std::string &code, xvm_context &ctx) {
@@ -40,12 +230,20 @@ void xlua_engine::validate_script(const std::string &code, xvm_context &ctx) {
         lua_setcontractaccount(m_lua_mgr, parent_addr.data(), parent_addr.size());
         lua_setuserdata(m_lua_mgr, reinterpret_cast<void*>(ctx.m_contract_helper.get()));
 
-        if (luaL_loadstring(m_lua_mgr, code.c_str())) {
-            string error_msg = lua_tostring(m_lua_mgr, -1);
-            xkinfo_lua("load lua code error\n %s", code.c_str());
-            std::error_code ec{ enum_xvm_error_code::enum_lua_code_parse_error };
-            top::error::throw_error(ec, "lua load code error:" + error_msg);
-        }
+        load_chunk(code);
+
+        // a fresh environment falling back to the globals, the script can not leave anything to the next user of the state
+        lua_newtable(m_lua_mgr);
+        lua_newtable(m_lua_mgr);
+        lua_pushglobaltable(m_lua_mgr);
+        lua_setfield(m_lua_mgr, -2, "__index");
+        lua_setmetatable(m_lua_mgr, -2);
+        lua_pushvalue(m_lua_mgr, -1);
+        lua_setfield(m_lua_mgr, -2, "_G");
+        luaL_unref(m_lua_mgr, LUA_REGISTRYINDEX, m_env_ref);
+        lua_pushvalue(m_lua_mgr, -1);
+        m_env_ref = luaL_ref(m_lua_mgr, LUA_REGISTRYINDEX);
+        lua_setupvalue(m_lua_mgr, -2, 1);  // _ENV of the main chunk
 
         if (lua_pcall(m_lua_mgr, 0, 0, 0)) {
             string error_msg = lua_tostring(m_lua_mgr, -1);
@@ -91,7 +289,7 @@ void xlua_engine::load_script(const std::string &code, xvm_context &ctx) {
 }
 
 void xlua_engine::call_init() {
-    int32_t ret = lua_getglobal(m_lua_mgr, "init");
+    int32_t ret = get_contract_field("init");
     if (ret != 0 && lua_pcall(m_lua_mgr, 0, 0, 0)) {
         string error_msg = lua_tostring(m_lua_mgr, -1);
         xkinfo_lua("lua_pcall init:%s", error_msg.c_str());
@@ -171,7 +369,7 @@ void xlua_engine::process(common::xaccount_address_t const &contract_account, co
     lua_setuserdata(m_lua_mgr, reinterpret_cast<void*>(ctx.m_contract_helper.get()));
     init_gas(ctx, CALC_GAS_TRUE);
 
-    lua_getglobal(m_lua_mgr, ctx.m_action_name.c_str());
+    get_contract_field(ctx.m_action_name.c_str());
 
     try {
         if (ctx.m_action_name == "init") {
@@ -200,7 +398,9 @@ void xlua_engine::process(common::xaccount_address_t const &contract_account, co
 void xlua_engine::close() {
     xdbg("close xlua_engine");
     if (m_lua_mgr != NULL) {
-        lua_close(m_lua_mgr);
+        luaL_unref(m_lua_mgr, LUA_REGISTRYINDEX, m_env_ref);
+        m_env_ref = LUA_NOREF;
+        release_state(m_lua_mgr);
         m_lua_mgr = NULL;
     }
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <cstdint>
 #include <mutex>
+#include <vector>
 #include "xvm/xvm_engine.h"
 extern "C"
 {
@@ -18,6 +19,8 @@ NS_BEG2(top, xvm)
 #define CALC_GAS_FALSE  0
 #define MAX_ARG_NUM     16
 #define MAX_ARG_STRING_SIZE 128
+#define MAX_IDLE_LUA_STATES 4
+#define MAX_CACHED_LUA_CHUNKS 64
 
 class xlua_engine : public xengine, public std::enable_shared_from_this<xlua_engine>
 {
@@ -34,6 +37,17 @@ public:
     void init_gas(xvm_context& ctx, int calc_gas);
     int32_t arg_parse(const string& action_param);
 private:
+    // states are taken from and given back to a pool of the calling thread. a pooled state only
+    // has the standard libraries open, every script runs in an environment table of its own.
+    static lua_State* acquire_state();
+    static void release_state(lua_State* L);
+    static lua_State* new_state();
+    static void snapshot_globals(lua_State* L);
+    static bool globals_untouched(lua_State* L);
+    void load_chunk(const std::string& code);
+    int get_contract_field(const char* name);
+
     lua_State* m_lua_mgr;
+    int m_env_ref{LUA_NOREF};
 };
 NS_END2
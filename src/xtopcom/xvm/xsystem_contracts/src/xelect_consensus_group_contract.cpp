@@ -19,8 +19,10 @@
 #include "xdata/xsystem_contract/xdata_structures.h"
 #include "xvm/xerror/xvm_error.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <unordered_map>
 
 using top::data::election::xelection_group_result_t;
 using top::data::election::xelection_info_bundle_t;
@@ -142,32 +144,31 @@ uint64_t xtop_election_awared_data::raw_credit_score() const noexcept {
 
 xtop_elect_consensus_group_contract::xtop_elect_consensus_group_contract(common::xnetwork_id_t const & network_id) : xbase_t{network_id} {}
 
-static uint64_t calc_comprehensive_stake(int i) {
-    auto const auditor_nodes_per_segment = XGET_ONCHAIN_GOVERNANCE_PARAMETER(auditor_nodes_per_segment);
-    uint64_t stake = basic_comprehensive_stake;
-
-    const auto seg = static_cast<uint32_t>(i) / auditor_nodes_per_segment;
-    for (uint32_t j = 0; j < seg; j++) {
-        stake = stake * 9 / 10;
-    }
-    return std::max(stake, minimum_comprehensive_stake);  // comprehensive_stake has minimum value 1.
-}
-
 static void normalize_stake(common::xminer_type_t const role, std::vector<xelection_awared_data_t> & input) {
     auto & result = input;
     switch (role) {
     case common::xminer_type_t::advance: {
         std::sort(std::begin(result), std::end(result), [](xelection_awared_data_t const & lhs, xelection_awared_data_t const & rhs) { return lhs > rhs; });
+
+        // the comprehensive stake drops by 10% every segment, it is carried over from the previous segment instead of recalculated per node.
+        auto const auditor_nodes_per_segment = XGET_ONCHAIN_GOVERNANCE_PARAMETER(auditor_nodes_per_segment);
+        uint64_t segment_stake = basic_comprehensive_stake;
         for (auto i = 0u; i < result.size(); ++i) {
+            if (i != 0 && i % auditor_nodes_per_segment == 0) {
+                segment_stake = segment_stake * 9 / 10;
+            }
             if (result[i].stake() > 0) {  // special condition check for genesis nodes.
-                result[i].comprehensive_stake(calc_comprehensive_stake(i));
+                result[i].comprehensive_stake(std::max(segment_stake, minimum_comprehensive_stake));  // comprehensive_stake has minimum value 1.
             } else {
                 assert(result[i].stake() == 0);
                 result[i].comprehensive_stake(minimum_comprehensive_stake);
             }
         }
 
-        std::sort(std::begin(result), std::end(result), [](xelection_awared_data_t const & lhs, xelection_awared_data_t const & rhs) { return lhs < rhs; });
+        // all comprehensive stakes were equal before, and they don't increase along the descending order,
+        // so the order is still descending with them and reversing gives the ascending order without sorting again.
+        std::reverse(std::begin(result), std::end(result));
+        assert(std::is_sorted(std::begin(result), std::end(result)));
         break;
     }
 
@@ -429,14 +430,21 @@ bool xtop_elect_consensus_group_contract::do_normal_election(common::xzone_id_t
     normalize_stake(role_type, effective_standby_result);
 
     auto const current_standby_result = effective_standby_result;
+    std::unordered_map<common::xnode_id_t, xelection_awared_data_t const *> current_standby_index;
+    current_standby_index.reserve(current_standby_result.size());
+    for (auto const & standby : current_standby_result) {
+        current_standby_index.emplace(standby.account(), &standby);
+    }
 
     // preparing the fts selection. rule:
     // when electing in, the higher the stake is, the higher the possibility is.
     // when electing out, the lower the stake is, the higher the possibility is.
 
     // filter the standbys by the current group nodes.
+    // the standbys kept are compacted in place, erasing them one by one is quadratic in the pool size.
     std::vector<common::xfts_merkle_tree_t<common::xnode_id_t>::value_type> fts_standbys;
-    for (auto it = std::begin(effective_standby_result); it != std::end(effective_standby_result);) {
+    auto kept_end = std::begin(effective_standby_result);
+    for (auto it = std::begin(effective_standby_result); it != std::end(effective_standby_result); ++it) {
         auto const & standby_node_id = it->account();
         auto const comprehensive_stake = it->comprehensive_stake();
 
@@ -446,13 +454,15 @@ bool xtop_elect_consensus_group_contract::do_normal_election(common::xzone_id_t
             node_election_info.comprehensive_stake(comprehensive_stake);
             node_election_info.stake(it->stake());
             node_election_info.public_key(it->public_key());
-
-            it = effective_standby_result.erase(it);
         } else {
             fts_standbys.push_back({static_cast<common::xstake_t>(comprehensive_stake), standby_node_id});
-            ++it;
+            if (kept_end != it) {
+                *kept_end = std::move(*it);
+            }
+            ++kept_end;
         }
     }
+    effective_standby_result.erase(kept_end, std::end(effective_standby_result));
 
 #if defined DEBUG
     for (auto const & standby : fts_standbys) {
@@ -605,14 +615,11 @@ bool xtop_elect_consensus_group_contract::do_normal_election(common::xzone_id_t
         auto & election_info_bundle = top::get<data::election::xelection_info_bundle_t>(node_info);
         auto const & account_address = election_info_bundle.account_address();
 
-        auto const elect_in_pos = std::find_if(std::begin(current_standby_result),
-                                               std::end(current_standby_result),
-                                               [&account_address](xelection_awared_data_t const & other) {
-            return other.account() == account_address;
-        });
-        if (elect_in_pos == std::end(current_standby_result)) {
+        auto const standby_it = current_standby_index.find(account_address);
+        if (standby_it == std::end(current_standby_index)) {
             continue;
         }
+        auto const elect_in_pos = standby_it->second;
 
         xinfo("%s see elected in %s node %s with miner type %s genesis %s credit score %" PRIu64,
               log_prefix.c_str(),
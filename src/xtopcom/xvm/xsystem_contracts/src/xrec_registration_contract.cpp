@@ -34,6 +34,25 @@ NS_BEG2(top, xstake)
 
 #define TIMER_ADJUST_DENOMINATOR 10
 
+// total votes of every voted node, each table's votes are deserialized once instead of once per registered node
+static std::map<std::string, uint64_t> calc_adv_votes(std::map<std::string, std::string> const & votes_table) {
+    std::map<std::string, uint64_t> adv_votes;
+    for (auto const & vote : votes_table) {
+        auto const & vote_str = vote.second;
+        if (vote_str.empty()) {
+            continue;
+        }
+        std::map<std::string, std::string> contract_votes;
+        base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)vote_str.c_str(), (uint32_t)vote_str.size());
+        stream >> contract_votes;
+        for (auto const & contract_vote : contract_votes) {
+            adv_votes[contract_vote.first] += base::xstring_utl::touint64(contract_vote.second);
+        }
+    }
+
+    return adv_votes;
+}
+
 xrec_registration_contract::xrec_registration_contract(common::xnetwork_id_t const & network_id) : xbase_t{network_id} {}
 
 void xrec_registration_contract::setup() {
@@ -636,24 +655,7 @@ void xrec_registration_contract::update_batch_stake(std::map<std::string, std::s
         xdbg("[xrec_registration_contract::update_batch_stake] MAP COPY GET error:%s", e.what());
     }
 
-    auto update_adv_votes = [&](std::string adv_account, std::map<std::string, std::string> votes_table) {
-        uint64_t total_votes = 0;
-        for (auto const & vote : votes_table) {
-            auto const & vote_str = vote.second;
-            std::map<std::string, std::string> contract_votes;
-            if (!vote_str.empty()) {
-                base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)vote_str.c_str(), (uint32_t)vote_str.size());
-                stream >> contract_votes;
-            }
-
-            auto iter = contract_votes.find(adv_account);
-            if (iter != contract_votes.end()) {
-                total_votes += base::xstring_utl::touint64(iter->second);
-            }
-        }
-
-        return total_votes;
-    };
+    auto const adv_votes = calc_adv_votes(votes_table);
 
     for (auto const & entity : map_nodes) {
         auto const & account = entity.first;
@@ -669,7 +671,8 @@ void xrec_registration_contract::update_batch_stake(std::map<std::string, std::s
             continue;
         }
 
-        reg_node_info.m_vote_amount = update_adv_votes(account, votes_table);
+        auto const votes_it = adv_votes.find(account);
+        reg_node_info.m_vote_amount = votes_it == adv_votes.end() ? 0 : votes_it->second;
         //reg_node_info.calc_stake();
         update_node_info(reg_node_info);
     }
@@ -755,24 +758,7 @@ void xrec_registration_contract::update_batch_stake_v2(uint64_t report_time, std
         xdbg("[xrec_registration_contract::update_batch_stake_v2] MAP COPY GET error:%s", e.what());
     }
 
-    auto update_adv_votes = [&](std::string adv_account, std::map<std::string, std::string> votes_table) {
-        uint64_t total_votes = 0;
-        for (auto const & vote : votes_table) {
-            auto const & vote_str = vote.second;
-            std::map<std::string, std::string> contract_votes;
-            if (!vote_str.empty()) {
-                base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)vote_str.c_str(), (uint32_t)vote_str.size());
-                stream >> contract_votes;
-            }
-
-            auto iter = contract_votes.find(adv_account);
-            if (iter != contract_votes.end()) {
-                total_votes += base::xstring_utl::touint64(iter->second);
-            }
-        }
-
-        return total_votes;
-    };
+    auto const adv_votes = calc_adv_votes(votes_table);
 
     for (auto const & entity : map_nodes) {
         auto const & account = entity.first;
@@ -784,7 +770,8 @@ void xrec_registration_contract::update_batch_stake_v2(uint64_t report_time, std
         data::system_contract::xreg_node_info reg_node_info;
         reg_node_info.serialize_from(stream);
 
-        reg_node_info.m_vote_amount = update_adv_votes(account, votes_table);
+        auto const votes_it = adv_votes.find(account);
+        reg_node_info.m_vote_amount = votes_it == adv_votes.end() ? 0 : votes_it->second;
         update_node_info(reg_node_info);
     }
 
@@ -49,6 +49,16 @@ using top::data::election::xstandby_result_t;
 
 NS_BEG4(top, xvm, system_contracts, zec)
 
+// standby pool of the node type a group is elected from, the only pool elect_group reads.
+// each group filters its own copy; copying the pools of all node types per group costs more than electing it on a large network.
+static xstandby_network_result_t standby_pool_of(xstandby_network_result_t const & standby_network_result, common::xnode_type_t const node_type) {
+    xstandby_network_result_t standby_pool;
+    auto const & results = standby_network_result.results();
+    auto const it = results.find(node_type);
+    standby_pool.result_of(node_type) = (it != std::end(results)) ? it->second : xstandby_result_t{};
+    return standby_pool;
+}
+
 xtop_zec_elect_consensus_group_contract::xtop_zec_elect_consensus_group_contract(common::xnetwork_id_t const & network_id) : xbase_t{network_id} {}
 
 #ifdef STATIC_CONSENSUS
@@ -534,7 +544,7 @@ bool xtop_zec_elect_consensus_group_contract::elect_auditor_validator(common::xz
     assert(!associated_validator_group_ids.empty());
 
     // clean up the auditor standby pool by filtering out the nodes that are currently in the validator group.
-    auto effective_standby_network_result = standby_network_result;
+    auto effective_standby_network_result = standby_pool_of(standby_network_result, common::xnode_type_t::consensus_auditor);
     auto & effective_auditor_standbys = effective_standby_network_result.result_of(common::xnode_type_t::consensus_auditor);
     auto & election_network_result = all_cluster_election_result_store.at(auditor_group_id).result_of(network_id());
     xwarn("%s begins to filter auditor standbys (standby size %zu)", log_prefix.c_str(), effective_auditor_standbys.size());
@@ -608,7 +618,7 @@ bool xtop_zec_elect_consensus_group_contract::elect_auditor_validator(common::xz
          (all_validator_group_id.end() - 1)->to_string().c_str());
 
     for (auto const & validator_group_id : associated_validator_group_ids) {
-        auto effective_standby_network_result = standby_network_result;
+        auto effective_standby_network_result = standby_pool_of(standby_network_result, common::xnode_type_t::consensus_validator);
         auto & effective_validator_standbys = effective_standby_network_result.result_of(common::xnode_type_t::consensus_validator);
 
         xwarn("%s begins to filter validator standbys (standby size %zu)", log_prefix.c_str(), effective_validator_standbys.size());
@@ -1018,44 +1018,34 @@ std::vector<std::vector<uint32_t>> xzec_reward_contract::calc_role_nums(std::map
 uint64_t xzec_reward_contract::calc_votes(std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
                                           std::map<common::xaccount_address_t, data::system_contract::xreg_node_info> & map_nodes,
                                           std::map<common::xaccount_address_t, uint64_t> & account_votes) {
+    // one pass over the votes instead of looking every node up in every voter's votes
     for (auto & entity : map_nodes) {
-        auto const & account = entity.first;
-        auto & node = entity.second;
-        uint64_t node_total_votes = 0;
-        for (auto const & vote_detail : votes_detail) {
-            auto const & contract = vote_detail.first;
-            auto const & vote = vote_detail.second;
-            auto iter = vote.find(account);
-            if (iter != vote.end()) {
-                account_votes[account] += iter->second;
-                node_total_votes += iter->second;
-            }
-        }
-        node.m_vote_amount = node_total_votes;
-        xdbg("[xzec_reward_contract::calc_votes] map_nodes: account: %s, deposit: %llu, node_type: %s, votes: %llu",
-             node.m_account.c_str(),
-             node.deposit(),
-             node.genesis() ? "advance,validator,edge" : common::to_string(node.miner_type()).c_str(),
-             node.m_vote_amount);
+        entity.second.m_vote_amount = 0;
     }
-    // valid auditor only
-    uint64_t total_votes = 0;
     for (auto const & entity : votes_detail) {
         auto const & vote = entity.second;
 
         for (auto const & entity2 : vote) {
-            data::system_contract::xreg_node_info node;
-            auto it = map_nodes.find(common::xaccount_address_t{entity2.first});
+            auto it = map_nodes.find(entity2.first);
             if (it == map_nodes.end()) {
                 xwarn("[xzec_reward_contract::calc_votes] account %s not in map_nodes", entity2.first.c_str());
                 continue;
-            } else {
-                node = it->second;
-            }
-
-            if (node.deposit() > 0 && node.can_be_auditor()) {
-                total_votes += entity2.second;
             }
+            account_votes[entity2.first] += entity2.second;
+            it->second.m_vote_amount += entity2.second;
+        }
+    }
+    // valid auditor only, checked after all votes are set since the tickets depend on them
+    uint64_t total_votes = 0;
+    for (auto const & entity : map_nodes) {
+        auto const & node = entity.second;
+        xdbg("[xzec_reward_contract::calc_votes] map_nodes: account: %s, deposit: %llu, node_type: %s, votes: %llu",
+             node.m_account.c_str(),
+             node.deposit(),
+             node.genesis() ? "advance,validator,edge" : common::to_string(node.miner_type()).c_str(),
+             node.m_vote_amount);
+        if (node.deposit() > 0 && node.can_be_auditor()) {
+            total_votes += node.m_vote_amount;
         }
     }
 
@@ -1066,15 +1056,10 @@ std::map<common::xaccount_address_t, uint64_t> xzec_reward_contract::calc_votes(
     std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, uint64_t>> const & votes_detail,
     std::map<common::xaccount_address_t, data::system_contract::xreg_node_info> const & map_nodes) {
     std::map<common::xaccount_address_t, uint64_t> account_votes;
-    for (auto & entity : map_nodes) {
-        auto const & account = entity.first;
-        auto & node = entity.second;
-        for (auto const & vote_detail : votes_detail) {
-            auto const & contract = vote_detail.first;
-            auto const & vote = vote_detail.second;
-            auto iter = vote.find(account);
-            if (iter != vote.end()) {
-                account_votes[account] += iter->second;
+    for (auto const & vote_detail : votes_detail) {
+        for (auto const & entity : vote_detail.second) {
+            if (map_nodes.find(entity.first) != map_nodes.end()) {
+                account_votes[entity.first] += entity.second;
             }
         }
     }
@@ -1760,8 +1745,7 @@ void xzec_reward_contract::calc_table_rewards(xreward_property_param_t & propert
                                               std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, ::uint128_t>> & table_node_reward_detail,
                                               std::map<common::xaccount_address_t, std::map<common::xaccount_address_t, ::uint128_t>> & table_node_dividend_detail,
                                               std::map<common::xaccount_address_t, ::uint128_t> & table_total_rewards) {
-    std::map<common::xaccount_address_t, uint64_t> account_votes;
-    calc_votes(property_param.votes_detail, property_param.map_nodes, account_votes);
+    auto account_votes = calc_votes(property_param.votes_detail, property_param.map_nodes);
     for(auto reward : node_reward_detail){
         xinfo("[xzec_reward_contract::calc_table_rewards] acocunt: %s", reward.first.c_str());
         common::xaccount_address_t table_address = calc_table_contract_address(common::xaccount_address_t{reward.first});
@@ -1770,15 +1754,23 @@ void xzec_reward_contract::calc_table_rewards(xreward_property_param_t & propert
         }
         calc_table_node_reward_detail(table_address, reward.first, reward.second, table_total_rewards, table_node_reward_detail);
     }
-    for(auto reward : node_dividend_detail){
-        for (auto & vote_detail : property_param.votes_detail){
-            auto const & voter = vote_detail.first;
-            auto const & votes = vote_detail.second;
-            common::xaccount_address_t table_address = calc_table_contract_address(common::xaccount_address_t{voter});
-            if(table_address.empty()){
+    if (node_dividend_detail.empty()) {
+        return;
+    }
+    // walk each voter's votes once, the table of the voter is calculated once rather than once per dividend node
+    for (auto const & vote_detail : property_param.votes_detail) {
+        auto const & voter = vote_detail.first;
+        auto const & votes = vote_detail.second;
+        common::xaccount_address_t table_address = calc_table_contract_address(common::xaccount_address_t{voter});
+        if (table_address.empty()) {
+            continue;
+        }
+        for (auto const & vote : votes) {
+            auto reward = node_dividend_detail.find(vote.first);
+            if (reward == node_dividend_detail.end()) {
                 continue;
             }
-            calc_table_node_dividend_detail(table_address, reward.first, reward.second, account_votes[reward.first], votes, table_total_rewards, table_node_dividend_detail);
+            calc_table_node_dividend_detail(table_address, reward->first, reward->second, account_votes[reward->first], votes, table_total_rewards, table_node_dividend_detail);
         }
     }
 }
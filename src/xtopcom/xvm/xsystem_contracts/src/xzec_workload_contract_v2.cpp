@@ -28,6 +28,23 @@ using namespace top::config;
 
 NS_BEG3(top, xvm, system_contracts)
 
+// keys at XPORPERTY_CONTRACT_WORKLOAD_KEY(serialized group address) of the groups carried by one upload
+static std::vector<std::string> uploaded_group_keys(std::string const & table_info_str) {
+    std::map<common::xgroup_address_t, xgroup_workload_t> group_workload;
+    {
+        xstream_t stream(xcontext_t::instance(), (uint8_t *)table_info_str.data(), table_info_str.size());
+        MAP_OBJECT_DESERIALZE2(stream, group_workload);
+    }
+    std::vector<std::string> keys;
+    keys.reserve(group_workload.size());
+    for (auto const & one_group_workload : group_workload) {
+        xstream_t stream(xcontext_t::instance());
+        stream << one_group_workload.first;
+        keys.emplace_back((const char *)stream.data(), stream.size());
+    }
+    return keys;
+}
+
 xzec_workload_contract_v2::xzec_workload_contract_v2(common::xnetwork_id_t const & network_id) : xbase_t{network_id} {
 }
 
@@ -77,7 +94,13 @@ void xzec_workload_contract_v2::on_receive_workload(std::string const & table_in
     {
         XMETRICS_TIME_RECORD(XWORKLOAD_CONTRACT "on_receive_workload_map_get");
         activation_str = STRING_GET2(XPORPERTY_CONTRACT_GENESIS_STAGE_KEY, sys_contract_rec_registration_addr);
-        MAP_COPY_GET(XPORPERTY_CONTRACT_WORKLOAD_KEY, workload_str);
+        // only the groups of this upload are read and rewritten,copying the whole map made each upload cost as much as all groups of the round
+        for (auto const & group_address_str : uploaded_group_keys(table_info_str)) {
+            std::string value_str;
+            if (MAP_GET2(XPORPERTY_CONTRACT_WORKLOAD_KEY, group_address_str, value_str) == 0) {
+                workload_str.emplace(group_address_str, std::move(value_str));
+            }
+        }
         tgas_str = STRING_GET2(XPORPERTY_CONTRACT_TGAS_KEY);
         MAP_GET2(XPORPERTY_CONTRACT_TABLEBLOCK_HEIGHT_KEY, std::to_string(table_id), height_str);
     }
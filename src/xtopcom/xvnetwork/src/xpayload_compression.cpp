@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvnetwork/xpayload_compression.h"
+
+#include "xbase/xlog.h"
+
+#include <lz4.h>
+
+#include <atomic>
+#include <cstring>
+
+NS_BEG2(top, vnetwork)
+
+// size of the original payload, little endian, in front of the lz4 block
+static constexpr std::size_t original_size_length{4};
+
+// a peer cannot make us allocate more than this for one payload
+static constexpr std::size_t max_original_size{128 * 1024 * 1024};
+
+static std::atomic<bool> compression_enabled{false};
+static std::atomic<std::size_t> compression_threshold{4096};
+
+void enable_payload_compression(bool const enable, std::size_t const threshold) {
+    compression_threshold.store(threshold, std::memory_order_relaxed);
+    compression_enabled.store(enable, std::memory_order_relaxed);
+    xkinfo("[vnetwork] payload compression %s, threshold %zu", enable ? "enabled" : "disabled", threshold);
+}
+
+bool payload_compression_enabled() noexcept {
+    return compression_enabled.load(std::memory_order_relaxed);
+}
+
+xpayload_encoding_t compress_payload(xbyte_buffer_t const & payload, xbyte_buffer_t & compressed) {
+    if (!payload_compression_enabled() || payload.size() < compression_threshold.load(std::memory_order_relaxed) || payload.size() > max_original_size) {
+        return xpayload_encoding_t::raw;
+    }
+
+    // compressed into a per thread buffer reused by every send, only the result is copied out
+    thread_local xbyte_buffer_t buffer;
+    auto const bound = static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(payload.size())));
+    if (buffer.size() < original_size_length + bound) {
+        buffer.resize(original_size_length + bound);
+    }
+
+    auto const size = static_cast<uint32_t>(payload.size());
+    for (std::size_t i = 0; i < original_size_length; ++i) {
+        buffer[i] = static_cast<uint8_t>(size >> (8 * i));
+    }
+    auto const compressed_size = LZ4_compress_default(reinterpret_cast<char const *>(payload.data()),
+                                                      reinterpret_cast<char *>(buffer.data() + original_size_length),
+                                                      static_cast<int>(payload.size()),
+                                                      static_cast<int>(bound));
+    if (compressed_size <= 0 || original_size_length + static_cast<std::size_t>(compressed_size) >= payload.size()) {
+        return xpayload_encoding_t::raw;
+    }
+
+    compressed.assign(buffer.begin(), buffer.begin() + original_size_length + compressed_size);
+    return xpayload_encoding_t::lz4;
+}
+
+bool decompress_payload(xpayload_encoding_t const encoding, xbyte_buffer_t const & compressed, xbyte_buffer_t & payload) {
+    if (encoding == xpayload_encoding_t::raw) {
+        payload = compressed;
+        return true;
+    }
+    if (encoding != xpayload_encoding_t::lz4 || compressed.size() <= original_size_length) {
+        xwarn("[vnetwork] payload encoding %d size %zu invalid", static_cast<int>(encoding), compressed.size());
+        return false;
+    }
+
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < original_size_length; ++i) {
+        size |= static_cast<std::size_t>(compressed[i]) << (8 * i);
+    }
+    if (size > max_original_size) {
+        xwarn("[vnetwork] payload original size %zu too large", size);
+        return false;
+    }
+
+    // decompressed right into the buffer the message keeps
+    payload.resize(size);
+    auto const decompressed_size = LZ4_decompress_safe(reinterpret_cast<char const *>(compressed.data() + original_size_length),
+                                                       reinterpret_cast<char *>(payload.data()),
+                                                       static_cast<int>(compressed.size() - original_size_length),
+                                                       static_cast<int>(size));
+    if (decompressed_size < 0 || static_cast<std::size_t>(decompressed_size) != size) {
+        xwarn("[vnetwork] payload decompress failed, ret %d expected %zu", decompressed_size, size);
+        payload.clear();
+        return false;
+    }
+    return true;
+}
+
+NS_END2
@@ -14,6 +14,7 @@
 #include "xcodec/xmsgpack_codec.hpp"
 #include "xcommon/xaddress.h"
 #include "xconfig/xconfig_register.h"
+#include "xconfig/xpredefined_configurations.h"
 #include "xelection/xcache/xgroup_element.h"
 #include "xelection/xdata_accessor_error.h"
 #include "xmetrics/xmetrics.h"
@@ -24,6 +25,7 @@
 #include "xvnetwork/xcodec/xmsgpack/xvnetwork_message_codec.hpp"
 #include "xvnetwork/xmessage.h"
 #include "xvnetwork/xmessage_filter_manager.h"
+#include "xvnetwork/xpayload_compression.h"
 #include "xvnetwork/xvnetwork_driver.h"
 #include "xvnetwork/xvnetwork_error.h"
 #include "xvnetwork/xvnetwork_error2.h"
@@ -61,6 +63,14 @@ static void msg_metrics(xvnetwork_message_t const & message, metrics::E_SIMPLE_M
     XMETRICS_GAUGE((metrics::E_SIMPLE_METRICS_TAG)(tag_start + delta), 1);
 }
 
+// consensus messages bypass sync and gossip floods in transport, or views time out while they wait behind bulk data.
+static network::xdeliver_priority_t deliver_priority(common::xmessage_id_t const message_id) {
+    if (common::get_message_category(message_id) == xmessage_category_consensus) {
+        return network::xdeliver_priority_t::highest;
+    }
+    return network::xdeliver_priority_t::normal;
+}
+
 xtop_vhost::xtop_vhost(observer_ptr<elect::xnetwork_driver_face_t> const & network_driver,
                        observer_ptr<time::xchain_time_face_t> const & chain_timer,
                        common::xnetwork_id_t const & nid,
@@ -75,6 +85,8 @@ xtop_vhost::xtop_vhost(observer_ptr<elect::xnetwork_driver_face_t> const & netwo
         // mock the m_filter_manager if you do not use the default para.
         m_filter_manager = std::move(message_filter_manager_ptr);
     }
+
+    enable_payload_compression(XGET_CONFIG(vnetwork_payload_compression), XGET_CONFIG(vnetwork_payload_compression_threshold));
 }
 
 common::xnode_id_t const & xtop_vhost::host_node_id() const noexcept {
@@ -100,12 +112,14 @@ void xtop_vhost::start() {
 }
 
 void xtop_vhost::stop() {
-    m_message_queue.push(xbyte_buffer_t{});
+    m_message_queue.push(xvnetwork_message_t{});
 
     assert(running());
     running(false);
     assert(!running());
 
+    stop_dispatchers();
+
     assert(m_network_driver);
 
     m_network_driver->unregister_message_ready_notify();
@@ -162,14 +176,16 @@ void xtop_vhost::send(xmessage_t const & message,
             auto new_hash_val = base::xhash32_t::digest(std::string((char *)bytes_message.data(), bytes_message.size()));
             xdbg("[vnetwork] send msg %" PRIx32 " [hash: %" PRIx64 "] [to_hash:%u]", static_cast<std::uint32_t>(message.id()), message.hash(), new_hash_val);
             #if VHOST_METRICS
-            XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_send" +
-                                           std::to_string(static_cast<std::uint32_t>(message.id())),
+            XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_send" +
+                top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                              {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                        1);
             #endif
 
             #if VHOST_METRICS
-            XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_send_size" +
-                                           std::to_string(static_cast<std::uint32_t>(message.id())),
+            XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_send_size" +
+                top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                              {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                        bytes_message.size());
             #endif
 
@@ -183,7 +199,7 @@ void xtop_vhost::send(xmessage_t const & message,
                  message_type == sync::xmessage_id_sync_frozen_broadcast_chain_state || message_type == sync::xmessage_id_sync_frozen_response_chain_state)) {
                 m_network_driver->send_to_through_root(src.xip2(), dst.node_id(), bytes_message, ec);
             } else {
-                m_network_driver->send_to(src.xip2(), dst.xip2(), bytes_message,ec);
+                m_network_driver->send_to(src.xip2(), dst.xip2(), bytes_message, deliver_priority(message_type), ec);
             }
             msg_metrics(vnetwork_message, metrics::message_send_category_begin);
 
@@ -259,7 +275,7 @@ void xtop_vhost::send_to(common::xnode_address_t const & src, common::xnode_addr
     //      message_type == sync::xmessage_id_sync_frozen_broadcast_chain_state || message_type == sync::xmessage_id_sync_frozen_response_chain_state)) {
     //     m_network_driver->send_to_through_root(convert_to_p2p_xip2(src), dst.node_id(), bytes, ec);
     // } else {
-    m_network_driver->send_to(src.xip2(), dst.xip2(), bytes, ec);
+    m_network_driver->send_to(src.xip2(), dst.xip2(), bytes, deliver_priority(vmsg.message_id()), ec);
     // }
     
     msg_metrics(vmsg, metrics::message_send_category_begin);
@@ -308,13 +324,15 @@ void xtop_vhost::broadcast(common::xnode_address_t const & src, common::xnode_ad
         xinfo("[vnetwork]xtop_vhost::broadcast [vnet hash: %" PRIx64 "] [msg hash: %u] [xxh32 to_hash:%" PRIu32 "]", vmsg.hash(), message.hash(), new_hash_val);
 
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_broadcast" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_broadcast" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    1);
 #endif
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_broadcast_size" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_broadcast_size" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    bytes.size());
 #endif
         // auto message_type = vmsg.message_id();
@@ -340,13 +358,15 @@ void xtop_vhost::broadcast(common::xnode_address_t const & src, common::xnode_ad
         xdbg("%s broadcast msg %x from:%s to:%s hash %" PRIx64, vnetwork_category2().name(), message.id(), src.to_string().c_str(), dst.to_string().c_str(), message.hash());
 
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_broadcast_to_all" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_broadcast_to_all" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    1);
 #endif
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_broadcast_to_all_size" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_broadcast_to_all_size" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    bytes_message.size());
 #endif
         assert(m_network_driver);
@@ -441,13 +461,15 @@ void xtop_vhost::broadcast(common::xnode_address_t const & src, common::xnode_ad
               n_dst.to_string().c_str());
 
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_forward_broadcast_message" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_forward_broadcast_message" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    1);
 #endif
 #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vhost_forward_broadcast_message_size" +
-                                       std::to_string(static_cast<std::uint32_t>(message.id())),
+        XMETRICS_COUNTER_INCREMENT("vhost_out_vhost_forward_broadcast_message_size" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                    bytes_message.size());
 #endif
         on_network_data_ready(host_node_id(), bytes_message);
@@ -473,7 +495,110 @@ void xtop_vhost::on_network_data_ready(common::xnode_id_t const &, xbyte_buffer_
 #if VHOST_METRICS
         XMETRICS_COUNTER_INCREMENT("vhost_total_size_of_all_messages", bytes.size());
 #endif
-        m_message_queue.push(bytes);
+        if (bytes.empty()) {
+            xwarn("[vnetwork] message byte empty!");
+            return;
+        }
+
+        // decode and filter on the delivering threads (transport workers), leave only dispatching to the vhost thread.
+        // todo check decode return value.
+        auto vnetwork_message = top::codec::msgpack_decode<xvnetwork_message_t>(bytes);
+        XMETRICS_GAUGE(metrics::vhost_recv_msg, 1);
+        auto const & message = vnetwork_message.message();
+        auto const & receiver = vnetwork_message.receiver();
+        auto const & sender = vnetwork_message.sender();
+
+        xdbg("[vnetwork] message hash: %" PRIx64 " , before filter:s&r sender is %s , receiver is %s",
+             vnetwork_message.hash(),
+             sender.to_string().c_str(),
+             receiver.to_string().c_str());
+
+        auto const message_category = common::get_message_category(vnetwork_message.message_id());
+        switch (message_category) {
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wswitch"
+#elif defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wswitch"
+#elif defined(_MSC_VER)
+#    pragma warning(push, 0)
+#endif
+        case xmessage_category_consensus:
+        {
+            XMETRICS_GAUGE(metrics::message_category_consensus_contains_duplicate, 1);
+            break;
+        }
+        case xmessage_category_timer:
+        {
+            XMETRICS_GAUGE(metrics::message_category_timer_contains_duplicate, 1);
+            break;
+        }
+        case xmessage_category_txpool:
+        {
+            XMETRICS_GAUGE(metrics::message_category_txpool_contains_duplicate, 1);
+            break;
+        }
+
+        case xmessage_category_rpc:
+        {
+            XMETRICS_GAUGE(metrics::message_category_rpc_contains_duplicate, 1);
+            break;
+        }
+
+        case xmessage_category_sync:
+        {
+            XMETRICS_GAUGE(metrics::message_category_sync_contains_duplicate, 1);
+            break;
+        }
+
+        case xmessage_category_state_sync:
+        {
+            XMETRICS_GAUGE(metrics::message_category_state_sync_contains_duplicate, 1);
+            break;
+        }
+
+        case xmessage_block_broadcast:
+        {
+            XMETRICS_GAUGE(metrics::message_block_broadcast_contains_duplicate, 1);
+            break;
+        }
+
+        case xmessage_category_relay:
+        {
+            XMETRICS_GAUGE(metrics::message_category_relay_contains_duplicate, 1);
+            break;
+        }
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#    pragma warning(pop)
+#endif
+        default:
+        {
+            assert(false);
+            XMETRICS_GAUGE(metrics::message_category_unknown_contains_duplicate, 1);
+            break;
+        }
+        }
+        #if VHOST_METRICS
+        XMETRICS_COUNTER_INCREMENT("vhost_in_vhost_size" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(vnetwork_message.message().id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(vnetwork_message.message().id()))}}),
+                                   bytes.size());
+        #endif
+        std::error_code ec;
+        m_filter_manager->filter_message(vnetwork_message, ec);
+        if (ec) {
+            xinfo("[vnetwork] message filter: message id %" PRIx32 " hash %" PRIx64 " filted out",
+                  static_cast<uint32_t>(message.id()),
+                  static_cast<uint64_t>(message.hash()));
+            return;
+        }
+
+        m_message_queue.push(std::move(vnetwork_message));
     } catch (std::exception const & eh) {
         xwarn("[vnetwork] std::exception exception caught: %s", eh.what());
     } catch (...) {
@@ -494,126 +619,34 @@ void xtop_vhost::do_handle_network_data() {
 #endif
     while (running()) {
         try {
-            auto all_byte_messages = m_message_queue.wait_and_pop_all();
+            auto all_vnetwork_messages = m_message_queue.wait_and_pop_all();
+            remove_unregistered_dispatchers();
 
-            XMETRICS_FLOW_COUNT("vhost_handle_data_ready_called", all_byte_messages.size());
+            XMETRICS_FLOW_COUNT("vhost_handle_data_ready_called", all_vnetwork_messages.size());
 
             XMETRICS_TIME_RECORD("vhost_handle_data_ready_called_time");
 
 #if defined(XENABLE_VHOST_BENCHMARK)
             auto xxbegin = std::chrono::high_resolution_clock::now();
 #endif
-            for (auto & bytes : all_byte_messages) {
+            for (auto & vnetwork_message : all_vnetwork_messages) {
                 if (!running()) {
                     xwarn("[vnetwork] vhost is not running!");
                     break;
                 }
 
                 try {
-                    if (bytes.empty()) {
+                    if (vnetwork_message.empty()) {
                         // this may be a stop notification message.
                         // anyway, for an empty message, just ignore it.
-                        xwarn("[vnetwork] message byte empty!");
                         continue;
                     }
 
-                    // todo check decode return value.
-                    auto vnetwork_message = top::codec::msgpack_decode<xvnetwork_message_t>(bytes);
-                    XMETRICS_GAUGE(metrics::vhost_recv_msg, 1);
                     auto const & message = vnetwork_message.message();
                     auto const & receiver = vnetwork_message.receiver();
                     auto const & sender = vnetwork_message.sender();
                     auto const msg_time = vnetwork_message.logic_time();
 
-                    xdbg("[vnetwork] message hash: %" PRIx64 " , before filter:s&r sender is %s , receiver is %s",
-                         vnetwork_message.hash(),
-                         sender.to_string().c_str(),
-                         receiver.to_string().c_str());
-
-                    auto const message_category = common::get_message_category(vnetwork_message.message_id());
-                    switch (message_category) {
-#if defined(__clang__)
-#    pragma clang diagnostic push
-#    pragma clang diagnostic ignored "-Wswitch"
-#elif defined(__GNUC__)
-#    pragma GCC diagnostic push
-#    pragma GCC diagnostic ignored "-Wswitch"
-#elif defined(_MSC_VER)
-#    pragma warning(push, 0)
-#endif
-                    case xmessage_category_consensus:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_consensus_contains_duplicate, 1);
-                        break;
-                    }
-                    case xmessage_category_timer:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_timer_contains_duplicate, 1);
-                        break;
-                    }
-                    case xmessage_category_txpool:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_txpool_contains_duplicate, 1);
-                        break;
-                    }
-
-                    case xmessage_category_rpc:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_rpc_contains_duplicate, 1);
-                        break;
-                    }
-
-                    case xmessage_category_sync:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_sync_contains_duplicate, 1);
-                        break;
-                    }
-
-                    case xmessage_category_state_sync:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_state_sync_contains_duplicate, 1);
-                        break;
-                    }
-
-                    case xmessage_block_broadcast:
-                    {
-                        XMETRICS_GAUGE(metrics::message_block_broadcast_contains_duplicate, 1);
-                        break;
-                    }
-
-                    case xmessage_category_relay:
-                    {
-                        XMETRICS_GAUGE(metrics::message_category_relay_contains_duplicate, 1);
-                        break;
-                    }
-#if defined(__clang__)
-#    pragma clang diagnostic pop
-#elif defined(__GNUC__)
-#    pragma GCC diagnostic pop
-#elif defined(_MSC_VER)
-#    pragma warning(pop)
-#endif
-                    default:
-                    {
-                        assert(false);
-                        XMETRICS_GAUGE(metrics::message_category_unknown_contains_duplicate, 1);
-                        break;
-                    }
-                    }
-                    #if VHOST_METRICS
-                    XMETRICS_COUNTER_INCREMENT("vhost_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(vnetwork_message.message().id()))) +
-                                                   "_in_vhost_size" + std::to_string(static_cast<std::uint32_t>(vnetwork_message.message().id())),
-                                               bytes.size());
-                    #endif
-                    std::error_code ec;
-                    m_filter_manager->filter_message(vnetwork_message, ec);
-                    if (ec) {
-                        xinfo("[vnetwork] message filter: message id %" PRIx32 " hash %" PRIx64 " filted out",
-                              static_cast<uint32_t>(message.id()),
-                              static_cast<uint64_t>(message.hash()));
-                        continue;
-                    }
-
                     xinfo("[vnetwork] message hash: %" PRIx64 " , after  filter:s&r sender is %s , receiver is %s",
                           vnetwork_message.hash(),
                           sender.to_string().c_str(),
@@ -652,23 +685,14 @@ void xtop_vhost::do_handle_network_data() {
                     for (auto & callback_info : callbacks) {
                         auto const & callback = top::get<xmessage_ready_callback_t>(callback_info);
                         if (callback) {
-                            try {
-                                // callback(sender, receiver, message);
-                                xdbg("[vnetwork] send msg %" PRIx32 " (hash %" PRIx64 ") to callback %p at address %s",
-                                     static_cast<std::uint32_t>(message.id()),
-                                     message.hash(),
-                                     &callback,
-                                     top::get<common::xnode_address_t const>(callback_info).to_string().c_str());
-#ifdef ENABLE_METRICS
-                                char msg_info[30] = {0};
-                                snprintf(msg_info, 29, "%x|%" PRIx64, static_cast<uint32_t>(vnetwork_message.message().id()), message.hash());
-                                XMETRICS_TIME_RECORD_KEY_WITH_TIMEOUT("vhost_handle_data_callback", msg_info, uint32_t(100000));
-#endif
-                                XMETRICS_GAUGE(metrics::vhost_recv_callback, 1);
-                                callback(sender, message, msg_time);
-                            } catch (std::exception const & eh) {
-                                xerror("[vnetwork] exception caught from callback: %s", eh.what());
-                            }
+                            auto const & callback_addr = top::get<common::xnode_address_t const>(callback_info);
+                            xdbg("[vnetwork] send msg %" PRIx32 " (hash %" PRIx64 ") to callback %p at address %s",
+                                 static_cast<std::uint32_t>(message.id()),
+                                 message.hash(),
+                                 &callback,
+                                 callback_addr.to_string().c_str());
+                            // the callback runs on the dispatcher of its address, see xvnode_dispatcher_t
+                            dispatcher_of(callback_addr)->push(callback, sender, message, msg_time);
                         } else {
                             xerror("[vnetwork] callback not registered");
                         }
@@ -685,7 +709,7 @@ void xtop_vhost::do_handle_network_data() {
 #if defined(XENABLE_VHOST_BENCHMARK)
             auto xxend = std::chrono::high_resolution_clock::now();
             auto ms = static_cast<std::size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(xxend - xxbegin).count());
-            xwarn("vhost processed in %zu milliseconds against %zu packs => tps = %lf", ms, all_byte_messages.size(), static_cast<double>(all_byte_messages.size()) * 1000 / ms);
+            xwarn("vhost processed in %zu milliseconds against %zu packs => tps = %lf", ms, all_vnetwork_messages.size(), static_cast<double>(all_vnetwork_messages.size()) * 1000 / ms);
 #endif
 
 
@@ -697,4 +721,49 @@ void xtop_vhost::do_handle_network_data() {
     }
 }
 
+xvnode_dispatcher_ptr_t xtop_vhost::dispatcher_of(common::xnode_address_t const & callback_address) {
+    std::lock_guard<std::mutex> lock{m_dispatchers_mutex};
+    auto & dispatcher = m_dispatchers[callback_address];
+    if (dispatcher == nullptr) {
+        xinfo("[vnetwork] create dispatcher for address %s", callback_address.to_string().c_str());
+        dispatcher = xvnode_dispatcher_t::create(callback_address, XGET_CONFIG(vnode_dispatch_threads), XGET_CONFIG(vnode_dispatch_queue_size));
+    }
+    return dispatcher;
+}
+
+void xtop_vhost::remove_unregistered_dispatchers() {
+    std::vector<xvnode_dispatcher_ptr_t> removed;
+    {
+        std::lock_guard<std::mutex> callbacks_lock{m_callbacks_mutex};
+        std::lock_guard<std::mutex> dispatchers_lock{m_dispatchers_mutex};
+        for (auto it = m_dispatchers.begin(); it != m_dispatchers.end();) {
+            if (m_callbacks.find(it->first) == m_callbacks.end()) {
+                removed.push_back(std::move(it->second));
+                it = m_dispatchers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (auto const & dispatcher : removed) {
+        xinfo("[vnetwork] remove dispatcher for address %s, %" PRIu64 " delivered %" PRIu64 " dropped",
+              dispatcher->address().to_string().c_str(),
+              dispatcher->delivered(),
+              dispatcher->dropped());
+        dispatcher->stop();
+    }
+}
+
+void xtop_vhost::stop_dispatchers() {
+    std::unordered_map<common::xnode_address_t, xvnode_dispatcher_ptr_t> dispatchers;
+    {
+        std::lock_guard<std::mutex> lock{m_dispatchers_mutex};
+        dispatchers.swap(m_dispatchers);
+    }
+    for (auto const & dispatcher : dispatchers) {
+        dispatcher.second->stop();
+    }
+}
+
 NS_END2
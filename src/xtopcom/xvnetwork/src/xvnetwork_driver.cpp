@@ -71,8 +71,9 @@ void xtop_vnetwork_driver::send_to(common::xnode_address_t const & to, xmessage_
     assert(!ec);
     assert(m_vhost);
     #if VHOST_METRICS
-    XMETRICS_COUNTER_INCREMENT("vnetwork_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id()))) + "_out_vnetwork_driver_send_to" +
-                                   std::to_string(static_cast<std::uint32_t>(message.id())),
+    XMETRICS_COUNTER_INCREMENT("vnetwork_out_vnetwork_driver_send_to" +
+        top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(message.id())))},
+                                      {"message_id", std::to_string(static_cast<std::uint32_t>(message.id()))}}),
                                1);
     #endif
     m_vhost->send_to(m_address, to, message, ec);
@@ -395,8 +396,9 @@ void xtop_vnetwork_driver::on_vhost_message_data_ready(common::xnode_address_t c
     }
 
     #if VHOST_METRICS
-    XMETRICS_COUNTER_INCREMENT("vnetwork_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(msg.id()))) + "_in_vnetwork_driver_filtered" +
-                                   std::to_string(static_cast<std::uint32_t>(msg.id())),
+    XMETRICS_COUNTER_INCREMENT("vnetwork_in_vnetwork_driver_filtered" +
+        top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(msg.id())))},
+                                      {"message_id", std::to_string(static_cast<std::uint32_t>(msg.id()))}}),
                                1);
 
     XMETRICS_COUNTER_INCREMENT("vnetwork_driver_received", 1);
@@ -420,8 +422,9 @@ void xtop_vnetwork_driver::on_vhost_message_data_ready(common::xnode_address_t c
 
     if (callback) {
         #if VHOST_METRICS
-        XMETRICS_COUNTER_INCREMENT("vnetwork_" + std::to_string(static_cast<std::uint16_t>(common::get_message_category(msg.id()))) + "_in_vnetwork_driver_callback" +
-                                       std::to_string(static_cast<std::uint32_t>(msg.id())),
+        XMETRICS_COUNTER_INCREMENT("vnetwork_in_vnetwork_driver_callback" +
+            top::metrics::metrics_labels({{"category", std::to_string(static_cast<std::uint16_t>(common::get_message_category(msg.id())))},
+                                          {"message_id", std::to_string(static_cast<std::uint32_t>(msg.id()))}}),
                                    1);
         #endif
 
@@ -0,0 +1,151 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xvnetwork/xvnode_dispatcher.h"
+
+#include "xbase/xlog.h"
+#include "xbasic/xthreading/xbackend_thread.hpp"
+#include "xcommon/xnode_type.h"
+#include "xmetrics/xmetrics.h"
+
+#include <cassert>
+#include <cinttypes>
+
+NS_BEG2(top, vnetwork)
+
+xvnode_dispatcher_ptr_t xtop_vnode_dispatcher::create(xvnode_address_t const & address, std::size_t thread_count, std::size_t const max_queue_size) {
+    auto dispatcher = std::make_shared<xtop_vnode_dispatcher>(address, max_queue_size);
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threading::xbackend_thread::spawn([dispatcher] { dispatcher->run(); });
+    }
+    return dispatcher;
+}
+
+xtop_vnode_dispatcher::xtop_vnode_dispatcher(xvnode_address_t const & address, std::size_t const max_queue_size)
+  : m_address{address}, m_max_queue_size{max_queue_size}, m_last_export{std::chrono::steady_clock::now()} {
+    if (m_max_queue_size == 0) {
+        m_max_queue_size = 1;
+    }
+#ifdef ENABLE_METRICS
+    m_metrics_labels = metrics::metrics_labels({{"vnode", common::to_string(m_address.type())}});
+#endif
+}
+
+bool xtop_vnode_dispatcher::push(xmessage_ready_callback_t const & callback,
+                                 xvnode_address_t const & sender,
+                                 xmessage_t const & message,
+                                 std::uint64_t const logic_time) {
+    assert(callback != nullptr);
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_running) {
+            return false;
+        }
+        if (m_queue.size() >= m_max_queue_size) {
+            ++m_dropped;
+            xwarn("[vnetwork] vnode %s dispatch queue full, drop msg %" PRIx32 " hash %" PRIx64,
+                  m_address.to_string().c_str(),
+                  static_cast<std::uint32_t>(message.id()),
+                  message.hash());
+            return false;
+        }
+        m_queue.push_back(xqueued_message_t{callback, sender, message, logic_time, std::chrono::steady_clock::now()});
+    }
+    m_not_empty.notify_one();
+    return true;
+}
+
+void xtop_vnode_dispatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_dropped += m_queue.size();
+        m_queue.clear();
+    }
+    m_not_empty.notify_all();
+}
+
+xvnode_address_t const & xtop_vnode_dispatcher::address() const noexcept {
+    return m_address;
+}
+
+std::size_t xtop_vnode_dispatcher::backlog() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_queue.size();
+}
+
+uint64_t xtop_vnode_dispatcher::delivered() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_delivered;
+}
+
+uint64_t xtop_vnode_dispatcher::dropped() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_dropped;
+}
+
+void xtop_vnode_dispatcher::run() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (m_running) {
+        m_not_empty.wait_for(lock, std::chrono::seconds(1), [this] { return !m_running || !m_queue.empty(); });
+        auto const now = std::chrono::steady_clock::now();
+        if (now - m_last_export >= std::chrono::seconds(1)) {
+            export_metrics(now);
+        }
+        if (!m_running || m_queue.empty()) {
+            continue;
+        }
+
+        xqueued_message_t queued = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+
+        auto const begin = std::chrono::steady_clock::now();
+        auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(begin - queued.enqueued);
+        try {
+            XMETRICS_GAUGE(metrics::vhost_recv_callback, 1);
+            queued.callback(queued.sender, queued.message, queued.logic_time);
+        } catch (std::exception const & eh) {
+            xerror("[vnetwork] exception caught from callback at address %s: %s", m_address.to_string().c_str(), eh.what());
+        }
+        auto const handle = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        XMETRICS_HISTOGRAM(metrics::vhost_dispatch_wait_hist, static_cast<uint64_t>(wait.count()));
+        XMETRICS_HISTOGRAM(metrics::vhost_dispatch_handle_hist, static_cast<uint64_t>(handle.count()));
+
+        lock.lock();
+        ++m_delivered;
+        auto & max_wait = m_max_wait[static_cast<std::uint32_t>(queued.message.id())];
+        if (wait > max_wait) {
+            max_wait = wait;
+        }
+    }
+}
+
+// called with the lock held, once a second at most
+void xtop_vnode_dispatcher::export_metrics(std::chrono::steady_clock::time_point const now) {
+    m_last_export = now;
+#ifdef ENABLE_METRICS
+    XMETRICS_COUNTER_SET("vhost_dispatch_backlog" + m_metrics_labels, static_cast<int64_t>(m_queue.size()));
+    XMETRICS_COUNTER_SET("vhost_dispatch_delivered" + m_metrics_labels, static_cast<int64_t>(m_delivered));
+    XMETRICS_COUNTER_SET("vhost_dispatch_dropped" + m_metrics_labels, static_cast<int64_t>(m_dropped));
+    for (auto const & max_wait : m_max_wait) {
+        char message_id[16] = {0};
+        snprintf(message_id, sizeof(message_id), "%" PRIx32, max_wait.first);
+        XMETRICS_COUNTER_SET("vhost_dispatch_max_wait_us" +
+                                 metrics::metrics_labels({{"vnode", common::to_string(m_address.type())}, {"message_id", message_id}}),
+                             static_cast<int64_t>(max_wait.second.count()));
+    }
+#endif
+    for (auto & max_wait : m_max_wait) {
+        max_wait.second = std::chrono::microseconds{0};
+    }
+}
+
+NS_END2
@@ -6,6 +6,7 @@
 
 #include "xcommon/xcodec/xmsgpack/xnode_address_codec.hpp"
 #include "xvnetwork/xcodec/xmsgpack/xmessage_codec.hpp"
+#include "xvnetwork/xpayload_compression.h"
 #include "xvnetwork/xvnetwork_message.h"
 
 #include <msgpack.hpp>
@@ -19,6 +20,7 @@ XINLINE_CONSTEXPR std::size_t xvnetwork_message_sender_index{ 0 };
 XINLINE_CONSTEXPR std::size_t xvnetwork_message_receiver_index{ 1 };
 XINLINE_CONSTEXPR std::size_t xvnetwork_message_message_index{ 2 };
 XINLINE_CONSTEXPR std::size_t xvnetwork_message_logic_time_index{ 3 };
+XINLINE_CONSTEXPR std::size_t xvnetwork_message_payload_encoding_index{ 4 };  // only packed when the payload is compressed
 
 template <>
 struct convert<top::vnetwork::xvnetwork_message_t> final
@@ -36,12 +38,18 @@ struct convert<top::vnetwork::xvnetwork_message_t> final
         top::common::xnode_address_t sender, receiver;
         top::vnetwork::xmessage_t msg;
         top::common::xlogic_time_t logic_time{top::common::xjudgement_day};
+        auto payload_encoding = top::vnetwork::xpayload_encoding_t::raw;
 
         switch (o.via.array.size - 1) {
             default: {
                 XATTRIBUTE_FALLTHROUGH;
             }
 
+            case xvnetwork_message_payload_encoding_index: {
+                payload_encoding = static_cast<top::vnetwork::xpayload_encoding_t>(o.via.array.ptr[xvnetwork_message_payload_encoding_index].as<std::uint8_t>());
+                XATTRIBUTE_FALLTHROUGH;
+            }
+
             case xvnetwork_message_logic_time_index: {
                 logic_time = o.via.array.ptr[xvnetwork_message_logic_time_index].as<top::common::xlogic_time_t>();
                 XATTRIBUTE_FALLTHROUGH;
@@ -63,6 +71,14 @@ struct convert<top::vnetwork::xvnetwork_message_t> final
             }
         }
 
+        if (payload_encoding != top::vnetwork::xpayload_encoding_t::raw) {
+            top::xbyte_buffer_t payload;
+            if (!top::vnetwork::decompress_payload(payload_encoding, msg.payload(), payload)) {
+                throw msgpack::type_error{};
+            }
+            msg = top::vnetwork::xmessage_t{ std::move(payload), msg.id() };
+        }
+
         v = top::vnetwork::xvnetwork_message_t{ sender, receiver, msg, logic_time };
 
         return o;
@@ -75,11 +91,22 @@ struct pack<top::vnetwork::xvnetwork_message_t>
     template <typename Stream>
     msgpack::packer<Stream> &
     operator()(msgpack::packer<Stream> & o, top::vnetwork::xvnetwork_message_t const & message) const {
-        o.pack_array(xvnetwork_message_field_count);
-        o.pack(message.sender());
-        o.pack(message.receiver());
-        o.pack(message.message());
-        o.pack(message.logic_time());
+        top::xbyte_buffer_t compressed;
+        auto const payload_encoding = top::vnetwork::compress_payload(message.message().payload(), compressed);
+        if (payload_encoding == top::vnetwork::xpayload_encoding_t::raw) {
+            o.pack_array(xvnetwork_message_field_count);
+            o.pack(message.sender());
+            o.pack(message.receiver());
+            o.pack(message.message());
+            o.pack(message.logic_time());
+        } else {
+            o.pack_array(xvnetwork_message_field_count + 1);
+            o.pack(message.sender());
+            o.pack(message.receiver());
+            o.pack(top::vnetwork::xmessage_t{ std::move(compressed), message.message().id() });
+            o.pack(message.logic_time());
+            o.pack(static_cast<std::uint8_t>(payload_encoding));
+        }
 
         return o;
     }
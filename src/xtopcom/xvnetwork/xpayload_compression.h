@@ -0,0 +1,36 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xbasic/xbyte_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+NS_BEG2(top, vnetwork)
+
+/// @brief How the payload of an xvnetwork_message_t is encoded on the wire. Carried as the fifth field of the message,
+///        absent when the payload is sent as is, so messages sent uncompressed are what older nodes expect.
+enum class xenum_payload_encoding : std::uint8_t {
+    raw = 0,
+    lz4 = 1,
+};
+using xpayload_encoding_t = xenum_payload_encoding;
+
+/// @brief Sending side switch of the payload compression. Every node decompresses; compression is only turned on,
+///        by the vnetwork_payload_compression config, after all peers run a version that decompresses.
+void enable_payload_compression(bool enable, std::size_t threshold);
+bool payload_compression_enabled() noexcept;
+
+/// @brief Compresses payload into compressed when compression is enabled, payload is at least the threshold and
+///        compressing saves space. compressed holds the original size followed by the lz4 block.
+/// @return lz4 if compressed is filled, raw if payload is to be sent as is.
+xpayload_encoding_t compress_payload(xbyte_buffer_t const & payload, xbyte_buffer_t & compressed);
+
+/// @brief Restores a payload received with encoding.
+/// @return false if encoding is unknown or the payload is corrupted.
+bool decompress_payload(xpayload_encoding_t encoding, xbyte_buffer_t const & compressed, xbyte_buffer_t & payload);
+
+NS_END2
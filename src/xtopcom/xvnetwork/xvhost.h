@@ -13,9 +13,11 @@
 #include "xvnetwork/xmessage.h"
 #include "xvnetwork/xmessage_filter_manager_face.h"
 #include "xvnetwork/xvnetwork_message.h"
+#include "xvnetwork/xvnode_dispatcher.h"
 
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #if defined DEBUG
 #    include <thread>
 #endif
@@ -29,10 +31,15 @@ private:
     using base_t = xbasic_vhost_t;
 
     constexpr static std::size_t max_message_queue_size{100000};
-    threading::xthreadsafe_queue<xbyte_buffer_t, std::vector<xbyte_buffer_t>> m_message_queue{max_message_queue_size};
+    // decoded messages already passed the filters
+    threading::xthreadsafe_queue<xvnetwork_message_t, std::vector<xvnetwork_message_t>> m_message_queue{max_message_queue_size};
     
     std::unique_ptr<xmessage_filter_manager_face_t> m_filter_manager;
 
+    // one dispatcher per callback address, so the messages of the vnodes are delivered independently
+    mutable std::mutex m_dispatchers_mutex{};
+    std::unordered_map<common::xnode_address_t, xvnode_dispatcher_ptr_t> m_dispatchers{};
+
 #if defined DEBUG
     std::thread::id m_vhost_thread_id{};
 #endif
@@ -84,6 +91,12 @@ private:
     void on_network_data_ready(common::xaccount_address_t const & account_address, xbyte_buffer_t const & bytes);
 
     void do_handle_network_data();
+
+    xvnode_dispatcher_ptr_t dispatcher_of(common::xnode_address_t const & callback_address);
+
+    void remove_unregistered_dispatchers();
+
+    void stop_dispatchers();
 };
 using xvhost_t = xtop_vhost;
 
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xvnetwork/xaddress.h"
+#include "xvnetwork/xmessage.h"
+#include "xvnetwork/xmessage_ready_callback.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+NS_BEG2(top, vnetwork)
+
+/* delivers the messages of one vnode (one registered callback address of vhost) on threads of its own.
+ * the vhost thread only enqueues, so a slow handler of one role (validator, auditor, edge...) doesn't hold up the messages of the others.
+ * with one thread the messages are delivered in arrival order. a full queue drops the pushed message.
+ * the threads keep the dispatcher alive until stop(), which doesn't wait for the message being delivered.
+ */
+class xtop_vnode_dispatcher : public std::enable_shared_from_this<xtop_vnode_dispatcher> {
+public:
+    static std::shared_ptr<xtop_vnode_dispatcher> create(xvnode_address_t const & address, std::size_t thread_count, std::size_t max_queue_size);
+
+    xtop_vnode_dispatcher(xvnode_address_t const & address, std::size_t max_queue_size);
+    xtop_vnode_dispatcher(xtop_vnode_dispatcher const &) = delete;
+    xtop_vnode_dispatcher & operator=(xtop_vnode_dispatcher const &) = delete;
+    ~xtop_vnode_dispatcher() = default;
+
+    /// @brief Queues the message for the callback, the one registered at the time the message arrives.
+    /// @return false if the dispatcher is stopped or its queue is full.
+    bool push(xmessage_ready_callback_t const & callback, xvnode_address_t const & sender, xmessage_t const & message, std::uint64_t const logic_time);
+
+    /// @brief Drops the queued messages, the threads quit after the message being delivered.
+    void stop();
+
+    xvnode_address_t const & address() const noexcept;
+
+    // monitor functions
+    std::size_t backlog() const;
+    uint64_t delivered() const;
+    uint64_t dropped() const;
+
+private:
+    struct xqueued_message_t {
+        xmessage_ready_callback_t callback;
+        xvnode_address_t sender;
+        xmessage_t message;
+        std::uint64_t logic_time;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    void run();
+    void export_metrics(std::chrono::steady_clock::time_point const now);
+
+    xvnode_address_t const m_address;
+    std::size_t m_max_queue_size;
+    std::string m_metrics_labels;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::deque<xqueued_message_t> m_queue;
+    bool m_running{true};
+    uint64_t m_delivered{0};
+    uint64_t m_dropped{0};
+    std::unordered_map<std::uint32_t, std::chrono::microseconds> m_max_wait;  // message id -> longest wait since the last export
+    std::chrono::steady_clock::time_point m_last_export;
+};
+using xvnode_dispatcher_t = xtop_vnode_dispatcher;
+using xvnode_dispatcher_ptr_t = std::shared_ptr<xvnode_dispatcher_t>;
+
+NS_END2
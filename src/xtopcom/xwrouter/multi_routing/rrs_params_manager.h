@@ -25,11 +25,13 @@ public:
 
 private:
     void update_rrs_params_with_node_size();
+    uint32_t adjust_switch_hop_num_with_duplicate_ratio(uint32_t params_k);
 
 private:
     std::function<void(uint64_t & node_size, std::error_code & ec)> m_callback;
     base::TimerManager * timer_manager_{base::TimerManager::Instance()};
     std::shared_ptr<base::TimerRepeated> update_rrs_params_timer;
+    int32_t m_switch_hop_offset{0};
 };
 
 }  // namespace wrouter
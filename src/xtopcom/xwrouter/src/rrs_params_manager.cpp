@@ -5,12 +5,18 @@
 #include "xwrouter/multi_routing/rrs_params_manager.h"
 
 #include "assert.h"
+#include "xgossip/include/gossip_filter.h"
 #include "xwrouter/xwrouter.h"
 
 namespace top {
 namespace wrouter {
 
 static const int32_t kUpdateRegisterNodeSizePeriod = 5 * 60 * 1000 * 1000; // 5min
+// feedback of the full body duplicate ratio on the body push hops, bounded around the simulated best params
+static const uint64_t kDuplicateStatMinReceived = 1000u;
+static const uint64_t kDuplicateRatioHighPercent = 80u;
+static const uint64_t kDuplicateRatioLowPercent = 50u;
+static const int32_t kMaxSwitchHopOffset = 1;
 
 bool RRSParamsMgr::set_callback(std::function<void(uint64_t & node_size, std::error_code & ec)> cb) {
     if (m_callback) {
@@ -64,9 +70,29 @@ void RRSParamsMgr::update_rrs_params_with_node_size() {
 
 #    undef RRS
 #endif
+    default_params_k = adjust_switch_hop_num_with_duplicate_ratio(default_params_k);
     xinfo("update_rrs_params_with_node_size, node_size: %llu, t: %u, k: %u", node_size, default_params_t, default_params_k);
     wrouter::Wrouter::Instance()->update_rrs_params(default_params_t, default_params_k);
 }
 
+uint32_t RRSParamsMgr::adjust_switch_hop_num_with_duplicate_ratio(uint32_t params_k) {
+    uint64_t received = 0;
+    uint64_t duplicated = 0;
+    gossip::GossipFilter::Instance()->TakeBodyReceiptStat(received, duplicated);
+    if (received >= kDuplicateStatMinReceived) {
+        auto const ratio = duplicated * 100 / received;
+        // too many copies of the body wastes bandwidth, push less and let the rest pull it by hash.
+        // few copies means pushing is cheap, push more hops for lower latency.
+        if (ratio > kDuplicateRatioHighPercent && m_switch_hop_offset > -kMaxSwitchHopOffset) {
+            --m_switch_hop_offset;
+        } else if (ratio < kDuplicateRatioLowPercent && m_switch_hop_offset < kMaxSwitchHopOffset) {
+            ++m_switch_hop_offset;
+        }
+        xinfo("adjust_switch_hop_num_with_duplicate_ratio, received: %llu, duplicated: %llu, ratio: %llu%%, offset: %d", received, duplicated, ratio, m_switch_hop_offset);
+    }
+    auto const adjusted = static_cast<int32_t>(params_k) + m_switch_hop_offset;
+    return adjusted < 1 ? 1u : static_cast<uint32_t>(adjusted);
+}
+
 }  // namespace wrouter
 }  // namespace top
\ No newline at end of file
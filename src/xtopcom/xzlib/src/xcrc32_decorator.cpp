@@ -4,6 +4,7 @@
 
 #include "xcodec/xcodec_error.h"
 #include "xzlib/xdecorators/xcrc32_decorator.h"
+#include "xutility/xchecksum.h"
 
 #include <cstring>
 #include <limits>
@@ -22,9 +23,8 @@ static
 std::uint32_t
 calc_crc(xbyte_t const * data, std::size_t const size)
 {
-    return static_cast<std::uint32_t>(crc32(crc32(0, nullptr, 0),
-                                            static_cast<const Bytef*>(data),
-                                            static_cast<uInt>(size)));
+    // same value as zlib's crc32, folded with pclmulqdq where the cpu has it
+    return utl::crc32(0, data, size);
 }
 
 xbyte_buffer_t
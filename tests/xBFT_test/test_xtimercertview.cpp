@@ -13,16 +13,24 @@ using namespace top::data;
 using namespace top::base;
 using namespace top::xconsensus;
 
+// node of a 4 nodes group as the election encodes it
+static xvip2_t group_node_xip(uint32_t node_id, uint64_t group_id = 1) {
+    xvip2_t xip;
+    xip.high_addr = (((uint64_t)4) << 54) | 1;
+    xip.low_addr = (group_id << 10) | node_id;
+    return xip;
+}
+
 TEST(xconspacemaker_t, cache_one_node) {
     xvote_cache_t cache;
 
     uint64_t clock = 1;
-    xvip2_t xip1;
+    xvip2_t xip1 = group_node_xip(0);
     std::string qcert_bin1 = "123";
 
     ASSERT_TRUE(cache.add_qcert(xip1, clock, qcert_bin1));
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 1);
     }
     ASSERT_FALSE(cache.add_qcert(xip1, clock, qcert_bin1));
@@ -31,24 +39,24 @@ TEST(xconspacemaker_t, cache_one_node) {
     ASSERT_TRUE(cache.add_qcert(xip1, clock+3, qcert_bin1));
 
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 1);
     }
 
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock+1);
+        const xvote_set_t& validators = cache.get_clock_votes(clock+1);
         ASSERT_EQ(validators.size(), 1);
     }
 
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock+2);
+        const xvote_set_t& validators = cache.get_clock_votes(clock+2);
         ASSERT_EQ(validators.size(), 1);
     }
 
     cache.clear();
     ASSERT_TRUE(cache.add_qcert(xip1, clock, qcert_bin1));
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 1);
     }
 }
@@ -57,52 +65,79 @@ TEST(xconspacemaker_t, cache_multi_node) {
     xvote_cache_t cache;
 
     uint64_t clock = 1;
-    xvip2_t xip1;
+    xvip2_t xip1 = group_node_xip(0);
     std::string qcert_bin1 = "123";
 
-    xvip2_t xip2;
-    xip2.high_addr = 2;
+    xvip2_t xip2 = group_node_xip(1);
     std::string qcert_bin2 = "456";
 
     ASSERT_TRUE(cache.add_qcert(xip1, clock, qcert_bin1));
     ASSERT_TRUE(cache.add_qcert(xip2, clock, qcert_bin2));
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 2);
-        const std::string &str1 = validators.at(xip1);
-        ASSERT_EQ(str1, qcert_bin1);
-
-        const std::string &str2 = validators.at(xip2);
-        ASSERT_EQ(str2, qcert_bin2);
+        ASSERT_TRUE(validators.contains(xip1));
+        ASSERT_TRUE(validators.contains(xip2));
+        ASSERT_EQ(validators.signatures(), (std::vector<std::string>{qcert_bin1, qcert_bin2}));
     }
 
     ASSERT_TRUE(cache.add_qcert(xip1, clock+1, qcert_bin1));
     ASSERT_TRUE(cache.add_qcert(xip2, clock+1, qcert_bin2));
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock+1);
+        const xvote_set_t& validators = cache.get_clock_votes(clock+1);
         ASSERT_EQ(validators.size(), 2);
-
-        const std::string &str1 = validators.at(xip1);
-        ASSERT_EQ(str1, qcert_bin1);
-
-        const std::string &str2 = validators.at(xip2);
-        ASSERT_EQ(str2, qcert_bin2);
+        ASSERT_TRUE(validators.contains(xip1));
+        ASSERT_TRUE(validators.contains(xip2));
+        ASSERT_EQ(validators.signatures(), (std::vector<std::string>{qcert_bin1, qcert_bin2}));
     }
 
     cache.clear();
     ASSERT_TRUE(cache.add_qcert(xip1, clock, qcert_bin1));
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 1);
     }
 }
 
+TEST(xconspacemaker_t, cache_other_group) {
+    xvote_cache_t cache;
+
+    uint64_t clock = 1;
+    ASSERT_TRUE(cache.add_qcert(group_node_xip(0), clock, "123"));
+    // merge_muti_sign takes signatures of one group only
+    ASSERT_FALSE(cache.add_qcert(group_node_xip(1, 2), clock, "456"));
+    // node id beyond the group size
+    ASSERT_FALSE(cache.add_qcert(group_node_xip(4), clock, "789"));
+    ASSERT_TRUE(cache.add_qcert(group_node_xip(1), clock, "456"));
+    ASSERT_EQ(cache.get_clock_votes(clock).size(), 2);
+}
+
+TEST(xvote_set_t, insert_and_merge_order) {
+    xvote_set_t votes;
+    ASSERT_TRUE(votes.empty());
+    ASSERT_TRUE(votes.insert(group_node_xip(3), "d"));
+    ASSERT_TRUE(votes.insert(group_node_xip(1), "b"));
+    ASSERT_FALSE(votes.insert(group_node_xip(1), "b2"));
+    ASSERT_TRUE(votes.reached(2));
+    ASSERT_FALSE(votes.reached(3));
+
+    auto const voters = votes.voters();
+    ASSERT_EQ(voters.size(), 2);
+    ASSERT_EQ(voters[0].low_addr, group_node_xip(1).low_addr);
+    ASSERT_EQ(voters[1].low_addr, group_node_xip(3).low_addr);
+    ASSERT_EQ(votes.signatures(), (std::vector<std::string>{"b", "d"}));
+
+    votes.clear();
+    ASSERT_FALSE(votes.contains(group_node_xip(1)));
+    ASSERT_TRUE(votes.insert(group_node_xip(0, 2), "a"));
+}
+
 #if 0
 TEST(xconspacemaker_t, cache_clear_timeout) {
     xvote_cache_t cache;
 
     uint64_t clock = 1;
-    xvip2_t xip1;
+    xvip2_t xip1 = group_node_xip(0);
     std::string qcert_bin1 = "123";
 
     ASSERT_TRUE(cache.add_qcert(xip1, clock, qcert_bin1));
@@ -110,7 +145,7 @@ TEST(xconspacemaker_t, cache_clear_timeout) {
     cache.clear_timeout_clock();
 
     {
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
         ASSERT_EQ(validators.size(), 1);
     }
 
@@ -121,7 +156,7 @@ TEST(xconspacemaker_t, cache_clear_timeout) {
 
         cache.clear_timeout_clock();
 
-        const std::map<xvip2_t,std::string,xvip2_compare>& validators = cache.get_clock_votes(clock);
+        const xvote_set_t& validators = cache.get_clock_votes(clock);
 
         if (validators.size() == 0)
             break;
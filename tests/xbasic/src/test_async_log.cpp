@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xasync_log.h"
+
+#include <gtest/gtest.h>
+
+#include <cinttypes>
+#include <cstdint>
+#include <string>
+
+using top::basic::details::xlog_capture;
+using top::basic::details::xlog_format;
+using top::basic::details::xlog_record_t;
+
+TEST(xbasic, async_log_formats_captured_arguments) {
+    xlog_record_t record;
+    {
+        std::string const account{"T00000LhCXUC5iQCREefnRPRFhxwDJTEbufi41EL"};
+        char buffer[8] = "table";
+        uint64_t const height = 12345678901234ULL;
+        ASSERT_TRUE(xlog_capture(record, enum_xlog_level_info, "xtest", "%s %s height:%" PRIu64 " %d %.2f %s", account.c_str(), static_cast<char const *>(buffer), height, -7, 0.5, static_cast<char const *>(nullptr)));
+        // the strings are copied, the caller may free them before the record is formatted
+    }
+
+    char text[256];
+    xlog_format(record, text, sizeof(text));
+    EXPECT_EQ(std::string{"T00000LhCXUC5iQCREefnRPRFhxwDJTEbufi41EL table height:12345678901234 -7 0.50 (null)"}, text);
+    EXPECT_EQ(enum_xlog_level_info, record.level);
+    EXPECT_EQ(std::string{"xtest"}, record.module);
+}
+
+TEST(xbasic, async_log_rejects_arguments_over_capacity) {
+    xlog_record_t record;
+    std::string const big(xlog_record_t::payload_capacity, 'x');
+    EXPECT_FALSE(xlog_capture(record, enum_xlog_level_info, "xtest", "%s", big.c_str()));
+
+    ASSERT_TRUE(xlog_capture(record, enum_xlog_level_info, "xtest", "no arguments %%"));
+    char text[64];
+    xlog_format(record, text, sizeof(text));
+    EXPECT_EQ(std::string{"no arguments %"}, text);
+}
+
+TEST(xbasic, async_log_level) {
+    auto & log = top::basic::xasync_log_t::instance();
+    log.set_level(enum_xlog_level_warn);
+    EXPECT_FALSE(log.enabled(enum_xlog_level_info));
+    EXPECT_TRUE(log.enabled(enum_xlog_level_warn));
+    EXPECT_TRUE(log.enabled(enum_xlog_level_error));
+    log.set_level(enum_xlog_level_debug);
+    EXPECT_TRUE(log.enabled(enum_xlog_level_debug));
+}
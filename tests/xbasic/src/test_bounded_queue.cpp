@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xbounded_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(xbasic, bounded_queue_order_and_drop) {
+    top::threading::xbounded_queue<int> queue{5};
+    EXPECT_EQ(8u, queue.capacity());
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i < 8, queue.push(i));
+    }
+    EXPECT_EQ(8u, queue.unsafe_size());
+    EXPECT_EQ(2u, queue.dropped());
+
+    auto values = queue.wait_and_pop_all();
+    ASSERT_EQ(8u, values.size());
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(i, values[i]);
+    }
+    int value{0};
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(0u, queue.unsafe_size());
+}
+
+TEST(xbasic, bounded_queue_batch) {
+    top::threading::xbounded_queue<std::unique_ptr<int>> queue{4};
+    std::vector<std::unique_ptr<int>> input;
+    for (int i = 0; i < 6; ++i) {
+        input.emplace_back(new int{i});
+    }
+    EXPECT_EQ(4u, queue.push_batch(input.begin(), input.end()));
+    EXPECT_EQ(2u, queue.dropped());
+
+    std::vector<std::unique_ptr<int>> output;
+    EXPECT_EQ(3u, queue.try_pop_batch(output, 3));
+    EXPECT_EQ(1u, queue.try_pop_batch(output, 3));
+    EXPECT_EQ(0u, queue.try_pop_batch(output, 3));
+    ASSERT_EQ(4u, output.size());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(i, *output[i]);
+    }
+
+    // the ring wraps around
+    for (int round = 0; round < 3; ++round) {
+        EXPECT_TRUE(queue.push(std::unique_ptr<int>(new int{round})));
+        EXPECT_EQ(round, *queue.wait_and_pop());
+    }
+}
+
+TEST(xbasic, bounded_queue_multiple_producers_and_consumers) {
+    top::threading::xbounded_queue<int> queue{1024};
+    int const producer_count = 4;
+    int const consumer_count = 2;
+    int const push_count = 50000;
+    // every producer pushes 1..push_count and retries when full, so nothing is lost
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumer_count; ++c) {
+        threads.emplace_back([&]() {
+            for (;;) {
+                int const value = queue.wait_and_pop();
+                if (value == 0) {
+                    return;
+                }
+                sum += value;
+                ++popped;
+            }
+        });
+    }
+    for (int p = 0; p < producer_count; ++p) {
+        threads.emplace_back([&queue, push_count]() {
+            for (int i = 1; i <= push_count; ++i) {
+                while (!queue.push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int p = 0; p < producer_count; ++p) {
+        threads[consumer_count + p].join();
+    }
+    for (int c = 0; c < consumer_count; ++c) {
+        while (!queue.push(0)) {
+            std::this_thread::yield();
+        }
+    }
+    for (int c = 0; c < consumer_count; ++c) {
+        threads[c].join();
+    }
+
+    EXPECT_EQ(producer_count * push_count, popped.load());
+    EXPECT_EQ(static_cast<long long>(producer_count) * push_count * (push_count + 1) / 2, sum.load());
+}
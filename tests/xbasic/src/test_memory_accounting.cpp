@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xmemory_accounting.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+using top::basic::xmemory_accounting_t;
+using top::basic::xmemory_usage_t;
+
+TEST(xbasic, memory_accounting_sums_reporters_of_subsystem) {
+    xmemory_accounting_t accounting;
+    accounting.add_reporter("cache", [] { return xmemory_usage_t{300, 3}; });
+    auto const id = accounting.add_reporter("cache", [] { return xmemory_usage_t{100, 1}; });
+    accounting.add_reporter("pool", [] { return xmemory_usage_t{50, 5}; });
+
+    auto usages = accounting.usages();
+    ASSERT_EQ(2u, usages.size());
+    EXPECT_EQ("cache", usages[0].name);
+    EXPECT_EQ(400u, usages[0].bytes);
+    EXPECT_EQ(4u, usages[0].objects);
+    EXPECT_FALSE(usages[0].shrinkable);
+    EXPECT_EQ("pool", usages[1].name);
+    EXPECT_EQ(50u, usages[1].bytes);
+
+    // a removed reporter is no longer called, its subsystem stays listed
+    accounting.remove_reporter(id);
+    usages = accounting.usages();
+    EXPECT_EQ(300u, usages[0].bytes);
+}
+
+TEST(xbasic, memory_accounting_shrinks_over_soft_limit) {
+    xmemory_accounting_t accounting;
+    uint64_t first_target = 0;
+    uint64_t second_target = 0;
+    accounting.add_reporter("cache", [] { return xmemory_usage_t{300, 3}; }, [&](uint64_t const target) { first_target = target; });
+    accounting.add_reporter("cache", [] { return xmemory_usage_t{100, 1}; }, [&](uint64_t const target) { second_target = target; });
+
+    // no limit, nothing shrinks
+    accounting.enforce_soft_limits();
+    EXPECT_EQ(0u, first_target);
+
+    // each reporter keeps its share of the limit
+    accounting.set_soft_limit("cache", 200);
+    auto usages = accounting.enforce_soft_limits();
+    ASSERT_EQ(1u, usages.size());
+    EXPECT_EQ(200u, usages[0].soft_limit);
+    EXPECT_TRUE(usages[0].shrinkable);
+    EXPECT_EQ(150u, first_target);
+    EXPECT_EQ(50u, second_target);
+    EXPECT_EQ(1u, accounting.usages()[0].shrinks);
+
+    // under the limit nothing shrinks again
+    first_target = 0;
+    accounting.set_soft_limit("cache", 1000);
+    accounting.enforce_soft_limits();
+    EXPECT_EQ(0u, first_target);
+    EXPECT_EQ(1u, accounting.usages()[0].shrinks);
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xmpsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST(xbasic, mpsc_queue_order) {
+    top::threading::xmpsc_queue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.pop_all().empty());
+
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    EXPECT_EQ(10u, queue.size());
+
+    auto values = queue.pop_all();
+    ASSERT_EQ(10u, values.size());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, values[i]);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0u, queue.size());
+}
+
+TEST(xbasic, mpsc_queue_multiple_producers) {
+    top::threading::xmpsc_queue<std::pair<int, int>> queue;
+    int const producer_count = 4;
+    int const push_count = 10000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p) {
+        producers.emplace_back([&queue, p, push_count]() {
+            for (int i = 0; i < push_count; ++i) {
+                queue.push(std::make_pair(p, i));
+            }
+        });
+    }
+
+    // consume while producing, every producer's items must come out in its push order
+    std::vector<int> next_expected(producer_count, 0);
+    int received = 0;
+    while (received < producer_count * push_count) {
+        for (auto & v : queue.pop_all()) {
+            ASSERT_EQ(next_expected[v.first], v.second);
+            ++next_expected[v.first];
+            ++received;
+        }
+    }
+    for (auto & t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xobject_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct xpooled_base_t {
+    XDECLARE_POOLED_NEW_DELETE
+    virtual ~xpooled_base_t() = default;
+    uint64_t value{0};
+};
+
+struct xpooled_derived_t : public xpooled_base_t {
+    char payload[200];
+};
+
+}  // namespace
+
+TEST(xbasic, object_pool_reuses_blocks) {
+    void * first = top::basic::xobject_pool_t::allocate(40);
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) % 16);
+    top::basic::xobject_pool_t::deallocate(first, 40);
+    // the block just freed is on top of the thread's list of its class
+    void * second = top::basic::xobject_pool_t::allocate(48);
+    EXPECT_EQ(first, second);
+    top::basic::xobject_pool_t::deallocate(second, 48);
+
+    // sizes above the pooled ones go to the global heap
+    void * large = top::basic::xobject_pool_t::allocate(top::basic::xobject_pool_t::max_pooled_size + 1);
+    ASSERT_NE(nullptr, large);
+    top::basic::xobject_pool_t::deallocate(large, top::basic::xobject_pool_t::max_pooled_size + 1);
+}
+
+TEST(xbasic, object_pool_distinct_blocks) {
+    std::vector<void *> blocks;
+    std::set<void *> unique;
+    for (int i = 0; i < 1000; ++i) {
+        blocks.push_back(top::basic::xobject_pool_t::allocate(64));
+        unique.insert(blocks.back());
+    }
+    EXPECT_EQ(blocks.size(), unique.size());
+    for (auto block : blocks) {
+        top::basic::xobject_pool_t::deallocate(block, 64);
+    }
+}
+
+TEST(xbasic, object_pool_class_new_delete) {
+    xpooled_base_t * base = new xpooled_base_t;
+    xpooled_base_t * derived = new xpooled_derived_t;
+    derived->value = 7;
+    EXPECT_EQ(7u, derived->value);
+    delete base;
+    delete derived;
+}
+
+TEST(xbasic, object_pool_shared_across_threads) {
+    std::vector<std::shared_ptr<xpooled_derived_t>> objects;
+    for (int i = 0; i < 500; ++i) {
+        objects.push_back(top::basic::make_pooled_shared<xpooled_derived_t>());
+        objects.back()->value = static_cast<uint64_t>(i);
+    }
+    // released by other threads than the allocating one
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&objects, t]() {
+            for (std::size_t i = t; i < objects.size(); i += 4) {
+                EXPECT_EQ(i, objects[i]->value);
+                objects[i].reset();
+            }
+            for (int i = 0; i < 1000; ++i) {
+                auto object = top::basic::make_pooled_shared<xpooled_derived_t>();
+                object->value = static_cast<uint64_t>(i);
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+}
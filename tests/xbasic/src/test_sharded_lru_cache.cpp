@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xsharded_lru_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct xcounting_deletor_t {
+    static int deleted;
+    void operator()(int &) {
+        ++deleted;
+    }
+};
+int xcounting_deletor_t::deleted = 0;
+
+struct xstring_weigher_t {
+    size_t operator()(int const &, std::string const & v) const {
+        return v.size();
+    }
+};
+
+}  // namespace
+
+TEST(xbasic, sharded_lru_cache_get_put) {
+    top::basic::xsharded_lru_cache<int, int> cache{64, 4};
+    EXPECT_EQ(4u, cache.shard_count());
+
+    int v = 0;
+    EXPECT_FALSE(cache.get(1, v));
+    cache.put(1, 10);
+    EXPECT_TRUE(cache.get(1, v));
+    EXPECT_EQ(10, v);
+    cache.put(1, 11);
+    EXPECT_TRUE(cache.get(1, v));
+    EXPECT_EQ(11, v);
+    EXPECT_TRUE(cache.exist(1));
+    EXPECT_EQ(1u, cache.size());
+
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.exist(1));
+    EXPECT_FALSE(cache.erase(1));
+
+    auto const stats = cache.stats();
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(0u, stats.size);
+}
+
+TEST(xbasic, sharded_lru_cache_evicts_unreferenced_first) {
+    // one shard, so the clock order is the insertion order
+    top::basic::xsharded_lru_cache<int, int, xcounting_deletor_t> cache{4, 1};
+    xcounting_deletor_t::deleted = 0;
+    for (int i = 0; i < 4; ++i) {
+        cache.put(i, i);
+    }
+    // the first pass clears all flags and evicts 0, then 1 is read again and spared
+    cache.put(4, 4);
+    int v = 0;
+    EXPECT_FALSE(cache.exist(0));
+    EXPECT_TRUE(cache.get(1, v));
+    cache.put(5, 5);
+    EXPECT_TRUE(cache.exist(1));
+    EXPECT_FALSE(cache.exist(2));
+    EXPECT_EQ(4u, cache.size());
+    EXPECT_EQ(2u, cache.stats().evictions);
+    EXPECT_EQ(2, xcounting_deletor_t::deleted);
+
+    cache.put(1, 100);
+    EXPECT_EQ(3, xcounting_deletor_t::deleted);
+    cache.clear();
+    EXPECT_EQ(7, xcounting_deletor_t::deleted);
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST(xbasic, sharded_lru_cache_weighted) {
+    top::basic::xsharded_lru_cache<int, std::string, top::basic::xvoid_deletor_t<std::string>, xstring_weigher_t> cache{10, 1};
+    cache.put(1, "aaaa");
+    cache.put(2, "bbbb");
+    EXPECT_EQ(8u, cache.stats().weight);
+    cache.put(3, "cccc");
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_LE(cache.stats().weight, 10u);
+
+    cache.set_max_size(4);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(xbasic, sharded_lru_cache_concurrent) {
+    top::basic::xsharded_lru_cache<int, int> cache{1000};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 20000; ++i) {
+                int const k = (i * 7 + t) % 2000;
+                int v = 0;
+                if (cache.get(k, v)) {
+                    EXPECT_EQ(k, v);
+                } else {
+                    cache.put(k, k);
+                }
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.size(), 1000u + cache.shard_count());
+    auto const stats = cache.stats();
+    EXPECT_EQ(80000u, stats.hits + stats.misses);
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xthreading/xthread_affinity.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using top::threading::parse_cpu_list;
+using top::threading::xthread_affinity_t;
+
+TEST(xbasic, parse_cpu_list) {
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 8}), parse_cpu_list("0-3,8"));
+    EXPECT_EQ((std::vector<int>{2, 3, 5}), parse_cpu_list(" 5, 2-3, 3\n"));
+    EXPECT_TRUE(parse_cpu_list("").empty());
+    EXPECT_TRUE(parse_cpu_list("a").empty());
+    EXPECT_TRUE(parse_cpu_list("3-1").empty());
+    EXPECT_TRUE(parse_cpu_list("1-").empty());
+    EXPECT_TRUE(parse_cpu_list("0-3,x").empty());
+    EXPECT_TRUE(parse_cpu_list("4096").empty());
+}
+
+TEST(xbasic, thread_affinity_configure) {
+    auto & affinity = xthread_affinity_t::instance();
+    EXPECT_TRUE(affinity.configure(""));
+    EXPECT_TRUE(affinity.configure("cons_worker:0-1; rpc:0"));
+    EXPECT_FALSE(affinity.configure("cons_worker"));
+    EXPECT_FALSE(affinity.configure(":0"));
+    EXPECT_FALSE(affinity.configure("rpc:x"));
+    EXPECT_TRUE(affinity.configure(""));
+    EXPECT_EQ(0u, affinity.apply_all_threads());
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xbasic/xtimer_wheel.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+TEST(xbasic, timer_wheel_expires_in_order) {
+    top::basic::xtimer_wheel_t<std::function<void()>> wheel;
+    std::vector<int> fired;
+    wheel.add(3, [&fired] { fired.push_back(3); });
+    wheel.add(1, [&fired] { fired.push_back(1); });
+    wheel.add(300, [&fired] { fired.push_back(300); });
+    auto const cancelled = wheel.add(2, [&fired] { fired.push_back(2); });
+    EXPECT_EQ(4u, wheel.size());
+    EXPECT_TRUE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.cancel(0));
+
+    std::vector<std::function<void()>> expired;
+    EXPECT_EQ(2u, wheel.advance(299, expired));
+    for (auto & callback : expired) {
+        callback();
+    }
+    EXPECT_EQ((std::vector<int>{1, 3}), fired);
+
+    expired.clear();
+    EXPECT_EQ(1u, wheel.advance(300, expired));
+    EXPECT_TRUE(wheel.empty());
+
+    // a deadline already passed expires at the next tick
+    wheel.add(10, [] {});
+    expired.clear();
+    EXPECT_EQ(1u, wheel.advance(301, expired));
+}
+
+TEST(xbasic, timer_wheel_random_against_map) {
+    // every level, the parking of deadlines beyond the wheel and cancel of reused nodes
+    top::basic::xtimer_wheel_t<std::uint64_t> wheel;
+    std::multimap<std::uint64_t, top::basic::xtimer_handle_t> pending;
+    std::mt19937_64 rng(5);
+    std::uint64_t const spans[] = {10, 300, 20000, 2000000, top::basic::xtimer_wheel_t<std::uint64_t>::max_span * 2};
+
+    std::uint64_t now = 0;
+    std::vector<std::uint64_t> expired;
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            auto const expire_tick = now + 1 + rng() % spans[rng() % 5];
+            pending.emplace(expire_tick, wheel.add(expire_tick, expire_tick));
+        }
+        if (!pending.empty() && rng() % 2 == 0) {
+            auto it = pending.begin();
+            std::advance(it, rng() % pending.size());
+            EXPECT_TRUE(wheel.cancel(it->second));
+            pending.erase(it);
+        }
+
+        now += 1 + rng() % 50000;
+        expired.clear();
+        wheel.advance(now, expired);
+        auto const end = pending.upper_bound(now);
+        ASSERT_EQ(static_cast<std::size_t>(std::distance(pending.begin(), end)), expired.size()) << "round " << round;
+        for (std::size_t i = 1; i < expired.size(); ++i) {
+            EXPECT_LE(expired[i - 1], expired[i]);
+        }
+        for (auto const tick : expired) {
+            EXPECT_LE(tick, now);
+        }
+        pending.erase(pending.begin(), end);
+        ASSERT_EQ(pending.size(), wheel.size());
+    }
+}
@@ -0,0 +1,45 @@
+#include "tests/mock/xdatamock_table.hpp"
+#include "xdata/xblock.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace top;
+
+namespace {
+
+// light table block with units of range(0) send txs, as blocks synced between nodes
+data::xblock_ptr_t make_table_block(uint32_t txs_count) {
+    mock::xdatamock_table mocktable(1, 2);
+    std::vector<std::string> const unit_addrs = mocktable.get_unit_accounts();
+    mocktable.push_txs(mocktable.create_send_txs(unit_addrs[0], unit_addrs[1], txs_count));
+    return mocktable.generate_one_table();
+}
+
+}  // namespace
+
+static void BM_vblock_full_serialize(benchmark::State & state) {
+    auto const block = make_table_block(state.range(0));
+    size_t bytes = 0;
+    while (state.KeepRunning()) {
+        base::xstream_t stream(base::xcontext_t::instance());
+        block->full_block_serialize_to(stream);
+        bytes += stream.size();
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_vblock_full_serialize)->Arg(1)->Arg(16)->Arg(64);
+
+static void BM_vblock_full_deserialize(benchmark::State & state) {
+    auto const block = make_table_block(state.range(0));
+    base::xstream_t block_stream(base::xcontext_t::instance());
+    block->full_block_serialize_to(block_stream);
+    std::string const bin((char const *)block_stream.data(), block_stream.size());
+    while (state.KeepRunning()) {
+        base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)bin.data(), (uint32_t)bin.size());
+        data::xblock_ptr_t new_block;
+        new_block.attach(dynamic_cast<data::xblock_t *>(data::xblock_t::full_block_read_from(stream)));
+        benchmark::DoNotOptimize(new_block);
+    }
+    state.SetBytesProcessed(state.iterations() * bin.size());
+}
+BENCHMARK(BM_vblock_full_deserialize)->Arg(1)->Arg(16)->Arg(64);
@@ -0,0 +1,111 @@
+#include "xcodec/xmsgpack_codec.hpp"
+#include "xdata/xcodec/xmsgpack/xelection/xstandby_result_store_codec.hpp"
+#include "xdata/xelection/xstandby_node_info.h"
+#include "xdata/xelection/xstandby_result_store.h"
+#include "xdata/xethheader.h"
+#include "xevm_common/rlp.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace top;
+
+namespace {
+
+data::xeth_header_t make_eth_header() {
+    data::xeth_header_t header;
+    header.set_gaslimit(30000000);
+    header.set_gasused(21000);
+    header.set_baseprice(evm_common::u256{1000000000});
+    header.set_transactions_root(evm_common::xh256_t{xbytes_t(32, 0x11)});
+    header.set_receipts_root(evm_common::xh256_t{xbytes_t(32, 0x22)});
+    header.set_state_root(evm_common::xh256_t{xbytes_t(32, 0x33)});
+    header.set_extra_data(xbytes_t(64, 0x44));
+    return header;
+}
+
+// same shape as standby pool property, range(0) nodes
+data::election::xstandby_result_store_t make_standby_result_store(uint32_t count) {
+    data::election::xstandby_result_store_t standby_result_store;
+    for (uint32_t i = 0; i < count; ++i) {
+        data::election::xstandby_node_info_t node_info;
+        node_info.consensus_public_key = xpublic_key_t{};
+        node_info.stake_container.insert({common::xnode_type_t::rec, i});
+        node_info.stake_container.insert({common::xnode_type_t::zec, i});
+        node_info.stake_container.insert({common::xnode_type_t::consensus_auditor, i});
+        node_info.stake_container.insert({common::xnode_type_t::consensus_validator, i});
+        common::xnode_id_t node_id{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(1000 + i)};
+        standby_result_store.result_of(common::xtopchain_network_id).insert({node_id, node_info});
+    }
+    return standby_result_store;
+}
+
+}  // namespace
+
+static void BM_rlp_eth_header_encode(benchmark::State & state) {
+    auto const header = make_eth_header();
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(header.encodeBytes());
+    }
+}
+BENCHMARK(BM_rlp_eth_header_encode);
+
+static void BM_rlp_eth_header_decode(benchmark::State & state) {
+    auto const bytes = make_eth_header().encodeBytes();
+    std::error_code ec;
+    while (state.KeepRunning()) {
+        data::xeth_header_t header;
+        header.decodeBytes(bytes, ec);
+        benchmark::DoNotOptimize(header);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_rlp_eth_header_decode);
+
+// list of range(0) hashes, as trie nodes and proofs
+static void BM_rlp_list_encode(benchmark::State & state) {
+    xbytes_t const item(32, 0x55);
+    while (state.KeepRunning()) {
+        evm_common::RLPStream stream(state.range(0));
+        for (int i = 0; i < state.range(0); i++) {
+            stream.append(item);
+        }
+        benchmark::DoNotOptimize(stream.out());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rlp_list_encode)->Arg(16)->Arg(256);
+
+static void BM_rlp_list_decode(benchmark::State & state) {
+    xbytes_t const item(32, 0x55);
+    evm_common::RLPStream stream(state.range(0));
+    for (int i = 0; i < state.range(0); i++) {
+        stream.append(item);
+    }
+    xbytes_t const bytes = stream.out();
+    while (state.KeepRunning()) {
+        evm_common::RLP rlp(bytes);
+        for (auto const & rlp_item : rlp) {
+            benchmark::DoNotOptimize(rlp_item.toBytes());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_rlp_list_decode)->Arg(16)->Arg(256);
+
+static void BM_msgpack_standby_result_store_encode(benchmark::State & state) {
+    auto const standby_result_store = make_standby_result_store(state.range(0));
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(codec::msgpack_encode(standby_result_store));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_msgpack_standby_result_store_encode)->Arg(64)->Arg(1024);
+
+static void BM_msgpack_standby_result_store_decode(benchmark::State & state) {
+    auto const bytes = codec::msgpack_encode(make_standby_result_store(state.range(0)));
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(codec::msgpack_decode<data::election::xstandby_result_store_t>(bytes));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_msgpack_standby_result_store_decode)->Arg(64)->Arg(1024);
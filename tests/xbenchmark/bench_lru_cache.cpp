@@ -0,0 +1,70 @@
+#include "xbasic/xlru_cache.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace top;
+
+namespace {
+
+size_t const cache_size = 4096;
+
+std::vector<std::string> make_keys(size_t count) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < count; i++) {
+        keys.push_back("T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(i));
+    }
+    return keys;
+}
+
+}  // namespace
+
+// range(0) keys over a cache of 4096, keys more than cache size evict on every put
+static void BM_lru_cache_put(benchmark::State & state) {
+    auto const keys = make_keys(state.range(0));
+    basic::xlru_cache<std::string, uint64_t> cache(cache_size);
+    uint64_t value = 0;
+    while (state.KeepRunning()) {
+        for (auto const & key : keys) {
+            cache.put(key, value++);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_lru_cache_put)->Arg(1024)->Arg(16384);
+
+static void BM_lru_cache_get(benchmark::State & state) {
+    auto const keys = make_keys(state.range(0));
+    basic::xlru_cache<std::string, uint64_t> cache(cache_size);
+    for (size_t i = 0; i < keys.size(); i++) {
+        cache.put(keys[i], i);
+    }
+    while (state.KeepRunning()) {
+        uint64_t value;
+        for (auto const & key : keys) {
+            benchmark::DoNotOptimize(cache.get(key, value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_lru_cache_get)->Arg(1024)->Arg(16384);
+
+// contended by the worker threads of consensus, as caches shared by tables
+static void BM_lru_cache_get_threads(benchmark::State & state) {
+    static auto const keys = make_keys(cache_size);
+    static basic::xlru_cache<std::string, uint64_t> cache(cache_size);
+    if (state.thread_index == 0) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            cache.put(keys[i], i);
+        }
+    }
+    size_t i = state.thread_index;
+    while (state.KeepRunning()) {
+        uint64_t value;
+        benchmark::DoNotOptimize(cache.get(keys[i++ % keys.size()], value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_lru_cache_get_threads)->Threads(1)->Threads(4)->Threads(8);
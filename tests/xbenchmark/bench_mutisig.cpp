@@ -0,0 +1,55 @@
+#include "xmutisig/xmutisig.h"
+#include "xmutisig/xschnorr.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace top;
+using namespace top::xmutisig;
+
+namespace {
+
+// votes of range(0) nodes for the same block, as collected by a leader
+struct xvotes_t {
+    std::vector<std::string> msgs;
+    std::vector<xpubkey> pubkeys;
+    std::vector<std::string> signs;
+    std::vector<std::string> points;
+};
+
+xvotes_t make_votes(uint32_t count) {
+    xvotes_t votes;
+    std::string const msg{"xbenchmark_block_hash"};
+    for (uint32_t i = 0; i < count; i++) {
+        key_pair_t keypair = xschnorr::instance()->generate_key_pair();
+        rand_pair_t rand_pair = xschnorr::instance()->generate_rand_pair();
+        std::string sign;
+        xmutisig::sign(msg, keypair.first, sign, rand_pair.first, rand_pair.second, xschnorr::instance());
+        votes.msgs.push_back(msg);
+        votes.pubkeys.push_back(keypair.second);
+        votes.signs.push_back(sign);
+        votes.points.push_back(rand_pair.second.get_serialize_str());
+    }
+    return votes;
+}
+
+}  // namespace
+
+static void BM_mutisig_verify_sign(benchmark::State & state) {
+    auto const votes = make_votes(state.range(0));
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < votes.msgs.size(); i++) {
+            benchmark::DoNotOptimize(xmutisig::verify_sign(votes.msgs[i], votes.pubkeys[i], votes.signs[i], votes.points[i], xschnorr::instance()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * votes.msgs.size());
+}
+BENCHMARK(BM_mutisig_verify_sign)->Arg(16)->Arg(64);
+
+static void BM_mutisig_batch_verify_sign(benchmark::State & state) {
+    auto const votes = make_votes(state.range(0));
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(xmutisig::batch_verify_sign(votes.msgs, votes.pubkeys, votes.signs, votes.points, xschnorr::instance()));
+    }
+    state.SetItemsProcessed(state.iterations() * votes.msgs.size());
+}
+BENCHMARK(BM_mutisig_batch_verify_sign)->Arg(16)->Arg(64);
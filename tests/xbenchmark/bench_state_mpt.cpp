@@ -0,0 +1,102 @@
+#include "xdb/xdb_factory.h"
+#include "xdbstore/xstore_face.h"
+#include "xstate_mpt/xstate_mpt.h"
+#include "xvledger/xvledger.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace top;
+
+namespace {
+
+common::xaccount_address_t const table_address{"Ta0000@0"};
+
+// in memory db, so that trie work is measured rather than disk io
+class xstate_mpt_bench_db_t {
+public:
+    xstate_mpt_bench_db_t() {
+        base::xvchain_t::instance().clean_all(true);
+        m_store = store::xstore_factory::create_store_with_static_kvdb(db::xdb_factory_t::create_memdb());
+        base::xvchain_t::instance().set_xdbstore(m_store.get());
+    }
+    ~xstate_mpt_bench_db_t() {
+        base::xvchain_t::instance().clean_all(true);
+    }
+
+    base::xvdbstore_t * db() const {
+        return base::xvchain_t::instance().get_xdbstore();
+    }
+
+private:
+    xobject_ptr_t<store::xstore_face_t> m_store{nullptr};
+};
+
+std::vector<common::xaccount_address_t> make_accounts(uint32_t count) {
+    std::vector<common::xaccount_address_t> accounts;
+    for (uint32_t i = 0; i < count; i++) {
+        accounts.push_back(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(1000 + i)});
+    }
+    return accounts;
+}
+
+base::xaccount_index_t make_index(uint64_t height) {
+    return base::xaccount_index_t{height, std::to_string(height), std::to_string(height), height};
+}
+
+}  // namespace
+
+static void BM_state_mpt_set_account_index(benchmark::State & state) {
+    xstate_mpt_bench_db_t bench_db;
+    auto const accounts = make_accounts(state.range(0));
+    std::error_code ec;
+    auto mpt = state_mpt::xstate_mpt_t::create(table_address, {}, bench_db.db(), ec);
+    uint64_t height = 0;
+    while (state.KeepRunning()) {
+        height++;
+        for (auto const & account : accounts) {
+            mpt->set_account_index(account, make_index(height), ec);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * accounts.size());
+}
+BENCHMARK(BM_state_mpt_set_account_index)->Arg(64)->Arg(1024);
+
+static void BM_state_mpt_get_account_index(benchmark::State & state) {
+    xstate_mpt_bench_db_t bench_db;
+    auto const accounts = make_accounts(state.range(0));
+    std::error_code ec;
+    auto mpt = state_mpt::xstate_mpt_t::create(table_address, {}, bench_db.db(), ec);
+    for (auto const & account : accounts) {
+        mpt->set_account_index(account, make_index(1), ec);
+    }
+    auto const root = mpt->commit(ec);
+    // reopen the committed trie, so that reads go through trie nodes rather than dirty state objects
+    mpt = state_mpt::xstate_mpt_t::create(table_address, root, bench_db.db(), ec);
+    while (state.KeepRunning()) {
+        for (auto const & account : accounts) {
+            benchmark::DoNotOptimize(mpt->get_account_index(account, ec));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * accounts.size());
+}
+BENCHMARK(BM_state_mpt_get_account_index)->Arg(64)->Arg(1024);
+
+// one commit per table block, every block updates range(0) accounts
+static void BM_state_mpt_commit(benchmark::State & state) {
+    xstate_mpt_bench_db_t bench_db;
+    auto const accounts = make_accounts(state.range(0));
+    std::error_code ec;
+    auto mpt = state_mpt::xstate_mpt_t::create(table_address, {}, bench_db.db(), ec);
+    uint64_t height = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        height++;
+        for (auto const & account : accounts) {
+            mpt->set_account_index(account, make_index(height), ec);
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(mpt->commit(ec));
+    }
+    state.SetItemsProcessed(state.iterations() * accounts.size());
+}
+BENCHMARK(BM_state_mpt_commit)->Arg(64)->Arg(1024);
@@ -0,0 +1,105 @@
+#include "tests/mock/xdatamock_table.hpp"
+#include "xtxpool_v2/xtxmgr_table.h"
+#include "xtxpool_v2/xtxpool_para.h"
+#include "xverifier/xverifier_utl.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace top;
+using namespace top::xtxpool_v2;
+
+namespace {
+
+uint32_t const users_count = 8;
+
+// send txs of all users of one table, the nonces of every user are continuous
+class xtxpool_bench_data_t {
+public:
+    static xtxpool_bench_data_t & instance() {
+        static xtxpool_bench_data_t data;
+        return data;
+    }
+
+    std::vector<data::xcons_transaction_ptr_t> txs(uint32_t count) {
+        std::vector<std::string> const unit_addrs = m_mocktable.get_unit_accounts();
+        uint32_t const count_per_user = (count + users_count - 1) / users_count;
+        uint64_t const now = xverifier::xtx_utl::get_gmttime_s();
+        std::vector<data::xcons_transaction_ptr_t> all_txs;
+        for (uint32_t i = 0; i < users_count && all_txs.size() < count; i++) {
+            auto user_txs = m_mocktable.create_send_txs(unit_addrs[i], unit_addrs[(i + 1) % users_count], count_per_user);
+            for (auto & tx : user_txs) {
+                if (all_txs.size() == count) {
+                    break;
+                }
+                tx->set_push_pool_timestamp(now);
+                all_txs.push_back(tx);
+            }
+        }
+        return all_txs;
+    }
+
+    mock::xdatamock_table m_mocktable{1, users_count};
+};
+
+class xtxmgr_table_bench_t {
+public:
+    xtxmgr_table_bench_t(std::string const & table_addr)
+      : m_table_state_cache(nullptr, table_addr), m_table_para(table_addr, &m_shard, &m_statistic, &m_table_state_cache), m_txmgr_table(&m_table_para, &m_resource) {
+    }
+
+    void push(std::vector<data::xcons_transaction_ptr_t> const & txs) {
+        xtx_para_t para;
+        for (auto & tx : txs) {
+            m_txmgr_table.push_send_tx(std::make_shared<xtx_entry>(tx, para), 0);
+        }
+    }
+
+    xtxmgr_table_t & txmgr_table() {
+        return m_txmgr_table;
+    }
+
+private:
+    xtxpool_role_info_t m_shard{0, 0, 0, common::xnode_type_t::consensus_auditor};
+    xtxpool_statistic_t m_statistic;
+    xtable_state_cache_t m_table_state_cache;
+    xtxpool_table_info_t m_table_para;
+    xtxpool_resources m_resource{nullptr, nullptr, nullptr};
+    xtxmgr_table_t m_txmgr_table;
+};
+
+}  // namespace
+
+static void BM_txpool_table_push_send_txs(benchmark::State & state) {
+    auto & bench_data = xtxpool_bench_data_t::instance();
+    auto const txs = bench_data.txs(state.range(0));
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        auto table = std::make_shared<xtxmgr_table_bench_t>(bench_data.m_mocktable.get_account());
+        state.ResumeTiming();
+        table->push(txs);
+        state.PauseTiming();
+        table.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * txs.size());
+}
+BENCHMARK(BM_txpool_table_push_send_txs)->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_txpool_table_pack(benchmark::State & state) {
+    auto & bench_data = xtxpool_bench_data_t::instance();
+    auto const & mocktable = bench_data.m_mocktable;
+    xtxmgr_table_bench_t table(mocktable.get_account());
+    table.push(bench_data.txs(state.range(0)));
+
+    auto cert_block = mocktable.get_cert_block();
+    xtxs_pack_para_t pack_para(mocktable.get_account(), mocktable.get_table_state(), cert_block.get(), 40, 35, 30, {});
+    xunconfirm_id_height id_height_map(1);
+    size_t packed = 0;
+    while (state.KeepRunning()) {
+        auto ready_txs = table.txmgr_table().get_ready_txs(pack_para, id_height_map);
+        packed += ready_txs.size();
+        benchmark::DoNotOptimize(ready_txs);
+    }
+    state.SetItemsProcessed(packed);
+}
+BENCHMARK(BM_txpool_table_pack)->Arg(64)->Arg(256)->Arg(1024);
@@ -0,0 +1,57 @@
+#include "xbase/xhash.h"
+#include "xbase/xlog.h"
+#include "xdata/xrootblock.h"
+#include "xmetrics/xmetrics.h"
+#include "xutility/xhash.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+class xhashtest_t : public top::base::xhashplugin_t {
+public:
+    xhashtest_t() : top::base::xhashplugin_t(-1) {
+    }
+
+private:
+    xhashtest_t(const xhashtest_t &);
+    xhashtest_t & operator=(const xhashtest_t &);
+    ~xhashtest_t() override = default;
+
+public:
+    const std::string hash(const std::string & input, enum_xhash_type type) override {
+        auto hash = top::utl::xsha2_256_t::digest(input);
+        return std::string(reinterpret_cast<char *>(hash.data()), hash.size());
+    }
+};
+
+// usage: xbenchmark [google benchmark flags], e.g. --benchmark_filter=mpt --benchmark_out=bench.json
+// results are printed as json unless --benchmark_format is given, so that runs of releases can be compared by tools
+int main(int argc, char ** argv) {
+    XMETRICS_INIT();
+    xinit_log("./xbenchmark.log", true, true);
+    xset_log_level(enum_xlog_level_warn);
+
+    new xhashtest_t();
+    top::data::xrootblock_para_t para;
+    top::data::xrootblock_t::init(para);
+
+    std::vector<char *> args(argv, argv + argc);
+    std::string json_format{"--benchmark_format=json"};
+    bool has_format = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--benchmark_format", std::strlen("--benchmark_format")) == 0) {
+            has_format = true;
+        }
+    }
+    if (!has_format) {
+        args.push_back(&json_format[0]);
+    }
+    int args_count = (int)args.size();
+
+    benchmark::Initialize(&args_count, args.data());
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+
+#include "xblockstore/xblockarchive.h"
+#include "tests/mock/xvchain_creator.hpp"
+#include "tests/mock/xdatamock_table.hpp"
+
+using namespace top;
+using namespace top::base;
+using namespace top::data;
+
+TEST(test_block_archive, write_and_read) {
+    mock::xvchain_creator creator(true);
+    creator.create_blockstore_with_xstore();
+    base::xvblockstore_t* blockstore = creator.get_blockstore();
+
+    uint64_t count = 10;
+    mock::xdatamock_table mocktable;
+    mocktable.genrate_table_chain(count, blockstore);
+    const std::vector<xblock_ptr_t> & tables = mocktable.get_history_tables();
+
+    const std::string archive_file = "./test_block_archive.seg";
+    store::xblock_archive_writer_t writer;
+    ASSERT_TRUE(writer.open(archive_file));
+    for (auto & block : tables) {
+        ASSERT_TRUE(writer.append(block.get()));
+    }
+    ASSERT_FALSE(writer.append(tables[1].get()));  // height must be ascending
+    ASSERT_EQ(writer.get_blocks_count(), tables.size());
+    ASSERT_TRUE(writer.close());
+
+    store::xblock_archive_reader_t reader;
+    ASSERT_TRUE(reader.open(archive_file));
+    ASSERT_EQ(reader.get_index().size(), 1);
+    for (auto & block : tables) {
+        base::xauto_ptr<base::xvblock_t> archived(reader.load_block(block->get_account(), block->get_height()));
+        ASSERT_NE(archived, nullptr);
+        ASSERT_EQ(archived->get_block_hash(), block->get_block_hash());
+        ASSERT_EQ(archived->get_input()->get_resources_data(), block->get_input()->get_resources_data());
+        ASSERT_EQ(archived->get_output()->get_resources_data(), block->get_output()->get_resources_data());
+    }
+    const char * data = nullptr;
+    size_t size = 0;
+    ASSERT_FALSE(reader.read_block_data(tables.back()->get_account(), tables.back()->get_height() + 1, data, size));
+    ASSERT_EQ(reader.load_block("not_exist_account", 1), nullptr);
+    reader.close();
+    remove(archive_file.c_str());
+}
+
+TEST(test_block_archive, reject_bad_segment) {
+    const std::string archive_file = "./test_block_archive_bad.seg";
+    FILE * file = fopen(archive_file.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const std::string garbage(64, 'x');
+    fwrite(garbage.data(), 1, garbage.size(), file);
+    fclose(file);
+
+    store::xblock_archive_reader_t reader;
+    ASSERT_FALSE(reader.open(archive_file));
+    ASSERT_FALSE(reader.open("./not_exist_archive.seg"));
+    remove(archive_file.c_str());
+}
@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+
+#include "xblockstore/src/xvblockcache.h"
+
+using namespace top::store;
+
+TEST(test_block_cache_budget, over_budget) {
+    auto & budget = xblockcache_budget_t::instance();
+    auto const max_cached_blocks = budget.get_max_cached_blocks();
+    auto const cached_blocks = budget.get_cached_blocks();
+
+    budget.set_max_cached_blocks(cached_blocks + 10);
+    EXPECT_FALSE(budget.is_over_budget());
+    budget.update_cached_blocks(11);
+    EXPECT_TRUE(budget.is_over_budget());
+    budget.update_cached_blocks(-11);
+    EXPECT_FALSE(budget.is_over_budget());
+    EXPECT_EQ(budget.get_cached_blocks(), cached_blocks);
+
+    budget.set_max_cached_blocks(max_cached_blocks);
+}
+
+TEST(test_block_cache_budget, access_frequency) {
+    auto & budget = xblockcache_budget_t::instance();
+    uint32_t hot_frequency{0};
+    uint32_t hot_epoch{0};
+    uint32_t cold_frequency{0};
+    uint32_t cold_epoch{0};
+    budget.touch(cold_frequency, cold_epoch);
+    for (int i = 0; i < xblockcache_budget_t::enum_hot_access_frequency; ++i) {
+        budget.touch(hot_frequency, hot_epoch);
+    }
+    EXPECT_TRUE(budget.is_hot(hot_frequency, hot_epoch));
+    EXPECT_FALSE(budget.is_hot(cold_frequency, cold_epoch));
+
+    // accesses of other accounts age the hot one until it is cold
+    uint32_t other_frequency{0};
+    uint32_t other_epoch{0};
+    for (int i = 0; i < xblockcache_budget_t::enum_access_aging_window; ++i) {
+        budget.touch(other_frequency, other_epoch);
+    }
+    EXPECT_EQ(budget.get_frequency(hot_frequency, hot_epoch), hot_frequency >> 1);
+    EXPECT_FALSE(budget.is_hot(hot_frequency, hot_epoch));
+}
@@ -115,6 +115,61 @@ TEST_F(test_block_store_load, store_batch_tables) {
     }
 }
 
+TEST_F(test_block_store_load, store_blocks_one_batch) {
+    mock::xvchain_creator creator(true);
+    base::xvblockstore_t* blockstore = creator.get_blockstore();
+
+    uint64_t max_block_height = 19;
+    mock::xdatamock_table mocktable(1, 4);
+    mocktable.genrate_table_chain(max_block_height, blockstore);
+    const std::vector<xblock_ptr_t> & tableblocks = mocktable.get_history_tables();
+    xassert(tableblocks.size() == max_block_height + 1);
+
+    // out of order on purpose, batch path links them by height
+    std::vector<base::xvblock_t*> batch_blocks;
+    for (auto it = tableblocks.rbegin(); it != tableblocks.rend(); ++it) {
+        batch_blocks.push_back(it->get());
+    }
+    ASSERT_TRUE(blockstore->store_blocks(mocktable, batch_blocks));
+
+    ASSERT_EQ(max_block_height, blockstore->get_latest_cert_block(mocktable)->get_height());
+    ASSERT_EQ(max_block_height - 2, blockstore->get_latest_committed_block(mocktable)->get_height());
+    for (uint64_t height = 1; height <= max_block_height - 2; height++) {
+        auto block = blockstore->load_block_object(mocktable, height, base::enum_xvblock_flag_committed, true);
+        ASSERT_NE(block, nullptr);
+        ASSERT_EQ(tableblocks[height]->get_block_hash(), block->get_block_hash());
+    }
+}
+
+TEST_F(test_block_store_load, lazy_body_block) {
+    mock::xvchain_creator creator(true);
+    base::xvblockstore_t* blockstore = creator.get_blockstore();
+
+    mock::xdatamock_table mocktable(1, 4);
+    mocktable.genrate_table_chain(3, blockstore);
+    const std::vector<xblock_ptr_t> & tableblocks = mocktable.get_history_tables();
+
+    std::string block_bin;
+    tableblocks[1]->serialize_to_string(block_bin);
+    base::xauto_ptr<base::xvblock_t> lazy_block(base::xvblock_t::create_block_object(block_bin.data(), block_bin.size(), true));
+    ASSERT_NE(lazy_block, nullptr);
+    EXPECT_FALSE(lazy_block->is_body_decoded());
+    EXPECT_EQ(tableblocks[1]->get_block_hash(), lazy_block->get_block_hash());
+    EXPECT_EQ(tableblocks[1]->get_height(), lazy_block->get_height());
+
+    // write back the kept bytes without decode
+    std::string lazy_block_bin;
+    lazy_block->serialize_to_string(lazy_block_bin);
+    EXPECT_FALSE(lazy_block->is_body_decoded());
+    EXPECT_EQ(block_bin, lazy_block_bin);
+
+    ASSERT_NE(lazy_block->get_input(), nullptr);
+    EXPECT_TRUE(lazy_block->is_body_decoded());
+    ASSERT_NE(lazy_block->get_output(), nullptr);
+    EXPECT_EQ(tableblocks[1]->get_input()->get_resources_hash(), lazy_block->get_input()->get_resources_hash());
+    EXPECT_EQ(tableblocks[1]->get_output()->get_resources_hash(), lazy_block->get_output()->get_resources_hash());
+}
+
 TEST_F(test_block_store_load, load_unexsit_block_1) {
     mock::xvchain_creator creator(true);
     base::xvblockstore_t* blockstore = creator.get_blockstore();
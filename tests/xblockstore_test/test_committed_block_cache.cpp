@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+
+#include "xblockstore/xblockstore_face.h"
+#include "tests/mock/xvchain_creator.hpp"
+#include "tests/mock/xdatamock_table.hpp"
+
+using namespace top;
+using namespace top::base;
+using namespace top::data;
+
+TEST(test_committed_block_cache, read_committed_after_store) {
+    mock::xvchain_creator creator(true);
+    creator.create_blockstore_with_xstore();
+    base::xvblockstore_t* blockstore = creator.get_blockstore();
+
+    uint64_t count = 10;
+    mock::xdatamock_table mocktable;
+    mocktable.genrate_table_chain(count, blockstore);
+    const std::vector<xblock_ptr_t> & tables = mocktable.get_history_tables();
+
+    xvaccount_t account(mocktable.get_account());
+    for (uint64_t i = 1; i <= count; i++) {
+        ASSERT_TRUE(blockstore->store_block(account, tables[i].get()));
+
+        // the latest two are locked and cert, so committed one is two blocks behind
+        uint64_t const committed_height = i >= 2 ? i - 2 : 0;
+        EXPECT_EQ(committed_height, blockstore->get_latest_committed_block_height(account));
+        auto committed_block = blockstore->get_latest_committed_block(account);
+        ASSERT_NE(committed_block, nullptr);
+        EXPECT_EQ(committed_height, committed_block->get_height());
+        EXPECT_EQ(tables[committed_height]->get_block_hash(), committed_block->get_block_hash());
+
+        auto by_flag = blockstore->load_block_object(account, committed_height, base::enum_xvblock_flag_committed, false);
+        ASSERT_NE(by_flag, nullptr);
+        EXPECT_EQ(committed_block->get_block_hash(), by_flag->get_block_hash());
+        auto by_hash = blockstore->load_block_object(account, committed_height, committed_block->get_block_hash(), false);
+        ASSERT_NE(by_hash, nullptr);
+        EXPECT_EQ(committed_height, by_hash->get_height());
+    }
+}
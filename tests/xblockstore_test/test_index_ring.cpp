@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+
+#include "xblockstore/src/xvindexring.h"
+#include "tests/mock/xvchain_creator.hpp"
+#include "tests/mock/xdatamock_table.hpp"
+
+using namespace top;
+using namespace top::base;
+using namespace top::store;
+
+TEST(test_index_ring, put_and_take) {
+    mock::xvchain_creator creator(true);
+    uint64_t count = 6;
+    mock::xdatamock_table mocktable;
+    mocktable.genrate_table_chain(count, creator.get_blockstore());
+    const std::vector<data::xblock_ptr_t> & tables = mocktable.get_history_tables();
+    xvaccount_t account(mocktable.get_account());
+
+    xvindex_ring_t ring(4);
+    for (uint64_t i = 1; i <= count; i++) {
+        xauto_ptr<xvbindex_t> index(new xvbindex_t(*tables[i]));
+        index->reset_modify_flag();
+        EXPECT_FALSE(ring.put(index.get()));  // not committed yet
+        index->set_block_flag(enum_xvblock_flag_committed);
+        index->reset_modify_flag();
+        EXPECT_TRUE(ring.put(index.get()));
+    }
+    EXPECT_EQ(4, ring.size());
+
+    // overwritten by higher heights of same slot
+    EXPECT_EQ(nullptr, ring.take(account, 1));
+    EXPECT_EQ(nullptr, ring.take(account, 2));
+
+    xauto_ptr<xvbindex_t> taken(ring.take(account, 5));
+    ASSERT_NE(nullptr, taken);
+    EXPECT_EQ(5, taken->get_height());
+    EXPECT_EQ(tables[5]->get_block_hash(), taken->get_block_hash());
+    EXPECT_TRUE(taken->check_block_flag(enum_xvblock_flag_committed));
+    EXPECT_EQ(account.get_address(), taken->get_address());
+    EXPECT_EQ(nullptr, ring.take(account, 5));  // slot is free after take
+    EXPECT_EQ(3, ring.size());
+
+    ring.erase(6);
+    EXPECT_EQ(nullptr, ring.take(account, 6));
+    ring.clear();
+    EXPECT_EQ(0, ring.size());
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include "xblockstore/src/xvprefetch.h"
+
+using namespace top;
+using namespace top::store;
+
+TEST(test_sequential_read_detector, start_after_continuous_reads) {
+    xsequential_read_detector_t detector;
+    const std::string address = "T00000LMZLAYynftsjQiKZ5W7TQncKg3Q9WNWaKo";
+    uint64_t from = 0;
+    uint64_t to = 0;
+    for (uint64_t height = 1; height < xsequential_read_detector_t::enum_min_sequential_reads; height++) {
+        EXPECT_FALSE(detector.on_read(address, height, from, to));
+    }
+    const uint64_t height = xsequential_read_detector_t::enum_min_sequential_reads;
+    EXPECT_TRUE(detector.on_read(address, height, from, to));
+    EXPECT_EQ(from, height + 1);
+    EXPECT_EQ(to, height + xsequential_read_detector_t::enum_prefetch_window);
+
+    // heights inside prefetched window are not given out again
+    EXPECT_FALSE(detector.on_read(address, height + 1, from, to));
+    EXPECT_FALSE(detector.on_read(address, height + 1, from, to));
+}
+
+TEST(test_sequential_read_detector, refill_and_reset) {
+    xsequential_read_detector_t detector;
+    const std::string address = "T00000LMZLAYynftsjQiKZ5W7TQncKg3Q9WNWaKo";
+    uint64_t from = 0;
+    uint64_t to = 0;
+    uint64_t prefetched = xsequential_read_detector_t::enum_min_sequential_reads;
+    for (uint64_t height = 1; height <= 100; height++) {
+        if (detector.on_read(address, height, from, to)) {
+            // continue from last window without gap or overlap
+            EXPECT_EQ(from, prefetched + 1);
+            EXPECT_LE(to, height + xsequential_read_detector_t::enum_prefetch_window);
+            prefetched = to;
+        }
+        if (height >= xsequential_read_detector_t::enum_min_sequential_reads) {
+            EXPECT_GT(prefetched, height);
+        }
+    }
+
+    // random access breaks the run
+    EXPECT_FALSE(detector.on_read(address, 10, from, to));
+    EXPECT_FALSE(detector.on_read(address, 50, from, to));
+    detector.remove(address);
+    EXPECT_FALSE(detector.on_read(address, 51, from, to));
+}
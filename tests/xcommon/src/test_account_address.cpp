@@ -183,6 +183,30 @@ TEST(account_address, value_address_must_not_changed) {
     ASSERT_EQ(std::addressof(lvalue), std::addressof(rvalue));
 }
 
+TEST(account_address, interned) {
+    top::common::xaccount_address_t const lhs{"T00000LMcqLyTzsk3HB8dhF51i6xEcVEuyX2Vx6p"};
+    top::common::xaccount_address_t const rhs{std::string{"T00000LMcqLyTzsk3HB8dhF51i6xEcVEuyX2Vx6p"}};
+    top::common::xaccount_address_t const other{"T00000LVpL9XRtVdU5RwfnmrCtJhvQFxJ8TB46gB"};
+
+    ASSERT_NE(0, lhs.interned_id());
+    EXPECT_EQ(lhs.interned_id(), rhs.interned_id());
+    EXPECT_NE(lhs.interned_id(), other.interned_id());
+    EXPECT_EQ(lhs, rhs);
+    EXPECT_NE(lhs, other);
+    EXPECT_EQ(lhs.hash(), rhs.hash());
+    EXPECT_EQ(std::hash<top::common::xaccount_address_t>{}(lhs), std::hash<top::common::xaccount_address_t>{}(rhs));
+
+    // ordered containers still see the string order
+    EXPECT_EQ(lhs.value() < other.value(), lhs < other);
+    EXPECT_FALSE(lhs < rhs);
+
+    top::common::xaccount_address_t copy{lhs};
+    copy.clear();
+    EXPECT_EQ(0, copy.interned_id());
+    EXPECT_EQ(0, copy.hash());
+    EXPECT_EQ(top::common::xaccount_address_t{}, copy);
+}
+
 TEST(account_address, size) {
     EXPECT_TRUE(sizeof(top::common::xaccount_address_t) <= 40);
     EXPECT_TRUE(sizeof(top::common::xaccount_base_address_t) <= 16);
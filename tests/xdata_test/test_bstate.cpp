@@ -66,6 +66,44 @@ TEST_F(test_bstate, snapshot_rollback_1) {
     
 }
 
+TEST_F(test_bstate, snapshot_rollback_2) {
+    xobject_ptr_t<base::xvbstate_t> bstate = make_object_ptr<base::xvbstate_t>("T80000733b43e6a2542709dc918ef2209ae0fc6503c2f2", (uint64_t)1, (uint64_t)1, std::string(), std::string(), (uint64_t)0, (uint32_t)0, (uint16_t)0);
+    xbstate_ctx_t bstatectx(bstate.get(), false);
+    ASSERT_EQ(0, bstatectx.string_create("@1"));
+    ASSERT_EQ(0, bstatectx.string_set("@1", "v1"));
+    ASSERT_EQ(0, bstatectx.map_create("@2"));
+    ASSERT_EQ(0, bstatectx.map_set("@2", "f1", "v1"));
+    ASSERT_EQ(4, bstatectx.do_snapshot());
+
+    for (uint32_t i = 0; i < 3; i++) {
+        base::xvproperty_t * untouched_property = bstatectx.get_bstate()->get_property_object("@1");
+        ASSERT_NE(nullptr, untouched_property);
+
+        ASSERT_EQ(0, bstatectx.map_set("@2", "f1", "v2"));
+        ASSERT_EQ(0, bstatectx.map_set("@2", "f2", "v2"));
+        ASSERT_EQ(0, bstatectx.string_create("@3"));
+        ASSERT_EQ(0, bstatectx.string_set("@3", "v3"));
+        ASSERT_EQ(true, bstatectx.do_rollback());
+
+        // only changed properties are restored, the untouched one is still the same object
+        ASSERT_EQ(untouched_property, bstatectx.get_bstate()->get_property_object("@1"));
+        ASSERT_EQ("v1", bstatectx.string_get("@1"));
+        ASSERT_EQ("v1", bstatectx.map_get("@2", "f1"));
+        ASSERT_EQ("", bstatectx.map_get("@2", "f2"));
+        ASSERT_EQ(false, bstatectx.get_bstate()->find_property("@3"));
+        ASSERT_EQ(4 + i, bstatectx.get_canvas_records_size());
+
+        // next tx succeeds and moves the snapshot forward
+        ASSERT_EQ(0, bstatectx.string_set("@1", "v1"));
+        ASSERT_EQ(1, bstatectx.do_snapshot());
+    }
+
+    ASSERT_EQ(0, bstatectx.string_set("@1", "v4"));
+    ASSERT_EQ(true, bstatectx.do_rollback());
+    ASSERT_EQ("v1", bstatectx.string_get("@1"));
+    ASSERT_EQ(false, bstatectx.is_state_dirty());
+}
+
 TEST_F(test_bstate, token_id_1) {
     std::string addr = "T80000733b43e6a2542709dc918ef2209ae0fc6503c2f2";
     xobject_ptr_t<base::xvbstate_t> bstate = make_object_ptr<base::xvbstate_t>(addr, (uint64_t)1, (uint64_t)1, std::string(), std::string(), (uint64_t)0, (uint32_t)0, (uint16_t)0);
@@ -1,11 +1,15 @@
+#include <atomic>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 #include <stdio.h>
 
 #include "gtest/gtest.h"
 #include "xdb/xdb.h"
 #include "xdb/xdb_factory.h"
 #include "xdb/xdb_face.h"
+#include "xdb/xdb_mem.h"
 
 using namespace top::db;
 using namespace std;
@@ -292,6 +296,555 @@ TEST_F(test_xdb, db_read_range) {
         ASSERT_NE(iter, values.end());
     }
 }
+
+TEST_F(test_xdb, db_shared_block_cache) {
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.block_cache_size = 64 << 20;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths, db_options);
+
+    // keys of 'r/' and 's/' are mapped to cf[1]~cf[4],others go to default cf,all share one block cache
+    std::vector<std::string> keys{"r/Ta0000@0/0000000000000001/h", "r/Ta0000@1/0000000000000001/h", "s/Ta0000@2/0000000000000001/u", "k/default_cf_key"};
+    for (auto const & key : keys) {
+        ASSERT_TRUE(db1.write(key, key));
+    }
+    db1.compact_range("", "");
+    for (auto const & key : keys) {
+        std::string value;
+        ASSERT_TRUE(db1.read(key, value));
+        ASSERT_EQ(value, key);
+    }
+    db1.GetDBMemStatus();
+}
+
+TEST_F(test_xdb, db_write_async) {
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths);
+    db1.write("async_key_0", "old_value");
+
+    std::atomic<int> written_count{0};
+    const int batch_count = 100;
+    for (int i = 0; i < batch_count; i++) {
+        std::map<std::string, std::string> objs;
+        objs["async_key_" + std::to_string(i)] = "value_" + std::to_string(i);
+        std::vector<std::string> delete_keys;
+        if (i == batch_count - 1) {
+            delete_keys.push_back("async_key_1");
+        }
+        ASSERT_TRUE(db1.write_async(objs, delete_keys, [&written_count](bool ret) {
+            if (ret) {
+                written_count++;
+            }
+        }));
+    }
+    // queued data is visible before being written
+    std::string value;
+    ASSERT_TRUE(db1.read("async_key_0", value));
+    ASSERT_EQ(value, "value_0");
+    ASSERT_FALSE(db1.exists("async_key_1"));
+
+    ASSERT_TRUE(db1.flush_async_writes());
+    ASSERT_EQ(written_count.load(), batch_count);
+
+    db1.close();
+    db1.open();
+    ASSERT_TRUE(db1.read("async_key_98", value));
+    ASSERT_EQ(value, "value_98");
+    ASSERT_FALSE(db1.exists("async_key_1"));
+}
+
+TEST_F(test_xdb, db_read_pinned) {
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths);
+    std::string big_value(64 * 1024, 'x');
+    ASSERT_TRUE(db1.write("pinned_key", big_value));
+
+    xdb_pinned_value_ptr value;
+    ASSERT_TRUE(db1.read_pinned("pinned_key", value));
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(std::string(value->data(), value->size()), big_value);
+
+    xdb_pinned_value_ptr not_found;
+    ASSERT_FALSE(db1.read_pinned("pinned_key_not_exist", not_found));
+    ASSERT_EQ(not_found, nullptr);
+}
+
+TEST_F(test_xdb, db_prefix_read_range) {
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths);
+    // two accounts of same ledger and a key without account prefix
+    ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/h", "a1"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000002/h", "a2"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_b/0000000000000001/h", "b1"));
+    ASSERT_TRUE(db1.write("r/ff0001", "ledger"));
+    ASSERT_TRUE(db1.compact_range("", ""));
+
+    {
+        // seek with full account prefix
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[0], "a1");
+        ASSERT_EQ(values[1], "a2");
+    }
+    {
+        // seek with longer prefix of one height
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_b/0000000000000001/", values));
+        ASSERT_EQ(values.size(), 1);
+        ASSERT_EQ(values[0], "b1");
+    }
+    {
+        // seek with prefix shorter than account prefix must still see all keys
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001", values));
+        ASSERT_EQ(values.size(), 4);
+    }
+}
+
+TEST_F(test_xdb, db_multi_read) {
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths);
+    // keys of different CFs are read by one batch
+    std::vector<std::string> keys = {"r/00000001_multi", "s/00000002_multi", "multi_key", "multi_key_not_exist"};
+    ASSERT_TRUE(db1.write(keys[0], "value0"));
+    ASSERT_TRUE(db1.write(keys[1], "value1"));
+    ASSERT_TRUE(db1.write(keys[2], "value2"));
+
+    std::vector<std::string> values;
+    ASSERT_TRUE(db1.multi_read(keys, values));
+    ASSERT_EQ(values.size(), keys.size());
+    ASSERT_EQ(values[0], "value0");
+    ASSERT_EQ(values[1], "value1");
+    ASSERT_EQ(values[2], "value2");
+    ASSERT_TRUE(values[3].empty());
+
+    std::vector<std::string> empty_values;
+    ASSERT_TRUE(db1.multi_read(std::vector<std::string>(), empty_values));
+    ASSERT_TRUE(empty_values.empty());
+}
+
+TEST_F(test_xdb, db_snapshot_read) {
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, DB_NAME, db_paths);
+    std::vector<std::string> keys = {"r/00000001_snapshot", "s/00000002_snapshot"};
+    ASSERT_TRUE(db1.write(keys[0], "value0"));
+    ASSERT_TRUE(db1.write(keys[1], "value1"));
+
+    xdb_snapshot_ptr snapshot = db1.create_snapshot();
+    ASSERT_NE(snapshot, nullptr);
+    // writes after the snapshot are not seen through it
+    ASSERT_TRUE(db1.write(keys[0], "value0_new"));
+    ASSERT_TRUE(db1.erase(keys[1]));
+
+    std::string value;
+    ASSERT_TRUE(db1.read(snapshot, keys[0], value));
+    ASSERT_EQ(value, "value0");
+    std::vector<std::string> values;
+    ASSERT_TRUE(db1.multi_read(snapshot, keys, values));
+    ASSERT_EQ(values[0], "value0");
+    ASSERT_EQ(values[1], "value1");
+
+    ASSERT_TRUE(db1.multi_read(keys, values));
+    ASSERT_EQ(values[0], "value0_new");
+    ASSERT_TRUE(values[1].empty());
+}
+
+TEST_F(test_xdb, db_delete_ranges) {
+    const std::string db_dir = "./test_db_delete_ranges/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb db1(xdb_kind_kvdb, db_dir, db_paths);
+    ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/b", "a1"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000002/b", "a2"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000003/b", "a3"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_b/0000000000000001/b", "b1"));
+    ASSERT_TRUE(db1.write("r/ff0001/account_b/0000000000000002/b", "b2"));
+
+    // ranges of different accounts are deleted by one write
+    std::vector<std::pair<std::string, std::string>> ranges;
+    ranges.emplace_back("r/ff0001/account_a/0000000000000001/", "r/ff0001/account_a/0000000000000003/");
+    ranges.emplace_back("r/ff0001/account_b/0000000000000001/", "r/ff0001/account_b/0000000000000002/");
+    ASSERT_TRUE(db1.delete_ranges(ranges));
+    ASSERT_TRUE(db1.delete_ranges(std::vector<std::pair<std::string, std::string>>()));
+
+    std::vector<std::string> values;
+    ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+    ASSERT_EQ(values, std::vector<std::string>({"a3"}));
+    values.clear();
+    ASSERT_TRUE(db1.read_range("r/ff0001/account_b/", values));
+    ASSERT_EQ(values, std::vector<std::string>({"b2"}));
+}
+
+TEST_F(test_xdb, db_bulk_load) {
+    const std::string db_dir = "./test_db_bulk_load/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.cf_routing_by_key_type = true;
+    xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+    ASSERT_TRUE(db1.write("u/account_a/m", "old_meta"));
+
+    // keys of different CFs are ingested by one call,and override the existing ones
+    std::map<std::string, std::string> objs;
+    objs["r/ff0001/account_a/0000000000000001/h"] = "index1";
+    objs["r/ff0001/account_a/0000000000000001/aaaa/b"] = "body1";
+    objs["u/account_a/m"] = "meta";
+    objs["f/0000aaaa/b"] = "tx";
+    ASSERT_TRUE(db1.bulk_load(objs));
+    ASSERT_TRUE(db1.bulk_load(std::map<std::string, std::string>()));
+
+    for (auto const & entry : objs) {
+        std::string value;
+        ASSERT_TRUE(db1.read(entry.first, value));
+        ASSERT_EQ(entry.second, value);
+    }
+    ASSERT_TRUE(db1.write("u/account_a/m", "new_meta"));
+    std::string value;
+    ASSERT_TRUE(db1.read("u/account_a/m", value));
+    ASSERT_EQ("new_meta", value);
+}
+
+TEST_F(test_xdb, db_cf_routing_by_key_type) {
+    const std::string db_dir = "./test_db_cf_routing/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.cf_routing_by_key_type = true;
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        // block index & meta go to meta CF,block body stays at shard CF,tx index goes to txindex CF
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/h", "index1"));
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/aaaa/b", "body1"));
+        ASSERT_TRUE(db1.write("u/account_a/m", "meta"));
+        ASSERT_TRUE(db1.write("f/0000aaaa/b", "tx"));
+        std::string value;
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/0000000000000001/h", value));
+        ASSERT_EQ(value, "index1");
+        ASSERT_TRUE(db1.read("u/account_a/m", value));
+        ASSERT_EQ(value, "meta");
+        ASSERT_TRUE(db1.read("f/0000aaaa/b", value));
+        ASSERT_EQ(value, "tx");
+
+        // range of account merges keys of both CFs in key order
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[0], "body1");
+        ASSERT_EQ(values[1], "index1");
+
+        ASSERT_TRUE(db1.erase("u/account_a/m"));
+        ASSERT_FALSE(db1.read("u/account_a/m", value));
+        ASSERT_TRUE(db1.migrate_cf_layout()); // nothing to move for new DB
+    }
+    xdb::destroy(db_dir);
+}
+
+TEST_F(test_xdb, db_migrate_cf_layout) {
+    const std::string db_dir = "./test_db_cf_migrate/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    {
+        // old DB at shard layout
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths);
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/h", "index1"));
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/aaaa/b", "body1"));
+        ASSERT_TRUE(db1.write("u/account_a/m", "meta"));
+        ASSERT_TRUE(db1.write("f/0000aaaa/b", "tx"));
+    }
+    xdb_options_t db_options;
+    db_options.cf_routing_by_key_type = true;
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        ASSERT_TRUE(db1.migrate_cf_layout());
+        ASSERT_TRUE(db1.write("u/account_a/m", "meta2"));
+
+        std::string value;
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/0000000000000001/h", value));
+        ASSERT_EQ(value, "index1");
+        ASSERT_TRUE(db1.read("u/account_a/m", value));
+        ASSERT_EQ(value, "meta2");
+        ASSERT_TRUE(db1.read("f/0000aaaa/b", value));
+        ASSERT_EQ(value, "tx");
+
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[0], "body1");
+        ASSERT_EQ(values[1], "index1");
+    }
+    {
+        // layout is persisted
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths);
+        std::string value;
+        ASSERT_TRUE(db1.read("u/account_a/m", value));
+        ASSERT_EQ(value, "meta2");
+    }
+    xdb::destroy(db_dir);
+}
+
+TEST_F(test_xdb, db_blob_files) {
+    const std::string db_dir = "./test_db_blob/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.blob_files = true;
+    db_options.min_blob_size = 1024;
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        const std::string big_value(64 * 1024, 'b');
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/0/b", big_value));
+        ASSERT_TRUE(db1.write("r/ff0001/account_a/0000000000000001/0/i", "small"));
+        ASSERT_TRUE(db1.compact_range("", ""));
+
+        std::string value;
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/0000000000000001/0/b", value));
+        ASSERT_EQ(value, big_value);
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/0000000000000001/0/i", value));
+        ASSERT_EQ(value, "small");
+
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 2);
+        ASSERT_EQ(values[0], big_value);
+
+        // deleted blob is dropped by gc without breaking reads of others
+        ASSERT_TRUE(db1.erase("r/ff0001/account_a/0000000000000001/0/b"));
+        ASSERT_TRUE(db1.compact_range("", ""));
+        ASSERT_FALSE(db1.read("r/ff0001/account_a/0000000000000001/0/b", value));
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/0000000000000001/0/i", value));
+    }
+    xdb::destroy(db_dir);
+}
+
+TEST_F(test_xdb, db_compaction_rate_limit) {
+    const std::string db_dir = "./test_db_rate_limit/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.compaction_rate_limit_mb = 64;
+    db_options.compaction_readahead_size = 1 << 20;
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_TRUE(db1.write("r/ff0001/account_a/" + std::to_string(i), std::string(1024, 'v')));
+        }
+        ASSERT_TRUE(db1.compact_range("", ""));
+
+        std::vector<std::string> keys = {"r/ff0001/account_a/1", "r/ff0001/account_a/999"};
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.multi_read(keys, values));
+        ASSERT_EQ(values[0], std::string(1024, 'v'));
+        ASSERT_EQ(values[1], std::string(1024, 'v'));
+    }
+    xdb::destroy(db_dir);
+}
+
+TEST_F(test_xdb, db_zstd_dictionary) {
+    const std::string db_dir = "./test_db_zstd_dict/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.zstd_dict_bytes = 16 * 1024;
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        // similar values as blocks of one account
+        for (int i = 0; i < 1000; i++) {
+            char key[64];
+            snprintf(key, sizeof(key), "r/ff0001/account_a/%016x/0/b", i);
+            ASSERT_TRUE(db1.write(key, "T00000LMZLAYynftsjQiKZ5W7TQncKg3Q9WNWaKo|balance|" + std::to_string(i)));
+        }
+        ASSERT_TRUE(db1.compact_range("", ""));
+
+        std::string value;
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/00000000000003e7/0/b", value));
+        ASSERT_EQ(value, "T00000LMZLAYynftsjQiKZ5W7TQncKg3Q9WNWaKo|balance|999");
+        std::vector<std::string> values;
+        ASSERT_TRUE(db1.read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 1000);
+    }
+    // data written with dictionary is readable after reopen without it
+    {
+        xdb db2(xdb_kind_kvdb, db_dir, db_paths);
+        std::string value;
+        ASSERT_TRUE(db2.read("r/ff0001/account_a/0000000000000000/0/b", value));
+        ASSERT_EQ(value, "T00000LMZLAYynftsjQiKZ5W7TQncKg3Q9WNWaKo|balance|0");
+    }
+    xdb::destroy(db_dir);
+}
+
+TEST_F(test_xdb, db_tiered_move_range_to_cold) {
+    const std::string hot_dir  = "./test_db_tiered_hot/";
+    const std::string cold_dir = "./test_db_tiered_cold/";
+    xdb::destroy(hot_dir);
+    xdb::destroy(cold_dir);
+    xdb_options_t db_options;
+    db_options.cold_db_path = cold_dir;
+    db_options.cold_block_height_gap = 1024;
+    {
+        std::shared_ptr<xdb_face_t> db = xdb_factory_t::create(xdb_kind_kvdb, hot_dir, std::vector<xdb_path_t>(), db_options);
+        ASSERT_EQ(db->get_cold_height_gap(), 1024);
+        ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000001/b", "old1"));
+        ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000002/b", "old2"));
+        ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000009/b", "new9"));
+
+        ASSERT_TRUE(db->move_range_to_cold("r/ff0001/account_a/0000000000000001/", "r/ff0001/account_a/0000000000000003/"));
+        ASSERT_TRUE(db->flush_async_writes());
+
+        // read-through cold DB
+        std::string value;
+        ASSERT_TRUE(db->read("r/ff0001/account_a/0000000000000001/b", value));
+        ASSERT_EQ(value, "old1");
+        std::vector<std::string> values;
+        ASSERT_TRUE(db->multi_read({"r/ff0001/account_a/0000000000000002/b", "r/ff0001/account_a/0000000000000009/b"}, values));
+        ASSERT_EQ(values[0], "old2");
+        ASSERT_EQ(values[1], "new9");
+        values.clear();
+        ASSERT_TRUE(db->read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values.size(), 3);
+
+        // range merges both DB by key order,hot one shadows the moved copy
+        ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000001/b", "upd1"));
+        values.clear();
+        ASSERT_TRUE(db->read_range("r/ff0001/account_a/", values));
+        ASSERT_EQ(values, std::vector<std::string>({"upd1", "old2", "new9"}));
+
+        // delete applies for both DB
+        ASSERT_TRUE(db->erase("r/ff0001/account_a/0000000000000002/b"));
+        ASSERT_FALSE(db->read("r/ff0001/account_a/0000000000000002/b", value));
+        ASSERT_TRUE(db->close());
+    }
+    {
+        std::vector<xdb_path_t> db_paths;
+        xdb hot_db(xdb_kind_kvdb, hot_dir, db_paths);
+        std::string value;
+        ASSERT_FALSE(hot_db.read("r/ff0001/account_a/0000000000000001/b", value));
+        ASSERT_TRUE(hot_db.read("r/ff0001/account_a/0000000000000009/b", value));
+    }
+    {
+        std::vector<xdb_path_t> db_paths;
+        xdb cold_db(xdb_kind_kvdb, cold_dir, db_paths);
+        std::string value;
+        ASSERT_TRUE(cold_db.read("r/ff0001/account_a/0000000000000001/b", value));
+        ASSERT_FALSE(cold_db.read("r/ff0001/account_a/0000000000000009/b", value));
+    }
+    xdb::destroy(hot_dir);
+    xdb::destroy(cold_dir);
+}
+
+static bool collect_keys_callback(const std::string& key, const std::string& value, void* cookie) {
+    ((std::vector<std::string>*)cookie)->push_back(key);
+    return true;
+}
+
+TEST_F(test_xdb, memdb_range_and_delete_range) {
+    std::shared_ptr<xdb_face_t> db = xdb_factory_t::create_memdb();
+    ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000003/b", "3"));
+    ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000001/b", "1"));
+    ASSERT_TRUE(db->write("r/ff0001/account_a/0000000000000002/b", "2"));
+    ASSERT_TRUE(db->write("r/ff0001/account_b/0000000000000001/b", "b1"));
+
+    std::vector<std::string> values;
+    ASSERT_TRUE(db->read_range("r/ff0001/account_a/", values));
+    ASSERT_EQ(values, std::vector<std::string>({"1", "2", "3"}));
+
+    std::vector<std::string> keys;
+    ASSERT_TRUE(db->read_range("", collect_keys_callback, &keys));
+    ASSERT_EQ(keys.size(), 4);
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    ASSERT_TRUE(db->delete_range("r/ff0001/account_a/0000000000000001/", "r/ff0001/account_a/0000000000000003/"));
+    values.clear();
+    ASSERT_TRUE(db->read_range("r/ff0001/account_a/", values));
+    ASSERT_EQ(values, std::vector<std::string>({"3"}));
+
+    xdb_pinned_value_ptr pinned;
+    ASSERT_TRUE(db->read_pinned("r/ff0001/account_b/0000000000000001/b", pinned));
+    ASSERT_TRUE(db->write("r/ff0001/account_b/0000000000000001/b", "b2"));
+    ASSERT_EQ(std::string(pinned->data(), pinned->size()), "b1"); // pinned value survives overwrite
+    uint64_t num = 0;
+    ASSERT_TRUE(db->get_estimate_num_keys(num));
+    ASSERT_EQ(num, 2);
+}
+
+TEST_F(test_xdb, memdb_snapshot) {
+    xdb_mem_t db;
+    ASSERT_TRUE(db.write("key1", "v1"));
+    ASSERT_TRUE(db.write("key2", "v2"));
+    xdb_mem_snapshot_ptr snapshot = db.get_snapshot();
+
+    ASSERT_TRUE(db.write("key1", "v1_new"));
+    ASSERT_TRUE(db.erase("key2"));
+    ASSERT_TRUE(db.write("key3", "v3"));
+
+    // snapshot is isolated from later writes
+    std::string value;
+    ASSERT_TRUE(snapshot->read("key1", value));
+    ASSERT_EQ(value, "v1");
+    ASSERT_TRUE(snapshot->read("key2", value));
+    ASSERT_FALSE(snapshot->read("key3", value));
+    ASSERT_EQ(snapshot->size(), 2);
+
+    ASSERT_TRUE(db.restore_snapshot(snapshot));
+    ASSERT_TRUE(db.read("key1", value));
+    ASSERT_EQ(value, "v1");
+    ASSERT_FALSE(db.exists("key3"));
+    ASSERT_EQ(db.get_meta().m_key_count, 2);
+
+    // write after restore must not touch snapshot
+    ASSERT_TRUE(db.write("key1", "v1_again"));
+    ASSERT_TRUE(snapshot->read("key1", value));
+    ASSERT_EQ(value, "v1");
+}
+
+TEST_F(test_xdb, memdb_concurrent_read_write) {
+    xdb_mem_t db;
+    const int key_count = 1000;
+    std::atomic<bool> failed{false};
+    std::thread writer([&db, key_count]() {
+        for (int i = 0; i < key_count; ++i)
+            db.write("key_" + std::to_string(i), std::to_string(i));
+    });
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&db, &failed, key_count]() {
+            for (int i = 0; i < key_count; ++i) {
+                std::string value;
+                if (db.read("key_" + std::to_string(i), value) && value != std::to_string(i))
+                    failed = true;
+            }
+        });
+    }
+    writer.join();
+    for (auto & reader : readers)
+        reader.join();
+    ASSERT_FALSE(failed);
+    ASSERT_EQ(db.get_meta().m_key_count, key_count);
+}
+
+TEST_F(test_xdb, db_statistics_export) {
+    const std::string db_dir = "./test_db_statistics/";
+    xdb::destroy(db_dir);
+    std::vector<xdb_path_t> db_paths;
+    xdb_options_t db_options;
+    db_options.statistics = true;
+    db_options.statistics_interval_sec = 1;
+    db_options.slow_op_threshold_ms = 1; // compact_range below trigger slow op report
+    {
+        xdb db1(xdb_kind_kvdb, db_dir, db_paths, db_options);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(db1.write("r/ff0001/account_a/" + std::to_string(i), std::string(128, 'v')));
+        }
+        std::string value;
+        ASSERT_TRUE(db1.read("r/ff0001/account_a/1", value));
+        ASSERT_FALSE(db1.read("r/ff0001/account_a/none", value));
+        ASSERT_TRUE(db1.compact_range("", ""));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500)); // let exporter run once
+        db1.GetDBMemStatus();
+    }
+    xdb::destroy(db_dir);
+}
+
 /*TEST_F(test_xdb, db_backup) {
     string db_dir = DB_NAME;
 
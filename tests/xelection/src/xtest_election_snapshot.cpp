@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "tests/xelection/xdummy_chain_timer.h"
+#include "tests/xelection/xtest_fixtures.h"
+#include "xbasic/xutility.h"
+#include "xcommon/xaddress.h"
+#include "xdata/xelection/xelection_result_store.h"
+#include "xelection/xcache/xdata_accessor.h"
+#include "xelection/xcache/xgroup_element.h"
+
+#include <gtest/gtest.h>
+
+using top::common::xnode_type_t;
+using top::common::xslot_id_t;
+using top::data::election::xelection_info_bundle_t;
+using top::data::election::xelection_info_t;
+using top::data::election::xelection_result_store_t;
+
+NS_BEG3(top, tests, election)
+
+static xelection_result_store_t build_committee_election_result(std::size_t const node_count, std::uint64_t const round) {
+    top::common::xnetwork_id_t network_id{top::common::xtopchain_network_id};
+
+    xelection_result_store_t election_result_store;
+    auto & group_result = election_result_store.result_of(network_id)
+                                               .result_of(xnode_type_t::committee)
+                                               .result_of(top::common::xcommittee_cluster_id)
+                                               .result_of(top::common::xcommittee_group_id);
+    group_result.group_version(top::common::xelection_round_t{round});
+    group_result.election_committee_version(top::common::xelection_round_t{round});
+    group_result.start_time(round * 10);
+
+    for (auto i = 0u; i < node_count; ++i) {
+        xelection_info_t new_election_info{};
+        new_election_info.joined_epoch(common::xelection_round_t{round});
+
+        xelection_info_bundle_t election_info_bundle;
+        election_info_bundle.account_address(build_account_address(i + round * node_count));
+        election_info_bundle.election_info(std::move(new_election_info));
+        group_result.insert(std::move(election_info_bundle));
+    }
+    return election_result_store;
+}
+
+TEST(xtest_election_snapshot, lookups) {
+    top::common::xnetwork_id_t network_id{top::common::xtopchain_network_id};
+    top::common::xgroup_address_t group_address{network_id, top::common::xcommittee_zone_id, top::common::xcommittee_cluster_id, top::common::xcommittee_group_id};
+
+    top::election::cache::xdata_accessor_t data_accessor{network_id, top::make_observer(top::tests::election::xdummy_chain_timer)};
+    ASSERT_EQ(nullptr, data_accessor.snapshot());
+
+    std::size_t const node_count{16};
+    std::error_code ec;
+    data_accessor.update_zone(top::common::xcommittee_zone_id, build_committee_election_result(node_count, 0), 0, ec);
+    ASSERT_EQ(0, ec.value());
+
+    auto const snapshot = data_accessor.snapshot();
+    ASSERT_NE(nullptr, snapshot);
+    ASSERT_EQ(1, snapshot->group_count());
+
+    auto const group_element = data_accessor.group_element_by_height(group_address, 0, ec);
+    ASSERT_EQ(0, ec.value());
+    auto const group_snapshot = snapshot->group(group_address, group_element->logic_epoch());
+    ASSERT_NE(nullptr, group_snapshot);
+    ASSERT_EQ(group_snapshot, snapshot->group_by_height(group_address, 0));
+    ASSERT_EQ(node_count, group_snapshot->nodes().size());
+    ASSERT_EQ(nullptr, group_snapshot->node_element(xslot_id_t{static_cast<std::uint16_t>(node_count)}));
+
+    auto const & nodes = data_accessor.group_nodes(group_address, group_element->logic_epoch(), ec);
+    ASSERT_EQ(0, ec.value());
+    ASSERT_EQ(node_count, nodes.size());
+
+    for (auto i = 0u; i < node_count; ++i) {
+        auto const node_element = group_snapshot->node_element(xslot_id_t{i});
+        ASSERT_NE(nullptr, node_element);
+        ASSERT_EQ(build_account_address(i), node_element->node_id());
+        ASSERT_EQ(build_account_address(i), data_accessor.account_address_from(node_element->xip2(), ec));
+        ASSERT_EQ(0, ec.value());
+    }
+}
+
+TEST(xtest_election_snapshot, immutable) {
+    top::common::xnetwork_id_t network_id{top::common::xtopchain_network_id};
+    top::common::xgroup_address_t group_address{network_id, top::common::xcommittee_zone_id, top::common::xcommittee_cluster_id, top::common::xcommittee_group_id};
+
+    top::election::cache::xdata_accessor_t data_accessor{network_id, top::make_observer(top::tests::election::xdummy_chain_timer)};
+
+    std::size_t const node_count{16};
+    std::error_code ec;
+    data_accessor.update_zone(top::common::xcommittee_zone_id, build_committee_election_result(node_count, 0), 0, ec);
+    ASSERT_EQ(0, ec.value());
+    auto const old_snapshot = data_accessor.snapshot();
+
+    data_accessor.update_zone(top::common::xcommittee_zone_id, build_committee_election_result(node_count, 1), 1, ec);
+    ASSERT_EQ(0, ec.value());
+    auto const new_snapshot = data_accessor.snapshot();
+
+    ASSERT_NE(old_snapshot, new_snapshot);
+    ASSERT_EQ(1, old_snapshot->group_count());
+    ASSERT_EQ(nullptr, old_snapshot->group_by_height(group_address, 1));
+    ASSERT_EQ(2, new_snapshot->group_count());
+
+    auto const group_snapshot = new_snapshot->group_by_height(group_address, 1);
+    ASSERT_NE(nullptr, group_snapshot);
+    ASSERT_EQ(build_account_address(node_count), group_snapshot->node_element(xslot_id_t{0})->node_id());
+}
+
+NS_END3
@@ -108,6 +108,10 @@ public:
                                                          std::error_code & ec) const noexcept {
         return {};
     }
+
+    std::shared_ptr<top::election::cache::xelection_snapshot_t const> snapshot() const override {
+        return nullptr;
+    }
 };
 using xdummy_election_cache_data_accessor_t = xtop_dummy_election_cache_data_accessor;
 
@@ -74,6 +74,22 @@ TEST(test_rlp, encode) {
                 "f786010203040506830304058801020304050607088831323334353637388b68656c6c6f20776f726c648d746f7020756e69742074657374");
 }
 
+TEST(test_rlp, encode_to) {
+    std::vector<top::xbytes_t> items{{}, {0x01}, {0x7f}, {0x80}, top::xbytes_t(55, 0x11), top::xbytes_t(56, 0x22), top::xbytes_t(300, 0x33)};
+    for (std::size_t n = 0; n <= items.size(); ++n) {
+        top::xbytes_t expect;
+        top::xbytes_t encoded{0xff};  // bytes already in buffer are kept
+        for (std::size_t i = 0; i < n; ++i) {
+            append(expect, RLP::encode(items[i]));
+            RLP::encodeTo(encoded, items[i]);
+        }
+        expect = RLP::encodeList(expect);
+        expect.insert(expect.begin(), 0xff);
+        RLP::encodeListTo(encoded, 1);
+        EXPECT_EQ(encoded, expect);
+    }
+}
+
 TEST(test_rlp, decode) {
     std::string rawTx = HexDecode("f786010203040506830304058801020304050607088831323334353637388b68656c6c6f20776f726c648d746f7020756e69742074657374");
     RLP::DecodedItem decoded = RLP::decode(::data(rawTx));
@@ -97,6 +113,72 @@ TEST(test_rlp, decode) {
     EXPECT_EQ(vecData[5], "top unit test");
 }
 
+TEST(test_rlp, decode_nested_and_invalid) {
+    // [ [], [[]], [ [], [[]] ] ] keeps an empty item for every empty list among the items
+    std::string raw = HexDecode("c7c0c1c0c3c0c1c0");
+    auto decoded = RLP::decode(::data(raw));
+    EXPECT_EQ(decoded.decoded.size(), 4u);
+    for (auto const & item : decoded.decoded) {
+        EXPECT_TRUE(item.empty());
+    }
+    EXPECT_TRUE(decoded.remainder.empty());
+
+    // remainder after the first item, a list is kept as its payload by decode_once
+    raw = HexDecode("c88363617483646f67820400");
+    decoded = RLP::decode(::data(raw));
+    ASSERT_EQ(decoded.decoded.size(), 2u);
+    EXPECT_EQ(std::string(decoded.decoded[1].begin(), decoded.decoded[1].end()), "dog");
+    EXPECT_EQ(HexEncode(std::string(decoded.remainder.begin(), decoded.remainder.end())), "820400");
+    decoded = RLP::decode_once(::data(raw));
+    ASSERT_EQ(decoded.decoded.size(), 1u);
+    EXPECT_EQ(HexEncode(std::string(decoded.decoded[0].begin(), decoded.decoded[0].end())), "8363617483646f67");
+
+    EXPECT_THROW(RLP::decode(top::xbytes_t{}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0x83, 0x01}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0x81, 0x01}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0x81}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0xb9, 0x00, 0x40}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0xf8, 0x01, 0x01}), std::invalid_argument);
+    EXPECT_THROW(RLP::decode(top::xbytes_t{0xc3, 0x01}), std::invalid_argument);
+}
+
+// a list shaped like an eth bridge header proof: 64 pairs of dag nodes followed by their merkle proofs
+TEST(test_rlp, large_list_round_trip) {
+    std::vector<top::xbytes_t> items;
+    for (size_t i = 0; i < 64 * 2; ++i) {
+        items.emplace_back(64, static_cast<top::xbyte_t>(i));
+    }
+    for (size_t i = 0; i < 64 * 24; ++i) {
+        items.emplace_back(16, static_cast<top::xbyte_t>(i));
+    }
+    top::xbytes_t payload;
+    for (auto const & item : items) {
+        append(payload, RLP::encode(item));
+    }
+    top::xbytes_t const encoded = RLP::encodeList(payload);
+
+    // in place encoding gives the same bytes
+    top::xbytes_t encoded_to;
+    for (auto const & item : items) {
+        RLP::encodeTo(encoded_to, item);
+    }
+    RLP::encodeListTo(encoded_to, 0);
+    ASSERT_EQ(encoded, encoded_to);
+
+    RLP::DecodedItem decoded = RLP::decode(encoded);
+    ASSERT_EQ(decoded.decoded, items);
+    ASSERT_TRUE(decoded.remainder.empty());
+
+    size_t view_items = 0;
+    size_t view_bytes = 0;
+    for (auto const & item : RLP(encoded)) {
+        ++view_items;
+        view_bytes += item.toBytesConstRef().size();
+    }
+    ASSERT_EQ(view_items, items.size());
+    ASSERT_EQ(view_bytes, 64 * 2 * 64 + 64 * 24 * 16u);
+}
+
 TEST(test_rlp, wiki_example) {
     std::string raw = HexDecode("c88363617483646f67");  // The list [ “cat”, “dog” ] = [ 0xc8, 0x83, 'c', 'a', 't', 0x83, 'd', 'o', 'g' ]
     RLP::DecodedItem decoded = RLP::decode(::data(raw));
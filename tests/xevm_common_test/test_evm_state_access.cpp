@@ -0,0 +1,47 @@
+#include "xevm_common/xevm_transaction_result.h"
+
+#include <gtest/gtest.h>
+
+NS_BEG3(top, evm_common, tests)
+
+TEST(test_evm_state_access, conflicts) {
+    xevm_state_access_t transfer_a;
+    transfer_a.add_read("slot_a");
+    transfer_a.add_write("slot_a");
+
+    xevm_state_access_t transfer_b;
+    transfer_b.add_read("slot_b");
+    transfer_b.add_write("slot_b");
+    EXPECT_FALSE(transfer_b.conflicts_with(transfer_a));
+
+    // both only read
+    xevm_state_access_t read_a;
+    read_a.add_read("slot_a");
+    xevm_state_access_t read_a2;
+    read_a2.add_read("slot_a");
+    EXPECT_FALSE(read_a2.conflicts_with(read_a));
+
+    // read after write, write after read and write after write
+    EXPECT_TRUE(read_a.conflicts_with(transfer_a));
+    EXPECT_TRUE(transfer_a.conflicts_with(read_a));
+    xevm_state_access_t write_a;
+    write_a.add_write("slot_a");
+    EXPECT_TRUE(write_a.conflicts_with(transfer_a));
+
+    xevm_state_access_t sys_call;
+    sys_call.opaque = true;
+    EXPECT_TRUE(sys_call.conflicts_with(transfer_b));
+    EXPECT_TRUE(transfer_b.conflicts_with(sys_call));
+}
+
+TEST(test_evm_state_access, copied_with_result) {
+    xevm_transaction_result_t result;
+    result.access.add_write("slot_a");
+    xevm_transaction_result_t copy = result;
+    EXPECT_EQ(copy.access.writes.size(), 1u);
+    xevm_transaction_result_t assigned;
+    assigned = result;
+    EXPECT_EQ(assigned.access.writes.count("slot_a"), 1u);
+}
+
+NS_END3
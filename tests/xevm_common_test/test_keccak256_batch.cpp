@@ -0,0 +1,56 @@
+#include "xbasic/xhex.h"
+#include "xutility/xhash.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+NS_BEG3(top, evm_common, tests)
+
+TEST(test_keccak256_batch, empty) {
+    xbytes_t output(32);
+    utl::xkeccak256_t::digest_once(nullptr, 0, output.data());
+    EXPECT_EQ(top::to_hex(output), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+}
+
+TEST(test_keccak256_batch, same_as_digest) {
+    // sizes around the 136 byte rate and of the trie nodes, in a count that leaves a scalar tail
+    std::mt19937 rng(7);
+    std::vector<xbytes_t> messages;
+    for (std::size_t size : {0, 1, 31, 32, 135, 136, 137, 271, 272, 532}) {
+        xbytes_t message(size);
+        for (auto & c : message) {
+            c = static_cast<uint8_t>(rng());
+        }
+        messages.push_back(std::move(message));
+    }
+    for (std::size_t i = 0; i < 33; ++i) {
+        xbytes_t message(rng() % 600);
+        for (auto & c : message) {
+            c = static_cast<uint8_t>(rng());
+        }
+        messages.push_back(std::move(message));
+    }
+
+    std::vector<uint8_t const *> datas;
+    std::vector<std::size_t> sizes;
+    for (auto const & message : messages) {
+        datas.push_back(message.data());
+        sizes.push_back(message.size());
+    }
+    xbytes_t outputs(messages.size() * 32);
+    utl::xkeccak256_t::digest_batch(messages.size(), datas.data(), sizes.data(), outputs.data());
+
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        auto const expected = utl::xkeccak256_t::digest(messages[i].data(), messages[i].size());
+        EXPECT_EQ(0, memcmp(expected.raw_uint8, outputs.data() + i * 32, 32)) << "message " << i << " of " << sizes[i] << " bytes";
+
+        xbytes_t once(32);
+        utl::xkeccak256_t::digest_once(messages[i].data(), messages[i].size(), once.data());
+        EXPECT_EQ(0, memcmp(expected.raw_uint8, once.data(), 32));
+    }
+}
+
+NS_END3
@@ -148,4 +148,16 @@ TEST(test_mpt, test_mpt_test) {
         ASSERT_EQ(receiptsRoot, goResult);
     }
 
-}
\ No newline at end of file
+}
+TEST(test_mpt, ordered_trie_root_stack_trie) {
+    // ordered root built by stack trie equals the one built from the whole key map, across rlp key order boundaries.
+    for (std::size_t n : {0, 1, 2, 0x7f, 0x80, 0x81, 0x100, 0x101, 1000}) {
+        std::vector<top::xbytes_t> items;
+        BytesMap m;
+        for (std::size_t i = 0; i < n; ++i) {
+            items.push_back(top::xbytes_t(1 + i % 40, static_cast<top::xbyte_t>(i)));
+            m[xrlp(static_cast<unsigned>(i))] = items.back();
+        }
+        EXPECT_EQ(orderedTrieRoot(items), hash256(m));
+    }
+}
@@ -0,0 +1,65 @@
+#include "tests/xevm_common_test/trie_test_fixture/xtest_trie_fixture.h"
+
+#include "xevm_common/trie/xstack_trie.h"
+#include "xutility/xhash.h"
+
+#include <map>
+
+NS_BEG4(top, evm_common, trie, tests)
+
+static std::map<xbytes_t, xbytes_t> hashed_leaves(std::size_t n) {
+    std::map<xbytes_t, xbytes_t> leaves;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const key = to_bytes(utl::xkeccak256_t::digest(std::to_string(i)));
+        leaves.emplace(key, to_bytes(std::to_string(i)));
+    }
+    return leaves;
+}
+
+TEST_F(xtest_trie_fixture, stack_trie_known_root) {
+    // nested branch and extension nodes are encoded after their children, against the root geth computes.
+    auto const stack_trie = xstack_trie_t::NewStackTrie(nullptr);
+    stack_trie->Update(to_bytes(std::string{"doe"}), to_bytes(std::string{"reindeer"}));
+    stack_trie->Update(to_bytes(std::string{"dog"}), to_bytes(std::string{"puppy"}));
+    stack_trie->Update(to_bytes(std::string{"dogglesworth"}), to_bytes(std::string{"cat"}));
+
+    std::error_code ec;
+    ASSERT_EQ(stack_trie->Hash(), xhash256_t{top::from_hex("8aad789dff2f538bca5d8ea56e8abe10f4c7ba3a5dea95fea4cd6e7c3a1168d3", ec)});
+    ASSERT_TRUE(!ec);
+}
+
+TEST_F(xtest_trie_fixture, stack_trie_hash) {
+    for (std::size_t n : {0, 1, 2, 3, 16, 100, 5000}) {
+        std::error_code ec;
+        auto const trie = xtrie_t::build_from({}, xtrie_db_t::NewDatabase(std::make_shared<xmock_disk_db>()), ec);
+        ASSERT_TRUE(!ec);
+        auto const stack_trie = xstack_trie_t::NewStackTrie(nullptr);
+
+        for (auto const & leaf : hashed_leaves(n)) {
+            trie->update(leaf.first, leaf.second);
+            stack_trie->Update(leaf.first, leaf.second);
+        }
+        ASSERT_EQ(trie->hash(), stack_trie->Hash());
+    }
+}
+
+TEST_F(xtest_trie_fixture, stack_trie_commit) {
+    std::error_code ec;
+    auto const stack_trie = xstack_trie_t::NewStackTrie(test_disk_db_ptr);
+    auto const leaves = hashed_leaves(1000);
+    for (auto const & leaf : leaves) {
+        stack_trie->Update(leaf.first, leaf.second);
+    }
+    auto const root = stack_trie->Commit(ec);
+    ASSERT_TRUE(!ec);
+
+    // nodes written by stack trie make up the full trie.
+    auto const trie = xtrie_t::build_from(root, xtrie_db_t::NewDatabase(test_disk_db_ptr), ec);
+    ASSERT_TRUE(!ec);
+    for (auto const & leaf : leaves) {
+        ASSERT_EQ(trie->try_get(leaf.first, ec), leaf.second);
+        ASSERT_TRUE(!ec);
+    }
+}
+
+NS_END4
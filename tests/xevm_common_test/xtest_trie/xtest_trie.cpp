@@ -341,4 +341,64 @@ commit:  9a53de09e43869f9ee8bea0535c15924a9f5f5f98c6ec81b4b3f2fc8c7090f8c  >  f8
     ASSERT_TRUE(test_disk_db_ptr->Counter_Get.load() == 34);
 }
 
+TEST_F(xtest_trie_fixture, parallel_hash_same_as_serial) {
+    std::error_code ec;
+    auto parallel_trie = xtrie_t::build_from({}, test_trie_db_ptr, ec);
+    ASSERT_TRUE(!ec);
+    auto serial_trie = xtrie_t::build_from({}, xtrie_db_t::NewDatabase(std::make_shared<xmock_disk_db>()), ec);
+    ASSERT_TRUE(!ec);
+
+    constexpr std::size_t key_count = 2000;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        UpdateString(parallel_trie, "account" + std::to_string(i), "value" + std::to_string(i));
+        UpdateString(serial_trie, "account" + std::to_string(i), "value" + std::to_string(i));
+        if (i % 50 == 49) {
+            // keep dirty set small so that it is always hashed serially
+            serial_trie->hash();
+        }
+    }
+
+    // all keys are dirty here, root full node children are hashed in parallel
+    ASSERT_EQ(parallel_trie->hash(), serial_trie->hash());
+
+    auto const result = parallel_trie->commit(ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_EQ(result.first, serial_trie->hash());
+    for (std::size_t i = 0; i < key_count; i += 97) {
+        TESTINTRIE(parallel_trie, "account" + std::to_string(i), "value" + std::to_string(i));
+    }
+}
+
+TEST_F(xtest_trie_fixture, parallel_commit) {
+    std::error_code ec;
+    auto trie = xtrie_t::build_from({}, test_trie_db_ptr, ec);
+    ASSERT_TRUE(!ec);
+
+    constexpr std::size_t key_count = 2000;
+    for (std::size_t i = 0; i < key_count; ++i) {
+        UpdateString(trie, "account" + std::to_string(i), "value" + std::to_string(i));
+    }
+    // enough updates, children of root full node are committed by workers
+    auto const result = trie->commit(ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_TRUE(result.second > 16);
+    test_trie_db_ptr->Commit(result.first, nullptr, ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_TRUE(test_disk_db_ptr->size() > 16);
+
+    // small update is committed serially on top of it
+    UpdateString(trie, "account0", "new_value");
+    auto const small_result = trie->commit(ec);
+    ASSERT_TRUE(!ec);
+    test_trie_db_ptr->Commit(small_result.first, nullptr, ec);
+    ASSERT_TRUE(!ec);
+
+    auto new_trie = xtrie_t::build_from(small_result.first, xtrie_db_t::NewDatabase(test_disk_db_ptr), ec);
+    ASSERT_TRUE(!ec);
+    TESTINTRIE(new_trie, "account0", "new_value");
+    for (std::size_t i = 1; i < key_count; ++i) {
+        TESTINTRIE(new_trie, "account" + std::to_string(i), "value" + std::to_string(i));
+    }
+}
+
 NS_END4
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "tests/xevm_common_test/trie_test_fixture/xtest_trie_fixture.h"
+#include "xevm_common/trie/xtrie_clean_cache.h"
+
+#include <cstdio>
+
+NS_BEG4(top, evm_common, trie, tests)
+
+#define UpdateString(trie, key, value) trie->update(top::to_bytes(std::string{key}), top::to_bytes(std::string{value}));
+
+#define TESTINTRIE(trie, key, value) ASSERT_EQ(trie->get(top::to_bytes(std::string{key})), top::to_bytes(std::string{value}));
+
+static xhash256_t make_test_hash(std::size_t const i) {
+    xhash256_t hash;
+    hash.data()[0] = static_cast<xbyte_t>(i);
+    hash.data()[1] = static_cast<xbyte_t>(i >> 8);
+    return hash;
+}
+
+TEST(xtest_trie_clean_cache, byte_budget) {
+    // one shard, room for about 10 entries of 1000 bytes
+    xtrie_clean_cache_t cache{11 * 1000, 1};
+    for (std::size_t i = 0; i < 100; ++i) {
+        cache.put(make_test_hash(i), xbytes_t(1000, static_cast<xbyte_t>(i)));
+        ASSERT_TRUE(cache.size_bytes() <= cache.capacity_bytes());
+    }
+    ASSERT_TRUE(cache.size() > 0);
+    ASSERT_TRUE(cache.size() < 11);
+
+    xbytes_t enc;
+    ASSERT_TRUE(cache.get(make_test_hash(99), enc));
+    ASSERT_EQ(enc, xbytes_t(1000, static_cast<xbyte_t>(99)));
+    ASSERT_FALSE(cache.get(make_test_hash(0), enc));
+
+    // node larger than budget is never cached
+    cache.put(make_test_hash(1000), xbytes_t(20 * 1000, 0));
+    ASSERT_FALSE(cache.contains(make_test_hash(1000)));
+
+    cache.erase(make_test_hash(99));
+    ASSERT_FALSE(cache.contains(make_test_hash(99)));
+}
+
+TEST(xtest_trie_clean_cache, recently_used_kept) {
+    xtrie_clean_cache_t cache{11 * 1000, 1};
+    cache.put(make_test_hash(0), xbytes_t(1000, 0));
+    for (std::size_t i = 1; i < 100; ++i) {
+        xbytes_t enc;
+        ASSERT_TRUE(cache.get(make_test_hash(0), enc));
+        cache.put(make_test_hash(i), xbytes_t(1000, static_cast<xbyte_t>(i)));
+    }
+    ASSERT_TRUE(cache.contains(make_test_hash(0)));
+    ASSERT_FALSE(cache.contains(make_test_hash(1)));
+}
+
+TEST(xtest_trie_clean_cache, journal) {
+    std::string const path = "./test_trie_clean_cache.journal";
+    std::remove(path.c_str());
+
+    std::error_code ec;
+    xtrie_clean_cache_t cache{1024 * 1024};
+    for (std::size_t i = 0; i < 100; ++i) {
+        cache.put(make_test_hash(i), xbytes_t(100, static_cast<xbyte_t>(i)));
+    }
+    cache.save_journal(path, ec);
+    ASSERT_TRUE(!ec);
+
+    xtrie_clean_cache_t loaded{1024 * 1024};
+    loaded.load_journal(path, ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_EQ(loaded.size(), cache.size());
+    for (std::size_t i = 0; i < 100; ++i) {
+        xbytes_t enc;
+        ASSERT_TRUE(loaded.get(make_test_hash(i), enc));
+        ASSERT_EQ(enc, xbytes_t(100, static_cast<xbyte_t>(i)));
+    }
+
+    // missing journal is not an error, e.g. first start.
+    std::remove(path.c_str());
+    xtrie_clean_cache_t empty{1024 * 1024};
+    empty.load_journal(path, ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_EQ(empty.size(), 0u);
+}
+
+TEST_F(xtest_trie_fixture, clean_cache_journal_warm_restart) {
+    std::string const path = "./test_trie_db_clean_cache.journal";
+    std::remove(path.c_str());
+
+    auto config = std::make_shared<xtrie_db_config_t>();
+    config->Journal = path;
+
+    std::error_code ec;
+    xhash256_t root;
+    {
+        auto trie_db = xtrie_db_t::NewDatabaseWithConfig(test_disk_db_ptr, config);
+        auto trie = xtrie_t::build_from({}, trie_db, ec);
+        ASSERT_TRUE(!ec);
+        UpdateString(trie, "doe", "reindeer");
+        UpdateString(trie, "dog", "puppy");
+        UpdateString(trie, "dogglesworth", "cat");
+        root = trie->commit(ec).first;
+        ASSERT_TRUE(!ec);
+        trie_db->Commit(root, nullptr, ec);
+        ASSERT_TRUE(!ec);
+        ASSERT_TRUE(trie_db->CleanCache()->size() > 0);
+    }  // journal saved here
+
+    // nodes come from journal instead of disk db after restart
+    auto trie_db = xtrie_db_t::NewDatabaseWithConfig(test_disk_db_ptr, config);
+    auto trie = xtrie_t::build_from(root, trie_db, ec);
+    ASSERT_TRUE(!ec);
+    TESTINTRIE(trie, "doe", "reindeer");
+    TESTINTRIE(trie, "dog", "puppy");
+    TESTINTRIE(trie, "dogglesworth", "cat");
+    ASSERT_EQ(test_disk_db_ptr->Counter_Get.load(), 0u);
+
+    trie_db.reset();
+    std::remove(path.c_str());
+}
+
+TEST_F(xtest_trie_fixture, clean_cache_shared) {
+    auto config = std::make_shared<xtrie_db_config_t>();
+    config->Clean_cache = std::make_shared<xtrie_clean_cache_t>(1024 * 1024);
+
+    std::error_code ec;
+    auto trie_db = xtrie_db_t::NewDatabaseWithConfig(test_disk_db_ptr, config);
+    auto trie = xtrie_t::build_from({}, trie_db, ec);
+    UpdateString(trie, "doe", "reindeer");
+    UpdateString(trie, "dog", "puppy");
+    auto const root = trie->commit(ec).first;
+    trie_db->Commit(root, nullptr, ec);
+    ASSERT_TRUE(!ec);
+
+    // another trie db over the same disk db reads committed nodes from the shared cache
+    auto other_trie_db = xtrie_db_t::NewDatabaseWithConfig(test_disk_db_ptr, config);
+    auto other_trie = xtrie_t::build_from(root, other_trie_db, ec);
+    ASSERT_TRUE(!ec);
+    TESTINTRIE(other_trie, "doe", "reindeer");
+    TESTINTRIE(other_trie, "dog", "puppy");
+    ASSERT_EQ(test_disk_db_ptr->Counter_Get.load(), 0u);
+}
+
+NS_END4
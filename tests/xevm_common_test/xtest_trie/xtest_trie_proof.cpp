@@ -1,4 +1,6 @@
 #include "tests/xevm_common_test/trie_test_fixture/xtest_trie_fixture.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
+#include "xutility/xhash.h"
 
 NS_BEG4(top, evm_common, trie, tests)
 
@@ -69,4 +71,143 @@ TEST_F(xtest_trie_fixture, test_verify_one_element_proof) {
     ASSERT_EQ(result, top::to_bytes(std::string{"v"}));
 }
 
-NS_END4
\ No newline at end of file
+NS_END4
+NS_BEG4(top, evm_common, trie, tests)
+
+static std::shared_ptr<xtrie_t> build_range_test_trie(std::shared_ptr<xtrie_db_t> const & db, std::size_t n) {
+    std::error_code ec;
+    auto trie = xtrie_t::build_from({}, db, ec);
+    for (std::size_t i = 0; i < n; ++i) {
+        trie->update(to_bytes(utl::xkeccak256_t::digest(std::to_string(i))), to_bytes(std::to_string(i)));
+    }
+    return trie;
+}
+
+static xbytes_t next_range_origin(xbytes_t key) {
+    for (auto it = key.rbegin(); it != key.rend(); ++it) {
+        if (++(*it) != 0) {
+            break;
+        }
+    }
+    return key;
+}
+
+TEST_F(xtest_trie_fixture, test_range_proof) {
+    std::error_code ec;
+    auto const trie = build_range_test_trie(test_trie_db_ptr, 1000);
+    auto const root = trie->hash();
+
+    // walk the whole trie in ranges, every range is proven and ranges cover all leaves once.
+    xbytes_t origin(32, 0);
+    std::size_t total{0};
+    for (bool more = true; more;) {
+        std::vector<xbytes_t> keys;
+        std::vector<xbytes_t> values;
+        trie->range(origin, 64, 1024 * 1024, keys, values, ec);
+        ASSERT_TRUE(!ec);
+
+        auto const proof_db = std::make_shared<xmock_prove_db>();
+        trie->prove(origin, 0, proof_db, ec);
+        ASSERT_TRUE(!ec);
+        if (!keys.empty()) {
+            trie->prove(keys.back(), 0, proof_db, ec);
+            ASSERT_TRUE(!ec);
+        }
+        more = VerifyRangeProof(root, origin, keys.empty() ? origin : keys.back(), keys, values, proof_db, ec);
+        ASSERT_TRUE(!ec);
+        total += keys.size();
+        if (!keys.empty()) {
+            origin = next_range_origin(keys.back());
+        }
+    }
+    ASSERT_EQ(total, 1000u);
+}
+
+TEST_F(xtest_trie_fixture, test_range_proof_bad) {
+    std::error_code ec;
+    auto const trie = build_range_test_trie(test_trie_db_ptr, 1000);
+    auto const root = trie->hash();
+
+    xbytes_t const origin(32, 0x10);
+    std::vector<xbytes_t> keys;
+    std::vector<xbytes_t> values;
+    trie->range(origin, 64, 1024 * 1024, keys, values, ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_EQ(keys.size(), 64u);
+    ASSERT_TRUE(origin < keys.front());
+
+    auto const proof_db = std::make_shared<xmock_prove_db>();
+    trie->prove(origin, 0, proof_db, ec);
+    trie->prove(keys.back(), 0, proof_db, ec);
+    ASSERT_TRUE(!ec);
+
+    // a gap inside the range.
+    auto gap_keys = keys;
+    auto gap_values = values;
+    gap_keys.erase(gap_keys.begin() + 10);
+    gap_values.erase(gap_values.begin() + 10);
+    VerifyRangeProof(root, origin, gap_keys.back(), gap_keys, gap_values, proof_db, ec);
+    ASSERT_TRUE(ec);
+    ec.clear();
+
+    // a modified value.
+    auto bad_values = values;
+    bad_values[20] = to_bytes(std::string{"bad"});
+    VerifyRangeProof(root, origin, keys.back(), keys, bad_values, proof_db, ec);
+    ASSERT_TRUE(ec);
+    ec.clear();
+
+    // proof of last key missing.
+    auto const origin_proof_db = std::make_shared<xmock_prove_db>();
+    trie->prove(origin, 0, origin_proof_db, ec);
+    ASSERT_TRUE(!ec);
+    VerifyRangeProof(root, origin, keys.back(), keys, values, origin_proof_db, ec);
+    ASSERT_TRUE(ec);
+    ec.clear();
+
+    ASSERT_TRUE(VerifyRangeProof(root, origin, keys.back(), keys, values, proof_db, ec));
+    ASSERT_TRUE(!ec);
+}
+
+TEST_F(xtest_trie_fixture, test_multi_proof) {
+    std::error_code ec;
+    auto const root = build_range_test_trie(test_trie_db_ptr, 1000)->commit(ec).first;
+    ASSERT_TRUE(!ec);
+    // reopened from root, so nodes are resolved from db during the walk.
+    auto const trie = xtrie_t::build_from(root, test_trie_db_ptr, ec);
+    ASSERT_TRUE(!ec);
+
+    std::vector<xbytes_t> keys;
+    for (std::size_t i = 0; i < 1000; i += 20) {
+        keys.push_back(to_bytes(utl::xkeccak256_t::digest(std::to_string(i))));
+    }
+    keys.push_back(keys.front());  // duplicated
+    auto const absent = to_bytes(utl::xkeccak256_t::digest(std::string{"absent"}));
+    keys.push_back(absent);
+
+    auto const multi_proof_db = std::make_shared<xmemory_kv_db_t>();
+    ASSERT_TRUE(trie->prove_multi(keys, multi_proof_db, ec));
+    ASSERT_TRUE(!ec);
+
+    // the multi proof is exactly the union of single proofs, common nodes appear once.
+    auto const single_proof_db = std::make_shared<xmemory_kv_db_t>();
+    std::size_t single_proof_nodes{0};
+    for (auto const & key : keys) {
+        auto const proof_db = std::make_shared<xmemory_kv_db_t>();
+        trie->prove(key, 0, proof_db, ec);
+        ASSERT_TRUE(!ec);
+        single_proof_nodes += proof_db->data().size();
+        single_proof_db->PutBatch(proof_db->data(), ec);
+    }
+    ASSERT_EQ(multi_proof_db->data(), single_proof_db->data());
+    ASSERT_LT(multi_proof_db->data().size(), single_proof_nodes);
+
+    for (std::size_t i = 0; i + 2 < keys.size(); ++i) {
+        ASSERT_EQ(VerifyProof(root, keys[i], multi_proof_db, ec), to_bytes(std::to_string(i * 20)));
+        ASSERT_TRUE(!ec);
+    }
+    ASSERT_TRUE(VerifyProof(root, absent, multi_proof_db, ec).empty());
+    ASSERT_TRUE(!ec);
+}
+
+NS_END4
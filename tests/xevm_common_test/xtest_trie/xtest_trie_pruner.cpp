@@ -1,4 +1,5 @@
 #include "tests/xevm_common_test/trie_test_fixture/xtest_trie_fixture.h"
+#include "xevm_common/trie/xtrie_node_diff.h"
 
 NS_BEG4(top, evm_common, trie, tests)
 
@@ -259,4 +260,80 @@ TEST_F(xtest_trie_fixture, prune_empty) {
     ASSERT_EQ(size2, std::dynamic_pointer_cast<xmock_disk_db>(test_trie_db_ptr->DiskDB())->size());
 }
 
+
+static xhash256_t build_prune_test_roots(xtrie_db_ptr_t const & trie_db, xhash256_t & old_root) {
+    std::error_code ec;
+    auto trie = xtrie_t::build_from({}, trie_db, ec);
+    for (std::size_t i = 0; i < 64; ++i) {
+        UpdateString(trie, "key" + std::to_string(i), "value" + std::to_string(i));
+    }
+    old_root = trie->commit(ec).first;
+    trie_db->Commit(old_root, nullptr, ec);
+
+    auto trie2 = xtrie_t::build_from(old_root, trie_db, ec);
+    for (std::size_t i = 0; i < 64; i += 8) {
+        UpdateString(trie2, "key" + std::to_string(i), "changed" + std::to_string(i));
+    }
+    trie2->try_delete(top::to_bytes(std::string{"key1"}), ec);
+    trie2->try_delete(top::to_bytes(std::string{"key33"}), ec);
+    UpdateString(trie2, "key64", "value64");
+    auto const new_root = trie2->commit(ec).first;
+    trie_db->Commit(new_root, nullptr, ec);
+    return new_root;
+}
+
+TEST_F(xtest_trie_fixture, prune_incremental) {
+    std::error_code ec;
+    auto config = std::make_shared<xtrie_db_config_t>();
+    config->Node_diff = true;
+    auto trie_db = xtrie_db_t::NewDatabaseWithConfig(test_disk_db_ptr, config);
+
+    xhash256_t old_root;
+    auto const new_root = build_prune_test_roots(trie_db, old_root);
+    ASSERT_NE(old_root, new_root);
+
+    xtrie_node_diff_t diff;
+    ASSERT_TRUE(ReadNodeDiff(test_disk_db_ptr, new_root, diff));
+    ASSERT_EQ(diff.parent, old_root);
+    ASSERT_FALSE(diff.inserted.empty());
+    ASSERT_FALSE(diff.obsolete.empty());
+
+    // same workload with full walk pruning
+    auto legacy_disk_db = std::make_shared<xmock_disk_db>();
+    auto legacy_trie_db = xtrie_db_t::NewDatabase(legacy_disk_db);
+    xhash256_t legacy_old_root;
+    ASSERT_EQ(new_root, build_prune_test_roots(legacy_trie_db, legacy_old_root));
+    auto legacy_trie = xtrie_t::build_from(new_root, legacy_trie_db, ec);
+    legacy_trie->prune(legacy_old_root, ec);
+    legacy_trie->commit_pruned(ec);
+    ASSERT_TRUE(!ec);
+
+    auto const size_before = test_disk_db_ptr->size();
+    auto trie = xtrie_t::build_from(new_root, trie_db, ec);
+    trie->prune(old_root, ec);
+    ASSERT_TRUE(!ec);
+    trie->commit_pruned(ec);
+    ASSERT_TRUE(!ec);
+    ASSERT_TRUE(test_disk_db_ptr->size() < size_before);
+    ASSERT_FALSE(ReadNodeDiff(test_disk_db_ptr, old_root, diff));
+
+    // nodes left are exactly what the full walk keeps, plus node diff of the kept root.
+    ASSERT_EQ(test_disk_db_ptr->size(), legacy_disk_db->size() + 1);
+    for (auto const & kv : legacy_disk_db->m) {
+        ASSERT_TRUE(test_disk_db_ptr->m.count(kv.first) == 1);
+    }
+
+    auto check_db = xtrie_db_t::NewDatabase(test_disk_db_ptr);
+    auto check = xtrie_t::build_from(new_root, check_db, ec);
+    ASSERT_TRUE(!ec);
+    for (std::size_t i = 2; i < 64; ++i) {
+        if (i == 33) {
+            continue;
+        }
+        auto const expected = i % 8 == 0 ? "changed" + std::to_string(i) : "value" + std::to_string(i);
+        ASSERT_EQ(check->get(top::to_bytes("key" + std::to_string(i))), top::to_bytes(expected));
+    }
+    ASSERT_EQ(check->get(top::to_bytes(std::string{"key64"})), top::to_bytes(std::string{"value64"}));
+}
+
 NS_END4
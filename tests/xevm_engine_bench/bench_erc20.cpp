@@ -0,0 +1,113 @@
+#include "tests/xevm_engine_bench/xevm_bench.h"
+
+#include "xbasic/xhex.h"
+
+#include <cassert>
+#include <cstdio>
+
+NS_BEG4(top, contract_runtime, evm, bench)
+
+namespace {
+
+// the erc20 of tests/xevm_engine_test/test_evm_concurrency.cpp, the deployer holds the supply of 100000
+std::string const erc20_code{
+        "60806040526040518060400160405280600781526020017f4d794572633230000000000000000000000000000000000000000000000000008152506003908051906020019061004f92919061016a565b50604051"
+        "8060400160405280600381526020017f53594d00000000000000000000000000000000000000000000000000000000008152506004908051906020019061009b92919061016a565b506012600560006101000a81"
+        "548160ff021916908360ff1602179055503480156100c457600080fd5b50620186a0600081905550600054600160003373ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffff"
+        "ffffffffffffff168152602001908152602001600020819055503373ffffffffffffffffffffffffffffffffffffffff167f60226e015dfa2f4684230d052fa02b7297d54471129f02a9585f4f4a81e9e0d26000"
+        "546040518082815260200191505060405180910390a261020f565b828054600181600116156101000203166002900490600052602060002090601f016020900481019282601f106101ab57805160ff1916838001"
+        "1785556101d9565b828001600101855582156101d9579182015b828111156101d85782518255916020019190600101906101bd565b5b5090506101e691906101ea565b5090565b61020c91905b80821115610208"
+        "5760008160009055506001016101f0565b5090565b90565b610a5b8061021e6000396000f3fe608060405234801561001057600080fd5b506004361061009e5760003560e01c806342966c681161006657806342"
+        "966c681461025457806370a082311461028257806395d89b41146102da578063a9059cbb1461035d578063dd62ed3e146103c35761009e565b806306fdde03146100a3578063095ea7b31461012657806318160d"
+        "dd1461018c57806323b872dd146101aa578063313ce56714610230575b600080fd5b6100ab61043b565b6040518080602001828103825283818151815260200191508051906020019080838360005b8381101561"
+        "00eb5780820151818401526020810190506100d0565b50505050905090810190601f1680156101185780820380516001836020036101000a031916815260200191505b509250505060405180910390f35b610172"
+        "6004803603604081101561013c57600080fd5b81019080803573ffffffffffffffffffffffffffffffffffffffff169060200190929190803590602001909291905050506104d9565b6040518082151515158152"
+        "60200191505060405180910390f35b6101946105cb565b6040518082815260200191505060405180910390f35b610216600480360360608110156101c057600080fd5b81019080803573ffffffffffffffffffff"
+        "ffffffffffffffffffff169060200190929190803573ffffffffffffffffffffffffffffffffffffffff169060200190929190803590602001909291905050506105d1565b604051808215151515815260200191"
+        "505060405180910390f35b610238610767565b604051808260ff1660ff16815260200191505060405180910390f35b6102806004803603602081101561026a57600080fd5b810190808035906020019092919050"
+        "505061077a565b005b6102c46004803603602081101561029857600080fd5b81019080803573ffffffffffffffffffffffffffffffffffffffff16906020019092919050505061083f565b604051808281526020"
+        "0191505060405180910390f35b6102e2610857565b6040518080602001828103825283818151815260200191508051906020019080838360005b8381101561032257808201518184015260208101905061030756"
+        "5b50505050905090810190601f16801561034f5780820380516001836020036101000a031916815260200191505b509250505060405180910390f35b6103a96004803603604081101561037357600080fd5b8101"
+        "9080803573ffffffffffffffffffffffffffffffffffffffff169060200190929190803590602001909291905050506108f5565b604051808215151515815260200191505060405180910390f35b610425600480"
+        "360360408110156103d957600080fd5b81019080803573ffffffffffffffffffffffffffffffffffffffff169060200190929190803573ffffffffffffffffffffffffffffffffffffffff169060200190929190"
+        "505050610a00565b6040518082815260200191505060405180910390f35b60038054600181600116156101000203166002900480601f016020809104026020016040519081016040528092919081815260200182"
+        "8054600181600116156101000203166002900480156104d15780601f106104a6576101008083540402835291602001916104d1565b820191906000526020600020905b8154815290600101906020018083116104"
+        "b457829003601f168201915b505050505081565b600081600260003373ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff16815260200190815260200160"
+        "002060008573ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff168152602001908152602001600020819055508273ffffffffffffffffffffffffffffff"
+        "ffffffffff163373ffffffffffffffffffffffffffffffffffffffff167f8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925846040518082815260200191505060405180910390a3"
+        "6001905092915050565b60005481565b600081600260008673ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff1681526020019081526020016000206000"
+        "3373ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff1681526020019081526020016000206000828254039250508190555081600160008673ffffffffff"
+        "ffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff1681526020019081526020016000206000828254039250508190555081600160008573ffffffffffffffffffffffff"
+        "ffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff168152602001908152602001600020600082825401925050819055508273ffffffffffffffffffffffffffffffffffffffff168473ff"
+        "ffffffffffffffffffffffffffffffffffffff167fddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef846040518082815260200191505060405180910390a3600190509392505050"
+        "565b600560009054906101000a900460ff1681565b80600160003373ffffffffffffffffffffffffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff1681526020019081526020016000"
+        "2060008282540392505081905550806000808282540392505081905550600073ffffffffffffffffffffffffffffffffffffffff163373ffffffffffffffffffffffffffffffffffffffff167fddf252ad1be2c8"
+        "9b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef836040518082815260200191505060405180910390a350565b60016020528060005260406000206000915090505481565b60048054600181600116"
+        "156101000203166002900480601f0160208091040260200160405190810160405280929190818152602001828054600181600116156101000203166002900480156108ed5780601f106108c25761010080835404"
+        "02835291602001916108ed565b820191906000526020600020905b8154815290600101906020018083116108d057829003601f168201915b505050505081565b600081600160003373ffffffffffffffffffffff"
+        "ffffffffffffffffff1673ffffffffffffffffffffffffffffffffffffffff1681526020019081526020016000206000828254039250508190555081600160008573ffffffffffffffffffffffffffffffffffff"
+        "ffff1673ffffffffffffffffffffffffffffffffffffffff168152602001908152602001600020600082825401925050819055508273ffffffffffffffffffffffffffffffffffffffff163373ffffffffffffff"
+        "ffffffffffffffffffffffffff167fddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef846040518082815260200191505060405180910390a36001905092915050565b6002602052"
+        "81600052604060002060205280600052604060002060009150915050548156fea2646970667358221220d85b6d67c18cbaefa92cadb028ffbb9d0d410e0960f7466456990c711ab8a77464736f6c634300060400"
+        "33"};
+
+std::string const erc20_owner{"T60004001bdc8251890aafc5841b05620c0eab336e3ebc"};
+
+std::string const selector_transfer{"0xa9059cbb"};
+std::string const selector_approve{"0x095ea7b3"};
+std::string const selector_transfer_from{"0x23b872dd"};
+std::string const selector_balance_of{"0x70a08231"};
+
+// a fresh holder for every run, so each transfer writes a slot that was never written
+std::string holder(uint64_t index) {
+    char buf[41];
+    std::snprintf(buf, sizeof(buf), "%040llx", static_cast<unsigned long long>(0x1000 + index));
+    return std::string{"T60004"} + buf;
+}
+
+bool succeeded(evm_common::xevm_transaction_result_t const & result) {
+    return result.status == evm_common::xevm_transaction_status_t::Success;
+}
+
+}  // namespace
+
+std::vector<xbench_result_t> run_erc20_workloads(uint64_t runs) {
+    std::vector<xbench_result_t> results;
+    std::error_code ec;
+    auto const code = top::from_hex(erc20_code, ec);
+    assert(!ec);
+
+    xevm_bench_t bench;
+    std::string contract;
+    results.push_back(bench.run("erc20_deploy", 1, [&](uint64_t) {
+        contract = bench.deploy(erc20_owner, code);
+        return !contract.empty();
+    }));
+    if (contract.empty()) {
+        return results;
+    }
+
+    results.push_back(bench.run("erc20_transfer", runs, [&](uint64_t i) {
+        return succeeded(bench.call(erc20_owner, contract, abi_call(selector_transfer, {abi_address(holder(i)), abi_uint(1)})));
+    }));
+
+    results.push_back(bench.run("erc20_transfer_warm", runs, [&](uint64_t) {
+        return succeeded(bench.call(erc20_owner, contract, abi_call(selector_transfer, {abi_address(holder(0)), abi_uint(1)})));
+    }));
+
+    results.push_back(bench.run("erc20_balance_of", runs, [&](uint64_t i) {
+        return succeeded(bench.call(erc20_owner, contract, abi_call(selector_balance_of, {abi_address(holder(i))})));
+    }));
+
+    results.push_back(bench.run("erc20_approve_transfer_from", runs, [&](uint64_t i) {
+        auto const spender = holder(i);
+        if (!succeeded(bench.call(erc20_owner, contract, abi_call(selector_approve, {abi_address(spender), abi_uint(1)})))) {
+            return false;
+        }
+        return succeeded(bench.call(spender, contract, abi_call(selector_transfer_from, {abi_address(erc20_owner), abi_address(holder(runs + i)), abi_uint(1)})));
+    }));
+
+    return results;
+}
+
+NS_END4
@@ -0,0 +1,67 @@
+#include "tests/xevm_engine_bench/xevm_bench.h"
+#include "xbase/xhash.h"
+#include "xbase/xlog.h"
+#include "xdata/xrootblock.h"
+#include "xmetrics/xmetrics.h"
+#include "xutility/xhash.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+std::atomic<uint64_t> top::contract_runtime::evm::bench::g_allocations{0};
+
+void * operator new(std::size_t size) {
+    top::contract_runtime::evm::bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void * p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+class xhashtest_t : public top::base::xhashplugin_t {
+public:
+    xhashtest_t() : top::base::xhashplugin_t(-1) {
+    }
+
+private:
+    xhashtest_t(const xhashtest_t &);
+    xhashtest_t & operator=(const xhashtest_t &);
+    ~xhashtest_t() override = default;
+
+public:
+    const std::string hash(const std::string & input, enum_xhash_type type) override {
+        auto hash = top::utl::xsha2_256_t::digest(input);
+        return std::string(reinterpret_cast<char *>(hash.data()), hash.size());
+    }
+};
+
+// usage: xevm_engine_bench [runs of each workload, 1000 by default]
+int main(int argc, char ** argv) {
+    XMETRICS_INIT();
+    xinit_log("./xevm_bench.log", true, true);
+    xset_log_level(enum_xlog_level_warn);
+
+    new xhashtest_t();
+    top::data::xrootblock_para_t para;
+    top::data::xrootblock_t::init(para);
+
+    uint64_t runs = 1000;
+    if (argc > 1) {
+        runs = std::strtoull(argv[1], nullptr, 10);
+    }
+
+    auto const results = top::contract_runtime::evm::bench::run_erc20_workloads(runs);
+    top::contract_runtime::evm::bench::xevm_bench_t::report(results);
+    for (auto const & result : results) {
+        if (result.failures > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "tests/xevm_engine_bench/xevm_bench.h"
+
+#include "xbasic/xhex.h"
+#include "xbasic/xmemory.hpp"
+#include "xevm/xevm.h"
+#include "xevm_contract_runtime/xevm_contract_manager.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+NS_BEG4(top, contract_runtime, evm, bench)
+
+xevm_bench_t::xevm_bench_t() {
+    top::evm::xevm_profiler_t::enable(true);
+}
+
+evm_common::xevm_transaction_result_t xevm_bench_t::execute(std::string const & sender, std::string const & recver, xbytes_t const & data, uint64_t gas_limit) {
+    auto evm_action = top::make_unique<data::xconsensus_action_t<data::xtop_action_type_t::evm>>(
+        common::xaccount_address_t{sender}, recver.empty() ? eth_zero_address : common::xaccount_address_t{recver}, evm_common::u256{0}, data, gas_limit);
+    auto contract_manager = top::make_observer<xevm_contract_manager_t>(xevm_contract_manager_t::instance());
+    top::evm::xtop_evm evm{contract_manager, m_statectx};
+    return evm.execute_action(std::move(evm_action), m_vm_param);
+}
+
+std::string xevm_bench_t::deploy(std::string const & sender, xbytes_t const & code) {
+    auto result = execute(sender, std::string{}, code, 3000000);
+    if (result.status != evm_common::xevm_transaction_status_t::Success) {
+        return {};
+    }
+    return evm_to_top_address(result.extra_msg);
+}
+
+evm_common::xevm_transaction_result_t xevm_bench_t::call(std::string const & sender, std::string const & contract, xbytes_t const & input, uint64_t gas_limit) {
+    return execute(sender, contract, input, gas_limit);
+}
+
+xbench_result_t xevm_bench_t::run(std::string const & name, uint64_t runs, std::function<bool(uint64_t)> const & workload) {
+    xbench_result_t result;
+    result.name = name;
+    result.runs = runs;
+
+    top::evm::xevm_profiler_t::profile().reset();
+    uint64_t const allocations = g_allocations.load();
+    auto const begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < runs; ++i) {
+        if (!workload(i)) {
+            result.failures++;
+        }
+    }
+    result.nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+    result.allocations = g_allocations.load() - allocations;
+    result.profile = top::evm::xevm_profiler_t::profile();
+    return result;
+}
+
+void xevm_bench_t::report(std::vector<xbench_result_t> const & results) {
+    for (auto const & result : results) {
+        auto const runs = result.runs > 0 ? result.runs : 1;
+        auto const & profile = result.profile;
+        std::printf("== %s: %llu runs, %llu failed, %.1f us/run, engine %.1f us/run, %.1f allocations/run\n",
+                    result.name.c_str(),
+                    static_cast<unsigned long long>(result.runs),
+                    static_cast<unsigned long long>(result.failures),
+                    result.nanos / 1000.0 / runs,
+                    profile.engine_nanos() / 1000.0 / runs,
+                    static_cast<double>(result.allocations) / runs);
+        for (std::size_t i = 0; i < top::evm::xevm_profile_t::class_count; ++i) {
+            if (profile.calls[i] == 0) {
+                continue;
+            }
+            std::printf("   %-15s %8.1f calls/run %8.2f us/run\n",
+                        top::evm::to_string(static_cast<top::evm::xevm_import_class_t>(i)),
+                        static_cast<double>(profile.calls[i]) / runs,
+                        profile.nanos[i] / 1000.0 / runs);
+        }
+    }
+}
+
+xbytes_t abi_call(std::string const & selector, std::vector<std::string> const & words) {
+    std::string hex = selector;
+    for (auto const & word : words) {
+        hex += word;
+    }
+    std::error_code ec;
+    auto bytes = top::from_hex(hex, ec);
+    assert(!ec);
+    return bytes;
+}
+
+std::string abi_address(std::string const & top_address) {
+    // T60004 + 40 hex chars of the eth address
+    return std::string(24, '0') + top_address.substr(6);
+}
+
+std::string abi_uint(uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return std::string(48, '0') + buf;
+}
+
+NS_END4
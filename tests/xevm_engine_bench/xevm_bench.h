@@ -0,0 +1,58 @@
+#pragma once
+
+#include "tests/xevm_engine_test/evm_test_fixture/xmock_evm_statectx.h"
+#include "xbasic/xbyte_buffer.h"
+#include "xevm_common/xevm_transaction_result.h"
+#include "xevm_runner/evm_profile.h"
+#include "xtxexecutor/xvm_face.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+NS_BEG4(top, contract_runtime, evm, bench)
+
+// heap allocations of the process, counted by the operator new of the benchmark
+extern std::atomic<uint64_t> g_allocations;
+
+struct xbench_result_t {
+    std::string name;
+    uint64_t runs{0};
+    uint64_t failures{0};
+    uint64_t nanos{0};
+    uint64_t allocations{0};
+    top::evm::xevm_profile_t profile;
+};
+
+// runs evm actions against an in-memory statectx with the profiler of the thread enabled
+class xevm_bench_t {
+public:
+    xevm_bench_t();
+
+    // deploys code from sender and returns the top address of the contract, empty if it failed
+    std::string deploy(std::string const & sender, xbytes_t const & code);
+    evm_common::xevm_transaction_result_t call(std::string const & sender, std::string const & contract, xbytes_t const & input, uint64_t gas_limit = 200000);
+
+    // times runs of one workload, setup is not measured
+    xbench_result_t run(std::string const & name, uint64_t runs, std::function<bool(uint64_t)> const & workload);
+
+    static void report(std::vector<xbench_result_t> const & results);
+
+private:
+    evm_common::xevm_transaction_result_t execute(std::string const & sender, std::string const & recver, xbytes_t const & data, uint64_t gas_limit);
+
+    txexecutor::xvm_para_t m_vm_param{0, "random_seed", 0, 0, 0, eth_zero_address};
+    std::shared_ptr<top::evm::tests::xmock_evm_statectx> m_statectx{std::make_shared<top::evm::tests::xmock_evm_statectx>()};
+};
+
+// abi encoding of the few calls the workloads make
+xbytes_t abi_call(std::string const & selector, std::vector<std::string> const & words);
+std::string abi_address(std::string const & top_address);
+std::string abi_uint(uint64_t value);
+
+std::vector<xbench_result_t> run_erc20_workloads(uint64_t runs);
+
+NS_END4
@@ -9,9 +9,11 @@
 #define ENABLE_METRICS
 #endif
 #include "xmetrics/xmetrics.h"
+#include "xmetrics/xhot_accounts.h"
 
 #include <gtest/gtest.h>
 #include <cinttypes>
+#include <vector>
 
 #define TEST_CASE_SIZE 7
 #define SLEEP_SECOND(t) std::this_thread::sleep_for(std::chrono::seconds(t))
@@ -285,4 +287,140 @@ TEST_F(metrics_test, gauge) {
     EXPECT_GT(XMETRICS_GAUGE_GET_VALUE(top::metrics::db_delete_tick), 20);
 }
 
+TEST_F(metrics_test, gauge_multi_thread) {
+    auto const before = XMETRICS_GAUGE_GET_VALUE(top::metrics::db_read);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 32; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10000; ++i) {
+                XMETRICS_GAUGE(top::metrics::db_read, 1);
+            }
+        });
+    }
+    for (auto & t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(XMETRICS_GAUGE_GET_VALUE(top::metrics::db_read), before + 32 * 10000);
+
+    XMETRICS_GAUGE_SET_VALUE(top::metrics::db_read, 7);
+    EXPECT_EQ(XMETRICS_GAUGE_GET_VALUE(top::metrics::db_read), 7);
+}
+
+TEST(test_metrics, histogram_buckets) {
+    using top::metrics::xhistogram_snapshot_t;
+    for (uint64_t value = 0; value < (1 << 20); ++value) {
+        auto const bucket = xhistogram_snapshot_t::bucket_of(value);
+        ASSERT_LE(xhistogram_snapshot_t::lower_bound_of(bucket), value);
+        ASSERT_GE(xhistogram_snapshot_t::upper_bound_of(bucket), value);
+        // within 1/16 of the value
+        ASSERT_LE(xhistogram_snapshot_t::upper_bound_of(bucket) - xhistogram_snapshot_t::lower_bound_of(bucket), value / 16);
+    }
+    EXPECT_EQ(xhistogram_snapshot_t::bucket_of(UINT64_MAX), xhistogram_snapshot_t::bucket_count - 1);
+}
+
+TEST(test_metrics, histogram_percentile) {
+    top::metrics::xlatency_histogram_t histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram] {
+            for (uint64_t value = 1; value <= 1000; ++value) {
+                histogram.record(value);
+            }
+        });
+    }
+    for (auto & t : threads) {
+        t.join();
+    }
+    auto const snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 4000u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_EQ(snapshot.mean(), 500u);
+    EXPECT_NEAR(snapshot.percentile(0.5), 500, 500 / 16);
+    EXPECT_NEAR(snapshot.percentile(0.99), 990, 990 / 16);
+    EXPECT_EQ(snapshot.percentile(1.0), 1000u);
+}
+
+TEST_F(metrics_test, histogram_dump) {
+    for (uint64_t value = 1; value <= 100; ++value) {
+        XMETRICS_HISTOGRAM(top::metrics::db_read_latency_hist, value);
+    }
+    EXPECT_EQ(top::metrics::e_metrics::get_instance().histogram_get(top::metrics::db_read_latency_hist).count, 100u);
+    top::metrics::e_metrics::get_instance().histogram_dump();
+}
+
 // #endif
+
+TEST(test_metrics, openmetrics_labels) {
+    using top::metrics::xopenmetrics_writer_t;
+    EXPECT_EQ(top::metrics::metrics_labels({{"table", "12"}, {"peer", "a\"b"}}), "{table=\"12\",peer=\"a\\\"b\"}");
+    EXPECT_EQ(xopenmetrics_writer_t::split_labels("vhost_out_send{category=\"3\"}").first, "vhost_out_send");
+    EXPECT_EQ(xopenmetrics_writer_t::split_labels("vhost_out_send{category=\"3\"}").second, "{category=\"3\"}");
+    EXPECT_EQ(xopenmetrics_writer_t::split_labels("vhost_out_send").second, "");
+
+    xopenmetrics_writer_t writer;
+    auto const name = writer.family("db.read", "counter");
+    writer.sample(name + "_total", "", int64_t{3});
+    EXPECT_EQ(writer.finish(), "# TYPE top_db_read counter\ntop_db_read_total 3\n# EOF\n");
+}
+
+TEST_F(metrics_test, openmetrics_text) {
+    XMETRICS_GAUGE(top::metrics::db_write, 1);
+    XMETRICS_HISTOGRAM(top::metrics::db_write_latency_hist, 40);
+    XMETRICS_COUNTER_INCREMENT("test_openmetrics" + top::metrics::metrics_labels({{"table", "1"}}), 5);
+
+    auto & metrics = top::metrics::e_metrics::get_instance();
+    auto text = metrics.openmetrics_text();
+    EXPECT_NE(text.find("# TYPE top_db_write gauge\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE top_db_write_latency_hist_microseconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("top_db_write_latency_hist_microseconds_bucket{le=\"63\"} "), std::string::npos);
+    EXPECT_NE(text.find("top_cons_worker_queue_size{worker=\"0\"} "), std::string::npos);
+    EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+
+    // the queued counter shows up once the process thread has published the hub for the scrape
+    SLEEP_SECOND(3);
+    text = metrics.openmetrics_text();
+    EXPECT_NE(text.find("top_test_openmetrics{table=\"1\"} 5\n"), std::string::npos);
+}
+
+TEST(test_metrics, hot_accounts_space_saving) {
+    top::metrics::xspace_saving_t sketch{4};
+    for (int i = 0; i < 100; ++i) {
+        sketch.add("heavy", 10);
+        sketch.add("medium", 3);
+        sketch.add("light" + std::to_string(i), 1);
+    }
+    auto const top = sketch.top(2);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].account, "heavy");
+    EXPECT_EQ(top[0].value, 1000u);
+    EXPECT_EQ(top[0].error, 0u);
+    EXPECT_EQ(top[1].account, "medium");
+    EXPECT_EQ(top[1].value, 300u);
+    EXPECT_EQ(sketch.top(10).size(), 4u);
+}
+
+TEST(test_metrics, hot_accounts_sampling) {
+    auto & hot = top::metrics::xhot_accounts_t::instance();
+    hot.reset();
+    hot.set_sample_rate(4);
+    std::size_t sampled = 0;
+    for (int i = 0; i < 400; ++i) {
+        if (hot.sampled()) {
+            ++sampled;
+            hot.record(top::metrics::xhot_dimension_t::txs, "Ta0000@1", "T80000spammer", 1);
+        }
+    }
+    EXPECT_EQ(sampled, 100u);
+    auto const tables = hot.top(top::metrics::xhot_dimension_t::txs, 3);
+    ASSERT_EQ(tables.size(), 1u);
+    EXPECT_EQ(tables.at("Ta0000@1").front().value, 400u);
+    EXPECT_TRUE(hot.top(top::metrics::xhot_dimension_t::txs, 3, "Ta0000@2").empty());
+
+    top::metrics::xopenmetrics_writer_t writer;
+    hot.openmetrics(writer, 3);
+    EXPECT_NE(writer.finish().find("top_hot_account_txs{table=\"Ta0000@1\",account=\"T80000spammer\"} 400\n"), std::string::npos);
+
+    hot.set_sample_rate(0);
+    EXPECT_FALSE(hot.sampled());
+    hot.reset();
+}
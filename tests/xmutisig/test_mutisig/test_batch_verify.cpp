@@ -0,0 +1,39 @@
+﻿#include "../test_common.h"
+
+NS_BEG2(top, xmutisig)
+
+TEST(xmutisig, batch_verify_sign) {
+    const uint32_t count = 16;
+    std::vector<std::string> msgs;
+    std::vector<xpubkey> pubkeys;
+    std::vector<std::string> signs;
+    std::vector<std::string> points;
+    for (uint32_t i = 0; i < count; i++) {
+        key_pair_t keypair = xschnorr::instance()->generate_key_pair();
+        rand_pair_t rand_pair = xschnorr::instance()->generate_rand_pair();
+        std::string msg = "batch_verify_sign_" + std::to_string(i % 4);  // same message signed by many nodes, as votes
+        std::string sign;
+        xmutisig::sign(msg, keypair.first, sign, rand_pair.first, rand_pair.second, xschnorr::instance());
+
+        msgs.push_back(msg);
+        pubkeys.push_back(keypair.second);
+        signs.push_back(sign);
+        points.push_back(rand_pair.second.get_serialize_str());
+    }
+    EXPECT_TRUE(xmutisig::batch_verify_sign(msgs, pubkeys, signs, points, xschnorr::instance()));
+
+    // one signature of other message makes whole batch fail
+    std::vector<std::string> bad_msgs = msgs;
+    bad_msgs[count / 2] = "batch_verify_sign_bad";
+    EXPECT_FALSE(xmutisig::verify_sign(bad_msgs[count / 2], pubkeys[count / 2], signs[count / 2], points[count / 2], xschnorr::instance()));
+    EXPECT_FALSE(xmutisig::batch_verify_sign(bad_msgs, pubkeys, signs, points, xschnorr::instance()));
+
+    // swapped signatures of two nodes must not pass even if their sum is unchanged
+    std::vector<std::string> swapped_signs = signs;
+    std::swap(swapped_signs[0], swapped_signs[1]);
+    EXPECT_FALSE(xmutisig::batch_verify_sign(msgs, pubkeys, swapped_signs, points, xschnorr::instance()));
+
+    EXPECT_FALSE(xmutisig::batch_verify_sign({}, {}, {}, {}, xschnorr::instance()));
+}
+
+NS_END2
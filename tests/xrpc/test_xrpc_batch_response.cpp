@@ -0,0 +1,31 @@
+#include "gtest/gtest.h"
+#include "xrpc/xrpc_batch_response.h"
+
+using namespace top;
+using namespace top::xrpc;
+
+TEST(test_xrpc_batch_response, order_and_concurrency) {
+    std::vector<uint32_t> dispatched;
+    std::string result;
+    auto batch = std::make_shared<xrpc_batch_response_t>(
+        4,
+        2,
+        [&dispatched](std::shared_ptr<xrpc_batch_response_t> const &, uint32_t index) { dispatched.push_back(index); },
+        [&result](const std::string & response) { result = response; });
+
+    batch->start();
+    ASSERT_EQ(dispatched, (std::vector<uint32_t>{0, 1}));
+
+    // every response starts the next request, the array keeps the request order
+    batch->set(1, "{\"id\":1}\n");
+    ASSERT_EQ(dispatched, (std::vector<uint32_t>{0, 1, 2}));
+    batch->set(1, "{\"id\":-1}");
+    ASSERT_EQ(dispatched.size(), 3u);
+    batch->set(2, "{\"id\":2}");
+    batch->set(0, "{\"id\":0}");
+    ASSERT_EQ(dispatched, (std::vector<uint32_t>{0, 1, 2, 3}));
+    EXPECT_TRUE(result.empty());
+
+    batch->set(3, "{\"id\":3}");
+    EXPECT_EQ(result, "[{\"id\":0},{\"id\":1},{\"id\":2},{\"id\":3}]");
+}
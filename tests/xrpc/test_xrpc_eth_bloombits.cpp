@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "xevm_common/xbloom9.h"
+#include "xrpc/xrpc_eth_bloombits.h"
+
+using namespace top;
+using namespace top::xrpc;
+
+class test_xrpc_eth_bloombits : public testing::Test {
+protected:
+    xbytes_t bloom_of(std::vector<xbytes_t> const & values) {
+        evm_common::xbloom9_t bloom;
+        for (auto & value : values) {
+            bloom.add(value);
+        }
+        return bloom.get_data();
+    }
+
+    bool is_set(xbytes_t const & matched, uint64_t offset) {
+        return !matched.empty() && (matched[offset / 8] & (0x80 >> (offset % 8)));
+    }
+
+    xbytes_t m_address{xbytes_t(20, 0x11)};
+    xbytes_t m_other_address{xbytes_t(20, 0x22)};
+    xbytes_t m_topic{xbytes_t(32, 0x33)};
+    xbytes_t m_other_topic{xbytes_t(32, 0x44)};
+};
+
+TEST_F(test_xrpc_eth_bloombits, bit_indexes) {
+    auto bits = xrpc_eth_bloombits_t::bit_indexes(m_address);
+    EXPECT_GE(bits.size(), (size_t)1);
+    EXPECT_LE(bits.size(), (size_t)3);
+    for (auto bit : bits) {
+        EXPECT_LT(bit, xrpc_eth_bloombits_t::bloom_bit_count);
+    }
+}
+
+TEST_F(test_xrpc_eth_bloombits, match) {
+    std::vector<xbytes_t> vectors(xrpc_eth_bloombits_t::bloom_bit_count);
+    xrpc_eth_bloombits_t::set_bloom(vectors, 1, bloom_of({m_address, m_topic}));
+    xrpc_eth_bloombits_t::set_bloom(vectors, 100, bloom_of({m_address, m_other_topic}));
+    xrpc_eth_bloombits_t::set_bloom(vectors, 4095, bloom_of({m_other_address, m_topic}));
+    auto load = [&vectors](uint32_t bit) { return vectors[bit]; };
+
+    auto matched = xrpc_eth_bloombits_t::match(load, {{m_address}});
+    EXPECT_TRUE(is_set(matched, 1));
+    EXPECT_TRUE(is_set(matched, 100));
+    EXPECT_FALSE(is_set(matched, 4095));
+    EXPECT_FALSE(is_set(matched, 0));
+
+    // and of the groups
+    matched = xrpc_eth_bloombits_t::match(load, {{m_address}, {m_topic}});
+    EXPECT_TRUE(is_set(matched, 1));
+    EXPECT_FALSE(is_set(matched, 100));
+    EXPECT_FALSE(is_set(matched, 4095));
+
+    // or in one group, empty groups match anything
+    matched = xrpc_eth_bloombits_t::match(load, {{}, {m_topic, m_other_topic}});
+    EXPECT_TRUE(is_set(matched, 1));
+    EXPECT_TRUE(is_set(matched, 100));
+    EXPECT_TRUE(is_set(matched, 4095));
+
+    matched = xrpc_eth_bloombits_t::match(load, {{xbytes_t(20, 0x55)}});
+    EXPECT_TRUE(matched.empty());
+
+    matched = xrpc_eth_bloombits_t::match(load, {});
+    EXPECT_TRUE(is_set(matched, 0));
+    EXPECT_TRUE(is_set(matched, 4095));
+}
@@ -110,3 +110,21 @@ TEST_F(test_xrpc_eth_parser, transaction_to_json2) {
 }
 
 
+TEST_F(test_xrpc_eth_parser, transaction_to_json_writer) {
+    xrpc::xtx_location_t txlocation("0x01", "0x2", "0x03", "0x4");
+    common::xeth_address_t from = common::xeth_address_t::build_from("0xbc9b5f068bc20a5b12030fcb72975d8bddc4e84c");
+    common::xeth_address_t to = common::xeth_address_t::build_from("0xaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+    xJson::FastWriter fast_writer;
+
+    // a call and a deploy, which has no to
+    for (auto const & ethtx : {data::xeth_transaction_t(from, to, xbytes_t{1, 2}, 100, 21000, 10), data::xeth_transaction_t(from, common::xeth_address_t{}, xbytes_t{}, 0, 21000, 10)}) {
+        xJson::Value js_v;
+        std::error_code ec;
+        xrpc::xrpc_eth_parser_t::transaction_to_json(txlocation, ethtx, js_v, ec);
+
+        xrpc::xrpc_json_buffer_t buffer;
+        xrpc::xrpc_json_writer_t writer(buffer);
+        xrpc::xrpc_eth_parser_t::transaction_to_json(txlocation, ethtx, writer);
+        EXPECT_EQ(std::string(buffer.GetString(), buffer.GetSize()) + "\n", fast_writer.write(js_v));
+    }
+}
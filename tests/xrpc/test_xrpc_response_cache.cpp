@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include "xrpc/xrpc_response_cache.h"
+
+using namespace top;
+using namespace top::xrpc;
+
+TEST(test_xrpc_response_cache, make_key) {
+    xJson::Reader reader;
+    xJson::Value params1;
+    xJson::Value params2;
+    ASSERT_TRUE(reader.parse("{\"type\":\"height\",\"height\":10,\"account_addr\":\"T0\"}", params1));
+    ASSERT_TRUE(reader.parse("{\"account_addr\":\"T0\",\"height\":10,\"type\":\"height\"}", params2));
+    EXPECT_EQ(xrpc_response_cache_t::make_key("getBlock", params1), xrpc_response_cache_t::make_key("getBlock", params2));
+    EXPECT_NE(xrpc_response_cache_t::make_key("getBlock", params1), xrpc_response_cache_t::make_key("getTransaction", params1));
+}
+
+TEST(test_xrpc_response_cache, put_get) {
+    auto & cache = xrpc_response_cache_t::instance();
+    cache.clear();
+
+    xJson::Value result;
+    result["number"] = "0x10";
+    result["hash"] = "0xabcd";
+    std::string key = "eth_getBlockByNumber\n[\"0x10\",false]";
+    std::string cached;
+    ASSERT_FALSE(cache.get(key, cached));
+    cache.put(key, result);
+    ASSERT_TRUE(cache.get(key, cached));
+
+    // the spliced response is the one written without the cache
+    xJson::FastWriter writer;
+    xJson::Value response;
+    response["id"] = 1;
+    response["jsonrpc"] = "2.0";
+    response["result"] = xJson::Value::null;
+    std::string body = writer.write(response);
+    ASSERT_TRUE(xrpc_response_cache_t::splice(body, "result", cached));
+    response["result"] = result;
+    EXPECT_EQ(body, writer.write(response));
+
+    cache.clear();
+    ASSERT_FALSE(cache.get(key, cached));
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "xrpc/xws/xws_subscription.h"
+
+using namespace top;
+using namespace top::xrpc;
+
+TEST(test_xws_subscription, subscribe_and_fan_out) {
+    xws_subscription_mgr_t mgr;
+    std::vector<std::string> sent1;
+    std::vector<std::string> sent2;
+    int conn1 = 0;
+    int conn2 = 0;
+
+    xJson::Value params;
+    params.append("newPendingTransactions");
+    std::string error;
+    std::string id1 = mgr.subscribe(&conn1, [&sent1](const std::string & message) { sent1.push_back(message); }, params, error);
+    std::string id2 = mgr.subscribe(&conn2, [&sent2](const std::string & message) { sent2.push_back(message); }, params, error);
+    ASSERT_FALSE(id1.empty());
+    ASSERT_FALSE(id2.empty());
+    ASSERT_NE(id1, id2);
+    ASSERT_EQ(mgr.size(), 2u);
+
+    mgr.on_pending_transaction("0x1234");
+    ASSERT_EQ(sent1.size(), 1u);
+    ASSERT_EQ(sent2.size(), 1u);
+    EXPECT_EQ(sent1[0], "{\"jsonrpc\":\"2.0\",\"method\":\"eth_subscription\",\"params\":{\"result\":\"0x1234\",\"subscription\":\"" + id1 + "\"}}");
+
+    // only the owner connection can unsubscribe
+    EXPECT_FALSE(mgr.unsubscribe(&conn2, id1));
+    EXPECT_TRUE(mgr.unsubscribe(&conn1, id1));
+    EXPECT_FALSE(mgr.unsubscribe(&conn1, id1));
+    mgr.on_pending_transaction("0x5678");
+    EXPECT_EQ(sent1.size(), 1u);
+    EXPECT_EQ(sent2.size(), 2u);
+
+    mgr.remove(&conn2);
+    EXPECT_EQ(mgr.size(), 0u);
+}
+
+TEST(test_xws_subscription, bad_params) {
+    xws_subscription_mgr_t mgr;
+    int conn = 0;
+    auto send = [](const std::string &) {};
+    std::string error;
+
+    xJson::Value unknown;
+    unknown.append("syncing");
+    EXPECT_TRUE(mgr.subscribe(&conn, send, unknown, error).empty());
+    EXPECT_FALSE(error.empty());
+
+    xJson::Value logs;
+    logs.append("logs");
+    logs[1]["address"] = "0x12";
+    EXPECT_TRUE(mgr.subscribe(&conn, send, logs, error).empty());
+
+    logs[1]["address"] = "0xbc9b5f068bc20a5b12030fcb72975d8bddc4e84c";
+    logs[1]["topics"].append("0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+    EXPECT_FALSE(mgr.subscribe(&conn, send, logs, error).empty());
+
+    xJson::Value heads;
+    heads.append("newHeads");
+    for (uint32_t i = 1; i < xws_subscription_mgr_t::max_subscriptions_per_connection; i++) {
+        ASSERT_FALSE(mgr.subscribe(&conn, send, heads, error).empty());
+    }
+    EXPECT_TRUE(mgr.subscribe(&conn, send, heads, error).empty());
+}
+
+TEST(test_xws_subscription, handle_request) {
+    xws_subscription_mgr_t mgr;
+    int conn = 0;
+    auto send = [](const std::string &) {};
+
+    EXPECT_TRUE(xws_subscription_mgr_t::is_subscription_request("{\"method\":\"eth_subscribe\"}"));
+    EXPECT_FALSE(xws_subscription_mgr_t::is_subscription_request("{\"method\":\"eth_blockNumber\"}"));
+
+    xJson::Value rsp;
+    xJson::Reader reader;
+    ASSERT_TRUE(reader.parse(mgr.handle_request(&conn, send, "{\"id\":1,\"jsonrpc\":\"2.0\",\"method\":\"eth_subscribe\",\"params\":[\"newHeads\"]}"), rsp));
+    EXPECT_EQ(rsp["id"].asInt(), 1);
+    std::string id = rsp["result"].asString();
+    EXPECT_FALSE(id.empty());
+
+    ASSERT_TRUE(reader.parse(mgr.handle_request(&conn, send, "{\"id\":2,\"jsonrpc\":\"2.0\",\"method\":\"eth_unsubscribe\",\"params\":[\"" + id + "\"]}"), rsp));
+    EXPECT_TRUE(rsp["result"].asBool());
+    EXPECT_EQ(mgr.size(), 0u);
+}
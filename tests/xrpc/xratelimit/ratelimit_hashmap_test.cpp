@@ -90,3 +90,30 @@ TEST_F(RatelimitHashmapTest, TestForeach) {
         EXPECT_EQ(value->nValue_, i + 1);
     }
 }
+
+TEST(RatelimitHashmapCase, TestRotate) {
+    RatelimitHashmap<int, int> hashmap;
+    for (int i{ 0 }; i < 100; ++i) {
+        EXPECT_TRUE(hashmap.Insert(i, i));
+    }
+    hashmap.Rotate();
+    EXPECT_EQ(hashmap.Size(), 100u);
+
+    // looked up entries move to the current generation and survive the next rotate
+    for (int i{ 0 }; i < 50; ++i) {
+        int value{ 0 };
+        EXPECT_TRUE(hashmap.Find(i, value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(hashmap.Insert(60, 0));
+    hashmap.Rotate();
+    EXPECT_EQ(hashmap.Size(), 50u);
+    for (int i{ 0 }; i < 100; ++i) {
+        int value{ 0 };
+        EXPECT_EQ(hashmap.Find(i, value), i < 50);
+    }
+
+    hashmap.Rotate();
+    hashmap.Rotate();
+    EXPECT_EQ(hashmap.Size(), 0u);
+}
@@ -2,6 +2,7 @@
 #include "xdbstore/xstore_face.h"
 #include "xevm_common/trie/xsecure_trie.h"
 #include "xevm_common/trie/xtrie_kv_db.h"
+#include "xevm_common/trie/xtrie_memory_kv_db.h"
 #include "xevm_common/trie/xtrie_sync.h"
 #include "xevm_common/xerror/xerror.h"
 #include "xstate_mpt/xerror.h"
@@ -13,7 +14,9 @@
 
 #include "nlohmann/fifo_map.hpp"
 #include "nlohmann/json.hpp"
+#include <atomic>
 #include <fstream>
+#include <thread>
 
 template <class K, class V, class dummy_compare, class A>
 using my_workaround_fifo_map = nlohmann::fifo_map<K, V, nlohmann::fifo_map_compare<K>, A>;
@@ -23,6 +26,7 @@ using json = unordered_json;
 
 #define private public
 #include "xstate_mpt/xstate_mpt.h"
+#include "xstate_mpt/xstate_mpt_reader.h"
 #include "xdata/xtable_bstate.h"
 #include "xdata/xunit_bstate.h"
 
@@ -319,6 +323,31 @@ TEST_F(test_state_mpt_fixture, test_basic) {
     // }
 }
 
+TEST_F(test_state_mpt_fixture, test_prune_unit) {
+    std::error_code ec;
+    auto s = state_mpt::xstate_mpt_t::create(TABLE_ADDRESS, {}, m_db, ec);
+    EXPECT_EQ(ec.value(), 0);
+
+    auto acc = common::xaccount_address_t{top::utl::xcrypto_util::make_address_by_random_key(base::enum_vaccount_addr_type_secp256k1_eth_user_account, 0)};
+    auto hash = base::xcontext_t::instance().hash(std::string{"state_str"}, enum_xhash_type_sha2_256);
+    base::xaccount_index_t index{5, hash, hash, 5};
+    s->set_account_index(acc, index, ec);
+    EXPECT_FALSE(ec);
+    s->get_root_hash(ec);
+    EXPECT_FALSE(ec);
+
+    base::xvaccount_t const vaccount{acc.value()};
+    auto const full_key = base::xvdbkey_t::create_prunable_unit_state_key(vaccount, index.get_latest_unit_height(), index.get_latest_unit_hash());
+    auto const delta_key = base::xvdbkey_t::create_prunable_unit_state_delta_key(vaccount, index.get_latest_unit_height(), index.get_latest_unit_hash());
+    EXPECT_TRUE(m_db->set_value(full_key, "full_state"));
+    EXPECT_TRUE(m_db->set_value(delta_key, "delta_state"));
+
+    s->prune_unit(acc, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_TRUE(m_db->get_value(full_key).empty());
+    EXPECT_TRUE(m_db->get_value(delta_key).empty());
+}
+
 // TODO: nedd to fix double commit
 TEST_F(test_state_mpt_fixture, test_create_twice_commit_twice) {
     std::error_code ec;
@@ -349,6 +378,164 @@ TEST_F(test_state_mpt_fixture, test_create_twice_commit_twice) {
     ASSERT_EQ(hash1, hash2);
 }
 
+TEST_F(test_state_mpt_fixture, test_snapshot) {
+    std::error_code ec;
+    auto s = state_mpt::xstate_mpt_t::create(TABLE_ADDRESS, {}, m_db, ec);
+    ASSERT_FALSE(ec);
+    auto snapshot = s->m_snapshot;
+    ASSERT_NE(snapshot, nullptr);
+
+    auto const n = state_mpt::xstate_snapshot_t::max_diff_layers + 10;
+    std::vector<common::xaccount_address_t> accounts;
+    std::vector<xhash256_t> roots;
+    for (std::size_t i = 0; i < n; ++i) {
+        // each commit updates a new account and an old one
+        accounts.push_back(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(1000 + i)});
+        s->set_account_index(accounts.back(), base::xaccount_index_t{i + 1, std::to_string(i), std::to_string(i), i}, ec);
+        ASSERT_FALSE(ec);
+        s->set_account_index(accounts.front(), base::xaccount_index_t{i + 1, std::to_string(i), std::to_string(i), i}, ec);
+        ASSERT_FALSE(ec);
+        roots.push_back(s->commit(ec));
+        ASSERT_FALSE(ec);
+    }
+    EXPECT_EQ(snapshot->diff_layer_count(), state_mpt::xstate_snapshot_t::max_diff_layers);
+    EXPECT_EQ(snapshot->disk_root(), roots[n - 1 - state_mpt::xstate_snapshot_t::max_diff_layers]);
+
+    // snapshot returns same value as trie, for disk layer and diff layers
+    for (auto const i : {std::size_t{0}, n - state_mpt::xstate_snapshot_t::max_diff_layers - 1, n - 2, n - 1}) {
+        if (i < n - 1 - state_mpt::xstate_snapshot_t::max_diff_layers) {
+            EXPECT_FALSE(snapshot->covers(roots[i]));
+            continue;
+        }
+        EXPECT_TRUE(snapshot->covers(roots[i]));
+        auto trie = evm_common::trie::xsecure_trie_t::build_from(roots[i], s->m_db, ec);
+        ASSERT_FALSE(ec);
+        for (std::size_t j = 0; j < n; ++j) {
+            std::string value;
+            ASSERT_TRUE(snapshot->get(roots[i], accounts[j], value));
+            auto const trie_value = trie->try_get(to_bytes(accounts[j]), ec);
+            ASSERT_FALSE(ec);
+            EXPECT_EQ(value, std::string(trie_value.begin(), trie_value.end()));
+        }
+    }
+
+    // reads of a new mpt go through snapshot
+    auto s1 = state_mpt::xstate_mpt_t::create(TABLE_ADDRESS, roots.back(), m_db, ec);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(s1->get_account_index(accounts.front(), ec).get_latest_unit_height(), n);
+    EXPECT_EQ(s1->get_account_index(accounts[5], ec).get_latest_unit_height(), 6u);
+    EXPECT_EQ(s1->get_account_index(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JEShoM"}, ec).get_latest_unit_height(), 0u);
+    ASSERT_FALSE(ec);
+
+    // unknown root is not covered, caller falls back to trie
+    std::string value;
+    EXPECT_FALSE(snapshot->get(xhash256_t(random_bytes(32)), accounts.front(), value));
+
+    // persisted diff layers are loaded again after restart
+    state_mpt::xstate_snapshot_t restarted{TABLE_ADDRESS, m_db};
+    restarted.load_disk_root();
+    EXPECT_EQ(restarted.disk_root(), snapshot->disk_root());
+    ASSERT_TRUE(restarted.get(roots.back(), accounts.front(), value));
+    EXPECT_EQ(value, [&] {
+        std::string v;
+        snapshot->get(roots.back(), accounts.front(), v);
+        return v;
+    }());
+}
+
+TEST_F(test_state_mpt_fixture, test_reader) {
+    std::error_code ec;
+    auto s = state_mpt::xstate_mpt_t::create(TABLE_ADDRESS, {}, m_db, ec);
+    ASSERT_FALSE(ec);
+
+    std::vector<common::xaccount_address_t> accounts;
+    for (std::size_t i = 0; i < 64; ++i) {
+        accounts.push_back(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(1000 + i)});
+        s->set_account_index(accounts.back(), base::xaccount_index_t{i + 1, std::to_string(i), std::to_string(i), i}, ec);
+        ASSERT_FALSE(ec);
+    }
+    auto const root = s->commit(ec);
+    ASSERT_FALSE(ec);
+
+    auto reader = s->reader(ec);
+    ASSERT_FALSE(ec);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->get_root_hash(), root);
+
+    // readers query the committed root while the writer keeps modifying and committing the same table
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (std::size_t round = 0; round < 20; ++round) {
+                for (std::size_t i = 0; i < accounts.size(); ++i) {
+                    std::error_code read_ec;
+                    if (reader->get_account_index(accounts[i], read_ec).get_latest_unit_height() != i + 1 || read_ec) {
+                        failed = true;
+                    }
+                }
+            }
+        });
+    }
+    for (std::size_t round = 0; round < 20; ++round) {
+        for (std::size_t i = 0; i < accounts.size(); i += 4) {
+            s->set_account_index(accounts[i], base::xaccount_index_t{1000 + round, std::to_string(round), std::to_string(round), round}, ec);
+            ASSERT_FALSE(ec);
+        }
+        s->commit(ec);
+        ASSERT_FALSE(ec);
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(failed);
+
+    // a new reader sees the latest commit, but never the pending modifies
+    s->set_account_index(accounts[1], base::xaccount_index_t{5000, "5000", "5000", 5000}, ec);
+    auto latest = s->reader(ec);
+    ASSERT_FALSE(ec);
+    EXPECT_EQ(latest->get_account_index(accounts[0], ec).get_latest_unit_height(), 1019u);
+    EXPECT_EQ(latest->get_account_index(accounts[1], ec).get_latest_unit_height(), 2u);
+    EXPECT_EQ(latest->get_account_index(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JEShoM"}, ec).get_latest_unit_height(), 0u);
+    EXPECT_TRUE(latest->get_unit(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JEShoM"}, ec).empty());
+    ASSERT_FALSE(ec);
+}
+
+TEST_F(test_state_mpt_fixture, test_reader_prove_account_indexes) {
+    std::error_code ec;
+    auto s = state_mpt::xstate_mpt_t::create(TABLE_ADDRESS, {}, m_db, ec);
+    ASSERT_FALSE(ec);
+
+    std::vector<common::xaccount_address_t> accounts;
+    for (std::size_t i = 0; i < 256; ++i) {
+        accounts.push_back(common::xaccount_address_t{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JE" + std::to_string(1000 + i)});
+        s->set_account_index(accounts.back(), base::xaccount_index_t{i + 1, std::to_string(i), std::to_string(i), i}, ec);
+        ASSERT_FALSE(ec);
+    }
+    auto const root = s->commit(ec);
+    ASSERT_FALSE(ec);
+    auto reader = s->reader(ec);
+    ASSERT_FALSE(ec);
+
+    std::vector<common::xaccount_address_t> proven{accounts.begin(), accounts.begin() + 32};
+    common::xaccount_address_t const absent{"T00000LVgLn3yVd11d2izvJg6znmxddxg8JEShoM"};
+    proven.push_back(absent);
+
+    auto const proof_db = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+    auto const indexes = reader->prove_account_indexes(proven, proof_db, ec);
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(indexes.size(), proven.size());
+
+    // a light client knowing root only verifies every account with the shared proof
+    for (std::size_t i = 0; i < proven.size(); ++i) {
+        auto const index = state_mpt::xstate_mpt_reader_t::verify_account_index(root, proven[i], proof_db, ec);
+        ASSERT_FALSE(ec);
+        EXPECT_EQ(index.get_latest_unit_height(), indexes[i].get_latest_unit_height());
+    }
+    EXPECT_EQ(indexes[5].get_latest_unit_height(), 6u);
+    EXPECT_EQ(indexes.back().get_latest_unit_height(), 0u);
+}
+
 TEST_F(test_state_mpt_fixture, test_trie_sync) {
     auto k4 = "6bf0c8abe6bc49f558c591d09cd8639459f93aa70a9da15a0f1a14ee86f63d9c";
     auto v4 = "e5808080808080cb358902003040020132013280808080808080808089010030400101310131";
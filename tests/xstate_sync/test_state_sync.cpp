@@ -195,6 +195,14 @@ void test_state_sync_fixture::sync_helper() {
             if (node_cnt >= 75) {
                 break;
             }
+        } else if (m.second.id() == state_sync::xmessage_id_sync_range_request) {
+            // peer not serving ranges, syncer falls back to node sync.
+            base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)(m.second.payload().data()), (uint32_t)m.second.payload().size());
+            std::string table;
+            uint32_t id{0};
+            stream >> table;
+            stream >> id;
+            m_syncer->deliver_req(m_track_reqs.at(id));
         } else {
             assert(false);
         }
@@ -418,6 +426,33 @@ TEST_F(test_state_sync_fixture, test_assign_trie_tasks) {
     EXPECT_EQ(units_bytes.size(), 0);
 }
 
+TEST_F(test_state_sync_fixture, test_pick_peer) {
+    auto peers = peers_func(table_account_address.table_id(), 3);
+    std::set<common::xnode_address_t> picked;
+    for (std::size_t i = 0; i < 3 * state_sync::xstate_sync_t::max_inflight_per_peer; ++i) {
+        common::xnode_address_t peer;
+        ASSERT_TRUE(m_syncer->pick_peer(peers, peer));
+        if (i < 3) {
+            // spread over all peers first
+            EXPECT_TRUE(picked.insert(peer).second);
+        }
+        m_syncer->m_peer_inflight[peer]++;
+    }
+    // every peer is at its in-flight cap
+    common::xnode_address_t peer;
+    EXPECT_FALSE(m_syncer->pick_peer(peers, peer));
+
+    // a peer becomes free once its response is processed
+    state_sync::state_req req;
+    req.type = state_sync::state_req_type::enum_state_req_trie;
+    req.peer = peers.peers[1];
+    std::error_code ec;
+    m_syncer->process_trie(req, ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(m_syncer->pick_peer(peers, peer));
+    EXPECT_EQ(peer, peers.peers[1]);
+}
+
 TEST_F(test_state_sync_fixture, test_assign_trie_tasks_empty) {
     state_sync::state_req req;
     std::vector<xhash256_t> nodes;
@@ -789,4 +824,71 @@ TEST_F(test_state_sync_fixture, test_run_cancel) {
     EXPECT_EQ(res.ec, make_error_code(state_sync::error::xenum_errc::state_sync_cancel));
 }
 
-}
\ No newline at end of file
+TEST_F(test_state_sync_fixture, test_assign_range_tasks) {
+    m_syncer->m_req_sequence_id = 100;
+    m_syncer->m_range_origin = xbytes_t(32, 0);
+    m_syncer->assign_range_tasks(m_peers);
+    EXPECT_TRUE(m_syncer->m_range_inflight);
+    // only one range in flight.
+    m_syncer->assign_range_tasks(m_peers);
+
+    EXPECT_EQ(m_track_reqs.size(), 1);
+    auto req = m_track_reqs.at(100);
+    EXPECT_EQ(req.type, state_sync::state_req_type::enum_state_req_range);
+    EXPECT_EQ(req.range_origin, xbytes_t(32, 0));
+
+    auto mock_net = std::dynamic_pointer_cast<xmock_vnetwork_driver_t>(m_peers.network);
+    EXPECT_EQ(mock_net->m_msg.size(), 1);
+    auto msg = mock_net->m_msg.front();
+    EXPECT_EQ(msg.second.id(), state_sync::xmessage_id_sync_range_request);
+    base::xstream_t stream(base::xcontext_t::instance(), (uint8_t *)(msg.second.payload().data()), (uint32_t)msg.second.payload().size());
+    std::string table;
+    uint32_t id{0};
+    xbytes_t root;
+    xbytes_t origin;
+    stream >> table;
+    stream >> id;
+    stream >> root;
+    stream >> origin;
+    EXPECT_EQ(table, table_account_address.value());
+    EXPECT_EQ(id, 100);
+    EXPECT_EQ(root, root_hash.to_bytes());
+    EXPECT_EQ(origin, xbytes_t(32, 0));
+}
+
+TEST_F(test_state_sync_fixture, test_process_range_empty_response) {
+    m_syncer->m_range_origin = xbytes_t(32, 0);
+    m_syncer->m_range_inflight = true;
+    state_sync::state_req req;
+    req.type = state_sync::state_req_type::enum_state_req_range;
+    req.range_origin = xbytes_t(32, 0);
+    std::error_code ec;
+    m_syncer->process_range(req, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_FALSE(m_syncer->m_range_inflight);
+    EXPECT_TRUE(m_syncer->m_range_done);
+    EXPECT_TRUE(m_syncer->m_range_failed);
+}
+
+TEST_F(test_state_sync_fixture, test_process_range_invalid_proof) {
+    m_syncer->m_range_origin = xbytes_t(32, 0);
+    m_syncer->m_range_batch = std::make_shared<evm_common::trie::xmemory_kv_db_t>();
+    m_syncer->m_stack_trie = evm_common::trie::xstack_trie_t::NewStackTrie(m_syncer->m_range_batch);
+    state_sync::state_req req;
+    req.type = state_sync::state_req_type::enum_state_req_range;
+    req.range_origin = xbytes_t(32, 0);
+    req.keys_response.push_back(xbytes_t(32, 1));
+    req.values_response.push_back(xbytes_t(8, 1));
+    req.nodes_response.push_back(xbytes_t(8, 2));
+    std::error_code ec;
+    for (uint32_t i = 0; i < state_sync::xstate_sync_t::max_range_failures; ++i) {
+        EXPECT_FALSE(m_syncer->m_range_done);
+        m_syncer->process_range(req, ec);
+        EXPECT_FALSE(ec);
+    }
+    EXPECT_TRUE(m_syncer->m_range_done);
+    EXPECT_TRUE(m_syncer->m_range_failed);
+    EXPECT_EQ(m_syncer->m_leaves_synced, 0);
+}
+
+}
@@ -19,6 +19,8 @@
 #include "xblockstore/src/xvblockhub.h"
 #include "xstatestore/xstatestore_face.h"
 #include "xstatestore/xstatestore_exec.h"
+#include "xstatestore/xstatestore_writer.h"
+#include "xstatestore/xstatestore_catchup.h"
 #include "test_common.hpp"
 
 using namespace top;
@@ -68,6 +70,8 @@ TEST_F(test_block_executed, order_execute_block_1) {
         xassert(nullptr != unitstate);
     }
 
+    statestore::xstatestore_writer_t::instance().flush();  // executed height is written after the states
+
     EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), max_count - 2);
     EXPECT_EQ(statestore::xstatestore_hub_t::instance()->get_latest_executed_block_height(common::xaccount_address_t{mocktable.get_account()}), max_count - 2);    
 }
@@ -107,6 +111,7 @@ TEST_F(test_block_executed, recover_execute_height) {
             auto _block = blockstore->load_block_object(mocktable, i, base::enum_xvblock_flag_committed, false);
             state_executor.on_table_block_committed(_block.get());
         }
+        state_executor.wait_states_written();
         state_executor.reset_execute_height(max_count/2);        
         EXPECT_EQ(state_executor.get_latest_executed_block_height(), max_count/2); 
         for (uint64_t i = max_count/2; i < max_count/2+20; i++) {
@@ -156,6 +161,8 @@ TEST_F(test_block_executed, xstatestore_executor_t_test_1) {
             std::cout << "account=" << v.get_account() << " index=" << account_index.dump() << std::endl;
         }
 
+        statestore::xstatestore_writer_t::instance().flush();
+
         EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), max_count - 2);
         EXPECT_EQ(state_executor.get_latest_executed_block_height(), max_count - 2);
     }
@@ -198,6 +205,8 @@ TEST_F(test_block_executed, xstatestore_executor_t_test_2) {
     }
     std::cout << "account=" << mockunits[0].get_account() << " index=" << account_index.dump() << std::endl;
 
+    statestore::xstatestore_writer_t::instance().flush();
+
     EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), max_count - 2);
     EXPECT_EQ(state_executor.get_latest_executed_block_height(), max_count - 2);   
 }
@@ -227,6 +236,7 @@ TEST_F(test_block_executed, xstatestore_executor_t_test_3) {
             xassert(false);
         }
         uint64_t expect_height = statestore::xstatestore_executor_t::execute_update_limit;
+        statestore::xstatestore_writer_t::instance().flush();
         EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), expect_height);
         EXPECT_EQ(state_executor.get_latest_executed_block_height(), expect_height);   
     }
@@ -239,6 +249,7 @@ TEST_F(test_block_executed, xstatestore_executor_t_test_3) {
             xassert(false);
         }
         std::cout << "account=" << mockunits[0].get_account() << " index=" << account_index.dump() << std::endl;
+        statestore::xstatestore_writer_t::instance().flush();
         EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), max_count-2);
         EXPECT_EQ(state_executor.get_latest_executed_block_height(), max_count-2);           
     }
@@ -278,6 +289,7 @@ TEST_F(test_block_executed, xstatestore_executor_t_test_5) {
     if (ec) {
         xassert(false);
     }
+    statestore::xstatestore_writer_t::instance().flush();
     EXPECT_EQ(blockstore->get_latest_executed_block_height(mocktable), max_count-2);
     EXPECT_EQ(state_executor.get_latest_executed_block_height(), max_count-2);
 }
@@ -485,4 +497,34 @@ TEST_F(test_block_executed, xvaccount_BENCH) {
     std::cout << "total time: " << t2 - t1 << " ms" << std::endl;
 }
 
-}
\ No newline at end of file
+}
+TEST_F(test_block_executed, catchup_execute_1) {
+    mock::xvchain_creator creator;
+    base::xvblockstore_t* blockstore = creator.get_blockstore();
+    uint64_t max_count = statestore::xstatestore_executor_t::execute_update_limit * 2;
+    mock::xdatamock_table mocktable(1, 4);
+    mocktable.genrate_table_chain(max_count, blockstore);
+    const std::vector<xblock_ptr_t> & tableblocks = mocktable.get_history_tables();
+    xassert(tableblocks.size() == max_count + 1);
+
+    for (auto & block : tableblocks) {
+        ASSERT_TRUE(blockstore->store_block(mocktable, block.get()));
+    }
+
+    common::xaccount_address_t table_addr{mocktable.get_account()};
+    std::map<std::string, statestore::xstatestore_table_ptr_t> tables;
+    tables[table_addr.value()] = std::make_shared<statestore::xstatestore_table_t>(table_addr, std::make_shared<statestore::xstatestore_resources_t>());
+
+    statestore::xstatestore_catchup_t catchup{tables};
+    EXPECT_EQ(catchup.pending_table_count(), 1);
+    catchup.start(2);
+    for (uint32_t i = 0; i < 1000 && catchup.done_table_count() < 1; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    catchup.stop();
+    statestore::xstatestore_writer_t::instance().flush();
+
+    EXPECT_EQ(catchup.done_table_count(), 1);
+    EXPECT_EQ(catchup.pending_table_count(), 0);
+    EXPECT_EQ(tables[table_addr.value()]->get_latest_executed_block_height(), max_count - 2);
+}
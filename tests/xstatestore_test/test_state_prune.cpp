@@ -7,6 +7,7 @@
 #define protected public
 #include "xstatestore/xstatestore_prune.h"
 #include "xstatestore/xstatestore_exec.h"
+#include "xstatestore/xstatestore_writer.h"
 
 using namespace top::data;
 using namespace top;
@@ -72,6 +73,8 @@ TEST_F(test_state_prune, prune_exec_storage) {
         ASSERT_TRUE(blockstore->store_block(mocktable, block.get()));
     }
 
+    // states of the executed blocks still written in background would come back after the prune
+    statestore::xstatestore_writer_t::instance().flush();
     std::shared_ptr<xstatestore_resources_t> para;
     xstatestore_prune_t pruner(common::xaccount_address_t(mocktable.get_vaccount().get_account()), para);
 
@@ -82,6 +85,11 @@ TEST_F(test_state_prune, prune_exec_storage) {
         xdb->write(state_key, "test_state" + std::to_string(block->get_height())); // for test.
         auto offdata_key = base::xvdbkey_t::create_prunable_block_output_offdata_key(mocktable.get_account(), block->get_height(), block->get_viewid());
         xdb->write(offdata_key, "test_offdata" + std::to_string(block->get_height())); // for test.
+        // keys written before the state height key layout
+        auto state_key_old = base::xvdbkey_t::create_prunable_state_key_old(mocktable.get_vaccount(), block->get_height(), block->get_block_hash());
+        xdb->write(state_key_old, "test_state" + std::to_string(block->get_height()));
+        auto offdata_key_old = base::xvdbkey_t::create_prunable_block_output_offdata_key_old(mocktable.get_account(), block->get_height(), block->get_viewid());
+        xdb->write(offdata_key_old, "test_offdata" + std::to_string(block->get_height()));
     }
 
     pruner.prune_imp(70);
@@ -98,6 +106,13 @@ TEST_F(test_state_prune, prune_exec_storage) {
         std::string value_offdata;
         xdb->read(offdata_key, value_offdata);
         EXPECT_EQ(value_offdata.empty(), (h <= 30 && block->get_block_class() != base::enum_xvblock_class_nil));
+
+        std::string value_state_old;
+        xdb->read(base::xvdbkey_t::create_prunable_state_key_old(mocktable.get_vaccount(), h, block->get_block_hash()), value_state_old);
+        EXPECT_EQ(value_state_old.empty(), (h <= 30 && block->get_block_class() != base::enum_xvblock_class_full));
+        std::string value_offdata_old;
+        xdb->read(base::xvdbkey_t::create_prunable_block_output_offdata_key_old(mocktable.get_account(), h, block->get_viewid()), value_offdata_old);
+        EXPECT_EQ(value_offdata_old.empty(), (h <= 30 && block->get_block_class() != base::enum_xvblock_class_nil));
     }
 
     pruner.prune_imp(95);
@@ -137,6 +152,7 @@ TEST_F(test_state_prune, prune_exec_storage_and_cons) {
         ASSERT_TRUE(blockstore->store_block(mocktable, block.get()));
     }
 
+    statestore::xstatestore_writer_t::instance().flush();
     std::shared_ptr<xstatestore_resources_t> para;
     xstatestore_prune_t pruner(common::xaccount_address_t(mocktable.get_vaccount().get_account()), para);
 
@@ -244,6 +260,7 @@ TEST_F(test_state_prune, prune_exec_cons) {
         EXPECT_EQ(mpt != nullptr, true);
     }
 
+    statestore::xstatestore_writer_t::instance().flush();
     std::shared_ptr<xstatestore_resources_t> para;
     xstatestore_prune_t pruner(common::xaccount_address_t(mocktable.get_vaccount().get_account()), para);
     base::xvchain_t::instance().set_node_type(false, true);
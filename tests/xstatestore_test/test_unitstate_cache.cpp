@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+
+#include "xstatestore/xunitstate_cache.h"
+#include "xvledger/xvstate.h"
+
+using namespace top;
+using namespace top::statestore;
+
+class test_unitstate_cache : public testing::Test {
+protected:
+    void SetUp() override {
+        auto vbstate = make_object_ptr<base::xvbstate_t>(m_unit_addr, 1, 1, std::string{}, std::string{}, 0, 0, 0);
+        m_state = std::make_shared<data::xunit_bstate_t>(vbstate.get());
+    }
+
+    std::string const m_unit_addr{"T00000LMcqLyTzsk3HB8dhF51i6xEcVEuyX2Vx6p"};
+    common::xaccount_address_t const m_table1{"Ta0000@1"};
+    common::xaccount_address_t const m_table2{"Ta0000@2"};
+    data::xunitstate_ptr_t m_state;
+};
+
+TEST_F(test_unitstate_cache, byte_budget) {
+    uint64_t const shared_bytes = xunitstate_cache_t::shard_count * 8 * 1024;
+    xunitstate_cache_t cache{shared_bytes, 0};
+    for (int i = 0; i < 1000; i++) {
+        cache.put(m_table1, "hash" + std::to_string(i), m_state, 1000, false);
+        ASSERT_LE(cache.bytes(), shared_bytes);
+    }
+    EXPECT_GT(cache.size(), 0);
+    EXPECT_LT(cache.size(), 1000);
+
+    // a state larger than the budget of its shard is not kept
+    cache.clear();
+    cache.put(m_table1, "large", m_state, 64 * 1024, false);
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(nullptr, cache.get(m_table1, "large"));
+}
+
+TEST_F(test_unitstate_cache, hot_state_outlives_scan) {
+    xunitstate_cache_t cache{xunitstate_cache_t::shard_count * 4 * 1024, 0};
+    cache.put(m_table1, "hot", m_state, 1000, false);
+    EXPECT_NE(nullptr, cache.get(m_table1, "hot"));
+    for (int i = 0; i < 1000; i++) {
+        cache.put(m_table2, "cold" + std::to_string(i), m_state, 1000, false);
+    }
+    EXPECT_NE(nullptr, cache.get(m_table1, "hot"));
+}
+
+TEST_F(test_unitstate_cache, executed_state_reserved) {
+    xunitstate_cache_t cache{xunitstate_cache_t::shard_count * 4 * 1024, xunitstate_cache_t::shard_count * 4 * 1024};
+    cache.put(m_table1, "executed", m_state, 1000, true);
+    for (int i = 0; i < 1000; i++) {
+        cache.put(m_table2, "loaded" + std::to_string(i), m_state, 1000, false);
+    }
+    EXPECT_NE(nullptr, cache.get(m_table1, "executed"));
+}
+
+TEST_F(test_unitstate_cache, table_stats) {
+    xunitstate_cache_t cache{xunitstate_cache_t::shard_count * 64 * 1024, 0};
+    cache.put(m_table1, "hash1", m_state, 100, false);
+    EXPECT_NE(nullptr, cache.get(m_table1, "hash1"));
+    EXPECT_NE(nullptr, cache.get(m_table1, "hash1"));
+    EXPECT_EQ(nullptr, cache.get(m_table1, "hash2"));
+    EXPECT_EQ(nullptr, cache.get(m_table2, "hash2"));
+
+    auto const stats = cache.table_stats();
+    ASSERT_EQ(2, stats.size());
+    EXPECT_EQ(2, stats.at(m_table1.value()).hits);
+    EXPECT_EQ(1, stats.at(m_table1.value()).misses);
+    EXPECT_EQ(0, stats.at(m_table2.value()).hits);
+    EXPECT_EQ(1, stats.at(m_table2.value()).misses);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "xsync/xsync_download_tracer_mgr.h"
+#include "../common.h"
+
+using namespace top;
+using namespace top::sync;
+
+TEST(xsync_download_tracer_mgr, merge) {
+    auto archives = get_archive_addresses(0, 0, 2);
+    xsync_download_tracer_mgr tracer_mgr;
+    std::string account = "T00000LabhPzSJ1MWCqxRGEWAvXJpDQJgJWWVRL9";
+    std::map<std::string, std::string> context;
+
+    // nothing in flight
+    ASSERT_FALSE(tracer_mgr.merge(account, std::make_pair(10, 20)));
+
+    ASSERT_TRUE(tracer_mgr.apply(account, std::make_pair(10, 20), context, archives[0], archives[1]));
+    ASSERT_FALSE(tracer_mgr.apply(account, std::make_pair(15, 30), context, archives[0], archives[1]));
+
+    // inside, overlapping and adjacent intervals are merged
+    ASSERT_TRUE(tracer_mgr.merge(account, std::make_pair(12, 18)));
+    ASSERT_TRUE(tracer_mgr.merge(account, std::make_pair(15, 30)));
+    ASSERT_TRUE(tracer_mgr.merge(account, std::make_pair(31, 40)));
+
+    // below the start or with a gap, not
+    ASSERT_FALSE(tracer_mgr.merge(account, std::make_pair(5, 12)));
+    ASSERT_FALSE(tracer_mgr.merge(account, std::make_pair(42, 50)));
+
+    xsync_download_tracer tracer;
+    ASSERT_TRUE(tracer_mgr.get(account, tracer));
+    ASSERT_EQ(tracer.height_interval().first, (uint64_t)10);
+    ASSERT_EQ(tracer.height_interval().second, (uint64_t)40);
+}
+
+TEST(xsync_download_tracer_mgr, missing) {
+    xsync_download_tracer_mgr tracer_mgr;
+    std::string account = "T00000LabhPzSJ1MWCqxRGEWAvXJpDQJgJWWVRL9";
+
+    ASSERT_FALSE(tracer_mgr.is_missing(account, 10));
+    tracer_mgr.set_missing(account, 10);
+    ASSERT_FALSE(tracer_mgr.is_missing(account, 9));
+    ASSERT_TRUE(tracer_mgr.is_missing(account, 10));
+    ASSERT_TRUE(tracer_mgr.is_missing(account, 11));
+}
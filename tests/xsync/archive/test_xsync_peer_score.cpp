@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "xsync/xsync_peer_score.h"
+#include "../common.h"
+
+using namespace top;
+using namespace top::sync;
+
+TEST(xsync_peer_score, sort_by_cost) {
+    auto archives = get_archive_addresses(0, 0, 4);
+    xsync_peer_score_t peer_score;
+
+    // never measured peers score 0
+    ASSERT_EQ(peer_score.score(archives[0]), 0);
+
+    peer_score.on_response(archives[0], 2000, 20);
+    peer_score.on_response(archives[1], 200, 20);
+    peer_score.on_response(archives[2], 1000, 20);
+
+    std::vector<vnetwork::xvnode_address_t> peers{archives[0], archives[1], archives[2], archives[3]};
+    peer_score.sort(peers);
+    ASSERT_TRUE(peers[0] == archives[3]);
+    ASSERT_TRUE(peers[1] == archives[1]);
+    ASSERT_TRUE(peers[2] == archives[2]);
+    ASSERT_TRUE(peers[3] == archives[0]);
+}
+
+TEST(xsync_peer_score, failure_and_deceit) {
+    auto archives = get_archive_addresses(0, 0, 2);
+    xsync_peer_score_t peer_score;
+
+    peer_score.on_response(archives[0], 200, 20);
+    peer_score.on_response(archives[1], 400, 20);
+    ASSERT_LT(peer_score.score(archives[0]), peer_score.score(archives[1]));
+
+    peer_score.on_failure(archives[0]);
+    ASSERT_GT(peer_score.score(archives[0]), peer_score.score(archives[1]));
+
+    // failures are forgiven by later responses
+    peer_score.on_response(archives[0], 200, 20);
+    ASSERT_LT(peer_score.score(archives[0]), peer_score.score(archives[1]));
+
+    int64_t const deceit_score = xsync_peer_score_t::deceit_score;
+    peer_score.on_deceit(archives[0]);
+    ASSERT_EQ(peer_score.score(archives[0]), deceit_score);
+    peer_score.on_response(archives[0], 1, 20);
+    ASSERT_EQ(peer_score.score(archives[0]), deceit_score);
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "xdata/xblocktool.h"
+#include "xmock_system.h"
+#include "xmock_blocks.h"
+#include "../../mock/xmock_network_config.hpp"
+#include "../../mock/xmock_network.hpp"
+#include "tests/mock/xvchain_creator.hpp"
+
+using namespace top;
+using namespace top::data;
+using namespace top::mock;
+
+// the parameters are read from the environment, so one binary serves every release comparison:
+//   XSYNC_BENCH_BLOCKS     table blocks to catch up (default 1000)
+//   XSYNC_BENCH_PEERS      peers holding the chain (default 3)
+//   XSYNC_BENCH_DELAY_MS   one way latency of every message (default 20)
+//   XSYNC_BENCH_BANDWIDTH  bytes per second of the link, 0 means unlimited (default 10MB)
+//   XSYNC_BENCH_TIMEOUT_S  give up after (default 600)
+static uint64_t bench_param(const char *name, uint64_t default_value) {
+    const char *value = getenv(name);
+    if (value == nullptr || *value == '\0')
+        return default_value;
+    return strtoull(value, nullptr, 10);
+}
+
+static double cpu_seconds(const struct timeval &tv) {
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+// cpu time of each thread name, from /proc/self/task/<tid>/stat
+static std::map<std::string, double> thread_cpu_seconds() {
+    std::map<std::string, double> result;
+    DIR *dir = opendir("/proc/self/task");
+    if (dir == nullptr)
+        return result;
+
+    long ticks = sysconf(_SC_CLK_TCK);
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        std::ifstream stat_file(std::string("/proc/self/task/") + entry->d_name + "/stat");
+        std::string line;
+        if (!std::getline(stat_file, line))
+            continue;
+
+        // pid (comm) state ... utime is the 14th field and stime the 15th
+        size_t name_begin = line.find('(');
+        size_t name_end = line.rfind(')');
+        if (name_begin == std::string::npos || name_end == std::string::npos)
+            continue;
+        std::string name = line.substr(name_begin + 1, name_end - name_begin - 1);
+
+        std::istringstream fields(line.substr(name_end + 2));
+        std::string field;
+        uint64_t utime = 0;
+        uint64_t stime = 0;
+        for (int i = 3; i <= 15 && (fields >> field); i++) {
+            if (i == 14)
+                utime = std::stoull(field);
+            else if (i == 15)
+                stime = std::stoull(field);
+        }
+        result[name] += (double)(utime + stime) / ticks;
+    }
+    closedir(dir);
+    return result;
+}
+
+// 1 shard: node0 starts empty, the other nodes hold the chain
+static xJson::Value bench_network(uint32_t peers) {
+    xJson::Value v = xJson::objectValue;
+
+    v["group"]["zone0"]["type"] = "zone";
+
+    v["group"]["adv0"]["type"] = "advance";
+    v["group"]["adv0"]["parent"] = "zone0";
+
+    v["group"]["shard0"]["type"] = "validator";
+    v["group"]["shard0"]["parent"] = "adv0";
+
+    for (uint32_t i = 0; i <= peers; i++) {
+        v["node"]["node" + std::to_string(i)]["parent"] = "shard0";
+    }
+
+    return v;
+}
+
+TEST(xsync_bench, catch_up_BENCH) {
+    uint32_t block_count = bench_param("XSYNC_BENCH_BLOCKS", 1000);
+    uint32_t peers = bench_param("XSYNC_BENCH_PEERS", 3);
+    uint32_t delay_ms = bench_param("XSYNC_BENCH_DELAY_MS", 20);
+    uint64_t bandwidth = bench_param("XSYNC_BENCH_BANDWIDTH", 10 * 1024 * 1024);
+    uint64_t timeout_s = bench_param("XSYNC_BENCH_TIMEOUT_S", 600);
+    ASSERT_GT(peers, (uint32_t)0);
+
+    xJson::Value virtual_network = bench_network(peers);
+    xmock_network_config_t cfg_network(virtual_network);
+    xmock_network_t network(cfg_network);
+    xmock_system_t sys(network);
+
+    std::vector<std::shared_ptr<xmock_node_t>> shard_nodes = sys.get_group_node("shard0");
+    ASSERT_EQ(shard_nodes.size(), peers + 1);
+
+    mock::xvchain_creator creator;
+    creator.create_blockstore_with_xstore();
+    xobject_ptr_t<store::xstore_face_t> store;
+    store.attach(creator.get_xstore());
+    xobject_ptr_t<base::xvblockstore_t> blockstore;
+    blockstore.attach(creator.get_blockstore());
+
+    std::string account_address = xblocktool_t::make_address_user_account("11111111111111111112");
+    std::string table_address = account_address_to_block_address(top::common::xaccount_address_t{account_address});
+    base::xvaccount_t _vaddress(table_address);
+    create_tableblock(store, blockstore, shard_nodes, account_address, block_count);
+
+    // the chain holds 3 table blocks (commit, lock, cert) for each unit
+    uint64_t chain_height = blockstore->get_latest_cert_block(_vaddress)->get_height();
+    for (uint32_t i = 1; i < shard_nodes.size(); i++) {
+        for (uint64_t h = 1; h <= chain_height; h++) {
+            duplicate_block(blockstore, shard_nodes[i]->m_blockstore, table_address, h);
+        }
+    }
+
+    sys.set_delay(delay_ms);
+    sys.set_bandwidth(bandwidth);
+
+    struct rusage usage_begin;
+    getrusage(RUSAGE_SELF, &usage_begin);
+    std::map<std::string, double> threads_begin = thread_cpu_seconds();
+    int64_t time_begin = base::xtime_utl::time_now_ms();
+
+    sys.start();
+
+    uint64_t height = 0;
+    while (height < chain_height) {
+        sleep(1);
+        height = shard_nodes[0]->m_blockstore->get_latest_cert_block(_vaddress)->get_height();
+        printf("xsync_bench height=%lu expect=%lu\n", height, chain_height);
+        if ((uint64_t)(base::xtime_utl::time_now_ms() - time_begin) > timeout_s * 1000)
+            break;
+    }
+
+    int64_t elapsed_ms = base::xtime_utl::time_now_ms() - time_begin;
+    struct rusage usage_end;
+    getrusage(RUSAGE_SELF, &usage_end);
+    std::map<std::string, double> threads_end = thread_cpu_seconds();
+    uint64_t bytes = sys.delivered_bytes();
+    uint64_t messages = sys.delivered_messages();
+
+    sys.stop();
+
+    double seconds = elapsed_ms / 1000.0;
+    printf("xsync_bench peers=%u delay=%ums bandwidth=%luB/s\n", peers, delay_ms, bandwidth);
+    printf("xsync_bench blocks=%lu time=%.3fs blocks/s=%.1f\n", height, seconds, height / seconds);
+    printf("xsync_bench messages=%lu bytes=%lu bytes/s=%.1f\n", messages, bytes, bytes / seconds);
+    printf("xsync_bench cpu user=%.3fs sys=%.3fs\n",
+        cpu_seconds(usage_end.ru_utime) - cpu_seconds(usage_begin.ru_utime),
+        cpu_seconds(usage_end.ru_stime) - cpu_seconds(usage_begin.ru_stime));
+    for (auto &it : threads_end) {
+        double used = it.second - threads_begin[it.first];
+        if (used > 0)
+            printf("xsync_bench cpu thread=%s %.3fs\n", it.first.c_str(), used);
+    }
+
+    ASSERT_EQ(height, chain_height);
+}
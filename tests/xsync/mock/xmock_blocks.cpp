@@ -0,0 +1,122 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xmock_blocks.h"
+#include "xdata/xblocktool.h"
+#include "../../xblockstore_test/test_blockmock.hpp"
+#include "../../mock/xtableblock_util.hpp"
+
+namespace top { namespace mock {
+
+using namespace top::base;
+using namespace top::data;
+
+void do_multi_sign(std::vector<std::shared_ptr<xmock_node_t>> &shard_nodes, const xvip2_t &leader_xip, base::xvblock_t* block) {
+
+    //printf("do multi sign : {%" PRIx64 ", %" PRIx64 "}\n", leader_xip.high_addr, leader_xip.low_addr);
+
+    block->get_cert()->set_validator(leader_xip);
+
+    std::map<xvip2_t,std::string,xvip2_compare> validators;
+
+    for (auto &it: shard_nodes) {
+        std::shared_ptr<xmock_node_t> &node = it;
+        xvip2_t xip = node->m_addr.xip2();
+
+        auto sign = node->m_certauth->do_sign(xip, block, base::xtime_utl::get_fast_random64());
+        //block->set_verify_signature(sign);
+        //xassert(get_vcertauth()->verify_sign(xip_addr, vote) == base::enum_vcert_auth_result::enum_successful);
+        validators[xip] = sign;
+    }
+
+    std::string sign = shard_nodes[0]->m_certauth->merge_muti_sign(validators, block->get_cert());
+    block->set_verify_signature(sign);
+    block->reset_block_flags();
+    block->set_block_flag(base::enum_xvblock_flag_authenticated);
+
+    assert(shard_nodes[0]->m_certauth->verify_muti_sign(block) == base::enum_vcert_auth_result::enum_successful);
+}
+
+void create_tableblock(xobject_ptr_t<store::xstore_face_t> &store, xobject_ptr_t<base::xvblockstore_t> &blockstore, std::vector<std::shared_ptr<xmock_node_t>> &shard_nodes, std::string &account_address, uint32_t count) {
+    // create data
+    test_blockmock_t blockmock(store.get());
+    std::string table_address = account_address_to_block_address(top::common::xaccount_address_t{account_address});
+    std::string property("election_list");
+    base::xvblock_t *prev_unit_block = blockmock.create_property_block(nullptr, account_address, property);
+    base::xvblock_t* prev_table_block = xblocktool_t::create_genesis_empty_table(table_address);
+    base::xvaccount_t _vaddress(table_address);
+    for (uint32_t i = 0; i < count; i++) {
+        std::string value(std::to_string(i));
+        base::xvblock_t *curr_unit_block = blockmock.create_property_block(prev_unit_block, account_address, property, value);
+
+        std::vector<base::xvblock_t*> units;
+        units.push_back(curr_unit_block);
+
+        xvip2_t leader_xip = shard_nodes[0]->m_xip;
+
+        base::xvblock_t* curr_table_block = xtableblock_util::create_tableblock_no_sign(units, prev_table_block, leader_xip);
+        do_multi_sign(shard_nodes, leader_xip, curr_table_block);
+        
+        assert(blockstore->store_block(_vaddress, curr_table_block));
+
+        base::xauto_ptr<base::xvblock_t> lock_tableblock = xblocktool_t::create_next_emptyblock(curr_table_block);
+        do_multi_sign(shard_nodes, leader_xip, lock_tableblock.get());
+        assert(blockstore->store_block(_vaddress, lock_tableblock.get()));
+
+        base::xauto_ptr<base::xvblock_t> cert_tableblock = xblocktool_t::create_next_emptyblock(lock_tableblock.get());
+        do_multi_sign(shard_nodes, leader_xip, cert_tableblock.get());
+        assert(blockstore->store_block(_vaddress, cert_tableblock.get()));
+
+        base::xauto_ptr<base::xvblock_t> commit_unitblock = blockstore->get_latest_committed_block(account_address);
+
+        prev_unit_block->release_ref();
+        prev_unit_block = commit_unitblock.get();
+        prev_unit_block->add_ref();
+
+        prev_table_block->release_ref();
+        prev_table_block = cert_tableblock.get();;
+        prev_table_block->add_ref();
+    }
+
+    prev_unit_block->release_ref();
+    prev_table_block->release_ref();
+}
+
+int duplicate_block(xobject_ptr_t<base::xvblockstore_t> &from, xobject_ptr_t<base::xvblockstore_t> &to, const std::string & address, uint64_t height) {
+    base::xstream_t stream(base::xcontext_t::instance());
+
+    base::xvaccount_t _vaddress(address);
+    xblock_vector block = from->load_block_object(_vaddress, height);
+    if (!block.get_vector().empty()) {
+        dynamic_cast<xblock_t*>(block.get_vector()[0])->full_block_serialize_to(stream);
+    } else {
+        xauto_ptr<xvblock_t> block2 = from->get_latest_cert_block(_vaddress);
+        if (block2 == nullptr)
+            return -1;
+
+        if (block2->get_height() != height)
+            return -2;
+
+        dynamic_cast<xblock_t*>(block2.get())->full_block_serialize_to(stream);
+    }
+
+    xblock_ptr_t block_ptr = nullptr;
+    {
+        xblock_t* _data_obj = dynamic_cast<xblock_t*>(xblock_t::full_block_read_from(stream));
+        block_ptr.attach(_data_obj);
+    }
+
+    block_ptr->reset_block_flags();
+    block_ptr->set_block_flag(base::enum_xvblock_flag_authenticated);
+
+    bool ret = to->store_block(_vaddress, block_ptr.get());
+
+    if (ret)
+        return 0;
+
+    return -2;
+}
+
+}
+}
@@ -0,0 +1,19 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include "xmock_node.h"
+#include "xstore/xstore.h"
+#include "xvledger/xvblockstore.h"
+
+namespace top { namespace mock {
+
+void do_multi_sign(std::vector<std::shared_ptr<xmock_node_t>> &shard_nodes, const xvip2_t &leader_xip, base::xvblock_t* block);
+// count committed table blocks signed by shard_nodes, each with one unit of account_address
+void create_tableblock(xobject_ptr_t<store::xstore_face_t> &store, xobject_ptr_t<base::xvblockstore_t> &blockstore, std::vector<std::shared_ptr<xmock_node_t>> &shard_nodes, std::string &account_address, uint32_t count);
+int duplicate_block(xobject_ptr_t<base::xvblockstore_t> &from, xobject_ptr_t<base::xvblockstore_t> &to, const std::string & address, uint64_t height);
+
+}
+}
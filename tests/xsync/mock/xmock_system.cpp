@@ -119,6 +119,18 @@ void xmock_system_t::set_packet_loss_rate(uint32_t rate) {
     m_forward_ptr->set_packet_loss_rate(rate);
 }
 
+void xmock_system_t::set_bandwidth(uint64_t bytes_per_second) {
+    m_forward_ptr->set_bandwidth(bytes_per_second);
+}
+
+uint64_t xmock_system_t::delivered_bytes() const {
+    return m_forward_ptr->delivered_bytes();
+}
+
+uint64_t xmock_system_t::delivered_messages() const {
+    return m_forward_ptr->delivered_messages();
+}
+
 void xmock_system_t::create_mock_node(std::vector<std::shared_ptr<xmock_node_info_t>> &all_nodes) {
     for (auto &it: all_nodes) {
         std::shared_ptr<xmock_node_info_t> &node_info = it;
@@ -32,6 +32,9 @@ public:
 
     void set_delay(uint32_t delay_ms);
     void set_packet_loss_rate(uint32_t rate);
+    void set_bandwidth(uint64_t bytes_per_second);
+    uint64_t delivered_bytes() const;
+    uint64_t delivered_messages() const;
 
 private:
     void create_mock_node(std::vector<std::shared_ptr<xmock_node_info_t>> &all_nodes);
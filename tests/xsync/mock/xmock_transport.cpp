@@ -79,6 +79,10 @@ void xmock_transport_t::set_packet_loss_rate(uint32_t rate) {
     m_packet_loss_rate = rate;
 }
 
+void xmock_transport_t::set_bandwidth(uint64_t bytes_per_second) {
+    m_bandwidth = bytes_per_second;
+}
+
 int32_t xmock_transport_t::unicast(top::vnetwork::xvnode_address_t const &src, top::vnetwork::xvnode_address_t const & dst, const vnetwork::xmessage_t &message) {
     if (!m_is_start) {
         return -1;
@@ -147,8 +151,10 @@ int32_t xmock_transport_t::unicast(top::vnetwork::xvnode_address_t const &src, t
             }
         }
 
-        if (m_delay_ms != 0) {
-            printf("%s >>>> %s delay:%ums\n", src.to_string().c_str(), dst_vhost->address().to_string().c_str(), m_delay_ms);
+        m_delivered_bytes += message_2.payload().size();
+        m_delivered_messages++;
+
+        if (m_delay_ms != 0 || m_bandwidth != 0) {
             xmock_transport_item_t item;
             item.dst_vhost = dst_vhost;
             item.src = src;
@@ -156,7 +162,13 @@ int32_t xmock_transport_t::unicast(top::vnetwork::xvnode_address_t const &src, t
             item.tm = base::xtime_utl::time_now_ms();
             item.timeout = m_delay_ms;
 
-            std::mutex m_mutex;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // messages share one link, each waits for the ones before it to be transmitted
+            if (m_bandwidth != 0) {
+                int64_t start = (m_link_free_ms > item.tm) ? m_link_free_ms : item.tm;
+                m_link_free_ms = start + (int64_t)(message_2.payload().size() * 1000 / m_bandwidth);
+                item.timeout += (uint32_t)(m_link_free_ms - item.tm);
+            }
             m_list.push_back(item);
             continue;
         }
@@ -200,23 +212,20 @@ int32_t xmock_transport_t::broadcast(top::vnetwork::xvnode_address_t const &src,
 
 void xmock_transport_t::on_timer() {
     int64_t now = base::xtime_utl::time_now_ms();
-    while (1) {
-        std::mutex m_mutex;
-
-        if (m_list.empty())
-            break;
-
-        xmock_transport_item_t &item = m_list.front();
-        if (now >= (item.tm + item.timeout)) {
-            const top::vnetwork::xvnode_address_t &src = item.src;
-            const top::vnetwork::xmessage_t &message = item.message;
-            std::shared_ptr<xmock_vhost_t> &dst_vhost = item.dst_vhost;
-
-            dst_vhost->on_message(src, message);
-            m_list.pop_front();
+    std::list<xmock_transport_item_t> arrived;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (!m_list.empty()) {
+            xmock_transport_item_t &item = m_list.front();
+            if (now < (item.tm + item.timeout))
+                break;
+            arrived.splice(arrived.end(), m_list, m_list.begin());
         }
-        else
-            break;
+    }
+
+    // delivered out of the lock, the receiver may send at once
+    for (auto &item: arrived) {
+        item.dst_vhost->on_message(item.src, item.message);
     }
 }
 
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include "xvnetwork/xaddress.h"
 #include "xbase/xthread.h"
@@ -36,6 +37,10 @@ public:
     void stop();
     void set_delay(uint32_t delay_ms);
     void set_packet_loss_rate(uint32_t rate);
+    // bytes per second of the simulated link, 0 means unlimited
+    void set_bandwidth(uint64_t bytes_per_second);
+    uint64_t delivered_bytes() const { return m_delivered_bytes; }
+    uint64_t delivered_messages() const { return m_delivered_messages; }
 
     int32_t unicast(top::vnetwork::xvnode_address_t const &src, top::vnetwork::xvnode_address_t const & dst, const top::vnetwork::xmessage_t &message);
     int32_t broadcast(top::vnetwork::xvnode_address_t const &src, const top::vnetwork::xmessage_t &message);
@@ -51,6 +56,10 @@ private:
     std::list<xmock_transport_item_t> m_list;
     uint32_t m_delay_ms{0};
     uint32_t m_packet_loss_rate{0};
+    uint64_t m_bandwidth{0};
+    int64_t m_link_free_ms{0};
+    std::atomic<uint64_t> m_delivered_bytes{0};
+    std::atomic<uint64_t> m_delivered_messages{0};
 };
 
 
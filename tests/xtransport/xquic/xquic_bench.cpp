@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+#include "xtransport/xquic_node/xquic_node.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+
+NS_BEG4(top, transport, quic, tests)
+
+namespace {
+
+// same as DEFAULT_QUIC_SERVER_PORT_DETLA in xquic_node.cpp
+#if defined(DEBUG) || defined(XBUILD_CI) || defined(XBUILD_DEV)
+std::size_t const quic_server_port_delta = 1000;
+#else
+std::size_t const quic_server_port_delta = 1;
+#endif
+
+// p2p ports of bench nodes, away from the ports of xquic_test.cpp
+std::size_t const bench_base_port = 12000;
+
+uint64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class xquic_bench_t {
+public:
+    explicit xquic_bench_t(std::size_t node_count) {
+        for (std::size_t i = 0; i < node_count; ++i) {
+            auto node = std::make_shared<xquic_node_t>(bench_base_port + i);
+            node->register_on_receive_callback(std::bind(&xquic_bench_t::on_receive, this, i, std::placeholders::_1, std::placeholders::_2));
+            node->start();
+            m_nodes.push_back(node);
+        }
+        m_first_recv_us.resize(node_count);
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    ~xquic_bench_t() {
+        for (auto & node : m_nodes) {
+            node->stop();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    // every sender thread sends msg_count messages to random peers, returns messages per second of sending
+    uint64_t send_random(std::size_t threads, std::size_t msg_count, std::size_t payload_size) {
+        auto const begin_us = now_us();
+        std::vector<std::thread> senders;
+        for (std::size_t t = 0; t < threads; ++t) {
+            senders.emplace_back([this, t, msg_count, payload_size]() {
+                std::default_random_engine random(t);  // fixed seed, same traffic every run
+                for (std::size_t i = 0; i < msg_count; ++i) {
+                    std::size_t const from = random() % m_nodes.size();
+                    std::size_t const to = (from + 1 + random() % (m_nodes.size() - 1)) % m_nodes.size();
+                    send(from, to, payload_size);
+                }
+            });
+        }
+        for (auto & sender : senders) {
+            sender.join();
+        }
+        auto const cost_us = std::max<uint64_t>(now_us() - begin_us, 1);
+        return threads * msg_count * 1000000 / cost_us;
+    }
+
+    // node 0 sends one message to every other node, returns microseconds until all received or 0 if some never did
+    uint64_t broadcast(std::size_t payload_size, std::chrono::seconds timeout) {
+        reset();
+        auto const begin_us = now_us();
+        for (std::size_t to = 1; to < m_nodes.size(); ++to) {
+            send(0, to, payload_size);
+        }
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        while (m_recv_count < m_nodes.size() - 1 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::lock_guard<std::mutex> lock(m_lock);
+        uint64_t last_us = 0;
+        for (std::size_t i = 1; i < m_first_recv_us.size(); ++i) {
+            if (m_first_recv_us[i] == 0) {
+                return 0;
+            }
+            last_us = std::max(last_us, m_first_recv_us[i]);
+        }
+        return last_us - begin_us;
+    }
+
+    bool wait_all_received(std::size_t expected, std::chrono::seconds timeout) {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        while (m_recv_count < expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return m_recv_count >= expected;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_recv_count = 0;
+        m_latency_us.clear();
+        std::fill(m_first_recv_us.begin(), m_first_recv_us.end(), 0);
+    }
+
+    std::size_t recv_count() const {
+        return m_recv_count;
+    }
+
+    uint64_t latency_percentile(uint32_t percent) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_latency_us.empty()) {
+            return 0;
+        }
+        std::sort(m_latency_us.begin(), m_latency_us.end());
+        return m_latency_us[(m_latency_us.size() - 1) * percent / 100];
+    }
+
+private:
+    void send(std::size_t from, std::size_t to, std::size_t payload_size) {
+        transport::protobuf::RoutingMessage proto_message;
+        proto_message.set_data(std::to_string(now_us()) + "," + std::string(payload_size, 'x'));
+        std::string const fake_header_str{"01234567"};  // enum_xbase_header_len
+        m_nodes[from]->send_data(fake_header_str + proto_message.SerializeAsString(), "127.0.0.1", bench_base_port + to + quic_server_port_delta);
+    }
+
+    void on_receive(std::size_t node_index, transport::protobuf::RoutingMessage & message, base::xpacket_t & packet) {
+        auto const recv_us = now_us();
+        auto const send_us = std::strtoull(message.data().c_str(), nullptr, 10);
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_latency_us.push_back(recv_us >= send_us ? recv_us - send_us : 0);
+        if (m_first_recv_us[node_index] == 0) {
+            m_first_recv_us[node_index] = recv_us;
+        }
+        m_recv_count++;
+    }
+
+    std::vector<std::shared_ptr<xquic_node_t>> m_nodes;
+    std::mutex m_lock;
+    std::atomic<std::size_t> m_recv_count{0};
+    std::vector<uint64_t> m_latency_us;
+    std::vector<uint64_t> m_first_recv_us;
+};
+
+}  // namespace
+
+// throughput and latency of quic transport between local nodes, for local to mid-scale node counts
+TEST(test_xquic_node, throughput_BENCH) {
+    std::size_t const threads = 4;
+    std::size_t const msg_count = 1000;
+    std::size_t const payload_size = 256;
+    for (std::size_t const node_count : {4, 16, 64}) {
+        xquic_bench_t bench(node_count);
+        auto const send_rate = bench.send_random(threads, msg_count, payload_size);
+        EXPECT_TRUE(bench.wait_all_received(threads * msg_count, std::chrono::seconds(30)));
+
+        auto const bcast_us = bench.broadcast(payload_size, std::chrono::seconds(10));
+        EXPECT_NE(bcast_us, 0);
+        std::cout << "[xquic bench] nodes:" << node_count << " sent:" << threads * msg_count << " recv:" << bench.recv_count()
+                  << " send_rate:" << send_rate << "/s latency_us p50:" << bench.latency_percentile(50) << " p90:" << bench.latency_percentile(90)
+                  << " p99:" << bench.latency_percentile(99) << " broadcast_cover_us:" << bcast_us << std::endl;
+    }
+}
+
+NS_END4
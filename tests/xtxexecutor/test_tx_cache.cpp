@@ -68,9 +68,17 @@ TEST_F(test_tx_cache, test_cache) {
     EXPECT_EQ(m_transaction_cache->tx_find(tx_hash), 1);
     xtransaction_cache_data_t cache_data;
     EXPECT_EQ(m_transaction_cache->tx_get(tx_hash, cache_data), 1);
-    xJson::Value jv;
-    m_transaction_cache->tx_set_json(tx_hash, 0, jv);
-    m_transaction_cache->tx_set_json(tx_hash, 1, jv);
+    xtransaction_cache_state_t state;
+    state.height = 10;
+    state.set_used_deposit(20);
+    EXPECT_EQ(m_transaction_cache->tx_set_state(tx_hash, 0, state), 0);
+    EXPECT_EQ(m_transaction_cache->tx_set_state(tx_hash, 1, state), 0);
+    EXPECT_TRUE(m_transaction_cache->tx_get(tx_hash, cache_data));
+    ASSERT_EQ(cache_data.states.size(), 2u);
+    xJson::Value jv = cache_data.states[1].to_json();
+    EXPECT_EQ(jv["height"].asUInt64(), 10u);
+    EXPECT_EQ(jv["used_deposit"].asUInt64(), 20u);
+    EXPECT_FALSE(jv.isMember("exec_status"));
     m_transaction_cache->tx_erase(tx_hash);
     EXPECT_EQ(m_transaction_cache->tx_find(tx_hash), 0);
     EXPECT_EQ(m_transaction_cache->tx_find(tx_hash2), 1);
@@ -78,3 +86,22 @@ TEST_F(test_tx_cache, test_cache) {
     m_transaction_cache->tx_clean();
     EXPECT_EQ(m_transaction_cache->tx_find(tx_hash2), 0);
 }
+
+TEST_F(test_tx_cache, test_cache_bytes_bound) {
+    // a budget of a few entries for each stripe
+    data::xtransaction_cache_t cache(xtransaction_cache_t::stripe_count * 1024);
+    xtransaction_ptr_t tx = make_object_ptr<xtransaction_v1_t>();
+    tx->set_digest();
+
+    std::string first_hash = "first";
+    cache.tx_add(first_hash, tx);
+    for (uint32_t i = 0; i < 10000; i++) {
+        cache.tx_add(std::to_string(i) + "1234567890123456789012345", tx);
+        // the first tx is used, so it stays
+        xtransaction_cache_data_t cache_data;
+        EXPECT_TRUE(cache.tx_get(first_hash, cache_data));
+    }
+    EXPECT_LE(cache.bytes(), (uint64_t)xtransaction_cache_t::stripe_count * 1024);
+    EXPECT_EQ(cache.tx_find(first_hash), 1);
+    EXPECT_EQ(cache.tx_find("01234567890123456789012345"), 0);
+}
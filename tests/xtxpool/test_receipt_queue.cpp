@@ -91,3 +91,48 @@ TEST_F(test_new_receipt_queue, receipt_queue_basic) {
     auto find_receipt = receipt_queue.find(receiver, recv_txs[1]->get_transaction()->digest());
     ASSERT_EQ(find_receipt, nullptr);
 }
+
+TEST_F(test_new_receipt_queue, peer_table_receipts_continuous_id) {
+    mock::xvchain_creator creator;
+    mock::xdatamock_table mocktable(1, 2);
+    std::string table_addr = mocktable.get_account();
+    std::vector<std::string> unit_addrs = mocktable.get_unit_accounts();
+
+    xtxpool_role_info_t shard(0, 0, 0, common::xnode_type_t::consensus_auditor);
+    xtxpool_statistic_t statistic;
+    xtable_state_cache_t table_state_cache(nullptr, table_addr);
+    xtxpool_table_info_t table_para(table_addr, &shard, &statistic, &table_state_cache);
+    xtx_para_t para;
+    xreceipt_queue_internal_t receipt_queue_internal(&table_para);
+    xpeer_table_receipts_t peer_table_receipts(&receipt_queue_internal);
+
+    uint32_t tx_num = 5;
+    std::vector<xcons_transaction_ptr_t> send_txs = mocktable.create_send_txs(unit_addrs[0], unit_addrs[1], tx_num);
+    mocktable.push_txs(send_txs);
+    xblock_ptr_t _tableblock1 = mocktable.generate_one_table();
+    mocktable.generate_one_table();
+    mocktable.generate_one_table();
+    std::vector<xcons_transaction_ptr_t> recv_txs = mocktable.create_receipts(_tableblock1);
+    ASSERT_EQ(recv_txs.size(), tx_num);
+
+    // receipt ids 1,2,4,5
+    for (uint32_t i : {0, 1, 3, 4}) {
+        ASSERT_EQ(peer_table_receipts.push_tx(std::make_shared<xtx_entry>(recv_txs[i], para)), 0);
+    }
+    ASSERT_EQ(peer_table_receipts.get_continuous_receipt_id(), 2);
+    ASSERT_EQ(peer_table_receipts.get_txs(1, 10, true).size(), 2);
+
+    ASSERT_EQ(peer_table_receipts.push_tx(std::make_shared<xtx_entry>(recv_txs[2], para)), 0);
+    ASSERT_EQ(peer_table_receipts.get_continuous_receipt_id(), 5);
+    ASSERT_EQ(peer_table_receipts.get_txs(1, 10, true).size(), 5);
+    ASSERT_EQ(peer_table_receipts.get_txs(2, 3, true).size(), 2);
+
+    peer_table_receipts.update_latest_receipt_id(2);
+    ASSERT_EQ(peer_table_receipts.get_continuous_receipt_id(), 5);
+    ASSERT_EQ(peer_table_receipts.get_txs(3, 10, true).size(), 3);
+
+    peer_table_receipts.erase(4);
+    ASSERT_EQ(peer_table_receipts.get_continuous_receipt_id(), 3);
+    ASSERT_EQ(peer_table_receipts.get_txs(3, 10, true).size(), 1);
+    ASSERT_EQ(peer_table_receipts.get_txs(3, 10, false).size(), 2);
+}
@@ -100,3 +100,23 @@ TEST_F(test_receiptid_state_cache, unconfirm_id_section) {
     ASSERT_EQ(confirm_id, 8);
     ASSERT_EQ(unconfirm_id_max, 11);
 }
+
+TEST_F(test_receiptid_state_cache, table_slots) {
+    xtable_shortid_t consensus_table = base::xtable_index_t(base::enum_chain_zone_consensus_index, 63).to_table_shortid();
+    xtable_shortid_t zec_table = base::xtable_index_t(base::enum_chain_zone_zec_index, 2).to_table_shortid();
+    xtable_shortid_t evm_table = base::xtable_index_t(base::enum_chain_zone_evm_index, 0).to_table_shortid();
+
+    xreceiptid_state_cache_t receiptid_state_cache;
+    for (auto table_id : {consensus_table, zec_table, evm_table}) {
+        auto receiptid_state = std::make_shared<base::xreceiptid_state_t>(table_id, 10 + table_id);
+        receiptid_state_cache.update_table_receiptid_state(nullptr, receiptid_state);
+    }
+    ASSERT_EQ(receiptid_state_cache.get_height(consensus_table), 10 + consensus_table);
+    ASSERT_EQ(receiptid_state_cache.get_height(zec_table), 10 + zec_table);
+    ASSERT_EQ(receiptid_state_cache.get_height(evm_table), 10 + evm_table);
+    ASSERT_EQ(receiptid_state_cache.get_table_receiptid_state(base::xtable_index_t(base::enum_chain_zone_consensus_index, 1).to_table_shortid()), nullptr);
+
+    // an older state doesn't replace the cached one
+    receiptid_state_cache.update_table_receiptid_state(nullptr, std::make_shared<base::xreceiptid_state_t>(zec_table, 1));
+    ASSERT_EQ(receiptid_state_cache.get_height(zec_table), 10 + zec_table);
+}
@@ -54,9 +54,12 @@ TEST_F(xunorder_test, unoder_filter) {
         pdu->reset_message(msg_type, ttl, msg_content, msg_nonce, from_addr.low_addr, to_addr.low_addr);
         ASSERT_FALSE(unorder_cache.filter_event(account_viewid, from_addr, to_addr, *pdu.get()));
         ASSERT_EQ(unorder_cache.get_unoder_cache_size(), 1);
+        ASSERT_EQ(unorder_cache.get_proposal_event(account_viewid + 2), nullptr);
+        ASSERT_EQ(unorder_cache.get_unoder_cache_size(), 1);
         xconsensus::xcspdu_fire* proposal_event = unorder_cache.get_proposal_event(account_viewid + 1);
         ASSERT_NE(proposal_event, nullptr);
         ASSERT_EQ(unorder_cache.get_unoder_cache_size(), 0);
+        proposal_event->release_ref();
     }
     {
         msg_type = xconsensus::enum_consensus_msg_type_proposal;
@@ -176,6 +176,29 @@ TEST_F(test_dbkey, key_block_state) {
         ASSERT_EQ(base::enum_xdbkey_type_state_object, xvdbkey_t::get_dbkey_type(old_key));
         std::cout << old_key << std::endl;
     }    
+    {
+        std::string old_key = xvdbkey_t::create_prunable_state_key_old(vaddr, 100, blockhash);
+        ASSERT_EQ(base::enum_xdbkey_type_state_object, xvdbkey_t::get_dbkey_type(old_key));
+        std::cout << old_key << std::endl;
+    }
+}
+
+TEST_F(test_dbkey, key_state_height_range) {
+    base::xvaccount_t vaddr("Ta0000@1");
+    std::string blockhash = "1111";
+    std::string offdata_key = xvdbkey_t::create_prunable_block_output_offdata_key(vaddr, 100, 200);
+    ASSERT_EQ(base::enum_xdbkey_type_block_out_offdata, xvdbkey_t::get_dbkey_type(offdata_key));
+    ASSERT_EQ(base::enum_xdbkey_type_block_out_offdata, xvdbkey_t::get_dbkey_type(xvdbkey_t::create_prunable_block_output_offdata_key_old(vaddr, 100, 200)));
+
+    // states and offdata of a height are all in ["height key", "next height key")
+    std::string state_key = xvdbkey_t::create_prunable_state_key(vaddr, 100, blockhash);
+    std::string begin_key = xvdbkey_t::create_prunable_state_height_key(vaddr, 100);
+    std::string end_key = xvdbkey_t::create_prunable_state_height_key(vaddr, 101);
+    ASSERT_TRUE(begin_key <= state_key && state_key < end_key);
+    ASSERT_TRUE(begin_key <= offdata_key && offdata_key < end_key);
+    ASSERT_TRUE(xvdbkey_t::create_prunable_state_key(vaddr, 0xff, blockhash) < xvdbkey_t::create_prunable_state_height_key(vaddr, 0x100));
+    ASSERT_TRUE(xvdbkey_t::create_prunable_state_key(base::xvaccount_t("Ta0000@10"), 100, blockhash) >= end_key ||
+                xvdbkey_t::create_prunable_state_key(base::xvaccount_t("Ta0000@10"), 100, blockhash) < begin_key);
 }
 
 TEST_F(test_dbkey, key_unit_proof) {
@@ -205,3 +205,87 @@ TEST_F(test_property, bstate_clone)
     xassert(prophash1 == prophash4);
     xassert(prophash1 == prophash5);    
 }
+
+TEST_F(test_property, bstate_delta)
+{
+    const std::string account = "T80000733b43e6a2542709dc918ef2209ae0fc6503c2f2";
+    xobject_ptr_t<base::xvbstate_t> base_state = make_object_ptr<base::xvbstate_t>(account, (uint64_t)1, (uint64_t)1, std::string(), std::string(), (uint64_t)0, (uint32_t)0, (uint16_t)0);
+    {
+        xauto_ptr<xvcanvas_t> canvas = new xvcanvas_t();
+        base_state->new_token_var("@1", canvas.get())->deposit((vtoken_t)100, canvas.get());
+        base_state->new_string_var("@2", canvas.get())->reset("value", canvas.get());
+        auto map_var = base_state->new_string_map_var("@3", canvas.get());
+        map_var->insert("key1", "value1", canvas.get());
+        map_var->insert("key2", "value2", canvas.get());
+        auto hashmap_var = base_state->new_hashmap_var("@4", canvas.get());
+        hashmap_var->insert("key1", "field1", "value1", canvas.get());
+        hashmap_var->insert("key1", "field2", "value2", canvas.get());
+        hashmap_var->insert("key2", "field1", "value1", canvas.get());
+        base_state->new_string_var("@5", canvas.get())->reset("value5", canvas.get());
+    }
+
+    std::string base_snapshot;
+    ASSERT_TRUE(base_state->take_snapshot(base_snapshot));
+    xobject_ptr_t<base::xvbstate_t> new_state = make_object_ptr<base::xvbstate_t>(account, (uint64_t)2, (uint64_t)2, std::string("hash1"), std::string(), (uint64_t)0, (uint32_t)0, (uint16_t)0);
+    ASSERT_TRUE(new_state->apply_changes_of_binlog(base_snapshot));
+    {
+        xauto_ptr<xvcanvas_t> canvas = new xvcanvas_t();
+        new_state->load_token_var("@1")->deposit((vtoken_t)1, canvas.get());
+        auto map_var = new_state->load_string_map_var("@3");
+        map_var->insert("key1", "value3", canvas.get());
+        map_var->erase("key2", canvas.get());
+        map_var->insert("key4", "value4", canvas.get());
+        auto hashmap_var = new_state->load_hashmap_var("@4");
+        hashmap_var->insert("key1", "field1", "value3", canvas.get());
+        hashmap_var->erase("key1", "field2", canvas.get());
+        hashmap_var->erase("key2", canvas.get());
+        hashmap_var->insert("key3", "field1", "value1", canvas.get());
+        new_state->load_string_var("@5")->reset("changed", canvas.get());
+    }
+
+    std::string delta_bin;
+    ASSERT_TRUE(new_state->take_delta(*base_state, delta_bin));
+    EXPECT_LT(delta_bin.size(), base_snapshot.size());
+    EXPECT_EQ(std::string("hash1"), base::xvbstate_t::get_delta_base_hash(delta_bin));
+
+    xauto_ptr<base::xvbstate_t> restored_state = base::xvbstate_t::create_from_delta(*base_state, delta_bin);
+    ASSERT_NE(nullptr, restored_state.get());
+    EXPECT_EQ(new_state->get_block_height(), restored_state->get_block_height());
+    EXPECT_EQ(new_state->get_last_block_hash(), restored_state->get_last_block_hash());
+
+    std::string new_snapshot;
+    std::string restored_snapshot;
+    ASSERT_TRUE(new_state->take_snapshot(new_snapshot));
+    ASSERT_TRUE(restored_state->take_snapshot(restored_snapshot));
+    EXPECT_EQ(new_snapshot, restored_snapshot);
+
+    // a delta only applies on the state of previous height
+    EXPECT_FALSE(base_state->take_delta(*new_state, delta_bin));
+}
+
+TEST_F(test_property, bstate_native_property_slot)
+{
+    EXPECT_EQ(enum_xvstate_native_property_balance, xvexestate_t::get_native_property_slot("$0"));
+    EXPECT_EQ(enum_xvstate_native_property_tx_info, xvexestate_t::get_native_property_slot("$06"));
+    EXPECT_EQ(enum_xvstate_native_property_max, xvexestate_t::get_native_property_slot("$1"));
+    EXPECT_EQ(enum_xvstate_native_property_max, xvexestate_t::get_native_property_slot("$16"));
+    EXPECT_EQ(enum_xvstate_native_property_max, xvexestate_t::get_native_property_slot("@0"));
+
+    xobject_ptr_t<base::xvbstate_t> bstate = make_object_ptr<base::xvbstate_t>("T80000733b43e6a2542709dc918ef2209ae0fc6503c2f2", (uint64_t)1, (uint64_t)1, std::string(), std::string(), (uint64_t)0, (uint32_t)0, (uint16_t)0);
+    xauto_ptr<xvcanvas_t> canvas = new xvcanvas_t();
+    EXPECT_EQ(nullptr, bstate->get_property_object(enum_xvstate_native_property_balance));
+    bstate->new_token_var("$0", canvas.get())->deposit((vtoken_t)100, canvas.get());
+    ASSERT_NE(nullptr, bstate->get_property_object(enum_xvstate_native_property_balance));
+    EXPECT_EQ(100, bstate->load_token_var("$0")->get_balance());
+
+    // slots of a clone and of a deserialized state point to their own properties
+    xauto_ptr<base::xvbstate_t> cloned_state(dynamic_cast<base::xvbstate_t*>(bstate->clone()));
+    ASSERT_NE(nullptr, cloned_state->get_property_object(enum_xvstate_native_property_balance));
+    EXPECT_NE(bstate->get_property_object(enum_xvstate_native_property_balance), cloned_state->get_property_object(enum_xvstate_native_property_balance));
+
+    std::string state_bin;
+    bstate->serialize_to_string(state_bin);
+    xauto_ptr<base::xvbstate_t> read_state = base::xvblock_t::create_state_object(state_bin);
+    ASSERT_NE(nullptr, read_state.get());
+    EXPECT_EQ(100, read_state->load_token_var("$0")->get_balance());
+}
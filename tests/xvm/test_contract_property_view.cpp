@@ -0,0 +1,53 @@
+#include "xvm/manager/xcontract_property_view.h"
+#include "xvledger/xvstate.h"
+
+#include <gtest/gtest.h>
+
+using namespace top;
+using namespace top::contract;
+
+namespace {
+
+using xtest_property_t = std::map<std::string, std::string>;
+
+std::string const test_address{"T00000LMcqLyTzsk3HB8dhF51i6xEcVEuyX2Vx6p"};
+std::string const test_property{"@test_property"};
+
+data::xunitstate_ptr_t make_unitstate(uint64_t const height, xtest_property_t const & value) {
+    auto vbstate = make_object_ptr<base::xvbstate_t>(test_address, height, height, std::string{"hash"} + std::to_string(height), std::string{}, 0, 0, 0);
+    auto unitstate = std::make_shared<data::xunit_bstate_t>(vbstate.get(), false);
+    auto const bytes = codec::msgpack_encode(value);
+    unitstate->string_create(test_property);
+    unitstate->string_set(test_property, {std::begin(bytes), std::end(bytes)});
+    return unitstate;
+}
+
+}
+
+TEST(xcontract_property_view, reused_until_height_changes) {
+    xcontract_property_view_t<xtest_property_t> view;
+
+    auto const state1 = make_unitstate(1, {{"k", "v1"}});
+    auto const value1 = view.get(state1, test_property);
+    ASSERT_NE(nullptr, value1);
+    EXPECT_EQ("v1", value1->at("k"));
+    EXPECT_EQ(value1, view.get(state1, test_property));
+
+    auto const state2 = make_unitstate(2, {{"k", "v2"}});
+    auto const value2 = view.get(state2, test_property);
+    ASSERT_NE(nullptr, value2);
+    EXPECT_EQ("v2", value2->at("k"));
+    EXPECT_EQ(value2, view.get(state2, test_property));
+
+    // an older state is decoded but doesn't replace the latest one
+    auto const old_value = view.get(state1, test_property);
+    ASSERT_NE(nullptr, old_value);
+    EXPECT_EQ("v1", old_value->at("k"));
+    EXPECT_EQ(value2, view.get(state2, test_property));
+}
+
+TEST(xcontract_property_view, empty_property) {
+    xcontract_property_view_t<xtest_property_t> view;
+    EXPECT_EQ(nullptr, view.get(nullptr, test_property));
+    EXPECT_EQ(nullptr, view.get(make_unitstate(1, {}), "@not_exist"));
+}
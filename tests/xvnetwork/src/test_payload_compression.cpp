@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xcodec/xmsgpack_codec.hpp"
+#include "xvnetwork/xcodec/xmsgpack/xvnetwork_message_codec.hpp"
+#include "xvnetwork/xpayload_compression.h"
+
+#include <gtest/gtest.h>
+
+using namespace top;            // NOLINT
+using namespace top::vnetwork;  // NOLINT
+
+static xbyte_buffer_t compressible_payload(std::size_t const size) {
+    xbyte_buffer_t payload(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        payload[i] = static_cast<uint8_t>(i % 16);
+    }
+    return payload;
+}
+
+TEST(xpayload_compression, small_or_disabled_payload_is_raw) {
+    xbyte_buffer_t compressed;
+    enable_payload_compression(false, 1024);
+    EXPECT_EQ(xpayload_encoding_t::raw, compress_payload(compressible_payload(8192), compressed));
+
+    enable_payload_compression(true, 1024);
+    EXPECT_EQ(xpayload_encoding_t::raw, compress_payload(compressible_payload(512), compressed));
+    enable_payload_compression(false, 4096);
+}
+
+TEST(xpayload_compression, lz4_round_trip) {
+    enable_payload_compression(true, 1024);
+    auto const payload = compressible_payload(64 * 1024);
+    xbyte_buffer_t compressed;
+    ASSERT_EQ(xpayload_encoding_t::lz4, compress_payload(payload, compressed));
+    EXPECT_LT(compressed.size(), payload.size());
+
+    xbyte_buffer_t restored;
+    ASSERT_TRUE(decompress_payload(xpayload_encoding_t::lz4, compressed, restored));
+    EXPECT_EQ(payload, restored);
+
+    // a corrupted block is rejected, not decoded into garbage
+    compressed.resize(compressed.size() / 2);
+    EXPECT_FALSE(decompress_payload(xpayload_encoding_t::lz4, compressed, restored));
+    enable_payload_compression(false, 4096);
+}
+
+TEST(xpayload_compression, vnetwork_message_codec_round_trip) {
+    xvnetwork_message_t const message{common::xnode_address_t{}, common::xnode_address_t{}, xmessage_t{compressible_payload(16 * 1024), common::xmessage_id_t::invalid}, 10};
+
+    auto const raw_bytes = codec::msgpack_encode(message);
+    enable_payload_compression(true, 1024);
+    auto const compressed_bytes = codec::msgpack_encode(message);
+    enable_payload_compression(false, 4096);
+    EXPECT_LT(compressed_bytes.size(), raw_bytes.size());
+
+    // receivers decode either form whether or not they compress themselves
+    auto const decoded = codec::msgpack_decode<xvnetwork_message_t>(compressed_bytes);
+    EXPECT_EQ(message.message(), decoded.message());
+    EXPECT_EQ(message.logic_time(), decoded.logic_time());
+    EXPECT_EQ(message.message(), codec::msgpack_decode<xvnetwork_message_t>(raw_bytes).message());
+}
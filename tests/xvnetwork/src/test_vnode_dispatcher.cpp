@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xcommon/xaddress.h"
+#include "xvnetwork/xvnode_dispatcher.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace top;
+using namespace top::vnetwork;
+
+namespace {
+
+common::xnode_address_t const test_address{common::build_network_broadcast_sharding_address(common::xnetwork_id_t{0})};
+
+xmessage_t make_message(std::uint8_t const seq) {
+    return xmessage_t{xbyte_buffer_t{seq}, common::xmessage_id_t::invalid};
+}
+
+}
+
+TEST(xvnode_dispatcher, delivered_in_order) {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::uint8_t> received;
+    xmessage_ready_callback_t callback = [&](xvnode_address_t const &, xmessage_t const & message, std::uint64_t const) {
+        std::lock_guard<std::mutex> lock{mutex};
+        received.push_back(message.payload().front());
+        cond.notify_one();
+    };
+
+    auto dispatcher = xvnode_dispatcher_t::create(test_address, 1, 128);
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(dispatcher->push(callback, test_address, make_message(i), i));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        ASSERT_TRUE(cond.wait_for(lock, std::chrono::seconds(10), [&] { return received.size() == 100; }));
+    }
+    for (std::uint8_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, received[i]);
+    }
+    EXPECT_EQ(100u, dispatcher->delivered());
+    dispatcher->stop();
+}
+
+TEST(xvnode_dispatcher, full_queue_and_stop_drop) {
+    std::atomic<bool> release{false};
+    std::atomic<int> entered{0};
+    std::atomic<int> exited{0};
+    xmessage_ready_callback_t callback = [&](xvnode_address_t const &, xmessage_t const &, std::uint64_t const) {
+        ++entered;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ++exited;
+    };
+
+    auto dispatcher = xvnode_dispatcher_t::create(test_address, 1, 2);
+    EXPECT_TRUE(dispatcher->push(callback, test_address, make_message(0), 0));
+    while (entered == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // the handler is busy, so the queue fills up
+    EXPECT_TRUE(dispatcher->push(callback, test_address, make_message(1), 0));
+    EXPECT_TRUE(dispatcher->push(callback, test_address, make_message(2), 0));
+    EXPECT_FALSE(dispatcher->push(callback, test_address, make_message(3), 0));
+    EXPECT_EQ(2u, dispatcher->backlog());
+    EXPECT_EQ(1u, dispatcher->dropped());
+
+    dispatcher->stop();
+    EXPECT_EQ(3u, dispatcher->dropped());
+    EXPECT_FALSE(dispatcher->push(callback, test_address, make_message(4), 0));
+    release = true;
+    while (exited == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(1, entered);
+}
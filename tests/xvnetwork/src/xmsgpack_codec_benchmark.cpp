@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2018 Telos Foundation & contributors
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "xcodec/xmsgpack_codec.hpp"
+#include "xvnetwork/xcodec/xmsgpack/xvnetwork_message_codec.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+
+XDEFINE_MSG_CATEGORY(xmessage_category_codec_benchmark, 0x0002);
+XDEFINE_MSG_ID(xmessage_category_codec_benchmark, xmessage_id_codec_benchmark, 0x00000001);
+
+std::vector<top::vnetwork::xvnetwork_message_t> build_messages(std::size_t const count) {
+    top::common::xnode_id_t node_id;
+    node_id.random();
+
+    top::common::xnode_address_t address{
+        top::common::xcluster_address_t{
+            top::common::xnetwork_id_t{ 0 },
+            top::common::xzone_id_t{ 1 },
+            top::common::xcluster_id_t{ 1 },
+            top::common::xgroup_id_t{ 1 }
+        },
+        top::common::xaccount_election_address_t{ node_id, top::common::xslot_id_t{} },
+        top::common::xelection_round_t{ static_cast<top::common::xelection_round_t::value_type>(0) },
+        std::uint16_t{1024},
+        std::uint64_t{0}
+    };
+
+    // payloads from consensus votes up to block sized messages
+    std::size_t const payload_sizes[] = { 64, 512, 4 * 1024, 64 * 1024 };
+
+    std::vector<top::vnetwork::xvnetwork_message_t> messages;
+    messages.reserve(count);
+    for (auto i = 0u; i < count; ++i) {
+        top::xbyte_buffer_t payload(payload_sizes[i % (sizeof(payload_sizes) / sizeof(payload_sizes[0]))], static_cast<top::xbyte_t>(i));
+        messages.push_back(top::vnetwork::xvnetwork_message_t{
+            address,
+            address,
+            top::vnetwork::xmessage_t{ std::move(payload), xmessage_id_codec_benchmark },
+            static_cast<std::uint64_t>(i)
+        });
+    }
+    return messages;
+}
+
+// encode and decode as the codec did before the thread scratch resources: an sbuffer copied out and an unpack
+// copying strings and bins into a fresh zone
+top::xbyte_buffer_t sbuffer_encode(top::vnetwork::xvnetwork_message_t const & message) {
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, message);
+    return { buffer.data(), buffer.data() + buffer.size() };
+}
+
+top::vnetwork::xvnetwork_message_t copying_decode(top::xbyte_buffer_t const & bytes) {
+    auto object_handle = msgpack::unpack(reinterpret_cast<char const *>(bytes.data()), bytes.size(), nullptr);
+    return object_handle.get().as<top::vnetwork::xvnetwork_message_t>();
+}
+
+template <typename F>
+std::int64_t elapsed_us(F && f) {
+    auto const begin = std::chrono::high_resolution_clock::now();
+    f();
+    auto const end = std::chrono::high_resolution_clock::now();
+    return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+}
+
+}  // namespace
+
+TEST(xvnetwork, msgpack_codec_benchmark) {
+    constexpr std::size_t count{ 20000 };
+    auto const messages = build_messages(count);
+
+    std::vector<top::xbyte_buffer_t> old_bytes;
+    std::vector<top::xbyte_buffer_t> new_bytes;
+    old_bytes.reserve(count);
+    new_bytes.reserve(count);
+
+    auto const old_encode_us = elapsed_us([&] {
+        for (auto const & message : messages) {
+            old_bytes.push_back(sbuffer_encode(message));
+        }
+    });
+    auto const new_encode_us = elapsed_us([&] {
+        for (auto const & message : messages) {
+            new_bytes.push_back(top::codec::msgpack_encode(message));
+        }
+    });
+    ASSERT_EQ(old_bytes, new_bytes);
+
+    std::uint64_t old_hashes{ 0 };
+    std::uint64_t new_hashes{ 0 };
+    auto const old_decode_us = elapsed_us([&] {
+        for (auto const & bytes : old_bytes) {
+            old_hashes += copying_decode(bytes).hash();
+        }
+    });
+    auto const new_decode_us = elapsed_us([&] {
+        for (auto const & bytes : new_bytes) {
+            new_hashes += top::codec::msgpack_decode<top::vnetwork::xvnetwork_message_t>(bytes).hash();
+        }
+    });
+    EXPECT_EQ(old_hashes, new_hashes);
+
+    for (auto i = 0u; i < count; i += count / 8) {
+        auto const decoded = top::codec::msgpack_decode<top::vnetwork::xvnetwork_message_t>(new_bytes[i]);
+        EXPECT_EQ(messages[i].hash(), decoded.hash());
+    }
+
+    std::printf("msgpack encode %zu messages: sbuffer %" PRIi64 "us, thread buffer %" PRIi64 "us\n", count, old_encode_us, new_encode_us);
+    std::printf("msgpack decode %zu messages: copying %" PRIi64 "us, referencing %" PRIi64 "us\n", count, old_decode_us, new_decode_us);
+}
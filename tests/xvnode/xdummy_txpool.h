@@ -72,6 +72,12 @@ public:
         return m_all_table_sids;
     }
 
+    void set_journal_dir(const std::string & dir) override {
+    }
+
+    void save_journal() override {
+    }
+
 private:
     std::set<base::xtable_shortid_t> m_all_table_sids;
 };